@@ -19,6 +19,7 @@ bool AssetManager::PushFront(std::unique_ptr<AssetResolver> resolver) {
   }
 
   resolvers_.push_front(std::move(resolver));
+  ClearAssetIndex();
   return true;
 }
 
@@ -28,6 +29,7 @@ bool AssetManager::PushBack(std::unique_ptr<AssetResolver> resolver) {
   }
 
   resolvers_.push_back(std::move(resolver));
+  ClearAssetIndex();
   return true;
 }
 
@@ -53,12 +55,19 @@ void AssetManager::UpdateResolverByType(
     new_resolvers.push_back(std::move(updated_asset_resolver));
   }
   resolvers_.swap(new_resolvers);
+  ClearAssetIndex();
 }
 
 std::deque<std::unique_ptr<AssetResolver>> AssetManager::TakeResolvers() {
+  ClearAssetIndex();
   return std::move(resolvers_);
 }
 
+void AssetManager::ClearAssetIndex() {
+  std::scoped_lock lock(asset_index_mutex_);
+  asset_index_.clear();
+}
+
 // |AssetResolver|
 std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
     const std::string& asset_name) const {
@@ -67,12 +76,38 @@ std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
   }
   TRACE_EVENT1("flutter", "AssetManager::GetAsMapping", "name",
                asset_name.c_str());
+  bool indexed = false;
+  const AssetResolver* indexed_resolver = nullptr;
+  {
+    std::scoped_lock lock(asset_index_mutex_);
+    auto found = asset_index_.find(asset_name);
+    if (found != asset_index_.end()) {
+      indexed = true;
+      indexed_resolver = found->second;
+    }
+  }
+  if (indexed) {
+    if (indexed_resolver == nullptr) {
+      return nullptr;
+    }
+    auto mapping = indexed_resolver->GetAsMapping(asset_name);
+    if (mapping != nullptr) {
+      return mapping;
+    }
+    // The asset went missing from its resolver, so look it up in all of them.
+  }
   for (const auto& resolver : resolvers_) {
     auto mapping = resolver->GetAsMapping(asset_name);
     if (mapping != nullptr) {
+      std::scoped_lock lock(asset_index_mutex_);
+      asset_index_[asset_name] = resolver.get();
       return mapping;
     }
   }
+  {
+    std::scoped_lock lock(asset_index_mutex_);
+    asset_index_[asset_name] = nullptr;
+  }
   FML_DLOG(WARNING) << "Could not find asset: " << asset_name;
   return nullptr;
 }
@@ -7,7 +7,9 @@
 
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include <optional>
 #include "flutter/assets/asset_resolver.h"
@@ -91,6 +93,15 @@ class AssetManager final : public AssetResolver {
  private:
   std::deque<std::unique_ptr<AssetResolver>> resolvers_;
 
+  // Maps the names of assets that have been looked up to the resolver that
+  // provided them, or to nullptr if no resolver had them. Lookups of indexed
+  // names probe at most one resolver. The index is cleared whenever the
+  // resolvers change.
+  mutable std::mutex asset_index_mutex_;
+  mutable std::unordered_map<std::string, const AssetResolver*> asset_index_;
+
+  void ClearAssetIndex();
+
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManager);
 };
 
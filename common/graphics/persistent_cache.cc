@@ -85,8 +85,8 @@ bool PersistentCache::Purge() {
   FML_CHECK(GetWorkerTaskRunner());
 
   std::promise<bool> removed;
-  GetWorkerTaskRunner()->PostTask([&removed,
-                                   cache_directory = cache_directory_]() {
+  GetWorkerTaskRunner()->PostTask([&removed, cache_directory = cache_directory_,
+                                   pack = pack_, sksl_pack = sksl_pack_]() {
     if (cache_directory->is_valid()) {
       // Only remove files but not directories.
       FML_LOG(INFO) << "Purge persistent cache.";
@@ -99,6 +99,8 @@ bool PersistentCache::Purge() {
         return fml::UnlinkFile(directory, filename.c_str());
       };
       removed.set_value(VisitFilesRecursively(*cache_directory, delete_file));
+      pack->Reset();
+      sksl_pack->Reset();
     } else {
       removed.set_value(false);
     }
@@ -223,6 +225,9 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
   std::vector<PersistentCache::SkSLCache> result;
   fml::FileVisitor visitor = [&result](const fml::UniqueFD& directory,
                                        const std::string& filename) {
+    if (filename == PersistentCachePack::kFileName) {
+      return true;
+    }
     SkSLCache cache = LoadFile(directory, filename, true);
     if (cache.key != nullptr && cache.value != nullptr) {
       result.push_back(cache);
@@ -243,6 +248,9 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
     if (fresh_dir.is_valid()) {
       fml::VisitFiles(fresh_dir, visitor);
     }
+    for (auto& [key, value] : sksl_pack_->GetEntries()) {
+      result.push_back({std::move(key), std::move(value)});
+    }
   }
 
   std::unique_ptr<fml::Mapping> mapping = nullptr;
@@ -279,7 +287,9 @@ PersistentCache::PersistentCache(bool read_only)
     : is_read_only_(read_only),
       cache_directory_(MakeCacheDirectory(cache_base_path_, read_only, false)),
       sksl_cache_directory_(
-          MakeCacheDirectory(cache_base_path_, read_only, true)) {
+          MakeCacheDirectory(cache_base_path_, read_only, true)),
+      pack_(std::make_shared<PersistentCachePack>(cache_directory_)),
+      sksl_pack_(std::make_shared<PersistentCachePack>(sksl_cache_directory_)) {
   if (!IsValid()) {
     FML_LOG(WARNING) << "Could not acquire the persistent cache directory. "
                         "Caching of GPU resources on disk is disabled.";
@@ -332,6 +342,10 @@ sk_sp<SkData> PersistentCache::load(const SkData& key) {
   if (!IsValid()) {
     return nullptr;
   }
+  if (auto result = pack_->Find(key)) {
+    TRACE_EVENT0("flutter", "PersistentCacheLoadHit");
+    return result;
+  }
   auto file_name = SkKeyToFilePath(key);
   if (file_name.empty()) {
     return nullptr;
@@ -371,7 +385,8 @@ static void PersistentCacheStore(
            "frame workload.";
     task();
   } else {
-    worker->PostTask(std::move(task));
+    worker->PostTaskWithGrade(std::move(task),
+                              fml::TaskSourceGrade::kBackground);
   }
 }
 
@@ -403,24 +418,45 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
     return;
   }
 
-  if (!IsValid()) {
+  if (!IsValid() || key.size() == 0) {
     return;
   }
 
-  auto file_name = SkKeyToFilePath(key);
-
-  if (file_name.empty()) {
-    return;
+  const auto& pack = cache_sksl_ ? sksl_pack_ : pack_;
+  if (pack->Add(key, data)) {
+    ScheduleFlush(pack, kMaxFlushDelay);
   }
+}
 
-  std::unique_ptr<fml::MallocMapping> mapping = BuildCacheObject(key, data);
-  if (!mapping) {
+void PersistentCache::FlushPendingEntries() {
+  if (is_read_only_ || !IsValid()) {
     return;
   }
+  for (const auto& pack : {pack_, sksl_pack_}) {
+    if (pack->GetPendingCount() > 0u) {
+      ScheduleFlush(pack, fml::TimeDelta::Zero());
+    }
+  }
+}
 
-  PersistentCacheStore(GetWorkerTaskRunner(),
-                       cache_sksl_ ? sksl_cache_directory_ : cache_directory_,
-                       std::move(file_name), std::move(mapping));
+void PersistentCache::ScheduleFlush(
+    const std::shared_ptr<PersistentCachePack>& pack,
+    fml::TimeDelta delay) const {
+  auto task = [pack]() {
+    if (!pack->Flush()) {
+      FML_LOG(WARNING) << "Could not write cache contents to persistent store.";
+    }
+  };
+  auto worker = GetWorkerTaskRunner();
+  if (!worker) {
+    FML_LOG(WARNING)
+        << "The persistent cache has no available workers. Performing the task "
+           "on the current thread. This slow operation is going to occur on a "
+           "frame workload.";
+    task();
+  } else {
+    worker->PostDelayedTask(task, delay);
+  }
 }
 
 void PersistentCache::DumpSkp(const SkData& data) {
@@ -482,4 +518,18 @@ PersistentCache::GetSkpsFromAssetManager() const {
   return asset_manager_->GetAsMappings(".*\\.skp$", "shaders");
 }
 
+std::string PersistentCache::LoadImpellerPipelineVariants() const {
+  TRACE_EVENT0("flutter", "PersistentCache::LoadImpellerPipelineVariants");
+  if (!asset_manager_) {
+    return "";
+  }
+  auto mapping =
+      asset_manager_->GetAsMapping(kImpellerPipelineVariantsAssetFileName);
+  if (!mapping || mapping->GetMapping() == nullptr) {
+    return "";
+  }
+  return std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                     mapping->GetSize());
+}
+
 }  // namespace flutter
@@ -10,8 +10,10 @@
 #include <set>
 
 #include "flutter/assets/asset_manager.h"
+#include "flutter/common/graphics/persistent_cache_pack.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/unique_fd.h"
 #include "third_party/skia/include/gpu/GrContextOptions.h"
 
@@ -27,6 +29,11 @@ class ShellTest;
 ///
 /// This is mainly used for Shaders but is also written to by Dart.  It is
 /// thread-safe for reading and writing from multiple threads.
+///
+/// New entries are appended to a |PersistentCachePack| in batches, when the
+/// rasterizer is idle or at the latest |kMaxFlushDelay| after they were
+/// stored. Entries stored in files of their own, such as the ones shipped
+/// with read-only caches, are also read.
 class PersistentCache : public GrContextOptions::PersistentCache {
  public:
   // Mutable static switch that can be set before GetCacheForProcess. If true,
@@ -87,6 +94,18 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   // Return whether the purge is successful.
   bool Purge();
 
+  // The longest time entries are kept in memory before they are written to
+  // disk, when the rasterizer isn't idle before then.
+  static constexpr fml::TimeDelta kMaxFlushDelay =
+      fml::TimeDelta::FromSeconds(10);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the stored entries that are not yet on disk, in one
+  ///             batch on a worker task runner. Called when the rasterizer
+  ///             is idle.
+  ///
+  void FlushPendingEntries();
+
   // |GrContextOptions::PersistentCache|
   sk_sp<SkData> load(const SkData& key) override;
 
@@ -116,6 +135,11 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   // Return mappings for all skp's accessible through the AssetManager
   std::vector<std::unique_ptr<fml::Mapping>> GetSkpsFromAssetManager() const;
 
+  /// Load the list of Impeller pipeline variants packaged with the
+  /// application, or an empty string if there is none. The list is dumped
+  /// with the `_flutter.getImpellerPipelineVariants` service protocol.
+  std::string LoadImpellerPipelineVariants() const;
+
   /// Set the asset manager from which PersistentCache can load SkLSs. A nullptr
   /// can be provided to clear the asset manager.
   static void SetAssetManager(std::shared_ptr<AssetManager> value);
@@ -131,6 +155,8 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   static constexpr char kSkSLSubdirName[] = "sksl";
   static constexpr char kAssetFileName[] = "io.flutter.shaders.json";
+  static constexpr char kImpellerPipelineVariantsAssetFileName[] =
+      "io.flutter.impeller_pipelines.txt";
 
  private:
   static std::string cache_base_path_;
@@ -153,6 +179,9 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   const bool is_read_only_;
   const std::shared_ptr<fml::UniqueFD> cache_directory_;
   const std::shared_ptr<fml::UniqueFD> sksl_cache_directory_;
+  // Shared with the flushes posted to the workers.
+  const std::shared_ptr<PersistentCachePack> pack_;
+  const std::shared_ptr<PersistentCachePack> sksl_pack_;
   mutable std::mutex worker_task_runners_mutex_;
   std::multiset<fml::RefPtr<fml::TaskRunner>> worker_task_runners_;
 
@@ -172,6 +201,10 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   fml::RefPtr<fml::TaskRunner> GetWorkerTaskRunner() const;
 
+  // Flushes |pack| on a worker, after |delay|.
+  void ScheduleFlush(const std::shared_ptr<PersistentCachePack>& pack,
+                     fml::TimeDelta delay) const;
+
   friend class testing::ShellTest;
 
   FML_DISALLOW_COPY_AND_ASSIGN(PersistentCache);
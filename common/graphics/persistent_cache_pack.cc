@@ -0,0 +1,231 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/graphics/persistent_cache_pack.h"
+
+#include <cstring>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+uint32_t Checksum(const uint8_t* key,
+                  size_t key_size,
+                  const uint8_t* value,
+                  size_t value_size) {
+  uint32_t hash = 2166136261u;
+  for (const auto& [data, size] : {std::make_pair(key, key_size),
+                                   std::make_pair(value, value_size)}) {
+    for (size_t i = 0; i < size; i++) {
+      hash = (hash ^ data[i]) * 16777619u;
+    }
+  }
+  return hash;
+}
+
+std::string ToIndexKey(const SkData& key) {
+  return std::string(reinterpret_cast<const char*>(key.data()), key.size());
+}
+
+}  // namespace
+
+PersistentCachePack::PersistentCachePack(
+    std::shared_ptr<fml::UniqueFD> directory)
+    : directory_(std::move(directory)) {}
+
+PersistentCachePack::~PersistentCachePack() = default;
+
+void PersistentCachePack::LoadIndexLocked() {
+  TRACE_EVENT0("flutter", "PersistentCachePack::LoadIndex");
+  index_loaded_ = true;
+  mapping_.reset();
+  index_.clear();
+  valid_size_ = 0u;
+  if (!directory_ || !directory_->is_valid()) {
+    return;
+  }
+  auto file = fml::OpenFileReadOnly(*directory_, kFileName);
+  if (!file.is_valid()) {
+    return;
+  }
+  auto mapping = std::make_unique<fml::FileMapping>(file);
+  const uint8_t* bytes = mapping->GetMapping();
+  const size_t size = mapping->GetSize();
+  if (bytes == nullptr || size == 0u) {
+    return;
+  }
+
+  size_t offset = 0u;
+  while (size - offset >= sizeof(RecordHeader)) {
+    RecordHeader header;
+    memcpy(&header, bytes + offset, sizeof(RecordHeader));
+    if (header.signature != RecordHeader::kSignature ||
+        header.version != RecordHeader::kVersion1) {
+      break;
+    }
+    const size_t key_offset = offset + sizeof(RecordHeader);
+    const size_t value_offset = key_offset + header.key_size;
+    if (size - key_offset <
+        static_cast<size_t>(header.key_size) + header.value_size) {
+      break;
+    }
+    if (Checksum(bytes + key_offset, header.key_size, bytes + value_offset,
+                 header.value_size) != header.checksum) {
+      break;
+    }
+    // Later records of a key replace the earlier ones.
+    index_[std::string(reinterpret_cast<const char*>(bytes + key_offset),
+                       header.key_size)] = {.value_offset = value_offset,
+                                            .value_size = header.value_size};
+    offset = value_offset + header.value_size;
+  }
+  if (offset != size) {
+    FML_LOG(INFO) << "Ignoring " << size - offset
+                  << " bytes of incomplete persistent cache records.";
+  }
+  valid_size_ = offset;
+  mapping_ = std::move(mapping);
+}
+
+sk_sp<SkData> PersistentCachePack::Find(const SkData& key) {
+  std::scoped_lock lock(mutex_);
+  const auto index_key = ToIndexKey(key);
+  auto pending = pending_index_.find(index_key);
+  if (pending != pending_index_.end()) {
+    return pending->second;
+  }
+  if (!index_loaded_) {
+    LoadIndexLocked();
+  }
+  auto found = index_.find(index_key);
+  if (found == index_.end() || !mapping_) {
+    return nullptr;
+  }
+  return SkData::MakeWithCopy(
+      mapping_->GetMapping() + found->second.value_offset,
+      found->second.value_size);
+}
+
+std::vector<PersistentCachePack::Entry> PersistentCachePack::GetEntries() {
+  std::scoped_lock lock(mutex_);
+  if (!index_loaded_) {
+    LoadIndexLocked();
+  }
+  std::vector<Entry> entries;
+  entries.reserve(index_.size() + pending_.size());
+  if (mapping_) {
+    for (const auto& [key, record] : index_) {
+      if (pending_index_.count(key) != 0u) {
+        continue;
+      }
+      entries.emplace_back(
+          SkData::MakeWithCopy(key.data(), key.size()),
+          SkData::MakeWithCopy(mapping_->GetMapping() + record.value_offset,
+                               record.value_size));
+    }
+  }
+  entries.insert(entries.end(), pending_.begin(), pending_.end());
+  return entries;
+}
+
+bool PersistentCachePack::Add(const SkData& key, const SkData& value) {
+  std::scoped_lock lock(mutex_);
+  auto index_key = ToIndexKey(key);
+  if (pending_index_.count(index_key) != 0u) {
+    return false;
+  }
+  const bool was_empty = pending_.empty();
+  auto key_data = SkData::MakeWithCopy(key.data(), key.size());
+  auto value_data = SkData::MakeWithCopy(value.data(), value.size());
+  pending_.emplace_back(key_data, value_data);
+  pending_index_[std::move(index_key)] = value_data;
+  return was_empty;
+}
+
+size_t PersistentCachePack::GetPendingCount() const {
+  std::scoped_lock lock(mutex_);
+  return pending_.size();
+}
+
+bool PersistentCachePack::Flush() {
+  std::scoped_lock lock(mutex_);
+  if (pending_.empty()) {
+    return true;
+  }
+  TRACE_EVENT1("flutter", "PersistentCachePack::Flush", "count",
+               std::to_string(pending_.size()).c_str());
+  if (!directory_ || !directory_->is_valid()) {
+    return false;
+  }
+  if (!index_loaded_) {
+    LoadIndexLocked();
+  }
+
+  size_t batch_size = 0u;
+  for (const auto& [key, value] : pending_) {
+    batch_size += sizeof(RecordHeader) + key->size() + value->size();
+  }
+  auto file = fml::OpenFile(*directory_, kFileName, true,
+                            fml::FilePermission::kReadWrite);
+  if (!file.is_valid()) {
+    FML_LOG(WARNING) << "Could not open the persistent cache pack.";
+    return false;
+  }
+  // The mapping must not outlive the truncation of the records it maps.
+  mapping_.reset();
+  const size_t offset = valid_size_;
+  const size_t size = offset + batch_size;
+  if (!fml::TruncateFile(file, size)) {
+    FML_LOG(WARNING) << "Could not grow the persistent cache pack.";
+    index_loaded_ = false;
+    return false;
+  }
+  {
+    fml::FileMapping mapping(file, {fml::FileMapping::Protection::kRead,
+                                    fml::FileMapping::Protection::kWrite});
+    uint8_t* bytes = mapping.GetMutableMapping();
+    if (bytes == nullptr || mapping.GetSize() != size) {
+      FML_LOG(WARNING) << "Could not map the persistent cache pack.";
+      index_loaded_ = false;
+      return false;
+    }
+    size_t write_offset = offset;
+    for (const auto& [key, value] : pending_) {
+      RecordHeader header;
+      header.key_size = key->size();
+      header.value_size = value->size();
+      header.checksum = Checksum(key->bytes(), key->size(), value->bytes(),
+                                 value->size());
+      memcpy(bytes + write_offset, &header, sizeof(RecordHeader));
+      write_offset += sizeof(RecordHeader);
+      memcpy(bytes + write_offset, key->data(), key->size());
+      write_offset += key->size();
+      index_[ToIndexKey(*key)] = {.value_offset = write_offset,
+                                  .value_size = value->size()};
+      memcpy(bytes + write_offset, value->data(), value->size());
+      write_offset += value->size();
+    }
+  }
+  valid_size_ = size;
+  mapping_ = std::make_unique<fml::FileMapping>(file);
+  pending_.clear();
+  pending_index_.clear();
+  return true;
+}
+
+void PersistentCachePack::Reset() {
+  std::scoped_lock lock(mutex_);
+  index_loaded_ = false;
+  mapping_.reset();
+  valid_size_ = 0u;
+  index_.clear();
+  pending_.clear();
+  pending_index_.clear();
+}
+
+}  // namespace flutter
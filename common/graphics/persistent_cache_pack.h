@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_PACK_H_
+#define FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_PACK_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/skia/include/core/SkData.h"
+
+namespace flutter {
+
+/// The entries of a |PersistentCache| directory, packed into a single file.
+///
+/// The file is a sequence of records, each a header followed by the key and
+/// the value of an entry. New entries are queued in memory and appended in
+/// batches by |Flush|, so that a burst of shader compilations costs one
+/// write. The index of the records is built by walking their headers in a
+/// single mapping of the file, the first time an entry is looked up.
+///
+/// A record that was not completely written, because the process died while
+/// appending it, fails its checksum. It and the records after it are ignored,
+/// and overwritten by the next append.
+///
+/// Thread safe.
+class PersistentCachePack {
+ public:
+  static constexpr char kFileName[] = "entries.pack";
+
+  struct RecordHeader {
+    static const uint32_t kSignature = 0xA869594F;
+    static const uint32_t kVersion1 = 1;
+
+    uint32_t signature = kSignature;
+    uint32_t version = kVersion1;
+    uint32_t key_size = 0;
+    uint32_t value_size = 0;
+    // The FNV-1a hash of the key and the value.
+    uint32_t checksum = 0;
+  };
+
+  using Entry = std::pair<sk_sp<SkData>, sk_sp<SkData>>;
+
+  explicit PersistentCachePack(std::shared_ptr<fml::UniqueFD> directory);
+
+  ~PersistentCachePack();
+
+  /// The value of the entry with the key, or null if there is none.
+  sk_sp<SkData> Find(const SkData& key);
+
+  /// All the entries, including those not yet flushed.
+  std::vector<Entry> GetEntries();
+
+  /// Queues an entry to be appended by the next |Flush|.
+  ///
+  /// @return  Whether the queue was empty, in which case the caller should
+  ///          schedule a flush.
+  bool Add(const SkData& key, const SkData& value);
+
+  /// The number of entries waiting for a |Flush|.
+  size_t GetPendingCount() const;
+
+  /// Appends the queued entries to the file. Blocks on the file system, and
+  /// should be called on a worker thread.
+  ///
+  /// @return  Whether the entries were written.
+  bool Flush();
+
+  /// Forgets the entries read from the file, and drops the queued entries.
+  /// Called after the files of the cache directory are removed.
+  void Reset();
+
+ private:
+  struct Record {
+    size_t value_offset = 0u;
+    size_t value_size = 0u;
+  };
+
+  const std::shared_ptr<fml::UniqueFD> directory_;
+  mutable std::mutex mutex_;
+  bool index_loaded_ = false;
+  std::unique_ptr<fml::FileMapping> mapping_;
+  // The size of the leading records of the file that are valid.
+  size_t valid_size_ = 0u;
+  std::unordered_map<std::string, Record> index_;
+  std::vector<Entry> pending_;
+  std::unordered_map<std::string, sk_sp<SkData>> pending_index_;
+
+  void LoadIndexLocked();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PersistentCachePack);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_PACK_H_
@@ -17,6 +17,7 @@
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/closure.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/unique_fd.h"
 
@@ -38,7 +39,20 @@ class FrameTiming {
       kVsyncStart,  kBuildStart,   kBuildFinish,
       kRasterStart, kRasterFinish, kRasterFinishWallTime};
 
-  static constexpr int kStatisticsCount = kCount + 5;
+  static constexpr int kStatisticsCount = kCount + 8;
+
+  /// Counts of the content rasterized in a frame, to correlate its timings
+  /// with.
+  struct Complexity {
+    /// The layers in the layer trees of the frame.
+    size_t layer_count = 0;
+    /// The ops of the display lists of those layers, including the ops of
+    /// nested display lists.
+    size_t display_list_op_count = 0;
+    /// The subpasses that Impeller rendered to offscreen textures, which is
+    /// zero for Skia.
+    size_t offscreen_pass_count = 0;
+  };
 
   fml::TimePoint Get(Phase phase) const { return data_[phase]; }
   fml::TimePoint Set(Phase phase, fml::TimePoint value) {
@@ -51,6 +65,18 @@ class FrameTiming {
   uint64_t GetLayerCacheBytes() const { return layer_cache_bytes_; }
   uint64_t GetPictureCacheCount() const { return picture_cache_count_; }
   uint64_t GetPictureCacheBytes() const { return picture_cache_bytes_; }
+  /// The GPU time of the most recent frame measured by the GPU tracer when
+  /// this frame was rasterized, which is zero if GPU tracing is unavailable.
+  fml::TimeDelta GetGPUTime() const { return gpu_time_; }
+  void SetGPUTime(fml::TimeDelta gpu_time) { gpu_time_ = gpu_time; }
+  /// The number of frames in flight in the pipeline, including this one, when
+  /// this frame was rasterized.
+  uint32_t GetPipelineDepth() const { return pipeline_depth_; }
+  void SetPipelineDepth(uint32_t depth) { pipeline_depth_ = depth; }
+  const Complexity& GetComplexity() const { return complexity_; }
+  void SetComplexity(const Complexity& complexity) {
+    complexity_ = complexity;
+  }
   void SetRasterCacheStatistics(size_t layer_cache_count,
                                 size_t layer_cache_bytes,
                                 size_t picture_cache_count,
@@ -68,6 +94,9 @@ class FrameTiming {
   size_t layer_cache_bytes_;
   size_t picture_cache_count_;
   size_t picture_cache_bytes_;
+  fml::TimeDelta gpu_time_;
+  uint32_t pipeline_depth_ = 0;
+  Complexity complexity_;
 };
 
 using TaskObserverAdd =
@@ -88,6 +117,8 @@ using MappingsCallback = std::function<Mappings(void)>;
 
 using FrameRasterizedCallback = std::function<void(const FrameTiming&)>;
 
+using JankCaptureCallback = std::function<void(const std::string& path)>;
+
 class DartIsolate;
 
 // TODO(https://github.com/flutter/flutter/issues/138750): Re-order fields to
@@ -140,6 +171,12 @@ struct Settings {
   MappingsCallback application_kernels;
 
   std::string temp_directory_path;
+  // Path to the snapshot page profile that is prefetched when the VM starts
+  // and recorded after the first frame if it doesn't exist yet. The profile
+  // is only valid for the snapshots it was recorded with, so it should live
+  // in a directory that is specific to the application version. Empty to
+  // disable.
+  std::string snapshot_page_profile_path;
   std::vector<std::string> dart_flags;
   // Isolate settings
   bool enable_checked_mode = false;
@@ -150,6 +187,19 @@ struct Settings {
   bool trace_startup = false;
   bool trace_systrace = false;
   std::string trace_to_file;
+  // The directory to which the first frames drawn by the rasterizer are
+  // written as serialized display lists, to be replayed by the display list
+  // replay benchmarks. Empty to disable.
+  std::string capture_display_lists_path;
+  // The directory to which jank captures are written when a frame takes
+  // longer than |jank_capture_threshold_ms|. A capture is a Perfetto trace of
+  // the trace ring buffer, the timings of the recent frames and the stats of
+  // the rasterizer's caches. Setting it enables recording trace events into
+  // the ring buffer. Empty to disable.
+  std::string jank_capture_path;
+  // The time from the start of the build to the end of the rasterization of a
+  // frame past which the frame is captured, or 0 for twice the frame budget.
+  double jank_capture_threshold_ms = 0.0;
   bool enable_timeline_event_handler = true;
   bool dump_skp_on_shader_compilation = false;
   bool cache_sksl = false;
@@ -210,6 +260,10 @@ struct Settings {
   // manager before creating the engine.
   bool prefetched_default_font_manager = false;
 
+  // Creates the default font manager on a concurrent worker while the shell
+  // and the root isolate start up, instead of on the UI thread.
+  bool enable_concurrent_startup = false;
+
   // Enable the rendering of colors outside of the sRGB gamut.
   bool enable_wide_gamut = false;
 
@@ -228,6 +282,55 @@ struct Settings {
   // must be available to the application.
   bool enable_vulkan_validation = false;
 
+  // Present the frames of the Impeller Vulkan backend on Android through
+  // surface control transactions of hardware buffers instead of a swapchain
+  // on the window. Ignored before Android 10 (API 29).
+  bool enable_surface_control = false;
+
+  // Compile the shaders and pipelines of runtime effects without blocking the
+  // raster thread, and skip drawing the effects until they are ready.
+  // Only supported with Impeller.
+  bool enable_async_runtime_effect_pipelines = false;
+
+  // Anti-alias solid filled rects, rrects, ovals, circles and lines in the
+  // fragment stage, and render save layers that only contain such draws
+  // without multisampling. Only supported with Impeller.
+  bool enable_impeller_analytic_antialiasing = false;
+
+  // Fill complex solid paths by drawing triangle fans into the stencil buffer
+  // and covering their bounds instead of triangulating them. Only supported
+  // with Impeller.
+  bool enable_impeller_stencil_then_cover = false;
+
+  // Preroll and paint the children of wide container layers on the concurrent
+  // worker threads instead of only on the raster thread.
+  bool enable_parallel_layer_tree_traversal = false;
+
+  // Adapt the depth of the frame pipeline and when frames start building to
+  // the timings of the last rasterized frames.
+  bool enable_deadline_aware_frame_scheduling = false;
+
+  // Move the UI and raster threads to the performance cores while frames are
+  // being produced and to the efficiency cores while the engine is idle.
+  bool enable_workload_thread_affinity = false;
+
+  // Run the raster thread with a realtime scheduling policy where the platform
+  // supports it. Only used by the embedder on Linux.
+  bool enable_realtime_raster_thread = false;
+
+  // Dispatch the pointer events received between two frames in a single packet
+  // before the next frame is built.
+  bool enable_pointer_event_coalescing = false;
+
+  // Coalesce the pointer events, and replace the moves of each pointer within
+  // a frame with a single move resampled at the target time of the frame.
+  bool enable_pointer_event_resampling = false;
+
+  // Lower the quality of blurs and cache pictures sooner while the raster
+  // thread keeps missing the frame budget, and restore them once it has
+  // caught up for a while.
+  bool enable_adaptive_quality = false;
+
   // Enable GPU tracing in GLES backends.
   // Some devices claim to support the required APIs but crash on their usage.
   bool enable_opengl_gpu_tracing = false;
@@ -292,6 +395,9 @@ struct Settings {
   LogMessageCallback log_message_callback;
   bool enable_software_rendering = false;
   bool skia_deterministic_rendering_on_cpu = false;
+  // Whether the Skia backend draws consecutive images that share their
+  // sampling and paint with a single image set, to create fewer GPU ops.
+  bool skia_batch_image_draws = false;
   bool verbose_logging = false;
   std::string log_tag = "flutter";
 
@@ -312,6 +418,10 @@ struct Settings {
   // soon as a frame is rasterized.
   FrameRasterizedCallback frame_rasterized_callback;
 
+  // Callback invoked on the IO thread with the path of each jank capture
+  // written to |jank_capture_path|, so that embedders can upload it.
+  JankCaptureCallback jank_capture_callback;
+
   // This data will be available to the isolate immediately on launch via the
   // PlatformDispatcher.getPersistentIsolateData callback. This is meant for
   // information that the isolate cannot request asynchronously (platform
@@ -330,6 +440,40 @@ struct Settings {
   // Max bytes threshold of resource cache, or 0 for unlimited.
   size_t resource_cache_max_bytes_threshold = 0;
 
+  // The resident memory of the process past which the shell acts as if the
+  // system sent a low memory warning, running the Dart GC and trimming the
+  // caches, or 0 to only do so on the warnings of the system.
+  size_t resident_memory_warning_bytes = 0;
+
+  // The number of threads, in addition to the IO thread, that upload decoded
+  // images to the GPU with resource contexts of their own. Only used with
+  // Skia on platforms that can create more than one resource context.
+  size_t resource_upload_thread_count = 0;
+
+  // The number of frames of animated images to decode on the concurrent worker
+  // threads ahead of the requests of the framework, or 0 to decode each frame
+  // on the IO thread when it is requested.
+  size_t animated_image_frame_lookahead = 0;
+
+  // The max bytes of the frames decoded ahead for each animated image. Fewer
+  // frames are decoded ahead for images too large for this budget.
+  size_t animated_image_lookahead_max_bytes = 16 * 1024 * 1024;
+
+  // Whether the textures of decoded images that are not drawn may be released
+  // on low memory warnings, and decoded again when they are drawn. Only
+  // supported with Impeller.
+  bool enable_image_texture_purging = false;
+
+  // The max bytes of the textures of decoded images when
+  // |enable_image_texture_purging| is set, or 0 to only release them on low
+  // memory warnings. Images drawn in the last second are never released.
+  size_t image_texture_cache_max_bytes = 0;
+
+  // Whether decoded images are uploaded without their mip levels, which are
+  // then generated the first time the images are drawn at a minifying scale
+  // with a mipmap filter. Only supported with Impeller.
+  bool enable_lazy_image_mipmaps = false;
+
   /// The minimum number of samples to require in multipsampled anti-aliasing.
   ///
   /// Setting this value to 0 or 1 disables MSAA.
@@ -253,10 +253,83 @@ void RunIntersectsSingleRectBenchmark(benchmark::State& state, int maxSize) {
   }
 }
 
+// Builds a region of vertical stripes, which produces span lines with many
+// spans. This is the case the vectorized span skipping in DlRegion targets.
+std::vector<SkIRect> GenerateStripes(int32_t left,
+                                     int32_t right,
+                                     int32_t stripe_width,
+                                     int32_t stripe_gap) {
+  std::vector<SkIRect> rects;
+  for (int32_t x = left; x + stripe_width <= right;
+       x += stripe_width + stripe_gap) {
+    rects.push_back(SkIRect::MakeLTRB(x, 0, x + stripe_width, 1000));
+  }
+  return rects;
+}
+
+template <typename Region>
+void RunSpanHeavyOpBenchmark(benchmark::State& state,
+                             RegionOp op,
+                             double overlapFactor) {
+  Region region1(GenerateStripes(0, 4000, 2, 2));
+  // The second region only overlaps the right hand side of the first, so most
+  // spans of the first region are skipped.
+  auto left = static_cast<int32_t>(4000 * (1.0 - overlapFactor));
+  Region region2(GenerateStripes(left, 4000, 3, 5));
+
+  switch (op) {
+    case kUnion:
+      while (state.KeepRunning()) {
+        Region::unionRegions(region1, region2);
+      }
+      break;
+    case kIntersection:
+      while (state.KeepRunning()) {
+        Region::intersectRegions(region1, region2);
+      }
+      break;
+  }
+}
+
+template <typename Region>
+void RunSpanHeavyIntersectsBenchmark(benchmark::State& state) {
+  Region region(GenerateStripes(0, 4000, 2, 2));
+  std::vector<SkIRect> rects;
+  for (int32_t x = 0; x < 4000; x += 37) {
+    rects.push_back(SkIRect::MakeXYWH(x, 500, 1, 1));
+  }
+
+  while (state.KeepRunning()) {
+    for (auto& rect : rects) {
+      region.intersects(rect);
+    }
+  }
+}
+
 }  // namespace
 
 namespace flutter {
 
+static void BM_DlRegion_SpanHeavyOperation(benchmark::State& state,
+                                           RegionOp op,
+                                           double overlapFactor) {
+  RunSpanHeavyOpBenchmark<DlRegionAdapter>(state, op, overlapFactor);
+}
+
+static void BM_SkRegion_SpanHeavyOperation(benchmark::State& state,
+                                           RegionOp op,
+                                           double overlapFactor) {
+  RunSpanHeavyOpBenchmark<SkRegionAdapter>(state, op, overlapFactor);
+}
+
+static void BM_DlRegion_SpanHeavyIntersects(benchmark::State& state) {
+  RunSpanHeavyIntersectsBenchmark<DlRegionAdapter>(state);
+}
+
+static void BM_SkRegion_SpanHeavyIntersects(benchmark::State& state) {
+  RunSpanHeavyIntersectsBenchmark<SkRegionAdapter>(state);
+}
+
 static void BM_DlRegion_FromRects(benchmark::State& state, int maxSize) {
   RunFromRectsBenchmark<DlRegionAdapter>(state, maxSize);
 }
@@ -709,4 +782,38 @@ BENCHMARK_CAPTURE(BM_DlRegion_GetRects, Large, 1500)
 BENCHMARK_CAPTURE(BM_SkRegion_GetRects, Large, 1500)
     ->Unit(benchmark::kMicrosecond);
 
-}  // namespace flutter
\ No newline at end of file
+BENCHMARK_CAPTURE(BM_DlRegion_SpanHeavyOperation,
+                  Union_Quarter,
+                  RegionOp::kUnion,
+                  0.25)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_SpanHeavyOperation,
+                  Union_Quarter,
+                  RegionOp::kUnion,
+                  0.25)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_SpanHeavyOperation,
+                  Intersection_Quarter,
+                  RegionOp::kIntersection,
+                  0.25)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_SpanHeavyOperation,
+                  Intersection_Quarter,
+                  RegionOp::kIntersection,
+                  0.25)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_SpanHeavyOperation,
+                  Intersection_Full,
+                  RegionOp::kIntersection,
+                  1.0)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_SpanHeavyOperation,
+                  Intersection_Full,
+                  RegionOp::kIntersection,
+                  1.0)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_DlRegion_SpanHeavyIntersects)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_SkRegion_SpanHeavyIntersects)->Unit(benchmark::kNanosecond);
+
+}  // namespace flutter
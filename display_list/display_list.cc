@@ -2,10 +2,12 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <type_traits>
 
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_op_records.h"
+#include "flutter/display_list/geometry/dl_region.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -19,33 +21,39 @@ DisplayList::DisplayList()
       op_count_(0),
       nested_byte_count_(0),
       nested_op_count_(0),
+      compacted_bytes_(0),
       unique_id_(0),
       bounds_({0, 0, 0, 0}),
       can_apply_group_opacity_(true),
       is_ui_thread_safe_(true),
       modifies_transparent_black_(false) {}
 
-DisplayList::DisplayList(DisplayListStorage&& storage,
-                         size_t byte_count,
-                         unsigned int op_count,
-                         size_t nested_byte_count,
-                         unsigned int nested_op_count,
-                         const SkRect& bounds,
-                         bool can_apply_group_opacity,
-                         bool is_ui_thread_safe,
-                         bool modifies_transparent_black,
-                         sk_sp<const DlRTree> rtree)
+DisplayList::DisplayList(
+    DisplayListStorage&& storage,
+    size_t byte_count,
+    unsigned int op_count,
+    size_t nested_byte_count,
+    unsigned int nested_op_count,
+    const SkRect& bounds,
+    bool can_apply_group_opacity,
+    bool is_ui_thread_safe,
+    bool modifies_transparent_black,
+    sk_sp<const DlRTree> rtree,
+    size_t compacted_bytes,
+    std::unique_ptr<const DlOcclusionRecord> occlusion_record)
     : storage_(std::move(storage)),
       byte_count_(byte_count),
       op_count_(op_count),
       nested_byte_count_(nested_byte_count),
       nested_op_count_(nested_op_count),
+      compacted_bytes_(compacted_bytes),
       unique_id_(next_unique_id()),
       bounds_(bounds),
       can_apply_group_opacity_(can_apply_group_opacity),
       is_ui_thread_safe_(is_ui_thread_safe),
       modifies_transparent_black_(modifies_transparent_black),
-      rtree_(std::move(rtree)) {}
+      rtree_(std::move(rtree)),
+      occlusion_record_(std::move(occlusion_record)) {}
 
 DisplayList::~DisplayList() {
   uint8_t* ptr = storage_.get();
@@ -166,6 +174,152 @@ void DisplayList::Dispatch(DlOpReceiver& receiver,
   Dispatch(receiver, ptr, ptr + byte_count_, culler);
 }
 
+void DisplayList::Dispatch(DlOpReceiver& receiver,
+                           const std::vector<int>& rtree_indices) const {
+  const DlRTree* rtree = this->rtree().get();
+  FML_DCHECK(rtree != nullptr);
+  FML_DCHECK(std::is_sorted(rtree_indices.begin(), rtree_indices.end()));
+  uint8_t* ptr = storage_.get();
+  VectorCuller culler(rtree, rtree_indices);
+  Dispatch(receiver, ptr, ptr + byte_count_, culler);
+}
+
+void DisplayList::DispatchUnoccluded(DlOpReceiver& receiver,
+                                     const SkIRect& cull_rect) const {
+  if (!has_rtree() || !occlusion_record_) {
+    Dispatch(receiver, cull_rect);
+    return;
+  }
+  std::call_once(occlusion_once_, [this]() { ComputeOcclusion(); });
+  if (occluded_rtree_indices_.empty()) {
+    Dispatch(receiver, cull_rect);
+    return;
+  }
+  SkRect cull = SkRect::Make(cull_rect);
+  if (cull.isEmpty()) {
+    return;
+  }
+  const DlRTree* rtree = this->rtree().get();
+  std::vector<int> rect_indices;
+  rtree->search(cull, &rect_indices);
+  rect_indices.erase(
+      std::remove_if(rect_indices.begin(), rect_indices.end(),
+                     [this](int index) {
+                       return std::binary_search(
+                           occluded_rtree_indices_.begin(),
+                           occluded_rtree_indices_.end(), index);
+                     }),
+      rect_indices.end());
+  uint8_t* ptr = storage_.get();
+  VectorCuller culler(rtree, rect_indices);
+  Dispatch(receiver, ptr, ptr + byte_count_, culler);
+}
+
+const DisplayList::OcclusionStatistics& DisplayList::occlusion_statistics()
+    const {
+  if (has_rtree() && occlusion_record_) {
+    std::call_once(occlusion_once_, [this]() { ComputeOcclusion(); });
+  }
+  return occlusion_statistics_;
+}
+
+void DlOcclusionRecord::remap_indices(const std::vector<int>& index_map) {
+  auto remap = [&index_map](int& index) {
+    if (index >= 0 && static_cast<size_t>(index) < index_map.size()) {
+      index = index_map[index];
+    }
+  };
+  for (Occluder& occluder : occluders) {
+    remap(occluder.op_index);
+  }
+  for (int& barrier : barriers) {
+    remap(barrier);
+  }
+  for (auto& [first, last] : layer_ranges) {
+    remap(first);
+    remap(last);
+  }
+}
+
+void DisplayList::ComputeOcclusion() const {
+  TRACE_EVENT0("flutter", "DisplayList::ComputeOcclusion");
+  const DlRTree& rtree = *rtree_;
+  const DlOcclusionRecord& record = *occlusion_record_;
+  if (record.occluders.empty()) {
+    return;
+  }
+
+  // Visit the rects from the last op to the first, accumulating the area
+  // covered by the opaque ops that follow the op of each rect.
+  std::vector<int> leaves(rtree.leaf_count());
+  for (int i = 0; i < rtree.leaf_count(); i++) {
+    leaves[i] = i;
+  }
+  std::stable_sort(leaves.begin(), leaves.end(), [&rtree](int a, int b) {
+    return rtree.id(a) > rtree.id(b);
+  });
+
+  auto is_in_layer = [&record](int op_index) {
+    for (const auto& [first, last] : record.layer_ranges) {
+      if (op_index > first && op_index <= last) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  DlRegion covered;
+  auto occluder = record.occluders.rbegin();
+  auto barrier = record.barriers.rbegin();
+  int current_id = -1;
+  bool current_op_occluded = false;
+  for (int leaf : leaves) {
+    const int id = rtree.id(leaf);
+    if (id != current_id) {
+      if (current_id >= 0 && current_op_occluded) {
+        occlusion_statistics_.occluded_op_count++;
+      }
+      current_id = id;
+      current_op_occluded = true;
+    }
+    while (true) {
+      bool next_is_occluder = occluder != record.occluders.rend() &&
+                              occluder->op_index > id;
+      bool next_is_barrier =
+          barrier != record.barriers.rend() && *barrier > id;
+      if (next_is_barrier &&
+          (!next_is_occluder || *barrier > occluder->op_index)) {
+        covered = DlRegion();
+        ++barrier;
+      } else if (next_is_occluder) {
+        covered = DlRegion::MakeUnion(covered, DlRegion(occluder->device_rect));
+        ++occluder;
+      } else {
+        break;
+      }
+    }
+    SkIRect bounds = rtree.bounds(leaf).roundOut();
+    bool occluded = !covered.isEmpty() && !is_in_layer(id) &&
+                    covered.bounds().contains(bounds);
+    if (occluded) {
+      DlRegion visible =
+          DlRegion::MakeIntersection(covered, DlRegion(bounds));
+      occluded = visible.isSimple() && visible.bounds() == bounds;
+    }
+    if (occluded) {
+      occluded_rtree_indices_.push_back(leaf);
+      occlusion_statistics_.occluded_area +=
+          static_cast<double>(bounds.width()) * bounds.height();
+    } else {
+      current_op_occluded = false;
+    }
+  }
+  if (current_id >= 0 && current_op_occluded) {
+    occlusion_statistics_.occluded_op_count++;
+  }
+  std::sort(occluded_rtree_indices_.begin(), occluded_rtree_indices_.end());
+}
+
 void DisplayList::Dispatch(DlOpReceiver& receiver,
                            uint8_t* ptr,
                            uint8_t* end,
@@ -300,6 +454,216 @@ static bool CompareOps(uint8_t* ptrA,
   return true;
 }
 
+static bool IsRenderingOp(DisplayListOpType type) {
+  return type >= DisplayListOpType::kDrawPaint &&
+         type <= DisplayListOpType::kDrawShadowTransparentOccluder;
+}
+
+// Compares two ops like |CompareOps|, except that the restore index of
+// save ops, which depends on the number of ops they enclose, is ignored.
+static bool OpsAreEquivalent(const DLOp* opA, const DLOp* opB) {
+  if (opA->type != opB->type || opA->size != opB->size) {
+    return false;
+  }
+  if (opA->type == DisplayListOpType::kSave ||
+      opA->type == DisplayListOpType::kSaveLayer) {
+    return static_cast<const SaveOpBase*>(opA)->options ==
+           static_cast<const SaveOpBase*>(opB)->options;
+  }
+  if (opA->type == DisplayListOpType::kSaveLayerBounds) {
+    auto layerA = static_cast<const SaveLayerBoundsOp*>(opA);
+    auto layerB = static_cast<const SaveLayerBoundsOp*>(opB);
+    return layerA->options == layerB->options && layerA->rect == layerB->rect;
+  }
+  DisplayListCompare result;
+  switch (opA->type) {
+#define DL_OP_EQUALS(name)                              \
+  case DisplayListOpType::k##name:                      \
+    result = static_cast<const name##Op*>(opA)->equals( \
+        static_cast<const name##Op*>(opB));             \
+    break;
+
+      FOR_EACH_DISPLAY_LIST_OP(DL_OP_EQUALS)
+#ifdef IMPELLER_ENABLE_3D
+      DL_OP_EQUALS(SetSceneColorSource)
+#endif  // IMPELLER_ENABLE_3D
+
+#undef DL_OP_EQUALS
+
+    default:
+      FML_DCHECK(false);
+      return false;
+  }
+  switch (result) {
+    case DisplayListCompare::kNotEqual:
+      return false;
+    case DisplayListCompare::kUseBulkCompare:
+      return memcmp(opA, opB, opA->size) == 0;
+    case DisplayListCompare::kEqual:
+      return true;
+  }
+  FML_UNREACHABLE();
+}
+
+static bool IsSaveLayerOp(DisplayListOpType type) {
+  return type == DisplayListOpType::kSaveLayer ||
+         type == DisplayListOpType::kSaveLayerBounds ||
+         type == DisplayListOpType::kSaveLayerBackdrop ||
+         type == DisplayListOpType::kSaveLayerBackdropBounds;
+}
+
+std::optional<SkRect> DisplayList::ComputeChangedBounds(
+    const DisplayList& other) const {
+  if (!has_rtree() || !other.has_rtree()) {
+    return std::nullopt;
+  }
+  if (this == &other || storage_.get() == other.storage_.get()) {
+    return SkRect::MakeEmpty();
+  }
+
+  auto collect_ops = [](const DisplayList& list) {
+    std::vector<const DLOp*> ops;
+    uint8_t* ptr = list.storage_.get();
+    uint8_t* end = ptr + list.byte_count_;
+    while (ptr < end) {
+      auto op = reinterpret_cast<const DLOp*>(ptr);
+      ptr += op->size;
+      ops.push_back(op);
+    }
+    return ops;
+  };
+  std::vector<const DLOp*> opsA = collect_ops(*this);
+  std::vector<const DLOp*> opsB = collect_ops(other);
+
+  // Skip the ops both lists start and end with. The saves that are open at
+  // the first changed op are tracked, as layers may spread the changes of
+  // their contents.
+  const size_t common = std::min(opsA.size(), opsB.size());
+  size_t prefix = 0;
+  std::vector<size_t> open_saves;
+  while (prefix < common && OpsAreEquivalent(opsA[prefix], opsB[prefix])) {
+    if (opsA[prefix]->type == DisplayListOpType::kSave ||
+        IsSaveLayerOp(opsA[prefix]->type)) {
+      open_saves.push_back(prefix);
+    } else if (opsA[prefix]->type == DisplayListOpType::kRestore &&
+               !open_saves.empty()) {
+      open_saves.pop_back();
+    }
+    prefix++;
+  }
+  size_t suffix = 0;
+  while (prefix + suffix < common &&
+         OpsAreEquivalent(opsA[opsA.size() - 1 - suffix],
+                          opsB[opsB.size() - 1 - suffix])) {
+    suffix++;
+  }
+  size_t endA = opsA.size() - suffix;
+  size_t endB = opsB.size() - suffix;
+
+  // The ops that follow the changed ops are rendered with the same
+  // transform and clip only if the changed ops save, transform and clip in
+  // the same way. A layer that isn't restored within the changed ops is
+  // composited with some of the following ops, which would change as well.
+  auto is_state_op = [](const DLOp* op) {
+    return !IsRenderingOp(op->type) && GetAttributeSlot(op->type) < 0;
+  };
+  for (size_t a = prefix, b = prefix;; a++, b++) {
+    while (a < endA && !is_state_op(opsA[a])) {
+      a++;
+    }
+    while (b < endB && !is_state_op(opsB[b])) {
+      b++;
+    }
+    if (a == endA || b == endB) {
+      if (a != endA || b != endB) {
+        return std::nullopt;
+      }
+      break;
+    }
+    if (!OpsAreEquivalent(opsA[a], opsB[b])) {
+      return std::nullopt;
+    }
+    if (IsSaveLayerOp(opsA[a]->type) &&
+        (static_cast<const SaveOpBase*>(opsA[a])->restore_index >=
+             static_cast<int>(endA) ||
+         static_cast<const SaveOpBase*>(opsB[b])->restore_index >=
+             static_cast<int>(endB))) {
+      return std::nullopt;
+    }
+  }
+
+  // The following ops that render with attributes that differ after the
+  // changed ops, until they are all set again, are changed as well.
+  auto last_attributes = [](const std::vector<const DLOp*>& ops, size_t end) {
+    std::vector<const DLOp*> attributes(kAttributeSlotCount, nullptr);
+    for (size_t i = 0; i < end; i++) {
+      int slot = GetAttributeSlot(ops[i]->type);
+      if (slot >= 0) {
+        attributes[slot] = ops[i];
+      }
+    }
+    return attributes;
+  };
+  std::vector<const DLOp*> attributesA = last_attributes(opsA, endA);
+  std::vector<const DLOp*> attributesB = last_attributes(opsB, endB);
+  uint32_t changed_attributes = 0u;
+  for (int slot = 0; slot < kAttributeSlotCount; slot++) {
+    const DLOp* attributeA = attributesA[slot];
+    const DLOp* attributeB = attributesB[slot];
+    if (attributeA != attributeB &&
+        (!attributeA || !attributeB ||
+         !OpsAreEquivalent(attributeA, attributeB))) {
+      changed_attributes |= 1u << slot;
+    }
+  }
+  size_t changed_suffix = 0u;
+  for (size_t i = endA; i < opsA.size() && changed_attributes != 0u; i++) {
+    int slot = GetAttributeSlot(opsA[i]->type);
+    if (slot >= 0) {
+      changed_attributes &= ~(1u << slot);
+    } else if (IsSaveLayerOp(opsA[i]->type)) {
+      return std::nullopt;
+    } else if (IsRenderingOp(opsA[i]->type)) {
+      changed_suffix = i + 1 - endA;
+    }
+  }
+  endA += changed_suffix;
+  endB += changed_suffix;
+
+  SkRect changed_bounds = SkRect::MakeEmpty();
+  auto add_changed_bounds = [&changed_bounds, &open_saves, prefix](
+                                const DisplayList& list,
+                                const std::vector<const DLOp*>& ops,
+                                size_t end) {
+    size_t begin = prefix;
+    // A layer may spread its contents with an image filter, so the whole
+    // outermost layer around the changes is changed.
+    for (size_t save_index : open_saves) {
+      if (IsSaveLayerOp(ops[save_index]->type)) {
+        begin = save_index;
+        break;
+      }
+    }
+    // Unbounded layers are accumulated at the index after their restore.
+    for (size_t i = begin; i < end && i < ops.size(); i++) {
+      if (IsSaveLayerOp(ops[i]->type)) {
+        auto layer = static_cast<const SaveOpBase*>(ops[i]);
+        end = std::max(end, static_cast<size_t>(layer->restore_index) + 2u);
+      }
+    }
+    const DlRTree* rtree = list.rtree_.get();
+    for (int i = 0; i < rtree->leaf_count(); i++) {
+      const int index = rtree->id(i);
+      if (index >= static_cast<int>(begin) && index < static_cast<int>(end)) {
+        changed_bounds.join(rtree->bounds(i));
+      }
+    }
+  };
+  add_changed_bounds(*this, opsA, endA);
+  add_changed_bounds(other, opsB, endB);
+  return changed_bounds;
+}
+
 bool DisplayList::Equals(const DisplayList* other) const {
   if (this == other) {
     return true;
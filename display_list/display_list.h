@@ -6,7 +6,10 @@
 #define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_H_
 
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include "flutter/display_list/dl_sampling_options.h"
 #include "flutter/display_list/geometry/dl_rtree.h"
@@ -225,6 +228,33 @@ class DisplayListStorage {
 
 class Culler;
 
+// The opaque rendering ops recorded into a DisplayList, along with the ops
+// that limit which of the earlier ops they may cover, from which the
+// DisplayList computes the ops that never contribute to its rendering.
+struct DlOcclusionRecord {
+  struct Occluder {
+    // The index of the op.
+    int op_index;
+    // The device space pixels that the op replaces with opaque colors.
+    SkIRect device_rect;
+  };
+
+  // Ordered by op index.
+  std::vector<Occluder> occluders;
+
+  // The indices of the saveLayer ops with backdrop filters, which read the
+  // rendering of the ops before them, so those ops are never occluded by
+  // the ops that follow.
+  std::vector<int> barriers;
+
+  // The inclusive ranges of op indices of the outermost saveLayers, from
+  // the saveLayer op to its restore op. The ops within a layer are never
+  // considered occluded.
+  std::vector<std::pair<int, int>> layer_ranges;
+
+  void remap_indices(const std::vector<int>& index_map);
+};
+
 // The base class that contains a sequence of rendering operations
 // for dispatch to a DlOpReceiver. These objects must be instantiated
 // through an instance of DisplayListBuilder::build().
@@ -238,6 +268,24 @@ class DisplayList : public SkRefCnt {
   void Dispatch(DlOpReceiver& ctx, const SkRect& cull_rect) const;
   void Dispatch(DlOpReceiver& ctx, const SkIRect& cull_rect) const;
 
+  /// @brief     Dispatches only the rendering ops whose rects in the |rtree|
+  ///            are listed in |rtree_indices|, in numerical order, along with
+  ///            the attribute, transform, clip and save ops that apply to
+  ///            them.
+  ///
+  /// @see       DlRTree::searchAndPartition
+  void Dispatch(DlOpReceiver& ctx, const std::vector<int>& rtree_indices) const;
+
+  /// @brief     Dispatches the rendering ops that intersect |cull_rect| like
+  ///            |Dispatch|, except for the ops that are completely covered by
+  ///            opaque ops that follow them.
+  ///
+  /// Ops are only found to be occluded in a DisplayList with an RTree. The
+  /// occluded ops are computed on first use and retained.
+  ///
+  /// @see       DisplayListBuilder::Build
+  void DispatchUnoccluded(DlOpReceiver& ctx, const SkIRect& cull_rect) const;
+
   // From historical behavior, SkPicture always included nested bytes,
   // but nested ops are only included if requested. The defaults used
   // here for these accessors follow that pattern.
@@ -250,6 +298,13 @@ class DisplayList : public SkRefCnt {
     return op_count_ + (nested ? nested_op_count_ : 0);
   }
 
+  /// @brief     The number of bytes of redundant ops that were removed from
+  ///            the op stream when this DisplayList was built with
+  ///            compaction, or 0 if it was built without.
+  ///
+  /// @see       DisplayListBuilder::Build
+  size_t compacted_bytes() const { return compacted_bytes_; }
+
   uint32_t unique_id() const { return unique_id_; }
 
   const SkRect& bounds() const { return bounds_; }
@@ -263,6 +318,36 @@ class DisplayList : public SkRefCnt {
     return Equals(other.get());
   }
 
+  /// @brief     Computes the bounds of the area in which rendering this
+  ///            DisplayList differs from rendering |other|, by comparing
+  ///            their ops rather than the lists as a whole.
+  ///
+  /// The ops the two lists start and end with in common are skipped. The
+  /// area covers the rendering ops in between, as found in the RTrees of
+  /// both lists, as long as the non-rendering ops in between are the same in
+  /// both lists.
+  ///
+  /// @return    The changed bounds, which are empty if the lists render the
+  ///            same, or std::nullopt if either list has no RTree or the
+  ///            changes also affect the rendering ops around them.
+  std::optional<SkRect> ComputeChangedBounds(const DisplayList& other) const;
+
+  struct OcclusionStatistics {
+    // The number of rendering ops that are completely covered by the opaque
+    // rendering ops that follow them.
+    int occluded_op_count = 0;
+    // The sum of the device space areas of the bounds of those ops, which
+    // is the overdraw that |DispatchUnoccluded| avoids.
+    double occluded_area = 0.0;
+  };
+
+  /// @brief     Reports the overdraw of the rendering ops that are hidden by
+  ///            the opaque ops that follow them, computing the occluded ops
+  ///            if they were not yet computed.
+  ///
+  /// @see       DispatchUnoccluded
+  const OcclusionStatistics& occlusion_statistics() const;
+
   bool can_apply_group_opacity() const { return can_apply_group_opacity_; }
   bool isUIThreadSafe() const { return is_ui_thread_safe_; }
 
@@ -289,7 +374,9 @@ class DisplayList : public SkRefCnt {
               bool can_apply_group_opacity,
               bool is_ui_thread_safe,
               bool modifies_transparent_black,
-              sk_sp<const DlRTree> rtree);
+              sk_sp<const DlRTree> rtree,
+              size_t compacted_bytes,
+              std::unique_ptr<const DlOcclusionRecord> occlusion_record);
 
   static uint32_t next_unique_id();
 
@@ -302,6 +389,8 @@ class DisplayList : public SkRefCnt {
   const size_t nested_byte_count_;
   const unsigned int nested_op_count_;
 
+  const size_t compacted_bytes_;
+
   const uint32_t unique_id_;
   const SkRect bounds_;
 
@@ -311,6 +400,14 @@ class DisplayList : public SkRefCnt {
 
   const sk_sp<const DlRTree> rtree_;
 
+  const std::unique_ptr<const DlOcclusionRecord> occlusion_record_;
+  mutable std::once_flag occlusion_once_;
+  // The sorted indices of the RTree rects that are occluded.
+  mutable std::vector<int> occluded_rtree_indices_;
+  mutable OcclusionStatistics occlusion_statistics_;
+
+  void ComputeOcclusion() const;
+
   void Dispatch(DlOpReceiver& ctx,
                 uint8_t* ptr,
                 uint8_t* end,
@@ -12,10 +12,12 @@
 #include "flutter/display_list/dl_blend_mode.h"
 #include "flutter/display_list/dl_builder.h"
 #include "flutter/display_list/dl_paint.h"
+#include "flutter/display_list/dl_serialization.h"
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "flutter/display_list/skia/dl_sk_dispatcher.h"
 #include "flutter/display_list/testing/dl_test_snippets.h"
 #include "flutter/display_list/utils/dl_receiver_utils.h"
+#include "flutter/fml/file.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/math.h"
 #include "flutter/testing/display_list_testing.h"
@@ -617,6 +619,352 @@ TEST_F(DisplayListTest, SingleOpDisplayListsRecapturedAreEqual) {
   }
 }
 
+TEST_F(DisplayListTest, SingleOpDisplayListsSerializedAreEqual) {
+  size_t serialized_count = 0u;
+  for (auto& group : allGroups) {
+    // Nested display lists are inlined when serialized.
+    if (group.op_name == "DrawDisplayList") {
+      continue;
+    }
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      sk_sp<DisplayList> dl = Build(group.variants[i]);
+      auto serialized = DlSerializedDisplayList::Serialize(*dl);
+      if (!serialized) {
+        // Text and runtime effects aren't serialized.
+        continue;
+      }
+      serialized_count++;
+      DisplayListBuilder copy_builder;
+      serialized->Dispatch(ToReceiver(copy_builder));
+      sk_sp<DisplayList> copy = copy_builder.Build();
+      auto desc = group.op_name + "(variant " + std::to_string(i + 1) +
+                  " == serialized)";
+      ASSERT_EQ(serialized->op_count(), dl->op_count(false)) << desc;
+      ASSERT_EQ(serialized->bounds(), dl->bounds()) << desc;
+      ASSERT_EQ(copy->op_count(false), dl->op_count(false)) << desc;
+      ASSERT_TRUE(copy->Equals(*dl)) << desc;
+    }
+  }
+  EXPECT_GT(serialized_count, 0u);
+}
+
+TEST_F(DisplayListTest, SerializedDisplayListIsRelocatable) {
+  DisplayListBuilder builder;
+  SkPath path = SkPath::Circle(50, 50, 20);
+  DlPaint paint;
+  paint.setImageFilter(std::make_shared<DlBlurImageFilter>(
+      5.0f, 5.0f, DlTileMode::kClamp));
+  builder.DrawPath(path, paint);
+  builder.ClipPath(path);
+  builder.DrawImage(TestImage1, {10, 10}, DlImageSampling::kLinear);
+  auto dl = builder.Build();
+
+  auto serialized = DlSerializedDisplayList::Serialize(*dl);
+  ASSERT_TRUE(serialized);
+  ASSERT_EQ(serialized->images().size(), 1u);
+
+  // Copying the bytes elsewhere, as writing them to a file and mapping it
+  // would, yields the same display list.
+  const auto& mapping = serialized->mapping();
+  std::vector<uint8_t> bytes(mapping->GetMapping(),
+                             mapping->GetMapping() + mapping->GetSize());
+  auto copy = DlSerializedDisplayList::Make(
+      std::make_shared<fml::DataMapping>(bytes), serialized->images());
+  ASSERT_TRUE(copy);
+  DisplayListBuilder copy_builder;
+  copy->Dispatch(ToReceiver(copy_builder));
+  EXPECT_TRUE(copy_builder.Build()->Equals(*dl));
+
+  // The image table must be supplied along with the bytes.
+  EXPECT_FALSE(DlSerializedDisplayList::Make(
+      std::make_shared<fml::DataMapping>(bytes), {}));
+
+  // Truncated or otherwise malformed data is rejected.
+  std::vector<uint8_t> truncated(bytes.begin(), bytes.end() - 4);
+  EXPECT_FALSE(DlSerializedDisplayList::Make(
+      std::make_shared<fml::DataMapping>(truncated), serialized->images()));
+  std::vector<uint8_t> wrong_version = bytes;
+  wrong_version[4]++;
+  EXPECT_FALSE(DlSerializedDisplayList::Make(
+      std::make_shared<fml::DataMapping>(wrong_version),
+      serialized->images()));
+}
+
+TEST_F(DisplayListTest, SerializedDisplayListInlinesNestedDisplayLists) {
+  DisplayListBuilder nested_builder;
+  nested_builder.DrawRect({0, 0, 10, 10}, DlPaint(DlColor::kBlue()));
+  auto nested = nested_builder.Build();
+
+  DisplayListBuilder builder;
+  builder.DrawRect({20, 20, 30, 30}, DlPaint(DlColor::kRed()));
+  builder.DrawDisplayList(nested, 0.5f);
+  builder.DrawRect({40, 40, 50, 50}, DlPaint(DlColor::kRed()));
+  auto dl = builder.Build();
+
+  auto serialized = DlSerializedDisplayList::Serialize(*dl);
+  ASSERT_TRUE(serialized);
+  DisplayListBuilder copy_builder;
+  serialized->Dispatch(ToReceiver(copy_builder));
+  auto copy = copy_builder.Build();
+
+  // The nested ops are drawn in a layer with the opacity, starting from the
+  // default attributes, and the outer attributes are set again afterwards.
+  DisplayListBuilder expected_builder;
+  DlOpReceiver& expected = ToReceiver(expected_builder);
+  expected.setColor(DlColor::kRed());
+  expected.drawRect({20, 20, 30, 30});
+  expected.setColor(DlPaint().setOpacity(0.5f).getColor());
+  expected.saveLayer(&nested->bounds(), SaveLayerOptions::kWithAttributes,
+                     nullptr);
+  expected.setColor(DlColor::kBlack());
+  expected.setColor(DlColor::kBlue());
+  expected.drawRect({0, 0, 10, 10});
+  expected.restore();
+  expected.setColor(DlColor::kRed());
+  expected.drawRect({40, 40, 50, 50});
+  EXPECT_TRUE(copy->Equals(expected_builder.Build())) << *copy;
+  EXPECT_EQ(copy->bounds(), dl->bounds());
+}
+
+TEST_F(DisplayListTest, SerializedDisplayListRoundTripsThroughDirectory) {
+  auto surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(10, 20));
+  auto image = DlImage::Make(surface->makeImageSnapshot());
+
+  DisplayListBuilder builder;
+  builder.DrawRect({0, 0, 10, 10}, DlPaint(DlColor::kRed()));
+  builder.DrawImage(image, {5, 5}, DlImageSampling::kNearestNeighbor);
+  auto dl = builder.Build();
+  auto serialized = DlSerializedDisplayList::Serialize(*dl);
+  ASSERT_TRUE(serialized);
+
+  fml::ScopedTemporaryDirectory directory;
+  ASSERT_TRUE(serialized->WriteToDirectory(directory.fd(), "frame_0"));
+
+  std::vector<SkISize> image_sizes;
+  auto read = DlSerializedDisplayList::ReadFromDirectory(
+      directory.fd(), "frame_0", [&](const SkISize& size) {
+        image_sizes.push_back(size);
+        return image;
+      });
+  ASSERT_TRUE(read);
+  EXPECT_EQ(image_sizes, std::vector<SkISize>{SkISize::Make(10, 20)});
+  EXPECT_EQ(read->op_count(), serialized->op_count());
+  EXPECT_EQ(read->bounds(), serialized->bounds());
+
+  DisplayListBuilder copy_builder;
+  read->Dispatch(ToReceiver(copy_builder));
+  EXPECT_TRUE(copy_builder.Build()->Equals(dl));
+
+  EXPECT_FALSE(DlSerializedDisplayList::ReadFromDirectory(
+      directory.fd(), "frame_1", [&](const SkISize& size) { return image; }));
+}
+
+TEST_F(DisplayListTest, CompactedDisplayListOmitsRedundantOps) {
+  auto record = [](DlOpReceiver& receiver) {
+    receiver.setColor(DlColor::kRed());
+    receiver.setColor(DlColor::kBlue());
+    receiver.save();
+    receiver.translate(20, 20);
+    receiver.clipRect({0, 0, 5, 5}, ClipOp::kIntersect, false);
+    receiver.restore();
+    receiver.translate(5, 5);
+    receiver.translate(5, 5);
+    receiver.drawRect({10, 10, 20, 20});
+    receiver.setColor(DlColor::kGreen());
+  };
+  DisplayListBuilder uncompacted_builder;
+  record(ToReceiver(uncompacted_builder));
+  auto uncompacted = uncompacted_builder.Build();
+  DisplayListBuilder builder;
+  record(ToReceiver(builder));
+  auto compacted = builder.Build(/*compact=*/true);
+
+  DisplayListBuilder expected_builder;
+  DlOpReceiver& expected_receiver = ToReceiver(expected_builder);
+  expected_receiver.setColor(DlColor::kBlue());
+  expected_receiver.translate(10, 10);
+  expected_receiver.drawRect({10, 10, 20, 20});
+  auto expected = expected_builder.Build();
+
+  EXPECT_TRUE(compacted->Equals(expected)) << *compacted;
+  EXPECT_EQ(compacted->op_count(), expected->op_count());
+  EXPECT_EQ(compacted->bounds(), uncompacted->bounds());
+  EXPECT_EQ(compacted->compacted_bytes(),
+            uncompacted->bytes() - compacted->bytes());
+  EXPECT_EQ(uncompacted->compacted_bytes(), 0u);
+}
+
+TEST_F(DisplayListTest, CompactedDisplayListKeepsRTreeIndices) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  DlOpReceiver& receiver = ToReceiver(builder);
+  receiver.save();
+  receiver.clipRect({0, 0, 5, 5}, ClipOp::kIntersect, false);
+  receiver.restore();
+  receiver.setColor(DlColor::kRed());
+  receiver.drawRect({10, 10, 20, 20});
+  receiver.setColor(DlColor::kBlue());
+  receiver.drawRect({50, 50, 60, 60});
+  auto display_list = builder.Build(/*compact=*/true);
+  ASSERT_GT(display_list->compacted_bytes(), 0u);
+
+  // Culling by the remapped RTree must still find only the second rect.
+  DisplayListBuilder culled_builder;
+  display_list->Dispatch(ToReceiver(culled_builder),
+                         SkRect::MakeLTRB(45, 45, 65, 65));
+  auto culled = culled_builder.Build();
+  EXPECT_EQ(culled->bounds(), SkRect::MakeLTRB(50, 50, 60, 60));
+}
+
+TEST_F(DisplayListTest, DispatchRTreePartitions) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  DlOpReceiver& receiver = ToReceiver(builder);
+  receiver.save();
+  receiver.clipRect({0, 0, 200, 200}, ClipOp::kIntersect, false);
+  receiver.setColor(DlColor::kRed());
+  receiver.drawRect({10, 10, 20, 20});
+  receiver.setColor(DlColor::kBlue());
+  receiver.drawRect({100, 100, 110, 110});
+  receiver.drawRect({15, 15, 25, 25});
+  receiver.restore();
+  auto display_list = builder.Build();
+
+  auto groups = display_list->rtree()->searchAndPartition(
+      display_list->bounds(), /*max_groups=*/4);
+  ASSERT_EQ(groups.size(), 2u);
+
+  std::vector<SkRect> group_bounds;
+  unsigned int op_count = 0u;
+  for (const auto& group : groups) {
+    DisplayListBuilder group_builder;
+    display_list->Dispatch(ToReceiver(group_builder), group);
+    auto group_list = group_builder.Build();
+    group_bounds.push_back(group_list->bounds());
+    op_count += group_list->op_count();
+  }
+  EXPECT_EQ(group_bounds[0], SkRect::MakeLTRB(10, 10, 25, 25));
+  EXPECT_EQ(group_bounds[1], SkRect::MakeLTRB(100, 100, 110, 110));
+  // Each group replays the save and the clip that apply to its draws.
+  EXPECT_EQ(op_count, display_list->op_count() + 3u);
+}
+
+TEST_F(DisplayListTest, DispatchUnoccludedSkipsOpsUnderOpaqueOps) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect({10, 10, 20, 20}, DlPaint(DlColor::kRed()));
+  builder.DrawRect({100, 100, 110, 110}, DlPaint(DlColor::kGreen()));
+  // Covered by the union of the two opaque rects that follow.
+  builder.DrawRect({30, 30, 70, 40}, DlPaint(DlColor::kRed()));
+  builder.DrawRect({0, 0, 50, 50}, DlPaint(DlColor::kBlue()));
+  builder.DrawRect({50, 0, 80, 50}, DlPaint(DlColor::kBlue()));
+  // Translucent ops do not occlude the ops before them.
+  builder.DrawRect({90, 90, 120, 120},
+                   DlPaint(DlColor::kBlue().withAlpha(0x7F)));
+  auto display_list = builder.Build();
+
+  DisplayListBuilder expected_builder;
+  expected_builder.DrawRect({100, 100, 110, 110}, DlPaint(DlColor::kGreen()));
+  expected_builder.DrawRect({0, 0, 50, 50}, DlPaint(DlColor::kBlue()));
+  expected_builder.DrawRect({50, 0, 80, 50}, DlPaint(DlColor::kBlue()));
+  expected_builder.DrawRect({90, 90, 120, 120},
+                            DlPaint(DlColor::kBlue().withAlpha(0x7F)));
+  auto expected = expected_builder.Build();
+
+  DisplayListBuilder unoccluded_builder;
+  display_list->DispatchUnoccluded(ToReceiver(unoccluded_builder),
+                                   SkIRect::MakeWH(200, 200));
+  // Compaction drops the colors of the skipped ops.
+  EXPECT_TRUE(DisplayListsEQ_Verbose(
+      unoccluded_builder.Build(/*compact=*/true), expected));
+
+  const auto& statistics = display_list->occlusion_statistics();
+  EXPECT_EQ(statistics.occluded_op_count, 2);
+  EXPECT_EQ(statistics.occluded_area, 100.0 + 400.0);
+}
+
+TEST_F(DisplayListTest, DispatchUnoccludedKeepsOpsThatMayShowThrough) {
+  auto check_not_occluded = [](const std::function<void(DlCanvas&)>& draw) {
+    DisplayListBuilder builder(/*prepare_rtree=*/true);
+    builder.DrawRect({10, 10, 20, 20}, DlPaint(DlColor::kRed()));
+    draw(builder);
+    auto display_list = builder.Build();
+    EXPECT_EQ(display_list->occlusion_statistics().occluded_op_count, 0);
+  };
+
+  // Non-rectangular clips.
+  check_not_occluded([](DlCanvas& canvas) {
+    canvas.Save();
+    canvas.ClipRRect(SkRRect::MakeRectXY({0, 0, 50, 50}, 20, 20));
+    canvas.DrawPaint(DlPaint(DlColor::kBlue()));
+    canvas.Restore();
+  });
+  // Rotated occluders.
+  check_not_occluded([](DlCanvas& canvas) {
+    canvas.Save();
+    canvas.Rotate(10);
+    canvas.DrawRect({0, 0, 50, 50}, DlPaint(DlColor::kBlue()));
+    canvas.Restore();
+  });
+  // Occluders within layers.
+  check_not_occluded([](DlCanvas& canvas) {
+    DlPaint layer_paint;
+    layer_paint.setAlpha(0x7F);
+    canvas.SaveLayer(nullptr, &layer_paint);
+    canvas.DrawRect({0, 0, 50, 50}, DlPaint(DlColor::kBlue()));
+    canvas.Restore();
+  });
+  // Backdrop filters that read the ops before the occluder.
+  check_not_occluded([](DlCanvas& canvas) {
+    DlBlurImageFilter blur(5, 5, DlTileMode::kClamp);
+    canvas.SaveLayer(nullptr, nullptr, &blur);
+    canvas.Restore();
+    canvas.DrawRect({0, 0, 50, 50}, DlPaint(DlColor::kBlue()));
+  });
+  // Stroked rects.
+  check_not_occluded([](DlCanvas& canvas) {
+    canvas.DrawRect({0, 0, 50, 50}, DlPaint(DlColor::kBlue())
+                                        .setDrawStyle(DlDrawStyle::kStroke)
+                                        .setStrokeWidth(40));
+  });
+}
+
+TEST_F(DisplayListTest, ChangedBoundsCoverChangedOps) {
+  auto build = [](SkScalar cursor_x, DlColor cursor_color, SkScalar dx) {
+    DisplayListBuilder builder(/*prepare_rtree=*/true);
+    builder.Save();
+    builder.Translate(dx, 0);
+    builder.DrawRect({0, 0, 50, 50}, DlPaint(DlColor::kGreen()));
+    builder.DrawRect({cursor_x, 0, cursor_x + 2, 20}, DlPaint(cursor_color));
+    builder.DrawRect({100, 100, 150, 150}, DlPaint(DlColor::kBlue()));
+    builder.Restore();
+    return builder.Build();
+  };
+  auto display_list = build(10, DlColor::kBlack(), 0);
+
+  EXPECT_EQ(display_list->ComputeChangedBounds(*display_list),
+            SkRect::MakeEmpty());
+  EXPECT_EQ(
+      display_list->ComputeChangedBounds(*build(10, DlColor::kBlack(), 0)),
+      SkRect::MakeEmpty());
+
+  // Moving the cursor changes its old and new position.
+  EXPECT_EQ(
+      display_list->ComputeChangedBounds(*build(20, DlColor::kBlack(), 0)),
+      SkRect::MakeLTRB(10, 0, 22, 20));
+
+  // Changing its color changes the draw that uses the color.
+  EXPECT_EQ(display_list->ComputeChangedBounds(*build(10, DlColor::kRed(), 0)),
+            SkRect::MakeLTRB(10, 0, 12, 20));
+
+  // Changing the transform changes everything after it.
+  EXPECT_FALSE(
+      display_list->ComputeChangedBounds(*build(10, DlColor::kBlack(), 5))
+          .has_value());
+
+  DisplayListBuilder builder;
+  builder.DrawRect({0, 0, 50, 50}, DlPaint());
+  EXPECT_FALSE(
+      display_list->ComputeChangedBounds(*builder.Build()).has_value());
+}
+
 TEST_F(DisplayListTest, SingleOpDisplayListsCompareToEachOther) {
   for (auto& group : allGroups) {
     std::vector<sk_sp<DisplayList>> lists_a;
@@ -10,6 +10,7 @@
 #include "flutter/display_list/dl_op_records.h"
 #include "flutter/display_list/effects/dl_color_source.h"
 #include "flutter/display_list/utils/dl_bounds_accumulator.h"
+#include "flutter/fml/memory/allocation_tag.h"
 #include "fml/logging.h"
 #include "third_party/skia/include/core/SkScalar.h"
 
@@ -63,11 +64,241 @@ void* DisplayListBuilder::Push(size_t pod, int render_op_inc, Args&&... args) {
   return op + 1;
 }
 
-sk_sp<DisplayList> DisplayListBuilder::Build() {
+namespace {
+
+// How an op affects the ops around it, for the purposes of compaction.
+enum class CompactOpKind {
+  kAttribute,
+  kSave,
+  kSaveLayer,
+  kRestore,
+  kTransform,
+  kClip,
+  kRender,
+};
+
+struct CompactOpRecord {
+  DLOp* op;
+  CompactOpKind kind;
+  int slot;
+  bool keep;
+};
+
+CompactOpRecord MakeCompactOpRecord(DLOp* op) {
+  auto record = [op](CompactOpKind kind) {
+    return CompactOpRecord{op, kind, -1, true};
+  };
+  const int slot = GetAttributeSlot(op->type);
+  if (slot >= 0) {
+    return CompactOpRecord{op, CompactOpKind::kAttribute, slot, true};
+  }
+  switch (op->type) {
+    case DisplayListOpType::kSave:
+      return record(CompactOpKind::kSave);
+    case DisplayListOpType::kSaveLayer:
+    case DisplayListOpType::kSaveLayerBounds:
+    case DisplayListOpType::kSaveLayerBackdrop:
+    case DisplayListOpType::kSaveLayerBackdropBounds:
+      return record(CompactOpKind::kSaveLayer);
+    case DisplayListOpType::kRestore:
+      return record(CompactOpKind::kRestore);
+
+    case DisplayListOpType::kTranslate:
+    case DisplayListOpType::kScale:
+    case DisplayListOpType::kRotate:
+    case DisplayListOpType::kSkew:
+    case DisplayListOpType::kTransform2DAffine:
+    case DisplayListOpType::kTransformFullPerspective:
+    case DisplayListOpType::kTransformReset:
+      return record(CompactOpKind::kTransform);
+
+    case DisplayListOpType::kClipIntersectRect:
+    case DisplayListOpType::kClipIntersectRRect:
+    case DisplayListOpType::kClipIntersectPath:
+    case DisplayListOpType::kClipDifferenceRect:
+    case DisplayListOpType::kClipDifferenceRRect:
+    case DisplayListOpType::kClipDifferencePath:
+      return record(CompactOpKind::kClip);
+
+    default:
+      return record(CompactOpKind::kRender);
+  }
+}
+
+// Whether a saveLayer that encloses no rendering ops can still change the
+// destination, either by filtering the backdrop or by compositing the empty
+// layer with attributes such as a blend mode or a color filter.
+bool SaveLayerAffectsDestination(const DLOp* op) {
+  if (op->type == DisplayListOpType::kSaveLayerBackdrop ||
+      op->type == DisplayListOpType::kSaveLayerBackdropBounds) {
+    return true;
+  }
+  return static_cast<const SaveOpBase*>(op)->options.renders_with_attributes();
+}
+
+// Folds |op| into the |previous| op if both are translates or both are
+// scales.
+bool FoldTransform(DLOp* previous, const DLOp* op) {
+  if (previous->type != op->type) {
+    return false;
+  }
+  const uint32_t size = previous->size;
+  switch (op->type) {
+    case DisplayListOpType::kTranslate: {
+      auto first = static_cast<const TranslateOp*>(previous);
+      auto second = static_cast<const TranslateOp*>(op);
+      new (previous)
+          TranslateOp(first->tx + second->tx, first->ty + second->ty);
+      break;
+    }
+    case DisplayListOpType::kScale: {
+      auto first = static_cast<const ScaleOp*>(previous);
+      auto second = static_cast<const ScaleOp*>(op);
+      new (previous) ScaleOp(first->sx * second->sx, first->sy * second->sy);
+      break;
+    }
+    default:
+      return false;
+  }
+  previous->type = op->type;
+  previous->size = size;
+  return true;
+}
+
+}  // namespace
+
+size_t DisplayListBuilder::CompactOps() {
+  uint8_t* const start = storage_.get();
+  if (!start || used_ == 0) {
+    return 0;
+  }
+
+  std::vector<CompactOpRecord> ops;
+  ops.reserve(op_index_);
+  for (uint8_t* ptr = start; ptr < start + used_;) {
+    auto op = reinterpret_cast<DLOp*>(ptr);
+    ptr += op->size;
+    ops.push_back(MakeCompactOpRecord(op));
+  }
+  FML_DCHECK(static_cast<int>(ops.size()) == op_index_);
+
+  // Walk the ops backwards so that, for each op, it is known whether any
+  // rendering op follows it in its save scope and which attributes are set
+  // again before the next rendering op uses them.
+  struct Scope {
+    size_t restore_index;
+    bool has_rendering;
+  };
+  std::vector<Scope> scopes = {{ops.size(), false}};
+  uint32_t overwritten_attributes = ~0u;
+  for (size_t i = ops.size(); i > 0; i--) {
+    CompactOpRecord& record = ops[i - 1];
+    switch (record.kind) {
+      case CompactOpKind::kAttribute:
+        if (overwritten_attributes & (1u << record.slot)) {
+          record.keep = false;
+        } else {
+          overwritten_attributes |= 1u << record.slot;
+        }
+        break;
+      case CompactOpKind::kRestore:
+        scopes.push_back({i - 1, false});
+        break;
+      case CompactOpKind::kSave:
+      case CompactOpKind::kSaveLayer: {
+        FML_DCHECK(scopes.size() > 1);
+        Scope scope = scopes.back();
+        scopes.pop_back();
+        if (scope.has_rendering ||
+            (record.kind == CompactOpKind::kSaveLayer &&
+             SaveLayerAffectsDestination(record.op))) {
+          scopes.back().has_rendering = true;
+          if (record.kind == CompactOpKind::kSaveLayer) {
+            // The layer is rendered with the attributes.
+            overwritten_attributes = 0u;
+          }
+        } else {
+          record.keep = false;
+          ops[scope.restore_index].keep = false;
+        }
+        break;
+      }
+      case CompactOpKind::kTransform:
+      case CompactOpKind::kClip:
+        if (!scopes.back().has_rendering) {
+          record.keep = false;
+        }
+        break;
+      case CompactOpKind::kRender:
+        scopes.back().has_rendering = true;
+        overwritten_attributes = 0u;
+        break;
+    }
+  }
+
+  // Fold consecutive transforms and map the index of every op to the index
+  // of the first remaining op at or after it.
+  std::vector<int> index_map(ops.size() + 1);
+  CompactOpRecord* previous = nullptr;
+  int index = 0;
+  for (size_t i = 0; i < ops.size(); i++) {
+    index_map[i] = index;
+    CompactOpRecord& record = ops[i];
+    if (record.keep && record.kind == CompactOpKind::kTransform && previous &&
+        FoldTransform(previous->op, record.op)) {
+      record.keep = false;
+    }
+    if (!record.keep) {
+      if (record.kind != CompactOpKind::kAttribute &&
+          record.op->type != DisplayListOpType::kTransformReset) {
+        render_op_count_--;
+      }
+      continue;
+    }
+    previous = &record;
+    index++;
+  }
+  index_map[ops.size()] = index;
+
+  uint8_t* dst = start;
+  for (CompactOpRecord& record : ops) {
+    auto src = reinterpret_cast<uint8_t*>(record.op);
+    const size_t size = record.op->size;
+    if (!record.keep) {
+      DisplayList::DisposeOps(src, src + size);
+      continue;
+    }
+    if (record.kind == CompactOpKind::kSave ||
+        record.kind == CompactOpKind::kSaveLayer) {
+      auto save_op = static_cast<SaveOpBase*>(record.op);
+      save_op->restore_index = index_map[save_op->restore_index];
+    }
+    if (dst != src) {
+      memmove(dst, src, size);
+    }
+    dst += size;
+  }
+
+  const size_t compacted_bytes = used_ - (dst - start);
+  // Ops are compared in bulk by |DisplayList::Equals|, so unused bytes must
+  // stay zeroed.
+  memset(dst, 0, compacted_bytes);
+  used_ = dst - start;
+  op_index_ = index;
+  accumulator()->remap_indices(index_map);
+  if (occlusion_record_) {
+    occlusion_record_->remap_indices(index_map);
+  }
+  return compacted_bytes;
+}
+
+sk_sp<DisplayList> DisplayListBuilder::Build(bool compact) {
+  FML_ALLOCATION_TAG(kDisplayList);
   while (layer_stack_.size() > 1) {
     restore();
   }
 
+  size_t compacted_bytes = compact ? CompactOps() : 0u;
   size_t bytes = used_;
   int count = render_op_count_;
   size_t nested_bytes = nested_bytes_;
@@ -75,6 +306,13 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
   bool compatible = current_layer_->is_group_opacity_compatible();
   bool is_safe = is_ui_thread_safe_;
   bool affects_transparency = current_layer_->affects_transparent_layer();
+  std::unique_ptr<DlOcclusionRecord> occlusion_record;
+  if (occlusion_record_) {
+    if (!occlusion_record_->occluders.empty()) {
+      occlusion_record = std::move(occlusion_record_);
+    }
+    occlusion_record_ = std::make_unique<DlOcclusionRecord>();
+  }
 
   used_ = allocated_ = render_op_count_ = op_index_ = 0;
   nested_bytes_ = nested_op_count_ = 0;
@@ -87,7 +325,8 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
 
   return sk_sp<DisplayList>(new DisplayList(
       std::move(storage_), bytes, count, nested_bytes, nested_count, bounds(),
-      compatible, is_safe, affects_transparency, rtree()));
+      compatible, is_safe, affects_transparency, rtree(), compacted_bytes,
+      std::move(occlusion_record)));
 }
 
 DisplayListBuilder::DisplayListBuilder(const SkRect& cull_rect,
@@ -95,6 +334,7 @@ DisplayListBuilder::DisplayListBuilder(const SkRect& cull_rect,
     : tracker_(cull_rect, SkMatrix::I()) {
   if (prepare_rtree) {
     accumulator_ = std::make_unique<RTreeBoundsAccumulator>();
+    occlusion_record_ = std::make_unique<DlOcclusionRecord>();
   } else {
     accumulator_ = std::make_unique<RectBoundsAccumulator>();
   }
@@ -386,11 +626,16 @@ void DisplayListBuilder::checkForDeferredSave() {
 }
 
 void DisplayListBuilder::Save() {
-  bool is_nop = current_layer_->is_nop_;
+  const LayerInfo& parent = *current_layer_;
+  bool is_nop = parent.is_nop_;
+  bool is_in_layer = parent.is_in_layer_;
+  bool has_complex_clip = parent.has_complex_clip_;
   layer_stack_.emplace_back();
   current_layer_ = &layer_stack_.back();
   current_layer_->has_deferred_save_op_ = true;
   current_layer_->is_nop_ = is_nop;
+  current_layer_->is_in_layer_ = is_in_layer;
+  current_layer_->has_complex_clip_ = has_complex_clip;
   tracker_.save();
   accumulator()->save();
 }
@@ -399,8 +644,9 @@ void DisplayListBuilder::Restore() {
   if (layer_stack_.size() > 1) {
     SaveOpBase* op = reinterpret_cast<SaveOpBase*>(
         storage_.get() + current_layer_->save_offset());
+    int restore_index = op_index_;
     if (!current_layer_->has_deferred_save_op_) {
-      op->restore_index = op_index_;
+      op->restore_index = restore_index;
       Push<RestoreOp>(0, 1);
     }
     // Grab the current layer info before we push the restore
@@ -441,6 +687,10 @@ void DisplayListBuilder::Restore() {
       // Layers are never deferred for now, we need to update the
       // following code if we ever do saveLayer culling...
       FML_DCHECK(!layer_info.has_deferred_save_op_);
+      if (occlusion_record_ && !current_layer_->is_in_layer_) {
+        occlusion_record_->layer_ranges.emplace_back(
+            layer_info.layer_op_index_, restore_index);
+      }
       if (layer_info.is_group_opacity_compatible()) {
         // We are now going to go back and modify the matching saveLayer
         // call to add the option indicating it can distribute an opacity
@@ -487,6 +737,7 @@ void DisplayListBuilder::saveLayer(const SkRect* bounds,
     return;
   }
   size_t save_layer_offset = used_;
+  bool has_complex_clip = current_layer_->has_complex_clip_;
   if (options.renders_with_attributes()) {
     // The actual flood of the outer layer clip will occur after the
     // (eventual) corresponding restore is called, but rather than
@@ -512,11 +763,17 @@ void DisplayListBuilder::saveLayer(const SkRect* bounds,
     layer_stack_.emplace_back(save_layer_offset, true, nullptr);
   }
   current_layer_ = &layer_stack_.back();
+  current_layer_->is_in_layer_ = true;
+  current_layer_->has_complex_clip_ = has_complex_clip;
+  current_layer_->layer_op_index_ = op_index_;
 
   tracker_.save();
   accumulator()->save();
 
   if (backdrop) {
+    if (occlusion_record_) {
+      occlusion_record_->barriers.push_back(op_index_);
+    }
     // A backdrop will affect up to the entire surface, bounded by the clip
     // Accumulate should always return true here because if the
     // clip was empty then that would have been caught up above
@@ -684,6 +941,18 @@ void DisplayListBuilder::ClipRect(const SkRect& rect,
   if (!rect.isFinite()) {
     return;
   }
+  if (clip_op != ClipOp::kIntersect || tracker_.using_4x4_matrix() ||
+      !tracker_.matrix_3x3().rectStaysRect()) {
+    current_layer_->has_complex_clip_ = true;
+  } else if (is_aa) {
+    // The tracker rounds out anti-aliased clips, which only partially cover
+    // the pixels on their edges unless they are pixel aligned.
+    SkRect device_rect = rect;
+    if (!tracker_.mapRect(&device_rect) ||
+        SkRect::Make(device_rect.roundOut()) != device_rect) {
+      current_layer_->has_complex_clip_ = true;
+    }
+  }
   tracker_.clipRect(rect, clip_op, is_aa);
   if (current_layer_->is_nop_ || tracker_.is_cull_rect_empty()) {
     current_layer_->is_nop_ = true;
@@ -705,6 +974,7 @@ void DisplayListBuilder::ClipRRect(const SkRRect& rrect,
   if (rrect.isRect()) {
     clipRect(rrect.rect(), clip_op, is_aa);
   } else {
+    current_layer_->has_complex_clip_ = true;
     tracker_.clipRRect(rrect, clip_op, is_aa);
     if (current_layer_->is_nop_ || tracker_.is_cull_rect_empty()) {
       current_layer_->is_nop_ = true;
@@ -741,6 +1011,7 @@ void DisplayListBuilder::ClipPath(const SkPath& path,
       return;
     }
   }
+  current_layer_->has_complex_clip_ = true;
   tracker_.clipPath(path, clip_op, is_aa);
   if (current_layer_->is_nop_ || tracker_.is_cull_rect_empty()) {
     current_layer_->is_nop_ = true;
@@ -764,6 +1035,9 @@ bool DisplayListBuilder::QuickReject(const SkRect& bounds) const {
 void DisplayListBuilder::drawPaint() {
   OpResult result = PaintResult(current_, kDrawPaintFlags);
   if (result != OpResult::kNoEffect && AccumulateUnbounded()) {
+    if (current_.rendersOpaque()) {
+      AccumulateOccluder(nullptr);
+    }
     Push<DrawPaintOp>(0, 1);
     CheckLayerOpacityCompatibility();
     UpdateLayerResult(result);
@@ -776,6 +1050,9 @@ void DisplayListBuilder::DrawPaint(const DlPaint& paint) {
 void DisplayListBuilder::DrawColor(DlColor color, DlBlendMode mode) {
   OpResult result = PaintResult(DlPaint(color).setBlendMode(mode));
   if (result != OpResult::kNoEffect && AccumulateUnbounded()) {
+    if (DlPaint(color).setBlendMode(mode).rendersOpaque()) {
+      AccumulateOccluder(nullptr);
+    }
     Push<DrawColorOp>(0, 1, color, mode);
     CheckLayerOpacityCompatibility(mode);
     UpdateLayerResult(result);
@@ -804,6 +1081,11 @@ void DisplayListBuilder::drawRect(const SkRect& rect) {
   OpResult result = PaintResult(current_, flags);
   if (result != OpResult::kNoEffect &&
       AccumulateOpBounds(rect.makeSorted(), flags)) {
+    if (current_.getDrawStyle() == DlDrawStyle::kFill &&
+        current_.rendersOpaque()) {
+      SkRect sorted = rect.makeSorted();
+      AccumulateOccluder(&sorted);
+    }
     Push<DrawRectOp>(0, 1, rect);
     CheckLayerOpacityCompatibility();
     UpdateLayerResult(result);
@@ -1441,6 +1723,28 @@ bool DisplayListBuilder::AccumulateOpBounds(SkRect& bounds,
     return AccumulateUnbounded();
   }
 }
+void DisplayListBuilder::AccumulateOccluder(const SkRect* rect) {
+  if (!occlusion_record_ || current_layer_->is_in_layer_ ||
+      current_layer_->has_complex_clip_ || tracker_.using_4x4_matrix()) {
+    return;
+  }
+  SkRect device_rect = tracker_.device_cull_rect();
+  if (rect) {
+    if (!tracker_.matrix_3x3().rectStaysRect()) {
+      return;
+    }
+    SkRect mapped = *rect;
+    if (!tracker_.mapRect(&mapped) || !device_rect.intersect(mapped)) {
+      return;
+    }
+  }
+  // Only the pixels that the op covers completely are replaced.
+  SkIRect pixels = device_rect.roundIn();
+  if (!pixels.isEmpty()) {
+    occlusion_record_->occluders.push_back({op_index_, pixels});
+  }
+}
+
 bool DisplayListBuilder::AccumulateBounds(SkRect& bounds) {
   if (!bounds.isEmpty()) {
     tracker_.mapRect(&bounds);
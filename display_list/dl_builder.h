@@ -244,7 +244,26 @@ class DisplayListBuilder final : public virtual DlCanvas,
   // |DlCanvas|
   void Flush() override {}
 
-  sk_sp<DisplayList> Build();
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a DisplayList from the recorded ops and resets the
+  ///             builder.
+  ///
+  /// @param[in]  compact  Whether to remove ops that can't affect rendering
+  ///                      from the op stream first: attributes overwritten
+  ///                      before any op uses them, transforms and clips that
+  ///                      no rendering op follows in their save scope, save
+  ///                      and restore pairs (and saveLayers without a backdrop
+  ///                      or attributes) that enclose no rendering ops, and
+  ///                      consecutive translates or scales which are folded
+  ///                      into one op. The bytes saved are reported by
+  ///                      |DisplayList::compacted_bytes|.
+  ///
+  ///             Builders that prepare an RTree also record the opaque rects,
+  ///             paints and colors drawn outside of saveLayers under
+  ///             rectangular clips, from which the DisplayList finds the ops
+  ///             that |DisplayList::DispatchUnoccluded| can skip.
+  ///
+  sk_sp<DisplayList> Build(bool compact = false);
 
  private:
   // This method exposes the internal stateful DlOpReceiver implementation
@@ -485,6 +504,10 @@ class DisplayListBuilder final : public virtual DlCanvas,
 
   void checkForDeferredSave();
 
+  // Removes redundant ops from the storage as described in |Build| and
+  // returns the number of bytes removed.
+  size_t CompactOps();
+
   DisplayListStorage storage_;
   size_t used_ = 0;
   size_t allocated_ = 0;
@@ -601,6 +624,12 @@ class DisplayListBuilder final : public virtual DlCanvas,
     bool has_deferred_save_op_ = false;
     bool is_nop_ = false;
     bool affects_transparent_layer_ = false;
+    // Whether this save is within a saveLayer, or is one.
+    bool is_in_layer_ = false;
+    // Whether the clip may not fill its device bounds completely.
+    bool has_complex_clip_ = false;
+    // The op index of the saveLayer op of this layer.
+    int layer_op_index_ = -1;
 
     friend class DisplayListBuilder;
   };
@@ -775,6 +804,15 @@ class DisplayListBuilder final : public virtual DlCanvas,
   // and clipping against the current clip.
   bool AccumulateBounds(SkRect& bounds);
 
+  // Records that the op about to be pushed replaces the pixels within the
+  // given local |rect|, or within the clip if it is null, with opaque colors
+  // if that area can be determined exactly.
+  void AccumulateOccluder(const SkRect* rect);
+
+  // Records the opaque ops and the layers and backdrops that limit which
+  // ops they occlude. Null if the builder does not prepare an RTree.
+  std::unique_ptr<DlOcclusionRecord> occlusion_record_;
+
   DlPaint current_;
 };
 
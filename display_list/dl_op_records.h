@@ -103,6 +103,76 @@ struct DLOp {
   }
 };
 
+// The attributes set by attribute ops. Ops that set the same attribute
+// overwrite each other.
+enum AttributeSlot {
+  kAntiAliasSlot,
+  kInvertColorsSlot,
+  kStrokeCapSlot,
+  kStrokeJoinSlot,
+  kStyleSlot,
+  kStrokeWidthSlot,
+  kStrokeMiterSlot,
+  kColorSlot,
+  kBlendModeSlot,
+  kPathEffectSlot,
+  kColorFilterSlot,
+  kColorSourceSlot,
+  kImageFilterSlot,
+  kMaskFilterSlot,
+  kAttributeSlotCount,
+};
+
+static_assert(kAttributeSlotCount <= 32);
+
+// Returns the attribute set by an op of the given type, or -1 if the op
+// doesn't set an attribute.
+inline int GetAttributeSlot(DisplayListOpType type) {
+  switch (type) {
+    case DisplayListOpType::kSetAntiAlias:
+      return kAntiAliasSlot;
+    case DisplayListOpType::kSetInvertColors:
+      return kInvertColorsSlot;
+    case DisplayListOpType::kSetStrokeCap:
+      return kStrokeCapSlot;
+    case DisplayListOpType::kSetStrokeJoin:
+      return kStrokeJoinSlot;
+    case DisplayListOpType::kSetStyle:
+      return kStyleSlot;
+    case DisplayListOpType::kSetStrokeWidth:
+      return kStrokeWidthSlot;
+    case DisplayListOpType::kSetStrokeMiter:
+      return kStrokeMiterSlot;
+    case DisplayListOpType::kSetColor:
+      return kColorSlot;
+    case DisplayListOpType::kSetBlendMode:
+      return kBlendModeSlot;
+    case DisplayListOpType::kSetPodPathEffect:
+    case DisplayListOpType::kClearPathEffect:
+      return kPathEffectSlot;
+    case DisplayListOpType::kClearColorFilter:
+    case DisplayListOpType::kSetPodColorFilter:
+      return kColorFilterSlot;
+    case DisplayListOpType::kClearColorSource:
+    case DisplayListOpType::kSetPodColorSource:
+    case DisplayListOpType::kSetImageColorSource:
+    case DisplayListOpType::kSetRuntimeEffectColorSource:
+#ifdef IMPELLER_ENABLE_3D
+    case DisplayListOpType::kSetSceneColorSource:
+#endif  // IMPELLER_ENABLE_3D
+      return kColorSourceSlot;
+    case DisplayListOpType::kClearImageFilter:
+    case DisplayListOpType::kSetPodImageFilter:
+    case DisplayListOpType::kSetSharedImageFilter:
+      return kImageFilterSlot;
+    case DisplayListOpType::kClearMaskFilter:
+    case DisplayListOpType::kSetPodMaskFilter:
+      return kMaskFilterSlot;
+    default:
+      return -1;
+  }
+}
+
 // 4 byte header + 4 byte payload packs into minimum 8 bytes
 #define DEFINE_SET_BOOL_OP(name)                             \
   struct Set##name##Op final : DLOp {                        \
@@ -34,6 +34,22 @@ bool DlPaint::operator==(DlPaint const& other) const {
          Equals(path_effect_, other.path_effect_);
 }
 
+bool DlPaint::rendersOpaque() const {
+  switch (getBlendMode()) {
+    case DlBlendMode::kSrc:
+    case DlBlendMode::kSrcOver:
+      break;
+    default:
+      return false;
+  }
+  if (is_invert_colors_ || color_filter_ || image_filter_ || mask_filter_ ||
+      path_effect_) {
+    return false;
+  }
+  // The alpha of the color modulates the colors of a color source.
+  return color_.isOpaque() && (!color_source_ || color_source_->is_opaque());
+}
+
 const DlPaint DlPaint::kDefault;
 
 }  // namespace flutter
@@ -192,6 +192,11 @@ class DlPaint {
 
   bool isDefault() const { return *this == kDefault; }
 
+  // Whether the pixels that a primitive drawn with this paint covers
+  // completely are replaced by opaque colors that do not depend on their
+  // previous contents. The draw style is not taken into account.
+  bool rendersOpaque() const;
+
   bool operator==(DlPaint const& other) const;
   bool operator!=(DlPaint const& other) const { return !(*this == other); }
 
@@ -147,5 +147,27 @@ TEST(DisplayListPaint, ChainingConstructor) {
   EXPECT_NE(paint, DlPaint());
 }
 
+TEST(DisplayListPaint, RendersOpaque) {
+  EXPECT_TRUE(DlPaint().rendersOpaque());
+  EXPECT_TRUE(DlPaint(DlColor::kBlue()).setBlendMode(DlBlendMode::kSrc)
+                  .rendersOpaque());
+  EXPECT_FALSE(DlPaint(DlColor::kBlue().withAlpha(0x7F)).rendersOpaque());
+  EXPECT_FALSE(
+      DlPaint().setBlendMode(DlBlendMode::kMultiply).rendersOpaque());
+  EXPECT_FALSE(DlPaint().setInvertColors(true).rendersOpaque());
+  EXPECT_FALSE(
+      DlPaint()
+          .setMaskFilter(DlBlurMaskFilter(DlBlurStyle::kNormal, 3).shared())
+          .rendersOpaque());
+  EXPECT_TRUE(DlPaint()
+                  .setColorSource(DlColorColorSource(DlColor::kRed()).shared())
+                  .rendersOpaque());
+  EXPECT_FALSE(
+      DlPaint()
+          .setColorSource(
+              DlColorColorSource(DlColor::kRed().withAlpha(0x7F)).shared())
+          .rendersOpaque());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -0,0 +1,1598 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_serialization.h"
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
+#include "flutter/display_list/dl_paint.h"
+#include "flutter/display_list/utils/dl_comparable.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkRSXform.h"
+
+namespace flutter {
+
+namespace {
+
+// The values of these enums are part of the serialized format. New values
+// must be appended and any change to the encoding of an existing value
+// requires bumping |DlSerializedDisplayList::kVersion|.
+enum class SerializedOp : uint32_t {
+  kSetAntiAlias,
+  kSetDrawStyle,
+  kSetColor,
+  kSetStrokeWidth,
+  kSetStrokeMiter,
+  kSetStrokeCap,
+  kSetStrokeJoin,
+  kSetColorSource,
+  kSetColorFilter,
+  kSetInvertColors,
+  kSetBlendMode,
+  kSetPathEffect,
+  kSetMaskFilter,
+  kSetImageFilter,
+
+  kSave,
+  kSaveLayer,
+  kRestore,
+
+  kTranslate,
+  kScale,
+  kRotate,
+  kSkew,
+  kTransform2DAffine,
+  kTransformFullPerspective,
+  kTransformReset,
+
+  kClipRect,
+  kClipRRect,
+  kClipPath,
+
+  kDrawColor,
+  kDrawPaint,
+  kDrawLine,
+  kDrawRect,
+  kDrawOval,
+  kDrawCircle,
+  kDrawRRect,
+  kDrawDRRect,
+  kDrawPath,
+  kDrawArc,
+  kDrawPoints,
+  kDrawVertices,
+  kDrawImage,
+  kDrawImageRect,
+  kDrawImageNine,
+  kDrawAtlas,
+  kDrawShadow,
+};
+
+enum class SerializedColorSource : uint32_t {
+  kNone,
+  kColor,
+  kLinearGradient,
+  kRadialGradient,
+  kConicalGradient,
+  kSweepGradient,
+  kLast = kSweepGradient,
+};
+
+enum class SerializedColorFilter : uint32_t {
+  kNone,
+  kBlend,
+  kMatrix,
+  kSrgbToLinearGamma,
+  kLinearToSrgbGamma,
+  kLast = kLinearToSrgbGamma,
+};
+
+enum class SerializedImageFilter : uint32_t {
+  kNone,
+  kBlur,
+  kDilate,
+  kErode,
+  kMatrix,
+  kCompose,
+  kColorFilter,
+  kLocalMatrix,
+  kLast = kLocalMatrix,
+};
+
+enum class SerializedMaskFilter : uint32_t {
+  kNone,
+  kBlur,
+  kLast = kBlur,
+};
+
+enum class SerializedPathEffect : uint32_t {
+  kNone,
+  kDash,
+  kLast = kDash,
+};
+
+// Written in the byte order of the host. A reader with a different byte
+// order sees a different value.
+constexpr uint32_t kByteOrderMark = 0x01020304;
+
+constexpr uint32_t kNullImageIndex = std::numeric_limits<uint32_t>::max();
+
+// Image filters nest, which bounds the recursion when reading them.
+constexpr int kMaxImageFilterDepth = 16;
+
+struct SerializedHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t op_count;
+  SkRect bounds;
+  uint32_t path_count;
+  uint32_t image_count;
+  uint32_t ops_offset;
+  uint32_t ops_size;
+};
+
+// Follows the header, one for each path. The offset is from the start of the
+// serialized data.
+struct SerializedPathEntry {
+  uint32_t offset;
+  uint32_t size;
+};
+
+// Precedes the arguments of every op. The size includes the header.
+struct SerializedOpHeader {
+  SerializedOp type;
+  uint32_t size;
+};
+
+static_assert(sizeof(SerializedHeader) % 4 == 0);
+static_assert(sizeof(SerializedPathEntry) % 4 == 0);
+static_assert(sizeof(SerializedOpHeader) % 4 == 0);
+
+constexpr size_t Align4(size_t size) {
+  return (size + 3u) & ~size_t{3u};
+}
+
+// Appends values to a byte buffer, padding each one to 4 bytes so that the
+// arrays read in place by |Reader| are aligned.
+class Writer {
+ public:
+  size_t size() const { return data_.size(); }
+
+  void WriteBytes(const void* bytes, size_t size) {
+    const auto* begin = static_cast<const uint8_t*>(bytes);
+    data_.insert(data_.end(), begin, begin + size);
+    data_.resize(Align4(data_.size()));
+  }
+
+  template <typename T>
+  void Write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    WriteBytes(&value, sizeof(T));
+  }
+
+  template <typename T>
+  void WriteAt(size_t offset, const T& value) {
+    FML_DCHECK(offset + sizeof(T) <= data_.size());
+    memcpy(data_.data() + offset, &value, sizeof(T));
+  }
+
+  template <typename T>
+  void WriteArray(const T* values, size_t count) {
+    WriteBytes(values, count * sizeof(T));
+  }
+
+  void WriteBool(bool value) { Write<uint32_t>(value ? 1u : 0u); }
+
+  template <typename T>
+  void WriteEnum(T value) {
+    Write<uint32_t>(static_cast<uint32_t>(value));
+  }
+
+  void WriteColor(DlColor color) { Write<uint32_t>(color.argb()); }
+
+  void WriteMatrix(const SkMatrix& matrix) {
+    SkScalar values[9];
+    matrix.get9(values);
+    WriteArray(values, 9);
+  }
+
+  void WriteRRect(const SkRRect& rrect) {
+    uint8_t buffer[SkRRect::kSizeInMemory];
+    rrect.writeToMemory(buffer);
+    WriteBytes(buffer, sizeof(buffer));
+  }
+
+  std::vector<uint8_t> Take() { return std::move(data_); }
+
+ private:
+  std::vector<uint8_t> data_;
+};
+
+// Reads values written by |Writer| from a bounded range of memory. Any read
+// past the end or of an out of range value marks the reader as failed and
+// returns a default value.
+class Reader {
+ public:
+  Reader(const uint8_t* data, size_t size) : ptr_(data), end_(data + size) {}
+
+  bool ok() const { return ok_; }
+
+  bool at_end() const { return ptr_ == end_; }
+
+  void Fail() { ok_ = false; }
+
+  template <typename T>
+  T Read() {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value{};
+    if (!Has(Align4(sizeof(T)))) {
+      return value;
+    }
+    memcpy(&value, ptr_, sizeof(T));
+    ptr_ += Align4(sizeof(T));
+    return value;
+  }
+
+  // Returns a pointer into the underlying memory, which must be 4 byte
+  // aligned.
+  template <typename T>
+  const T* ReadArray(size_t count) {
+    static_assert(alignof(T) <= 4u);
+    if (count > static_cast<size_t>(end_ - ptr_) / sizeof(T) ||
+        !Has(Align4(count * sizeof(T)))) {
+      Fail();
+      return nullptr;
+    }
+    const T* values = reinterpret_cast<const T*>(ptr_);
+    ptr_ += Align4(count * sizeof(T));
+    return values;
+  }
+
+  bool ReadBool() {
+    auto value = Read<uint32_t>();
+    if (value > 1u) {
+      Fail();
+    }
+    return value == 1u;
+  }
+
+  template <typename T>
+  T ReadEnum(T last) {
+    auto value = Read<uint32_t>();
+    if (value > static_cast<uint32_t>(last)) {
+      Fail();
+      return static_cast<T>(0);
+    }
+    return static_cast<T>(value);
+  }
+
+  DlColor ReadColor() { return DlColor(Read<uint32_t>()); }
+
+  SkMatrix ReadMatrix() {
+    SkMatrix matrix;
+    const SkScalar* values = ReadArray<SkScalar>(9);
+    if (values) {
+      matrix.set9(values);
+    }
+    return matrix;
+  }
+
+  SkRRect ReadRRect() {
+    SkRRect rrect;
+    if (!Has(SkRRect::kSizeInMemory)) {
+      return rrect;
+    }
+    if (rrect.readFromMemory(ptr_, SkRRect::kSizeInMemory) == 0) {
+      Fail();
+      return SkRRect();
+    }
+    ptr_ += SkRRect::kSizeInMemory;
+    return rrect;
+  }
+
+ private:
+  const uint8_t* ptr_;
+  const uint8_t* end_;
+  bool ok_ = true;
+
+  bool Has(size_t size) {
+    if (!ok_ || size > static_cast<size_t>(end_ - ptr_)) {
+      Fail();
+      return false;
+    }
+    return true;
+  }
+};
+
+void WriteGradient(Writer& writer, const DlGradientColorSourceBase* gradient) {
+  writer.WriteEnum(gradient->tile_mode());
+  const SkMatrix* matrix = gradient->matrix_ptr();
+  writer.WriteBool(matrix != nullptr);
+  if (matrix) {
+    writer.WriteMatrix(*matrix);
+  }
+  writer.Write<uint32_t>(gradient->stop_count());
+  writer.WriteArray(gradient->colors(), gradient->stop_count());
+  writer.WriteArray(gradient->stops(), gradient->stop_count());
+}
+
+bool WriteColorSource(Writer& writer, const DlColorSource* source) {
+  if (!source) {
+    writer.WriteEnum(SerializedColorSource::kNone);
+    return true;
+  }
+  if (auto color = source->asColor()) {
+    writer.WriteEnum(SerializedColorSource::kColor);
+    writer.WriteColor(color->color());
+    return true;
+  }
+  if (auto linear = source->asLinearGradient()) {
+    writer.WriteEnum(SerializedColorSource::kLinearGradient);
+    writer.Write(linear->start_point());
+    writer.Write(linear->end_point());
+    WriteGradient(writer, linear);
+    return true;
+  }
+  if (auto radial = source->asRadialGradient()) {
+    writer.WriteEnum(SerializedColorSource::kRadialGradient);
+    writer.Write(radial->center());
+    writer.Write(radial->radius());
+    WriteGradient(writer, radial);
+    return true;
+  }
+  if (auto conical = source->asConicalGradient()) {
+    writer.WriteEnum(SerializedColorSource::kConicalGradient);
+    writer.Write(conical->start_center());
+    writer.Write(conical->start_radius());
+    writer.Write(conical->end_center());
+    writer.Write(conical->end_radius());
+    WriteGradient(writer, conical);
+    return true;
+  }
+  if (auto sweep = source->asSweepGradient()) {
+    writer.WriteEnum(SerializedColorSource::kSweepGradient);
+    writer.Write(sweep->center());
+    writer.Write(sweep->start());
+    writer.Write(sweep->end());
+    WriteGradient(writer, sweep);
+    return true;
+  }
+  // Image sources reference live images and runtime effects reference
+  // compiled shaders and samplers.
+  return false;
+}
+
+std::shared_ptr<DlColorSource> ReadColorSource(Reader& reader) {
+  auto type = reader.ReadEnum(SerializedColorSource::kLast);
+  if (type == SerializedColorSource::kNone) {
+    return nullptr;
+  }
+  if (type == SerializedColorSource::kColor) {
+    return std::make_shared<DlColorColorSource>(reader.ReadColor());
+  }
+
+  // The geometry of each gradient type, in the order written by
+  // |WriteColorSource|.
+  SkPoint p0 = reader.Read<SkPoint>();
+  SkPoint p1;
+  SkScalar s0 = 0.0f;
+  SkScalar s1 = 0.0f;
+  switch (type) {
+    case SerializedColorSource::kLinearGradient:
+      p1 = reader.Read<SkPoint>();
+      break;
+    case SerializedColorSource::kRadialGradient:
+      s0 = reader.Read<SkScalar>();
+      break;
+    case SerializedColorSource::kConicalGradient:
+      s0 = reader.Read<SkScalar>();
+      p1 = reader.Read<SkPoint>();
+      s1 = reader.Read<SkScalar>();
+      break;
+    case SerializedColorSource::kSweepGradient:
+      s0 = reader.Read<SkScalar>();
+      s1 = reader.Read<SkScalar>();
+      break;
+    case SerializedColorSource::kNone:
+    case SerializedColorSource::kColor:
+      FML_UNREACHABLE();
+  }
+
+  auto tile_mode = reader.ReadEnum(DlTileMode::kDecal);
+  bool has_matrix = reader.ReadBool();
+  SkMatrix matrix = has_matrix ? reader.ReadMatrix() : SkMatrix::I();
+  auto stop_count = reader.Read<uint32_t>();
+  const DlColor* colors = reader.ReadArray<DlColor>(stop_count);
+  const float* stops = reader.ReadArray<float>(stop_count);
+  if (!reader.ok()) {
+    return nullptr;
+  }
+  const SkMatrix* matrix_ptr = has_matrix ? &matrix : nullptr;
+  switch (type) {
+    case SerializedColorSource::kLinearGradient:
+      return DlColorSource::MakeLinear(p0, p1, stop_count, colors, stops,
+                                       tile_mode, matrix_ptr);
+    case SerializedColorSource::kRadialGradient:
+      return DlColorSource::MakeRadial(p0, s0, stop_count, colors, stops,
+                                       tile_mode, matrix_ptr);
+    case SerializedColorSource::kConicalGradient:
+      return DlColorSource::MakeConical(p0, s0, p1, s1, stop_count, colors,
+                                        stops, tile_mode, matrix_ptr);
+    case SerializedColorSource::kSweepGradient:
+      return DlColorSource::MakeSweep(p0, s0, s1, stop_count, colors, stops,
+                                      tile_mode, matrix_ptr);
+    case SerializedColorSource::kNone:
+    case SerializedColorSource::kColor:
+      break;
+  }
+  FML_UNREACHABLE();
+}
+
+void WriteColorFilter(Writer& writer, const DlColorFilter* filter) {
+  if (!filter) {
+    writer.WriteEnum(SerializedColorFilter::kNone);
+    return;
+  }
+  switch (filter->type()) {
+    case DlColorFilterType::kBlend:
+      writer.WriteEnum(SerializedColorFilter::kBlend);
+      writer.WriteColor(filter->asBlend()->color());
+      writer.WriteEnum(filter->asBlend()->mode());
+      return;
+    case DlColorFilterType::kMatrix: {
+      float matrix[20];
+      filter->asMatrix()->get_matrix(matrix);
+      writer.WriteEnum(SerializedColorFilter::kMatrix);
+      writer.WriteArray(matrix, 20);
+      return;
+    }
+    case DlColorFilterType::kSrgbToLinearGamma:
+      writer.WriteEnum(SerializedColorFilter::kSrgbToLinearGamma);
+      return;
+    case DlColorFilterType::kLinearToSrgbGamma:
+      writer.WriteEnum(SerializedColorFilter::kLinearToSrgbGamma);
+      return;
+  }
+  FML_UNREACHABLE();
+}
+
+std::shared_ptr<const DlColorFilter> ReadColorFilter(Reader& reader) {
+  switch (reader.ReadEnum(SerializedColorFilter::kLast)) {
+    case SerializedColorFilter::kNone:
+      return nullptr;
+    case SerializedColorFilter::kBlend: {
+      DlColor color = reader.ReadColor();
+      DlBlendMode mode = reader.ReadEnum(DlBlendMode::kLastMode);
+      return std::make_shared<DlBlendColorFilter>(color, mode);
+    }
+    case SerializedColorFilter::kMatrix: {
+      const float* matrix = reader.ReadArray<float>(20);
+      if (!matrix) {
+        return nullptr;
+      }
+      return std::make_shared<DlMatrixColorFilter>(matrix);
+    }
+    case SerializedColorFilter::kSrgbToLinearGamma:
+      return DlSrgbToLinearGammaColorFilter::kInstance;
+    case SerializedColorFilter::kLinearToSrgbGamma:
+      return DlLinearToSrgbGammaColorFilter::kInstance;
+  }
+  FML_UNREACHABLE();
+}
+
+void WriteImageFilter(Writer& writer, const DlImageFilter* filter) {
+  if (!filter) {
+    writer.WriteEnum(SerializedImageFilter::kNone);
+    return;
+  }
+  switch (filter->type()) {
+    case DlImageFilterType::kBlur:
+      writer.WriteEnum(SerializedImageFilter::kBlur);
+      writer.Write(filter->asBlur()->sigma_x());
+      writer.Write(filter->asBlur()->sigma_y());
+      writer.WriteEnum(filter->asBlur()->tile_mode());
+      return;
+    case DlImageFilterType::kDilate:
+      writer.WriteEnum(SerializedImageFilter::kDilate);
+      writer.Write(filter->asDilate()->radius_x());
+      writer.Write(filter->asDilate()->radius_y());
+      return;
+    case DlImageFilterType::kErode:
+      writer.WriteEnum(SerializedImageFilter::kErode);
+      writer.Write(filter->asErode()->radius_x());
+      writer.Write(filter->asErode()->radius_y());
+      return;
+    case DlImageFilterType::kMatrix:
+      writer.WriteEnum(SerializedImageFilter::kMatrix);
+      writer.WriteMatrix(filter->asMatrix()->matrix());
+      writer.WriteEnum(filter->asMatrix()->sampling());
+      return;
+    case DlImageFilterType::kCompose:
+      writer.WriteEnum(SerializedImageFilter::kCompose);
+      WriteImageFilter(writer, filter->asCompose()->outer().get());
+      WriteImageFilter(writer, filter->asCompose()->inner().get());
+      return;
+    case DlImageFilterType::kColorFilter:
+      writer.WriteEnum(SerializedImageFilter::kColorFilter);
+      WriteColorFilter(writer, filter->asColorFilter()->color_filter().get());
+      return;
+    case DlImageFilterType::kLocalMatrix:
+      writer.WriteEnum(SerializedImageFilter::kLocalMatrix);
+      writer.WriteMatrix(filter->asLocalMatrix()->matrix());
+      WriteImageFilter(writer, filter->asLocalMatrix()->image_filter().get());
+      return;
+  }
+  FML_UNREACHABLE();
+}
+
+std::shared_ptr<DlImageFilter> ReadImageFilter(Reader& reader, int depth) {
+  if (depth > kMaxImageFilterDepth) {
+    reader.Fail();
+    return nullptr;
+  }
+  switch (reader.ReadEnum(SerializedImageFilter::kLast)) {
+    case SerializedImageFilter::kNone:
+      return nullptr;
+    case SerializedImageFilter::kBlur: {
+      auto sigma_x = reader.Read<SkScalar>();
+      auto sigma_y = reader.Read<SkScalar>();
+      auto tile_mode = reader.ReadEnum(DlTileMode::kDecal);
+      return std::make_shared<DlBlurImageFilter>(sigma_x, sigma_y, tile_mode);
+    }
+    case SerializedImageFilter::kDilate: {
+      auto radius_x = reader.Read<SkScalar>();
+      auto radius_y = reader.Read<SkScalar>();
+      return std::make_shared<DlDilateImageFilter>(radius_x, radius_y);
+    }
+    case SerializedImageFilter::kErode: {
+      auto radius_x = reader.Read<SkScalar>();
+      auto radius_y = reader.Read<SkScalar>();
+      return std::make_shared<DlErodeImageFilter>(radius_x, radius_y);
+    }
+    case SerializedImageFilter::kMatrix: {
+      SkMatrix matrix = reader.ReadMatrix();
+      auto sampling = reader.ReadEnum(DlImageSampling::kCubic);
+      return std::make_shared<DlMatrixImageFilter>(matrix, sampling);
+    }
+    case SerializedImageFilter::kCompose: {
+      auto outer = ReadImageFilter(reader, depth + 1);
+      auto inner = ReadImageFilter(reader, depth + 1);
+      if (!outer || !inner) {
+        reader.Fail();
+        return nullptr;
+      }
+      return std::make_shared<DlComposeImageFilter>(outer, inner);
+    }
+    case SerializedImageFilter::kColorFilter: {
+      auto color_filter = ReadColorFilter(reader);
+      if (!color_filter) {
+        reader.Fail();
+        return nullptr;
+      }
+      return std::make_shared<DlColorFilterImageFilter>(color_filter);
+    }
+    case SerializedImageFilter::kLocalMatrix: {
+      SkMatrix matrix = reader.ReadMatrix();
+      auto image_filter = ReadImageFilter(reader, depth + 1);
+      if (!image_filter) {
+        reader.Fail();
+        return nullptr;
+      }
+      return std::make_shared<DlLocalMatrixImageFilter>(matrix, image_filter);
+    }
+  }
+  FML_UNREACHABLE();
+}
+
+// Records the ops dispatched by a |DisplayList| into the serialized format.
+class DlOpSerializer final : public virtual DlOpReceiver {
+ public:
+  DlOpSerializer() = default;
+
+  bool failed() const { return failed_; }
+
+  std::vector<sk_sp<DlImage>> TakeImages() { return std::move(images_); }
+
+  std::vector<uint8_t> Finish(const SkRect& bounds) {
+    Writer writer;
+    SerializedHeader header = {
+        .magic = DlSerializedDisplayList::kMagic,
+        .version = DlSerializedDisplayList::kVersion,
+        .byte_order = kByteOrderMark,
+        .op_count = op_count_,
+        .bounds = bounds,
+        .path_count = static_cast<uint32_t>(paths_.size()),
+        .image_count = static_cast<uint32_t>(images_.size()),
+    };
+    writer.Write(header);
+
+    size_t entries_offset = writer.size();
+    for (size_t i = 0; i < paths_.size(); i++) {
+      writer.Write(SerializedPathEntry{});
+    }
+    std::vector<uint8_t> path_data;
+    for (size_t i = 0; i < paths_.size(); i++) {
+      path_data.resize(paths_[i].writeToMemory(nullptr));
+      paths_[i].writeToMemory(path_data.data());
+      writer.WriteAt(entries_offset + i * sizeof(SerializedPathEntry),
+                     SerializedPathEntry{
+                         .offset = static_cast<uint32_t>(writer.size()),
+                         .size = static_cast<uint32_t>(path_data.size()),
+                     });
+      writer.WriteBytes(path_data.data(), path_data.size());
+    }
+
+    header.ops_offset = static_cast<uint32_t>(writer.size());
+    header.ops_size = static_cast<uint32_t>(ops_.size());
+    writer.WriteAt(0u, header);
+    std::vector<uint8_t> ops = ops_.Take();
+    writer.WriteBytes(ops.data(), ops.size());
+    return writer.Take();
+  }
+
+  void setAntiAlias(bool aa) override {
+    attributes_.setAntiAlias(aa);
+    Begin(SerializedOp::kSetAntiAlias).WriteBool(aa);
+    End();
+  }
+  void setDrawStyle(DlDrawStyle style) override {
+    attributes_.setDrawStyle(style);
+    Begin(SerializedOp::kSetDrawStyle).WriteEnum(style);
+    End();
+  }
+  void setColor(DlColor color) override {
+    attributes_.setColor(color);
+    Begin(SerializedOp::kSetColor).WriteColor(color);
+    End();
+  }
+  void setStrokeWidth(float width) override {
+    attributes_.setStrokeWidth(width);
+    Begin(SerializedOp::kSetStrokeWidth).Write(width);
+    End();
+  }
+  void setStrokeMiter(float limit) override {
+    attributes_.setStrokeMiter(limit);
+    Begin(SerializedOp::kSetStrokeMiter).Write(limit);
+    End();
+  }
+  void setStrokeCap(DlStrokeCap cap) override {
+    attributes_.setStrokeCap(cap);
+    Begin(SerializedOp::kSetStrokeCap).WriteEnum(cap);
+    End();
+  }
+  void setStrokeJoin(DlStrokeJoin join) override {
+    attributes_.setStrokeJoin(join);
+    Begin(SerializedOp::kSetStrokeJoin).WriteEnum(join);
+    End();
+  }
+  void setColorSource(const DlColorSource* source) override {
+    attributes_.setColorSource(source);
+    if (!WriteColorSource(Begin(SerializedOp::kSetColorSource), source)) {
+      failed_ = true;
+    }
+    End();
+  }
+  void setColorFilter(const DlColorFilter* filter) override {
+    attributes_.setColorFilter(filter);
+    WriteColorFilter(Begin(SerializedOp::kSetColorFilter), filter);
+    End();
+  }
+  void setInvertColors(bool invert) override {
+    attributes_.setInvertColors(invert);
+    Begin(SerializedOp::kSetInvertColors).WriteBool(invert);
+    End();
+  }
+  void setBlendMode(DlBlendMode mode) override {
+    attributes_.setBlendMode(mode);
+    Begin(SerializedOp::kSetBlendMode).WriteEnum(mode);
+    End();
+  }
+  void setPathEffect(const DlPathEffect* effect) override {
+    attributes_.setPathEffect(effect);
+    auto& writer = Begin(SerializedOp::kSetPathEffect);
+    if (effect && effect->asDash()) {
+      const DlDashPathEffect* dash = effect->asDash();
+      writer.WriteEnum(SerializedPathEffect::kDash);
+      writer.Write(dash->phase());
+      writer.Write<uint32_t>(dash->count());
+      writer.WriteArray(dash->intervals(), dash->count());
+    } else {
+      writer.WriteEnum(SerializedPathEffect::kNone);
+    }
+    End();
+  }
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    attributes_.setMaskFilter(filter);
+    auto& writer = Begin(SerializedOp::kSetMaskFilter);
+    if (filter && filter->asBlur()) {
+      writer.WriteEnum(SerializedMaskFilter::kBlur);
+      writer.WriteEnum(filter->asBlur()->style());
+      writer.Write(filter->asBlur()->sigma());
+      writer.WriteBool(filter->asBlur()->respectCTM());
+    } else {
+      writer.WriteEnum(SerializedMaskFilter::kNone);
+    }
+    End();
+  }
+  void setImageFilter(const DlImageFilter* filter) override {
+    attributes_.setImageFilter(filter);
+    WriteImageFilter(Begin(SerializedOp::kSetImageFilter), filter);
+    End();
+  }
+
+  void save() override {
+    Begin(SerializedOp::kSave);
+    End();
+  }
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    auto& writer = Begin(SerializedOp::kSaveLayer);
+    writer.WriteBool(options.renders_with_attributes());
+    writer.WriteBool(options.can_distribute_opacity());
+    writer.WriteBool(bounds != nullptr);
+    writer.Write(bounds ? *bounds : SkRect::MakeEmpty());
+    WriteImageFilter(writer, backdrop);
+    End();
+  }
+  void restore() override {
+    Begin(SerializedOp::kRestore);
+    End();
+  }
+
+  void translate(SkScalar tx, SkScalar ty) override {
+    WriteScalars(SerializedOp::kTranslate, {tx, ty});
+  }
+  void scale(SkScalar sx, SkScalar sy) override {
+    WriteScalars(SerializedOp::kScale, {sx, sy});
+  }
+  void rotate(SkScalar degrees) override {
+    WriteScalars(SerializedOp::kRotate, {degrees});
+  }
+  void skew(SkScalar sx, SkScalar sy) override {
+    WriteScalars(SerializedOp::kSkew, {sx, sy});
+  }
+  // clang-format off
+  void transform2DAffine(SkScalar mxx, SkScalar mxy, SkScalar mxt,
+                         SkScalar myx, SkScalar myy, SkScalar myt) override {
+    WriteScalars(SerializedOp::kTransform2DAffine,
+                 {mxx, mxy, mxt,
+                  myx, myy, myt});
+  }
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override {
+    WriteScalars(SerializedOp::kTransformFullPerspective,
+                 {mxx, mxy, mxz, mxt,
+                  myx, myy, myz, myt,
+                  mzx, mzy, mzz, mzt,
+                  mwx, mwy, mwz, mwt});
+  }
+  // clang-format on
+  void transformReset() override {
+    // Inlined display lists can't reset to the transform they were drawn
+    // with.
+    if (nesting_depth_ > 0) {
+      failed_ = true;
+    }
+    Begin(SerializedOp::kTransformReset);
+    End();
+  }
+
+  void clipRect(const SkRect& rect, ClipOp clip_op, bool is_aa) override {
+    auto& writer = Begin(SerializedOp::kClipRect);
+    writer.Write(rect);
+    writer.WriteEnum(clip_op);
+    writer.WriteBool(is_aa);
+    End();
+  }
+  void clipRRect(const SkRRect& rrect, ClipOp clip_op, bool is_aa) override {
+    auto& writer = Begin(SerializedOp::kClipRRect);
+    writer.WriteRRect(rrect);
+    writer.WriteEnum(clip_op);
+    writer.WriteBool(is_aa);
+    End();
+  }
+  void clipPath(const SkPath& path, ClipOp clip_op, bool is_aa) override {
+    auto& writer = Begin(SerializedOp::kClipPath);
+    writer.Write(PathIndex(path));
+    writer.WriteEnum(clip_op);
+    writer.WriteBool(is_aa);
+    End();
+  }
+
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    auto& writer = Begin(SerializedOp::kDrawColor);
+    writer.WriteColor(color);
+    writer.WriteEnum(mode);
+    End();
+  }
+  void drawPaint() override {
+    Begin(SerializedOp::kDrawPaint);
+    End();
+  }
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override {
+    auto& writer = Begin(SerializedOp::kDrawLine);
+    writer.Write(p0);
+    writer.Write(p1);
+    End();
+  }
+  void drawRect(const SkRect& rect) override {
+    Begin(SerializedOp::kDrawRect).Write(rect);
+    End();
+  }
+  void drawOval(const SkRect& bounds) override {
+    Begin(SerializedOp::kDrawOval).Write(bounds);
+    End();
+  }
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    auto& writer = Begin(SerializedOp::kDrawCircle);
+    writer.Write(center);
+    writer.Write(radius);
+    End();
+  }
+  void drawRRect(const SkRRect& rrect) override {
+    Begin(SerializedOp::kDrawRRect).WriteRRect(rrect);
+    End();
+  }
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    auto& writer = Begin(SerializedOp::kDrawDRRect);
+    writer.WriteRRect(outer);
+    writer.WriteRRect(inner);
+    End();
+  }
+  void drawPath(const SkPath& path) override {
+    Begin(SerializedOp::kDrawPath).Write(PathIndex(path));
+    End();
+  }
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    auto& writer = Begin(SerializedOp::kDrawArc);
+    writer.Write(oval_bounds);
+    writer.Write(start_degrees);
+    writer.Write(sweep_degrees);
+    writer.WriteBool(use_center);
+    End();
+  }
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    auto& writer = Begin(SerializedOp::kDrawPoints);
+    writer.WriteEnum(mode);
+    writer.Write(count);
+    writer.WriteArray(points, count);
+    End();
+  }
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+    auto& writer = Begin(SerializedOp::kDrawVertices);
+    writer.WriteEnum(mode);
+    writer.WriteEnum(vertices->mode());
+    writer.Write<uint32_t>(vertices->vertex_count());
+    writer.Write<uint32_t>(vertices->index_count());
+    writer.WriteBool(vertices->texture_coordinates() != nullptr);
+    writer.WriteBool(vertices->colors() != nullptr);
+    writer.WriteArray(vertices->vertices(), vertices->vertex_count());
+    if (vertices->texture_coordinates()) {
+      writer.WriteArray(vertices->texture_coordinates(),
+                        vertices->vertex_count());
+    }
+    if (vertices->colors()) {
+      writer.WriteArray(vertices->colors(), vertices->vertex_count());
+    }
+    if (vertices->indices()) {
+      writer.WriteArray(vertices->indices(), vertices->index_count());
+    }
+    End();
+  }
+  void drawImage(const sk_sp<DlImage> image,
+                 const SkPoint point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    auto& writer = Begin(SerializedOp::kDrawImage);
+    writer.Write(ImageIndex(image));
+    writer.Write(point);
+    writer.WriteEnum(sampling);
+    writer.WriteBool(render_with_attributes);
+    End();
+  }
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SrcRectConstraint constraint) override {
+    auto& writer = Begin(SerializedOp::kDrawImageRect);
+    writer.Write(ImageIndex(image));
+    writer.Write(src);
+    writer.Write(dst);
+    writer.WriteEnum(sampling);
+    writer.WriteBool(render_with_attributes);
+    writer.WriteEnum(constraint);
+    End();
+  }
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    auto& writer = Begin(SerializedOp::kDrawImageNine);
+    writer.Write(ImageIndex(image));
+    writer.Write(center);
+    writer.Write(dst);
+    writer.WriteEnum(filter);
+    writer.WriteBool(render_with_attributes);
+    End();
+  }
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    auto& writer = Begin(SerializedOp::kDrawAtlas);
+    writer.Write(ImageIndex(atlas));
+    writer.Write<uint32_t>(count);
+    writer.WriteEnum(mode);
+    writer.WriteEnum(sampling);
+    writer.WriteBool(render_with_attributes);
+    writer.WriteBool(colors != nullptr);
+    writer.WriteBool(cull_rect != nullptr);
+    writer.Write(cull_rect ? *cull_rect : SkRect::MakeEmpty());
+    writer.WriteArray(xform, count);
+    writer.WriteArray(tex, count);
+    if (colors) {
+      writer.WriteArray(colors, count);
+    }
+    End();
+  }
+  // Nested display lists are inlined between a save and a restore, or in a
+  // layer when drawn with an opacity. They are recorded from the default
+  // attributes, so those are set before the nested ops and the attributes of
+  // this list are set again after them.
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       SkScalar opacity) override {
+    DlPaint outer_attributes = attributes_;
+    if (opacity < SK_Scalar1) {
+      WriteAttributes(DlPaint().setOpacity(opacity));
+      saveLayer(&display_list->bounds(),
+                SaveLayerOptions::kWithAttributes, nullptr);
+    } else {
+      save();
+    }
+    WriteAttributes(DlPaint());
+    nesting_depth_++;
+    display_list->Dispatch(*this);
+    nesting_depth_--;
+    restore();
+    WriteAttributes(outer_attributes);
+  }
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    failed_ = true;
+  }
+  void drawTextFrame(const std::shared_ptr<impeller::TextFrame>& text_frame,
+                     SkScalar x,
+                     SkScalar y) override {
+    failed_ = true;
+  }
+  void drawShadow(const SkPath& path,
+                  const DlColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    auto& writer = Begin(SerializedOp::kDrawShadow);
+    writer.Write(PathIndex(path));
+    writer.WriteColor(color);
+    writer.Write(elevation);
+    writer.WriteBool(transparent_occluder);
+    writer.Write(dpr);
+    End();
+  }
+
+ private:
+  Writer ops_;
+  size_t op_offset_ = 0u;
+  uint32_t op_count_ = 0u;
+  bool failed_ = false;
+
+  std::vector<SkPath> paths_;
+  std::unordered_map<uint32_t, uint32_t> path_indices_;
+  std::vector<sk_sp<DlImage>> images_;
+  std::unordered_map<const DlImage*, uint32_t> image_indices_;
+
+  // The current attributes, and the number of nested display lists being
+  // inlined.
+  DlPaint attributes_;
+  int nesting_depth_ = 0;
+
+  // Sets the attributes that differ from the current ones.
+  void WriteAttributes(const DlPaint& paint) {
+    if (paint.isAntiAlias() != attributes_.isAntiAlias()) {
+      setAntiAlias(paint.isAntiAlias());
+    }
+    if (paint.getDrawStyle() != attributes_.getDrawStyle()) {
+      setDrawStyle(paint.getDrawStyle());
+    }
+    if (paint.getColor() != attributes_.getColor()) {
+      setColor(paint.getColor());
+    }
+    if (paint.getStrokeWidth() != attributes_.getStrokeWidth()) {
+      setStrokeWidth(paint.getStrokeWidth());
+    }
+    if (paint.getStrokeMiter() != attributes_.getStrokeMiter()) {
+      setStrokeMiter(paint.getStrokeMiter());
+    }
+    if (paint.getStrokeCap() != attributes_.getStrokeCap()) {
+      setStrokeCap(paint.getStrokeCap());
+    }
+    if (paint.getStrokeJoin() != attributes_.getStrokeJoin()) {
+      setStrokeJoin(paint.getStrokeJoin());
+    }
+    if (!Equals(paint.getColorSourcePtr(), attributes_.getColorSourcePtr())) {
+      setColorSource(paint.getColorSourcePtr());
+    }
+    if (!Equals(paint.getColorFilterPtr(), attributes_.getColorFilterPtr())) {
+      setColorFilter(paint.getColorFilterPtr());
+    }
+    if (paint.isInvertColors() != attributes_.isInvertColors()) {
+      setInvertColors(paint.isInvertColors());
+    }
+    if (paint.getBlendMode() != attributes_.getBlendMode()) {
+      setBlendMode(paint.getBlendMode());
+    }
+    if (!Equals(paint.getPathEffectPtr(), attributes_.getPathEffectPtr())) {
+      setPathEffect(paint.getPathEffectPtr());
+    }
+    if (!Equals(paint.getMaskFilterPtr(), attributes_.getMaskFilterPtr())) {
+      setMaskFilter(paint.getMaskFilterPtr());
+    }
+    if (!Equals(paint.getImageFilterPtr(), attributes_.getImageFilterPtr())) {
+      setImageFilter(paint.getImageFilterPtr());
+    }
+  }
+
+  Writer& Begin(SerializedOp type) {
+    op_offset_ = ops_.size();
+    ops_.Write(SerializedOpHeader{.type = type});
+    return ops_;
+  }
+
+  void End() {
+    ops_.WriteAt(op_offset_ + offsetof(SerializedOpHeader, size),
+                 static_cast<uint32_t>(ops_.size() - op_offset_));
+    op_count_++;
+  }
+
+  void WriteScalars(SerializedOp type,
+                    std::initializer_list<SkScalar> scalars) {
+    Begin(type).WriteArray(scalars.begin(), scalars.size());
+    End();
+  }
+
+  // Paths with the same generation ID have the same contents, so they share
+  // an entry of the path table.
+  uint32_t PathIndex(const SkPath& path) {
+    auto [it, inserted] = path_indices_.try_emplace(
+        path.getGenerationID(), static_cast<uint32_t>(paths_.size()));
+    if (inserted) {
+      paths_.push_back(path);
+    }
+    return it->second;
+  }
+
+  uint32_t ImageIndex(const sk_sp<DlImage>& image) {
+    if (!image) {
+      return kNullImageIndex;
+    }
+    auto [it, inserted] = image_indices_.try_emplace(
+        image.get(), static_cast<uint32_t>(images_.size()));
+    if (inserted) {
+      images_.push_back(image);
+    }
+    return it->second;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlOpSerializer);
+};
+
+// Reads every op without acting on any of them, to validate a mapping.
+class DlOpValidator final : public IgnoreAttributeDispatchHelper,
+                            public IgnoreClipDispatchHelper,
+                            public IgnoreTransformDispatchHelper,
+                            public IgnoreDrawDispatchHelper {};
+
+}  // namespace
+
+std::unique_ptr<DlSerializedDisplayList> DlSerializedDisplayList::Serialize(
+    const DisplayList& display_list) {
+  TRACE_EVENT0("flutter", "DlSerializedDisplayList::Serialize");
+  DlOpSerializer serializer;
+  display_list.Dispatch(serializer);
+  if (serializer.failed()) {
+    return nullptr;
+  }
+  auto data = serializer.Finish(display_list.bounds());
+  return Make(std::make_shared<fml::DataMapping>(std::move(data)),
+              serializer.TakeImages());
+}
+
+std::unique_ptr<DlSerializedDisplayList> DlSerializedDisplayList::Make(
+    std::shared_ptr<const fml::Mapping> mapping,
+    std::vector<sk_sp<DlImage>> images) {
+  TRACE_EVENT0("flutter", "DlSerializedDisplayList::Make");
+  if (!mapping || !mapping->GetMapping()) {
+    return nullptr;
+  }
+  auto serialized = std::unique_ptr<DlSerializedDisplayList>(
+      new DlSerializedDisplayList(std::move(mapping), std::move(images)));
+  if (!serialized->Load()) {
+    return nullptr;
+  }
+  DlOpValidator validator;
+  if (!serialized->DispatchOps(validator)) {
+    return nullptr;
+  }
+  return serialized;
+}
+
+static constexpr const char* kOpsFileExtension = ".dlsz";
+static constexpr const char* kImagesFileExtension = ".images";
+
+std::unique_ptr<DlSerializedDisplayList>
+DlSerializedDisplayList::ReadFromDirectory(const fml::UniqueFD& directory,
+                                           const std::string& name,
+                                           const ImageFactory& image_factory) {
+  std::shared_ptr<const fml::Mapping> ops =
+      fml::FileMapping::CreateReadOnly(directory, name + kOpsFileExtension);
+  auto image_sizes =
+      fml::FileMapping::CreateReadOnly(directory, name + kImagesFileExtension);
+  if (!ops || !image_sizes) {
+    return nullptr;
+  }
+  std::istringstream stream(
+      std::string(reinterpret_cast<const char*>(image_sizes->GetMapping()),
+                  image_sizes->GetSize()));
+  std::vector<sk_sp<DlImage>> images;
+  int32_t width;
+  int32_t height;
+  while (stream >> width >> height) {
+    auto image = image_factory(SkISize::Make(width, height));
+    if (!image) {
+      return nullptr;
+    }
+    images.push_back(std::move(image));
+  }
+  if (!stream.eof()) {
+    return nullptr;
+  }
+  return Make(std::move(ops), std::move(images));
+}
+
+bool DlSerializedDisplayList::WriteToDirectory(const fml::UniqueFD& directory,
+                                               const std::string& name) const {
+  std::ostringstream image_sizes;
+  for (const auto& image : images_) {
+    auto size = image ? image->dimensions() : SkISize::MakeEmpty();
+    image_sizes << size.width() << " " << size.height() << "\n";
+  }
+  fml::DataMapping image_sizes_mapping(image_sizes.str());
+  return fml::WriteAtomically(directory, (name + kOpsFileExtension).c_str(),
+                              *mapping_) &&
+         fml::WriteAtomically(directory, (name + kImagesFileExtension).c_str(),
+                              image_sizes_mapping);
+}
+
+DlSerializedDisplayList::DlSerializedDisplayList(
+    std::shared_ptr<const fml::Mapping> mapping,
+    std::vector<sk_sp<DlImage>> images)
+    : mapping_(std::move(mapping)), images_(std::move(images)) {}
+
+DlSerializedDisplayList::~DlSerializedDisplayList() = default;
+
+bool DlSerializedDisplayList::Load() {
+  const uint8_t* data = mapping_->GetMapping();
+  const size_t size = mapping_->GetSize();
+  if (reinterpret_cast<uintptr_t>(data) % 4u != 0u) {
+    return false;
+  }
+  Reader reader(data, size);
+  auto header = reader.Read<SerializedHeader>();
+  if (!reader.ok() || header.magic != kMagic || header.version != kVersion ||
+      header.byte_order != kByteOrderMark ||
+      header.image_count != images_.size() || header.ops_offset % 4u != 0u ||
+      header.ops_offset > size || header.ops_size > size - header.ops_offset) {
+    return false;
+  }
+  const auto* entries =
+      reader.ReadArray<SerializedPathEntry>(header.path_count);
+  if (!entries) {
+    return false;
+  }
+  paths_.resize(header.path_count);
+  for (uint32_t i = 0; i < header.path_count; i++) {
+    if (entries[i].offset > size || entries[i].size > size - entries[i].offset ||
+        paths_[i].readFromMemory(data + entries[i].offset, entries[i].size) ==
+            0u) {
+      return false;
+    }
+  }
+  bounds_ = header.bounds;
+  op_count_ = header.op_count;
+  ops_ = data + header.ops_offset;
+  ops_size_ = header.ops_size;
+  return true;
+}
+
+void DlSerializedDisplayList::Dispatch(DlOpReceiver& receiver) const {
+  // The ops were validated by |Make|.
+  [[maybe_unused]] bool result = DispatchOps(receiver);
+  FML_DCHECK(result);
+}
+
+bool DlSerializedDisplayList::DispatchOps(DlOpReceiver& receiver) const {
+  using ClipOp = DlCanvas::ClipOp;
+  using PointMode = DlCanvas::PointMode;
+  using SrcRectConstraint = DlCanvas::SrcRectConstraint;
+
+  auto read_path = [this](Reader& reader) -> const SkPath* {
+    auto index = reader.Read<uint32_t>();
+    if (index >= paths_.size()) {
+      reader.Fail();
+      return nullptr;
+    }
+    return &paths_[index];
+  };
+  auto read_image = [this](Reader& reader) -> sk_sp<DlImage> {
+    auto index = reader.Read<uint32_t>();
+    if (index == kNullImageIndex) {
+      return nullptr;
+    }
+    if (index >= images_.size()) {
+      reader.Fail();
+      return nullptr;
+    }
+    return images_[index];
+  };
+
+  Reader stream(ops_, ops_size_);
+  unsigned int op_count = 0u;
+  while (!stream.at_end()) {
+    auto header = stream.Read<SerializedOpHeader>();
+    if (!stream.ok() || header.size < sizeof(SerializedOpHeader)) {
+      return false;
+    }
+    const size_t args_size = header.size - sizeof(SerializedOpHeader);
+    const auto* args = stream.ReadArray<uint8_t>(args_size);
+    if (!args) {
+      return false;
+    }
+    Reader reader(args, args_size);
+
+// Reads the arguments of an op into local variables before dispatching it,
+// so that a malformed op is never seen by the receiver.
+#define DL_SERIALIZED_DISPATCH(call)    \
+  if (!reader.ok() || !reader.at_end()) { \
+    return false;                         \
+  }                                       \
+  receiver.call;                          \
+  break;
+
+    switch (header.type) {
+      case SerializedOp::kSetAntiAlias: {
+        bool aa = reader.ReadBool();
+        DL_SERIALIZED_DISPATCH(setAntiAlias(aa));
+      }
+      case SerializedOp::kSetDrawStyle: {
+        auto style = reader.ReadEnum(DlDrawStyle::kLastStyle);
+        DL_SERIALIZED_DISPATCH(setDrawStyle(style));
+      }
+      case SerializedOp::kSetColor: {
+        DlColor color = reader.ReadColor();
+        DL_SERIALIZED_DISPATCH(setColor(color));
+      }
+      case SerializedOp::kSetStrokeWidth: {
+        auto width = reader.Read<float>();
+        DL_SERIALIZED_DISPATCH(setStrokeWidth(width));
+      }
+      case SerializedOp::kSetStrokeMiter: {
+        auto limit = reader.Read<float>();
+        DL_SERIALIZED_DISPATCH(setStrokeMiter(limit));
+      }
+      case SerializedOp::kSetStrokeCap: {
+        auto cap = reader.ReadEnum(DlStrokeCap::kLastCap);
+        DL_SERIALIZED_DISPATCH(setStrokeCap(cap));
+      }
+      case SerializedOp::kSetStrokeJoin: {
+        auto join = reader.ReadEnum(DlStrokeJoin::kLastJoin);
+        DL_SERIALIZED_DISPATCH(setStrokeJoin(join));
+      }
+      case SerializedOp::kSetColorSource: {
+        auto source = ReadColorSource(reader);
+        DL_SERIALIZED_DISPATCH(setColorSource(source.get()));
+      }
+      case SerializedOp::kSetColorFilter: {
+        auto filter = ReadColorFilter(reader);
+        DL_SERIALIZED_DISPATCH(setColorFilter(filter.get()));
+      }
+      case SerializedOp::kSetInvertColors: {
+        bool invert = reader.ReadBool();
+        DL_SERIALIZED_DISPATCH(setInvertColors(invert));
+      }
+      case SerializedOp::kSetBlendMode: {
+        auto mode = reader.ReadEnum(DlBlendMode::kLastMode);
+        DL_SERIALIZED_DISPATCH(setBlendMode(mode));
+      }
+      case SerializedOp::kSetPathEffect: {
+        std::shared_ptr<DlPathEffect> effect;
+        if (reader.ReadEnum(SerializedPathEffect::kLast) ==
+            SerializedPathEffect::kDash) {
+          auto phase = reader.Read<SkScalar>();
+          auto count = reader.Read<uint32_t>();
+          const SkScalar* intervals = reader.ReadArray<SkScalar>(count);
+          if (intervals) {
+            effect = DlDashPathEffect::Make(intervals, count, phase);
+          }
+        }
+        DL_SERIALIZED_DISPATCH(setPathEffect(effect.get()));
+      }
+      case SerializedOp::kSetMaskFilter: {
+        std::shared_ptr<DlMaskFilter> filter;
+        if (reader.ReadEnum(SerializedMaskFilter::kLast) ==
+            SerializedMaskFilter::kBlur) {
+          auto style = reader.ReadEnum(DlBlurStyle::kInner);
+          auto sigma = reader.Read<SkScalar>();
+          bool respect_ctm = reader.ReadBool();
+          filter =
+              std::make_shared<DlBlurMaskFilter>(style, sigma, respect_ctm);
+        }
+        DL_SERIALIZED_DISPATCH(setMaskFilter(filter.get()));
+      }
+      case SerializedOp::kSetImageFilter: {
+        auto filter = ReadImageFilter(reader, 0);
+        DL_SERIALIZED_DISPATCH(setImageFilter(filter.get()));
+      }
+
+      case SerializedOp::kSave: {
+        DL_SERIALIZED_DISPATCH(save());
+      }
+      case SerializedOp::kSaveLayer: {
+        SaveLayerOptions options;
+        if (reader.ReadBool()) {
+          options = options.with_renders_with_attributes();
+        }
+        if (reader.ReadBool()) {
+          options = options.with_can_distribute_opacity();
+        }
+        bool has_bounds = reader.ReadBool();
+        auto bounds = reader.Read<SkRect>();
+        auto backdrop = ReadImageFilter(reader, 0);
+        DL_SERIALIZED_DISPATCH(saveLayer(has_bounds ? &bounds : nullptr,
+                                         options, backdrop.get()));
+      }
+      case SerializedOp::kRestore: {
+        DL_SERIALIZED_DISPATCH(restore());
+      }
+
+      case SerializedOp::kTranslate: {
+        const SkScalar* m = reader.ReadArray<SkScalar>(2);
+        DL_SERIALIZED_DISPATCH(translate(m[0], m[1]));
+      }
+      case SerializedOp::kScale: {
+        const SkScalar* m = reader.ReadArray<SkScalar>(2);
+        DL_SERIALIZED_DISPATCH(scale(m[0], m[1]));
+      }
+      case SerializedOp::kRotate: {
+        const SkScalar* m = reader.ReadArray<SkScalar>(1);
+        DL_SERIALIZED_DISPATCH(rotate(m[0]));
+      }
+      case SerializedOp::kSkew: {
+        const SkScalar* m = reader.ReadArray<SkScalar>(2);
+        DL_SERIALIZED_DISPATCH(skew(m[0], m[1]));
+      }
+      case SerializedOp::kTransform2DAffine: {
+        const SkScalar* m = reader.ReadArray<SkScalar>(6);
+        DL_SERIALIZED_DISPATCH(
+            transform2DAffine(m[0], m[1], m[2], m[3], m[4], m[5]));
+      }
+      case SerializedOp::kTransformFullPerspective: {
+        const SkScalar* m = reader.ReadArray<SkScalar>(16);
+        // clang-format off
+        DL_SERIALIZED_DISPATCH(transformFullPerspective(
+            m[0],  m[1],  m[2],  m[3],
+            m[4],  m[5],  m[6],  m[7],
+            m[8],  m[9],  m[10], m[11],
+            m[12], m[13], m[14], m[15]));
+        // clang-format on
+      }
+      case SerializedOp::kTransformReset: {
+        DL_SERIALIZED_DISPATCH(transformReset());
+      }
+
+      case SerializedOp::kClipRect: {
+        auto rect = reader.Read<SkRect>();
+        auto clip_op = reader.ReadEnum(ClipOp::kIntersect);
+        bool is_aa = reader.ReadBool();
+        DL_SERIALIZED_DISPATCH(clipRect(rect, clip_op, is_aa));
+      }
+      case SerializedOp::kClipRRect: {
+        SkRRect rrect = reader.ReadRRect();
+        auto clip_op = reader.ReadEnum(ClipOp::kIntersect);
+        bool is_aa = reader.ReadBool();
+        DL_SERIALIZED_DISPATCH(clipRRect(rrect, clip_op, is_aa));
+      }
+      case SerializedOp::kClipPath: {
+        const SkPath* path = read_path(reader);
+        auto clip_op = reader.ReadEnum(ClipOp::kIntersect);
+        bool is_aa = reader.ReadBool();
+        DL_SERIALIZED_DISPATCH(clipPath(*path, clip_op, is_aa));
+      }
+
+      case SerializedOp::kDrawColor: {
+        DlColor color = reader.ReadColor();
+        auto mode = reader.ReadEnum(DlBlendMode::kLastMode);
+        DL_SERIALIZED_DISPATCH(drawColor(color, mode));
+      }
+      case SerializedOp::kDrawPaint: {
+        DL_SERIALIZED_DISPATCH(drawPaint());
+      }
+      case SerializedOp::kDrawLine: {
+        auto p0 = reader.Read<SkPoint>();
+        auto p1 = reader.Read<SkPoint>();
+        DL_SERIALIZED_DISPATCH(drawLine(p0, p1));
+      }
+      case SerializedOp::kDrawRect: {
+        auto rect = reader.Read<SkRect>();
+        DL_SERIALIZED_DISPATCH(drawRect(rect));
+      }
+      case SerializedOp::kDrawOval: {
+        auto bounds = reader.Read<SkRect>();
+        DL_SERIALIZED_DISPATCH(drawOval(bounds));
+      }
+      case SerializedOp::kDrawCircle: {
+        auto center = reader.Read<SkPoint>();
+        auto radius = reader.Read<SkScalar>();
+        DL_SERIALIZED_DISPATCH(drawCircle(center, radius));
+      }
+      case SerializedOp::kDrawRRect: {
+        SkRRect rrect = reader.ReadRRect();
+        DL_SERIALIZED_DISPATCH(drawRRect(rrect));
+      }
+      case SerializedOp::kDrawDRRect: {
+        SkRRect outer = reader.ReadRRect();
+        SkRRect inner = reader.ReadRRect();
+        DL_SERIALIZED_DISPATCH(drawDRRect(outer, inner));
+      }
+      case SerializedOp::kDrawPath: {
+        const SkPath* path = read_path(reader);
+        DL_SERIALIZED_DISPATCH(drawPath(*path));
+      }
+      case SerializedOp::kDrawArc: {
+        auto bounds = reader.Read<SkRect>();
+        auto start = reader.Read<SkScalar>();
+        auto sweep = reader.Read<SkScalar>();
+        bool use_center = reader.ReadBool();
+        DL_SERIALIZED_DISPATCH(drawArc(bounds, start, sweep, use_center));
+      }
+      case SerializedOp::kDrawPoints: {
+        auto mode = reader.ReadEnum(PointMode::kPolygon);
+        auto count = reader.Read<uint32_t>();
+        if (count >
+            static_cast<uint32_t>(DlOpReceiver::kMaxDrawPointsCount)) {
+          return false;
+        }
+        const SkPoint* points = reader.ReadArray<SkPoint>(count);
+        DL_SERIALIZED_DISPATCH(drawPoints(mode, count, points));
+      }
+      case SerializedOp::kDrawVertices: {
+        auto mode = reader.ReadEnum(DlBlendMode::kLastMode);
+        auto vertex_mode = reader.ReadEnum(DlVertexMode::kTriangleFan);
+        auto vertex_count = reader.Read<uint32_t>();
+        auto index_count = reader.Read<uint32_t>();
+        bool has_texture_coordinates = reader.ReadBool();
+        bool has_colors = reader.ReadBool();
+        if (vertex_count > std::numeric_limits<int>::max() ||
+            index_count > std::numeric_limits<int>::max()) {
+          return false;
+        }
+        const SkPoint* points = reader.ReadArray<SkPoint>(vertex_count);
+        const SkPoint* texture_coordinates =
+            has_texture_coordinates ? reader.ReadArray<SkPoint>(vertex_count)
+                                    : nullptr;
+        const DlColor* colors =
+            has_colors ? reader.ReadArray<DlColor>(vertex_count) : nullptr;
+        const uint16_t* indices = reader.ReadArray<uint16_t>(index_count);
+        if (!reader.ok() || !reader.at_end()) {
+          return false;
+        }
+        auto vertices = DlVertices::Make(
+            vertex_mode, vertex_count, points, texture_coordinates, colors,
+            index_count, index_count > 0u ? indices : nullptr);
+        DL_SERIALIZED_DISPATCH(drawVertices(vertices.get(), mode));
+      }
+      case SerializedOp::kDrawImage: {
+        auto image = read_image(reader);
+        auto point = reader.Read<SkPoint>();
+        auto sampling = reader.ReadEnum(DlImageSampling::kCubic);
+        bool with_attributes = reader.ReadBool();
+        DL_SERIALIZED_DISPATCH(
+            drawImage(image, point, sampling, with_attributes));
+      }
+      case SerializedOp::kDrawImageRect: {
+        auto image = read_image(reader);
+        auto src = reader.Read<SkRect>();
+        auto dst = reader.Read<SkRect>();
+        auto sampling = reader.ReadEnum(DlImageSampling::kCubic);
+        bool with_attributes = reader.ReadBool();
+        auto constraint = reader.ReadEnum(SrcRectConstraint::kFast);
+        DL_SERIALIZED_DISPATCH(drawImageRect(image, src, dst, sampling,
+                                             with_attributes, constraint));
+      }
+      case SerializedOp::kDrawImageNine: {
+        auto image = read_image(reader);
+        auto center = reader.Read<SkIRect>();
+        auto dst = reader.Read<SkRect>();
+        auto filter = reader.ReadEnum(DlFilterMode::kLast);
+        bool with_attributes = reader.ReadBool();
+        DL_SERIALIZED_DISPATCH(
+            drawImageNine(image, center, dst, filter, with_attributes));
+      }
+      case SerializedOp::kDrawAtlas: {
+        auto atlas = read_image(reader);
+        auto count = reader.Read<uint32_t>();
+        auto mode = reader.ReadEnum(DlBlendMode::kLastMode);
+        auto sampling = reader.ReadEnum(DlImageSampling::kCubic);
+        bool with_attributes = reader.ReadBool();
+        bool has_colors = reader.ReadBool();
+        bool has_cull_rect = reader.ReadBool();
+        auto cull_rect = reader.Read<SkRect>();
+        if (count > std::numeric_limits<int>::max()) {
+          return false;
+        }
+        const SkRSXform* xform = reader.ReadArray<SkRSXform>(count);
+        const SkRect* tex = reader.ReadArray<SkRect>(count);
+        const DlColor* colors =
+            has_colors ? reader.ReadArray<DlColor>(count) : nullptr;
+        DL_SERIALIZED_DISPATCH(drawAtlas(atlas, xform, tex, colors, count,
+                                         mode, sampling,
+                                         has_cull_rect ? &cull_rect : nullptr,
+                                         with_attributes));
+      }
+      case SerializedOp::kDrawShadow: {
+        const SkPath* path = read_path(reader);
+        DlColor color = reader.ReadColor();
+        auto elevation = reader.Read<SkScalar>();
+        bool transparent_occluder = reader.ReadBool();
+        auto dpr = reader.Read<SkScalar>();
+        DL_SERIALIZED_DISPATCH(drawShadow(*path, color, elevation,
+                                          transparent_occluder, dpr));
+      }
+      default:
+        return false;
+    }
+
+#undef DL_SERIALIZED_DISPATCH
+
+    op_count++;
+  }
+  return op_count == op_count_;
+}
+
+}  // namespace flutter
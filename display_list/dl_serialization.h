@@ -0,0 +1,151 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_SERIALIZATION_H_
+#define FLUTTER_DISPLAY_LIST_DL_SERIALIZATION_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/dl_op_receiver.h"
+#include "flutter/display_list/image/dl_image.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/skia/include/core/SkPath.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A DisplayList stored in a versioned, relocatable byte format
+///             that can be written to disk or shared with another process and
+///             dispatched straight from its memory mapping.
+///
+/// Unlike the op buffer of a |DisplayList|, the serialized form contains no
+/// pointers. Ops refer to large or shared objects by index into side tables:
+///
+///   - Paths are serialized into a path table that is decoded once when the
+///     mapping is loaded.
+///   - Images live on the GPU or in the image decoder and are never
+///     serialized. Each image is assigned an index into an image table that
+///     is returned by |Serialize| and must be supplied again to |Make| (for
+///     example, by a cache that keeps the images alive alongside the file).
+///   - Color sources, color filters, image filters, mask filters and path
+///     effects are encoded inline with the attribute ops that set them.
+///
+/// All other op arguments are read in place from the mapping, so dispatching
+/// a serialized list doesn't copy its op stream.
+///
+/// Nested display lists are inlined, so a flattened layer tree can be
+/// serialized as a whole.
+///
+/// Serialization fails for display lists containing ops that can't be
+/// represented without live objects: text, runtime effects, image color
+/// sources and 3D scenes.
+///
+/// The format uses the byte order of the host that wrote it. A mapping with
+/// a different byte order, a different version, or any out of range value is
+/// rejected by |Make|.
+///
+class DlSerializedDisplayList {
+ public:
+  static constexpr uint32_t kMagic = 0x5a534c44;  // "DLSZ"
+  static constexpr uint32_t kVersion = 1u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Serializes the ops of a display list.
+  ///
+  /// @return     The serialized display list or `nullptr` if the display list
+  ///             contains ops that can't be serialized.
+  ///
+  static std::unique_ptr<DlSerializedDisplayList> Serialize(
+      const DisplayList& display_list);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Wraps a serialized display list, such as a file mapped with
+  ///             |fml::FileMapping|. The whole op stream is validated here so
+  ///             that dispatching the result never encounters malformed data.
+  ///
+  /// @param[in]  mapping  The serialized bytes. Must be 4 byte aligned.
+  /// @param[in]  images   The image table produced along with the bytes.
+  ///
+  /// @return     The serialized display list or `nullptr` if the mapping is
+  ///             not a valid serialized display list for this host.
+  ///
+  static std::unique_ptr<DlSerializedDisplayList> Make(
+      std::shared_ptr<const fml::Mapping> mapping,
+      std::vector<sk_sp<DlImage>> images);
+
+  /// Creates a stand-in for an image of the image table when reading a
+  /// serialized display list back from disk.
+  using ImageFactory = std::function<sk_sp<DlImage>(const SkISize& size)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reads a serialized display list written by |WriteToDirectory|
+  ///             in another process, such as a benchmark replaying captured
+  ///             frames. As images aren't serialized, the image table is
+  ///             filled with images of the recorded sizes created by
+  ///             `image_factory`.
+  ///
+  /// @return     The serialized display list or `nullptr` if the files are
+  ///             missing or invalid.
+  ///
+  static std::unique_ptr<DlSerializedDisplayList> ReadFromDirectory(
+      const fml::UniqueFD& directory,
+      const std::string& name,
+      const ImageFactory& image_factory);
+
+  ~DlSerializedDisplayList();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the serialized bytes to `<name>.dlsz` and the size of
+  ///             each image of the image table, one "width height" pair per
+  ///             line, to `<name>.images`.
+  ///
+  bool WriteToDirectory(const fml::UniqueFD& directory,
+                        const std::string& name) const;
+
+  const std::shared_ptr<const fml::Mapping>& mapping() const {
+    return mapping_;
+  }
+
+  const std::vector<sk_sp<DlImage>>& images() const { return images_; }
+
+  const SkRect& bounds() const { return bounds_; }
+
+  unsigned int op_count() const { return op_count_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Plays the ops back to a receiver in the order they were
+  ///             recorded, as |DisplayList::Dispatch| would.
+  ///
+  void Dispatch(DlOpReceiver& receiver) const;
+
+ private:
+  DlSerializedDisplayList(std::shared_ptr<const fml::Mapping> mapping,
+                          std::vector<sk_sp<DlImage>> images);
+
+  // Decodes the header and path table.
+  bool Load();
+
+  // Returns false, without calling the receiver for the failed op, if any op
+  // is malformed.
+  bool DispatchOps(DlOpReceiver& receiver) const;
+
+  const std::shared_ptr<const fml::Mapping> mapping_;
+  const std::vector<sk_sp<DlImage>> images_;
+  std::vector<SkPath> paths_;
+  SkRect bounds_;
+  unsigned int op_count_ = 0u;
+  const uint8_t* ops_ = nullptr;
+  size_t ops_size_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlSerializedDisplayList);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_SERIALIZATION_H_
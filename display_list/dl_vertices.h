@@ -228,6 +228,12 @@ class DlVertices {
     return static_cast<const uint16_t*>(pod(indices_offset_));
   }
 
+  /// Returns an ID that identifies the contents of these vertices. The
+  /// copies made by a DisplayListBuilder keep the ID of the vertices they
+  /// copy, so the ID is shared by the same vertices in different display
+  /// lists.
+  uint64_t unique_id() const { return unique_id_; }
+
   bool operator==(DlVertices const& other) const;
 
   bool operator!=(DlVertices const& other) const { return !(*this == other); }
@@ -271,6 +277,8 @@ class DlVertices {
 
   SkRect bounds_;
 
+  uint64_t unique_id_;
+
   const void* pod(int offset) const {
     if (offset <= 0) {
       return nullptr;
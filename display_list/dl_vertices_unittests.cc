@@ -5,6 +5,7 @@
 #include "flutter/display_list/dl_builder.h"
 #include "flutter/display_list/dl_vertices.h"
 #include "flutter/display_list/testing/dl_test_equality.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
 #include "flutter/display_list/utils/dl_comparable.h"
 #include "gtest/gtest.h"
 
@@ -977,5 +978,41 @@ TEST(DisplayListVertices, TestNotEquals) {
   }
 }
 
+class VerticesIdRecorder : public virtual DlOpReceiver,
+                           public IgnoreAttributeDispatchHelper,
+                           public IgnoreClipDispatchHelper,
+                           public IgnoreTransformDispatchHelper,
+                           public IgnoreDrawDispatchHelper {
+ public:
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+    ids.push_back(vertices->unique_id());
+  }
+
+  std::vector<uint64_t> ids;
+};
+
+TEST(DisplayListVertices, CopiesKeepTheUniqueId) {
+  SkPoint coords[3] = {
+      SkPoint::Make(2, 3),
+      SkPoint::Make(5, 6),
+      SkPoint::Make(15, 20),
+  };
+  auto vertices1 = DlVertices::Make(DlVertexMode::kTriangles, 3, coords,
+                                    nullptr, nullptr);
+  auto vertices2 = DlVertices::Make(DlVertexMode::kTriangles, 3, coords,
+                                    nullptr, nullptr);
+  EXPECT_NE(vertices1->unique_id(), vertices2->unique_id());
+
+  DisplayListBuilder builder;
+  builder.DrawVertices(vertices1.get(), DlBlendMode::kSrcOver, DlPaint());
+  builder.DrawVertices(vertices2.get(), DlBlendMode::kSrcOver, DlPaint());
+  VerticesIdRecorder recorder;
+  builder.Build()->Dispatch(recorder);
+
+  std::vector<uint64_t> expected = {vertices1->unique_id(),
+                                    vertices2->unique_id()};
+  EXPECT_EQ(recorder.ids, expected);
+}
+
 }  // namespace testing
 }  // namespace flutter
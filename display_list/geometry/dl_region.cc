@@ -6,6 +6,14 @@
 
 #include "flutter/fml/logging.h"
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DL_REGION_USE_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define DL_REGION_USE_NEON 1
+#endif
+
 namespace flutter {
 
 // Threshold for switching from linear search through span lines to binary
@@ -153,6 +161,20 @@ size_t DlRegion::unionLineSpans(std::vector<Span>& res,
       }
     }
 
+    // Accumulates the remaining spans of a single line. Once a span starts
+    // past everything accumulated so far, the rest of the line is already
+    // sorted and disjoint and can be copied in bulk.
+    void accumulateRemaining(const Span* begin, const Span* end) {
+      while (begin < end && len > 0 && begin->left <= last_) {
+        accumulate(*begin++);
+      }
+      if (begin < end) {
+        memcpy(res.data() + len, begin, (end - begin) * sizeof(Span));
+        len += end - begin;
+        last_ = (end - 1)->right;
+      }
+    }
+
     size_t len = 0;
     std::vector<Span>& res;
 
@@ -191,12 +213,8 @@ size_t DlRegion::unionLineSpans(std::vector<Span>& res,
 
   FML_DCHECK(begin1 == end1 || begin2 == end2);
 
-  while (begin1 < end1) {
-    accumulator.accumulate(*begin1++);
-  }
-  while (begin2 < end2) {
-    accumulator.accumulate(*begin2++);
-  }
+  accumulator.accumulateRemaining(begin1, end1);
+  accumulator.accumulateRemaining(begin2, end2);
 
   FML_DCHECK(begin1 == end1 && begin2 == end2);
 
@@ -227,9 +245,9 @@ size_t DlRegion::intersectLineSpans(std::vector<Span>& res,
 
   while (begin1 != end1 && begin2 != end2) {
     if (begin1->right <= begin2->left) {
-      ++begin1;
+      begin1 = skipSpansEndingBefore(begin1 + 1, end1, begin2->left);
     } else if (begin2->right <= begin1->left) {
-      ++begin2;
+      begin2 = skipSpansEndingBefore(begin2 + 1, end2, begin1->left);
     } else {
       int32_t left = std::max(begin1->left, begin2->left);
       int32_t right = std::min(begin1->right, begin2->right);
@@ -646,6 +664,7 @@ bool DlRegion::intersects(const SkIRect& rect) const {
     FML_DCHECK(rect.fTop < it->bottom && it->top < rect.fBottom);
     const Span *begin, *end;
     span_buffer_.getSpans(it->chunk_handle, begin, end);
+    begin = skipSpansEndingBefore(begin, end, rect.fLeft);
     while (begin != end && begin->left < rect.fRight) {
       if (begin->right > rect.fLeft) {
         return true;
@@ -658,15 +677,61 @@ bool DlRegion::intersects(const SkIRect& rect) const {
   return false;
 }
 
+// Returns the first span in [begin, end) whose right edge is past x. Spans are
+// sorted and disjoint, so their right edges are strictly increasing and the
+// search can test several spans at once.
+//
+// SSE2 and NEON (on arm64) are part of the baseline instruction set of their
+// architectures, so they are selected at compile time. Regions rarely have
+// enough spans per line for wider vectors to pay off over their setup cost.
+const DlRegion::Span* DlRegion::skipSpansEndingBefore(const Span* begin,
+                                                      const Span* end,
+                                                      int32_t x) {
+  static_assert(sizeof(Span) == 2 * sizeof(int32_t));
+#if defined(DL_REGION_USE_SSE2)
+  const __m128i threshold = _mm_set1_epi32(x);
+  while (end - begin >= 4) {
+    // Each vector holds two spans: {left0, right0, left1, right1}.
+    __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + 2));
+    __m128i past = _mm_or_si128(_mm_cmpgt_epi32(v0, threshold),
+                                _mm_cmpgt_epi32(v1, threshold));
+    // Only the right edges (odd lanes) matter.
+    if ((_mm_movemask_ps(_mm_castsi128_ps(past)) & 0xA) != 0) {
+      break;
+    }
+    begin += 4;
+  }
+#elif defined(DL_REGION_USE_NEON)
+  const int32x4_t threshold = vdupq_n_s32(x);
+  // Lanes holding the right edge of each span.
+  const uint32x4_t right_lanes = {0, ~0u, 0, ~0u};
+  while (end - begin >= 4) {
+    int32x4_t v0 = vld1q_s32(reinterpret_cast<const int32_t*>(begin));
+    int32x4_t v1 = vld1q_s32(reinterpret_cast<const int32_t*>(begin + 2));
+    uint32x4_t past = vorrq_u32(vcgtq_s32(v0, threshold),
+                                vcgtq_s32(v1, threshold));
+    if (vmaxvq_u32(vandq_u32(past, right_lanes)) != 0) {
+      break;
+    }
+    begin += 4;
+  }
+#endif
+  while (begin != end && begin->right <= x) {
+    ++begin;
+  }
+  return begin;
+}
+
 bool DlRegion::spansIntersect(const Span* begin1,
                               const Span* end1,
                               const Span* begin2,
                               const Span* end2) {
   while (begin1 != end1 && begin2 != end2) {
     if (begin1->right <= begin2->left) {
-      ++begin1;
+      begin1 = skipSpansEndingBefore(begin1 + 1, end1, begin2->left);
     } else if (begin2->right <= begin1->left) {
-      ++begin2;
+      begin2 = skipSpansEndingBefore(begin2 + 1, end2, begin1->left);
     } else {
       return true;
     }
@@ -152,6 +152,11 @@ class DlRegion {
 
   bool spansEqual(SpanLine& line, const Span* begin, const Span* end) const;
 
+  /// Returns the first span in [begin, end) whose right edge is past x.
+  static const Span* skipSpansEndingBefore(const Span* begin,
+                                           const Span* end,
+                                           int32_t x);
+
   static bool spansIntersect(const Span* begin1,
                              const Span* end1,
                              const Span* begin2,
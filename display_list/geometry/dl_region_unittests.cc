@@ -429,5 +429,50 @@ TEST(DisplayListRegion, TestAgainstSkRegion) {
   }
 }
 
+TEST(DisplayListRegion, TestManySpansPerLineAgainstSkRegion) {
+  // Vertical stripes produce long span lines, which exercise the vectorized
+  // span skipping paths.
+  auto make_stripes = [](int32_t left, int32_t right, int32_t width,
+                         int32_t gap, int32_t top, int32_t bottom) {
+    std::vector<SkIRect> rects;
+    for (int32_t x = left; x + width <= right; x += width + gap) {
+      rects.push_back(SkIRect::MakeLTRB(x, top, x + width, bottom));
+    }
+    return rects;
+  };
+
+  for (int32_t offset : {0, 1, 3, 7, 501, 1999}) {
+    auto rects_in1 = make_stripes(0, 2000, 2, 2, 0, 100);
+    auto rects_in2 = make_stripes(offset, 2000, 3, 5, 50, 150);
+
+    DlRegion region1(rects_in1);
+    SkRegion sk_region1;
+    sk_region1.setRects(rects_in1.data(), rects_in1.size());
+    CheckEquality(region1, sk_region1);
+
+    DlRegion region2(rects_in2);
+    SkRegion sk_region2;
+    sk_region2.setRects(rects_in2.data(), rects_in2.size());
+    CheckEquality(region2, sk_region2);
+
+    EXPECT_EQ(region1.intersects(region2),
+              sk_region1.intersects(sk_region2));
+    for (int32_t x = 0; x < 2000; x += 13) {
+      auto rect = SkIRect::MakeXYWH(x, 60, 1, 1);
+      EXPECT_EQ(region1.intersects(rect), sk_region1.intersects(rect));
+    }
+
+    DlRegion dl_union = DlRegion::MakeUnion(region1, region2);
+    SkRegion sk_union(sk_region1);
+    sk_union.op(sk_region2, SkRegion::kUnion_Op);
+    CheckEquality(dl_union, sk_union);
+
+    DlRegion dl_intersection = DlRegion::MakeIntersection(region1, region2);
+    SkRegion sk_intersection(sk_region1);
+    sk_intersection.op(sk_region2, SkRegion::kIntersect_Op);
+    CheckEquality(dl_intersection, sk_intersection);
+  }
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -5,6 +5,9 @@
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "flutter/display_list/geometry/dl_region.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "flutter/fml/logging.h"
 
 namespace flutter {
@@ -201,6 +204,122 @@ void DlRTree::search(const Node& parent,
   }
 }
 
+std::vector<std::vector<int>> DlRTree::searchAndPartition(
+    const SkRect& query,
+    int max_groups) const {
+  std::vector<int> indices;
+  search(query, &indices);
+  std::sort(indices.begin(), indices.end());
+  std::vector<std::vector<int>> groups;
+  if (indices.empty()) {
+    return groups;
+  }
+  if (max_groups <= 1) {
+    groups.push_back(std::move(indices));
+    return groups;
+  }
+
+  // The rects of the region are sorted by spanline and then from left to
+  // right, and a rect only touches rects of the spanlines directly above and
+  // below it. Join the rects of adjacent spanlines whose spans overlap to
+  // find the connected areas of the region.
+  std::vector<SkIRect> rects = region().getRects(/*deband=*/false);
+  std::vector<size_t> line_starts;
+  for (size_t i = 0; i < rects.size(); i++) {
+    if (i == 0 || rects[i].fTop != rects[i - 1].fTop) {
+      line_starts.push_back(i);
+    }
+  }
+  line_starts.push_back(rects.size());
+
+  std::vector<size_t> parents(rects.size());
+  std::iota(parents.begin(), parents.end(), 0u);
+  auto find = [&parents](size_t i) {
+    while (parents[i] != i) {
+      i = parents[i] = parents[parents[i]];
+    }
+    return i;
+  };
+  for (size_t line = 1; line + 1 < line_starts.size(); line++) {
+    size_t above = line_starts[line - 1];
+    size_t above_end = line_starts[line];
+    size_t below = line_starts[line];
+    size_t below_end = line_starts[line + 1];
+    if (rects[above].fBottom != rects[below].fTop) {
+      continue;
+    }
+    while (above < above_end && below < below_end) {
+      if (rects[above].fRight > rects[below].fLeft &&
+          rects[below].fRight > rects[above].fLeft) {
+        parents[find(above)] = find(below);
+      }
+      if (rects[above].fRight < rects[below].fRight) {
+        above++;
+      } else {
+        below++;
+      }
+    }
+  }
+
+  // Every rect of the tree lies in exactly one connected area, which is
+  // found from the region rect containing its top left corner.
+  auto area_of = [&rects, &line_starts, &find](const SkIRect& bounds) {
+    auto line = std::upper_bound(line_starts.begin(), line_starts.end() - 1,
+                                 bounds.fTop, [&rects](int32_t y, size_t i) {
+                                   return y < rects[i].fTop;
+                                 });
+    FML_DCHECK(line != line_starts.begin());
+    auto begin = rects.begin() + *(line - 1);
+    auto end = rects.begin() + *line;
+    auto rect = std::upper_bound(begin, end, bounds.fLeft,
+                                 [](int32_t x, const SkIRect& rect) {
+                                   return x < rect.fLeft;
+                                 });
+    FML_DCHECK(rect != begin);
+    return find((rect - 1) - rects.begin());
+  };
+  std::vector<size_t> areas(indices.size());
+  std::vector<size_t> area_counts(rects.size(), 0u);
+  for (size_t i = 0; i < indices.size(); i++) {
+    SkIRect bounds;
+    nodes_[indices[i]].bounds.roundOut(&bounds);
+    areas[i] = area_of(bounds);
+    area_counts[areas[i]]++;
+  }
+
+  // Hand out the areas from the largest to the smallest, each to the group
+  // that has the fewest rects so far.
+  std::vector<size_t> sorted_areas;
+  for (size_t area = 0; area < area_counts.size(); area++) {
+    if (area_counts[area] > 0) {
+      sorted_areas.push_back(area);
+    }
+  }
+  if (sorted_areas.size() == 1) {
+    groups.push_back(std::move(indices));
+    return groups;
+  }
+  std::stable_sort(sorted_areas.begin(), sorted_areas.end(),
+                   [&area_counts](size_t a, size_t b) {
+                     return area_counts[a] > area_counts[b];
+                   });
+  size_t group_count =
+      std::min(sorted_areas.size(), static_cast<size_t>(max_groups));
+  std::vector<size_t> group_counts(group_count, 0u);
+  std::vector<size_t> area_groups(rects.size());
+  for (size_t area : sorted_areas) {
+    size_t group = std::min_element(group_counts.begin(), group_counts.end()) -
+                   group_counts.begin();
+    area_groups[area] = group;
+    group_counts[group] += area_counts[area];
+  }
+  groups.resize(group_count);
+  for (size_t i = 0; i < indices.size(); i++) {
+    groups[area_groups[areas[i]]].push_back(indices[i]);
+  }
+  return groups;
+}
+
 const DlRegion& DlRTree::region() const {
   if (!region_) {
     std::vector<SkIRect> rects;
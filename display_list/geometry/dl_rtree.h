@@ -126,6 +126,17 @@ class DlRTree : public SkRefCnt {
   std::list<SkRect> searchAndConsolidateRects(const SkRect& query,
                                               bool deband = true) const;
 
+  /// Finds the rects in the tree that intersect with the query rect and
+  /// splits their indices into at most |max_groups| groups such that no
+  /// rect in one group overlaps a rect in another group.
+  ///
+  /// Rects are grouped by the connected areas of the |region| of the tree,
+  /// and those areas are distributed so that the groups receive a similar
+  /// number of rects. A single group is returned if all of the rects are
+  /// connected. Within each group the indices are in numerical order.
+  std::vector<std::vector<int>> searchAndPartition(const SkRect& query,
+                                                   int max_groups) const;
+
   /// Returns DlRegion that represents the union of all rectangles in the
   /// R-Tree.
   const DlRegion& region() const;
@@ -319,5 +319,45 @@ TEST(DisplayListRTree, Region) {
   EXPECT_EQ(rects.size(), expected_rects.size());
 }
 
+TEST(DisplayListRTree, Partition) {
+  // Two diagonal chains of overlapping rects, one L shaped pair around
+  // them and a lone rect.
+  SkRect rects[] = {
+      SkRect::MakeXYWH(0, 0, 20, 20),      //
+      SkRect::MakeXYWH(200, 0, 20, 20),    //
+      SkRect::MakeXYWH(10, 10, 20, 20),    //
+      SkRect::MakeXYWH(190, 10, 20, 20),   //
+      SkRect::MakeXYWH(20, 20, 20, 20),    //
+      SkRect::MakeXYWH(0, 100, 100, 10),   //
+      SkRect::MakeXYWH(90, 100, 10, 100),  //
+      SkRect::MakeXYWH(300, 300, 10, 10),  //
+  };
+  DlRTree rtree(rects, 8);
+  auto query = SkRect::MakeLTRB(0, 0, 400, 400);
+
+  auto single = rtree.searchAndPartition(query, 1);
+  ASSERT_EQ(single.size(), 1u);
+  EXPECT_EQ(single[0], std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7}));
+
+  auto groups = rtree.searchAndPartition(query, 4);
+  ASSERT_EQ(groups.size(), 4u);
+  EXPECT_EQ(groups[0], std::vector<int>({0, 2, 4}));
+  EXPECT_EQ(groups[1], std::vector<int>({1, 3}));
+  EXPECT_EQ(groups[2], std::vector<int>({5, 6}));
+  EXPECT_EQ(groups[3], std::vector<int>({7}));
+
+  // With fewer groups than areas, the smaller areas are combined.
+  auto pairs = rtree.searchAndPartition(query, 2);
+  ASSERT_EQ(pairs.size(), 2u);
+  EXPECT_EQ(pairs[0].size() + pairs[1].size(), 8u);
+  EXPECT_EQ(pairs[0], std::vector<int>({0, 2, 4, 7}));
+  EXPECT_EQ(pairs[1], std::vector<int>({1, 3, 5, 6}));
+
+  // Only rects intersecting the query are returned.
+  auto corner = rtree.searchAndPartition(SkRect::MakeLTRB(0, 0, 15, 15), 4);
+  ASSERT_EQ(corner.size(), 1u);
+  EXPECT_EQ(corner[0], std::vector<int>({0, 2}));
+}
+
 }  // namespace testing
 }  // namespace flutter
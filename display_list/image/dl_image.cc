@@ -32,6 +32,11 @@ SkIRect DlImage::bounds() const {
   return SkIRect::MakeSize(dimensions());
 }
 
+std::shared_ptr<impeller::Texture> DlImage::impeller_mipmapped_texture()
+    const {
+  return impeller_texture();
+}
+
 std::optional<std::string> DlImage::get_error() const {
   return std::nullopt;
 }
@@ -54,6 +54,17 @@ class DlImage : public SkRefCnt {
   ///
   virtual std::shared_ptr<impeller::Texture> impeller_texture() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The Impeller texture to sample when this image is drawn at a
+  ///             minifying scale with a mipmap filter. Images that generate
+  ///             their mip levels lazily do so the first time this is called.
+  ///
+  /// @return     An Impeller texture instance with all its mip levels, or
+  ///             null.
+  ///
+  virtual std::shared_ptr<impeller::Texture> impeller_mipmapped_texture()
+      const;
+
   //----------------------------------------------------------------------------
   /// @brief      If the pixel format of this image ignores alpha, this returns
   ///             true. This method might conservatively return false when it
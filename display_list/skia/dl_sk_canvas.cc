@@ -315,6 +315,7 @@ void DlSkCanvasAdapter::DrawDisplayList(const sk_sp<DisplayList> display_list,
   } else {
     display_list->Dispatch(dispatcher);
   }
+  dispatcher.FlushImageSet();
 
   delegate_->restoreToCount(restore_count);
 }
@@ -4,6 +4,9 @@
 
 #include "flutter/display_list/skia/dl_sk_dispatcher.h"
 
+#include <string>
+#include <utility>
+
 #include "flutter/display_list/dl_blend_mode.h"
 #include "flutter/display_list/skia/dl_sk_conversions.h"
 #include "flutter/display_list/skia/dl_sk_types.h"
@@ -30,6 +33,7 @@ const SkPaint* DlSkCanvasDispatcher::safe_paint(bool use_attributes) {
 }
 
 void DlSkCanvasDispatcher::save() {
+  FlushImageSet();
   canvas_->save();
   // save has no impact on attributes, but it needs to register a record
   // on the restore stack so that the eventual call to restore() will
@@ -40,12 +44,14 @@ void DlSkCanvasDispatcher::save() {
   save_opacity(opacity());
 }
 void DlSkCanvasDispatcher::restore() {
+  FlushImageSet();
   canvas_->restore();
   restore_opacity();
 }
 void DlSkCanvasDispatcher::saveLayer(const SkRect* bounds,
                                      const SaveLayerOptions options,
                                      const DlImageFilter* backdrop) {
+  FlushImageSet();
   if (bounds == nullptr && options.can_distribute_opacity() &&
       backdrop == nullptr) {
     // We know that:
@@ -76,15 +82,19 @@ void DlSkCanvasDispatcher::saveLayer(const SkRect* bounds,
 }
 
 void DlSkCanvasDispatcher::translate(SkScalar tx, SkScalar ty) {
+  FlushImageSet();
   canvas_->translate(tx, ty);
 }
 void DlSkCanvasDispatcher::scale(SkScalar sx, SkScalar sy) {
+  FlushImageSet();
   canvas_->scale(sx, sy);
 }
 void DlSkCanvasDispatcher::rotate(SkScalar degrees) {
+  FlushImageSet();
   canvas_->rotate(degrees);
 }
 void DlSkCanvasDispatcher::skew(SkScalar sx, SkScalar sy) {
+  FlushImageSet();
   canvas_->skew(sx, sy);
 }
 // clang-format off
@@ -92,6 +102,7 @@ void DlSkCanvasDispatcher::skew(SkScalar sx, SkScalar sy) {
 void DlSkCanvasDispatcher::transform2DAffine(
     SkScalar mxx, SkScalar mxy, SkScalar mxt,
     SkScalar myx, SkScalar myy, SkScalar myt) {
+  FlushImageSet();
   // Internally concat(SkMatrix) gets redirected to concat(SkM44)
   // so we just jump directly to the SkM44 version
   canvas_->concat(SkM44(mxx, mxy, 0, mxt,
@@ -105,6 +116,7 @@ void DlSkCanvasDispatcher::transformFullPerspective(
     SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
     SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
     SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) {
+  FlushImageSet();
   canvas_->concat(SkM44(mxx, mxy, mxz, mxt,
                         myx, myy, myz, myt,
                         mzx, mzy, mzz, mzt,
@@ -112,26 +124,31 @@ void DlSkCanvasDispatcher::transformFullPerspective(
 }
 // clang-format on
 void DlSkCanvasDispatcher::transformReset() {
+  FlushImageSet();
   canvas_->setMatrix(original_transform_);
 }
 
 void DlSkCanvasDispatcher::clipRect(const SkRect& rect,
                                     ClipOp clip_op,
                                     bool is_aa) {
+  FlushImageSet();
   canvas_->clipRect(rect, ToSk(clip_op), is_aa);
 }
 void DlSkCanvasDispatcher::clipRRect(const SkRRect& rrect,
                                      ClipOp clip_op,
                                      bool is_aa) {
+  FlushImageSet();
   canvas_->clipRRect(rrect, ToSk(clip_op), is_aa);
 }
 void DlSkCanvasDispatcher::clipPath(const SkPath& path,
                                     ClipOp clip_op,
                                     bool is_aa) {
+  FlushImageSet();
   canvas_->clipPath(path, ToSk(clip_op), is_aa);
 }
 
 void DlSkCanvasDispatcher::drawPaint() {
+  FlushImageSet();
   const SkPaint& sk_paint = paint();
   SkImageFilter* filter = sk_paint.getImageFilter();
   if (filter && !filter->asColorFilter(nullptr)) {
@@ -142,6 +159,7 @@ void DlSkCanvasDispatcher::drawPaint() {
   canvas_->drawPaint(sk_paint);
 }
 void DlSkCanvasDispatcher::drawColor(DlColor color, DlBlendMode mode) {
+  FlushImageSet();
   // SkCanvas::drawColor(SkColor) does the following conversion anyway
   // We do it here manually to increase precision on applying opacity
   SkColor4f color4f = SkColor4f::FromColor(ToSk(color));
@@ -149,46 +167,67 @@ void DlSkCanvasDispatcher::drawColor(DlColor color, DlBlendMode mode) {
   canvas_->drawColor(color4f, ToSk(mode));
 }
 void DlSkCanvasDispatcher::drawLine(const SkPoint& p0, const SkPoint& p1) {
+  FlushImageSet();
   canvas_->drawLine(p0, p1, paint());
 }
 void DlSkCanvasDispatcher::drawRect(const SkRect& rect) {
+  FlushImageSet();
   canvas_->drawRect(rect, paint());
 }
 void DlSkCanvasDispatcher::drawOval(const SkRect& bounds) {
+  FlushImageSet();
   canvas_->drawOval(bounds, paint());
 }
 void DlSkCanvasDispatcher::drawCircle(const SkPoint& center, SkScalar radius) {
+  FlushImageSet();
   canvas_->drawCircle(center, radius, paint());
 }
 void DlSkCanvasDispatcher::drawRRect(const SkRRect& rrect) {
+  FlushImageSet();
   canvas_->drawRRect(rrect, paint());
 }
 void DlSkCanvasDispatcher::drawDRRect(const SkRRect& outer,
                                       const SkRRect& inner) {
+  FlushImageSet();
   canvas_->drawDRRect(outer, inner, paint());
 }
 void DlSkCanvasDispatcher::drawPath(const SkPath& path) {
+  FlushImageSet();
   canvas_->drawPath(path, paint());
 }
 void DlSkCanvasDispatcher::drawArc(const SkRect& bounds,
                                    SkScalar start,
                                    SkScalar sweep,
                                    bool useCenter) {
+  FlushImageSet();
   canvas_->drawArc(bounds, start, sweep, useCenter, paint());
 }
 void DlSkCanvasDispatcher::drawPoints(PointMode mode,
                                       uint32_t count,
                                       const SkPoint pts[]) {
+  FlushImageSet();
   canvas_->drawPoints(ToSk(mode), count, pts, paint());
 }
 void DlSkCanvasDispatcher::drawVertices(const DlVertices* vertices,
                                         DlBlendMode mode) {
+  FlushImageSet();
   canvas_->drawVertices(ToSk(vertices), ToSk(mode), paint());
 }
 void DlSkCanvasDispatcher::drawImage(const sk_sp<DlImage> image,
                                      const SkPoint point,
                                      DlImageSampling sampling,
                                      bool render_with_attributes) {
+  if (batch_image_draws_ && image && image->skia_image()) {
+    auto skia_image = image->skia_image();
+    const SkRect src = SkRect::Make(skia_image->bounds());
+    const SkRect dst = src.makeOffset(point.fX, point.fY);
+    if (BatchImageRect(std::move(skia_image), src, dst, sampling,
+                       render_with_attributes,
+                       SkCanvas::kFast_SrcRectConstraint)) {
+      return;
+    }
+  }
+  FlushImageSet();
   canvas_->drawImage(image ? image->skia_image() : nullptr, point.fX, point.fY,
                      ToSk(sampling), safe_paint(render_with_attributes));
 }
@@ -198,6 +237,12 @@ void DlSkCanvasDispatcher::drawImageRect(const sk_sp<DlImage> image,
                                          DlImageSampling sampling,
                                          bool render_with_attributes,
                                          SrcRectConstraint constraint) {
+  if (batch_image_draws_ && image &&
+      BatchImageRect(image->skia_image(), src, dst, sampling,
+                     render_with_attributes, ToSk(constraint))) {
+    return;
+  }
+  FlushImageSet();
   canvas_->drawImageRect(image ? image->skia_image() : nullptr, src, dst,
                          ToSk(sampling), safe_paint(render_with_attributes),
                          ToSk(constraint));
@@ -207,6 +252,7 @@ void DlSkCanvasDispatcher::drawImageNine(const sk_sp<DlImage> image,
                                          const SkRect& dst,
                                          DlFilterMode filter,
                                          bool render_with_attributes) {
+  FlushImageSet();
   if (!image) {
     return;
   }
@@ -226,6 +272,7 @@ void DlSkCanvasDispatcher::drawAtlas(const sk_sp<DlImage> atlas,
                                      DlImageSampling sampling,
                                      const SkRect* cullRect,
                                      bool render_with_attributes) {
+  FlushImageSet();
   if (!atlas) {
     return;
   }
@@ -241,6 +288,7 @@ void DlSkCanvasDispatcher::drawAtlas(const sk_sp<DlImage> atlas,
 void DlSkCanvasDispatcher::drawDisplayList(
     const sk_sp<DisplayList> display_list,
     SkScalar opacity) {
+  FlushImageSet();
   const int restore_count = canvas_->getSaveCount();
 
   // Compute combined opacity and figure out whether we can apply it
@@ -263,6 +311,7 @@ void DlSkCanvasDispatcher::drawDisplayList(
   } else {
     display_list->Dispatch(dispatcher);
   }
+  dispatcher.FlushImageSet();
 
   // Restore canvas state to what it was before dispatching.
   canvas_->restoreToCount(restore_count);
@@ -270,6 +319,7 @@ void DlSkCanvasDispatcher::drawDisplayList(
 void DlSkCanvasDispatcher::drawTextBlob(const sk_sp<SkTextBlob> blob,
                                         SkScalar x,
                                         SkScalar y) {
+  FlushImageSet();
   canvas_->drawTextBlob(blob, x, y, paint());
 }
 
@@ -277,9 +327,76 @@ void DlSkCanvasDispatcher::drawTextFrame(
     const std::shared_ptr<impeller::TextFrame>& text_frame,
     SkScalar x,
     SkScalar y) {
+  FlushImageSet();
   FML_CHECK(false);
 }
 
+bool DlSkCanvasDispatcher::BatchImageRect(
+    sk_sp<SkImage> image,
+    const SkRect& src,
+    const SkRect& dst,
+    DlImageSampling sampling,
+    bool render_with_attributes,
+    SkCanvas::SrcRectConstraint constraint) {
+  if (!image) {
+    return false;
+  }
+  const SkPaint* paint = safe_paint(render_with_attributes);
+  // Filters and path effects apply to each draw on its own, which an image
+  // set can't express.
+  if (paint && (paint->getImageFilter() || paint->getMaskFilter() ||
+                paint->getPathEffect())) {
+    return false;
+  }
+  const SkSamplingOptions sk_sampling = ToSk(sampling);
+  if (!image_set_.empty() &&
+      (image_set_sampling_ != sk_sampling ||
+       image_set_constraint_ != constraint ||
+       image_set_has_paint_ != !!paint ||
+       (paint && image_set_paint_ != *paint))) {
+    FlushImageSet();
+  }
+  if (image_set_.empty()) {
+    image_set_sampling_ = sk_sampling;
+    image_set_constraint_ = constraint;
+    image_set_has_paint_ = !!paint;
+    if (paint) {
+      image_set_paint_ = *paint;
+    }
+  }
+  const unsigned aa_flags = paint && paint->isAntiAlias()
+                                ? SkCanvas::kAll_QuadAAFlags
+                                : SkCanvas::kNone_QuadAAFlags;
+  image_set_.emplace_back(std::move(image), src, dst, 1.0f, aa_flags);
+  return true;
+}
+
+void DlSkCanvasDispatcher::FlushImageSet() {
+  if (image_set_.empty()) {
+    return;
+  }
+  const SkPaint* paint = image_set_has_paint_ ? &image_set_paint_ : nullptr;
+  if (image_set_.size() == 1u) {
+    // A lone image is drawn exactly as it would have been without batching.
+    const SkCanvas::ImageSetEntry& entry = image_set_.front();
+    canvas_->drawImageRect(entry.fImage.get(), entry.fSrcRect, entry.fDstRect,
+                           image_set_sampling_, paint, image_set_constraint_);
+  } else {
+    TRACE_EVENT1("flutter", "DlSkCanvasDispatcher::FlushImageSet", "count",
+                 std::to_string(image_set_.size()).c_str());
+    canvas_->experimental_DrawEdgeAAImageSet(
+        image_set_.data(), static_cast<int>(image_set_.size()), nullptr,
+        nullptr, image_set_sampling_, paint, image_set_constraint_);
+  }
+  image_set_.clear();
+}
+
+std::atomic<bool> DlSkCanvasDispatcher::batch_image_draws_default_ = false;
+
+void DlSkCanvasDispatcher::SetBatchImageDraws(bool batch) {
+  batch_image_draws_default_ = batch;
+}
+
 void DlSkCanvasDispatcher::DrawShadow(SkCanvas* canvas,
                                       const SkPath& path,
                                       DlColor color,
@@ -311,6 +428,7 @@ void DlSkCanvasDispatcher::drawShadow(const SkPath& path,
                                       const SkScalar elevation,
                                       bool transparent_occluder,
                                       SkScalar dpr) {
+  FlushImageSet();
   DrawShadow(canvas_, path, color, elevation, transparent_occluder, dpr);
 }
 
@@ -5,6 +5,9 @@
 #ifndef FLUTTER_DISPLAY_LIST_SKIA_DL_SK_DISPATCHER_H_
 #define FLUTTER_DISPLAY_LIST_SKIA_DL_SK_DISPATCHER_H_
 
+#include <atomic>
+#include <vector>
+
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_op_receiver.h"
 #include "flutter/display_list/skia/dl_sk_paint_dispatcher.h"
@@ -16,6 +19,12 @@ namespace flutter {
 //------------------------------------------------------------------------------
 /// @brief      Backend implementation of |DlOpReceiver| for |SkCanvas|.
 ///
+///             When image draws are batched, consecutive image draws that
+///             share their sampling and attributes are held back and drawn
+///             with a single |SkCanvas::experimental_DrawEdgeAAImageSet|,
+///             which Ganesh turns into one texture op instead of one per
+///             image. Any other op draws the held images first.
+///
 /// @see       DlOpReceiver
 class DlSkCanvasDispatcher : public virtual DlOpReceiver,
                              public DlSkPaintDispatchHelper {
@@ -23,7 +32,23 @@ class DlSkCanvasDispatcher : public virtual DlOpReceiver,
   explicit DlSkCanvasDispatcher(SkCanvas* canvas, SkScalar opacity = SK_Scalar1)
       : DlSkPaintDispatchHelper(opacity),
         canvas_(canvas),
-        original_transform_(canvas->getLocalToDevice()) {}
+        original_transform_(canvas->getLocalToDevice()),
+        batch_image_draws_(batch_image_draws_default_) {}
+
+  ~DlSkCanvasDispatcher() { FlushImageSet(); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets whether the dispatchers created from now on batch
+  ///             consecutive image draws. Off by default.
+  ///
+  static void SetBatchImageDraws(bool batch);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Draws the images held back for batching, if any. Callers
+  ///             that change the state of the canvas after dispatching must
+  ///             call this first.
+  ///
+  void FlushImageSet();
 
   const SkPaint* safe_paint(bool use_attributes);
 
@@ -115,9 +140,29 @@ class DlSkCanvasDispatcher : public virtual DlOpReceiver,
                          SkScalar dpr);
 
  private:
+  static std::atomic<bool> batch_image_draws_default_;
+
   SkCanvas* canvas_;
   const SkM44 original_transform_;
   SkPaint temp_paint_;
+
+  const bool batch_image_draws_;
+  std::vector<SkCanvas::ImageSetEntry> image_set_;
+  SkSamplingOptions image_set_sampling_;
+  SkCanvas::SrcRectConstraint image_set_constraint_ =
+      SkCanvas::kFast_SrcRectConstraint;
+  bool image_set_has_paint_ = false;
+  SkPaint image_set_paint_;
+
+  // Adds the image draw to the batch, drawing the batch first if the draw
+  // can't join it. Returns false without adding the draw if it can't be
+  // batched at all.
+  bool BatchImageRect(sk_sp<SkImage> image,
+                      const SkRect& src,
+                      const SkRect& dst,
+                      DlImageSampling sampling,
+                      bool render_with_attributes,
+                      SkCanvas::SrcRectConstraint constraint);
 };
 
 }  // namespace flutter
@@ -0,0 +1,116 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/skia/dl_sk_dispatcher.h"
+
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/utils/SkNoDrawCanvas.h"
+
+namespace flutter {
+namespace testing {
+
+class ImageDrawCountingCanvas : public SkNoDrawCanvas {
+ public:
+  ImageDrawCountingCanvas() : SkNoDrawCanvas(100, 100) {}
+
+  int image_count = 0;
+  int image_rect_count = 0;
+  std::vector<int> image_set_counts;
+
+ protected:
+  void onDrawImage2(const SkImage* image,
+                    SkScalar x,
+                    SkScalar y,
+                    const SkSamplingOptions& sampling,
+                    const SkPaint* paint) override {
+    image_count++;
+  }
+
+  void onDrawImageRect2(const SkImage* image,
+                        const SkRect& src,
+                        const SkRect& dst,
+                        const SkSamplingOptions& sampling,
+                        const SkPaint* paint,
+                        SrcRectConstraint constraint) override {
+    image_rect_count++;
+  }
+
+  void onDrawEdgeAAImageSet2(const ImageSetEntry entries[],
+                             int count,
+                             const SkPoint dst_clips[],
+                             const SkMatrix pre_view_matrices[],
+                             const SkSamplingOptions& sampling,
+                             const SkPaint* paint,
+                             SrcRectConstraint constraint) override {
+    image_set_counts.push_back(count);
+  }
+};
+
+class DlSkCanvasDispatcherTest : public ::testing::Test {
+ protected:
+  void SetUp() override { DlSkCanvasDispatcher::SetBatchImageDraws(true); }
+  void TearDown() override { DlSkCanvasDispatcher::SetBatchImageDraws(false); }
+};
+
+TEST_F(DlSkCanvasDispatcherTest, BatchesConsecutiveImageDraws) {
+  DisplayListBuilder builder;
+  const SkRect src = SkRect::MakeWH(10, 10);
+  builder.DrawImageRect(TestImage1, src, SkRect::MakeXYWH(0, 0, 10, 10),
+                        DlImageSampling::kLinear);
+  builder.DrawImageRect(TestImage2, src, SkRect::MakeXYWH(10, 0, 10, 10),
+                        DlImageSampling::kLinear);
+  builder.DrawImageRect(TestImage1, src, SkRect::MakeXYWH(20, 0, 10, 10),
+                        DlImageSampling::kLinear);
+  builder.DrawRect(SkRect::MakeXYWH(0, 20, 10, 10), DlPaint());
+  builder.DrawImage(TestImage1, {0, 40}, DlImageSampling::kLinear);
+  auto display_list = builder.Build();
+
+  ImageDrawCountingCanvas canvas;
+  DlSkCanvasDispatcher dispatcher(&canvas);
+  display_list->Dispatch(dispatcher);
+  dispatcher.FlushImageSet();
+
+  ASSERT_EQ(canvas.image_set_counts.size(), 1u);
+  EXPECT_EQ(canvas.image_set_counts[0], 3);
+  EXPECT_EQ(canvas.image_rect_count, 1);
+}
+
+TEST_F(DlSkCanvasDispatcherTest, DoesNotBatchImagesWithDifferentSampling) {
+  DisplayListBuilder builder;
+  builder.DrawImage(TestImage1, {0, 0}, DlImageSampling::kLinear);
+  builder.DrawImage(TestImage1, {10, 0}, DlImageSampling::kNearestNeighbor);
+  builder.DrawImage(TestImage1, {20, 0}, DlImageSampling::kNearestNeighbor);
+  auto display_list = builder.Build();
+
+  ImageDrawCountingCanvas canvas;
+  {
+    DlSkCanvasDispatcher dispatcher(&canvas);
+    display_list->Dispatch(dispatcher);
+  }
+
+  ASSERT_EQ(canvas.image_set_counts.size(), 1u);
+  EXPECT_EQ(canvas.image_set_counts[0], 2);
+  EXPECT_EQ(canvas.image_rect_count, 1);
+}
+
+TEST(DlSkCanvasDispatcherBatchingTest, DrawsImagesOneByOneByDefault) {
+  DisplayListBuilder builder;
+  builder.DrawImage(TestImage1, {0, 0}, DlImageSampling::kLinear);
+  builder.DrawImage(TestImage1, {10, 0}, DlImageSampling::kLinear);
+  auto display_list = builder.Build();
+
+  ImageDrawCountingCanvas canvas;
+  DlSkCanvasDispatcher dispatcher(&canvas);
+  display_list->Dispatch(dispatcher);
+
+  EXPECT_TRUE(canvas.image_set_counts.empty());
+  EXPECT_EQ(canvas.image_count, 2);
+}
+
+}  // namespace testing
+}  // namespace flutter
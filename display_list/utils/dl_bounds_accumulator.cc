@@ -116,6 +116,14 @@ bool RTreeBoundsAccumulator::restore(
   return success;
 }
 
+void RTreeBoundsAccumulator::remap_indices(const std::vector<int>& index_map) {
+  for (int& index : rect_indices_) {
+    if (index >= 0 && static_cast<size_t>(index) < index_map.size()) {
+      index = index_map[index];
+    }
+  }
+}
+
 SkRect RTreeBoundsAccumulator::bounds() const {
   FML_DCHECK(saved_offsets_.empty());
   RectBoundsAccumulator accumulator;
@@ -6,6 +6,7 @@
 #define FLUTTER_DISPLAY_LIST_UTILS_DL_BOUNDS_ACCUMULATOR_H_
 
 #include <functional>
+#include <vector>
 
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "flutter/fml/logging.h"
@@ -82,6 +83,11 @@ class BoundsAccumulator {
       std::function<bool(const SkRect& original, SkRect& modified)> map,
       const SkRect* clip = nullptr) = 0;
 
+  /// Replaces the op index of every accumulated rect with the value found
+  /// at that position in |index_map|, used when ops are removed from the
+  /// DisplayList after their bounds were accumulated.
+  virtual void remap_indices(const std::vector<int>& index_map) = 0;
+
   virtual SkRect bounds() const = 0;
 
   virtual sk_sp<DlRTree> rtree() const = 0;
@@ -103,6 +109,8 @@ class RectBoundsAccumulator final : public virtual BoundsAccumulator {
   bool restore(std::function<bool(const SkRect&, SkRect&)> mapper,
                const SkRect* clip) override;
 
+  void remap_indices(const std::vector<int>& index_map) override {}
+
   SkRect bounds() const override {
     FML_DCHECK(saved_rects_.empty());
     return rect_.bounds();
@@ -149,6 +157,8 @@ class RTreeBoundsAccumulator final : public virtual BoundsAccumulator {
       std::function<bool(const SkRect& original, SkRect& modified)> map,
       const SkRect* clip = nullptr) override;
 
+  void remap_indices(const std::vector<int>& index_map) override;
+
   SkRect bounds() const override;
 
   sk_sp<DlRTree> rtree() const override;
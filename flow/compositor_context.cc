@@ -41,6 +41,10 @@ std::optional<SkRect> FrameDamage::ComputeClipRect(
     damage_ =
         context.ComputeDamage(additional_damage_, horizontal_clip_alignment_,
                               vertical_clip_alignment_);
+    context.statistics().LogStatistics();
+    if (!clip_to_damage_) {
+      return std::nullopt;
+    }
     return SkRect::Make(damage_->buffer_damage);
   }
   return std::nullopt;
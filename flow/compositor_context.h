@@ -14,6 +14,7 @@
 #include "flutter/flow/layer_snapshot_store.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/stopwatch.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/raster_thread_merger.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -67,11 +68,19 @@ class FrameDamage {
     vertical_clip_alignment_ = vertical;
   }
 
+  // Specifies whether the rasterization is clipped to the damage. Surfaces
+  // that always repaint entire frames may still compute the damage to report
+  // which parts of the frame changed.
+  void SetClipToDamage(bool clip_to_damage) {
+    clip_to_damage_ = clip_to_damage;
+  }
+
   // Calculates clip rect for current rasterization. This is diff of layer tree
   // and previous layer tree + any additional provided damage.
   // If previous layer tree is not specified, clip rect will be nullopt,
   // but the paint region of layer_tree will be calculated so that it can be
-  // used for diffing of subsequent frames.
+  // used for diffing of subsequent frames. The clip rect is also nullopt if
+  // the rasterization is not clipped to the damage.
   std::optional<SkRect> ComputeClipRect(flutter::LayerTree& layer_tree,
                                         bool has_raster_cache,
                                         bool impeller_enabled);
@@ -100,6 +109,7 @@ class FrameDamage {
   const LayerTree* prev_layer_tree_ = nullptr;
   int vertical_clip_alignment_ = 1;
   int horizontal_clip_alignment_ = 1;
+  bool clip_to_damage_ = true;
   bool ignore_damage_ = false;
 };
 
@@ -194,12 +204,24 @@ class CompositorContext {
 
   LayerSnapshotStore& snapshot_store() { return layer_snapshot_store_; }
 
+  // The workers used to preroll and paint the children of wide containers in
+  // parallel. Layer trees are traversed on the raster thread alone if this is
+  // not set.
+  const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner() const {
+    return worker_task_runner_;
+  }
+  void set_worker_task_runner(
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner) {
+    worker_task_runner_ = std::move(worker_task_runner);
+  }
+
  private:
   RasterCache raster_cache_;
   std::shared_ptr<TextureRegistry> texture_registry_;
   Stopwatch raster_time_;
   Stopwatch ui_time_;
   LayerSnapshotStore layer_snapshot_store_;
+  std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
 
   /// Only used by default constructor of `CompositorContext`.
   FixedRefreshRateUpdater fixed_refresh_rate_updater_;
@@ -180,18 +180,26 @@ void DiffContext::MarkSubtreeDirty(const SkRect& previous_paint_region) {
   state_.dirty = true;
 }
 
-void DiffContext::AddLayerBounds(const SkRect& rect) {
+bool DiffContext::MapLayerRect(const SkRect& rect, SkRect* transformed_rect) {
   // During painting we cull based on non-overriden transform and then
   // override the transform right before paint. Do the same thing here to get
   // identical paint rect.
-  auto transformed_rect = ApplyFilterBoundsAdjustment(MapRect(rect));
-  if (transformed_rect.intersects(clip_tracker_.device_cull_rect())) {
-    if (state_.integral_transform) {
-      clip_tracker_.save();
-      MakeCurrentTransformIntegral();
-      transformed_rect = ApplyFilterBoundsAdjustment(MapRect(rect));
-      clip_tracker_.restore();
-    }
+  *transformed_rect = ApplyFilterBoundsAdjustment(MapRect(rect));
+  if (!transformed_rect->intersects(clip_tracker_.device_cull_rect())) {
+    return false;
+  }
+  if (state_.integral_transform) {
+    clip_tracker_.save();
+    MakeCurrentTransformIntegral();
+    *transformed_rect = ApplyFilterBoundsAdjustment(MapRect(rect));
+    clip_tracker_.restore();
+  }
+  return true;
+}
+
+void DiffContext::AddLayerBounds(const SkRect& rect) {
+  SkRect transformed_rect;
+  if (MapLayerRect(rect, &transformed_rect)) {
     rects_->push_back(transformed_rect);
     if (IsSubtreeDirty()) {
       AddDamage(transformed_rect);
@@ -199,6 +207,13 @@ void DiffContext::AddLayerBounds(const SkRect& rect) {
   }
 }
 
+void DiffContext::AddLayerDamage(const SkRect& rect) {
+  SkRect transformed_rect;
+  if (MapLayerRect(rect, &transformed_rect)) {
+    AddDamage(transformed_rect);
+  }
+}
+
 void DiffContext::MarkSubtreeHasTextureLayer() {
   // Set the has_texture flag on current state and all parent states. That
   // way we'll know that we can't skip diff for retained layers because
@@ -229,6 +244,20 @@ void DiffContext::AddReadbackRegion(const SkIRect& paint_rect,
   readbacks_.push_back(readback);
 }
 
+bool DiffContext::IsReadbackRegionDamaged(const SkIRect& readback_rect) const {
+  SkRect damage(damage_);
+  // Mirror ComputeDamage, but only for readbacks diffed so far: a damaged
+  // readback repaints its paint rect, which may be read back in turn.
+  for (const auto& r : readbacks_) {
+    if (SkRect::Make(r.paint_rect).intersects(damage) ||
+        SkRect::Make(r.readback_rect).intersects(damage)) {
+      damage.join(SkRect::Make(r.readback_rect));
+      damage.join(SkRect::Make(r.paint_rect));
+    }
+  }
+  return SkRect::Make(readback_rect).intersects(damage);
+}
+
 PaintRegion DiffContext::CurrentSubtreeRegion() const {
   bool has_readback = std::any_of(
       readbacks_.begin(), readbacks_.end(),
@@ -272,7 +301,10 @@ void DiffContext::Statistics::LogStatistics() {
                     deep_compare_pictures_, "SameInstancePictures",
                     same_instance_pictures_,
                     "DifferentInstanceButEqualPictures",
-                    different_instance_but_equal_pictures_);
+                    different_instance_but_equal_pictures_,
+                    "PartiallyChangedPictures", partially_changed_pictures_,
+                    "UnchangedBackdrops", unchanged_backdrops_,
+                    "ChangedBackdrops", changed_backdrops_);
 #endif  // !FLUTTER_RELEASE
 }
 
@@ -115,6 +115,12 @@ class DiffContext {
   // coordinates.
   void AddLayerBounds(const SkRect& rect);
 
+  // Add rect to damage without adding it to the paint region; rect is in
+  // "local" (layer) coordinates and is mapped like the rect passed to
+  // AddLayerBounds. Used by layers that determine which parts of their content
+  // changed in a subtree that is not dirty.
+  void AddLayerDamage(const SkRect& rect);
+
   // Add entire paint region of retained layer for current subtree. This can
   // only be used in subtrees that are not dirty, otherwise ancestor transforms
   // or clips may result in different paint region.
@@ -130,6 +136,15 @@ class DiffContext {
   void AddReadbackRegion(const SkIRect& paint_rect,
                          const SkIRect& readback_rect);
 
+  // Returns whether anything diffed so far, which is everything painted before
+  // the current layer, damages readback_rect (in screen coordinates). This
+  // includes the paint rects of earlier readbacks that are damaged themselves.
+  //
+  // When this returns false for the readback region of a filter that didn't
+  // change either, the filter samples the same backdrop as in the previous
+  // frame.
+  bool IsReadbackRegionDamaged(const SkIRect& readback_rect) const;
+
   // Returns the paint region for current subtree; Each rect in paint region is
   // in screen coordinates; Once a layer accumulates the paint regions of its
   // children, this PaintRegion value can be associated with the current layer
@@ -189,6 +204,19 @@ class DiffContext {
       ++different_instance_but_equal_pictures_;
     };
 
+    // Picture replaced by different picture of which only the changed area
+    // was damaged
+    void AddPartiallyChangedPicture() { ++partially_changed_pictures_; }
+
+    // Backdrop filter that samples the same backdrop as in the previous frame
+    void AddUnchangedBackdrop() { ++unchanged_backdrops_; }
+
+    // Backdrop filter that is new or samples a damaged backdrop
+    void AddChangedBackdrop() { ++changed_backdrops_; }
+
+    int unchanged_backdrops() const { return unchanged_backdrops_; }
+    int changed_backdrops() const { return changed_backdrops_; }
+
     // Logs the statistics to trace counter
     void LogStatistics();
 
@@ -198,6 +226,9 @@ class DiffContext {
     int same_instance_pictures_ = 0;
     int deep_compare_pictures_ = 0;
     int different_instance_but_equal_pictures_ = 0;
+    int partially_changed_pictures_ = 0;
+    int unchanged_backdrops_ = 0;
+    int changed_backdrops_ = 0;
   };
 
   Statistics& statistics() { return statistics_; }
@@ -236,6 +267,10 @@ class DiffContext {
 
   void MakeCurrentTransformIntegral();
 
+  // Maps layer rect to screen coordinates the way the layer is painted.
+  // Returns false if the result doesn't intersect the cull rect.
+  bool MapLayerRect(const SkRect& rect, SkRect* transformed_rect);
+
   DisplayListMatrixClipTracker clip_tracker_;
   std::shared_ptr<std::vector<SkRect>> rects_;
   State state_;
@@ -32,5 +32,27 @@ TEST_F(DiffContextTest, ClipAlignment) {
   EXPECT_EQ(damage.buffer_damage, SkIRect::MakeLTRB(16, 16, 64, 64));
 }
 
+TEST_F(DiffContextTest, ReadbackRegionDamage) {
+  PaintRegionMap this_frame_paint_region_map;
+  PaintRegionMap last_frame_paint_region_map;
+  DiffContext dc(SkISize::Make(100, 100), this_frame_paint_region_map,
+                 last_frame_paint_region_map, /*has_raster_cache=*/false,
+                 /*impeller_enabled=*/false);
+  dc.PushCullRect(SkRect::MakeIWH(100, 100));
+
+  dc.BeginSubtree();
+  dc.MarkSubtreeDirty();
+  dc.AddLayerBounds(SkRect::MakeLTRB(0, 0, 10, 10));
+  dc.EndSubtree();
+  EXPECT_TRUE(dc.IsReadbackRegionDamaged(SkIRect::MakeLTRB(5, 5, 20, 20)));
+  EXPECT_FALSE(dc.IsReadbackRegionDamaged(SkIRect::MakeLTRB(30, 30, 40, 40)));
+
+  // The damaged readback repaints its paint rect, which damages the region.
+  dc.AddReadbackRegion(SkIRect::MakeLTRB(30, 30, 40, 40),
+                       SkIRect::MakeLTRB(0, 0, 40, 40));
+  EXPECT_TRUE(dc.IsReadbackRegionDamaged(SkIRect::MakeLTRB(30, 30, 40, 40)));
+  EXPECT_FALSE(dc.IsReadbackRegionDamaged(SkIRect::MakeLTRB(60, 60, 70, 70)));
+}
+
 }  // namespace testing
 }  // namespace flutter
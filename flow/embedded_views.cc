@@ -53,6 +53,10 @@ bool ExternalViewEmbedder::SupportsDynamicThreadMerging() {
   return false;
 }
 
+bool ExternalViewEmbedder::SupportsFrameDamage() {
+  return false;
+}
+
 void ExternalViewEmbedder::Teardown() {}
 
 void MutatorsStack::PushClipRect(const SkRect& rect) {
@@ -471,6 +471,13 @@ class ExternalViewEmbedder {
   // |RasterThreadMerger| instance.
   virtual bool SupportsDynamicThreadMerging();
 
+  // Whether the embedder presents the damage of the frames it submits.
+  //
+  // Returning `true` results in the damage of each frame being computed even
+  // though the embedder repaints entire frames. The damage is passed in the
+  // |SurfaceFrame::SubmitInfo| of the frame given to |SubmitFlutterView|.
+  virtual bool SupportsFrameDamage();
+
   // Called when the rasterizer is being torn down.
   // This method provides a way to release resources associated with the current
   // embedder.
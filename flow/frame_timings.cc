@@ -174,6 +174,11 @@ fml::Status FrameTimingsRecorder::RecordRasterStartImpl(
   return fml::Status();
 }
 
+void FrameTimingsRecorder::RecordPipelineDepth(uint32_t pipeline_depth) {
+  std::scoped_lock state_lock(state_mutex_);
+  pipeline_depth_ = pipeline_depth;
+}
+
 FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
   std::scoped_lock state_lock(state_mutex_);
   FML_DCHECK(state_ == State::kRasterStart);
@@ -198,6 +203,7 @@ FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
   timing_.Set(FrameTiming::kRasterFinish, raster_end_);
   timing_.Set(FrameTiming::kRasterFinishWallTime, raster_end_wall_time_);
   timing_.SetFrameNumber(GetFrameNumber());
+  timing_.SetPipelineDepth(pipeline_depth_);
   timing_.SetRasterCacheStatistics(layer_cache_count_, layer_cache_bytes_,
                                    picture_cache_count_, picture_cache_bytes_);
   return timing_;
@@ -31,6 +31,15 @@ void BackdropFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
     SkIRect filter_input_bounds;  // in screen coordinates
     filter_->get_input_device_bounds(
         filter_target_bounds, context->GetTransform3x3(), filter_input_bounds);
+    // A filter that didn't change and reads from an undamaged region samples
+    // the same backdrop as in the previous frame, so its result could be
+    // reused even if its children are repainted.
+    if (context->IsSubtreeDirty() ||
+        context->IsReadbackRegionDamaged(filter_input_bounds)) {
+      context->statistics().AddChangedBackdrop();
+    } else {
+      context->statistics().AddUnchangedBackdrop();
+    }
     context->AddReadbackRegion(filter_target_bounds, filter_input_bounds);
   }
 
@@ -4,7 +4,13 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include <algorithm>
+#include <functional>
 #include <optional>
+#include <thread>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 
 namespace flutter {
 
@@ -64,10 +70,17 @@ void ContainerLayer::DiffChildren(DiffContext* context,
     --old_children_bottom;
   }
 
+  // A single layer that changed in place may be able to damage only the
+  // parts of it that changed.
+  const bool single_layer_changed = old_children_top == old_children_bottom &&
+                                    new_children_top == new_children_bottom;
+
   // old layers that don't match
-  for (int i = old_children_top; i <= old_children_bottom; ++i) {
-    auto layer = prev_layers[i];
-    context->AddDamage(context->GetOldLayerPaintRegion(layer.get()));
+  if (!single_layer_changed) {
+    for (int i = old_children_top; i <= old_children_bottom; ++i) {
+      auto layer = prev_layers[i];
+      context->AddDamage(context->GetOldLayerPaintRegion(layer.get()));
+    }
   }
 
   for (int i = 0; i < static_cast<int>(layers_.size()); ++i) {
@@ -95,9 +108,16 @@ void ContainerLayer::DiffChildren(DiffContext* context,
         layer->Diff(context, prev_layer.get());
       }
     } else {
+      auto layer = layers_[i];
+      if (single_layer_changed) {
+        auto prev_layer = prev_layers[old_children_top];
+        if (layer->DiffChanges(context, prev_layer.get())) {
+          continue;
+        }
+        context->AddDamage(context->GetOldLayerPaintRegion(prev_layer.get()));
+      }
       DiffContext::AutoSubtreeRestore subtree(context);
       context->MarkSubtreeDirty();
-      auto layer = layers_[i];
       layer->Diff(context, nullptr);
     }
   }
@@ -137,32 +157,49 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   bool child_has_texture_layer = false;
   bool all_renderable_state_flags = LayerStateStack::kCallerCanApplyAnything;
 
-  for (auto& layer : layers_) {
-    // Reset context->has_platform_view and context->has_texture_layer to false
-    // so that layers aren't treated as if they have a platform view or texture
-    // layer based on one being previously found in a sibling tree.
-    context->has_platform_view = false;
-    context->has_texture_layer = false;
-
-    // Initialize the renderable state flags to false to force the layer to
-    // opt-in to applying state attributes during its |Preroll|
-    context->renderable_state_flags = 0;
-
-    layer->Preroll(context);
-
-    all_renderable_state_flags &= context->renderable_state_flags;
-    if (safe_intersection_test(child_paint_bounds, layer->paint_bounds())) {
+  auto accumulate_child = [&](const Layer& layer,
+                              const ChildPrerollState& state) {
+    all_renderable_state_flags &= state.renderable_state_flags;
+    if (safe_intersection_test(child_paint_bounds, layer.paint_bounds())) {
       // This will allow inheritance by a linear sequence of non-overlapping
       // children, but will fail with a grid or other arbitrary 2D layout.
       // See https://github.com/flutter/flutter/issues/93899
       all_renderable_state_flags = 0;
     }
-    child_paint_bounds->join(layer->paint_bounds());
+    child_paint_bounds->join(layer.paint_bounds());
 
     child_has_platform_view =
-        child_has_platform_view || context->has_platform_view;
+        child_has_platform_view || state.has_platform_view;
     child_has_texture_layer =
-        child_has_texture_layer || context->has_texture_layer;
+        child_has_texture_layer || state.has_texture_layer;
+  };
+
+  if (CanPrerollChildrenInParallel(context)) {
+    auto states = PrerollChildrenInParallel(context);
+    for (size_t i = 0; i < layers_.size(); i++) {
+      accumulate_child(*layers_[i], states[i]);
+    }
+  } else {
+    for (auto& layer : layers_) {
+      // Reset context->has_platform_view and context->has_texture_layer to
+      // false so that layers aren't treated as if they have a platform view or
+      // texture layer based on one being previously found in a sibling tree.
+      context->has_platform_view = false;
+      context->has_texture_layer = false;
+
+      // Initialize the renderable state flags to false to force the layer to
+      // opt-in to applying state attributes during its |Preroll|
+      context->renderable_state_flags = 0;
+
+      layer->PrerollOrReuse(context);
+
+      ChildPrerollState state = {
+          .renderable_state_flags = context->renderable_state_flags,
+          .has_platform_view = context->has_platform_view,
+          .has_texture_layer = context->has_texture_layer,
+      };
+      accumulate_child(*layer, state);
+    }
   }
 
   context->has_platform_view = child_has_platform_view;
@@ -171,6 +208,115 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   set_subtree_has_platform_view(child_has_platform_view);
   set_children_renderable_state_flags(all_renderable_state_flags);
   set_child_paint_bounds(*child_paint_bounds);
+  children_can_paint_in_parallel_ = layers_.size() >= kMinParallelChildCount &&
+                                    !child_has_platform_view &&
+                                    !child_has_texture_layer;
+}
+
+static size_t GetParallelChunkCount(size_t child_count) {
+  return std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u),
+                          child_count);
+}
+
+// Runs |traverse| for each chunk of consecutive children, running the first
+// chunk on the calling thread and the others on the workers, and waits for
+// all of them to finish.
+static void TraverseChunksInParallel(
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner,
+    size_t child_count,
+    size_t chunk_count,
+    const std::function<void(size_t chunk, size_t begin, size_t end)>&
+        traverse) {
+  auto traverse_chunk = [&](size_t chunk) {
+    traverse(chunk, chunk * child_count / chunk_count,
+             (chunk + 1) * child_count / chunk_count);
+  };
+  fml::CountDownLatch latch(chunk_count - 1);
+  for (size_t chunk = 1; chunk < chunk_count; chunk++) {
+    worker_task_runner->PostTask(
+        [&traverse_chunk, &latch, chunk]() {
+          traverse_chunk(chunk);
+          latch.CountDown();
+        },
+        fml::ConcurrentTaskPriority::kHigh);
+  }
+  traverse_chunk(0);
+  latch.Wait();
+}
+
+bool ContainerLayer::CanPrerollChildrenInParallel(
+    const PrerollContext* context) const {
+  // The view embedder expects to be told about platform views in paint order,
+  // so the subtrees can only be prerolled in parallel when there is none.
+  // The workers preroll with a 3x3 matrix, as the layer tree would.
+  return context->worker_task_runner &&
+         layers_.size() >= kMinParallelChildCount && !context->view_embedder &&
+         context->state_stack.transform_4x4() ==
+             SkM44(context->state_stack.transform_3x3());
+}
+
+std::vector<ContainerLayer::ChildPrerollState>
+ContainerLayer::PrerollChildrenInParallel(PrerollContext* context) {
+  TRACE_EVENT0("flutter", "ContainerLayer::PrerollChildrenInParallel");
+  const size_t child_count = layers_.size();
+  const size_t chunk_count = GetParallelChunkCount(child_count);
+  const SkRect cull_rect = context->state_stack.device_cull_rect();
+  const SkMatrix matrix = context->state_stack.transform_3x3();
+
+  std::vector<ChildPrerollState> states(child_count);
+  // Raster cache items must be prepared in paint order, so each chunk
+  // collects its own and they are concatenated below.
+  std::vector<std::vector<RasterCacheItem*>> chunk_cached_entries(chunk_count);
+  std::vector<char> chunk_needs_readback(chunk_count, false);
+
+  TraverseChunksInParallel(
+      context->worker_task_runner, child_count, chunk_count,
+      [&](size_t chunk, size_t begin, size_t end) {
+        LayerStateStack state_stack;
+        state_stack.set_preroll_delegate(cull_rect, matrix);
+        PrerollContext chunk_context = {
+            // clang-format off
+            .raster_cache                  = context->raster_cache,
+            .gr_context                    = context->gr_context,
+            .view_embedder                 = nullptr,
+            .state_stack                   = state_stack,
+            .dst_color_space               = context->dst_color_space,
+            .surface_needs_readback        = context->surface_needs_readback,
+            .raster_time                   = context->raster_time,
+            .ui_time                       = context->ui_time,
+            .texture_registry              = context->texture_registry,
+            .raster_cached_entries         = &chunk_cached_entries[chunk],
+            // Nested containers traverse their children on this worker, the
+            // other workers may all be waiting for them.
+            .worker_task_runner            = nullptr,
+            .reuse_retained_prerolls       = context->reuse_retained_prerolls,
+            // clang-format on
+        };
+        for (size_t i = begin; i < end; i++) {
+          chunk_context.has_platform_view = false;
+          chunk_context.has_texture_layer = false;
+          chunk_context.renderable_state_flags = 0;
+          layers_[i]->PrerollOrReuse(&chunk_context);
+          states[i] = {
+              .renderable_state_flags = chunk_context.renderable_state_flags,
+              .has_platform_view = chunk_context.has_platform_view,
+              .has_texture_layer = chunk_context.has_texture_layer,
+          };
+        }
+        chunk_needs_readback[chunk] = chunk_context.surface_needs_readback;
+      });
+
+  for (size_t chunk = 0; chunk < chunk_count; chunk++) {
+    if (context->raster_cached_entries) {
+      context->raster_cached_entries->insert(
+          context->raster_cached_entries->end(),
+          chunk_cached_entries[chunk].begin(),
+          chunk_cached_entries[chunk].end());
+    }
+    context->surface_needs_readback =
+        context->surface_needs_readback || chunk_needs_readback[chunk];
+  }
+  return states;
 }
 
 void ContainerLayer::PaintChildren(PaintContext& context) const {
@@ -180,6 +326,14 @@ void ContainerLayer::PaintChildren(PaintContext& context) const {
   // layer calls PaintChildren(), though, it may have modified the
   // PaintContext so the test doesn't work in this "context".
 
+  if (CanPaintChildrenInParallel(context)) {
+    // The children are recorded without the outstanding state, so it must
+    // all be applied here.
+    auto restore = context.state_stack.applyState(child_paint_bounds(), 0);
+    PaintChildrenInParallel(context);
+    return;
+  }
+
   // Apply any outstanding state that the children cannot individually
   // and collectively handle.
   auto restore = context.state_stack.applyState(
@@ -194,4 +348,65 @@ void ContainerLayer::PaintChildren(PaintContext& context) const {
   }
 }
 
+bool ContainerLayer::CanPaintChildrenInParallel(
+    const PaintContext& context) const {
+  // Leaf layer snapshots are taken from the canvas of the raster thread.
+  return context.worker_task_runner && children_can_paint_in_parallel_ &&
+         !context.enable_leaf_layer_tracing;
+}
+
+void ContainerLayer::PaintChildrenInParallel(PaintContext& context) const {
+  TRACE_EVENT0("flutter", "ContainerLayer::PaintChildrenInParallel");
+  const size_t child_count = layers_.size();
+  const size_t chunk_count = GetParallelChunkCount(child_count);
+  const SkRect cull_rect = context.state_stack.device_cull_rect();
+  const SkM44 matrix = context.state_stack.transform_4x4();
+
+  // Each chunk of children is recorded in device space into its own display
+  // list, which the canvas then draws in order. The clip of the canvas
+  // still applies to those display lists, the workers only cull with it.
+  std::vector<sk_sp<DisplayList>> display_lists(chunk_count);
+  TraverseChunksInParallel(
+      context.worker_task_runner, child_count, chunk_count,
+      [&](size_t chunk, size_t begin, size_t end) {
+        DisplayListBuilder builder(cull_rect);
+        builder.Transform(matrix);
+        LayerStateStack state_stack;
+        state_stack.set_delegate(&builder);
+        PaintContext chunk_context = {
+            // clang-format off
+            .state_stack                   = state_stack,
+            .canvas                        = &builder,
+            .rendering_above_platform_view =
+                context.rendering_above_platform_view,
+            .gr_context                    = context.gr_context,
+            .dst_color_space               = context.dst_color_space,
+            .view_embedder                 = context.view_embedder,
+            .raster_time                   = context.raster_time,
+            .ui_time                       = context.ui_time,
+            .texture_registry              = context.texture_registry,
+            .raster_cache                  = context.raster_cache,
+            .impeller_enabled              = context.impeller_enabled,
+            .aiks_context                  = context.aiks_context,
+            // clang-format on
+        };
+        for (size_t i = begin; i < end; i++) {
+          if (layers_[i]->needs_painting(chunk_context)) {
+            layers_[i]->Paint(chunk_context);
+          }
+        }
+        display_lists[chunk] = builder.Build();
+      });
+
+  DlCanvas* canvas = context.canvas;
+  canvas->Save();
+  canvas->TransformReset();
+  for (const auto& display_list : display_lists) {
+    if (display_list->op_count() > 0) {
+      canvas->DrawDisplayList(display_list);
+    }
+  }
+  canvas->Restore();
+}
+
 }  // namespace flutter
@@ -13,6 +13,11 @@ namespace flutter {
 
 class ContainerLayer : public Layer {
  public:
+  // The number of children above which the subtrees of the children are
+  // prerolled and painted on the worker task runner of the contexts, if any.
+  // Smaller containers aren't worth the cost of synchronizing with workers.
+  static constexpr size_t kMinParallelChildCount = 16u;
+
   ContainerLayer();
 
   void Diff(DiffContext* context, const Layer* old_layer) override;
@@ -48,9 +53,26 @@ class ContainerLayer : public Layer {
   void PrerollChildren(PrerollContext* context, SkRect* child_paint_bounds);
 
  private:
+  struct ChildPrerollState {
+    int renderable_state_flags = 0;
+    bool has_platform_view = false;
+    bool has_texture_layer = false;
+  };
+
+  bool CanPrerollChildrenInParallel(const PrerollContext* context) const;
+  std::vector<ChildPrerollState> PrerollChildrenInParallel(
+      PrerollContext* context);
+
+  bool CanPaintChildrenInParallel(const PaintContext& context) const;
+  void PaintChildrenInParallel(PaintContext& context) const;
+
   std::vector<std::shared_ptr<Layer>> layers_;
   SkRect child_paint_bounds_;
   int children_renderable_state_flags_ = 0;
+  // Whether the subtrees of the children only record into the canvas, so
+  // that each of them can be recorded on a worker into a separate display
+  // list. Platform views and textures must be painted on the raster thread.
+  bool children_can_paint_in_parallel_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
 };
@@ -9,6 +9,7 @@
 #include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "gtest/gtest.h"
 #include "include/core/SkMatrix.h"
@@ -560,6 +561,92 @@ TEST_F(ContainerLayerTest, CollectionCacheableLayer) {
             static_cast<const unsigned long>(2));
 }
 
+TEST_F(ContainerLayerTest, ParallelPrerollAndPaint) {
+  auto message_loop = fml::ConcurrentMessageLoop::Create(4u);
+  SkMatrix initial_transform = SkMatrix::Translate(-0.5f, -0.5f);
+  DlPaint child_paint = DlPaint(DlColor::kGreen());
+
+  auto serial_layer = std::make_shared<ContainerLayer>();
+  auto parallel_layer = std::make_shared<ContainerLayer>();
+  std::vector<std::shared_ptr<MockLayer>> mock_layers;
+  for (size_t i = 0; i < ContainerLayer::kMinParallelChildCount; i++) {
+    SkPath child_path = SkPath::Rect(SkRect::MakeXYWH(i * 10.0f, 5, 8, 8));
+    serial_layer->Add(std::make_shared<MockLayer>(child_path, child_paint));
+    auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+    parallel_layer->Add(mock_layer);
+    mock_layers.push_back(mock_layer);
+  }
+
+  preroll_context()->state_stack.set_preroll_delegate(initial_transform);
+  serial_layer->Preroll(preroll_context());
+  preroll_context()->worker_task_runner = message_loop->GetTaskRunner();
+  parallel_layer->Preroll(preroll_context());
+  EXPECT_FALSE(preroll_context()->has_platform_view);
+  EXPECT_EQ(parallel_layer->paint_bounds(), serial_layer->paint_bounds());
+  EXPECT_EQ(parallel_layer->children_renderable_state_flags(),
+            serial_layer->children_renderable_state_flags());
+  for (auto& mock_layer : mock_layers) {
+    EXPECT_EQ(mock_layer->parent_matrix(), initial_transform);
+    EXPECT_EQ(mock_layer->parent_cull_rect(), kGiantRect);
+  }
+
+  serial_layer->Paint(display_list_paint_context());
+  auto serial_display_list = display_list();
+  reset_display_list();
+
+  display_list_paint_context().worker_task_runner =
+      message_loop->GetTaskRunner();
+  parallel_layer->Paint(display_list_paint_context());
+  auto parallel_display_list = display_list();
+
+  // The children are drawn from nested display lists with the same bounds.
+  EXPECT_EQ(parallel_display_list->bounds(), serial_display_list->bounds());
+  EXPECT_GE(parallel_display_list->op_count(/*nested=*/true) -
+                parallel_display_list->op_count(),
+            serial_display_list->op_count());
+}
+
+TEST_F(ContainerLayerTest, ReusesPrerollOfRetainedChildren) {
+  auto path1 = SkPath().addRect({10, 10, 30, 30});
+  auto path2 = SkPath().addRect({40, 40, 50, 50});
+  auto mock1 = MockLayer::MakeOpacityCompatible(path1);
+  auto mock2 = MockLayer::Make(path2);
+  mock2->set_fake_has_platform_view(true);
+  auto container = std::make_shared<ContainerLayer>();
+  container->Add(mock1);
+  container->Add(mock2);
+
+  PrerollContext* context = preroll_context();
+  context->reuse_retained_prerolls = true;
+  SkMatrix transform = SkMatrix::Translate(5, 5);
+  context->state_stack.set_preroll_delegate(transform);
+  container->Preroll(context);
+  EXPECT_EQ(mock1->preroll_count(), 1);
+  EXPECT_EQ(mock2->preroll_count(), 1);
+
+  // The subtree of a platform view is prerolled every time.
+  context->has_platform_view = false;
+  container->Preroll(context);
+  EXPECT_EQ(mock1->preroll_count(), 1);
+  EXPECT_EQ(mock2->preroll_count(), 2);
+  SkRect expected_bounds = path1.getBounds();
+  expected_bounds.join(path2.getBounds());
+  EXPECT_EQ(container->paint_bounds(), expected_bounds);
+  EXPECT_TRUE(context->has_platform_view);
+
+  // The transform is an input of the preroll.
+  context->has_platform_view = false;
+  context->state_stack.set_preroll_delegate(SkMatrix::Translate(10, 10));
+  container->Preroll(context);
+  EXPECT_EQ(mock1->preroll_count(), 2);
+  EXPECT_EQ(mock1->parent_matrix(), SkMatrix::Translate(10, 10));
+
+  context->has_platform_view = false;
+  context->reuse_retained_prerolls = false;
+  container->Preroll(context);
+  EXPECT_EQ(mock1->preroll_count(), 3);
+}
+
 using ContainerLayerDiffTest = DiffContextTest;
 
 // Insert PictureLayer amongst container layers
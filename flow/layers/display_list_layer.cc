@@ -57,6 +57,34 @@ void DisplayListLayer::Diff(DiffContext* context, const Layer* old_layer) {
   context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
 }
 
+bool DisplayListLayer::DiffChanges(DiffContext* context,
+                                   const Layer* old_layer) {
+  FML_DCHECK(!context->IsSubtreeDirty());
+  auto prev = old_layer->as_display_list_layer();
+  if (prev == nullptr || prev->offset_ != offset_) {
+    return false;
+  }
+  // Only the area covered by the ops that differ between the two display
+  // lists is damaged, and painting within that area only dispatches the ops
+  // that intersect it.
+  auto changed_bounds =
+      display_list_->ComputeChangedBounds(*prev->display_list_);
+  if (!changed_bounds.has_value()) {
+    return false;
+  }
+  context->statistics().AddPartiallyChangedPicture();
+
+  DiffContext::AutoSubtreeRestore subtree(context);
+  context->PushTransform(SkMatrix::Translate(offset_.x(), offset_.y()));
+  if (context->has_raster_cache()) {
+    context->WillPaintWithIntegralTransform();
+  }
+  context->AddLayerDamage(changed_bounds.value());
+  context->AddLayerBounds(display_list()->bounds());
+  context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
+  return true;
+}
+
 bool DisplayListLayer::Compare(DiffContext::Statistics& statistics,
                                const DisplayListLayer* l1,
                                const DisplayListLayer* l2) {
@@ -157,6 +185,18 @@ void DisplayListLayer::Paint(PaintContext& context) const {
     context.layer_snapshot_store->Add(snapshot_data);
   }
 
+  if (context.raster_cache && display_list_raster_cache_item_) {
+    // Measure how long the display list takes to draw without the cache to
+    // decide whether it is worth caching.
+    const auto start_time = fml::TimePoint::Now();
+    context.canvas->DrawDisplayList(display_list_, opacity);
+    context.raster_cache->RecordDrawCost(
+        RasterCacheKeyID(display_list_->unique_id(),
+                         RasterCacheKeyType::kDisplayList),
+        fml::TimePoint::Now() - start_time);
+    return;
+  }
+
   context.canvas->DrawDisplayList(display_list_, opacity);
 }
 
@@ -29,6 +29,8 @@ class DisplayListLayer : public Layer {
 
   void Diff(DiffContext* context, const Layer* old_layer) override;
 
+  bool DiffChanges(DiffContext* context, const Layer* old_layer) override;
+
   const DisplayListLayer* as_display_list_layer() const override {
     return this;
   }
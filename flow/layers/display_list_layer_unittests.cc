@@ -439,6 +439,42 @@ TEST_F(DisplayListLayerDiffTest, DisplayListCompare) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(20, 20, 70, 70));
 }
 
+TEST_F(DisplayListLayerDiffTest, DisplayListChangedOps) {
+  auto create_display_list = [](DlColor cursor_color) {
+    DisplayListBuilder builder(/*prepare_rtree=*/true);
+    builder.Save();
+    builder.ClipRect(SkRect::MakeLTRB(0, 0, 500, 500));
+    builder.DrawRect(SkRect::MakeLTRB(10, 10, 400, 400),
+                     DlPaint(DlColor::kGreen()));
+    builder.DrawRect(SkRect::MakeLTRB(100, 100, 102, 120),
+                     DlPaint(cursor_color));
+    builder.DrawRect(SkRect::MakeLTRB(300, 300, 450, 450),
+                     DlPaint(DlColor::kBlue()));
+    builder.Restore();
+    return builder.Build();
+  };
+
+  MockLayerTree tree1;
+  tree1.root()->Add(
+      CreateDisplayListLayer(create_display_list(DlColor::kBlack())));
+  auto damage = DiffLayerTree(tree1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(10, 10, 450, 450));
+
+  // Only the area of the op that changed is damaged.
+  MockLayerTree tree2;
+  tree2.root()->Add(
+      CreateDisplayListLayer(create_display_list(DlColor::kRed())));
+  damage = DiffLayerTree(tree2, tree1);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(100, 100, 102, 120));
+
+  // Moving the layer damages both of its positions.
+  MockLayerTree tree3;
+  tree3.root()->Add(CreateDisplayListLayer(
+      create_display_list(DlColor::kBlack()), SkPoint::Make(10, 10)));
+  damage = DiffLayerTree(tree3, tree2);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(10, 10, 460, 460));
+}
+
 TEST_F(DisplayListLayerTest, LayerTreeSnapshotsWhenEnabled) {
   const SkPoint layer_offset = SkPoint::Make(1.5f, -0.5f);
   const SkRect picture_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
@@ -22,6 +22,7 @@ static bool IsDisplayListWorthRasterizing(
     const DisplayList* display_list,
     bool will_change,
     bool is_complex,
+    std::optional<fml::TimeDelta> measured_draw_cost,
     DisplayListComplexityCalculator* complexity_calculator) {
   if (will_change) {
     // If the display list is going to change in the future, there is no point
@@ -42,6 +43,17 @@ static bool IsDisplayListWorthRasterizing(
     return true;
   }
 
+  if (measured_draw_cost.has_value() &&
+      measured_draw_cost.value() >=
+          fml::TimeDelta::FromMicroseconds(
+              RasterCacheUtil::kMinimumDrawCostToCacheMicros)) {
+    // The complexity score is only an estimate, display lists that were
+    // measured to be slow to draw are worth rasterizing regardless. Only the
+    // CPU side of drawing is measured, so a low cost doesn't prove the display
+    // list is cheap for the GPU and the score still decides in that case.
+    return true;
+  }
+
   unsigned int complexity_score = complexity_calculator->Compute(display_list);
   return complexity_calculator->ShouldBeCached(complexity_score);
 }
@@ -76,7 +88,13 @@ void DisplayListRasterCacheItem::PrerollSetup(PrerollContext* context,
                                 context->gr_context->backend())
                           : DisplayListComplexityCalculator::GetForSoftware();
 
+  std::optional<fml::TimeDelta> measured_draw_cost;
+  if (context->raster_cache) {
+    measured_draw_cost = context->raster_cache->GetDrawCost(key_id_);
+  }
+
   if (!IsDisplayListWorthRasterizing(display_list(), will_change_, is_complex_,
+                                     measured_draw_cost,
                                      complexity_calculator)) {
     // We only deal with display lists that are worthy of rasterization.
     return;
@@ -164,6 +182,7 @@ bool DisplayListRasterCacheItem::TryToPrepareRasterCache(
       .matrix             = transformation_matrix_,
       .logical_rect       = bounds,
       .flow_type          = flow_type,
+      .aiks_context       = context.aiks_context,
       // clang-format on
   };
   return context.raster_cache->UpdateCacheEntry(
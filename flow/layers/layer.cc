@@ -24,6 +24,47 @@ uint64_t Layer::NextUniqueID() {
   return id;
 }
 
+void Layer::PrerollOrReuse(PrerollContext* context) {
+  if (!context->reuse_retained_prerolls) {
+    last_preroll_.reset();
+    Preroll(context);
+    return;
+  }
+
+  const SkM44 transform = context->state_stack.transform_4x4();
+  const SkRect cull_rect = context->state_stack.device_cull_rect();
+  const bool has_raster_cache = context->raster_cache != nullptr;
+  if (last_preroll_.has_value() && last_preroll_->transform == transform &&
+      last_preroll_->cull_rect == cull_rect &&
+      last_preroll_->has_raster_cache == has_raster_cache) {
+    context->renderable_state_flags = last_preroll_->renderable_state_flags;
+    context->has_texture_layer = last_preroll_->has_texture_layer;
+    return;
+  }
+
+  const bool needed_readback = context->surface_needs_readback;
+  const size_t cached_entry_count = context->raster_cached_entries
+                                        ? context->raster_cached_entries->size()
+                                        : 0u;
+  Preroll(context);
+
+  const bool registered_cache_entries =
+      context->raster_cached_entries &&
+      context->raster_cached_entries->size() != cached_entry_count;
+  if (context->has_platform_view || needed_readback ||
+      context->surface_needs_readback || registered_cache_entries) {
+    last_preroll_.reset();
+    return;
+  }
+  last_preroll_ = {
+      .transform = transform,
+      .cull_rect = cull_rect,
+      .has_raster_cache = has_raster_cache,
+      .renderable_state_flags = context->renderable_state_flags,
+      .has_texture_layer = context->has_texture_layer,
+  };
+}
+
 Layer::AutoPrerollSaveLayerState::AutoPrerollSaveLayerState(
     PrerollContext* preroll_context,
     bool save_layer_is_active,
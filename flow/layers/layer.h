@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <unordered_set>
 #include <vector>
 
@@ -19,6 +20,7 @@
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/stopwatch.h"
 #include "flutter/fml/build_config.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/compiler_specific.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
@@ -82,6 +84,14 @@ struct PrerollContext {
   int renderable_state_flags = 0;
 
   std::vector<RasterCacheItem*>* raster_cached_entries;
+
+  // When set, containers with many children preroll the subtree of each child
+  // on these workers. See |ContainerLayer::PrerollChildren|.
+  std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner;
+
+  // Whether layers retained from an earlier frame may skip their preroll.
+  // See |Layer::PrerollOrReuse|.
+  bool reuse_retained_prerolls = false;
 };
 
 struct PaintContext {
@@ -119,6 +129,10 @@ struct PaintContext {
   bool enable_leaf_layer_tracing = false;
   bool impeller_enabled = false;
   impeller::AiksContext* aiks_context;
+
+  // When set, containers with many children record the subtree of each child
+  // on these workers. See |ContainerLayer::PaintChildren|.
+  std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner;
 };
 
 // Represents a single composited layer. Created on the UI thread but then
@@ -156,6 +170,16 @@ class Layer {
   // Performs diff with given layer
   virtual void Diff(DiffContext* context, const Layer* old_layer) {}
 
+  // Used for a layer that is the only change among its siblings, where
+  // |old_layer| is in its place in the previous frame but is not replaced by
+  // it. If the layer can tell which parts of its content changed, it adds
+  // its paint region and only those parts as damage and returns true.
+  // Otherwise it returns false without touching the context, and both
+  // layers are damaged as a whole.
+  virtual bool DiffChanges(DiffContext* context, const Layer* old_layer) {
+    return false;
+  }
+
   // Used when diffing retained layer; In case the layer is identical, it
   // doesn't need to be diffed, but the paint region needs to be stored in diff
   // context so that it can be used in next frame
@@ -167,6 +191,17 @@ class Layer {
 
   virtual void Preroll(PrerollContext* context) = 0;
 
+  // Used by containers to preroll their children. Calls |Preroll| unless the
+  // layer is retained from an earlier frame and was last prerolled under the
+  // same transform, cull rect and raster cache availability. As layers are
+  // immutable once built, the results of that preroll, including the paint
+  // bounds throughout the subtree, still hold and are reported again.
+  //
+  // Subtrees that register raster cache entries, contain platform views or
+  // read back from the surface are always prerolled, since their preroll
+  // also updates the raster cache or the view embedder each frame.
+  void PrerollOrReuse(PrerollContext* context);
+
   // Used during Preroll by layers that employ a saveLayer to manage the
   // PrerollContext settings with values affected by the saveLayer mechanism.
   // This object must be created before calling Preroll on the children to
@@ -268,6 +303,16 @@ class Layer {
   uint64_t original_layer_id_;
   bool subtree_has_platform_view_ = false;
 
+  // The inputs and results of the last preroll, if it can be reused.
+  struct PrerollResults {
+    SkM44 transform;
+    SkRect cull_rect;
+    bool has_raster_cache;
+    int renderable_state_flags;
+    bool has_texture_layer;
+  };
+  std::optional<PrerollResults> last_preroll_;
+
   static uint64_t NextUniqueID();
 
   FML_DISALLOW_COPY_AND_ASSIGN(Layer);
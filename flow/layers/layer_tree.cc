@@ -62,6 +62,8 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       .ui_time                       = frame.context().ui_time(),
       .texture_registry              = frame.context().texture_registry(),
       .raster_cached_entries         = &raster_cache_items_,
+      .worker_task_runner            = frame.context().worker_task_runner(),
+      .reuse_retained_prerolls       = true,
       // clang-format on
   };
 
@@ -142,6 +144,7 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
       .enable_leaf_layer_tracing     = enable_leaf_layer_tracing_,
       .impeller_enabled              = !!frame.aiks_context(),
       .aiks_context                  = frame.aiks_context(),
+      .worker_task_runner            = frame.context().worker_task_runner(),
       // clang-format on
   };
 
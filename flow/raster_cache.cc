@@ -4,10 +4,13 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <mutex>
 #include <vector>
 
 #include "flutter/common/constants.h"
+#include "flutter/display_list/dl_builder.h"
 #include "flutter/display_list/skia/dl_sk_dispatcher.h"
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/layer.h"
@@ -22,6 +25,12 @@
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/skia/include/gpu/ganesh/SkSurfaceGanesh.h"
 
+#if IMPELLER_SUPPORTS_RENDERING
+#include "flutter/impeller/aiks/aiks_context.h"              // nogncheck
+#include "flutter/impeller/display_list/dl_dispatcher.h"     // nogncheck
+#include "flutter/impeller/display_list/dl_image_impeller.h"  // nogncheck
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 namespace flutter {
 
 RasterCacheResult::RasterCacheResult(sk_sp<DlImage> image,
@@ -69,9 +78,11 @@ void RasterCacheResult::draw(DlCanvas& canvas,
 }
 
 RasterCache::RasterCache(size_t access_threshold,
-                         size_t display_list_cache_limit_per_frame)
+                         size_t display_list_cache_limit_per_frame,
+                         size_t cache_byte_budget)
     : access_threshold_(access_threshold),
-      display_list_cache_limit_per_frame_(display_list_cache_limit_per_frame) {}
+      display_list_cache_limit_per_frame_(display_list_cache_limit_per_frame),
+      cache_byte_budget_(cache_byte_budget) {}
 
 /// @note Procedure doesn't copy all closures.
 std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
@@ -84,6 +95,13 @@ std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
   SkRect dest_rect =
       RasterCacheUtil::GetRoundedOutDeviceBounds(context.logical_rect, matrix);
 
+#if IMPELLER_SUPPORTS_RENDERING
+  if (context.aiks_context) {
+    return RasterizeImpeller(context, std::move(rtree), dest_rect, matrix,
+                             draw_function, draw_checkerboard);
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
   const SkImageInfo image_info = SkImageInfo::MakeN32Premul(
       dest_rect.width(), dest_rect.height(), context.dst_color_space);
 
@@ -113,6 +131,44 @@ std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
       image, context.logical_rect, context.flow_type, std::move(rtree));
 }
 
+#if IMPELLER_SUPPORTS_RENDERING
+std::unique_ptr<RasterCacheResult> RasterCache::RasterizeImpeller(
+    const RasterCache::Context& context,
+    sk_sp<const DlRTree> rtree,
+    const SkRect& dest_rect,
+    const SkMatrix& matrix,
+    const std::function<void(DlCanvas*)>& draw_function,
+    const std::function<void(DlCanvas*, const SkRect& rect)>& draw_checkerboard)
+    const {
+  // Record the content and render it with Impeller into a texture of its own.
+  // Cached images outlive the frame, so unlike offscreen passes they can't be
+  // allocated from the per-frame render target cache.
+  DisplayListBuilder builder(SkRect::MakeWH(dest_rect.width(),
+                                            dest_rect.height()));
+  builder.Translate(-dest_rect.left(), -dest_rect.top());
+  builder.Transform(matrix);
+  draw_function(&builder);
+
+  if (checkerboard_images_) {
+    draw_checkerboard(&builder, context.logical_rect);
+  }
+
+  impeller::DlDispatcher dispatcher;
+  builder.Build()->Dispatch(dispatcher);
+  impeller::Picture picture = dispatcher.EndRecordingAsPicture();
+  std::shared_ptr<impeller::Image> image = picture.ToImage(
+      *context.aiks_context,
+      impeller::ISize(dest_rect.width(), dest_rect.height()));
+  if (!image) {
+    return nullptr;
+  }
+  return std::make_unique<RasterCacheResult>(
+      impeller::DlImageImpeller::Make(image->GetTexture(),
+                                      DlImage::OwningContext::kRaster),
+      context.logical_rect, context.flow_type, std::move(rtree));
+}
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 bool RasterCache::UpdateCacheEntry(
     const RasterCacheKeyID& id,
     const Context& raster_cache_context,
@@ -133,15 +189,88 @@ bool RasterCache::UpdateCacheEntry(
         default:
           break;
       }
-      return true;
+      UpdatePriority(key, entry);
+      EnforceByteBudget();
+      // The new image may have been the cheapest one to evict.
+      auto it = cache_.find(key);
+      return it != cache_.end() && it->second.image != nullptr;
     }
   }
   return entry.image != nullptr;
 }
 
+void RasterCache::RecordDrawCost(const RasterCacheKeyID& id,
+                                 fml::TimeDelta cost) const {
+  std::scoped_lock lock(mutex_);
+  auto [it, inserted] = draw_costs_.try_emplace(id, DrawCost{.cost = cost});
+  DrawCost& draw_cost = it->second;
+  if (!inserted) {
+    // Smooth out the measurements, drawing times vary a lot from frame to
+    // frame.
+    draw_cost.cost = (draw_cost.cost * 3 + cost) / 4;
+  }
+  draw_cost.used_this_frame = true;
+}
+
+std::optional<fml::TimeDelta> RasterCache::GetDrawCost(
+    const RasterCacheKeyID& id) const {
+  std::scoped_lock lock(mutex_);
+  auto it = draw_costs_.find(id);
+  if (it == draw_costs_.end()) {
+    return std::nullopt;
+  }
+  it->second.used_this_frame = true;
+  return it->second.cost;
+}
+
+void RasterCache::UpdatePriority(const RasterCacheKey& key,
+                                 Entry& entry) const {
+  if (!entry.image) {
+    return;
+  }
+  // Content that was never measured, such as layers, costs as much as the
+  // cheapest content worth caching.
+  double cost_micros = RasterCacheUtil::kMinimumDrawCostToCacheMicros;
+  auto it = draw_costs_.find(key.id());
+  if (it != draw_costs_.end()) {
+    cost_micros = std::max(it->second.cost.ToMicrosecondsF(), 1.0);
+  }
+  double bytes = std::max<int64_t>(entry.image->image_bytes(), 1);
+  entry.priority = priority_inflation_ + cost_micros / bytes;
+}
+
+void RasterCache::EnforceByteBudget() const {
+  size_t cache_bytes = 0;
+  for (const auto& item : cache_) {
+    if (item.second.image) {
+      cache_bytes += item.second.image->image_bytes();
+    }
+  }
+  while (cache_bytes > cache_byte_budget_) {
+    auto victim = cache_.end();
+    for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+      if (it->second.image && (victim == cache_.end() ||
+                               it->second.priority < victim->second.priority)) {
+        victim = it;
+      }
+    }
+    if (victim == cache_.end()) {
+      break;
+    }
+    priority_inflation_ = victim->second.priority;
+    size_t bytes = victim->second.image->image_bytes();
+    cache_bytes -= bytes;
+    // Keep the entry so that its access count isn't lost.
+    victim->second.image.reset();
+    budget_eviction_count_++;
+    budget_eviction_bytes_ += bytes;
+  }
+}
+
 RasterCache::CacheInfo RasterCache::MarkSeen(const RasterCacheKeyID& id,
                                              const SkMatrix& matrix,
                                              bool visible) const {
+  std::scoped_lock lock(mutex_);
   RasterCacheKey key = RasterCacheKey(id, matrix);
   Entry& entry = cache_[key];
   entry.encountered_this_frame = true;
@@ -154,6 +283,7 @@ RasterCache::CacheInfo RasterCache::MarkSeen(const RasterCacheKeyID& id,
 
 int RasterCache::GetAccessCount(const RasterCacheKeyID& id,
                                 const SkMatrix& matrix) const {
+  std::scoped_lock lock(mutex_);
   RasterCacheKey key = RasterCacheKey(id, matrix);
   auto entry = cache_.find(key);
   if (entry != cache_.cend()) {
@@ -164,6 +294,7 @@ int RasterCache::GetAccessCount(const RasterCacheKeyID& id,
 
 bool RasterCache::HasEntry(const RasterCacheKeyID& id,
                            const SkMatrix& matrix) const {
+  std::scoped_lock lock(mutex_);
   RasterCacheKey key = RasterCacheKey(id, matrix);
   if (cache_.find(key) != cache_.cend()) {
     return true;
@@ -175,6 +306,7 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
                        DlCanvas& canvas,
                        const DlPaint* paint,
                        bool preserve_rtree) const {
+  std::scoped_lock lock(mutex_);
   auto it = cache_.find(RasterCacheKey(id, canvas.GetTransform()));
   if (it == cache_.end()) {
     return false;
@@ -184,6 +316,7 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
 
   if (entry.image) {
     entry.image->draw(canvas, paint, preserve_rtree);
+    UpdatePriority(it->first, entry);
     return true;
   }
 
@@ -192,6 +325,8 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
 
 void RasterCache::BeginFrame() {
   display_list_cached_this_frame_ = 0;
+  budget_eviction_count_ = 0;
+  budget_eviction_bytes_ = 0;
   picture_metrics_ = {};
   layer_metrics_ = {};
 }
@@ -227,6 +362,15 @@ void RasterCache::EvictUnusedCacheEntries() {
     }
     cache_.erase(it);
   }
+
+  for (auto it = draw_costs_.begin(); it != draw_costs_.end();) {
+    if (it->second.used_this_frame) {
+      it->second.used_this_frame = false;
+      ++it;
+    } else {
+      it = draw_costs_.erase(it);
+    }
+  }
 }
 
 void RasterCache::EndFrame() {
@@ -236,6 +380,8 @@ void RasterCache::EndFrame() {
 
 void RasterCache::Clear() {
   cache_.clear();
+  draw_costs_.clear();
+  priority_inflation_ = 0.0;
   picture_metrics_ = {};
   layer_metrics_ = {};
 }
@@ -284,7 +430,9 @@ void RasterCache::TraceStatsToTimeline() const {
       "LayerCount", layer_metrics_.total_count(),                          //
       "LayerMBytes", layer_metrics_.total_bytes() / kMegaByteSizeInBytes,  //
       "PictureCount", picture_metrics_.total_count(),                      //
-      "PictureMBytes", picture_metrics_.total_bytes() / kMegaByteSizeInBytes);
+      "PictureMBytes", picture_metrics_.total_bytes() / kMegaByteSizeInBytes,
+      "BudgetEvictionCount", budget_eviction_count_,                       //
+      "BudgetEvictionMBytes", budget_eviction_bytes_ / kMegaByteSizeInBytes);
 
 #endif  // !FLUTTER_RELEASE
 }
@@ -6,6 +6,8 @@
 #define FLUTTER_FLOW_RASTER_CACHE_H_
 
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <unordered_map>
 
 #include "flutter/display_list/dl_canvas.h"
@@ -13,6 +15,7 @@
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkRect.h"
@@ -20,6 +23,10 @@
 class GrDirectContext;
 class SkColorSpace;
 
+namespace impeller {
+class AiksContext;
+}  // namespace impeller
+
 namespace flutter {
 
 enum class RasterCacheLayerStrategy { kLayer, kLayerChildren };
@@ -121,6 +128,9 @@ class RasterCache {
     const SkMatrix& matrix;
     const SkRect& logical_rect;
     const char* flow_type;
+    // When set, entries are rasterized into Impeller textures instead of Skia
+    // surfaces.
+    impeller::AiksContext* aiks_context = nullptr;
   };
   struct CacheInfo {
     const size_t accesses_since_visible;
@@ -137,7 +147,8 @@ class RasterCache {
   explicit RasterCache(
       size_t access_threshold = 3,
       size_t picture_and_display_list_cache_limit_per_frame =
-          RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame);
+          RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame,
+      size_t cache_byte_budget = RasterCacheUtil::kDefaultCacheByteBudget);
 
   virtual ~RasterCache() = default;
 
@@ -215,6 +226,14 @@ class RasterCache {
    */
   size_t access_threshold() const { return access_threshold_; }
 
+  /**
+   * @brief Change the number of frames that a picture must be prepared
+   * before it will be cached, for the entries touched from now on.
+   */
+  void set_access_threshold(size_t access_threshold) {
+    access_threshold_ = access_threshold;
+  }
+
   bool GenerateNewCacheInThisFrame() const {
     // Disabling caching when access_threshold is zero is historic behavior.
     return access_threshold_ != 0 && display_list_cached_this_frame_ <
@@ -246,25 +265,91 @@ class RasterCache {
                         const std::function<void(DlCanvas*)>& render_function,
                         sk_sp<const DlRTree> rtree = nullptr) const;
 
+  /**
+   * @brief Records how long it took to draw the content identified by |id|
+   * without the cache. The measured costs drive which entries are worth
+   * caching and which cached images are evicted first when the cache is over
+   * its byte budget.
+   *
+   * Costs are kept as long as the content is drawn or looked up every frame.
+   */
+  void RecordDrawCost(const RasterCacheKeyID& id, fml::TimeDelta cost) const;
+
+  /**
+   * Returns the smoothed cost of drawing the content identified by |id|
+   * without the cache, if it was ever measured.
+   */
+  std::optional<fml::TimeDelta> GetDrawCost(const RasterCacheKeyID& id) const;
+
+  size_t cache_byte_budget() const { return cache_byte_budget_; }
+
  private:
   struct Entry {
     bool encountered_this_frame = false;
     bool visible_this_frame = false;
     size_t accesses_since_visible = 0;
+    // The GreedyDual-Size priority of the image. Images with the lowest
+    // priority are evicted first when the cache is over its byte budget.
+    double priority = 0.0;
     std::unique_ptr<RasterCacheResult> image;
   };
 
+  struct DrawCost {
+    fml::TimeDelta cost;
+    bool used_this_frame = true;
+  };
+
+  struct KeyIDHash {
+    std::size_t operator()(const RasterCacheKeyID& id) const {
+      return id.GetHash();
+    }
+  };
+
   void UpdateMetrics();
 
+#if IMPELLER_SUPPORTS_RENDERING
+  std::unique_ptr<RasterCacheResult> RasterizeImpeller(
+      const RasterCache::Context& context,
+      sk_sp<const DlRTree> rtree,
+      const SkRect& dest_rect,
+      const SkMatrix& matrix,
+      const std::function<void(DlCanvas*)>& draw_function,
+      const std::function<void(DlCanvas*, const SkRect& rect)>&
+          draw_checkerboard) const;
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+  // Evicts the cached images with the lowest priority until the cache fits
+  // its byte budget.
+  void EnforceByteBudget() const;
+
+  // Refreshes the GreedyDual-Size priority of an entry whose image was just
+  // created or drawn. Images that are expensive to draw relative to their
+  // size stay longer in the cache.
+  void UpdatePriority(const RasterCacheKey& key, Entry& entry) const;
+
   RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind);
 
-  const size_t access_threshold_;
+  size_t access_threshold_;
   const size_t display_list_cache_limit_per_frame_;
+  const size_t cache_byte_budget_;
   mutable size_t display_list_cached_this_frame_ = 0;
+  // The priority of the last image evicted for the byte budget. It is added
+  // to the priority of images when they are used so that images that haven't
+  // been used for a long time eventually get evicted.
+  mutable double priority_inflation_ = 0.0;
+  mutable size_t budget_eviction_count_ = 0;
+  mutable size_t budget_eviction_bytes_ = 0;
   RasterCacheMetrics layer_metrics_;
   RasterCacheMetrics picture_metrics_;
   mutable RasterCacheKey::Map<Entry> cache_;
+  mutable std::unordered_map<RasterCacheKeyID, DrawCost, KeyIDHash>
+      draw_costs_;
   bool checkerboard_images_ = false;
+  // Guards the entries and draw costs that are looked up and updated by
+  // layers prerolled or painted on worker threads. Frame level operations,
+  // such as preparing entries and evicting them, run on the raster thread
+  // while no layers are being traversed.
+  mutable std::mutex mutex_;
 
   void TraceStatsToTimeline() const;
 
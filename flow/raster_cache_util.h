@@ -19,6 +19,16 @@ struct RasterCacheUtil {
   // the work across multiple frames.
   static constexpr int kDefaultPictureAndDisplayListCacheLimitPerFrame = 3;
 
+  // The default max number of bytes of cached images. When the cache grows
+  // larger, the images that are the cheapest to draw per byte and that were
+  // used the longest time ago are evicted first.
+  static constexpr size_t kDefaultCacheByteBudget = 128 * (1 << 20);
+
+  // Display lists that took at least this long to draw the last times they
+  // were drawn without the cache are worth caching, regardless of their
+  // estimated complexity.
+  static constexpr int64_t kMinimumDrawCostToCacheMicros = 100;
+
   // The ImageFilterLayer might cache the filtered output of this layer
   // if the layer remains stable (if it is not animating for instance).
   // If the ImageFilterLayer is not the same between rendered frames,
@@ -107,6 +107,8 @@ class MockLayer : public Layer {
     expected_paint_matrix_ = matrix;
   }
 
+  int preroll_count() const { return preroll_count_; }
+
  private:
   MutatorsStack parent_mutators_;
   SkMatrix parent_matrix_;
@@ -123,6 +125,7 @@ class MockLayer : public Layer {
   static constexpr int kFakeHasTextureLayer = 1 << 5;
 
   int mock_flags_ = 0;
+  int preroll_count_ = 0;
 
   FML_DISALLOW_COPY_AND_ASSIGN(MockLayer);
 };
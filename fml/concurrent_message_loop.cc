@@ -13,11 +13,15 @@ namespace fml {
 
 ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
     : worker_count_(std::max<size_t>(worker_count, 1ul)) {
+  for (size_t i = 0; i < worker_count_; ++i) {
+    worker_queues_.emplace_back(std::make_unique<WorkerQueue>());
+  }
+
   for (size_t i = 0; i < worker_count_; ++i) {
     workers_.emplace_back([i, this]() {
       fml::Thread::SetCurrentThreadName(fml::Thread::ThreadConfig(
           std::string{"io.worker." + std::to_string(i + 1)}));
-      WorkerMain();
+      WorkerMain(i);
     });
   }
 
@@ -42,77 +46,133 @@ std::shared_ptr<ConcurrentTaskRunner> ConcurrentMessageLoop::GetTaskRunner() {
   return std::make_shared<ConcurrentTaskRunner>(weak_from_this());
 }
 
-void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
+void ConcurrentMessageLoop::PostTask(fml::TaskClosure task,
+                                     ConcurrentTaskPriority priority) {
   if (!task) {
     return;
   }
 
-  std::unique_lock lock(tasks_mutex_);
-
   // Don't just drop tasks on the floor in case of shutdown.
   if (shutdown_) {
     FML_DLOG(WARNING)
         << "Tried to post a task to shutdown concurrent message "
            "loop. The task will be executed on the callers thread.";
-    lock.unlock();
     ExecuteTask(task);
     return;
   }
 
-  tasks_.push(task);
-
-  // Unlock the mutex before notifying the condition variable because that mutex
-  // has to be acquired on the other thread anyway. Waiting in this scope till
-  // it is acquired there is a pessimization.
-  lock.unlock();
+  // Tasks posted by a worker stay on it, which keeps the tasks split off a
+  // job together. Other threads hand out their tasks to the workers in turns.
+  size_t worker_index = GetCurrentWorkerIndex();
+  if (worker_index == worker_count_) {
+    worker_index = next_worker_queue_.fetch_add(1u) % worker_count_;
+  }
+  {
+    auto& queue = *worker_queues_[worker_index];
+    std::scoped_lock lock(queue.mutex);
+    queue.tasks[static_cast<size_t>(priority)].push_back({
+        .closure = std::move(task),
+        .priority = priority,
+        .post_time = fml::TimePoint::Now(),
+    });
+  }
+  pending_task_count_++;
 
-  tasks_condition_.notify_one();
+  // A worker that is about to wait counts itself as idle before checking for
+  // pending tasks, so either it sees this task or it is woken up here.
+  if (idle_worker_count_ > 0u) {
+    {
+      std::scoped_lock lock(tasks_mutex_);
+    }
+    tasks_condition_.notify_one();
+  }
 }
 
-void ConcurrentMessageLoop::WorkerMain() {
-  while (true) {
-    std::unique_lock lock(tasks_mutex_);
-    tasks_condition_.wait(lock, [&]() {
-      return !tasks_.empty() || shutdown_ || HasThreadTasksLocked();
-    });
-
-    // Shutdown cannot be read with the task mutex unlocked.
-    bool shutdown_now = shutdown_;
-    fml::closure task;
-    std::vector<fml::closure> thread_tasks;
+size_t ConcurrentMessageLoop::GetCurrentWorkerIndex() const {
+  const auto thread_id = std::this_thread::get_id();
+  for (size_t i = 0; i < worker_thread_ids_.size(); i++) {
+    if (worker_thread_ids_[i] == thread_id) {
+      return i;
+    }
+  }
+  return worker_count_;
+}
 
-    if (!tasks_.empty()) {
-      task = tasks_.front();
-      tasks_.pop();
+bool ConcurrentMessageLoop::PopTask(size_t worker_index, Task& task) {
+  for (size_t priority = 0; priority < kPriorityCount; priority++) {
+    for (size_t i = 0; i < worker_count_; i++) {
+      auto& queue = *worker_queues_[(worker_index + i) % worker_count_];
+      std::scoped_lock lock(queue.mutex);
+      auto& tasks = queue.tasks[priority];
+      if (!tasks.empty()) {
+        task = std::move(tasks.front());
+        tasks.pop_front();
+        pending_task_count_--;
+        return true;
+      }
     }
+  }
+  return false;
+}
 
+void ConcurrentMessageLoop::RunTask(const Task& task) {
+#if !FLUTTER_RELEASE
+  static constexpr const char* kLatencyNames[kPriorityCount] = {
+      "HighPriorityLatencyMicros",
+      "NormalPriorityLatencyMicros",
+      "BackgroundPriorityLatencyMicros",
+  };
+  FML_TRACE_COUNTER("flutter", "ConcurrentTaskLatency",
+                    reinterpret_cast<int64_t>(this),
+                    kLatencyNames[static_cast<size_t>(task.priority)],
+                    (fml::TimePoint::Now() - task.post_time).ToMicroseconds());
+#endif  // !FLUTTER_RELEASE
+  ExecuteTask(task.closure);
+}
+
+void ConcurrentMessageLoop::RunThreadTasks() {
+  std::vector<fml::closure> thread_tasks;
+  {
+    std::scoped_lock lock(tasks_mutex_);
     if (HasThreadTasksLocked()) {
       thread_tasks = GetThreadTasksLocked();
       FML_DCHECK(!HasThreadTasksLocked());
     }
+    has_thread_tasks_ = !thread_tasks_.empty();
+  }
+  for (auto& thread_task : thread_tasks) {
+    ExecuteTask(std::move(thread_task));
+  }
+}
 
-    // Don't hold onto the mutex while tasks are being executed as they could
-    // themselves try to post more tasks to the message loop.
-    lock.unlock();
-
-    TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
-    // Execute the primary task we woke up for.
-    if (task) {
-      ExecuteTask(task);
+void ConcurrentMessageLoop::WorkerMain(size_t worker_index) {
+  while (!shutdown_) {
+    if (has_thread_tasks_) {
+      RunThreadTasks();
     }
 
-    // Execute any thread tasks.
-    for (const auto& thread_task : thread_tasks) {
-      ExecuteTask(thread_task);
+    Task task;
+    if (PopTask(worker_index, task)) {
+      RunTask(task);
+      continue;
     }
 
-    if (shutdown_now) {
-      break;
-    }
+    std::unique_lock lock(tasks_mutex_);
+    idle_worker_count_++;
+    tasks_condition_.wait(lock, [&]() {
+      return pending_task_count_ > 0 || shutdown_ || HasThreadTasksLocked();
+    });
+    idle_worker_count_--;
+    lock.unlock();
+
+    TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
   }
+
+  // Thread tasks posted before the shutdown still run, as they used to.
+  RunThreadTasks();
 }
 
-void ConcurrentMessageLoop::ExecuteTask(const fml::closure& task) {
+void ConcurrentMessageLoop::ExecuteTask(const fml::TaskClosure& task) {
   task();
 }
 
@@ -131,6 +191,7 @@ void ConcurrentMessageLoop::PostTaskToAllWorkers(const fml::closure& task) {
   for (const auto& worker_thread_id : worker_thread_ids_) {
     thread_tasks_[worker_thread_id].emplace_back(task);
   }
+  has_thread_tasks_ = true;
   tasks_condition_.notify_all();
 }
 
@@ -153,13 +214,18 @@ ConcurrentTaskRunner::ConcurrentTaskRunner(
 
 ConcurrentTaskRunner::~ConcurrentTaskRunner() = default;
 
-void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
+void ConcurrentTaskRunner::PostTask(fml::TaskClosure task) {
+  PostTask(std::move(task), ConcurrentTaskPriority::kNormal);
+}
+
+void ConcurrentTaskRunner::PostTask(fml::TaskClosure task,
+                                    ConcurrentTaskPriority priority) {
   if (!task) {
     return;
   }
 
   if (auto loop = weak_loop_.lock()) {
-    loop->PostTask(task);
+    loop->PostTask(std::move(task), priority);
     return;
   }
 
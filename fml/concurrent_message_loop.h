@@ -5,19 +5,38 @@
 #ifndef FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 #define FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <map>
-#include <queue>
+#include <memory>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/task_closure.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_point.h"
 
 namespace fml {
 
 class ConcurrentTaskRunner;
 
+/// The priority of a task posted to a |ConcurrentMessageLoop|. Workers always
+/// pick the most urgent pending task so that short tasks other threads are
+/// waiting on don't queue up behind long running ones.
+enum class ConcurrentTaskPriority {
+  /// Tasks that another thread is blocked on, such as the parts a frame is
+  /// split into to be rendered on multiple threads.
+  kHigh,
+  /// The default, such as image decoding or compiling a pipeline on demand.
+  kNormal,
+  /// Tasks whose results aren't needed soon, such as prewarming a cache or
+  /// writing it to disk.
+  kBackground,
+};
+
 class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
@@ -38,23 +57,58 @@ class ConcurrentMessageLoop
 
  protected:
   explicit ConcurrentMessageLoop(size_t worker_count);
-  virtual void ExecuteTask(const fml::closure& task);
+  virtual void ExecuteTask(const fml::TaskClosure& task);
 
  private:
   friend ConcurrentTaskRunner;
 
+  static constexpr size_t kPriorityCount = 3u;
+
+  struct Task {
+    fml::TaskClosure closure;
+    ConcurrentTaskPriority priority = ConcurrentTaskPriority::kNormal;
+    fml::TimePoint post_time;
+  };
+
+  // The tasks posted to one worker, either by tasks running on it or by other
+  // threads in turns. Workers without tasks of their own take the tasks of
+  // the others.
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks[kPriorityCount];
+  };
+
   size_t worker_count_ = 0;
   std::vector<std::thread> workers_;
+  std::vector<std::unique_ptr<WorkerQueue>> worker_queues_;
+  std::atomic<size_t> next_worker_queue_ = 0u;
+  // The number of tasks in the worker queues. It may briefly be off by the
+  // tasks being pushed or popped.
+  std::atomic<int64_t> pending_task_count_ = 0;
+  // The number of workers waiting on |tasks_condition_|. Posting a task only
+  // takes |tasks_mutex_| to wake one of them up.
+  std::atomic<size_t> idle_worker_count_ = 0u;
   std::mutex tasks_mutex_;
   std::condition_variable tasks_condition_;
-  std::queue<fml::closure> tasks_;
   std::vector<std::thread::id> worker_thread_ids_;
   std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
-  bool shutdown_ = false;
+  std::atomic<bool> has_thread_tasks_ = false;
+  std::atomic<bool> shutdown_ = false;
 
-  void WorkerMain();
+  void WorkerMain(size_t worker_index);
 
-  void PostTask(const fml::closure& task);
+  void PostTask(fml::TaskClosure task, ConcurrentTaskPriority priority);
+
+  // Returns |worker_count_| if the current thread isn't one of the workers.
+  size_t GetCurrentWorkerIndex() const;
+
+  // Pops the oldest task with the highest priority, preferring the tasks of
+  // the given worker over the ones of the other workers.
+  bool PopTask(size_t worker_index, Task& task);
+
+  void RunTask(const Task& task);
+
+  void RunThreadTasks();
 
   bool HasThreadTasksLocked() const;
 
@@ -69,7 +123,10 @@ class ConcurrentTaskRunner : public BasicTaskRunner {
 
   virtual ~ConcurrentTaskRunner();
 
-  void PostTask(const fml::closure& task) override;
+  // Posts a task with |ConcurrentTaskPriority::kNormal|.
+  void PostTask(fml::TaskClosure task) override;
+
+  void PostTask(fml::TaskClosure task, ConcurrentTaskPriority priority);
 
  private:
   friend ConcurrentMessageLoop;
@@ -7,7 +7,7 @@
 
 #include <queue>
 
-#include "flutter/fml/closure.h"
+#include "flutter/fml/task_closure.h"
 #include "flutter/fml/task_source_grade.h"
 #include "flutter/fml/time/time_point.h"
 
@@ -16,15 +16,23 @@ namespace fml {
 class DelayedTask {
  public:
   DelayedTask(size_t order,
-              const fml::closure& task,
+              fml::TaskClosure task,
               fml::TimePoint target_time,
               fml::TaskSourceGrade task_source_grade);
 
-  DelayedTask(const DelayedTask& other);
+  // Tasks are moved rather than copied as the heaps are reordered, since
+  // copying a closure copies its captures, such as weak pointers whose
+  // reference counts are shared with other threads.
+  DelayedTask(DelayedTask&& other);
+
+  DelayedTask& operator=(DelayedTask&& other);
 
   ~DelayedTask();
 
-  const fml::closure& GetTask() const;
+  const fml::TaskClosure& GetTask() const;
+
+  // Moves the closure out of this task, which must not be run afterwards.
+  fml::TaskClosure TakeTask();
 
   fml::TimePoint GetTargetTime() const;
 
@@ -34,7 +42,7 @@ class DelayedTask {
 
  private:
   size_t order_;
-  fml::closure task_;
+  fml::TaskClosure task_;
   fml::TimePoint target_time_;
   fml::TaskSourceGrade task_source_grade_;
 };
@@ -326,6 +326,37 @@ TEST(FileTest, MappingDontNeedSafeTest) {
   ASSERT_TRUE(fml::UnlinkFile(dir.fd(), "my_contents"));
 }
 
+TEST(FileTest, MappingAdviseAccessPatternTest) {
+  fml::ScopedTemporaryDirectory dir;
+
+  {
+    auto file = fml::OpenFile(dir.fd(), "my_contents", true,
+                              fml::FilePermission::kReadWrite);
+    WriteStringToFile(file, "some content");
+  }
+
+  {
+    auto file = fml::OpenFile(dir.fd(), "my_contents", false,
+                              fml::FilePermission::kRead);
+    fml::FileMapping mapping(file);
+    ASSERT_TRUE(mapping.IsValid());
+#if FML_OS_WIN
+    ASSERT_FALSE(mapping.AdviseAccessPattern(
+        fml::FileMapping::AccessPattern::kRandom));
+#else
+    ASSERT_TRUE(mapping.AdviseAccessPattern(
+        fml::FileMapping::AccessPattern::kRandom));
+    ASSERT_TRUE(mapping.AdviseAccessPattern(
+        fml::FileMapping::AccessPattern::kNormal));
+#endif  // FML_OS_WIN
+    // The contents are unchanged by the hints.
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                          mapping.GetSize()),
+              "some content");
+  }
+  ASSERT_TRUE(fml::UnlinkFile(dir.fd(), "my_contents"));
+}
+
 TEST(FileTest, FileTestsWork) {
   fml::ScopedTemporaryDirectory dir;
   ASSERT_TRUE(dir.fd().is_valid());
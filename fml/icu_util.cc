@@ -60,6 +60,10 @@ class ICUContext {
     auto file_mapping = std::make_unique<FileMapping>(fd, protection);
 
     if (file_mapping->GetSize() != 0) {
+      // ICU looks up individual items through the table of contents of the
+      // data file, and most apps only use a few of them. Disable readahead so
+      // that only the pages of the items that are looked up are read.
+      file_mapping->AdviseAccessPattern(FileMapping::AccessPattern::kRandom);
       mapping_ = std::move(file_mapping);
       return true;
     }
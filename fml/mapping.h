@@ -44,6 +44,12 @@ class FileMapping final : public Mapping {
     kExecute,
   };
 
+  enum class AccessPattern {
+    kNormal,
+    kRandom,
+    kSequential,
+  };
+
   explicit FileMapping(const fml::UniqueFD& fd,
                        std::initializer_list<Protection> protection = {
                            Protection::kRead});
@@ -76,6 +82,11 @@ class FileMapping final : public Mapping {
 
   bool IsValid() const;
 
+  // Hints to the kernel how the mapping will be accessed, for example to
+  // disable the readahead of pages around the ones that are touched. Returns
+  // false if the hint isn't supported on this platform.
+  bool AdviseAccessPattern(AccessPattern pattern) const;
+
  private:
   bool valid_ = false;
   size_t size_ = 0;
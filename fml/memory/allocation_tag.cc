@@ -0,0 +1,220 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/memory/allocation_tag.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+#include "flutter/fml/trace_event.h"
+
+namespace fml {
+
+const char* AllocationTagToString(AllocationTag tag) {
+  switch (tag) {
+    case AllocationTag::kUntagged:
+      return "Untagged";
+    case AllocationTag::kDisplayList:
+      return "DisplayList";
+    case AllocationTag::kImpellerEntity:
+      return "ImpellerEntity";
+    case AllocationTag::kTxt:
+      return "Txt";
+    case AllocationTag::kCodecs:
+      return "Codecs";
+    case AllocationTag::kPlatformMessages:
+      return "PlatformMessages";
+    case AllocationTag::kSemantics:
+      return "Semantics";
+    case AllocationTag::kCount:
+      break;
+  }
+  return "Unknown";
+}
+
+#if FLUTTER_ALLOCATION_TAGGING
+
+namespace {
+
+constexpr size_t kTagCount = static_cast<size_t>(AllocationTag::kCount);
+
+// The trace counter names, which must outlive the trace events.
+constexpr const char* kCounterNames[kTagCount] = {
+    "Allocations.Untagged",          //
+    "Allocations.DisplayList",       //
+    "Allocations.ImpellerEntity",    //
+    "Allocations.Txt",               //
+    "Allocations.Codecs",            //
+    "Allocations.PlatformMessages",  //
+    "Allocations.Semantics",         //
+};
+
+// Everything here is touched by every allocation of the process, so it only
+// uses lock-free atomics and nothing that could allocate itself.
+struct TagCounters {
+  std::atomic<size_t> allocation_count = 0;
+  std::atomic<size_t> allocated_bytes = 0;
+  std::atomic<size_t> free_count = 0;
+  std::atomic<size_t> freed_bytes = 0;
+  std::atomic<int64_t> freed_lifetime_micros = 0;
+  std::atomic<int64_t> live_bytes = 0;
+};
+
+TagCounters gCounters[kTagCount];
+
+thread_local AllocationTag tCurrentTag = AllocationTag::kUntagged;
+
+// Prepended to every allocation to find its tag, size and age when it is
+// freed. Its size keeps the returned pointer aligned like malloc's.
+struct alignas(std::max_align_t) AllocationHeader {
+  size_t size;
+  int64_t allocated_at_micros;
+  AllocationTag tag;
+};
+
+// Reads the clock directly rather than through |fml::TimePoint|, whose clock
+// source can be replaced by tests.
+int64_t NowMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void* TaggedAllocate(size_t size) {
+  auto* header =
+      static_cast<AllocationHeader*>(std::malloc(sizeof(AllocationHeader) +
+                                                 (size == 0 ? 1 : size)));
+  if (header == nullptr) {
+    return nullptr;
+  }
+  header->size = size;
+  header->allocated_at_micros = NowMicros();
+  header->tag = tCurrentTag;
+
+  TagCounters& counters = gCounters[static_cast<size_t>(header->tag)];
+  counters.allocation_count.fetch_add(1, std::memory_order_relaxed);
+  counters.allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  counters.live_bytes.fetch_add(size, std::memory_order_relaxed);
+  return header + 1;
+}
+
+void TaggedFree(void* pointer) {
+  if (pointer == nullptr) {
+    return;
+  }
+  auto* header = static_cast<AllocationHeader*>(pointer) - 1;
+
+  TagCounters& counters = gCounters[static_cast<size_t>(header->tag)];
+  counters.free_count.fetch_add(1, std::memory_order_relaxed);
+  counters.freed_bytes.fetch_add(header->size, std::memory_order_relaxed);
+  counters.freed_lifetime_micros.fetch_add(
+      NowMicros() - header->allocated_at_micros, std::memory_order_relaxed);
+  counters.live_bytes.fetch_sub(header->size, std::memory_order_relaxed);
+  std::free(header);
+}
+
+void* TaggedAllocateOrAbort(size_t size) {
+  void* pointer = TaggedAllocate(size);
+  if (pointer == nullptr) {
+    // The engine is built without exceptions, so there is no bad_alloc to
+    // throw.
+    std::abort();
+  }
+  return pointer;
+}
+
+}  // namespace
+
+ScopedAllocationTag::ScopedAllocationTag(AllocationTag tag)
+    : previous_(tCurrentTag) {
+  tCurrentTag = tag;
+}
+
+ScopedAllocationTag::~ScopedAllocationTag() {
+  tCurrentTag = previous_;
+}
+
+AllocationTagStats TakeAllocationTagStats(AllocationTag tag) {
+  TagCounters& counters = gCounters[static_cast<size_t>(tag)];
+  AllocationTagStats stats;
+  stats.allocation_count = counters.allocation_count.exchange(0);
+  stats.allocated_bytes = counters.allocated_bytes.exchange(0);
+  stats.free_count = counters.free_count.exchange(0);
+  stats.freed_bytes = counters.freed_bytes.exchange(0);
+  stats.freed_lifetime_micros = counters.freed_lifetime_micros.exchange(0);
+  stats.live_bytes = counters.live_bytes.load();
+  return stats;
+}
+
+void ReportAllocationTagStats() {
+  for (size_t i = 0; i < kTagCount; i++) {
+    const AllocationTagStats stats =
+        TakeAllocationTagStats(static_cast<AllocationTag>(i));
+    const int64_t average_lifetime_micros =
+        stats.free_count == 0
+            ? 0
+            : stats.freed_lifetime_micros /
+                  static_cast<int64_t>(stats.free_count);
+    FML_TRACE_COUNTER("flutter", kCounterNames[i], /*counter_id=*/0,
+                      "Allocations", stats.allocation_count,
+                      "AllocatedBytes", stats.allocated_bytes, "Frees",
+                      stats.free_count, "FreedBytes", stats.freed_bytes,
+                      "AverageLifetimeMicros", average_lifetime_micros,
+                      "LiveBytes", stats.live_bytes);
+  }
+}
+
+#endif  // FLUTTER_ALLOCATION_TAGGING
+
+}  // namespace fml
+
+#if FLUTTER_ALLOCATION_TAGGING
+
+// The replacements of the global allocation functions that keep the counts.
+// The over-aligned variants are left alone; they are rare in the engine and
+// are paired with their own deallocation functions.
+
+void* operator new(size_t size) {
+  return fml::TaggedAllocateOrAbort(size);
+}
+
+void* operator new[](size_t size) {
+  return fml::TaggedAllocateOrAbort(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return fml::TaggedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return fml::TaggedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+  fml::TaggedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  fml::TaggedFree(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+  fml::TaggedFree(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+  fml::TaggedFree(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+  fml::TaggedFree(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+  fml::TaggedFree(pointer);
+}
+
+#endif  // FLUTTER_ALLOCATION_TAGGING
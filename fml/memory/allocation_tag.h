@@ -0,0 +1,99 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_MEMORY_ALLOCATION_TAG_H_
+#define FLUTTER_FML_MEMORY_ALLOCATION_TAG_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      The engine subsystems that allocations can be attributed to.
+///
+enum class AllocationTag : uint8_t {
+  kUntagged,
+  kDisplayList,
+  kImpellerEntity,
+  kTxt,
+  kCodecs,
+  kPlatformMessages,
+  kSemantics,
+  kCount,
+};
+
+const char* AllocationTagToString(AllocationTag tag);
+
+//------------------------------------------------------------------------------
+/// @brief      What was allocated and freed under a tag since the last call to
+///             |TakeAllocationTagStats|.
+///
+///             Frees are attributed to the tag that was current when the
+///             memory was allocated, not when it was freed.
+///
+struct AllocationTagStats {
+  size_t allocation_count = 0;
+  size_t allocated_bytes = 0;
+  size_t free_count = 0;
+  size_t freed_bytes = 0;
+  // The sum of the lifetimes of the freed allocations.
+  int64_t freed_lifetime_micros = 0;
+  // What is still allocated under the tag. Not reset when taking the stats.
+  int64_t live_bytes = 0;
+};
+
+#if FLUTTER_ALLOCATION_TAGGING
+
+//------------------------------------------------------------------------------
+/// @brief      Attributes the allocations made on the current thread to a tag
+///             for as long as it is in scope. Scopes nest, the innermost one
+///             wins.
+///
+///             Only exists in builds with `flutter_enable_allocation_tagging`,
+///             which replace the global `operator new` and `operator delete`
+///             to keep the counts. Memory that is allocated with `malloc`
+///             directly, like most of Skia's, isn't counted. Use
+///             |FML_ALLOCATION_TAG| so the marker compiles away otherwise.
+///
+class ScopedAllocationTag {
+ public:
+  explicit ScopedAllocationTag(AllocationTag tag);
+
+  ~ScopedAllocationTag();
+
+ private:
+  const AllocationTag previous_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ScopedAllocationTag);
+};
+
+AllocationTagStats TakeAllocationTagStats(AllocationTag tag);
+
+//------------------------------------------------------------------------------
+/// @brief      Emits the stats of every tag as trace counters and resets them.
+///             Called once per frame by the rasterizer.
+///
+void ReportAllocationTagStats();
+
+#define FML_ALLOCATION_TAG(tag) \
+  ::fml::ScopedAllocationTag fml_allocation_tag(::fml::AllocationTag::tag)
+
+#else  // FLUTTER_ALLOCATION_TAGGING
+
+inline AllocationTagStats TakeAllocationTagStats(AllocationTag tag) {
+  return {};
+}
+
+inline void ReportAllocationTagStats() {}
+
+#define FML_ALLOCATION_TAG(tag) ((void)0)
+
+#endif  // FLUTTER_ALLOCATION_TAGGING
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_MEMORY_ALLOCATION_TAG_H_
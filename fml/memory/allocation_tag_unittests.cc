@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/memory/allocation_tag.h"
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(AllocationTagTest, NamesEveryTag) {
+  EXPECT_STREQ(AllocationTagToString(AllocationTag::kUntagged), "Untagged");
+  EXPECT_STREQ(AllocationTagToString(AllocationTag::kDisplayList),
+               "DisplayList");
+  EXPECT_STREQ(AllocationTagToString(AllocationTag::kSemantics), "Semantics");
+}
+
+#if FLUTTER_ALLOCATION_TAGGING
+
+// Keeps the compiler from eliding the allocations under test.
+char* volatile gSink = nullptr;
+
+TEST(AllocationTagTest, AttributesAllocationsToTheInnermostTag) {
+  TakeAllocationTagStats(AllocationTag::kTxt);
+  TakeAllocationTagStats(AllocationTag::kCodecs);
+  {
+    FML_ALLOCATION_TAG(kTxt);
+    gSink = new char[100];
+    {
+      FML_ALLOCATION_TAG(kCodecs);
+      delete[] gSink;
+      gSink = new char[50];
+    }
+  }
+  AllocationTagStats txt = TakeAllocationTagStats(AllocationTag::kTxt);
+  EXPECT_EQ(txt.allocation_count, 1u);
+  EXPECT_EQ(txt.allocated_bytes, 100u);
+  // The free is counted against the tag the memory was allocated with.
+  EXPECT_EQ(txt.free_count, 1u);
+  EXPECT_EQ(txt.freed_bytes, 100u);
+
+  AllocationTagStats codecs = TakeAllocationTagStats(AllocationTag::kCodecs);
+  EXPECT_EQ(codecs.allocation_count, 1u);
+  EXPECT_EQ(codecs.allocated_bytes, 50u);
+  EXPECT_EQ(codecs.free_count, 0u);
+
+  int64_t live_bytes = codecs.live_bytes;
+  delete[] gSink;
+  gSink = nullptr;
+  codecs = TakeAllocationTagStats(AllocationTag::kCodecs);
+  EXPECT_EQ(codecs.allocation_count, 0u);
+  EXPECT_EQ(codecs.live_bytes, live_bytes - 50);
+}
+
+#else  // FLUTTER_ALLOCATION_TAGGING
+
+TEST(AllocationTagTest, ReportsNothingWhenDisabled) {
+  FML_ALLOCATION_TAG(kTxt);
+  AllocationTagStats stats = TakeAllocationTagStats(AllocationTag::kTxt);
+  EXPECT_EQ(stats.allocation_count, 0u);
+  EXPECT_EQ(stats.live_bytes, 0);
+}
+
+#endif  // FLUTTER_ALLOCATION_TAGGING
+
+}  // namespace testing
+}  // namespace fml
@@ -95,13 +95,15 @@ class RefPtr final {
     }
   }
 
-  // Move constructor.
-  RefPtr(RefPtr<T>&& r) : ptr_(r.ptr_) {  // NOLINT(google-explicit-constructor)
-    r.ptr_ = nullptr;
-  }
+  // Move constructor. Moves are noexcept so that containers move rather than
+  // copy the pointers they hold as they grow, which would increment and
+  // decrement every reference count.
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  RefPtr(RefPtr<T>&& r) noexcept : ptr_(r.ptr_) { r.ptr_ = nullptr; }
 
   template <typename U>
-  RefPtr(RefPtr<U>&& r) : ptr_(r.ptr_) {  // NOLINT(google-explicit-constructor)
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  RefPtr(RefPtr<U>&& r) noexcept : ptr_(r.ptr_) {
     r.ptr_ = nullptr;
   }
 
@@ -161,18 +163,18 @@ class RefPtr final {
   // Move assignment.
   // Note: Like |std::shared_ptr|, we support self-move and move assignment is
   // equivalent to |RefPtr<T>(std::move(r)).swap(*this)|.
-  RefPtr<T>& operator=(RefPtr<T>&& r) {
+  RefPtr<T>& operator=(RefPtr<T>&& r) noexcept {
     RefPtr<T>(std::move(r)).swap(*this);
     return *this;
   }
 
   template <typename U>
-  RefPtr<T>& operator=(RefPtr<U>&& r) {
+  RefPtr<T>& operator=(RefPtr<U>&& r) noexcept {
     RefPtr<T>(std::move(r)).swap(*this);
     return *this;
   }
 
-  void swap(RefPtr<T>& r) {
+  void swap(RefPtr<T>& r) noexcept {
     T* p = ptr_;
     ptr_ = r.ptr_;
     r.ptr_ = p;
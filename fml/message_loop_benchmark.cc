@@ -0,0 +1,184 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include <algorithm>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/raster_thread_merger.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/thread.h"
+
+namespace fml {
+namespace benchmarking {
+
+namespace {
+
+// Stands in for the work of a small task, such as handling a platform
+// message, so that the benchmarks don't only measure the queues.
+void DoTaskWork() {
+  int value = 0;
+  for (int i = 0; i < 200; i++) {
+    benchmark::DoNotOptimize(value += i);
+  }
+}
+
+// Reports the median and the tail of |samples|, in microseconds.
+void ReportPercentiles(benchmark::State& state,
+                       std::vector<fml::TimeDelta>& samples) {
+  if (samples.empty()) {
+    return;
+  }
+  std::sort(samples.begin(), samples.end());
+  auto percentile = [&samples](double fraction) {
+    size_t index = static_cast<size_t>(fraction * (samples.size() - 1));
+    return static_cast<double>(samples[index].ToMicroseconds());
+  };
+  state.counters["p50_us"] = percentile(0.5);
+  state.counters["p90_us"] = percentile(0.9);
+  state.counters["p99_us"] = percentile(0.99);
+  state.counters["max_us"] = percentile(1.0);
+}
+
+}  // namespace
+
+// The time from posting a task from another thread to it starting to run,
+// which includes waking up the target thread. Its tail bounds how late a
+// frame can be scheduled across the UI and raster threads.
+static void BM_CrossThreadPostLatency(benchmark::State& state) {
+  fml::Thread thread("latency");
+  auto task_runner = thread.GetTaskRunner();
+  std::vector<fml::TimeDelta> samples;
+  fml::AutoResetWaitableEvent ran;
+  for (auto _ : state) {
+    const auto post_time = fml::TimePoint::Now();
+    fml::TimePoint run_time;
+    task_runner->PostTask([&run_time, &ran]() {
+      run_time = fml::TimePoint::Now();
+      ran.Signal();
+    });
+    ran.Wait();
+    const auto latency = run_time - post_time;
+    state.SetIterationTime(latency.ToSecondsF());
+    samples.push_back(latency);
+  }
+  ReportPercentiles(state, samples);
+}
+
+BENCHMARK(BM_CrossThreadPostLatency)->UseManualTime();
+
+// The number of tasks that the platform and raster threads run when they are
+// separate and when the raster thread is merged into the platform thread, as
+// it is while platform views are shown. The first argument is whether the
+// threads are merged.
+static void BM_PlatformAndRasterThroughput(benchmark::State& state) {
+  const bool merged = state.range(0) != 0;
+  constexpr size_t kTaskCount = 1000u;
+  fml::Thread platform_thread("platform");
+  fml::Thread raster_thread("raster");
+  auto platform_task_runner = platform_thread.GetTaskRunner();
+  auto raster_task_runner = raster_thread.GetTaskRunner();
+  auto merger = fml::MakeRefCounted<fml::RasterThreadMerger>(
+      platform_task_runner->GetTaskQueueId(),
+      raster_task_runner->GetTaskQueueId());
+  if (merged) {
+    merger->MergeWithLease(1);
+  }
+
+  for (auto _ : state) {
+    fml::CountDownLatch done(kTaskCount);
+    for (size_t i = 0; i < kTaskCount; i++) {
+      const auto& task_runner =
+          i % 2 == 0 ? platform_task_runner : raster_task_runner;
+      task_runner->PostTask([&done]() {
+        DoTaskWork();
+        done.CountDown();
+      });
+    }
+    done.Wait();
+  }
+  state.SetItemsProcessed(state.iterations() * kTaskCount);
+
+  if (merged) {
+    fml::AutoResetWaitableEvent unmerged;
+    raster_task_runner->PostTask([&merger, &unmerged]() {
+      merger->UnMergeNowIfLastOne();
+      unmerged.Signal();
+    });
+    unmerged.Wait();
+  }
+}
+
+BENCHMARK(BM_PlatformAndRasterThroughput)
+    ->ArgName("merged")
+    ->Arg(0)
+    ->Arg(1)
+    ->UseRealTime();
+
+// How late delayed tasks run, which is what animations and the batching of
+// frame timings rely on. The argument is the delay in milliseconds.
+static void BM_DelayedTaskLateness(benchmark::State& state) {
+  const auto delay = fml::TimeDelta::FromMilliseconds(state.range(0));
+  fml::Thread thread("delayed");
+  auto task_runner = thread.GetTaskRunner();
+  std::vector<fml::TimeDelta> samples;
+  fml::AutoResetWaitableEvent ran;
+  for (auto _ : state) {
+    const auto target_time = fml::TimePoint::Now() + delay;
+    fml::TimePoint run_time;
+    task_runner->PostTaskForTime(
+        [&run_time, &ran]() {
+          run_time = fml::TimePoint::Now();
+          ran.Signal();
+        },
+        target_time);
+    ran.Wait();
+    const auto lateness = run_time - target_time;
+    state.SetIterationTime(lateness.ToSecondsF());
+    samples.push_back(lateness);
+  }
+  ReportPercentiles(state, samples);
+}
+
+BENCHMARK(BM_DelayedTaskLateness)
+    ->ArgName("delay_ms")
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16)
+    ->Iterations(100)
+    ->UseManualTime();
+
+// The number of tasks a concurrent message loop runs as workers are added,
+// when a thread fans out many small tasks and waits for all of them, as the
+// raster thread does for parallel work. The argument is the worker count.
+static void BM_ConcurrentMessageLoopFanOut(benchmark::State& state) {
+  constexpr size_t kTaskCount = 1000u;
+  auto loop = fml::ConcurrentMessageLoop::Create(state.range(0));
+  auto task_runner = loop->GetTaskRunner();
+  for (auto _ : state) {
+    fml::CountDownLatch done(kTaskCount);
+    for (size_t i = 0; i < kTaskCount; i++) {
+      task_runner->PostTask([&done]() {
+        DoTaskWork();
+        done.CountDown();
+      });
+    }
+    done.Wait();
+  }
+  state.SetItemsProcessed(state.iterations() * kTaskCount);
+}
+
+BENCHMARK(BM_ConcurrentMessageLoopFanOut)
+    ->ArgName("workers")
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseRealTime();
+
+}  // namespace benchmarking
+}  // namespace fml
@@ -16,6 +16,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/synchronization/shared_mutex.h"
+#include "flutter/fml/task_closure.h"
 #include "flutter/fml/task_queue_id.h"
 #include "flutter/fml/task_source.h"
 #include "flutter/fml/wakeable.h"
@@ -46,6 +47,10 @@ class TaskQueueEntry {
 
   TaskQueueId created_for;
 
+  /// Guards the tasks and observers of this TaskQueue and of the TaskQueues
+  /// it owns. Only the mutex of a TaskQueue that isn't subsumed is used.
+  std::mutex tasks_mutex;
+
   explicit TaskQueueEntry(TaskQueueId created_for);
 
  private:
@@ -78,19 +83,26 @@ class MessageLoopTaskQueues {
   // Tasks methods.
 
   void RegisterTask(TaskQueueId queue_id,
-                    const fml::closure& task,
+                    fml::TaskClosure task,
                     fml::TimePoint target_time,
                     fml::TaskSourceGrade task_source_grade =
                         fml::TaskSourceGrade::kUnspecified);
 
   bool HasPendingTasks(TaskQueueId queue_id) const;
 
-  fml::closure GetNextTaskToRun(TaskQueueId queue_id, fml::TimePoint from_time);
+  fml::TaskClosure GetNextTaskToRun(TaskQueueId queue_id,
+                                    fml::TimePoint from_time);
 
   size_t GetNumPendingTasks(TaskQueueId queue_id) const;
 
   static TaskSourceGrade GetCurrentTaskSourceGrade();
 
+  /// Returns how long the tasks of the given grade registered with the queue
+  /// waited between their target time and the time they ran.
+  TaskQueueingDelayHistogram GetQueueingDelayHistogram(
+      TaskQueueId queue_id,
+      TaskSourceGrade grade) const;
+
   // Observers methods.
 
   void AddTaskObserver(TaskQueueId queue_id,
@@ -144,15 +156,34 @@ class MessageLoopTaskQueues {
 
   ~MessageLoopTaskQueues();
 
+  // Returns the mutex guarding the tasks of the queue, which is the one of its
+  // owner if the queue is subsumed.
+  std::mutex& GetTasksMutexUnlocked(TaskQueueId queue_id) const;
+
   void WakeUpUnlocked(TaskQueueId queue_id, fml::TimePoint time) const;
 
   bool HasPendingTasksUnlocked(TaskQueueId queue_id) const;
 
   TaskSource::TopTask PeekNextTaskUnlocked(TaskQueueId owner) const;
 
+  // The task to run at |from_time|, which may not be the next task if that's
+  // a background task deferred by a task of another grade. See
+  // |TaskSource::Top|.
+  TaskSource::TopTask PeekTaskToRunUnlocked(TaskQueueId owner,
+                                            fml::TimePoint from_time) const;
+
   fml::TimePoint GetNextWakeTimeUnlocked(TaskQueueId queue_id) const;
 
-  mutable std::mutex queue_mutex_;
+  // Locking is split in two levels so that the loops of unrelated queues,
+  // such as the UI and IO threads, don't contend with each other:
+  //  - |queue_meta_mutex_| guards the set of queues and how they are merged.
+  //    Operations on tasks take it shared, while creating, disposing, merging
+  //    and unmerging queues take it exclusively.
+  //  - |TaskQueueEntry::tasks_mutex| of the owner of a set of merged queues,
+  //    or of a queue that isn't merged, guards their tasks and observers.
+  // Methods with the "Unlocked" suffix expect the caller to hold both locks,
+  // or |queue_meta_mutex_| exclusively.
+  std::unique_ptr<fml::SharedMutex> queue_meta_mutex_;
   std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
 
   size_t task_queue_id_counter_ = 0;
@@ -23,8 +23,9 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
     const int num_tasks_per_queue = 100;
     const fml::TimePoint past = fml::TimePoint::Now();
 
+    std::vector<TaskQueueId> queue_ids;
     for (int i = 0; i < num_task_queues; i++) {
-      task_queue->CreateTaskQueue();
+      queue_ids.push_back(task_queue->CreateTaskQueue());
     }
 
     std::vector<std::thread> threads;
@@ -34,18 +35,18 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
 
     threads.reserve(num_task_queues);
     for (int i = 0; i < num_task_queues; i++) {
-      threads.emplace_back([task_runner_id = i, &task_queue, past, &tasks_done,
-                            &tasks_registered]() {
+      threads.emplace_back([task_runner_id = queue_ids[i], &task_queue, past,
+                            &tasks_done, &tasks_registered]() {
         for (int j = 0; j < num_tasks_per_queue; j++) {
-          task_queue->RegisterTask(TaskQueueId(task_runner_id), [] {}, past);
+          task_queue->RegisterTask(task_runner_id, [] {}, past);
         }
         tasks_registered.CountDown();
         tasks_registered.Wait();
         const auto now = fml::TimePoint::Now();
         int num_invocations = 0;
         for (;;) {
-          fml::closure invocation =
-              task_queue->GetNextTaskToRun(TaskQueueId(task_runner_id), now);
+          fml::TaskClosure invocation =
+              task_queue->GetNextTaskToRun(task_runner_id, now);
           if (!invocation) {
             break;
           }
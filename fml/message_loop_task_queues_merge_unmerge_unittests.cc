@@ -33,7 +33,7 @@ static int CountRemainingTasks(fml::MessageLoopTaskQueues* task_queue,
                                bool run_invocation = false) {
   const auto now = ChronoTicksSinceEpoch();
   int count = 0;
-  fml::closure invocation;
+  fml::TaskClosure invocation;
   do {
     invocation = task_queue->GetNextTaskToRun(queue_id, now);
     if (!invocation) {
@@ -10,6 +10,7 @@
 #include <cstdlib>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -108,7 +109,7 @@ TEST(MessageLoopTaskQueue, PreserveTaskOrdering) {
   const auto now = ChronoTicksSinceEpoch();
   int expected_value = 1;
   while (true) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(queue_id, now);
+    fml::TaskClosure invocation = task_queue->GetNextTaskToRun(queue_id, now);
     if (!invocation) {
       break;
     }
@@ -148,7 +149,8 @@ TEST(MessageLoopTaskQueue, RegisterTasksOnMergedQueuesPreserveTaskOrdering) {
   // "test_val = 1" in platform_queue
   // "test_val = 2" in raster2_queue
   while (true) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(platform_queue, now);
+    fml::TaskClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
     if (!invocation) {
       break;
     }
@@ -191,7 +193,8 @@ TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   // "test_val = 1" in platform_queue
   // "test_val = 2" in raster_queue (running on platform)
   for (int i = 0; i < 3; i++) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(platform_queue, now);
+    fml::TaskClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == i);
@@ -210,7 +213,8 @@ TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   // platform_queue has 1 task left: "test_val = 4"
   {
     ASSERT_TRUE(task_queue->GetNumPendingTasks(platform_queue) == 1);
-    fml::closure invocation = task_queue->GetNextTaskToRun(platform_queue, now);
+    fml::TaskClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == 4);
@@ -220,14 +224,16 @@ TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   // raster_queue has 2 tasks left: "test_val = 3" and "test_val = 5"
   {
     ASSERT_TRUE(task_queue->GetNumPendingTasks(raster_queue) == 2);
-    fml::closure invocation = task_queue->GetNextTaskToRun(raster_queue, now);
+    fml::TaskClosure invocation =
+        task_queue->GetNextTaskToRun(raster_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == 3);
   }
   {
     ASSERT_TRUE(task_queue->GetNumPendingTasks(raster_queue) == 1);
-    fml::closure invocation = task_queue->GetNextTaskToRun(raster_queue, now);
+    fml::TaskClosure invocation =
+        task_queue->GetNextTaskToRun(raster_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == 5);
@@ -413,6 +419,42 @@ TEST(MessageLoopTaskQueue, ConcurrentQueueAndTaskCreatingCounts) {
   ASSERT_EQ(pending_tasks, kThreadCount * kThreadTaskCount);
 }
 
+TEST(MessageLoopTaskQueue, ConcurrentMergeAndRegisterTasks) {
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  auto platform_queue = task_queues->CreateTaskQueue();
+  auto raster_queue = task_queues->CreateTaskQueue();
+  // Posting to this queue is never blocked by the merges.
+  auto io_queue = task_queues->CreateTaskQueue();
+
+  constexpr size_t kThreadTaskCount = 500;
+  const std::vector<TaskQueueId> task_queue_ids = {platform_queue,
+                                                   raster_queue, io_queue};
+  std::vector<std::thread> threads;
+  for (const auto& queue_id : task_queue_ids) {
+    threads.emplace_back([&task_queues, queue_id]() {
+      for (size_t i = 0; i < kThreadTaskCount; i++) {
+        task_queues->RegisterTask(
+            queue_id, []() {}, ChronoTicksSinceEpoch());
+      }
+    });
+  }
+  for (size_t i = 0; i < 100; i++) {
+    ASSERT_TRUE(task_queues->Merge(platform_queue, raster_queue));
+    ASSERT_TRUE(task_queues->Unmerge(platform_queue, raster_queue));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& queue_id : task_queue_ids) {
+    ASSERT_EQ(task_queues->GetNumPendingTasks(queue_id), kThreadTaskCount);
+  }
+  task_queues->Merge(platform_queue, raster_queue);
+  ASSERT_EQ(task_queues->GetNumPendingTasks(platform_queue),
+            2 * kThreadTaskCount);
+  ASSERT_EQ(task_queues->GetNumPendingTasks(raster_queue), 0u);
+}
+
 TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
   auto platform_queue = task_queue->CreateTaskQueue();
@@ -451,5 +493,125 @@ TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   ASSERT_EQ(time1, wakes[2]);
 }
 
+
+TEST(MessageLoopTaskQueue, BackgroundTasksRunAfterReadyTasksOfOtherGrades) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto platform_queue = task_queue->CreateTaskQueue();
+  auto raster_queue = task_queue->CreateTaskQueue();
+  task_queue->Merge(platform_queue, raster_queue);
+  std::vector<int> order;
+
+  const auto time = ChronoTicksSinceEpoch();
+  task_queue->RegisterTask(
+      raster_queue, [&order]() { order.push_back(0); }, time,
+      fml::TaskSourceGrade::kBackground);
+  task_queue->RegisterTask(
+      platform_queue, [&order]() { order.push_back(1); },
+      time + fml::TimeDelta::FromMilliseconds(1));
+  task_queue->RegisterTask(
+      raster_queue, [&order]() { order.push_back(2); },
+      time + fml::TimeDelta::FromMilliseconds(2),
+      fml::TaskSourceGrade::kUserInteraction);
+
+  const auto now = time + fml::TimeDelta::FromMilliseconds(3);
+  while (fml::TaskClosure invocation =
+             task_queue->GetNextTaskToRun(platform_queue, now)) {
+    invocation();
+  }
+  ASSERT_EQ(order, std::vector<int>({1, 2, 0}));
+}
+
+TEST(MessageLoopTaskQueue, StarvedBackgroundTasksAreNotDeferred) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+  std::vector<int> order;
+
+  const auto time = ChronoTicksSinceEpoch();
+  task_queue->RegisterTask(
+      queue_id, [&order]() { order.push_back(0); }, time,
+      fml::TaskSourceGrade::kBackground);
+  task_queue->RegisterTask(
+      queue_id, [&order]() { order.push_back(1); },
+      time + fml::TimeDelta::FromMilliseconds(1));
+
+  const auto now = time + TaskSource::kMaxBackgroundTaskDelay;
+  while (fml::TaskClosure invocation =
+             task_queue->GetNextTaskToRun(queue_id, now)) {
+    invocation();
+  }
+  ASSERT_EQ(order, std::vector<int>({0, 1}));
+}
+
+TEST(MessageLoopTaskQueue, RecordsQueueingDelayPerGrade) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+
+  const auto now = ChronoTicksSinceEpoch();
+  task_queue->RegisterTask(
+      queue_id, []() {}, now, fml::TaskSourceGrade::kUserInteraction);
+  task_queue->RegisterTask(
+      queue_id, []() {}, now, fml::TaskSourceGrade::kBackground);
+  task_queue->RegisterTask(
+      queue_id, []() {}, now, fml::TaskSourceGrade::kBackground);
+  while (fml::TaskClosure invocation =
+             task_queue->GetNextTaskToRun(queue_id, now)) {
+    invocation();
+  }
+
+  EXPECT_EQ(task_queue
+                ->GetQueueingDelayHistogram(
+                    queue_id, fml::TaskSourceGrade::kUserInteraction)
+                .GetTotalCount(),
+            1u);
+  EXPECT_EQ(task_queue
+                ->GetQueueingDelayHistogram(queue_id,
+                                            fml::TaskSourceGrade::kBackground)
+                .GetTotalCount(),
+            2u);
+  EXPECT_EQ(task_queue
+                ->GetQueueingDelayHistogram(queue_id,
+                                            fml::TaskSourceGrade::kUnspecified)
+                .GetTotalCount(),
+            0u);
+}
+
+TEST(MessageLoopTaskQueue, TasksAreCopiedOnceWhileQueued) {
+  // Counts the copies of the closures, which copy their captures.
+  struct CopyCounter {
+    explicit CopyCounter(std::shared_ptr<size_t> copies)
+        : copies(std::move(copies)) {}
+    CopyCounter(const CopyCounter& other) : copies(other.copies) {
+      (*copies)++;
+    }
+    CopyCounter(CopyCounter&& other) = default;
+    void operator()() const {}
+    std::shared_ptr<size_t> copies;
+  };
+
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+  auto copies = std::make_shared<size_t>(0u);
+  const size_t kTaskCount = 100u;
+  const auto now = ChronoTicksSinceEpoch();
+  for (size_t i = 0; i < kTaskCount; i++) {
+    // Registers the tasks out of order so that the heap is reordered.
+    const fml::closure task = CopyCounter(copies);
+    task_queue->RegisterTask(
+        queue_id, task,
+        now - fml::TimeDelta::FromMicroseconds((i * 7) % kTaskCount));
+  }
+  size_t run_count = 0u;
+  while (fml::TaskClosure invocation =
+             task_queue->GetNextTaskToRun(queue_id, now)) {
+    invocation();
+    run_count++;
+  }
+
+  EXPECT_EQ(run_count, kTaskCount);
+  // The only copies are the ones made when registering the tasks, since the
+  // caller keeps the closures.
+  EXPECT_EQ(*copies, kTaskCount);
+}
+
 }  // namespace testing
 }  // namespace fml
@@ -7,7 +7,9 @@
 #include "flutter/fml/message_loop.h"
 
 #include <iostream>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/concurrent_message_loop.h"
@@ -191,6 +193,64 @@ TEST(MessageLoop, CanCreateAndShutdownConcurrentMessageLoopsOverAndOver) {
   }
 }
 
+TEST(MessageLoop, ConcurrentMessageLoopRunsUrgentTasksFirst) {
+  auto loop = fml::ConcurrentMessageLoop::Create(1u);
+  auto task_runner = loop->GetTaskRunner();
+  fml::AutoResetWaitableEvent worker_blocked;
+  fml::AutoResetWaitableEvent unblock_worker;
+  task_runner->PostTask([&]() {
+    worker_blocked.Signal();
+    unblock_worker.Wait();
+  });
+  worker_blocked.Wait();
+
+  std::mutex order_mutex;
+  std::vector<fml::ConcurrentTaskPriority> order;
+  fml::CountDownLatch latch(3u);
+  for (auto priority : {fml::ConcurrentTaskPriority::kBackground,
+                        fml::ConcurrentTaskPriority::kNormal,
+                        fml::ConcurrentTaskPriority::kHigh}) {
+    task_runner->PostTask(
+        [&, priority]() {
+          {
+            std::scoped_lock lock(order_mutex);
+            order.push_back(priority);
+          }
+          latch.CountDown();
+        },
+        priority);
+  }
+  unblock_worker.Signal();
+  latch.Wait();
+
+  std::vector<fml::ConcurrentTaskPriority> expected_order = {
+      fml::ConcurrentTaskPriority::kHigh,
+      fml::ConcurrentTaskPriority::kNormal,
+      fml::ConcurrentTaskPriority::kBackground,
+  };
+  ASSERT_EQ(order, expected_order);
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopWorkersStealTasks) {
+  auto loop = fml::ConcurrentMessageLoop::Create(2u);
+  auto task_runner = loop->GetTaskRunner();
+  fml::AutoResetWaitableEvent done;
+  task_runner->PostTask([&]() {
+    // The task is queued on this worker, which is blocked until the other
+    // worker takes it.
+    fml::AutoResetWaitableEvent subtask_done;
+    std::thread::id subtask_thread_id;
+    task_runner->PostTask([&]() {
+      subtask_thread_id = std::this_thread::get_id();
+      subtask_done.Signal();
+    });
+    subtask_done.Wait();
+    EXPECT_NE(subtask_thread_id, std::this_thread::get_id());
+    done.Signal();
+  });
+  done.Wait();
+}
+
 TEST(MessageLoop, CanCreateConcurrentMessageLoop) {
   auto loop = fml::ConcurrentMessageLoop::Create();
   auto task_runner = loop->GetTaskRunner();
@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/pixel_conversion.h"
+
+#include <algorithm>
+
+namespace fml {
+
+namespace {
+
+// The BT.601 coefficients of `YUVToRGBFilterContents` in 16.16 fixed point.
+struct YUVCoefficients {
+  int32_t y_offset;
+  int32_t y;
+  int32_t v_to_r;
+  int32_t u_to_g;
+  int32_t v_to_g;
+  int32_t u_to_b;
+};
+
+constexpr YUVCoefficients kBT601LimitedRange = {
+    .y_offset = 16,
+    .y = 76284,        // 1.164
+    .v_to_r = 104595,  // 1.596
+    .u_to_g = 25690,   // 0.392
+    .v_to_g = 53281,   // 0.813
+    .u_to_b = 132186,  // 2.017
+};
+
+constexpr YUVCoefficients kBT601FullRange = {
+    .y_offset = 0,
+    .y = 65536,        // 1.0
+    .v_to_r = 91881,   // 1.402
+    .u_to_g = 22544,   // 0.344
+    .v_to_g = 46793,   // 0.714
+    .u_to_b = 116130,  // 1.772
+};
+
+const YUVCoefficients& GetCoefficients(YUVRange range) {
+  return range == YUVRange::kLimited ? kBT601LimitedRange : kBT601FullRange;
+}
+
+uint8_t ClampToByte(int32_t value) {
+  return static_cast<uint8_t>(std::clamp(value, 0, 255));
+}
+
+void ConvertYUVPixel(const YUVCoefficients& coefficients,
+                     uint8_t y,
+                     uint8_t u,
+                     uint8_t v,
+                     uint8_t* rgba) {
+  constexpr int32_t kHalf = 1 << 15;
+  int32_t luma = (y - coefficients.y_offset) * coefficients.y + kHalf;
+  int32_t cb = u - 128;
+  int32_t cr = v - 128;
+  rgba[0] = ClampToByte((luma + cr * coefficients.v_to_r) >> 16);
+  rgba[1] = ClampToByte(
+      (luma - cb * coefficients.u_to_g - cr * coefficients.v_to_g) >> 16);
+  rgba[2] = ClampToByte((luma + cb * coefficients.u_to_b) >> 16);
+  rgba[3] = 255;
+}
+
+}  // namespace
+
+void SwizzleRedAndBlue(const uint8_t* src,
+                       size_t src_row_bytes,
+                       uint8_t* dst,
+                       size_t dst_row_bytes,
+                       size_t width,
+                       size_t height) {
+  for (size_t row = 0; row < height; row++) {
+    const uint8_t* src_row = src + row * src_row_bytes;
+    uint8_t* dst_row = dst + row * dst_row_bytes;
+    for (size_t x = 0; x < width * 4; x += 4) {
+      uint8_t red = src_row[x + 2];
+      uint8_t blue = src_row[x];
+      dst_row[x] = red;
+      dst_row[x + 1] = src_row[x + 1];
+      dst_row[x + 2] = blue;
+      dst_row[x + 3] = src_row[x + 3];
+    }
+  }
+}
+
+void ConvertNV12ToRGBA(const uint8_t* y_plane,
+                       size_t y_row_bytes,
+                       const uint8_t* uv_plane,
+                       size_t uv_row_bytes,
+                       uint8_t* dst,
+                       size_t dst_row_bytes,
+                       size_t width,
+                       size_t height,
+                       YUVRange range) {
+  const YUVCoefficients& coefficients = GetCoefficients(range);
+  for (size_t row = 0; row < height; row++) {
+    const uint8_t* y_row = y_plane + row * y_row_bytes;
+    const uint8_t* uv_row = uv_plane + (row / 2) * uv_row_bytes;
+    uint8_t* dst_row = dst + row * dst_row_bytes;
+    for (size_t x = 0; x < width; x++) {
+      size_t chroma = (x / 2) * 2;
+      ConvertYUVPixel(coefficients, y_row[x], uv_row[chroma],
+                      uv_row[chroma + 1], dst_row + x * 4);
+    }
+  }
+}
+
+void ConvertI420ToRGBA(const uint8_t* y_plane,
+                       size_t y_row_bytes,
+                       const uint8_t* u_plane,
+                       size_t u_row_bytes,
+                       const uint8_t* v_plane,
+                       size_t v_row_bytes,
+                       uint8_t* dst,
+                       size_t dst_row_bytes,
+                       size_t width,
+                       size_t height,
+                       YUVRange range) {
+  const YUVCoefficients& coefficients = GetCoefficients(range);
+  for (size_t row = 0; row < height; row++) {
+    const uint8_t* y_row = y_plane + row * y_row_bytes;
+    const uint8_t* u_row = u_plane + (row / 2) * u_row_bytes;
+    const uint8_t* v_row = v_plane + (row / 2) * v_row_bytes;
+    uint8_t* dst_row = dst + row * dst_row_bytes;
+    for (size_t x = 0; x < width; x++) {
+      ConvertYUVPixel(coefficients, y_row[x], u_row[x / 2], v_row[x / 2],
+                      dst_row + x * 4);
+    }
+  }
+}
+
+}  // namespace fml
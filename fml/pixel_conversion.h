@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_PIXEL_CONVERSION_H_
+#define FLUTTER_FML_PIXEL_CONVERSION_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fml {
+
+// Conversions of 8 bit per channel pixels on the CPU, for the pixels that are
+// read back from or uploaded to the GPU without going through a shader.
+//
+// The rows of the source and destination may be padded, so each plane comes
+// with its row bytes. The loops work on whole 32 bit pixels without branches
+// so that compilers vectorize them.
+
+/// Swaps the red and blue channels of 32 bit pixels, which converts BGRA8888
+/// to RGBA8888 and back. The source and destination may be the same buffer
+/// if their row bytes are the same.
+void SwizzleRedAndBlue(const uint8_t* src,
+                       size_t src_row_bytes,
+                       uint8_t* dst,
+                       size_t dst_row_bytes,
+                       size_t width,
+                       size_t height);
+
+/// The range of the luma and chroma values of YUV pixels, whose colors are
+/// converted to RGB with BT.601 like `YUVToRGBFilterContents` does.
+enum class YUVRange {
+  /// Luma from 16 to 235 and chroma from 16 to 240.
+  kLimited,
+  /// Luma and chroma from 0 to 255.
+  kFull,
+};
+
+/// Converts NV12 pixels, a plane of luma followed by a plane of interleaved
+/// U and V chroma at half the resolution, to opaque RGBA8888 pixels.
+void ConvertNV12ToRGBA(const uint8_t* y_plane,
+                       size_t y_row_bytes,
+                       const uint8_t* uv_plane,
+                       size_t uv_row_bytes,
+                       uint8_t* dst,
+                       size_t dst_row_bytes,
+                       size_t width,
+                       size_t height,
+                       YUVRange range);
+
+/// Converts I420 pixels, a plane of luma followed by a U and a V plane of
+/// chroma at half the resolution, to opaque RGBA8888 pixels.
+void ConvertI420ToRGBA(const uint8_t* y_plane,
+                       size_t y_row_bytes,
+                       const uint8_t* u_plane,
+                       size_t u_row_bytes,
+                       const uint8_t* v_plane,
+                       size_t v_row_bytes,
+                       uint8_t* dst,
+                       size_t dst_row_bytes,
+                       size_t width,
+                       size_t height,
+                       YUVRange range);
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_PIXEL_CONVERSION_H_
@@ -0,0 +1,53 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/pixel_conversion.h"
+
+#include <array>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(PixelConversionTest, SwizzlesRedAndBlueOfPaddedRows) {
+  // Two rows of one pixel, each padded to 8 bytes.
+  std::array<uint8_t, 16> bgra = {1, 2, 3, 4, 0, 0, 0, 0,
+                                  5, 6, 7, 8, 0, 0, 0, 0};
+  std::array<uint8_t, 8> rgba = {};
+  SwizzleRedAndBlue(bgra.data(), 8u, rgba.data(), 4u, 1u, 2u);
+  EXPECT_EQ(rgba, (std::array<uint8_t, 8>{3, 2, 1, 4, 7, 6, 5, 8}));
+
+  // In place.
+  SwizzleRedAndBlue(rgba.data(), 4u, rgba.data(), 4u, 1u, 2u);
+  EXPECT_EQ(rgba, (std::array<uint8_t, 8>{1, 2, 3, 4, 5, 6, 7, 8}));
+}
+
+TEST(PixelConversionTest, ConvertsLimitedRangeNV12) {
+  // A 2x2 image with a single chroma sample of no color.
+  std::array<uint8_t, 4> y = {16, 235, 128, 81};
+  std::array<uint8_t, 2> uv = {128, 128};
+  std::array<uint8_t, 16> rgba = {};
+  ConvertNV12ToRGBA(y.data(), 2u, uv.data(), 2u, rgba.data(), 8u, 2u, 2u,
+                    YUVRange::kLimited);
+  EXPECT_EQ(rgba, (std::array<uint8_t, 16>{0, 0, 0, 255,        //
+                                           255, 255, 255, 255,  //
+                                           130, 130, 130, 255,  //
+                                           76, 76, 76, 255}));
+}
+
+TEST(PixelConversionTest, ConvertsFullRangeI420) {
+  std::array<uint8_t, 2> y = {0, 255};
+  std::array<uint8_t, 1> u = {128};
+  std::array<uint8_t, 1> v = {255};
+  std::array<uint8_t, 8> rgba = {};
+  ConvertI420ToRGBA(y.data(), 2u, u.data(), 1u, v.data(), 1u, rgba.data(), 8u,
+                    2u, 1u, YUVRange::kFull);
+  // Full red chroma saturates red and takes green away.
+  EXPECT_EQ(rgba, (std::array<uint8_t, 8>{178, 0, 0, 255,  //
+                                          255, 164, 255, 255}));
+}
+
+}  // namespace testing
+}  // namespace fml
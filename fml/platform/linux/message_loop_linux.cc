@@ -7,13 +7,25 @@
 #include <sys/epoll.h>
 #include <unistd.h>
 
+#include <iterator>
+#include <utility>
+
 #include "flutter/fml/eintr_wrapper.h"
 #include "flutter/fml/platform/linux/timerfd.h"
+#include "flutter/fml/trace_event.h"
 
 namespace fml {
 
 static constexpr int kClockType = CLOCK_MONOTONIC;
 
+// The upper bounds of the buckets of the wakeup lateness histogram, in
+// microseconds. The last bucket holds the wakeups later than 2ms.
+static constexpr int64_t kLatenessBucketLimits[] = {100, 250, 500, 1000, 2000};
+
+// The number of wakeups between the traces of the lateness histogram, which
+// is about a second of frames at 120Hz.
+static constexpr size_t kWakeUpsPerLatenessTrace = 120u;
+
 MessageLoopLinux::MessageLoopLinux()
     : epoll_fd_(FML_HANDLE_EINTR(::epoll_create(1 /* unused */))),
       timer_fd_(::timerfd_create(kClockType, TFD_NONBLOCK | TFD_CLOEXEC)) {
@@ -79,15 +91,51 @@ void MessageLoopLinux::Terminate() {
 
 // |fml::MessageLoopImpl|
 void MessageLoopLinux::WakeUp(fml::TimePoint time_point) {
+  std::scoped_lock lock(wake_time_mutex_);
+  // The task queues ask for a wakeup at the time of their earliest task each
+  // time a task is posted, which most of the time hasn't changed. Skip the
+  // system call in that case.
+  if (time_point == wake_time_) {
+    return;
+  }
+  wake_time_ = time_point;
   bool result = TimerRearm(timer_fd_.get(), time_point);
   (void)result;
   FML_DCHECK(result);
 }
 
 void MessageLoopLinux::OnEventFired() {
+  fml::TimePoint wake_time;
+  {
+    std::scoped_lock lock(wake_time_mutex_);
+    wake_time = std::exchange(wake_time_, fml::TimePoint::Max());
+  }
   if (TimerDrain(timer_fd_.get())) {
+    RecordWakeUpLateness(fml::TimePoint::Now() - wake_time);
     RunExpiredTasksNow();
   }
 }
 
+void MessageLoopLinux::RecordWakeUpLateness(fml::TimeDelta lateness) {
+  const int64_t lateness_micros = lateness.ToMicroseconds();
+  size_t bucket = 0u;
+  while (bucket < std::size(kLatenessBucketLimits) &&
+         lateness_micros >= kLatenessBucketLimits[bucket]) {
+    bucket++;
+  }
+  lateness_counts_[bucket]++;
+
+  if (++wake_up_count_ < kWakeUpsPerLatenessTrace) {
+    return;
+  }
+  FML_TRACE_COUNTER("flutter", "MessageLoopWakeUpLateness",
+                    reinterpret_cast<int64_t>(this), "Under100us",
+                    lateness_counts_[0], "Under250us", lateness_counts_[1],
+                    "Under500us", lateness_counts_[2], "Under1ms",
+                    lateness_counts_[3], "Under2ms", lateness_counts_[4],
+                    "Over2ms", lateness_counts_[5]);
+  wake_up_count_ = 0u;
+  lateness_counts_ = {};
+}
+
 }  // namespace fml
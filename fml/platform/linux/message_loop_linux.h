@@ -5,7 +5,9 @@
 #ifndef FLUTTER_FML_PLATFORM_LINUX_MESSAGE_LOOP_LINUX_H_
 #define FLUTTER_FML_PLATFORM_LINUX_MESSAGE_LOOP_LINUX_H_
 
+#include <array>
 #include <atomic>
+#include <mutex>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/message_loop_impl.h"
@@ -18,6 +20,14 @@ class MessageLoopLinux : public MessageLoopImpl {
   fml::UniqueFD epoll_fd_;
   fml::UniqueFD timer_fd_;
   bool running_ = false;
+  std::mutex wake_time_mutex_;
+  // The time the timer is armed for, or |fml::TimePoint::Max()| if it has
+  // fired since.
+  fml::TimePoint wake_time_ = fml::TimePoint::Max();
+  // The number of wakeups since the lateness histogram was last traced, and
+  // the number in each of its buckets.
+  size_t wake_up_count_ = 0u;
+  std::array<size_t, 6> lateness_counts_ = {};
 
   MessageLoopLinux();
 
@@ -34,6 +44,10 @@ class MessageLoopLinux : public MessageLoopImpl {
 
   void OnEventFired();
 
+  // Records how late the loop woke up, and periodically traces the histogram
+  // of the lateness of the recent wakeups.
+  void RecordWakeUpLateness(fml::TimeDelta lateness);
+
   bool AddOrRemoveTimerSource(bool add);
 
   FML_FRIEND_MAKE_REF_COUNTED(MessageLoopLinux);
@@ -0,0 +1,42 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/platform/linux/thread_scheduling.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/prctl.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "flutter/fml/logging.h"
+
+namespace fml {
+
+bool SetCurrentThreadTimerSlack(fml::TimeDelta slack) {
+  // A slack of zero resets the thread to the slack of the process.
+  const auto nanoseconds =
+      static_cast<unsigned long>(std::max<int64_t>(slack.ToNanoseconds(), 1));
+  if (::prctl(PR_SET_TIMERSLACK, nanoseconds) != 0) {
+    FML_DLOG(ERROR) << "Could not set the timer slack: " << strerror(errno);
+    return false;
+  }
+  return true;
+}
+
+bool RequestCurrentThreadRealtimePriority(int priority) {
+  struct sched_param param = {};
+  param.sched_priority = priority;
+  const int result =
+      ::pthread_setschedparam(::pthread_self(), SCHED_FIFO, &param);
+  if (result != 0) {
+    FML_DLOG(ERROR) << "Could not set the realtime priority: "
+                    << strerror(result);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace fml
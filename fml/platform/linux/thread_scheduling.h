@@ -0,0 +1,26 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_PLATFORM_LINUX_THREAD_SCHEDULING_H_
+#define FLUTTER_FML_PLATFORM_LINUX_THREAD_SCHEDULING_H_
+
+#include "flutter/fml/time/time_delta.h"
+
+namespace fml {
+
+/// Sets how much later than requested the kernel may fire the timers of the
+/// current thread, such as the timer of its message loop, to coalesce them
+/// with other wakeups. The kernel's default is 50 microseconds, but processes
+/// may inherit a much larger slack from the service that launched them.
+bool SetCurrentThreadTimerSlack(fml::TimeDelta slack);
+
+/// Requests the `SCHED_FIFO` policy with the given priority, between 1 and
+/// 99, for the current thread so that it preempts all the threads of the
+/// default policy as soon as it is runnable. This fails unless the process
+/// has `CAP_SYS_NICE` or an `RLIMIT_RTPRIO` of at least `priority`.
+bool RequestCurrentThreadRealtimePriority(int priority);
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_PLATFORM_LINUX_THREAD_SCHEDULING_H_
@@ -107,4 +107,23 @@ bool FileMapping::IsValid() const {
   return valid_;
 }
 
+bool FileMapping::AdviseAccessPattern(AccessPattern pattern) const {
+  if (mapping_ == nullptr) {
+    return false;
+  }
+  int advice = MADV_NORMAL;
+  switch (pattern) {
+    case AccessPattern::kNormal:
+      advice = MADV_NORMAL;
+      break;
+    case AccessPattern::kRandom:
+      advice = MADV_RANDOM;
+      break;
+    case AccessPattern::kSequential:
+      advice = MADV_SEQUENTIAL;
+      break;
+  }
+  return ::madvise(mapping_, size_, advice) == 0;
+}
+
 }  // namespace fml
@@ -123,4 +123,8 @@ bool FileMapping::IsValid() const {
   return valid_;
 }
 
+bool FileMapping::AdviseAccessPattern(AccessPattern pattern) const {
+  return false;
+}
+
 }  // namespace fml
@@ -0,0 +1,165 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TASK_CLOSURE_H_
+#define FLUTTER_FML_TASK_CLOSURE_H_
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      A move-only closure for the tasks posted to task runners.
+///
+///             Unlike `fml::closure`, which is a `std::function`, callables
+///             of up to `kInlineSize` bytes are stored inline rather than on
+///             the heap, so posting a typical lambda doesn't allocate. And
+///             since it is never copied, it accepts move-only callables
+///             without `fml::MakeCopyable`, and copying a task doesn't copy
+///             its captures.
+///
+///             An `fml::closure` converts to a `TaskClosure`, which is empty
+///             if the `fml::closure` is.
+///
+class TaskClosure final {
+ public:
+  /// The size of the callables stored inline.
+  static constexpr size_t kInlineSize = 48u;
+
+  TaskClosure() = default;
+
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  TaskClosure(std::nullptr_t) {}
+
+  template <typename F,
+            typename Callable = std::decay_t<F>,
+            typename = std::enable_if_t<
+                !std::is_same_v<Callable, TaskClosure> &&
+                std::is_invocable_v<Callable&>>>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  TaskClosure(F&& callable) {
+    if constexpr (std::is_pointer_v<Callable> ||
+                  IsFunction<Callable>::value) {
+      if (!callable) {
+        return;
+      }
+    }
+    if constexpr (IsStoredInline<Callable>()) {
+      new (storage_) Callable(std::forward<F>(callable));
+      operations_ = &kInlineOperations<Callable>;
+    } else {
+      new (storage_) Callable*(new Callable(std::forward<F>(callable)));
+      operations_ = &kHeapOperations<Callable>;
+    }
+  }
+
+  TaskClosure(TaskClosure&& other) noexcept { MoveFrom(other); }
+
+  TaskClosure& operator=(TaskClosure&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  TaskClosure& operator=(std::nullptr_t) {
+    Reset();
+    return *this;
+  }
+
+  ~TaskClosure() { Reset(); }
+
+  explicit operator bool() const { return operations_ != nullptr; }
+
+  friend bool operator==(const TaskClosure& closure, std::nullptr_t) {
+    return !closure;
+  }
+
+  void operator()() const {
+    FML_DCHECK(operations_);
+    operations_->invoke(storage_);
+  }
+
+ private:
+  struct Operations {
+    void (*invoke)(void* storage);
+    // Moves the callable in `from` to `to`, and destroys the one in `from`.
+    void (*relocate)(void* from, void* to);
+    void (*destroy)(void* storage);
+  };
+
+  template <typename T>
+  struct IsFunction : std::false_type {};
+
+  template <typename Signature>
+  struct IsFunction<std::function<Signature>> : std::true_type {};
+
+  template <typename Callable>
+  static constexpr bool IsStoredInline() {
+    return sizeof(Callable) <= kInlineSize &&
+           alignof(Callable) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible_v<Callable>;
+  }
+
+  template <typename Callable>
+  static constexpr Operations kInlineOperations = {
+      .invoke =
+          [](void* storage) {
+            std::invoke(*static_cast<Callable*>(storage));
+          },
+      .relocate =
+          [](void* from, void* to) {
+            auto callable = static_cast<Callable*>(from);
+            new (to) Callable(std::move(*callable));
+            callable->~Callable();
+          },
+      .destroy =
+          [](void* storage) { static_cast<Callable*>(storage)->~Callable(); },
+  };
+
+  template <typename Callable>
+  static constexpr Operations kHeapOperations = {
+      .invoke =
+          [](void* storage) {
+            std::invoke(**static_cast<Callable**>(storage));
+          },
+      .relocate =
+          [](void* from, void* to) {
+            new (to) Callable*(*static_cast<Callable**>(from));
+          },
+      .destroy =
+          [](void* storage) { delete *static_cast<Callable**>(storage); },
+  };
+
+  alignas(std::max_align_t) mutable std::byte storage_[kInlineSize];
+  const Operations* operations_ = nullptr;
+
+  void MoveFrom(TaskClosure& other) {
+    if (other.operations_) {
+      other.operations_->relocate(other.storage_, storage_);
+      operations_ = std::exchange(other.operations_, nullptr);
+    }
+  }
+
+  void Reset() {
+    if (operations_) {
+      std::exchange(operations_, nullptr)->destroy(storage_);
+    }
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TaskClosure);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TASK_CLOSURE_H_
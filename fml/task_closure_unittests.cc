@@ -0,0 +1,78 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/task_closure.h"
+
+#include <array>
+#include <memory>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(TaskClosureTest, IsEmptyByDefault) {
+  TaskClosure closure;
+  EXPECT_FALSE(closure);
+  EXPECT_TRUE(closure == nullptr);
+  EXPECT_FALSE(TaskClosure(nullptr));
+}
+
+TEST(TaskClosureTest, IsEmptyWhenConvertedFromAnEmptyClosure) {
+  fml::closure empty;
+  EXPECT_FALSE(TaskClosure(empty));
+
+  int calls = 0;
+  fml::closure counter = [&calls]() { calls++; };
+  TaskClosure closure(counter);
+  ASSERT_TRUE(closure);
+  closure();
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(TaskClosureTest, InvokesSmallAndLargeCallables) {
+  int calls = 0;
+  TaskClosure small([&calls]() { calls++; });
+  std::array<char, TaskClosure::kInlineSize * 2> padding = {};
+  TaskClosure large([&calls, padding]() { calls += 1 + padding[0]; });
+  small();
+  large();
+  EXPECT_EQ(calls, 2);
+}
+
+TEST(TaskClosureTest, AcceptsMoveOnlyCallables) {
+  auto value = std::make_unique<int>(42);
+  int result = 0;
+  TaskClosure closure(
+      [value = std::move(value), &result]() { result = *value; });
+  TaskClosure moved(std::move(closure));
+  EXPECT_FALSE(closure);  // NOLINT(bugprone-use-after-move)
+  moved();
+  EXPECT_EQ(result, 42);
+}
+
+TEST(TaskClosureTest, DestroysTheCallableOnce) {
+  auto small_capture = std::make_shared<int>(0);
+  auto large_capture = std::make_shared<int>(0);
+  {
+    TaskClosure small([small_capture]() {});
+    std::array<char, TaskClosure::kInlineSize * 2> padding = {};
+    TaskClosure large([large_capture, padding]() {});
+    EXPECT_EQ(small_capture.use_count(), 2);
+    EXPECT_EQ(large_capture.use_count(), 2);
+
+    TaskClosure moved_small(std::move(small));
+    TaskClosure moved_large;
+    moved_large = std::move(large);
+    EXPECT_EQ(small_capture.use_count(), 2);
+    EXPECT_EQ(large_capture.use_count(), 2);
+
+    moved_small = nullptr;
+    EXPECT_EQ(small_capture.use_count(), 1);
+  }
+  EXPECT_EQ(large_capture.use_count(), 1);
+}
+
+}  // namespace testing
+}  // namespace fml
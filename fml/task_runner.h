@@ -8,6 +8,7 @@
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
+#include "flutter/fml/task_closure.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/fml/message_loop_task_queues.h"
 #include "flutter/fml/time/time_point.h"
@@ -20,8 +21,8 @@ class MessageLoopImpl;
 class BasicTaskRunner {
  public:
   /// Schedules \p task to be executed on the TaskRunner's associated event
-  /// loop.
-  virtual void PostTask(const fml::closure& task) = 0;
+  /// loop. Lambdas and `fml::closure`s convert to an `fml::TaskClosure`.
+  virtual void PostTask(fml::TaskClosure task) = 0;
 };
 
 /// The object for scheduling tasks on a \p fml::MessageLoop.
@@ -36,18 +37,25 @@ class TaskRunner : public fml::RefCountedThreadSafe<TaskRunner>,
  public:
   virtual ~TaskRunner();
 
-  virtual void PostTask(const fml::closure& task) override;
+  virtual void PostTask(fml::TaskClosure task) override;
 
-  virtual void PostTaskForTime(const fml::closure& task,
+  virtual void PostTaskForTime(fml::TaskClosure task,
                                fml::TimePoint target_time);
 
+  /// Schedules \p task with the given \p grade, which tells the
+  /// MessageLoop how urgent the task is. Background tasks only run once no
+  /// other task is ready to run.
+  /// \see fml::TaskSourceGrade
+  virtual void PostTaskWithGrade(fml::TaskClosure task,
+                                 fml::TaskSourceGrade grade);
+
   /// Schedules a task to be run on the MessageLoop after the time \p delay has
   /// passed.
   /// \note There is latency between when the task is schedule and actually
   /// executed so that the actual execution time is: now + delay +
   /// message_loop_latency, where message_loop_latency is undefined and could be
   /// tens of milliseconds.
-  virtual void PostDelayedTask(const fml::closure& task, fml::TimeDelta delay);
+  virtual void PostDelayedTask(fml::TaskClosure task, fml::TimeDelta delay);
 
   /// Returns \p true when the current executing thread's TaskRunner matches
   /// this instance.
@@ -60,7 +68,7 @@ class TaskRunner : public fml::RefCountedThreadSafe<TaskRunner>,
   /// Executes the \p task directly if the TaskRunner \p runner is the
   /// TaskRunner associated with the current executing thread.
   static void RunNowOrPostTask(const fml::RefPtr<fml::TaskRunner>& runner,
-                               const fml::closure& task);
+                               fml::TaskClosure task);
 
  protected:
   explicit TaskRunner(fml::RefPtr<MessageLoopImpl> loop);
@@ -6,8 +6,34 @@
 
 #include "flutter/fml/task_source.h"
 
+#include <utility>
+
 namespace fml {
 
+void TaskQueueingDelayHistogram::Record(fml::TimeDelta delay) {
+  size_t bucket = 0;
+  int64_t bucket_end_millis = 1;
+  while (bucket + 1 < kBucketCount &&
+         delay >= fml::TimeDelta::FromMilliseconds(bucket_end_millis)) {
+    bucket++;
+    bucket_end_millis *= 2;
+  }
+  counts_[bucket]++;
+}
+
+size_t TaskQueueingDelayHistogram::GetCount(size_t bucket) const {
+  FML_DCHECK(bucket < kBucketCount);
+  return counts_[bucket];
+}
+
+size_t TaskQueueingDelayHistogram::GetTotalCount() const {
+  size_t total = 0;
+  for (size_t count : counts_) {
+    total += count;
+  }
+  return total;
+}
+
 TaskSource::TaskSource(TaskQueueId task_queue_id)
     : task_queue_id_(task_queue_id) {}
 
@@ -18,38 +44,52 @@ TaskSource::~TaskSource() {
 void TaskSource::ShutDown() {
   primary_task_queue_ = {};
   secondary_task_queue_ = {};
+  background_task_queue_ = {};
 }
 
-void TaskSource::RegisterTask(const DelayedTask& task) {
+void TaskSource::RegisterTask(DelayedTask task) {
   switch (task.GetTaskSourceGrade()) {
     case TaskSourceGrade::kUserInteraction:
-      primary_task_queue_.push(task);
+      primary_task_queue_.push(std::move(task));
       break;
     case TaskSourceGrade::kUnspecified:
-      primary_task_queue_.push(task);
+      primary_task_queue_.push(std::move(task));
       break;
     case TaskSourceGrade::kDartMicroTasks:
-      secondary_task_queue_.push(task);
+      secondary_task_queue_.push(std::move(task));
+      break;
+    case TaskSourceGrade::kBackground:
+      background_task_queue_.push(std::move(task));
       break;
   }
 }
 
-void TaskSource::PopTask(TaskSourceGrade grade) {
+fml::TaskClosure TaskSource::PopTask(TaskSourceGrade grade) {
+  DelayedTaskQueue* queue = nullptr;
   switch (grade) {
     case TaskSourceGrade::kUserInteraction:
-      primary_task_queue_.pop();
+      queue = &primary_task_queue_;
       break;
     case TaskSourceGrade::kUnspecified:
-      primary_task_queue_.pop();
+      queue = &primary_task_queue_;
       break;
     case TaskSourceGrade::kDartMicroTasks:
-      secondary_task_queue_.pop();
+      queue = &secondary_task_queue_;
+      break;
+    case TaskSourceGrade::kBackground:
+      queue = &background_task_queue_;
       break;
   }
+  // The heap only orders tasks by their target time and order, which taking
+  // the closure leaves untouched, so the top can be moved from before the
+  // pop.
+  auto task = const_cast<DelayedTask&>(queue->top()).TakeTask();
+  queue->pop();
+  return task;
 }
 
 size_t TaskSource::GetNumPendingTasks() const {
-  size_t size = primary_task_queue_.size();
+  size_t size = primary_task_queue_.size() + background_task_queue_.size();
   if (secondary_pause_requests_ == 0) {
     size += secondary_task_queue_.size();
   }
@@ -60,37 +100,54 @@ bool TaskSource::IsEmpty() const {
   return GetNumPendingTasks() == 0;
 }
 
-TaskSource::TopTask TaskSource::Top() const {
-  FML_CHECK(!IsEmpty());
+const DelayedTask* TaskSource::TopForegroundTask() const {
   if (secondary_pause_requests_ > 0 || secondary_task_queue_.empty()) {
-    const auto& primary_top = primary_task_queue_.top();
-    return {
-        .task_queue_id = task_queue_id_,
-        .task = primary_top,
-    };
+    return primary_task_queue_.empty() ? nullptr : &primary_task_queue_.top();
   } else if (primary_task_queue_.empty()) {
-    const auto& secondary_top = secondary_task_queue_.top();
-    return {
-        .task_queue_id = task_queue_id_,
-        .task = secondary_top,
-    };
+    return &secondary_task_queue_.top();
   } else {
     const auto& primary_top = primary_task_queue_.top();
     const auto& secondary_top = secondary_task_queue_.top();
     if (primary_top > secondary_top) {
-      return {
-          .task_queue_id = task_queue_id_,
-          .task = secondary_top,
-      };
+      return &secondary_top;
     } else {
-      return {
-          .task_queue_id = task_queue_id_,
-          .task = primary_top,
-      };
+      return &primary_top;
     }
   }
 }
 
+TaskSource::TopTask TaskSource::Top() const {
+  FML_CHECK(!IsEmpty());
+  const DelayedTask* foreground_top = TopForegroundTask();
+  if (!foreground_top || (!background_task_queue_.empty() &&
+                          *foreground_top > background_task_queue_.top())) {
+    return {
+        .task_queue_id = task_queue_id_,
+        .task = background_task_queue_.top(),
+    };
+  }
+  return {
+      .task_queue_id = task_queue_id_,
+      .task = *foreground_top,
+  };
+}
+
+TaskSource::TopTask TaskSource::Top(fml::TimePoint from_time) const {
+  const TopTask top = Top();
+  if (top.task.GetTaskSourceGrade() != TaskSourceGrade::kBackground ||
+      from_time - top.task.GetTargetTime() >= kMaxBackgroundTaskDelay) {
+    return top;
+  }
+  const DelayedTask* foreground_top = TopForegroundTask();
+  if (foreground_top && foreground_top->GetTargetTime() <= from_time) {
+    return {
+        .task_queue_id = task_queue_id_,
+        .task = *foreground_top,
+    };
+  }
+  return top;
+}
+
 void TaskSource::PauseSecondary() {
   secondary_pause_requests_++;
 }
@@ -100,4 +157,14 @@ void TaskSource::ResumeSecondary() {
   FML_DCHECK(secondary_pause_requests_ >= 0);
 }
 
+void TaskSource::RecordQueueingDelay(TaskSourceGrade grade,
+                                     fml::TimeDelta delay) {
+  queueing_delays_[static_cast<size_t>(grade)].Record(delay);
+}
+
+const TaskQueueingDelayHistogram& TaskSource::GetQueueingDelayHistogram(
+    TaskSourceGrade grade) const {
+  return queueing_delays_[static_cast<size_t>(grade)];
+}
+
 }  // namespace fml
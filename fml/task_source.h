@@ -5,20 +5,48 @@
 #ifndef FLUTTER_FML_TASK_SOURCE_H_
 #define FLUTTER_FML_TASK_SOURCE_H_
 
+#include <array>
+
 #include "flutter/fml/delayed_task.h"
 #include "flutter/fml/task_queue_id.h"
 #include "flutter/fml/task_source_grade.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
 
 namespace fml {
 
 class MessageLoopTaskQueues;
 
+/**
+ * The distribution of how long tasks waited between their target time and the
+ * time they ran.
+ */
+class TaskQueueingDelayHistogram {
+ public:
+  /// Bucket 0 counts the delays under 1ms, bucket `i` the delays from
+  /// 2^(i-1)ms up to 2^i ms, and the last bucket the delays of 64ms or more.
+  static constexpr size_t kBucketCount = 8u;
+
+  /// Counts a task that waited `delay`.
+  void Record(fml::TimeDelta delay);
+
+  /// Returns the number of tasks counted in `bucket`.
+  size_t GetCount(size_t bucket) const;
+
+  /// Returns the number of tasks counted in all buckets.
+  size_t GetTotalCount() const;
+
+ private:
+  std::array<size_t, kBucketCount> counts_ = {};
+};
+
 /**
  * A Source of tasks for the `MessageLoopTaskQueues` task dispatcher. This is a
  * wrapper around a primary and secondary task heap with the difference between
  * them being that the secondary task heap can be paused and resumed by the task
  * dispatcher. `TaskSourceGrade` determines what task heap the task is assigned
- * to.
+ * to. Tasks with `TaskSourceGrade::kBackground` are held in a third heap, and
+ * only run once no task of another grade is ready to run.
  *
  * Registering Tasks
  * -----------------
@@ -44,15 +72,21 @@ class TaskSource {
 
   ~TaskSource();
 
-  /// Drops the pending tasks from both primary and secondary task heaps.
+  /// How long a background task can be ready to run before it runs ahead of
+  /// the tasks of other grades.
+  static constexpr fml::TimeDelta kMaxBackgroundTaskDelay =
+      fml::TimeDelta::FromMilliseconds(500);
+
+  /// Drops the pending tasks from all the task heaps.
   void ShutDown();
 
   /// Adds a task to the corresponding task heap as dictated by the
   /// `TaskSourceGrade` of the `DelayedTask`.
-  void RegisterTask(const DelayedTask& task);
+  void RegisterTask(DelayedTask task);
 
-  /// Pops the task heap corresponding to the `TaskSourceGrade`.
-  void PopTask(TaskSourceGrade grade);
+  /// Pops the task heap corresponding to the `TaskSourceGrade`, and returns
+  /// the closure of the popped task without copying it.
+  fml::TaskClosure PopTask(TaskSourceGrade grade);
 
   /// Returns the number of pending tasks. Excludes the tasks from the secondary
   /// heap if it's paused.
@@ -65,17 +99,38 @@ class TaskSource {
   /// the secondary heap has been paused or not.
   TopTask Top() const;
 
+  /// Returns the task to run at `from_time`. This is the top task, unless it's
+  /// a background task and a task of another grade is ready to run at
+  /// `from_time`. Background tasks that have been ready to run for
+  /// `kMaxBackgroundTaskDelay` are not deferred anymore.
+  TopTask Top(fml::TimePoint from_time) const;
+
   /// Pause providing tasks from secondary task heap.
   void PauseSecondary();
 
   /// Resume providing tasks from secondary task heap.
   void ResumeSecondary();
 
+  /// Records how long a task of the given grade waited to run.
+  void RecordQueueingDelay(TaskSourceGrade grade, fml::TimeDelta delay);
+
+  /// Returns how long the tasks of the given grade waited to run.
+  const TaskQueueingDelayHistogram& GetQueueingDelayHistogram(
+      TaskSourceGrade grade) const;
+
  private:
+  static constexpr size_t kGradeCount = 4u;
+
   const fml::TaskQueueId task_queue_id_;
   fml::DelayedTaskQueue primary_task_queue_;
   fml::DelayedTaskQueue secondary_task_queue_;
+  fml::DelayedTaskQueue background_task_queue_;
   int secondary_pause_requests_ = 0;
+  std::array<TaskQueueingDelayHistogram, kGradeCount> queueing_delays_;
+
+  /// Returns the top task of the primary and secondary heaps, or nullptr if
+  /// they have no task to provide.
+  const DelayedTask* TopForegroundTask() const;
 
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(TaskSource);
 };
@@ -19,6 +19,10 @@ enum class TaskSourceGrade {
   /// This `TaskSourceGrade` indicates that a task corresponds to servicing a
   /// dart micro task. These aren't critical to user interaction.
   kDartMicroTasks,
+  /// This `TaskSourceGrade` indicates that a task can wait until no task of
+  /// another grade is ready to run, such as cache purges or writing caches and
+  /// snapshots to disk.
+  kBackground,
   /// The absence of a specialized `TaskSourceGrade`.
   kUnspecified,
 };
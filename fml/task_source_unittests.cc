@@ -97,5 +97,46 @@ TEST(TaskSourceTests, OrderingMultiTaskHeapsSecondaryPaused) {
   ASSERT_EQ(value, 1);
 }
 
+
+TEST(TaskSourceTests, BackgroundTasksDeferredByReadyTasks) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+  task_source.RegisterTask(
+      {1, [] {}, time_stamp, TaskSourceGrade::kBackground});
+  task_source.RegisterTask({2, [] {},
+                            time_stamp + fml::TimeDelta::FromMilliseconds(1),
+                            TaskSourceGrade::kUnspecified});
+
+  // The background task is the next one, but doesn't run while the other
+  // task is ready to run.
+  ASSERT_EQ(task_source.Top().task.GetTaskSourceGrade(),
+            TaskSourceGrade::kBackground);
+  ASSERT_EQ(task_source.Top(time_stamp).task.GetTaskSourceGrade(),
+            TaskSourceGrade::kBackground);
+  ASSERT_EQ(task_source
+                .Top(time_stamp + fml::TimeDelta::FromMilliseconds(1))
+                .task.GetTaskSourceGrade(),
+            TaskSourceGrade::kUnspecified);
+  ASSERT_EQ(task_source.Top(time_stamp + TaskSource::kMaxBackgroundTaskDelay)
+                .task.GetTaskSourceGrade(),
+            TaskSourceGrade::kBackground);
+}
+
+TEST(TaskQueueingDelayHistogramTests, BucketsArePowersOfTwoMilliseconds) {
+  TaskQueueingDelayHistogram histogram;
+  histogram.Record(fml::TimeDelta::FromMicroseconds(500));
+  histogram.Record(fml::TimeDelta::FromMilliseconds(1));
+  histogram.Record(fml::TimeDelta::FromMilliseconds(3));
+  histogram.Record(fml::TimeDelta::FromMilliseconds(64));
+  histogram.Record(fml::TimeDelta::FromSeconds(10));
+
+  ASSERT_EQ(histogram.GetCount(0), 1u);
+  ASSERT_EQ(histogram.GetCount(1), 1u);
+  ASSERT_EQ(histogram.GetCount(2), 1u);
+  ASSERT_EQ(histogram.GetCount(TaskQueueingDelayHistogram::kBucketCount - 1),
+            2u);
+  ASSERT_EQ(histogram.GetTotalCount(), 5u);
+}
+
 }  // namespace testing
 }  // namespace fml
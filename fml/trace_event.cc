@@ -6,11 +6,13 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cstdlib>
 #include <utility>
 
 #include "flutter/fml/ascii_trie.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_ring_buffer.h"
 
 namespace fml {
 namespace tracing {
@@ -27,6 +29,67 @@ AsciiTrie gAllowlist;
 std::atomic<TimelineEventHandler> gTimelineEventHandler;
 std::atomic<TimelineMicrosSource> gTimelineMicrosSource = DefaultMicrosSource;
 
+// Records the event in the trace ring buffer, stamped with the current time
+// if |timestamp_nanos| is negative.
+void RecordInRingBuffer(int64_t timestamp_nanos,
+                        const char* label,
+                        int64_t timestamp1_or_async_id,
+                        intptr_t flow_id_count,
+                        const int64_t* flow_ids,
+                        Dart_Timeline_Event_Type type,
+                        intptr_t argument_count,
+                        const char** argument_names,
+                        const char** argument_values) {
+  using EventType = TraceRingBuffer::EventType;
+  if (timestamp_nanos < 0) {
+    timestamp_nanos = TimePoint::Now().ToEpochDelta().ToNanoseconds();
+  }
+  const auto id = static_cast<uint64_t>(timestamp1_or_async_id);
+  switch (type) {
+    case Dart_Timeline_Event_Begin:
+      // Only the first flow of a slice is recorded to keep events small.
+      TraceRingBuffer::RecordAt(
+          timestamp_nanos, EventType::kSliceBegin, label,
+          flow_id_count > 0 ? static_cast<uint64_t>(flow_ids[0]) : 0u);
+      break;
+    case Dart_Timeline_Event_End:
+      TraceRingBuffer::RecordAt(timestamp_nanos, EventType::kSliceEnd, label);
+      break;
+    case Dart_Timeline_Event_Instant:
+      TraceRingBuffer::RecordAt(timestamp_nanos, EventType::kInstant, label);
+      break;
+    case Dart_Timeline_Event_Async_Begin:
+      TraceRingBuffer::RecordAt(timestamp_nanos, EventType::kAsyncBegin, label,
+                                id);
+      break;
+    case Dart_Timeline_Event_Async_End:
+      TraceRingBuffer::RecordAt(timestamp_nanos, EventType::kAsyncEnd, label,
+                                id);
+      break;
+    case Dart_Timeline_Event_Flow_Begin:
+      TraceRingBuffer::RecordAt(timestamp_nanos, EventType::kFlowBegin, label,
+                                id);
+      break;
+    case Dart_Timeline_Event_Flow_Step:
+      TraceRingBuffer::RecordAt(timestamp_nanos, EventType::kFlowStep, label,
+                                id);
+      break;
+    case Dart_Timeline_Event_Flow_End:
+      TraceRingBuffer::RecordAt(timestamp_nanos, EventType::kFlowEnd, label,
+                                id);
+      break;
+    case Dart_Timeline_Event_Counter:
+      for (intptr_t i = 0; i < argument_count; i++) {
+        TraceRingBuffer::RecordAt(timestamp_nanos, EventType::kCounter, label,
+                                  id, argument_names[i],
+                                  std::strtod(argument_values[i], nullptr));
+      }
+      break;
+    default:
+      break;
+  }
+}
+
 inline void FlutterTimelineEvent(const char* label,
                                  int64_t timestamp0,
                                  int64_t timestamp1_or_async_id,
@@ -35,7 +98,13 @@ inline void FlutterTimelineEvent(const char* label,
                                  Dart_Timeline_Event_Type type,
                                  intptr_t argument_count,
                                  const char** argument_names,
-                                 const char** argument_values) {
+                                 const char** argument_values,
+                                 int64_t ring_buffer_timestamp_nanos = -1) {
+  if (TraceRingBuffer::IsEnabled()) {
+    RecordInRingBuffer(ring_buffer_timestamp_nanos, label,
+                       timestamp1_or_async_id, flow_id_count, flow_ids, type,
+                       argument_count, argument_names, argument_values);
+  }
   TimelineEventHandler handler =
       gTimelineEventHandler.load(std::memory_order_relaxed);
   if (handler && gAllowlist.Query(label)) {
@@ -43,6 +112,38 @@ inline void FlutterTimelineEvent(const char* label,
             type, argument_count, argument_names, argument_values);
   }
 }
+
+void DispatchTimelineEvent(TraceArg name,
+                           int64_t timestamp_micros,
+                           int64_t ring_buffer_timestamp_nanos,
+                           TraceIDArg identifier,
+                           size_t flow_id_count,
+                           const uint64_t* flow_ids,
+                           Dart_Timeline_Event_Type type,
+                           const std::vector<const char*>& c_names,
+                           const std::vector<std::string>& values) {
+  const auto argument_count = std::min(c_names.size(), values.size());
+
+  std::vector<const char*> c_values;
+  c_values.resize(argument_count, nullptr);
+
+  for (size_t i = 0; i < argument_count; i++) {
+    c_values[i] = values[i].c_str();
+  }
+
+  FlutterTimelineEvent(
+      name,                                        // label
+      timestamp_micros,                            // timestamp0
+      identifier,                                  // timestamp1_or_async_id
+      flow_id_count,                               // flow_id_count
+      reinterpret_cast<const int64_t*>(flow_ids),  // flow_ids
+      type,                                        // event type
+      argument_count,                              // argument_count
+      const_cast<const char**>(c_names.data()),    // argument_names
+      c_values.data(),                             // argument_values
+      ring_buffer_timestamp_nanos                  // ring buffer timestamp
+  );
+}
 }  // namespace
 
 void TraceSetAllowlist(const std::vector<std::string>& allowlist) {
@@ -80,26 +181,10 @@ void TraceTimelineEvent(TraceArg category_group,
                         Dart_Timeline_Event_Type type,
                         const std::vector<const char*>& c_names,
                         const std::vector<std::string>& values) {
-  const auto argument_count = std::min(c_names.size(), values.size());
-
-  std::vector<const char*> c_values;
-  c_values.resize(argument_count, nullptr);
-
-  for (size_t i = 0; i < argument_count; i++) {
-    c_values[i] = values[i].c_str();
-  }
-
-  FlutterTimelineEvent(
-      name,                                        // label
-      timestamp_micros,                            // timestamp0
-      identifier,                                  // timestamp1_or_async_id
-      flow_id_count,                               // flow_id_count
-      reinterpret_cast<const int64_t*>(flow_ids),  // flow_ids
-      type,                                        // event type
-      argument_count,                              // argument_count
-      const_cast<const char**>(c_names.data()),    // argument_names
-      c_values.data()                              // argument_values
-  );
+  // Explicit timestamps are on the clock of |fml::TimePoint|.
+  DispatchTimelineEvent(name, timestamp_micros, timestamp_micros * 1000,
+                        identifier, flow_id_count, flow_ids, type, c_names,
+                        values);
 }
 
 void TraceTimelineEvent(TraceArg category_group,
@@ -110,16 +195,8 @@ void TraceTimelineEvent(TraceArg category_group,
                         Dart_Timeline_Event_Type type,
                         const std::vector<const char*>& c_names,
                         const std::vector<std::string>& values) {
-  TraceTimelineEvent(category_group,                  // group
-                     name,                            // name
-                     gTimelineMicrosSource.load()(),  // timestamp_micros
-                     identifier,                      // identifier
-                     flow_id_count,                   // flow_id_count
-                     flow_ids,                        // flow_ids
-                     type,                            // type
-                     c_names,                         // names
-                     values                           // values
-  );
+  DispatchTimelineEvent(name, gTimelineMicrosSource.load()(), -1, identifier,
+                        flow_id_count, flow_ids, type, c_names, values);
 }
 
 void TraceEvent0(TraceArg category_group,
@@ -0,0 +1,457 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_ring_buffer.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <utility>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+namespace tracing {
+
+namespace {
+
+std::atomic_bool gEnabled = false;
+
+/// A ring buffer written by a single thread and read by any thread.
+///
+/// Every slot is guarded by a sequence number, which is odd while the slot is
+/// being written, so that readers can detect and skip slots overwritten while
+/// they were being read.
+class ThreadBuffer {
+ public:
+  using Event = TraceRingBuffer::Event;
+
+  void Write(const Event& event) {
+    auto index = next_index_.load(std::memory_order_relaxed);
+    auto& slot = slots_[index % slots_.size()];
+    slot.sequence.store(2u * index + 1u, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.type.store(event.type, std::memory_order_relaxed);
+    slot.timestamp_nanos.store(event.timestamp_nanos,
+                               std::memory_order_relaxed);
+    slot.name.store(event.name, std::memory_order_relaxed);
+    slot.arg_name.store(event.arg_name, std::memory_order_relaxed);
+    slot.id.store(event.id, std::memory_order_relaxed);
+    slot.value.store(event.value, std::memory_order_relaxed);
+    slot.sequence.store(2u * index + 2u, std::memory_order_release);
+    next_index_.store(index + 1u, std::memory_order_release);
+  }
+
+  /// Read the events written since |first_index|, oldest first.
+  std::vector<Event> Read(uint64_t first_index) const {
+    auto end = next_index_.load(std::memory_order_acquire);
+    auto begin = end > slots_.size() ? end - slots_.size() : 0u;
+    begin = std::max(begin, first_index);
+    std::vector<Event> events;
+    events.reserve(end - begin);
+    for (auto index = begin; index < end; index++) {
+      const auto& slot = slots_[index % slots_.size()];
+      auto sequence = slot.sequence.load(std::memory_order_acquire);
+      if (sequence != 2u * index + 2u) {
+        continue;
+      }
+      Event event;
+      event.type = slot.type.load(std::memory_order_relaxed);
+      event.timestamp_nanos =
+          slot.timestamp_nanos.load(std::memory_order_relaxed);
+      event.name = slot.name.load(std::memory_order_relaxed);
+      event.arg_name = slot.arg_name.load(std::memory_order_relaxed);
+      event.id = slot.id.load(std::memory_order_relaxed);
+      event.value = slot.value.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+        continue;
+      }
+      events.push_back(event);
+    }
+    return events;
+  }
+
+  uint64_t GetNextIndex() const {
+    return next_index_.load(std::memory_order_acquire);
+  }
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> sequence = 0u;
+    std::atomic<TraceRingBuffer::EventType> type =
+        TraceRingBuffer::EventType::kInstant;
+    std::atomic<int64_t> timestamp_nanos = 0;
+    std::atomic<const char*> name = nullptr;
+    std::atomic<const char*> arg_name = nullptr;
+    std::atomic<uint64_t> id = 0u;
+    std::atomic<double> value = 0.0;
+  };
+
+  std::array<Slot, TraceRingBuffer::kEventsPerThread> slots_;
+  std::atomic<uint64_t> next_index_ = 0u;
+};
+
+/// The buffers of all threads that recorded events. Buffers are handed to new
+/// threads once their thread exits instead of being freed, so that the events
+/// of exited threads can still be dumped, and so that the memory used is
+/// bounded by the number of threads alive at once.
+class Registry {
+ public:
+  struct Entry {
+    std::unique_ptr<ThreadBuffer> buffer;
+    std::string thread_name;
+    // The index of the first event written by the current thread.
+    uint64_t first_index = 0u;
+    bool in_use = false;
+  };
+
+  static Registry& Get() {
+    // Leaked, as threads may exit after static destructors have run.
+    static Registry* registry = new Registry();
+    return *registry;
+  }
+
+  Entry* Acquire(const std::string& thread_name) {
+    std::scoped_lock lock(mutex_);
+    Entry* entry = nullptr;
+    for (auto& candidate : entries_) {
+      if (!candidate->in_use) {
+        entry = candidate.get();
+        break;
+      }
+    }
+    if (!entry) {
+      entries_.push_back(std::make_unique<Entry>());
+      entry = entries_.back().get();
+      entry->buffer = std::make_unique<ThreadBuffer>();
+    }
+    entry->in_use = true;
+    entry->first_index = entry->buffer->GetNextIndex();
+    entry->thread_name = thread_name.empty()
+                             ? "Thread " + std::to_string(entries_.size())
+                             : thread_name;
+    return entry;
+  }
+
+  void Release(Entry* entry) {
+    std::scoped_lock lock(mutex_);
+    entry->in_use = false;
+  }
+
+  void SetThreadName(Entry* entry, const std::string& thread_name) {
+    std::scoped_lock lock(mutex_);
+    entry->thread_name = thread_name;
+  }
+
+  std::vector<TraceRingBuffer::ThreadEvents> Read() const {
+    std::scoped_lock lock(mutex_);
+    std::vector<TraceRingBuffer::ThreadEvents> threads;
+    for (const auto& entry : entries_) {
+      auto events = entry->buffer->Read(entry->first_index);
+      if (!events.empty()) {
+        threads.push_back({entry->thread_name, std::move(events)});
+      }
+    }
+    return threads;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<Entry>> entries_;
+};
+
+/// The buffer of the current thread, acquired on the first recorded event.
+class ThreadState {
+ public:
+  ~ThreadState() {
+    if (entry_) {
+      Registry::Get().Release(entry_);
+    }
+  }
+
+  ThreadBuffer& GetBuffer() {
+    if (!entry_) {
+      entry_ = Registry::Get().Acquire(thread_name_);
+    }
+    return *entry_->buffer;
+  }
+
+  void SetThreadName(const std::string& thread_name) {
+    thread_name_ = thread_name;
+    if (entry_) {
+      Registry::Get().SetThreadName(entry_, thread_name);
+    }
+  }
+
+ private:
+  Registry::Entry* entry_ = nullptr;
+  std::string thread_name_;
+};
+
+thread_local ThreadState tThreadState;
+
+/// Encodes protobuf messages without depending on the protobuf runtime.
+class ProtoWriter {
+ public:
+  void AddVarInt(uint32_t field, uint64_t value) {
+    WriteTag(field, 0u);
+    WriteVarInt(value);
+  }
+
+  void AddFixed64(uint32_t field, uint64_t value) {
+    WriteTag(field, 1u);
+    for (size_t i = 0; i < sizeof(value); i++) {
+      data_.push_back(static_cast<uint8_t>(value >> (8u * i)));
+    }
+  }
+
+  void AddDouble(uint32_t field, double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    AddFixed64(field, bits);
+  }
+
+  void AddBytes(uint32_t field, const uint8_t* bytes, size_t size) {
+    WriteTag(field, 2u);
+    WriteVarInt(size);
+    data_.insert(data_.end(), bytes, bytes + size);
+  }
+
+  void AddString(uint32_t field, std::string_view string) {
+    AddBytes(field, reinterpret_cast<const uint8_t*>(string.data()),
+             string.size());
+  }
+
+  void AddMessage(uint32_t field, const ProtoWriter& message) {
+    AddBytes(field, message.data_.data(), message.data_.size());
+  }
+
+  std::vector<uint8_t> TakeData() { return std::move(data_); }
+
+ private:
+  std::vector<uint8_t> data_;
+
+  void WriteTag(uint32_t field, uint32_t wire_type) {
+    WriteVarInt((field << 3u) | wire_type);
+  }
+
+  void WriteVarInt(uint64_t value) {
+    while (value >= 0x80u) {
+      data_.push_back(static_cast<uint8_t>(value | 0x80u));
+      value >>= 7u;
+    }
+    data_.push_back(static_cast<uint8_t>(value));
+  }
+};
+
+// Field numbers and enum values of perfetto/protos/perfetto/trace.
+constexpr uint32_t kTracePacketField = 1u;
+constexpr uint32_t kTimestampField = 8u;
+constexpr uint32_t kTrustedPacketSequenceIdField = 10u;
+constexpr uint32_t kTrackEventField = 11u;
+constexpr uint32_t kTimestampClockIdField = 58u;
+constexpr uint32_t kTrackDescriptorField = 60u;
+
+constexpr uint32_t kTrackDescriptorUuidField = 1u;
+constexpr uint32_t kTrackDescriptorNameField = 2u;
+constexpr uint32_t kTrackDescriptorParentUuidField = 5u;
+constexpr uint32_t kTrackDescriptorCounterField = 8u;
+
+constexpr uint32_t kTrackEventTypeField = 9u;
+constexpr uint32_t kTrackEventTrackUuidField = 11u;
+constexpr uint32_t kTrackEventNameField = 23u;
+constexpr uint32_t kTrackEventDoubleCounterValueField = 44u;
+constexpr uint32_t kTrackEventFlowIdsField = 47u;
+constexpr uint32_t kTrackEventTerminatingFlowIdsField = 48u;
+
+constexpr uint64_t kTypeSliceBegin = 1u;
+constexpr uint64_t kTypeSliceEnd = 2u;
+constexpr uint64_t kTypeInstant = 3u;
+constexpr uint64_t kTypeCounter = 4u;
+
+// |fml::TimePoint| uses the monotonic clock on the platforms where traces are
+// most useful.
+constexpr uint64_t kBuiltinClockMonotonic = 3u;
+constexpr uint64_t kSequenceId = 1u;
+
+void AddTrackDescriptor(ProtoWriter& trace,
+                        uint64_t uuid,
+                        std::string_view name,
+                        uint64_t parent_uuid,
+                        bool counter) {
+  ProtoWriter descriptor;
+  descriptor.AddVarInt(kTrackDescriptorUuidField, uuid);
+  descriptor.AddString(kTrackDescriptorNameField, name);
+  if (parent_uuid != 0u) {
+    descriptor.AddVarInt(kTrackDescriptorParentUuidField, parent_uuid);
+  }
+  if (counter) {
+    descriptor.AddMessage(kTrackDescriptorCounterField, ProtoWriter{});
+  }
+  ProtoWriter packet;
+  packet.AddVarInt(kTrustedPacketSequenceIdField, kSequenceId);
+  packet.AddMessage(kTrackDescriptorField, descriptor);
+  trace.AddMessage(kTracePacketField, packet);
+}
+
+}  // namespace
+
+void TraceRingBuffer::SetEnabled(bool enabled) {
+  gEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool TraceRingBuffer::IsEnabled() {
+  return gEnabled.load(std::memory_order_relaxed);
+}
+
+void TraceRingBuffer::Record(EventType type,
+                             const char* name,
+                             uint64_t id,
+                             const char* arg_name,
+                             double value) {
+  if (!IsEnabled()) {
+    return;
+  }
+  RecordAt(TimePoint::Now().ToEpochDelta().ToNanoseconds(), type, name, id,
+           arg_name, value);
+}
+
+void TraceRingBuffer::RecordAt(int64_t timestamp_nanos,
+                               EventType type,
+                               const char* name,
+                               uint64_t id,
+                               const char* arg_name,
+                               double value) {
+  if (!IsEnabled() || name == nullptr) {
+    return;
+  }
+  tThreadState.GetBuffer().Write(Event{.type = type,
+                                       .timestamp_nanos = timestamp_nanos,
+                                       .name = name,
+                                       .arg_name = arg_name,
+                                       .id = id,
+                                       .value = value});
+}
+
+void TraceRingBuffer::SetCurrentThreadName(const std::string& name) {
+  tThreadState.SetThreadName(name);
+}
+
+std::vector<TraceRingBuffer::ThreadEvents> TraceRingBuffer::GetEvents() {
+  return Registry::Get().Read();
+}
+
+std::vector<uint8_t> TraceRingBuffer::SerializeAsPerfettoTrace(
+    const std::vector<ThreadEvents>& threads) {
+  ProtoWriter descriptors;
+  ProtoWriter events;
+
+  // Thread tracks use the UUIDs below the number of threads. Async and
+  // counter tracks are allocated the ones after.
+  uint64_t next_uuid = threads.size() + 1u;
+  std::map<uint64_t, uint64_t> async_tracks;
+  std::map<std::string, uint64_t> counter_tracks;
+
+  for (size_t i = 0; i < threads.size(); i++) {
+    const uint64_t thread_uuid = i + 1u;
+    AddTrackDescriptor(descriptors, thread_uuid, threads[i].thread_name, 0u,
+                       false);
+    for (const auto& event : threads[i].events) {
+      ProtoWriter track_event;
+      uint64_t track_uuid = thread_uuid;
+      switch (event.type) {
+        case EventType::kSliceBegin:
+          track_event.AddVarInt(kTrackEventTypeField, kTypeSliceBegin);
+          if (event.id != 0u) {
+            track_event.AddFixed64(kTrackEventFlowIdsField, event.id);
+          }
+          break;
+        case EventType::kSliceEnd:
+          track_event.AddVarInt(kTrackEventTypeField, kTypeSliceEnd);
+          break;
+        case EventType::kInstant:
+          track_event.AddVarInt(kTrackEventTypeField, kTypeInstant);
+          break;
+        case EventType::kAsyncBegin:
+        case EventType::kAsyncEnd: {
+          auto found = async_tracks.find(event.id);
+          if (found == async_tracks.end()) {
+            found = async_tracks.emplace(event.id, next_uuid++).first;
+            AddTrackDescriptor(descriptors, found->second, event.name,
+                               thread_uuid, false);
+          }
+          track_uuid = found->second;
+          track_event.AddVarInt(kTrackEventTypeField,
+                                event.type == EventType::kAsyncBegin
+                                    ? kTypeSliceBegin
+                                    : kTypeSliceEnd);
+          break;
+        }
+        case EventType::kFlowBegin:
+        case EventType::kFlowStep:
+          track_event.AddVarInt(kTrackEventTypeField, kTypeInstant);
+          track_event.AddFixed64(kTrackEventFlowIdsField, event.id);
+          break;
+        case EventType::kFlowEnd:
+          track_event.AddVarInt(kTrackEventTypeField, kTypeInstant);
+          track_event.AddFixed64(kTrackEventTerminatingFlowIdsField,
+                                 event.id);
+          break;
+        case EventType::kCounter: {
+          std::string counter_name = event.name;
+          if (event.arg_name) {
+            counter_name = counter_name + "." + event.arg_name;
+          }
+          auto found = counter_tracks.find(counter_name);
+          if (found == counter_tracks.end()) {
+            found = counter_tracks.emplace(counter_name, next_uuid++).first;
+            AddTrackDescriptor(descriptors, found->second, counter_name, 0u,
+                               true);
+          }
+          track_uuid = found->second;
+          track_event.AddVarInt(kTrackEventTypeField, kTypeCounter);
+          track_event.AddDouble(kTrackEventDoubleCounterValueField,
+                                event.value);
+          break;
+        }
+      }
+      track_event.AddVarInt(kTrackEventTrackUuidField, track_uuid);
+      if (event.type != EventType::kSliceEnd &&
+          event.type != EventType::kAsyncEnd &&
+          event.type != EventType::kCounter) {
+        track_event.AddString(kTrackEventNameField, event.name);
+      }
+
+      ProtoWriter packet;
+      packet.AddVarInt(kTimestampField, event.timestamp_nanos);
+      packet.AddVarInt(kTimestampClockIdField, kBuiltinClockMonotonic);
+      packet.AddVarInt(kTrustedPacketSequenceIdField, kSequenceId);
+      packet.AddMessage(kTrackEventField, track_event);
+      events.AddMessage(kTracePacketField, packet);
+    }
+  }
+
+  // The tracks are described before the events that refer to them.
+  auto trace = descriptors.TakeData();
+  auto event_data = events.TakeData();
+  trace.insert(trace.end(), event_data.begin(), event_data.end());
+  return trace;
+}
+
+bool TraceRingBuffer::WritePerfettoTrace(const fml::UniqueFD& directory,
+                                         const std::string& file_name) {
+  DataMapping trace(SerializeAsPerfettoTrace(GetEvents()));
+  return fml::WriteAtomically(directory, file_name.c_str(), trace);
+}
+
+}  // namespace tracing
+}  // namespace fml
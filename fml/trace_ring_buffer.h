@@ -0,0 +1,132 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_RING_BUFFER_H_
+#define FLUTTER_FML_TRACE_RING_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace fml {
+namespace tracing {
+
+//------------------------------------------------------------------------------
+/// @brief      Records trace events in a compact binary form into a fixed size
+///             ring buffer per thread, so that tracing can stay enabled in the
+///             field where forwarding every event to the Dart timeline would
+///             be too expensive. The most recent events of all threads can be
+///             written out as a Perfetto trace on demand, such as when a frame
+///             misses its deadline.
+///
+///             Recording is lock-free as each thread only writes to its own
+///             buffer. Only pointers to the event names are recorded, so the
+///             names must outlive the buffers, as the string literals used by
+///             the trace macros do.
+///
+class TraceRingBuffer {
+ public:
+  enum class EventType : uint8_t {
+    kSliceBegin,
+    kSliceEnd,
+    kInstant,
+    kAsyncBegin,
+    kAsyncEnd,
+    kFlowBegin,
+    kFlowStep,
+    kFlowEnd,
+    kCounter,
+  };
+
+  struct Event {
+    EventType type = EventType::kInstant;
+    int64_t timestamp_nanos = 0;
+    const char* name = nullptr;
+    /// The name of the argument of counter events.
+    const char* arg_name = nullptr;
+    /// The identifier of async and flow events, or of the flow a slice
+    /// belongs to. Zero for none.
+    uint64_t id = 0u;
+    /// The value of counter events.
+    double value = 0.0;
+  };
+
+  struct ThreadEvents {
+    std::string thread_name;
+    /// The events still in the buffer of the thread, oldest first.
+    std::vector<Event> events;
+  };
+
+  /// The number of events kept per thread. Older events are overwritten.
+  static constexpr size_t kEventsPerThread = 2048u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Start or stop recording events. Events are not recorded by
+  ///             default.
+  ///
+  static void SetEnabled(bool enabled);
+
+  static bool IsEnabled();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record an event on the buffer of the calling thread, stamped
+  ///             with the current time, if recording is enabled.
+  ///
+  static void Record(EventType type,
+                     const char* name,
+                     uint64_t id = 0u,
+                     const char* arg_name = nullptr,
+                     double value = 0.0);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record an event with an explicit timestamp in nanoseconds on
+  ///             the clock of |fml::TimePoint|.
+  ///
+  static void RecordAt(int64_t timestamp_nanos,
+                       EventType type,
+                       const char* name,
+                       uint64_t id = 0u,
+                       const char* arg_name = nullptr,
+                       double value = 0.0);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Name the track of the calling thread in the dumped traces.
+  ///
+  static void SetCurrentThreadName(const std::string& name);
+
+  //----------------------------------------------------------------------------
+  /// @brief      A snapshot of the events of every thread that recorded any.
+  ///             Events being overwritten while the snapshot is taken are
+  ///             skipped.
+  ///
+  static std::vector<ThreadEvents> GetEvents();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Encode events as a trace in Perfetto's protobuf format, which
+  ///             can be loaded in Perfetto's trace viewer.
+  ///
+  static std::vector<uint8_t> SerializeAsPerfettoTrace(
+      const std::vector<ThreadEvents>& threads);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Write a snapshot of the events as a Perfetto trace to the file
+  ///             named `file_name` in `directory`.
+  ///
+  /// @return     Whether the trace was written.
+  ///
+  static bool WritePerfettoTrace(const fml::UniqueFD& directory,
+                                 const std::string& file_name);
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(TraceRingBuffer);
+};
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TRACE_RING_BUFFER_H_
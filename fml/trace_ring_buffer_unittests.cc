@@ -0,0 +1,82 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_ring_buffer.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+namespace {
+
+// Returns the events recorded by the thread named |thread_name|.
+std::vector<TraceRingBuffer::Event> GetThreadEvents(
+    const std::string& thread_name) {
+  for (auto& thread : TraceRingBuffer::GetEvents()) {
+    if (thread.thread_name == thread_name) {
+      return std::move(thread.events);
+    }
+  }
+  return {};
+}
+
+}  // namespace
+
+TEST(TraceRingBufferTest, RecordsNothingWhenDisabled) {
+  std::thread thread([] {
+    TraceRingBuffer::SetCurrentThreadName("disabled");
+    TraceRingBuffer::Record(TraceRingBuffer::EventType::kInstant, "event");
+  });
+  thread.join();
+  EXPECT_TRUE(GetThreadEvents("disabled").empty());
+}
+
+TEST(TraceRingBufferTest, KeepsTheMostRecentEventsOfEachThread) {
+  TraceRingBuffer::SetEnabled(true);
+  std::thread thread([] {
+    TraceRingBuffer::SetCurrentThreadName("recent");
+    for (size_t i = 0; i < TraceRingBuffer::kEventsPerThread + 10u; i++) {
+      TraceRingBuffer::Record(TraceRingBuffer::EventType::kCounter, "counter",
+                              0u, "value", static_cast<double>(i));
+    }
+  });
+  thread.join();
+  TraceRingBuffer::SetEnabled(false);
+
+  auto events = GetThreadEvents("recent");
+  ASSERT_EQ(events.size(), TraceRingBuffer::kEventsPerThread);
+  EXPECT_EQ(events.front().value, 10.0);
+  EXPECT_EQ(events.back().value,
+            static_cast<double>(TraceRingBuffer::kEventsPerThread + 9u));
+  EXPECT_STREQ(events.back().arg_name, "value");
+  for (size_t i = 1; i < events.size(); i++) {
+    EXPECT_LE(events[i - 1].timestamp_nanos, events[i].timestamp_nanos);
+  }
+}
+
+TEST(TraceRingBufferTest, SerializesEventsAsPerfettoTrace) {
+  TraceRingBuffer::ThreadEvents thread;
+  thread.thread_name = "serialized";
+  thread.events.push_back({.type = TraceRingBuffer::EventType::kSliceBegin,
+                           .timestamp_nanos = 1,
+                           .name = "slice"});
+  thread.events.push_back({.type = TraceRingBuffer::EventType::kSliceEnd,
+                           .timestamp_nanos = 2,
+                           .name = "slice"});
+  auto trace = TraceRingBuffer::SerializeAsPerfettoTrace({thread});
+  ASSERT_FALSE(trace.empty());
+  // Every top level field is a length delimited TracePacket.
+  EXPECT_EQ(trace[0], (1u << 3u) | 2u);
+  std::string data(trace.begin(), trace.end());
+  EXPECT_NE(data.find("serialized"), std::string::npos);
+  EXPECT_NE(data.find("slice"), std::string::npos);
+}
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
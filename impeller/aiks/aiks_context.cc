@@ -53,7 +53,12 @@ bool AiksContext::Render(const Picture& picture,
   }
 
   fml::ScopedCleanupClosure closure([&]() {
-    if (reset_host_buffer) {
+    if (!reset_host_buffer) {
+      return;
+    }
+    if (in_frame_batch_) {
+      reset_host_buffer_after_batch_ = true;
+    } else {
       content_context_->GetTransientsBuffer().Reset();
     }
   });
@@ -64,4 +69,25 @@ bool AiksContext::Render(const Picture& picture,
   return true;
 }
 
+void AiksContext::BeginFrameBatch() {
+  if (!IsValid()) {
+    return;
+  }
+  FML_DCHECK(!in_frame_batch_);
+  in_frame_batch_ = true;
+  content_context_->GetLazyGlyphAtlas()->BeginFrameBatch();
+}
+
+void AiksContext::EndFrameBatch() {
+  if (!IsValid() || !in_frame_batch_) {
+    return;
+  }
+  in_frame_batch_ = false;
+  content_context_->GetLazyGlyphAtlas()->EndFrameBatch();
+  if (reset_host_buffer_after_batch_) {
+    reset_host_buffer_after_batch_ = false;
+    content_context_->GetTransientsBuffer().Reset();
+  }
+}
+
 }  // namespace impeller
@@ -47,10 +47,26 @@ class AiksContext {
               RenderTarget& render_target,
               bool reset_host_buffer);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Begins a batch of renders that draw the views of one frame.
+  ///
+  ///             Until `EndFrameBatch`, the renders share the transients
+  ///             buffer of a single frame instead of each resetting it, and
+  ///             share their glyph atlases. See
+  ///             `LazyGlyphAtlas::BeginFrameBatch`.
+  ///
+  void BeginFrameBatch();
+
+  void EndFrameBatch();
+
  private:
   std::shared_ptr<Context> context_;
   std::unique_ptr<ContentContext> content_context_;
   bool is_valid_ = false;
+  bool in_frame_batch_ = false;
+  // Whether a render of the batch asked for the transients buffer to be reset,
+  // which is done once the batch ends.
+  bool reset_host_buffer_after_batch_ = false;
 
   AiksContext(const AiksContext&) = delete;
 
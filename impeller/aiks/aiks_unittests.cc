@@ -1867,6 +1867,38 @@ TEST_P(AiksTest, OpacityPeepHoleApplicationTest) {
   ASSERT_TRUE(delegate->CanCollapseIntoParentPass(entity_pass.get()));
 }
 
+TEST_P(AiksTest, OpacityPeepHoleFoldsColorFiltersIntoSolidColors) {
+  auto entity_pass = std::make_shared<EntityPass>();
+  for (int i = 0; i < 4; i++) {
+    Entity entity;
+    entity.SetContents(SolidColorContents::Make(
+        PathBuilder{}.AddRect(Rect::MakeXYWH(i * 20, 0, 10, 10)).TakePath(),
+        Color::Red()));
+    entity_pass->AddEntity(std::move(entity));
+  }
+  Paint paint;
+  paint.color = Color::White().WithAlpha(0.5);
+  paint.color_filter =
+      ColorFilter::MakeBlend(BlendMode::kSourceIn, Color::Blue());
+
+  auto delegate = std::make_shared<OpacityPeepholePassDelegate>(paint);
+  ASSERT_TRUE(delegate->CanCollapseIntoParentPass(entity_pass.get()));
+  entity_pass->IterateAllEntities([](Entity& entity) {
+    EXPECT_EQ(entity.GetContents()->AsSolidColor()->GetColor(),
+              Color::Blue().WithAlpha(0.5));
+    return true;
+  });
+
+  // Overlapping entities can't inherit the opacity or the color filter.
+  Entity entity;
+  entity.SetContents(SolidColorContents::Make(
+      PathBuilder{}.AddRect(Rect::MakeXYWH(5, 5, 10, 10)).TakePath(),
+      Color::Red()));
+  entity_pass->AddEntity(std::move(entity));
+  delegate = std::make_shared<OpacityPeepholePassDelegate>(paint);
+  ASSERT_FALSE(delegate->CanCollapseIntoParentPass(entity_pass.get()));
+}
+
 TEST_P(AiksTest, DrawPaintAbsorbsClears) {
   Canvas canvas;
   canvas.DrawPaint({.color = Color::Red(), .blend_mode = BlendMode::kSource});
@@ -1994,6 +2026,51 @@ TEST_P(AiksTest, DrawRectAbsorbsClearsNegative) {
   ASSERT_EQ(render_pass->GetCommands().size(), 2llu);
 }
 
+TEST_P(AiksTest, DrawsOutsideOfClipAreNotRecorded) {
+  Canvas canvas(Rect::MakeXYWH(0, 0, 100, 100));
+  canvas.DrawRect(Rect::MakeXYWH(200, 200, 10, 10), {.color = Color::Red()});
+  canvas.ClipRect(Rect::MakeXYWH(0, 0, 50, 50));
+  canvas.DrawRect(Rect::MakeXYWH(60, 60, 10, 10), {.color = Color::Red()});
+  canvas.DrawRect(Rect::MakeXYWH(40, 40, 20, 20), {.color = Color::Blue()});
+
+  Picture picture = canvas.EndRecordingAsPicture();
+  std::vector<Color> colors;
+  picture.pass->IterateAllEntities([&colors](Entity& entity) {
+    if (const auto* contents = entity.GetContents()->AsSolidColor()) {
+      colors.push_back(contents->GetColor());
+    }
+    return true;
+  });
+#ifdef IMPELLER_CONTENT_CULLING
+  ASSERT_EQ(colors.size(), 1u);
+  EXPECT_EQ(colors[0], Color::Blue());
+#else
+  EXPECT_EQ(colors.size(), 3u);
+#endif  // IMPELLER_CONTENT_CULLING
+}
+
+TEST_P(AiksTest, DrawsCoveredByLaterSourceRectAreSkipped) {
+  Canvas canvas;
+  canvas.DrawOval(Rect::MakeXYWH(10, 10, 50, 80), {.color = Color::Red()});
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 100, 100),
+                  {.color = Color::Blue(), .blend_mode = BlendMode::kSource});
+
+  std::shared_ptr<ContextSpy> spy = ContextSpy::Make();
+  Picture picture = canvas.EndRecordingAsPicture();
+  std::shared_ptr<Context> real_context = GetContext();
+  std::shared_ptr<ContextMock> mock_context = spy->MakeContext(real_context);
+  AiksContext renderer(mock_context, nullptr);
+  std::shared_ptr<Image> image = picture.ToImage(renderer, {300, 300});
+
+  ASSERT_EQ(spy->render_passes_.size(), 1llu);
+  std::shared_ptr<RenderPass> render_pass = spy->render_passes_[0];
+#ifdef IMPELLER_CONTENT_CULLING
+  EXPECT_EQ(render_pass->GetCommands().size(), 1llu);
+#else
+  EXPECT_EQ(render_pass->GetCommands().size(), 2llu);
+#endif  // IMPELLER_CONTENT_CULLING
+}
+
 TEST_P(AiksTest, ClipRectElidesNoOpClips) {
   Canvas canvas(Rect::MakeXYWH(0, 0, 100, 100));
   canvas.ClipRect(Rect::MakeXYWH(0, 0, 100, 100));
@@ -2290,6 +2367,34 @@ TEST_P(AiksTest, TranslucentSaveLayerWithColorAndImageFilterDrawsCorrectly) {
   ASSERT_TRUE(OpenPlaygroundHere(canvas.EndRecordingAsPicture()));
 }
 
+TEST_P(AiksTest, MorphologyFiltersAtIncreasingRadii) {
+  // The radii on either side of the single pass limit, and large radii that
+  // are split into several passes.
+  const Scalar radii[] = {2, 8, 16, 17, 32, 64};
+  Canvas canvas;
+  canvas.Scale(GetContentScale());
+  canvas.DrawPaint({.color = Color::White()});
+
+  for (int row = 0; row < 2; row++) {
+    bool dilate = row == 0;
+    for (size_t i = 0; i < std::size(radii); i++) {
+      Radius radius{radii[i]};
+      canvas.Save();
+      canvas.Translate({50.0f + i * 160.0f, 80.0f + row * 260.0f});
+      auto filter = dilate ? ImageFilter::MakeDilate(radius, radius)
+                           : ImageFilter::MakeErode(radius, radius);
+      canvas.SaveLayer({.image_filter = filter});
+      canvas.DrawRect(Rect::MakeXYWH(0, 0, 140, 140),
+                      {.color = Color::Blue()});
+      canvas.DrawCircle({70, 70}, 20, {.color = Color::Yellow()});
+      canvas.Restore();
+      canvas.Restore();
+    }
+  }
+
+  ASSERT_TRUE(OpenPlaygroundHere(canvas.EndRecordingAsPicture()));
+}
+
 TEST_P(AiksTest, ImageFilteredSaveLayerWithUnboundedContents) {
   Canvas canvas;
   canvas.Scale(GetContentScale());
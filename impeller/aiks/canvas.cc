@@ -11,6 +11,7 @@
 #include "flutter/fml/trace_event.h"
 #include "impeller/aiks/image_filter.h"
 #include "impeller/aiks/paint_pass_delegate.h"
+#include "impeller/base/arena.h"
 #include "impeller/entity/contents/atlas_contents.h"
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/color_source_contents.h"
@@ -290,7 +291,7 @@ void Canvas::DrawPath(Path path, const Paint& paint) {
   entity.SetBlendMode(paint.blend_mode);
   entity.SetContents(CreatePathContentsWithFilters(paint, std::move(path)));
 
-  GetCurrentPass().AddEntity(std::move(entity));
+  AddRenderEntityToCurrentPass(std::move(entity));
 }
 
 void Canvas::DrawPaint(const Paint& paint) {
@@ -300,7 +301,7 @@ void Canvas::DrawPaint(const Paint& paint) {
   entity.SetBlendMode(paint.blend_mode);
   entity.SetContents(CreateCoverContentsWithFilters(paint));
 
-  GetCurrentPass().AddEntity(std::move(entity));
+  AddRenderEntityToCurrentPass(std::move(entity));
 }
 
 bool Canvas::AttemptDrawBlurredRRect(const Rect& rect,
@@ -325,7 +326,7 @@ bool Canvas::AttemptDrawBlurredRRect(const Rect& rect,
   // For symmetrically mask blurred solid RRects, absorb the mask blur and use
   // a faster SDF approximation.
 
-  auto contents = std::make_shared<SolidRRectBlurContents>();
+  auto contents = MakeShared<SolidRRectBlurContents>();
   contents->SetColor(new_paint.color);
   contents->SetSigma(new_paint.mask_blur_descriptor->sigma);
   contents->SetRRect(rect, corner_radius);
@@ -338,7 +339,7 @@ bool Canvas::AttemptDrawBlurredRRect(const Rect& rect,
   entity.SetBlendMode(new_paint.blend_mode);
   entity.SetContents(new_paint.WithFilters(std::move(contents)));
 
-  GetCurrentPass().AddEntity(std::move(entity));
+  AddRenderEntityToCurrentPass(std::move(entity));
 
   return true;
 }
@@ -351,7 +352,7 @@ void Canvas::DrawLine(const Point& p0, const Point& p1, const Paint& paint) {
   entity.SetContents(CreateContentsForGeometryWithFilters(
       paint, Geometry::MakeLine(p0, p1, paint.stroke_width, paint.stroke_cap)));
 
-  GetCurrentPass().AddEntity(std::move(entity));
+  AddRenderEntityToCurrentPass(std::move(entity));
 }
 
 void Canvas::DrawRect(const Rect& rect, const Paint& paint) {
@@ -371,7 +372,7 @@ void Canvas::DrawRect(const Rect& rect, const Paint& paint) {
   entity.SetContents(
       CreateContentsForGeometryWithFilters(paint, Geometry::MakeRect(rect)));
 
-  GetCurrentPass().AddEntity(std::move(entity));
+  AddRenderEntityToCurrentPass(std::move(entity));
 }
 
 void Canvas::DrawOval(const Rect& rect, const Paint& paint) {
@@ -398,7 +399,7 @@ void Canvas::DrawOval(const Rect& rect, const Paint& paint) {
   entity.SetContents(
       CreateContentsForGeometryWithFilters(paint, Geometry::MakeOval(rect)));
 
-  GetCurrentPass().AddEntity(std::move(entity));
+  AddRenderEntityToCurrentPass(std::move(entity));
 }
 
 void Canvas::DrawRRect(const Rect& rect,
@@ -417,7 +418,7 @@ void Canvas::DrawRRect(const Rect& rect,
     entity.SetContents(CreateContentsForGeometryWithFilters(
         paint, Geometry::MakeRoundRect(rect, corner_radii)));
 
-    GetCurrentPass().AddEntity(std::move(entity));
+    AddRenderEntityToCurrentPass(std::move(entity));
     return;
   }
 
@@ -450,7 +451,7 @@ void Canvas::DrawCircle(const Point& center,
   entity.SetContents(
       CreateContentsForGeometryWithFilters(paint, std::move(geometry)));
 
-  GetCurrentPass().AddEntity(std::move(entity));
+  AddRenderEntityToCurrentPass(std::move(entity));
 }
 
 void Canvas::ClipPath(Path path, Entity::ClipOperation clip_op) {
@@ -546,7 +547,7 @@ void Canvas::ClipRRect(const Rect& rect,
 
 void Canvas::ClipGeometry(const std::shared_ptr<Geometry>& geometry,
                           Entity::ClipOperation clip_op) {
-  auto contents = std::make_shared<ClipContents>();
+  auto contents = MakeShared<ClipContents>();
   contents->SetGeometry(geometry);
   contents->SetClipOperation(clip_op);
 
@@ -591,7 +592,7 @@ void Canvas::RestoreClip() {
   entity.SetTransform(GetCurrentTransform());
   // This path is empty because ClipRestoreContents just generates a quad that
   // takes up the full render target.
-  entity.SetContents(std::make_shared<ClipRestoreContents>());
+  entity.SetContents(MakeShared<ClipRestoreContents>());
   entity.SetClipDepth(GetClipDepth());
 
   GetCurrentPass().AddEntity(std::move(entity));
@@ -614,7 +615,7 @@ void Canvas::DrawPoints(std::vector<Point> points,
       Geometry::MakePointField(std::move(points), radius,
                                /*round=*/point_style == PointStyle::kRound)));
 
-  GetCurrentPass().AddEntity(std::move(entity));
+  AddRenderEntityToCurrentPass(std::move(entity));
 }
 
 void Canvas::DrawPicture(const Picture& picture) {
@@ -691,7 +692,7 @@ void Canvas::DrawImageRect(const std::shared_ptr<Image>& image,
   entity.SetContents(paint.WithFilters(contents));
   entity.SetTransform(GetCurrentTransform());
 
-  GetCurrentPass().AddEntity(std::move(entity));
+  AddRenderEntityToCurrentPass(std::move(entity));
 }
 
 Picture Canvas::EndRecordingAsPicture() {
@@ -709,6 +710,22 @@ EntityPass& Canvas::GetCurrentPass() {
   return *current_pass_;
 }
 
+void Canvas::AddRenderEntityToCurrentPass(Entity entity) {
+#ifdef IMPELLER_CONTENT_CULLING
+  // Entities that fall entirely outside of the current clip are never visible,
+  // so don't bother recording them.
+  const auto& cull_rect = transform_stack_.back().cull_rect;
+  if (cull_rect.has_value()) {
+    auto coverage = entity.GetCoverage();
+    if (!coverage.has_value() ||
+        !cull_rect->IntersectsWithRect(coverage.value())) {
+      return;
+    }
+  }
+#endif  // IMPELLER_CONTENT_CULLING
+  GetCurrentPass().AddEntity(std::move(entity));
+}
+
 size_t Canvas::GetClipDepth() const {
   return transform_stack_.back().clip_depth;
 }
@@ -752,7 +769,7 @@ void Canvas::DrawTextFrame(const std::shared_ptr<TextFrame>& text_frame,
   entity.SetClipDepth(GetClipDepth());
   entity.SetBlendMode(paint.blend_mode);
 
-  auto text_contents = std::make_shared<TextContents>();
+  auto text_contents = MakeShared<TextContents>();
   text_contents->SetTextFrame(text_frame);
   text_contents->SetColor(paint.color);
   text_contents->SetForceTextColor(paint.mask_blur_descriptor.has_value());
@@ -769,7 +786,7 @@ void Canvas::DrawTextFrame(const std::shared_ptr<TextFrame>& text_frame,
   entity.SetContents(
       paint.WithFilters(paint.WithMaskBlur(std::move(text_contents), true)));
 
-  GetCurrentPass().AddEntity(std::move(entity));
+  AddRenderEntityToCurrentPass(std::move(entity));
 }
 
 static bool UseColorSourceContents(
@@ -808,7 +825,7 @@ void Canvas::DrawVertices(const std::shared_ptr<VerticesGeometry>& vertices,
   // are vertex coordinates then only if the contents are an image.
   if (UseColorSourceContents(vertices, paint)) {
     entity.SetContents(CreateContentsForGeometryWithFilters(paint, vertices));
-    GetCurrentPass().AddEntity(std::move(entity));
+    AddRenderEntityToCurrentPass(std::move(entity));
     return;
   }
 
@@ -839,14 +856,14 @@ void Canvas::DrawVertices(const std::shared_ptr<VerticesGeometry>& vertices,
         src_paint.CreateContentsForGeometry(Geometry::MakeRect(src_coverage));
   }
 
-  auto contents = std::make_shared<VerticesContents>();
+  auto contents = MakeShared<VerticesContents>();
   contents->SetAlpha(paint.color.alpha);
   contents->SetBlendMode(blend_mode);
   contents->SetGeometry(vertices);
   contents->SetSourceContents(std::move(src_contents));
   entity.SetContents(paint.WithFilters(std::move(contents)));
 
-  GetCurrentPass().AddEntity(std::move(entity));
+  AddRenderEntityToCurrentPass(std::move(entity));
 }
 
 void Canvas::DrawAtlas(const std::shared_ptr<Image>& atlas,
@@ -861,7 +878,7 @@ void Canvas::DrawAtlas(const std::shared_ptr<Image>& atlas,
     return;
   }
 
-  std::shared_ptr<AtlasContents> contents = std::make_shared<AtlasContents>();
+  std::shared_ptr<AtlasContents> contents = MakeShared<AtlasContents>();
   contents->SetColors(std::move(colors));
   contents->SetTransforms(std::move(transforms));
   contents->SetTextureCoordinates(std::move(texture_coordinates));
@@ -877,7 +894,7 @@ void Canvas::DrawAtlas(const std::shared_ptr<Image>& atlas,
   entity.SetBlendMode(paint.blend_mode);
   entity.SetContents(paint.WithFilters(contents));
 
-  GetCurrentPass().AddEntity(std::move(entity));
+  AddRenderEntityToCurrentPass(std::move(entity));
 }
 
 }  // namespace impeller
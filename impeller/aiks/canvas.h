@@ -15,6 +15,7 @@
 #include "impeller/aiks/image_filter.h"
 #include "impeller/aiks/paint.h"
 #include "impeller/aiks/picture.h"
+#include "impeller/base/arena.h"
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/entity_pass.h"
@@ -179,6 +180,11 @@ class Canvas {
   Picture EndRecordingAsPicture();
 
  private:
+  // The contents and geometry of the entities recorded on this thread are
+  // allocated from the arena of the canvas, which is freed at once when the
+  // last of them is released rather than object by object.
+  std::shared_ptr<Arena> arena_ = Arena::Create();
+  Arena::Scope arena_scope_{arena_};
   std::unique_ptr<EntityPass> base_pass_;
   EntityPass* current_pass_ = nullptr;
   std::deque<CanvasStackEntry> transform_stack_;
@@ -190,6 +196,12 @@ class Canvas {
 
   EntityPass& GetCurrentPass();
 
+  //----------------------------------------------------------------------------
+  /// @brief  Adds an entity that draws to the current pass unless it is
+  ///         entirely outside of the current clip.
+  ///
+  void AddRenderEntityToCurrentPass(Entity entity);
+
   size_t GetClipDepth() const;
 
   void ClipGeometry(const std::shared_ptr<Geometry>& geometry,
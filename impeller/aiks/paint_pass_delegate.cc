@@ -4,6 +4,7 @@
 
 #include "impeller/aiks/paint_pass_delegate.h"
 
+#include "flutter/fml/logging.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/entity/contents/contents.h"
@@ -13,6 +14,19 @@
 
 namespace impeller {
 
+namespace {
+
+// The most elements of a pass whose opacity and color filter are folded into
+// its entities.
+constexpr size_t kMaxCollapsedElementCount = 16u;
+
+bool IsClip(const Entity& entity) {
+  return entity.GetContents()->GetClipCoverage(entity, std::nullopt).type !=
+         Contents::ClipCoverage::Type::kNoChange;
+}
+
+}  // namespace
+
 /// PaintPassDelegate
 /// ----------------------------------------------
 
@@ -34,11 +48,12 @@ bool PaintPassDelegate::CanCollapseIntoParentPass(EntityPass* entity_pass) {
 // |EntityPassDelgate|
 std::shared_ptr<Contents> PaintPassDelegate::CreateContentsForSubpassTarget(
     std::shared_ptr<Texture> target,
+    ISize size,
     const Matrix& effect_transform) {
-  auto contents = TextureContents::MakeRect(Rect::MakeSize(target->GetSize()));
+  auto contents = TextureContents::MakeRect(Rect::MakeSize(size));
   contents->SetTexture(target);
   contents->SetLabel("Subpass");
-  contents->SetSourceRect(Rect::MakeSize(target->GetSize()));
+  contents->SetSourceRect(Rect::MakeSize(size));
   contents->SetOpacity(paint_.color.alpha);
   contents->SetDeferApplyingOpacity(true);
 
@@ -46,6 +61,11 @@ std::shared_ptr<Contents> PaintPassDelegate::CreateContentsForSubpassTarget(
                                             effect_transform);
 }
 
+// |EntityPassDelgate|
+bool PaintPassDelegate::DrawsSubpassTargetDirectly() const {
+  return !paint_.image_filter && !paint_.HasColorFilter();
+}
+
 // |EntityPassDelgate|
 std::shared_ptr<FilterContents> PaintPassDelegate::WithImageFilter(
     const FilterInput::Variant& input,
@@ -71,6 +91,12 @@ bool OpacityPeepholePassDelegate::CanElide() {
 // |EntityPassDelgate|
 bool OpacityPeepholePassDelegate::CanCollapseIntoParentPass(
     EntityPass* entity_pass) {
+  // The opacity and color filter were already folded into the entities of
+  // this pass when it was rendered before.
+  if (collapsed_) {
+    return true;
+  }
+
   // Passes with absorbed clips can not be safely collapsed.
   if (entity_pass->GetBoundsLimit().has_value()) {
     return false;
@@ -78,35 +104,47 @@ bool OpacityPeepholePassDelegate::CanCollapseIntoParentPass(
 
   // OpacityPeepholePassDelegate will only get used if the pass's blend mode is
   // SourceOver, so no need to check here.
-  if (paint_.color.alpha <= 0.0 || paint_.color.alpha >= 1.0 ||
-      paint_.image_filter || paint_.color_filter) {
+  auto alpha = paint_.color.alpha;
+  if (alpha <= 0.0 || paint_.image_filter) {
+    return false;
+  }
+  std::shared_ptr<ColorFilter> color_filter = paint_.GetColorFilter();
+  if (alpha >= 1.0 && !color_filter) {
     return false;
   }
+  ColorFilter::ColorFilterProc color_filter_proc;
+  if (color_filter) {
+    color_filter_proc = color_filter->GetCPUColorFilterProc();
+    // The color filter of the layer also applies to the transparent pixels
+    // between the entities, which folding it into them would leave out.
+    if (color_filter_proc(Color::BlackTransparent()).alpha > 0.0) {
+      return false;
+    }
+  }
 
-  // Note: determing whether any coverage intersects has quadradic complexity in
-  // the number of rectangles, and depending on whether or not we cache at
-  // different levels of the entity tree may end up cubic. In the interest of
-  // proving whether or not this optimization is valuable, we only consider very
-  // simple peephole optimizations here - where there is a single drawing
-  // command wrapped in save layer. This would indicate something like an
-  // Opacity or FadeTransition wrapping a very simple widget, like in the
-  // CupertinoPicker.
-  if (entity_pass->GetElementCount() > 3) {
-    // Single paint command with a save layer would be:
-    // 1. clip
-    // 2. draw command
-    // 3. restore.
+  // Note: determing whether any coverage intersects has quadradic complexity
+  // in the number of rectangles, so only passes with a few elements, such as
+  // an Opacity or FadeTransition wrapping a simple widget like in the
+  // CupertinoPicker, are considered.
+  if (entity_pass->GetElementCount() > kMaxCollapsedElementCount) {
     return false;
   }
   bool all_can_accept = true;
   std::vector<Rect> all_coverages;
   auto had_subpass = entity_pass->IterateUntilSubpass(
-      [&all_coverages, &all_can_accept](Entity& entity) {
+      [&all_coverages, &all_can_accept, &color_filter_proc](Entity& entity) {
         const auto& contents = entity.GetContents();
         if (!entity.CanInheritOpacity()) {
           all_can_accept = false;
           return false;
         }
+        // Only solid colors are known to accept any color filter, and clips
+        // don't draw colors the filter would apply to.
+        if (color_filter_proc && !IsClip(entity) &&
+            contents->AsSolidColor() == nullptr) {
+          all_can_accept = false;
+          return false;
+        }
         auto maybe_coverage = contents->GetCoverage(entity);
         if (maybe_coverage.has_value()) {
           auto coverage = maybe_coverage.value();
@@ -123,11 +161,19 @@ bool OpacityPeepholePassDelegate::CanCollapseIntoParentPass(
   if (had_subpass || !all_can_accept) {
     return false;
   }
-  auto alpha = paint_.color.alpha;
-  entity_pass->IterateUntilSubpass([&alpha](Entity& entity) {
-    entity.SetInheritedOpacity(alpha);
-    return true;
-  });
+  entity_pass->IterateUntilSubpass(
+      [&alpha, &color_filter_proc](Entity& entity) {
+        // Inheriting the opacity first turns opaque sources into source-over
+        // draws, which the color filter may make translucent.
+        entity.SetInheritedOpacity(alpha);
+        if (color_filter_proc && !IsClip(entity)) {
+          [[maybe_unused]] bool applied =
+              entity.GetContents()->ApplyColorFilter(color_filter_proc);
+          FML_DCHECK(applied);
+        }
+        return true;
+      });
+  collapsed_ = true;
   return true;
 }
 
@@ -135,11 +181,12 @@ bool OpacityPeepholePassDelegate::CanCollapseIntoParentPass(
 std::shared_ptr<Contents>
 OpacityPeepholePassDelegate::CreateContentsForSubpassTarget(
     std::shared_ptr<Texture> target,
+    ISize size,
     const Matrix& effect_transform) {
-  auto contents = TextureContents::MakeRect(Rect::MakeSize(target->GetSize()));
+  auto contents = TextureContents::MakeRect(Rect::MakeSize(size));
   contents->SetLabel("Subpass");
   contents->SetTexture(target);
-  contents->SetSourceRect(Rect::MakeSize(target->GetSize()));
+  contents->SetSourceRect(Rect::MakeSize(size));
   contents->SetOpacity(paint_.color.alpha);
   contents->SetDeferApplyingOpacity(true);
 
@@ -147,6 +194,11 @@ OpacityPeepholePassDelegate::CreateContentsForSubpassTarget(
                                             effect_transform);
 }
 
+// |EntityPassDelgate|
+bool OpacityPeepholePassDelegate::DrawsSubpassTargetDirectly() const {
+  return !paint_.image_filter && !paint_.HasColorFilter();
+}
+
 // |EntityPassDelgate|
 std::shared_ptr<FilterContents> OpacityPeepholePassDelegate::WithImageFilter(
     const FilterInput::Variant& input,
@@ -29,8 +29,12 @@ class PaintPassDelegate final : public EntityPassDelegate {
   // |EntityPassDelgate|
   std::shared_ptr<Contents> CreateContentsForSubpassTarget(
       std::shared_ptr<Texture> target,
+      ISize size,
       const Matrix& effect_transform) override;
 
+  // |EntityPassDelgate|
+  bool DrawsSubpassTargetDirectly() const override;
+
   // |EntityPassDelgate|
   std::shared_ptr<FilterContents> WithImageFilter(
       const FilterInput::Variant& input,
@@ -44,10 +48,12 @@ class PaintPassDelegate final : public EntityPassDelegate {
   PaintPassDelegate& operator=(const PaintPassDelegate&) = delete;
 };
 
-/// A delegate that attempts to forward opacity from a save layer to
-/// child contents.
+/// A delegate that attempts to forward opacity and color filters from a save
+/// layer to child contents, so that the layer doesn't need an offscreen
+/// texture.
 ///
-/// Currently this has a hardcoded limit of 3 entities in a pass, and
+/// Currently this has a hardcoded limit of 16 elements in a pass whose
+/// coverages don't overlap, only forwards color filters to solid colors, and
 /// cannot forward to child subpass delegates.
 class OpacityPeepholePassDelegate final : public EntityPassDelegate {
  public:
@@ -65,8 +71,12 @@ class OpacityPeepholePassDelegate final : public EntityPassDelegate {
   // |EntityPassDelgate|
   std::shared_ptr<Contents> CreateContentsForSubpassTarget(
       std::shared_ptr<Texture> target,
+      ISize size,
       const Matrix& effect_transform) override;
 
+  // |EntityPassDelgate|
+  bool DrawsSubpassTargetDirectly() const override;
+
   // |EntityPassDelgate|
   std::shared_ptr<FilterContents> WithImageFilter(
       const FilterInput::Variant& input,
@@ -74,6 +84,7 @@ class OpacityPeepholePassDelegate final : public EntityPassDelegate {
 
  private:
   const Paint paint_;
+  bool collapsed_ = false;
 
   OpacityPeepholePassDelegate(const OpacityPeepholePassDelegate&) = delete;
 
@@ -0,0 +1,74 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/base/arena.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+
+namespace impeller {
+
+namespace {
+
+std::shared_ptr<Arena>& CurrentArena() {
+  static thread_local std::shared_ptr<Arena> current;
+  return current;
+}
+
+}  // namespace
+
+std::shared_ptr<Arena> Arena::Create() {
+  return std::shared_ptr<Arena>(new Arena());
+}
+
+Arena::Arena() = default;
+
+Arena::~Arena() = default;
+
+void* Arena::Allocate(size_t size, size_t alignment) {
+  auto address = reinterpret_cast<uintptr_t>(cursor_);
+  auto aligned = (address + alignment - 1) & ~(alignment - 1);
+  if (cursor_ != nullptr &&
+      aligned + size <= reinterpret_cast<uintptr_t>(end_)) {
+    cursor_ = reinterpret_cast<uint8_t*>(aligned + size);
+    return reinterpret_cast<void*>(aligned);
+  }
+
+  // Allocations larger than a block get a block of their own, and the
+  // current block is kept for the smaller allocations that follow.
+  size_t block_size = std::max(kBlockSize, size + alignment);
+  auto block = std::make_unique<uint8_t[]>(block_size);
+  auto start = reinterpret_cast<uintptr_t>(block.get());
+  aligned = (start + alignment - 1) & ~(alignment - 1);
+  if (block_size == kBlockSize) {
+    cursor_ = reinterpret_cast<uint8_t*>(aligned + size);
+    end_ = block.get() + block_size;
+  }
+  blocks_.push_back(std::move(block));
+  return reinterpret_cast<void*>(aligned);
+}
+
+size_t Arena::GetBlockCount() const {
+  return blocks_.size();
+}
+
+const std::shared_ptr<Arena>& Arena::GetCurrent() {
+  return CurrentArena();
+}
+
+Arena::Scope::Scope(std::shared_ptr<Arena> arena)
+    : previous_(std::exchange(CurrentArena(), std::move(arena))),
+      thread_id_(std::this_thread::get_id()) {}
+
+Arena::Scope::~Scope() {
+  // A scope destroyed on another thread leaves that thread's arena alone
+  // rather than replacing it with one from the thread it was created on.
+  FML_DCHECK(thread_id_ == std::this_thread::get_id());
+  if (thread_id_ == std::this_thread::get_id()) {
+    CurrentArena() = std::move(previous_);
+  }
+}
+
+}  // namespace impeller
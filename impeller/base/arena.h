@@ -0,0 +1,130 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_BASE_ARENA_H_
+#define FLUTTER_IMPELLER_BASE_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A bump allocator for the many small, short-lived objects of a
+///             recording, such as the contents and geometry of its entities.
+///
+///             Memory is never returned to the arena piecemeal. All of it is
+///             released at once when the arena is destroyed, which happens
+///             when the last object allocated from it with an
+///             `ArenaAllocator` is destroyed, since those keep it alive.
+///
+///             An arena isn't thread safe. It is only allocated from on the
+///             thread it is current on.
+///
+class Arena final {
+ public:
+  /// The size of the blocks that the arena allocates from.
+  static constexpr size_t kBlockSize = 16u * 1024u;
+
+  static std::shared_ptr<Arena> Create();
+
+  ~Arena();
+
+  void* Allocate(size_t size, size_t alignment);
+
+  size_t GetBlockCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The arena that `MakeShared` allocates from on this thread, if
+  ///             any.
+  ///
+  static const std::shared_ptr<Arena>& GetCurrent();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Makes an arena current on this thread for its lifetime, and
+  ///             restores the previous one when it is destroyed.
+  ///
+  class Scope final {
+   public:
+    explicit Scope(std::shared_ptr<Arena> arena);
+
+    ~Scope();
+
+   private:
+    std::shared_ptr<Arena> previous_;
+    std::thread::id thread_id_;
+
+    Scope(const Scope&) = delete;
+
+    Scope& operator=(const Scope&) = delete;
+  };
+
+ private:
+  std::vector<std::unique_ptr<uint8_t[]>> blocks_;
+  uint8_t* cursor_ = nullptr;
+  uint8_t* end_ = nullptr;
+
+  Arena();
+
+  Arena(const Arena&) = delete;
+
+  Arena& operator=(const Arena&) = delete;
+};
+
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  explicit ArenaAllocator(std::shared_ptr<Arena> arena)
+      : arena_(std::move(arena)) {}
+
+  template <typename U>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena_) {}
+
+  T* allocate(size_t count) {
+    return static_cast<T*>(arena_->Allocate(count * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T*, size_t) {}
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const {
+    return arena_ == other.arena_;
+  }
+
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const {
+    return arena_ != other.arena_;
+  }
+
+ private:
+  template <typename U>
+  friend class ArenaAllocator;
+
+  std::shared_ptr<Arena> arena_;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Makes a shared object in the current arena of this thread, or
+///             on the heap if there is none.
+///
+template <typename T, typename... Args>
+std::shared_ptr<T> MakeShared(Args&&... args) {
+  const std::shared_ptr<Arena>& arena = Arena::GetCurrent();
+  if (!arena) {
+    return std::make_shared<T>(std::forward<Args>(args)...);
+  }
+  return std::allocate_shared<T>(ArenaAllocator<T>(arena),
+                                 std::forward<Args>(args)...);
+}
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_BASE_ARENA_H_
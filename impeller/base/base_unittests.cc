@@ -2,7 +2,10 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <array>
+
 #include "flutter/testing/testing.h"
+#include "impeller/base/arena.h"
 #include "impeller/base/strings.h"
 #include "impeller/base/thread.h"
 
@@ -233,5 +236,38 @@ TEST(ConditionVariableTest, TestsCriticalSectionAfterWait) {
   ASSERT_EQ(sum, kThreadCount);
 }
 
+TEST(ArenaTest, IsReleasedWithTheLastObjectAllocatedFromIt) {
+  std::weak_ptr<Arena> weak_arena;
+  std::shared_ptr<int> small;
+  std::shared_ptr<std::array<uint8_t, Arena::kBlockSize * 2>> large;
+  {
+    auto arena = Arena::Create();
+    weak_arena = arena;
+    Arena::Scope scope(arena);
+    ASSERT_EQ(Arena::GetCurrent(), arena);
+    small = MakeShared<int>(42);
+    large = MakeShared<std::array<uint8_t, Arena::kBlockSize * 2>>();
+    ASSERT_EQ(arena->GetBlockCount(), 2u);
+  }
+  ASSERT_EQ(Arena::GetCurrent(), nullptr);
+  ASSERT_EQ(*small, 42);
+
+  small.reset();
+  ASSERT_FALSE(weak_arena.expired());
+  large.reset();
+  ASSERT_TRUE(weak_arena.expired());
+}
+
+TEST(ArenaTest, ScopesRestoreThePreviousArena) {
+  auto outer = Arena::Create();
+  auto inner = Arena::Create();
+  Arena::Scope outer_scope(outer);
+  {
+    Arena::Scope inner_scope(inner);
+    ASSERT_EQ(Arena::GetCurrent(), inner);
+  }
+  ASSERT_EQ(Arena::GetCurrent(), outer);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -262,6 +262,22 @@ Compiler::Compiler(const std::shared_ptr<const fml::Mapping>& source_mapping,
   // will be processed later by backend specific compilers.
   spirv_options.generate_debug_info = true;
 
+  switch (options_.optimization_level) {
+    case OptimizationLevel::kNone:
+      spirv_options.optimization_level =
+          shaderc_optimization_level::shaderc_optimization_level_zero;
+      break;
+    case OptimizationLevel::kSize:
+      spirv_options.optimization_level =
+          shaderc_optimization_level::shaderc_optimization_level_size;
+      break;
+    case OptimizationLevel::kUnknown:
+    case OptimizationLevel::kPerformance:
+      spirv_options.optimization_level =
+          shaderc_optimization_level::shaderc_optimization_level_performance;
+      break;
+  }
+
   switch (options_.source_language) {
     case SourceLanguage::kGLSL:
       // Expects GLSL 4.60 (Core Profile).
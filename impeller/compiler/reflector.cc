@@ -488,6 +488,22 @@ std::shared_ptr<ShaderBundleData> Reflector::GenerateShaderBundleData() const {
     data->AddUniformStruct(uniform_struct);
   }
 
+  // Storage buffers are bound by name like uniform structs. Their fields
+  // aren't reflected since they usually end with a runtime sized array.
+  const auto storage_buffers =
+      compiler_->get_shader_resources().storage_buffers;
+  for (const auto& storage_buffer : storage_buffers) {
+    ShaderBundleData::ShaderUniformStruct uniform_struct;
+    uniform_struct.name = storage_buffer.name;
+    uniform_struct.ext_res_0 = compiler_.GetExtendedMSLResourceBinding(
+        CompilerBackend::ExtendedResourceIndex::kPrimary, storage_buffer.id);
+    uniform_struct.set = compiler_->get_decoration(
+        storage_buffer.id, spv::Decoration::DecorationDescriptorSet);
+    uniform_struct.binding = compiler_->get_decoration(
+        storage_buffer.id, spv::Decoration::DecorationBinding);
+    data->AddUniformStruct(uniform_struct);
+  }
+
   const auto sampled_images = compiler_->get_shader_resources().sampled_images;
   for (const auto& image : sampled_images) {
     ShaderBundleData::ShaderUniformTexture uniform_texture;
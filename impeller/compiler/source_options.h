@@ -39,6 +39,10 @@ struct SourceOptions {
   /// Only used on OpenGLES targets.
   bool require_framebuffer_fetch = false;
 
+  /// @brief The SPIR-V optimization passes to run. SkSL targets are never
+  /// optimized as SkSL can't express some of the optimized control flow.
+  OptimizationLevel optimization_level = OptimizationLevel::kPerformance;
+
   SourceOptions();
 
   ~SourceOptions();
@@ -110,6 +110,10 @@ void Switches::PrintHelp(std::ostream& stream) {
             "targeting metal)"
          << std::endl;
   stream << optional_prefix << "--require-framebuffer-fetch" << std::endl;
+  stream << optional_prefix
+         << "--optimization-level=none|size|performance (default: "
+            "performance)"
+         << std::endl;
 }
 
 Switches::Switches() = default;
@@ -193,6 +197,10 @@ Switches::Switches(const fml::CommandLine& command_line)
 
   source_language = ToSourceLanguage(language);
 
+  optimization_level = ToOptimizationLevel(ToLowerCase(
+      command_line.GetOptionValueWithDefault("optimization-level",
+                                             "performance")));
+
   if (!working_directory || !working_directory->is_valid()) {
     return;
   }
@@ -257,6 +265,11 @@ bool Switches::AreValid(std::ostream& explain) const {
     valid = false;
   }
 
+  if (optimization_level == OptimizationLevel::kUnknown) {
+    explain << "Invalid optimization level." << std::endl;
+    valid = false;
+  }
+
   if (!working_directory || !working_directory->is_valid()) {
     explain << "Could not open the working directory: \""
             << Utf8FromPath(std::filesystem::current_path()).c_str() << "\""
@@ -326,6 +339,7 @@ SourceOptions Switches::CreateSourceOptions(
   options.metal_version = metal_version;
   options.use_half_textures = use_half_textures;
   options.require_framebuffer_fetch = require_framebuffer_fetch;
+  options.optimization_level = optimization_level;
   return options;
 }
 
@@ -43,6 +43,7 @@ class Switches {
   std::string entry_point = "";
   bool use_half_textures = false;
   bool require_framebuffer_fetch = false;
+  OptimizationLevel optimization_level = OptimizationLevel::kPerformance;
 
   Switches();
 
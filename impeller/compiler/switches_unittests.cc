@@ -69,6 +69,26 @@ TEST(SwitchesTest, EntryPointCanBeSetForHLSL) {
   ASSERT_EQ(switches.entry_point, "CustomEntryPoint");
 }
 
+TEST(SwitchesTest, OptimizationLevelDefaultsToPerformance) {
+  Switches switches = MakeSwitchesDesktopGL();
+  ASSERT_TRUE(switches.AreValid(std::cout));
+  ASSERT_EQ(switches.optimization_level, OptimizationLevel::kPerformance);
+  ASSERT_EQ(switches.CreateSourceOptions().optimization_level,
+            OptimizationLevel::kPerformance);
+}
+
+TEST(SwitchesTest, OptimizationLevelCanBeSet) {
+  Switches switches = MakeSwitchesDesktopGL({"--optimization-level=size"});
+  ASSERT_TRUE(switches.AreValid(std::cout));
+  ASSERT_EQ(switches.CreateSourceOptions().optimization_level,
+            OptimizationLevel::kSize);
+}
+
+TEST(SwitchesTest, RejectsUnknownOptimizationLevel) {
+  Switches switches = MakeSwitchesDesktopGL({"--optimization-level=fast"});
+  ASSERT_FALSE(switches.AreValid(std::cout));
+}
+
 TEST(SwitchesTEst, ConvertToEntrypointName) {
   ASSERT_EQ(ConvertToEntrypointName("mandelbrot_unrolled"),
             "mandelbrot_unrolled");
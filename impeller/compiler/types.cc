@@ -71,6 +71,19 @@ SourceLanguage ToSourceLanguage(const std::string& source_language) {
   return SourceLanguage::kUnknown;
 }
 
+OptimizationLevel ToOptimizationLevel(const std::string& optimization_level) {
+  if (optimization_level == "none") {
+    return OptimizationLevel::kNone;
+  }
+  if (optimization_level == "size") {
+    return OptimizationLevel::kSize;
+  }
+  if (optimization_level == "performance") {
+    return OptimizationLevel::kPerformance;
+  }
+  return OptimizationLevel::kUnknown;
+}
+
 std::string TargetPlatformToString(TargetPlatform platform) {
   switch (platform) {
     case TargetPlatform::kUnknown:
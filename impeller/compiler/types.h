@@ -45,6 +45,18 @@ enum class SourceLanguage {
   kHLSL,
 };
 
+/// The SPIR-V optimization passes run before the shader is translated to the
+/// target shading language.
+enum class OptimizationLevel {
+  kUnknown,
+  /// No optimization passes. Keeps the SPIR-V closest to the source.
+  kNone,
+  /// Passes that reduce the size of the shader.
+  kSize,
+  /// Passes that reduce the cost of the shader at runtime.
+  kPerformance,
+};
+
 struct UniformDescription {
   std::string name;
   size_t location = 0u;
@@ -98,6 +110,8 @@ SourceLanguage ToSourceLanguage(const std::string& source_language);
 
 std::string SourceLanguageToString(SourceLanguage source_language);
 
+OptimizationLevel ToOptimizationLevel(const std::string& optimization_level);
+
 std::string TargetPlatformSLExtension(TargetPlatform platform);
 
 std::string EntryPointFunctionNameFromSourceName(
@@ -0,0 +1,123 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/core/allocation_accountant.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+/// Released resources are swept while tracking new ones once the number of
+/// allocations grows past twice the count of the last sweep, plus this slack,
+/// so that backends which never call |Update| don't grow without bound.
+static constexpr size_t kMinSweepAllocationCount = 64u;
+
+AllocationAccountant::AllocationAccountant() = default;
+
+AllocationAccountant::~AllocationAccountant() = default;
+
+void AllocationAccountant::Track(AllocationCategory category,
+                                 const std::shared_ptr<const void>& resource,
+                                 size_t bytes) {
+  if (!resource || bytes == 0u) {
+    return;
+  }
+  Lock lock(mutex_);
+  allocations_.push_back(
+      Allocation{.resource = resource, .category = category, .bytes = bytes});
+  bytes_[static_cast<size_t>(category)] += bytes;
+  if (allocations_.size() >=
+      2 * swept_allocation_count_ + kMinSweepAllocationCount) {
+    SweepLocked();
+  }
+}
+
+size_t AllocationAccountant::GetBytes(AllocationCategory category) const {
+  Lock lock(mutex_);
+  return bytes_[static_cast<size_t>(category)];
+}
+
+size_t AllocationAccountant::GetTotalBytes() const {
+  Lock lock(mutex_);
+  return std::accumulate(bytes_.begin(), bytes_.end(), size_t{0u});
+}
+
+void AllocationAccountant::SetBudget(std::optional<size_t> bytes) {
+  Lock lock(mutex_);
+  budget_ = bytes;
+}
+
+std::optional<size_t> AllocationAccountant::GetBudget() const {
+  Lock lock(mutex_);
+  return budget_;
+}
+
+uint64_t AllocationAccountant::AddPressureCallback(PressureCallback callback) {
+  Lock lock(mutex_);
+  auto id = next_callback_id_++;
+  callbacks_[id] = std::move(callback);
+  return id;
+}
+
+void AllocationAccountant::RemovePressureCallback(uint64_t id) {
+  Lock lock(mutex_);
+  callbacks_.erase(id);
+}
+
+void AllocationAccountant::Update() {
+  std::vector<PressureCallback> callbacks;
+  size_t bytes_over_threshold = 0u;
+  {
+    Lock lock(mutex_);
+    SweepLocked();
+
+    static constexpr int64_t kImpellerMemoryTraceID = 1995;
+    using Category = AllocationCategory;
+    FML_TRACE_COUNTER(
+        "impeller",                                                       //
+        "AllocationAccountant",                                           //
+        kImpellerMemoryTraceID,                                           //
+        "RenderTargets", bytes_[static_cast<size_t>(Category::kRenderTarget)],
+        "Textures", bytes_[static_cast<size_t>(Category::kTexture)],      //
+        "HostBuffers", bytes_[static_cast<size_t>(Category::kHostBuffer)],
+        "DeviceBuffers", bytes_[static_cast<size_t>(Category::kDeviceBuffer)]
+    );
+
+    if (!budget_.has_value()) {
+      return;
+    }
+    auto total = std::accumulate(bytes_.begin(), bytes_.end(), size_t{0u});
+    auto threshold = static_cast<size_t>(budget_.value() * kPressureThreshold);
+    if (total <= threshold) {
+      return;
+    }
+    bytes_over_threshold = total - threshold;
+    for (const auto& [id, callback] : callbacks_) {
+      callbacks.push_back(callback);
+    }
+  }
+  // The callbacks are invoked without holding the lock as they usually
+  // release resources, and may track new ones.
+  for (const auto& callback : callbacks) {
+    callback(bytes_over_threshold);
+  }
+}
+
+void AllocationAccountant::SweepLocked() {
+  auto live = std::remove_if(
+      allocations_.begin(), allocations_.end(), [&](const Allocation& a) {
+        if (!a.resource.expired()) {
+          return false;
+        }
+        bytes_[static_cast<size_t>(a.category)] -= a.bytes;
+        return true;
+      });
+  allocations_.erase(live, allocations_.end());
+  swept_allocation_count_ = allocations_.size();
+}
+
+}  // namespace impeller
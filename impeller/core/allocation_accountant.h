@@ -0,0 +1,126 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_CORE_ALLOCATION_ACCOUNTANT_H_
+#define FLUTTER_IMPELLER_CORE_ALLOCATION_ACCOUNTANT_H_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "impeller/base/thread.h"
+
+namespace impeller {
+
+enum class AllocationCategory : uint8_t {
+  /// Textures that can be rendered to.
+  kRenderTarget,
+  /// Other textures, such as images and atlases.
+  kTexture,
+  /// Buffers written by the host, such as the transients buffer.
+  kHostBuffer,
+  /// Buffers only accessed by the device.
+  kDeviceBuffer,
+  kLast = kDeviceBuffer,
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Tracks the memory of the resources created by an allocator by
+///             category, and notifies its clients when the usage nears the
+///             memory budget of the device so that caches can be trimmed.
+///
+///             Released resources are only forgotten by |Update| and
+///             periodically while tracking new ones, so the usage is an
+///             upper bound between updates.
+///
+///             This class is thread-safe. Pressure callbacks are invoked on
+///             the thread calling |Update|.
+///
+class AllocationAccountant {
+ public:
+  /// The fraction of the budget above which pressure callbacks are invoked.
+  static constexpr double kPressureThreshold = 0.9;
+
+  /// Called with the number of bytes by which the usage exceeds the pressure
+  /// threshold.
+  using PressureCallback = std::function<void(size_t bytes_over_threshold)>;
+
+  AllocationAccountant();
+
+  ~AllocationAccountant();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Count `bytes` towards `category` until `resource` is
+  ///             released.
+  ///
+  void Track(AllocationCategory category,
+             const std::shared_ptr<const void>& resource,
+             size_t bytes);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The bytes of the tracked resources of `category`.
+  ///
+  size_t GetBytes(AllocationCategory category) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The bytes of all tracked resources.
+  ///
+  size_t GetTotalBytes() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Set the number of bytes the tracked resources may use, or
+  ///             std::nullopt if the budget is unknown, which disables the
+  ///             pressure callbacks.
+  ///
+  void SetBudget(std::optional<size_t> bytes);
+
+  std::optional<size_t> GetBudget() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Register a callback invoked by |Update| when the usage is
+  ///             above the pressure threshold of the budget.
+  ///
+  /// @return     An identifier for |RemovePressureCallback|.
+  ///
+  uint64_t AddPressureCallback(PressureCallback callback);
+
+  void RemovePressureCallback(uint64_t id);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Forget the released resources, and invoke the pressure
+  ///             callbacks if the usage is still above the pressure
+  ///             threshold. Usually called once per frame.
+  ///
+  void Update();
+
+ private:
+  struct Allocation {
+    std::weak_ptr<const void> resource;
+    AllocationCategory category;
+    size_t bytes;
+  };
+
+  mutable Mutex mutex_;
+  std::vector<Allocation> allocations_ IPLR_GUARDED_BY(mutex_);
+  std::array<size_t, static_cast<size_t>(AllocationCategory::kLast) + 1>
+      bytes_ IPLR_GUARDED_BY(mutex_) = {};
+  size_t swept_allocation_count_ IPLR_GUARDED_BY(mutex_) = 0u;
+  std::optional<size_t> budget_ IPLR_GUARDED_BY(mutex_);
+  std::map<uint64_t, PressureCallback> callbacks_ IPLR_GUARDED_BY(mutex_);
+  uint64_t next_callback_id_ IPLR_GUARDED_BY(mutex_) = 0u;
+
+  void SweepLocked() IPLR_REQUIRES(mutex_);
+
+  AllocationAccountant(const AllocationAccountant&) = delete;
+
+  AllocationAccountant& operator=(const AllocationAccountant&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_CORE_ALLOCATION_ACCOUNTANT_H_
@@ -11,6 +11,20 @@
 
 namespace impeller {
 
+static AllocationCategory GetAllocationCategory(
+    const DeviceBufferDescriptor& desc) {
+  return desc.storage_mode == StorageMode::kHostVisible
+             ? AllocationCategory::kHostBuffer
+             : AllocationCategory::kDeviceBuffer;
+}
+
+static AllocationCategory GetAllocationCategory(const TextureDescriptor& desc) {
+  auto render_target =
+      static_cast<TextureUsageMask>(TextureUsage::kRenderTarget);
+  return (desc.usage & render_target) ? AllocationCategory::kRenderTarget
+                                      : AllocationCategory::kTexture;
+}
+
 Allocator::Allocator() = default;
 
 Allocator::~Allocator() = default;
@@ -43,7 +57,9 @@ std::shared_ptr<DeviceBuffer> Allocator::CreateBufferWithCopy(
 
 std::shared_ptr<DeviceBuffer> Allocator::CreateBuffer(
     const DeviceBufferDescriptor& desc) {
-  return OnCreateBuffer(desc);
+  auto buffer = OnCreateBuffer(desc);
+  accountant_.Track(GetAllocationCategory(desc), buffer, desc.size);
+  return buffer;
 }
 
 std::shared_ptr<Texture> Allocator::CreateTexture(
@@ -55,10 +71,17 @@ std::shared_ptr<Texture> Allocator::CreateTexture(
     return nullptr;
   }
 
-  return OnCreateTexture(desc);
+  auto texture = OnCreateTexture(desc);
+  accountant_.Track(GetAllocationCategory(desc), texture,
+                    desc.GetByteSizeOfAllLevels());
+  return texture;
+}
+
+void Allocator::DidAcquireSurfaceFrame() {
+  accountant_.Update();
 }
 
-void Allocator::DidAcquireSurfaceFrame() {}
+void Allocator::CompactMemory(fml::TimePoint deadline) {}
 
 uint16_t Allocator::MinimumBytesPerRow(PixelFormat format) const {
   return BytesPerPixelForPixelFormat(format);
@@ -6,6 +6,8 @@
 #define FLUTTER_IMPELLER_CORE_ALLOCATOR_H_
 
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/time/time_point.h"
+#include "impeller/core/allocation_accountant.h"
 #include "impeller/core/device_buffer_descriptor.h"
 #include "impeller/core/texture.h"
 #include "impeller/core/texture_descriptor.h"
@@ -45,9 +47,26 @@ class Allocator {
   virtual ISize GetMaxTextureSizeSupported() const = 0;
 
   /// @brief Increment an internal frame used to cycle through a ring buffer of
-  /// allocation pools.
+  /// allocation pools, and update the allocation accountant.
   virtual void DidAcquireSurfaceFrame();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Moves long lived textures out of sparsely used blocks of
+  ///             device memory so that those blocks can be released. Called
+  ///             while the engine is idle, and returns by the deadline.
+  ///
+  ///             The default implementation does nothing.
+  ///
+  virtual void CompactMemory(fml::TimePoint deadline);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The memory used by the buffers and textures created by this
+  ///             allocator, by category. Caches may register pressure
+  ///             callbacks with it to trim themselves when the usage nears
+  ///             the budget of the device.
+  ///
+  AllocationAccountant& GetAccountant() { return accountant_; }
+
  protected:
   Allocator();
 
@@ -58,6 +77,8 @@ class Allocator {
       const TextureDescriptor& desc) = 0;
 
  private:
+  AllocationAccountant accountant_;
+
   Allocator(const Allocator&) = delete;
 
   Allocator& operator=(const Allocator&) = delete;
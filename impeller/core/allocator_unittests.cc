@@ -4,6 +4,7 @@
 
 #include <memory>
 #include "flutter/testing/testing.h"
+#include "impeller/core/allocation_accountant.h"
 #include "impeller/core/allocator.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/texture_descriptor.h"
@@ -79,5 +80,63 @@ TEST(AllocatorTest, TextureDescriptorCompatibility) {
   }
 }
 
+TEST(AllocatorTest, TextureDescriptorByteSizeCountsAllLevels) {
+  TextureDescriptor desc = {.format = PixelFormat::kR8G8B8A8UNormInt,
+                            .size = ISize(8, 4),
+                            .mip_count = 4u};
+  // 8x4, 4x2, 2x1 and 1x1.
+  EXPECT_EQ(desc.GetByteSizeOfBaseMipLevel(), 8u * 4u * 4u);
+  EXPECT_EQ(desc.GetByteSizeOfAllLevels(), (32u + 8u + 2u + 1u) * 4u);
+
+  desc.type = TextureType::kTextureCube;
+  EXPECT_EQ(desc.GetByteSizeOfAllLevels(), 6u * (32u + 8u + 2u + 1u) * 4u);
+
+  TextureDescriptor msaa = {.type = TextureType::kTexture2DMultisample,
+                            .format = PixelFormat::kR8G8B8A8UNormInt,
+                            .size = ISize(8, 4),
+                            .sample_count = SampleCount::kCount4};
+  EXPECT_EQ(msaa.GetByteSizeOfAllLevels(), 4u * 8u * 4u * 4u);
+
+  EXPECT_EQ(TextureDescriptor{}.GetByteSizeOfAllLevels(), 0u);
+}
+
+TEST(AllocatorTest, AllocationAccountantTracksCategoriesAndPressure) {
+  AllocationAccountant accountant;
+  auto texture = std::make_shared<int>(0);
+  auto buffer = std::make_shared<int>(0);
+  accountant.Track(AllocationCategory::kTexture, texture, 600u);
+  accountant.Track(AllocationCategory::kHostBuffer, buffer, 400u);
+  EXPECT_EQ(accountant.GetBytes(AllocationCategory::kTexture), 600u);
+  EXPECT_EQ(accountant.GetBytes(AllocationCategory::kHostBuffer), 400u);
+  EXPECT_EQ(accountant.GetTotalBytes(), 1000u);
+
+  size_t pressure_bytes = 0u;
+  auto id = accountant.AddPressureCallback(
+      [&](size_t bytes_over_threshold) {
+        pressure_bytes = bytes_over_threshold;
+      });
+
+  // No budget, no pressure.
+  accountant.Update();
+  EXPECT_EQ(pressure_bytes, 0u);
+
+  accountant.SetBudget(1000u);
+  accountant.Update();
+  EXPECT_EQ(pressure_bytes, 100u);
+
+  // Released resources are forgotten.
+  pressure_bytes = 0u;
+  buffer.reset();
+  accountant.Update();
+  EXPECT_EQ(accountant.GetBytes(AllocationCategory::kHostBuffer), 0u);
+  EXPECT_EQ(accountant.GetTotalBytes(), 600u);
+  EXPECT_EQ(pressure_bytes, 0u);
+
+  accountant.SetBudget(500u);
+  accountant.RemovePressureCallback(id);
+  accountant.Update();
+  EXPECT_EQ(pressure_bytes, 0u);
+}
+
 }  // namespace testing
 }  // namespace impeller
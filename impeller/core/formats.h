@@ -105,6 +105,11 @@ enum class PixelFormat : uint8_t {
   kB10G10R10XR,
   kB10G10R10XRSRGB,
   kB10G10R10A10XR,
+  // Block compressed formats. These can only be sampled from, and each block
+  // of 4x4 pixels is stored in 16 bytes.
+  kETC2R8G8B8A8UNormInt,
+  kASTC4x4UNormInt,
+  kBC7UNormInt,
   // Depth and stencil formats.
   kS8UInt,
   kD24UnormS8Uint,
@@ -132,6 +137,17 @@ constexpr bool IsStencilWritable(PixelFormat format) {
   }
 }
 
+constexpr bool IsCompressed(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kBC7UNormInt:
+      return true;
+    default:
+      return false;
+  }
+}
+
 constexpr const char* PixelFormatToString(PixelFormat format) {
   switch (format) {
     case PixelFormat::kUnknown:
@@ -160,6 +176,12 @@ constexpr const char* PixelFormatToString(PixelFormat format) {
       return "B10G10R10XRSRGB";
     case PixelFormat::kB10G10R10A10XR:
       return "B10G10R10A10XR";
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+      return "ETC2R8G8B8A8UNormInt";
+    case PixelFormat::kASTC4x4UNormInt:
+      return "ASTC4x4UNormInt";
+    case PixelFormat::kBC7UNormInt:
+      return "BC7UNormInt";
     case PixelFormat::kS8UInt:
       return "S8UInt";
     case PixelFormat::kD24UnormS8Uint:
@@ -449,6 +471,11 @@ constexpr size_t BytesPerPixelForPixelFormat(PixelFormat format) {
       return 1u;
     case PixelFormat::kR8G8UNormInt:
       return 2u;
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kBC7UNormInt:
+      // 16 bytes per block of 4x4 pixels.
+      return 1u;
     case PixelFormat::kR8G8B8A8UNormInt:
     case PixelFormat::kR8G8B8A8UNormIntSRGB:
     case PixelFormat::kB8G8R8A8UNormInt:
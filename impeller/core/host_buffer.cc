@@ -4,6 +4,7 @@
 
 #include "impeller/core/host_buffer.h"
 
+#include <algorithm>
 #include <cstring>
 #include <tuple>
 
@@ -24,11 +25,8 @@ std::shared_ptr<HostBuffer> HostBuffer::Create(
 
 HostBuffer::HostBuffer(const std::shared_ptr<Allocator>& allocator)
     : allocator_(allocator) {
-  DeviceBufferDescriptor desc;
-  desc.size = kAllocatorBlockSize;
-  desc.storage_mode = StorageMode::kHostVisible;
   for (auto i = 0u; i < kHostBufferArenaSize; i++) {
-    device_buffers_[i].push_back(allocator->CreateBuffer(desc));
+    device_buffers_[i].push_back(CreateBlock());
   }
 }
 
@@ -74,17 +72,41 @@ HostBuffer::TestStateQuery HostBuffer::GetStateForTest() {
   };
 }
 
+const HostBuffer::FrameStatistics& HostBuffer::GetLastFrameStatistics() const {
+  return last_frame_statistics_;
+}
+
+uint64_t HostBuffer::GetResetCount() const {
+  return reset_count_;
+}
+
+std::shared_ptr<DeviceBuffer> HostBuffer::CreateBlock() const {
+  DeviceBufferDescriptor desc;
+  desc.size = kAllocatorBlockSize;
+  desc.storage_mode = StorageMode::kHostVisible;
+  return allocator_->CreateBuffer(desc);
+}
+
 void HostBuffer::MaybeCreateNewBuffer() {
+  frame_bytes_used_ += kAllocatorBlockSize - offset_;
   current_buffer_++;
   if (current_buffer_ >= device_buffers_[frame_index_].size()) {
-    DeviceBufferDescriptor desc;
-    desc.size = kAllocatorBlockSize;
-    desc.storage_mode = StorageMode::kHostVisible;
-    device_buffers_[frame_index_].push_back(allocator_->CreateBuffer(desc));
+    device_buffers_[frame_index_].push_back(CreateBlock());
+    frame_allocation_count_++;
   }
   offset_ = 0;
 }
 
+void HostBuffer::PresizeCurrentFrame() {
+  auto& frame_buffers = device_buffers_[frame_index_];
+  while (frame_buffers.size() < retained_block_count_) {
+    frame_buffers.push_back(CreateBlock());
+  }
+  while (frame_buffers.size() > retained_block_count_) {
+    frame_buffers.pop_back();
+  }
+}
+
 std::tuple<Range, std::shared_ptr<DeviceBuffer>> HostBuffer::EmplaceInternal(
     size_t length,
     size_t align,
@@ -103,6 +125,8 @@ std::tuple<Range, std::shared_ptr<DeviceBuffer>> HostBuffer::EmplaceInternal(
     if (!device_buffer) {
       return {};
     }
+    frame_bytes_used_ += length;
+    frame_allocation_count_++;
     if (cb) {
       cb(device_buffer->OnGetContents());
       device_buffer->Flush(Range{0, length});
@@ -138,6 +162,8 @@ std::tuple<Range, std::shared_ptr<DeviceBuffer>> HostBuffer::EmplaceInternal(
     if (!device_buffer) {
       return {};
     }
+    frame_bytes_used_ += length;
+    frame_allocation_count_++;
     if (buffer) {
       if (!device_buffer->CopyHostBuffer(static_cast<const uint8_t*>(buffer),
                                          Range{0, length})) {
@@ -182,15 +208,38 @@ HostBuffer::EmplaceInternal(const void* buffer, size_t length, size_t align) {
 }
 
 void HostBuffer::Reset() {
-  // When resetting the host buffer state at the end of the frame, check if
-  // there are any unused buffers and remove them.
-  while (device_buffers_[frame_index_].size() > current_buffer_ + 1) {
-    device_buffers_[frame_index_].pop_back();
+  const size_t blocks_used = current_buffer_ + 1;
+  frame_bytes_used_ += offset_;
+  last_frame_statistics_ = FrameStatistics{
+      .bytes_used = frame_bytes_used_,
+      .bytes_high_water_mark = std::max(
+          last_frame_statistics_.bytes_high_water_mark, frame_bytes_used_),
+      .blocks_used = blocks_used,
+      .allocation_count = frame_allocation_count_,
+  };
+  frame_bytes_used_ = 0u;
+  frame_allocation_count_ = 0u;
+
+  // Grow the retained block count immediately, but only shrink it once the
+  // workload has stayed smaller for a while. This keeps frames that briefly
+  // need less from releasing blocks that the next busy frame would have to
+  // allocate again.
+  if (blocks_used >= retained_block_count_) {
+    retained_block_count_ = blocks_used;
+    frames_below_retained_count_ = 0u;
+  } else if (++frames_below_retained_count_ > kHostBufferRetainedFrameCount) {
+    retained_block_count_ = blocks_used;
+    frames_below_retained_count_ = 0u;
   }
 
   offset_ = 0u;
   current_buffer_ = 0u;
   frame_index_ = (frame_index_ + 1) % kHostBufferArenaSize;
+  reset_count_++;
+
+  // The blocks of the frame that is now current were last used
+  // kHostBufferArenaSize frames ago, and that work has retired by now.
+  PresizeCurrentFrame();
 }
 
 }  // namespace impeller
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -21,10 +22,17 @@ namespace impeller {
 /// Approximately the same size as the max frames in flight.
 static const constexpr size_t kHostBufferArenaSize = 3u;
 
+/// The number of consecutive frames that may use fewer blocks than the
+/// retained high-water mark before the surplus blocks are released.
+static const constexpr size_t kHostBufferRetainedFrameCount = 60u;
+
 /// The host buffer class manages one more 1024 Kb blocks of device buffer
 /// allocations.
 ///
-/// These are reset per-frame.
+/// These are reset per-frame. Each frame in flight has its own set of blocks
+/// which is reused once the frame index comes around again. Frame sets are
+/// pre-sized to the recent high-water mark when they become current, so that
+/// emplacing in steady state never allocates.
 class HostBuffer {
  public:
   static std::shared_ptr<HostBuffer> Create(
@@ -123,6 +131,30 @@ class HostBuffer {
   ///        reused.
   void Reset();
 
+  /// Telemetry describing the most recently completed frame.
+  struct FrameStatistics {
+    /// The number of bytes emplaced, including alignment padding and one-off
+    /// buffers larger than the block size.
+    size_t bytes_used = 0u;
+    /// The largest value of `bytes_used` seen by this host buffer.
+    size_t bytes_high_water_mark = 0u;
+    /// The number of blocks the frame spanned.
+    size_t blocks_used = 0u;
+    /// The number of device buffers that had to be allocated while emplacing.
+    /// This is zero in steady state.
+    size_t allocation_count = 0u;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief Retrieve telemetry for the frame that was completed by the most
+  ///        recent call to `Reset`.
+  const FrameStatistics& GetLastFrameStatistics() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief Retrieve the number of times `Reset` has been called. Buffer views
+  ///        emplaced while this count is unchanged are still valid.
+  uint64_t GetResetCount() const;
+
   /// Test only internal state.
   struct TestStateQuery {
     size_t current_frame;
@@ -147,6 +179,10 @@ class HostBuffer {
 
   void MaybeCreateNewBuffer();
 
+  std::shared_ptr<DeviceBuffer> CreateBlock() const;
+
+  void PresizeCurrentFrame();
+
   std::shared_ptr<DeviceBuffer>& GetCurrentBuffer() {
     return device_buffers_[frame_index_][current_buffer_];
   }
@@ -165,7 +201,17 @@ class HostBuffer {
   size_t current_buffer_ = 0u;
   size_t offset_ = 0u;
   size_t frame_index_ = 0u;
+  uint64_t reset_count_ = 0u;
   std::string label_;
+
+  // The number of blocks each frame should keep around and how many frames in
+  // a row have needed fewer than that.
+  size_t retained_block_count_ = 1u;
+  size_t frames_below_retained_count_ = 0u;
+
+  size_t frame_bytes_used_ = 0u;
+  size_t frame_allocation_count_ = 0u;
+  FrameStatistics last_frame_statistics_;
 };
 
 }  // namespace impeller
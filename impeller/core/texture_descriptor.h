@@ -5,6 +5,8 @@
 #ifndef FLUTTER_IMPELLER_CORE_TEXTURE_DESCRIPTOR_H_
 #define FLUTTER_IMPELLER_CORE_TEXTURE_DESCRIPTOR_H_
 
+#include <algorithm>
+
 #include "impeller/core/formats.h"
 #include "impeller/geometry/size.h"
 
@@ -49,13 +51,40 @@ struct TextureDescriptor {
     if (!IsValid()) {
       return 0u;
     }
+    if (IsCompressed(format)) {
+      return GetBytesPerRow() * ((size.height + 3) / 4);
+    }
     return size.Area() * BytesPerPixelForPixelFormat(format);
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      The bytes of all the mip levels of all the layers and samples
+  ///             of the texture, ignoring the padding and alignment of its
+  ///             allocation.
+  ///
+  constexpr size_t GetByteSizeOfAllLevels() const {
+    if (!IsValid()) {
+      return 0u;
+    }
+    TextureDescriptor level = *this;
+    size_t bytes = 0u;
+    for (size_t mip = 0u; mip < mip_count; mip++) {
+      bytes += level.GetByteSizeOfBaseMipLevel();
+      level.size = ISize(std::max<int64_t>(level.size.width / 2, 1),
+                         std::max<int64_t>(level.size.height / 2, 1));
+    }
+    const size_t layers = type == TextureType::kTextureCube ? 6u : 1u;
+    return bytes * layers * static_cast<size_t>(sample_count);
+  }
+
   constexpr size_t GetBytesPerRow() const {
     if (!IsValid()) {
       return 0u;
     }
+    if (IsCompressed(format)) {
+      // A row of 4x4 blocks of 16 bytes each.
+      return ((size.width + 3) / 4) * 16u;
+    }
     return size.width * BytesPerPixelForPixelFormat(format);
   }
 
@@ -8,15 +8,18 @@
 #include <cstring>
 #include <memory>
 #include <optional>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/aiks/color_filter.h"
 #include "impeller/core/formats.h"
 #include "impeller/display_list/dl_vertices_geometry.h"
 #include "impeller/display_list/nine_patch_converter.h"
+#include "impeller/display_list/path_conversion_cache.h"
 #include "impeller/display_list/skia_conversions.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
@@ -163,6 +166,17 @@ static impeller::SamplerDescriptor ToSamplerDescriptor(
   return desc;
 }
 
+// Images drawn with a mipmap filter at a minifying scale sample their mip
+// levels, which some images only generate the first time they are needed.
+static std::shared_ptr<Texture> ToTexture(const flutter::DlImage& image,
+                                          flutter::DlImageSampling sampling,
+                                          bool minifying) {
+  if (sampling == flutter::DlImageSampling::kMipmapLinear && minifying) {
+    return image.impeller_mipmapped_texture();
+  }
+  return image.impeller_texture();
+}
+
 static Matrix ToMatrix(const SkMatrix& m) {
   return Matrix{
       // clang-format off
@@ -284,6 +298,17 @@ static std::optional<ColorSource::Type> ToColorSourceType(
 
 // |flutter::DlOpReceiver|
 void DlDispatcher::setColorSource(const flutter::DlColorSource* source) {
+  // Solid colors also set the color, which later ops may change again, so
+  // they are applied right away.
+  if (source && source->type() != flutter::DlColorSourceType::kColor) {
+    pending_color_source_ = source;
+    return;
+  }
+  pending_color_source_ = std::nullopt;
+  ApplyColorSource(source);
+}
+
+void DlDispatcher::ApplyColorSource(const flutter::DlColorSource* source) {
   if (!source) {
     paint_.color_source = ColorSource::MakeColor();
     return;
@@ -385,7 +410,10 @@ void DlDispatcher::setColorSource(const flutter::DlColorSource* source) {
       const flutter::DlImageColorSource* image_color_source = source->asImage();
       FML_DCHECK(image_color_source &&
                  image_color_source->image()->impeller_texture());
-      auto texture = image_color_source->image()->impeller_texture();
+      // The scale of the image is only known once the contents are rendered.
+      auto texture = ToTexture(*image_color_source->image(),
+                               image_color_source->sampling(),
+                               /*minifying=*/true);
       auto x_tile_mode = ToTileMode(image_color_source->horizontal_tile_mode());
       auto y_tile_mode = ToTileMode(image_color_source->vertical_tile_mode());
       auto desc = ToSamplerDescriptor(image_color_source->sampling());
@@ -416,7 +444,8 @@ void DlDispatcher::setColorSource(const flutter::DlColorSource* source) {
         FML_DCHECK(image->image()->impeller_texture());
         texture_inputs.push_back({
             .sampler_descriptor = ToSamplerDescriptor(image->sampling()),
-            .texture = image->image()->impeller_texture(),
+            .texture = ToTexture(*image->image(), image->sampling(),
+                                 /*minifying=*/true),
         });
       }
 
@@ -470,7 +499,7 @@ static std::shared_ptr<ColorFilter> ToColorFilter(
 
 // |flutter::DlOpReceiver|
 void DlDispatcher::setColorFilter(const flutter::DlColorFilter* filter) {
-  paint_.color_filter = ToColorFilter(filter);
+  pending_color_filter_ = filter;
 }
 
 // |flutter::DlOpReceiver|
@@ -614,7 +643,23 @@ static std::shared_ptr<ImageFilter> ToImageFilter(
 
 // |flutter::DlOpReceiver|
 void DlDispatcher::setImageFilter(const flutter::DlImageFilter* filter) {
-  paint_.image_filter = ToImageFilter(filter);
+  pending_image_filter_ = filter;
+}
+
+const Paint& DlDispatcher::GetPaint() {
+  if (pending_color_source_.has_value()) {
+    ApplyColorSource(pending_color_source_.value());
+    pending_color_source_ = std::nullopt;
+  }
+  if (pending_color_filter_.has_value()) {
+    paint_.color_filter = ToColorFilter(pending_color_filter_.value());
+    pending_color_filter_ = std::nullopt;
+  }
+  if (pending_image_filter_.has_value()) {
+    paint_.image_filter = ToImageFilter(pending_image_filter_.value());
+    pending_image_filter_ = std::nullopt;
+  }
+  return paint_;
 }
 
 // |flutter::DlOpReceiver|
@@ -626,7 +671,7 @@ void DlDispatcher::save() {
 void DlDispatcher::saveLayer(const SkRect* bounds,
                              const flutter::SaveLayerOptions options,
                              const flutter::DlImageFilter* backdrop) {
-  auto paint = options.renders_with_attributes() ? paint_ : Paint{};
+  auto paint = options.renders_with_attributes() ? GetPaint() : Paint{};
   canvas_.SaveLayer(paint, skia_conversions::ToRect(bounds),
                     ToImageFilter(backdrop));
 }
@@ -756,7 +801,7 @@ void DlDispatcher::clipPath(const SkPath& path, ClipOp sk_op, bool is_aa) {
                         skia_conversions::ToSize(rrect.getSimpleRadii()),
                         clip_op);
     } else {
-      canvas_.ClipPath(skia_conversions::ToPath(path), clip_op);
+      canvas_.ClipPath(PathConversionCache::GetShared().ToPath(path), clip_op);
     }
   }
 }
@@ -778,31 +823,32 @@ void DlDispatcher::drawPaint() {
 // |flutter::DlOpReceiver|
 void DlDispatcher::drawLine(const SkPoint& p0, const SkPoint& p1) {
   canvas_.DrawLine(skia_conversions::ToPoint(p0), skia_conversions::ToPoint(p1),
-                   paint_);
+                   GetPaint());
 }
 
 // |flutter::DlOpReceiver|
 void DlDispatcher::drawRect(const SkRect& rect) {
-  canvas_.DrawRect(skia_conversions::ToRect(rect), paint_);
+  canvas_.DrawRect(skia_conversions::ToRect(rect), GetPaint());
 }
 
 // |flutter::DlOpReceiver|
 void DlDispatcher::drawOval(const SkRect& bounds) {
-  canvas_.DrawOval(skia_conversions::ToRect(bounds), paint_);
+  canvas_.DrawOval(skia_conversions::ToRect(bounds), GetPaint());
 }
 
 // |flutter::DlOpReceiver|
 void DlDispatcher::drawCircle(const SkPoint& center, SkScalar radius) {
-  canvas_.DrawCircle(skia_conversions::ToPoint(center), radius, paint_);
+  canvas_.DrawCircle(skia_conversions::ToPoint(center), radius, GetPaint());
 }
 
 // |flutter::DlOpReceiver|
 void DlDispatcher::drawRRect(const SkRRect& rrect) {
   if (rrect.isSimple()) {
     canvas_.DrawRRect(skia_conversions::ToRect(rrect.rect()),
-                      skia_conversions::ToSize(rrect.getSimpleRadii()), paint_);
+                      skia_conversions::ToSize(rrect.getSimpleRadii()),
+                      GetPaint());
   } else {
-    canvas_.DrawPath(skia_conversions::ToPath(rrect), paint_);
+    canvas_.DrawPath(skia_conversions::ToPath(rrect), GetPaint());
   }
 }
 
@@ -811,12 +857,12 @@ void DlDispatcher::drawDRRect(const SkRRect& outer, const SkRRect& inner) {
   PathBuilder builder;
   builder.AddPath(skia_conversions::ToPath(outer));
   builder.AddPath(skia_conversions::ToPath(inner));
-  canvas_.DrawPath(builder.TakePath(FillType::kOdd), paint_);
+  canvas_.DrawPath(builder.TakePath(FillType::kOdd), GetPaint());
 }
 
 // |flutter::DlOpReceiver|
 void DlDispatcher::drawPath(const SkPath& path) {
-  SimplifyOrDrawPath(canvas_, path, paint_);
+  SimplifyOrDrawPath(canvas_, path, GetPaint());
 }
 
 void DlDispatcher::SimplifyOrDrawPath(CanvasType& canvas,
@@ -844,7 +890,7 @@ void DlDispatcher::SimplifyOrDrawPath(CanvasType& canvas,
     return;
   }
 
-  canvas.DrawPath(skia_conversions::ToPath(path), paint);
+  canvas.DrawPath(PathConversionCache::GetShared().ToPath(path), paint);
 }
 
 // |flutter::DlOpReceiver|
@@ -855,14 +901,14 @@ void DlDispatcher::drawArc(const SkRect& oval_bounds,
   PathBuilder builder;
   builder.AddArc(skia_conversions::ToRect(oval_bounds), Degrees(start_degrees),
                  Degrees(sweep_degrees), use_center);
-  canvas_.DrawPath(builder.TakePath(), paint_);
+  canvas_.DrawPath(builder.TakePath(), GetPaint());
 }
 
 // |flutter::DlOpReceiver|
 void DlDispatcher::drawPoints(PointMode mode,
                               uint32_t count,
                               const SkPoint points[]) {
-  Paint paint = paint_;
+  Paint paint = GetPaint();
   paint.style = Paint::Style::kStroke;
   switch (mode) {
     case flutter::DlCanvas::PointMode::kPoints: {
@@ -899,7 +945,8 @@ void DlDispatcher::drawPoints(PointMode mode,
 // |flutter::DlOpReceiver|
 void DlDispatcher::drawVertices(const flutter::DlVertices* vertices,
                                 flutter::DlBlendMode dl_mode) {
-  canvas_.DrawVertices(MakeVertices(vertices), ToBlendMode(dl_mode), paint_);
+  auto geometry = VerticesGeometryCache::GetShared().MakeVertices(vertices);
+  canvas_.DrawVertices(geometry, ToBlendMode(dl_mode), GetPaint());
 }
 
 // |flutter::DlOpReceiver|
@@ -938,12 +985,16 @@ void DlDispatcher::drawImageRect(
     flutter::DlImageSampling sampling,
     bool render_with_attributes,
     SrcRectConstraint constraint = SrcRectConstraint::kFast) {
+  const auto scale = canvas_.GetCurrentTransform().GetScale();
+  const bool minifying = dst.width() * scale.x < src.width() ||
+                         dst.height() * scale.y < src.height();
+  auto texture = ToTexture(*image, sampling, minifying);
   canvas_.DrawImageRect(
-      std::make_shared<Image>(image->impeller_texture()),  // image
-      skia_conversions::ToRect(src),                       // source rect
-      skia_conversions::ToRect(dst),                       // destination rect
-      render_with_attributes ? paint_ : Paint(),           // paint
-      ToSamplerDescriptor(sampling)                        // sampling
+      std::make_shared<Image>(std::move(texture)),    // image
+      skia_conversions::ToRect(src),                  // source rect
+      skia_conversions::ToRect(dst),                  // destination rect
+      render_with_attributes ? GetPaint() : Paint(),  // paint
+      ToSamplerDescriptor(sampling)                   // sampling
   );
 }
 
@@ -954,11 +1005,12 @@ void DlDispatcher::drawImageNine(const sk_sp<flutter::DlImage> image,
                                  flutter::DlFilterMode filter,
                                  bool render_with_attributes) {
   NinePatchConverter converter = {};
+  Paint paint = GetPaint();
   converter.DrawNinePatch(
       std::make_shared<Image>(image->impeller_texture()),
       Rect::MakeLTRB(center.fLeft, center.fTop, center.fRight, center.fBottom),
       skia_conversions::ToRect(dst), ToSamplerDescriptor(filter), &canvas_,
-      &paint_);
+      &paint);
 }
 
 // |flutter::DlOpReceiver|
@@ -971,20 +1023,24 @@ void DlDispatcher::drawAtlas(const sk_sp<flutter::DlImage> atlas,
                              flutter::DlImageSampling sampling,
                              const SkRect* cull_rect,
                              bool render_with_attributes) {
-  canvas_.DrawAtlas(std::make_shared<Image>(atlas->impeller_texture()),
+  // The sprites may each be drawn at a different scale.
+  auto texture = ToTexture(*atlas, sampling, /*minifying=*/true);
+  canvas_.DrawAtlas(std::make_shared<Image>(std::move(texture)),
                     skia_conversions::ToRSXForms(xform, count),
                     skia_conversions::ToRects(tex, count),
                     ToColors(colors, count), ToBlendMode(mode),
                     ToSamplerDescriptor(sampling),
-                    skia_conversions::ToRect(cull_rect), paint_);
+                    skia_conversions::ToRect(cull_rect), GetPaint());
 }
 
 // |flutter::DlOpReceiver|
 void DlDispatcher::drawDisplayList(
     const sk_sp<flutter::DisplayList> display_list,
     SkScalar opacity) {
-  // Save all values that must remain untouched after the operation.
-  Paint saved_paint = paint_;
+  // Save all values that must remain untouched after the operation. The
+  // pending attributes are converted first, as the paint is reset for the
+  // display list.
+  Paint saved_paint = GetPaint();
   Matrix saved_initial_matrix = initial_matrix_;
   int restore_count = canvas_.GetSaveCount();
 
@@ -1052,7 +1108,7 @@ void DlDispatcher::drawTextFrame(const std::shared_ptr<TextFrame>& text_frame,
                                  SkScalar y) {
   canvas_.DrawTextFrame(text_frame,             //
                         impeller::Point{x, y},  //
-                        paint_                  //
+                        GetPaint()              //
   );
 }
 
@@ -1120,4 +1176,55 @@ Picture DlDispatcher::EndRecordingAsPicture() {
   return canvas_.EndRecordingAsPicture();
 }
 
+Picture DlDispatcher::DispatchPartitioned(
+    const flutter::DisplayList& display_list,
+    IRect cull_rect,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  TRACE_EVENT0("impeller", "DlDispatcher::DispatchPartitioned");
+  auto sk_cull_rect = SkIRect::MakeLTRB(cull_rect.GetLeft(), cull_rect.GetTop(),
+                                        cull_rect.GetRight(),
+                                        cull_rect.GetBottom());
+  const int max_groups = std::thread::hardware_concurrency();
+  std::vector<std::vector<int>> groups;
+  if (worker_task_runner && display_list.has_rtree() &&
+      display_list.op_count() >= kMinPartitionedOpCount && max_groups > 1) {
+    groups = display_list.rtree()->searchAndPartition(
+        SkRect::Make(sk_cull_rect), max_groups);
+  }
+  if (groups.size() <= 1) {
+    DlDispatcher dispatcher(cull_rect);
+    display_list.DispatchUnoccluded(dispatcher, sk_cull_rect);
+    return dispatcher.EndRecordingAsPicture();
+  }
+
+  std::vector<Picture> pictures(groups.size());
+  auto dispatch = [&display_list, &groups, &pictures, cull_rect](size_t i) {
+    TRACE_EVENT0("impeller", "DlDispatcher::DispatchPartition");
+    DlDispatcher dispatcher(cull_rect);
+    display_list.Dispatch(dispatcher, groups[i]);
+    pictures[i] = dispatcher.EndRecordingAsPicture();
+  };
+
+  // The calling thread converts the first group instead of idling.
+  fml::CountDownLatch latch(groups.size() - 1);
+  for (size_t i = 1; i < groups.size(); i++) {
+    worker_task_runner->PostTask(
+        [&dispatch, &latch, i]() {
+          dispatch(i);
+          latch.CountDown();
+        },
+        fml::ConcurrentTaskPriority::kHigh);
+  }
+  dispatch(0u);
+  latch.Wait();
+
+  // The groups don't overlap, so appending their entities in any order
+  // renders the same as converting the display list serially.
+  Picture picture = std::move(pictures[0]);
+  for (size_t i = 1; i < pictures.size(); i++) {
+    picture.pass->AddSubpassInline(std::move(pictures[i].pass));
+  }
+  return picture;
+}
+
 }  // namespace impeller
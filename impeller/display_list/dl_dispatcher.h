@@ -5,7 +5,12 @@
 #ifndef FLUTTER_IMPELLER_DISPLAY_LIST_DL_DISPATCHER_H_
 #define FLUTTER_IMPELLER_DISPLAY_LIST_DL_DISPATCHER_H_
 
+#include <memory>
+#include <optional>
+
+#include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_op_receiver.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "impeller/aiks/canvas_type.h"
 #include "impeller/aiks/paint.h"
 
@@ -23,6 +28,41 @@ class DlDispatcher final : public flutter::DlOpReceiver {
 
   Picture EndRecordingAsPicture();
 
+  //----------------------------------------------------------------------------
+  /// The number of rendering ops below which a display list is always
+  /// converted on the calling thread.
+  ///
+  static constexpr unsigned int kMinPartitionedOpCount = 2000u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Converts the ops of a display list that intersect the cull
+  ///             rect into a picture, converting groups of ops on the worker
+  ///             task runner.
+  ///
+  ///             Ops whose bounds don't overlap can be rendered in any order.
+  ///             The RTree of the display list is used to split its
+  ///             rendering ops into groups that don't overlap each other, and
+  ///             each group is dispatched to its own dispatcher along with the
+  ///             attribute, transform, clip and save ops that apply to it.
+  ///             The entities of the groups are then appended to a single
+  ///             picture.
+  ///
+  ///             Display lists without an RTree, with fewer than
+  ///             |kMinPartitionedOpCount| ops, or whose ops all overlap are
+  ///             converted on the calling thread, as is the first group.
+  ///             Display lists converted serially skip the ops that are
+  ///             hidden by the opaque ops that follow them.
+  ///
+  /// @param[in]  display_list        The display list to convert.
+  /// @param[in]  cull_rect           The cull rect of the picture.
+  /// @param[in]  worker_task_runner  The task runner to convert groups on.
+  ///                                 May be `nullptr`.
+  ///
+  static Picture DispatchPartitioned(
+      const flutter::DisplayList& display_list,
+      IRect cull_rect,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner);
+
   // |flutter::DlOpReceiver|
   void setAntiAlias(bool aa) override;
 
@@ -226,6 +266,20 @@ class DlDispatcher final : public flutter::DlOpReceiver {
   CanvasType canvas_;
   Matrix initial_matrix_;
 
+  // The attributes whose conversion is deferred until a rendering op uses
+  // the paint. Display lists are often dispatched with a cull rect, and the
+  // attributes of the ops that are culled are then never converted. The
+  // attributes are owned by the display list being dispatched.
+  std::optional<const flutter::DlColorSource*> pending_color_source_;
+  std::optional<const flutter::DlColorFilter*> pending_color_filter_;
+  std::optional<const flutter::DlImageFilter*> pending_image_filter_;
+
+  /// Returns the paint of the rendering ops, after converting the pending
+  /// attributes.
+  const Paint& GetPaint();
+
+  void ApplyColorSource(const flutter::DlColorSource* source);
+
   static void SimplifyOrDrawPath(CanvasType& canvas,
                                  const SkPath& path,
                                  const Paint& paint);
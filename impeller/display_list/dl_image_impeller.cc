@@ -88,7 +88,7 @@ SkISize DlImageImpeller::dimensions() const {
 size_t DlImageImpeller::GetApproximateByteSize() const {
   auto size = sizeof(*this);
   if (texture_) {
-    size += texture_->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+    size += texture_->GetTextureDescriptor().GetByteSizeOfAllLevels();
   }
   return size;
 }
@@ -0,0 +1,116 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/dl_serialization.h"
+#include "flutter/display_list/skia/dl_sk_dispatcher.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "impeller/display_list/dl_dispatcher.h"
+#include "impeller/display_list/skia_conversions.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+// Replays frames captured with the `--capture-display-lists-path` flag
+// through the Skia and Impeller display list dispatchers.
+//
+// The frames are read from the directory named by the
+// FLUTTER_DL_REPLAY_DIR environment variable, and one benchmark is
+// registered per frame and backend. These benchmarks measure the CPU cost of
+// encoding the frames. They do not measure the GPU cost of executing them, as
+// they run without a GPU.
+//
+// Images aren't captured with the frames, so they are replaced by opaque
+// images of the same size. Impeller skips drawing these as they have no
+// texture.
+
+namespace impeller {
+
+namespace {
+
+constexpr const char* kReplayDirectoryVariable = "FLUTTER_DL_REPLAY_DIR";
+
+sk_sp<flutter::DlImage> MakePlaceholderImage(const SkISize& size) {
+  auto surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(
+      std::max(size.width(), 1), std::max(size.height(), 1)));
+  if (!surface) {
+    return nullptr;
+  }
+  surface->getCanvas()->clear(SK_ColorGRAY);
+  return flutter::DlImage::Make(surface->makeImageSnapshot());
+}
+
+void SetCounters(benchmark::State& state,
+                 const flutter::DlSerializedDisplayList& frame) {
+  state.counters["OpCount"] = frame.op_count();
+  state.counters["SerializedBytes"] = frame.mapping()->GetSize();
+}
+
+void BM_ReplaySkia(benchmark::State& state,
+                   const flutter::DlSerializedDisplayList* frame) {
+  auto bounds = frame->bounds().roundOut();
+  auto surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(
+      std::max(bounds.right(), 1), std::max(bounds.bottom(), 1)));
+  if (!surface) {
+    state.SkipWithError("Could not create the surface.");
+    return;
+  }
+  while (state.KeepRunning()) {
+    surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+    flutter::DlSkCanvasDispatcher dispatcher(surface->getCanvas());
+    frame->Dispatch(dispatcher);
+  }
+  SetCounters(state, *frame);
+}
+
+void BM_ReplayImpeller(benchmark::State& state,
+                       const flutter::DlSerializedDisplayList* frame) {
+  while (state.KeepRunning()) {
+    DlDispatcher dispatcher(skia_conversions::ToRect(frame->bounds()));
+    frame->Dispatch(dispatcher);
+    auto picture = dispatcher.EndRecordingAsPicture();
+    benchmark::DoNotOptimize(picture);
+  }
+  SetCounters(state, *frame);
+}
+
+// Registers the benchmarks before the benchmark runner's |main| runs. The
+// frames are leaked as the benchmarks refer to them until the process exits.
+bool RegisterReplayBenchmarks() {
+  const char* path = std::getenv(kReplayDirectoryVariable);
+  if (path == nullptr) {
+    return false;
+  }
+  auto directory = fml::OpenDirectory(path, false, fml::FilePermission::kRead);
+  if (!directory.is_valid()) {
+    FML_LOG(ERROR) << "Could not open " << path << ".";
+    return false;
+  }
+  for (size_t i = 0;; i++) {
+    auto name = "frame_" + std::to_string(i);
+    auto frame = flutter::DlSerializedDisplayList::ReadFromDirectory(
+        directory, name, MakePlaceholderImage);
+    if (!frame) {
+      break;
+    }
+    auto* replayed = frame.release();
+    benchmark::RegisterBenchmark(("BM_ReplaySkia/" + name).c_str(),
+                                 BM_ReplaySkia, replayed);
+    benchmark::RegisterBenchmark(("BM_ReplayImpeller/" + name).c_str(),
+                                 BM_ReplayImpeller, replayed);
+  }
+  return true;
+}
+
+[[maybe_unused]] const bool kReplayBenchmarksRegistered =
+    RegisterReplayBenchmarks();
+
+}  // namespace
+
+}  // namespace impeller
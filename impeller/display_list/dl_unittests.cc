@@ -22,6 +22,7 @@
 #include "impeller/display_list/dl_image_impeller.h"
 #include "impeller/display_list/dl_playground.h"
 #include "impeller/entity/contents/clip_contents.h"
+#include "impeller/entity/contents/linear_gradient_contents.h"
 #include "impeller/entity/contents/solid_color_contents.h"
 #include "impeller/entity/contents/solid_rrect_blur_contents.h"
 #include "impeller/geometry/constants.h"
@@ -1815,6 +1816,38 @@ TEST(DisplayListTest, CircleBoundsComputation) {
             Rect::MakeLTRB(-5, -5, 5, 5));
 }
 
+TEST(DisplayListTest, ColorSourcesApplyOnlyToTheirDraws) {
+  std::vector<flutter::DlColor> colors = {flutter::DlColor::kBlue(),
+                                          flutter::DlColor::kRed()};
+  const float stops[2] = {0.0, 1.0};
+  flutter::DlPaint gradient_paint;
+  gradient_paint.setColorSource(flutter::DlColorSource::MakeLinear(
+      {0.0, 0.0}, {100.0, 100.0}, 2, colors.data(), stops,
+      flutter::DlTileMode::kClamp));
+  flutter::DlPaint solid_paint;
+
+  flutter::DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeLTRB(0, 0, 100, 100), solid_paint);
+  builder.DrawRect(SkRect::MakeLTRB(100, 0, 200, 100), gradient_paint);
+  builder.DrawRect(SkRect::MakeLTRB(200, 0, 300, 100), solid_paint);
+  auto display_list = builder.Build();
+
+  // The color source of the gradient is converted when the rect that uses it
+  // is drawn, and not applied to the rects drawn around it.
+  DlDispatcher dispatcher;
+  display_list->Dispatch(dispatcher);
+  auto picture = dispatcher.EndRecordingAsPicture();
+
+  std::vector<bool> is_gradient;
+  picture.pass->IterateAllEntities([&is_gradient](Entity& entity) {
+    is_gradient.push_back(static_cast<bool>(
+        std::dynamic_pointer_cast<LinearGradientContents>(
+            entity.GetContents())));
+    return true;
+  });
+  EXPECT_EQ(is_gradient, std::vector<bool>({false, true, false}));
+}
+
 #ifdef IMPELLER_ENABLE_3D
 TEST_P(DisplayListTest, SceneColorSource) {
   // Load up the scene.
@@ -62,4 +62,56 @@ std::shared_ptr<impeller::VerticesGeometry> MakeVertices(
       positions, indices, texture_coordinates, colors, bounds, mode);
 }
 
+VerticesGeometryCache::VerticesGeometryCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+VerticesGeometryCache::~VerticesGeometryCache() = default;
+
+VerticesGeometryCache& VerticesGeometryCache::GetShared() {
+  static VerticesGeometryCache* cache = new VerticesGeometryCache();
+  return *cache;
+}
+
+std::shared_ptr<VerticesGeometry> VerticesGeometryCache::MakeVertices(
+    const flutter::DlVertices* vertices) {
+  const size_t bytes = vertices->size();
+  if (bytes > max_bytes_) {
+    return impeller::MakeVertices(vertices);
+  }
+  const uint64_t unique_id = vertices->unique_id();
+
+  {
+    Lock lock(mutex_);
+    auto found = index_.find(unique_id);
+    if (found != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, found->second);
+      return found->second->geometry;
+    }
+  }
+
+  auto geometry = impeller::MakeVertices(vertices);
+
+  Lock lock(mutex_);
+  if (index_.find(unique_id) == index_.end()) {
+    entries_.push_front(Entry{
+        .unique_id = unique_id,
+        .bytes = bytes,
+        .geometry = geometry,
+    });
+    index_[unique_id] = entries_.begin();
+    byte_count_ += bytes;
+    while (byte_count_ > max_bytes_) {
+      byte_count_ -= entries_.back().bytes;
+      index_.erase(entries_.back().unique_id);
+      entries_.pop_back();
+    }
+  }
+  return geometry;
+}
+
+size_t VerticesGeometryCache::GetByteCount() const {
+  Lock lock(mutex_);
+  return byte_count_;
+}
+
 }  // namespace impeller
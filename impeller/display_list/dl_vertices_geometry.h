@@ -5,8 +5,12 @@
 #ifndef FLUTTER_IMPELLER_DISPLAY_LIST_DL_VERTICES_GEOMETRY_H_
 #define FLUTTER_IMPELLER_DISPLAY_LIST_DL_VERTICES_GEOMETRY_H_
 
+#include <list>
+#include <unordered_map>
+
 #include "flutter/display_list/dl_vertices.h"
 
+#include "impeller/base/thread.h"
 #include "impeller/entity/geometry/vertices_geometry.h"
 
 namespace impeller {
@@ -14,6 +18,62 @@ namespace impeller {
 std::shared_ptr<VerticesGeometry> MakeVertices(
     const flutter::DlVertices* vertices);
 
+//------------------------------------------------------------------------------
+/// @brief      A cache of the geometry made for DlVertices, keyed by their
+///             unique ID.
+///
+///             A `ui.Vertices` object that is drawn every frame is copied
+///             into every display list, but the copies keep its ID. Reusing
+///             the geometry keeps both the converted vertex data and the
+///             device buffers that the geometry uploads it to, so a
+///             long-lived mesh is converted and uploaded once.
+///
+///             The cache is bounded by the size of the cached DlVertices,
+///             which approximates the size of their uploaded buffers.
+///             Least recently drawn vertices are evicted first.
+///
+class VerticesGeometryCache {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 16u * 1024u * 1024u;
+
+  explicit VerticesGeometryCache(size_t max_bytes = kDefaultMaxBytes);
+
+  ~VerticesGeometryCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The cache used by the display list dispatchers. It is safe
+  ///             to use from any thread.
+  ///
+  static VerticesGeometryCache& GetShared();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the geometry of `vertices`, as `MakeVertices` would.
+  ///
+  std::shared_ptr<VerticesGeometry> MakeVertices(
+      const flutter::DlVertices* vertices);
+
+  size_t GetByteCount() const;
+
+ private:
+  struct Entry {
+    uint64_t unique_id;
+    size_t bytes;
+    std::shared_ptr<VerticesGeometry> geometry;
+  };
+
+  const size_t max_bytes_;
+  mutable Mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> entries_ IPLR_GUARDED_BY(mutex_);
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> index_
+      IPLR_GUARDED_BY(mutex_);
+  size_t byte_count_ IPLR_GUARDED_BY(mutex_) = 0u;
+
+  VerticesGeometryCache(const VerticesGeometryCache&) = delete;
+
+  VerticesGeometryCache& operator=(const VerticesGeometryCache&) = delete;
+};
+
 }  // namespace impeller
 
 #endif  // FLUTTER_IMPELLER_DISPLAY_LIST_DL_VERTICES_GEOMETRY_H_
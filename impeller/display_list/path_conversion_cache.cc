@@ -0,0 +1,78 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/display_list/path_conversion_cache.h"
+
+#include "flutter/fml/logging.h"
+#include "impeller/display_list/skia_conversions.h"
+
+namespace impeller {
+
+PathConversionCache::PathConversionCache(size_t max_entry_count)
+    : max_entry_count_(max_entry_count) {
+  FML_DCHECK(max_entry_count_ > 0u);
+}
+
+PathConversionCache::~PathConversionCache() = default;
+
+PathConversionCache& PathConversionCache::GetShared() {
+  static PathConversionCache* cache = new PathConversionCache();
+  return *cache;
+}
+
+Path PathConversionCache::ToPath(const SkPath& path) {
+  if (path.isVolatile() || path.countVerbs() == 0) {
+    return skia_conversions::ToPath(path);
+  }
+  const uint32_t generation_id = path.getGenerationID();
+
+  // The generation ID identifies the points and verbs of the path. The other
+  // properties are checked too, in case the ID was reused.
+  auto matches = [&path](const Entry& entry) {
+    return entry.fill_type == path.getFillType() &&
+           entry.point_count == path.countPoints() &&
+           entry.verb_count == path.countVerbs();
+  };
+
+  {
+    Lock lock(mutex_);
+    auto found = index_.find(generation_id);
+    if (found != index_.end()) {
+      if (matches(*found->second)) {
+        entries_.splice(entries_.begin(), entries_, found->second);
+        return found->second->path.Clone();
+      }
+      entries_.erase(found->second);
+      index_.erase(found);
+    }
+  }
+
+  // Convert without holding the lock, so that dispatchers on other threads
+  // are not blocked by large paths.
+  Path converted = skia_conversions::ToPath(path);
+
+  Lock lock(mutex_);
+  if (index_.find(generation_id) == index_.end()) {
+    entries_.push_front(Entry{
+        .generation_id = generation_id,
+        .fill_type = path.getFillType(),
+        .point_count = path.countPoints(),
+        .verb_count = path.countVerbs(),
+        .path = converted.Clone(),
+    });
+    index_[generation_id] = entries_.begin();
+    if (entries_.size() > max_entry_count_) {
+      index_.erase(entries_.back().generation_id);
+      entries_.pop_back();
+    }
+  }
+  return converted;
+}
+
+size_t PathConversionCache::GetEntryCount() const {
+  Lock lock(mutex_);
+  return entries_.size();
+}
+
+}  // namespace impeller
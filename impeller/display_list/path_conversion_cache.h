@@ -0,0 +1,76 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_DISPLAY_LIST_PATH_CONVERSION_CACHE_H_
+#define FLUTTER_IMPELLER_DISPLAY_LIST_PATH_CONVERSION_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+#include "impeller/base/thread.h"
+#include "impeller/geometry/path.h"
+#include "third_party/skia/include/core/SkPath.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A cache of the Impeller paths that SkPaths convert to, keyed
+///             by the generation ID of the SkPath.
+///
+///             Copies of an SkPath share its generation ID until one of them
+///             is modified, so the path of a `ui.Path` that is drawn
+///             unchanged frame after frame is only converted once. The
+///             converted paths are returned as clones, which also share the
+///             polyline that the path is flattened to.
+///
+///             Paths marked volatile by the `VolatilePathTracker` change
+///             too often to benefit and are converted without the cache.
+///
+class PathConversionCache {
+ public:
+  static constexpr size_t kDefaultMaxEntryCount = 256u;
+
+  explicit PathConversionCache(size_t max_entry_count = kDefaultMaxEntryCount);
+
+  ~PathConversionCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The cache used by the display list dispatchers. It is safe
+  ///             to use from any thread.
+  ///
+  static PathConversionCache& GetShared();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the conversion of `path`, as
+  ///             `skia_conversions::ToPath` would.
+  ///
+  Path ToPath(const SkPath& path);
+
+  size_t GetEntryCount() const;
+
+ private:
+  struct Entry {
+    uint32_t generation_id;
+    SkPathFillType fill_type;
+    int point_count;
+    int verb_count;
+    Path path;
+  };
+
+  const size_t max_entry_count_;
+  mutable Mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> entries_ IPLR_GUARDED_BY(mutex_);
+  std::unordered_map<uint32_t, std::list<Entry>::iterator> index_
+      IPLR_GUARDED_BY(mutex_);
+
+  PathConversionCache(const PathConversionCache&) = delete;
+
+  PathConversionCache& operator=(const PathConversionCache&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_DISPLAY_LIST_PATH_CONVERSION_CACHE_H_
@@ -5,6 +5,7 @@
 #include "display_list/dl_color.h"
 #include "display_list/dl_tile_mode.h"
 #include "flutter/testing/testing.h"
+#include "impeller/display_list/path_conversion_cache.h"
 #include "impeller/display_list/skia_conversions.h"
 #include "impeller/geometry/scalar.h"
 
@@ -174,5 +175,54 @@ TEST(SkiaConversionsTest, GradientConversionNonMonotonic) {
   ASSERT_TRUE(ScalarNearlyEqual(converted_stops[3], 1.0f));
 }
 
+TEST(PathConversionCacheTest, ReusesConversionsOfUnchangedPaths) {
+  PathConversionCache cache;
+  SkPath path;
+  path.moveTo(0, 0);
+  path.lineTo(10, 0);
+  path.quadTo(10, 10, 0, 10);
+  path.close();
+
+  Path first = cache.ToPath(path);
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+  // A copy of the path shares its generation ID.
+  SkPath copy = path;
+  Path second = cache.ToPath(copy);
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+  EXPECT_EQ(second.GetContentHash(), first.GetContentHash());
+  EXPECT_EQ(second.GetContentHash(),
+            skia_conversions::ToPath(path).GetContentHash());
+
+  copy.lineTo(20, 20);
+  Path modified = cache.ToPath(copy);
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+  EXPECT_EQ(modified.GetContentHash(),
+            skia_conversions::ToPath(copy).GetContentHash());
+}
+
+TEST(PathConversionCacheTest, SkipsVolatilePaths) {
+  PathConversionCache cache;
+  SkPath path;
+  path.moveTo(0, 0);
+  path.lineTo(10, 10);
+  path.setIsVolatile(true);
+
+  cache.ToPath(path);
+  EXPECT_EQ(cache.GetEntryCount(), 0u);
+}
+
+TEST(PathConversionCacheTest, BoundsItsEntryCount) {
+  PathConversionCache cache(2u);
+  SkPath a = SkPath::Circle(0, 0, 10);
+  SkPath b = SkPath::Circle(0, 0, 20);
+  SkPath c = SkPath::Circle(0, 0, 30);
+
+  cache.ToPath(a);
+  cache.ToPath(b);
+  cache.ToPath(a);
+  cache.ToPath(c);
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -15,7 +15,9 @@
 #include "impeller/entity/entity.h"
 #include "impeller/entity/texture_fill.frag.h"
 #include "impeller/entity/texture_fill.vert.h"
+#include "impeller/entity/texture_fill_instanced.vert.h"
 #include "impeller/geometry/color.h"
+#include "impeller/geometry/vector.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/vertex_buffer_builder.h"
 
@@ -374,6 +376,15 @@ bool AtlasTextureContents::Render(const ContentContext& renderer,
     transforms = parent_.GetTransforms();
   }
 
+  if (texture_coords.empty()) {
+    return true;
+  }
+
+  if (renderer.GetDeviceCapabilities().SupportsSSBO()) {
+    return RenderInstanced(renderer, entity, pass, texture, texture_coords,
+                           transforms);
+  }
+
   const Size texture_size(texture->GetSize());
   VertexBufferBuilder<VS::PerVertexData> vertex_builder;
   vertex_builder.Reserve(texture_coords.size() * 6);
@@ -417,6 +428,75 @@ bool AtlasTextureContents::Render(const ContentContext& renderer,
   return pass.Draw().ok();
 }
 
+namespace {
+
+/// Matches the std140 layout of InstanceData in texture_fill_instanced.vert.
+struct AtlasInstanceData {
+  Matrix transform;
+  Vector4 texture_rect;
+};
+
+}  // namespace
+
+bool AtlasTextureContents::RenderInstanced(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass,
+    const std::shared_ptr<Texture>& texture,
+    const std::vector<Rect>& texture_coords,
+    const std::vector<Matrix>& transforms) const {
+  using VS = TextureInstancedPipeline::VertexShader;
+  using FS = TextureInstancedPipeline::FragmentShader;
+
+  auto& host_buffer = renderer.GetTransientsBuffer();
+
+  // A single unit quad is shared by every sprite. The vertex shader scales it
+  // by the sample rect size and applies the sprite transform.
+  VertexBufferBuilder<VS::PerVertexData> vertex_builder;
+  vertex_builder.AddVertices({
+      {Point(0, 0)},
+      {Point(1, 0)},
+      {Point(0, 1)},
+      {Point(1, 0)},
+      {Point(0, 1)},
+      {Point(1, 1)},
+  });
+
+  const size_t instance_count = texture_coords.size();
+  auto instance_buffer = host_buffer.Emplace(
+      instance_count * sizeof(AtlasInstanceData), DefaultUniformAlignment(),
+      [&texture_coords, &transforms](uint8_t* buffer) {
+        auto* instances = reinterpret_cast<AtlasInstanceData*>(buffer);
+        for (size_t i = 0; i < texture_coords.size(); i++) {
+          const auto& rect = texture_coords[i];
+          instances[i].transform = transforms[i];
+          instances[i].texture_rect =
+              Vector4(rect.GetX(), rect.GetY(), rect.GetWidth(),
+                      rect.GetHeight());
+        }
+      });
+
+  pass.SetCommandLabel("AtlasTexture Instanced");
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = pass.GetOrthographicTransform() * entity.GetTransform();
+  frame_info.texture_size = Point(texture->GetSize());
+  frame_info.texture_sampler_y_coord_scale = texture->GetYCoordScale();
+  frame_info.alpha = alpha_;
+
+  auto options = OptionsFromPassAndEntity(pass, entity);
+  pass.SetPipeline(renderer.GetTextureInstancedPipeline(options));
+  pass.SetStencilReference(entity.GetClipDepth());
+  pass.SetVertexBuffer(vertex_builder.CreateVertexBuffer(host_buffer));
+  pass.SetInstanceCount(instance_count);
+  VS::BindFrameInfo(pass, host_buffer.EmplaceUniform(frame_info));
+  VS::BindInstanceInfo(pass, instance_buffer);
+  FS::BindTextureSampler(pass, texture,
+                         renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+                             parent_.GetSamplerDescriptor()));
+  return pass.Draw().ok();
+}
+
 // AtlasColorContents
 // ---------------------------------------------------------
 
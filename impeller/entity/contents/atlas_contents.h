@@ -125,6 +125,16 @@ class AtlasTextureContents final : public Contents {
   bool use_destination_ = false;
   std::shared_ptr<SubAtlasResult> subatlas_;
 
+  /// Draws every sprite as an instance of a single unit quad, reading the
+  /// per-sprite transform and sample rect from a storage buffer. Requires
+  /// SSBO support.
+  bool RenderInstanced(const ContentContext& renderer,
+                       const Entity& entity,
+                       RenderPass& pass,
+                       const std::shared_ptr<Texture>& texture,
+                       const std::vector<Rect>& texture_coords,
+                       const std::vector<Matrix>& transforms) const;
+
   AtlasTextureContents(const AtlasTextureContents&) = delete;
 
   AtlasTextureContents& operator=(const AtlasTextureContents&) = delete;
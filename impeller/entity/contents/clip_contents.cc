@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cmath>
 #include <optional>
 
 #include "fml/logging.h"
@@ -9,6 +10,7 @@
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity.h"
+#include "impeller/geometry/constants.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/vertex_buffer_builder.h"
 
@@ -22,6 +24,10 @@ ClipContents::ClipContents() = default;
 
 ClipContents::~ClipContents() = default;
 
+DrawCategory ClipContents::GetDrawCategory() const {
+  return DrawCategory::kClip;
+}
+
 void ClipContents::SetGeometry(const std::shared_ptr<Geometry>& geometry) {
   geometry_ = geometry;
 }
@@ -30,6 +36,23 @@ void ClipContents::SetClipOperation(Entity::ClipOperation clip_op) {
   clip_op_ = clip_op;
 }
 
+bool ClipContents::IsPixelAlignedRectIntersect(const Entity& entity) const {
+  if (clip_op_ != Entity::ClipOperation::kIntersect || !geometry_ ||
+      !entity.GetTransform().IsTranslationScaleOnly()) {
+    return false;
+  }
+  std::optional<Rect> rect = geometry_->AsRect();
+  if (!rect.has_value()) {
+    return false;
+  }
+  for (Scalar edge : rect->TransformBounds(entity.GetTransform()).GetLTRB()) {
+    if (std::fabs(edge - std::round(edge)) > kEhCloseEnough) {
+      return false;
+    }
+  }
+  return true;
+}
+
 std::optional<Rect> ClipContents::GetCoverage(const Entity& entity) const {
   return std::nullopt;
 };
@@ -121,7 +144,8 @@ bool ClipContents::Render(const ContentContext& renderer,
     options.stencil_operation = StencilOperation::kIncrementClamp;
   }
 
-  auto geometry_result = geometry_->GetPositionBuffer(renderer, entity, pass);
+  auto geometry_result =
+      geometry_->GetSharedPositionBuffer(renderer, entity, pass);
   options.primitive_type = geometry_result.type;
   pass.SetPipeline(renderer.GetClipPipeline(options));
 
@@ -141,6 +165,10 @@ ClipRestoreContents::ClipRestoreContents() = default;
 
 ClipRestoreContents::~ClipRestoreContents() = default;
 
+DrawCategory ClipRestoreContents::GetDrawCategory() const {
+  return DrawCategory::kClip;
+}
+
 void ClipRestoreContents::SetRestoreCoverage(
     std::optional<Rect> restore_coverage) {
   restore_coverage_ = restore_coverage;
@@ -26,6 +26,14 @@ class ClipContents final : public Contents {
 
   void SetClipOperation(Entity::ClipOperation clip_op);
 
+  //----------------------------------------------------------------------------
+  /// @brief  Whether this clip intersects with a rectangle whose edges land
+  ///         on whole pixels under the entity transform, in which case a
+  ///         scissor rect applies it exactly without touching the stencil
+  ///         buffer.
+  ///
+  bool IsPixelAlignedRectIntersect(const Entity& entity) const;
+
   // |Contents|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
@@ -48,6 +56,9 @@ class ClipContents final : public Contents {
   // |Contents|
   void SetInheritedOpacity(Scalar opacity) override;
 
+  // |Contents|
+  DrawCategory GetDrawCategory() const override;
+
  private:
   std::shared_ptr<Geometry> geometry_;
   Entity::ClipOperation clip_op_ = Entity::ClipOperation::kIntersect;
@@ -92,6 +103,9 @@ class ClipRestoreContents final : public Contents {
   // |Contents|
   void SetInheritedOpacity(Scalar opacity) override;
 
+  // |Contents|
+  DrawCategory GetDrawCategory() const override;
+
  private:
   std::optional<Rect> restore_coverage_;
 
@@ -18,6 +18,10 @@ ConicalGradientContents::ConicalGradientContents() = default;
 
 ConicalGradientContents::~ConicalGradientContents() = default;
 
+DrawCategory ConicalGradientContents::GetDrawCategory() const {
+  return DrawCategory::kGradient;
+}
+
 void ConicalGradientContents::SetCenterAndRadius(Point center, Scalar radius) {
   center_ = center;
   radius_ = radius;
@@ -52,7 +56,8 @@ void ConicalGradientContents::SetFocus(std::optional<Point> focus,
 bool ConicalGradientContents::Render(const ContentContext& renderer,
                                      const Entity& entity,
                                      RenderPass& pass) const {
-  if (renderer.GetDeviceCapabilities().SupportsSSBO()) {
+  if (ShouldUseSSBOGradient(renderer.GetDeviceCapabilities(),
+                            stops_.size())) {
     return RenderSSBO(renderer, entity, pass);
   }
   return RenderTexture(renderer, entity, pass);
@@ -127,9 +132,8 @@ bool ConicalGradientContents::RenderTexture(const ContentContext& renderer,
   using VS = ConicalGradientFillPipeline::VertexShader;
   using FS = ConicalGradientFillPipeline::FragmentShader;
 
-  auto gradient_data = CreateGradientBuffer(colors_, stops_);
-  auto gradient_texture =
-      CreateGradientTexture(gradient_data, renderer.GetContext());
+  auto gradient_texture = renderer.GetGradientTextureCache()->GetTexture(
+      colors_, stops_, renderer.GetContext());
   if (gradient_texture == nullptr) {
     return false;
   }
@@ -48,6 +48,9 @@ class ConicalGradientContents final : public ColorSourceContents {
 
   void SetFocus(std::optional<Point> focus, Scalar radius);
 
+  // |Contents|
+  DrawCategory GetDrawCategory() const override;
+
  private:
   bool RenderTexture(const ContentContext& renderer,
                      const Entity& entity,
@@ -4,22 +4,86 @@
 
 #include "impeller/entity/contents/content_context.h"
 
+#include <algorithm>
 #include <memory>
+#include <sstream>
 
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/strings.h"
 #include "impeller/core/formats.h"
 #include "impeller/entity/contents/framebuffer_blend_contents.h"
+#include "impeller/entity/contents/gradient_generator.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/geometry/geometry_buffer_memo.h"
 #include "impeller/entity/render_target_cache.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/pipeline_descriptor.h"
 #include "impeller/renderer/pipeline_library.h"
 #include "impeller/renderer/render_target.h"
+#include "impeller/renderer/shader_library.h"
 #include "impeller/tessellator/tessellator.h"
 #include "impeller/typographer/typographer_context.h"
 
 namespace impeller {
 
+namespace {
+
+/// Unused render targets are kept for a few frames so that layers which
+/// briefly disappear, such as during transitions, don't reallocate them.
+constexpr size_t kRenderTargetKeepAliveFrameCount = 3u;
+constexpr size_t kMaxUnusedRenderTargetBytes = 64u * 1024u * 1024u;
+
+constexpr uint32_t kStencilFillMarkBit = 0x80;
+constexpr uint32_t kStencilFillCountMask = 0x7F;
+
+void ApplyStencilFillMode(StencilFillMode mode,
+                          StencilAttachmentDescriptor stencil,
+                          PipelineDescriptor& desc) {
+  StencilAttachmentDescriptor back = stencil;
+  switch (mode) {
+    case StencilFillMode::kNone:
+      break;
+    case StencilFillMode::kMark:
+      stencil.stencil_compare = CompareFunction::kEqual;
+      stencil.depth_stencil_pass = StencilOperation::kInvert;
+      stencil.write_mask = kStencilFillMarkBit;
+      back = stencil;
+      break;
+    case StencilFillMode::kClearCount:
+      stencil.stencil_compare = CompareFunction::kEqual;
+      stencil.depth_stencil_pass = StencilOperation::kZero;
+      stencil.read_mask = kStencilFillMarkBit;
+      stencil.write_mask = kStencilFillCountMask;
+      back = stencil;
+      break;
+    case StencilFillMode::kNonZero:
+      stencil.stencil_compare = CompareFunction::kEqual;
+      stencil.read_mask = kStencilFillMarkBit;
+      stencil.write_mask = kStencilFillCountMask;
+      back = stencil;
+      stencil.depth_stencil_pass = StencilOperation::kIncrementWrap;
+      back.depth_stencil_pass = StencilOperation::kDecrementWrap;
+      break;
+    case StencilFillMode::kEvenOdd:
+      stencil.stencil_compare = CompareFunction::kEqual;
+      stencil.depth_stencil_pass = StencilOperation::kInvert;
+      stencil.read_mask = kStencilFillMarkBit;
+      stencil.write_mask = 0x01;
+      back = stencil;
+      break;
+    case StencilFillMode::kCover:
+      // The reference is the mark bit alone, so this passes for marked pixels
+      // with a nonzero count.
+      stencil.stencil_compare = CompareFunction::kLess;
+      stencil.depth_stencil_pass = StencilOperation::kKeep;
+      back = stencil;
+      break;
+  }
+  desc.SetStencilAttachmentDescriptors(stencil, back);
+}
+
+}  // namespace
+
 void ContentContextOptions::ApplyToPipelineDescriptor(
     PipelineDescriptor& desc) const {
   auto pipeline_blend = blend_mode;
@@ -145,7 +209,11 @@ void ContentContextOptions::ApplyToPipelineDescriptor(
     StencilAttachmentDescriptor stencil = maybe_stencil.value();
     stencil.stencil_compare = stencil_compare;
     stencil.depth_stencil_pass = stencil_operation;
-    desc.SetStencilAttachmentDescriptors(stencil);
+    if (stencil_fill_mode == StencilFillMode::kNone) {
+      desc.SetStencilAttachmentDescriptors(stencil);
+    } else {
+      ApplyStencilFillMode(stencil_fill_mode, stencil, desc);
+    }
   }
 
   desc.SetPrimitiveType(primitive_type);
@@ -183,8 +251,12 @@ ContentContext::ContentContext(
 #endif  // IMPELLER_ENABLE_3D
       render_target_cache_(render_target_allocator == nullptr
                                ? std::make_shared<RenderTargetCache>(
-                                     context_->GetResourceAllocator())
+                                     context_->GetResourceAllocator(),
+                                     kRenderTargetKeepAliveFrameCount,
+                                     kMaxUnusedRenderTargetBytes)
                                : std::move(render_target_allocator)),
+      gradient_texture_cache_(std::make_shared<GradientTextureCache>()),
+      geometry_buffer_memo_(std::make_shared<GeometryBufferMemo>()),
       host_buffer_(HostBuffer::Create(context_->GetResourceAllocator())) {
   if (!context_ || !context_->IsValid()) {
     return;
@@ -213,6 +285,7 @@ ContentContext::ContentContext(
     radial_gradient_ssbo_fill_pipelines_.CreateDefault(*context_, options);
     conical_gradient_ssbo_fill_pipelines_.CreateDefault(*context_, options);
     sweep_gradient_ssbo_fill_pipelines_.CreateDefault(*context_, options);
+    texture_instanced_pipelines_.CreateDefault(*context_, options);
   } else {
     linear_gradient_fill_pipelines_.CreateDefault(*context_, options);
     radial_gradient_fill_pipelines_.CreateDefault(*context_, options);
@@ -329,6 +402,7 @@ ContentContext::ContentContext(
       *context_, options_trianglestrip,
       {static_cast<Scalar>(BlendSelectValues::kSoftLight), supports_decal});
 
+  rrect_aa_pipelines_.CreateDefault(*context_, options_trianglestrip);
   rrect_blur_pipelines_.CreateDefault(*context_, options_trianglestrip);
   texture_blend_pipelines_.CreateDefault(*context_, options);
   texture_pipelines_.CreateDefault(*context_, options);
@@ -352,6 +426,7 @@ ContentContext::ContentContext(
                                                  options_trianglestrip);
   glyph_atlas_pipelines_.CreateDefault(*context_, options);
   glyph_atlas_color_pipelines_.CreateDefault(*context_, options);
+  glyph_atlas_sdf_pipelines_.CreateDefault(*context_, options);
   geometry_color_pipelines_.CreateDefault(*context_, options);
   yuv_to_rgb_filter_pipelines_.CreateDefault(*context_, options_trianglestrip);
   porter_duff_blend_pipelines_.CreateDefault(*context_, options_trianglestrip,
@@ -401,15 +476,33 @@ ContentContext::ContentContext(
   clip_pipelines_.SetDefault(options, std::make_unique<ClipPipeline>(
                                           *context_, clip_pipeline_descriptor));
 
+  // This is invoked on the raster thread between frames, and removed before
+  // the content context is destroyed.
+  pressure_callback_id_ =
+      context_->GetResourceAllocator()->GetAccountant().AddPressureCallback(
+          [this](size_t) { ReleaseCachedResources(); });
+
   is_valid_ = true;
 }
 
-ContentContext::~ContentContext() = default;
+ContentContext::~ContentContext() {
+  if (pressure_callback_id_.has_value()) {
+    context_->GetResourceAllocator()->GetAccountant().RemovePressureCallback(
+        pressure_callback_id_.value());
+  }
+}
 
 bool ContentContext::IsValid() const {
   return is_valid_;
 }
 
+void ContentContext::ReleaseCachedResources() const {
+  TRACE_EVENT0("impeller", "ContentContext::ReleaseCachedResources");
+  render_target_cache_->Trim();
+  gradient_texture_cache_->Trim();
+  lazy_glyph_atlas_->Trim();
+}
+
 fml::StatusOr<RenderTarget> ContentContext::MakeSubpass(
     const std::string& label,
     ISize texture_size,
@@ -457,6 +550,7 @@ fml::StatusOr<RenderTarget> ContentContext::MakeSubpass(
     return fml::Status(fml::StatusCode::kUnknown, "");
   }
   sub_renderpass->SetLabel(SPrintF("%s RenderPass", label.c_str()));
+  sub_renderpass->SetDrawCategory(draw_category_);
 
   if (!subpass_callback(*this, *sub_renderpass)) {
     return fml::Status(fml::StatusCode::kUnknown, "");
@@ -491,12 +585,82 @@ void ContentContext::SetWireframe(bool wireframe) {
   wireframe_ = wireframe;
 }
 
-std::shared_ptr<Pipeline<PipelineDescriptor>>
+void ContentContext::SetDrawReordering(bool enabled) {
+  draw_reordering_ = enabled;
+}
+
+bool ContentContext::IsDrawReorderingEnabled() const {
+  return draw_reordering_;
+}
+
+void ContentContext::SetGaussianBlurPyramidThreshold(
+    std::optional<Scalar> sigma) {
+  gaussian_blur_pyramid_threshold_ = sigma;
+}
+
+std::optional<Scalar> ContentContext::GetGaussianBlurPyramidThreshold() const {
+  return gaussian_blur_pyramid_threshold_;
+}
+
+void ContentContext::SetGaussianBlurDownsampleScale(Scalar scale) {
+  gaussian_blur_downsample_scale_ = scale;
+}
+
+Scalar ContentContext::GetGaussianBlurDownsampleScale() const {
+  return gaussian_blur_downsample_scale_;
+}
+
+void ContentContext::SetAsyncRuntimeEffectPipelines(bool enabled) {
+  async_runtime_effect_pipelines_ = enabled;
+}
+
+bool ContentContext::AreRuntimeEffectPipelinesAsync() const {
+  return async_runtime_effect_pipelines_;
+}
+
+void ContentContext::SetAnalyticAntialiasing(bool enabled) {
+  analytic_antialiasing_ = enabled;
+}
+
+bool ContentContext::IsAnalyticAntialiasingEnabled() const {
+  return analytic_antialiasing_;
+}
+
+void ContentContext::SetStencilThenCoverFills(bool enabled) {
+  stencil_then_cover_fills_ = enabled;
+}
+
+bool ContentContext::AreStencilThenCoverFillsEnabled() const {
+  return stencil_then_cover_fills_;
+}
+
+ContentContext::DrawBatchingStatistics&
+ContentContext::GetDrawBatchingStatistics() {
+  return draw_batching_statistics_;
+}
+
+ContentContext::ClipStatistics& ContentContext::GetClipStatistics() {
+  return clip_statistics_;
+}
+
+ContentContext::SubpassStatistics& ContentContext::GetSubpassStatistics() {
+  return subpass_statistics_;
+}
+
+void ContentContext::SetDrawCategory(DrawCategory category) const {
+  draw_category_ = category;
+}
+
+DrawCategory ContentContext::GetDrawCategory() const {
+  return draw_category_;
+}
+
+PipelineFuture<PipelineDescriptor>
 ContentContext::GetCachedRuntimeEffectPipeline(
     const std::string& unique_entrypoint_name,
     const ContentContextOptions& options,
-    const std::function<std::shared_ptr<Pipeline<PipelineDescriptor>>()>&
-        create_callback) const {
+    const std::function<PipelineFuture<PipelineDescriptor>()>& create_callback)
+    const {
   RuntimeEffectPipelineKey key{unique_entrypoint_name, options};
   auto it = runtime_effect_pipelines_.find(key);
   if (it == runtime_effect_pipelines_.end()) {
@@ -505,8 +669,23 @@ ContentContext::GetCachedRuntimeEffectPipeline(
   return it->second;
 }
 
+bool ContentContext::RegisterRuntimeEffectFunctionAsync(
+    const std::string& unique_entrypoint_name,
+    ShaderStage stage,
+    std::shared_ptr<fml::Mapping> code) const {
+  auto& done = runtime_effect_function_registrations_[unique_entrypoint_name];
+  if (!done) {
+    done = std::make_shared<std::atomic_bool>(false);
+    context_->GetShaderLibrary()->RegisterFunction(
+        unique_entrypoint_name, stage, std::move(code),
+        [done = done](bool result) { done->store(true); });
+  }
+  return done->load();
+}
+
 void ContentContext::ClearCachedRuntimeEffectPipeline(
     const std::string& unique_entrypoint_name) const {
+  runtime_effect_function_registrations_.erase(unique_entrypoint_name);
   for (auto it = runtime_effect_pipelines_.begin();
        it != runtime_effect_pipelines_.end();) {
     if (it->first.unique_entrypoint_name == unique_entrypoint_name) {
@@ -517,4 +696,210 @@ void ContentContext::ClearCachedRuntimeEffectPipeline(
   }
 }
 
+
+std::vector<std::pair<std::string_view, ContentContext::VariantsBase*>>
+ContentContext::GetAllVariants() const {
+  // The names are recorded in pipeline variant lists and must not change.
+#define IPLR_VARIANTS(name) {#name, &name##_pipelines_}
+  return {
+#ifdef IMPELLER_DEBUG
+      IPLR_VARIANTS(checkerboard),
+#endif  // IMPELLER_DEBUG
+      IPLR_VARIANTS(solid_fill),
+      IPLR_VARIANTS(linear_gradient_fill),
+      IPLR_VARIANTS(radial_gradient_fill),
+      IPLR_VARIANTS(conical_gradient_fill),
+      IPLR_VARIANTS(sweep_gradient_fill),
+      IPLR_VARIANTS(linear_gradient_ssbo_fill),
+      IPLR_VARIANTS(radial_gradient_ssbo_fill),
+      IPLR_VARIANTS(conical_gradient_ssbo_fill),
+      IPLR_VARIANTS(sweep_gradient_ssbo_fill),
+      IPLR_VARIANTS(rrect_aa),
+      IPLR_VARIANTS(rrect_blur),
+      IPLR_VARIANTS(texture_blend),
+      IPLR_VARIANTS(texture),
+      IPLR_VARIANTS(texture_strict_src),
+#ifdef IMPELLER_ENABLE_OPENGLES
+      IPLR_VARIANTS(texture_external),
+      IPLR_VARIANTS(tiled_texture_external),
+#endif  // IMPELLER_ENABLE_OPENGLES
+      IPLR_VARIANTS(position_uv),
+      IPLR_VARIANTS(tiled_texture),
+      IPLR_VARIANTS(gaussian_blur_noalpha_decal),
+      IPLR_VARIANTS(gaussian_blur_noalpha_nodecal),
+      IPLR_VARIANTS(kernel_decal),
+      IPLR_VARIANTS(kernel_nodecal),
+      IPLR_VARIANTS(border_mask_blur),
+      IPLR_VARIANTS(morphology_filter),
+      IPLR_VARIANTS(color_matrix_color_filter),
+      IPLR_VARIANTS(linear_to_srgb_filter),
+      IPLR_VARIANTS(srgb_to_linear_filter),
+      IPLR_VARIANTS(clip),
+      IPLR_VARIANTS(glyph_atlas),
+      IPLR_VARIANTS(glyph_atlas_color),
+      IPLR_VARIANTS(glyph_atlas_sdf),
+      IPLR_VARIANTS(geometry_color),
+      IPLR_VARIANTS(yuv_to_rgb_filter),
+      IPLR_VARIANTS(porter_duff_blend),
+      IPLR_VARIANTS(blend_color),
+      IPLR_VARIANTS(blend_colorburn),
+      IPLR_VARIANTS(blend_colordodge),
+      IPLR_VARIANTS(blend_darken),
+      IPLR_VARIANTS(blend_difference),
+      IPLR_VARIANTS(blend_exclusion),
+      IPLR_VARIANTS(blend_hardlight),
+      IPLR_VARIANTS(blend_hue),
+      IPLR_VARIANTS(blend_lighten),
+      IPLR_VARIANTS(blend_luminosity),
+      IPLR_VARIANTS(blend_multiply),
+      IPLR_VARIANTS(blend_overlay),
+      IPLR_VARIANTS(blend_saturation),
+      IPLR_VARIANTS(blend_screen),
+      IPLR_VARIANTS(blend_softlight),
+      IPLR_VARIANTS(framebuffer_blend_color),
+      IPLR_VARIANTS(framebuffer_blend_colorburn),
+      IPLR_VARIANTS(framebuffer_blend_colordodge),
+      IPLR_VARIANTS(framebuffer_blend_darken),
+      IPLR_VARIANTS(framebuffer_blend_difference),
+      IPLR_VARIANTS(framebuffer_blend_exclusion),
+      IPLR_VARIANTS(framebuffer_blend_hardlight),
+      IPLR_VARIANTS(framebuffer_blend_hue),
+      IPLR_VARIANTS(framebuffer_blend_lighten),
+      IPLR_VARIANTS(framebuffer_blend_luminosity),
+      IPLR_VARIANTS(framebuffer_blend_multiply),
+      IPLR_VARIANTS(framebuffer_blend_overlay),
+      IPLR_VARIANTS(framebuffer_blend_saturation),
+      IPLR_VARIANTS(framebuffer_blend_screen),
+      IPLR_VARIANTS(framebuffer_blend_softlight),
+  };
+#undef IPLR_VARIANTS
+}
+
+size_t ContentContext::GetPipelineVariantCount() const {
+  size_t count = 0u;
+  for (const auto& [name, variants] : GetAllVariants()) {
+    count += variants->GetVariantOptions().size();
+  }
+  return count;
+}
+
+std::string ContentContext::GetPipelineVariants() const {
+  std::vector<std::string> lines;
+  for (const auto& [name, variants] : GetAllVariants()) {
+    for (const auto& options : variants->GetVariantOptions()) {
+      std::stringstream line;
+      line << name << " " << static_cast<int>(options.sample_count) << " "
+           << static_cast<int>(options.blend_mode) << " "
+           << static_cast<int>(options.stencil_compare) << " "
+           << static_cast<int>(options.stencil_operation) << " "
+           << static_cast<int>(options.primitive_type) << " "
+           << static_cast<int>(options.color_attachment_pixel_format) << " "
+           << options.has_stencil_attachment << " " << options.wireframe
+           << " " << options.is_for_rrect_blur_clear << " "
+           << static_cast<int>(options.stencil_fill_mode);
+      lines.push_back(line.str());
+    }
+  }
+  // The containers are unordered. Sort the list so that it only changes when
+  // the set of variants does.
+  std::sort(lines.begin(), lines.end());
+
+  std::string result(kPipelineVariantsHeader);
+  result += "\n";
+  for (const auto& line : lines) {
+    result += line;
+    result += "\n";
+  }
+  return result;
+}
+
+namespace {
+
+template <class T>
+bool ReadEnum(std::istream& stream, T last, T& value) {
+  int raw = -1;
+  if (!(stream >> raw) || raw < 0 || raw > static_cast<int>(last)) {
+    return false;
+  }
+  value = static_cast<T>(raw);
+  return true;
+}
+
+bool ReadBool(std::istream& stream, bool& value) {
+  int raw = -1;
+  if (!(stream >> raw) || (raw != 0 && raw != 1)) {
+    return false;
+  }
+  value = raw == 1;
+  return true;
+}
+
+std::optional<std::pair<std::string, ContentContextOptions>>
+ParsePipelineVariant(const std::string& line) {
+  std::istringstream stream(line);
+  std::string name;
+  ContentContextOptions options;
+  if (!(stream >> name) ||
+      !ReadEnum(stream, SampleCount::kCount4, options.sample_count) ||
+      !ReadEnum(stream, BlendMode::kLast, options.blend_mode) ||
+      !ReadEnum(stream, CompareFunction::kAlways, options.stencil_compare) ||
+      !ReadEnum(stream, StencilOperation::kDecrementWrap,
+                options.stencil_operation) ||
+      !ReadEnum(stream, PrimitiveType::kPoint, options.primitive_type) ||
+      !ReadEnum(stream, PixelFormat::kD32FloatS8UInt,
+                options.color_attachment_pixel_format) ||
+      !ReadBool(stream, options.has_stencil_attachment) ||
+      !ReadBool(stream, options.wireframe) ||
+      !ReadBool(stream, options.is_for_rrect_blur_clear) ||
+      !ReadEnum(stream, StencilFillMode::kLast, options.stencil_fill_mode)) {
+    return std::nullopt;
+  }
+  if (options.sample_count != SampleCount::kCount1 &&
+      options.sample_count != SampleCount::kCount4) {
+    return std::nullopt;
+  }
+  std::string trailing;
+  if (stream >> trailing) {
+    return std::nullopt;
+  }
+  return std::make_pair(std::move(name), options);
+}
+
+}  // namespace
+
+size_t ContentContext::PrewarmPipelineVariants(
+    std::string_view variants) const {
+  if (!IsValid()) {
+    return 0u;
+  }
+  TRACE_EVENT0("impeller", "ContentContext::PrewarmPipelineVariants");
+
+  std::istringstream stream{std::string(variants)};
+  std::string line;
+  if (!std::getline(stream, line) || line != kPipelineVariantsHeader) {
+    return 0u;
+  }
+
+  std::unordered_map<std::string_view, VariantsBase*> all_variants;
+  for (const auto& [name, container] : GetAllVariants()) {
+    all_variants[name] = container;
+  }
+
+  size_t count = 0u;
+  while (std::getline(stream, line)) {
+    auto variant = ParsePipelineVariant(line);
+    if (!variant.has_value()) {
+      continue;
+    }
+    auto found = all_variants.find(variant->first);
+    if (found == all_variants.end()) {
+      continue;
+    }
+    if (found->second->CreateVariant(*context_, variant->second)) {
+      count++;
+    }
+  }
+  return count;
+}
+
 }  // namespace impeller
@@ -5,10 +5,15 @@
 #ifndef FLUTTER_IMPELLER_ENTITY_CONTENTS_CONTENT_CONTEXT_H_
 #define FLUTTER_IMPELLER_ENTITY_CONTENTS_CONTENT_CONTEXT_H_
 
+#include <atomic>
 #include <initializer_list>
 #include <memory>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
@@ -40,6 +45,7 @@
 #include "impeller/entity/glyph_atlas.frag.h"
 #include "impeller/entity/glyph_atlas.vert.h"
 #include "impeller/entity/glyph_atlas_color.frag.h"
+#include "impeller/entity/glyph_atlas_sdf.frag.h"
 #include "impeller/entity/gradient_fill.vert.h"
 #include "impeller/entity/linear_gradient_fill.frag.h"
 #include "impeller/entity/linear_to_srgb_filter.frag.h"
@@ -50,6 +56,8 @@
 #include "impeller/entity/porter_duff_blend.frag.h"
 #include "impeller/entity/porter_duff_blend.vert.h"
 #include "impeller/entity/radial_gradient_fill.frag.h"
+#include "impeller/entity/rrect_aa.frag.h"
+#include "impeller/entity/rrect_aa.vert.h"
 #include "impeller/entity/rrect_blur.frag.h"
 #include "impeller/entity/rrect_blur.vert.h"
 #include "impeller/entity/solid_fill.frag.h"
@@ -80,6 +88,7 @@
 #include "impeller/entity/linear_gradient_ssbo_fill.frag.h"
 #include "impeller/entity/radial_gradient_ssbo_fill.frag.h"
 #include "impeller/entity/sweep_gradient_ssbo_fill.frag.h"
+#include "impeller/entity/texture_fill_instanced.vert.h"
 
 #include "impeller/entity/advanced_blend.frag.h"
 #include "impeller/entity/advanced_blend.vert.h"
@@ -126,11 +135,16 @@ using RadialGradientSSBOFillPipeline =
 using SweepGradientSSBOFillPipeline =
     RenderPipelineT<GradientFillVertexShader,
                     SweepGradientSsboFillFragmentShader>;
+using RRectAAPipeline =
+    RenderPipelineT<RrectAaVertexShader, RrectAaFragmentShader>;
 using RRectBlurPipeline =
     RenderPipelineT<RrectBlurVertexShader, RrectBlurFragmentShader>;
 using BlendPipeline = RenderPipelineT<BlendVertexShader, BlendFragmentShader>;
 using TexturePipeline =
     RenderPipelineT<TextureFillVertexShader, TextureFillFragmentShader>;
+using TextureInstancedPipeline =
+    RenderPipelineT<TextureFillInstancedVertexShader,
+                    TextureFillFragmentShader>;
 using TextureStrictSrcPipeline =
     RenderPipelineT<TextureFillVertexShader,
                     TextureFillStrictSrcFragmentShader>;
@@ -166,6 +180,8 @@ using GlyphAtlasPipeline =
     RenderPipelineT<GlyphAtlasVertexShader, GlyphAtlasFragmentShader>;
 using GlyphAtlasColorPipeline =
     RenderPipelineT<GlyphAtlasVertexShader, GlyphAtlasColorFragmentShader>;
+using GlyphAtlasSdfPipeline =
+    RenderPipelineT<GlyphAtlasVertexShader, GlyphAtlasSdfFragmentShader>;
 using PorterDuffBlendPipeline =
     RenderPipelineT<PorterDuffBlendVertexShader, PorterDuffBlendFragmentShader>;
 // Instead of requiring new shaders for clips, the solid fill stages are used
@@ -268,6 +284,28 @@ using TiledTextureExternalPipeline =
                     TiledTextureFillExternalFragmentShader>;
 #endif  // IMPELLER_ENABLE_OPENGLES
 
+/// Stencil configurations of the draws of a stencil-then-cover path fill.
+///
+/// While a fill is in progress, bit 7 of the stencil buffer marks the pixels
+/// at the clip depth of the fill, and the low 7 bits of the marked pixels
+/// count the winding of the path. This requires clip depths below 128.
+enum class StencilFillMode : uint8_t {
+  /// The stencil is configured by `stencil_compare` and `stencil_operation`.
+  kNone,
+  /// Sets bit 7 of the pixels whose value is the reference clip depth.
+  kMark,
+  /// Resets the count of marked pixels.
+  kClearCount,
+  /// Counts front facing triangles up and back facing triangles down in
+  /// marked pixels.
+  kNonZero,
+  /// Toggles the lowest bit of marked pixels for every triangle.
+  kEvenOdd,
+  /// Passes marked pixels with a nonzero count.
+  kCover,
+  kLast = kCover,
+};
+
 /// Pipeline state configuration.
 ///
 /// Each unique combination of these options requires a different pipeline state
@@ -288,6 +326,7 @@ struct ContentContextOptions {
   bool has_stencil_attachment = true;
   bool wireframe = false;
   bool is_for_rrect_blur_clear = false;
+  StencilFillMode stencil_fill_mode = StencilFillMode::kNone;
 
   struct Hash {
     constexpr uint64_t operator()(const ContentContextOptions& o) const {
@@ -298,11 +337,13 @@ struct ContentContextOptions {
       static_assert(sizeof(o.stencil_operation) == 1);
       static_assert(sizeof(o.primitive_type) == 1);
       static_assert(sizeof(o.color_attachment_pixel_format) == 1);
+      static_assert(sizeof(o.stencil_fill_mode) == 1);
 
       return (o.is_for_rrect_blur_clear ? 1llu : 0llu) << 0 |
              (o.wireframe ? 1llu : 0llu) << 1 |
              (o.has_stencil_attachment ? 1llu : 0llu) << 2 |
              // enums
+             static_cast<uint64_t>(o.stencil_fill_mode) << 8 |
              static_cast<uint64_t>(o.color_attachment_pixel_format) << 16 |
              static_cast<uint64_t>(o.primitive_type) << 24 |
              static_cast<uint64_t>(o.stencil_operation) << 32 |
@@ -324,7 +365,8 @@ struct ContentContextOptions {
                  rhs.color_attachment_pixel_format &&
              lhs.has_stencil_attachment == rhs.has_stencil_attachment &&
              lhs.wireframe == rhs.wireframe &&
-             lhs.is_for_rrect_blur_clear == rhs.is_for_rrect_blur_clear;
+             lhs.is_for_rrect_blur_clear == rhs.is_for_rrect_blur_clear &&
+             lhs.stencil_fill_mode == rhs.stencil_fill_mode;
     }
   };
 
@@ -333,6 +375,8 @@ struct ContentContextOptions {
 
 class Tessellator;
 class RenderTargetCache;
+class GradientTextureCache;
+class GeometryBufferMemo;
 
 class ContentContext {
  public:
@@ -397,6 +441,11 @@ class ContentContext {
     return GetPipeline(conical_gradient_fill_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetRRectAAPipeline(
+      ContentContextOptions opts) const {
+    return GetPipeline(rrect_aa_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetRRectBlurPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(rrect_blur_pipelines_, opts);
@@ -422,6 +471,12 @@ class ContentContext {
     return GetPipeline(texture_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetTextureInstancedPipeline(
+      ContentContextOptions opts) const {
+    FML_DCHECK(GetDeviceCapabilities().SupportsSSBO());
+    return GetPipeline(texture_instanced_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetTextureStrictSrcPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(texture_strict_src_pipelines_, opts);
@@ -513,6 +568,11 @@ class ContentContext {
     return GetPipeline(glyph_atlas_color_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetGlyphAtlasSdfPipeline(
+      ContentContextOptions opts) const {
+    return GetPipeline(glyph_atlas_sdf_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetGeometryColorPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(geometry_color_pipelines_, opts);
@@ -714,6 +774,115 @@ class ContentContext {
 
   void SetWireframe(bool wireframe);
 
+  //----------------------------------------------------------------------------
+  /// @brief  Allows entity passes to reorder draws whose coverage does not
+  ///         overlap so that more draws sharing a pipeline can be batched.
+  ///         Disabled by default.
+  ///
+  void SetDrawReordering(bool enabled);
+
+  bool IsDrawReorderingEnabled() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief  Gaussian blurs with a scaled sigma of at least `sigma` are
+  ///         downsampled through a pyramid of successive halvings instead of
+  ///         a single pass, which avoids the shimmering of large blurs over
+  ///         inputs without mipmaps. Disabled by default.
+  ///
+  void SetGaussianBlurPyramidThreshold(std::optional<Scalar> sigma);
+
+  std::optional<Scalar> GetGaussianBlurPyramidThreshold() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief  The downsample factor of Gaussian blurs is multiplied by `scale`,
+  ///         which trades the quality of blurs for fill rate when it is less
+  ///         than 1. Defaults to 1.
+  ///
+  void SetGaussianBlurDownsampleScale(Scalar scale);
+
+  Scalar GetGaussianBlurDownsampleScale() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief  Runtime effect shaders and pipelines are compiled without
+  ///         blocking the raster thread, and runtime effects are not drawn
+  ///         until they are ready. Disabled by default.
+  ///
+  void SetAsyncRuntimeEffectPipelines(bool enabled);
+
+  bool AreRuntimeEffectPipelinesAsync() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief  Solid filled rects, rrects, ellipses, circles and lines compute
+  ///         their edge coverage in the fragment stage instead of relying on
+  ///         multisampling, and offscreen passes that only contain such draws
+  ///         are rendered without multisampling. Disabled by default.
+  ///
+  void SetAnalyticAntialiasing(bool enabled);
+
+  bool IsAnalyticAntialiasingEnabled() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief  Solid filled paths that are not convex are drawn as triangle
+  ///         fans into the stencil buffer and then covered by their bounds
+  ///         instead of being triangulated. Disabled by default.
+  ///
+  void SetStencilThenCoverFills(bool enabled);
+
+  bool AreStencilThenCoverFillsEnabled() const;
+
+  struct DrawBatchingStatistics {
+    /// The number of draws merged into another one.
+    size_t merged_draw_count = 0u;
+    /// The number of merged draws that had to be reordered.
+    size_t reordered_draw_count = 0u;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief  Draw batching statistics of the frame being rendered. The root
+  ///         entity pass resets them before rendering and reports them as
+  ///         trace counters afterwards.
+  ///
+  DrawBatchingStatistics& GetDrawBatchingStatistics();
+
+  struct ClipStatistics {
+    /// The number of rectangular clips applied as scissor rects instead of
+    /// being drawn to the stencil buffer.
+    size_t scissor_clip_count = 0u;
+    /// The number of clip restores that did not need a stencil draw.
+    size_t skipped_restore_count = 0u;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief  Stencil draws saved by the clips of the frame being rendered.
+  ///         The root entity pass resets them before rendering and reports
+  ///         them as trace counters afterwards.
+  ///
+  ClipStatistics& GetClipStatistics();
+
+  struct SubpassStatistics {
+    /// The number of subpasses rendered to an offscreen texture.
+    size_t offscreen_subpass_count = 0u;
+    /// The number of subpasses collapsed into their parent pass, whose
+    /// offscreen textures were avoided.
+    size_t collapsed_subpass_count = 0u;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief  Offscreen textures used and avoided by the subpasses of the frame
+  ///         being rendered. The root entity pass resets them before
+  ///         rendering and reports them as trace counters afterwards.
+  ///
+  SubpassStatistics& GetSubpassStatistics();
+
+  //----------------------------------------------------------------------------
+  /// @brief  The category of the contents being rendered. Subpasses made by
+  ///         |MakeSubpass| attribute their draws to it, as do contents that
+  ///         don't have a category of their own. Set by |Entity::Render|.
+  ///
+  void SetDrawCategory(DrawCategory category) const;
+
+  DrawCategory GetDrawCategory() const;
+
   using SubpassCallback =
       std::function<bool(const ContentContext&, RenderPass&)>;
 
@@ -739,6 +908,28 @@ class ContentContext {
     return render_target_cache_;
   }
 
+  /// Gradient textures must be obtained via this cache to avoid uploading
+  /// the same ramp every frame.
+  std::shared_ptr<GradientTextureCache> GetGradientTextureCache() const {
+    return gradient_texture_cache_;
+  }
+
+  /// The vertex buffers of analytic shapes that are drawn repeatedly are
+  /// emplaced onto the transients buffer once per frame via this memo.
+  GeometryBufferMemo& GetGeometryBufferMemo() const {
+    return *geometry_buffer_memo_;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief  Releases the textures kept for reuse by the next frames: unused
+  ///         render targets, gradient ramps and glyph atlases. Called when
+  ///         the device is low on memory.
+  ///
+  ///         This is only safe to call from the raster threads, between
+  ///         frames.
+  ///
+  void ReleaseCachedResources() const;
+
   /// RuntimeEffect pipelines must be obtained via this method to avoid
   /// re-creating them every frame.
   ///
@@ -747,13 +938,23 @@ class ContentContext {
   /// based on the input file name and shader stage.
   ///
   /// The create_callback is synchronously invoked exactly once if a cached
-  /// pipeline is not found.
-  std::shared_ptr<Pipeline<PipelineDescriptor>> GetCachedRuntimeEffectPipeline(
+  /// pipeline is not found. The returned future may not be ready yet.
+  PipelineFuture<PipelineDescriptor> GetCachedRuntimeEffectPipeline(
       const std::string& unique_entrypoint_name,
       const ContentContextOptions& options,
-      const std::function<std::shared_ptr<Pipeline<PipelineDescriptor>>()>&
+      const std::function<PipelineFuture<PipelineDescriptor>()>&
           create_callback) const;
 
+  /// Starts registering the fragment function of a runtime effect with the
+  /// shader library of the context if it hasn't been started yet, without
+  /// waiting for it.
+  ///
+  /// @return Whether the registration has completed, successfully or not.
+  bool RegisterRuntimeEffectFunctionAsync(
+      const std::string& unique_entrypoint_name,
+      ShaderStage stage,
+      std::shared_ptr<fml::Mapping> code) const;
+
   /// Used by hot reload/hot restart to clear a cached pipeline from
   /// GetCachedRuntimeEffectPipeline.
   void ClearCachedRuntimeEffectPipeline(
@@ -765,6 +966,35 @@ class ContentContext {
   /// allocate their own device buffers.
   HostBuffer& GetTransientsBuffer() const { return *host_buffer_; }
 
+  /// The first line of a list returned by |GetPipelineVariants|.
+  static constexpr std::string_view kPipelineVariantsHeader =
+      "impeller-pipeline-variants-2";
+
+  //----------------------------------------------------------------------------
+  /// @brief      Lists the pipeline variants created besides the prototypes,
+  ///             one per line. The list is stable across sessions and can be
+  ///             bundled with an application to prewarm these variants.
+  ///
+  std::string GetPipelineVariants() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of pipeline variants created besides the
+  ///             prototypes.
+  ///
+  size_t GetPipelineVariantCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts creating the pipeline variants in a list returned by
+  ///             |GetPipelineVariants|, without waiting for them. Variants
+  ///             that already exist or that this device can't use, and
+  ///             malformed lines, are skipped.
+  ///
+  ///             This is only safe to call from the raster threads.
+  ///
+  /// @return     The number of variants whose creation was started.
+  ///
+  size_t PrewarmPipelineVariants(std::string_view variants) const;
+
  private:
   std::shared_ptr<Context> context_;
   std::shared_ptr<LazyGlyphAtlas> lazy_glyph_atlas_;
@@ -790,13 +1020,36 @@ class ContentContext {
   };
 
   mutable std::unordered_map<RuntimeEffectPipelineKey,
-                             std::shared_ptr<Pipeline<PipelineDescriptor>>,
+                             PipelineFuture<PipelineDescriptor>,
                              RuntimeEffectPipelineKey::Hash,
                              RuntimeEffectPipelineKey::Equal>
       runtime_effect_pipelines_;
 
+  // Set by the shader library once the registration of a runtime effect
+  // function has completed, possibly on another thread.
+  mutable std::unordered_map<std::string, std::shared_ptr<std::atomic_bool>>
+      runtime_effect_function_registrations_;
+
+  class VariantsBase {
+   public:
+    virtual ~VariantsBase() = default;
+
+    /// @brief      The options of every variant besides the default one.
+    virtual std::vector<ContentContextOptions> GetVariantOptions() const = 0;
+
+    //--------------------------------------------------------------------------
+    /// @brief      Starts creating the variant for the options from the
+    ///             descriptor of the prototype, without waiting for it.
+    ///
+    /// @return     Whether a variant was created. It isn't if the variant
+    ///             already exists or there is no prototype.
+    ///
+    virtual bool CreateVariant(const Context& context,
+                               const ContentContextOptions& options) = 0;
+  };
+
   template <class PipelineT>
-  class Variants {
+  class Variants final : public VariantsBase {
    public:
     Variants() = default;
 
@@ -842,6 +1095,40 @@ class ContentContext {
 
     size_t GetPipelineCount() const { return pipelines_.size(); }
 
+    // |VariantsBase|
+    std::vector<ContentContextOptions> GetVariantOptions() const override {
+      std::vector<ContentContextOptions> options;
+      for (const auto& [variant_options, pipeline] : pipelines_) {
+        if (!default_options_.has_value() ||
+            !ContentContextOptions::Equal{}(variant_options,
+                                            default_options_.value())) {
+          options.push_back(variant_options);
+        }
+      }
+      return options;
+    }
+
+    // |VariantsBase|
+    bool CreateVariant(const Context& context,
+                       const ContentContextOptions& options) override {
+      if (Get(options) != nullptr) {
+        return false;
+      }
+      auto prototype = GetDefault();
+      if (prototype == nullptr) {
+        return false;
+      }
+      auto desc = prototype->GetDescriptor();
+      if (!desc.has_value()) {
+        return false;
+      }
+      options.ApplyToPipelineDescriptor(*desc);
+      desc->SetLabel(
+          SPrintF("%s V#%zu", desc->GetLabel().c_str(), GetPipelineCount()));
+      Set(options, std::make_unique<PipelineT>(context, desc));
+      return true;
+    }
+
    private:
     std::optional<ContentContextOptions> default_options_;
     std::unordered_map<ContentContextOptions,
@@ -877,9 +1164,11 @@ class ContentContext {
       conical_gradient_ssbo_fill_pipelines_;
   mutable Variants<SweepGradientSSBOFillPipeline>
       sweep_gradient_ssbo_fill_pipelines_;
+  mutable Variants<RRectAAPipeline> rrect_aa_pipelines_;
   mutable Variants<RRectBlurPipeline> rrect_blur_pipelines_;
   mutable Variants<BlendPipeline> texture_blend_pipelines_;
   mutable Variants<TexturePipeline> texture_pipelines_;
+  mutable Variants<TextureInstancedPipeline> texture_instanced_pipelines_;
   mutable Variants<TextureStrictSrcPipeline> texture_strict_src_pipelines_;
 #ifdef IMPELLER_ENABLE_OPENGLES
   mutable Variants<TextureExternalPipeline> texture_external_pipelines_;
@@ -903,6 +1192,7 @@ class ContentContext {
   mutable Variants<ClipPipeline> clip_pipelines_;
   mutable Variants<GlyphAtlasPipeline> glyph_atlas_pipelines_;
   mutable Variants<GlyphAtlasColorPipeline> glyph_atlas_color_pipelines_;
+  mutable Variants<GlyphAtlasSdfPipeline> glyph_atlas_sdf_pipelines_;
   mutable Variants<GeometryColorPipeline> geometry_color_pipelines_;
   mutable Variants<YUVToRGBFilterPipeline> yuv_to_rgb_filter_pipelines_;
   mutable Variants<PorterDuffBlendPipeline> porter_duff_blend_pipelines_;
@@ -974,37 +1264,43 @@ class ContentContext {
       return found->WaitAndGet();
     }
 
-    auto prototype = container.GetDefault();
-
     // The prototype must always be initialized in the constructor.
-    FML_CHECK(prototype != nullptr);
+    FML_CHECK(container.GetDefault() != nullptr);
 
-    auto pipeline = prototype->WaitAndGet();
-    if (!pipeline) {
+    if (!container.CreateVariant(*GetContext(), opts)) {
       return nullptr;
     }
-
-    auto variant_future = pipeline->CreateVariant(
-        [&opts, variants_count =
-                    container.GetPipelineCount()](PipelineDescriptor& desc) {
-          opts.ApplyToPipelineDescriptor(desc);
-          desc.SetLabel(
-              SPrintF("%s V#%zu", desc.GetLabel().c_str(), variants_count));
-        });
-    auto variant = std::make_unique<TypedPipeline>(std::move(variant_future));
-    auto variant_pipeline = variant->WaitAndGet();
-    container.Set(opts, std::move(variant));
-    return variant_pipeline;
+    return container.Get(opts)->WaitAndGet();
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Every container of pipeline variants, along with a name that
+  ///             identifies it across sessions.
+  ///
+  std::vector<std::pair<std::string_view, VariantsBase*>> GetAllVariants()
+      const;
+
   bool is_valid_ = false;
   std::shared_ptr<Tessellator> tessellator_;
 #if IMPELLER_ENABLE_3D
   std::shared_ptr<scene::SceneContext> scene_context_;
 #endif  // IMPELLER_ENABLE_3D
   std::shared_ptr<RenderTargetAllocator> render_target_cache_;
+  std::shared_ptr<GradientTextureCache> gradient_texture_cache_;
+  std::shared_ptr<GeometryBufferMemo> geometry_buffer_memo_;
   std::shared_ptr<HostBuffer> host_buffer_;
   bool wireframe_ = false;
+  bool draw_reordering_ = false;
+  bool async_runtime_effect_pipelines_ = false;
+  bool analytic_antialiasing_ = false;
+  bool stencil_then_cover_fills_ = false;
+  std::optional<Scalar> gaussian_blur_pyramid_threshold_;
+  Scalar gaussian_blur_downsample_scale_ = 1.0;
+  DrawBatchingStatistics draw_batching_statistics_;
+  ClipStatistics clip_statistics_;
+  SubpassStatistics subpass_statistics_;
+  mutable DrawCategory draw_category_ = DrawCategory::kOther;
+  std::optional<uint64_t> pressure_callback_id_;
 
   ContentContext(const ContentContext&) = delete;
 
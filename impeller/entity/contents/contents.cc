@@ -47,6 +47,14 @@ bool Contents::IsOpaque() const {
   return false;
 }
 
+DrawCategory Contents::GetDrawCategory() const {
+  return DrawCategory::kOther;
+}
+
+bool Contents::IsAnalyticallyAntialiased(const Entity& entity) const {
+  return false;
+}
+
 Contents::ClipCoverage Contents::GetClipCoverage(
     const Entity& entity,
     const std::optional<Rect>& current_clip_coverage) const {
@@ -125,6 +133,14 @@ const FilterContents* Contents::AsFilter() const {
   return nullptr;
 }
 
+const SolidColorContents* Contents::AsSolidColor() const {
+  return nullptr;
+}
+
+const TextureContents* Contents::AsTexture() const {
+  return nullptr;
+}
+
 bool Contents::ApplyColorFilter(
     const Contents::ColorFilterProc& color_filter_proc) {
   return false;
@@ -14,6 +14,7 @@
 #include "impeller/core/texture.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/rect.h"
+#include "impeller/renderer/draw_category.h"
 #include "impeller/renderer/snapshot.h"
 #include "impeller/typographer/lazy_glyph_atlas.h"
 
@@ -25,6 +26,8 @@ class Entity;
 class Surface;
 class RenderPass;
 class FilterContents;
+class SolidColorContents;
+class TextureContents;
 
 ContentContextOptions OptionsFromPass(const RenderPass& pass);
 
@@ -96,6 +99,20 @@ class Contents {
   ///
   virtual bool IsOpaque() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief Whether this Contents computes its edge coverage in the fragment
+  ///        stage when analytic anti-aliasing is enabled, and so renders
+  ///        correctly into a render target without multisampling.
+  ///
+  virtual bool IsAnalyticallyAntialiased(const Entity& entity) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief The kind of contents this draws, used to attribute the GPU time
+  ///        of a frame. Applies to the subpasses rendered by this contents
+  ///        too.
+  ///
+  virtual DrawCategory GetDrawCategory() const;
+
   //----------------------------------------------------------------------------
   /// @brief Given the current pass space bounding rectangle of the clip
   ///        buffer, return the expected clip coverage after this draw call.
@@ -173,6 +190,18 @@ class Contents {
   ///
   virtual const FilterContents* AsFilter() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief Cast to solid color contents. Returns `nullptr` if this Contents
+  ///        is not a solid color.
+  ///
+  virtual const SolidColorContents* AsSolidColor() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief Cast to texture contents. Returns `nullptr` if this Contents is
+  ///        not a texture.
+  ///
+  virtual const TextureContents* AsTexture() const;
+
   //----------------------------------------------------------------------------
   /// @brief      If possible, applies a color filter to this contents inputs on
   ///             the CPU.
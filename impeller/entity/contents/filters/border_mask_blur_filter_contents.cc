@@ -16,6 +16,10 @@ BorderMaskBlurFilterContents::BorderMaskBlurFilterContents() = default;
 
 BorderMaskBlurFilterContents::~BorderMaskBlurFilterContents() = default;
 
+DrawCategory BorderMaskBlurFilterContents::GetDrawCategory() const {
+  return DrawCategory::kBlur;
+}
+
 void BorderMaskBlurFilterContents::SetSigma(Sigma sigma_x, Sigma sigma_y) {
   sigma_x_ = sigma_x;
   sigma_y_ = sigma_y;
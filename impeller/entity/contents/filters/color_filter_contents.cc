@@ -55,9 +55,43 @@ std::shared_ptr<ColorFilterContents> ColorFilterContents::MakeBlend(
   return new_blend;
 }
 
+// Returns the matrix that applies |inner| and then |outer|.
+static ColorMatrix ComposeColorMatrices(const ColorMatrix& outer,
+                                        const ColorMatrix& inner) {
+  const Scalar* o = outer.array;
+  const Scalar* i = inner.array;
+  ColorMatrix result;
+  for (int row = 0; row < 4; row++) {
+    for (int column = 0; column < 5; column++) {
+      Scalar value = column == 4 ? o[row * 5 + 4] : 0.0f;
+      for (int k = 0; k < 4; k++) {
+        value += o[row * 5 + k] * i[k * 5 + column];
+      }
+      result.array[row * 5 + column] = value;
+    }
+  }
+  return result;
+}
+
 std::shared_ptr<ColorFilterContents> ColorFilterContents::MakeColorMatrix(
     FilterInput::Ref input,
     const ColorMatrix& color_matrix) {
+  // A color matrix filter applied to the output of another one is fused
+  // with it into a single pass when the inner filter's clamp is a no-op,
+  // instead of rendering the inner filter into an offscreen texture.
+  auto variant = input->GetInput();
+  auto inner_filter = std::get_if<std::shared_ptr<FilterContents>>(&variant);
+  if (inner_filter &&
+      ColorMatrixFilterContents::ScalesAlphaOnly(color_matrix)) {
+    const ColorMatrixFilterContents* inner =
+        (*inner_filter)->AsColorMatrixFilter();
+    if (inner && inner->CanFuseIntoNextFilter()) {
+      return MakeColorMatrix(
+          inner->GetInputs()[0],
+          ComposeColorMatrices(color_matrix, inner->GetMatrix()));
+    }
+  }
+
   auto filter = std::make_shared<ColorMatrixFilterContents>();
   filter->SetInputs({std::move(input)});
   filter->SetMatrix(color_matrix);
@@ -4,6 +4,7 @@
 
 #include "impeller/entity/contents/filters/color_matrix_filter_contents.h"
 
+#include <algorithm>
 #include <optional>
 
 #include "impeller/entity/contents/anonymous_contents.h"
@@ -25,6 +26,41 @@ void ColorMatrixFilterContents::SetMatrix(const ColorMatrix& matrix) {
   matrix_ = matrix;
 }
 
+const ColorMatrix& ColorMatrixFilterContents::GetMatrix() const {
+  return matrix_;
+}
+
+bool ColorMatrixFilterContents::ScalesAlphaOnly(const ColorMatrix& matrix) {
+  const Scalar* m = matrix.array;
+  return m[15] == 0.0f && m[16] == 0.0f && m[17] == 0.0f && m[18] > 0.0f &&
+         m[18] <= 1.0f && m[19] == 0.0f;
+}
+
+bool ColorMatrixFilterContents::CanFuseIntoNextFilter() const {
+  if (GetAbsorbOpacity() == AbsorbOpacity::kYes || GetAlpha().has_value() ||
+      GetInputs().size() != 1u) {
+    return false;
+  }
+  const Scalar* m = matrix_.array;
+  for (int row = 0; row < 3; row++) {
+    Scalar min = m[row * 5 + 4];
+    Scalar max = m[row * 5 + 4];
+    for (int column = 0; column < 4; column++) {
+      min += std::min(m[row * 5 + column], 0.0f);
+      max += std::max(m[row * 5 + column], 0.0f);
+    }
+    if (min < 0.0f || max > 1.0f) {
+      return false;
+    }
+  }
+  return ScalesAlphaOnly(matrix_);
+}
+
+const ColorMatrixFilterContents*
+ColorMatrixFilterContents::AsColorMatrixFilter() const {
+  return this;
+}
+
 std::optional<Entity> ColorMatrixFilterContents::RenderFilter(
     const FilterInput::Vector& inputs,
     const ContentContext& renderer,
@@ -23,6 +23,26 @@ class ColorMatrixFilterContents final : public ColorFilterContents {
 
   void SetMatrix(const ColorMatrix& matrix);
 
+  const ColorMatrix& GetMatrix() const;
+
+  /// @brief  Whether the alpha of colors transformed by `matrix` is their
+  ///         alpha scaled by a factor in (0, 1], so that transparent pixels
+  ///         stay transparent and no others become transparent.
+  static bool ScalesAlphaOnly(const ColorMatrix& matrix);
+
+  /// @brief  Whether this filter can be fused into a following color matrix
+  ///         filter that `ScalesAlphaOnly`.
+  ///
+  ///         This is the case when the clamp of this filter's output is a
+  ///         no-op: the matrix maps every unpremultiplied color within [0, 1]
+  ///         to a color within [0, 1]. The alpha of both matrices must only
+  ///         be scaled, because the intermediate texture loses the color of
+  ///         transparent pixels.
+  bool CanFuseIntoNextFilter() const;
+
+  // |FilterContents|
+  const ColorMatrixFilterContents* AsColorMatrixFilter() const override;
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(
@@ -37,6 +37,10 @@ DirectionalGaussianBlurFilterContents::DirectionalGaussianBlurFilterContents() =
 DirectionalGaussianBlurFilterContents::
     ~DirectionalGaussianBlurFilterContents() = default;
 
+DrawCategory DirectionalGaussianBlurFilterContents::GetDrawCategory() const {
+  return DrawCategory::kBlur;
+}
+
 void DirectionalGaussianBlurFilterContents::SetSigma(Sigma sigma) {
   blur_sigma_ = sigma;
 }
@@ -84,6 +84,9 @@ class DirectionalGaussianBlurFilterContents final : public FilterContents {
       const Entity& entity,
       const Matrix& effect_transform) const override;
 
+  // |Contents|
+  DrawCategory GetDrawCategory() const override;
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(
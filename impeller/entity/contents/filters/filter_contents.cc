@@ -284,6 +284,14 @@ const FilterContents* FilterContents::AsFilter() const {
   return this;
 }
 
+const ColorMatrixFilterContents* FilterContents::AsColorMatrixFilter() const {
+  return nullptr;
+}
+
+const FilterInput::Vector& FilterContents::GetInputs() const {
+  return inputs_;
+}
+
 Matrix FilterContents::GetLocalTransform(const Matrix& parent_transform) const {
   return Matrix();
 }
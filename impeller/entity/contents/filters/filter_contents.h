@@ -18,6 +18,8 @@
 
 namespace impeller {
 
+class ColorMatrixFilterContents;
+
 class FilterContents : public Contents {
  public:
   static const int32_t kBlurFilterRequiredMipCount;
@@ -136,6 +138,13 @@ class FilterContents : public Contents {
   // |Contents|
   const FilterContents* AsFilter() const override;
 
+  /// @brief  Returns this filter if it is a color matrix filter, which lets
+  ///         chains of color matrix filters be fused into a single pass.
+  virtual const ColorMatrixFilterContents* AsColorMatrixFilter() const;
+
+  /// @brief  The input texture sources set by |SetInputs|.
+  const FilterInput::Vector& GetInputs() const;
+
   /// @brief  Determines the coverage of source pixels that will be needed
   ///         to produce results for the specified |output_limit| under the
   ///         specified |effect_transform|. This is essentially a reverse of
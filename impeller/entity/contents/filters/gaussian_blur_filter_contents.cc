@@ -65,6 +65,51 @@ void SetTileMode(SamplerDescriptor* descriptor,
   }
 }
 
+/// Makes a subpass callback that fills the pass with `input_texture`, sampled
+/// at `uvs` with linear filtering.
+ContentContext::SubpassCallback MakeResampleCallback(
+    std::shared_ptr<Texture> input_texture,
+    const SamplerDescriptor& sampler_descriptor,
+    const Quad& uvs,
+    Entity::TileMode tile_mode,
+    const char* label) {
+  return [input_texture = std::move(input_texture), sampler_descriptor, uvs,
+          tile_mode, label](const ContentContext& renderer, RenderPass& pass) {
+    HostBuffer& host_buffer = renderer.GetTransientsBuffer();
+
+    pass.SetCommandLabel(label);
+    auto pipeline_options = OptionsFromPass(pass);
+    pipeline_options.primitive_type = PrimitiveType::kTriangleStrip;
+    pass.SetPipeline(renderer.GetTexturePipeline(pipeline_options));
+
+    TextureFillVertexShader::FrameInfo frame_info;
+    frame_info.mvp = Matrix::MakeOrthographic(ISize(1, 1));
+    frame_info.texture_sampler_y_coord_scale = 1.0;
+    frame_info.alpha = 1.0;
+
+    BindVertices<TextureFillVertexShader>(pass, host_buffer,
+                                          {
+                                              {Point(0, 0), uvs[0]},
+                                              {Point(1, 0), uvs[1]},
+                                              {Point(0, 1), uvs[2]},
+                                              {Point(1, 1), uvs[3]},
+                                          });
+
+    SamplerDescriptor linear_sampler_descriptor = sampler_descriptor;
+    SetTileMode(&linear_sampler_descriptor, renderer, tile_mode);
+    linear_sampler_descriptor.mag_filter = MinMagFilter::kLinear;
+    linear_sampler_descriptor.min_filter = MinMagFilter::kLinear;
+    TextureFillVertexShader::BindFrameInfo(
+        pass, host_buffer.EmplaceUniform(frame_info));
+    TextureFillFragmentShader::BindTextureSampler(
+        pass, input_texture,
+        renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+            linear_sampler_descriptor));
+
+    return pass.Draw().ok();
+  };
+}
+
 /// Makes a subpass that will render the scaled down input and add the
 /// transparent gutter required for the blur halo.
 fml::StatusOr<RenderTarget> MakeDownsampleSubpass(
@@ -74,44 +119,54 @@ fml::StatusOr<RenderTarget> MakeDownsampleSubpass(
     const Quad& uvs,
     const ISize& subpass_size,
     Entity::TileMode tile_mode) {
-  ContentContext::SubpassCallback subpass_callback =
-      [&](const ContentContext& renderer, RenderPass& pass) {
-        HostBuffer& host_buffer = renderer.GetTransientsBuffer();
-
-        pass.SetCommandLabel("Gaussian blur downsample");
-        auto pipeline_options = OptionsFromPass(pass);
-        pipeline_options.primitive_type = PrimitiveType::kTriangleStrip;
-        pass.SetPipeline(renderer.GetTexturePipeline(pipeline_options));
-
-        TextureFillVertexShader::FrameInfo frame_info;
-        frame_info.mvp = Matrix::MakeOrthographic(ISize(1, 1));
-        frame_info.texture_sampler_y_coord_scale = 1.0;
-        frame_info.alpha = 1.0;
-
-        BindVertices<TextureFillVertexShader>(pass, host_buffer,
-                                              {
-                                                  {Point(0, 0), uvs[0]},
-                                                  {Point(1, 0), uvs[1]},
-                                                  {Point(0, 1), uvs[2]},
-                                                  {Point(1, 1), uvs[3]},
-                                              });
-
-        SamplerDescriptor linear_sampler_descriptor = sampler_descriptor;
-        SetTileMode(&linear_sampler_descriptor, renderer, tile_mode);
-        linear_sampler_descriptor.mag_filter = MinMagFilter::kLinear;
-        linear_sampler_descriptor.min_filter = MinMagFilter::kLinear;
-        TextureFillVertexShader::BindFrameInfo(
-            pass, host_buffer.EmplaceUniform(frame_info));
-        TextureFillFragmentShader::BindTextureSampler(
-            pass, input_texture,
-            renderer.GetContext()->GetSamplerLibrary()->GetSampler(
-                linear_sampler_descriptor));
+  return renderer.MakeSubpass(
+      "Gaussian Blur Filter", subpass_size,
+      MakeResampleCallback(std::move(input_texture), sampler_descriptor, uvs,
+                           tile_mode, "Gaussian blur downsample"));
+}
 
-        return pass.Draw().ok();
-      };
-  fml::StatusOr<RenderTarget> render_target = renderer.MakeSubpass(
-      "Gaussian Blur Filter", subpass_size, subpass_callback);
-  return render_target;
+/// Like `MakeDownsampleSubpass`, but scales the input down through successive
+/// halvings. Each level is a 2x2 box filter of the previous one, so unlike a
+/// single downsample pass no texels of the input are skipped and mipmaps
+/// aren't required to avoid shimmering.
+///
+/// Every level but the last one is appended to `levels`, from the largest to
+/// the smallest, so that they can be reused when upsampling the result.
+fml::StatusOr<RenderTarget> MakeDownsamplePyramid(
+    const ContentContext& renderer,
+    std::shared_ptr<Texture> input_texture,
+    const SamplerDescriptor& sampler_descriptor,
+    const Quad& uvs,
+    const ISize& padded_size,
+    const ISize& subpass_size,
+    Entity::TileMode tile_mode,
+    std::vector<RenderTarget>& levels) {
+  std::vector<ISize> sizes = GaussianBlurFilterContents::CalculatePyramidSizes(
+      padded_size, subpass_size);
+  FML_DCHECK(!sizes.empty());
+  std::shared_ptr<Texture> level_texture = std::move(input_texture);
+  SamplerDescriptor level_sampler_descriptor = sampler_descriptor;
+  Quad level_uvs = uvs;
+  for (size_t i = 0; i < sizes.size(); i++) {
+    // There are no geometry edges to antialias, so skip MSAA and its resolve.
+    fml::StatusOr<RenderTarget> level = renderer.MakeSubpass(
+        "Gaussian Blur Filter", sizes[i],
+        MakeResampleCallback(level_texture, level_sampler_descriptor,
+                             level_uvs, tile_mode, "Gaussian blur downsample"),
+        /*msaa_enabled=*/false);
+    if (!level.ok() || i + 1 == sizes.size()) {
+      return level;
+    }
+    levels.push_back(level.value());
+    // The first level already applied the tile mode to the gutter, the
+    // following ones sample whole levels.
+    level_texture = level.value().GetRenderTargetTexture();
+    level_sampler_descriptor = MakeSamplerDescriptor(
+        MinMagFilter::kLinear, SamplerAddressMode::kClampToEdge);
+    level_uvs = {Point(0, 0), Point(1, 0), Point(0, 1), Point(1, 1)};
+    tile_mode = Entity::TileMode::kClamp;
+  }
+  FML_UNREACHABLE();
 }
 
 fml::StatusOr<RenderTarget> MakeBlurSubpass(
@@ -198,6 +253,10 @@ GaussianBlurFilterContents::GaussianBlurFilterContents(
     Entity::TileMode tile_mode)
     : sigma_x_(sigma_x), sigma_y_(sigma_y), tile_mode_(tile_mode) {}
 
+DrawCategory GaussianBlurFilterContents::GetDrawCategory() const {
+  return DrawCategory::kBlur;
+}
+
 // This value was extracted from Skia, see:
 //  * https://github.com/google/skia/blob/d29cc3fe182f6e8a8539004a6a4ee8251677a6fd/src/gpu/ganesh/GrBlurUtils.cpp#L2561-L2576
 //  * https://github.com/google/skia/blob/d29cc3fe182f6e8a8539004a6a4ee8251677a6fd/src/gpu/BlurUtils.h#L57
@@ -281,14 +340,21 @@ std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
                                 entity.GetClipDepth());  // No blur to render.
   }
 
+  std::optional<Scalar> pyramid_threshold =
+      renderer.GetGaussianBlurPyramidThreshold();
+  bool use_pyramid =
+      pyramid_threshold.has_value() &&
+      std::max(scaled_sigma.x, scaled_sigma.y) >= pyramid_threshold.value();
+
   // In order to avoid shimmering in downsampling step, we should have mips.
-  if (input_snapshot->texture->GetMipCount() <= 1) {
+  if (!use_pyramid && input_snapshot->texture->GetMipCount() <= 1) {
     FML_DLOG(ERROR) << kNoMipsError;
   }
   FML_DCHECK(!input_snapshot->texture->NeedsMipmapGeneration());
 
   Scalar desired_scalar =
-      std::min(CalculateScale(scaled_sigma.x), CalculateScale(scaled_sigma.y));
+      std::min(CalculateScale(scaled_sigma.x), CalculateScale(scaled_sigma.y)) *
+      renderer.GetGaussianBlurDownsampleScale();
   // TODO(jonahwilliams): If desired_scalar is 1.0 and we fully acquired the
   // gutter from the expanded_coverage_hint, we can skip the downsample pass.
   // pass.
@@ -313,9 +379,18 @@ std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
   Quad uvs = CalculateUVs(inputs[0], entity, source_rect_padded,
                           input_snapshot->texture->GetSize());
 
-  fml::StatusOr<RenderTarget> pass1_out = MakeDownsampleSubpass(
-      renderer, input_snapshot->texture, input_snapshot->sampler_descriptor,
-      uvs, subpass_size, tile_mode_);
+  std::vector<RenderTarget> pyramid_levels;
+  fml::StatusOr<RenderTarget> pass1_out =
+      use_pyramid
+          ? MakeDownsamplePyramid(
+                renderer, input_snapshot->texture,
+                input_snapshot->sampler_descriptor, uvs,
+                ISize(round(source_rect_padded.GetWidth()),
+                      round(source_rect_padded.GetHeight())),
+                subpass_size, tile_mode_, pyramid_levels)
+          : MakeDownsampleSubpass(renderer, input_snapshot->texture,
+                                  input_snapshot->sampler_descriptor, uvs,
+                                  subpass_size, tile_mode_);
 
   if (!pass1_out.ok()) {
     return std::nullopt;
@@ -395,16 +470,48 @@ std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
   SamplerDescriptor sampler_desc = MakeSamplerDescriptor(
       MinMagFilter::kLinear, SamplerAddressMode::kClampToEdge);
 
+  // Upsample the result through the smaller levels of the pyramid, reusing
+  // their render targets, to smooth out the magnification of tiny results.
+  // The largest level is skipped since it costs more than all the others.
+  RenderTarget result = pass3_out.value();
+  for (size_t i = pyramid_levels.size(); i > 1; i--) {
+    fml::StatusOr<RenderTarget> upsample_out = renderer.MakeSubpass(
+        "Gaussian Blur Filter", pyramid_levels[i - 1],
+        MakeResampleCallback(
+            result.GetRenderTargetTexture(), sampler_desc,
+            {Point(0, 0), Point(1, 0), Point(0, 1), Point(1, 1)},
+            Entity::TileMode::kClamp, "Gaussian blur upsample"));
+    if (!upsample_out.ok()) {
+      return std::nullopt;
+    }
+    result = upsample_out.value();
+  }
+  Vector2 result_scalar =
+      Vector2(result.GetRenderTargetSize()) / source_rect_padded.GetSize();
+
   return Entity::FromSnapshot(
-      Snapshot{.texture = pass3_out.value().GetRenderTargetTexture(),
+      Snapshot{.texture = result.GetRenderTargetTexture(),
                .transform = input_snapshot->transform *
                             padding_snapshot_adjustment *
-                            Matrix::MakeScale(1 / effective_scalar),
+                            Matrix::MakeScale(1 / result_scalar),
                .sampler_descriptor = sampler_desc,
                .opacity = input_snapshot->opacity},
       entity.GetBlendMode(), entity.GetClipDepth());
 }
 
+std::vector<ISize> GaussianBlurFilterContents::CalculatePyramidSizes(
+    const ISize& source_size,
+    const ISize& destination_size) {
+  std::vector<ISize> sizes;
+  ISize size = source_size;
+  do {
+    size = ISize(std::max(size.width / 2, destination_size.width),
+                 std::max(size.height / 2, destination_size.height));
+    sizes.push_back(size);
+  } while (size != destination_size);
+  return sizes;
+}
+
 Scalar GaussianBlurFilterContents::CalculateBlurRadius(Scalar sigma) {
   return static_cast<Radius>(Sigma(sigma)).radius;
 }
@@ -6,6 +6,8 @@
 #define FLUTTER_IMPELLER_ENTITY_CONTENTS_FILTERS_GAUSSIAN_BLUR_FILTER_CONTENTS_H_
 
 #include <optional>
+#include <vector>
+
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
 
@@ -66,6 +68,15 @@ class GaussianBlurFilterContents final : public FilterContents {
   /// Visible for testing.
   static Scalar CalculateScale(Scalar sigma);
 
+  /// Calculate the sizes of the levels of the downsample pyramid used to scale
+  /// `source_size` down to `destination_size`. Each level halves the previous
+  /// one, except the last one which is always `destination_size`.
+  ///
+  /// Visible for testing.
+  static std::vector<ISize> CalculatePyramidSizes(
+      const ISize& source_size,
+      const ISize& destination_size);
+
   /// Scales down the sigma value to match Skia's behavior.
   ///
   /// effective_blur_radius = CalculateBlurRadius(ScaleSigma(sigma_));
@@ -75,6 +86,9 @@ class GaussianBlurFilterContents final : public FilterContents {
   /// equation that puts the minima there and a f(0)=1.
   static Scalar ScaleSigma(Scalar sigma);
 
+  // |Contents|
+  DrawCategory GetDrawCategory() const override;
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(
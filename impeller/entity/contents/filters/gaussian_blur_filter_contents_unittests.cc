@@ -200,6 +200,23 @@ TEST(GaussianBlurFilterContentsTest, CalculateSigmaValues) {
   EXPECT_EQ(GaussianBlurFilterContents::CalculateScale(1024.0f), 4.f / 1024.f);
 }
 
+TEST(GaussianBlurFilterContentsTest, CalculatePyramidSizes) {
+  EXPECT_THAT(
+      GaussianBlurFilterContents::CalculatePyramidSizes(ISize(100, 80),
+                                                        ISize(10, 8)),
+      ::testing::ElementsAre(ISize(50, 40), ISize(25, 20), ISize(12, 10),
+                           ISize(10, 8)));
+  EXPECT_THAT(
+      GaussianBlurFilterContents::CalculatePyramidSizes(ISize(100, 100),
+                                                        ISize(50, 50)),
+      ::testing::ElementsAre(ISize(50, 50)));
+  // Levels stop halving the dimensions that already reached the destination.
+  EXPECT_THAT(
+      GaussianBlurFilterContents::CalculatePyramidSizes(ISize(100, 10),
+                                                        ISize(25, 8)),
+      ::testing::ElementsAre(ISize(50, 8), ISize(25, 8)));
+}
+
 TEST_P(GaussianBlurFilterContentsTest, RenderCoverageMatchesGetCoverage) {
   TextureDescriptor desc = {
       .storage_mode = StorageMode::kDevicePrivate,
@@ -308,6 +325,68 @@ TEST_P(GaussianBlurFilterContentsTest,
   }
 }
 
+TEST_P(GaussianBlurFilterContentsTest,
+       RenderCoverageMatchesGetCoverageWithPyramid) {
+  TextureDescriptor desc = {
+      .storage_mode = StorageMode::kDevicePrivate,
+      .format = PixelFormat::kB8G8R8A8UNormInt,
+      .size = ISize(400, 300),
+  };
+  std::shared_ptr<Texture> texture = MakeTexture(desc);
+  auto contents = std::make_unique<GaussianBlurFilterContents>(
+      /*sigma_x=*/40.0, /*sigma_y=*/40.0, Entity::TileMode::kDecal);
+  contents->SetInputs({FilterInput::Make(texture)});
+  std::shared_ptr<ContentContext> renderer = GetContentContext();
+  renderer->SetGaussianBlurPyramidThreshold(16.0);
+
+  Entity entity;
+  entity.SetTransform(Matrix::MakeTranslation({100, 200, 0}));
+  std::optional<Entity> result =
+      contents->GetEntity(*renderer, entity, /*coverage_hint=*/{});
+  renderer->SetGaussianBlurPyramidThreshold(std::nullopt);
+  EXPECT_TRUE(result.has_value());
+  if (result.has_value()) {
+    std::optional<Rect> result_coverage = result.value().GetCoverage();
+    std::optional<Rect> contents_coverage = contents->GetCoverage(entity);
+    EXPECT_TRUE(result_coverage.has_value());
+    EXPECT_TRUE(contents_coverage.has_value());
+    if (result_coverage.has_value() && contents_coverage.has_value()) {
+      EXPECT_TRUE(RectNear(result_coverage.value(), contents_coverage.value()));
+    }
+  }
+}
+
+TEST_P(GaussianBlurFilterContentsTest,
+       RenderCoverageMatchesGetCoverageWithDownsampleScale) {
+  TextureDescriptor desc = {
+      .storage_mode = StorageMode::kDevicePrivate,
+      .format = PixelFormat::kB8G8R8A8UNormInt,
+      .size = ISize(400, 300),
+  };
+  std::shared_ptr<Texture> texture = MakeTexture(desc);
+  auto contents = std::make_unique<GaussianBlurFilterContents>(
+      /*sigma_x=*/20.0, /*sigma_y=*/20.0, Entity::TileMode::kDecal);
+  contents->SetInputs({FilterInput::Make(texture)});
+  std::shared_ptr<ContentContext> renderer = GetContentContext();
+  renderer->SetGaussianBlurDownsampleScale(0.5);
+
+  Entity entity;
+  entity.SetTransform(Matrix::MakeTranslation({100, 200, 0}));
+  std::optional<Entity> result =
+      contents->GetEntity(*renderer, entity, /*coverage_hint=*/{});
+  renderer->SetGaussianBlurDownsampleScale(1.0);
+  EXPECT_TRUE(result.has_value());
+  if (result.has_value()) {
+    std::optional<Rect> result_coverage = result.value().GetCoverage();
+    std::optional<Rect> contents_coverage = contents->GetCoverage(entity);
+    EXPECT_TRUE(result_coverage.has_value());
+    EXPECT_TRUE(contents_coverage.has_value());
+    if (result_coverage.has_value() && contents_coverage.has_value()) {
+      EXPECT_TRUE(RectNear(result_coverage.value(), contents_coverage.value()));
+    }
+  }
+}
+
 TEST_P(GaussianBlurFilterContentsTest, CalculateUVsSimple) {
   TextureDescriptor desc = {
       .storage_mode = StorageMode::kDevicePrivate,
@@ -4,6 +4,7 @@
 
 #include "impeller/entity/contents/filters/morphology_filter_contents.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "impeller/core/formats.h"
@@ -35,6 +36,22 @@ void DirectionalMorphologyFilterContents::SetMorphType(MorphType morph_type) {
   morph_type_ = morph_type;
 }
 
+std::vector<DirectionalMorphologyFilterContents::Pass>
+DirectionalMorphologyFilterContents::GetPasses(int pixel_radius) {
+  if (pixel_radius <= kMaxSinglePassRadius) {
+    return {{.radius = pixel_radius, .step = 1}};
+  }
+  // The windows of steps 1, 2, ..., 2^(k-1) cover [-(2^k - 1), 2^k - 1], so a
+  // remaining step of at most 2^k extends the coverage without gaps.
+  std::vector<Pass> passes;
+  int remaining = pixel_radius;
+  for (int step = 1; remaining > 0; step *= 2) {
+    passes.push_back({.radius = 1, .step = std::min(step, remaining)});
+    remaining -= passes.back().step;
+  }
+  return passes;
+}
+
 std::optional<Entity> DirectionalMorphologyFilterContents::RenderFilter(
     const FilterInput::Vector& inputs,
     const ContentContext& renderer,
@@ -42,9 +59,6 @@ std::optional<Entity> DirectionalMorphologyFilterContents::RenderFilter(
     const Matrix& effect_transform,
     const Rect& coverage,
     const std::optional<Rect>& coverage_hint) const {
-  using VS = MorphologyFilterPipeline::VertexShader;
-  using FS = MorphologyFilterPipeline::FragmentShader;
-
   //----------------------------------------------------------------------------
   /// Handle inputs.
   ///
@@ -63,7 +77,46 @@ std::optional<Entity> DirectionalMorphologyFilterContents::RenderFilter(
                                 entity.GetClipDepth());
   }
 
-  auto maybe_input_uvs = input_snapshot->GetCoverageUVs(coverage);
+  auto transform = entity.GetTransform() * effect_transform.Basis();
+  auto transformed_radius =
+      transform.TransformDirection(direction_ * radius_.radius);
+  auto passes = GetPasses(std::round(transformed_radius.GetLength()));
+
+  // The passes before the last one render every pixel that a later pass may
+  // sample a non-transparent value from: the output coverage for dilation,
+  // and the input coverage for erosion.
+  auto intermediate_rect = coverage;
+  if (auto input_coverage = input_snapshot->GetCoverage()) {
+    intermediate_rect = intermediate_rect.Union(input_coverage.value());
+  }
+
+  Snapshot snapshot = input_snapshot.value();
+  for (size_t i = 0; i < passes.size(); i++) {
+    bool is_last_pass = i + 1 == passes.size();
+    auto result = RenderMorphologyPass(
+        renderer, snapshot, is_last_pass ? coverage : intermediate_rect,
+        transformed_radius, passes[i]);
+    if (!result.has_value()) {
+      return std::nullopt;
+    }
+    snapshot = result.value();
+  }
+
+  return Entity::FromSnapshot(snapshot, entity.GetBlendMode(),
+                              entity.GetClipDepth());
+}
+
+std::optional<Snapshot>
+DirectionalMorphologyFilterContents::RenderMorphologyPass(
+    const ContentContext& renderer,
+    const Snapshot& input_snapshot,
+    const Rect& output_rect,
+    const Vector2& transformed_radius,
+    const Pass& pass) const {
+  using VS = MorphologyFilterPipeline::VertexShader;
+  using FS = MorphologyFilterPipeline::FragmentShader;
+
+  auto maybe_input_uvs = input_snapshot.GetCoverageUVs(output_rect);
   if (!maybe_input_uvs.has_value()) {
     return std::nullopt;
   }
@@ -74,7 +127,7 @@ std::optional<Entity> DirectionalMorphologyFilterContents::RenderFilter(
   ///
 
   ContentContext::SubpassCallback callback = [&](const ContentContext& renderer,
-                                                 RenderPass& pass) {
+                                                 RenderPass& render_pass) {
     auto& host_buffer = renderer.GetTransientsBuffer();
 
     VertexBufferBuilder<VS::PerVertexData> vtx_builder;
@@ -88,14 +141,11 @@ std::optional<Entity> DirectionalMorphologyFilterContents::RenderFilter(
     VS::FrameInfo frame_info;
     frame_info.mvp = Matrix::MakeOrthographic(ISize(1, 1));
     frame_info.texture_sampler_y_coord_scale =
-        input_snapshot->texture->GetYCoordScale();
+        input_snapshot.texture->GetYCoordScale();
 
-    auto transform = entity.GetTransform() * effect_transform.Basis();
-    auto transformed_radius =
-        transform.TransformDirection(direction_ * radius_.radius);
     auto transformed_texture_vertices =
-        Rect::MakeSize(input_snapshot->texture->GetSize())
-            .GetTransformedPoints(input_snapshot->transform);
+        Rect::MakeSize(input_snapshot.texture->GetSize())
+            .GetTransformedPoints(input_snapshot.transform);
     auto transformed_texture_width =
         transformed_texture_vertices[0].GetDistance(
             transformed_texture_vertices[1]);
@@ -104,39 +154,40 @@ std::optional<Entity> DirectionalMorphologyFilterContents::RenderFilter(
             transformed_texture_vertices[2]);
 
     FS::FragInfo frag_info;
-    frag_info.radius = std::round(transformed_radius.GetLength());
+    frag_info.radius = pass.radius;
     frag_info.morph_type = static_cast<Scalar>(morph_type_);
     frag_info.uv_offset =
-        input_snapshot->transform.Invert()
+        input_snapshot.transform.Invert()
             .TransformDirection(transformed_radius)
             .Normalize() /
-        Point(transformed_texture_width, transformed_texture_height);
+        Point(transformed_texture_width, transformed_texture_height) *
+        pass.step;
 
-    pass.SetCommandLabel("Morphology Filter");
-    auto options = OptionsFromPass(pass);
+    render_pass.SetCommandLabel("Morphology Filter");
+    auto options = OptionsFromPass(render_pass);
     options.primitive_type = PrimitiveType::kTriangleStrip;
     options.blend_mode = BlendMode::kSource;
-    pass.SetPipeline(renderer.GetMorphologyFilterPipeline(options));
-    pass.SetVertexBuffer(vtx_builder.CreateVertexBuffer(host_buffer));
+    render_pass.SetPipeline(renderer.GetMorphologyFilterPipeline(options));
+    render_pass.SetVertexBuffer(vtx_builder.CreateVertexBuffer(host_buffer));
 
-    auto sampler_descriptor = input_snapshot->sampler_descriptor;
+    auto sampler_descriptor = input_snapshot.sampler_descriptor;
     if (renderer.GetDeviceCapabilities().SupportsDecalSamplerAddressMode()) {
       sampler_descriptor.width_address_mode = SamplerAddressMode::kDecal;
       sampler_descriptor.height_address_mode = SamplerAddressMode::kDecal;
     }
 
     FS::BindTextureSampler(
-        pass, input_snapshot->texture,
+        render_pass, input_snapshot.texture,
         renderer.GetContext()->GetSamplerLibrary()->GetSampler(
             sampler_descriptor));
-    VS::BindFrameInfo(pass, host_buffer.EmplaceUniform(frame_info));
-    FS::BindFragInfo(pass, host_buffer.EmplaceUniform(frag_info));
+    VS::BindFrameInfo(render_pass, host_buffer.EmplaceUniform(frame_info));
+    FS::BindFragInfo(render_pass, host_buffer.EmplaceUniform(frag_info));
 
-    return pass.Draw().ok();
+    return render_pass.Draw().ok();
   };
 
   fml::StatusOr<RenderTarget> render_target = renderer.MakeSubpass(
-      "Directional Morphology Filter", ISize(coverage.GetSize()), callback);
+      "Directional Morphology Filter", ISize(output_rect.GetSize()), callback);
   if (!render_target.ok()) {
     return std::nullopt;
   }
@@ -145,12 +196,10 @@ std::optional<Entity> DirectionalMorphologyFilterContents::RenderFilter(
   sampler_desc.min_filter = MinMagFilter::kLinear;
   sampler_desc.mag_filter = MinMagFilter::kLinear;
 
-  return Entity::FromSnapshot(
-      Snapshot{.texture = render_target.value().GetRenderTargetTexture(),
-               .transform = Matrix::MakeTranslation(coverage.GetOrigin()),
-               .sampler_descriptor = sampler_desc,
-               .opacity = input_snapshot->opacity},
-      entity.GetBlendMode(), entity.GetClipDepth());
+  return Snapshot{.texture = render_target.value().GetRenderTargetTexture(),
+                  .transform = Matrix::MakeTranslation(output_rect.GetOrigin()),
+                  .sampler_descriptor = sampler_desc,
+                  .opacity = input_snapshot.opacity};
 }
 
 std::optional<Rect> DirectionalMorphologyFilterContents::GetFilterCoverage(
@@ -7,6 +7,8 @@
 
 #include <memory>
 #include <optional>
+#include <vector>
+
 #include "impeller/entity/contents/filters/filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 
@@ -14,6 +16,26 @@ namespace impeller {
 
 class DirectionalMorphologyFilterContents final : public FilterContents {
  public:
+  /// The largest radius, in pixels, that is filtered in a single pass.
+  static constexpr int kMaxSinglePassRadius = 16;
+
+  /// A pass that takes the min or max of the `2 * radius + 1` texels spaced
+  /// `step` texels apart around each pixel.
+  struct Pass {
+    int radius = 0;
+    int step = 1;
+  };
+
+  /// @brief  Returns the passes that filter a radius of `pixel_radius`.
+  ///
+  ///         Up to `kMaxSinglePassRadius` this is a single pass that samples
+  ///         every texel in the radius. Larger radii are split into passes of
+  ///         radius 1 whose steps double (1, 2, 4, ... and the remainder),
+  ///         whose combined windows cover every texel in the radius. Each
+  ///         pixel is then sampled O(log radius) times instead of
+  ///         `2 * pixel_radius + 1` times.
+  static std::vector<Pass> GetPasses(int pixel_radius);
+
   DirectionalMorphologyFilterContents();
 
   ~DirectionalMorphologyFilterContents() override;
@@ -45,6 +67,13 @@ class DirectionalMorphologyFilterContents final : public FilterContents {
       const Rect& coverage,
       const std::optional<Rect>& coverage_hint) const override;
 
+  std::optional<Snapshot> RenderMorphologyPass(
+      const ContentContext& renderer,
+      const Snapshot& input_snapshot,
+      const Rect& output_rect,
+      const Vector2& transformed_radius,
+      const Pass& pass) const;
+
   Radius radius_;
   Vector2 direction_;
   MorphType morph_type_;
@@ -0,0 +1,53 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <set>
+
+#include "flutter/testing/testing.h"
+#include "impeller/entity/contents/filters/morphology_filter_contents.h"
+
+namespace impeller {
+namespace testing {
+
+using Pass = DirectionalMorphologyFilterContents::Pass;
+
+TEST(MorphologyFilterContentsTest, SmallRadiiUseASinglePass) {
+  for (int radius = 0;
+       radius <= DirectionalMorphologyFilterContents::kMaxSinglePassRadius;
+       radius++) {
+    auto passes = DirectionalMorphologyFilterContents::GetPasses(radius);
+    ASSERT_EQ(passes.size(), 1u);
+    EXPECT_EQ(passes[0].radius, radius);
+    EXPECT_EQ(passes[0].step, 1);
+  }
+}
+
+TEST(MorphologyFilterContentsTest, LargeRadiiPassesCoverEveryTexel) {
+  for (int radius = DirectionalMorphologyFilterContents::kMaxSinglePassRadius;
+       radius <= 300; radius++) {
+    auto passes = DirectionalMorphologyFilterContents::GetPasses(radius);
+
+    // The offsets sampled by the passes combined.
+    std::set<int> offsets = {0};
+    for (const Pass& pass : passes) {
+      std::set<int> combined;
+      for (int offset : offsets) {
+        for (int i = -pass.radius; i <= pass.radius; i++) {
+          combined.insert(offset + i * pass.step);
+        }
+      }
+      offsets = std::move(combined);
+    }
+
+    ASSERT_EQ(offsets.size(), static_cast<size_t>(2 * radius + 1)) << radius;
+    EXPECT_EQ(*offsets.begin(), -radius);
+    EXPECT_EQ(*offsets.rbegin(), radius);
+    if (radius > DirectionalMorphologyFilterContents::kMaxSinglePassRadius) {
+      EXPECT_LE(passes.size(), 10u) << radius;
+    }
+  }
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -6,9 +6,11 @@
 
 #include "impeller/entity/contents/gradient_generator.h"
 
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
 #include "impeller/core/texture.h"
 #include "impeller/entity/contents/content_context.h"
+#include "impeller/renderer/capabilities.h"
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/render_pass.h"
 
@@ -42,6 +44,72 @@ std::shared_ptr<Texture> CreateGradientTexture(
   return texture;
 }
 
+bool ShouldUseSSBOGradient(const Capabilities& capabilities,
+                           size_t stop_count) {
+  return capabilities.SupportsSSBO() && stop_count <= kMaxSSBOGradientStops;
+}
+
+GradientTextureCache::GradientTextureCache() = default;
+
+GradientTextureCache::~GradientTextureCache() = default;
+
+void GradientTextureCache::Start() {
+  for (auto& [key, data] : textures_) {
+    data.used_this_frame = false;
+  }
+}
+
+void GradientTextureCache::End() {
+  for (auto it = textures_.begin(); it != textures_.end();) {
+    if (it->second.used_this_frame) {
+      ++it;
+    } else {
+      it = textures_.erase(it);
+    }
+  }
+}
+
+void GradientTextureCache::Trim() {
+  textures_.clear();
+}
+
+std::shared_ptr<Texture> GradientTextureCache::GetTexture(
+    const std::vector<Color>& colors,
+    const std::vector<Scalar>& stops,
+    const std::shared_ptr<impeller::Context>& context) {
+  Key key{.colors = colors, .stops = stops};
+  auto found = textures_.find(key);
+  if (found != textures_.end()) {
+    found->second.used_this_frame = true;
+    return found->second.texture;
+  }
+
+  auto texture =
+      CreateGradientTexture(CreateGradientBuffer(colors, stops), context);
+  if (texture == nullptr) {
+    return nullptr;
+  }
+  textures_.emplace(std::move(key),
+                    TextureData{.used_this_frame = true, .texture = texture});
+  return texture;
+}
+
+size_t GradientTextureCache::CachedTextureCount() const {
+  return textures_.size();
+}
+
+std::size_t GradientTextureCache::Key::Hash::operator()(const Key& key) const {
+  std::size_t hash = fml::HashCombine(key.colors.size());
+  for (const auto& color : key.colors) {
+    fml::HashCombineSeed(hash, color.red, color.green, color.blue,
+                         color.alpha);
+  }
+  for (auto stop : key.stops) {
+    fml::HashCombineSeed(hash, stop);
+  }
+  return hash;
+}
+
 std::vector<StopData> CreateGradientColors(const std::vector<Color>& colors,
                                            const std::vector<Scalar>& stops) {
   FML_DCHECK(stops.size() == colors.size());
@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -19,6 +20,7 @@
 
 namespace impeller {
 
+class Capabilities;
 class Context;
 
 /**
@@ -29,6 +31,79 @@ std::shared_ptr<Texture> CreateGradientTexture(
     const GradientData& gradient_data,
     const std::shared_ptr<impeller::Context>& context);
 
+/// The number of stops up to which gradients are rendered with the SSBO
+/// shaders when the device supports them. The SSBO shaders search the stops
+/// for every fragment, so gradients with more stops sample a cached ramp
+/// texture instead.
+static constexpr size_t kMaxSSBOGradientStops = 16u;
+
+/**
+ * @brief Whether a gradient with `stop_count` stops should be rendered with
+ * the SSBO shaders rather than with a gradient texture.
+ */
+bool ShouldUseSSBOGradient(const Capabilities& capabilities,
+                           size_t stop_count);
+
+/**
+ * @brief Caches the gradient textures by their colors and stops, so that
+ * gradients drawn every frame don't upload the same ramp again. Textures
+ * that were not used during a frame are released at the end of it.
+ */
+class GradientTextureCache {
+ public:
+  GradientTextureCache();
+
+  ~GradientTextureCache();
+
+  /// Mark the start of a frame.
+  void Start();
+
+  /// Release the textures that were not used since the last call to |Start|.
+  void End();
+
+  /// Release all textures. Called when the device is low on memory.
+  void Trim();
+
+  /**
+   * @brief Return the texture for the gradient described by `colors` and
+   * `stops`, creating it with |CreateGradientTexture| if it isn't cached.
+   */
+  std::shared_ptr<Texture> GetTexture(
+      const std::vector<Color>& colors,
+      const std::vector<Scalar>& stops,
+      const std::shared_ptr<impeller::Context>& context);
+
+  // visible for testing.
+  size_t CachedTextureCount() const;
+
+ private:
+  struct Key {
+    std::vector<Color> colors;
+    std::vector<Scalar> stops;
+
+    struct Hash {
+      std::size_t operator()(const Key& key) const;
+    };
+
+    struct Equal {
+      bool operator()(const Key& lhs, const Key& rhs) const {
+        return lhs.colors == rhs.colors && lhs.stops == rhs.stops;
+      }
+    };
+  };
+
+  struct TextureData {
+    bool used_this_frame;
+    std::shared_ptr<Texture> texture;
+  };
+
+  std::unordered_map<Key, TextureData, Key::Hash, Key::Equal> textures_;
+
+  GradientTextureCache(const GradientTextureCache&) = delete;
+
+  GradientTextureCache& operator=(const GradientTextureCache&) = delete;
+};
+
 struct StopData {
   Color color;
   Scalar stop;
@@ -135,7 +135,13 @@ TEST_P(HostBufferTest, UnusedBuffersAreDiscardedWhenResetting) {
   EXPECT_EQ(buffer->GetStateForTest().total_buffer_count, 2u);
   EXPECT_EQ(buffer->GetStateForTest().current_frame, 0u);
 
-  // Now when we reset, the buffer should get dropped.
+  // The extra buffer is retained while the workload stays smaller, and only
+  // dropped once it has gone unused for kHostBufferRetainedFrameCount frames.
+  for (auto i = 0u; i < kHostBufferRetainedFrameCount - 3u; i++) {
+    buffer->Reset();
+  }
+  EXPECT_EQ(buffer->GetStateForTest().total_buffer_count, 2u);
+
   // Reset until we get back to this frame.
   for (auto i = 0; i < 3; i++) {
     buffer->Reset();
@@ -146,5 +152,44 @@ TEST_P(HostBufferTest, UnusedBuffersAreDiscardedWhenResetting) {
   EXPECT_EQ(buffer->GetStateForTest().current_frame, 0u);
 }
 
+TEST_P(HostBufferTest, SteadyStateFramesDoNotAllocate) {
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+
+  auto emplace_frame = [&buffer]() {
+    for (auto i = 0; i < 3; i++) {
+      auto view = buffer->Emplace(1000000, 0, [](uint8_t* data) {});
+      ASSERT_TRUE(view);
+    }
+    buffer->Reset();
+  };
+
+  // The first frame in each slot of the arena grows it.
+  emplace_frame();
+  EXPECT_EQ(buffer->GetLastFrameStatistics().allocation_count, 2u);
+  EXPECT_EQ(buffer->GetLastFrameStatistics().blocks_used, 3u);
+
+  // Other slots are pre-sized to the high-water mark and never allocate while
+  // emplacing.
+  for (auto i = 0u; i < kHostBufferArenaSize * 4; i++) {
+    emplace_frame();
+    EXPECT_EQ(buffer->GetLastFrameStatistics().allocation_count, 0u);
+    EXPECT_EQ(buffer->GetStateForTest().total_buffer_count, 3u);
+  }
+}
+
+TEST_P(HostBufferTest, TracksBytesHighWaterMark) {
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+
+  auto view = buffer->Emplace(1000, 0, [](uint8_t* data) {});
+  buffer->Reset();
+  EXPECT_EQ(buffer->GetLastFrameStatistics().bytes_used, 1000u);
+  EXPECT_EQ(buffer->GetLastFrameStatistics().bytes_high_water_mark, 1000u);
+
+  view = buffer->Emplace(200, 0, [](uint8_t* data) {});
+  buffer->Reset();
+  EXPECT_EQ(buffer->GetLastFrameStatistics().bytes_used, 200u);
+  EXPECT_EQ(buffer->GetLastFrameStatistics().bytes_high_water_mark, 1000u);
+}
+
 }  // namespace  testing
 }  // namespace impeller
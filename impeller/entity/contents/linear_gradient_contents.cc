@@ -17,6 +17,10 @@ LinearGradientContents::LinearGradientContents() = default;
 
 LinearGradientContents::~LinearGradientContents() = default;
 
+DrawCategory LinearGradientContents::GetDrawCategory() const {
+  return DrawCategory::kGradient;
+}
+
 void LinearGradientContents::SetEndPoints(Point start_point, Point end_point) {
   start_point_ = start_point;
   end_point_ = end_point;
@@ -57,7 +61,8 @@ bool LinearGradientContents::IsOpaque() const {
 bool LinearGradientContents::Render(const ContentContext& renderer,
                                     const Entity& entity,
                                     RenderPass& pass) const {
-  if (renderer.GetDeviceCapabilities().SupportsSSBO()) {
+  if (ShouldUseSSBOGradient(renderer.GetDeviceCapabilities(),
+                            stops_.size())) {
     return RenderSSBO(renderer, entity, pass);
   }
   return RenderTexture(renderer, entity, pass);
@@ -69,9 +74,8 @@ bool LinearGradientContents::RenderTexture(const ContentContext& renderer,
   using VS = LinearGradientFillPipeline::VertexShader;
   using FS = LinearGradientFillPipeline::FragmentShader;
 
-  auto gradient_data = CreateGradientBuffer(colors_, stops_);
-  auto gradient_texture =
-      CreateGradientTexture(gradient_data, renderer.GetContext());
+  auto gradient_texture = renderer.GetGradientTextureCache()->GetTexture(
+      colors_, stops_, renderer.GetContext());
   if (gradient_texture == nullptr) {
     return false;
   }
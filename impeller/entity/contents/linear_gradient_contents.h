@@ -50,6 +50,9 @@ class LinearGradientContents final : public ColorSourceContents {
 
   void SetTileMode(Entity::TileMode tile_mode);
 
+  // |Contents|
+  DrawCategory GetDrawCategory() const override;
+
  private:
   bool RenderTexture(const ContentContext& renderer,
                      const Entity& entity,
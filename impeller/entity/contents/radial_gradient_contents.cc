@@ -18,6 +18,10 @@ RadialGradientContents::RadialGradientContents() = default;
 
 RadialGradientContents::~RadialGradientContents() = default;
 
+DrawCategory RadialGradientContents::GetDrawCategory() const {
+  return DrawCategory::kGradient;
+}
+
 void RadialGradientContents::SetCenterAndRadius(Point center, Scalar radius) {
   center_ = center;
   radius_ = radius;
@@ -58,7 +62,8 @@ bool RadialGradientContents::IsOpaque() const {
 bool RadialGradientContents::Render(const ContentContext& renderer,
                                     const Entity& entity,
                                     RenderPass& pass) const {
-  if (renderer.GetDeviceCapabilities().SupportsSSBO()) {
+  if (ShouldUseSSBOGradient(renderer.GetDeviceCapabilities(),
+                            stops_.size())) {
     return RenderSSBO(renderer, entity, pass);
   }
   return RenderTexture(renderer, entity, pass);
@@ -126,9 +131,8 @@ bool RadialGradientContents::RenderTexture(const ContentContext& renderer,
   using VS = RadialGradientFillPipeline::VertexShader;
   using FS = RadialGradientFillPipeline::FragmentShader;
 
-  auto gradient_data = CreateGradientBuffer(colors_, stops_);
-  auto gradient_texture =
-      CreateGradientTexture(gradient_data, renderer.GetContext());
+  auto gradient_texture = renderer.GetGradientTextureCache()->GetTexture(
+      colors_, stops_, renderer.GetContext());
   if (gradient_texture == nullptr) {
     return false;
   }
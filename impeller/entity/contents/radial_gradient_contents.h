@@ -44,6 +44,9 @@ class RadialGradientContents final : public ColorSourceContents {
 
   void SetTileMode(Entity::TileMode tile_mode);
 
+  // |Contents|
+  DrawCategory GetDrawCategory() const override;
+
  private:
   bool RenderTexture(const ContentContext& renderer,
                      const Entity& entity,
@@ -0,0 +1,250 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/rect_batch_contents.h"
+
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "impeller/core/formats.h"
+#include "impeller/core/texture.h"
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/solid_color_contents.h"
+#include "impeller/entity/contents/texture_contents.h"
+#include "impeller/entity/geometry/geometry.h"
+#include "impeller/entity/texture_fill.frag.h"
+#include "impeller/entity/texture_fill.vert.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
+
+namespace impeller {
+
+// The two triangles of a quad, indexing into the points returned by
+// `Rect::GetPoints()`.
+static constexpr std::array<size_t, 6> kQuadIndices = {0, 1, 2, 1, 3, 2};
+
+std::shared_ptr<RectBatchContents> RectBatchContents::Make(
+    const Entity& entity) {
+  const auto& contents = entity.GetContents();
+  if (!contents) {
+    return nullptr;
+  }
+  Type type;
+  if (contents->AsSolidColor()) {
+    type = Type::kSolidColor;
+  } else if (contents->AsTexture()) {
+    type = Type::kTexture;
+  } else {
+    return nullptr;
+  }
+  auto batch = std::shared_ptr<RectBatchContents>(
+      new RectBatchContents(type, entity.Clone()));
+  if (!batch->Append(entity)) {
+    return nullptr;
+  }
+  return batch;
+}
+
+RectBatchContents::RectBatchContents(Type type, Entity first_entity)
+    : type_(type), first_entity_(std::move(first_entity)) {}
+
+RectBatchContents::~RectBatchContents() = default;
+
+bool RectBatchContents::Append(const Entity& entity) {
+  if (!quads_.empty() &&
+      (entity.GetBlendMode() != first_entity_.GetBlendMode() ||
+       entity.GetClipDepth() != first_entity_.GetClipDepth())) {
+    return false;
+  }
+  // Advanced blends read from the destination and can't be batched. Vertices
+  // are transformed on the CPU, which is only equivalent for 2D transforms.
+  if (entity.GetBlendMode() > Entity::kLastPipelineBlendMode ||
+      !entity.GetTransform().IsAffine() || !entity.GetContents()) {
+    return false;
+  }
+  auto coverage = entity.GetCoverage();
+  if (!coverage.has_value()) {
+    return false;
+  }
+
+  bool appended = false;
+  switch (type_) {
+    case Type::kSolidColor:
+      appended = AppendSolidColor(entity);
+      break;
+    case Type::kTexture:
+      appended = AppendTexture(entity);
+      break;
+  }
+  if (!appended) {
+    return false;
+  }
+  coverage_ = quads_.size() == 1u ? coverage.value()
+                                  : coverage_.Union(coverage.value());
+  return true;
+}
+
+bool RectBatchContents::AppendSolidColor(const Entity& entity) {
+  const auto* contents = entity.GetContents()->AsSolidColor();
+  if (!contents || !contents->GetGeometry()) {
+    return false;
+  }
+  auto rect = contents->GetGeometry()->AsRect();
+  if (!rect.has_value()) {
+    return false;
+  }
+  quads_.push_back(Quad{
+      .positions = rect->GetTransformedPoints(entity.GetTransform()),
+      .color = contents->GetColor().Premultiply(),
+  });
+  return true;
+}
+
+bool RectBatchContents::AppendTexture(const Entity& entity) {
+  const auto* contents = entity.GetContents()->AsTexture();
+  if (!contents) {
+    return false;
+  }
+  auto texture = contents->GetTexture();
+  // Strict source rects and external textures use different pipelines.
+  if (!texture || texture->GetSize().IsEmpty() ||
+      texture->GetTextureDescriptor().type ==
+          TextureType::kTextureExternalOES ||
+      contents->GetStrictSourceRect() ||
+      contents->GetDestinationRect().IsEmpty() ||
+      contents->GetSourceRect().IsEmpty()) {
+    return false;
+  }
+
+  if (quads_.empty()) {
+    texture_ = texture;
+    sampler_descriptor_ = contents->GetSamplerDescriptor();
+    opacity_ = contents->GetOpacity();
+    stencil_enabled_ = contents->GetStencilEnabled();
+  } else if (texture != texture_ ||
+             !sampler_descriptor_.IsEqual(contents->GetSamplerDescriptor()) ||
+             opacity_ != contents->GetOpacity() ||
+             stencil_enabled_ != contents->GetStencilEnabled()) {
+    return false;
+  }
+
+  auto destination_rect = contents->GetDestinationRect();
+  quads_.push_back(Quad{
+      .positions = destination_rect.GetTransformedPoints(entity.GetTransform()),
+      .texture_coords =
+          Rect::MakeSize(texture->GetSize()).Project(contents->GetSourceRect()),
+  });
+  return true;
+}
+
+size_t RectBatchContents::GetRectCount() const {
+  return quads_.size();
+}
+
+const Entity& RectBatchContents::GetFirstEntity() const {
+  return first_entity_;
+}
+
+std::optional<Rect> RectBatchContents::GetCoverage(const Entity& entity) const {
+  if (quads_.empty()) {
+    return std::nullopt;
+  }
+  return coverage_.TransformBounds(entity.GetTransform());
+}
+
+bool RectBatchContents::Render(const ContentContext& renderer,
+                               const Entity& entity,
+                               RenderPass& pass) const {
+  if (quads_.empty()) {
+    return true;  // Nothing to render.
+  }
+  switch (type_) {
+    case Type::kSolidColor:
+      return RenderSolidColor(renderer, entity, pass);
+    case Type::kTexture:
+      return RenderTexture(renderer, entity, pass);
+  }
+  FML_UNREACHABLE();
+}
+
+bool RectBatchContents::RenderSolidColor(const ContentContext& renderer,
+                                         const Entity& entity,
+                                         RenderPass& pass) const {
+  using VS = GeometryColorPipeline::VertexShader;
+  using FS = GeometryColorPipeline::FragmentShader;
+
+  VertexBufferBuilder<VS::PerVertexData> vertex_builder;
+  vertex_builder.Reserve(quads_.size() * kQuadIndices.size());
+  for (const auto& quad : quads_) {
+    for (auto index : kQuadIndices) {
+      vertex_builder.AppendVertex({
+          .position = quad.positions[index],
+          .color = quad.color,
+      });
+    }
+  }
+
+  auto& host_buffer = renderer.GetTransientsBuffer();
+  auto options = OptionsFromPassAndEntity(pass, entity);
+  options.primitive_type = PrimitiveType::kTriangle;
+
+  pass.SetCommandLabel("Solid Fill Batch");
+  pass.SetPipeline(renderer.GetGeometryColorPipeline(options));
+  pass.SetStencilReference(entity.GetClipDepth());
+  pass.SetVertexBuffer(vertex_builder.CreateVertexBuffer(host_buffer));
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = pass.GetOrthographicTransform() * entity.GetTransform();
+  VS::BindFrameInfo(pass, host_buffer.EmplaceUniform(frame_info));
+
+  FS::FragInfo frag_info;
+  frag_info.alpha = 1.0f;
+  FS::BindFragInfo(pass, host_buffer.EmplaceUniform(frag_info));
+
+  return pass.Draw().ok();
+}
+
+bool RectBatchContents::RenderTexture(const ContentContext& renderer,
+                                      const Entity& entity,
+                                      RenderPass& pass) const {
+  using VS = TextureFillVertexShader;
+  using FS = TextureFillFragmentShader;
+
+  VertexBufferBuilder<VS::PerVertexData> vertex_builder;
+  vertex_builder.Reserve(quads_.size() * kQuadIndices.size());
+  for (const auto& quad : quads_) {
+    auto texture_coords = quad.texture_coords.GetPoints();
+    for (auto index : kQuadIndices) {
+      vertex_builder.AppendVertex(
+          {quad.positions[index], texture_coords[index]});
+    }
+  }
+
+  auto& host_buffer = renderer.GetTransientsBuffer();
+  auto options = OptionsFromPassAndEntity(pass, entity);
+  if (!stencil_enabled_) {
+    options.stencil_compare = CompareFunction::kAlways;
+  }
+  options.primitive_type = PrimitiveType::kTriangle;
+
+  pass.SetCommandLabel("Texture Fill Batch");
+  pass.SetPipeline(renderer.GetTexturePipeline(options));
+  pass.SetStencilReference(entity.GetClipDepth());
+  pass.SetVertexBuffer(vertex_builder.CreateVertexBuffer(host_buffer));
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = pass.GetOrthographicTransform() * entity.GetTransform();
+  frame_info.texture_sampler_y_coord_scale = texture_->GetYCoordScale();
+  frame_info.alpha = opacity_;
+  VS::BindFrameInfo(pass, host_buffer.EmplaceUniform(frame_info));
+
+  FS::BindTextureSampler(
+      pass, texture_,
+      renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+          sampler_descriptor_));
+
+  return pass.Draw().ok();
+}
+
+}  // namespace impeller
@@ -0,0 +1,121 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_CONTENTS_RECT_BATCH_CONTENTS_H_
+#define FLUTTER_IMPELLER_ENTITY_CONTENTS_RECT_BATCH_CONTENTS_H_
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "impeller/core/sampler_descriptor.h"
+#include "impeller/entity/contents/contents.h"
+#include "impeller/entity/entity.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/point.h"
+#include "impeller/geometry/rect.h"
+
+namespace impeller {
+
+class Texture;
+
+//------------------------------------------------------------------------------
+/// @brief      Renders the rectangles of consecutive solid color or texture
+///             entities that share a pipeline and bindings with a single draw.
+///
+///             The vertices of each rectangle are transformed on the CPU and
+///             concatenated in the order the entities were appended. Since the
+///             GPU rasterizes primitives of a draw in order, merging
+///             consecutive entities is valid even when their rectangles
+///             overlap.
+///
+///             The batch itself must be rendered with an identity transform.
+///
+class RectBatchContents final : public Contents {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a batch containing the rectangle of the entity.
+  ///
+  /// @return     The batch or `nullptr` if the entity doesn't draw a single
+  ///             rectangle that can be batched.
+  ///
+  static std::shared_ptr<RectBatchContents> Make(const Entity& entity);
+
+  ~RectBatchContents() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Appends the rectangle of an entity drawn right after the
+  ///             entities already in the batch.
+  ///
+  ///             The entity must use the same blend mode and clip depth as the
+  ///             first entity of the batch. Texture entities must also sample
+  ///             the same texture with the same sampler and opacity.
+  ///
+  /// @return     Whether the entity could be added to the batch.
+  ///
+  bool Append(const Entity& entity);
+
+  size_t GetRectCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The entity the batch was created from. Its blend mode, clip
+  ///             depth and capture apply to the whole batch.
+  ///
+  const Entity& GetFirstEntity() const;
+
+  // |Contents|
+  std::optional<Rect> GetCoverage(const Entity& entity) const override;
+
+  // |Contents|
+  bool Render(const ContentContext& renderer,
+              const Entity& entity,
+              RenderPass& pass) const override;
+
+ private:
+  enum class Type {
+    kSolidColor,
+    kTexture,
+  };
+
+  struct Quad {
+    std::array<Point, 4> positions;
+    // Only used by solid color batches.
+    Color color;
+    // Only used by texture batches.
+    Rect texture_coords;
+  };
+
+  const Type type_;
+  const Entity first_entity_;
+  std::vector<Quad> quads_;
+  Rect coverage_;
+
+  std::shared_ptr<Texture> texture_;
+  SamplerDescriptor sampler_descriptor_;
+  Scalar opacity_ = 1.0f;
+  bool stencil_enabled_ = true;
+
+  RectBatchContents(Type type, Entity first_entity);
+
+  bool AppendSolidColor(const Entity& entity);
+
+  bool AppendTexture(const Entity& entity);
+
+  bool RenderSolidColor(const ContentContext& renderer,
+                        const Entity& entity,
+                        RenderPass& pass) const;
+
+  bool RenderTexture(const ContentContext& renderer,
+                     const Entity& entity,
+                     RenderPass& pass) const;
+
+  RectBatchContents(const RectBatchContents&) = delete;
+
+  RectBatchContents& operator=(const RectBatchContents&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_CONTENTS_RECT_BATCH_CONTENTS_H_
@@ -4,6 +4,7 @@
 
 #include "impeller/entity/contents/runtime_effect_contents.h"
 
+#include <chrono>
 #include <future>
 #include <memory>
 
@@ -23,6 +24,10 @@
 
 namespace impeller {
 
+DrawCategory RuntimeEffectContents::GetDrawCategory() const {
+  return DrawCategory::kRuntimeEffect;
+}
+
 void RuntimeEffectContents::SetRuntimeStage(
     std::shared_ptr<RuntimeStage> runtime_stage) {
   runtime_stage_ = std::move(runtime_stage);
@@ -66,6 +71,37 @@ static std::shared_ptr<ShaderMetadata> MakeShaderMetadata(
   return metadata;
 }
 
+/// The descriptor set layouts of the uniforms of a runtime stage. Uniform
+/// buffers keep their locations and samplers are bound right after them, in
+/// declaration order.
+static std::vector<DescriptorSetLayout> GetDescriptorSetLayouts(
+    const RuntimeStage& runtime_stage) {
+  std::vector<DescriptorSetLayout> descriptor_set_layouts;
+  for (const auto& uniform : runtime_stage.GetUniforms()) {
+    if (uniform.type == kStruct) {
+      descriptor_set_layouts.emplace_back(DescriptorSetLayout{
+          static_cast<uint32_t>(uniform.location),
+          DescriptorType::kUniformBuffer,
+          ShaderStage::kFragment,
+      });
+    }
+  }
+  for (const auto& uniform : runtime_stage.GetUniforms()) {
+    if (uniform.type == kSampledImage) {
+      uint32_t sampler_binding_location = 0u;
+      if (!descriptor_set_layouts.empty()) {
+        sampler_binding_location = descriptor_set_layouts.back().binding + 1;
+      }
+      descriptor_set_layouts.emplace_back(DescriptorSetLayout{
+          sampler_binding_location,
+          DescriptorType::kSampledImage,
+          ShaderStage::kFragment,
+      });
+    }
+  }
+  return descriptor_set_layouts;
+}
+
 bool RuntimeEffectContents::Render(const ContentContext& renderer,
                                    const Entity& entity,
                                    RenderPass& pass) const {
@@ -81,19 +117,6 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
   std::shared_ptr<const ShaderFunction> function = library->GetFunction(
       runtime_stage_->GetEntrypoint(), ShaderStage::kFragment);
 
-  //--------------------------------------------------------------------------
-  /// Resolve geometry and content context options.
-  ///
-
-  auto geometry_result =
-      GetGeometry()->GetPositionBuffer(renderer, entity, pass);
-  auto options = OptionsFromPassAndEntity(pass, entity);
-  if (geometry_result.prevent_overdraw) {
-    options.stencil_compare = CompareFunction::kEqual;
-    options.stencil_operation = StencilOperation::kIncrementClamp;
-  }
-  options.primitive_type = geometry_result.type;
-
   if (function && runtime_stage_->IsDirty()) {
     renderer.ClearCachedRuntimeEffectPipeline(runtime_stage_->GetEntrypoint());
     context->GetPipelineLibrary()->RemovePipelinesWithEntryPoint(function);
@@ -103,6 +126,25 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
     function = nullptr;
   }
 
+  if (!function && renderer.AreRuntimeEffectPipelinesAsync()) {
+    // Skip the effect until its function is ready instead of blocking the
+    // raster thread.
+    runtime_stage_->SetClean();
+    if (!renderer.RegisterRuntimeEffectFunctionAsync(
+            runtime_stage_->GetEntrypoint(),
+            ToShaderStage(runtime_stage_->GetShaderStage()),
+            runtime_stage_->GetCodeMapping())) {
+      return true;
+    }
+    function = library->GetFunction(runtime_stage_->GetEntrypoint(),
+                                    ShaderStage::kFragment);
+    if (!function) {
+      VALIDATION_LOG << "Failed to build runtime effect (entry point: "
+                     << runtime_stage_->GetEntrypoint() << ")";
+      return false;
+    }
+  }
+
   if (!function) {
     std::promise<bool> promise;
     auto future = promise.get_future();
@@ -135,8 +177,21 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
   }
 
   //--------------------------------------------------------------------------
-  /// Set up the command. Defer setting up the pipeline until the descriptor set
-  /// layouts are known from the uniforms.
+  /// Resolve geometry and content context options.
+  ///
+
+  auto geometry_result =
+      GetGeometry()->GetPositionBuffer(renderer, entity, pass);
+  auto options = OptionsFromPassAndEntity(pass, entity);
+  if (geometry_result.prevent_overdraw) {
+    options.stencil_compare = CompareFunction::kEqual;
+    options.stencil_operation = StencilOperation::kIncrementClamp;
+  }
+  options.primitive_type = geometry_result.type;
+
+  //--------------------------------------------------------------------------
+  /// Get the pipeline before binding anything, so that the draw can be
+  /// skipped while the pipeline is being compiled asynchronously.
   ///
 
   const std::shared_ptr<const Capabilities>& caps = context->GetCapabilities();
@@ -145,6 +200,54 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
 
   using VS = RuntimeEffectVertexShader;
 
+  const std::vector<DescriptorSetLayout> descriptor_set_layouts =
+      GetDescriptorSetLayouts(*runtime_stage_);
+
+  auto create_callback = [&]() -> PipelineFuture<PipelineDescriptor> {
+    PipelineDescriptor desc;
+    desc.SetLabel("Runtime Stage");
+    desc.AddStageEntrypoint(
+        library->GetFunction(VS::kEntrypointName, ShaderStage::kVertex));
+    desc.AddStageEntrypoint(library->GetFunction(
+        runtime_stage_->GetEntrypoint(), ShaderStage::kFragment));
+    auto vertex_descriptor = std::make_shared<VertexDescriptor>();
+    vertex_descriptor->SetStageInputs(VS::kAllShaderStageInputs,
+                                      VS::kInterleavedBufferLayout);
+    vertex_descriptor->RegisterDescriptorSetLayouts(VS::kDescriptorSetLayouts);
+    vertex_descriptor->RegisterDescriptorSetLayouts(
+        descriptor_set_layouts.data(), descriptor_set_layouts.size());
+    desc.SetVertexDescriptor(std::move(vertex_descriptor));
+    desc.SetColorAttachmentDescriptor(
+        0u, {.format = color_attachment_format, .blending_enabled = true});
+
+    StencilAttachmentDescriptor stencil0;
+    stencil0.stencil_compare = CompareFunction::kEqual;
+    desc.SetStencilAttachmentDescriptors(stencil0);
+    desc.SetStencilPixelFormat(stencil_attachment_format);
+
+    options.ApplyToPipelineDescriptor(desc);
+    return context->GetPipelineLibrary()->GetPipeline(desc);
+  };
+
+  PipelineFuture<PipelineDescriptor> pipeline_future =
+      renderer.GetCachedRuntimeEffectPipeline(runtime_stage_->GetEntrypoint(),
+                                              options, create_callback);
+  if (renderer.AreRuntimeEffectPipelinesAsync() && pipeline_future.IsValid() &&
+      pipeline_future.future.wait_for(std::chrono::seconds(0)) !=
+          std::future_status::ready) {
+    return true;
+  }
+  std::shared_ptr<Pipeline<PipelineDescriptor>> pipeline =
+      pipeline_future.IsValid() ? pipeline_future.Get() : nullptr;
+  if (!pipeline) {
+    VALIDATION_LOG << "Failed to get or create runtime effect pipeline.";
+    return false;
+  }
+
+  //--------------------------------------------------------------------------
+  /// Set up the command.
+  ///
+
   pass.SetCommandLabel("RuntimeEffectContents");
   pass.SetStencilReference(entity.GetClipDepth());
   pass.SetVertexBuffer(std::move(geometry_result.vertex_buffer));
@@ -165,8 +268,7 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
   size_t minimum_sampler_index = 100000000;
   size_t buffer_index = 0;
   size_t buffer_offset = 0;
-
-  std::vector<DescriptorSetLayout> descriptor_set_layouts;
+  size_t struct_count = 0;
 
   for (const auto& uniform : runtime_stage_->GetUniforms()) {
     std::shared_ptr<ShaderMetadata> metadata = MakeShaderMetadata(uniform);
@@ -208,11 +310,7 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
       case kStruct: {
         FML_DCHECK(renderer.GetContext()->GetBackendType() ==
                    Context::BackendType::kVulkan);
-        descriptor_set_layouts.emplace_back(DescriptorSetLayout{
-            static_cast<uint32_t>(uniform.location),
-            DescriptorType::kUniformBuffer,
-            ShaderStage::kFragment,
-        });
+        struct_count++;
         ShaderUniformSlot uniform_slot;
         uniform_slot.name = uniform.name.c_str();
         uniform_slot.binding = uniform.location;
@@ -257,19 +355,8 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
 
         SampledImageSlot image_slot;
         image_slot.name = uniform.name.c_str();
-
-        uint32_t sampler_binding_location = 0u;
-        if (!descriptor_set_layouts.empty()) {
-          sampler_binding_location = descriptor_set_layouts.back().binding + 1;
-        }
-
-        descriptor_set_layouts.emplace_back(DescriptorSetLayout{
-            sampler_binding_location,
-            DescriptorType::kSampledImage,
-            ShaderStage::kFragment,
-        });
-
-        image_slot.binding = sampler_binding_location;
+        image_slot.binding =
+            descriptor_set_layouts[struct_count + sampler_index].binding;
         image_slot.texture_index = uniform.location - minimum_sampler_index;
         pass.BindResource(ShaderStage::kFragment, image_slot, *metadata,
                           input.texture, sampler);
@@ -282,42 +369,7 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
     }
   }
 
-  /// Now that the descriptor set layouts are known, get the pipeline.
-  auto create_callback =
-      [&]() -> std::shared_ptr<Pipeline<PipelineDescriptor>> {
-    PipelineDescriptor desc;
-    desc.SetLabel("Runtime Stage");
-    desc.AddStageEntrypoint(
-        library->GetFunction(VS::kEntrypointName, ShaderStage::kVertex));
-    desc.AddStageEntrypoint(library->GetFunction(
-        runtime_stage_->GetEntrypoint(), ShaderStage::kFragment));
-    auto vertex_descriptor = std::make_shared<VertexDescriptor>();
-    vertex_descriptor->SetStageInputs(VS::kAllShaderStageInputs,
-                                      VS::kInterleavedBufferLayout);
-    vertex_descriptor->RegisterDescriptorSetLayouts(VS::kDescriptorSetLayouts);
-    vertex_descriptor->RegisterDescriptorSetLayouts(
-        descriptor_set_layouts.data(), descriptor_set_layouts.size());
-    desc.SetVertexDescriptor(std::move(vertex_descriptor));
-    desc.SetColorAttachmentDescriptor(
-        0u, {.format = color_attachment_format, .blending_enabled = true});
-
-    StencilAttachmentDescriptor stencil0;
-    stencil0.stencil_compare = CompareFunction::kEqual;
-    desc.SetStencilAttachmentDescriptors(stencil0);
-    desc.SetStencilPixelFormat(stencil_attachment_format);
-
-    options.ApplyToPipelineDescriptor(desc);
-    auto pipeline = context->GetPipelineLibrary()->GetPipeline(desc).Get();
-    if (!pipeline) {
-      VALIDATION_LOG << "Failed to get or create runtime effect pipeline.";
-      return nullptr;
-    }
-
-    return pipeline;
-  };
-
-  pass.SetPipeline(renderer.GetCachedRuntimeEffectPipeline(
-      runtime_stage_->GetEntrypoint(), options, create_callback));
+  pass.SetPipeline(pipeline);
 
   if (!pass.Draw().ok()) {
     return false;
@@ -4,12 +4,15 @@
 
 #include "solid_color_contents.h"
 
+#include <algorithm>
+
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/geometry/path.h"
 #include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
 
 namespace impeller {
 
@@ -33,6 +36,17 @@ bool SolidColorContents::IsOpaque() const {
   return GetColor().IsOpaque();
 }
 
+bool SolidColorContents::IsAnalyticallyAntialiased(const Entity& entity) const {
+  // Fractional coverage is applied as alpha, which only matches the coverage
+  // computed by multisampling for source-over blending.
+  if (entity.GetBlendMode() != BlendMode::kSourceOver ||
+      entity.GetTransform().HasPerspective()) {
+    return false;
+  }
+  const std::shared_ptr<Geometry>& geometry = GetGeometry();
+  return geometry != nullptr && geometry->AsAnalyticRRect().has_value();
+}
+
 std::optional<Rect> SolidColorContents::GetCoverage(
     const Entity& entity) const {
   if (GetColor().IsTransparent()) {
@@ -52,8 +66,25 @@ bool SolidColorContents::Render(const ContentContext& renderer,
   auto capture = entity.GetCapture().CreateChild("SolidColorContents");
   using VS = SolidFillPipeline::VertexShader;
 
+  if (renderer.IsAnalyticAntialiasingEnabled() &&
+      IsAnalyticallyAntialiased(entity)) {
+    return RenderAnalyticRRect(renderer, entity, pass,
+                               GetGeometry()->AsAnalyticRRect().value());
+  }
+
+  // The stencil-then-cover fill keeps the clip depth in the low 7 bits of the
+  // stencil buffer while it is in progress.
+  if (renderer.AreStencilThenCoverFillsEnabled() &&
+      pass.HasStencilAttachment() && entity.GetClipDepth() < 0x80) {
+    auto fans = GetGeometry()->GetStencilFanBuffer(renderer, entity, pass);
+    if (fans.has_value()) {
+      return RenderStencilThenCover(renderer, entity, pass,
+                                    std::move(fans.value()));
+    }
+  }
+
   auto geometry_result =
-      GetGeometry()->GetPositionBuffer(renderer, entity, pass);
+      GetGeometry()->GetSharedPositionBuffer(renderer, entity, pass);
 
   auto options = OptionsFromPassAndEntity(pass, entity);
   if (geometry_result.prevent_overdraw) {
@@ -86,6 +117,150 @@ bool SolidColorContents::Render(const ContentContext& renderer,
   return true;
 }
 
+bool SolidColorContents::RenderAnalyticRRect(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass,
+    const AnalyticRRect& rrect) const {
+  using VS = RRectAAPipeline::VertexShader;
+  using FS = RRectAAPipeline::FragmentShader;
+
+  Rect rect = rrect.rect.GetPositive();
+  Matrix transform = entity.GetTransform() * rrect.transform *
+                     Matrix::MakeTranslation(rect.GetCenter());
+
+  // The fragment stage measures distances along the local axes of the rrect
+  // in device pixels, so the geometry is padded by a pixel on each side for
+  // the fractional coverage of the edges.
+  Point pixel_scale(transform.GetBasisX().Length(),
+                    transform.GetBasisY().Length());
+  if (pixel_scale.x <= 0 || pixel_scale.y <= 0) {
+    return true;
+  }
+  Size half_size = rect.GetSize() * 0.5f;
+  Size radii(std::clamp(rrect.radii.width, 0.0f, half_size.width),
+             std::clamp(rrect.radii.height, 0.0f, half_size.height));
+  Scalar pad_x = half_size.width + 1.0f / pixel_scale.x;
+  Scalar pad_y = half_size.height + 1.0f / pixel_scale.y;
+
+  VertexBufferBuilder<VS::PerVertexData> vtx_builder;
+  vtx_builder.AddVertices({
+      {Point(-pad_x, -pad_y)},
+      {Point(pad_x, -pad_y)},
+      {Point(-pad_x, pad_y)},
+      {Point(pad_x, pad_y)},
+  });
+
+  auto options = OptionsFromPassAndEntity(pass, entity);
+  options.primitive_type = PrimitiveType::kTriangleStrip;
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = pass.GetOrthographicTransform() * transform;
+  frame_info.pixel_scale = pixel_scale;
+
+  FS::FragInfo frag_info;
+  frag_info.color = GetColor().Premultiply();
+  frag_info.half_size = Point(half_size) * pixel_scale;
+  frag_info.radii = Point(radii) * pixel_scale;
+
+  pass.SetCommandLabel("Solid Fill (Analytic AA)");
+  pass.SetPipeline(renderer.GetRRectAAPipeline(options));
+  pass.SetVertexBuffer(
+      vtx_builder.CreateVertexBuffer(renderer.GetTransientsBuffer()));
+  pass.SetStencilReference(entity.GetClipDepth());
+  VS::BindFrameInfo(pass,
+                    renderer.GetTransientsBuffer().EmplaceUniform(frame_info));
+  FS::BindFragInfo(pass,
+                   renderer.GetTransientsBuffer().EmplaceUniform(frag_info));
+
+  return pass.Draw().ok();
+}
+
+bool SolidColorContents::RenderStencilThenCover(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass,
+    StencilFanResult fans) const {
+  using ClipVS = ClipPipeline::VertexShader;
+  using VS = SolidFillPipeline::VertexShader;
+
+  auto& host_buffer = renderer.GetTransientsBuffer();
+  Matrix transform = pass.GetOrthographicTransform() * entity.GetTransform();
+
+  // The clip and solid fill pipelines both take a single position attribute,
+  // so the cover rectangle is shared by the stencil and color draws.
+  auto points = fans.cover_rect.GetPoints();
+  auto cover_vertices =
+      VertexBufferBuilder<VS::PerVertexData>{}
+          .AddVertices({{points[0]}, {points[1]}, {points[2]}, {points[3]}})
+          .CreateVertexBuffer(host_buffer);
+
+  ClipVS::FrameInfo clip_info;
+  clip_info.mvp = transform;
+  auto clip_info_buffer = host_buffer.EmplaceUniform(clip_info);
+
+  auto stencil_options = OptionsFromPass(pass);
+  stencil_options.blend_mode = BlendMode::kDestination;
+  stencil_options.primitive_type = PrimitiveType::kTriangleStrip;
+
+  // Mark the pixels at the clip depth of this entity and reset their count.
+  pass.SetCommandLabel("Stencil Fill (Mark)");
+  stencil_options.stencil_fill_mode = StencilFillMode::kMark;
+  pass.SetPipeline(renderer.GetClipPipeline(stencil_options));
+  pass.SetStencilReference(entity.GetClipDepth());
+  pass.SetVertexBuffer(cover_vertices);
+  ClipVS::BindFrameInfo(pass, clip_info_buffer);
+  if (!pass.Draw().ok()) {
+    return false;
+  }
+
+  pass.SetCommandLabel("Stencil Fill (Clear Count)");
+  stencil_options.stencil_fill_mode = StencilFillMode::kClearCount;
+  pass.SetPipeline(renderer.GetClipPipeline(stencil_options));
+  pass.SetStencilReference(0x80);
+  pass.SetVertexBuffer(cover_vertices);
+  ClipVS::BindFrameInfo(pass, clip_info_buffer);
+  if (!pass.Draw().ok()) {
+    return false;
+  }
+
+  // Accumulate the winding of the fans in the marked pixels.
+  pass.SetCommandLabel("Stencil Fill (Fans)");
+  stencil_options.stencil_fill_mode = fans.fill_type == FillType::kOdd
+                                          ? StencilFillMode::kEvenOdd
+                                          : StencilFillMode::kNonZero;
+  stencil_options.primitive_type = fans.fans.type;
+  pass.SetPipeline(renderer.GetClipPipeline(stencil_options));
+  pass.SetStencilReference(0x80);
+  pass.SetVertexBuffer(std::move(fans.fans.vertex_buffer));
+  clip_info.mvp = fans.fans.transform;
+  ClipVS::BindFrameInfo(pass, host_buffer.EmplaceUniform(clip_info));
+  if (!pass.Draw().ok()) {
+    return false;
+  }
+
+  pass.SetCommandLabel("Stencil Fill (Cover)");
+  auto options = OptionsFromPassAndEntity(pass, entity);
+  options.stencil_fill_mode = StencilFillMode::kCover;
+  options.primitive_type = PrimitiveType::kTriangleStrip;
+  pass.SetPipeline(renderer.GetSolidFillPipeline(options));
+  pass.SetStencilReference(0x80);
+  pass.SetVertexBuffer(std::move(cover_vertices));
+  VS::FrameInfo frame_info;
+  frame_info.mvp = transform;
+  frame_info.color = GetColor().Premultiply();
+  VS::BindFrameInfo(pass, host_buffer.EmplaceUniform(frame_info));
+  if (!pass.Draw().ok()) {
+    return false;
+  }
+
+  // Return every marked pixel to the clip depth.
+  auto restore = ClipRestoreContents();
+  restore.SetRestoreCoverage(
+      fans.cover_rect.TransformBounds(entity.GetTransform()));
+  return restore.Render(renderer, entity, pass);
+}
+
 std::unique_ptr<SolidColorContents> SolidColorContents::Make(Path path,
                                                              Color color) {
   auto contents = std::make_unique<SolidColorContents>();
@@ -103,6 +278,10 @@ std::optional<Color> SolidColorContents::AsBackgroundColor(
              : std::optional<Color>();
 }
 
+const SolidColorContents* SolidColorContents::AsSolidColor() const {
+  return this;
+}
+
 bool SolidColorContents::ApplyColorFilter(
     const ColorFilterProc& color_filter_proc) {
   color_ = color_filter_proc(color_);
@@ -36,6 +36,9 @@ class SolidColorContents final : public ColorSourceContents {
   // |Contents|
   bool IsOpaque() const override;
 
+  // |Contents|
+  bool IsAnalyticallyAntialiased(const Entity& entity) const override;
+
   // |Contents|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
@@ -47,11 +50,24 @@ class SolidColorContents final : public ColorSourceContents {
   std::optional<Color> AsBackgroundColor(const Entity& entity,
                                          ISize target_size) const override;
 
+  // |Contents|
+  const SolidColorContents* AsSolidColor() const override;
+
   // |Contents|
   [[nodiscard]] bool ApplyColorFilter(
       const ColorFilterProc& color_filter_proc) override;
 
  private:
+  bool RenderAnalyticRRect(const ContentContext& renderer,
+                           const Entity& entity,
+                           RenderPass& pass,
+                           const AnalyticRRect& rrect) const;
+
+  bool RenderStencilThenCover(const ContentContext& renderer,
+                              const Entity& entity,
+                              RenderPass& pass,
+                              StencilFanResult fans) const;
+
   Color color_;
 
   SolidColorContents(const SolidColorContents&) = delete;
@@ -26,6 +26,10 @@ SolidRRectBlurContents::SolidRRectBlurContents() = default;
 
 SolidRRectBlurContents::~SolidRRectBlurContents() = default;
 
+DrawCategory SolidRRectBlurContents::GetDrawCategory() const {
+  return DrawCategory::kBlur;
+}
+
 void SolidRRectBlurContents::SetRRect(std::optional<Rect> rect,
                                       Scalar corner_radius) {
   rect_ = rect;
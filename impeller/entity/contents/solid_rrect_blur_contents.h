@@ -48,6 +48,9 @@ class SolidRRectBlurContents final : public Contents {
   [[nodiscard]] bool ApplyColorFilter(
       const ColorFilterProc& color_filter_proc) override;
 
+  // |Contents|
+  DrawCategory GetDrawCategory() const override;
+
  private:
   std::optional<Rect> rect_;
   Scalar corner_radius_;
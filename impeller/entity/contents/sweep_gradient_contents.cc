@@ -18,6 +18,10 @@ SweepGradientContents::SweepGradientContents() = default;
 
 SweepGradientContents::~SweepGradientContents() = default;
 
+DrawCategory SweepGradientContents::GetDrawCategory() const {
+  return DrawCategory::kGradient;
+}
+
 void SweepGradientContents::SetCenterAndAngles(Point center,
                                                Degrees start_angle,
                                                Degrees end_angle) {
@@ -64,7 +68,8 @@ bool SweepGradientContents::IsOpaque() const {
 bool SweepGradientContents::Render(const ContentContext& renderer,
                                    const Entity& entity,
                                    RenderPass& pass) const {
-  if (renderer.GetDeviceCapabilities().SupportsSSBO()) {
+  if (ShouldUseSSBOGradient(renderer.GetDeviceCapabilities(),
+                            stops_.size())) {
     return RenderSSBO(renderer, entity, pass);
   }
   return RenderTexture(renderer, entity, pass);
@@ -134,9 +139,8 @@ bool SweepGradientContents::RenderTexture(const ContentContext& renderer,
   using VS = SweepGradientFillPipeline::VertexShader;
   using FS = SweepGradientFillPipeline::FragmentShader;
 
-  auto gradient_data = CreateGradientBuffer(colors_, stops_);
-  auto gradient_texture =
-      CreateGradientTexture(gradient_data, renderer.GetContext());
+  auto gradient_texture = renderer.GetGradientTextureCache()->GetTexture(
+      colors_, stops_, renderer.GetContext());
   if (gradient_texture == nullptr) {
     return false;
   }
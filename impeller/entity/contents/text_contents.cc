@@ -22,6 +22,10 @@ TextContents::TextContents() = default;
 
 TextContents::~TextContents() = default;
 
+DrawCategory TextContents::GetDrawCategory() const {
+  return DrawCategory::kText;
+}
+
 void TextContents::SetTextFrame(const std::shared_ptr<TextFrame>& frame) {
   frame_ = frame;
 }
@@ -69,7 +73,7 @@ std::optional<Rect> TextContents::GetCoverage(const Entity& entity) const {
 void TextContents::PopulateGlyphAtlas(
     const std::shared_ptr<LazyGlyphAtlas>& lazy_glyph_atlas,
     Scalar scale) {
-  lazy_glyph_atlas->AddTextFrame(*frame_, scale);
+  atlas_type_ = lazy_glyph_atlas->AddTextFrame(*frame_, scale);
   scale_ = scale;
 }
 
@@ -81,7 +85,7 @@ bool TextContents::Render(const ContentContext& renderer,
     return true;
   }
 
-  auto type = frame_->GetAtlasType();
+  auto type = atlas_type_;
   auto atlas =
       ResolveAtlas(*renderer.GetContext(), type, renderer.GetLazyGlyphAtlas());
 
@@ -94,10 +98,16 @@ bool TextContents::Render(const ContentContext& renderer,
   pass.SetCommandLabel("TextFrame");
   auto opts = OptionsFromPassAndEntity(pass, entity);
   opts.primitive_type = PrimitiveType::kTriangle;
-  if (type == GlyphAtlas::Type::kAlphaBitmap) {
-    pass.SetPipeline(renderer.GetGlyphAtlasPipeline(opts));
-  } else {
-    pass.SetPipeline(renderer.GetGlyphAtlasColorPipeline(opts));
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      pass.SetPipeline(renderer.GetGlyphAtlasPipeline(opts));
+      break;
+    case GlyphAtlas::Type::kColorBitmap:
+      pass.SetPipeline(renderer.GetGlyphAtlasColorPipeline(opts));
+      break;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      pass.SetPipeline(renderer.GetGlyphAtlasSdfPipeline(opts));
+      break;
   }
   pass.SetStencilReference(entity.GetClipDepth());
 
@@ -125,10 +135,17 @@ bool TextContents::Render(const ContentContext& renderer,
     frag_info.use_text_color = force_text_color_ ? 1.0 : 0.0;
     FSS::BindFragInfo(pass,
                       renderer.GetTransientsBuffer().EmplaceUniform(frag_info));
+  } else if (type == GlyphAtlas::Type::kSignedDistanceField) {
+    using FSS = GlyphAtlasSdfPipeline::FragmentShader;
+    FSS::FragInfo frag_info;
+    frag_info.spread = GlyphAtlas::kSignedDistanceFieldSpread;
+    FSS::BindFragInfo(pass,
+                      renderer.GetTransientsBuffer().EmplaceUniform(frag_info));
   }
 
   SamplerDescriptor sampler_desc;
-  if (frame_info.is_translation_scale) {
+  if (frame_info.is_translation_scale &&
+      type != GlyphAtlas::Type::kSignedDistanceField) {
     sampler_desc.min_filter = MinMagFilter::kNearest;
     sampler_desc.mag_filter = MinMagFilter::kNearest;
   } else {
@@ -137,6 +154,8 @@ bool TextContents::Render(const ContentContext& renderer,
     // on linear sampling to prevent crunchiness caused by the pixel grid not
     // being perfectly aligned.
     // The downside is that this slightly over-blurs rotated/skewed text.
+    // Distance fields are always interpolated, which keeps magnified glyphs
+    // sharp.
     sampler_desc.min_filter = MinMagFilter::kLinear;
     sampler_desc.mag_filter = MinMagFilter::kLinear;
   }
@@ -175,14 +194,20 @@ bool TextContents::Render(const ContentContext& renderer,
             reinterpret_cast<VS::PerVertexData*>(contents);
         for (const TextRun& run : frame_->GetRuns()) {
           const Font& font = run.GetFont();
-          Scalar rounded_scale = TextFrame::RoundScaledFontSize(
-              scale_, font.GetMetrics().point_size);
+          Scalar atlas_scale = TextFrame::GetAtlasScale(
+              type, scale_, font.GetMetrics().point_size);
           const FontGlyphAtlas* font_atlas =
-              atlas->GetFontGlyphAtlas(font, rounded_scale);
+              atlas->GetFontGlyphAtlas(font, atlas_scale);
           if (!font_atlas) {
             VALIDATION_LOG << "Could not find font in the atlas.";
             continue;
           }
+          // The distance fields extend past the glyph bounds by the spread on
+          // every side.
+          Scalar outset = type == GlyphAtlas::Type::kSignedDistanceField
+                              ? GlyphAtlas::kSignedDistanceFieldSpread /
+                                    atlas_scale
+                              : 0;
 
           for (const TextRun::GlyphPosition& glyph_position :
                run.GetGlyphPositions()) {
@@ -194,7 +219,8 @@ bool TextContents::Render(const ContentContext& renderer,
             }
             const Rect& atlas_glyph_bounds = maybe_atlas_glyph_bounds.value();
             vtx.atlas_glyph_bounds = Vector4(atlas_glyph_bounds.GetXYWH());
-            vtx.glyph_bounds = Vector4(glyph_position.glyph.bounds.GetXYWH());
+            vtx.glyph_bounds = Vector4(
+                glyph_position.glyph.bounds.Expand(outset).GetXYWH());
             vtx.glyph_position = glyph_position.position;
 
             for (const Point& point : unit_points) {
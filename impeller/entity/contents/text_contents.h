@@ -62,9 +62,14 @@ class TextContents final : public Contents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  DrawCategory GetDrawCategory() const override;
+
  private:
   std::shared_ptr<TextFrame> frame_;
   Scalar scale_ = 1.0;
+  // The type of the atlas the glyphs were added to at |scale_|.
+  GlyphAtlas::Type atlas_type_ = GlyphAtlas::Type::kAlphaBitmap;
   Color color_;
   Scalar inherited_opacity_ = 1.0;
   Vector2 offset_;
@@ -38,6 +38,10 @@ void TextureContents::SetDestinationRect(Rect rect) {
   destination_rect_ = rect;
 }
 
+const Rect& TextureContents::GetDestinationRect() const {
+  return destination_rect_;
+}
+
 void TextureContents::SetTexture(std::shared_ptr<Texture> texture) {
   texture_ = std::move(texture);
 }
@@ -54,6 +58,10 @@ void TextureContents::SetStencilEnabled(bool enabled) {
   stencil_enabled_ = enabled;
 }
 
+bool TextureContents::GetStencilEnabled() const {
+  return stencil_enabled_;
+}
+
 bool TextureContents::CanInheritOpacity(const Entity& entity) const {
   return true;
 }
@@ -230,6 +238,10 @@ const SamplerDescriptor& TextureContents::GetSamplerDescriptor() const {
   return sampler_descriptor_;
 }
 
+const TextureContents* TextureContents::AsTexture() const {
+  return this;
+}
+
 void TextureContents::SetDeferApplyingOpacity(bool defer_applying_opacity) {
   defer_applying_opacity_ = defer_applying_opacity;
 }
@@ -33,6 +33,8 @@ class TextureContents final : public Contents {
 
   void SetDestinationRect(Rect rect);
 
+  const Rect& GetDestinationRect() const;
+
   void SetTexture(std::shared_ptr<Texture> texture);
 
   std::shared_ptr<Texture> GetTexture() const;
@@ -55,6 +57,8 @@ class TextureContents final : public Contents {
 
   void SetStencilEnabled(bool enabled);
 
+  bool GetStencilEnabled() const;
+
   // |Contents|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
@@ -78,6 +82,9 @@ class TextureContents final : public Contents {
   // |Contents|
   void SetInheritedOpacity(Scalar opacity) override;
 
+  // |Contents|
+  const TextureContents* AsTexture() const override;
+
   void SetDeferApplyingOpacity(bool defer_applying_opacity);
 
  private:
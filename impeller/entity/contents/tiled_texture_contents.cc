@@ -82,12 +82,14 @@ SamplerDescriptor TiledTextureContents::CreateSamplerDescriptor(
   SamplerDescriptor descriptor = sampler_descriptor_;
   auto width_mode = TileModeToAddressMode(x_tile_mode_, capabilities);
   auto height_mode = TileModeToAddressMode(y_tile_mode_, capabilities);
-  if (width_mode.has_value()) {
-    descriptor.width_address_mode = width_mode.value();
-  }
-  if (height_mode.has_value()) {
-    descriptor.height_address_mode = height_mode.value();
-  }
+  // Tile modes without a sampler address mode are emulated in the tiled
+  // texture fill shader, which discards samples outside of the texture. Clamp
+  // the samples inside of it so that linear filtering at the edges does not
+  // pick up texels from the opposite side of the texture.
+  descriptor.width_address_mode =
+      width_mode.value_or(SamplerAddressMode::kClampToEdge);
+  descriptor.height_address_mode =
+      height_mode.value_or(SamplerAddressMode::kClampToEdge);
   return descriptor;
 }
 
@@ -45,6 +45,43 @@ TEST_P(EntityTest, TiledTextureContentsRendersWithCorrectPipeline) {
                "TextureFill Pipeline V#1");
 }
 
+TEST_P(EntityTest, TiledTextureContentsEmulatesDecalInTheFillShader) {
+  TextureDescriptor texture_desc;
+  texture_desc.size = {100, 100};
+  texture_desc.type = TextureType::kTexture2D;
+  texture_desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  texture_desc.storage_mode = StorageMode::kDevicePrivate;
+  auto texture =
+      GetContext()->GetResourceAllocator()->CreateTexture(texture_desc);
+
+  TiledTextureContents contents;
+  contents.SetTexture(texture);
+  contents.SetTileModes(Entity::TileMode::kDecal, Entity::TileMode::kMirror);
+  contents.SetGeometry(Geometry::MakeCover());
+
+  auto content_context = GetContentContext();
+  auto buffer = content_context->GetContext()->CreateCommandBuffer();
+  auto render_target = RenderTarget::CreateOffscreenMSAA(
+      *content_context->GetContext(),
+      *GetContentContext()->GetRenderTargetCache(), {100, 100},
+      /*mip_count=*/1);
+  auto render_pass = buffer->CreateRenderPass(render_target);
+
+  ASSERT_TRUE(contents.Render(*GetContentContext(), {}, *render_pass));
+  const std::vector<Command>& commands = render_pass->GetCommands();
+
+  // Decal is either supported by the sampler or emulated by the fill shader,
+  // but never requires more than the one draw.
+  ASSERT_EQ(commands.size(), 1u);
+  if (GetContext()->GetCapabilities()->SupportsDecalSamplerAddressMode()) {
+    ASSERT_STREQ(commands[0].pipeline->GetDescriptor().GetLabel().c_str(),
+                 "TextureFill Pipeline V#1");
+  } else {
+    ASSERT_STREQ(commands[0].pipeline->GetDescriptor().GetLabel().c_str(),
+                 "TiledTextureFill Pipeline V#1");
+  }
+}
+
 // GL_OES_EGL_image_external isn't supported on MacOS hosts.
 #if !defined(FML_OS_MACOSX)
 TEST_P(EntityTest, TiledTextureContentsRendersWithCorrectPipelineExternalOES) {
@@ -167,7 +167,20 @@ bool Entity::Render(const ContentContext& renderer,
         Rect::MakeSize(parent_pass.GetRenderTargetSize()));
   }
 
-  return contents_->Render(renderer, *this, parent_pass);
+  // Contents without a category of their own, such as the inputs of a
+  // filter, are attributed to the contents rendering them.
+  DrawCategory category = contents_->GetDrawCategory();
+  if (category == DrawCategory::kOther) {
+    category = renderer.GetDrawCategory();
+  }
+  const DrawCategory pass_category = parent_pass.GetDrawCategory();
+  const DrawCategory renderer_category = renderer.GetDrawCategory();
+  parent_pass.SetDrawCategory(category);
+  renderer.SetDrawCategory(category);
+  bool result = contents_->Render(renderer, *this, parent_pass);
+  parent_pass.SetDrawCategory(pass_category);
+  renderer.SetDrawCategory(renderer_category);
+  return result;
 }
 
 Scalar Entity::DeriveTextScale() const {
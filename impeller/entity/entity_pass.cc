@@ -4,12 +4,14 @@
 
 #include "impeller/entity/entity_pass.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <variant>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/memory/allocation_tag.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/strings.h"
 #include "impeller/base/validation.h"
@@ -19,8 +21,11 @@
 #include "impeller/entity/contents/filters/color_filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 #include "impeller/entity/contents/framebuffer_blend_contents.h"
+#include "impeller/entity/contents/gradient_generator.h"
+#include "impeller/entity/contents/solid_color_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/entity_pass_draw_list.h"
 #include "impeller/entity/inline_pass_context.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/rect.h"
@@ -44,6 +49,60 @@ std::tuple<std::optional<Color>, BlendMode> ElementAsBackgroundColor(
   }
   return {};
 }
+
+/// The number of clips up to `clip_depth` that are applied as scissor rects,
+/// which do not increment the stencil buffer.
+size_t CountScissorClips(
+    const EntityPass::ClipCoverageStack& clip_coverage_stack,
+    size_t clip_depth) {
+  size_t count = 0u;
+  for (const auto& layer : clip_coverage_stack) {
+    if (layer.is_scissor && layer.clip_depth <= clip_depth) {
+      count++;
+    }
+  }
+  return count;
+}
+
+/// The scissor rect of the innermost scissor clip relative to the pass. The
+/// coverage of a clip layer already includes the coverage of the layers below
+/// it.
+std::optional<IRect> GetClipScissor(
+    const EntityPass::ClipCoverageStack& clip_coverage_stack,
+    Point global_pass_position,
+    ISize target_size) {
+  for (auto it = clip_coverage_stack.rbegin(); it != clip_coverage_stack.rend();
+       ++it) {
+    if (!it->is_scissor) {
+      continue;
+    }
+    if (!it->coverage.has_value()) {
+      return IRect();
+    }
+    Rect coverage = Rect::RoundOut(it->coverage->Shift(-global_pass_position));
+    IRect scissor =
+        IRect::MakeLTRB(coverage.GetLeft(), coverage.GetTop(),
+                        coverage.GetRight(), coverage.GetBottom());
+    return scissor.Intersection(IRect::MakeSize(target_size))
+        .value_or(IRect());
+  }
+  return std::nullopt;
+}
+
+/// Subpass targets that are drawn without filtering are rounded up to a
+/// multiple of this size so that layers whose bounds change slightly from
+/// frame to frame keep reusing the same cached render targets.
+constexpr int64_t kSubpassSizeClass = 64;
+
+ISize RoundUpToSizeClass(ISize size, ISize max_size) {
+  auto round_up = [](int64_t value, int64_t max_value) {
+    auto rounded =
+        (value + kSubpassSizeClass - 1) / kSubpassSizeClass * kSubpassSizeClass;
+    return std::max(std::min(rounded, max_value), value);
+  };
+  return ISize(round_up(size.width, max_size.width),
+               round_up(size.height, max_size.height));
+}
 }  // namespace
 
 const std::string EntityPass::kCaptureDocumentName = "EntityPass";
@@ -96,24 +155,63 @@ size_t EntityPass::GetSubpassesDepth() const {
 
 std::optional<Rect> EntityPass::GetElementsCoverage(
     std::optional<Rect> coverage_limit) const {
+  // When there is a coverage limit, the clips of this pass limit the coverage
+  // of the elements drawn under them further, so that the coverage of a small
+  // layer in a large clip doesn't grow with the draws the clips cut off. Here
+  // a std::nullopt clip coverage means that everything is clipped out.
+  struct ClipLayer {
+    std::optional<Rect> coverage;
+    size_t clip_depth = 0u;
+  };
+  std::vector<ClipLayer> clip_stack;
+  if (coverage_limit.has_value()) {
+    clip_stack.push_back({.coverage = coverage_limit});
+  }
+
   std::optional<Rect> accumulated_coverage;
   for (const auto& element : elements_) {
     std::optional<Rect> element_coverage;
+    std::optional<Rect> clip_coverage =
+        clip_stack.empty() ? coverage_limit : clip_stack.back().coverage;
 
     if (auto entity = std::get_if<Entity>(&element)) {
+      if (!clip_stack.empty()) {
+        auto entity_clip = entity->GetClipCoverage(clip_coverage);
+        switch (entity_clip.type) {
+          case Contents::ClipCoverage::Type::kNoChange:
+            break;
+          case Contents::ClipCoverage::Type::kAppend:
+            clip_stack.push_back({.coverage = entity_clip.coverage,
+                                  .clip_depth = entity->GetClipDepth() + 1});
+            continue;
+          case Contents::ClipCoverage::Type::kRestore:
+            while (clip_stack.size() > 1u &&
+                   clip_stack.back().clip_depth > entity->GetClipDepth()) {
+              clip_stack.pop_back();
+            }
+            continue;
+        }
+        if (!clip_coverage.has_value()) {
+          continue;
+        }
+      }
+
       element_coverage = entity->GetCoverage();
 
       // When the coverage limit is std::nullopt, that means there is no limit,
       // as opposed to empty coverage.
-      if (element_coverage.has_value() && coverage_limit.has_value()) {
+      if (element_coverage.has_value() && clip_coverage.has_value()) {
         const auto* filter = entity->GetContents()->AsFilter();
         if (!filter || filter->IsTranslationOnly()) {
           element_coverage =
-              element_coverage->Intersection(coverage_limit.value());
+              element_coverage->Intersection(clip_coverage.value());
         }
       }
     } else if (auto subpass_ptr =
                    std::get_if<std::unique_ptr<EntityPass>>(&element)) {
+      if (!clip_stack.empty() && !clip_coverage.has_value()) {
+        continue;
+      }
       auto& subpass = *subpass_ptr->get();
 
       std::optional<Rect> unfiltered_coverage =
@@ -160,7 +258,7 @@ std::optional<Rect> EntityPass::GetElementsCoverage(
         element_coverage = unfiltered_coverage;
       }
 
-      element_coverage = Rect::Intersection(element_coverage, coverage_limit);
+      element_coverage = Rect::Intersection(element_coverage, clip_coverage);
     } else {
       FML_UNREACHABLE();
     }
@@ -248,7 +346,8 @@ static const constexpr RenderTarget::AttachmentConfig kDefaultStencilConfig =
 static EntityPassTarget CreateRenderTarget(ContentContext& renderer,
                                            ISize size,
                                            int mip_count,
-                                           const Color& clear_color) {
+                                           const Color& clear_color,
+                                           bool msaa_enabled = true) {
   const std::shared_ptr<Context>& context = renderer.GetContext();
 
   /// All of the load/store actions are managed by `InlinePassContext` when
@@ -265,7 +364,7 @@ static EntityPassTarget CreateRenderTarget(ContentContext& renderer,
   }
 
   RenderTarget target;
-  if (context->GetCapabilities()->SupportsOffscreenMSAA()) {
+  if (msaa_enabled && context->GetCapabilities()->SupportsOffscreenMSAA()) {
     target = RenderTarget::CreateOffscreenMSAA(
         /*context=*/*context,
         /*allocator=*/*renderer.GetRenderTargetCache(),
@@ -303,6 +402,85 @@ static EntityPassTarget CreateRenderTarget(ContentContext& renderer,
       renderer.GetDeviceCapabilities().SupportsImplicitResolvingMSAA());
 }
 
+bool EntityPass::CanDeferSubmission(ContentContext& renderer) const {
+  if (backdrop_filter_proc_ || required_mip_count_ > 1 ||
+      GetTotalPassReads(renderer) > 0) {
+    return false;
+  }
+  for (const auto& element : elements_) {
+    if (auto subpass = std::get_if<std::unique_ptr<EntityPass>>(&element)) {
+      if (!subpass->get()->CanDeferSubmission(renderer)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool EntityPass::IsAnalyticallyAntialiased() const {
+  if (backdrop_filter_proc_) {
+    return false;
+  }
+  for (const auto& element : elements_) {
+    const Entity* entity = std::get_if<Entity>(&element);
+    if (entity == nullptr || entity->GetContents() == nullptr ||
+        !entity->GetContents()->IsAnalyticallyAntialiased(*entity)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<bool> EntityPass::FindOccludedElements(
+    size_t clip_depth_floor) const {
+  std::vector<bool> occluded(elements_.size(), false);
+#ifdef IMPELLER_CONTENT_CULLING
+  std::optional<Rect> occluder;
+  for (size_t i = elements_.size(); i > 0; i--) {
+    const auto* entity = std::get_if<Entity>(&elements_[i - 1]);
+    // Subpasses and advanced blends may read what was drawn before them.
+    if (!entity || entity->GetBlendMode() > Entity::kLastPipelineBlendMode) {
+      occluder = std::nullopt;
+      continue;
+    }
+    const auto& contents = entity->GetContents();
+    if (!contents) {
+      continue;
+    }
+    auto coverage = entity->GetCoverage();
+    if (!coverage.has_value() ||
+        entity->GetClipCoverage(coverage).type !=
+            Contents::ClipCoverage::Type::kNoChange) {
+      continue;
+    }
+    if (occluder.has_value() && occluder->Contains(coverage.value())) {
+      occluded[i - 1] = true;
+      continue;
+    }
+
+    // A source blend replaces everything drawn before it within its geometry.
+    if (entity->GetBlendMode() != BlendMode::kSource ||
+        entity->GetClipDepth() != clip_depth_floor ||
+        !entity->GetTransform().IsTranslationScaleOnly()) {
+      continue;
+    }
+    const auto* solid_color = contents->AsSolidColor();
+    if (!solid_color || !solid_color->GetGeometry()) {
+      continue;
+    }
+    auto rect = solid_color->GetGeometry()->AsRect();
+    if (!rect.has_value()) {
+      continue;
+    }
+    auto candidate = rect->TransformBounds(entity->GetTransform());
+    if (!occluder.has_value() || candidate.Area() > occluder->Area()) {
+      occluder = candidate;
+    }
+  }
+#endif  // IMPELLER_CONTENT_CULLING
+  return occluded;
+}
+
 uint32_t EntityPass::GetTotalPassReads(ContentContext& renderer) const {
   return renderer.GetDeviceCapabilities().SupportsFramebufferFetch()
              ? backdrop_filter_reads_from_pass_texture_
@@ -312,13 +490,49 @@ uint32_t EntityPass::GetTotalPassReads(ContentContext& renderer) const {
 
 bool EntityPass::Render(ContentContext& renderer,
                         const RenderTarget& render_target) const {
+  FML_ALLOCATION_TAG(kImpellerEntity);
   auto capture =
       renderer.GetContext()->capture.GetDocument(kCaptureDocumentName);
 
   renderer.GetRenderTargetCache()->Start();
+  renderer.GetGradientTextureCache()->Start();
+  renderer.GetDrawBatchingStatistics() = {};
+  renderer.GetClipStatistics() = {};
+  renderer.GetSubpassStatistics() = {};
   fml::ScopedCleanupClosure reset_state([&renderer]() {
     renderer.GetLazyGlyphAtlas()->ResetTextFrames();
     renderer.GetRenderTargetCache()->End();
+    renderer.GetGradientTextureCache()->End();
+
+    static constexpr int64_t kImpellerDrawBatchingTraceID = 1993;
+    const auto& statistics = renderer.GetDrawBatchingStatistics();
+    FML_TRACE_COUNTER("impeller",                                        //
+                      "EntityPassDrawBatching",                          //
+                      kImpellerDrawBatchingTraceID,                      //
+                      "MergedDraws", statistics.merged_draw_count,       //
+                      "ReorderedDraws", statistics.reordered_draw_count  //
+    );
+
+    static constexpr int64_t kImpellerClipTraceID = 1994;
+    const auto& clip_statistics = renderer.GetClipStatistics();
+    FML_TRACE_COUNTER("impeller",                                          //
+                      "EntityPassClips",                                   //
+                      kImpellerClipTraceID,                                //
+                      "ScissorClips", clip_statistics.scissor_clip_count,  //
+                      "SkippedRestores",                                   //
+                      clip_statistics.skipped_restore_count                //
+    );
+
+    static constexpr int64_t kImpellerSubpassTraceID = 1996;
+    const auto& subpass_statistics = renderer.GetSubpassStatistics();
+    FML_TRACE_COUNTER("impeller",                                  //
+                      "EntityPassSubpasses",                       //
+                      kImpellerSubpassTraceID,                     //
+                      "Offscreen",                                 //
+                      subpass_statistics.offscreen_subpass_count,  //
+                      "Collapsed",                                 //
+                      subpass_statistics.collapsed_subpass_count   //
+    );
   });
 
   auto root_render_target = render_target;
@@ -531,12 +745,14 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
               clip_coverage_stack,           // clip_coverage_stack
               clip_depth_,                   // clip_depth_floor
               nullptr,                       // backdrop_filter_contents
-              pass_context.GetRenderPass(pass_depth)  // collapsed_parent_pass
+              pass_context.GetRenderPass(pass_depth),  // collapsed_parent_pass
+              pass_context.GetDeferredSubmissions()    // deferred_submissions
               )) {
         // Validation error messages are triggered for all `OnRender()` failure
         // cases.
         return EntityPass::EntityResult::Failure();
       }
+      renderer.GetSubpassStatistics().collapsed_subpass_count++;
       return EntityPass::EntityResult::Skip();
     }
 
@@ -611,16 +827,34 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
       return EntityPass::EntityResult::Skip();
     }
 
+    // Subpasses that only contain analytically anti-aliased draws skip the
+    // cost of multisampling and resolving their texture.
+    bool subpass_msaa_enabled = !renderer.IsAnalyticAntialiasingEnabled() ||
+                                !subpass->IsAnalyticallyAntialiased();
+
+    // The contents are rendered to the top left of the target, so the target
+    // may only be larger than the subpass when nothing samples past it.
+    auto subpass_target_size = subpass_size;
+    if (subpass->GetRequiredMipCount() == 1 &&
+        !subpass_backdrop_filter_contents &&
+        subpass->delegate_->DrawsSubpassTargetDirectly()) {
+      subpass_target_size =
+          RoundUpToSizeClass(subpass_size, renderer.GetContext()
+                                               ->GetResourceAllocator()
+                                               ->GetMaxTextureSizeSupported());
+    }
     auto subpass_target = CreateRenderTarget(
-        renderer,      // renderer
-        subpass_size,  // size
+        renderer,             // renderer
+        subpass_target_size,  // size
         subpass->GetRequiredMipCount(),
-        subpass->GetClearColorOrDefault(subpass_size));  // clear_color
+        subpass->GetClearColorOrDefault(subpass_size),  // clear_color
+        subpass_msaa_enabled);                          // msaa_enabled
 
     if (!subpass_target.IsValid()) {
       VALIDATION_LOG << "Subpass render target is invalid.";
       return EntityPass::EntityResult::Failure();
     }
+    renderer.GetSubpassStatistics().offscreen_subpass_count++;
 
     auto subpass_capture = capture.CreateChild("EntityPass");
     subpass_capture.AddRect("Coverage", *subpass_coverage, {.readonly = true});
@@ -645,8 +879,12 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
                 global_pass_position,         // local_pass_position
             ++pass_depth,                     // pass_depth
             subpass_clip_coverage_stack,      // clip_coverage_stack
-            subpass->clip_depth_,             // clip_depth_floor
-            subpass_backdrop_filter_contents  // backdrop_filter_contents
+            subpass->clip_depth_,              // clip_depth_floor
+            subpass_backdrop_filter_contents,  // backdrop_filter_contents
+            std::nullopt,                      // collapsed_parent_pass
+            subpass->CanDeferSubmission(renderer)
+                ? pass_context.GetDeferredSubmissions()
+                : nullptr  // deferred_submissions
             )) {
       // Validation error messages are triggered for all `OnRender()` failure
       // cases.
@@ -659,7 +897,7 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
 
     auto offscreen_texture_contents =
         subpass->delegate_->CreateContentsForSubpassTarget(
-            subpass_texture,
+            subpass_texture, subpass_size,
             Matrix::MakeTranslation(Vector3{-global_pass_position}) *
                 subpass->transform_);
 
@@ -705,6 +943,9 @@ bool EntityPass::RenderElement(Entity& element_entity,
     // append a validation log here.
     return false;
   }
+  result.pass->SetClipScissor(GetClipScissor(
+      clip_coverage_stack, global_pass_position,
+      result.pass->GetRenderTargetSize()));
 
   // If the pass context returns a backdrop texture, we need to draw it to the
   // current pass. We do this because it's faster and takes significantly less
@@ -767,9 +1008,14 @@ bool EntityPass::RenderElement(Entity& element_entity,
       break;
     case Contents::ClipCoverage::Type::kAppend: {
       auto op = clip_coverage_stack.back().coverage;
+      // Rectangles on whole pixels are clipped exactly by a scissor rect.
+      bool is_scissor =
+          static_cast<ClipContents*>(element_entity.GetContents().get())
+              ->IsPixelAlignedRectIntersect(element_entity);
       clip_coverage_stack.push_back(
           ClipCoverageLayer{.coverage = clip_coverage.coverage,
-                            .clip_depth = element_entity.GetClipDepth() + 1});
+                            .clip_depth = element_entity.GetClipDepth() + 1,
+                            .is_scissor = is_scissor});
       FML_DCHECK(clip_coverage_stack.back().clip_depth ==
                  clip_coverage_stack.front().clip_depth +
                      clip_coverage_stack.size() - 1);
@@ -779,6 +1025,10 @@ bool EntityPass::RenderElement(Entity& element_entity,
         // whole screen is already being clipped, so skip it.
         return true;
       }
+      if (is_scissor) {
+        renderer.GetClipStatistics().scissor_clip_count++;
+        return true;
+      }
     } break;
     case Contents::ClipCoverage::Type::kRestore: {
       if (clip_coverage_stack.back().clip_depth <=
@@ -801,12 +1051,23 @@ bool EntityPass::RenderElement(Entity& element_entity,
         // Make the coverage rectangle relative to the current pass.
         restore_coverage = restore_coverage->Shift(-global_pass_position);
       }
+      bool restores_stencil = false;
+      for (size_t i = restoration_index + 1; i < clip_coverage_stack.size();
+           i++) {
+        restores_stencil |= !clip_coverage_stack[i].is_scissor;
+      }
       clip_coverage_stack.resize(restoration_index + 1);
 
       if (!clip_coverage_stack.back().coverage.has_value()) {
         // Running this restore op won't make anything renderable, so skip it.
         return true;
       }
+      if (!restores_stencil) {
+        // Only scissor clips are being removed, which the scissor rect of the
+        // next element already accounts for.
+        renderer.GetClipStatistics().skipped_restore_count++;
+        return true;
+      }
 
       auto restore_contents =
           static_cast<ClipRestoreContents*>(element_entity.GetContents().get());
@@ -827,7 +1088,24 @@ bool EntityPass::RenderElement(Entity& element_entity,
   }
 #endif
 
-  element_entity.SetClipDepth(element_entity.GetClipDepth() - clip_depth_floor);
+  // Filters may sample textures of subpasses whose submission has been
+  // deferred from an intermediate pass that is submitted right away, so
+  // those need to be flushed first.
+  if (element_entity.GetContents()->AsFilter()) {
+    if (!pass_context.GetDeferredSubmissions()->EncodeAndSubmit(
+            *renderer.GetContext())) {
+      return false;
+    }
+  }
+
+  // Scissor clips are not counted by the stencil buffer.
+  size_t scissor_clip_count =
+      CountScissorClips(clip_coverage_stack, element_entity.GetClipDepth());
+  element_entity.SetClipDepth(element_entity.GetClipDepth() -
+                              clip_depth_floor - scissor_clip_count);
+  result.pass->SetClipScissor(GetClipScissor(
+      clip_coverage_stack, global_pass_position,
+      result.pass->GetRenderTargetSize()));
   clip_replay_->RecordEntity(element_entity, clip_coverage.type);
   if (!element_entity.Render(renderer, *result.pass)) {
     VALIDATION_LOG << "Failed to render entity.";
@@ -848,7 +1126,8 @@ bool EntityPass::OnRender(
     size_t clip_depth_floor,
     std::shared_ptr<Contents> backdrop_filter_contents,
     const std::optional<InlinePassContext::RenderPassResult>&
-        collapsed_parent_pass) const {
+        collapsed_parent_pass,
+    DeferredSubmissions* deferred_submissions) const {
   TRACE_EVENT0("impeller", "EntityPass::OnRender");
 
   const std::shared_ptr<Context>& context = renderer.GetContext();
@@ -859,6 +1138,7 @@ bool EntityPass::OnRender(
     VALIDATION_LOG << SPrintF("Pass context invalid (Depth=%d)", pass_depth);
     return false;
   }
+  pass_context.SetDeferredSubmissions(deferred_submissions);
   auto clear_color_size = pass_target.GetRenderTarget().GetRenderTargetSize();
 
   if (!collapsed_parent_pass && GetClearColor(clear_color_size).has_value()) {
@@ -891,7 +1171,22 @@ bool EntityPass::OnRender(
                                     // Backdrop filters act as a entity before
                                     // everything and disrupt the optimization.
                                     !backdrop_filter_proc_;
-  for (const auto& element : elements_) {
+
+  // Draws that share a pipeline and bindings are merged until an element is
+  // encountered that must be rendered in order.
+  EntityPassDrawList draw_list(renderer.IsDrawReorderingEnabled());
+  auto flush_draw_list = [&]() -> bool {
+    return draw_list.Flush([&](Entity& entity) {
+      return RenderElement(entity, clip_depth_floor, pass_context, pass_depth,
+                           renderer, clip_coverage_stack,
+                           global_pass_position);
+    });
+  };
+
+  const auto occluded_elements = FindOccludedElements(clip_depth_floor);
+  for (size_t element_index = 0; element_index < elements_.size();
+       element_index++) {
+    const auto& element = elements_[element_index];
     // Skip elements that are incorporated into the clear color.
     if (is_collapsing_clear_colors) {
       auto [entity_color, _] =
@@ -902,6 +1197,17 @@ bool EntityPass::OnRender(
       is_collapsing_clear_colors = false;
     }
 
+    // Skip entities that are completely overwritten by a later draw.
+    if (occluded_elements[element_index]) {
+      continue;
+    }
+
+    // Subpasses may end the current render pass, so draws batched so far must
+    // be recorded first.
+    if (!std::holds_alternative<Entity>(element) && !flush_draw_list()) {
+      return false;
+    }
+
     EntityResult result =
         GetEntityForElement(element,               // element
                             renderer,              // renderer
@@ -924,6 +1230,18 @@ bool EntityPass::OnRender(
         continue;
     };
 
+    //--------------------------------------------------------------------------
+    /// Batch compatible draws.
+    ///
+
+    if (EntityPassDrawList::CanAdd(result.entity)) {
+      draw_list.Add(std::move(result.entity));
+      continue;
+    }
+    if (!flush_draw_list()) {
+      return false;
+    }
+
     //--------------------------------------------------------------------------
     /// Setup advanced blends.
     ///
@@ -985,6 +1303,15 @@ bool EntityPass::OnRender(
     }
   }
 
+  if (!flush_draw_list()) {
+    return false;
+  }
+  auto& batching_statistics = renderer.GetDrawBatchingStatistics();
+  batching_statistics.merged_draw_count +=
+      draw_list.GetStatistics().merged_draw_count;
+  batching_statistics.reordered_draw_count +=
+      draw_list.GetStatistics().reordered_draw_count;
+
 #ifdef IMPELLER_DEBUG
   //--------------------------------------------------------------------------
   /// Draw debug checkerboard over offscreen textures.
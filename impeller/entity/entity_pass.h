@@ -46,6 +46,9 @@ class EntityPass {
   struct ClipCoverageLayer {
     std::optional<Rect> coverage;
     size_t clip_depth;
+    /// Whether the clip of this layer is applied as a scissor rect, and so
+    /// does not increment the stencil buffer.
+    bool is_scissor = false;
   };
 
   using ClipCoverageStack = std::vector<ClipCoverageLayer>;
@@ -279,6 +282,13 @@ class EntityPass {
   ///                                      creating a new `RenderPass`. This
   ///                                      "collapses" the Elements into the
   ///                                      parent pass.
+  /// @param[in]  deferred_submissions     Optional. If supplied, the render
+  ///                                      passes of this `EntityPass` are
+  ///                                      appended to this list instead of
+  ///                                      being submitted immediately. The
+  ///                                      owner of the list submits them in
+  ///                                      order, possibly after encoding them
+  ///                                      concurrently.
   ///
   bool OnRender(ContentContext& renderer,
                 Capture& capture,
@@ -291,7 +301,26 @@ class EntityPass {
                 size_t clip_depth_floor = 0,
                 std::shared_ptr<Contents> backdrop_filter_contents = nullptr,
                 const std::optional<InlinePassContext::RenderPassResult>&
-                    collapsed_parent_pass = std::nullopt) const;
+                    collapsed_parent_pass = std::nullopt,
+                DeferredSubmissions* deferred_submissions = nullptr) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief  Whether the render passes of this subpass (and its children) can
+  ///         be submitted any time before the parent pass that samples from
+  ///         them.
+  ///
+  ///         This is true when nothing in the subtree reads back from a pass
+  ///         texture or requires mipmaps to be generated. Filters that sample
+  ///         deferred passes flush them before rendering.
+  ///
+  bool CanDeferSubmission(ContentContext& renderer) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief  Whether every element of this subpass anti-aliases its own edges,
+  ///         in which case the pass texture does not need multisampling when
+  ///         analytic anti-aliasing is enabled.
+  ///
+  bool IsAnalyticallyAntialiased() const;
 
   /// The list of renderable items in the scene. Each of these items is
   /// evaluated and recorded to an `EntityPassTarget` by the `OnRender` method.
@@ -321,6 +350,23 @@ class EntityPass {
 
   uint32_t GetTotalPassReads(ContentContext& renderer) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief  Finds the entities of this pass that are completely overwritten
+  ///         by a later draw, so that they can be skipped before their
+  ///         contents generate any geometry.
+  ///
+  ///         An entity is overwritten by a later unclipped solid rectangle with
+  ///         a source blend that contains its coverage, unless an element in
+  ///         between may read from the pass texture. Clips are never skipped.
+  ///
+  ///         Nothing is occluded unless `IMPELLER_CONTENT_CULLING` is defined.
+  ///
+  /// @param[in]  clip_depth_floor  The clip depth of unclipped entities.
+  ///
+  /// @return     Whether each element is occluded, indexed like `elements_`.
+  ///
+  std::vector<bool> FindOccludedElements(size_t clip_depth_floor) const;
+
   BackdropFilterProc backdrop_filter_proc_ = nullptr;
 
   std::shared_ptr<EntityPassDelegate> delegate_ =
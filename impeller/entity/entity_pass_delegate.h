@@ -31,10 +31,18 @@ class EntityPassDelegate {
   ///         If true, this method may modify the entities for the current pass.
   virtual bool CanCollapseIntoParentPass(EntityPass* entity_pass) = 0;
 
+  /// @brief  Creates the contents that draw the subpass rendered into the
+  ///         top left `size` pixels of `target`, which may be larger.
   virtual std::shared_ptr<Contents> CreateContentsForSubpassTarget(
       std::shared_ptr<Texture> target,
+      ISize size,
       const Matrix& effect_transform) = 0;
 
+  /// @brief  Whether the contents created for the subpass target draw the
+  ///         texture without filtering it. Only then may the subpass be
+  ///         rendered into a texture larger than its coverage.
+  virtual bool DrawsSubpassTargetDirectly() const;
+
   virtual std::shared_ptr<FilterContents> WithImageFilter(
       const FilterInput::Variant& input,
       const Matrix& effect_transform) const = 0;
@@ -0,0 +1,121 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/entity_pass_draw_list.h"
+
+#include <utility>
+
+#include "flutter/fml/logging.h"
+
+namespace impeller {
+
+EntityPassDrawList::EntityPassDrawList(bool allow_reordering)
+    : allow_reordering_(allow_reordering) {}
+
+EntityPassDrawList::~EntityPassDrawList() = default;
+
+bool EntityPassDrawList::CanAdd(const Entity& entity) {
+  if (!entity.GetContents() ||
+      entity.GetBlendMode() > Entity::kLastPipelineBlendMode) {
+    return false;
+  }
+  auto coverage = entity.GetCoverage();
+  if (!coverage.has_value()) {
+    return false;
+  }
+  return entity.GetClipCoverage(coverage).type ==
+         Contents::ClipCoverage::Type::kNoChange;
+}
+
+bool EntityPassDrawList::Draw::Overlaps(const Rect& coverage) const {
+  if (!bounds.IntersectsWithRect(coverage)) {
+    return false;
+  }
+  for (const auto& draw_coverage : coverages) {
+    if (draw_coverage.IntersectsWithRect(coverage)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool EntityPassDrawList::Merge(const Entity& entity, const Rect& coverage) {
+  const size_t min_index =
+      allow_reordering_ && draws_.size() > kMaxReorderDistance
+          ? draws_.size() - kMaxReorderDistance
+          : 0u;
+  for (size_t index = draws_.size(); index > min_index; index--) {
+    auto& draw = draws_[index - 1];
+    if (draw.batch && draw.batch->Append(entity)) {
+      draw.bounds = draw.bounds.Union(coverage);
+      draw.coverages.push_back(coverage);
+      statistics_.merged_draw_count++;
+      if (index != draws_.size()) {
+        statistics_.reordered_draw_count++;
+      }
+      return true;
+    }
+    if (!allow_reordering_ || draw.Overlaps(coverage)) {
+      return false;
+    }
+  }
+  return false;
+}
+
+void EntityPassDrawList::Add(Entity entity) {
+  FML_DCHECK(CanAdd(entity));
+  auto coverage = entity.GetCoverage().value_or(Rect::MakeMaximum());
+  if (Merge(entity, coverage)) {
+    return;
+  }
+  Draw draw;
+  draw.batch = RectBatchContents::Make(entity);
+  if (!draw.batch) {
+    draw.entity.emplace(std::move(entity));
+  }
+  draw.bounds = coverage;
+  draw.coverages.push_back(coverage);
+  draws_.push_back(std::move(draw));
+}
+
+bool EntityPassDrawList::IsEmpty() const {
+  return draws_.empty();
+}
+
+bool EntityPassDrawList::Flush(const std::function<bool(Entity&)>& callback) {
+  auto draws = std::move(draws_);
+  draws_.clear();
+  for (auto& draw : draws) {
+    if (draw.entity.has_value()) {
+      if (!callback(draw.entity.value())) {
+        return false;
+      }
+      continue;
+    }
+    if (draw.batch->GetRectCount() == 1u) {
+      auto entity = draw.batch->GetFirstEntity().Clone();
+      if (!callback(entity)) {
+        return false;
+      }
+      continue;
+    }
+    const auto& first_entity = draw.batch->GetFirstEntity();
+    Entity entity;
+    entity.SetContents(draw.batch);
+    entity.SetBlendMode(first_entity.GetBlendMode());
+    entity.SetClipDepth(first_entity.GetClipDepth());
+    entity.SetCapture(first_entity.GetCapture());
+    if (!callback(entity)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+const EntityPassDrawList::Statistics& EntityPassDrawList::GetStatistics()
+    const {
+  return statistics_;
+}
+
+}  // namespace impeller
@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_ENTITY_PASS_DRAW_LIST_H_
+#define FLUTTER_IMPELLER_ENTITY_ENTITY_PASS_DRAW_LIST_H_
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "impeller/entity/contents/rect_batch_contents.h"
+#include "impeller/entity/entity.h"
+#include "impeller/geometry/rect.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Collects the draws of an entity pass between two points that
+///             must be rendered in order, such as clips and subpasses, and
+///             merges draws that can be batched with `RectBatchContents`.
+///
+///             By default, an entity can only be merged into the draw right
+///             before it. With reordering, an entity is merged into the most
+///             recent compatible batch as long as its coverage does not
+///             overlap any draw recorded after that batch. Draws that don't
+///             overlap can be rendered in any order, so this clusters draws
+///             sharing a pipeline and bindings without affecting the output.
+///
+class EntityPassDrawList {
+ public:
+  //----------------------------------------------------------------------------
+  /// The number of draws, starting from the most recent one, that are tested
+  /// for overlap before giving up on finding a compatible batch. This bounds
+  /// the cost of adding draws to long lists.
+  ///
+  static constexpr size_t kMaxReorderDistance = 64u;
+
+  struct Statistics {
+    /// The number of draws merged into another one.
+    size_t merged_draw_count = 0u;
+    /// The number of draws merged into a batch that wasn't the last draw. Each
+    /// of these saved at least one pipeline or binding change.
+    size_t reordered_draw_count = 0u;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  allow_reordering  Whether entities may be merged into draws
+  ///                               recorded before the last one.
+  ///
+  explicit EntityPassDrawList(bool allow_reordering);
+
+  ~EntityPassDrawList();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether an entity can be added to the list. Entities that
+  ///             affect the clip, read from the destination for advanced
+  ///             blends or have no coverage must be rendered in order after
+  ///             the list is flushed.
+  ///
+  static bool CanAdd(const Entity& entity);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds an entity drawn after all entities already in the list.
+  ///
+  void Add(Entity entity);
+
+  bool IsEmpty() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Invokes the callback with each draw, in the order they must be
+  ///             rendered, and clears the list.
+  ///
+  /// @return     If all invocations of the callback returned true.
+  ///
+  bool Flush(const std::function<bool(Entity&)>& callback);
+
+  const Statistics& GetStatistics() const;
+
+ private:
+  struct Draw {
+    std::shared_ptr<RectBatchContents> batch;
+    std::optional<Entity> entity;
+    // The union of `coverages`, used to quickly reject overlap tests.
+    Rect bounds;
+    std::vector<Rect> coverages;
+
+    bool Overlaps(const Rect& coverage) const;
+  };
+
+  const bool allow_reordering_;
+  std::vector<Draw> draws_;
+  Statistics statistics_;
+
+  bool Merge(const Entity& entity, const Rect& coverage);
+
+  EntityPassDrawList(const EntityPassDrawList&) = delete;
+
+  EntityPassDrawList& operator=(const EntityPassDrawList&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_ENTITY_PASS_DRAW_LIST_H_
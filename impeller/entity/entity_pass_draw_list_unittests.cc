@@ -0,0 +1,99 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "impeller/entity/contents/clip_contents.h"
+#include "impeller/entity/contents/solid_color_contents.h"
+#include "impeller/entity/entity.h"
+#include "impeller/entity/entity_pass_draw_list.h"
+#include "impeller/entity/geometry/geometry.h"
+#include "impeller/geometry/path_builder.h"
+
+namespace impeller {
+namespace testing {
+
+static Entity MakeRectEntity(Rect rect) {
+  auto contents = std::make_shared<SolidColorContents>();
+  contents->SetGeometry(Geometry::MakeRect(rect));
+  contents->SetColor(Color::Red());
+  Entity entity;
+  entity.SetContents(std::move(contents));
+  return entity;
+}
+
+static Entity MakeOvalEntity(Rect rect) {
+  Entity entity;
+  entity.SetContents(SolidColorContents::Make(
+      PathBuilder{}.AddOval(rect).TakePath(), Color::Blue()));
+  return entity;
+}
+
+static std::vector<const Contents*> FlushContents(
+    EntityPassDrawList& draw_list) {
+  std::vector<const Contents*> contents;
+  draw_list.Flush([&contents](Entity& entity) {
+    contents.push_back(entity.GetContents().get());
+    return true;
+  });
+  return contents;
+}
+
+TEST(EntityPassDrawListTest, MergesConsecutiveRects) {
+  EntityPassDrawList draw_list(/*allow_reordering=*/false);
+  draw_list.Add(MakeRectEntity(Rect::MakeXYWH(0, 0, 10, 10)));
+  draw_list.Add(MakeRectEntity(Rect::MakeXYWH(5, 5, 10, 10)));
+  draw_list.Add(MakeOvalEntity(Rect::MakeXYWH(100, 100, 10, 10)));
+  draw_list.Add(MakeRectEntity(Rect::MakeXYWH(20, 20, 10, 10)));
+
+  EXPECT_EQ(draw_list.GetStatistics().merged_draw_count, 1u);
+  EXPECT_EQ(draw_list.GetStatistics().reordered_draw_count, 0u);
+  EXPECT_EQ(FlushContents(draw_list).size(), 3u);
+  EXPECT_TRUE(draw_list.IsEmpty());
+}
+
+TEST(EntityPassDrawListTest, ReordersDrawsThatDontOverlap) {
+  EntityPassDrawList draw_list(/*allow_reordering=*/true);
+  draw_list.Add(MakeRectEntity(Rect::MakeXYWH(0, 0, 10, 10)));
+  auto oval = MakeOvalEntity(Rect::MakeXYWH(100, 100, 10, 10));
+  const auto* oval_contents = oval.GetContents().get();
+  draw_list.Add(std::move(oval));
+  draw_list.Add(MakeRectEntity(Rect::MakeXYWH(20, 20, 10, 10)));
+
+  EXPECT_EQ(draw_list.GetStatistics().merged_draw_count, 1u);
+  EXPECT_EQ(draw_list.GetStatistics().reordered_draw_count, 1u);
+  auto contents = FlushContents(draw_list);
+  ASSERT_EQ(contents.size(), 2u);
+  EXPECT_EQ(contents[1], oval_contents);
+}
+
+TEST(EntityPassDrawListTest, DoesNotReorderOverlappingDraws) {
+  EntityPassDrawList draw_list(/*allow_reordering=*/true);
+  draw_list.Add(MakeRectEntity(Rect::MakeXYWH(0, 0, 10, 10)));
+  draw_list.Add(MakeOvalEntity(Rect::MakeXYWH(15, 15, 10, 10)));
+  draw_list.Add(MakeRectEntity(Rect::MakeXYWH(20, 20, 10, 10)));
+
+  EXPECT_EQ(draw_list.GetStatistics().merged_draw_count, 0u);
+  EXPECT_EQ(FlushContents(draw_list).size(), 3u);
+}
+
+TEST(EntityPassDrawListTest, ClipsCantBeAdded) {
+  auto clip = std::make_shared<ClipContents>();
+  clip->SetGeometry(Geometry::MakeRect(Rect::MakeXYWH(0, 0, 10, 10)));
+  Entity clip_entity;
+  clip_entity.SetContents(clip);
+  EXPECT_FALSE(EntityPassDrawList::CanAdd(clip_entity));
+
+  Entity restore_entity;
+  restore_entity.SetContents(std::make_shared<ClipRestoreContents>());
+  EXPECT_FALSE(EntityPassDrawList::CanAdd(restore_entity));
+
+  EXPECT_TRUE(
+      EntityPassDrawList::CanAdd(MakeRectEntity(Rect::MakeXYWH(0, 0, 1, 1))));
+}
+
+}  // namespace testing
+}  // namespace impeller
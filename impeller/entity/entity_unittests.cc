@@ -2,9 +2,11 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <chrono>
 #include <cstring>
 #include <memory>
 #include <optional>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -22,8 +24,10 @@
 #include "impeller/entity/contents/filters/filter_contents.h"
 #include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
+#include "impeller/entity/contents/gradient_generator.h"
 #include "impeller/entity/contents/linear_gradient_contents.h"
 #include "impeller/entity/contents/radial_gradient_contents.h"
+#include "impeller/entity/contents/rect_batch_contents.h"
 #include "impeller/entity/contents/runtime_effect_contents.h"
 #include "impeller/entity/contents/solid_color_contents.h"
 #include "impeller/entity/contents/solid_rrect_blur_contents.h"
@@ -88,6 +92,7 @@ class TestPassDelegate final : public EntityPassDelegate {
   // |EntityPassDelgate|
   std::shared_ptr<Contents> CreateContentsForSubpassTarget(
       std::shared_ptr<Texture> target,
+      ISize size,
       const Matrix& transform) override {
     return nullptr;
   }
@@ -195,6 +200,39 @@ TEST_P(EntityTest, EntityPassCoverageRespectsCoverageLimit) {
   }
 }
 
+TEST_P(EntityTest, EntityPassCoverageRespectsClipsOfThePass) {
+  EntityPass pass;
+  auto draw_rect = [&pass](Rect rect, uint32_t clip_depth) {
+    Entity entity;
+    entity.SetClipDepth(clip_depth);
+    entity.SetContents(SolidColorContents::Make(
+        PathBuilder{}.AddRect(rect).TakePath(), Color::Red()));
+    pass.AddEntity(std::move(entity));
+  };
+
+  Entity clip;
+  auto clip_contents = std::make_shared<ClipContents>();
+  clip_contents->SetClipOperation(Entity::ClipOperation::kIntersect);
+  clip_contents->SetGeometry(
+      Geometry::MakeRect(Rect::MakeLTRB(10, 10, 20, 20)));
+  clip.SetContents(std::move(clip_contents));
+  pass.AddEntity(std::move(clip));
+  draw_rect(Rect::MakeLTRB(0, 0, 500, 500), 1u);
+  Entity restore;
+  restore.SetContents(std::make_shared<ClipRestoreContents>());
+  pass.AddEntity(std::move(restore));
+  draw_rect(Rect::MakeLTRB(100, 100, 110, 110), 0u);
+
+  // Without a coverage limit, clips are not taken into account.
+  auto pass_coverage = pass.GetElementsCoverage(std::nullopt);
+  ASSERT_TRUE(pass_coverage.has_value());
+  ASSERT_RECT_NEAR(pass_coverage.value(), Rect::MakeLTRB(0, 0, 500, 500));
+
+  pass_coverage = pass.GetElementsCoverage(Rect::MakeLTRB(0, 0, 1000, 1000));
+  ASSERT_TRUE(pass_coverage.has_value());
+  ASSERT_RECT_NEAR(pass_coverage.value(), Rect::MakeLTRB(10, 10, 110, 110));
+}
+
 TEST_P(EntityTest, FilterCoverageRespectsCropRect) {
   auto image = CreateTextureForFixture("boston.jpg");
   auto filter = ColorFilterContents::MakeBlend(BlendMode::kSoftLight,
@@ -1727,6 +1765,36 @@ TEST_P(EntityTest, ClipContentsGetClipCoverageIsCorrect) {
   }
 }
 
+TEST_P(EntityTest, ClipContentsDetectPixelAlignedRects) {
+  auto make_clip = [](Rect rect, Entity::ClipOperation op) {
+    auto clip = std::make_shared<ClipContents>();
+    clip->SetClipOperation(op);
+    clip->SetGeometry(Geometry::MakeRect(rect));
+    return clip;
+  };
+  Entity entity;
+  entity.SetTransform(Matrix::MakeTranslation({10, 20}) *
+                      Matrix::MakeScale({2, 2, 1}));
+
+  EXPECT_TRUE(make_clip(Rect::MakeLTRB(0, 0, 50, 50),
+                        Entity::ClipOperation::kIntersect)
+                  ->IsPixelAlignedRectIntersect(entity));
+  EXPECT_TRUE(make_clip(Rect::MakeLTRB(0.5, 0, 50, 50),
+                        Entity::ClipOperation::kIntersect)
+                  ->IsPixelAlignedRectIntersect(entity));
+  EXPECT_FALSE(make_clip(Rect::MakeLTRB(0.25, 0, 50, 50),
+                         Entity::ClipOperation::kIntersect)
+                   ->IsPixelAlignedRectIntersect(entity));
+  EXPECT_FALSE(make_clip(Rect::MakeLTRB(0, 0, 50, 50),
+                         Entity::ClipOperation::kDifference)
+                   ->IsPixelAlignedRectIntersect(entity));
+
+  entity.SetTransform(Matrix::MakeRotationZ(Degrees(45)));
+  EXPECT_FALSE(make_clip(Rect::MakeLTRB(0, 0, 50, 50),
+                         Entity::ClipOperation::kIntersect)
+                   ->IsPixelAlignedRectIntersect(entity));
+}
+
 TEST_P(EntityTest, RRectShadowTest) {
   auto callback = [&](ContentContext& context, RenderPass& pass) {
     static Color color = Color::Red();
@@ -1806,6 +1874,53 @@ TEST_P(EntityTest, ColorMatrixFilterCoverageIsCorrect) {
   ASSERT_RECT_NEAR(actual.value(), expected);
 }
 
+TEST_P(EntityTest, ColorMatrixFiltersThatPreserveRangeAreFused) {
+  auto fill = std::make_shared<SolidColorContents>();
+  fill->SetGeometry(Geometry::MakeFillPath(
+      PathBuilder{}.AddRect(Rect::MakeXYWH(0, 0, 300, 400)).TakePath()));
+  fill->SetColor(Color::Coral());
+  auto fill_input = FilterInput::Make(fill);
+
+  // Grayscale, which keeps colors within range.
+  ColorMatrix grayscale = {
+      0.2126, 0.7152, 0.0722, 0, 0,  //
+      0.2126, 0.7152, 0.0722, 0, 0,  //
+      0.2126, 0.7152, 0.0722, 0, 0,  //
+      0, 0, 0, 1, 0,  //
+  };
+  ColorMatrix half_opacity = {
+      1, 0, 0, 0, 0,    //
+      0, 1, 0, 0, 0,    //
+      0, 0, 1, 0, 0,    //
+      0, 0, 0, 0.5, 0,  //
+  };
+  auto inner = ColorFilterContents::MakeColorMatrix(fill_input, grayscale);
+  auto fused = ColorFilterContents::MakeColorMatrix(FilterInput::Make(inner),
+                                                    half_opacity);
+
+  ASSERT_NE(fused->AsColorMatrixFilter(), nullptr);
+  ASSERT_EQ(fused->GetInputs().size(), 1u);
+  EXPECT_EQ(fused->GetInputs()[0], fill_input);
+  const ColorMatrix& matrix = fused->AsColorMatrixFilter()->GetMatrix();
+  for (int i = 0; i < 15; i++) {
+    EXPECT_FLOAT_EQ(matrix.array[i], grayscale.array[i]);
+  }
+  EXPECT_FLOAT_EQ(matrix.array[18], 0.5f);
+
+  // Colors may leave the [0, 1] range, so the inner output must be clamped.
+  ColorMatrix brighten = {
+      2, 0, 0, 0, 0,  //
+      0, 2, 0, 0, 0,  //
+      0, 0, 2, 0, 0,  //
+      0, 0, 0, 1, 0,  //
+  };
+  auto clamped = ColorFilterContents::MakeColorMatrix(fill_input, brighten);
+  auto not_fused = ColorFilterContents::MakeColorMatrix(
+      FilterInput::Make(clamped), half_opacity);
+  ASSERT_EQ(not_fused->GetInputs().size(), 1u);
+  EXPECT_NE(not_fused->GetInputs()[0], fill_input);
+}
+
 TEST_P(EntityTest, ColorMatrixFilterEditable) {
   auto bay_bridge = CreateTextureForFixture("bay_bridge.jpg");
   ASSERT_TRUE(bay_bridge);
@@ -2247,6 +2362,120 @@ TEST_P(EntityTest, RuntimeEffectSetsRightSizeWhenUniformIsStruct) {
             16u);
 }
 
+TEST_P(EntityTest, ContentsInheritTheDrawCategoryOfTheirRenderer) {
+  auto contents = std::make_shared<SolidColorContents>();
+  contents->SetGeometry(Geometry::MakeRect(Rect::MakeLTRB(0, 0, 100, 100)));
+  contents->SetColor(Color::Red());
+  EXPECT_EQ(contents->GetDrawCategory(), DrawCategory::kOther);
+
+  Entity entity;
+  entity.SetContents(contents);
+
+  auto context = GetContentContext();
+  RenderTarget target;
+  testing::MockRenderPass pass(GetContext(), target);
+  // As when rendering the input of a blur filter.
+  context->SetDrawCategory(DrawCategory::kBlur);
+  ASSERT_TRUE(entity.Render(*context, pass));
+  context->SetDrawCategory(DrawCategory::kOther);
+
+  EXPECT_EQ(pass.GetDrawCategory(), DrawCategory::kOther);
+  ASSERT_EQ(pass.GetCommands().size(), 1u);
+#ifdef IMPELLER_DEBUG
+  EXPECT_EQ(pass.GetCommands()[0].category, DrawCategory::kBlur);
+#endif  // IMPELLER_DEBUG
+}
+
+TEST_P(EntityTest, RuntimeEffectSkipsDrawUntilAsyncPipelineIsReady) {
+  auto runtime_stages =
+      OpenAssetAsRuntimeStage("runtime_stage_example.frag.iplr");
+  auto runtime_stage =
+      runtime_stages[PlaygroundBackendToRuntimeStageBackend(GetBackend())];
+  ASSERT_TRUE(runtime_stage);
+
+  auto contents = std::make_shared<RuntimeEffectContents>();
+  contents->SetGeometry(Geometry::MakeCover());
+  contents->SetRuntimeStage(runtime_stage);
+  auto uniform_data = std::make_shared<std::vector<uint8_t>>(16u, 0u);
+  contents->SetUniformData(uniform_data);
+
+  Entity entity;
+  entity.SetContents(contents);
+
+  auto context = GetContentContext();
+  context->SetAsyncRuntimeEffectPipelines(true);
+  RenderTarget target;
+  testing::MockRenderPass pass(GetContext(), target);
+  for (size_t i = 0u; i < 1000u && pass.GetCommands().empty(); i++) {
+    ASSERT_TRUE(contents->Render(*context, entity, pass));
+    if (pass.GetCommands().empty()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+  context->SetAsyncRuntimeEffectPipelines(false);
+
+  // The effect is drawn once its function and pipeline are ready.
+  ASSERT_EQ(pass.GetCommands().size(), 1u);
+  EXPECT_TRUE(pass.GetCommands()[0].pipeline);
+}
+
+TEST_P(EntityTest, SolidColorContentsUseAnalyticAntialiasingWhenEnabled) {
+  auto contents = std::make_shared<SolidColorContents>();
+  contents->SetGeometry(
+      Geometry::MakeRoundRect(Rect::MakeLTRB(10, 10, 90, 90), Size(10, 10)));
+  contents->SetColor(Color::Red());
+
+  Entity entity;
+  entity.SetContents(contents);
+  EXPECT_TRUE(contents->IsAnalyticallyAntialiased(entity));
+  entity.SetBlendMode(BlendMode::kSource);
+  EXPECT_FALSE(contents->IsAnalyticallyAntialiased(entity));
+  entity.SetBlendMode(BlendMode::kSourceOver);
+
+  auto context = GetContentContext();
+  context->SetAnalyticAntialiasing(true);
+  RenderTarget target;
+  testing::MockRenderPass pass(GetContext(), target);
+  ASSERT_TRUE(contents->Render(*context, entity, pass));
+  context->SetAnalyticAntialiasing(false);
+
+  // A single quad is drawn, without tessellating the rounded corners.
+  ASSERT_EQ(pass.GetCommands().size(), 1u);
+  EXPECT_EQ(pass.GetCommands()[0].vertex_buffer.vertex_count, 4u);
+}
+
+TEST_P(EntityTest, SolidColorContentsFillComplexPathsWithStencilThenCover) {
+  // A non-convex contour of 5 points is fanned into 3 triangles.
+  auto path = PathBuilder{}
+                  .MoveTo({0, 0})
+                  .LineTo({100, 0})
+                  .LineTo({50, 50})
+                  .LineTo({100, 100})
+                  .LineTo({0, 100})
+                  .Close()
+                  .TakePath(FillType::kOdd);
+  auto contents = std::make_shared<SolidColorContents>();
+  contents->SetGeometry(Geometry::MakeFillPath(std::move(path)));
+  contents->SetColor(Color::Red());
+
+  Entity entity;
+  entity.SetContents(contents);
+
+  auto context = GetContentContext();
+  context->SetStencilThenCoverFills(true);
+  auto target = RenderTarget::CreateOffscreen(
+      *GetContext(), *context->GetRenderTargetCache(), ISize(100, 100),
+      /*mip_count=*/1);
+  testing::MockRenderPass pass(GetContext(), target);
+  ASSERT_TRUE(contents->Render(*context, entity, pass));
+  context->SetStencilThenCoverFills(false);
+
+  // Mark, clear count, fans, cover and restore.
+  ASSERT_EQ(pass.GetCommands().size(), 5u);
+  EXPECT_EQ(pass.GetCommands()[2].vertex_buffer.vertex_count, 9u);
+  EXPECT_EQ(pass.GetCommands()[3].vertex_buffer.vertex_count, 4u);
+}
+
 TEST_P(EntityTest, InheritOpacityTest) {
   Entity entity;
 
@@ -2462,6 +2691,25 @@ TEST_P(EntityTest, SweepGradientContentsIsOpaque) {
   ASSERT_FALSE(contents.IsOpaque());
 }
 
+TEST_P(EntityTest, GradientTextureCacheReusesRampsUntilUnused) {
+  GradientTextureCache cache;
+  std::vector<Color> colors = {Color::Red(), Color::Blue()};
+  std::vector<Scalar> stops = {0.0, 1.0};
+
+  cache.Start();
+  auto texture = cache.GetTexture(colors, stops, GetContext());
+  ASSERT_NE(texture, nullptr);
+  EXPECT_EQ(cache.GetTexture(colors, stops, GetContext()), texture);
+  EXPECT_NE(cache.GetTexture(colors, {0.0, 0.5}, GetContext()), texture);
+  cache.End();
+  EXPECT_EQ(cache.CachedTextureCount(), 2u);
+
+  cache.Start();
+  EXPECT_EQ(cache.GetTexture(colors, stops, GetContext()), texture);
+  cache.End();
+  EXPECT_EQ(cache.CachedTextureCount(), 1u);
+}
+
 TEST_P(EntityTest, TiledTextureContentsIsOpaque) {
   auto bay_bridge = CreateTextureForFixture("bay_bridge.jpg");
   TiledTextureContents contents;
@@ -2701,6 +2949,33 @@ TEST_P(EntityTest, ContentContextOptionsHasReasonableHashFunctions) {
   EXPECT_NE(hash_c, hash_d);
 }
 
+TEST_P(EntityTest, ContentContextPrewarmsRecordedPipelineVariants) {
+  auto content_context =
+      ContentContext(GetContext(), TypographerContextSkia::Make());
+  ContentContextOptions options;
+  options.blend_mode = BlendMode::kSource;
+  options.color_attachment_pixel_format = PixelFormat::kR8G8B8A8UNormInt;
+  ASSERT_NE(content_context.GetSolidFillPipeline(options), nullptr);
+
+  auto variants = content_context.GetPipelineVariants();
+  EXPECT_NE(variants.find("\nsolid_fill "), std::string::npos);
+
+  auto prewarmed_context =
+      ContentContext(GetContext(), TypographerContextSkia::Make());
+  EXPECT_EQ(prewarmed_context.PrewarmPipelineVariants(variants), 1u);
+  EXPECT_EQ(prewarmed_context.PrewarmPipelineVariants(variants), 0u);
+  EXPECT_EQ(prewarmed_context.GetPipelineVariants(), variants);
+  EXPECT_NE(prewarmed_context.GetSolidFillPipeline(options), nullptr);
+
+  // Malformed lines and unknown pipelines are skipped.
+  auto header = std::string(ContentContext::kPipelineVariantsHeader);
+  EXPECT_EQ(prewarmed_context.PrewarmPipelineVariants(
+                header + "\nsolid_fill 3 0 0 0 0 0 1 0 0 0\nunknown 1 0 0 0 0 "
+                         "0 1 0 0 0\nsolid_fill 1\n"),
+            0u);
+  EXPECT_EQ(prewarmed_context.PrewarmPipelineVariants("solid_fill"), 0u);
+}
+
 #ifdef FML_OS_LINUX
 TEST_P(EntityTest, FramebufferFetchVulkanBindingOffsetIsTheSame) {
   // Using framebuffer fetch on Vulkan requires that we maintain a subpass input
@@ -2725,6 +3000,171 @@ TEST_P(EntityTest, FramebufferFetchVulkanBindingOffsetIsTheSame) {
 }
 #endif
 
+TEST_P(EntityTest, DeferredSubmissionsAreSubmittedInOrder) {
+  std::vector<int> submission_order;
+  DeferredSubmissions deferred_submissions;
+  RenderTarget target;
+  for (int i = 0; i < 3; i++) {
+    auto command_buffer =
+        std::make_shared<testing::MockCommandBuffer>(GetContext());
+    EXPECT_CALL(*command_buffer, IsValid())
+        .WillRepeatedly(::testing::Return(true));
+    EXPECT_CALL(*command_buffer, OnSubmitCommands(::testing::_))
+        .WillOnce([&submission_order, i](auto) {
+          submission_order.push_back(i);
+          return true;
+        });
+    auto render_pass =
+        std::make_shared<testing::MockRenderPass>(GetContext(), target);
+    EXPECT_CALL(*render_pass, IsValid())
+        .WillRepeatedly(::testing::Return(true));
+    EXPECT_CALL(*render_pass, OnEncodeCommands(::testing::_))
+        .WillOnce(::testing::Return(true));
+    deferred_submissions.Add(command_buffer, render_pass);
+  }
+  ASSERT_EQ(deferred_submissions.GetCount(), 3u);
+
+  EXPECT_TRUE(deferred_submissions.EncodeAndSubmit(*GetContext()));
+  EXPECT_TRUE(deferred_submissions.IsEmpty());
+  EXPECT_EQ(submission_order, std::vector<int>({0, 1, 2}));
+}
+
+static Entity MakeSolidRectEntity(Rect rect, Color color) {
+  auto contents = std::make_shared<SolidColorContents>();
+  contents->SetGeometry(Geometry::MakeRect(rect));
+  contents->SetColor(color);
+  Entity entity;
+  entity.SetContents(std::move(contents));
+  return entity;
+}
+
+TEST_P(EntityTest, RectBatchContentsAppendsCompatibleSolidRects) {
+  auto batch = RectBatchContents::Make(
+      MakeSolidRectEntity(Rect::MakeXYWH(0, 0, 10, 10), Color::Red()));
+  ASSERT_NE(batch, nullptr);
+
+  auto translated =
+      MakeSolidRectEntity(Rect::MakeXYWH(0, 0, 10, 10), Color::Blue());
+  translated.SetTransform(Matrix::MakeTranslation({20, 30}));
+  EXPECT_TRUE(batch->Append(translated));
+
+  auto different_blend =
+      MakeSolidRectEntity(Rect::MakeXYWH(0, 0, 10, 10), Color::Red());
+  different_blend.SetBlendMode(BlendMode::kSource);
+  EXPECT_FALSE(batch->Append(different_blend));
+
+  auto different_clip =
+      MakeSolidRectEntity(Rect::MakeXYWH(0, 0, 10, 10), Color::Red());
+  different_clip.SetClipDepth(1u);
+  EXPECT_FALSE(batch->Append(different_clip));
+
+  auto perspective =
+      MakeSolidRectEntity(Rect::MakeXYWH(0, 0, 10, 10), Color::Red());
+  perspective.SetTransform(Matrix::MakePerspective(Radians(1), 1, 1, 100));
+  EXPECT_FALSE(batch->Append(perspective));
+
+  Entity oval;
+  oval.SetContents(SolidColorContents::Make(
+      PathBuilder{}.AddOval(Rect::MakeXYWH(0, 0, 10, 10)).TakePath(),
+      Color::Red()));
+  EXPECT_FALSE(batch->Append(oval));
+  EXPECT_EQ(RectBatchContents::Make(oval), nullptr);
+
+  EXPECT_EQ(batch->GetRectCount(), 2u);
+  EXPECT_RECT_NEAR(batch->GetCoverage(Entity{}).value(),
+                   Rect::MakeLTRB(0, 0, 30, 40));
+}
+
+TEST_P(EntityTest, RectBatchContentsRequiresSameTextureBindings) {
+  auto bridge = CreateTextureForFixture("bay_bridge.jpg");
+  auto boston = CreateTextureForFixture("boston.jpg");
+  auto make_entity = [](const std::shared_ptr<Texture>& texture,
+                        Scalar opacity) {
+    auto contents = TextureContents::MakeRect(Rect::MakeXYWH(0, 0, 50, 50));
+    contents->SetTexture(texture);
+    contents->SetSourceRect(Rect::MakeSize(texture->GetSize()));
+    contents->SetOpacity(opacity);
+    Entity entity;
+    entity.SetContents(std::move(contents));
+    return entity;
+  };
+
+  auto batch = RectBatchContents::Make(make_entity(bridge, 1.0));
+  ASSERT_NE(batch, nullptr);
+  EXPECT_TRUE(batch->Append(make_entity(bridge, 1.0)));
+  EXPECT_FALSE(batch->Append(make_entity(boston, 1.0)));
+  EXPECT_FALSE(batch->Append(make_entity(bridge, 0.5)));
+  EXPECT_FALSE(batch->Append(
+      MakeSolidRectEntity(Rect::MakeXYWH(0, 0, 10, 10), Color::Red())));
+  EXPECT_EQ(batch->GetRectCount(), 2u);
+}
+
+TEST_P(EntityTest, EntityPassBatchesConsecutiveRects) {
+  EntityPass pass;
+  for (int i = 0; i < 10; i++) {
+    for (int j = 0; j < 10; j++) {
+      // Overlapping rects must still be drawn in order.
+      pass.AddEntity(MakeSolidRectEntity(
+          Rect::MakeXYWH(i * 50, j * 50, 70, 70),
+          Color::Lerp(Color::Red(), Color::Blue(), i / 10.0f)
+              .WithAlpha(0.5)));
+    }
+  }
+  auto bridge = CreateTextureForFixture("bay_bridge.jpg");
+  for (int i = 0; i < 4; i++) {
+    auto contents =
+        TextureContents::MakeRect(Rect::MakeXYWH(550, i * 120, 100, 100));
+    contents->SetTexture(bridge);
+    contents->SetSourceRect(Rect::MakeXYWH(i * 100, i * 100, 400, 400));
+    Entity entity;
+    entity.SetContents(std::move(contents));
+    pass.AddEntity(std::move(entity));
+  }
+  ASSERT_TRUE(OpenPlaygroundHere(pass));
+}
+
+TEST_P(EntityTest, RepeatedRoundRectsShareOneVertexBufferPerFrame) {
+  auto content_context = GetContentContext();
+  auto buffer = content_context->GetContext()->CreateCommandBuffer();
+  auto render_target = RenderTarget::CreateOffscreenMSAA(
+      *content_context->GetContext(),
+      *content_context->GetRenderTargetCache(), {100, 100},
+      /*mip_count=*/1);
+  auto render_pass = buffer->CreateRenderPass(render_target);
+
+  auto first = Geometry::MakeRoundRect(Rect::MakeXYWH(10, 10, 40, 20),
+                                       Size(5, 5));
+  auto second = Geometry::MakeRoundRect(Rect::MakeXYWH(10, 60, 40, 20),
+                                        Size(5, 5));
+  auto other = Geometry::MakeRoundRect(Rect::MakeXYWH(10, 60, 40, 20),
+                                       Size(8, 8));
+
+  Entity entity;
+  auto first_result =
+      first->GetSharedPositionBuffer(*content_context, entity, *render_pass);
+  auto second_result =
+      second->GetSharedPositionBuffer(*content_context, entity, *render_pass);
+  auto other_result =
+      other->GetSharedPositionBuffer(*content_context, entity, *render_pass);
+
+  // Only the transforms of the draws of the same shape differ.
+  EXPECT_EQ(first_result.vertex_buffer.vertex_buffer.buffer,
+            second_result.vertex_buffer.vertex_buffer.buffer);
+  EXPECT_EQ(first_result.vertex_buffer.vertex_buffer.range,
+            second_result.vertex_buffer.vertex_buffer.range);
+  EXPECT_MATRIX_NEAR(second_result.transform,
+                     first_result.transform * Matrix::MakeTranslation({0, 50}));
+  EXPECT_FALSE(first_result.vertex_buffer.vertex_buffer.range ==
+               other_result.vertex_buffer.vertex_buffer.range);
+
+  // The buffers are emplaced again once the transients buffer is reset.
+  content_context->GetTransientsBuffer().Reset();
+  auto next_frame_result =
+      second->GetSharedPositionBuffer(*content_context, entity, *render_pass);
+  EXPECT_EQ(content_context->GetGeometryBufferMemo().GetEntryCount(), 1u);
+  EXPECT_TRUE(next_frame_result.vertex_buffer);
+}
+
 }  // namespace testing
 }  // namespace impeller
 
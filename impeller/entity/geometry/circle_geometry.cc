@@ -44,6 +44,30 @@ GeometryResult CircleGeometry::GetPositionBuffer(const ContentContext& renderer,
   return ComputePositionGeometry(renderer, generator, entity, pass);
 }
 
+// |Geometry|
+GeometryResult CircleGeometry::GetSharedPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  auto& transform = entity.GetTransform();
+
+  Scalar half_width = stroke_width_ < 0 ? 0.0
+                                        : LineGeometry::ComputePixelHalfWidth(
+                                              transform, stroke_width_);
+
+  // Tessellate around the origin so that every circle of this radius and
+  // stroke width shares the vertices, wherever it is drawn.
+  auto generator = renderer.GetTessellator()->StrokedCircle(
+      transform, Point(), radius_, half_width);
+  return ComputeSharedPositionGeometry(
+      renderer,
+      {
+          .shape = GeometryBufferMemo::Shape::kStrokedCircle,
+          .size = Size(radius_, half_width),
+      },
+      generator, center_, entity, pass);
+}
+
 // |Geometry|
 GeometryResult CircleGeometry::GetPositionUVBuffer(
     Rect texture_coverage,
@@ -81,10 +105,8 @@ std::optional<Rect> CircleGeometry::GetCoverage(const Matrix& transform) const {
       {center_.x - radius_, center_.y},
   };
 
-  for (int i = 0; i < 4; i++) {
-    corners[i] = transform * corners[i];
-  }
-  return Rect::MakePointBounds(std::begin(corners), std::end(corners));
+  transform.TransformPoints(corners, corners, 4);
+  return Rect::MakePointBounds(corners, 4);
 }
 
 bool CircleGeometry::CoversArea(const Matrix& transform,
@@ -96,4 +118,16 @@ bool CircleGeometry::IsAxisAlignedRect() const {
   return false;
 }
 
+std::optional<AnalyticRRect> CircleGeometry::AsAnalyticRRect() const {
+  // Only filled circles are represented as a rounded rectangle.
+  if (stroke_width_ >= 0) {
+    return std::nullopt;
+  }
+  return AnalyticRRect{
+      .rect = Rect::MakeLTRB(center_.x - radius_, center_.y - radius_,
+                             center_.x + radius_, center_.y + radius_),
+      .radii = Size(radius_, radius_),
+      .transform = Matrix()};
+}
+
 }  // namespace impeller
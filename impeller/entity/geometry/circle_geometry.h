@@ -27,12 +27,20 @@ class CircleGeometry final : public Geometry {
   // |Geometry|
   bool IsAxisAlignedRect() const override;
 
+  // |Geometry|
+  std::optional<AnalyticRRect> AsAnalyticRRect() const override;
+
  private:
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
                                    const Entity& entity,
                                    RenderPass& pass) const override;
 
+  // |Geometry|
+  GeometryResult GetSharedPositionBuffer(const ContentContext& renderer,
+                                         const Entity& entity,
+                                         RenderPass& pass) const override;
+
   // |Geometry|
   GeometryVertexType GetVertexType() const override;
 
@@ -54,4 +54,10 @@ bool EllipseGeometry::IsAxisAlignedRect() const {
   return false;
 }
 
+std::optional<AnalyticRRect> EllipseGeometry::AsAnalyticRRect() const {
+  return AnalyticRRect{.rect = bounds_,
+                       .radii = bounds_.GetSize() * 0.5f,
+                       .transform = Matrix()};
+}
+
 }  // namespace impeller
@@ -154,4 +154,67 @@ bool FillPathGeometry::CoversArea(const Matrix& transform,
   return coverage.Contains(rect);
 }
 
+std::optional<StencilFanResult> FillPathGeometry::GetStencilFanBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  // Convex paths are already drawn without triangulation.
+  FillType fill_type = path_.GetFillType();
+  if ((fill_type != FillType::kNonZero && fill_type != FillType::kOdd) ||
+      (fill_type == FillType::kNonZero && path_.IsConvex())) {
+    return std::nullopt;
+  }
+  std::optional<Rect> bounds = path_.GetBoundingBox();
+  if (!bounds.has_value()) {
+    return std::nullopt;
+  }
+
+  Path::Polyline polyline = renderer.GetTessellator()->CreateTempPolyline(
+      path_, entity.GetTransform().GetMaxBasisLength());
+
+  // Each contour is fanned out from its first point. The fans overlap where
+  // the contour winds around a pixel more than once, and the closing edge of
+  // the contour is implied by the last triangle.
+  size_t vertex_count = 0u;
+  for (size_t i = 0u; i < polyline.contours.size(); i++) {
+    auto [start, end] = polyline.GetContourPointBounds(i);
+    if (end - start > 2u) {
+      vertex_count += (end - start - 2u) * 3u;
+    }
+  }
+  if (vertex_count == 0u) {
+    return std::nullopt;
+  }
+
+  VertexBuffer vertex_buffer;
+  vertex_buffer.vertex_buffer = renderer.GetTransientsBuffer().Emplace(
+      vertex_count * sizeof(Point), alignof(Point),
+      [&polyline](uint8_t* buffer) {
+        auto* vertices = reinterpret_cast<Point*>(buffer);
+        for (size_t i = 0u; i < polyline.contours.size(); i++) {
+          auto [start, end] = polyline.GetContourPointBounds(i);
+          for (size_t j = start + 1u; j + 1u < end; j++) {
+            *vertices++ = polyline.GetPoint(start);
+            *vertices++ = polyline.GetPoint(j);
+            *vertices++ = polyline.GetPoint(j + 1u);
+          }
+        }
+      });
+  vertex_buffer.vertex_count = vertex_count;
+  vertex_buffer.index_type = IndexType::kNone;
+
+  return StencilFanResult{
+      .fans =
+          GeometryResult{
+              .type = PrimitiveType::kTriangle,
+              .vertex_buffer = std::move(vertex_buffer),
+              .transform =
+                  pass.GetOrthographicTransform() * entity.GetTransform(),
+              .prevent_overdraw = false,
+          },
+      .fill_type = fill_type,
+      .cover_rect = bounds.value(),
+  };
+}
+
 }  // namespace impeller
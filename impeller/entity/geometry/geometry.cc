@@ -7,6 +7,7 @@
 #include <memory>
 #include <optional>
 
+#include "impeller/base/arena.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/geometry/circle_geometry.h"
 #include "impeller/entity/geometry/cover_geometry.h"
@@ -90,6 +91,31 @@ GeometryResult Geometry::ComputePositionUVGeometry(
   };
 }
 
+GeometryResult Geometry::ComputeSharedPositionGeometry(
+    const ContentContext& renderer,
+    GeometryBufferMemo::Key key,
+    const Tessellator::VertexGenerator& generator,
+    const Point& origin,
+    const Entity& entity,
+    RenderPass& pass) {
+  key.vertex_count = generator.GetVertexCount();
+  key.type = generator.GetTriangleType();
+
+  auto vertex_buffer = renderer.GetGeometryBufferMemo().GetOrEmplace(
+      key, renderer.GetTransientsBuffer(), [&](HostBuffer&) {
+        return ComputePositionGeometry(renderer, generator, entity, pass)
+            .vertex_buffer;
+      });
+
+  return GeometryResult{
+      .type = key.type,
+      .vertex_buffer = std::move(vertex_buffer),
+      .transform = pass.GetOrthographicTransform() * entity.GetTransform() *
+                   Matrix::MakeTranslation(origin),
+      .prevent_overdraw = false,
+  };
+}
+
 VertexBufferBuilder<TextureFillVertexShader::PerVertexData>
 ComputeUVGeometryCPU(
     VertexBufferBuilder<SolidFillVertexShader::PerVertexData>& input,
@@ -142,6 +168,13 @@ GeometryResult ComputeUVGeometryForRect(Rect source_rect,
   };
 }
 
+GeometryResult Geometry::GetSharedPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  return GetPositionBuffer(renderer, entity, pass);
+}
+
 GeometryResult Geometry::GetPositionUVBuffer(Rect texture_coverage,
                                              Matrix effect_transform,
                                              const ContentContext& renderer,
@@ -153,13 +186,13 @@ GeometryResult Geometry::GetPositionUVBuffer(Rect texture_coverage,
 std::shared_ptr<Geometry> Geometry::MakeFillPath(
     Path path,
     std::optional<Rect> inner_rect) {
-  return std::make_shared<FillPathGeometry>(std::move(path), inner_rect);
+  return MakeShared<FillPathGeometry>(std::move(path), inner_rect);
 }
 
 std::shared_ptr<Geometry> Geometry::MakePointField(std::vector<Point> points,
                                                    Scalar radius,
                                                    bool round) {
-  return std::make_shared<PointFieldGeometry>(std::move(points), radius, round);
+  return MakeShared<PointFieldGeometry>(std::move(points), radius, round);
 }
 
 std::shared_ptr<Geometry> Geometry::MakeStrokePath(Path path,
@@ -171,43 +204,43 @@ std::shared_ptr<Geometry> Geometry::MakeStrokePath(Path path,
   if (miter_limit < 0) {
     miter_limit = 4.0;
   }
-  return std::make_shared<StrokePathGeometry>(
+  return MakeShared<StrokePathGeometry>(
       std::move(path), stroke_width, miter_limit, stroke_cap, stroke_join);
 }
 
 std::shared_ptr<Geometry> Geometry::MakeCover() {
-  return std::make_shared<CoverGeometry>();
+  return MakeShared<CoverGeometry>();
 }
 
 std::shared_ptr<Geometry> Geometry::MakeRect(const Rect& rect) {
-  return std::make_shared<RectGeometry>(rect);
+  return MakeShared<RectGeometry>(rect);
 }
 
 std::shared_ptr<Geometry> Geometry::MakeOval(const Rect& rect) {
-  return std::make_shared<EllipseGeometry>(rect);
+  return MakeShared<EllipseGeometry>(rect);
 }
 
 std::shared_ptr<Geometry> Geometry::MakeLine(const Point& p0,
                                              const Point& p1,
                                              Scalar width,
                                              Cap cap) {
-  return std::make_shared<LineGeometry>(p0, p1, width, cap);
+  return MakeShared<LineGeometry>(p0, p1, width, cap);
 }
 
 std::shared_ptr<Geometry> Geometry::MakeCircle(const Point& center,
                                                Scalar radius) {
-  return std::make_shared<CircleGeometry>(center, radius);
+  return MakeShared<CircleGeometry>(center, radius);
 }
 
 std::shared_ptr<Geometry> Geometry::MakeStrokedCircle(const Point& center,
                                                       Scalar radius,
                                                       Scalar stroke_width) {
-  return std::make_shared<CircleGeometry>(center, radius, stroke_width);
+  return MakeShared<CircleGeometry>(center, radius, stroke_width);
 }
 
 std::shared_ptr<Geometry> Geometry::MakeRoundRect(const Rect& rect,
                                                   const Size& radii) {
-  return std::make_shared<RoundRectGeometry>(rect, radii);
+  return MakeShared<RoundRectGeometry>(rect, radii);
 }
 
 bool Geometry::CoversArea(const Matrix& transform, const Rect& rect) const {
@@ -218,4 +251,19 @@ bool Geometry::IsAxisAlignedRect() const {
   return false;
 }
 
+std::optional<Rect> Geometry::AsRect() const {
+  return std::nullopt;
+}
+
+std::optional<AnalyticRRect> Geometry::AsAnalyticRRect() const {
+  return std::nullopt;
+}
+
+std::optional<StencilFanResult> Geometry::GetStencilFanBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  return std::nullopt;
+}
+
 }  // namespace impeller
@@ -9,7 +9,9 @@
 #include "impeller/core/vertex_buffer.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/geometry/geometry_buffer_memo.h"
 #include "impeller/entity/texture_fill.vert.h"
+#include "impeller/geometry/path.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/vertex_buffer_builder.h"
 
@@ -31,6 +33,24 @@ static const GeometryResult kEmptyResult = {
         },
 };
 
+/// @brief A filled rectangle with quarter ellipse corners of the given radii.
+///        `transform` maps the local space of the rectangle into the local
+///        space of the geometry.
+struct AnalyticRRect {
+  Rect rect;
+  Size radii;
+  Matrix transform;
+};
+
+/// @brief Triangle fans of the contours of a path. The winding of the fans in
+///        the stencil buffer determines which pixels of `cover_rect` are
+///        inside of the path according to `fill_type`.
+struct StencilFanResult {
+  GeometryResult fans;
+  FillType fill_type;
+  Rect cover_rect;
+};
+
 enum GeometryVertexType {
   kPosition,
   kColor,
@@ -97,6 +117,20 @@ class Geometry {
                                            const Entity& entity,
                                            RenderPass& pass) const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief    Like |GetPositionBuffer|, but the vertices may be relative to
+  ///           any origin, with the result transform moving them into place,
+  ///           so that identical shapes drawn in the same frame can share one
+  ///           vertex buffer.
+  ///
+  ///           Only contents that use the vertex positions solely through the
+  ///           result transform may call this. Shaders that derive anything
+  ///           else from the positions, like gradients, must not.
+  ///
+  virtual GeometryResult GetSharedPositionBuffer(const ContentContext& renderer,
+                                                 const Entity& entity,
+                                                 RenderPass& pass) const;
+
   virtual GeometryResult GetPositionUVBuffer(Rect texture_coverage,
                                              Matrix effect_transform,
                                              const ContentContext& renderer,
@@ -121,6 +155,29 @@ class Geometry {
 
   virtual bool IsAxisAlignedRect() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief    Returns the rectangle this geometry fills in its local space if
+  ///           it is known to be exactly a filled rectangle.
+  ///
+  virtual std::optional<Rect> AsRect() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief    Returns the rounded rectangle this geometry fills if its edge
+  ///           coverage can be computed analytically in the fragment stage,
+  ///           which anti-aliases it without multisampling.
+  ///
+  virtual std::optional<AnalyticRRect> AsAnalyticRRect() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief    Returns triangle fans that fill this geometry when they are
+  ///           drawn with stencil-then-cover, which is linear in the number
+  ///           of vertices where triangulating the geometry is not.
+  ///
+  virtual std::optional<StencilFanResult> GetStencilFanBuffer(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass) const;
+
  protected:
   static GeometryResult ComputePositionGeometry(
       const ContentContext& renderer,
@@ -134,6 +191,19 @@ class Geometry {
       const Matrix& uv_transform,
       const Entity& entity,
       RenderPass& pass);
+
+  //----------------------------------------------------------------------------
+  /// @brief    Computes the position geometry of a generator whose vertices
+  ///           are relative to `origin`, reusing the vertex buffer of any
+  ///           earlier draw of the frame with the same shape and vertex count.
+  ///
+  static GeometryResult ComputeSharedPositionGeometry(
+      const ContentContext& renderer,
+      GeometryBufferMemo::Key key,
+      const Tessellator::VertexGenerator& generator,
+      const Point& origin,
+      const Entity& entity,
+      RenderPass& pass);
 };
 
 }  // namespace impeller
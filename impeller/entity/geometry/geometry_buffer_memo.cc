@@ -0,0 +1,47 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/geometry/geometry_buffer_memo.h"
+
+#include "flutter/fml/hash_combine.h"
+
+namespace impeller {
+
+size_t GeometryBufferMemo::KeyHash::operator()(const Key& key) const {
+  return fml::HashCombine(static_cast<int>(key.shape), key.size.width,
+                          key.size.height, key.radii.width, key.radii.height,
+                          key.vertex_count, static_cast<int>(key.type));
+}
+
+GeometryBufferMemo::GeometryBufferMemo() = default;
+
+GeometryBufferMemo::~GeometryBufferMemo() = default;
+
+VertexBuffer GeometryBufferMemo::GetOrEmplace(const Key& key,
+                                              HostBuffer& host_buffer,
+                                              const EmplaceProc& emplace) {
+  if (host_buffer_ != &host_buffer ||
+      reset_count_ != host_buffer.GetResetCount()) {
+    entries_.clear();
+    host_buffer_ = &host_buffer;
+    reset_count_ = host_buffer.GetResetCount();
+  }
+
+  auto found = entries_.find(key);
+  if (found != entries_.end()) {
+    return found->second;
+  }
+
+  auto vertex_buffer = emplace(host_buffer);
+  if (entries_.size() < kMaxEntryCount) {
+    entries_[key] = vertex_buffer;
+  }
+  return vertex_buffer;
+}
+
+size_t GeometryBufferMemo::GetEntryCount() const {
+  return entries_.size();
+}
+
+}  // namespace impeller
@@ -0,0 +1,96 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_GEOMETRY_GEOMETRY_BUFFER_MEMO_H_
+#define FLUTTER_IMPELLER_ENTITY_GEOMETRY_GEOMETRY_BUFFER_MEMO_H_
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+#include "impeller/core/formats.h"
+#include "impeller/core/host_buffer.h"
+#include "impeller/core/vertex_buffer.h"
+#include "impeller/geometry/size.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Remembers the vertex buffers of the analytic shapes emplaced
+///             onto a host buffer during the current frame.
+///
+///             Lists of cards repeat the same round rect, with the same
+///             radii at the same scale, hundreds of times per frame. Those
+///             shapes are tessellated relative to their origin and uploaded
+///             once, and every draw of them only differs in its transform.
+///
+///             Entries are forgotten when the host buffer is reset, which
+///             invalidates the buffer views they refer to.
+///
+///             This object is not thread safe.
+///
+class GeometryBufferMemo {
+ public:
+  /// The number of distinct shapes remembered per frame. Shapes drawn after
+  /// this limit are emplaced on every draw.
+  static constexpr size_t kMaxEntryCount = 1024u;
+
+  enum class Shape {
+    kFilledRoundRect,
+    kStrokedCircle,
+  };
+
+  struct Key {
+    Shape shape = Shape::kFilledRoundRect;
+    /// The size of a round rect, or the radius and the stroke half width of a
+    /// circle.
+    Size size;
+    /// The corner radii of a round rect.
+    Size radii;
+    /// The vertex count and topology of the tessellation, which capture the
+    /// number of divisions chosen for the scale of the transform.
+    size_t vertex_count = 0u;
+    PrimitiveType type = PrimitiveType::kTriangle;
+
+    constexpr bool operator==(const Key& other) const {
+      return shape == other.shape && size == other.size &&
+             radii == other.radii && vertex_count == other.vertex_count &&
+             type == other.type;
+    }
+  };
+
+  using EmplaceProc = std::function<VertexBuffer(HostBuffer& host_buffer)>;
+
+  GeometryBufferMemo();
+
+  ~GeometryBufferMemo();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the vertex buffer emplaced for the key during the
+  ///             current frame of the host buffer, or emplaces it with the
+  ///             given callback.
+  ///
+  VertexBuffer GetOrEmplace(const Key& key,
+                            HostBuffer& host_buffer,
+                            const EmplaceProc& emplace);
+
+  size_t GetEntryCount() const;
+
+ private:
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  const HostBuffer* host_buffer_ = nullptr;
+  uint64_t reset_count_ = 0u;
+  std::unordered_map<Key, VertexBuffer, KeyHash> entries_;
+
+  GeometryBufferMemo(const GeometryBufferMemo&) = delete;
+
+  GeometryBufferMemo& operator=(const GeometryBufferMemo&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_GEOMETRY_GEOMETRY_BUFFER_MEMO_H_
@@ -4,6 +4,7 @@
 
 #include "flutter/testing/testing.h"
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/geometry/geometry_asserts.h"
 #include "impeller/geometry/path_builder.h"
 
 namespace impeller {
@@ -71,5 +72,47 @@ TEST(EntityGeometryTest, RoundRectGeometryCoversArea) {
   EXPECT_TRUE(geometry->CoversArea({}, Rect::MakeLTRB(1, 30, 99, 70)));
 }
 
+TEST(EntityGeometryTest, AnalyticRRectOfPrimitives) {
+  auto rect = Geometry::MakeRect(Rect::MakeLTRB(0, 0, 100, 50))
+                  ->AsAnalyticRRect();
+  ASSERT_TRUE(rect.has_value());
+  EXPECT_EQ(rect->rect, Rect::MakeLTRB(0, 0, 100, 50));
+  EXPECT_EQ(rect->radii, Size());
+
+  auto oval = Geometry::MakeOval(Rect::MakeLTRB(0, 0, 100, 50))
+                  ->AsAnalyticRRect();
+  ASSERT_TRUE(oval.has_value());
+  EXPECT_EQ(oval->radii, Size(50, 25));
+
+  auto circle = Geometry::MakeCircle(Point(10, 20), 5)->AsAnalyticRRect();
+  ASSERT_TRUE(circle.has_value());
+  EXPECT_EQ(circle->rect, Rect::MakeLTRB(5, 15, 15, 25));
+  EXPECT_EQ(circle->radii, Size(5, 5));
+
+  EXPECT_FALSE(Geometry::MakeStrokedCircle(Point(10, 20), 5, 2)
+                   ->AsAnalyticRRect()
+                   .has_value());
+  EXPECT_FALSE(Geometry::MakeLine(Point(0, 0), Point(10, 0), 0, Cap::kButt)
+                   ->AsAnalyticRRect()
+                   .has_value());
+}
+
+TEST(EntityGeometryTest, AnalyticRRectOfLine) {
+  auto line = Geometry::MakeLine(Point(10, 10), Point(10, 30), 4, Cap::kRound)
+                  ->AsAnalyticRRect();
+  ASSERT_TRUE(line.has_value());
+  EXPECT_EQ(line->radii, Size(2, 2));
+  // The rectangle runs along the line, extended by the round caps.
+  EXPECT_RECT_NEAR(line->rect.TransformBounds(line->transform),
+                   Rect::MakeLTRB(8, 8, 12, 32));
+
+  auto butt = Geometry::MakeLine(Point(10, 10), Point(10, 30), 4, Cap::kButt)
+                  ->AsAnalyticRRect();
+  ASSERT_TRUE(butt.has_value());
+  EXPECT_EQ(butt->radii, Size());
+  EXPECT_RECT_NEAR(butt->rect.TransformBounds(butt->transform),
+                   Rect::MakeLTRB(8, 10, 12, 30));
+}
+
 }  // namespace testing
 }  // namespace impeller
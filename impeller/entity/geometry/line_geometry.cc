@@ -172,10 +172,8 @@ std::optional<Rect> LineGeometry::GetCoverage(const Matrix& transform) const {
     return {};
   }
 
-  for (int i = 0; i < 4; i++) {
-    corners[i] = transform * corners[i];
-  }
-  return Rect::MakePointBounds(std::begin(corners), std::end(corners));
+  transform.TransformPoints(corners, corners, 4);
+  return Rect::MakePointBounds(corners, 4);
 }
 
 bool LineGeometry::CoversArea(const Matrix& transform, const Rect& rect) const {
@@ -190,4 +188,37 @@ bool LineGeometry::IsAxisAlignedRect() const {
   return cap_ != Cap::kRound && (p0_.x == p1_.x || p0_.y == p1_.y);
 }
 
+std::optional<AnalyticRRect> LineGeometry::AsAnalyticRRect() const {
+  // Hairlines are widened to a pixel by the tessellated path.
+  if (width_ <= 0) {
+    return std::nullopt;
+  }
+  Vector2 along = p1_ - p0_;
+  Scalar length = along.GetLength();
+  if (length <= 0) {
+    if (cap_ == Cap::kButt) {
+      return std::nullopt;
+    }
+    along = Vector2(1, 0);
+  } else {
+    along = along / length;
+  }
+
+  // The line is a rectangle in a space whose x axis runs from p0 to p1.
+  Scalar half_width = width_ * 0.5f;
+  Scalar extension = cap_ == Cap::kButt ? 0.0f : half_width;
+  Scalar radius = cap_ == Cap::kRound ? half_width : 0.0f;
+  // clang-format off
+  Matrix transform(along.x,  along.y, 0.0f, 0.0f,
+                   -along.y, along.x, 0.0f, 0.0f,
+                   0.0f,     0.0f,    1.0f, 0.0f,
+                   p0_.x,    p0_.y,   0.0f, 1.0f);
+  // clang-format on
+  return AnalyticRRect{
+      .rect = Rect::MakeLTRB(-extension, -half_width, length + extension,
+                             half_width),
+      .radii = Size(radius, radius),
+      .transform = transform};
+}
+
 }  // namespace impeller
@@ -24,6 +24,9 @@ class LineGeometry final : public Geometry {
   // |Geometry|
   bool IsAxisAlignedRect() const override;
 
+  // |Geometry|
+  std::optional<AnalyticRRect> AsAnalyticRRect() const override;
+
  private:
   // Computes the 4 corners of a rectangle that defines the line and
   // possibly extended endpoints which will be rendered under the given
@@ -56,4 +56,12 @@ bool RectGeometry::IsAxisAlignedRect() const {
   return true;
 }
 
+std::optional<Rect> RectGeometry::AsRect() const {
+  return rect_;
+}
+
+std::optional<AnalyticRRect> RectGeometry::AsAnalyticRRect() const {
+  return AnalyticRRect{.rect = rect_, .radii = Size(), .transform = Matrix()};
+}
+
 }  // namespace impeller
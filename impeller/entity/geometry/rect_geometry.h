@@ -21,6 +21,12 @@ class RectGeometry final : public Geometry {
   // |Geometry|
   bool IsAxisAlignedRect() const override;
 
+  // |Geometry|
+  std::optional<Rect> AsRect() const override;
+
+  // |Geometry|
+  std::optional<AnalyticRRect> AsAnalyticRRect() const override;
+
  private:
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
@@ -19,6 +19,25 @@ GeometryResult RoundRectGeometry::GetPositionBuffer(
                                  entity, pass);
 }
 
+// |Geometry|
+GeometryResult RoundRectGeometry::GetSharedPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  // Tessellate relative to the origin of the bounds so that every round rect
+  // of this size and radii shares the vertices, wherever it is drawn.
+  auto generator = renderer.GetTessellator()->FilledRoundRect(
+      entity.GetTransform(), Rect::MakeSize(bounds_.GetSize()), radii_);
+  return ComputeSharedPositionGeometry(
+      renderer,
+      {
+          .shape = GeometryBufferMemo::Shape::kFilledRoundRect,
+          .size = bounds_.GetSize(),
+          .radii = radii_,
+      },
+      generator, bounds_.GetOrigin(), entity, pass);
+}
+
 // |Geometry|
 GeometryResult RoundRectGeometry::GetPositionUVBuffer(
     Rect texture_coverage,
@@ -80,4 +99,8 @@ bool RoundRectGeometry::IsAxisAlignedRect() const {
   return false;
 }
 
+std::optional<AnalyticRRect> RoundRectGeometry::AsAnalyticRRect() const {
+  return AnalyticRRect{.rect = bounds_, .radii = radii_, .transform = Matrix()};
+}
+
 }  // namespace impeller
@@ -5,6 +5,7 @@
 #include "impeller/entity/geometry/stroke_path_geometry.h"
 
 #include "impeller/geometry/path_builder.h"
+#include "impeller/tessellator/tessellator.h"
 
 namespace impeller {
 
@@ -37,314 +38,327 @@ Join StrokePathGeometry::GetStrokeJoin() const {
   return stroke_join_;
 }
 
-// static
-Scalar StrokePathGeometry::CreateBevelAndGetDirection(
-    VertexBufferBuilder<SolidFillVertexShader::PerVertexData>& vtx_builder,
-    const Point& position,
-    const Point& start_offset,
-    const Point& end_offset) {
-  SolidFillVertexShader::PerVertexData vtx;
-  vtx.position = position;
-  vtx_builder.AppendVertex(vtx);
+namespace {
+
+/// Generates the triangle strip for a stroked polyline into a retained point
+/// arena. Joins and caps are selected with a switch rather than through
+/// per-stroke std::function callbacks.
+class StrokeGenerator {
+ public:
+  StrokeGenerator(std::vector<Point>& vertices,
+                  std::vector<Point>& arc_points,
+                  Scalar stroke_width,
+                  Scalar scaled_miter_limit,
+                  Join join,
+                  Cap cap,
+                  Scalar scale)
+      : vertices_(vertices),
+        arc_points_(arc_points),
+        stroke_width_(stroke_width),
+        scaled_miter_limit_(scaled_miter_limit),
+        join_(join),
+        cap_(cap),
+        scale_(scale) {}
+
+  void Generate(const Path::Polyline& polyline);
+
+ private:
+  std::vector<Point>& vertices_;
+  std::vector<Point>& arc_points_;
+  const Scalar stroke_width_;
+  const Scalar scaled_miter_limit_;
+  const Join join_;
+  const Cap cap_;
+  const Scalar scale_;
+
+  // Offset state.
+  Point offset_;
+  Point previous_offset_;  // Used for computing joins.
+
+  void AppendVertex(const Point& position) { vertices_.push_back(position); }
+
+  /// Returns an upper bound on the number of points |AppendArcPoints| adds
+  /// for a single join or cap, used to size the arena up front.
+  size_t GetMaxArcPointCount();
+
+  void AppendArcPoints(const CubicPathComponent& arc) {
+    arc_points_.clear();
+    arc.AppendPolylinePoints(scale_, arc_points_);
+  }
+
+  size_t GetMaxVertexCount(const Path::Polyline& polyline);
+
+  void ComputeOffset(const Path::Polyline& polyline,
+                     size_t point_i,
+                     size_t contour_start_point_i,
+                     size_t contour_end_point_i,
+                     const Path::PolylineContour& contour);
+
+  void AddVerticesForLinearComponent(const Path::Polyline& polyline,
+                                     size_t component_start_index,
+                                     size_t component_end_index,
+                                     size_t contour_start_point_i,
+                                     size_t contour_end_point_i,
+                                     const Path::PolylineContour& contour);
+
+  void AddVerticesForCurveComponent(const Path::Polyline& polyline,
+                                    size_t component_start_index,
+                                    size_t component_end_index,
+                                    size_t contour_start_point_i,
+                                    size_t contour_end_point_i,
+                                    const Path::PolylineContour& contour);
+
+  Scalar CreateBevelAndGetDirection(const Point& position,
+                                    const Point& start_offset,
+                                    const Point& end_offset);
+
+  void AddJoin(const Point& position,
+               const Point& start_offset,
+               const Point& end_offset);
+
+  void AddCap(const Point& position, const Point& offset, bool reverse);
+};
+
+size_t StrokeGenerator::GetMaxArcPointCount() {
+  if (join_ != Join::kRound && cap_ != Cap::kRound) {
+    return 0u;
+  }
+  // Round joins and caps flatten at most a quarter circle of radius
+  // stroke_width / 2.
+  Point start(stroke_width_ * 0.5f, 0);
+  Point end(0, stroke_width_ * 0.5f);
+  AppendArcPoints(CubicPathComponent(
+      start, start + end * PathBuilder::kArcApproximationMagic,
+      end + start * PathBuilder::kArcApproximationMagic, end));
+  return arc_points_.size();
+}
+
+size_t StrokeGenerator::GetMaxVertexCount(const Path::Polyline& polyline) {
+  // Each join or cap emits at most two vertices per arc point plus a handful
+  // of fixed vertices.
+  const size_t max_decoration_count = 2 * GetMaxArcPointCount() + 4;
+  size_t count = polyline.points->size() * 4;
+  for (const auto& contour : polyline.contours) {
+    // Pen pick up, two caps and a join between every pair of components.
+    count += 4 + (contour.components.size() + 2) * max_decoration_count;
+  }
+  return count;
+}
+
+Scalar StrokeGenerator::CreateBevelAndGetDirection(const Point& position,
+                                                   const Point& start_offset,
+                                                   const Point& end_offset) {
+  AppendVertex(position);
 
   Scalar dir = start_offset.Cross(end_offset) > 0 ? -1 : 1;
-  vtx.position = position + start_offset * dir;
-  vtx_builder.AppendVertex(vtx);
-  vtx.position = position + end_offset * dir;
-  vtx_builder.AppendVertex(vtx);
+  AppendVertex(position + start_offset * dir);
+  AppendVertex(position + end_offset * dir);
 
   return dir;
 }
 
-// static
-StrokePathGeometry::JoinProc StrokePathGeometry::GetJoinProc(Join stroke_join) {
-  using VS = SolidFillVertexShader;
-  StrokePathGeometry::JoinProc join_proc;
-  switch (stroke_join) {
+void StrokeGenerator::AddJoin(const Point& position,
+                              const Point& start_offset,
+                              const Point& end_offset) {
+  switch (join_) {
     case Join::kBevel:
-      join_proc = [](VertexBufferBuilder<VS::PerVertexData>& vtx_builder,
-                     const Point& position, const Point& start_offset,
-                     const Point& end_offset, Scalar miter_limit,
-                     Scalar scale) {
-        CreateBevelAndGetDirection(vtx_builder, position, start_offset,
-                                   end_offset);
-      };
-      break;
-    case Join::kMiter:
-      join_proc = [](VertexBufferBuilder<VS::PerVertexData>& vtx_builder,
-                     const Point& position, const Point& start_offset,
-                     const Point& end_offset, Scalar miter_limit,
-                     Scalar scale) {
-        Point start_normal = start_offset.Normalize();
-        Point end_normal = end_offset.Normalize();
-
-        // 1 for no joint (straight line), 0 for max joint (180 degrees).
-        Scalar alignment = (start_normal.Dot(end_normal) + 1) / 2;
-        if (ScalarNearlyEqual(alignment, 1)) {
-          return;
-        }
+      CreateBevelAndGetDirection(position, start_offset, end_offset);
+      return;
+    case Join::kMiter: {
+      Point start_normal = start_offset.Normalize();
+      Point end_normal = end_offset.Normalize();
+
+      // 1 for no joint (straight line), 0 for max joint (180 degrees).
+      Scalar alignment = (start_normal.Dot(end_normal) + 1) / 2;
+      if (ScalarNearlyEqual(alignment, 1)) {
+        return;
+      }
 
-        Scalar dir = CreateBevelAndGetDirection(vtx_builder, position,
-                                                start_offset, end_offset);
+      Scalar dir =
+          CreateBevelAndGetDirection(position, start_offset, end_offset);
 
-        Point miter_point = (start_offset + end_offset) / 2 / alignment;
-        if (miter_point.GetDistanceSquared({0, 0}) >
-            miter_limit * miter_limit) {
-          return;  // Convert to bevel when we exceed the miter limit.
-        }
+      Point miter_point = (start_offset + end_offset) / 2 / alignment;
+      if (miter_point.GetDistanceSquared({0, 0}) >
+          scaled_miter_limit_ * scaled_miter_limit_) {
+        return;  // Convert to bevel when we exceed the miter limit.
+      }
 
-        // Outer miter point.
-        VS::PerVertexData vtx;
-        vtx.position = position + miter_point * dir;
-        vtx_builder.AppendVertex(vtx);
-      };
-      break;
-    case Join::kRound:
-      join_proc = [](VertexBufferBuilder<VS::PerVertexData>& vtx_builder,
-                     const Point& position, const Point& start_offset,
-                     const Point& end_offset, Scalar miter_limit,
-                     Scalar scale) {
-        Point start_normal = start_offset.Normalize();
-        Point end_normal = end_offset.Normalize();
-
-        // 0 for no joint (straight line), 1 for max joint (180 degrees).
-        Scalar alignment = 1 - (start_normal.Dot(end_normal) + 1) / 2;
-        if (ScalarNearlyEqual(alignment, 0)) {
-          return;
-        }
+      // Outer miter point.
+      AppendVertex(position + miter_point * dir);
+      return;
+    }
+    case Join::kRound: {
+      Point start_normal = start_offset.Normalize();
+      Point end_normal = end_offset.Normalize();
+
+      // 0 for no joint (straight line), 1 for max joint (180 degrees).
+      Scalar alignment = 1 - (start_normal.Dot(end_normal) + 1) / 2;
+      if (ScalarNearlyEqual(alignment, 0)) {
+        return;
+      }
 
-        Scalar dir = CreateBevelAndGetDirection(vtx_builder, position,
-                                                start_offset, end_offset);
-
-        Point middle =
-            (start_offset + end_offset).Normalize() * start_offset.GetLength();
-        Point middle_normal = middle.Normalize();
-
-        Point middle_handle = middle + Point(-middle.y, middle.x) *
-                                           PathBuilder::kArcApproximationMagic *
-                                           alignment * dir;
-        Point start_handle =
-            start_offset + Point(start_offset.y, -start_offset.x) *
-                               PathBuilder::kArcApproximationMagic * alignment *
-                               dir;
-
-        std::vector<Point> arc_points;
-        CubicPathComponent(start_offset, start_handle, middle_handle, middle)
-            .AppendPolylinePoints(scale, arc_points);
-
-        VS::PerVertexData vtx;
-        for (const auto& point : arc_points) {
-          vtx.position = position + point * dir;
-          vtx_builder.AppendVertex(vtx);
-          vtx.position = position + (-point * dir).Reflect(middle_normal);
-          vtx_builder.AppendVertex(vtx);
-        }
-      };
-      break;
+      Scalar dir =
+          CreateBevelAndGetDirection(position, start_offset, end_offset);
+
+      Point middle =
+          (start_offset + end_offset).Normalize() * start_offset.GetLength();
+      Point middle_normal = middle.Normalize();
+
+      Point middle_handle = middle + Point(-middle.y, middle.x) *
+                                         PathBuilder::kArcApproximationMagic *
+                                         alignment * dir;
+      Point start_handle =
+          start_offset + Point(start_offset.y, -start_offset.x) *
+                             PathBuilder::kArcApproximationMagic * alignment *
+                             dir;
+
+      AppendArcPoints(CubicPathComponent(start_offset, start_handle,
+                                         middle_handle, middle));
+      for (const auto& point : arc_points_) {
+        AppendVertex(position + point * dir);
+        AppendVertex(position + (-point * dir).Reflect(middle_normal));
+      }
+      return;
+    }
   }
-  return join_proc;
 }
 
-// static
-StrokePathGeometry::CapProc StrokePathGeometry::GetCapProc(Cap stroke_cap) {
-  using VS = SolidFillVertexShader;
-  StrokePathGeometry::CapProc cap_proc;
-  switch (stroke_cap) {
+void StrokeGenerator::AddCap(const Point& position,
+                             const Point& offset,
+                             bool reverse) {
+  Point orientation = offset * (reverse ? -1 : 1);
+  Point forward(offset.y, -offset.x);
+  switch (cap_) {
     case Cap::kButt:
-      cap_proc = [](VertexBufferBuilder<VS::PerVertexData>& vtx_builder,
-                    const Point& position, const Point& offset, Scalar scale,
-                    bool reverse) {
-        Point orientation = offset * (reverse ? -1 : 1);
-        VS::PerVertexData vtx;
-        vtx.position = position + orientation;
-        vtx_builder.AppendVertex(vtx);
-        vtx.position = position - orientation;
-        vtx_builder.AppendVertex(vtx);
-      };
-      break;
-    case Cap::kRound:
-      cap_proc = [](VertexBufferBuilder<VS::PerVertexData>& vtx_builder,
-                    const Point& position, const Point& offset, Scalar scale,
-                    bool reverse) {
-        Point orientation = offset * (reverse ? -1 : 1);
-
-        VS::PerVertexData vtx;
-
-        Point forward(offset.y, -offset.x);
-        Point forward_normal = forward.Normalize();
-
-        CubicPathComponent arc;
-        if (reverse) {
-          arc = CubicPathComponent(
-              forward,
-              forward + orientation * PathBuilder::kArcApproximationMagic,
-              orientation + forward * PathBuilder::kArcApproximationMagic,
-              orientation);
-        } else {
-          arc = CubicPathComponent(
-              orientation,
-              orientation + forward * PathBuilder::kArcApproximationMagic,
-              forward + orientation * PathBuilder::kArcApproximationMagic,
-              forward);
-        }
+      AppendVertex(position + orientation);
+      AppendVertex(position - orientation);
+      return;
+    case Cap::kRound: {
+      Point forward_normal = forward.Normalize();
+
+      CubicPathComponent arc;
+      if (reverse) {
+        arc = CubicPathComponent(
+            forward,
+            forward + orientation * PathBuilder::kArcApproximationMagic,
+            orientation + forward * PathBuilder::kArcApproximationMagic,
+            orientation);
+      } else {
+        arc = CubicPathComponent(
+            orientation,
+            orientation + forward * PathBuilder::kArcApproximationMagic,
+            forward + orientation * PathBuilder::kArcApproximationMagic,
+            forward);
+      }
 
-        vtx.position = position + orientation;
-        vtx_builder.AppendVertex(vtx);
-        vtx.position = position - orientation;
-        vtx_builder.AppendVertex(vtx);
-        std::vector<Point> arc_points;
-        arc.AppendPolylinePoints(scale, arc_points);
-        for (const auto& point : arc_points) {
-          vtx.position = position + point;
-          vtx_builder.AppendVertex(vtx);
-          vtx.position = position + (-point).Reflect(forward_normal);
-          vtx_builder.AppendVertex(vtx);
-        }
-      };
-      break;
+      AppendVertex(position + orientation);
+      AppendVertex(position - orientation);
+      AppendArcPoints(arc);
+      for (const auto& point : arc_points_) {
+        AppendVertex(position + point);
+        AppendVertex(position + (-point).Reflect(forward_normal));
+      }
+      return;
+    }
     case Cap::kSquare:
-      cap_proc = [](VertexBufferBuilder<VS::PerVertexData>& vtx_builder,
-                    const Point& position, const Point& offset, Scalar scale,
-                    bool reverse) {
-        Point orientation = offset * (reverse ? -1 : 1);
-
-        VS::PerVertexData vtx;
-
-        Point forward(offset.y, -offset.x);
-
-        vtx.position = position + orientation;
-        vtx_builder.AppendVertex(vtx);
-        vtx.position = position - orientation;
-        vtx_builder.AppendVertex(vtx);
-        vtx.position = position + orientation + forward;
-        vtx_builder.AppendVertex(vtx);
-        vtx.position = position - orientation + forward;
-        vtx_builder.AppendVertex(vtx);
-      };
-      break;
+      AppendVertex(position + orientation);
+      AppendVertex(position - orientation);
+      AppendVertex(position + orientation + forward);
+      AppendVertex(position - orientation + forward);
+      return;
   }
-  return cap_proc;
 }
 
-// static
-VertexBufferBuilder<SolidFillVertexShader::PerVertexData>
-StrokePathGeometry::CreateSolidStrokeVertices(
-    const Path& path,
-    Scalar stroke_width,
-    Scalar scaled_miter_limit,
-    const StrokePathGeometry::JoinProc& join_proc,
-    const StrokePathGeometry::CapProc& cap_proc,
-    Scalar scale) {
-  VertexBufferBuilder<VS::PerVertexData> vtx_builder;
-  auto point_buffer = std::make_unique<std::vector<Point>>();
-  // 512 is an arbitrary choice that should be big enough for most paths without
-  // needing to reallocate. If we have motivating benchmarks we should raise or
-  // lower this number, cause dnfield just made it up!
-  point_buffer->reserve(512);
-  auto polyline = path.CreatePolyline(scale, std::move(point_buffer));
+// Computes offset by calculating the direction from point_i - 1 to point_i if
+// point_i is within `contour_start_point_i` and `contour_end_point_i`;
+// Otherwise, it uses direction from contour.
+void StrokeGenerator::ComputeOffset(const Path::Polyline& polyline,
+                                    size_t point_i,
+                                    size_t contour_start_point_i,
+                                    size_t contour_end_point_i,
+                                    const Path::PolylineContour& contour) {
+  Point direction;
+  if (point_i >= contour_end_point_i) {
+    direction = contour.end_direction;
+  } else if (point_i <= contour_start_point_i) {
+    direction = -contour.start_direction;
+  } else {
+    direction = (polyline.GetPoint(point_i) - polyline.GetPoint(point_i - 1))
+                    .Normalize();
+  }
+  previous_offset_ = offset_;
+  offset_ = Vector2{-direction.y, direction.x} * stroke_width_ * 0.5;
+}
 
-  VS::PerVertexData vtx;
+void StrokeGenerator::AddVerticesForLinearComponent(
+    const Path::Polyline& polyline,
+    size_t component_start_index,
+    size_t component_end_index,
+    size_t contour_start_point_i,
+    size_t contour_end_point_i,
+    const Path::PolylineContour& contour) {
+  auto is_last_component = component_start_index ==
+                           contour.components.back().component_start_index;
+
+  for (size_t point_i = component_start_index; point_i < component_end_index;
+       point_i++) {
+    auto is_end_of_component = point_i == component_end_index - 1;
+    AppendVertex(polyline.GetPoint(point_i) + offset_);
+    AppendVertex(polyline.GetPoint(point_i) - offset_);
+
+    // For line components, two additional points need to be appended
+    // prior to appending a join connecting the next component.
+    AppendVertex(polyline.GetPoint(point_i + 1) + offset_);
+    AppendVertex(polyline.GetPoint(point_i + 1) - offset_);
+
+    ComputeOffset(polyline, point_i + 2, contour_start_point_i,
+                  contour_end_point_i, contour);
+    if (!is_last_component && is_end_of_component) {
+      // Generate join from the current line to the next line.
+      AddJoin(polyline.GetPoint(point_i + 1), previous_offset_, offset_);
+    }
+  }
+}
 
-  // Offset state.
-  Point offset;
-  Point previous_offset;  // Used for computing joins.
-
-  // Computes offset by calculating the direction from point_i - 1 to point_i if
-  // point_i is within `contour_start_point_i` and `contour_end_point_i`;
-  // Otherwise, it uses direction from contour.
-  auto compute_offset = [&polyline, &offset, &previous_offset, &stroke_width](
-                            const size_t point_i,
-                            const size_t contour_start_point_i,
-                            const size_t contour_end_point_i,
-                            const Path::PolylineContour& contour) {
-    Point direction;
-    if (point_i >= contour_end_point_i) {
-      direction = contour.end_direction;
-    } else if (point_i <= contour_start_point_i) {
-      direction = -contour.start_direction;
-    } else {
-      direction = (polyline.GetPoint(point_i) - polyline.GetPoint(point_i - 1))
-                      .Normalize();
+void StrokeGenerator::AddVerticesForCurveComponent(
+    const Path::Polyline& polyline,
+    size_t component_start_index,
+    size_t component_end_index,
+    size_t contour_start_point_i,
+    size_t contour_end_point_i,
+    const Path::PolylineContour& contour) {
+  auto is_last_component = component_start_index ==
+                           contour.components.back().component_start_index;
+
+  for (size_t point_i = component_start_index; point_i < component_end_index;
+       point_i++) {
+    auto is_end_of_component = point_i == component_end_index - 1;
+
+    AppendVertex(polyline.GetPoint(point_i) + offset_);
+    AppendVertex(polyline.GetPoint(point_i) - offset_);
+
+    ComputeOffset(polyline, point_i + 2, contour_start_point_i,
+                  contour_end_point_i, contour);
+    // For curve components, the polyline is detailed enough such that
+    // it can avoid worrying about joins altogether.
+    if (is_end_of_component) {
+      AppendVertex(polyline.GetPoint(point_i + 1) + offset_);
+      AppendVertex(polyline.GetPoint(point_i + 1) - offset_);
+      // Generate join from the current line to the next line.
+      if (!is_last_component) {
+        AddJoin(polyline.GetPoint(point_i + 1), previous_offset_, offset_);
+      }
     }
-    previous_offset = offset;
-    offset = Vector2{-direction.y, direction.x} * stroke_width * 0.5;
-  };
+  }
+}
 
-  auto add_vertices_for_linear_component =
-      [&vtx_builder, &offset, &previous_offset, &vtx, &polyline,
-       &compute_offset, scaled_miter_limit, scale, &join_proc](
-          const size_t component_start_index, const size_t component_end_index,
-          const size_t contour_start_point_i, const size_t contour_end_point_i,
-          const Path::PolylineContour& contour) {
-        auto is_last_component =
-            component_start_index ==
-            contour.components.back().component_start_index;
-
-        for (size_t point_i = component_start_index;
-             point_i < component_end_index; point_i++) {
-          auto is_end_of_component = point_i == component_end_index - 1;
-          vtx.position = polyline.GetPoint(point_i) + offset;
-          vtx_builder.AppendVertex(vtx);
-          vtx.position = polyline.GetPoint(point_i) - offset;
-          vtx_builder.AppendVertex(vtx);
-
-          // For line components, two additional points need to be appended
-          // prior to appending a join connecting the next component.
-          vtx.position = polyline.GetPoint(point_i + 1) + offset;
-          vtx_builder.AppendVertex(vtx);
-          vtx.position = polyline.GetPoint(point_i + 1) - offset;
-          vtx_builder.AppendVertex(vtx);
-
-          compute_offset(point_i + 2, contour_start_point_i,
-                         contour_end_point_i, contour);
-          if (!is_last_component && is_end_of_component) {
-            // Generate join from the current line to the next line.
-            join_proc(vtx_builder, polyline.GetPoint(point_i + 1),
-                      previous_offset, offset, scaled_miter_limit, scale);
-          }
-        }
-      };
-
-  auto add_vertices_for_curve_component =
-      [&vtx_builder, &offset, &previous_offset, &vtx, &polyline,
-       &compute_offset, scaled_miter_limit, scale, &join_proc](
-          const size_t component_start_index, const size_t component_end_index,
-          const size_t contour_start_point_i, const size_t contour_end_point_i,
-          const Path::PolylineContour& contour) {
-        auto is_last_component =
-            component_start_index ==
-            contour.components.back().component_start_index;
-
-        for (size_t point_i = component_start_index;
-             point_i < component_end_index; point_i++) {
-          auto is_end_of_component = point_i == component_end_index - 1;
-
-          vtx.position = polyline.GetPoint(point_i) + offset;
-          vtx_builder.AppendVertex(vtx);
-          vtx.position = polyline.GetPoint(point_i) - offset;
-          vtx_builder.AppendVertex(vtx);
-
-          compute_offset(point_i + 2, contour_start_point_i,
-                         contour_end_point_i, contour);
-          // For curve components, the polyline is detailed enough such that
-          // it can avoid worrying about joins altogether.
-          if (is_end_of_component) {
-            vtx.position = polyline.GetPoint(point_i + 1) + offset;
-            vtx_builder.AppendVertex(vtx);
-            vtx.position = polyline.GetPoint(point_i + 1) - offset;
-            vtx_builder.AppendVertex(vtx);
-            // Generate join from the current line to the next line.
-            if (!is_last_component) {
-              join_proc(vtx_builder, polyline.GetPoint(point_i + 1),
-                        previous_offset, offset, scaled_miter_limit, scale);
-            }
-          }
-        }
-      };
+void StrokeGenerator::Generate(const Path::Polyline& polyline) {
+  vertices_.clear();
+  vertices_.reserve(GetMaxVertexCount(polyline));
 
   for (size_t contour_i = 0; contour_i < polyline.contours.size();
        contour_i++) {
-    auto contour = polyline.contours[contour_i];
+    const auto& contour = polyline.contours[contour_i];
     size_t contour_start_point_i, contour_end_point_i;
     std::tie(contour_start_point_i, contour_end_point_i) =
         polyline.GetContourPointBounds(contour_i);
@@ -352,8 +366,8 @@ StrokePathGeometry::CreateSolidStrokeVertices(
     switch (contour_end_point_i - contour_start_point_i) {
       case 1: {
         Point p = polyline.GetPoint(contour_start_point_i);
-        cap_proc(vtx_builder, p, {-stroke_width * 0.5f, 0}, scale, false);
-        cap_proc(vtx_builder, p, {stroke_width * 0.5f, 0}, scale, false);
+        AddCap(p, {-stroke_width_ * 0.5f, 0}, false);
+        AddCap(p, {stroke_width_ * 0.5f, 0}, false);
         continue;
       }
       case 0:
@@ -362,9 +376,9 @@ StrokePathGeometry::CreateSolidStrokeVertices(
         break;
     }
 
-    compute_offset(contour_start_point_i, contour_start_point_i,
-                   contour_end_point_i, contour);
-    const Point contour_first_offset = offset;
+    ComputeOffset(polyline, contour_start_point_i, contour_start_point_i,
+                  contour_end_point_i, contour);
+    const Point contour_first_offset = offset_;
 
     if (contour_i > 0) {
       // This branch only executes when we've just finished drawing a contour
@@ -374,33 +388,30 @@ StrokePathGeometry::CreateSolidStrokeVertices(
       // vertices at the start of the new contour (thus connecting the two
       // contours with two zero volume triangles, which will be discarded by
       // the rasterizer).
-      vtx.position = polyline.GetPoint(contour_start_point_i - 1);
       // Append two vertices when "picking up" the pen so that the triangle
       // drawn when moving to the beginning of the new contour will have zero
       // volume.
-      vtx_builder.AppendVertex(vtx);
-      vtx_builder.AppendVertex(vtx);
+      AppendVertex(polyline.GetPoint(contour_start_point_i - 1));
+      AppendVertex(polyline.GetPoint(contour_start_point_i - 1));
 
-      vtx.position = polyline.GetPoint(contour_start_point_i);
       // Append two vertices at the beginning of the new contour, which
       // appends  two triangles of zero area.
-      vtx_builder.AppendVertex(vtx);
-      vtx_builder.AppendVertex(vtx);
+      AppendVertex(polyline.GetPoint(contour_start_point_i));
+      AppendVertex(polyline.GetPoint(contour_start_point_i));
     }
 
     // Generate start cap.
-    if (!polyline.contours[contour_i].is_closed) {
+    if (!contour.is_closed) {
       auto cap_offset =
           Vector2(-contour.start_direction.y, contour.start_direction.x) *
-          stroke_width * 0.5;  // Counterclockwise normal
-      cap_proc(vtx_builder, polyline.GetPoint(contour_start_point_i),
-               cap_offset, scale, true);
+          stroke_width_ * 0.5;  // Counterclockwise normal
+      AddCap(polyline.GetPoint(contour_start_point_i), cap_offset, true);
     }
 
     for (size_t contour_component_i = 0;
          contour_component_i < contour.components.size();
          contour_component_i++) {
-      auto component = contour.components[contour_component_i];
+      const auto& component = contour.components[contour_component_i];
       auto is_last_component =
           contour_component_i == contour.components.size() - 1;
 
@@ -410,13 +421,13 @@ StrokePathGeometry::CreateSolidStrokeVertices(
                             : contour.components[contour_component_i + 1]
                                   .component_start_index;
       if (component.is_curve) {
-        add_vertices_for_curve_component(
-            component_start_index, component_end_index, contour_start_point_i,
-            contour_end_point_i, contour);
+        AddVerticesForCurveComponent(polyline, component_start_index,
+                                     component_end_index, contour_start_point_i,
+                                     contour_end_point_i, contour);
       } else {
-        add_vertices_for_linear_component(
-            component_start_index, component_end_index, contour_start_point_i,
-            contour_end_point_i, contour);
+        AddVerticesForLinearComponent(
+            polyline, component_start_index, component_end_index,
+            contour_start_point_i, contour_end_point_i, contour);
       }
     }
 
@@ -424,16 +435,34 @@ StrokePathGeometry::CreateSolidStrokeVertices(
     if (!contour.is_closed) {
       auto cap_offset =
           Vector2(-contour.end_direction.y, contour.end_direction.x) *
-          stroke_width * 0.5;  // Clockwise normal
-      cap_proc(vtx_builder, polyline.GetPoint(contour_end_point_i - 1),
-               cap_offset, scale, false);
+          stroke_width_ * 0.5;  // Clockwise normal
+      AddCap(polyline.GetPoint(contour_end_point_i - 1), cap_offset, false);
     } else {
-      join_proc(vtx_builder, polyline.GetPoint(contour_start_point_i), offset,
-                contour_first_offset, scaled_miter_limit, scale);
+      AddJoin(polyline.GetPoint(contour_start_point_i), offset_,
+              contour_first_offset);
     }
   }
+}
 
-  return vtx_builder;
+}  // namespace
+
+// static
+const std::vector<Point>& StrokePathGeometry::CreateSolidStrokeVertices(
+    Tessellator& tessellator,
+    const Path& path,
+    Scalar stroke_width,
+    Scalar scaled_miter_limit,
+    Join stroke_join,
+    Cap stroke_cap,
+    Scalar scale) {
+  auto& vertices = tessellator.GetStrokePointArena();
+  {
+    auto polyline = tessellator.CreateTempPolyline(path, scale);
+    StrokeGenerator(vertices, tessellator.GetStrokeArcPoints(), stroke_width,
+                    scaled_miter_limit, stroke_join, stroke_cap, scale)
+        .Generate(polyline);
+  }
+  return vertices;
 }
 
 GeometryResult StrokePathGeometry::GetPositionBuffer(
@@ -452,14 +481,21 @@ GeometryResult StrokePathGeometry::GetPositionBuffer(
   Scalar stroke_width = std::max(stroke_width_, min_size);
 
   auto& host_buffer = renderer.GetTransientsBuffer();
-  auto vertex_builder = CreateSolidStrokeVertices(
-      path_, stroke_width, miter_limit_ * stroke_width_ * 0.5,
-      GetJoinProc(stroke_join_), GetCapProc(stroke_cap_),
+  const auto& vertices = CreateSolidStrokeVertices(
+      *renderer.GetTessellator(), path_, stroke_width,
+      miter_limit_ * stroke_width_ * 0.5, stroke_join_, stroke_cap_,
       entity.GetTransform().GetMaxBasisLength());
 
   return GeometryResult{
       .type = PrimitiveType::kTriangleStrip,
-      .vertex_buffer = vertex_builder.CreateVertexBuffer(host_buffer),
+      .vertex_buffer =
+          {
+              .vertex_buffer = host_buffer.Emplace(
+                  vertices.data(), vertices.size() * sizeof(Point),
+                  alignof(Point)),
+              .vertex_count = vertices.size(),
+              .index_type = IndexType::kNone,
+          },
       .transform = pass.GetOrthographicTransform() * entity.GetTransform(),
       .prevent_overdraw = true,
   };
@@ -483,16 +519,35 @@ GeometryResult StrokePathGeometry::GetPositionUVBuffer(
   Scalar stroke_width = std::max(stroke_width_, min_size);
 
   auto& host_buffer = renderer.GetTransientsBuffer();
-  auto stroke_builder = CreateSolidStrokeVertices(
-      path_, stroke_width, miter_limit_ * stroke_width_ * 0.5,
-      GetJoinProc(stroke_join_), GetCapProc(stroke_cap_),
+  const auto& vertices = CreateSolidStrokeVertices(
+      *renderer.GetTessellator(), path_, stroke_width,
+      miter_limit_ * stroke_width_ * 0.5, stroke_join_, stroke_cap_,
       entity.GetTransform().GetMaxBasisLength());
-  auto vertex_builder = ComputeUVGeometryCPU(
-      stroke_builder, {0, 0}, texture_coverage.GetSize(), effect_transform);
+
+  // Interleave the texture coordinates while copying into the host buffer
+  // rather than building a second vertex buffer.
+  using VS = TextureFillVertexShader;
+  const Size coverage_size = texture_coverage.GetSize();
+  auto buffer_view = host_buffer.Emplace(
+      vertices.size() * sizeof(VS::PerVertexData),
+      alignof(VS::PerVertexData),
+      [&vertices, &coverage_size, &effect_transform](uint8_t* buffer) {
+        auto* data = reinterpret_cast<VS::PerVertexData*>(buffer);
+        for (const auto& position : vertices) {
+          data->position = position;
+          data->texture_coords = effect_transform * position / coverage_size;
+          data++;
+        }
+      });
 
   return GeometryResult{
       .type = PrimitiveType::kTriangleStrip,
-      .vertex_buffer = vertex_builder.CreateVertexBuffer(host_buffer),
+      .vertex_buffer =
+          {
+              .vertex_buffer = buffer_view,
+              .vertex_count = vertices.size(),
+              .index_type = IndexType::kNone,
+          },
       .transform = pass.GetOrthographicTransform() * entity.GetTransform(),
       .prevent_overdraw = true,
   };
@@ -29,22 +29,6 @@ class StrokePathGeometry final : public Geometry {
   Join GetStrokeJoin() const;
 
  private:
-  using VS = SolidFillVertexShader;
-
-  using CapProc =
-      std::function<void(VertexBufferBuilder<VS::PerVertexData>& vtx_builder,
-                         const Point& position,
-                         const Point& offset,
-                         Scalar scale,
-                         bool reverse)>;
-  using JoinProc =
-      std::function<void(VertexBufferBuilder<VS::PerVertexData>& vtx_builder,
-                         const Point& position,
-                         const Point& start_offset,
-                         const Point& end_offset,
-                         Scalar miter_limit,
-                         Scalar scale)>;
-
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
                                    const Entity& entity,
@@ -65,23 +49,17 @@ class StrokePathGeometry final : public Geometry {
 
   bool SkipRendering() const;
 
-  static Scalar CreateBevelAndGetDirection(
-      VertexBufferBuilder<SolidFillVertexShader::PerVertexData>& vtx_builder,
-      const Point& position,
-      const Point& start_offset,
-      const Point& end_offset);
-
-  static VertexBufferBuilder<SolidFillVertexShader::PerVertexData>
-  CreateSolidStrokeVertices(const Path& path,
-                            Scalar stroke_width,
-                            Scalar scaled_miter_limit,
-                            const JoinProc& join_proc,
-                            const CapProc& cap_proc,
-                            Scalar scale);
-
-  static StrokePathGeometry::JoinProc GetJoinProc(Join stroke_join);
-
-  static StrokePathGeometry::CapProc GetCapProc(Cap stroke_cap);
+  /// Generates the triangle strip for the stroke into the tessellator's
+  /// retained stroke arena and returns it. The result is only valid until
+  /// the tessellator is used again.
+  static const std::vector<Point>& CreateSolidStrokeVertices(
+      Tessellator& tessellator,
+      const Path& path,
+      Scalar stroke_width,
+      Scalar scaled_miter_limit,
+      Join stroke_join,
+      Cap stroke_cap,
+      Scalar scale);
 
   Path path_;
   Scalar stroke_width_;
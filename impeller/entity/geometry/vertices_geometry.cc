@@ -6,7 +6,6 @@
 
 #include <utility>
 
-#include <utility>
 #include "impeller/core/formats.h"
 
 namespace impeller {
@@ -104,48 +103,54 @@ std::optional<Rect> VerticesGeometry::GetTextureCoordinateCoverge() const {
     return std::nullopt;
   }
 
-  return Rect::MakePointBounds(texture_coordinates_.begin(),
-                               texture_coordinates_.end());
+  return Rect::MakePointBounds(texture_coordinates_.data(),
+                               texture_coordinates_.size());
 }
 
-GeometryResult VerticesGeometry::GetPositionBuffer(
+std::shared_ptr<DeviceBuffer> VerticesGeometry::UploadBuffer(
     const ContentContext& renderer,
-    const Entity& entity,
-    RenderPass& pass) const {
-  auto index_count = indices_.size();
-  auto vertex_count = vertices_.size();
-
-  size_t total_vtx_bytes = vertex_count * sizeof(float) * 2;
-  size_t total_idx_bytes = index_count * sizeof(uint16_t);
+    const uint8_t* vertex_data,
+    size_t vertex_bytes) const {
+  size_t index_bytes = indices_.size() * sizeof(uint16_t);
 
   DeviceBufferDescriptor buffer_desc;
-  buffer_desc.size = total_vtx_bytes + total_idx_bytes;
+  buffer_desc.size = vertex_bytes + index_bytes;
   buffer_desc.storage_mode = StorageMode::kHostVisible;
 
   auto buffer =
       renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
+  if (!buffer) {
+    return nullptr;
+  }
 
-  if (!buffer->CopyHostBuffer(
-          reinterpret_cast<const uint8_t*>(vertices_.data()),
-          Range{0, total_vtx_bytes}, 0)) {
-    return {};
+  if (!buffer->CopyHostBuffer(vertex_data, Range{0, vertex_bytes}, 0)) {
+    return nullptr;
   }
-  if (index_count > 0 &&
+  if (index_bytes > 0 &&
       !buffer->CopyHostBuffer(
           reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(indices_.data())),
-          Range{0, total_idx_bytes}, total_vtx_bytes)) {
-    return {};
+          Range{0, index_bytes}, vertex_bytes)) {
+    return nullptr;
   }
+  return buffer;
+}
+
+GeometryResult VerticesGeometry::MakeResult(const UploadedBuffer& uploaded,
+                                            const Entity& entity,
+                                            RenderPass& pass) const {
+  auto index_count = indices_.size();
+  auto vertex_count = vertices_.size();
+  size_t index_bytes = index_count * sizeof(uint16_t);
 
   return GeometryResult{
       .type = GetPrimitiveType(),
       .vertex_buffer =
           {
-              .vertex_buffer = {.buffer = buffer,
-                                .range = Range{0, total_vtx_bytes}},
-              .index_buffer = {.buffer = buffer,
+              .vertex_buffer = {.buffer = uploaded.buffer,
+                                .range = Range{0, uploaded.vertex_bytes}},
+              .index_buffer = {.buffer = uploaded.buffer,
                                .range =
-                                   Range{total_vtx_bytes, total_idx_bytes}},
+                                   Range{uploaded.vertex_bytes, index_bytes}},
               .vertex_count = index_count > 0 ? index_count : vertex_count,
               .index_type =
                   index_count > 0 ? IndexType::k16bit : IndexType::kNone,
@@ -155,62 +160,60 @@ GeometryResult VerticesGeometry::GetPositionBuffer(
   };
 }
 
+bool VerticesGeometry::UploadedBuffer::IsValidFor(
+    const ContentContext& renderer) const {
+  return buffer && context.lock() == renderer.GetContext();
+}
+
+GeometryResult VerticesGeometry::GetPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  Lock lock(uploaded_mutex_);
+  if (!position_buffer_.IsValidFor(renderer)) {
+    size_t vertex_bytes = vertices_.size() * sizeof(float) * 2;
+    auto buffer = UploadBuffer(
+        renderer, reinterpret_cast<const uint8_t*>(vertices_.data()),
+        vertex_bytes);
+    if (!buffer) {
+      return {};
+    }
+    position_buffer_ = {renderer.GetContext(), std::move(buffer),
+                        vertex_bytes};
+  }
+  return MakeResult(position_buffer_, entity, pass);
+}
+
 GeometryResult VerticesGeometry::GetPositionColorBuffer(
     const ContentContext& renderer,
     const Entity& entity,
     RenderPass& pass) {
   using VS = GeometryColorPipeline::VertexShader;
 
-  auto index_count = indices_.size();
-  auto vertex_count = vertices_.size();
-
-  std::vector<VS::PerVertexData> vertex_data(vertex_count);
-  {
-    for (auto i = 0u; i < vertex_count; i++) {
-      vertex_data[i] = {
-          .position = vertices_[i],
-          .color = colors_[i],
-      };
+  Lock lock(uploaded_mutex_);
+  if (!position_color_buffer_.IsValidFor(renderer)) {
+    auto vertex_count = vertices_.size();
+    std::vector<VS::PerVertexData> vertex_data(vertex_count);
+    {
+      for (auto i = 0u; i < vertex_count; i++) {
+        vertex_data[i] = {
+            .position = vertices_[i],
+            .color = colors_[i],
+        };
+      }
     }
-  }
-
-  size_t total_vtx_bytes = vertex_data.size() * sizeof(VS::PerVertexData);
-  size_t total_idx_bytes = index_count * sizeof(uint16_t);
-
-  DeviceBufferDescriptor buffer_desc;
-  buffer_desc.size = total_vtx_bytes + total_idx_bytes;
-  buffer_desc.storage_mode = StorageMode::kHostVisible;
 
-  auto buffer =
-      renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
-
-  if (!buffer->CopyHostBuffer(reinterpret_cast<uint8_t*>(vertex_data.data()),
-                              Range{0, total_vtx_bytes}, 0)) {
-    return {};
-  }
-  if (index_count > 0 &&
-      !buffer->CopyHostBuffer(
-          reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(indices_.data())),
-          Range{0, total_idx_bytes}, total_vtx_bytes)) {
-    return {};
+    size_t vertex_bytes = vertex_data.size() * sizeof(VS::PerVertexData);
+    auto buffer = UploadBuffer(
+        renderer, reinterpret_cast<const uint8_t*>(vertex_data.data()),
+        vertex_bytes);
+    if (!buffer) {
+      return {};
+    }
+    position_color_buffer_ = {renderer.GetContext(), std::move(buffer),
+                              vertex_bytes};
   }
-
-  return GeometryResult{
-      .type = GetPrimitiveType(),
-      .vertex_buffer =
-          {
-              .vertex_buffer = {.buffer = buffer,
-                                .range = Range{0, total_vtx_bytes}},
-              .index_buffer = {.buffer = buffer,
-                               .range =
-                                   Range{total_vtx_bytes, total_idx_bytes}},
-              .vertex_count = index_count > 0 ? index_count : vertex_count,
-              .index_type =
-                  index_count > 0 ? IndexType::k16bit : IndexType::kNone,
-          },
-      .transform = pass.GetOrthographicTransform() * entity.GetTransform(),
-      .prevent_overdraw = false,
-  };
+  return MakeResult(position_color_buffer_, entity, pass);
 }
 
 GeometryResult VerticesGeometry::GetPositionUVBuffer(
@@ -221,66 +224,45 @@ GeometryResult VerticesGeometry::GetPositionUVBuffer(
     RenderPass& pass) const {
   using VS = TexturePipeline::VertexShader;
 
-  auto index_count = indices_.size();
-  auto vertex_count = vertices_.size();
-  auto uv_transform =
-      texture_coverage.GetNormalizingTransform() * effect_transform;
-  auto has_texture_coordinates = HasTextureCoordinates();
-  std::vector<VS::PerVertexData> vertex_data(vertex_count);
-  {
-    for (auto i = 0u; i < vertex_count; i++) {
-      auto vertex = vertices_[i];
-      auto texture_coord =
-          has_texture_coordinates ? texture_coordinates_[i] : vertices_[i];
-      auto uv = uv_transform * texture_coord;
-      // From experimentation we need to clamp these values to < 1.0 or else
-      // there can be flickering.
-      vertex_data[i] = {
-          .position = vertex,
-          .texture_coords =
-              Point(std::clamp(uv.x, 0.0f, 1.0f - kEhCloseEnough),
-                    std::clamp(uv.y, 0.0f, 1.0f - kEhCloseEnough)),
-      };
+  Lock lock(uploaded_mutex_);
+  if (!position_uv_buffer_.IsValidFor(renderer) ||
+      !(uv_texture_coverage_ == texture_coverage) ||
+      uv_effect_transform_ != effect_transform) {
+    auto vertex_count = vertices_.size();
+    auto uv_transform =
+        texture_coverage.GetNormalizingTransform() * effect_transform;
+    auto has_texture_coordinates = HasTextureCoordinates();
+    std::vector<VS::PerVertexData> vertex_data(vertex_count);
+    {
+      for (auto i = 0u; i < vertex_count; i++) {
+        auto vertex = vertices_[i];
+        auto texture_coord =
+            has_texture_coordinates ? texture_coordinates_[i] : vertices_[i];
+        auto uv = uv_transform * texture_coord;
+        // From experimentation we need to clamp these values to < 1.0 or else
+        // there can be flickering.
+        vertex_data[i] = {
+            .position = vertex,
+            .texture_coords =
+                Point(std::clamp(uv.x, 0.0f, 1.0f - kEhCloseEnough),
+                      std::clamp(uv.y, 0.0f, 1.0f - kEhCloseEnough)),
+        };
+      }
     }
-  }
-
-  size_t total_vtx_bytes = vertex_data.size() * sizeof(VS::PerVertexData);
-  size_t total_idx_bytes = index_count * sizeof(uint16_t);
-
-  DeviceBufferDescriptor buffer_desc;
-  buffer_desc.size = total_vtx_bytes + total_idx_bytes;
-  buffer_desc.storage_mode = StorageMode::kHostVisible;
-
-  auto buffer =
-      renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
 
-  if (!buffer->CopyHostBuffer(reinterpret_cast<uint8_t*>(vertex_data.data()),
-                              Range{0, total_vtx_bytes}, 0)) {
-    return {};
-  }
-  if (index_count > 0u &&
-      !buffer->CopyHostBuffer(
-          reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(indices_.data())),
-          Range{0, total_idx_bytes}, total_vtx_bytes)) {
-    return {};
+    size_t vertex_bytes = vertex_data.size() * sizeof(VS::PerVertexData);
+    auto buffer = UploadBuffer(
+        renderer, reinterpret_cast<const uint8_t*>(vertex_data.data()),
+        vertex_bytes);
+    if (!buffer) {
+      return {};
+    }
+    position_uv_buffer_ = {renderer.GetContext(), std::move(buffer),
+                           vertex_bytes};
+    uv_texture_coverage_ = texture_coverage;
+    uv_effect_transform_ = effect_transform;
   }
-
-  return GeometryResult{
-      .type = GetPrimitiveType(),
-      .vertex_buffer =
-          {
-              .vertex_buffer = {.buffer = buffer,
-                                .range = Range{0, total_vtx_bytes}},
-              .index_buffer = {.buffer = buffer,
-                               .range =
-                                   Range{total_vtx_bytes, total_idx_bytes}},
-              .vertex_count = index_count > 0 ? index_count : vertex_count,
-              .index_type =
-                  index_count > 0 ? IndexType::k16bit : IndexType::kNone,
-          },
-      .transform = pass.GetOrthographicTransform() * entity.GetTransform(),
-      .prevent_overdraw = false,
-  };
+  return MakeResult(position_uv_buffer_, entity, pass);
 }
 
 GeometryVertexType VerticesGeometry::GetVertexType() const {
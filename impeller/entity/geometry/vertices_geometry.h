@@ -5,11 +5,16 @@
 #ifndef FLUTTER_IMPELLER_ENTITY_GEOMETRY_VERTICES_GEOMETRY_H_
 #define FLUTTER_IMPELLER_ENTITY_GEOMETRY_VERTICES_GEOMETRY_H_
 
+#include "impeller/base/thread.h"
 #include "impeller/entity/geometry/geometry.h"
 
 namespace impeller {
 
 /// @brief A geometry that is created from a vertices object.
+///
+/// The device buffers created for the geometry are kept with it, so that a
+/// geometry that is drawn again (see `VerticesGeometryCache`) uploads its
+/// data once per context.
 class VerticesGeometry final : public Geometry {
  public:
   enum class VertexMode {
@@ -56,10 +61,27 @@ class VerticesGeometry final : public Geometry {
   std::optional<Rect> GetTextureCoordinateCoverge() const;
 
  private:
+  struct UploadedBuffer {
+    std::weak_ptr<Context> context;
+    std::shared_ptr<DeviceBuffer> buffer;
+    size_t vertex_bytes = 0;
+
+    bool IsValidFor(const ContentContext& renderer) const;
+  };
+
   void NormalizeIndices();
 
   PrimitiveType GetPrimitiveType() const;
 
+  /// Creates a buffer holding `vertex_data` followed by the indices.
+  std::shared_ptr<DeviceBuffer> UploadBuffer(const ContentContext& renderer,
+                                             const uint8_t* vertex_data,
+                                             size_t vertex_bytes) const;
+
+  GeometryResult MakeResult(const UploadedBuffer& uploaded,
+                            const Entity& entity,
+                            RenderPass& pass) const;
+
   std::vector<Point> vertices_;
   std::vector<Color> colors_;
   std::vector<Point> texture_coordinates_;
@@ -67,6 +89,14 @@ class VerticesGeometry final : public Geometry {
   Rect bounds_;
   VerticesGeometry::VertexMode vertex_mode_ =
       VerticesGeometry::VertexMode::kTriangles;
+
+  mutable Mutex uploaded_mutex_;
+  mutable UploadedBuffer position_buffer_ IPLR_GUARDED_BY(uploaded_mutex_);
+  mutable UploadedBuffer position_color_buffer_
+      IPLR_GUARDED_BY(uploaded_mutex_);
+  mutable UploadedBuffer position_uv_buffer_ IPLR_GUARDED_BY(uploaded_mutex_);
+  mutable Rect uv_texture_coverage_ IPLR_GUARDED_BY(uploaded_mutex_);
+  mutable Matrix uv_effect_transform_ IPLR_GUARDED_BY(uploaded_mutex_);
 };
 
 }  // namespace impeller
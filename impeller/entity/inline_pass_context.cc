@@ -7,6 +7,8 @@
 #include <utility>
 
 #include "flutter/fml/status.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/allocation.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
@@ -16,6 +18,71 @@
 
 namespace impeller {
 
+DeferredSubmissions::DeferredSubmissions() = default;
+
+DeferredSubmissions::~DeferredSubmissions() {
+  FML_DCHECK(submissions_.empty())
+      << "Deferred render passes were dropped without being submitted.";
+}
+
+void DeferredSubmissions::Add(std::shared_ptr<CommandBuffer> command_buffer,
+                              std::shared_ptr<RenderPass> render_pass) {
+  submissions_.push_back({.command_buffer = std::move(command_buffer),
+                          .render_pass = std::move(render_pass)});
+}
+
+bool DeferredSubmissions::IsEmpty() const {
+  return submissions_.empty();
+}
+
+size_t DeferredSubmissions::GetCount() const {
+  return submissions_.size();
+}
+
+bool DeferredSubmissions::EncodeAndSubmit(const Context& context) {
+  if (submissions_.empty()) {
+    return true;
+  }
+  TRACE_EVENT1("impeller", "DeferredSubmissions::EncodeAndSubmit", "count",
+               std::to_string(submissions_.size()).c_str());
+
+  std::vector<Submission> submissions;
+  std::swap(submissions, submissions_);
+
+  auto task_runner = context.GetConcurrentEncodingTaskRunner();
+  if (!task_runner || submissions.size() == 1u) {
+    bool success = true;
+    for (const auto& submission : submissions) {
+      if (!submission.command_buffer->EncodeAndSubmit(
+              submission.render_pass)) {
+        success = false;
+      }
+    }
+    return success;
+  }
+
+  // Encoding touches nothing but the pass and its own command buffer, so the
+  // passes can be encoded in parallel. Submission must still happen in order.
+  std::vector<uint8_t> encoded(submissions.size(), 0u);
+  fml::CountDownLatch latch(submissions.size());
+  for (size_t i = 0; i < submissions.size(); i++) {
+    task_runner->PostTask([&submissions, &encoded, &latch, i]() {
+      encoded[i] = submissions[i].render_pass->EncodeCommands() ? 1u : 0u;
+      latch.CountDown();
+    });
+  }
+  latch.Wait();
+
+  bool success = true;
+  for (size_t i = 0; i < submissions.size(); i++) {
+    if (!encoded[i] || !submissions[i].command_buffer->SubmitCommands()) {
+      VALIDATION_LOG << "Failed to encode and submit a deferred render pass.";
+      success = false;
+    }
+  }
+  return success;
+}
+
 InlinePassContext::InlinePassContext(
     std::shared_ptr<Context> context,
     EntityPassTarget& pass_target,
@@ -53,6 +120,28 @@ std::shared_ptr<Texture> InlinePassContext::GetTexture() {
 }
 
 bool InlinePassContext::EndPass() {
+  if (deferred_submissions_ && !is_collapsed_) {
+    if (!IsActive()) {
+      return true;
+    }
+    FML_DCHECK(GetPassTarget()
+                   .GetRenderTarget()
+                   .GetRenderTargetTexture()
+                   ->GetMipCount() == 1);
+    if (command_buffer_) {
+      deferred_submissions_->Add(std::move(command_buffer_), std::move(pass_));
+    }
+    pass_ = nullptr;
+    command_buffer_ = nullptr;
+    return true;
+  }
+
+  // Passes from independent children must reach the GPU before this one,
+  // which samples their textures.
+  if (!GetDeferredSubmissions()->EncodeAndSubmit(*context_)) {
+    return false;
+  }
+
   if (!IsActive()) {
     return true;
   }
@@ -187,4 +276,14 @@ uint32_t InlinePassContext::GetPassCount() const {
   return pass_count_;
 }
 
+void InlinePassContext::SetDeferredSubmissions(
+    DeferredSubmissions* deferred_submissions) {
+  deferred_submissions_ = deferred_submissions;
+}
+
+DeferredSubmissions* InlinePassContext::GetDeferredSubmissions() {
+  return deferred_submissions_ ? deferred_submissions_
+                               : &owned_deferred_submissions_;
+}
+
 }  // namespace impeller
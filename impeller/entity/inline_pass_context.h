@@ -6,14 +6,57 @@
 #define FLUTTER_IMPELLER_ENTITY_INLINE_PASS_CONTEXT_H_
 
 #include <cstdint>
+#include <vector>
 
 #include "impeller/entity/entity_pass_target.h"
+#include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/render_target.h"
 
 namespace impeller {
 
+//------------------------------------------------------------------------------
+/// @brief  An ordered list of render passes whose encoding and submission has
+///         been deferred.
+///
+///         Passes are submitted in the order they were added. If the context
+///         provides a concurrent encoding task runner, the passes are encoded
+///         on its workers before being submitted on the calling thread.
+///
+class DeferredSubmissions {
+ public:
+  DeferredSubmissions();
+
+  ~DeferredSubmissions();
+
+  void Add(std::shared_ptr<CommandBuffer> command_buffer,
+           std::shared_ptr<RenderPass> render_pass);
+
+  bool IsEmpty() const;
+
+  size_t GetCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief  Encode and submit all pending passes, leaving the list empty.
+  ///
+  /// @return Whether all passes were encoded and submitted successfully.
+  ///
+  [[nodiscard]] bool EncodeAndSubmit(const Context& context);
+
+ private:
+  struct Submission {
+    std::shared_ptr<CommandBuffer> command_buffer;
+    std::shared_ptr<RenderPass> render_pass;
+  };
+
+  std::vector<Submission> submissions_;
+
+  DeferredSubmissions(const DeferredSubmissions&) = delete;
+
+  DeferredSubmissions& operator=(const DeferredSubmissions&) = delete;
+};
+
 class InlinePassContext {
  public:
   struct RenderPassResult {
@@ -44,6 +87,22 @@ class InlinePassContext {
 
   RenderPassResult GetRenderPass(uint32_t pass_depth);
 
+  //----------------------------------------------------------------------------
+  /// @brief  Defer the submission of passes ended by this context to
+  ///         `deferred_submissions`, which is owned by an ancestor context.
+  ///
+  ///         This is only valid for passes that don't read from their own
+  ///         texture between passes and don't require mipmap generation.
+  ///
+  void SetDeferredSubmissions(DeferredSubmissions* deferred_submissions);
+
+  //----------------------------------------------------------------------------
+  /// @brief  The list that independent child passes should append their
+  ///         submissions to. These are flushed before this context submits
+  ///         any of its own passes.
+  ///
+  DeferredSubmissions* GetDeferredSubmissions();
+
  private:
   std::shared_ptr<Context> context_;
   EntityPassTarget& pass_target_;
@@ -51,6 +110,8 @@ class InlinePassContext {
   std::shared_ptr<RenderPass> pass_;
   uint32_t pass_count_ = 0;
   uint32_t entity_count_ = 0;
+  DeferredSubmissions owned_deferred_submissions_;
+  DeferredSubmissions* deferred_submissions_ = nullptr;
 
   // Whether this context is collapsed into a parent entity pass.
   bool is_collapsed_ = false;
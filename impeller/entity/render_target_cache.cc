@@ -3,12 +3,25 @@
 // found in the LICENSE file.
 
 #include "impeller/entity/render_target_cache.h"
+
+#include <algorithm>
+
 #include "impeller/renderer/render_target.h"
 
 namespace impeller {
 
-RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator)
-    : RenderTargetAllocator(std::move(allocator)) {}
+static size_t GetTextureByteSize(const Texture& texture) {
+  const auto& desc = texture.GetTextureDescriptor();
+  return desc.GetByteSizeOfBaseMipLevel() *
+         static_cast<size_t>(desc.sample_count);
+}
+
+RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator,
+                                     size_t keep_alive_frame_count,
+                                     size_t max_unused_bytes)
+    : RenderTargetAllocator(std::move(allocator)),
+      keep_alive_frame_count_(keep_alive_frame_count),
+      max_unused_bytes_(max_unused_bytes) {}
 
 void RenderTargetCache::Start() {
   for (auto& td : texture_data_) {
@@ -19,14 +32,49 @@ void RenderTargetCache::Start() {
 void RenderTargetCache::End() {
   std::vector<TextureData> retain;
 
+  for (auto& td : texture_data_) {
+    td.unused_frame_count = td.used_this_frame ? 0u : td.unused_frame_count + 1;
+    if (td.unused_frame_count <= keep_alive_frame_count_) {
+      retain.push_back(td);
+    }
+  }
+
+  // Keep the textures unused for the shortest time within the byte limit.
+  std::stable_sort(retain.begin(), retain.end(),
+                   [](const TextureData& a, const TextureData& b) {
+                     return a.unused_frame_count < b.unused_frame_count;
+                   });
+  size_t unused_bytes = 0u;
+  auto end = std::find_if(retain.begin(), retain.end(), [&](const auto& td) {
+    if (td.unused_frame_count == 0u) {
+      return false;
+    }
+    unused_bytes += GetTextureByteSize(*td.texture);
+    return unused_bytes > max_unused_bytes_;
+  });
+  retain.erase(end, retain.end());
+  texture_data_.swap(retain);
+}
+
+void RenderTargetCache::Trim() {
+  std::vector<TextureData> retain;
+
   for (const auto& td : texture_data_) {
-    if (td.used_this_frame) {
+    if (td.texture.use_count() > 1) {
       retain.push_back(td);
     }
   }
   texture_data_.swap(retain);
 }
 
+size_t RenderTargetCache::GetCachedBytes() const {
+  size_t bytes = 0u;
+  for (const auto& td : texture_data_) {
+    bytes += GetTextureByteSize(*td.texture);
+  }
+  return bytes;
+}
+
 size_t RenderTargetCache::CachedTextureCount() const {
   return texture_data_.size();
 }
@@ -40,7 +88,11 @@ std::shared_ptr<Texture> RenderTargetCache::CreateTexture(
   for (auto& td : texture_data_) {
     const auto other_desc = td.texture->GetTextureDescriptor();
     FML_DCHECK(td.texture != nullptr);
-    if (!td.used_this_frame && desc == other_desc) {
+    if (desc != other_desc) {
+      continue;
+    }
+    // Textures only owned by the cache can be reused in the same frame.
+    if (!td.used_this_frame || td.texture.use_count() == 1) {
       td.used_this_frame = true;
       return td.texture;
     }
@@ -10,12 +10,24 @@
 namespace impeller {
 
 /// @brief An implementation of the [RenderTargetAllocator] that caches all
-///        allocated texture data for one frame.
+///        allocated texture data across frames.
 ///
-///        Any textures unused after a frame are immediately discarded.
+///        Textures unused during a frame are kept for up to
+///        `keep_alive_frame_count` more frames, as long as the unused textures
+///        don't add up to more than `max_unused_bytes`; the textures unused
+///        for the longest are discarded first. By default, any textures
+///        unused after a frame are immediately discarded.
+///
+///        Within a frame, a texture that is no longer referenced outside of
+///        the cache is handed out again. Its lifetime has ended, as render
+///        passes and command buffers keep the textures they use alive until
+///        they no longer need them, so intermediates whose lifetimes don't
+///        overlap share the same memory.
 class RenderTargetCache : public RenderTargetAllocator {
  public:
-  explicit RenderTargetCache(std::shared_ptr<Allocator> allocator);
+  explicit RenderTargetCache(std::shared_ptr<Allocator> allocator,
+                             size_t keep_alive_frame_count = 0u,
+                             size_t max_unused_bytes = 0u);
 
   ~RenderTargetCache() = default;
 
@@ -25,6 +37,12 @@ class RenderTargetCache : public RenderTargetAllocator {
   // |RenderTargetAllocator|
   void End() override;
 
+  // |RenderTargetAllocator|
+  void Trim() override;
+
+  // |RenderTargetAllocator|
+  size_t GetCachedBytes() const override;
+
   // |RenderTargetAllocator|
   std::shared_ptr<Texture> CreateTexture(
       const TextureDescriptor& desc) override;
@@ -36,9 +54,13 @@ class RenderTargetCache : public RenderTargetAllocator {
   struct TextureData {
     bool used_this_frame;
     std::shared_ptr<Texture> texture;
+    /// The number of frames since the texture was last used.
+    size_t unused_frame_count = 0u;
   };
 
   std::vector<TextureData> texture_data_;
+  size_t keep_alive_frame_count_;
+  size_t max_unused_bytes_;
 
   RenderTargetCache(const RenderTargetCache&) = delete;
 
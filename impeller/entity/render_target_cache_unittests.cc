@@ -53,23 +53,129 @@ TEST(RenderTargetCacheTest, CachesUsedTexturesAcrossFrames) {
   render_target_cache.Start();
   // Create two textures of the same exact size/shape. Both should be marked
   // as used this frame, so the cached data set will contain two.
-  render_target_cache.CreateTexture(desc);
-  render_target_cache.CreateTexture(desc);
+  {
+    auto first = render_target_cache.CreateTexture(desc);
+    auto second = render_target_cache.CreateTexture(desc);
 
-  ASSERT_EQ(render_target_cache.CachedTextureCount(), 2u);
+    ASSERT_EQ(render_target_cache.CachedTextureCount(), 2u);
+  }
 
   render_target_cache.End();
   render_target_cache.Start();
 
   // Next frame, only create one texture. The set will still contain two,
   // but one will be removed at the end of the frame.
-  render_target_cache.CreateTexture(desc);
+  auto texture = render_target_cache.CreateTexture(desc);
   ASSERT_EQ(render_target_cache.CachedTextureCount(), 2u);
 
   render_target_cache.End();
   ASSERT_EQ(render_target_cache.CachedTextureCount(), 1u);
 }
 
+TEST(RenderTargetCacheTest, ReportsTheBytesOfCachedTextures) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache = RenderTargetCache(allocator);
+  auto desc = TextureDescriptor{
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .size = ISize(100, 100),
+      .usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)};
+  ASSERT_EQ(render_target_cache.GetCachedBytes(), 0u);
+
+  render_target_cache.Start();
+  {
+    auto first = render_target_cache.CreateTexture(desc);
+    auto second = render_target_cache.CreateTexture(desc);
+    ASSERT_EQ(render_target_cache.GetCachedBytes(), 80000u);
+  }
+  render_target_cache.End();
+  ASSERT_EQ(render_target_cache.GetCachedBytes(), 80000u);
+
+  render_target_cache.Start();
+  render_target_cache.End();
+  ASSERT_EQ(render_target_cache.GetCachedBytes(), 0u);
+}
+
+TEST(RenderTargetCacheTest, KeepsUnusedTexturesAliveForFrameCount) {
+  auto allocator = std::make_shared<TestAllocator>();
+  // Each texture is 40000 bytes, so only one unused texture fits the limit.
+  auto render_target_cache = RenderTargetCache(allocator,
+                                               /*keep_alive_frame_count=*/2u,
+                                               /*max_unused_bytes=*/50000u);
+  auto desc = TextureDescriptor{
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .size = ISize(100, 100),
+      .usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)};
+
+  render_target_cache.Start();
+  {
+    auto first = render_target_cache.CreateTexture(desc);
+    auto second = render_target_cache.CreateTexture(desc);
+  }
+  render_target_cache.End();
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 2u);
+
+  // Neither texture is used, and only one fits in the unused byte limit.
+  render_target_cache.Start();
+  render_target_cache.End();
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 1u);
+
+  render_target_cache.Start();
+  render_target_cache.End();
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 1u);
+
+  // The texture has now been unused for longer than the keep alive count.
+  render_target_cache.Start();
+  render_target_cache.End();
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 0u);
+}
+
+TEST(RenderTargetCacheTest, TrimReleasesTexturesNotInUse) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache = RenderTargetCache(allocator);
+  auto desc = TextureDescriptor{
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .size = ISize(100, 100),
+      .usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)};
+
+  render_target_cache.Start();
+  auto texture = render_target_cache.CreateTexture(desc);
+  render_target_cache.CreateTexture(desc);
+  render_target_cache.End();
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 2u);
+
+  render_target_cache.Trim();
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 1u);
+
+  texture.reset();
+  render_target_cache.Trim();
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 0u);
+}
+
+TEST(RenderTargetCacheTest, ReusesReleasedTexturesWithinFrame) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache = RenderTargetCache(allocator);
+  auto desc = TextureDescriptor{
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .size = ISize(100, 100),
+      .usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)};
+
+  render_target_cache.Start();
+  auto first = render_target_cache.CreateTexture(desc);
+  Texture* first_ptr = first.get();
+
+  // A texture that is still referenced is not handed out again.
+  auto second = render_target_cache.CreateTexture(desc);
+  EXPECT_NE(second.get(), first_ptr);
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 2u);
+
+  // Once released, its memory is reused by the next intermediate.
+  first.reset();
+  auto third = render_target_cache.CreateTexture(desc);
+  EXPECT_EQ(third.get(), first_ptr);
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 2u);
+  render_target_cache.End();
+}
+
 TEST(RenderTargetCacheTest, DoesNotPersistFailedAllocations) {
   auto allocator = std::make_shared<TestAllocator>();
   auto render_target_cache = RenderTargetCache(allocator);
@@ -24,6 +24,9 @@ in vec2 unit_position;
 in vec2 glyph_position;
 
 out vec2 v_uv;
+// The number of screen pixels covered by an atlas pixel, which antialiases
+// the edges of signed distance field glyphs.
+out float v_pixels_per_texel;
 
 IMPELLER_MAYBE_FLAT out f16vec4 v_text_color;
 
@@ -81,5 +84,8 @@ void main() {
 
   gl_Position = frame_info.mvp * position;
   v_uv = uv_origin + unit_position * uv_size;
+  v_pixels_per_texel =
+      length((basis_transform * vec4(glyph_bounds.z, 0.0, 0.0, 0.0)).xy) /
+      max(atlas_glyph_bounds.z, 1.0);
   v_text_color = frame_info.text_color;
 }
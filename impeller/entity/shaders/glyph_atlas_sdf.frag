@@ -0,0 +1,33 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+precision mediump float;
+
+#include <impeller/types.glsl>
+
+uniform f16sampler2D glyph_atlas_sampler;
+
+uniform FragInfo {
+  // The distance in atlas pixels from the outlines of the glyphs at which the
+  // distance fields saturate.
+  float spread;
+}
+frag_info;
+
+in highp vec2 v_uv;
+in highp float v_pixels_per_texel;
+
+IMPELLER_MAYBE_FLAT in f16vec4 v_text_color;
+
+out f16vec4 frag_color;
+
+void main() {
+  float value = float(texture(glyph_atlas_sampler, v_uv).a);
+  // The signed distance in screen pixels from the outline, positive inside of
+  // the glyph, over which the edge is antialiased.
+  float distance =
+      (value - 0.5) * 2.0 * frag_info.spread * v_pixels_per_texel;
+  float16_t coverage = float16_t(clamp(distance + 0.5, 0.0, 1.0));
+  frag_color = coverage * v_text_color;
+}
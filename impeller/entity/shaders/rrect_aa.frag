@@ -0,0 +1,44 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+precision highp float;
+
+#include <impeller/types.glsl>
+
+uniform FragInfo {
+  vec4 color;
+  vec2 half_size;
+  vec2 radii;
+}
+frag_info;
+
+in vec2 v_position;
+
+out vec4 frag_color;
+
+/// Approximate signed distance to a rectangle centered at the origin whose
+/// corners are quarter ellipses with the given radii.
+float RRectDistance(vec2 position, vec2 half_size, vec2 radii) {
+  vec2 edge = abs(position) - half_size;
+  vec2 corner = edge + radii;
+  if (corner.x <= 0.0 || corner.y <= 0.0) {
+    return max(edge.x, edge.y);
+  }
+  if (radii.x * radii.y <= 0.0) {
+    return length(corner);
+  }
+  // First order approximation of the distance to the corner ellipse, which is
+  // accurate close to its edge where the coverage is fractional.
+  vec2 inv_radii = 1.0 / radii;
+  vec2 unit = corner * inv_radii;
+  float implicit = dot(unit, unit) - 1.0;
+  vec2 gradient = 2.0 * unit * inv_radii;
+  return implicit / max(length(gradient), 1e-6);
+}
+
+void main() {
+  float signed_distance =
+      RRectDistance(v_position, frag_info.half_size, frag_info.radii);
+  frag_color = frag_info.color * clamp(0.5 - signed_distance, 0.0, 1.0);
+}
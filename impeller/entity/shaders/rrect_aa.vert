@@ -0,0 +1,22 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <impeller/types.glsl>
+
+uniform FrameInfo {
+  mat4 mvp;
+  vec2 pixel_scale;
+}
+frame_info;
+
+in vec2 position;
+
+out vec2 v_position;
+
+void main() {
+  gl_Position = frame_info.mvp * vec4(position, 0.0, 1.0);
+  // The fragment stage measures distances in approximate device pixels
+  // relative to the center of the rrect.
+  v_position = position * frame_info.pixel_scale;
+}
@@ -0,0 +1,55 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <impeller/conversions.glsl>
+#include <impeller/types.glsl>
+
+#ifdef IMPELLER_TARGET_OPENGLES
+
+void main() {
+  // Instancing is not supported on legacy targets. Callers fall back to
+  // TextureFill with CPU expanded vertices instead.
+}
+
+#else  // IMPELLER_TARGET_OPENGLES
+
+uniform FrameInfo {
+  mat4 mvp;
+  vec2 texture_size;
+  float texture_sampler_y_coord_scale;
+  float16_t alpha;
+}
+frame_info;
+
+struct InstanceData {
+  mat4 transform;
+  // The sample rect in texels, as (x, y, width, height).
+  vec4 texture_rect;
+};
+
+layout(std140) readonly buffer InstanceInfo {
+  InstanceData instances[];
+}
+instance_info;
+
+// The corner of the unit quad, in the range [0, 1].
+in vec2 unit_position;
+
+out vec2 v_texture_coords;
+IMPELLER_MAYBE_FLAT out float16_t v_alpha;
+
+void main() {
+  InstanceData instance = instance_info.instances[gl_InstanceIndex];
+  vec2 size = instance.texture_rect.zw;
+  vec4 position = instance.transform * vec4(unit_position * size, 0.0, 1.0);
+  gl_Position = frame_info.mvp * position;
+  v_alpha = frame_info.alpha;
+  vec2 texture_coords =
+      (instance.texture_rect.xy + unit_position * size) /
+      frame_info.texture_size;
+  v_texture_coords = IPRemapCoords(texture_coords,
+                                   frame_info.texture_sampler_y_coord_scale);
+}
+
+#endif  // IMPELLER_TARGET_OPENGLES
@@ -4,8 +4,10 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 
+#include "impeller/geometry/matrix.h"
 #include "impeller/geometry/path.h"
 #include "impeller/geometry/path_builder.h"
+#include "impeller/geometry/rect.h"
 #include "impeller/tessellator/tessellator.h"
 
 namespace impeller {
@@ -32,6 +34,8 @@ static void BM_Polyline(benchmark::State& state, Args&&... args) {
   size_t single_point_count = 0u;
   auto points = std::make_unique<std::vector<Point>>();
   points->reserve(2048);
+  // Measure the tessellation itself rather than cache lookups.
+  tess.SetCacheByteBudget(0u);
   while (state.KeepRunning()) {
     if (tessellate) {
       tess.Tessellate(path, 1.0f,
@@ -73,6 +77,7 @@ static void BM_Convex(benchmark::State& state, Args&&... args) {
   size_t single_point_count = 0u;
   auto points = std::make_unique<std::vector<Point>>();
   points->reserve(2048);
+  tess.SetCacheByteBudget(0u);
   while (state.KeepRunning()) {
     auto points = tess.TessellateConvex(path, 1.0f);
     single_point_count = points.size();
@@ -82,6 +87,53 @@ static void BM_Convex(benchmark::State& state, Args&&... args) {
   state.counters["TotalPointCount"] = point_count;
 }
 
+static std::vector<Point> CreatePoints(size_t count) {
+  std::vector<Point> points;
+  points.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    points.emplace_back(static_cast<Scalar>(i % 97) * 3.5f,
+                        static_cast<Scalar>(i % 89) * -2.25f);
+  }
+  return points;
+}
+
+static void BM_MatrixMultiply(benchmark::State& state) {
+  Matrix a = Matrix::MakeTranslation({10, 20, 0}) *
+             Matrix::MakeRotationZ(Radians{0.5}) *
+             Matrix::MakeScale({2, 3, 1});
+  Matrix b = Matrix::MakeScale({1.01, 0.99, 1});
+  while (state.KeepRunning()) {
+    a = a * b;
+    benchmark::DoNotOptimize(a);
+  }
+}
+
+static void BM_TransformPoints(benchmark::State& state) {
+  auto points = CreatePoints(state.range(0));
+  std::vector<Point> result(points.size());
+  Matrix transform = Matrix::MakeTranslation({10, 20, 0}) *
+                     Matrix::MakeRotationZ(Radians{0.5}) *
+                     Matrix::MakeScale({2, 3, 1});
+  while (state.KeepRunning()) {
+    transform.TransformPoints(points.data(), result.data(), points.size());
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+static void BM_PointBounds(benchmark::State& state) {
+  auto points = CreatePoints(state.range(0));
+  while (state.KeepRunning()) {
+    auto bounds = Rect::MakePointBounds(points.data(), points.size());
+    benchmark::DoNotOptimize(bounds);
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+BENCHMARK(BM_MatrixMultiply);
+BENCHMARK(BM_TransformPoints)->Arg(4)->Arg(64)->Arg(1024);
+BENCHMARK(BM_PointBounds)->Arg(4)->Arg(64)->Arg(1024);
+
 BENCHMARK_CAPTURE(BM_Polyline, cubic_polyline, CreateCubic(), false);
 BENCHMARK_CAPTURE(BM_Polyline, cubic_polyline_tess, CreateCubic(), true);
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline, CreateQuadratic(), false);
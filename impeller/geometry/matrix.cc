@@ -7,8 +7,18 @@
 #include <climits>
 #include <sstream>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define IMPELLER_GEOMETRY_USE_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define IMPELLER_GEOMETRY_USE_NEON 1
+#endif
+
 namespace impeller {
 
+static_assert(sizeof(Point) == 2 * sizeof(Scalar));
+
 Matrix::Matrix(const MatrixDecomposition& d) : Matrix() {
   /*
    *  Apply perspective.
@@ -406,4 +416,85 @@ uint64_t MatrixDecomposition::GetComponentsMask() const {
   return mask;
 }
 
+Matrix Matrix::operator*(const Matrix& o) const {
+  // Each column of the result is a linear combination of the columns of this
+  // matrix, weighted by the matching column of |o|. The additions happen in
+  // the same order as in |Multiply|.
+#if defined(IMPELLER_GEOMETRY_USE_SSE2)
+  const __m128 c0 = _mm_loadu_ps(&m[0]);
+  const __m128 c1 = _mm_loadu_ps(&m[4]);
+  const __m128 c2 = _mm_loadu_ps(&m[8]);
+  const __m128 c3 = _mm_loadu_ps(&m[12]);
+  Matrix result;
+  for (int i = 0; i < 4; i++) {
+    const Scalar* oc = &o.m[i * 4];
+    __m128 r = _mm_mul_ps(c0, _mm_set1_ps(oc[0]));
+    r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(oc[1])));
+    r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(oc[2])));
+    r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_set1_ps(oc[3])));
+    _mm_storeu_ps(&result.m[i * 4], r);
+  }
+  return result;
+#elif defined(IMPELLER_GEOMETRY_USE_NEON)
+  const float32x4_t c0 = vld1q_f32(&m[0]);
+  const float32x4_t c1 = vld1q_f32(&m[4]);
+  const float32x4_t c2 = vld1q_f32(&m[8]);
+  const float32x4_t c3 = vld1q_f32(&m[12]);
+  Matrix result;
+  for (int i = 0; i < 4; i++) {
+    const float32x4_t oc = vld1q_f32(&o.m[i * 4]);
+    // Multiply and add separately rather than fusing to stay close to the
+    // rounding of the scalar path.
+    float32x4_t r = vmulq_laneq_f32(c0, oc, 0);
+    r = vaddq_f32(r, vmulq_laneq_f32(c1, oc, 1));
+    r = vaddq_f32(r, vmulq_laneq_f32(c2, oc, 2));
+    r = vaddq_f32(r, vmulq_laneq_f32(c3, oc, 3));
+    vst1q_f32(&result.m[i * 4], r);
+  }
+  return result;
+#else
+  return Multiply(o);
+#endif
+}
+
+void Matrix::TransformPoints(const Point* src, Point* dst, size_t count) const {
+  size_t i = 0;
+  // Without perspective w is always 1 and each point is simply
+  // (x * m0 + y * m4 + m12, x * m1 + y * m5 + m13).
+  if (m[3] == 0 && m[7] == 0 && m[15] == 1) {
+#if defined(IMPELLER_GEOMETRY_USE_SSE2)
+    const __m128 basis_x = _mm_setr_ps(m[0], m[1], m[0], m[1]);
+    const __m128 basis_y = _mm_setr_ps(m[4], m[5], m[4], m[5]);
+    const __m128 translation = _mm_setr_ps(m[12], m[13], m[12], m[13]);
+    for (; i + 2 <= count; i += 2) {
+      // {x0, y0, x1, y1}
+      const __m128 p = _mm_loadu_ps(&src[i].x);
+      const __m128 xs = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 0, 0));
+      const __m128 ys = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 1, 1));
+      const __m128 r = _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(xs, basis_x), _mm_mul_ps(ys, basis_y)),
+          translation);
+      _mm_storeu_ps(&dst[i].x, r);
+    }
+#elif defined(IMPELLER_GEOMETRY_USE_NEON)
+    const float32x4_t basis_x = {m[0], m[1], m[0], m[1]};
+    const float32x4_t basis_y = {m[4], m[5], m[4], m[5]};
+    const float32x4_t translation = {m[12], m[13], m[12], m[13]};
+    for (; i + 2 <= count; i += 2) {
+      // {x0, y0, x1, y1}
+      const float32x4_t p = vld1q_f32(&src[i].x);
+      const float32x4_t xs = vtrn1q_f32(p, p);
+      const float32x4_t ys = vtrn2q_f32(p, p);
+      const float32x4_t r = vaddq_f32(
+          vaddq_f32(vmulq_f32(xs, basis_x), vmulq_f32(ys, basis_y)),
+          translation);
+      vst1q_f32(&dst[i].x, r);
+    }
+#endif
+  }
+  for (; i < count; i++) {
+    dst[i] = *this * src[i];
+  }
+}
+
 }  // namespace impeller
@@ -392,7 +392,9 @@ struct Matrix {
 
   Matrix operator-(const Vector3& t) const { return Translate(-t); }
 
-  Matrix operator*(const Matrix& m) const { return Multiply(m); }
+  /// @brief  Equivalent to |Multiply| but uses SSE2 or NEON where available.
+  ///         Prefer this over |Multiply| outside of constant expressions.
+  Matrix operator*(const Matrix& m) const;
 
   Matrix operator+(const Matrix& m) const;
 
@@ -446,6 +448,12 @@ struct Matrix {
     return Vector2(v.x * m[0] + v.y * m[4], v.x * m[1] + v.y * m[5]);
   }
 
+  /// @brief  Transforms |count| points from |src| into |dst|, which may
+  ///         alias. Equivalent to applying |operator*| to each point, but
+  ///         processes two points at a time using SSE2 or NEON when the
+  ///         matrix has no perspective.
+  void TransformPoints(const Point* src, Point* dst, size_t count) const;
+
   constexpr Quad Transform(const Quad& quad) const {
     return {
         *this * quad[0],
@@ -24,5 +24,40 @@ TEST(MatrixTest, Multiply) {
                                         11.0, 21.0, 0.0, 1.0)));
 }
 
+TEST(MatrixTest, MultiplyOperatorMatchesMultiply) {
+  Matrix a = Matrix::MakeTranslation({10, 20, 30}) *
+             Matrix::MakeRotationZ(Radians{0.5}) *
+             Matrix::MakeScale({2, 3, 4});
+  Matrix b = Matrix::MakePerspective(Radians{1.0}, 1.5, 0.1, 100) *
+             Matrix::MakeRotationX(Radians{0.25});
+  EXPECT_TRUE(MatrixNear(a * b, a.Multiply(b)));
+  EXPECT_TRUE(MatrixNear(b * a, b.Multiply(a)));
+}
+
+TEST(MatrixTest, TransformPointsMatchesPointMultiply) {
+  std::vector<Point> points;
+  for (int i = 0; i < 9; i++) {
+    points.emplace_back(i * 3.5f - 10.0f, 7.0f - i * 1.25f);
+  }
+  Matrix affine = Matrix::MakeTranslation({10, 20, 0}) *
+                  Matrix::MakeRotationZ(Radians{0.5}) *
+                  Matrix::MakeScale({2, 3, 1});
+  Matrix perspective = Matrix::MakePerspective(Radians{1.0}, 1.5, 0.1, 100) *
+                       Matrix::MakeTranslation({0, 0, -10});
+
+  for (const Matrix& matrix : {affine, perspective}) {
+    std::vector<Point> result(points.size());
+    matrix.TransformPoints(points.data(), result.data(), points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+      EXPECT_POINT_NEAR(result[i], matrix * points[i]);
+    }
+
+    // Transforming in place is supported.
+    std::vector<Point> in_place = points;
+    matrix.TransformPoints(in_place.data(), in_place.data(), in_place.size());
+    EXPECT_EQ(in_place, result);
+  }
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -7,6 +7,7 @@
 #include <optional>
 #include <variant>
 
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
 #include "impeller/geometry/path_component.h"
 #include "impeller/geometry/point.h"
@@ -60,11 +61,28 @@ bool Path::IsConvex() const {
   return convexity_ == Convexity::kConvex;
 }
 
+size_t Path::GetContentHash() const {
+  size_t hash = fml::HashCombine(static_cast<int>(fill_), points_.size(),
+                                 components_.size(), contours_.size());
+  for (const auto& component : components_) {
+    fml::HashCombineSeed(hash, static_cast<int>(component.type));
+  }
+  for (const auto& point : points_) {
+    fml::HashCombineSeed(hash, point.x, point.y);
+  }
+  for (const auto& contour : contours_) {
+    fml::HashCombineSeed(hash, contour.destination.x, contour.destination.y,
+                         contour.is_closed);
+  }
+  return hash;
+}
+
 void Path::SetConvexity(Convexity value) {
   convexity_ = value;
 }
 
 void Path::Shift(Point shift) {
+  polyline_cache_.reset();
   for (auto i = 0u; i < points_.size(); i++) {
     points_[i] += shift;
   }
@@ -79,6 +97,7 @@ Path Path::Clone() const {
 }
 
 Path& Path::AddLinearComponent(const Point& p1, const Point& p2) {
+  polyline_cache_.reset();
   auto index = points_.size();
   points_.emplace_back(p1);
   points_.emplace_back(p2);
@@ -89,6 +108,7 @@ Path& Path::AddLinearComponent(const Point& p1, const Point& p2) {
 Path& Path::AddQuadraticComponent(const Point& p1,
                                   const Point& cp,
                                   const Point& p2) {
+  polyline_cache_.reset();
   auto index = points_.size();
   points_.emplace_back(p1);
   points_.emplace_back(cp);
@@ -101,6 +121,7 @@ Path& Path::AddCubicComponent(const Point& p1,
                               const Point& cp1,
                               const Point& cp2,
                               const Point& p2) {
+  polyline_cache_.reset();
   auto index = points_.size();
   points_.emplace_back(p1);
   points_.emplace_back(cp1);
@@ -111,6 +132,7 @@ Path& Path::AddCubicComponent(const Point& p1,
 }
 
 Path& Path::AddContourComponent(const Point& destination, bool is_closed) {
+  polyline_cache_.reset();
   if (components_.size() > 0 &&
       components_.back().type == ComponentType::kContour) {
     // Never insert contiguous contours.
@@ -123,6 +145,7 @@ Path& Path::AddContourComponent(const Point& destination, bool is_closed) {
 }
 
 void Path::SetContourClosed(bool is_closed) {
+  polyline_cache_.reset();
   contours_.back().is_closed = is_closed;
 }
 
@@ -250,12 +273,46 @@ Path::Polyline::~Polyline() {
   }
 }
 
+void Path::EnablePolylineCache() {
+  for (const auto& component : components_) {
+    if (component.type == ComponentType::kQuadratic ||
+        component.type == ComponentType::kCubic) {
+      polyline_cache_ = std::make_shared<PolylineCache>();
+      return;
+    }
+  }
+}
+
 Path::Polyline Path::CreatePolyline(
     Scalar scale,
     Path::Polyline::PointBufferPtr point_buffer,
     Path::Polyline::ReclaimPointBufferCallback reclaim) const {
   Polyline polyline(std::move(point_buffer), std::move(reclaim));
 
+  const bool use_cache = polyline_cache_ && polyline.points->empty();
+  if (use_cache) {
+    std::scoped_lock lock(polyline_cache_->mutex);
+    if (polyline_cache_->valid && polyline_cache_->scale == scale) {
+      polyline.points->assign(polyline_cache_->points.begin(),
+                              polyline_cache_->points.end());
+      polyline.contours = polyline_cache_->contours;
+      return polyline;
+    }
+  }
+
+  FlattenPolyline(scale, polyline);
+
+  if (use_cache) {
+    std::scoped_lock lock(polyline_cache_->mutex);
+    polyline_cache_->valid = true;
+    polyline_cache_->scale = scale;
+    polyline_cache_->points = *polyline.points;
+    polyline_cache_->contours = polyline.contours;
+  }
+  return polyline;
+}
+
+void Path::FlattenPolyline(Scalar scale, Polyline& polyline) const {
   auto get_path_component = [this](size_t component_i) -> PathComponentVariant {
     if (component_i >= components_.size()) {
       return std::monostate{};
@@ -382,7 +439,6 @@ Path::Polyline Path::CreatePolyline(
     }
   }
   end_contour();
-  return polyline;
 }
 
 std::optional<Rect> Path::GetBoundingBox() const {
@@ -6,6 +6,8 @@
 #define FLUTTER_IMPELLER_GEOMETRY_PATH_H_
 
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <tuple>
@@ -144,6 +146,14 @@ class Path {
 
   bool IsConvex() const;
 
+  /// @brief Computes a hash of the fill type, components and points of this
+  ///        path. Paths with equal geometry produce equal hashes, which allows
+  ///        the results of expensive operations on a path to be cached.
+  ///
+  ///        The hash is recomputed on every call and is linear in the number
+  ///        of points in the path.
+  size_t GetContentHash() const;
+
   template <class T>
   using Applier = std::function<void(size_t index, const T& component)>;
   void EnumerateComponents(
@@ -169,6 +179,10 @@ class Path {
   /// It is suitable to use the max basis length of the matrix used to transform
   /// the path. If the provided scale is 0, curves will revert to straight
   /// lines.
+  ///
+  /// Paths with curves that were built by a |PathBuilder| remember the most
+  /// recent polyline, so that filling, stroking and other consumers that use
+  /// the same scale only flatten the curves once.
   Polyline CreatePolyline(
       Scalar scale,
       Polyline::PointBufferPtr point_buffer =
@@ -215,6 +229,23 @@ class Path {
 
   void Shift(Point shift);
 
+  /// @brief Called by `PathBuilder` once the path is complete to let
+  ///        |CreatePolyline| reuse its results. Paths without curves are
+  ///        cheap to flatten and are not cached.
+  void EnablePolylineCache();
+
+  void FlattenPolyline(Scalar scale, Polyline& polyline) const;
+
+  /// The most recent polyline created for this path. Shared between clones,
+  /// which have identical geometry, and dropped whenever the path changes.
+  struct PolylineCache {
+    std::mutex mutex;
+    bool valid = false;
+    Scalar scale = 0;
+    std::vector<Point> points;
+    std::vector<PolylineContour> contours;
+  };
+
   struct ComponentIndexPair {
     ComponentType type = ComponentType::kLinear;
     size_t index = 0;
@@ -232,6 +263,7 @@ class Path {
   std::vector<ContourComponent> contours_;
 
   std::optional<Rect> computed_bounds_;
+  std::shared_ptr<PolylineCache> polyline_cache_;
 };
 
 }  // namespace impeller
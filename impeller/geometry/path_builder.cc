@@ -25,6 +25,7 @@ Path PathBuilder::TakePath(FillType fill) {
   if (!did_compute_bounds_) {
     path.ComputeBounds();
   }
+  path.EnablePolylineCache();
   did_compute_bounds_ = false;
   return path;
 }
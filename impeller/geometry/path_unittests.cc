@@ -220,6 +220,31 @@ TEST(PathTest, PolylineBufferReuse) {
               });
 }
 
+TEST(PathTest, PolylineIsReusedForMatchingScale) {
+  auto path = PathBuilder{}
+                  .MoveTo({0, 0})
+                  .CubicCurveTo({10, 100}, {90, 100}, {100, 0})
+                  .QuadraticCurveTo({150, 50}, {200, 0})
+                  .Close()
+                  .TakePath();
+  auto clone = path.Clone();
+
+  auto first = path.CreatePolyline(1.0f);
+  auto second = path.CreatePolyline(1.0f);
+  EXPECT_EQ(*first.points, *second.points);
+  ASSERT_EQ(first.contours.size(), second.contours.size());
+  EXPECT_EQ(first.contours[0].components.size(),
+            second.contours[0].components.size());
+
+  // A different scale must be flattened again.
+  auto detailed = path.CreatePolyline(4.0f);
+  EXPECT_GT(detailed.points->size(), first.points->size());
+
+  // Clones share geometry and produce the same polylines.
+  EXPECT_EQ(*clone.CreatePolyline(4.0f).points, *detailed.points);
+  EXPECT_EQ(*clone.CreatePolyline(1.0f).points, *first.points);
+}
+
 TEST(PathTest, PolylineFailsWithNullptrBuffer) {
   EXPECT_DEATH_IF_SUPPORTED(PathBuilder{}
                                 .MoveTo({50, 50})
@@ -5,8 +5,81 @@
 #include "rect.h"
 #include <sstream>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define IMPELLER_GEOMETRY_USE_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define IMPELLER_GEOMETRY_USE_NEON 1
+#endif
+
 namespace impeller {
 
-//
+template <>
+std::optional<Rect> Rect::MakePointBounds(const Point* points, size_t count) {
+  if (count == 0) {
+    return std::nullopt;
+  }
+  auto left = points[0].x;
+  auto top = points[0].y;
+  auto right = points[0].x;
+  auto bottom = points[0].y;
+  size_t i = 1;
+
+  // The comparisons below mirror std::min and std::max so that NaN
+  // coordinates are skipped exactly as in the scalar overload.
+#if defined(IMPELLER_GEOMETRY_USE_SSE2)
+  if (count >= 3) {
+    // Lanes hold {min_x, min_y, min_x, min_y}, and likewise for the max.
+    __m128 min = _mm_setr_ps(left, top, left, top);
+    __m128 max = min;
+    for (; i + 2 <= count; i += 2) {
+      const __m128 p = _mm_loadu_ps(&points[i].x);
+      min = _mm_min_ps(p, min);
+      max = _mm_max_ps(p, max);
+    }
+    min = _mm_min_ps(_mm_movehl_ps(min, min), min);
+    max = _mm_max_ps(_mm_movehl_ps(max, max), max);
+    alignas(16) Scalar lanes[8];
+    _mm_store_ps(&lanes[0], min);
+    _mm_store_ps(&lanes[4], max);
+    left = lanes[0];
+    top = lanes[1];
+    right = lanes[4];
+    bottom = lanes[5];
+  }
+#elif defined(IMPELLER_GEOMETRY_USE_NEON)
+  if (count >= 3) {
+    // Lanes hold {min_x, min_y, min_x, min_y}, and likewise for the max.
+    float32x4_t min = {left, top, left, top};
+    float32x4_t max = min;
+    for (; i + 2 <= count; i += 2) {
+      const float32x4_t p = vld1q_f32(&points[i].x);
+      min = vbslq_f32(vcltq_f32(p, min), p, min);
+      max = vbslq_f32(vcgtq_f32(p, max), p, max);
+    }
+    const float32x2_t min_lo = vget_low_f32(min);
+    const float32x2_t min_hi = vget_high_f32(min);
+    const float32x2_t max_lo = vget_low_f32(max);
+    const float32x2_t max_hi = vget_high_f32(max);
+    const float32x2_t min_xy =
+        vbsl_f32(vclt_f32(min_hi, min_lo), min_hi, min_lo);
+    const float32x2_t max_xy =
+        vbsl_f32(vcgt_f32(max_hi, max_lo), max_hi, max_lo);
+    left = vget_lane_f32(min_xy, 0);
+    top = vget_lane_f32(min_xy, 1);
+    right = vget_lane_f32(max_xy, 0);
+    bottom = vget_lane_f32(max_xy, 1);
+  }
+#endif
+
+  for (; i < count; i++) {
+    left = std::min(left, points[i].x);
+    top = std::min(top, points[i].y);
+    right = std::max(right, points[i].x);
+    bottom = std::max(bottom, points[i].y);
+  }
+  return Rect::MakeLTRB(left, top, right, bottom);
+}
 
 }  // namespace impeller
@@ -69,6 +69,14 @@ struct TRect {
     return TRect::MakeLTRB(left, top, right, bottom);
   }
 
+  /// @brief  Computes the bounds of |count| contiguous points. Equivalent to
+  ///         the iterator overload, but vectorized for |Rect| on SSE2 and
+  ///         NEON targets.
+  static std::optional<TRect> MakePointBounds(const TPoint<Type>* points,
+                                              size_t count) {
+    return MakePointBounds(points, points + count);
+  }
+
   constexpr static TRect MakeMaximum() {
     return TRect::MakeLTRB(-std::numeric_limits<Type>::infinity(),
                            -std::numeric_limits<Type>::infinity(),
@@ -488,6 +496,9 @@ struct TRect {
 using Rect = TRect<Scalar>;
 using IRect = TRect<int64_t>;
 
+template <>
+std::optional<Rect> Rect::MakePointBounds(const Point* points, size_t count);
+
 }  // namespace impeller
 
 namespace std {
@@ -421,6 +421,25 @@ TEST(RectTest, MakePointBoundsQuad) {
   }
 }
 
+TEST(RectTest, MakePointBoundsFromPointerMatchesIterators) {
+  std::vector<Point> points;
+  for (int i = 0; i < 37; i++) {
+    points.emplace_back(i * 7 % 13 - 6.5f, i * 5 % 11 - 20.25f);
+  }
+  points.emplace_back(std::nanf(""), 100);
+  points.emplace_back(-100, std::nanf(""));
+
+  for (size_t count = 0; count <= points.size(); count++) {
+    auto expected =
+        Rect::MakePointBounds(points.begin(), points.begin() + count);
+    auto actual = Rect::MakePointBounds(points.data(), count);
+    ASSERT_EQ(expected.has_value(), actual.has_value()) << count;
+    if (expected.has_value()) {
+      EXPECT_EQ(expected.value(), actual.value()) << count;
+    }
+  }
+}
+
 TEST(RectTest, IsSquare) {
   EXPECT_TRUE(Rect::MakeXYWH(10, 30, 20, 20).IsSquare());
   EXPECT_FALSE(Rect::MakeXYWH(10, 30, 20, 19).IsSquare());
@@ -0,0 +1,34 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/golden_tests/frame_capture_replay.h"
+
+#include "flutter/fml/logging.h"
+
+namespace impeller {
+namespace testing {
+
+FrameCaptureReplay* FrameCaptureReplay::instance_ = nullptr;
+
+FrameCaptureReplay::FrameCaptureReplay() {}
+
+FrameCaptureReplay* FrameCaptureReplay::Instance() {
+  if (!instance_) {
+    instance_ = new FrameCaptureReplay();
+  }
+  return instance_;
+}
+
+void FrameCaptureReplay::SetPath(const std::string& path) {
+  FML_CHECK(!path_.has_value());
+  path_ = path;
+}
+
+void FrameCaptureReplay::SetIterationCount(size_t iteration_count) {
+  FML_CHECK(iteration_count > 0u);
+  iteration_count_ = iteration_count;
+}
+
+}  // namespace testing
+}  // namespace impeller
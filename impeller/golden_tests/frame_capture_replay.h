@@ -0,0 +1,43 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_GOLDEN_TESTS_FRAME_CAPTURE_REPLAY_H_
+#define FLUTTER_IMPELLER_GOLDEN_TESTS_FRAME_CAPTURE_REPLAY_H_
+
+#include <optional>
+#include <string>
+
+#include "flutter/fml/macros.h"
+
+namespace impeller {
+namespace testing {
+
+/// Keeps track of the global variables for the frame capture that
+/// `GoldenTests.ReplayFrameCapture` replays, if one was specified.
+class FrameCaptureReplay {
+ public:
+  static FrameCaptureReplay* Instance();
+
+  void SetPath(const std::string& path);
+
+  const std::optional<std::string>& GetPath() const { return path_; }
+
+  void SetIterationCount(size_t iteration_count);
+
+  size_t GetIterationCount() const { return iteration_count_; }
+
+ private:
+  FrameCaptureReplay(const FrameCaptureReplay&) = delete;
+
+  FrameCaptureReplay& operator=(const FrameCaptureReplay&) = delete;
+  FrameCaptureReplay();
+  static FrameCaptureReplay* instance_;
+  std::optional<std::string> path_;
+  size_t iteration_count_ = 100u;
+};
+
+}  // namespace testing
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_GOLDEN_TESTS_FRAME_CAPTURE_REPLAY_H_
@@ -11,10 +11,12 @@
 #include "impeller/aiks/canvas.h"
 #include "impeller/entity/contents/conical_gradient_contents.h"
 #include "impeller/geometry/path_builder.h"
+#include "impeller/golden_tests/frame_capture_replay.h"
 #include "impeller/golden_tests/golden_digest.h"
 #include "impeller/golden_tests/metal_screenshot.h"
 #include "impeller/golden_tests/metal_screenshotter.h"
 #include "impeller/golden_tests/working_directory.h"
+#include "impeller/renderer/frame_capture.h"
 
 namespace impeller {
 namespace testing {
@@ -86,5 +88,29 @@ TEST_F(GoldenTests, ConicalGradient) {
   auto screenshot = Screenshotter().MakeScreenshot(aiks_context, picture);
   ASSERT_TRUE(SaveScreenshot(std::move(screenshot)));
 }
+
+TEST_F(GoldenTests, ReplayFrameCapture) {
+  FrameCaptureReplay* replay = FrameCaptureReplay::Instance();
+  if (!replay->GetPath().has_value()) {
+    GTEST_SKIP() << "No frame capture was specified with --frame_capture.";
+  }
+  auto capture = FrameCapture::ReadFromArchive(replay->GetPath().value());
+  ASSERT_TRUE(capture);
+
+  auto statistics =
+      capture->Replay(Screenshotter().GetPlayground().GetContext(),
+                      replay->GetIterationCount());
+  ASSERT_TRUE(statistics.has_value());
+  std::cout << "replayed " << capture->GetRenderPassCount()
+            << " render passes and " << capture->GetCommandCount()
+            << " commands " << statistics->iteration_count << " times: min "
+            << statistics->min_frame_time.ToMicroseconds() << "us, average "
+            << statistics->average_frame_time.ToMicroseconds() << "us, max "
+            << statistics->max_frame_time.ToMicroseconds() << "us"
+            << std::endl;
+  RecordProperty("average_frame_time_us",
+                 statistics->average_frame_time.ToMicroseconds());
+}
+
 }  // namespace testing
 }  // namespace impeller
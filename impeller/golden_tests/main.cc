@@ -4,10 +4,13 @@
 
 #include <wordexp.h>
 
+#include <string>
+
 #include "flutter/fml/backtrace.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/logging.h"
+#include "flutter/impeller/golden_tests/frame_capture_replay.h"
 #include "flutter/impeller/golden_tests/golden_digest.h"
 #include "flutter/impeller/golden_tests/working_directory.h"
 #include "gtest/gtest.h"
@@ -21,6 +24,12 @@ void print_usage() {
   std::cout << "  working_dir: Where the golden images will be generated and "
                "uploaded to Skia Gold from."
             << std::endl;
+  std::cout << "  frame_capture: Optional. The frame capture archive that "
+               "GoldenTests.ReplayFrameCapture replays and times."
+            << std::endl;
+  std::cout << "  frame_capture_iterations: Optional. How many times the "
+               "frame capture is replayed. Defaults to 100."
+            << std::endl;
 }
 }  // namespace
 
@@ -38,6 +47,11 @@ int main(int argc, char** argv) {
       FML_CHECK(wordexp_result.we_wordc != 0);
       working_dir = wordexp_result.we_wordv[0];
       wordfree(&wordexp_result);
+    } else if (option.name == "frame_capture") {
+      impeller::testing::FrameCaptureReplay::Instance()->SetPath(option.value);
+    } else if (option.name == "frame_capture_iterations") {
+      impeller::testing::FrameCaptureReplay::Instance()->SetIterationCount(
+          std::stoul(option.value));
     }
   }
   if (!working_dir) {
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include <array>
+#include <cinttypes>
 #include <memory>
 #include <optional>
 #include <sstream>
@@ -25,6 +26,7 @@
 #include "impeller/playground/playground.h"
 #include "impeller/playground/playground_impl.h"
 #include "impeller/renderer/context.h"
+#include "impeller/renderer/gpu_statistics.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/renderer.h"
 #include "third_party/imgui/backends/imgui_impl_glfw.h"
@@ -48,6 +50,56 @@ std::string PlaygroundBackendToString(PlaygroundBackend backend) {
   FML_UNREACHABLE();
 }
 
+static Scalar BytesToMegabytes(size_t bytes) {
+  return static_cast<Scalar>(bytes) / (1024 * 1024);
+}
+
+/// Lists what the GPU tracer measured for the last frame, and the bandwidth
+/// estimates of the render passes of the last frame.
+static void DrawGPUStatisticsOverlay(
+    const Context& context,
+    const std::vector<RenderPassBandwidth>& passes) {
+  ImGui::SetNextWindowPos({10, 400}, ImGuiCond_FirstUseEver);
+  ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+  ImGui::Begin("GPU Statistics", nullptr,
+               ImGuiWindowFlags_AlwaysAutoResize |
+                   ImGuiWindowFlags_NoSavedSettings);
+
+  if (auto frame_time = context.GetLastGPUFrameTime();
+      frame_time.has_value()) {
+    ImGui::Text("GPU frame time: %.3f ms", frame_time->ToMillisecondsF());
+  }
+  if (auto statistics = context.GetLastGPUFramePipelineStatistics();
+      statistics.has_value()) {
+    ImGui::Text("Vertex invocations: %" PRIu64,
+                statistics->vertex_invocations);
+    ImGui::Text("Clipping invocations: %" PRIu64,
+                statistics->clipping_invocations);
+    ImGui::Text("Clipping primitives: %" PRIu64,
+                statistics->clipping_primitives);
+    ImGui::Text("Fragment invocations: %" PRIu64,
+                statistics->fragment_invocations);
+  }
+
+  size_t total_bytes = 0u;
+  for (size_t i = 0; i < passes.size(); i++) {
+    const auto& pass = passes[i];
+    ImGui::Text("Pass %zu (%dx%d, %dx): load %.2f MB, store %.2f MB, "
+                "resolve %.2f MB",
+                i, static_cast<int>(pass.size.width),
+                static_cast<int>(pass.size.height),
+                static_cast<int>(pass.sample_count),
+                BytesToMegabytes(pass.bytes_loaded),
+                BytesToMegabytes(pass.bytes_stored),
+                BytesToMegabytes(pass.bytes_resolved));
+    total_bytes += pass.GetTotalBytes();
+  }
+  ImGui::Text("Estimated attachment bandwidth: %.2f MB per frame",
+              BytesToMegabytes(total_bytes));
+
+  ImGui::End();
+}
+
 struct Playground::GLFWInitializer {
   GLFWInitializer() {
     // This guard is a hack to work around a problem where glfwCreateWindow
@@ -242,6 +294,11 @@ bool Playground::OpenPlaygroundHere(
 
   ImGui::SetNextWindowPos({10, 10});
 
+  auto context = renderer_->GetContext();
+  context->bandwidth_recorder = std::make_shared<RenderPassBandwidthRecorder>();
+  fml::ScopedCleanupClosure reset_bandwidth_recorder(
+      [context]() { context->bandwidth_recorder = nullptr; });
+
   ::glfwSetWindowSize(window, GetWindowSize().width, GetWindowSize().height);
   ::glfwSetWindowPos(window, 200, 100);
   ::glfwShowWindow(window);
@@ -261,10 +318,14 @@ bool Playground::OpenPlaygroundHere(
     Renderer::RenderCallback wrapped_callback =
         [render_callback,
          &renderer = renderer_](RenderTarget& render_target) -> bool {
+      // The passes of the previous frame, including its ImGui pass.
+      auto passes = renderer->GetContext()->bandwidth_recorder->TakeRecords();
+
       ImGui::NewFrame();
       ImGui::DockSpaceOverViewport(ImGui::GetMainViewport(),
                                    ImGuiDockNodeFlags_PassthruCentralNode);
       bool result = render_callback(render_target);
+      DrawGPUStatisticsOverlay(*renderer->GetContext(), passes);
       ImGui::Render();
 
       // Render ImGui overlay.
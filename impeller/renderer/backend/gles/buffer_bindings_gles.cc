@@ -24,11 +24,18 @@ bool BufferBindingsGLES::RegisterVertexStageInput(
     const std::vector<ShaderStageIOSlot>& p_inputs,
     const std::vector<ShaderStageBufferLayout>& layouts) {
   std::vector<VertexAttribPointer> vertex_attrib_arrays;
+  uint32_t vertex_attrib_mask = 0u;
   for (auto i = 0u; i < p_inputs.size(); i++) {
     const auto& input = p_inputs[i];
     const auto& layout = layouts[input.binding];
     VertexAttribPointer attrib;
     attrib.index = input.location;
+    if (attrib.index >= StateTrackerGLES::kMaxVertexAttribs) {
+      VALIDATION_LOG << "Vertex attribute location " << attrib.index
+                     << " is out of range.";
+      return false;
+    }
+    vertex_attrib_mask |= 1u << attrib.index;
     // Component counts must be 1, 2, 3 or 4. Do that validation now.
     if (input.vec_size < 1u || input.vec_size > 4u) {
       return false;
@@ -45,6 +52,7 @@ bool BufferBindingsGLES::RegisterVertexStageInput(
     vertex_attrib_arrays.emplace_back(attrib);
   }
   vertex_attrib_arrays_ = std::move(vertex_attrib_arrays);
+  vertex_attrib_mask_ = vertex_attrib_mask;
   return true;
 }
 
@@ -125,17 +133,16 @@ bool BufferBindingsGLES::ReadUniformsBindings(const ProcTableGLES& gl,
   return true;
 }
 
-bool BufferBindingsGLES::BindVertexAttributes(const ProcTableGLES& gl,
+bool BufferBindingsGLES::BindVertexAttributes(StateTrackerGLES& state,
                                               size_t vertex_offset) const {
+  state.SetEnabledVertexAttribArrays(vertex_attrib_mask_);
   for (const auto& array : vertex_attrib_arrays_) {
-    gl.EnableVertexAttribArray(array.index);
-    gl.VertexAttribPointer(array.index,       // index
-                           array.size,        // size (must be 1, 2, 3, or 4)
-                           array.type,        // type
-                           array.normalized,  // normalized
-                           array.stride,      // stride
-                           reinterpret_cast<const GLvoid*>(static_cast<GLsizei>(
-                               vertex_offset + array.offset))  // pointer
+    state.VertexAttribPointer(array.index,                  // index
+                              array.size,                   // size
+                              array.type,                   // type
+                              array.normalized,             // normalized
+                              array.stride,                 // stride
+                              vertex_offset + array.offset  // offset
     );
   }
 
@@ -172,13 +179,6 @@ bool BufferBindingsGLES::BindUniformData(const ProcTableGLES& gl,
   return true;
 }
 
-bool BufferBindingsGLES::UnbindVertexAttributes(const ProcTableGLES& gl) const {
-  for (const auto& array : vertex_attrib_arrays_) {
-    gl.DisableVertexAttribArray(array.index);
-  }
-  return true;
-}
-
 GLint BufferBindingsGLES::ComputeTextureLocation(
     const ShaderMetadata* metadata) {
   auto location = binding_map_.find(metadata->name);
@@ -11,6 +11,7 @@
 #include "impeller/core/shader_types.h"
 #include "impeller/renderer/backend/gles/gles.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/backend/gles/state_tracker_gles.h"
 #include "impeller/renderer/command.h"
 
 namespace impeller {
@@ -32,7 +33,11 @@ class BufferBindingsGLES {
 
   bool ReadUniformsBindings(const ProcTableGLES& gl, GLuint program);
 
-  bool BindVertexAttributes(const ProcTableGLES& gl,
+  //----------------------------------------------------------------------------
+  /// @brief      Specifies the vertex attributes sourced from the currently
+  ///             bound array buffer and disables all other attribute arrays.
+  ///
+  bool BindVertexAttributes(StateTrackerGLES& state,
                             size_t vertex_offset) const;
 
   bool BindUniformData(const ProcTableGLES& gl,
@@ -40,8 +45,6 @@ class BufferBindingsGLES {
                        const Bindings& vertex_bindings,
                        const Bindings& fragment_bindings);
 
-  bool UnbindVertexAttributes(const ProcTableGLES& gl) const;
-
  private:
   //----------------------------------------------------------------------------
   /// @brief      The arguments to glVertexAttribPointer.
@@ -55,6 +58,7 @@ class BufferBindingsGLES {
     GLsizei offset = 0u;
   };
   std::vector<VertexAttribPointer> vertex_attrib_arrays_;
+  uint32_t vertex_attrib_mask_ = 0u;
 
   std::unordered_map<std::string, GLint> uniform_locations_;
 
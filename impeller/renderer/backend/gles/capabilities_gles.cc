@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/backend/gles/capabilities_gles.h"
 
+#include <vector>
+
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
 
 namespace impeller {
@@ -21,6 +23,10 @@ static const constexpr char* kNvidiaTextureBorderClampExt =
 static const constexpr char* kMultisampledRenderToTextureExt =
     "GL_EXT_multisampled_render_to_texture";
 
+// https://registry.khronos.org/OpenGL/extensions/KHR/KHR_parallel_shader_compile.txt
+static const constexpr char* kParallelShaderCompileExt =
+    "GL_KHR_parallel_shader_compile";
+
 CapabilitiesGLES::CapabilitiesGLES(const ProcTableGLES& gl) {
   {
     GLint value = 0;
@@ -96,6 +102,27 @@ CapabilitiesGLES::CapabilitiesGLES(const ProcTableGLES& gl) {
     num_compressed_texture_formats = value;
   }
 
+  if (num_compressed_texture_formats > 0) {
+    std::vector<GLint> formats(num_compressed_texture_formats);
+    gl.GetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data());
+    for (auto format : formats) {
+      switch (format) {
+        case GL_COMPRESSED_RGBA8_ETC2_EAC:
+          compressed_texture_formats_.insert(
+              PixelFormat::kETC2R8G8B8A8UNormInt);
+          break;
+        case GL_COMPRESSED_RGBA_ASTC_4x4_KHR:
+          compressed_texture_formats_.insert(PixelFormat::kASTC4x4UNormInt);
+          break;
+        case GL_COMPRESSED_RGBA_BPTC_UNORM_EXT:
+          compressed_texture_formats_.insert(PixelFormat::kBC7UNormInt);
+          break;
+        default:
+          break;
+      }
+    }
+  }
+
   if (desc->IsES()) {
     GLint value = 0;
     gl.GetIntegerv(GL_NUM_SHADER_BINARY_FORMATS, &value);
@@ -117,6 +144,9 @@ CapabilitiesGLES::CapabilitiesGLES(const ProcTableGLES& gl) {
     gl.GetIntegerv(GL_MAX_SAMPLES_EXT, &value);
     supports_offscreen_msaa_ = value >= 4;
   }
+
+  supports_parallel_shader_compile_ =
+      desc->HasExtension(kParallelShaderCompileExt);
 }
 
 size_t CapabilitiesGLES::GetMaxTextureUnits(ShaderStage stage) const {
@@ -132,6 +162,10 @@ size_t CapabilitiesGLES::GetMaxTextureUnits(ShaderStage stage) const {
   FML_UNREACHABLE();
 }
 
+bool CapabilitiesGLES::SupportsParallelShaderCompile() const {
+  return supports_parallel_shader_compile_;
+}
+
 bool CapabilitiesGLES::SupportsOffscreenMSAA() const {
   return supports_offscreen_msaa_;
 }
@@ -176,6 +210,11 @@ bool CapabilitiesGLES::SupportsDeviceTransientTextures() const {
   return false;
 }
 
+bool CapabilitiesGLES::SupportsCompressedTextureFormat(
+    PixelFormat format) const {
+  return compressed_texture_formats_.count(format) > 0;
+}
+
 PixelFormat CapabilitiesGLES::GetDefaultColorFormat() const {
   return PixelFormat::kR8G8B8A8UNormInt;
 }
@@ -6,6 +6,7 @@
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_CAPABILITIES_GLES_H_
 
 #include <cstddef>
+#include <set>
 
 #include "impeller/base/backend_cast.h"
 #include "impeller/core/shader_types.h"
@@ -74,6 +75,13 @@ class CapabilitiesGLES final
 
   size_t GetMaxTextureUnits(ShaderStage stage) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether shaders can be compiled and programs linked without
+  ///             blocking, with completion queried via
+  ///             `GL_COMPLETION_STATUS_KHR`.
+  ///
+  bool SupportsParallelShaderCompile() const;
+
   // |Capabilities|
   bool SupportsOffscreenMSAA() const override;
 
@@ -107,6 +115,9 @@ class CapabilitiesGLES final
   // |Capabilities|
   bool SupportsDeviceTransientTextures() const override;
 
+  // |Capabilities|
+  bool SupportsCompressedTextureFormat(PixelFormat format) const override;
+
   // |Capabilities|
   PixelFormat GetDefaultColorFormat() const override;
 
@@ -121,6 +132,8 @@ class CapabilitiesGLES final
   bool supports_decal_sampler_address_mode_ = false;
   bool supports_offscreen_msaa_ = false;
   bool supports_implicit_msaa_ = false;
+  bool supports_parallel_shader_compile_ = false;
+  std::set<PixelFormat> compressed_texture_formats_;
 };
 
 }  // namespace impeller
@@ -9,21 +9,24 @@
 #include "impeller/base/validation.h"
 #include "impeller/renderer/backend/gles/command_buffer_gles.h"
 #include "impeller/renderer/backend/gles/gpu_tracer_gles.h"
+#include "impeller/renderer/backend/gles/program_binary_cache_gles.h"
 
 namespace impeller {
 
 std::shared_ptr<ContextGLES> ContextGLES::Create(
     std::unique_ptr<ProcTableGLES> gl,
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
-    bool enable_gpu_tracing) {
-  return std::shared_ptr<ContextGLES>(
-      new ContextGLES(std::move(gl), shader_libraries, enable_gpu_tracing));
+    bool enable_gpu_tracing,
+    const fml::UniqueFD& cache_directory) {
+  return std::shared_ptr<ContextGLES>(new ContextGLES(
+      std::move(gl), shader_libraries, enable_gpu_tracing, cache_directory));
 }
 
 ContextGLES::ContextGLES(
     std::unique_ptr<ProcTableGLES> gl,
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_mappings,
-    bool enable_gpu_tracing) {
+    bool enable_gpu_tracing,
+    const fml::UniqueFD& cache_directory) {
   reactor_ = std::make_shared<ReactorGLES>(std::move(gl));
   if (!reactor_->IsValid()) {
     VALIDATION_LOG << "Could not create valid reactor.";
@@ -43,8 +46,18 @@ ContextGLES::ContextGLES(
 
   // Create the pipeline library.
   {
-    pipeline_library_ =
-        std::shared_ptr<PipelineLibraryGLES>(new PipelineLibraryGLES(reactor_));
+    std::shared_ptr<ProgramBinaryCacheGLES> binary_cache;
+    const auto& gl = reactor_->GetProcTable();
+    if (cache_directory.is_valid() && ProgramBinaryCacheGLES::IsSupported(gl)) {
+      binary_cache = std::make_shared<ProgramBinaryCacheGLES>(
+          cache_directory, gl.GetDescription()->GetString());
+      if (!binary_cache->IsValid()) {
+        FML_LOG(WARNING) << "Could not open the program binary cache.";
+        binary_cache = nullptr;
+      }
+    }
+    pipeline_library_ = std::shared_ptr<PipelineLibraryGLES>(
+        new PipelineLibraryGLES(reactor_, std::move(binary_cache)));
   }
 
   // Create allocators.
@@ -101,6 +114,11 @@ bool ContextGLES::IsValid() const {
 
 void ContextGLES::Shutdown() {}
 
+// |Context|
+std::optional<fml::TimeDelta> ContextGLES::GetLastGPUFrameTime() const {
+  return gpu_tracer_ ? gpu_tracer_->GetLastFrameTime() : std::nullopt;
+}
+
 // |Context|
 std::string ContextGLES::DescribeGpuModel() const {
   return reactor_->GetProcTable().GetDescription()->GetString();
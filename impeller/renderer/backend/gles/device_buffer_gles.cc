@@ -71,7 +71,9 @@ static GLenum ToTarget(DeviceBufferGLES::BindingType type) {
   FML_UNREACHABLE();
 }
 
-bool DeviceBufferGLES::BindAndUploadDataIfNecessary(BindingType type) const {
+bool DeviceBufferGLES::BindAndUploadDataIfNecessary(
+    BindingType type,
+    StateTrackerGLES& state) const {
   if (!reactor_) {
     return false;
   }
@@ -84,7 +86,7 @@ bool DeviceBufferGLES::BindAndUploadDataIfNecessary(BindingType type) const {
   const auto target_type = ToTarget(type);
   const auto& gl = reactor_->GetProcTable();
 
-  gl.BindBuffer(target_type, buffer.value());
+  state.BindBuffer(target_type, buffer.value());
 
   if (upload_generation_ != generation_) {
     TRACE_EVENT1("impeller", "BufferData", "Bytes",
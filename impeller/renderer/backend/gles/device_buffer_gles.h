@@ -12,6 +12,7 @@
 #include "impeller/base/backend_cast.h"
 #include "impeller/core/device_buffer.h"
 #include "impeller/renderer/backend/gles/reactor_gles.h"
+#include "impeller/renderer/backend/gles/state_tracker_gles.h"
 
 namespace impeller {
 
@@ -36,7 +37,9 @@ class DeviceBufferGLES final
     kElementArrayBuffer,
   };
 
-  [[nodiscard]] bool BindAndUploadDataIfNecessary(BindingType type) const;
+  [[nodiscard]] bool BindAndUploadDataIfNecessary(
+      BindingType type,
+      StateTrackerGLES& state) const;
 
   void Flush(std::optional<Range> range = std::nullopt) const override;
 
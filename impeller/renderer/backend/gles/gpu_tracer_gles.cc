@@ -63,6 +63,8 @@ void GPUTracerGLES::ProcessQueries(const ProcTableGLES& gl) {
     uint64_t duration = 0;
     gl.GetQueryObjectui64vEXT(query, GL_QUERY_RESULT_EXT, &duration);
     auto gpu_ms = duration / 1000000.0;
+    last_frame_time_ =
+        fml::TimeDelta::FromNanoseconds(static_cast<int64_t>(duration));
 
     FML_TRACE_COUNTER("flutter", "GPUTracer",
                       reinterpret_cast<int64_t>(this),  // Trace Counter ID
@@ -72,6 +74,10 @@ void GPUTracerGLES::ProcessQueries(const ProcTableGLES& gl) {
   }
 }
 
+std::optional<fml::TimeDelta> GPUTracerGLES::GetLastFrameTime() const {
+  return last_frame_time_;
+}
+
 void GPUTracerGLES::MarkFrameEnd(const ProcTableGLES& gl) {
   if (!enabled_ || std::this_thread::get_id() != raster_thread_ ||
       !active_frame_.has_value()) {
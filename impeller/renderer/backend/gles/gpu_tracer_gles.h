@@ -7,8 +7,10 @@
 
 #include <cstdint>
 #include <deque>
+#include <optional>
 #include <thread>
 
+#include "flutter/fml/time/time_delta.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
 
 namespace impeller {
@@ -40,12 +42,17 @@ class GPUTracerGLES {
   /// @brief Record the end of a frame workload.
   void MarkFrameEnd(const ProcTableGLES& gl);
 
+  /// @brief The GPU time of the most recently measured frame, if any. Must be
+  ///        called on the raster thread.
+  std::optional<fml::TimeDelta> GetLastFrameTime() const;
+
  private:
   void ProcessQueries(const ProcTableGLES& gl);
 
   std::deque<uint32_t> pending_traces_;
   std::optional<uint32_t> active_frame_ = std::nullopt;
   std::thread::id raster_thread_;
+  std::optional<fml::TimeDelta> last_frame_time_;
 
   bool enabled_ = false;
 };
@@ -4,6 +4,14 @@
 
 #include "impeller/renderer/backend/gles/pipeline_gles.h"
 
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+
+// https://registry.khronos.org/OpenGL/extensions/KHR/KHR_parallel_shader_compile.txt
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 namespace impeller {
 
 PipelineGLES::PipelineGLES(ReactorGLES::Ref reactor,
@@ -57,7 +65,45 @@ bool PipelineGLES::BuildVertexDescriptor(const ProcTableGLES& gl,
   return true;
 }
 
-[[nodiscard]] bool PipelineGLES::BindProgram() const {
+PipelineGLES::LinkStatus PipelineGLES::CheckLinkStatus(
+    const ProcTableGLES& gl,
+    bool wait) {
+  if (link_status_ != LinkStatus::kPending) {
+    return link_status_;
+  }
+  auto program = reactor_->GetGLHandle(handle_);
+  if (!program.has_value()) {
+    VALIDATION_LOG << "Could not obtain program handle.";
+    link_status_ = LinkStatus::kFailed;
+    return link_status_;
+  }
+  if (!wait) {
+    GLint completed = GL_FALSE;
+    gl.GetProgramiv(*program, GL_COMPLETION_STATUS_KHR, &completed);
+    if (completed != GL_TRUE) {
+      return LinkStatus::kPending;
+    }
+  }
+  TRACE_EVENT0("impeller", "PipelineGLES::FinishLink");
+  GLint link_status = GL_FALSE;
+  gl.GetProgramiv(*program, GL_LINK_STATUS, &link_status);
+  if (link_status != GL_TRUE) {
+    VALIDATION_LOG << "Could not link shader program for '"
+                   << GetDescriptor().GetLabel()
+                   << "': " << gl.GetProgramInfoLogString(*program);
+    link_status_ = LinkStatus::kFailed;
+    return link_status_;
+  }
+  if (!BuildVertexDescriptor(gl, *program)) {
+    VALIDATION_LOG << "Could not build pipeline vertex descriptors.";
+    link_status_ = LinkStatus::kFailed;
+    return link_status_;
+  }
+  link_status_ = LinkStatus::kLinked;
+  return link_status_;
+}
+
+[[nodiscard]] bool PipelineGLES::BindProgram(StateTrackerGLES& state) const {
   if (handle_.IsDead()) {
     return false;
   }
@@ -65,14 +111,7 @@ bool PipelineGLES::BuildVertexDescriptor(const ProcTableGLES& gl,
   if (!handle.has_value()) {
     return false;
   }
-  reactor_->GetProcTable().UseProgram(handle.value());
-  return true;
-}
-
-[[nodiscard]] bool PipelineGLES::UnbindProgram() const {
-  if (reactor_) {
-    reactor_->GetProcTable().UseProgram(0u);
-  }
+  state.UseProgram(handle.value());
   return true;
 }
 
@@ -10,6 +10,7 @@
 #include "impeller/renderer/backend/gles/buffer_bindings_gles.h"
 #include "impeller/renderer/backend/gles/handle_gles.h"
 #include "impeller/renderer/backend/gles/reactor_gles.h"
+#include "impeller/renderer/backend/gles/state_tracker_gles.h"
 #include "impeller/renderer/pipeline.h"
 
 namespace impeller {
@@ -25,15 +26,36 @@ class PipelineGLES final
 
   const HandleGLES& GetProgramHandle() const;
 
-  [[nodiscard]] bool BindProgram() const;
-
-  [[nodiscard]] bool UnbindProgram() const;
+  [[nodiscard]] bool BindProgram(StateTrackerGLES& state) const;
 
   BufferBindingsGLES* GetBufferBindings() const;
 
   [[nodiscard]] bool BuildVertexDescriptor(const ProcTableGLES& gl,
                                            GLuint program);
 
+  enum class LinkStatus {
+    kPending,
+    kLinked,
+    kFailed,
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Checks whether the link of the program issued by the library
+  ///             has completed, and builds the vertex descriptor once it has.
+  ///
+  ///             Programs are only linked asynchronously on drivers supporting
+  ///             `GL_KHR_parallel_shader_compile`. Other programs are linked
+  ///             by the time the pipeline is created.
+  ///
+  ///             This may only be called within a reactor operation.
+  ///
+  /// @param[in]  gl    The proc table.
+  /// @param[in]  wait  Whether to block until the link completes.
+  ///
+  /// @return     The link status. It is never pending if `wait` is true.
+  ///
+  LinkStatus CheckLinkStatus(const ProcTableGLES& gl, bool wait);
+
  private:
   friend PipelineLibraryGLES;
 
@@ -41,6 +63,7 @@ class PipelineGLES final
   HandleGLES handle_;
   std::unique_ptr<BufferBindingsGLES> buffer_bindings_;
   bool is_valid_ = false;
+  LinkStatus link_status_ = LinkStatus::kLinked;
 
   // |Pipeline|
   bool IsValid() const override;
@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/gles/pipeline_library_gles.h"
 
+#include <optional>
 #include <sstream>
 #include <string>
 
@@ -16,8 +17,10 @@
 
 namespace impeller {
 
-PipelineLibraryGLES::PipelineLibraryGLES(ReactorGLES::Ref reactor)
-    : reactor_(std::move(reactor)) {}
+PipelineLibraryGLES::PipelineLibraryGLES(
+    ReactorGLES::Ref reactor,
+    std::shared_ptr<ProgramBinaryCacheGLES> binary_cache)
+    : reactor_(std::move(reactor)), binary_cache_(std::move(binary_cache)) {}
 
 static std::string GetShaderInfoLog(const ProcTableGLES& gl, GLuint shader) {
   GLint log_length = 0;
@@ -74,11 +77,20 @@ static void LogShaderCompilationFailure(const ProcTableGLES& gl,
   VALIDATION_LOG << stream.str();
 }
 
+//------------------------------------------------------------------------------
+/// @brief      Compiles the shaders and links the program of the pipeline.
+///
+///             If `wait_for_completion` is false, neither the compile nor the
+///             link status are queried as doing so would block until the
+///             driver is done. The caller must check the link status of the
+///             pipeline later instead.
+///
 static bool LinkProgram(
     const ReactorGLES& reactor,
     const std::shared_ptr<PipelineGLES>& pipeline,
     const std::shared_ptr<const ShaderFunction>& vert_function,
-    const std::shared_ptr<const ShaderFunction>& frag_function) {
+    const std::shared_ptr<const ShaderFunction>& frag_function,
+    bool wait_for_completion) {
   TRACE_EVENT0("impeller", __FUNCTION__);
 
   const auto& descriptor = pipeline->GetDescriptor();
@@ -117,22 +129,24 @@ static bool LinkProgram(
   gl.CompileShader(vert_shader);
   gl.CompileShader(frag_shader);
 
-  GLint vert_status = GL_FALSE;
-  GLint frag_status = GL_FALSE;
+  if (wait_for_completion) {
+    GLint vert_status = GL_FALSE;
+    GLint frag_status = GL_FALSE;
 
-  gl.GetShaderiv(vert_shader, GL_COMPILE_STATUS, &vert_status);
-  gl.GetShaderiv(frag_shader, GL_COMPILE_STATUS, &frag_status);
+    gl.GetShaderiv(vert_shader, GL_COMPILE_STATUS, &vert_status);
+    gl.GetShaderiv(frag_shader, GL_COMPILE_STATUS, &frag_status);
 
-  if (vert_status != GL_TRUE) {
-    LogShaderCompilationFailure(gl, vert_shader, descriptor.GetLabel(),
-                                *vert_mapping, ShaderStage::kVertex);
-    return false;
-  }
+    if (vert_status != GL_TRUE) {
+      LogShaderCompilationFailure(gl, vert_shader, descriptor.GetLabel(),
+                                  *vert_mapping, ShaderStage::kVertex);
+      return false;
+    }
 
-  if (frag_status != GL_TRUE) {
-    LogShaderCompilationFailure(gl, frag_shader, descriptor.GetLabel(),
-                                *frag_mapping, ShaderStage::kFragment);
-    return false;
+    if (frag_status != GL_TRUE) {
+      LogShaderCompilationFailure(gl, frag_shader, descriptor.GetLabel(),
+                                  *frag_mapping, ShaderStage::kFragment);
+      return false;
+    }
   }
 
   auto program = reactor.GetGLHandle(pipeline->GetProgramHandle());
@@ -163,6 +177,11 @@ static bool LinkProgram(
 
   gl.LinkProgram(*program);
 
+  if (!wait_for_completion) {
+    // Detaching and deleting the shaders doesn't affect the pending link.
+    return true;
+  }
+
   GLint link_status = GL_FALSE;
   gl.GetProgramiv(*program, GL_LINK_STATUS, &link_status);
 
@@ -211,8 +230,8 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryGLES::GetPipeline(
   auto weak_this = weak_from_this();
 
   auto result = reactor_->AddOperation(
-      [promise, weak_this, reactor_ptr = reactor_, descriptor, vert_function,
-       frag_function](const ReactorGLES& reactor) {
+      [promise, weak_this, reactor_ptr = reactor_, binary_cache = binary_cache_,
+       descriptor, vert_function, frag_function](const ReactorGLES& reactor) {
         auto strong_this = weak_this.lock();
         if (!strong_this) {
           promise->set_value(nullptr);
@@ -228,18 +247,78 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryGLES::GetPipeline(
           VALIDATION_LOG << "Could not obtain program handle.";
           return;
         }
-        const auto link_result = LinkProgram(reactor,        //
-                                             pipeline,       //
-                                             vert_function,  //
-                                             frag_function   //
+        const auto& gl = reactor.GetProcTable();
+        std::optional<uint64_t> binary_key;
+        if (binary_cache) {
+          binary_key = ProgramBinaryCacheGLES::CreateKey(
+              *ShaderFunctionGLES::Cast(*vert_function).GetSourceMapping(),
+              *ShaderFunctionGLES::Cast(*frag_function).GetSourceMapping(),
+              descriptor);
+          if (binary_cache->LoadProgram(gl, program.value(),
+                                        binary_key.value())) {
+            if (!pipeline->BuildVertexDescriptor(gl, program.value()) ||
+                !pipeline->IsValid()) {
+              promise->set_value(nullptr);
+              VALIDATION_LOG << "Could not build pipeline from program binary.";
+              return;
+            }
+            promise->set_value(std::move(pipeline));
+            return;
+          }
+          gl.ProgramParameteri(program.value(),
+                               GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+        // With parallel shader compilation, the pipeline is handed out while
+        // the driver is still linking its program. The link is polled for
+        // completion on every reaction and only waited on if the pipeline is
+        // used before it is done.
+        const bool link_in_parallel =
+            gl.GetCapabilities()->SupportsParallelShaderCompile();
+        const auto link_result = LinkProgram(reactor,           //
+                                             pipeline,          //
+                                             vert_function,     //
+                                             frag_function,     //
+                                             !link_in_parallel  //
         );
         if (!link_result) {
           promise->set_value(nullptr);
           VALIDATION_LOG << "Could not link pipeline program.";
           return;
         }
-        if (!pipeline->BuildVertexDescriptor(reactor.GetProcTable(),
-                                             program.value())) {
+        if (link_in_parallel) {
+          pipeline->link_status_ = PipelineGLES::LinkStatus::kPending;
+          auto poll = [weak_pipeline = std::weak_ptr<PipelineGLES>(pipeline),
+                       binary_cache, binary_key](const ReactorGLES& reactor) {
+            auto pipeline = weak_pipeline.lock();
+            if (!pipeline) {
+              return true;
+            }
+            const auto& gl = reactor.GetProcTable();
+            // The status may already have been resolved by a draw waiting on
+            // the link.
+            const auto status = pipeline->CheckLinkStatus(gl, /*wait=*/false);
+            if (status == PipelineGLES::LinkStatus::kPending) {
+              return false;
+            }
+            if (status == PipelineGLES::LinkStatus::kLinked && binary_key) {
+              auto program = reactor.GetGLHandle(pipeline->GetProgramHandle());
+              if (program.has_value()) {
+                binary_cache->StoreProgram(gl, program.value(),
+                                           binary_key.value());
+              }
+            }
+            return true;
+          };
+          if (!reactor_ptr->AddPollOperation(std::move(poll))) {
+            VALIDATION_LOG << "Could not poll pipeline program link.";
+          }
+          promise->set_value(std::move(pipeline));
+          return;
+        }
+        if (binary_key) {
+          binary_cache->StoreProgram(gl, program.value(), binary_key.value());
+        }
+        if (!pipeline->BuildVertexDescriptor(gl, program.value())) {
           promise->set_value(nullptr);
           VALIDATION_LOG << "Could not build pipeline vertex descriptors.";
           return;
@@ -5,7 +5,10 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PIPELINE_LIBRARY_GLES_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PIPELINE_LIBRARY_GLES_H_
 
+#include <memory>
+
 #include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/gles/program_binary_cache_gles.h"
 #include "impeller/renderer/backend/gles/reactor_gles.h"
 #include "impeller/renderer/pipeline_library.h"
 
@@ -22,9 +25,12 @@ class PipelineLibraryGLES final : public PipelineLibrary {
   friend ContextGLES;
 
   ReactorGLES::Ref reactor_;
+  std::shared_ptr<ProgramBinaryCacheGLES> binary_cache_;
   PipelineMap pipelines_;
 
-  explicit PipelineLibraryGLES(ReactorGLES::Ref reactor);
+  PipelineLibraryGLES(
+      ReactorGLES::Ref reactor,
+      std::shared_ptr<ProgramBinaryCacheGLES> binary_cache = nullptr);
 
   // |PipelineLibrary|
   bool IsValid() const override;
@@ -119,6 +119,7 @@ struct GLProc {
   PROC(ClearStencil);                        \
   PROC(ColorMask);                           \
   PROC(CompileShader);                       \
+  PROC(CompressedTexImage2D);                \
   PROC(CreateProgram);                       \
   PROC(CreateShader);                        \
   PROC(CullFace);                            \
@@ -188,7 +189,11 @@ struct GLProc {
   PROC(GetShaderSource);                     \
   PROC(ReadPixels);
 
-#define FOR_EACH_IMPELLER_GLES3_PROC(PROC) PROC(BlitFramebuffer);
+#define FOR_EACH_IMPELLER_GLES3_PROC(PROC) \
+  PROC(BlitFramebuffer);                  \
+  PROC(GetProgramBinary);                 \
+  PROC(ProgramBinary);                    \
+  PROC(ProgramParameteri);
 
 #define FOR_EACH_IMPELLER_EXT_PROC(PROC)    \
   PROC(DebugMessageControlKHR);             \
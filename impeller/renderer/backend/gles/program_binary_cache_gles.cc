@@ -0,0 +1,178 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/program_binary_cache_gles.h"
+
+#include <cinttypes>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/strings.h"
+#include "impeller/base/validation.h"
+#include "impeller/renderer/vertex_descriptor.h"
+
+namespace impeller {
+
+static constexpr const char* kProgramBinaryDirectoryName =
+    "flutter.impeller.glprograms";
+
+namespace {
+
+struct ProgramBinaryHeader {
+  // A prefix used to identify the file format.
+  static constexpr uint32_t kSignature = 0x49475042;
+  static constexpr uint32_t kVersion = 1u;
+
+  uint32_t signature = kSignature;
+  uint32_t version = kVersion;
+  uint64_t driver_hash = 0u;
+  uint64_t key = 0u;
+  uint32_t binary_format = 0u;
+  uint32_t binary_length = 0u;
+};
+
+std::string GetFileName(uint64_t key) {
+  return SPrintF("%016" PRIx64 ".bin", key);
+}
+
+std::string_view ToStringView(const fml::Mapping& mapping) {
+  return std::string_view(reinterpret_cast<const char*>(mapping.GetMapping()),
+                          mapping.GetSize());
+}
+
+}  // namespace
+
+bool ProgramBinaryCacheGLES::IsSupported(const ProcTableGLES& gl) {
+  if (!gl.GetProgramBinary.IsAvailable() || !gl.ProgramBinary.IsAvailable() ||
+      !gl.ProgramParameteri.IsAvailable()) {
+    return false;
+  }
+  const auto* description = gl.GetDescription();
+  auto version = description->GetGlVersion();
+  if (!version.IsAtLeast(description->IsES() ? Version(3, 0, 0)
+                                             : Version(4, 1, 0))) {
+    return false;
+  }
+  GLint format_count = 0;
+  gl.GetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+  return format_count > 0;
+}
+
+uint64_t ProgramBinaryCacheGLES::CreateKey(const fml::Mapping& vertex_source,
+                                           const fml::Mapping& fragment_source,
+                                           const PipelineDescriptor& desc) {
+  size_t seed = fml::HashCombine(ToStringView(vertex_source),
+                                 ToStringView(fragment_source));
+  for (auto constant : desc.GetSpecializationConstants()) {
+    fml::HashCombineSeed(seed, constant);
+  }
+  // Attribute locations are bound before linking and are part of the binary.
+  if (const auto& vertex_descriptor = desc.GetVertexDescriptor()) {
+    for (const auto& input : vertex_descriptor->GetStageInputs()) {
+      fml::HashCombineSeed(seed, std::string_view(input.name), input.location);
+    }
+  }
+  return static_cast<uint64_t>(seed);
+}
+
+ProgramBinaryCacheGLES::ProgramBinaryCacheGLES(
+    const fml::UniqueFD& cache_directory,
+    const std::string& driver_id)
+    : driver_hash_(static_cast<uint64_t>(std::hash<std::string>{}(driver_id))) {
+  if (!cache_directory.is_valid()) {
+    return;
+  }
+  directory_ = fml::OpenDirectory(cache_directory, kProgramBinaryDirectoryName,
+                                  true, fml::FilePermission::kReadWrite);
+}
+
+ProgramBinaryCacheGLES::~ProgramBinaryCacheGLES() = default;
+
+bool ProgramBinaryCacheGLES::IsValid() const {
+  return directory_.is_valid();
+}
+
+bool ProgramBinaryCacheGLES::LoadProgram(const ProcTableGLES& gl,
+                                         GLuint program,
+                                         uint64_t key) const {
+  if (!IsValid()) {
+    return false;
+  }
+  TRACE_EVENT0("impeller", "ProgramBinaryCacheGLES::LoadProgram");
+  const auto file_name = GetFileName(key);
+  auto mapping =
+      fml::FileMapping::CreateReadOnly(directory_, file_name.c_str());
+  if (!mapping || mapping->GetSize() < sizeof(ProgramBinaryHeader)) {
+    return false;
+  }
+
+  ProgramBinaryHeader header;
+  std::memcpy(&header, mapping->GetMapping(), sizeof(header));
+  if (header.signature != ProgramBinaryHeader::kSignature ||
+      header.version != ProgramBinaryHeader::kVersion ||
+      header.driver_hash != driver_hash_ || header.key != key ||
+      header.binary_length !=
+          mapping->GetSize() - sizeof(ProgramBinaryHeader)) {
+    // Stale binaries are replaced once the program is linked from source.
+    return false;
+  }
+
+  gl.ProgramBinary(program, header.binary_format,
+                   mapping->GetMapping() + sizeof(ProgramBinaryHeader),
+                   static_cast<GLsizei>(header.binary_length));
+
+  GLint link_status = GL_FALSE;
+  gl.GetProgramiv(program, GL_LINK_STATUS, &link_status);
+  if (link_status != GL_TRUE) {
+    FML_LOG(INFO) << "The driver rejected a cached program binary. Linking "
+                     "the program from source instead.";
+    fml::UnlinkFile(directory_, file_name.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool ProgramBinaryCacheGLES::StoreProgram(const ProcTableGLES& gl,
+                                          GLuint program,
+                                          uint64_t key) const {
+  if (!IsValid()) {
+    return false;
+  }
+  TRACE_EVENT0("impeller", "ProgramBinaryCacheGLES::StoreProgram");
+  GLint binary_length = 0;
+  gl.GetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_length);
+  if (binary_length <= 0) {
+    return false;
+  }
+
+  std::vector<uint8_t> data(sizeof(ProgramBinaryHeader) + binary_length);
+  GLsizei written_length = 0;
+  GLenum binary_format = GL_NONE;
+  gl.GetProgramBinary(program, binary_length, &written_length, &binary_format,
+                      data.data() + sizeof(ProgramBinaryHeader));
+  if (written_length <= 0 || written_length > binary_length) {
+    return false;
+  }
+  data.resize(sizeof(ProgramBinaryHeader) + written_length);
+
+  ProgramBinaryHeader header;
+  header.driver_hash = driver_hash_;
+  header.key = key;
+  header.binary_format = binary_format;
+  header.binary_length = static_cast<uint32_t>(written_length);
+  std::memcpy(data.data(), &header, sizeof(header));
+
+  fml::NonOwnedMapping mapping(data.data(), data.size());
+  if (!fml::WriteAtomically(directory_, GetFileName(key).c_str(), mapping)) {
+    VALIDATION_LOG << "Could not persist program binary.";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace impeller
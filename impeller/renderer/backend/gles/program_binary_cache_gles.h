@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PROGRAM_BINARY_CACHE_GLES_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PROGRAM_BINARY_CACHE_GLES_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/pipeline_descriptor.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Persists linked program binaries (`GL_PROGRAM_BINARY`) so that
+///             later launches can skip compiling and linking shaders from
+///             source.
+///
+///             Binaries are only valid for the driver that produced them. They
+///             are stored along with an identifier of the driver and ignored
+///             once it changes, for instance after a system update. Drivers
+///             may still reject a binary, in which case the program must be
+///             linked from source.
+///
+///             This object is thread safe. Its methods that take a proc table
+///             may only be called within reactor operations.
+///
+class ProgramBinaryCacheGLES {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the driver can retrieve and load program binaries.
+  ///
+  static bool IsSupported(const ProcTableGLES& gl);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a key identifying the program linked from the given
+  ///             shader sources for the descriptor. The key takes the
+  ///             specialization constants and vertex attribute locations of
+  ///             the descriptor into account.
+  ///
+  static uint64_t CreateKey(const fml::Mapping& vertex_source,
+                            const fml::Mapping& fragment_source,
+                            const PipelineDescriptor& desc);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a cache persisting binaries in a subdirectory of the
+  ///             given cache directory.
+  ///
+  /// @param[in]  cache_directory  The base directory of the cache.
+  /// @param[in]  driver_id        Identifies the driver and its version.
+  ///                              Binaries stored with a different identifier
+  ///                              are ignored.
+  ///
+  ProgramBinaryCacheGLES(const fml::UniqueFD& cache_directory,
+                         const std::string& driver_id);
+
+  ~ProgramBinaryCacheGLES();
+
+  bool IsValid() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Loads the binary stored for the key into the program.
+  ///
+  /// @return     Whether the program was successfully linked from the binary.
+  ///             Binaries rejected by the driver are removed from the cache.
+  ///
+  bool LoadProgram(const ProcTableGLES& gl, GLuint program, uint64_t key) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stores the binary of a successfully linked program.
+  ///
+  ///             The program should have been linked with
+  ///             `GL_PROGRAM_BINARY_RETRIEVABLE_HINT` set.
+  ///
+  /// @return     Whether the binary was persisted.
+  ///
+  bool StoreProgram(const ProcTableGLES& gl,
+                    GLuint program,
+                    uint64_t key) const;
+
+ private:
+  fml::UniqueFD directory_;
+  uint64_t driver_hash_ = 0u;
+
+  ProgramBinaryCacheGLES(const ProgramBinaryCacheGLES&) = delete;
+
+  ProgramBinaryCacheGLES& operator=(const ProgramBinaryCacheGLES&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PROGRAM_BINARY_CACHE_GLES_H_
@@ -5,6 +5,7 @@
 #include "impeller/renderer/backend/gles/reactor_gles.h"
 
 #include <algorithm>
+#include <iterator>
 
 #include "flutter/fml/trace_event.h"
 #include "fml/logging.h"
@@ -68,7 +69,7 @@ std::optional<GLuint> ReactorGLES::GetGLHandle(const HandleGLES& handle) const {
   return std::nullopt;
 }
 
-bool ReactorGLES::AddOperation(Operation operation) {
+bool ReactorGLES::AddOperation(Operation operation, bool defer) {
   if (!operation) {
     return false;
   }
@@ -76,11 +77,25 @@ bool ReactorGLES::AddOperation(Operation operation) {
     Lock ops_lock(ops_mutex_);
     ops_.emplace_back(std::move(operation));
   }
+  if (defer) {
+    return true;
+  }
   // Attempt a reaction if able but it is not an error if this isn't possible.
   [[maybe_unused]] auto result = React();
   return true;
 }
 
+bool ReactorGLES::AddPollOperation(PollOperation operation) {
+  if (!operation) {
+    return false;
+  }
+  {
+    Lock ops_lock(ops_mutex_);
+    polls_.emplace_back(std::move(operation));
+  }
+  return true;
+}
+
 static std::optional<GLuint> CreateGLHandle(const ProcTableGLES& gl,
                                             HandleType type) {
   GLuint handle = GL_NONE;
@@ -167,6 +182,10 @@ bool ReactorGLES::React() {
       return false;
     }
   }
+  {
+    Lock execution_lock(ops_execution_mutex_);
+    PollOnce();
+  }
   return true;
 }
 
@@ -259,6 +278,28 @@ bool ReactorGLES::FlushOps() {
   return true;
 }
 
+void ReactorGLES::PollOnce() {
+  // As with operations, the locks are not held while polling in case the polls
+  // add more operations or polls.
+  decltype(polls_) polls;
+  {
+    Lock ops_lock(ops_mutex_);
+    if (polls_.empty()) {
+      return;
+    }
+    std::swap(polls_, polls);
+  }
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  polls.erase(std::remove_if(polls.begin(), polls.end(),
+                             [&](const auto& poll) { return poll(*this); }),
+              polls.end());
+  if (polls.empty()) {
+    return;
+  }
+  Lock ops_lock(ops_mutex_);
+  std::move(polls.begin(), polls.end(), std::back_inserter(polls_));
+}
+
 void ReactorGLES::SetupDebugGroups() {
   // Setup of a default active debug group: Filter everything in.
   if (proc_table_->DebugMessageControlKHR.IsAvailable()) {
@@ -203,11 +203,34 @@ class ReactorGLES {
   ///             there is a reactor worker and the reactor itself is not being
   ///             torn down.
   ///
+  ///             Operations that are deferred are only queued and run along
+  ///             with other pending operations on the next reaction, for
+  ///             instance when a command buffer is submitted. This avoids the
+  ///             overhead of a reaction per operation.
+  ///
   /// @param[in]  operation  The operation
+  /// @param[in]  defer      Whether to skip attempting a reaction right away.
   ///
   /// @return     If the operation was successfully queued for completion.
   ///
-  [[nodiscard]] bool AddOperation(Operation operation);
+  [[nodiscard]] bool AddOperation(Operation operation, bool defer = false);
+
+  using PollOperation = std::function<bool(const ReactorGLES& reactor)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds an operation that the reactor calls once at the end of
+  ///             every reaction until it returns true.
+  ///
+  ///             Unlike operations added with `AddOperation`, pending polls
+  ///             don't keep the reactor reacting. They are meant for waiting
+  ///             on work that the driver performs asynchronously without
+  ///             blocking the thread performing the reaction.
+  ///
+  /// @param[in]  operation  The operation. It returns true once it is done.
+  ///
+  /// @return     If the operation was successfully queued for polling.
+  ///
+  [[nodiscard]] bool AddPollOperation(PollOperation operation);
 
   //----------------------------------------------------------------------------
   /// @brief      Perform a reaction on the current thread if able.
@@ -237,6 +260,7 @@ class ReactorGLES {
   Mutex ops_execution_mutex_;
   mutable Mutex ops_mutex_;
   std::vector<Operation> ops_ IPLR_GUARDED_BY(ops_mutex_);
+  std::vector<PollOperation> polls_ IPLR_GUARDED_BY(ops_mutex_);
 
   // Make sure the container is one where erasing items during iteration doesn't
   // invalidate other iterators.
@@ -256,6 +280,8 @@ class ReactorGLES {
 
   bool ReactOnce() IPLR_REQUIRES(ops_execution_mutex_);
 
+  void PollOnce() IPLR_REQUIRES(ops_execution_mutex_);
+
   bool HasPendingOperations() const;
 
   bool CanReactOnCurrentThread() const;
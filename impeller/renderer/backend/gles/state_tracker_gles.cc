@@ -0,0 +1,224 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/state_tracker_gles.h"
+
+#include "flutter/fml/logging.h"
+
+namespace impeller {
+
+StateTrackerGLES::StateTrackerGLES(const ProcTableGLES& gl) : gl_(gl) {}
+
+StateTrackerGLES::~StateTrackerGLES() = default;
+
+void StateTrackerGLES::SetDefaultState() {
+  SetEnabled(GL_SCISSOR_TEST, false);
+  SetEnabled(GL_DEPTH_TEST, false);
+  SetEnabled(GL_STENCIL_TEST, false);
+  SetEnabled(GL_CULL_FACE, false);
+  SetEnabled(GL_BLEND, false);
+  ColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+}
+
+void StateTrackerGLES::Unbind() {
+  SetEnabledVertexAttribArrays(0u);
+  UseProgram(0u);
+}
+
+std::optional<bool>* StateTrackerGLES::GetCapabilityState(GLenum capability) {
+  switch (capability) {
+    case GL_BLEND:
+      return &blend_;
+    case GL_CULL_FACE:
+      return &cull_face_;
+    case GL_DEPTH_TEST:
+      return &depth_test_;
+    case GL_SCISSOR_TEST:
+      return &scissor_test_;
+    case GL_STENCIL_TEST:
+      return &stencil_test_;
+    default:
+      return nullptr;
+  }
+}
+
+void StateTrackerGLES::SetEnabled(GLenum capability, bool enabled) {
+  auto* state = GetCapabilityState(capability);
+  if (state && !Update(*state, enabled)) {
+    return;
+  }
+  if (enabled) {
+    gl_.Enable(capability);
+  } else {
+    gl_.Disable(capability);
+  }
+}
+
+void StateTrackerGLES::BlendFuncSeparate(GLenum src_color,
+                                         GLenum dst_color,
+                                         GLenum src_alpha,
+                                         GLenum dst_alpha) {
+  if (Update(blend_func_, {src_color, dst_color, src_alpha, dst_alpha})) {
+    gl_.BlendFuncSeparate(src_color, dst_color, src_alpha, dst_alpha);
+  }
+}
+
+void StateTrackerGLES::BlendEquationSeparate(GLenum color_mode,
+                                             GLenum alpha_mode) {
+  if (Update(blend_equation_, {color_mode, alpha_mode})) {
+    gl_.BlendEquationSeparate(color_mode, alpha_mode);
+  }
+}
+
+void StateTrackerGLES::ColorMask(GLboolean red,
+                                 GLboolean green,
+                                 GLboolean blue,
+                                 GLboolean alpha) {
+  if (Update(color_mask_, {red, green, blue, alpha})) {
+    gl_.ColorMask(red, green, blue, alpha);
+  }
+}
+
+void StateTrackerGLES::StencilOpSeparate(GLenum face,
+                                         GLenum stencil_fail,
+                                         GLenum depth_fail,
+                                         GLenum depth_stencil_pass) {
+  if (UpdateFaces<std::array<GLenum, 3>>(
+          face, &StencilFaceState::op,
+          {stencil_fail, depth_fail, depth_stencil_pass})) {
+    gl_.StencilOpSeparate(face, stencil_fail, depth_fail, depth_stencil_pass);
+  }
+}
+
+void StateTrackerGLES::StencilFuncSeparate(GLenum face,
+                                           GLenum func,
+                                           GLint reference,
+                                           GLuint mask) {
+  if (UpdateFaces<std::array<GLuint, 3>>(
+          face, &StencilFaceState::func,
+          {func, static_cast<GLuint>(reference), mask})) {
+    gl_.StencilFuncSeparate(face, func, reference, mask);
+  }
+}
+
+void StateTrackerGLES::StencilMaskSeparate(GLenum face, GLuint mask) {
+  if (UpdateFaces<GLuint>(face, &StencilFaceState::write_mask, mask)) {
+    gl_.StencilMaskSeparate(face, mask);
+  }
+}
+
+void StateTrackerGLES::DepthFunc(GLenum func) {
+  if (Update(depth_func_, func)) {
+    gl_.DepthFunc(func);
+  }
+}
+
+void StateTrackerGLES::DepthMask(GLboolean enabled) {
+  if (Update(depth_mask_, enabled)) {
+    gl_.DepthMask(enabled);
+  }
+}
+
+void StateTrackerGLES::DepthRangef(GLfloat z_near, GLfloat z_far) {
+  if (Update(depth_range_, {z_near, z_far})) {
+    gl_.DepthRangef(z_near, z_far);
+  }
+}
+
+void StateTrackerGLES::Viewport(GLint x,
+                                GLint y,
+                                GLsizei width,
+                                GLsizei height) {
+  if (Update(viewport_, {x, y, width, height})) {
+    gl_.Viewport(x, y, width, height);
+  }
+}
+
+void StateTrackerGLES::Scissor(GLint x,
+                               GLint y,
+                               GLsizei width,
+                               GLsizei height) {
+  if (Update(scissor_, {x, y, width, height})) {
+    gl_.Scissor(x, y, width, height);
+  }
+}
+
+void StateTrackerGLES::CullFace(GLenum mode) {
+  if (Update(cull_face_mode_, mode)) {
+    gl_.CullFace(mode);
+  }
+}
+
+void StateTrackerGLES::FrontFace(GLenum mode) {
+  if (Update(front_face_, mode)) {
+    gl_.FrontFace(mode);
+  }
+}
+
+void StateTrackerGLES::UseProgram(GLuint program) {
+  if (Update(program_, program)) {
+    gl_.UseProgram(program);
+  }
+}
+
+void StateTrackerGLES::BindBuffer(GLenum target, GLuint buffer) {
+  std::optional<GLuint>* state = nullptr;
+  switch (target) {
+    case GL_ARRAY_BUFFER:
+      state = &array_buffer_;
+      break;
+    case GL_ELEMENT_ARRAY_BUFFER:
+      state = &element_array_buffer_;
+      break;
+    default:
+      break;
+  }
+  if (state && !Update(*state, buffer)) {
+    return;
+  }
+  gl_.BindBuffer(target, buffer);
+}
+
+void StateTrackerGLES::SetEnabledVertexAttribArrays(uint32_t mask) {
+  const auto changed = enabled_vertex_attribs_ ^ mask;
+  for (GLuint index = 0u; index < kMaxVertexAttribs; index++) {
+    const auto bit = 1u << index;
+    if ((changed & bit) == 0u) {
+      if (mask & bit) {
+        elided_call_count_++;
+      }
+      continue;
+    }
+    if (mask & bit) {
+      gl_.EnableVertexAttribArray(index);
+    } else {
+      gl_.DisableVertexAttribArray(index);
+    }
+  }
+  enabled_vertex_attribs_ = mask;
+}
+
+void StateTrackerGLES::VertexAttribPointer(GLuint index,
+                                           GLint size,
+                                           GLenum type,
+                                           GLboolean normalized,
+                                           GLsizei stride,
+                                           size_t offset) {
+  FML_DCHECK(index < kMaxVertexAttribs);
+  const auto buffer = array_buffer_.value_or(GL_NONE);
+  // Nothing is known about the buffer binding when it wasn't made through
+  // this tracker.
+  if (!array_buffer_.has_value() || index >= kMaxVertexAttribs ||
+      Update(vertex_attribs_[index], {buffer, size, type, normalized, stride,
+                                      offset})) {
+    gl_.VertexAttribPointer(index, size, type, normalized, stride,
+                            reinterpret_cast<const GLvoid*>(offset));
+  }
+}
+
+size_t StateTrackerGLES::GetElidedCallCount() const {
+  return elided_call_count_;
+}
+
+}  // namespace impeller
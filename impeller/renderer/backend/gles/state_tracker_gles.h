@@ -0,0 +1,220 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_TRACKER_GLES_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_TRACKER_GLES_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Shadows the GL state set while encoding a render pass and
+///             elides calls that would not change it.
+///
+///             GL state belongs to the context that is current on the calling
+///             thread and reactor operations may run on different contexts.
+///             Nothing is assumed about state that wasn't set through this
+///             object, so a tracker should only live for the duration of a
+///             single reactor operation.
+///
+///             Calls are forwarded to the proc table verbatim. There is no
+///             validation of the arguments.
+///
+class StateTrackerGLES {
+ public:
+  //----------------------------------------------------------------------------
+  /// The highest vertex attribute location (exclusive) that can be tracked.
+  ///
+  static constexpr GLuint kMaxVertexAttribs = 32u;
+
+  explicit StateTrackerGLES(const ProcTableGLES& gl);
+
+  ~StateTrackerGLES();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Disables blending along with the scissor, depth, stencil and
+  ///             cull face tests and enables writes to all color channels. This
+  ///             is the state expected when clearing attachments.
+  ///
+  void SetDefaultState();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Disables all vertex attribute arrays enabled through this
+  ///             object and unbinds the program.
+  ///
+  void Unbind();
+
+  void SetEnabled(GLenum capability, bool enabled);
+
+  void BlendFuncSeparate(GLenum src_color,
+                         GLenum dst_color,
+                         GLenum src_alpha,
+                         GLenum dst_alpha);
+
+  void BlendEquationSeparate(GLenum color_mode, GLenum alpha_mode);
+
+  void ColorMask(GLboolean red,
+                 GLboolean green,
+                 GLboolean blue,
+                 GLboolean alpha);
+
+  void StencilOpSeparate(GLenum face,
+                         GLenum stencil_fail,
+                         GLenum depth_fail,
+                         GLenum depth_stencil_pass);
+
+  void StencilFuncSeparate(GLenum face,
+                           GLenum func,
+                           GLint reference,
+                           GLuint mask);
+
+  void StencilMaskSeparate(GLenum face, GLuint mask);
+
+  void DepthFunc(GLenum func);
+
+  void DepthMask(GLboolean enabled);
+
+  void DepthRangef(GLfloat z_near, GLfloat z_far);
+
+  void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+  void Scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+  void CullFace(GLenum mode);
+
+  void FrontFace(GLenum mode);
+
+  void UseProgram(GLuint program);
+
+  void BindBuffer(GLenum target, GLuint buffer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Enables the vertex attribute arrays in the mask and disables
+  ///             all others.
+  ///
+  /// @param[in]  mask  A bit for each vertex attribute location.
+  ///
+  void SetEnabledVertexAttribArrays(uint32_t mask);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Specifies a vertex attribute sourced from the currently bound
+  ///             array buffer. Calls are only elided if the same buffer is
+  ///             still bound.
+  ///
+  void VertexAttribPointer(GLuint index,
+                           GLint size,
+                           GLenum type,
+                           GLboolean normalized,
+                           GLsizei stride,
+                           size_t offset);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of calls that were elided by this tracker.
+  ///
+  size_t GetElidedCallCount() const;
+
+ private:
+  struct StencilFaceState {
+    std::optional<std::array<GLenum, 3>> op;
+    std::optional<std::array<GLuint, 3>> func;
+    std::optional<GLuint> write_mask;
+  };
+
+  struct VertexAttribState {
+    GLuint buffer = GL_NONE;
+    GLint size = 0;
+    GLenum type = GL_NONE;
+    GLboolean normalized = GL_FALSE;
+    GLsizei stride = 0;
+    size_t offset = 0u;
+
+    constexpr bool operator==(const VertexAttribState& o) const {
+      return buffer == o.buffer && size == o.size && type == o.type &&
+             normalized == o.normalized && stride == o.stride &&
+             offset == o.offset;
+    }
+  };
+
+  const ProcTableGLES& gl_;
+  std::optional<bool> blend_;
+  std::optional<bool> cull_face_;
+  std::optional<bool> depth_test_;
+  std::optional<bool> scissor_test_;
+  std::optional<bool> stencil_test_;
+  std::optional<std::array<GLenum, 4>> blend_func_;
+  std::optional<std::array<GLenum, 2>> blend_equation_;
+  std::optional<std::array<GLboolean, 4>> color_mask_;
+  StencilFaceState stencil_front_;
+  StencilFaceState stencil_back_;
+  std::optional<GLenum> depth_func_;
+  std::optional<GLboolean> depth_mask_;
+  std::optional<std::array<GLfloat, 2>> depth_range_;
+  std::optional<std::array<GLint, 4>> viewport_;
+  std::optional<std::array<GLint, 4>> scissor_;
+  std::optional<GLenum> cull_face_mode_;
+  std::optional<GLenum> front_face_;
+  std::optional<GLuint> program_;
+  std::optional<GLuint> array_buffer_;
+  std::optional<GLuint> element_array_buffer_;
+  uint32_t enabled_vertex_attribs_ = 0u;
+  std::array<std::optional<VertexAttribState>, kMaxVertexAttribs>
+      vertex_attribs_;
+  size_t elided_call_count_ = 0u;
+
+  std::optional<bool>* GetCapabilityState(GLenum capability);
+
+  template <class T>
+  bool Update(std::optional<T>& state, const T& value) {
+    if (state.has_value() && *state == value) {
+      elided_call_count_++;
+      return false;
+    }
+    state = value;
+    return true;
+  }
+
+  template <class T>
+  bool UpdateFaces(GLenum face,
+                   std::optional<T> StencilFaceState::*member,
+                   const T& value) {
+    auto& front = stencil_front_.*member;
+    auto& back = stencil_back_.*member;
+    const bool front_matches = front.has_value() && *front == value;
+    const bool back_matches = back.has_value() && *back == value;
+    bool needs_update = false;
+    switch (face) {
+      case GL_FRONT:
+        needs_update = !front_matches;
+        front = value;
+        break;
+      case GL_BACK:
+        needs_update = !back_matches;
+        back = value;
+        break;
+      default:
+        needs_update = !front_matches || !back_matches;
+        front = value;
+        back = value;
+        break;
+    }
+    if (!needs_update) {
+      elided_call_count_++;
+    }
+    return needs_update;
+  }
+
+  StateTrackerGLES(const StateTrackerGLES&) = delete;
+
+  StateTrackerGLES& operator=(const StateTrackerGLES&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_TRACKER_GLES_H_
@@ -64,5 +64,21 @@ TEST(CapabilitiesGLES, SupportsFramebufferFetch) {
   EXPECT_TRUE(capabilities->SupportsFramebufferFetch());
 }
 
+TEST(CapabilitiesGLES, SupportsParallelShaderCompile) {
+  {
+    auto mock_gles = MockGLES::Init();
+    auto capabilities = mock_gles->GetProcTable().GetCapabilities();
+    EXPECT_FALSE(capabilities->SupportsParallelShaderCompile());
+  }
+  auto const extensions = std::vector<const unsigned char*>{
+      reinterpret_cast<const unsigned char*>("GL_KHR_debug"),  //
+      reinterpret_cast<const unsigned char*>(
+          "GL_KHR_parallel_shader_compile"),  //
+  };
+  auto mock_gles = MockGLES::Init(extensions);
+  auto capabilities = mock_gles->GetProcTable().GetCapabilities();
+  EXPECT_TRUE(capabilities->SupportsParallelShaderCompile());
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
 #include "GLES3/gl3.h"
@@ -79,6 +81,9 @@ void mockGetIntegerv(GLenum name, int* value) {
     case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
       *value = 8;
       break;
+    case GL_NUM_PROGRAM_BINARY_FORMATS:
+      *value = 1;
+      break;
     default:
       *value = 0;
       break;
@@ -159,6 +164,119 @@ void mockDeleteQueriesEXT(GLsizei size, const GLuint* queries) {
 static_assert(CheckSameSignature<decltype(mockDeleteQueriesEXT),  //
                                  decltype(glDeleteQueriesEXT)>::value);
 
+void mockEnable(GLenum cap) {
+  RecordGLCall("glEnable");
+}
+
+static_assert(CheckSameSignature<decltype(mockEnable),  //
+                                 decltype(glEnable)>::value);
+
+void mockDisable(GLenum cap) {
+  RecordGLCall("glDisable");
+}
+
+static_assert(CheckSameSignature<decltype(mockDisable),  //
+                                 decltype(glDisable)>::value);
+
+void mockUseProgram(GLuint program) {
+  RecordGLCall("glUseProgram");
+}
+
+static_assert(CheckSameSignature<decltype(mockUseProgram),  //
+                                 decltype(glUseProgram)>::value);
+
+void mockBindBuffer(GLenum target, GLuint buffer) {
+  RecordGLCall("glBindBuffer");
+}
+
+static_assert(CheckSameSignature<decltype(mockBindBuffer),  //
+                                 decltype(glBindBuffer)>::value);
+
+void mockBlendFuncSeparate(GLenum src_color,
+                           GLenum dst_color,
+                           GLenum src_alpha,
+                           GLenum dst_alpha) {
+  RecordGLCall("glBlendFuncSeparate");
+}
+
+static_assert(CheckSameSignature<decltype(mockBlendFuncSeparate),  //
+                                 decltype(glBlendFuncSeparate)>::value);
+
+void mockEnableVertexAttribArray(GLuint index) {
+  RecordGLCall("glEnableVertexAttribArray");
+}
+
+static_assert(CheckSameSignature<decltype(mockEnableVertexAttribArray),  //
+                                 decltype(glEnableVertexAttribArray)>::value);
+
+void mockDisableVertexAttribArray(GLuint index) {
+  RecordGLCall("glDisableVertexAttribArray");
+}
+
+static_assert(CheckSameSignature<decltype(mockDisableVertexAttribArray),  //
+                                 decltype(glDisableVertexAttribArray)>::value);
+
+void mockVertexAttribPointer(GLuint index,
+                             GLint size,
+                             GLenum type,
+                             GLboolean normalized,
+                             GLsizei stride,
+                             const void* pointer) {
+  RecordGLCall("glVertexAttribPointer");
+}
+
+static_assert(CheckSameSignature<decltype(mockVertexAttribPointer),  //
+                                 decltype(glVertexAttribPointer)>::value);
+
+static constexpr GLenum kMockProgramBinaryFormat = 1u;
+static constexpr uint8_t kMockProgramBinary[] = {0xF, 0x1, 0x7, 0x7};
+
+void mockGetProgramiv(GLuint program, GLenum name, GLint* value) {
+  switch (name) {
+    case GL_LINK_STATUS:
+      *value = GL_TRUE;
+      break;
+    case GL_PROGRAM_BINARY_LENGTH:
+      *value = sizeof(kMockProgramBinary);
+      break;
+    default:
+      *value = 0;
+      break;
+  }
+}
+
+static_assert(CheckSameSignature<decltype(mockGetProgramiv),  //
+                                 decltype(glGetProgramiv)>::value);
+
+void mockGetProgramBinary(GLuint program,
+                          GLsizei buffer_size,
+                          GLsizei* length,
+                          GLenum* binary_format,
+                          void* binary) {
+  RecordGLCall("glGetProgramBinary");
+  auto size = std::min<GLsizei>(buffer_size, sizeof(kMockProgramBinary));
+  std::memcpy(binary, kMockProgramBinary, size);
+  *length = size;
+  *binary_format = kMockProgramBinaryFormat;
+}
+
+static_assert(CheckSameSignature<decltype(mockGetProgramBinary),  //
+                                 decltype(glGetProgramBinary)>::value);
+
+void mockProgramBinary(GLuint program,
+                       GLenum binary_format,
+                       const void* binary,
+                       GLsizei length) {
+  const bool matches =
+      binary_format == kMockProgramBinaryFormat &&
+      length == sizeof(kMockProgramBinary) &&
+      std::memcmp(binary, kMockProgramBinary, sizeof(kMockProgramBinary)) == 0;
+  RecordGLCall(matches ? "glProgramBinary" : "glProgramBinary (mismatch)");
+}
+
+static_assert(CheckSameSignature<decltype(mockProgramBinary),  //
+                                 decltype(glProgramBinary)>::value);
+
 std::shared_ptr<MockGLES> MockGLES::Init(
     const std::optional<std::vector<const unsigned char*>>& extensions) {
   // If we cannot obtain a lock, MockGLES is already being used elsewhere.
@@ -195,6 +313,28 @@ const ProcTableGLES::Resolver kMockResolver = [](const char* name) {
     return reinterpret_cast<void*>(mockGetQueryObjectui64vEXT);
   } else if (strcmp(name, "glGetQueryObjectuivEXT") == 0) {
     return reinterpret_cast<void*>(mockGetQueryObjectuivEXT);
+  } else if (strcmp(name, "glEnable") == 0) {
+    return reinterpret_cast<void*>(&mockEnable);
+  } else if (strcmp(name, "glDisable") == 0) {
+    return reinterpret_cast<void*>(&mockDisable);
+  } else if (strcmp(name, "glUseProgram") == 0) {
+    return reinterpret_cast<void*>(&mockUseProgram);
+  } else if (strcmp(name, "glBindBuffer") == 0) {
+    return reinterpret_cast<void*>(&mockBindBuffer);
+  } else if (strcmp(name, "glBlendFuncSeparate") == 0) {
+    return reinterpret_cast<void*>(&mockBlendFuncSeparate);
+  } else if (strcmp(name, "glEnableVertexAttribArray") == 0) {
+    return reinterpret_cast<void*>(&mockEnableVertexAttribArray);
+  } else if (strcmp(name, "glDisableVertexAttribArray") == 0) {
+    return reinterpret_cast<void*>(&mockDisableVertexAttribArray);
+  } else if (strcmp(name, "glVertexAttribPointer") == 0) {
+    return reinterpret_cast<void*>(&mockVertexAttribPointer);
+  } else if (strcmp(name, "glGetProgramiv") == 0) {
+    return reinterpret_cast<void*>(&mockGetProgramiv);
+  } else if (strcmp(name, "glGetProgramBinary") == 0) {
+    return reinterpret_cast<void*>(&mockGetProgramBinary);
+  } else if (strcmp(name, "glProgramBinary") == 0) {
+    return reinterpret_cast<void*>(&mockProgramBinary);
   } else {
     return reinterpret_cast<void*>(&doNothing);
   }
@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/gles/program_binary_cache_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+namespace testing {
+
+static constexpr GLuint kProgram = 1u;
+
+TEST(ProgramBinaryCacheGLES, LoadsStoredPrograms) {
+  auto mock_gles = MockGLES::Init();
+  const auto& gl = mock_gles->GetProcTable();
+  fml::ScopedTemporaryDirectory directory;
+
+  ProgramBinaryCacheGLES cache(directory.fd(), "Driver 1.0");
+  ASSERT_TRUE(cache.IsValid());
+  EXPECT_FALSE(cache.LoadProgram(gl, kProgram, 42u));
+
+  EXPECT_TRUE(cache.StoreProgram(gl, kProgram, 42u));
+  EXPECT_TRUE(cache.LoadProgram(gl, kProgram, 42u));
+  EXPECT_FALSE(cache.LoadProgram(gl, kProgram, 43u));
+
+  auto calls = mock_gles->GetCapturedCalls();
+  EXPECT_EQ(calls, (std::vector<std::string>{"glGetProgramBinary",
+                                             "glProgramBinary"}));
+}
+
+TEST(ProgramBinaryCacheGLES, IgnoresProgramsOfOtherDrivers) {
+  auto mock_gles = MockGLES::Init();
+  const auto& gl = mock_gles->GetProcTable();
+  fml::ScopedTemporaryDirectory directory;
+
+  {
+    ProgramBinaryCacheGLES cache(directory.fd(), "Driver 1.0");
+    ASSERT_TRUE(cache.StoreProgram(gl, kProgram, 42u));
+  }
+
+  ProgramBinaryCacheGLES updated_cache(directory.fd(), "Driver 2.0");
+  EXPECT_FALSE(updated_cache.LoadProgram(gl, kProgram, 42u));
+
+  ProgramBinaryCacheGLES cache(directory.fd(), "Driver 1.0");
+  EXPECT_TRUE(cache.LoadProgram(gl, kProgram, 42u));
+}
+
+TEST(ProgramBinaryCacheGLES, KeysDependOnSourcesAndConstants) {
+  fml::NonOwnedMapping vertex(reinterpret_cast<const uint8_t*>("vertex"), 6u);
+  fml::NonOwnedMapping fragment(reinterpret_cast<const uint8_t*>("fragment"),
+                                8u);
+  PipelineDescriptor desc;
+  auto key = ProgramBinaryCacheGLES::CreateKey(vertex, fragment, desc);
+  EXPECT_EQ(ProgramBinaryCacheGLES::CreateKey(vertex, fragment, desc), key);
+  EXPECT_NE(ProgramBinaryCacheGLES::CreateKey(fragment, vertex, desc), key);
+
+  desc.SetSpecializationConstants({1.0f});
+  EXPECT_NE(ProgramBinaryCacheGLES::CreateKey(vertex, fragment, desc), key);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -0,0 +1,80 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/gles/state_tracker_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+namespace testing {
+
+using Calls = std::vector<std::string>;
+
+TEST(StateTrackerGLES, ElidesRedundantStateChanges) {
+  auto mock_gles = MockGLES::Init();
+  StateTrackerGLES state(mock_gles->GetProcTable());
+
+  state.SetDefaultState();
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            (Calls{"glDisable", "glDisable", "glDisable", "glDisable",
+                   "glDisable"}));
+
+  state.SetEnabled(GL_BLEND, false);
+  state.SetEnabled(GL_BLEND, true);
+  state.SetEnabled(GL_BLEND, true);
+  state.BlendFuncSeparate(GL_ONE, GL_ZERO, GL_ONE, GL_ZERO);
+  state.BlendFuncSeparate(GL_ONE, GL_ZERO, GL_ONE, GL_ZERO);
+  state.BlendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ZERO);
+  state.UseProgram(1u);
+  state.UseProgram(1u);
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            (Calls{"glEnable", "glBlendFuncSeparate", "glBlendFuncSeparate",
+                   "glUseProgram"}));
+  EXPECT_EQ(state.GetElidedCallCount(), 4u);
+}
+
+TEST(StateTrackerGLES, ForwardsUntrackedCapabilities) {
+  auto mock_gles = MockGLES::Init();
+  StateTrackerGLES state(mock_gles->GetProcTable());
+
+  state.SetEnabled(GL_DITHER, false);
+  state.SetEnabled(GL_DITHER, false);
+  EXPECT_EQ(mock_gles->GetCapturedCalls(), (Calls{"glDisable", "glDisable"}));
+  EXPECT_EQ(state.GetElidedCallCount(), 0u);
+}
+
+TEST(StateTrackerGLES, KeepsVertexAttribArraysEnabledBetweenDraws) {
+  auto mock_gles = MockGLES::Init();
+  StateTrackerGLES state(mock_gles->GetProcTable());
+
+  state.BindBuffer(GL_ARRAY_BUFFER, 1u);
+  state.SetEnabledVertexAttribArrays(0b011u);
+  state.VertexAttribPointer(0u, 2, GL_FLOAT, GL_FALSE, 16, 0u);
+  state.VertexAttribPointer(1u, 2, GL_FLOAT, GL_FALSE, 16, 8u);
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            (Calls{"glBindBuffer", "glEnableVertexAttribArray",
+                   "glEnableVertexAttribArray", "glVertexAttribPointer",
+                   "glVertexAttribPointer"}));
+
+  // Same buffer and layout.
+  state.BindBuffer(GL_ARRAY_BUFFER, 1u);
+  state.SetEnabledVertexAttribArrays(0b001u);
+  state.VertexAttribPointer(0u, 2, GL_FLOAT, GL_FALSE, 16, 0u);
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            (Calls{"glDisableVertexAttribArray"}));
+
+  // Pointers must be specified again for a different buffer.
+  state.BindBuffer(GL_ARRAY_BUFFER, 2u);
+  state.VertexAttribPointer(0u, 2, GL_FLOAT, GL_FALSE, 16, 0u);
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            (Calls{"glBindBuffer", "glVertexAttribPointer"}));
+
+  state.Unbind();
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            (Calls{"glDisableVertexAttribArray", "glUseProgram"}));
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -96,6 +96,9 @@ struct TexImage2DData {
   GLint internal_format = 0;
   GLenum external_format = GL_NONE;
   GLenum type = GL_NONE;
+  // Whether the data must be uploaded with `glCompressedTexImage2D`, in which
+  // case only the internal format is set.
+  bool compressed = false;
   std::shared_ptr<const fml::Mapping> data;
 
   explicit TexImage2DData(PixelFormat pixel_format) {
@@ -133,6 +136,18 @@ struct TexImage2DData {
         external_format = GL_DEPTH_STENCIL;
         type = GL_UNSIGNED_INT_24_8;
         break;
+      case PixelFormat::kETC2R8G8B8A8UNormInt:
+        internal_format = GL_COMPRESSED_RGBA8_ETC2_EAC;
+        compressed = true;
+        break;
+      case PixelFormat::kASTC4x4UNormInt:
+        internal_format = GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+        compressed = true;
+        break;
+      case PixelFormat::kBC7UNormInt:
+        internal_format = GL_COMPRESSED_RGBA_BPTC_UNORM_EXT;
+        compressed = true;
+        break;
       case PixelFormat::kUnknown:
       case PixelFormat::kD24UnormS8Uint:
       case PixelFormat::kD32FloatS8UInt:
@@ -255,6 +270,18 @@ bool TextureGLES::OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
     {
       TRACE_EVENT1("impeller", "TexImage2DUpload", "Bytes",
                    std::to_string(data->data->GetSize()).c_str());
+      if (data->compressed) {
+        gl.CompressedTexImage2D(texture_target,         // target
+                                0u,                     // LOD level
+                                data->internal_format,  // internal format
+                                size.width,             // width
+                                size.height,            // height
+                                0u,                     // border
+                                data->data->GetSize(),  // image size
+                                tex_data                // data
+        );
+        return;
+      }
       gl.TexImage2D(texture_target,         // target
                     0u,                     // LOD level
                     data->internal_format,  // internal format
@@ -301,6 +328,9 @@ static std::optional<GLenum> ToRenderBufferFormat(PixelFormat format) {
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kBC7UNormInt:
       return std::nullopt;
   }
   FML_UNREACHABLE();
@@ -340,6 +370,11 @@ void TextureGLES::InitializeContentsIfNecessary() const {
         VALIDATION_LOG << "Invalid format for texture image.";
         return;
       }
+      if (tex_data.compressed) {
+        VALIDATION_LOG << "Compressed textures must be initialized with their "
+                          "contents.";
+        return;
+      }
       gl.BindTexture(GL_TEXTURE_2D, handle.value());
       {
         TRACE_EVENT0("impeller", "TexImage2DInitialization");
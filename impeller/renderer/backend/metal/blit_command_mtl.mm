@@ -114,17 +114,19 @@ bool BlitCopyBufferToTextureCommandMTL::Encode(
   }
 
   auto destination_origin_mtl =
-      MTLOriginMake(destination_origin.x, destination_origin.y, 0);
+      MTLOriginMake(destination_region.GetX(), destination_region.GetY(), 0);
 
-  auto image_size = destination->GetTextureDescriptor().size;
-  auto source_size_mtl = MTLSizeMake(image_size.width, image_size.height, 1);
+  auto source_size_mtl = MTLSizeMake(destination_region.GetWidth(),
+                                     destination_region.GetHeight(), 1);
 
-  auto destination_bytes_per_pixel =
-      BytesPerPixelForPixelFormat(destination->GetTextureDescriptor().format);
-  auto destination_bytes_per_row =
-      source_size_mtl.width * destination_bytes_per_pixel;
+  // Rows of compressed formats are rows of blocks, which the descriptor of
+  // the copied region accounts for.
+  auto region_descriptor = destination->GetTextureDescriptor();
+  region_descriptor.size = destination_region.GetSize();
+  region_descriptor.mip_count = 1u;
+  auto destination_bytes_per_row = region_descriptor.GetBytesPerRow();
   auto destination_bytes_per_image =
-      source_size_mtl.height * destination_bytes_per_row;
+      region_descriptor.GetByteSizeOfBaseMipLevel();
 
   [encoder copyFromBuffer:source_mtl
              sourceOffset:source.range.offset
@@ -95,6 +95,10 @@ class ContextMTL final : public Context,
 
   const std::shared_ptr<fml::ConcurrentTaskRunner> GetWorkerTaskRunner() const;
 
+  // |Context|
+  std::shared_ptr<fml::ConcurrentTaskRunner> GetConcurrentWorkerTaskRunner()
+      const override;
+
   std::shared_ptr<const fml::SyncSwitch> GetIsGpuDisabledSyncSwitch() const;
 
 #ifdef IMPELLER_DEBUG
@@ -104,6 +108,13 @@ class ContextMTL final : public Context,
   // |Context|
   void StoreTaskForGPU(const std::function<void()>& task) override;
 
+  // |Context|
+  std::optional<fml::TimeDelta> GetLastGPUFrameTime() const override;
+
+  // |Context|
+  std::optional<PipelineStatistics> GetLastGPUFramePipelineStatistics()
+      const override;
+
  private:
   class SyncSwitchObserver : public fml::SyncSwitch::Observer {
    public:
@@ -51,6 +51,30 @@ static bool DeviceSupportsComputeSubgroups(id<MTLDevice> device) {
   return supports_subgroups;
 }
 
+static bool DeviceSupportsMobileTextureCompression(id<MTLDevice> device) {
+  // ASTC and ETC2 are available on all Apple GPUs, including Apple silicon
+  // Macs, but not on Intel and AMD GPUs.
+  if (@available(macOS 10.15, iOS 13, tvOS 13, *)) {
+    return [device supportsFamily:MTLGPUFamilyApple2];
+  }
+#if FML_OS_IOS
+  return true;
+#else
+  return false;
+#endif  // FML_OS_IOS
+}
+
+static bool DeviceSupportsBCTextureCompression(id<MTLDevice> device) {
+  if (@available(macOS 11.0, iOS 16.4, tvOS 16.4, *)) {
+    return [device supportsBCTextureCompression];
+  }
+#if FML_OS_IOS
+  return false;
+#else
+  return true;
+#endif  // FML_OS_IOS
+}
+
 static std::unique_ptr<Capabilities> InferMetalCapabilities(
     id<MTLDevice> device,
     PixelFormat color_format) {
@@ -68,6 +92,14 @@ static std::unique_ptr<Capabilities> InferMetalCapabilities(
       .SetSupportsComputeSubgroups(DeviceSupportsComputeSubgroups(device))
       .SetSupportsReadFromResolve(true)
       .SetSupportsDeviceTransientTextures(true)
+      .SetSupportsCompressedTextureFormat(
+          PixelFormat::kETC2R8G8B8A8UNormInt,
+          DeviceSupportsMobileTextureCompression(device))
+      .SetSupportsCompressedTextureFormat(
+          PixelFormat::kASTC4x4UNormInt,
+          DeviceSupportsMobileTextureCompression(device))
+      .SetSupportsCompressedTextureFormat(
+          PixelFormat::kBC7UNormInt, DeviceSupportsBCTextureCompression(device))
       .Build();
 }
 
@@ -148,7 +180,7 @@ ContextMTL::ContextMTL(
   device_capabilities_ =
       InferMetalCapabilities(device_, PixelFormat::kB8G8R8A8UNormInt);
 #ifdef IMPELLER_DEBUG
-  gpu_tracer_ = std::make_shared<GPUTracerMTL>();
+  gpu_tracer_ = std::make_shared<GPUTracerMTL>(device_);
 #endif  // IMPELLER_DEBUG
   is_valid_ = true;
 }
@@ -340,11 +372,36 @@ std::shared_ptr<GPUTracerMTL> ContextMTL::GetGPUTracer() const {
 }
 #endif  // IMPELLER_DEBUG
 
+// |Context|
+std::optional<fml::TimeDelta> ContextMTL::GetLastGPUFrameTime() const {
+#ifdef IMPELLER_DEBUG
+  return gpu_tracer_ ? gpu_tracer_->GetLastFrameTime() : std::nullopt;
+#else
+  return std::nullopt;
+#endif  // IMPELLER_DEBUG
+}
+
+// |Context|
+std::optional<PipelineStatistics>
+ContextMTL::GetLastGPUFramePipelineStatistics() const {
+#ifdef IMPELLER_DEBUG
+  return gpu_tracer_ ? gpu_tracer_->GetLastFramePipelineStatistics()
+                     : std::nullopt;
+#else
+  return std::nullopt;
+#endif  // IMPELLER_DEBUG
+}
+
 const std::shared_ptr<fml::ConcurrentTaskRunner>
 ContextMTL::GetWorkerTaskRunner() const {
   return raster_message_loop_->GetTaskRunner();
 }
 
+std::shared_ptr<fml::ConcurrentTaskRunner>
+ContextMTL::GetConcurrentWorkerTaskRunner() const {
+  return raster_message_loop_->GetTaskRunner();
+}
+
 std::shared_ptr<const fml::SyncSwitch> ContextMTL::GetIsGpuDisabledSyncSwitch()
     const {
   return is_gpu_disabled_sync_switch_;
@@ -50,6 +50,12 @@ constexpr PixelFormat FromMTLPixelFormat(MTLPixelFormat format) {
       return PixelFormat::kB10G10R10XR;
     case MTLPixelFormatBGRA10_XR:
       return PixelFormat::kB10G10R10A10XR;
+    case MTLPixelFormatEAC_RGBA8:
+      return PixelFormat::kETC2R8G8B8A8UNormInt;
+    case MTLPixelFormatASTC_4x4_LDR:
+      return PixelFormat::kASTC4x4UNormInt;
+    case MTLPixelFormatBC7_RGBAUnorm:
+      return PixelFormat::kBC7UNormInt;
     default:
       return PixelFormat::kUnknown;
   }
@@ -74,6 +80,20 @@ MTLPixelFormat SafeMTLPixelFormatBGR10_XR();
 /// Returns PixelFormat::kUnknown if MTLPixelFormatBGR10_XR isn't supported.
 MTLPixelFormat SafeMTLPixelFormatBGRA10_XR();
 
+/// Safe accessor for MTLPixelFormatEAC_RGBA8.
+/// Returns PixelFormat::kUnknown if MTLPixelFormatEAC_RGBA8 isn't supported.
+MTLPixelFormat SafeMTLPixelFormatEAC_RGBA8();
+
+/// Safe accessor for MTLPixelFormatASTC_4x4_LDR.
+/// Returns PixelFormat::kUnknown if MTLPixelFormatASTC_4x4_LDR isn't
+/// supported.
+MTLPixelFormat SafeMTLPixelFormatASTC_4x4_LDR();
+
+/// Safe accessor for MTLPixelFormatBC7_RGBAUnorm.
+/// Returns PixelFormat::kUnknown if MTLPixelFormatBC7_RGBAUnorm isn't
+/// supported.
+MTLPixelFormat SafeMTLPixelFormatBC7_RGBAUnorm();
+
 constexpr MTLPixelFormat ToMTLPixelFormat(PixelFormat format) {
   switch (format) {
     case PixelFormat::kUnknown:
@@ -108,6 +128,12 @@ constexpr MTLPixelFormat ToMTLPixelFormat(PixelFormat format) {
       return SafeMTLPixelFormatBGR10_XR();
     case PixelFormat::kB10G10R10A10XR:
       return SafeMTLPixelFormatBGRA10_XR();
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+      return SafeMTLPixelFormatEAC_RGBA8();
+    case PixelFormat::kASTC4x4UNormInt:
+      return SafeMTLPixelFormatASTC_4x4_LDR();
+    case PixelFormat::kBC7UNormInt:
+      return SafeMTLPixelFormatBC7_RGBAUnorm();
   }
   return MTLPixelFormatInvalid;
 };
@@ -9,9 +9,12 @@
 
 #include <memory>
 #include <optional>
+
+#include "flutter/fml/time/time_delta.h"
 #include "impeller/base/thread.h"
 #include "impeller/base/thread_safety.h"
 #include "impeller/geometry/scalar.h"
+#include "impeller/renderer/gpu_statistics.h"
 
 namespace impeller {
 
@@ -20,10 +23,16 @@ class ContextMTL;
 /// @brief Approximate the GPU frame time by computing a difference between the
 ///        smallest GPUStartTime and largest GPUEndTime for all command buffers
 ///        submitted in a frame workload.
+///
+///        When the device samples the statistic counter set at stage
+///        boundaries, the pipeline statistics of the render passes of a frame
+///        are counted too.
 class GPUTracerMTL : public std::enable_shared_from_this<GPUTracerMTL> {
  public:
   GPUTracerMTL() = default;
 
+  explicit GPUTracerMTL(id<MTLDevice> device);
+
   ~GPUTracerMTL() = default;
 
   /// @brief Record that the current frame has ended. Any additional cmd buffers
@@ -34,16 +43,49 @@ class GPUTracerMTL : public std::enable_shared_from_this<GPUTracerMTL> {
   ///        aggregate frame workload metric.
   void RecordCmdBuffer(id<MTLCommandBuffer> buffer);
 
+  /// @brief Attach a counter sample buffer to the render pass descriptor that
+  ///        samples the statistic counters at the start of its vertex stage
+  ///        and at the end of its fragment stage. Must be called before the
+  ///        render command encoder is created.
+  void SampleRenderPass(MTLRenderPassDescriptor* desc);
+
+  /// @brief The GPU time of the most recently measured frame, if any.
+  std::optional<fml::TimeDelta> GetLastFrameTime() const;
+
+  /// @brief The pipeline statistics of the most recently measured frame, if
+  ///        any.
+  std::optional<PipelineStatistics> GetLastFramePipelineStatistics() const;
+
  private:
+  static constexpr size_t kMaxSampledPasses = 256u;
+
   struct GPUTraceState {
     Scalar smallest_timestamp = std::numeric_limits<float>::max();
     Scalar largest_timestamp = 0;
     size_t pending_buffers = 0;
+    // Two samples, at the start and the end of the pass, per sampled pass.
+    id<MTLCounterSampleBuffer> sample_buffer API_AVAILABLE(
+        ios(14.0), tvos(14.0), macos(10.15)) = nil;
+    size_t sampled_passes = 0;
   };
 
+  /// @brief Sum the pipeline statistics sampled for the passes of a completed
+  ///        trace state.
+  void ResolvePipelineStatistics(GPUTraceState& state)
+      IPLR_REQUIRES(trace_state_mutex_);
+
+  id<MTLDevice> device_ = nil;
+  id<MTLCounterSet> statistic_counter_set_ API_AVAILABLE(ios(14.0),
+                                                         tvos(14.0),
+                                                         macos(10.15)) = nil;
+
   mutable Mutex trace_state_mutex_;
   GPUTraceState trace_states_[16] IPLR_GUARDED_BY(trace_state_mutex_);
   size_t current_state_ IPLR_GUARDED_BY(trace_state_mutex_) = 0u;
+  std::optional<fml::TimeDelta> last_frame_time_ IPLR_GUARDED_BY(
+      trace_state_mutex_);
+  std::optional<PipelineStatistics> last_frame_pipeline_statistics_
+      IPLR_GUARDED_BY(trace_state_mutex_);
 };
 
 }  // namespace impeller
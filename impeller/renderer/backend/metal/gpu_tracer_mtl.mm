@@ -13,10 +13,117 @@
 
 namespace impeller {
 
+GPUTracerMTL::GPUTracerMTL(id<MTLDevice> device) : device_(device) {
+  if (@available(ios 14.0, tvos 14.0, macos 11.0, macCatalyst 14.0, *)) {
+    if (![device_ supportsCounterSampling:
+                      MTLCounterSamplingPointAtStageBoundary]) {
+      return;
+    }
+    for (id<MTLCounterSet> counter_set in device_.counterSets) {
+      if ([counter_set.name isEqualToString:MTLCommonCounterSetStatistic]) {
+        statistic_counter_set_ = counter_set;
+        break;
+      }
+    }
+  }
+}
+
 void GPUTracerMTL::MarkFrameEnd() {
   if (@available(ios 10.3, tvos 10.2, macos 10.15, macCatalyst 13.0, *)) {
     Lock lock(trace_state_mutex_);
     current_state_ = (current_state_ + 1) % 16;
+    trace_states_[current_state_].sampled_passes = 0;
+  }
+}
+
+std::optional<fml::TimeDelta> GPUTracerMTL::GetLastFrameTime() const {
+  Lock lock(trace_state_mutex_);
+  return last_frame_time_;
+}
+
+std::optional<PipelineStatistics>
+GPUTracerMTL::GetLastFramePipelineStatistics() const {
+  Lock lock(trace_state_mutex_);
+  return last_frame_pipeline_statistics_;
+}
+
+void GPUTracerMTL::SampleRenderPass(MTLRenderPassDescriptor* desc) {
+  if (@available(ios 14.0, tvos 14.0, macos 11.0, macCatalyst 14.0, *)) {
+    if (!statistic_counter_set_) {
+      return;
+    }
+    Lock lock(trace_state_mutex_);
+    auto& state = trace_states_[current_state_];
+    if (state.sampled_passes >= kMaxSampledPasses) {
+      return;
+    }
+    if (!state.sample_buffer) {
+      MTLCounterSampleBufferDescriptor* buffer_desc =
+          [[MTLCounterSampleBufferDescriptor alloc] init];
+      buffer_desc.counterSet = statistic_counter_set_;
+      buffer_desc.storageMode = MTLStorageModeShared;
+      buffer_desc.sampleCount = kMaxSampledPasses * 2;
+      NSError* error = nil;
+      state.sample_buffer =
+          [device_ newCounterSampleBufferWithDescriptor:buffer_desc
+                                                  error:&error];
+      if (!state.sample_buffer) {
+        // Stop sampling instead of failing on every pass.
+        statistic_counter_set_ = nil;
+        return;
+      }
+    }
+
+    const auto start_index = state.sampled_passes * 2;
+    auto attachment = desc.sampleBufferAttachments[0];
+    attachment.sampleBuffer = state.sample_buffer;
+    attachment.startOfVertexSampleIndex = start_index;
+    attachment.endOfVertexSampleIndex = MTLCounterDontSample;
+    attachment.startOfFragmentSampleIndex = MTLCounterDontSample;
+    attachment.endOfFragmentSampleIndex = start_index + 1;
+    state.sampled_passes += 1;
+  }
+}
+
+void GPUTracerMTL::ResolvePipelineStatistics(GPUTraceState& state) {
+  if (@available(ios 14.0, tvos 14.0, macos 11.0, macCatalyst 14.0, *)) {
+    if (!state.sample_buffer || state.sampled_passes == 0) {
+      return;
+    }
+    NSData* data = [state.sample_buffer
+        resolveCounterRange:NSMakeRange(0, state.sampled_passes * 2)];
+    if (!data ||
+        data.length < state.sampled_passes * 2 *
+                          sizeof(MTLCounterResultStatistic)) {
+      return;
+    }
+    auto samples =
+        reinterpret_cast<const MTLCounterResultStatistic*>(data.bytes);
+    auto is_valid = [](const MTLCounterResultStatistic& sample) {
+      return sample.vertexInvocations != MTLCounterErrorValue &&
+             sample.clipperInvocations != MTLCounterErrorValue &&
+             sample.clipperPrimitivesOut != MTLCounterErrorValue &&
+             sample.fragmentInvocations != MTLCounterErrorValue;
+    };
+
+    PipelineStatistics statistics;
+    for (auto i = 0u; i < state.sampled_passes; i++) {
+      const auto& start = samples[i * 2];
+      const auto& end = samples[i * 2 + 1];
+      if (!is_valid(start) || !is_valid(end)) {
+        continue;
+      }
+      statistics += {
+          .vertex_invocations = end.vertexInvocations - start.vertexInvocations,
+          .clipping_invocations =
+              end.clipperInvocations - start.clipperInvocations,
+          .clipping_primitives =
+              end.clipperPrimitivesOut - start.clipperPrimitivesOut,
+          .fragment_invocations =
+              end.fragmentInvocations - start.fragmentInvocations};
+    }
+    state.sampled_passes = 0;
+    last_frame_pipeline_statistics_ = statistics;
   }
 }
 
@@ -41,8 +148,10 @@ void GPUTracerMTL::RecordCmdBuffer(id<MTLCommandBuffer> buffer) {
           state.largest_timestamp, static_cast<Scalar>(buffer.GPUEndTime));
 
       if (state.pending_buffers == 0) {
+        self->ResolvePipelineStatistics(state);
         auto gpu_ms =
             (state.largest_timestamp - state.smallest_timestamp) * 1000;
+        self->last_frame_time_ = fml::TimeDelta::FromMillisecondsF(gpu_ms);
         state.smallest_timestamp = std::numeric_limits<float>::max();
         state.largest_timestamp = 0;
         FML_TRACE_COUNTER("flutter", "GPUTracer",
@@ -4,6 +4,11 @@
 
 #include "impeller/renderer/backend/metal/render_pass_mtl.h"
 
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <optional>
+
 #include "flutter/fml/closure.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
@@ -143,6 +148,13 @@ RenderPassMTL::RenderPassMTL(std::weak_ptr<const Context> context,
   if (!buffer_ || !desc_ || !render_target_.IsValid()) {
     return;
   }
+#ifdef IMPELLER_DEBUG
+  if (auto strong_context = context_.lock()) {
+    if (auto tracer = ContextMTL::Cast(*strong_context).GetGPUTracer()) {
+      tracer->SampleRenderPass(desc_);
+    }
+  }
+#endif  // IMPELLER_DEBUG
   is_valid_ = true;
 }
 
@@ -189,10 +201,21 @@ bool RenderPassMTL::OnEncodeCommands(const Context& context) const {
 ///             the frame insights during profiling and instrumentation not
 ///             complain about the same.
 ///
+///             Buffers, textures and samplers that change between draws are
+///             only recorded when set, and bound by |FlushBindings| with one
+///             call per stage and resource kind for the contiguous range of
+///             slots that changed.
+///
 ///             There should be no change to rendering if this caching was
 ///             absent.
 ///
 struct PassBindingsCache {
+  /// The buffer slots available to each stage, the last of which is the
+  /// |VertexDescriptor::kReservedVertexBufferIndex|.
+  static constexpr size_t kMaxBufferBindings = 31u;
+  static constexpr size_t kMaxTextureBindings = 128u;
+  static constexpr size_t kMaxSamplerBindings = 16u;
+
   explicit PassBindingsCache(id<MTLRenderCommandEncoder> encoder)
       : encoder_(encoder) {}
 
@@ -216,94 +239,124 @@ struct PassBindingsCache {
     [encoder_ setDepthStencilState:depth_stencil_];
   }
 
+  void SetFrontFacingWinding(MTLWinding winding) {
+    if (winding_.has_value() && winding_.value() == winding) {
+      return;
+    }
+    winding_ = winding;
+    [encoder_ setFrontFacingWinding:winding];
+  }
+
+  void SetCullMode(MTLCullMode cull_mode) {
+    if (cull_mode_.has_value() && cull_mode_.value() == cull_mode) {
+      return;
+    }
+    cull_mode_ = cull_mode;
+    [encoder_ setCullMode:cull_mode];
+  }
+
+  void SetTriangleFillMode(MTLTriangleFillMode fill_mode) {
+    if (fill_mode_.has_value() && fill_mode_.value() == fill_mode) {
+      return;
+    }
+    fill_mode_ = fill_mode;
+    [encoder_ setTriangleFillMode:fill_mode];
+  }
+
+  void SetStencilReferenceValue(uint32_t value) {
+    if (stencil_reference_.has_value() && stencil_reference_.value() == value) {
+      return;
+    }
+    stencil_reference_ = value;
+    [encoder_ setStencilReferenceValue:value];
+  }
+
   bool SetBuffer(ShaderStage stage,
                  uint64_t index,
                  uint64_t offset,
                  id<MTLBuffer> buffer) {
-    auto& buffers_map = buffers_[stage];
-    auto found = buffers_map.find(index);
-    if (found != buffers_map.end() && found->second.buffer == buffer) {
+    auto* bindings = GetStageBindings(stage);
+    if (!bindings) {
+      VALIDATION_LOG << "Cannot bind buffer to unknown shader stage.";
+      return false;
+    }
+    if (index >= kMaxBufferBindings) {
+      VALIDATION_LOG << "Buffer binding index " << index << " is out of range.";
+      return false;
+    }
+    if (bindings->buffers[index] == buffer) {
       // The right buffer is bound. Check if its offset needs to be updated.
-      if (found->second.offset == offset) {
+      if (bindings->buffer_offsets[index] == offset) {
         // Buffer and its offset is identical. Nothing to do.
         return true;
       }
 
-      // Only the offset needs to be updated.
-      found->second.offset = offset;
-
-      switch (stage) {
-        case ShaderStage::kVertex:
-          [encoder_ setVertexBufferOffset:offset atIndex:index];
-          return true;
-        case ShaderStage::kFragment:
-          [encoder_ setFragmentBufferOffset:offset atIndex:index];
-          return true;
-        default:
-          VALIDATION_LOG << "Cannot update buffer offset of an unknown stage.";
-          return false;
+      // Only the offset needs to be updated. If the slot is about to be bound
+      // anyway, the new offset is bound along with it.
+      bindings->buffer_offsets[index] = offset;
+      if (bindings->dirty_buffers.Contains(index)) {
+        return true;
+      }
+      if (stage == ShaderStage::kVertex) {
+        [encoder_ setVertexBufferOffset:offset atIndex:index];
+      } else {
+        [encoder_ setFragmentBufferOffset:offset atIndex:index];
       }
       return true;
     }
-    buffers_map[index] = {buffer, static_cast<size_t>(offset)};
-    switch (stage) {
-      case ShaderStage::kVertex:
-        [encoder_ setVertexBuffer:buffer offset:offset atIndex:index];
-        return true;
-      case ShaderStage::kFragment:
-        [encoder_ setFragmentBuffer:buffer offset:offset atIndex:index];
-        return true;
-      default:
-        VALIDATION_LOG << "Cannot bind buffer to unknown shader stage.";
-        return false;
-    }
-    return false;
+    bindings->buffers[index] = buffer;
+    bindings->buffer_offsets[index] = offset;
+    bindings->dirty_buffers.Add(index);
+    return true;
   }
 
   bool SetTexture(ShaderStage stage, uint64_t index, id<MTLTexture> texture) {
-    auto& texture_map = textures_[stage];
-    auto found = texture_map.find(index);
-    if (found != texture_map.end() && found->second == texture) {
+    auto* bindings = GetStageBindings(stage);
+    if (!bindings) {
+      VALIDATION_LOG << "Cannot bind texture to unknown shader stage.";
+      return false;
+    }
+    if (index >= kMaxTextureBindings) {
+      VALIDATION_LOG << "Texture binding index " << index
+                     << " is out of range.";
+      return false;
+    }
+    if (bindings->textures[index] == texture) {
       // Already bound.
       return true;
     }
-    texture_map[index] = texture;
-    switch (stage) {
-      case ShaderStage::kVertex:
-        [encoder_ setVertexTexture:texture atIndex:index];
-        return true;
-      case ShaderStage::kFragment:
-        [encoder_ setFragmentTexture:texture atIndex:index];
-        return true;
-      default:
-        VALIDATION_LOG << "Cannot bind buffer to unknown shader stage.";
-        return false;
-    }
-    return false;
+    bindings->textures[index] = texture;
+    bindings->dirty_textures.Add(index);
+    return true;
   }
 
   bool SetSampler(ShaderStage stage,
                   uint64_t index,
                   id<MTLSamplerState> sampler) {
-    auto& sampler_map = samplers_[stage];
-    auto found = sampler_map.find(index);
-    if (found != sampler_map.end() && found->second == sampler) {
+    auto* bindings = GetStageBindings(stage);
+    if (!bindings) {
+      VALIDATION_LOG << "Cannot bind sampler to unknown shader stage.";
+      return false;
+    }
+    if (index >= kMaxSamplerBindings) {
+      VALIDATION_LOG << "Sampler binding index " << index
+                     << " is out of range.";
+      return false;
+    }
+    if (bindings->samplers[index] == sampler) {
       // Already bound.
       return true;
     }
-    sampler_map[index] = sampler;
-    switch (stage) {
-      case ShaderStage::kVertex:
-        [encoder_ setVertexSamplerState:sampler atIndex:index];
-        return true;
-      case ShaderStage::kFragment:
-        [encoder_ setFragmentSamplerState:sampler atIndex:index];
-        return true;
-      default:
-        VALIDATION_LOG << "Cannot bind buffer to unknown shader stage.";
-        return false;
-    }
-    return false;
+    bindings->samplers[index] = sampler;
+    bindings->dirty_samplers.Add(index);
+    return true;
+  }
+
+  /// Binds the buffers, textures and samplers set since the last flush. Must
+  /// be called before each draw.
+  void FlushBindings() {
+    FlushStage(ShaderStage::kVertex, vertex_bindings_);
+    FlushStage(ShaderStage::kFragment, fragment_bindings_);
   }
 
   void SetViewport(const Viewport& viewport) {
@@ -337,20 +390,91 @@ struct PassBindingsCache {
   }
 
  private:
-  struct BufferOffsetPair {
-    id<MTLBuffer> buffer = nullptr;
-    size_t offset = 0u;
+  /// The slots changed since the last flush, including any unchanged slots
+  /// in between.
+  struct DirtyRange {
+    NSUInteger begin = std::numeric_limits<NSUInteger>::max();
+    NSUInteger end = 0u;
+
+    void Add(NSUInteger index) {
+      begin = std::min(begin, index);
+      end = std::max(end, index + 1);
+    }
+
+    bool Contains(NSUInteger index) const {
+      return index >= begin && index < end;
+    }
+
+    bool IsEmpty() const { return begin >= end; }
+
+    NSRange GetRange() const { return NSMakeRange(begin, end - begin); }
   };
-  using BufferMap = std::map<uint64_t, BufferOffsetPair>;
-  using TextureMap = std::map<uint64_t, id<MTLTexture>>;
-  using SamplerMap = std::map<uint64_t, id<MTLSamplerState>>;
+
+  struct StageBindings {
+    std::array<id<MTLBuffer>, kMaxBufferBindings> buffers = {};
+    std::array<NSUInteger, kMaxBufferBindings> buffer_offsets = {};
+    std::array<id<MTLTexture>, kMaxTextureBindings> textures = {};
+    std::array<id<MTLSamplerState>, kMaxSamplerBindings> samplers = {};
+    DirtyRange dirty_buffers;
+    DirtyRange dirty_textures;
+    DirtyRange dirty_samplers;
+  };
+
+  StageBindings* GetStageBindings(ShaderStage stage) {
+    switch (stage) {
+      case ShaderStage::kVertex:
+        return &vertex_bindings_;
+      case ShaderStage::kFragment:
+        return &fragment_bindings_;
+      default:
+        return nullptr;
+    }
+  }
+
+  void FlushStage(ShaderStage stage, StageBindings& bindings) {
+    const bool vertex = stage == ShaderStage::kVertex;
+    if (!bindings.dirty_buffers.IsEmpty()) {
+      const auto range = bindings.dirty_buffers.GetRange();
+      const auto* buffers = bindings.buffers.data() + range.location;
+      const auto* offsets = bindings.buffer_offsets.data() + range.location;
+      if (vertex) {
+        [encoder_ setVertexBuffers:buffers offsets:offsets withRange:range];
+      } else {
+        [encoder_ setFragmentBuffers:buffers offsets:offsets withRange:range];
+      }
+      bindings.dirty_buffers = {};
+    }
+    if (!bindings.dirty_textures.IsEmpty()) {
+      const auto range = bindings.dirty_textures.GetRange();
+      const auto* textures = bindings.textures.data() + range.location;
+      if (vertex) {
+        [encoder_ setVertexTextures:textures withRange:range];
+      } else {
+        [encoder_ setFragmentTextures:textures withRange:range];
+      }
+      bindings.dirty_textures = {};
+    }
+    if (!bindings.dirty_samplers.IsEmpty()) {
+      const auto range = bindings.dirty_samplers.GetRange();
+      const auto* samplers = bindings.samplers.data() + range.location;
+      if (vertex) {
+        [encoder_ setVertexSamplerStates:samplers withRange:range];
+      } else {
+        [encoder_ setFragmentSamplerStates:samplers withRange:range];
+      }
+      bindings.dirty_samplers = {};
+    }
+  }
 
   const id<MTLRenderCommandEncoder> encoder_;
   id<MTLRenderPipelineState> pipeline_ = nullptr;
   id<MTLDepthStencilState> depth_stencil_ = nullptr;
-  std::map<ShaderStage, BufferMap> buffers_;
-  std::map<ShaderStage, TextureMap> textures_;
-  std::map<ShaderStage, SamplerMap> samplers_;
+  std::optional<MTLWinding> winding_;
+  std::optional<MTLCullMode> cull_mode_;
+  std::optional<MTLTriangleFillMode> fill_mode_;
+  std::optional<uint32_t> stencil_reference_;
+  StageBindings vertex_bindings_;
+  StageBindings fragment_bindings_;
   std::optional<Viewport> viewport_;
   std::optional<IRect> scissor_;
 };
@@ -457,14 +581,14 @@ bool RenderPassMTL::EncodeCommands(const std::shared_ptr<Allocator>& allocator,
     pass_bindings.SetScissor(
         command.scissor.value_or(IRect::MakeSize(GetRenderTargetSize())));
 
-    [encoder setFrontFacingWinding:pipeline_desc.GetWindingOrder() ==
-                                           WindingOrder::kClockwise
-                                       ? MTLWindingClockwise
-                                       : MTLWindingCounterClockwise];
-    [encoder setCullMode:ToMTLCullMode(pipeline_desc.GetCullMode())];
-    [encoder setTriangleFillMode:ToMTLTriangleFillMode(
-                                     pipeline_desc.GetPolygonMode())];
-    [encoder setStencilReferenceValue:command.stencil_reference];
+    pass_bindings.SetFrontFacingWinding(
+        pipeline_desc.GetWindingOrder() == WindingOrder::kClockwise
+            ? MTLWindingClockwise
+            : MTLWindingCounterClockwise);
+    pass_bindings.SetCullMode(ToMTLCullMode(pipeline_desc.GetCullMode()));
+    pass_bindings.SetTriangleFillMode(
+        ToMTLTriangleFillMode(pipeline_desc.GetPolygonMode()));
+    pass_bindings.SetStencilReferenceValue(command.stencil_reference);
 
     if (!Bind(pass_bindings, *allocator, ShaderStage::kVertex,
               VertexDescriptor::kReservedVertexBufferIndex,
@@ -479,6 +603,7 @@ bool RenderPassMTL::EncodeCommands(const std::shared_ptr<Allocator>& allocator,
                               ShaderStage::kFragment)) {
       return false;
     }
+    pass_bindings.FlushBindings();
 
     const PrimitiveType primitive_type = pipeline_desc.GetPrimitiveType();
     if (command.vertex_buffer.index_type == IndexType::kNone) {
@@ -4,11 +4,18 @@
 
 #include "impeller/renderer/backend/vulkan/allocator_vk.h"
 
+#include <algorithm>
+#include <functional>
 #include <memory>
+#include <unordered_map>
 
 #include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/core/formats.h"
+#include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
+#include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
+#include "impeller/renderer/backend/vulkan/descriptor_set_cache_vk.h"
 #include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
 #include "impeller/renderer/backend/vulkan/texture_vk.h"
@@ -84,6 +91,55 @@ static PoolVMA CreateBufferPool(VmaAllocator allocator) {
   return {allocator, pool};
 }
 
+/// The size of the blocks of the render target pool. Render targets at least
+/// half this size get a dedicated allocation instead.
+static constexpr VkDeviceSize kRenderTargetPoolBlockSize = 32u * 1024u * 1024u;
+
+/// Render targets are created and destroyed every few frames as the render
+/// target cache and the subpasses of a scene change. Keeping them in their own
+/// pool stops the gaps they leave from fragmenting the blocks of long lived
+/// images.
+static PoolVMA CreateRenderTargetPool(VmaAllocator allocator) {
+  vk::ImageCreateInfo image_info;
+  image_info.imageType = vk::ImageType::e2D;
+  image_info.format = vk::Format::eR8G8B8A8Unorm;
+  image_info.extent = VkExtent3D{1u, 1u, 1u};
+  image_info.samples = vk::SampleCountFlagBits::e1;
+  image_info.mipLevels = 1u;
+  image_info.arrayLayers = 1u;
+  image_info.tiling = vk::ImageTiling::eOptimal;
+  image_info.usage = vk::ImageUsageFlagBits::eColorAttachment |
+                     vk::ImageUsageFlagBits::eSampled |
+                     vk::ImageUsageFlagBits::eTransferSrc |
+                     vk::ImageUsageFlagBits::eTransferDst;
+  image_info.sharingMode = vk::SharingMode::eExclusive;
+  auto image_info_native =
+      static_cast<vk::ImageCreateInfo::NativeType>(image_info);
+
+  VmaAllocationCreateInfo allocation_info = {};
+  allocation_info.usage = VMA_MEMORY_USAGE_AUTO;
+  allocation_info.preferredFlags = static_cast<VkMemoryPropertyFlags>(
+      vk::MemoryPropertyFlagBits::eDeviceLocal);
+
+  uint32_t memTypeIndex;
+  auto result = vk::Result{vmaFindMemoryTypeIndexForImageInfo(
+      allocator, &image_info_native, &allocation_info, &memTypeIndex)};
+  if (result != vk::Result::eSuccess) {
+    return {};
+  }
+
+  VmaPoolCreateInfo pool_create_info = {};
+  pool_create_info.memoryTypeIndex = memTypeIndex;
+  pool_create_info.blockSize = kRenderTargetPoolBlockSize;
+
+  VmaPool pool = {};
+  result = vk::Result{::vmaCreatePool(allocator, &pool_create_info, &pool)};
+  if (result != vk::Result::eSuccess) {
+    return {};
+  }
+  return {allocator, pool};
+}
+
 AllocatorVK::AllocatorVK(std::weak_ptr<Context> context,
                          uint32_t vulkan_api_version,
                          const vk::PhysicalDevice& physical_device,
@@ -135,6 +191,11 @@ AllocatorVK::AllocatorVK(std::weak_ptr<Context> context,
   allocator_info.device = device_holder->GetDevice();
   allocator_info.instance = instance;
   allocator_info.pVulkanFunctions = &proc_table;
+  if (capabilities.HasOptionalDeviceExtension(
+          OptionalDeviceExtensionVK::kEXTMemoryBudget)) {
+    allocator_info.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+    supports_memory_budget_ = true;
+  }
 
   VmaAllocator allocator = {};
   auto result = vk::Result{::vmaCreateAllocator(&allocator_info, &allocator)};
@@ -144,6 +205,7 @@ AllocatorVK::AllocatorVK(std::weak_ptr<Context> context,
   }
   staging_buffer_pool_.reset(CreateBufferPool(allocator));
   created_buffer_pool_ &= staging_buffer_pool_.is_valid();
+  render_target_pool_.reset(CreateRenderTargetPool(allocator));
   allocator_.reset(allocator);
   supports_memoryless_textures_ =
       capabilities.SupportsDeviceTransientTextures();
@@ -261,15 +323,65 @@ static VmaAllocationCreateFlags ToVmaAllocationCreateFlags(StorageMode mode) {
   FML_UNREACHABLE();
 }
 
+static bool IsDedicatedAllocation(const TextureDescriptor& desc) {
+  return desc.GetByteSizeOfBaseMipLevel() *
+             static_cast<size_t>(desc.sample_count) >=
+         kRenderTargetPoolBlockSize / 2u;
+}
+
+static bool IsPooledRenderTarget(const TextureDescriptor& desc) {
+  return desc.storage_mode == StorageMode::kDevicePrivate &&
+         (desc.usage &
+          static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)) &&
+         !IsDedicatedAllocation(desc);
+}
+
+/// Whether the image of a texture may be moved to another allocation while
+/// compacting memory. Transient textures have no contents to move, and
+/// dedicated allocations don't share their memory with other textures.
+static bool IsRelocatable(const TextureDescriptor& desc) {
+  return desc.storage_mode == StorageMode::kDevicePrivate &&
+         desc.sample_count == SampleCount::kCount1 &&
+         !IsDedicatedAllocation(desc);
+}
+
+static void EncodeImageBarrier(const vk::CommandBuffer& cmd_buffer,
+                               vk::Image image,
+                               vk::ImageAspectFlags aspect,
+                               vk::ImageLayout old_layout,
+                               vk::ImageLayout new_layout,
+                               vk::PipelineStageFlags src_stage,
+                               vk::AccessFlags src_access,
+                               vk::PipelineStageFlags dst_stage,
+                               vk::AccessFlags dst_access) {
+  vk::ImageMemoryBarrier barrier;
+  barrier.image = image;
+  barrier.oldLayout = old_layout;
+  barrier.newLayout = new_layout;
+  barrier.srcAccessMask = src_access;
+  barrier.dstAccessMask = dst_access;
+  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.subresourceRange.aspectMask = aspect;
+  barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+  barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+  cmd_buffer.pipelineBarrier(src_stage, dst_stage, {}, nullptr, nullptr,
+                             barrier);
+}
+
 class AllocatedTextureSourceVK final : public TextureSourceVK {
  public:
   AllocatedTextureSourceVK(std::weak_ptr<ResourceManagerVK> resource_manager,
                            const TextureDescriptor& desc,
                            VmaAllocator allocator,
+                           VmaPool render_target_pool,
                            vk::Device device,
                            bool supports_memoryless_textures,
                            bool supports_framebuffer_fetch)
-      : TextureSourceVK(desc), resource_(std::move(resource_manager)) {
+      : TextureSourceVK(desc),
+        allocator_(allocator),
+        device_(device),
+        resource_(std::move(resource_manager)) {
     FML_DCHECK(desc.format != PixelFormat::kUnknown);
     vk::ImageCreateInfo image_info;
     image_info.flags = ToVKImageCreateFlags(desc.type);
@@ -297,6 +409,11 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
         static_cast<VkMemoryPropertyFlags>(ToVKTextureMemoryPropertyFlags(
             desc.storage_mode, supports_memoryless_textures));
     alloc_nfo.flags = ToVmaAllocationCreateFlags(desc.storage_mode);
+    if (IsDedicatedAllocation(desc)) {
+      alloc_nfo.flags |= VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+    } else if (render_target_pool != VmaPool{} && IsPooledRenderTarget(desc)) {
+      alloc_nfo.pool = render_target_pool;
+    }
 
     auto create_info_native =
         static_cast<vk::ImageCreateInfo::NativeType>(image_info);
@@ -312,6 +429,18 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
                                                 &allocation,          //
                                                 &allocation_info      //
                                                 )};
+      if (result != vk::Result::eSuccess && alloc_nfo.pool != VmaPool{}) {
+        // The memory type of the pool may not suit this format, or the pool
+        // may be out of memory. Fall back to the default pools.
+        alloc_nfo.pool = VmaPool{};
+        result = vk::Result{::vmaCreateImage(allocator,            //
+                                             &create_info_native,  //
+                                             &alloc_nfo,           //
+                                             &vk_image,            //
+                                             &allocation,          //
+                                             &allocation_info      //
+                                             )};
+      }
       if (result != vk::Result::eSuccess) {
         VALIDATION_LOG << "Unable to allocate Vulkan Image: "
                        << vk::to_string(result)
@@ -329,6 +458,8 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
     }
 
     auto image = vk::Image{vk_image};
+    image_info_ = image_info;
+    alloc_info_ = alloc_nfo;
 
     vk::ImageViewCreateInfo view_info = {};
     view_info.image = image;
@@ -353,6 +484,7 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
                      << vk::to_string(result);
       return;
     }
+    view_info_ = view_info;
     resource_.Swap(ImageResource(ImageVMA{allocator, allocation, image},
                                  std::move(image_view)));
     is_valid_ = true;
@@ -362,6 +494,130 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
 
   bool IsValid() const { return is_valid_; }
 
+  VmaAllocationInfo GetAllocationInfo() const {
+    VmaAllocationInfo info = {};
+    ::vmaGetAllocationInfo(allocator_, resource_->image.get().allocation,
+                           &info);
+    return info;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Allocates a new image for the texture and encodes a copy of
+  ///             the contents of the current image into it. The texture keeps
+  ///             using the current image until |CommitRelocation| is called
+  ///             once the copy completed.
+  ///
+  /// @param[in]  accept  Whether the new allocation is worth moving to, given
+  ///                     the block of device memory it was placed in.
+  ///
+  /// @return     The block of device memory of the new allocation, or
+  ///             nullopt if no copy was encoded.
+  ///
+  std::optional<VkDeviceMemory> EncodeRelocation(
+      const vk::CommandBuffer& cmd_buffer,
+      const std::function<bool(VkDeviceMemory)>& accept) {
+    if (pending_resource_.has_value()) {
+      return std::nullopt;
+    }
+    // Images that were never written to have no contents to preserve. They
+    // are left alone, as they are likely about to be uploaded to.
+    const auto layout = GetLayout();
+    if (layout == vk::ImageLayout::eUndefined) {
+      return std::nullopt;
+    }
+
+    auto create_info_native =
+        static_cast<vk::ImageCreateInfo::NativeType>(image_info_);
+    VkImage vk_image = VK_NULL_HANDLE;
+    VmaAllocation allocation = {};
+    VmaAllocationInfo allocation_info = {};
+    auto result = vk::Result{::vmaCreateImage(allocator_,           //
+                                              &create_info_native,  //
+                                              &alloc_info_,         //
+                                              &vk_image,            //
+                                              &allocation,          //
+                                              &allocation_info      //
+                                              )};
+    if (result != vk::Result::eSuccess) {
+      return std::nullopt;
+    }
+    UniqueImageVMA new_image(
+        ImageVMA{allocator_, allocation, vk::Image{vk_image}});
+    if (!accept(allocation_info.deviceMemory)) {
+      return std::nullopt;
+    }
+
+    auto view_info = view_info_;
+    view_info.image = new_image.get().image;
+    auto [view_result, image_view] = device_.createImageViewUnique(view_info);
+    if (view_result != vk::Result::eSuccess) {
+      return std::nullopt;
+    }
+
+    const auto old_image = GetImage();
+    const auto aspect = view_info_.subresourceRange.aspectMask;
+    EncodeImageBarrier(cmd_buffer, old_image, aspect, layout,
+                       vk::ImageLayout::eTransferSrcOptimal,
+                       vk::PipelineStageFlagBits::eAllCommands,
+                       vk::AccessFlagBits::eMemoryWrite,
+                       vk::PipelineStageFlagBits::eTransfer,
+                       vk::AccessFlagBits::eTransferRead);
+    EncodeImageBarrier(cmd_buffer, new_image.get().image, aspect,
+                       vk::ImageLayout::eUndefined,
+                       vk::ImageLayout::eTransferDstOptimal,
+                       vk::PipelineStageFlagBits::eTopOfPipe, {},
+                       vk::PipelineStageFlagBits::eTransfer,
+                       vk::AccessFlagBits::eTransferWrite);
+
+    std::vector<vk::ImageCopy> regions;
+    for (uint32_t mip = 0u; mip < image_info_.mipLevels; mip++) {
+      vk::ImageCopy region;
+      region.srcSubresource.aspectMask = aspect;
+      region.srcSubresource.mipLevel = mip;
+      region.srcSubresource.layerCount = image_info_.arrayLayers;
+      region.dstSubresource = region.srcSubresource;
+      region.extent = vk::Extent3D{
+          std::max(image_info_.extent.width >> mip, 1u),
+          std::max(image_info_.extent.height >> mip, 1u), 1u};
+      regions.push_back(region);
+    }
+    cmd_buffer.copyImage(old_image, vk::ImageLayout::eTransferSrcOptimal,
+                         new_image.get().image,
+                         vk::ImageLayout::eTransferDstOptimal, regions);
+
+    // Both images end up in the layout the texture is tracked in, so either
+    // can be used afterwards.
+    EncodeImageBarrier(cmd_buffer, new_image.get().image, aspect,
+                       vk::ImageLayout::eTransferDstOptimal, layout,
+                       vk::PipelineStageFlagBits::eTransfer,
+                       vk::AccessFlagBits::eTransferWrite,
+                       vk::PipelineStageFlagBits::eAllCommands,
+                       vk::AccessFlagBits::eMemoryRead |
+                           vk::AccessFlagBits::eMemoryWrite);
+    EncodeImageBarrier(cmd_buffer, old_image, aspect,
+                       vk::ImageLayout::eTransferSrcOptimal, layout,
+                       vk::PipelineStageFlagBits::eTransfer, {},
+                       vk::PipelineStageFlagBits::eAllCommands,
+                       vk::AccessFlagBits::eMemoryRead |
+                           vk::AccessFlagBits::eMemoryWrite);
+
+    pending_resource_.emplace(new_image.release(), std::move(image_view));
+    return allocation_info.deviceMemory;
+  }
+
+  /// Switches the texture to the image the relocation copied to. The previous
+  /// image is reclaimed by the resource manager.
+  void CommitRelocation() {
+    if (!pending_resource_.has_value()) {
+      return;
+    }
+    resource_.Swap(std::move(pending_resource_.value()));
+    pending_resource_.reset();
+  }
+
+  /// Frees the image the relocation copied to.
+  void AbortRelocation() { pending_resource_.reset(); }
+
   vk::Image GetImage() const override { return resource_->image.get().image; }
 
   vk::ImageView GetImageView() const override {
@@ -388,7 +644,15 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
     ImageResource& operator=(const ImageResource&) = delete;
   };
 
+  VmaAllocator allocator_ = {};
+  vk::Device device_ = {};
+  // What the image was created with, to create another one like it when the
+  // texture is relocated.
+  vk::ImageCreateInfo image_info_;
+  VmaAllocationCreateInfo alloc_info_ = {};
+  vk::ImageViewCreateInfo view_info_;
   UniqueResourceVKT<ImageResource> resource_;
+  std::optional<ImageResource> pending_resource_;
   bool is_valid_ = false;
 
   AllocatedTextureSourceVK(const AllocatedTextureSourceVK&) = delete;
@@ -414,6 +678,7 @@ std::shared_ptr<Texture> AllocatorVK::OnCreateTexture(
       ContextVK::Cast(*context).GetResourceManager(),  //
       desc,                                            //
       allocator_.get(),                                //
+      render_target_pool_.get().pool,                  //
       device_holder->GetDevice(),                      //
       supports_memoryless_textures_,                   //
       supports_framebuffer_fetch_                      //
@@ -421,12 +686,213 @@ std::shared_ptr<Texture> AllocatorVK::OnCreateTexture(
   if (!source->IsValid()) {
     return nullptr;
   }
+  if (IsRelocatable(desc)) {
+    AddRelocatableTexture(source);
+  }
   return std::make_shared<TextureVK>(context_, std::move(source));
 }
 
+template <class T>
+static void PruneRelocatableTextures(std::vector<T>& textures) {
+  textures.erase(std::remove_if(textures.begin(), textures.end(),
+                                [](const T& texture) {
+                                  return texture.source.expired();
+                                }),
+                 textures.end());
+}
+
+void AllocatorVK::AddRelocatableTexture(
+    const std::shared_ptr<AllocatedTextureSourceVK>& source) {
+  Lock lock(relocatable_textures_mutex_);
+  // Drop the textures that were destroyed whenever the list doubled in size.
+  if (relocatable_textures_.size() >= relocatable_textures_prune_size_) {
+    PruneRelocatableTextures(relocatable_textures_);
+    relocatable_textures_prune_size_ =
+        std::max<size_t>(relocatable_textures_.size() * 2u, 64u);
+  }
+  relocatable_textures_.push_back(
+      {.source = source, .generation = compaction_generation_});
+}
+
+std::vector<std::shared_ptr<AllocatedTextureSourceVK>>
+AllocatorVK::GetLongLivedTextures() {
+  std::vector<std::shared_ptr<AllocatedTextureSourceVK>> sources;
+  Lock lock(relocatable_textures_mutex_);
+  compaction_generation_++;
+  PruneRelocatableTextures(relocatable_textures_);
+  for (const auto& texture : relocatable_textures_) {
+    if (texture.generation + 1u >= compaction_generation_) {
+      continue;
+    }
+    if (auto source = texture.source.lock()) {
+      sources.push_back(std::move(source));
+    }
+  }
+  return sources;
+}
+
+size_t AllocatorVK::GetUnusedDeviceLocalBlockBytes() {
+  const VkPhysicalDeviceMemoryProperties* properties = nullptr;
+  ::vmaGetMemoryProperties(allocator_.get(), &properties);
+  std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budgets = {};
+  ::vmaGetHeapBudgets(allocator_.get(), budgets.data());
+
+  size_t unused_bytes = 0u;
+  for (uint32_t i = 0; i < properties->memoryHeapCount; i++) {
+    if (properties->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+      unused_bytes += budgets[i].statistics.blockBytes -
+                      budgets[i].statistics.allocationBytes;
+    }
+  }
+  return unused_bytes;
+}
+
+/// Compaction is skipped until the blocks of device memory hold at least this
+/// many unused bytes.
+static constexpr size_t kMinCompactableBytes = 16u * 1024u * 1024u;
+
+/// The most bytes of textures copied per compaction pass, which bounds the GPU
+/// time the pass waits for.
+static constexpr size_t kMaxRelocatedBytesPerPass = 8u * 1024u * 1024u;
+
+// |Allocator|
+void AllocatorVK::CompactMemory(fml::TimePoint deadline) {
+  TRACE_EVENT0("impeller", "AllocatorVK::CompactMemory");
+  if (!IsValid()) {
+    return;
+  }
+  auto context = context_.lock();
+  if (!context) {
+    return;
+  }
+  if (GetUnusedDeviceLocalBlockBytes() < kMinCompactableBytes) {
+    return;
+  }
+
+  // The textures created since the previous pass may still be uploaded to
+  // from the IO thread, so only the older ones are moved.
+  struct Candidate {
+    std::shared_ptr<AllocatedTextureSourceVK> source;
+    VkDeviceMemory memory;
+    size_t size;
+  };
+  std::vector<Candidate> candidates;
+  // The bytes of the candidates in each block of device memory.
+  std::unordered_map<VkDeviceMemory, size_t> block_usage;
+  for (auto& source : GetLongLivedTextures()) {
+    auto info = source->GetAllocationInfo();
+    block_usage[info.deviceMemory] += info.size;
+    candidates.push_back({.source = std::move(source),
+                          .memory = info.deviceMemory,
+                          .size = static_cast<size_t>(info.size)});
+  }
+  if (candidates.empty()) {
+    return;
+  }
+  // Empty the least used blocks first, as they are the closest to being
+  // released.
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [&block_usage](const Candidate& a, const Candidate& b) {
+                     return block_usage[a.memory] < block_usage[b.memory];
+                   });
+
+  auto cmd_buffer = context->CreateCommandBuffer();
+  if (!cmd_buffer) {
+    return;
+  }
+  cmd_buffer->SetLabel("Memory Compaction");
+  const auto& encoder = CommandBufferVK::Cast(*cmd_buffer).GetEncoder();
+  if (!encoder) {
+    return;
+  }
+  const auto& vk_cmd_buffer = encoder->GetCommandBuffer();
+
+  std::vector<std::shared_ptr<AllocatedTextureSourceVK>> relocated;
+  size_t relocated_bytes = 0u;
+  for (const auto& candidate : candidates) {
+    if (fml::TimePoint::Now() >= deadline ||
+        relocated_bytes + candidate.size > kMaxRelocatedBytesPerPass) {
+      break;
+    }
+    const auto source_usage = block_usage[candidate.memory];
+    // Moving to a new block, or to one that is used less, wouldn't bring any
+    // block closer to being released.
+    auto accept = [&](VkDeviceMemory memory) {
+      auto found = block_usage.find(memory);
+      return memory != candidate.memory && found != block_usage.end() &&
+             found->second > source_usage;
+    };
+    auto memory = candidate.source->EncodeRelocation(vk_cmd_buffer, accept);
+    if (!memory.has_value()) {
+      continue;
+    }
+    block_usage[candidate.memory] -= candidate.size;
+    block_usage[memory.value()] += candidate.size;
+    relocated_bytes += candidate.size;
+    relocated.push_back(candidate.source);
+  }
+  if (relocated.empty()) {
+    return;
+  }
+
+  // The images are swapped once the copies completed, so that neither the
+  // previous frames nor the copies read from a reclaimed image.
+  fml::CountDownLatch latch(1u);
+  bool completed = false;
+  if (!cmd_buffer->SubmitCommands(
+          [&latch, &completed](CommandBuffer::Status status) {
+            completed = status == CommandBuffer::Status::kCompleted;
+            latch.CountDown();
+          })) {
+    for (const auto& source : relocated) {
+      source->AbortRelocation();
+    }
+    return;
+  }
+  latch.Wait();
+
+  for (const auto& source : relocated) {
+    if (completed) {
+      source->CommitRelocation();
+    } else {
+      source->AbortRelocation();
+    }
+  }
+  if (completed) {
+    // Cached descriptor sets may refer to the image views just reclaimed.
+    ContextVK::Cast(*context).GetDescriptorSetCache()->Clear();
+  }
+  FML_TRACE_COUNTER("impeller", "AllocatorVK::CompactMemory",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "RelocatedBytes", relocated_bytes);
+}
+
 void AllocatorVK::DidAcquireSurfaceFrame() {
   frame_count_++;
   raster_thread_id_ = std::this_thread::get_id();
+  GetAccountant().SetBudget(GetDeviceLocalBudget());
+  Allocator::DidAcquireSurfaceFrame();
+}
+
+std::optional<size_t> AllocatorVK::GetDeviceLocalBudget() {
+  if (!supports_memory_budget_ || !allocator_.is_valid()) {
+    return std::nullopt;
+  }
+  // Advancing the frame index makes VMA query the budgets again.
+  ::vmaSetCurrentFrameIndex(allocator_.get(), frame_count_);
+
+  const VkPhysicalDeviceMemoryProperties* properties = nullptr;
+  ::vmaGetMemoryProperties(allocator_.get(), &properties);
+  std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budgets = {};
+  ::vmaGetHeapBudgets(allocator_.get(), budgets.data());
+
+  size_t budget = 0u;
+  for (uint32_t i = 0; i < properties->memoryHeapCount; i++) {
+    if (properties->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+      budget += budgets[i].budget;
+    }
+  }
+  return budget;
 }
 
 // |Allocator|
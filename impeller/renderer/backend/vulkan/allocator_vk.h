@@ -7,6 +7,7 @@
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_ptr.h"
+#include "impeller/base/thread.h"
 #include "impeller/core/allocator.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
@@ -16,9 +17,13 @@
 #include <array>
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <vector>
 
 namespace impeller {
 
+class AllocatedTextureSourceVK;
+
 class AllocatorVK final : public Allocator {
  public:
   // |Allocator|
@@ -29,17 +34,33 @@ class AllocatorVK final : public Allocator {
 
   UniqueAllocatorVMA allocator_;
   UniquePoolVMA staging_buffer_pool_;
+  UniquePoolVMA render_target_pool_;
   std::weak_ptr<Context> context_;
   std::weak_ptr<DeviceHolder> device_holder_;
   ISize max_texture_size_;
   bool is_valid_ = false;
   bool supports_memoryless_textures_ = false;
   bool supports_framebuffer_fetch_ = false;
+  bool supports_memory_budget_ = false;
   // TODO(jonahwilliams): figure out why CI can't create these buffer pools.
   bool created_buffer_pool_ = true;
   uint32_t frame_count_ = 0;
   std::thread::id raster_thread_id_;
 
+  struct RelocatableTexture {
+    std::weak_ptr<AllocatedTextureSourceVK> source;
+    // The compaction pass during which the texture was created.
+    uint64_t generation = 0u;
+  };
+
+  Mutex relocatable_textures_mutex_;
+  std::vector<RelocatableTexture> relocatable_textures_ IPLR_GUARDED_BY(
+      relocatable_textures_mutex_);
+  size_t relocatable_textures_prune_size_ IPLR_GUARDED_BY(
+      relocatable_textures_mutex_) = 0u;
+  uint64_t compaction_generation_ IPLR_GUARDED_BY(
+      relocatable_textures_mutex_) = 0u;
+
   AllocatorVK(std::weak_ptr<Context> context,
               uint32_t vulkan_api_version,
               const vk::PhysicalDevice& physical_device,
@@ -53,6 +74,25 @@ class AllocatorVK final : public Allocator {
   // |Allocator|
   void DidAcquireSurfaceFrame() override;
 
+  // |Allocator|
+  void CompactMemory(fml::TimePoint deadline) override;
+
+  /// The bytes of the device local blocks of memory that aren't used by any
+  /// allocation.
+  size_t GetUnusedDeviceLocalBlockBytes();
+
+  void AddRelocatableTexture(
+      const std::shared_ptr<AllocatedTextureSourceVK>& source);
+
+  /// The live textures created before the previous compaction pass, which
+  /// are no longer being uploaded to from other threads.
+  std::vector<std::shared_ptr<AllocatedTextureSourceVK>>
+  GetLongLivedTextures();
+
+  /// The budget of the device local heaps reported by VK_EXT_memory_budget,
+  /// or std::nullopt if the extension isn't enabled.
+  std::optional<size_t> GetDeviceLocalBudget();
+
   // |Allocator|
   std::shared_ptr<DeviceBuffer> OnCreateBuffer(
       const DeviceBufferDescriptor& desc) override;
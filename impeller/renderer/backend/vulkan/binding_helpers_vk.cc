@@ -3,6 +3,11 @@
 // found in the LICENSE file.
 
 #include "impeller/renderer/backend/vulkan/binding_helpers_vk.h"
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
 #include "fml/status.h"
 #include "impeller/core/allocator.h"
 #include "impeller/core/device_buffer.h"
@@ -12,6 +17,7 @@
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/compute_pipeline_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/descriptor_set_cache_vk.h"
 #include "impeller/renderer/backend/vulkan/sampler_vk.h"
 #include "impeller/renderer/backend/vulkan/texture_vk.h"
 #include "impeller/renderer/command.h"
@@ -29,7 +35,7 @@ static bool BindImages(
     const Bindings& bindings,
     Allocator& allocator,
     const std::shared_ptr<CommandEncoderVK>& encoder,
-    vk::DescriptorSet& vk_desc_set,
+    DescriptorSetKeyVK& key,
     std::array<vk::DescriptorImageInfo, kMaxBindings>& image_workspace,
     size_t& image_offset,
     std::array<vk::WriteDescriptorSet, kMaxBindings + kMaxBindings>&
@@ -54,29 +60,64 @@ static bool BindImages(
     image_workspace[image_offset++] = image_info;
 
     vk::WriteDescriptorSet write_set;
-    write_set.dstSet = vk_desc_set;
     write_set.dstBinding = slot.binding;
     write_set.descriptorCount = 1u;
     write_set.descriptorType = vk::DescriptorType::eCombinedImageSampler;
     write_set.pImageInfo = &image_workspace[image_offset - 1];
 
     write_workspace[write_offset++] = write_set;
+
+    key.AddBinding({
+        .binding = static_cast<uint32_t>(slot.binding),
+        .type = write_set.descriptorType,
+        .resource = DescriptorSetKeyVK::GetHandleValue(image_info.imageView),
+        .sampler = DescriptorSetKeyVK::GetHandleValue(image_info.sampler),
+    });
+    key.AddDependency(texture_vk.GetTextureSource());
+    key.AddDependency(sampler.GetSharedSampler());
   }
 
   return true;
 };
 
+namespace {
+
+/// The dynamic offsets of a descriptor set, keyed by binding until they are
+/// sorted into the order that |vkCmdBindDescriptorSets| expects.
+struct DynamicOffsets {
+  std::array<std::pair<uint32_t, uint32_t>, kMaxBindings> entries;
+  size_t count = 0u;
+};
+
+}  // namespace
+
+/// Wraps the descriptor set with its dynamic offsets in binding order.
+static DescriptorSetBindingVK MakeDescriptorSetBinding(
+    vk::DescriptorSet descriptor_set,
+    DynamicOffsets& dynamic_offsets) {
+  std::sort(dynamic_offsets.entries.begin(),
+            dynamic_offsets.entries.begin() + dynamic_offsets.count);
+  DescriptorSetBindingVK binding;
+  binding.descriptor_set = descriptor_set;
+  for (size_t i = 0u; i < dynamic_offsets.count; i++) {
+    binding.dynamic_offsets[i] = dynamic_offsets.entries[i].second;
+  }
+  binding.dynamic_offset_count = static_cast<uint32_t>(dynamic_offsets.count);
+  return binding;
+}
+
 static bool BindBuffers(
     const Bindings& bindings,
     Allocator& allocator,
     const std::shared_ptr<CommandEncoderVK>& encoder,
-    vk::DescriptorSet& vk_desc_set,
+    DescriptorSetKeyVK& key,
     const std::vector<DescriptorSetLayout>& desc_set,
     std::array<vk::DescriptorBufferInfo, kMaxBindings>& buffer_workspace,
     size_t& buffer_offset,
     std::array<vk::WriteDescriptorSet, kMaxBindings + kMaxBindings>&
         write_workspace,
-    size_t& write_offset) {
+    size_t& write_offset,
+    DynamicOffsets& dynamic_offsets) {
   for (const BufferAndUniformSlot& data : bindings.buffers) {
     const std::shared_ptr<const DeviceBuffer>& device_buffer =
         data.view.resource.buffer;
@@ -92,12 +133,6 @@ static bool BindBuffers(
 
     uint32_t offset = data.view.resource.range.offset;
 
-    vk::DescriptorBufferInfo buffer_info;
-    buffer_info.buffer = buffer;
-    buffer_info.offset = offset;
-    buffer_info.range = data.view.resource.range.length;
-    buffer_workspace[buffer_offset++] = buffer_info;
-
     // TODO(jonahwilliams): remove this part by storing more data in
     // ShaderUniformSlot.
     const ShaderUniformSlot& uniform = data.slot;
@@ -112,20 +147,90 @@ static bool BindBuffers(
       return false;
     }
     auto layout = *layout_it;
+    const vk::DescriptorType descriptor_type =
+        ToVKDescriptorType(layout.descriptor_type);
+
+    // The offset of a dynamic uniform buffer is supplied when the set is
+    // bound, so that it doesn't take part in the descriptor set contents.
+    if (descriptor_type == vk::DescriptorType::eUniformBufferDynamic) {
+      dynamic_offsets.entries[dynamic_offsets.count++] = {
+          static_cast<uint32_t>(uniform.binding), offset};
+      offset = 0u;
+    }
+
+    vk::DescriptorBufferInfo buffer_info;
+    buffer_info.buffer = buffer;
+    buffer_info.offset = offset;
+    buffer_info.range = data.view.resource.range.length;
+    buffer_workspace[buffer_offset++] = buffer_info;
 
     vk::WriteDescriptorSet write_set;
-    write_set.dstSet = vk_desc_set;
     write_set.dstBinding = uniform.binding;
     write_set.descriptorCount = 1u;
-    write_set.descriptorType = ToVKDescriptorType(layout.descriptor_type);
+    write_set.descriptorType = descriptor_type;
     write_set.pBufferInfo = &buffer_workspace[buffer_offset - 1];
 
     write_workspace[write_offset++] = write_set;
+
+    key.AddBinding({
+        .binding = static_cast<uint32_t>(uniform.binding),
+        .type = write_set.descriptorType,
+        .resource = DescriptorSetKeyVK::GetHandleValue(buffer),
+        .offset = buffer_info.offset,
+        .range = buffer_info.range,
+    });
+    key.AddDependency(device_buffer);
   }
   return true;
 }
 
-fml::StatusOr<vk::DescriptorSet> AllocateAndBindDescriptorSets(
+// Reuses a cached descriptor set with the same contents if there is one.
+// Otherwise the writes in the workspace are applied to a new set, which is
+// cached if a key is given.
+static fml::StatusOr<vk::DescriptorSet> UpdateDescriptorSet(
+    const ContextVK& context,
+    const std::shared_ptr<CommandEncoderVK>& encoder,
+    const vk::DescriptorSetLayout& layout,
+    std::optional<DescriptorSetKeyVK> key,
+    std::array<vk::WriteDescriptorSet, kMaxBindings + kMaxBindings>&
+        write_workspace,
+    size_t write_offset) {
+  vk::DescriptorSet descriptor_set;
+  const auto& cache = context.GetDescriptorSetCache();
+  if (key.has_value() && cache) {
+    if (auto cached = cache->Get(key.value())) {
+      if (!encoder->Track(cached)) {
+        return fml::Status(fml::StatusCode::kUnknown,
+                           "Failed to track descriptor set.");
+      }
+      return cached->Get();
+    }
+    if (auto cached = cache->Create(std::move(key.value()))) {
+      if (!encoder->Track(cached)) {
+        return fml::Status(fml::StatusCode::kUnknown,
+                           "Failed to track descriptor set.");
+      }
+      descriptor_set = cached->Get();
+    }
+  }
+
+  if (!descriptor_set) {
+    auto descriptor_result = encoder->AllocateDescriptorSets(layout, context);
+    if (!descriptor_result.ok()) {
+      return descriptor_result.status();
+    }
+    descriptor_set = descriptor_result.value();
+  }
+
+  for (auto i = 0u; i < write_offset; i++) {
+    write_workspace[i].dstSet = descriptor_set;
+  }
+  context.GetDevice().updateDescriptorSets(write_offset, write_workspace.data(),
+                                           0u, {});
+  return descriptor_set;
+}
+
+fml::StatusOr<DescriptorSetBindingVK> AllocateAndBindDescriptorSets(
     const ContextVK& context,
     const std::shared_ptr<CommandEncoderVK>& encoder,
     Allocator& allocator,
@@ -135,12 +240,9 @@ fml::StatusOr<vk::DescriptorSet> AllocateAndBindDescriptorSets(
     std::array<vk::DescriptorBufferInfo, kMaxBindings>& buffer_workspace,
     std::array<vk::WriteDescriptorSet, kMaxBindings + kMaxBindings>&
         write_workspace) {
-  auto descriptor_result = encoder->AllocateDescriptorSets(
-      PipelineVK::Cast(*command.pipeline).GetDescriptorSetLayout(), context);
-  if (!descriptor_result.ok()) {
-    return descriptor_result.status();
-  }
-  vk::DescriptorSet descriptor_set = descriptor_result.value();
+  const auto& layout =
+      PipelineVK::Cast(*command.pipeline).GetDescriptorSetLayout();
+  DescriptorSetKeyVK key(layout);
 
   size_t buffer_offset = 0u;
   size_t image_offset = 0u;
@@ -150,13 +252,14 @@ fml::StatusOr<vk::DescriptorSet> AllocateAndBindDescriptorSets(
   auto& desc_set =
       pipeline_descriptor.GetVertexDescriptor()->GetDescriptorSetLayouts();
 
-  if (!BindBuffers(command.vertex_bindings, allocator, encoder, descriptor_set,
+  DynamicOffsets dynamic_offsets;
+  if (!BindBuffers(command.vertex_bindings, allocator, encoder, key, desc_set,
+                   buffer_workspace, buffer_offset, write_workspace,
+                   write_offset, dynamic_offsets) ||
+      !BindBuffers(command.fragment_bindings, allocator, encoder, key,
                    desc_set, buffer_workspace, buffer_offset, write_workspace,
-                   write_offset) ||
-      !BindBuffers(command.fragment_bindings, allocator, encoder,
-                   descriptor_set, desc_set, buffer_workspace, buffer_offset,
-                   write_workspace, write_offset) ||
-      !BindImages(command.fragment_bindings, allocator, encoder, descriptor_set,
+                   write_offset, dynamic_offsets) ||
+      !BindImages(command.fragment_bindings, allocator, encoder, key,
                   image_workspace, image_offset, write_workspace,
                   write_offset)) {
     return fml::Status(fml::StatusCode::kUnknown,
@@ -171,22 +274,32 @@ fml::StatusOr<vk::DescriptorSet> AllocateAndBindDescriptorSets(
     image_workspace[image_offset++] = image_info;
 
     vk::WriteDescriptorSet write_set;
-    write_set.dstSet = descriptor_set;
     write_set.dstBinding = kMagicSubpassInputBinding;
     write_set.descriptorCount = 1u;
     write_set.descriptorType = vk::DescriptorType::eInputAttachment;
     write_set.pImageInfo = &image_workspace[image_offset - 1];
 
     write_workspace[write_offset++] = write_set;
-  }
 
-  context.GetDevice().updateDescriptorSets(write_offset, write_workspace.data(),
-                                           0u, {});
+    // The input attachment changes with every render target, so sets that
+    // read from it are not worth caching.
+    auto descriptor_set = UpdateDescriptorSet(
+        context, encoder, layout, std::nullopt, write_workspace, write_offset);
+    if (!descriptor_set.ok()) {
+      return descriptor_set.status();
+    }
+    return MakeDescriptorSetBinding(descriptor_set.value(), dynamic_offsets);
+  }
 
-  return descriptor_set;
+  auto descriptor_set = UpdateDescriptorSet(
+      context, encoder, layout, std::move(key), write_workspace, write_offset);
+  if (!descriptor_set.ok()) {
+    return descriptor_set.status();
+  }
+  return MakeDescriptorSetBinding(descriptor_set.value(), dynamic_offsets);
 }
 
-fml::StatusOr<vk::DescriptorSet> AllocateAndBindDescriptorSets(
+fml::StatusOr<DescriptorSetBindingVK> AllocateAndBindDescriptorSets(
     const ContextVK& context,
     const std::shared_ptr<CommandEncoderVK>& encoder,
     Allocator& allocator,
@@ -195,13 +308,9 @@ fml::StatusOr<vk::DescriptorSet> AllocateAndBindDescriptorSets(
     std::array<vk::DescriptorBufferInfo, kMaxBindings>& buffer_workspace,
     std::array<vk::WriteDescriptorSet, kMaxBindings + kMaxBindings>&
         write_workspace) {
-  auto descriptor_result = encoder->AllocateDescriptorSets(
-      ComputePipelineVK::Cast(*command.pipeline).GetDescriptorSetLayout(),
-      context);
-  if (!descriptor_result.ok()) {
-    return descriptor_result.status();
-  }
-  auto descriptor_set = descriptor_result.value();
+  const auto& layout =
+      ComputePipelineVK::Cast(*command.pipeline).GetDescriptorSetLayout();
+  DescriptorSetKeyVK key(layout);
 
   size_t buffer_offset = 0u;
   size_t image_offset = 0u;
@@ -210,19 +319,22 @@ fml::StatusOr<vk::DescriptorSet> AllocateAndBindDescriptorSets(
   auto& pipeline_descriptor = command.pipeline->GetDescriptor();
   auto& desc_set = pipeline_descriptor.GetDescriptorSetLayouts();
 
-  if (!BindBuffers(command.bindings, allocator, encoder, descriptor_set,
-                   desc_set, buffer_workspace, buffer_offset, write_workspace,
-                   write_offset) ||
-      !BindImages(command.bindings, allocator, encoder, descriptor_set,
-                  image_workspace, image_offset, write_workspace,
-                  write_offset)) {
+  DynamicOffsets dynamic_offsets;
+  if (!BindBuffers(command.bindings, allocator, encoder, key, desc_set,
+                   buffer_workspace, buffer_offset, write_workspace,
+                   write_offset, dynamic_offsets) ||
+      !BindImages(command.bindings, allocator, encoder, key, image_workspace,
+                  image_offset, write_workspace, write_offset)) {
     return fml::Status(fml::StatusCode::kUnknown,
                        "Failed to bind texture or buffer.");
   }
-  context.GetDevice().updateDescriptorSets(write_offset, write_workspace.data(),
-                                           0u, {});
 
-  return descriptor_set;
+  auto descriptor_set = UpdateDescriptorSet(
+      context, encoder, layout, std::move(key), write_workspace, write_offset);
+  if (!descriptor_set.ok()) {
+    return descriptor_set.status();
+  }
+  return MakeDescriptorSetBinding(descriptor_set.value(), dynamic_offsets);
 }
 
 }  // namespace impeller
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_BINDING_HELPERS_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_BINDING_HELPERS_VK_H_
 
+#include <array>
+
 #include "fml/status_or.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/texture_vk.h"
@@ -17,7 +19,17 @@ namespace impeller {
 // backend to avoid dynamic heap allocations.
 static constexpr size_t kMaxBindings = 32;
 
-fml::StatusOr<vk::DescriptorSet> AllocateAndBindDescriptorSets(
+/// A descriptor set along with the dynamic offsets of its uniform buffers,
+/// ordered by binding. Uniform buffers are bound as dynamic uniform buffers so
+/// that commands whose uniforms only differ in their offset into the same
+/// buffer can share a descriptor set.
+struct DescriptorSetBindingVK {
+  vk::DescriptorSet descriptor_set;
+  std::array<uint32_t, kMaxBindings> dynamic_offsets;
+  uint32_t dynamic_offset_count = 0u;
+};
+
+fml::StatusOr<DescriptorSetBindingVK> AllocateAndBindDescriptorSets(
     const ContextVK& context,
     const std::shared_ptr<CommandEncoderVK>& encoder,
     Allocator& allocator,
@@ -28,7 +40,7 @@ fml::StatusOr<vk::DescriptorSet> AllocateAndBindDescriptorSets(
     std::array<vk::WriteDescriptorSet, kMaxBindings + kMaxBindings>&
         write_workspace);
 
-fml::StatusOr<vk::DescriptorSet> AllocateAndBindDescriptorSets(
+fml::StatusOr<DescriptorSetBindingVK> AllocateAndBindDescriptorSets(
     const ContextVK& context,
     const std::shared_ptr<CommandEncoderVK>& encoder,
     Allocator& allocator,
@@ -185,10 +185,10 @@ bool BlitCopyBufferToTextureCommandVK::Encode(CommandEncoderVK& encoder) const {
   image_copy.setBufferImageHeight(0);
   image_copy.setImageSubresource(
       vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1));
-  image_copy.setImageOffset(
-      vk::Offset3D(destination_origin.x, destination_origin.y, 0));
-  image_copy.setImageExtent(vk::Extent3D(destination->GetSize().width,
-                                         destination->GetSize().height, 1));
+  image_copy.setImageOffset(vk::Offset3D(destination_region.GetX(),
+                                         destination_region.GetY(), 0));
+  image_copy.setImageExtent(vk::Extent3D(destination_region.GetWidth(),
+                                         destination_region.GetHeight(), 1));
 
   if (!dst.SetLayout(dst_barrier)) {
     VALIDATION_LOG << "Could not encode layout transition.";
@@ -245,37 +245,12 @@ static void InsertImageMemoryBarrier(const vk::CommandBuffer& cmd,
   cmd.pipelineBarrier(src_stage, dst_stage, {}, nullptr, nullptr, barrier);
 }
 
-bool BlitGenerateMipmapCommandVK::Encode(CommandEncoderVK& encoder) const {
-  auto& src = TextureVK::Cast(*texture);
-
-  const auto size = src.GetTextureDescriptor().size;
-  uint32_t mip_count = src.GetTextureDescriptor().mip_count;
-
-  if (mip_count < 2u) {
-    return true;
-  }
-
-  const auto& image = src.GetImage();
-  const auto& cmd = encoder.GetCommandBuffer();
-
-  if (!encoder.Track(texture)) {
-    return false;
-  }
-
-  // Transition the base mip level to transfer-src layout so we can read from
-  // it and transition the rest to dst-optimal since they are going to be
-  // written to.
-  InsertImageMemoryBarrier(
-      cmd,                                   // command buffer
-      image,                                 // image
-      vk::AccessFlagBits::eTransferWrite,    // src access mask
-      vk::AccessFlagBits::eTransferRead,     // dst access mask
-      src.GetLayout(),                       // old layout
-      vk::ImageLayout::eTransferSrcOptimal,  // new layout
-      vk::PipelineStageFlagBits::eTransfer,  // src stage
-      vk::PipelineStageFlagBits::eTransfer,  // dst stage
-      0u                                     // mip level
-  );
+void EncodeMipmapBlitsVK(const vk::CommandBuffer& cmd,
+                         const vk::Image& image,
+                         ISize size,
+                         uint32_t mip_count) {
+  // Transition the levels other than the base one to dst-optimal since they
+  // are going to be written to.
   InsertImageMemoryBarrier(
       cmd,                                   // command buffer
       image,                                 // image
@@ -348,6 +323,39 @@ bool BlitGenerateMipmapCommandVK::Encode(CommandEncoderVK& encoder) const {
       1u,                                          // mip level
       mip_count - 1                                // mip level count
   );
+}
+
+bool BlitGenerateMipmapCommandVK::Encode(CommandEncoderVK& encoder) const {
+  auto& src = TextureVK::Cast(*texture);
+
+  const auto size = src.GetTextureDescriptor().size;
+  uint32_t mip_count = src.GetTextureDescriptor().mip_count;
+
+  if (mip_count < 2u) {
+    return true;
+  }
+
+  const auto& image = src.GetImage();
+  const auto& cmd = encoder.GetCommandBuffer();
+
+  if (!encoder.Track(texture)) {
+    return false;
+  }
+
+  // Transition the base mip level to transfer-src layout so we can read from
+  // it.
+  InsertImageMemoryBarrier(
+      cmd,                                   // command buffer
+      image,                                 // image
+      vk::AccessFlagBits::eTransferWrite,    // src access mask
+      vk::AccessFlagBits::eTransferRead,     // dst access mask
+      src.GetLayout(),                       // old layout
+      vk::ImageLayout::eTransferSrcOptimal,  // new layout
+      vk::PipelineStageFlagBits::eTransfer,  // src stage
+      vk::PipelineStageFlagBits::eTransfer,  // dst stage
+      0u                                     // mip level
+  );
+  EncodeMipmapBlitsVK(cmd, image, size, mip_count);
 
   // We modified the layouts of this image from underneath it. Tell it its new
   // state so it doesn't try to perform redundant transitions under the hood.
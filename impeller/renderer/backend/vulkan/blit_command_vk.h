@@ -62,6 +62,14 @@ struct BlitGenerateMipmapCommandVK : public BlitGenerateMipmapCommand,
   [[nodiscard]] bool Encode(CommandEncoderVK& encoder) const override;
 };
 
+/// Records the blits that generate the mip levels of `image` from its base
+/// level, which must already be in the transfer source layout. Leaves all the
+/// mip levels in the shader read layout.
+void EncodeMipmapBlitsVK(const vk::CommandBuffer& cmd,
+                         const vk::Image& image,
+                         ISize size,
+                         uint32_t mip_count);
+
 }  // namespace impeller
 
 #endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_BLIT_COMMAND_VK_H_
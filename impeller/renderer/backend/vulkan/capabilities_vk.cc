@@ -5,9 +5,11 @@
 #include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 
 #include <algorithm>
+#include <utility>
 
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
+#include "impeller/renderer/backend/vulkan/formats_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 #include "vulkan/vulkan_core.h"
 
@@ -161,6 +163,12 @@ static const char* GetDeviceExtensionName(OptionalDeviceExtensionVK ext) {
       return VK_ARM_RASTERIZATION_ORDER_ATTACHMENT_ACCESS_EXTENSION_NAME;
     case OptionalDeviceExtensionVK::kEXTRasterizationOrderAttachmentAccess:
       return VK_EXT_RASTERIZATION_ORDER_ATTACHMENT_ACCESS_EXTENSION_NAME;
+    case OptionalDeviceExtensionVK::kGOOGLEDisplayTiming:
+      return VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME;
+    case OptionalDeviceExtensionVK::kKHRExternalSemaphoreFd:
+      return VK_KHR_EXTERNAL_SEMAPHORE_FD_EXTENSION_NAME;
+    case OptionalDeviceExtensionVK::kEXTMemoryBudget:
+      return VK_EXT_MEMORY_BUDGET_EXTENSION_NAME;
     case OptionalDeviceExtensionVK::kLast:
       return "Unknown";
   }
@@ -246,6 +254,13 @@ static bool HasSuitableColorFormat(const vk::PhysicalDevice& device,
             vk::FormatFeatureFlagBits::eColorAttachment);
 }
 
+static bool HasSuitableSampledFormat(const vk::PhysicalDevice& device,
+                                     vk::Format format) {
+  const auto props = device.getFormatProperties(format);
+  return !!(props.optimalTilingFeatures &
+            vk::FormatFeatureFlagBits::eSampledImageFilterLinear);
+}
+
 static bool HasSuitableDepthStencilFormat(const vk::PhysicalDevice& device,
                                           vk::Format format) {
   const auto props = device.getFormatProperties(format);
@@ -318,6 +333,17 @@ CapabilitiesVK::GetEnabledDeviceFeatures(
   // necessarily a big deal if we don't have this feature.
   required.fillModeNonSolid = device_features.fillModeNonSolid;
 
+  // Compressed texture formats can only be used if their feature is enabled.
+  required.textureCompressionETC2 = device_features.textureCompressionETC2;
+  required.textureCompressionASTC_LDR =
+      device_features.textureCompressionASTC_LDR;
+  required.textureCompressionBC = device_features.textureCompressionBC;
+
+#ifdef IMPELLER_DEBUG
+  // The GPU tracer counts the shader invocations of frames when available.
+  required.pipelineStatisticsQuery = device_features.pipelineStatisticsQuery;
+#endif  // IMPELLER_DEBUG
+
   return required;
 }
 
@@ -363,6 +389,24 @@ bool CapabilitiesVK::SetPhysicalDevice(const vk::PhysicalDevice& device) {
 
   device_properties_ = device.getProperties();
 
+  {
+    const auto device_features = device.getFeatures();
+    const std::pair<PixelFormat, bool> compressed_formats[] = {
+        {PixelFormat::kETC2R8G8B8A8UNormInt,
+         !!device_features.textureCompressionETC2},
+        {PixelFormat::kASTC4x4UNormInt,
+         !!device_features.textureCompressionASTC_LDR},
+        {PixelFormat::kBC7UNormInt, !!device_features.textureCompressionBC},
+    };
+    compressed_texture_formats_.clear();
+    for (const auto& [format, feature_supported] : compressed_formats) {
+      if (feature_supported &&
+          HasSuitableSampledFormat(device, ToVKImageFormat(format))) {
+        compressed_texture_formats_.insert(format);
+      }
+    }
+  }
+
   auto physical_properties_2 =
       device.getProperties2<vk::PhysicalDeviceProperties2,
                             vk::PhysicalDeviceSubgroupProperties>();
@@ -407,7 +451,7 @@ bool CapabilitiesVK::SetPhysicalDevice(const vk::PhysicalDevice& device) {
   }
 
   {
-    supports_framebuffer_fetch_ =
+    supports_rasterization_order_attachment_access_ =
         (optional_device_extensions_.find(
              OptionalDeviceExtensionVK::
                  kARMRasterizationOrderAttachmentAccess) !=
@@ -416,6 +460,11 @@ bool CapabilitiesVK::SetPhysicalDevice(const vk::PhysicalDevice& device) {
              OptionalDeviceExtensionVK::
                  kEXTRasterizationOrderAttachmentAccess) !=
              optional_device_extensions_.end());
+    // Reading the color attachment as an input attachment of the same
+    // subpass is core Vulkan. Without rasterization order access, the render
+    // pass declares a self-dependency and a barrier is recorded before each
+    // draw that reads the framebuffer.
+    supports_framebuffer_fetch_ = true;
   }
 
   return true;
@@ -451,6 +500,10 @@ bool CapabilitiesVK::SupportsFramebufferFetch() const {
   return supports_framebuffer_fetch_;
 }
 
+bool CapabilitiesVK::SupportsRasterizationOrderAttachmentAccess() const {
+  return supports_rasterization_order_attachment_access_;
+}
+
 // |Capabilities|
 bool CapabilitiesVK::SupportsCompute() const {
   // Vulkan 1.1 requires support for compute.
@@ -477,6 +530,11 @@ bool CapabilitiesVK::SupportsDeviceTransientTextures() const {
   return supports_device_transient_textures_;
 }
 
+// |Capabilities|
+bool CapabilitiesVK::SupportsCompressedTextureFormat(PixelFormat format) const {
+  return compressed_texture_formats_.count(format) > 0;
+}
+
 // |Capabilities|
 PixelFormat CapabilitiesVK::GetDefaultColorFormat() const {
   return default_color_format_;
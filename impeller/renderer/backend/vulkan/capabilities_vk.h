@@ -24,6 +24,12 @@ enum class OptionalDeviceExtensionVK : uint32_t {
   kEXTPipelineCreationFeedback,
   kARMRasterizationOrderAttachmentAccess,
   kEXTRasterizationOrderAttachmentAccess,
+  // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_GOOGLE_display_timing.html
+  kGOOGLEDisplayTiming,
+  // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_KHR_external_semaphore_fd.html
+  kKHRExternalSemaphoreFd,
+  // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_EXT_memory_budget.html
+  kEXTMemoryBudget,
   kLast,
 };
 
@@ -78,6 +84,12 @@ class CapabilitiesVK final : public Capabilities,
   // |Capabilities|
   bool SupportsFramebufferFetch() const override;
 
+  /// @brief Whether framebuffer reads are coherent with rasterization order,
+  ///        in which case no barrier is needed between a draw that writes
+  ///        the color attachment and one that reads it as an input
+  ///        attachment.
+  bool SupportsRasterizationOrderAttachmentAccess() const;
+
   // |Capabilities|
   bool SupportsCompute() const override;
 
@@ -93,6 +105,9 @@ class CapabilitiesVK final : public Capabilities,
   // |Capabilities|
   bool SupportsDeviceTransientTextures() const override;
 
+  // |Capabilities|
+  bool SupportsCompressedTextureFormat(PixelFormat format) const override;
+
   // |Capabilities|
   PixelFormat GetDefaultColorFormat() const override;
 
@@ -106,6 +121,7 @@ class CapabilitiesVK final : public Capabilities,
   bool validations_enabled_ = false;
   std::map<std::string, std::set<std::string>> exts_;
   std::set<OptionalDeviceExtensionVK> optional_device_extensions_;
+  std::set<PixelFormat> compressed_texture_formats_;
   mutable PixelFormat default_color_format_ = PixelFormat::kUnknown;
   PixelFormat default_stencil_format_ = PixelFormat::kUnknown;
   PixelFormat default_depth_stencil_format_ = PixelFormat::kUnknown;
@@ -113,6 +129,7 @@ class CapabilitiesVK final : public Capabilities,
   bool supports_compute_subgroups_ = false;
   bool supports_device_transient_textures_ = false;
   bool supports_framebuffer_fetch_ = false;
+  bool supports_rasterization_order_attachment_access_ = false;
   bool is_valid_ = false;
 
   bool HasExtension(const std::string& ext) const;
@@ -55,6 +55,10 @@ bool CommandBufferVK::OnSubmitCommands(CompletionCallback callback) {
   if (!encoder_) {
     encoder_ = encoder_factory_->Create();
   }
+  // The commands may sample textures whose uploads are still pending.
+  if (auto context = context_.lock()) {
+    ContextVK::Cast(*context).FlushTextureUploads();
+  }
   if (!callback) {
     return encoder_->Submit();
   }
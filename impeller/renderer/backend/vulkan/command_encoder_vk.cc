@@ -32,13 +32,30 @@ std::shared_ptr<CommandEncoderVK> CommandEncoderFactoryVK::Create() {
   if (!recycler) {
     return nullptr;
   }
-  auto tls_pool = recycler->Get();
-  if (!tls_pool) {
+  return CreateWithPool(context, recycler->Get());
+}
+
+std::shared_ptr<CommandEncoderVK> CommandEncoderFactoryVK::CreateDetached() {
+  auto context = context_.lock();
+  if (!context) {
+    return nullptr;
+  }
+  auto recycler = context->GetCommandPoolRecycler();
+  if (!recycler) {
+    return nullptr;
+  }
+  return CreateWithPool(context, recycler->GetDetached());
+}
+
+std::shared_ptr<CommandEncoderVK> CommandEncoderFactoryVK::CreateWithPool(
+    const std::shared_ptr<const ContextVK>& context,
+    const std::shared_ptr<CommandPoolVK>& pool) {
+  if (!pool) {
     return nullptr;
   }
 
   auto tracked_objects = std::make_shared<TrackedObjectsVK>(
-      context, tls_pool, context->GetGPUTracer()->CreateGPUProbe());
+      context, pool, context->GetGPUTracer()->CreateGPUProbe());
   auto queue = context->GetGraphicsQueue();
 
   if (!tracked_objects || !tracked_objects->IsValid() || !queue) {
@@ -124,6 +141,8 @@ bool CommandEncoderVK::Submit(SubmitCallback callback) {
   vk::SubmitInfo submit_info;
   std::vector<vk::CommandBuffer> buffers = {command_buffer};
   submit_info.setCommandBuffers(buffers);
+  submit_info.setWaitSemaphores(wait_semaphores_);
+  submit_info.setWaitDstStageMask(wait_stages_);
   status = queue_->Submit(submit_info, *fence);
   if (status != vk::Result::eSuccess) {
     VALIDATION_LOG << "Failed to submit queue: " << vk::to_string(status);
@@ -191,6 +210,17 @@ bool CommandEncoderVK::Track(std::shared_ptr<const TextureSourceVK> texture) {
   return true;
 }
 
+bool CommandEncoderVK::AddWaitSemaphore(SharedHandleVK<vk::Semaphore> semaphore,
+                                        vk::PipelineStageFlags stage) {
+  if (!IsValid() || !semaphore) {
+    return false;
+  }
+  wait_semaphores_.push_back(semaphore->Get());
+  wait_stages_.push_back(stage);
+  tracked_objects_->Track(std::move(semaphore));
+  return true;
+}
+
 bool CommandEncoderVK::Track(const std::shared_ptr<const Texture>& texture) {
   if (!IsValid()) {
     return false;
@@ -233,6 +263,14 @@ void CommandEncoderVK::PushDebugGroup(const char* label) const {
   }
 }
 
+void CommandEncoderVK::RecordDrawCategory(
+    std::optional<DrawCategory> category) const {
+  if (tracked_objects_) {
+    tracked_objects_->GetGPUProbe().RecordDrawCategory(GetCommandBuffer(),
+                                                       category);
+  }
+}
+
 void CommandEncoderVK::PopDebugGroup() const {
   if (!HasValidationLayers()) {
     return;
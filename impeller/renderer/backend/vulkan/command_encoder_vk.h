@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <functional>
 #include <optional>
+#include <vector>
 
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
@@ -35,12 +36,20 @@ class CommandEncoderFactoryVK {
 
   std::shared_ptr<CommandEncoderVK> Create();
 
+  /// Like |Create|, but records into a command pool that is not associated
+  /// with the current thread, for threads that never dispose of their pools.
+  std::shared_ptr<CommandEncoderVK> CreateDetached();
+
   void SetLabel(const std::string& label);
 
  private:
   std::weak_ptr<const ContextVK> context_;
   std::optional<std::string> label_;
 
+  std::shared_ptr<CommandEncoderVK> CreateWithPool(
+      const std::shared_ptr<const ContextVK>& context,
+      const std::shared_ptr<CommandPoolVK>& pool);
+
   CommandEncoderFactoryVK(const CommandEncoderFactoryVK&) = delete;
 
   CommandEncoderFactoryVK& operator=(const CommandEncoderFactoryVK&) = delete;
@@ -74,6 +83,11 @@ class CommandEncoderVK {
 
   bool Track(std::shared_ptr<const TextureSourceVK> texture);
 
+  /// Makes the submission of this encoder wait on `semaphore` at `stage`. The
+  /// semaphore is tracked until the submission completes.
+  bool AddWaitSemaphore(SharedHandleVK<vk::Semaphore> semaphore,
+                        vk::PipelineStageFlags stage);
+
   vk::CommandBuffer GetCommandBuffer() const;
 
   void PushDebugGroup(const char* label) const;
@@ -82,6 +96,11 @@ class CommandEncoderVK {
 
   void InsertDebugMarker(const char* label) const;
 
+  /// Attributes the GPU time of the following draws to `category`, or ends
+  /// the attribution if `category` is std::nullopt. Only valid inside a
+  /// render pass.
+  void RecordDrawCategory(std::optional<DrawCategory> category) const;
+
   fml::StatusOr<vk::DescriptorSet> AllocateDescriptorSets(
       const vk::DescriptorSetLayout& layout,
       const ContextVK& context);
@@ -94,6 +113,8 @@ class CommandEncoderVK {
   std::shared_ptr<QueueVK> queue_;
   const std::shared_ptr<FenceWaiterVK> fence_waiter_;
   std::shared_ptr<HostBuffer> host_buffer_;
+  std::vector<vk::Semaphore> wait_semaphores_;
+  std::vector<vk::PipelineStageFlags> wait_stages_;
   bool is_valid_ = true;
 
   void Reset();
@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <utility>
@@ -25,9 +27,11 @@ class BackgroundCommandPoolVK final {
   explicit BackgroundCommandPoolVK(
       vk::UniqueCommandPool&& pool,
       std::vector<vk::UniqueCommandBuffer>&& buffers,
+      std::vector<vk::UniqueCommandBuffer>&& secondary_buffers,
       std::weak_ptr<CommandPoolRecyclerVK> recycler)
       : pool_(std::move(pool)),
         buffers_(std::move(buffers)),
+        secondary_buffers_(std::move(secondary_buffers)),
         recycler_(std::move(recycler)) {}
 
   ~BackgroundCommandPoolVK() {
@@ -40,9 +44,10 @@ class BackgroundCommandPoolVK final {
     if (!recycler) {
       return;
     }
-    buffers_.clear();
+    secondary_buffers_.clear();
 
-    recycler->Reclaim(std::move(pool_));
+    // The primary buffers are reset along with the pool and recycled.
+    recycler->Reclaim(std::move(pool_), std::move(buffers_));
   }
 
  private:
@@ -56,6 +61,7 @@ class BackgroundCommandPoolVK final {
   // wrapper type will attempt to reset the cmd buffer, and doing so may be a
   // thread safety violation as this may happen on the fence waiter thread.
   std::vector<vk::UniqueCommandBuffer> buffers_;
+  std::vector<vk::UniqueCommandBuffer> secondary_buffers_;
   std::weak_ptr<CommandPoolRecyclerVK> recycler_;
 };
 
@@ -73,15 +79,21 @@ CommandPoolVK::~CommandPoolVK() {
     return;
   }
 
+  // Buffers that were never handed out are recycled again as well.
+  std::move(free_buffers_.begin(), free_buffers_.end(),
+            std::back_inserter(collected_buffers_));
+  free_buffers_.clear();
   auto reset_pool_when_dropped = BackgroundCommandPoolVK(
-      std::move(pool_), std::move(collected_buffers_), recycler);
+      std::move(pool_), std::move(collected_buffers_),
+      std::move(collected_secondary_buffers_), recycler);
 
   UniqueResourceVKT<BackgroundCommandPoolVK> pool(
       context->GetResourceManager(), std::move(reset_pool_when_dropped));
 }
 
 // TODO(matanlurey): Return a status_or<> instead of {} when we have one.
-vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer() {
+vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer(
+    vk::CommandBufferLevel level) {
   auto const context = context_.lock();
   if (!context) {
     return {};
@@ -92,11 +104,17 @@ vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer() {
     return {};
   }
 
+  if (level == vk::CommandBufferLevel::ePrimary && !free_buffers_.empty()) {
+    auto buffer = std::move(free_buffers_.back());
+    free_buffers_.pop_back();
+    return buffer;
+  }
+
   auto const device = context->GetDevice();
   vk::CommandBufferAllocateInfo info;
   info.setCommandPool(pool_.get());
   info.setCommandBufferCount(1u);
-  info.setLevel(vk::CommandBufferLevel::ePrimary);
+  info.setLevel(level);
   auto [result, buffers] = device.allocateCommandBuffersUnique(info);
   if (result != vk::Result::eSuccess) {
     return {};
@@ -104,7 +122,8 @@ vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer() {
   return std::move(buffers[0]);
 }
 
-void CommandPoolVK::CollectCommandBuffer(vk::UniqueCommandBuffer&& buffer) {
+void CommandPoolVK::CollectCommandBuffer(vk::UniqueCommandBuffer&& buffer,
+                                         vk::CommandBufferLevel level) {
   Lock lock(pool_mutex_);
   if (!pool_) {
     // If the command pool has already been destroyed, then its buffers have
@@ -112,7 +131,11 @@ void CommandPoolVK::CollectCommandBuffer(vk::UniqueCommandBuffer&& buffer) {
     buffer.release();
     return;
   }
-  collected_buffers_.push_back(std::move(buffer));
+  if (level == vk::CommandBufferLevel::ePrimary) {
+    collected_buffers_.push_back(std::move(buffer));
+  } else {
+    collected_secondary_buffers_.push_back(std::move(buffer));
+  }
 }
 
 void CommandPoolVK::Destroy() {
@@ -121,10 +144,13 @@ void CommandPoolVK::Destroy() {
 
   // When the command pool is destroyed, all of its command buffers are freed.
   // Handles allocated from that pool are now invalid and must be discarded.
-  for (auto& buffer : collected_buffers_) {
-    buffer.release();
+  for (auto* buffers : {&collected_buffers_, &collected_secondary_buffers_,
+                        &free_buffers_}) {
+    for (auto& buffer : *buffers) {
+      buffer.release();
+    }
+    buffers->clear();
   }
-  collected_buffers_.clear();
 }
 
 // Associates a resource with a thread and context.
@@ -164,8 +190,8 @@ std::shared_ptr<CommandPoolVK> CommandPoolRecyclerVK::Get() {
     return nullptr;
   }
 
-  auto const resource =
-      std::make_shared<CommandPoolVK>(std::move(*pool), context_);
+  auto const resource = std::make_shared<CommandPoolVK>(
+      std::move(pool->pool), context_, std::move(pool->buffers));
   pool_map.emplace(hash, resource);
 
   {
@@ -176,8 +202,39 @@ std::shared_ptr<CommandPoolVK> CommandPoolRecyclerVK::Get() {
   return resource;
 }
 
+std::shared_ptr<CommandPoolVK> CommandPoolRecyclerVK::GetDetached() {
+  auto const strong_context = context_.lock();
+  if (!strong_context) {
+    return nullptr;
+  }
+
+  auto pool = Create();
+  if (!pool) {
+    return nullptr;
+  }
+
+  auto const resource = std::make_shared<CommandPoolVK>(
+      std::move(pool->pool), context_, std::move(pool->buffers));
+
+  {
+    // Register the pool so that it is destroyed along with the context even if
+    // it is still referenced, dropping the entries of pools already recycled.
+    Lock all_pools_lock(g_all_pools_map_mutex);
+    auto& pools = g_all_pools_map[strong_context.get()];
+    pools.erase(std::remove_if(pools.begin(), pools.end(),
+                               [](const std::weak_ptr<CommandPoolVK>& pool) {
+                                 return pool.expired();
+                               }),
+                pools.end());
+    pools.push_back(resource);
+  }
+
+  return resource;
+}
+
 // TODO(matanlurey): Return a status_or<> instead of nullopt when we have one.
-std::optional<vk::UniqueCommandPool> CommandPoolRecyclerVK::Create() {
+std::optional<CommandPoolRecyclerVK::RecycledData>
+CommandPoolRecyclerVK::Create() {
   // If we can reuse a command pool, do so.
   if (auto pool = Reuse()) {
     return pool;
@@ -197,10 +254,11 @@ std::optional<vk::UniqueCommandPool> CommandPoolRecyclerVK::Create() {
   if (result != vk::Result::eSuccess) {
     return std::nullopt;
   }
-  return std::move(pool);
+  return RecycledData{.pool = std::move(pool)};
 }
 
-std::optional<vk::UniqueCommandPool> CommandPoolRecyclerVK::Reuse() {
+std::optional<CommandPoolRecyclerVK::RecycledData>
+CommandPoolRecyclerVK::Reuse() {
   // If there are no recycled pools, return nullopt.
   Lock recycled_lock(recycled_mutex_);
   if (recycled_.empty()) {
@@ -208,12 +266,14 @@ std::optional<vk::UniqueCommandPool> CommandPoolRecyclerVK::Reuse() {
   }
 
   // Otherwise, remove and return a recycled pool.
-  auto pool = std::move(recycled_.back());
+  auto data = std::move(recycled_.back());
   recycled_.pop_back();
-  return std::move(pool);
+  return std::move(data);
 }
 
-void CommandPoolRecyclerVK::Reclaim(vk::UniqueCommandPool&& pool) {
+void CommandPoolRecyclerVK::Reclaim(
+    vk::UniqueCommandPool&& pool,
+    std::vector<vk::UniqueCommandBuffer>&& buffers) {
   // Reset the pool on a background thread.
   auto strong_context = context_.lock();
   if (!strong_context) {
@@ -222,9 +282,11 @@ void CommandPoolRecyclerVK::Reclaim(vk::UniqueCommandPool&& pool) {
   auto device = strong_context->GetDevice();
   device.resetCommandPool(pool.get());
 
-  // Move the pool to the recycled list.
+  // Move the pool to the recycled list. Resetting the pool returned its
+  // buffers to the initial state, so they can be recorded again.
   Lock recycled_lock(recycled_mutex_);
-  recycled_.push_back(std::move(pool));
+  recycled_.push_back(
+      RecycledData{.pool = std::move(pool), .buffers = std::move(buffers)});
 }
 
 CommandPoolRecyclerVK::~CommandPoolRecyclerVK() {
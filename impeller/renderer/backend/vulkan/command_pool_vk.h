@@ -8,6 +8,7 @@
 #include <memory>
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/vk.h"  // IWYU pragma: keep.
@@ -24,6 +25,10 @@ class CommandPoolRecyclerVK;
 /// the lifecycle of a single |vk::CommandPool| by returning to the origin
 /// (|CommandPoolRecyclerVK|) when it is destroyed to be reused.
 ///
+/// The primary command buffers collected by this pool are recycled along with
+/// it, so that a reused pool hands out the buffers allocated by its previous
+/// user instead of allocating new ones.
+///
 /// @warning    This class is not thread-safe.
 ///
 /// @see        |CommandPoolRecyclerVK|
@@ -33,25 +38,38 @@ class CommandPoolVK final {
 
   /// @brief      Creates a resource that manages the life of a command pool.
   ///
-  /// @param[in]  pool      The command pool to manage.
-  /// @param[in]  recycler  The context that will be notified on destruction.
+  /// @param[in]  pool          The command pool to manage.
+  /// @param[in]  recycler      The context that will be notified on
+  ///                           destruction.
+  /// @param[in]  free_buffers  Reset primary command buffers allocated from
+  ///                           `pool` to hand out before allocating new ones.
   explicit CommandPoolVK(vk::UniqueCommandPool pool,
-                         std::weak_ptr<ContextVK>& context)
-      : pool_(std::move(pool)), context_(context) {}
+                         std::weak_ptr<ContextVK>& context,
+                         std::vector<vk::UniqueCommandBuffer> free_buffers = {})
+      : pool_(std::move(pool)),
+        context_(context),
+        free_buffers_(std::move(free_buffers)) {}
 
   /// @brief      Creates and returns a new |vk::CommandBuffer|.
   ///
+  /// @param[in]  level  Whether to create a primary or a secondary buffer.
+  ///
   /// @return     Always returns a new |vk::CommandBuffer|, but if for any
   ///             reason a valid command buffer could not be created, it will be
   ///             a `{}` default instance (i.e. while being torn down).
-  vk::UniqueCommandBuffer CreateCommandBuffer();
+  vk::UniqueCommandBuffer CreateCommandBuffer(
+      vk::CommandBufferLevel level = vk::CommandBufferLevel::ePrimary);
 
   /// @brief      Collects the given |vk::CommandBuffer| to be retained.
   ///
   /// @param[in]  buffer  The |vk::CommandBuffer| to collect.
+  /// @param[in]  level   The level the buffer was created with. Only primary
+  ///                     buffers are recycled along with the pool.
   ///
   /// @see        |GarbageCollectBuffersIfAble|
-  void CollectCommandBuffer(vk::UniqueCommandBuffer&& buffer);
+  void CollectCommandBuffer(
+      vk::UniqueCommandBuffer&& buffer,
+      vk::CommandBufferLevel level = vk::CommandBufferLevel::ePrimary);
 
   /// @brief      Delete all Vulkan objects in this command pool.
   void Destroy();
@@ -68,6 +86,13 @@ class CommandPoolVK final {
   // Used to retain a reference on these until the pool is reset.
   std::vector<vk::UniqueCommandBuffer> collected_buffers_ IPLR_GUARDED_BY(
       pool_mutex_);
+  std::vector<vk::UniqueCommandBuffer> collected_secondary_buffers_
+      IPLR_GUARDED_BY(pool_mutex_);
+
+  // Primary buffers recycled from a previous use of the pool, in the initial
+  // state.
+  std::vector<vk::UniqueCommandBuffer> free_buffers_ IPLR_GUARDED_BY(
+      pool_mutex_);
 };
 
 //------------------------------------------------------------------------------
@@ -116,29 +141,48 @@ class CommandPoolRecyclerVK final
   /// @warning    Returns a |nullptr| if a pool could not be created.
   std::shared_ptr<CommandPoolVK> Get();
 
+  /// @brief      Gets a command pool that is not associated with any thread.
+  ///
+  ///             Such a pool lets one worker record command buffers while
+  ///             other threads record into their own pools. It is reset and
+  ///             recycled once the last reference to it is dropped, and must
+  ///             only be used by one thread at a time.
+  ///
+  /// @warning    Returns a |nullptr| if a pool could not be created.
+  std::shared_ptr<CommandPoolVK> GetDetached();
+
   /// @brief      Returns a command pool to be reset on a background thread.
   ///
-  /// @param[in]  pool The pool to recycler.
-  void Reclaim(vk::UniqueCommandPool&& pool);
+  /// @param[in]  pool     The pool to recycler.
+  /// @param[in]  buffers  Primary buffers allocated from the pool to recycle
+  ///                      along with it.
+  void Reclaim(vk::UniqueCommandPool&& pool,
+               std::vector<vk::UniqueCommandBuffer>&& buffers = {});
 
   /// @brief      Clears all recycled command pools to let them be reclaimed.
   void Dispose();
 
  private:
+  /// A reset command pool along with the primary buffers allocated from it.
+  struct RecycledData {
+    vk::UniqueCommandPool pool;
+    std::vector<vk::UniqueCommandBuffer> buffers;
+  };
+
   std::weak_ptr<ContextVK> context_;
 
   Mutex recycled_mutex_;
-  std::vector<vk::UniqueCommandPool> recycled_ IPLR_GUARDED_BY(recycled_mutex_);
+  std::vector<RecycledData> recycled_ IPLR_GUARDED_BY(recycled_mutex_);
 
   /// @brief      Creates a new |vk::CommandPool|.
   ///
   /// @returns    Returns a |std::nullopt| if a pool could not be created.
-  std::optional<vk::UniqueCommandPool> Create();
+  std::optional<RecycledData> Create();
 
   /// @brief      Reuses a recycled |vk::CommandPool|, if available.
   ///
   /// @returns    Returns a |std::nullopt| if a pool was not available.
-  std::optional<vk::UniqueCommandPool> Reuse();
+  std::optional<RecycledData> Reuse();
 
   CommandPoolRecyclerVK(const CommandPoolRecyclerVK&) = delete;
 
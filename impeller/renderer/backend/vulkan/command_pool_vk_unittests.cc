@@ -52,6 +52,31 @@ TEST(CommandPoolRecyclerVKTest, GetsTheSameCommandPoolOnSameThread) {
   context->Shutdown();
 }
 
+TEST(CommandPoolRecyclerVKTest, GetsADetachedCommandPoolPerCall) {
+  auto const context = MockVulkanContextBuilder().Build();
+
+  {
+    auto const recycler = context->GetCommandPoolRecycler();
+    auto const thread_pool = recycler->Get();
+    auto const pool1 = recycler->GetDetached();
+    auto const pool2 = recycler->GetDetached();
+    ASSERT_NE(pool1, nullptr);
+    ASSERT_NE(pool2, nullptr);
+
+    // Detached pools are neither shared with the thread nor with each other.
+    EXPECT_NE(pool1, thread_pool);
+    EXPECT_NE(pool1, pool2);
+
+    EXPECT_TRUE(pool1->CreateCommandBuffer(vk::CommandBufferLevel::eSecondary));
+
+    auto const called = GetMockVulkanFunctions(context->GetDevice());
+    EXPECT_EQ(
+        std::count(called->begin(), called->end(), "vkCreateCommandPool"), 3u);
+  }
+
+  context->Shutdown();
+}
+
 namespace {
 
 // Invokes the provided callback when the destructor is called.
@@ -112,5 +137,45 @@ TEST(CommandPoolRecyclerVKTest, ReclaimMakesCommandPoolAvailable) {
   context->Shutdown();
 }
 
+TEST(CommandPoolRecyclerVKTest, RecyclesCommandBuffersWithCommandPool) {
+  auto const context = MockVulkanContextBuilder().Build();
+
+  {
+    auto const recycler = context->GetCommandPoolRecycler();
+    auto const pool = recycler->Get();
+    auto buffer = pool->CreateCommandBuffer();
+    EXPECT_TRUE(buffer);
+    pool->CollectCommandBuffer(std::move(buffer));
+
+    // This normally is called at the end of a frame.
+    recycler->Dispose();
+  }
+
+  // Wait for the pool to be reclaimed.
+  auto waiter = fml::AutoResetWaitableEvent();
+  auto rattle = DeathRattle([&waiter]() { waiter.Signal(); });
+  {
+    UniqueResourceVKT<DeathRattle> resource(context->GetResourceManager(),
+                                            std::move(rattle));
+  }
+  waiter.Wait();
+
+  // The recycled pool hands out the command buffer it was reclaimed with.
+  std::thread thread([&]() {
+    auto const pool = context->GetCommandPoolRecycler()->Get();
+    EXPECT_TRUE(pool->CreateCommandBuffer());
+  });
+  thread.join();
+
+  auto const called = GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_EQ(std::count(called->begin(), called->end(), "vkCreateCommandPool"),
+            1u);
+  EXPECT_EQ(
+      std::count(called->begin(), called->end(), "vkAllocateCommandBuffers"),
+      1u);
+
+  context->Shutdown();
+}
+
 }  // namespace testing
 }  // namespace impeller
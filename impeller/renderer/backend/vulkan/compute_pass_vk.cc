@@ -111,7 +111,7 @@ bool ComputePassVK::OnEncodeCommands(const Context& context,
     if (!desc_set_result.ok()) {
       return false;
     }
-    auto desc_set = desc_set_result.value();
+    const auto& desc_set = desc_set_result.value();
 
     const auto& pipeline_vk = ComputePipelineVK::Cast(*command.pipeline);
 
@@ -121,8 +121,10 @@ bool ComputePassVK::OnEncodeCommands(const Context& context,
         vk::PipelineBindPoint::eCompute,  // bind point
         pipeline_vk.GetPipelineLayout(),  // layout
         0,                                // first set
-        {vk::DescriptorSet{desc_set}},    // sets
-        nullptr                           // offsets
+        1,                                // set count
+        &desc_set.descriptor_set,         // sets
+        desc_set.dynamic_offset_count,    // offset count
+        desc_set.dynamic_offsets.data()   // offsets
     );
 
     // TOOD(dnfield): This should be moved to caps. But for now keeping this
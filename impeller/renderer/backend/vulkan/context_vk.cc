@@ -27,10 +27,12 @@
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/debug_report_vk.h"
+#include "impeller/renderer/backend/vulkan/descriptor_set_cache_vk.h"
 #include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
 #include "impeller/renderer/backend/vulkan/gpu_tracer_vk.h"
 #include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
 #include "impeller/renderer/backend/vulkan/surface_context_vk.h"
+#include "impeller/renderer/backend/vulkan/texture_upload_queue_vk.h"
 #include "impeller/renderer/capabilities.h"
 
 VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE
@@ -78,13 +80,14 @@ static std::vector<vk::DeviceQueueCreateInfo> GetQueueCreateInfos(
   return infos;
 }
 
-static std::optional<QueueIndexVK> PickQueue(const vk::PhysicalDevice& device,
-                                             vk::QueueFlagBits flags) {
-  // This can be modified to ensure that dedicated queues are returned for each
-  // queue type depending on support.
+static std::optional<QueueIndexVK> PickQueue(
+    const vk::PhysicalDevice& device,
+    vk::QueueFlagBits flags,
+    vk::QueueFlags excluded_flags = {}) {
   const auto families = device.getQueueFamilyProperties();
   for (size_t i = 0u; i < families.size(); i++) {
-    if (!(families[i].queueFlags & flags)) {
+    if (!(families[i].queueFlags & flags) ||
+        (families[i].queueFlags & excluded_flags)) {
       continue;
     }
     return QueueIndexVK{.family = i, .index = 0};
@@ -271,8 +274,11 @@ void ContextVK::Setup(Settings settings) {
   ///
   auto graphics_queue =
       PickQueue(device_holder->physical_device, vk::QueueFlagBits::eGraphics);
+  // Graphics and compute queues support transfers too, so only a queue family
+  // without them lets uploads run alongside rendering.
   auto transfer_queue =
-      PickQueue(device_holder->physical_device, vk::QueueFlagBits::eTransfer);
+      PickQueue(device_holder->physical_device, vk::QueueFlagBits::eTransfer,
+                vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute);
   auto compute_queue =
       PickQueue(device_holder->physical_device, vk::QueueFlagBits::eCompute);
 
@@ -383,12 +389,6 @@ void ContextVK::Setup(Settings settings) {
     return;
   }
 
-  //----------------------------------------------------------------------------
-  /// Create the fence waiter.
-  ///
-  auto fence_waiter =
-      std::shared_ptr<FenceWaiterVK>(new FenceWaiterVK(device_holder));
-
   //----------------------------------------------------------------------------
   /// Create the resource manager and command pool recycler.
   ///
@@ -398,6 +398,12 @@ void ContextVK::Setup(Settings settings) {
     return;
   }
 
+  //----------------------------------------------------------------------------
+  /// Create the fence waiter.
+  ///
+  auto fence_waiter = std::shared_ptr<FenceWaiterVK>(
+      new FenceWaiterVK(device_holder, resource_manager));
+
   auto command_pool_recycler =
       std::make_shared<CommandPoolRecyclerVK>(weak_from_this());
   if (!command_pool_recycler) {
@@ -444,9 +450,22 @@ void ContextVK::Setup(Settings settings) {
   resource_manager_ = std::move(resource_manager);
   command_pool_recycler_ = std::move(command_pool_recycler);
   descriptor_pool_recycler_ = std::move(descriptor_pool_recycler);
+  descriptor_set_cache_ =
+      std::make_shared<DescriptorSetCacheVK>(device_holder_);
+  if (queues_.transfer_queue->GetIndex().family !=
+      queues_.graphics_queue->GetIndex().family) {
+    texture_upload_queue_ = std::make_shared<TextureUploadQueueVK>(
+        weak_from_this(), queues_.transfer_queue);
+  }
   device_name_ = std::string(physical_device_properties.deviceName);
+  enable_parallel_render_pass_encoding_ =
+      settings.enable_parallel_render_pass_encoding;
   is_valid_ = true;
 
+  // Start creating the pipelines used by previous sessions while the rest of
+  // the engine starts up.
+  pipeline_library_->WarmUpPipelines(*shader_library_);
+
   // Create the GPU Tracer later because it depends on state from
   // the ContextVK.
   gpu_tracer_ = std::make_shared<GPUTracerVK>(GetDeviceHolder());
@@ -506,7 +525,7 @@ const fml::RefPtr<fml::TaskRunner> ContextVK::GetQueueSubmitRunner() const {
   return queue_submit_thread_->GetTaskRunner();
 }
 
-const std::shared_ptr<fml::ConcurrentTaskRunner>
+std::shared_ptr<fml::ConcurrentTaskRunner>
 ContextVK::GetConcurrentWorkerTaskRunner() const {
   return raster_message_loop_->GetTaskRunner();
 }
@@ -517,6 +536,7 @@ void ContextVK::Shutdown() {
   // pointers ensures that cleanup happens in a correct order.
   //
   // tl;dr: Without it, we get thread::join failures on shutdown.
+  texture_upload_queue_.reset();
   fence_waiter_.reset();
   resource_manager_.reset();
 
@@ -553,6 +573,20 @@ std::shared_ptr<CommandPoolRecyclerVK> ContextVK::GetCommandPoolRecycler()
   return command_pool_recycler_;
 }
 
+bool ContextVK::EnqueueTextureUpload(std::shared_ptr<DeviceBuffer> source,
+                                     std::shared_ptr<Texture> texture) {
+  if (!texture_upload_queue_) {
+    return false;
+  }
+  return texture_upload_queue_->Enqueue(std::move(source), std::move(texture));
+}
+
+void ContextVK::FlushTextureUploads() const {
+  if (texture_upload_queue_) {
+    texture_upload_queue_->Flush();
+  }
+}
+
 std::unique_ptr<CommandEncoderFactoryVK>
 ContextVK::CreateGraphicsCommandEncoderFactory() const {
   return std::make_unique<CommandEncoderFactoryVK>(weak_from_this());
@@ -562,4 +596,22 @@ std::shared_ptr<GPUTracerVK> ContextVK::GetGPUTracer() const {
   return gpu_tracer_;
 }
 
+// |Context|
+std::optional<fml::TimeDelta> ContextVK::GetLastGPUFrameTime() const {
+  return gpu_tracer_ ? gpu_tracer_->GetLastFrameTime() : std::nullopt;
+}
+
+// |Context|
+std::optional<DrawCategoryTimes> ContextVK::GetLastGPUFrameTimeByCategory()
+    const {
+  return gpu_tracer_ ? gpu_tracer_->GetLastFrameCategoryTimes() : std::nullopt;
+}
+
+// |Context|
+std::optional<PipelineStatistics> ContextVK::GetLastGPUFramePipelineStatistics()
+    const {
+  return gpu_tracer_ ? gpu_tracer_->GetLastFramePipelineStatistics()
+                     : std::nullopt;
+}
+
 }  // namespace impeller
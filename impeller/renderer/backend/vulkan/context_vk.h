@@ -34,7 +34,9 @@ class FenceWaiterVK;
 class ResourceManagerVK;
 class SurfaceContextVK;
 class GPUTracerVK;
+class TextureUploadQueueVK;
 class DescriptorPoolRecyclerVK;
+class DescriptorSetCacheVK;
 
 class ContextVK final : public Context,
                         public BackendCast<ContextVK, Context>,
@@ -45,6 +47,9 @@ class ContextVK final : public Context,
     std::vector<std::shared_ptr<fml::Mapping>> shader_libraries_data;
     fml::UniqueFD cache_directory;
     bool enable_validation = false;
+    /// Whether render passes with many commands may be recorded into
+    /// secondary command buffers on the worker threads.
+    bool enable_parallel_render_pass_encoding = false;
 
     Settings() = default;
 
@@ -88,9 +93,24 @@ class ContextVK final : public Context,
   // |Context|
   void Shutdown() override;
 
+  // |Context|
+  bool EnqueueTextureUpload(std::shared_ptr<DeviceBuffer> source,
+                            std::shared_ptr<Texture> texture) override;
+
   // |Context|
   void SetSyncPresentation(bool value) override { sync_presentation_ = value; }
 
+  // |Context|
+  std::optional<fml::TimeDelta> GetLastGPUFrameTime() const override;
+
+  // |Context|
+  std::optional<DrawCategoryTimes> GetLastGPUFrameTimeByCategory()
+      const override;
+
+  // |Context|
+  std::optional<PipelineStatistics> GetLastGPUFramePipelineStatistics()
+      const override;
+
   bool GetSyncPresentation() const { return sync_presentation_; }
 
   void SetOffscreenFormat(PixelFormat pixel_format);
@@ -132,8 +152,9 @@ class ContextVK final : public Context,
 
   const vk::Device& GetDevice() const;
 
-  const std::shared_ptr<fml::ConcurrentTaskRunner>
-  GetConcurrentWorkerTaskRunner() const;
+  // |Context|
+  std::shared_ptr<fml::ConcurrentTaskRunner> GetConcurrentWorkerTaskRunner()
+      const override;
 
   /// @brief A single-threaded task runner that should only be used for
   ///        submitKHR.
@@ -159,14 +180,38 @@ class ContextVK final : public Context,
 
   std::shared_ptr<CommandPoolRecyclerVK> GetCommandPoolRecycler() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Submits the texture uploads enqueued on the transfer queue.
+  ///             Called before any command buffer is submitted to the graphics
+  ///             queue, since it may sample the uploaded textures.
+  ///
+  void FlushTextureUploads() const;
+
   std::shared_ptr<DescriptorPoolRecyclerVK> GetDescriptorPoolRecycler() const {
     return descriptor_pool_recycler_;
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      The cache of descriptor sets reused across frames by commands
+  ///             binding the same resources.
+  ///
+  const std::shared_ptr<DescriptorSetCacheVK>& GetDescriptorSetCache() const {
+    return descriptor_set_cache_;
+  }
+
   std::shared_ptr<GPUTracerVK> GetGPUTracer() const;
 
   void RecordFrameEndTime() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether render passes may record their commands into
+  ///             secondary command buffers on the concurrent worker task
+  ///             runner.
+  ///
+  bool IsParallelRenderPassEncodingEnabled() const {
+    return enable_parallel_render_pass_encoding_;
+  }
+
  private:
   struct DeviceHolderImpl : public DeviceHolder {
     // |DeviceHolder|
@@ -197,12 +242,18 @@ class ContextVK final : public Context,
   std::unique_ptr<fml::Thread> queue_submit_thread_;
   std::shared_ptr<GPUTracerVK> gpu_tracer_;
   std::shared_ptr<DescriptorPoolRecyclerVK> descriptor_pool_recycler_;
+  std::shared_ptr<DescriptorSetCacheVK> descriptor_set_cache_;
+  // Null unless the device has a dedicated transfer queue.
+  std::shared_ptr<TextureUploadQueueVK> texture_upload_queue_;
 
   bool sync_presentation_ = false;
+  bool enable_parallel_render_pass_encoding_ = false;
   const uint64_t hash_;
 
   bool is_valid_ = false;
 
+  friend class TextureUploadQueueVK;
+
   ContextVK();
 
   void Setup(Settings settings);
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/testing/testing.h"  // IWYU pragma: keep
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
@@ -143,5 +145,61 @@ TEST(ContextVKTest, CanCreateContextWithValidationLayers) {
   ASSERT_TRUE(capabilites_vk->AreValidationsEnabled());
 }
 
+TEST(ContextVKTest, DoesNotEnqueueTextureUploadsWithoutTransferQueue) {
+  // The mocked device only has a graphics queue family.
+  auto context = MockVulkanContextBuilder().Build();
+  ASSERT_NE(context, nullptr);
+
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {4, 4};
+  auto texture = context->GetResourceAllocator()->CreateTexture(desc);
+  auto buffer = context->GetResourceAllocator()->CreateBuffer(
+      {StorageMode::kHostVisible, desc.GetByteSizeOfBaseMipLevel()});
+  ASSERT_TRUE(texture);
+  ASSERT_TRUE(buffer);
+
+  EXPECT_FALSE(context->EnqueueTextureUpload(buffer, texture));
+}
+
+TEST(ContextVKTest, CompactMemoryDoesNothingWithoutUnusedDeviceMemory) {
+  // The mocked device has no device local heap, so no block of device memory
+  // is worth compacting.
+  auto context = MockVulkanContextBuilder().Build();
+  ASSERT_NE(context, nullptr);
+
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {4, 4};
+  auto texture = context->GetResourceAllocator()->CreateTexture(desc);
+  ASSERT_TRUE(texture);
+
+  auto count_allocated_command_buffers = [&context]() {
+    auto functions = GetMockVulkanFunctions(context->GetDevice());
+    return std::count(functions->begin(), functions->end(),
+                      "vkAllocateCommandBuffers");
+  };
+  auto allocated_before = count_allocated_command_buffers();
+
+  auto deadline = fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(1);
+  context->GetResourceAllocator()->CompactMemory(deadline);
+  context->GetResourceAllocator()->CompactMemory(deadline);
+
+  EXPECT_EQ(count_allocated_command_buffers(), allocated_before);
+}
+
+TEST(ContextVKTest, SupportsFramebufferFetchWithoutRasterizationOrderAccess) {
+  // The mocked device doesn't report the rasterization order attachment
+  // access extensions.
+  auto context = MockVulkanContextBuilder().Build();
+  ASSERT_NE(context, nullptr);
+  const CapabilitiesVK* capabilites_vk =
+      reinterpret_cast<const CapabilitiesVK*>(context->GetCapabilities().get());
+  EXPECT_TRUE(capabilites_vk->SupportsFramebufferFetch());
+  EXPECT_FALSE(capabilites_vk->SupportsRasterizationOrderAttachmentAccess());
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -167,7 +167,7 @@ vk::UniqueDescriptorPool DescriptorPoolRecyclerVK::Create() {
   std::vector<vk::DescriptorPoolSize> pools = {
       vk::DescriptorPoolSize{vk::DescriptorType::eCombinedImageSampler,
                              kDefaultBindingSize.texture_bindings},
-      vk::DescriptorPoolSize{vk::DescriptorType::eUniformBuffer,
+      vk::DescriptorPoolSize{vk::DescriptorType::eUniformBufferDynamic,
                              kDefaultBindingSize.buffer_bindings},
       vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer,
                              kDefaultBindingSize.storage_bindings},
@@ -0,0 +1,216 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/descriptor_set_cache_vk.h"
+
+#include <algorithm>
+#include <optional>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+// The pool backing the cache. Sets are freed when the last command buffer
+// using them completes, which may happen on any thread, so access to the pool
+// is synchronized separately from the cache itself.
+class DescriptorSetPoolVK {
+ public:
+  explicit DescriptorSetPoolVK(vk::UniqueDescriptorPool pool)
+      : pool_(std::move(pool)) {}
+
+  std::optional<vk::DescriptorSet> Allocate(vk::DescriptorSetLayout layout) {
+    Lock lock(mutex_);
+    vk::DescriptorSetAllocateInfo set_info;
+    set_info.setDescriptorPool(pool_.get());
+    set_info.setPSetLayouts(&layout);
+    set_info.setDescriptorSetCount(1);
+    vk::DescriptorSet set;
+    auto result = pool_.getOwner().allocateDescriptorSets(&set_info, &set);
+    if (result != vk::Result::eSuccess) {
+      return std::nullopt;
+    }
+    return set;
+  }
+
+  void Free(vk::DescriptorSet set) {
+    Lock lock(mutex_);
+    [[maybe_unused]] auto result =
+        pool_.getOwner().freeDescriptorSets(pool_.get(), 1u, &set);
+  }
+
+ private:
+  Mutex mutex_;
+  vk::UniqueDescriptorPool pool_ IPLR_GUARDED_BY(mutex_);
+
+  DescriptorSetPoolVK(const DescriptorSetPoolVK&) = delete;
+
+  DescriptorSetPoolVK& operator=(const DescriptorSetPoolVK&) = delete;
+};
+
+DescriptorSetKeyVK::DescriptorSetKeyVK(vk::DescriptorSetLayout layout)
+    : layout_(layout),
+      hash_(fml::HashCombine(GetHandleValue(layout))) {}
+
+DescriptorSetKeyVK::~DescriptorSetKeyVK() = default;
+
+void DescriptorSetKeyVK::AddBinding(const Binding& binding) {
+  bindings_.push_back(binding);
+  fml::HashCombineSeed(hash_, binding.binding,
+                       static_cast<uint32_t>(binding.type), binding.resource,
+                       binding.sampler, binding.offset, binding.range);
+}
+
+void DescriptorSetKeyVK::AddDependency(
+    const std::shared_ptr<const void>& object) {
+  dependencies_.push_back(object);
+}
+
+bool DescriptorSetKeyVK::HasExpiredDependencies() const {
+  return std::any_of(
+      dependencies_.begin(), dependencies_.end(),
+      [](const std::weak_ptr<const void>& object) { return object.expired(); });
+}
+
+bool DescriptorSetKeyVK::operator==(const DescriptorSetKeyVK& other) const {
+  return hash_ == other.hash_ && layout_ == other.layout_ &&
+         bindings_ == other.bindings_;
+}
+
+CachedDescriptorSetVK::CachedDescriptorSetVK(
+    std::shared_ptr<DescriptorSetPoolVK> pool,
+    vk::DescriptorSet set)
+    : pool_(std::move(pool)), set_(set) {}
+
+CachedDescriptorSetVK::~CachedDescriptorSetVK() {
+  pool_->Free(set_);
+}
+
+DescriptorSetCacheVK::DescriptorSetCacheVK(
+    std::weak_ptr<const DeviceHolder> device_holder,
+    size_t max_cached_sets)
+    : device_holder_(std::move(device_holder)),
+      max_cached_sets_(max_cached_sets) {}
+
+DescriptorSetCacheVK::~DescriptorSetCacheVK() = default;
+
+std::shared_ptr<CachedDescriptorSetVK> DescriptorSetCacheVK::Get(
+    const DescriptorSetKeyVK& key) {
+  Lock lock(mutex_);
+  auto found = index_.find(&key);
+  if (found == index_.end()) {
+    statistics_.misses++;
+    ReportStatistics();
+    return nullptr;
+  }
+  if (found->second->first.HasExpiredDependencies()) {
+    // A bound resource was destroyed; its handle may since have been reused
+    // by an unrelated object.
+    Evict(found->second);
+    statistics_.misses++;
+    ReportStatistics();
+    return nullptr;
+  }
+  statistics_.hits++;
+  ReportStatistics();
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return entries_.front().second;
+}
+
+std::shared_ptr<CachedDescriptorSetVK> DescriptorSetCacheVK::Create(
+    DescriptorSetKeyVK key) {
+  if (max_cached_sets_ == 0u) {
+    return nullptr;
+  }
+
+  Lock lock(mutex_);
+  if (!pool_ && !CreatePool()) {
+    return nullptr;
+  }
+
+  auto found = index_.find(&key);
+  if (found != index_.end()) {
+    Evict(found->second);
+  }
+  while (entries_.size() >= max_cached_sets_) {
+    Evict(std::prev(entries_.end()));
+  }
+
+  auto allocated = pool_->Allocate(key.GetLayout());
+  if (!allocated.has_value()) {
+    // The pool may be fragmented or lack descriptors of some type. Sets in use
+    // by pending command buffers can't be freed early, so let the caller fall
+    // back to a per-frame set instead.
+    return nullptr;
+  }
+
+  auto set = std::make_shared<CachedDescriptorSetVK>(pool_, allocated.value());
+  entries_.emplace_front(std::move(key), set);
+  index_[&entries_.front().first] = entries_.begin();
+  statistics_.entry_count = entries_.size();
+  return set;
+}
+
+void DescriptorSetCacheVK::Clear() {
+  Lock lock(mutex_);
+  index_.clear();
+  entries_.clear();
+  statistics_.entry_count = 0u;
+}
+
+DescriptorSetCacheVK::Statistics DescriptorSetCacheVK::GetStatistics() const {
+  Lock lock(mutex_);
+  return statistics_;
+}
+
+void DescriptorSetCacheVK::Evict(EntryList::iterator entry) {
+  index_.erase(&entry->first);
+  entries_.erase(entry);
+  statistics_.entry_count = entries_.size();
+}
+
+bool DescriptorSetCacheVK::CreatePool() {
+  auto device_holder = device_holder_.lock();
+  if (!device_holder) {
+    return false;
+  }
+  // Most pipelines bind a couple of uniform buffers and at most a few
+  // textures.
+  const auto max_sets = static_cast<uint32_t>(max_cached_sets_);
+  std::vector<vk::DescriptorPoolSize> pool_sizes = {
+      vk::DescriptorPoolSize{vk::DescriptorType::eCombinedImageSampler,
+                             max_sets * 2u},
+      vk::DescriptorPoolSize{vk::DescriptorType::eUniformBufferDynamic,
+                             max_sets * 4u},
+      vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer, max_sets},
+  };
+  vk::DescriptorPoolCreateInfo pool_info;
+  // Evicted sets are freed individually.
+  pool_info.setFlags(vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet);
+  pool_info.setMaxSets(max_sets);
+  pool_info.setPoolSizes(pool_sizes);
+  auto [result, pool] =
+      device_holder->GetDevice().createDescriptorPoolUnique(pool_info);
+  if (result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Unable to create the descriptor set cache pool: "
+                   << vk::to_string(result);
+    return false;
+  }
+  pool_ = std::make_shared<DescriptorSetPoolVK>(std::move(pool));
+  return true;
+}
+
+void DescriptorSetCacheVK::ReportStatistics() const {
+  static constexpr int64_t kImpellerDescriptorSetCacheTraceID = 1991;
+  FML_TRACE_COUNTER("impeller",                                          //
+                    "DescriptorSetCacheVK",                              //
+                    kImpellerDescriptorSetCacheTraceID,                  //
+                    "DescriptorSetCacheHits", statistics_.hits,          //
+                    "DescriptorSetCacheMisses", statistics_.misses,      //
+                    "DescriptorSetCacheEntries", statistics_.entry_count  //
+  );
+}
+
+}  // namespace impeller
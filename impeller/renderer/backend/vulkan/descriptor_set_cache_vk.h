@@ -0,0 +1,215 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_DESCRIPTOR_SET_CACHE_VK_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_DESCRIPTOR_SET_CACHE_VK_H_
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "impeller/base/thread.h"
+#include "impeller/renderer/backend/vulkan/device_holder.h"
+#include "impeller/renderer/backend/vulkan/shared_object_vk.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+
+namespace impeller {
+
+class DescriptorSetPoolVK;
+
+//------------------------------------------------------------------------------
+/// @brief      Identifies the contents of a descriptor set: its layout and
+///             every resource written to it.
+///
+///             The key also holds weak references to the objects owning the
+///             bound handles. They don't take part in comparisons, but let the
+///             cache detect sets referring to destroyed resources even if the
+///             driver has reused their handles.
+///
+class DescriptorSetKeyVK {
+ public:
+  struct Binding {
+    uint32_t binding = 0u;
+    vk::DescriptorType type = vk::DescriptorType::eUniformBuffer;
+    /// The buffer or image view, as a raw handle.
+    uint64_t resource = 0u;
+    uint64_t sampler = 0u;
+    uint64_t offset = 0u;
+    uint64_t range = 0u;
+
+    constexpr bool operator==(const Binding& other) const {
+      return binding == other.binding && type == other.type &&
+             resource == other.resource && sampler == other.sampler &&
+             offset == other.offset && range == other.range;
+    }
+  };
+
+  /// @brief      The raw value of a non-dispatchable handle, for use in a
+  ///             |Binding|.
+  template <class T>
+  static uint64_t GetHandleValue(T handle) {
+    auto c_handle = static_cast<typename T::CType>(handle);
+    return reinterpret_cast<uint64_t>(c_handle);
+  }
+
+  explicit DescriptorSetKeyVK(vk::DescriptorSetLayout layout);
+
+  DescriptorSetKeyVK(DescriptorSetKeyVK&&) = default;
+
+  DescriptorSetKeyVK& operator=(DescriptorSetKeyVK&&) = default;
+
+  ~DescriptorSetKeyVK();
+
+  void AddBinding(const Binding& binding);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records an object that must stay alive for the bindings to
+  ///             remain valid.
+  ///
+  void AddDependency(const std::shared_ptr<const void>& object);
+
+  /// @brief      Whether any of the dependencies has been destroyed.
+  bool HasExpiredDependencies() const;
+
+  vk::DescriptorSetLayout GetLayout() const { return layout_; }
+
+  size_t GetHash() const { return hash_; }
+
+  bool operator==(const DescriptorSetKeyVK& other) const;
+
+ private:
+  vk::DescriptorSetLayout layout_;
+  std::vector<Binding> bindings_;
+  std::vector<std::weak_ptr<const void>> dependencies_;
+  size_t hash_;
+
+  DescriptorSetKeyVK(const DescriptorSetKeyVK&) = delete;
+
+  DescriptorSetKeyVK& operator=(const DescriptorSetKeyVK&) = delete;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      A descriptor set owned by a |DescriptorSetCacheVK|.
+///
+///             Encoders must track the set for as long as it is used by their
+///             command buffer. The set is freed once neither the cache nor any
+///             encoder references it.
+///
+class CachedDescriptorSetVK final : public SharedObjectVK {
+ public:
+  CachedDescriptorSetVK(std::shared_ptr<DescriptorSetPoolVK> pool,
+                        vk::DescriptorSet set);
+
+  // |SharedObjectVK|
+  ~CachedDescriptorSetVK() override;
+
+  vk::DescriptorSet Get() const { return set_; }
+
+ private:
+  std::shared_ptr<DescriptorSetPoolVK> pool_;
+  vk::DescriptorSet set_;
+
+  CachedDescriptorSetVK(const CachedDescriptorSetVK&) = delete;
+
+  CachedDescriptorSetVK& operator=(const CachedDescriptorSetVK&) = delete;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      A least recently used cache of fully written descriptor sets
+///             that persists across frames.
+///
+///             Unlike the per-frame sets handed out by |DescriptorPoolVK|,
+///             cached sets are allocated from a dedicated pool that is never
+///             reset. Draws that bind the same resources as in a previous
+///             frame can then skip both vkAllocateDescriptorSets and
+///             vkUpdateDescriptorSets.
+///
+///             This object is thread safe.
+///
+class DescriptorSetCacheVK {
+ public:
+  /// The maximum number of descriptor sets retained by the cache.
+  static constexpr size_t kMaxCachedSets = 1024u;
+
+  struct Statistics {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t entry_count = 0;
+  };
+
+  explicit DescriptorSetCacheVK(
+      std::weak_ptr<const DeviceHolder> device_holder,
+      size_t max_cached_sets = kMaxCachedSets);
+
+  ~DescriptorSetCacheVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Looks up a set with the same contents and marks it as most
+  ///             recently used. Entries with expired dependencies are evicted.
+  ///
+  /// @return     The set, or nullptr on a miss.
+  ///
+  std::shared_ptr<CachedDescriptorSetVK> Get(const DescriptorSetKeyVK& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Allocates a set with the layout of the key and caches it,
+  ///             evicting the least recently used set if the cache is full.
+  ///
+  ///             The caller must write the bindings described by the key to
+  ///             the set before it is used.
+  ///
+  /// @return     The set, or nullptr if the cache could not allocate one. The
+  ///             caller should fall back to a per-frame set in that case.
+  ///
+  std::shared_ptr<CachedDescriptorSetVK> Create(DescriptorSetKeyVK key);
+
+  void Clear();
+
+  Statistics GetStatistics() const;
+
+ private:
+  struct KeyHash {
+    size_t operator()(const DescriptorSetKeyVK* key) const {
+      return key->GetHash();
+    }
+  };
+
+  struct KeyEqual {
+    bool operator()(const DescriptorSetKeyVK* a,
+                    const DescriptorSetKeyVK* b) const {
+      return *a == *b;
+    }
+  };
+
+  using EntryList = std::list<
+      std::pair<DescriptorSetKeyVK, std::shared_ptr<CachedDescriptorSetVK>>>;
+
+  std::weak_ptr<const DeviceHolder> device_holder_;
+  const size_t max_cached_sets_;
+  mutable Mutex mutex_;
+  std::shared_ptr<DescriptorSetPoolVK> pool_ IPLR_GUARDED_BY(mutex_);
+  EntryList entries_ IPLR_GUARDED_BY(mutex_);
+  std::unordered_map<const DescriptorSetKeyVK*,
+                     EntryList::iterator,
+                     KeyHash,
+                     KeyEqual>
+      index_ IPLR_GUARDED_BY(mutex_);
+  Statistics statistics_ IPLR_GUARDED_BY(mutex_);
+
+  void Evict(EntryList::iterator entry) IPLR_REQUIRES(mutex_);
+
+  bool CreatePool() IPLR_REQUIRES(mutex_);
+
+  void ReportStatistics() const IPLR_REQUIRES(mutex_);
+
+  DescriptorSetCacheVK(const DescriptorSetCacheVK&) = delete;
+
+  DescriptorSetCacheVK& operator=(const DescriptorSetCacheVK&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_DESCRIPTOR_SET_CACHE_VK_H_
@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <string>
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep.
+#include "impeller/renderer/backend/vulkan/descriptor_set_cache_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+DescriptorSetKeyVK MakeKey(uint64_t buffer,
+                           const std::shared_ptr<const void>& dependency) {
+  DescriptorSetKeyVK key(vk::DescriptorSetLayout{});
+  key.AddBinding({
+      .binding = 0u,
+      .type = vk::DescriptorType::eUniformBuffer,
+      .resource = buffer,
+      .range = 64u,
+  });
+  key.AddDependency(dependency);
+  return key;
+}
+
+size_t CountCalls(const std::shared_ptr<ContextVK>& context,
+                  const std::string& name) {
+  auto const called = GetMockVulkanFunctions(context->GetDevice());
+  return std::count(called->begin(), called->end(), name);
+}
+
+}  // namespace
+
+TEST(DescriptorSetCacheVKTest, ReusesSetsWithTheSameBindings) {
+  auto const context = MockVulkanContextBuilder().Build();
+  auto const buffer = std::make_shared<int>(0);
+  {
+    DescriptorSetCacheVK cache(context->GetDeviceHolder());
+
+    EXPECT_EQ(cache.Get(MakeKey(1u, buffer)), nullptr);
+    auto const created = cache.Create(MakeKey(1u, buffer));
+    ASSERT_NE(created, nullptr);
+
+    EXPECT_EQ(cache.Get(MakeKey(1u, buffer)), created);
+    EXPECT_EQ(cache.Get(MakeKey(2u, buffer)), nullptr);
+
+    auto const statistics = cache.GetStatistics();
+    EXPECT_EQ(statistics.hits, 1u);
+    EXPECT_EQ(statistics.misses, 2u);
+    EXPECT_EQ(statistics.entry_count, 1u);
+    EXPECT_EQ(CountCalls(context, "vkAllocateDescriptorSets"), 1u);
+  }
+  context->Shutdown();
+}
+
+TEST(DescriptorSetCacheVKTest, EvictsSetsWithDestroyedDependencies) {
+  auto const context = MockVulkanContextBuilder().Build();
+  {
+    DescriptorSetCacheVK cache(context->GetDeviceHolder());
+
+    auto buffer = std::make_shared<int>(0);
+    ASSERT_NE(cache.Create(MakeKey(1u, buffer)), nullptr);
+    buffer.reset();
+
+    // A new resource may be given the handle of a destroyed one. The set
+    // written for the old resource must not be reused.
+    auto const new_buffer = std::make_shared<int>(0);
+    EXPECT_EQ(cache.Get(MakeKey(1u, new_buffer)), nullptr);
+    EXPECT_EQ(cache.GetStatistics().entry_count, 0u);
+    EXPECT_EQ(CountCalls(context, "vkFreeDescriptorSets"), 1u);
+  }
+  context->Shutdown();
+}
+
+TEST(DescriptorSetCacheVKTest, EvictsLeastRecentlyUsedSets) {
+  auto const context = MockVulkanContextBuilder().Build();
+  auto const buffer = std::make_shared<int>(0);
+  {
+    DescriptorSetCacheVK cache(context->GetDeviceHolder(), 2u);
+
+    ASSERT_NE(cache.Create(MakeKey(1u, buffer)), nullptr);
+    ASSERT_NE(cache.Create(MakeKey(2u, buffer)), nullptr);
+
+    // Keep the set that is about to be evicted referenced, as if a pending
+    // command buffer was still using it.
+    auto const second = cache.Get(MakeKey(2u, buffer));
+    ASSERT_NE(second, nullptr);
+    // Mark the first set as recently used.
+    ASSERT_NE(cache.Get(MakeKey(1u, buffer)), nullptr);
+    ASSERT_NE(cache.Create(MakeKey(3u, buffer)), nullptr);
+
+    EXPECT_EQ(cache.Get(MakeKey(2u, buffer)), nullptr);
+    EXPECT_NE(cache.Get(MakeKey(1u, buffer)), nullptr);
+    EXPECT_NE(cache.Get(MakeKey(3u, buffer)), nullptr);
+    EXPECT_EQ(CountCalls(context, "vkFreeDescriptorSets"), 0u);
+  }
+  // All sets are freed once neither the cache nor their users hold them.
+  EXPECT_EQ(CountCalls(context, "vkFreeDescriptorSets"), 3u);
+  context->Shutdown();
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -52,8 +52,10 @@ class WaitSetEntry {
   WaitSetEntry& operator=(WaitSetEntry&&) = delete;
 };
 
-FenceWaiterVK::FenceWaiterVK(std::weak_ptr<DeviceHolder> device_holder)
-    : device_holder_(std::move(device_holder)) {
+FenceWaiterVK::FenceWaiterVK(std::weak_ptr<DeviceHolder> device_holder,
+                             std::weak_ptr<ResourceManagerVK> resource_manager)
+    : device_holder_(std::move(device_holder)),
+      resource_manager_(std::move(resource_manager)) {
   waiter_thread_ = std::make_unique<std::thread>([&]() { Main(); });
 }
 
@@ -197,7 +199,14 @@ bool FenceWaiterVK::Wait() {
 
   {
     TRACE_EVENT0("impeller", "ClearSignaledFences");
-    // Erase the erased entries which will invoke callbacks.
+    // Erasing the entries invokes their callbacks, which may release
+    // thousands of tracked objects. Let the resource manager do that so that
+    // fences signaled in the meantime aren't kept waiting. If it is gone, the
+    // entries are erased right here.
+    for (auto& entry : erased_entries) {
+      UniqueResourceVKT<std::shared_ptr<WaitSetEntry>> reclaimed(
+          resource_manager_, std::move(entry));
+    }
     erased_entries.clear();  // Bit redundant because of scope but hey.
   }
 
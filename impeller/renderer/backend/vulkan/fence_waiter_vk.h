@@ -14,6 +14,7 @@
 #include "flutter/fml/macros.h"
 #include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
+#include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
 #include "impeller/renderer/backend/vulkan/shared_object_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 
@@ -24,6 +25,15 @@ class WaitSetEntry;
 
 using WaitSet = std::vector<std::shared_ptr<WaitSetEntry>>;
 
+//------------------------------------------------------------------------------
+/// @brief      Waits on fences on a dedicated thread, and invokes the callback
+///             of each fence once it is signaled.
+///
+///             All pending fences are waited on at once. The callbacks of the
+///             signaled fences, which usually release the resources of a
+///             command buffer, are handed to the resource manager so that
+///             the waiter thread can immediately go back to waiting.
+///
 class FenceWaiterVK {
  public:
   ~FenceWaiterVK();
@@ -38,13 +48,15 @@ class FenceWaiterVK {
   friend class ContextVK;
 
   std::weak_ptr<DeviceHolder> device_holder_;
+  std::weak_ptr<ResourceManagerVK> resource_manager_;
   std::unique_ptr<std::thread> waiter_thread_;
   std::mutex wait_set_mutex_;
   std::condition_variable wait_set_cv_;
   WaitSet wait_set_;
   bool terminate_ = false;
 
-  explicit FenceWaiterVK(std::weak_ptr<DeviceHolder> device_holder);
+  FenceWaiterVK(std::weak_ptr<DeviceHolder> device_holder,
+                std::weak_ptr<ResourceManagerVK> resource_manager);
 
   void Main();
 
@@ -165,6 +165,12 @@ constexpr vk::Format ToVKImageFormat(PixelFormat format) {
       return vk::Format::eR8Unorm;
     case PixelFormat::kR8G8UNormInt:
       return vk::Format::eR8G8Unorm;
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+      return vk::Format::eEtc2R8G8B8A8UnormBlock;
+    case PixelFormat::kASTC4x4UNormInt:
+      return vk::Format::eAstc4x4UnormBlock;
+    case PixelFormat::kBC7UNormInt:
+      return vk::Format::eBc7UnormBlock;
   }
 
   FML_UNREACHABLE();
@@ -196,6 +202,12 @@ constexpr PixelFormat ToPixelFormat(vk::Format format) {
       return PixelFormat::kR8UNormInt;
     case vk::Format::eR8G8Unorm:
       return PixelFormat::kR8G8UNormInt;
+    case vk::Format::eEtc2R8G8B8A8UnormBlock:
+      return PixelFormat::kETC2R8G8B8A8UNormInt;
+    case vk::Format::eAstc4x4UnormBlock:
+      return PixelFormat::kASTC4x4UNormInt;
+    case vk::Format::eBc7UnormBlock:
+      return PixelFormat::kBC7UNormInt;
     default:
       return PixelFormat::kUnknown;
   }
@@ -272,7 +284,9 @@ constexpr vk::DescriptorType ToVKDescriptorType(DescriptorType type) {
       return vk::DescriptorType::eCombinedImageSampler;
       break;
     case DescriptorType::kUniformBuffer:
-      return vk::DescriptorType::eUniformBuffer;
+      // Uniforms are suballocated from a few large host buffers. Binding them
+      // with dynamic offsets lets commands share descriptor sets.
+      return vk::DescriptorType::eUniformBufferDynamic;
       break;
     case DescriptorType::kStorageBuffer:
       return vk::DescriptorType::eStorageBuffer;
@@ -385,6 +399,9 @@ constexpr bool PixelFormatIsDepthStencil(PixelFormat format) {
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kBC7UNormInt:
       return false;
     case PixelFormat::kS8UInt:
     case PixelFormat::kD24UnormS8Uint:
@@ -416,6 +433,9 @@ constexpr AttachmentKind AttachmentKindFromFormat(PixelFormat format) {
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kBC7UNormInt:
       return AttachmentKind::kColor;
     case PixelFormat::kS8UInt:
       return AttachmentKind::kStencil;
@@ -493,6 +513,21 @@ constexpr vk::AttachmentDescription CreateAttachmentDescription(
 static constexpr vk::AttachmentReference kUnusedAttachmentReference = {
     VK_ATTACHMENT_UNUSED, vk::ImageLayout::eUndefined};
 
+/// The self-dependency of a subpass that reads its own color attachment as an
+/// input attachment. Pipeline barriers recorded within the subpass must be a
+/// subset of this dependency.
+constexpr vk::SubpassDependency CreateFramebufferFetchSelfDependency() {
+  vk::SubpassDependency dependency;
+  dependency.srcSubpass = 0u;
+  dependency.dstSubpass = 0u;
+  dependency.srcStageMask = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+  dependency.dstStageMask = vk::PipelineStageFlagBits::eFragmentShader;
+  dependency.srcAccessMask = vk::AccessFlagBits::eColorAttachmentWrite;
+  dependency.dstAccessMask = vk::AccessFlagBits::eInputAttachmentRead;
+  dependency.dependencyFlags = vk::DependencyFlagBits::eByRegion;
+  return dependency;
+}
+
 constexpr vk::CullModeFlags ToVKCullModeFlags(CullMode mode) {
   switch (mode) {
     case CullMode::kNone:
@@ -580,6 +615,9 @@ constexpr vk::ImageAspectFlags ToVKImageAspectFlags(PixelFormat format) {
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kBC7UNormInt:
       return vk::ImageAspectFlagBits::eColor;
     case PixelFormat::kS8UInt:
       return vk::ImageAspectFlagBits::eStencil;
@@ -654,6 +692,9 @@ constexpr vk::ImageAspectFlags ToImageAspectFlags(PixelFormat format) {
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kBC7UNormInt:
       return vk::ImageAspectFlagBits::eColor;
     case PixelFormat::kS8UInt:
       return vk::ImageAspectFlagBits::eStencil;
@@ -18,6 +18,15 @@ namespace impeller {
 
 static constexpr uint32_t kPoolSize = 1024u;
 
+// The statistics counted by each pipeline statistics query. Their results are
+// written in the order of the bits of the flags.
+static constexpr vk::QueryPipelineStatisticFlags kPipelineStatistics =
+    vk::QueryPipelineStatisticFlagBits::eVertexShaderInvocations |
+    vk::QueryPipelineStatisticFlagBits::eClippingInvocations |
+    vk::QueryPipelineStatisticFlagBits::eClippingPrimitives |
+    vk::QueryPipelineStatisticFlagBits::eFragmentShaderInvocations;
+static constexpr size_t kPipelineStatisticsCount = 4u;
+
 GPUTracerVK::GPUTracerVK(const std::shared_ptr<DeviceHolder>& device_holder)
     : device_holder_(device_holder) {
   timestamp_period_ = device_holder_->GetPhysicalDevice()
@@ -30,6 +39,9 @@ GPUTracerVK::GPUTracerVK(const std::shared_ptr<DeviceHolder>& device_holder)
   // Disable tracing in release mode.
 #ifdef IMPELLER_DEBUG
   enabled_ = true;
+  pipeline_statistics_enabled_ = !!device_holder_->GetPhysicalDevice()
+                                       .getFeatures()
+                                       .pipelineStatisticsQuery;
 #endif
 }
 
@@ -37,6 +49,23 @@ bool GPUTracerVK::IsEnabled() const {
   return enabled_;
 }
 
+std::optional<fml::TimeDelta> GPUTracerVK::GetLastFrameTime() const {
+  Lock lock(trace_state_mutex_);
+  return last_frame_time_;
+}
+
+std::optional<DrawCategoryTimes> GPUTracerVK::GetLastFrameCategoryTimes()
+    const {
+  Lock lock(trace_state_mutex_);
+  return last_frame_category_times_;
+}
+
+std::optional<PipelineStatistics> GPUTracerVK::GetLastFramePipelineStatistics()
+    const {
+  Lock lock(trace_state_mutex_);
+  return last_frame_pipeline_statistics_;
+}
+
 void GPUTracerVK::MarkFrameStart() {
   FML_DCHECK(!in_frame_);
   in_frame_ = true;
@@ -61,6 +90,8 @@ void GPUTracerVK::MarkFrameEnd() {
 
   state.pending_buffers = 0;
   state.current_index = 0;
+  state.category_spans.clear();
+  state.statistics_index = 0;
   in_frame_ = false;
 }
 
@@ -77,21 +108,9 @@ void GPUTracerVK::RecordCmdBufferStart(const vk::CommandBuffer& buffer,
   Lock lock(trace_state_mutex_);
   auto& state = trace_states_[current_state_];
 
-  // Initialize the query pool for the first query on each frame.
-  if (state.pending_buffers == 0) {
-    vk::QueryPoolCreateInfo info;
-    info.queryCount = kPoolSize;
-    info.queryType = vk::QueryType::eTimestamp;
-
-    auto [status, pool] =
-        device_holder_->GetDevice().createQueryPoolUnique(info);
-    if (status != vk::Result::eSuccess) {
-      VALIDATION_LOG << "Failed to create query pool.";
-      return;
-    }
-    trace_states_[current_state_].query_pool = std::move(pool);
-    buffer.resetQueryPool(trace_states_[current_state_].query_pool.get(), 0,
-                          kPoolSize);
+  // Initialize the query pools for the first query on each frame.
+  if (state.pending_buffers == 0 && !ResetQueryPools(buffer, state)) {
+    return;
   }
 
   // We size the query pool to kPoolSize, but Flutter applications can create an
@@ -109,10 +128,62 @@ void GPUTracerVK::RecordCmdBufferStart(const vk::CommandBuffer& buffer,
     state.pending_buffers += 1;
     probe.index_ = current_state_;
   }
+
+  if (state.statistics_query_pool && state.statistics_index < kPoolSize &&
+      !probe.statistics_index_.has_value()) {
+    buffer.beginQuery(state.statistics_query_pool.get(),
+                      state.statistics_index, {});
+    probe.statistics_index_ = state.statistics_index;
+    state.statistics_index += 1;
+  }
+}
+
+bool GPUTracerVK::ResetQueryPools(const vk::CommandBuffer& buffer,
+                                  GPUTraceState& state) {
+  vk::QueryPoolCreateInfo info;
+  info.queryCount = kPoolSize;
+  info.queryType = vk::QueryType::eTimestamp;
+
+  auto [status, pool] = device_holder_->GetDevice().createQueryPoolUnique(info);
+  if (status != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Failed to create query pool.";
+    return false;
+  }
+  state.query_pool = std::move(pool);
+  buffer.resetQueryPool(state.query_pool.get(), 0, kPoolSize);
+
+  state.statistics_query_pool.reset();
+  if (!pipeline_statistics_enabled_) {
+    return true;
+  }
+  vk::QueryPoolCreateInfo statistics_info;
+  statistics_info.queryCount = kPoolSize;
+  statistics_info.queryType = vk::QueryType::ePipelineStatistics;
+  statistics_info.pipelineStatistics = kPipelineStatistics;
+
+  auto [statistics_status, statistics_pool] =
+      device_holder_->GetDevice().createQueryPoolUnique(statistics_info);
+  if (statistics_status != vk::Result::eSuccess) {
+    // The frame time can still be measured without the statistics.
+    VALIDATION_LOG << "Failed to create pipeline statistics query pool.";
+    return true;
+  }
+  state.statistics_query_pool = std::move(statistics_pool);
+  buffer.resetQueryPool(state.statistics_query_pool.get(), 0, kPoolSize);
+  return true;
 }
 
 void GPUTracerVK::RecordCmdBufferEnd(const vk::CommandBuffer& buffer,
                                      GPUProbe& probe) {
+  // The pipeline statistics query must end within the cmd buffer it began in,
+  // even if the frame ended in the meantime.
+  if (probe.statistics_index_.has_value() && probe.index_.has_value()) {
+    Lock lock(trace_state_mutex_);
+    buffer.endQuery(
+        trace_states_[probe.index_.value()].statistics_query_pool.get(),
+        probe.statistics_index_.value());
+  }
+
   if (!enabled_ || std::this_thread::get_id() != raster_thread_id_ ||
       !in_frame_) {
     return;
@@ -134,6 +205,41 @@ void GPUTracerVK::RecordCmdBufferEnd(const vk::CommandBuffer& buffer,
   }
 }
 
+void GPUTracerVK::RecordDrawCategory(const vk::CommandBuffer& buffer,
+                                     GPUProbe& probe,
+                                     std::optional<DrawCategory> category) {
+  if (!enabled_ || std::this_thread::get_id() != raster_thread_id_ ||
+      !in_frame_) {
+    return;
+  }
+  Lock lock(trace_state_mutex_);
+  // Only cmd buffers started in this frame have a query pool to write to.
+  if (probe.index_ != current_state_) {
+    return;
+  }
+  GPUTraceState& state = trace_states_[current_state_];
+
+  if (state.current_index >= kPoolSize) {
+    probe.span_start_index_ = std::nullopt;
+    return;
+  }
+
+  buffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe,
+                        state.query_pool.get(), state.current_index);
+  if (probe.span_start_index_.has_value()) {
+    state.category_spans.push_back(
+        CategorySpan{.start_index = probe.span_start_index_.value(),
+                     .end_index = state.current_index,
+                     .category = probe.span_category_});
+  }
+  probe.span_start_index_ = std::nullopt;
+  if (category.has_value()) {
+    probe.span_start_index_ = state.current_index;
+    probe.span_category_ = category.value();
+  }
+  state.current_index += 1;
+}
+
 void GPUTracerVK::OnFenceComplete(size_t frame_index) {
   if (!enabled_) {
     return;
@@ -145,6 +251,8 @@ void GPUTracerVK::OnFenceComplete(size_t frame_index) {
   state.pending_buffers -= 1;
 
   if (state.pending_buffers == 0) {
+    ReadPipelineStatistics(state);
+
     auto buffer_count = state.current_index;
     std::vector<uint64_t> bits(buffer_count);
 
@@ -173,10 +281,76 @@ void GPUTracerVK::OnFenceComplete(size_t frame_index) {
     auto gpu_ms =
         (((largest_timestamp - smallest_timestamp) * timestamp_period_) /
          1000000);
+    last_frame_time_ = fml::TimeDelta::FromMillisecondsF(gpu_ms);
     FML_TRACE_COUNTER("flutter", "GPUTracer",
                       reinterpret_cast<int64_t>(this),  // Trace Counter ID
                       "FrameTimeMS", gpu_ms);
+
+    if (state.category_spans.empty()) {
+      return;
+    }
+    // The timestamps are written after the draws before them complete, so
+    // the time between two timestamps approximates the cost of the draws
+    // between them.
+    DrawCategoryTimes category_times = {};
+    for (const auto& span : state.category_spans) {
+      auto span_ticks = bits[span.end_index] - bits[span.start_index];
+      auto span_ms = (span_ticks * timestamp_period_) / 1000000;
+      auto& category_time = category_times[static_cast<size_t>(span.category)];
+      category_time =
+          category_time + fml::TimeDelta::FromMillisecondsF(span_ms);
+    }
+    last_frame_category_times_ = category_times;
+    auto category_ms = [&category_times](DrawCategory category) {
+      return category_times[static_cast<size_t>(category)].ToMillisecondsF();
+    };
+    FML_TRACE_COUNTER(
+        "flutter", "GPUTracerCategories",
+        reinterpret_cast<int64_t>(this) + 1,  // Trace Counter ID
+        DrawCategoryToString(DrawCategory::kText),
+        category_ms(DrawCategory::kText),
+        DrawCategoryToString(DrawCategory::kBlur),
+        category_ms(DrawCategory::kBlur),
+        DrawCategoryToString(DrawCategory::kGradient),
+        category_ms(DrawCategory::kGradient),
+        DrawCategoryToString(DrawCategory::kRuntimeEffect),
+        category_ms(DrawCategory::kRuntimeEffect),
+        DrawCategoryToString(DrawCategory::kClip),
+        category_ms(DrawCategory::kClip),
+        DrawCategoryToString(DrawCategory::kOther),
+        category_ms(DrawCategory::kOther));
+  }
+}
+
+void GPUTracerVK::ReadPipelineStatistics(const GPUTraceState& state) {
+  if (!state.statistics_query_pool || state.statistics_index == 0u) {
+    return;
+  }
+  std::vector<uint64_t> results(state.statistics_index *
+                                kPipelineStatisticsCount);
+  auto result = device_holder_->GetDevice().getQueryPoolResults(
+      state.statistics_query_pool.get(), 0, state.statistics_index,
+      results.size() * sizeof(uint64_t), results.data(),
+      kPipelineStatisticsCount * sizeof(uint64_t),
+      vk::QueryResultFlagBits::e64);
+  // As with the timestamps, drop the statistics of frames whose queries
+  // aren't available.
+  if (result != vk::Result::eSuccess) {
+    return;
   }
+
+  PipelineStatistics statistics;
+  for (auto i = 0u; i < results.size(); i += kPipelineStatisticsCount) {
+    statistics += {.vertex_invocations = results[i],
+                   .clipping_invocations = results[i + 1],
+                   .clipping_primitives = results[i + 2],
+                   .fragment_invocations = results[i + 3]};
+  }
+  last_frame_pipeline_statistics_ = statistics;
+  FML_TRACE_COUNTER("flutter", "GPUTracerPipelineStatistics",
+                    reinterpret_cast<int64_t>(this) + 2,  // Trace Counter ID
+                    "VertexInvocations", statistics.vertex_invocations,
+                    "FragmentInvocations", statistics.fragment_invocations);
 }
 
 GPUProbe::GPUProbe(const std::weak_ptr<GPUTracerVK>& tracer)
@@ -209,4 +383,13 @@ void GPUProbe::RecordCmdBufferEnd(const vk::CommandBuffer& buffer) {
   tracer->RecordCmdBufferEnd(buffer, *this);
 }
 
+void GPUProbe::RecordDrawCategory(const vk::CommandBuffer& buffer,
+                                  std::optional<DrawCategory> category) {
+  auto tracer = tracer_.lock();
+  if (!tracer) {
+    return;
+  }
+  tracer->RecordDrawCategory(buffer, *this, category);
+}
+
 }  // namespace impeller
@@ -3,10 +3,15 @@
 // found in the LICENSE file.
 
 #include <memory>
+#include <optional>
 #include <thread>
 
+#include "flutter/fml/time/time_delta.h"
+
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
+#include "impeller/renderer/draw_category.h"
+#include "impeller/renderer/gpu_statistics.h"
 #include "vulkan/vulkan_handles.hpp"
 
 namespace impeller {
@@ -14,7 +19,8 @@ namespace impeller {
 class GPUProbe;
 
 /// @brief A class that uses timestamp queries to record the approximate GPU
-/// execution time.
+/// execution time, and pipeline statistics queries to count the shader
+/// invocations of a frame when the device supports them.
 class GPUTracerVK : public std::enable_shared_from_this<GPUTracerVK> {
  public:
   explicit GPUTracerVK(const std::shared_ptr<DeviceHolder>& device_holder);
@@ -37,6 +43,17 @@ class GPUTracerVK : public std::enable_shared_from_this<GPUTracerVK> {
   // visible for testing.
   bool IsEnabled() const;
 
+  /// @brief The GPU time of the most recently measured frame, if any.
+  std::optional<fml::TimeDelta> GetLastFrameTime() const;
+
+  /// @brief The GPU time of the most recently measured frame spent on the
+  ///        draws of each category, if any.
+  std::optional<DrawCategoryTimes> GetLastFrameCategoryTimes() const;
+
+  /// @brief The pipeline statistics of the most recently measured frame, if
+  ///        any.
+  std::optional<PipelineStatistics> GetLastFramePipelineStatistics() const;
+
  private:
   friend class GPUProbe;
 
@@ -55,18 +72,51 @@ class GPUTracerVK : public std::enable_shared_from_this<GPUTracerVK> {
   ///        time.
   void RecordCmdBufferEnd(const vk::CommandBuffer& buffer, GPUProbe& probe);
 
+  /// @brief Record a timestamp query into the provided cmd buffer that ends
+  ///        the draws of the previous category, if any, and starts the draws
+  ///        of [category].
+  void RecordDrawCategory(const vk::CommandBuffer& buffer,
+                          GPUProbe& probe,
+                          std::optional<DrawCategory> category);
+
   const std::shared_ptr<DeviceHolder> device_holder_;
 
+  /// The timestamp queries delimiting consecutive draws of one category.
+  struct CategorySpan {
+    size_t start_index;
+    size_t end_index;
+    DrawCategory category;
+  };
+
   struct GPUTraceState {
     size_t current_index = 0;
     size_t pending_buffers = 0;
     vk::UniqueQueryPool query_pool;
+    std::vector<CategorySpan> category_spans;
+    // One pipeline statistics query spans each cmd buffer of the frame.
+    size_t statistics_index = 0;
+    vk::UniqueQueryPool statistics_query_pool;
   };
 
+  /// @brief Create the query pools of the current trace state and reset them
+  ///        in the provided cmd buffer.
+  bool ResetQueryPools(const vk::CommandBuffer& buffer, GPUTraceState& state)
+      IPLR_REQUIRES(trace_state_mutex_);
+
+  /// @brief Sum the pipeline statistics queries of a completed trace state.
+  void ReadPipelineStatistics(const GPUTraceState& state)
+      IPLR_REQUIRES(trace_state_mutex_);
+
   mutable Mutex trace_state_mutex_;
   GPUTraceState trace_states_[kTraceStatesSize] IPLR_GUARDED_BY(
       trace_state_mutex_);
   size_t current_state_ IPLR_GUARDED_BY(trace_state_mutex_) = 0u;
+  std::optional<fml::TimeDelta> last_frame_time_ IPLR_GUARDED_BY(
+      trace_state_mutex_);
+  std::optional<DrawCategoryTimes> last_frame_category_times_ IPLR_GUARDED_BY(
+      trace_state_mutex_);
+  std::optional<PipelineStatistics> last_frame_pipeline_statistics_
+      IPLR_GUARDED_BY(trace_state_mutex_);
 
   // The number of nanoseconds for each timestamp unit.
   float timestamp_period_ = 1;
@@ -84,6 +134,8 @@ class GPUTracerVK : public std::enable_shared_from_this<GPUTracerVK> {
   // that are not guaranteed to start/end according to frame boundaries.
   std::thread::id raster_thread_id_;
   bool enabled_ = false;
+  // Whether the device enabled the pipelineStatisticsQuery feature.
+  bool pipeline_statistics_enabled_ = false;
 };
 
 class GPUProbe {
@@ -103,11 +155,23 @@ class GPUProbe {
   ///        time.
   void RecordCmdBufferEnd(const vk::CommandBuffer& buffer);
 
+  /// @brief Record a timestamp query into the provided cmd buffer that
+  ///        attributes the following draws to [category], or ends the
+  ///        attribution if [category] is std::nullopt. Only valid inside a
+  ///        render pass.
+  void RecordDrawCategory(const vk::CommandBuffer& buffer,
+                          std::optional<DrawCategory> category);
+
  private:
   friend class GPUTracerVK;
 
   std::weak_ptr<GPUTracerVK> tracer_;
   std::optional<size_t> index_ = std::nullopt;
+  // The pipeline statistics query active in the cmd buffer, if any.
+  std::optional<size_t> statistics_index_ = std::nullopt;
+  // The query starting the current span of draws, and their category.
+  std::optional<size_t> span_start_index_ = std::nullopt;
+  DrawCategory span_category_ = DrawCategory::kOther;
 };
 
 }  // namespace impeller
@@ -34,6 +34,8 @@ class PipelineCacheVK {
 
   void PersistCacheToDisk() const;
 
+  const fml::UniqueFD& GetCacheDirectory() const { return cache_directory_; }
+
  private:
   const std::shared_ptr<const Capabilities> caps_;
   std::weak_ptr<DeviceHolder> device_holder_;
@@ -14,6 +14,7 @@
 #include "impeller/base/promise.h"
 #include "impeller/base/timing.h"
 #include "impeller/base/validation.h"
+#include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
 #include "impeller/renderer/backend/vulkan/pipeline_vk.h"
@@ -31,9 +32,13 @@ PipelineLibraryVK::PipelineLibraryVK(
     std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner)
     : device_holder_(device_holder),
       supports_framebuffer_fetch_(caps->SupportsFramebufferFetch()),
+      supports_rasterization_order_attachment_access_(
+          CapabilitiesVK::Cast(*caps)
+              .SupportsRasterizationOrderAttachmentAccess()),
       pso_cache_(std::make_shared<PipelineCacheVK>(std::move(caps),
                                                    device_holder,
                                                    std::move(cache_directory))),
+      manifest_(std::make_shared<PipelineManifestVK>()),
       worker_task_runner_(std::move(worker_task_runner)) {
   FML_DCHECK(worker_task_runner_);
   if (!pso_cache_->IsValid() || !worker_task_runner_) {
@@ -83,7 +88,8 @@ static vk::AttachmentDescription CreatePlaceholderAttachmentDescription(
 static vk::UniqueRenderPass CreateCompatRenderPassForPipeline(
     const vk::Device& device,
     const PipelineDescriptor& desc,
-    bool supports_framebuffer_fetch) {
+    bool supports_framebuffer_fetch,
+    bool supports_rasterization_order_attachment_access) {
   std::vector<vk::AttachmentDescription> attachments;
 
   std::vector<vk::AttachmentReference> color_refs;
@@ -125,14 +131,19 @@ static vk::UniqueRenderPass CreateCompatRenderPassForPipeline(
   subpass_desc.pipelineBindPoint = vk::PipelineBindPoint::eGraphics;
 
   // If the device supports framebuffer fetch, compatibility pipelines are
-  // always created with the self reference and rasterization order flag. This
-  // ensures that all compiled pipelines are compatible with a render pass that
-  // contains a framebuffer fetch shader (advanced blends).
+  // always created with the self reference and either the rasterization order
+  // flag or the self-dependency used in its absence. This ensures that all
+  // compiled pipelines are compatible with a render pass that contains a
+  // framebuffer fetch shader (advanced blends).
   std::vector<vk::SubpassDependency> subpass_dependencies;
   if (supports_framebuffer_fetch) {
-    subpass_desc.setFlags(vk::SubpassDescriptionFlagBits::
-                              eRasterizationOrderAttachmentColorAccessARM);
     subpass_desc.setInputAttachments(subpass_color_ref);
+    if (supports_rasterization_order_attachment_access) {
+      subpass_desc.setFlags(vk::SubpassDescriptionFlagBits::
+                                eRasterizationOrderAttachmentColorAccessARM);
+    } else {
+      subpass_dependencies.push_back(CreateFramebufferFetchSelfDependency());
+    }
   }
   subpass_desc.setColorAttachments(color_refs);
   subpass_desc.setPDepthStencilAttachment(&depth_stencil_ref);
@@ -389,7 +400,8 @@ std::unique_ptr<PipelineVK> PipelineLibraryVK::CreatePipeline(
   }
 
   auto render_pass = CreateCompatRenderPassForPipeline(
-      strong_device->GetDevice(), desc, supports_framebuffer_fetch_);
+      strong_device->GetDevice(), desc, supports_framebuffer_fetch_,
+      supports_rasterization_order_attachment_access_);
   if (render_pass) {
     pipeline_info.setBasePipelineHandle(VK_NULL_HANDLE);
     pipeline_info.setSubpass(0);
@@ -653,13 +665,25 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryVK::GetPipeline(
       return;
     }
 
-    auto pipeline = PipelineLibraryVK::Cast(*thiz).CreatePipeline(descriptor);
+    auto& library = PipelineLibraryVK::Cast(*thiz);
+    auto key = PipelineManifestVK::CreateKey(descriptor);
+    if (key.has_value()) {
+      if (auto pipeline = library.TakeWarmPipeline(*key, descriptor)) {
+        promise->set_value(std::move(pipeline));
+        return;
+      }
+    }
+
+    auto pipeline = library.CreatePipeline(descriptor);
     if (!pipeline) {
       promise->set_value(nullptr);
       VALIDATION_LOG << "Could not create pipeline: " << descriptor.GetLabel();
       return;
     }
 
+    if (key.has_value()) {
+      library.manifest_->AddKey(std::move(*key));
+    }
     promise->set_value(std::move(pipeline));
   });
 
@@ -724,6 +748,81 @@ void PipelineLibraryVK::RemovePipelinesWithEntryPoint(
   });
 }
 
+void PipelineLibraryVK::WarmUpPipelines(ShaderLibrary& shader_library) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  auto keys = manifest_->Load(pso_cache_->GetCacheDirectory());
+  for (auto& key : keys) {
+    // Entries may refer to shaders that are no longer part of the application
+    // or that are only registered at runtime.
+    auto desc = PipelineManifestVK::CreateDescriptor(key, shader_library);
+    if (!desc.has_value()) {
+      manifest_->RemoveKey(key);
+      continue;
+    }
+    worker_task_runner_->PostTask(
+        [weak_this = weak_from_this(), key = std::move(key),
+         desc = std::move(desc.value())]() {
+          auto thiz = weak_this.lock();
+          if (!thiz) {
+            return;
+          }
+          PipelineLibraryVK::Cast(*thiz).WarmUpPipeline(key, desc);
+        },
+        fml::ConcurrentTaskPriority::kBackground);
+  }
+}
+
+void PipelineLibraryVK::WarmUpPipeline(const std::string& key,
+                                       const PipelineDescriptor& desc) {
+  {
+    Lock lock(warm_pipelines_mutex_);
+    if (claimed_keys_.count(key) > 0u) {
+      return;
+    }
+  }
+
+  auto pipeline = CreatePipeline(desc);
+  if (!pipeline) {
+    manifest_->RemoveKey(key);
+    return;
+  }
+
+  Lock lock(warm_pipelines_mutex_);
+  if (claimed_keys_.count(key) > 0u) {
+    return;
+  }
+  warm_pipelines_[key] = std::move(pipeline);
+}
+
+std::unique_ptr<PipelineVK> PipelineLibraryVK::TakeWarmPipeline(
+    const std::string& key,
+    const PipelineDescriptor& desc) {
+  std::unique_ptr<PipelineVK> warm_pipeline;
+  {
+    Lock lock(warm_pipelines_mutex_);
+    auto found = warm_pipelines_.find(key);
+    if (found == warm_pipelines_.end()) {
+      claimed_keys_.insert(key);
+      return nullptr;
+    }
+    warm_pipeline = std::move(found->second);
+    warm_pipelines_.erase(found);
+  }
+
+  // The warm pipeline was created from a descriptor recreated from the
+  // manifest. Move its objects over to a pipeline with the descriptor that
+  // was actually requested, so that variants derived from it match.
+  return std::make_unique<PipelineVK>(
+      device_holder_,                                   //
+      weak_from_this(),                                 //
+      desc,                                             //
+      std::move(warm_pipeline->pipeline_),              //
+      std::move(warm_pipeline->render_pass_),           //
+      std::move(warm_pipeline->layout_),                //
+      std::move(warm_pipeline->descriptor_set_layout_)  //
+  );
+}
+
 void PipelineLibraryVK::DidAcquireSurfaceFrame() {
   if (++frames_acquired_ == 50u) {
     PersistPipelineCacheToDisk();
@@ -732,13 +831,18 @@ void PipelineLibraryVK::DidAcquireSurfaceFrame() {
 
 void PipelineLibraryVK::PersistPipelineCacheToDisk() {
   worker_task_runner_->PostTask(
-      [weak_cache = decltype(pso_cache_)::weak_type(pso_cache_)]() {
+      [weak_cache = decltype(pso_cache_)::weak_type(pso_cache_),
+       weak_manifest = decltype(manifest_)::weak_type(manifest_)]() {
         auto cache = weak_cache.lock();
         if (!cache) {
           return;
         }
         cache->PersistCacheToDisk();
-      });
+        if (auto manifest = weak_manifest.lock()) {
+          manifest->Persist(cache->GetCacheDirectory());
+        }
+      },
+      fml::ConcurrentTaskPriority::kBackground);
 }
 
 }  // namespace impeller
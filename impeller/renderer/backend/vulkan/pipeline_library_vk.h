@@ -6,6 +6,9 @@
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_PIPELINE_LIBRARY_VK_H_
 
 #include <atomic>
+#include <set>
+#include <string>
+#include <unordered_map>
 
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
@@ -15,6 +18,7 @@
 #include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/compute_pipeline_vk.h"
 #include "impeller/renderer/backend/vulkan/pipeline_cache_vk.h"
+#include "impeller/renderer/backend/vulkan/pipeline_manifest_vk.h"
 #include "impeller/renderer/backend/vulkan/pipeline_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 #include "impeller/renderer/pipeline_library.h"
@@ -37,13 +41,19 @@ class PipelineLibraryVK final
 
   std::weak_ptr<DeviceHolder> device_holder_;
   bool supports_framebuffer_fetch_ = false;
+  bool supports_rasterization_order_attachment_access_ = false;
   std::shared_ptr<PipelineCacheVK> pso_cache_;
+  std::shared_ptr<PipelineManifestVK> manifest_;
   std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
   Mutex pipelines_mutex_;
   PipelineMap pipelines_ IPLR_GUARDED_BY(pipelines_mutex_);
   Mutex compute_pipelines_mutex_;
   ComputePipelineMap compute_pipelines_
       IPLR_GUARDED_BY(compute_pipelines_mutex_);
+  Mutex warm_pipelines_mutex_;
+  std::unordered_map<std::string, std::unique_ptr<PipelineVK>> warm_pipelines_
+      IPLR_GUARDED_BY(warm_pipelines_mutex_);
+  std::set<std::string> claimed_keys_ IPLR_GUARDED_BY(warm_pipelines_mutex_);
   std::atomic_size_t frames_acquired_ = 0u;
   bool is_valid_ = false;
 
@@ -73,6 +83,23 @@ class PipelineLibraryVK final
   std::unique_ptr<ComputePipelineVK> CreateComputePipeline(
       const ComputePipelineDescriptor& desc);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the pipelines recorded in the manifest of previous
+  ///             sessions on the worker task runner, so that they are ready
+  ///             by the time they are first requested.
+  ///
+  void WarmUpPipelines(ShaderLibrary& shader_library);
+
+  void WarmUpPipeline(const std::string& key, const PipelineDescriptor& desc);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Takes the pipeline created during the warm up for the key, if
+  ///             any. Otherwise, marks the key as claimed so that a pipeline
+  ///             still being warmed up for it is discarded.
+  ///
+  std::unique_ptr<PipelineVK> TakeWarmPipeline(const std::string& key,
+                                               const PipelineDescriptor& desc);
+
   void PersistPipelineCacheToDisk();
 
   PipelineLibraryVK(const PipelineLibraryVK&) = delete;
@@ -0,0 +1,496 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/pipeline_manifest_vk.h"
+
+#include <cctype>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "impeller/base/validation.h"
+#include "impeller/renderer/shader_function.h"
+#include "impeller/renderer/vertex_descriptor.h"
+
+namespace impeller {
+
+static constexpr const char* kPipelineManifestFileName =
+    "flutter.impeller.vkpipelines";
+
+/// Must be updated whenever the format of the keys changes so that manifests
+/// written by older versions are discarded.
+static constexpr const char* kPipelineManifestHeader =
+    "impeller-vk-pipeline-manifest-1";
+
+/// Bounds the number of elements read for any list in a key so that a corrupt
+/// manifest can't cause large allocations.
+static constexpr uint64_t kMaxListSize = 64u;
+
+template <class T>
+static uint64_t ToInt(T value) {
+  return static_cast<uint64_t>(value);
+}
+
+static bool IsValidToken(const std::string& token) {
+  if (token.empty()) {
+    return false;
+  }
+  for (auto c : token) {
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void WriteStencil(
+    std::ostream& stream,
+    const std::optional<StencilAttachmentDescriptor>& desc) {
+  stream << " S " << desc.has_value();
+  if (desc.has_value()) {
+    stream << ' ' << ToInt(desc->stencil_compare) << ' '
+           << ToInt(desc->stencil_failure) << ' '
+           << ToInt(desc->depth_failure) << ' '
+           << ToInt(desc->depth_stencil_pass) << ' ' << desc->read_mask << ' '
+           << desc->write_mask;
+  }
+}
+
+std::optional<std::string> PipelineManifestVK::CreateKey(
+    const PipelineDescriptor& desc) {
+  const auto& vertex_descriptor = desc.GetVertexDescriptor();
+  if (!vertex_descriptor ||
+      desc.GetLabel().find('\n') != std::string::npos) {
+    return std::nullopt;
+  }
+
+  std::ostringstream stream;
+  stream << ToInt(desc.GetSampleCount()) << ' '
+         << ToInt(desc.GetWindingOrder()) << ' ' << ToInt(desc.GetCullMode())
+         << ' ' << ToInt(desc.GetPrimitiveType()) << ' '
+         << ToInt(desc.GetPolygonMode()) << ' ' << desc.UsesSubpassInput()
+         << ' ' << ToInt(desc.GetDepthPixelFormat()) << ' '
+         << ToInt(desc.GetStencilPixelFormat());
+
+  stream << " E " << desc.GetStageEntrypoints().size();
+  for (const auto& [stage, function] : desc.GetStageEntrypoints()) {
+    if (!function || !IsValidToken(function->GetName())) {
+      return std::nullopt;
+    }
+    stream << ' ' << ToInt(stage) << ' ' << function->GetName();
+  }
+
+  stream << " C " << desc.GetColorAttachmentDescriptors().size();
+  for (const auto& [index, color] : desc.GetColorAttachmentDescriptors()) {
+    stream << ' ' << index << ' ' << ToInt(color.format) << ' '
+           << color.blending_enabled << ' '
+           << ToInt(color.src_color_blend_factor) << ' '
+           << ToInt(color.color_blend_op) << ' '
+           << ToInt(color.dst_color_blend_factor) << ' '
+           << ToInt(color.src_alpha_blend_factor) << ' '
+           << ToInt(color.alpha_blend_op) << ' '
+           << ToInt(color.dst_alpha_blend_factor) << ' ' << color.write_mask;
+  }
+
+  const auto depth = desc.GetDepthStencilAttachmentDescriptor();
+  stream << " D " << depth.has_value();
+  if (depth.has_value()) {
+    stream << ' ' << ToInt(depth->depth_compare) << ' '
+           << depth->depth_write_enabled;
+  }
+  WriteStencil(stream, desc.GetFrontStencilAttachmentDescriptor());
+  WriteStencil(stream, desc.GetBackStencilAttachmentDescriptor());
+
+  // Constants are written as their bit patterns so that they round trip
+  // exactly.
+  stream << " K " << desc.GetSpecializationConstants().size();
+  for (auto constant : desc.GetSpecializationConstants()) {
+    uint32_t bits = 0u;
+    static_assert(sizeof(bits) == sizeof(constant));
+    std::memcpy(&bits, &constant, sizeof(bits));
+    stream << ' ' << bits;
+  }
+
+  stream << " V " << vertex_descriptor->GetStageInputs().size();
+  for (const auto& input : vertex_descriptor->GetStageInputs()) {
+    stream << ' ' << input.location << ' ' << input.set << ' '
+           << input.binding << ' ' << ToInt(input.type) << ' '
+           << input.bit_width << ' ' << input.vec_size << ' ' << input.columns
+           << ' ' << input.offset;
+  }
+  stream << ' ' << vertex_descriptor->GetStageLayouts().size();
+  for (const auto& layout : vertex_descriptor->GetStageLayouts()) {
+    stream << ' ' << layout.stride << ' ' << layout.binding;
+  }
+  stream << ' ' << vertex_descriptor->GetDescriptorSetLayouts().size();
+  for (const auto& layout : vertex_descriptor->GetDescriptorSetLayouts()) {
+    stream << ' ' << layout.binding << ' ' << ToInt(layout.descriptor_type)
+           << ' ' << ToInt(layout.shader_stage);
+  }
+
+  // The label may contain spaces, so it goes last.
+  stream << " L " << desc.GetLabel();
+  return stream.str();
+}
+
+namespace {
+
+class KeyReader {
+ public:
+  explicit KeyReader(const std::string& key) : stream_(key) {}
+
+  bool Read(uint64_t& value) { return !!(stream_ >> value); }
+
+  bool Read(uint32_t& value) {
+    uint64_t raw = 0u;
+    if (!Read(raw) || raw > std::numeric_limits<uint32_t>::max()) {
+      return false;
+    }
+    value = static_cast<uint32_t>(raw);
+    return true;
+  }
+
+  bool Read(bool& value) {
+    uint64_t raw = 0u;
+    if (!Read(raw) || raw > 1u) {
+      return false;
+    }
+    value = raw == 1u;
+    return true;
+  }
+
+  bool Read(std::string& value) { return !!(stream_ >> value); }
+
+  template <class T>
+  bool ReadEnum(T& value, T last) {
+    uint64_t raw = 0u;
+    if (!Read(raw) || raw > ToInt(last)) {
+      return false;
+    }
+    value = static_cast<T>(raw);
+    return true;
+  }
+
+  bool ReadListSize(uint64_t& size) {
+    return Read(size) && size <= kMaxListSize;
+  }
+
+  bool ReadTag(char tag) {
+    char c = 0;
+    return (stream_ >> c) && c == tag;
+  }
+
+  bool ReadStencil(std::optional<StencilAttachmentDescriptor>& desc) {
+    bool has_value = false;
+    if (!ReadTag('S') || !Read(has_value)) {
+      return false;
+    }
+    if (!has_value) {
+      desc = std::nullopt;
+      return true;
+    }
+    StencilAttachmentDescriptor stencil;
+    if (!ReadEnum(stencil.stencil_compare, CompareFunction::kGreaterEqual) ||
+        !ReadEnum(stencil.stencil_failure, StencilOperation::kDecrementWrap) ||
+        !ReadEnum(stencil.depth_failure, StencilOperation::kDecrementWrap) ||
+        !ReadEnum(stencil.depth_stencil_pass,
+                  StencilOperation::kDecrementWrap) ||
+        !Read(stencil.read_mask) || !Read(stencil.write_mask)) {
+      return false;
+    }
+    desc = stencil;
+    return true;
+  }
+
+  bool ReadLabel(std::string& label) {
+    if (!ReadTag('L')) {
+      return false;
+    }
+    // Skip the single separator that precedes the label.
+    stream_.get();
+    std::getline(stream_, label);
+    return true;
+  }
+
+ private:
+  std::istringstream stream_;
+};
+
+}  // namespace
+
+std::optional<PipelineDescriptor> PipelineManifestVK::CreateDescriptor(
+    const std::string& key,
+    ShaderLibrary& library) {
+  KeyReader reader(key);
+  PipelineDescriptor desc;
+
+  uint64_t sample_count = 0u;
+  WindingOrder winding_order = WindingOrder::kClockwise;
+  CullMode cull_mode = CullMode::kNone;
+  PrimitiveType primitive_type = PrimitiveType::kTriangle;
+  PolygonMode polygon_mode = PolygonMode::kFill;
+  bool uses_subpass_input = false;
+  PixelFormat depth_format = PixelFormat::kUnknown;
+  PixelFormat stencil_format = PixelFormat::kUnknown;
+  if (!reader.Read(sample_count) ||
+      !reader.ReadEnum(winding_order, WindingOrder::kCounterClockwise) ||
+      !reader.ReadEnum(cull_mode, CullMode::kBackFace) ||
+      !reader.ReadEnum(primitive_type, PrimitiveType::kPoint) ||
+      !reader.ReadEnum(polygon_mode, PolygonMode::kLine) ||
+      !reader.Read(uses_subpass_input) ||
+      !reader.ReadEnum(depth_format, PixelFormat::kD32FloatS8UInt) ||
+      !reader.ReadEnum(stencil_format, PixelFormat::kD32FloatS8UInt)) {
+    return std::nullopt;
+  }
+  if (sample_count != ToInt(SampleCount::kCount1) &&
+      sample_count != ToInt(SampleCount::kCount4)) {
+    return std::nullopt;
+  }
+  desc.SetSampleCount(static_cast<SampleCount>(sample_count));
+  desc.SetWindingOrder(winding_order);
+  desc.SetCullMode(cull_mode);
+  desc.SetPrimitiveType(primitive_type);
+  desc.SetPolygonMode(polygon_mode);
+  desc.SetUseSubpassInput(uses_subpass_input ? UseSubpassInput::kYes
+                                             : UseSubpassInput::kNo);
+  desc.SetDepthPixelFormat(depth_format);
+  desc.SetStencilPixelFormat(stencil_format);
+
+  uint64_t count = 0u;
+  if (!reader.ReadTag('E') || !reader.ReadListSize(count)) {
+    return std::nullopt;
+  }
+  for (uint64_t i = 0; i < count; i++) {
+    ShaderStage stage = ShaderStage::kUnknown;
+    std::string name;
+    if (!reader.ReadEnum(stage, ShaderStage::kCompute) || !reader.Read(name)) {
+      return std::nullopt;
+    }
+    auto function = library.GetFunction(name, stage);
+    if (!function) {
+      return std::nullopt;
+    }
+    desc.AddStageEntrypoint(std::move(function));
+  }
+
+  if (!reader.ReadTag('C') || !reader.ReadListSize(count)) {
+    return std::nullopt;
+  }
+  for (uint64_t i = 0; i < count; i++) {
+    uint64_t index = 0u;
+    ColorAttachmentDescriptor color;
+    if (!reader.Read(index) ||
+        !reader.ReadEnum(color.format, PixelFormat::kD32FloatS8UInt) ||
+        !reader.Read(color.blending_enabled) ||
+        !reader.ReadEnum(color.src_color_blend_factor,
+                         BlendFactor::kOneMinusBlendAlpha) ||
+        !reader.ReadEnum(color.color_blend_op,
+                         BlendOperation::kReverseSubtract) ||
+        !reader.ReadEnum(color.dst_color_blend_factor,
+                         BlendFactor::kOneMinusBlendAlpha) ||
+        !reader.ReadEnum(color.src_alpha_blend_factor,
+                         BlendFactor::kOneMinusBlendAlpha) ||
+        !reader.ReadEnum(color.alpha_blend_op,
+                         BlendOperation::kReverseSubtract) ||
+        !reader.ReadEnum(color.dst_alpha_blend_factor,
+                         BlendFactor::kOneMinusBlendAlpha) ||
+        !reader.Read(color.write_mask)) {
+      return std::nullopt;
+    }
+    desc.SetColorAttachmentDescriptor(static_cast<size_t>(index), color);
+  }
+
+  bool has_depth = false;
+  if (!reader.ReadTag('D') || !reader.Read(has_depth)) {
+    return std::nullopt;
+  }
+  if (has_depth) {
+    DepthAttachmentDescriptor depth;
+    if (!reader.ReadEnum(depth.depth_compare, CompareFunction::kGreaterEqual) ||
+        !reader.Read(depth.depth_write_enabled)) {
+      return std::nullopt;
+    }
+    desc.SetDepthStencilAttachmentDescriptor(depth);
+  }
+
+  std::optional<StencilAttachmentDescriptor> front;
+  std::optional<StencilAttachmentDescriptor> back;
+  if (!reader.ReadStencil(front) || !reader.ReadStencil(back)) {
+    return std::nullopt;
+  }
+  desc.SetStencilAttachmentDescriptors(front, back);
+
+  if (!reader.ReadTag('K') || !reader.ReadListSize(count)) {
+    return std::nullopt;
+  }
+  std::vector<Scalar> constants;
+  for (uint64_t i = 0; i < count; i++) {
+    uint32_t bits = 0u;
+    if (!reader.Read(bits)) {
+      return std::nullopt;
+    }
+    Scalar constant = 0;
+    std::memcpy(&constant, &bits, sizeof(bits));
+    constants.push_back(constant);
+  }
+  desc.SetSpecializationConstants(std::move(constants));
+
+  if (!reader.ReadTag('V') || !reader.ReadListSize(count)) {
+    return std::nullopt;
+  }
+  std::vector<ShaderStageIOSlot> inputs;
+  for (uint64_t i = 0; i < count; i++) {
+    // The names of vertex inputs are not recorded. Only the OpenGL ES backend
+    // needs them.
+    ShaderStageIOSlot input = {};
+    input.name = "";
+    uint64_t location, set, binding, bit_width, vec_size, columns, offset;
+    if (!reader.Read(location) || !reader.Read(set) || !reader.Read(binding) ||
+        !reader.ReadEnum(input.type, ShaderType::kSampler) ||
+        !reader.Read(bit_width) || !reader.Read(vec_size) ||
+        !reader.Read(columns) || !reader.Read(offset)) {
+      return std::nullopt;
+    }
+    input.location = static_cast<size_t>(location);
+    input.set = static_cast<size_t>(set);
+    input.binding = static_cast<size_t>(binding);
+    input.bit_width = static_cast<size_t>(bit_width);
+    input.vec_size = static_cast<size_t>(vec_size);
+    input.columns = static_cast<size_t>(columns);
+    input.offset = static_cast<size_t>(offset);
+    inputs.push_back(input);
+  }
+  if (!reader.ReadListSize(count)) {
+    return std::nullopt;
+  }
+  std::vector<ShaderStageBufferLayout> layouts;
+  for (uint64_t i = 0; i < count; i++) {
+    uint64_t stride, binding;
+    if (!reader.Read(stride) || !reader.Read(binding)) {
+      return std::nullopt;
+    }
+    layouts.push_back({
+        .stride = static_cast<size_t>(stride),
+        .binding = static_cast<size_t>(binding),
+    });
+  }
+  if (!reader.ReadListSize(count)) {
+    return std::nullopt;
+  }
+  std::vector<DescriptorSetLayout> desc_set_layouts;
+  for (uint64_t i = 0; i < count; i++) {
+    DescriptorSetLayout layout = {};
+    if (!reader.Read(layout.binding) ||
+        !reader.ReadEnum(layout.descriptor_type,
+                         DescriptorType::kInputAttachment) ||
+        !reader.ReadEnum(layout.shader_stage, ShaderStage::kCompute)) {
+      return std::nullopt;
+    }
+    desc_set_layouts.push_back(layout);
+  }
+  auto vertex_descriptor = std::make_shared<VertexDescriptor>();
+  vertex_descriptor->SetStageInputs(inputs, layouts);
+  vertex_descriptor->RegisterDescriptorSetLayouts(desc_set_layouts.data(),
+                                                  desc_set_layouts.size());
+  desc.SetVertexDescriptor(std::move(vertex_descriptor));
+
+  std::string label;
+  if (!reader.ReadLabel(label)) {
+    return std::nullopt;
+  }
+  desc.SetLabel(std::move(label));
+
+  return desc;
+}
+
+PipelineManifestVK::PipelineManifestVK() = default;
+
+PipelineManifestVK::~PipelineManifestVK() = default;
+
+std::vector<std::string> PipelineManifestVK::Load(
+    const fml::UniqueFD& directory) {
+  if (!directory.is_valid()) {
+    return {};
+  }
+  auto mapping =
+      fml::FileMapping::CreateReadOnly(directory, kPipelineManifestFileName);
+  if (!mapping || !mapping->GetMapping()) {
+    return {};
+  }
+
+  std::istringstream stream(
+      std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                  mapping->GetSize()));
+  std::string line;
+  if (!std::getline(stream, line) || line != kPipelineManifestHeader) {
+    FML_LOG(INFO) << "Discarding pipeline manifest in an unknown format.";
+    return {};
+  }
+
+  std::vector<std::string> keys;
+  Lock lock(mutex_);
+  while (std::getline(stream, line) && keys_.size() < kMaxEntries) {
+    if (line.empty()) {
+      continue;
+    }
+    if (keys_.insert(line).second) {
+      keys.push_back(line);
+    }
+  }
+  dirty_ = false;
+  return keys;
+}
+
+void PipelineManifestVK::AddKey(std::string key) {
+  Lock lock(mutex_);
+  if (keys_.size() >= kMaxEntries) {
+    return;
+  }
+  if (keys_.insert(std::move(key)).second) {
+    dirty_ = true;
+  }
+}
+
+void PipelineManifestVK::RemoveKey(const std::string& key) {
+  Lock lock(mutex_);
+  if (keys_.erase(key) > 0u) {
+    dirty_ = true;
+  }
+}
+
+size_t PipelineManifestVK::GetKeyCount() const {
+  Lock lock(mutex_);
+  return keys_.size();
+}
+
+bool PipelineManifestVK::Persist(const fml::UniqueFD& directory) {
+  if (!directory.is_valid()) {
+    return false;
+  }
+  std::string contents;
+  {
+    Lock lock(mutex_);
+    if (!dirty_) {
+      return true;
+    }
+    contents = kPipelineManifestHeader;
+    for (const auto& key : keys_) {
+      contents += '\n';
+      contents += key;
+    }
+    dirty_ = false;
+  }
+  fml::DataMapping mapping(contents);
+  if (!fml::WriteAtomically(directory, kPipelineManifestFileName, mapping)) {
+    VALIDATION_LOG << "Could not persist pipeline manifest to disk.";
+    Lock lock(mutex_);
+    dirty_ = true;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace impeller
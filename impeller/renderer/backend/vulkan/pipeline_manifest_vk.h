@@ -0,0 +1,99 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_PIPELINE_MANIFEST_VK_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_PIPELINE_MANIFEST_VK_H_
+
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/unique_fd.h"
+#include "impeller/base/thread.h"
+#include "impeller/renderer/pipeline_descriptor.h"
+#include "impeller/renderer/shader_library.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      The set of pipelines created in previous sessions, persisted
+///             next to the pipeline cache so that they can be created again
+///             ahead of their first use.
+///
+///             Each pipeline is recorded as a key that describes its
+///             descriptor with shader functions referred to by name, since the
+///             descriptors themselves hold pointers that are only meaningful
+///             within a single process.
+///
+///             This object is thread safe.
+///
+class PipelineManifestVK {
+ public:
+  /// The maximum number of pipelines recorded in the manifest.
+  static constexpr size_t kMaxEntries = 1024u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a key for the descriptor that is stable across
+  ///             sessions. Descriptors that only differ in the names of their
+  ///             vertex inputs have the same key.
+  ///
+  /// @return     The key, or std::nullopt if the descriptor can't be recorded.
+  ///
+  static std::optional<std::string> CreateKey(const PipelineDescriptor& desc);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Recreates a descriptor from a key, resolving its shader
+  ///             functions from the given library.
+  ///
+  /// @return     The descriptor, or std::nullopt if the key is malformed or
+  ///             refers to a function that is not in the library.
+  ///
+  static std::optional<PipelineDescriptor> CreateDescriptor(
+      const std::string& key,
+      ShaderLibrary& library);
+
+  PipelineManifestVK();
+
+  ~PipelineManifestVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reads the manifest persisted in the directory, if any.
+  ///
+  /// @return     The keys that were read.
+  ///
+  std::vector<std::string> Load(const fml::UniqueFD& directory);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records a key. The key is dropped if the manifest is full.
+  ///
+  void AddKey(std::string key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Forgets a key, for instance because the pipeline it
+  ///             describes can no longer be created.
+  ///
+  void RemoveKey(const std::string& key);
+
+  size_t GetKeyCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the manifest to the directory if any key was added or
+  ///             removed since it was last loaded or persisted.
+  ///
+  bool Persist(const fml::UniqueFD& directory);
+
+ private:
+  mutable Mutex mutex_;
+  std::set<std::string> keys_ IPLR_GUARDED_BY(mutex_);
+  bool dirty_ IPLR_GUARDED_BY(mutex_) = false;
+
+  PipelineManifestVK(const PipelineManifestVK&) = delete;
+
+  PipelineManifestVK& operator=(const PipelineManifestVK&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_PIPELINE_MANIFEST_VK_H_
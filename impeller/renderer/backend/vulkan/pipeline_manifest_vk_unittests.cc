@@ -0,0 +1,144 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <map>
+#include <utility>
+
+#include "flutter/fml/file.h"
+#include "flutter/testing/testing.h"  // IWYU pragma: keep.
+#include "impeller/renderer/backend/vulkan/pipeline_manifest_vk.h"
+#include "impeller/renderer/shader_function.h"
+#include "impeller/renderer/vertex_descriptor.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+class TestShaderFunction final : public ShaderFunction {
+ public:
+  TestShaderFunction(std::string name, ShaderStage stage)
+      : ShaderFunction(UniqueID{}, std::move(name), stage) {}
+};
+
+class TestShaderLibrary final : public ShaderLibrary {
+ public:
+  std::shared_ptr<const ShaderFunction> AddFunction(std::string name,
+                                                    ShaderStage stage) {
+    auto function = std::make_shared<TestShaderFunction>(name, stage);
+    functions_[{std::move(name), stage}] = function;
+    return function;
+  }
+
+  // |ShaderLibrary|
+  bool IsValid() const override { return true; }
+
+  // |ShaderLibrary|
+  std::shared_ptr<const ShaderFunction> GetFunction(
+      std::string_view name,
+      ShaderStage stage) override {
+    auto found = functions_.find({std::string(name), stage});
+    return found == functions_.end() ? nullptr : found->second;
+  }
+
+  // |ShaderLibrary|
+  void UnregisterFunction(std::string name, ShaderStage stage) override {
+    functions_.erase({std::move(name), stage});
+  }
+
+ private:
+  std::map<std::pair<std::string, ShaderStage>,
+           std::shared_ptr<const ShaderFunction>>
+      functions_;
+};
+
+PipelineDescriptor CreateTestDescriptor(TestShaderLibrary& library) {
+  PipelineDescriptor desc;
+  desc.SetLabel("Solid Fill Pipeline");
+  desc.AddStageEntrypoint(
+      library.AddFunction("solid_vertex", ShaderStage::kVertex));
+  desc.AddStageEntrypoint(
+      library.AddFunction("solid_fragment", ShaderStage::kFragment));
+  desc.SetSampleCount(SampleCount::kCount4);
+  desc.SetPrimitiveType(PrimitiveType::kTriangleStrip);
+
+  ColorAttachmentDescriptor color;
+  color.format = PixelFormat::kB8G8R8A8UNormInt;
+  color.blending_enabled = true;
+  desc.SetColorAttachmentDescriptor(0u, color);
+
+  StencilAttachmentDescriptor stencil;
+  stencil.stencil_compare = CompareFunction::kEqual;
+  stencil.depth_stencil_pass = StencilOperation::kIncrementClamp;
+  desc.SetStencilAttachmentDescriptors(stencil);
+  desc.SetStencilPixelFormat(PixelFormat::kS8UInt);
+  desc.SetSpecializationConstants({1.5f, -0.25f});
+
+  static const ShaderStageIOSlot kPosition = {
+      "position", 0u, 0u, 0u, ShaderType::kFloat, 32u, 2u, 1u, 0u};
+  static const ShaderStageBufferLayout kLayout = {8u, 0u};
+  static const DescriptorSetLayout kSetLayout = {
+      0u, DescriptorType::kUniformBuffer, ShaderStage::kVertex};
+  auto vertex_descriptor = std::make_shared<VertexDescriptor>();
+  vertex_descriptor->SetStageInputs({kPosition}, {kLayout});
+  vertex_descriptor->RegisterDescriptorSetLayouts(&kSetLayout, 1u);
+  desc.SetVertexDescriptor(std::move(vertex_descriptor));
+  return desc;
+}
+
+}  // namespace
+
+TEST(PipelineManifestVKTest, KeysRoundTripThroughDescriptors) {
+  TestShaderLibrary library;
+  auto desc = CreateTestDescriptor(library);
+
+  auto key = PipelineManifestVK::CreateKey(desc);
+  ASSERT_TRUE(key.has_value());
+
+  auto recreated = PipelineManifestVK::CreateDescriptor(*key, library);
+  ASSERT_TRUE(recreated.has_value());
+  EXPECT_EQ(PipelineManifestVK::CreateKey(*recreated), key);
+  EXPECT_EQ(recreated->GetLabel(), desc.GetLabel());
+  EXPECT_EQ(recreated->GetSpecializationConstants(),
+            desc.GetSpecializationConstants());
+  EXPECT_TRUE(DeepCompareMap(recreated->GetStageEntrypoints(),
+                             desc.GetStageEntrypoints()));
+  EXPECT_EQ(
+      recreated->GetVertexDescriptor()->GetDescriptorSetLayouts().size(), 1u);
+}
+
+TEST(PipelineManifestVKTest, RejectsMalformedKeys) {
+  TestShaderLibrary library;
+  auto key = PipelineManifestVK::CreateKey(CreateTestDescriptor(library));
+  ASSERT_TRUE(key.has_value());
+
+  EXPECT_FALSE(PipelineManifestVK::CreateDescriptor("", library).has_value());
+  EXPECT_FALSE(
+      PipelineManifestVK::CreateDescriptor(key->substr(0u, key->size() / 2u),
+                                           library)
+          .has_value());
+
+  library.UnregisterFunction("solid_fragment", ShaderStage::kFragment);
+  EXPECT_FALSE(PipelineManifestVK::CreateDescriptor(*key, library).has_value());
+}
+
+TEST(PipelineManifestVKTest, PersistsKeysToDisk) {
+  fml::ScopedTemporaryDirectory directory;
+  {
+    PipelineManifestVK manifest;
+    manifest.AddKey("first");
+    manifest.AddKey("second");
+    manifest.AddKey("first");
+    EXPECT_EQ(manifest.GetKeyCount(), 2u);
+    EXPECT_TRUE(manifest.Persist(directory.fd()));
+  }
+
+  PipelineManifestVK manifest;
+  auto keys = manifest.Load(directory.fd());
+  EXPECT_EQ(keys, (std::vector<std::string>{"first", "second"}));
+  EXPECT_EQ(manifest.GetKeyCount(), 2u);
+}
+
+}  // namespace testing
+}  // namespace impeller
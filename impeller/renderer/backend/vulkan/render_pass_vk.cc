@@ -4,18 +4,23 @@
 
 #include "impeller/renderer/backend/vulkan/render_pass_vk.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <vector>
 
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/device_buffer.h"
 #include "impeller/core/formats.h"
 #include "impeller/renderer/backend/vulkan/barrier_vk.h"
 #include "impeller/renderer/backend/vulkan/binding_helpers_vk.h"
+#include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
+#include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
@@ -44,7 +49,11 @@ static vk::AttachmentDescription CreateAttachmentDescription(
   auto load_action = attachment.load_action;
   auto store_action = attachment.store_action;
 
-  if (current_layout == vk::ImageLayout::eUndefined) {
+  // The contents of an image in the undefined layout can't be loaded. Passes
+  // that don't care about the previous contents keep kDontCare, which saves
+  // tile-based GPUs from writing a clear value that is immediately drawn over.
+  if (current_layout == vk::ImageLayout::eUndefined &&
+      load_action == LoadAction::kLoad) {
     load_action = LoadAction::kClear;
   }
 
@@ -175,17 +184,23 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
   std::vector<vk::SubpassDependency> subpass_dependencies;
   std::vector<vk::AttachmentReference> subpass_color_ref;
   subpass_color_ref.push_back(vk::AttachmentReference{
-      static_cast<uint32_t>(0), vk::ImageLayout::eColorAttachmentOptimal});
+      static_cast<uint32_t>(0), vk::ImageLayout::eGeneral});
   if (supports_framebuffer_fetch) {
-    subpass_desc.setFlags(vk::SubpassDescriptionFlagBits::
-                              eRasterizationOrderAttachmentColorAccessARM);
     subpass_desc.setInputAttachments(subpass_color_ref);
+    if (CapabilitiesVK::Cast(*context.GetCapabilities())
+            .SupportsRasterizationOrderAttachmentAccess()) {
+      subpass_desc.setFlags(vk::SubpassDescriptionFlagBits::
+                                eRasterizationOrderAttachmentColorAccessARM);
+    } else {
+      subpass_dependencies.push_back(CreateFramebufferFetchSelfDependency());
+    }
   }
 
   vk::RenderPassCreateInfo render_pass_desc;
   render_pass_desc.setAttachments(attachments);
   render_pass_desc.setPSubpasses(&subpass_desc);
   render_pass_desc.setSubpassCount(1u);
+  render_pass_desc.setDependencies(subpass_dependencies);
 
   auto [result, pass] =
       context.GetDevice().createRenderPassUnique(render_pass_desc);
@@ -365,18 +380,55 @@ static void SetViewportAndScissor(const Command& command,
   cmd_buffer_cache.SetScissor(cmd_buffer, 0, 1, &scissor);
 }
 
-static bool EncodeCommand(const Context& context,
-                          const Command& command,
-                          CommandEncoderVK& encoder,
+/// Holds on to the vertex and index buffers of a command until the GPU is done
+/// with the command buffer it is recorded to.
+static bool TrackCommand(const Command& command, CommandEncoderVK& encoder) {
+  if (!command.vertex_buffer.vertex_buffer) {
+    VALIDATION_LOG << "Failed to acquire device buffer"
+                   << " for vertex buffer view";
+    return false;
+  }
+
+  if (!encoder.Track(command.vertex_buffer.vertex_buffer.buffer)) {
+    return false;
+  }
+
+  if (command.vertex_buffer.index_type != IndexType::kNone) {
+    const BufferView& index_buffer_view = command.vertex_buffer.index_buffer;
+    if (!index_buffer_view) {
+      return false;
+    }
+
+    if (!index_buffer_view.buffer) {
+      VALIDATION_LOG << "Failed to acquire device buffer"
+                     << " for index buffer view";
+      return false;
+    }
+
+    if (!encoder.Track(index_buffer_view.buffer)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Records a command that has already been validated and tracked by
+/// |TrackCommand|. Only touches the given command buffer and bindings cache,
+/// so that commands may be recorded into different command buffers
+/// concurrently.
+static void RecordCommand(const Command& command,
                           PassBindingsCache& command_buffer_cache,
                           const ISize& target_size,
-                          const vk::DescriptorSet vk_desc_set,
-                          const vk::CommandBuffer& cmd_buffer) {
+                          const DescriptorSetBindingVK& desc_set,
+                          const vk::CommandBuffer& cmd_buffer,
+                          bool needs_framebuffer_fetch_barrier) {
 #ifdef IMPELLER_DEBUG
   fml::ScopedCleanupClosure pop_marker(
-      [&encoder]() { encoder.PopDebugGroup(); });
-  if (!command.label.empty()) {
-    encoder.PushDebugGroup(command.label.c_str());
+      [&cmd_buffer]() { cmd_buffer.endDebugUtilsLabelEXT(); });
+  if (!command.label.empty() && HasValidationLayers()) {
+    vk::DebugUtilsLabelEXT label_info;
+    label_info.pLabelName = command.label.c_str();
+    cmd_buffer.beginDebugUtilsLabelEXT(label_info);
   } else {
     pop_marker.Release();
   }
@@ -384,13 +436,32 @@ static bool EncodeCommand(const Context& context,
 
   const PipelineVK& pipeline_vk = PipelineVK::Cast(*command.pipeline);
 
-  cmd_buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,  // bind point
-                                pipeline_vk.GetPipelineLayout(),   // layout
-                                0,                                 // first set
-                                1,                                 // set count
-                                &vk_desc_set,                      // sets
-                                0,       // offset count
-                                nullptr  // offsets
+  // Without rasterization order attachment access, the writes of previous
+  // draws are only visible to input attachment reads after a barrier that
+  // matches the self-dependency of the subpass.
+  if (needs_framebuffer_fetch_barrier &&
+      command.pipeline->GetDescriptor().UsesSubpassInput()) {
+    vk::MemoryBarrier barrier;
+    barrier.srcAccessMask = vk::AccessFlagBits::eColorAttachmentWrite;
+    barrier.dstAccessMask = vk::AccessFlagBits::eInputAttachmentRead;
+    cmd_buffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eColorAttachmentOutput,  // src stage
+        vk::PipelineStageFlagBits::eFragmentShader,         // dst stage
+        vk::DependencyFlagBits::eByRegion,                  // flags
+        barrier,                                            // memory
+        {},                                                 // buffers
+        {}                                                  // images
+    );
+  }
+
+  cmd_buffer.bindDescriptorSets(
+      vk::PipelineBindPoint::eGraphics,     // bind point
+      pipeline_vk.GetPipelineLayout(),      // layout
+      0,                                    // first set
+      1,                                    // set count
+      &desc_set.descriptor_set,             // sets
+      desc_set.dynamic_offset_count,        // offset count
+      desc_set.dynamic_offsets.data()       // offsets
   );
 
   command_buffer_cache.BindPipeline(
@@ -404,24 +475,10 @@ static bool EncodeCommand(const Context& context,
       cmd_buffer, vk::StencilFaceFlagBits::eVkStencilFrontAndBack,
       command.stencil_reference);
 
-  // Configure vertex and index and buffers for binding.
-  if (!command.vertex_buffer.vertex_buffer) {
-    VALIDATION_LOG << "Failed to acquire device buffer"
-                   << " for vertex buffer view";
-    return false;
-  }
-
-  auto& allocator = *context.GetResourceAllocator();
-  const std::shared_ptr<const DeviceBuffer>& vertex_buffer =
-      command.vertex_buffer.vertex_buffer.buffer;
-
-  if (!encoder.Track(vertex_buffer)) {
-    return false;
-  }
-
   // Bind the vertex buffer.
   vk::Buffer vertex_buffer_handle =
-      DeviceBufferVK::Cast(*vertex_buffer).GetBuffer();
+      DeviceBufferVK::Cast(*command.vertex_buffer.vertex_buffer.buffer)
+          .GetBuffer();
   vk::Buffer vertex_buffers[] = {vertex_buffer_handle};
   vk::DeviceSize vertex_buffer_offsets[] = {
       command.vertex_buffer.vertex_buffer.range.offset};
@@ -430,24 +487,8 @@ static bool EncodeCommand(const Context& context,
   if (command.vertex_buffer.index_type != IndexType::kNone) {
     // Bind the index buffer.
     const BufferView& index_buffer_view = command.vertex_buffer.index_buffer;
-    if (!index_buffer_view) {
-      return false;
-    }
-
-    const std::shared_ptr<const DeviceBuffer>& index_buffer =
-        index_buffer_view.buffer;
-    if (!index_buffer) {
-      VALIDATION_LOG << "Failed to acquire device buffer"
-                     << " for index buffer view";
-      return false;
-    }
-
-    if (!encoder.Track(index_buffer)) {
-      return false;
-    }
-
     vk::Buffer index_buffer_handle =
-        DeviceBufferVK::Cast(*index_buffer).GetBuffer();
+        DeviceBufferVK::Cast(*index_buffer_view.buffer).GetBuffer();
     cmd_buffer.bindIndexBuffer(index_buffer_handle,
                                index_buffer_view.range.offset,
                                ToVKIndexType(command.vertex_buffer.index_type));
@@ -466,6 +507,152 @@ static bool EncodeCommand(const Context& context,
                     0u                                   // first instance
     );
   }
+}
+
+namespace {
+
+/// A secondary command buffer along with the detached pool it was allocated
+/// from. Tracked by the encoder of the primary command buffer executing it.
+class SecondaryCommandBufferVK final : public SharedObjectVK {
+ public:
+  SecondaryCommandBufferVK(std::shared_ptr<CommandPoolVK> pool,
+                           vk::UniqueCommandBuffer buffer)
+      : pool_(std::move(pool)), buffer_(std::move(buffer)) {}
+
+  // |SharedObjectVK|
+  ~SecondaryCommandBufferVK() override {
+    pool_->CollectCommandBuffer(std::move(buffer_),
+                                vk::CommandBufferLevel::eSecondary);
+  }
+
+  vk::CommandBuffer Get() const { return *buffer_; }
+
+ private:
+  std::shared_ptr<CommandPoolVK> pool_;
+  vk::UniqueCommandBuffer buffer_;
+
+  SecondaryCommandBufferVK(const SecondaryCommandBufferVK&) = delete;
+
+  SecondaryCommandBufferVK& operator=(const SecondaryCommandBufferVK&) =
+      delete;
+};
+
+}  // namespace
+
+/// Below this many commands per secondary command buffer, the cost of
+/// allocating and executing the buffers outweighs recording in parallel.
+static constexpr size_t kMinCommandsPerSecondaryCommandBuffer = 256u;
+
+/// Matches the size of the concurrent worker pool of the context.
+static constexpr size_t kMaxSecondaryCommandBuffers = 4u;
+
+static size_t GetSecondaryCommandBufferCount(const ContextVK& context,
+                                             size_t command_count) {
+  if (!context.IsParallelRenderPassEncodingEnabled()) {
+    return 0u;
+  }
+  auto count = std::min(command_count / kMinCommandsPerSecondaryCommandBuffer,
+                        kMaxSecondaryCommandBuffers);
+  return count < 2u ? 0u : count;
+}
+
+bool RenderPassVK::EncodeCommandsInSecondaryCommandBuffers(
+    const ContextVK& context,
+    CommandEncoderVK& encoder,
+    const std::vector<DescriptorSetBindingVK>& desc_sets,
+    const vk::RenderPassBeginInfo& pass_info,
+    size_t buffer_count) const {
+  TRACE_EVENT0("impeller", "EncodeRenderPassCommandsConcurrently");
+  const auto& target_size = render_target_.GetRenderTargetSize();
+  const bool needs_framebuffer_fetch_barrier =
+      !CapabilitiesVK::Cast(*context.GetCapabilities())
+           .SupportsRasterizationOrderAttachmentAccess();
+
+  // Command pools must not be used from several threads at the same time, so
+  // each secondary command buffer gets its own pool.
+  std::vector<std::shared_ptr<SecondaryCommandBufferVK>> secondaries;
+  secondaries.reserve(buffer_count);
+  for (size_t i = 0; i < buffer_count; i++) {
+    auto pool = context.GetCommandPoolRecycler()->GetDetached();
+    if (!pool) {
+      return false;
+    }
+    auto buffer =
+        pool->CreateCommandBuffer(vk::CommandBufferLevel::eSecondary);
+    if (!buffer) {
+      return false;
+    }
+    auto secondary = std::make_shared<SecondaryCommandBufferVK>(
+        std::move(pool), std::move(buffer));
+    if (!encoder.Track(secondary)) {
+      return false;
+    }
+    secondaries.push_back(std::move(secondary));
+  }
+
+  vk::CommandBufferInheritanceInfo inheritance_info;
+  inheritance_info.renderPass = pass_info.renderPass;
+  inheritance_info.subpass = 0u;
+  inheritance_info.framebuffer = pass_info.framebuffer;
+
+  vk::CommandBufferBeginInfo begin_info;
+  begin_info.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit |
+                     vk::CommandBufferUsageFlagBits::eRenderPassContinue;
+  begin_info.pInheritanceInfo = &inheritance_info;
+
+  // Dynamic state is not inherited from the primary command buffer, so every
+  // secondary command buffer starts with an empty bindings cache.
+  auto record = [&](size_t index) -> bool {
+    vk::CommandBuffer cmd_buffer = secondaries[index]->Get();
+    if (cmd_buffer.begin(begin_info) != vk::Result::eSuccess) {
+      return false;
+    }
+    PassBindingsCache bindings_cache;
+    size_t commands_per_buffer =
+        (commands_.size() + buffer_count - 1) / buffer_count;
+    size_t begin = index * commands_per_buffer;
+    size_t end = std::min(begin + commands_per_buffer, commands_.size());
+    for (size_t i = begin; i < end; i++) {
+      RecordCommand(commands_[i], bindings_cache, target_size, desc_sets[i],
+                    cmd_buffer, needs_framebuffer_fetch_barrier);
+    }
+    return cmd_buffer.end() == vk::Result::eSuccess;
+  };
+
+  // The raster thread records the first range instead of idling.
+  std::atomic_bool success = true;
+  fml::CountDownLatch latch(buffer_count - 1);
+  auto worker_task_runner = context.GetConcurrentWorkerTaskRunner();
+  for (size_t i = 1; i < buffer_count; i++) {
+    worker_task_runner->PostTask(
+        [&record, &success, &latch, i]() {
+          if (!record(i)) {
+            success = false;
+          }
+          latch.CountDown();
+        },
+        fml::ConcurrentTaskPriority::kHigh);
+  }
+  if (!record(0u)) {
+    success = false;
+  }
+  latch.Wait();
+  if (!success) {
+    VALIDATION_LOG << "Could not record secondary command buffers.";
+    return false;
+  }
+
+  std::vector<vk::CommandBuffer> cmd_buffers;
+  cmd_buffers.reserve(buffer_count);
+  for (const auto& secondary : secondaries) {
+    cmd_buffers.push_back(secondary->Get());
+  }
+
+  vk::CommandBuffer cmd_buffer = encoder.GetCommandBuffer();
+  cmd_buffer.beginRenderPass(pass_info,
+                             vk::SubpassContents::eSecondaryCommandBuffers);
+  cmd_buffer.executeCommands(cmd_buffers);
+  cmd_buffer.endRenderPass();
   return true;
 }
 
@@ -545,25 +732,72 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
       *render_target_.GetColorAttachments().find(0u)->second.texture);
   Allocator& allocator = *context.GetResourceAllocator();
 
+  const size_t secondary_buffer_count =
+      GetSecondaryCommandBufferCount(vk_context, commands_.size());
+  if (secondary_buffer_count > 0u) {
+    // Descriptor pools and the tracked objects of the encoder are not thread
+    // safe. Do all of the allocation and tracking up front so that workers
+    // only record into their own command buffers.
+    std::vector<DescriptorSetBindingVK> desc_sets;
+    desc_sets.reserve(commands_.size());
+    for (const auto& command : commands_) {
+      fml::StatusOr<DescriptorSetBindingVK> desc_set_result =
+          AllocateAndBindDescriptorSets(vk_context, encoder, allocator, command,
+                                        color_image_vk, image_workspace_,
+                                        buffer_workspace_, write_workspace_);
+      if (!desc_set_result.ok()) {
+        return false;
+      }
+      if (!TrackCommand(command, *encoder)) {
+        return false;
+      }
+      desc_sets.push_back(desc_set_result.value());
+    }
+    return EncodeCommandsInSecondaryCommandBuffers(
+        vk_context, *encoder, desc_sets, pass_info, secondary_buffer_count);
+  }
+
   {
     TRACE_EVENT0("impeller", "EncodeRenderPassCommands");
     cmd_buffer.beginRenderPass(pass_info, vk::SubpassContents::eInline);
+    const bool needs_framebuffer_fetch_barrier =
+        !CapabilitiesVK::Cast(*vk_context.GetCapabilities())
+             .SupportsRasterizationOrderAttachmentAccess();
 
     fml::ScopedCleanupClosure end_render_pass(
         [cmd_buffer]() { cmd_buffer.endRenderPass(); });
 
+#ifdef IMPELLER_DEBUG
+    // Attribute the GPU time of each run of draws of the same category.
+    // Draws recorded in secondary command buffers aren't attributed.
+    std::optional<DrawCategory> category;
+    fml::ScopedCleanupClosure end_category([&encoder, &category]() {
+      if (category.has_value()) {
+        encoder->RecordDrawCategory(std::nullopt);
+      }
+    });
+#endif  // IMPELLER_DEBUG
+
     for (const auto& command : commands_) {
-      fml::StatusOr<vk::DescriptorSet> desc_set_result =
+      fml::StatusOr<DescriptorSetBindingVK> desc_set_result =
           AllocateAndBindDescriptorSets(vk_context, encoder, allocator, command,
                                         color_image_vk, image_workspace_,
                                         buffer_workspace_, write_workspace_);
       if (!desc_set_result.ok()) {
         return false;
       }
-      if (!EncodeCommand(context, command, *encoder, pass_bindings_cache_,
-                         target_size, desc_set_result.value(), cmd_buffer)) {
+      if (!TrackCommand(command, *encoder)) {
         return false;
       }
+#ifdef IMPELLER_DEBUG
+      if (category != command.category) {
+        category = command.category;
+        encoder->RecordDrawCategory(category);
+      }
+#endif  // IMPELLER_DEBUG
+      RecordCommand(command, pass_bindings_cache_, target_size,
+                    desc_set_result.value(), cmd_buffer,
+                    needs_framebuffer_fetch_barrier);
     }
   }
 
@@ -16,6 +16,7 @@
 namespace impeller {
 
 class CommandBufferVK;
+class CommandEncoderVK;
 
 class RenderPassVK final : public RenderPass {
  public:
@@ -24,6 +25,7 @@ class RenderPassVK final : public RenderPass {
 
  private:
   friend class CommandBufferVK;
+class CommandEncoderVK;
 
   std::weak_ptr<CommandBufferVK> command_buffer_;
   std::string debug_label_;
@@ -58,6 +60,21 @@ class RenderPassVK final : public RenderPass {
       const ContextVK& context,
       const vk::RenderPass& pass) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Records the commands of the pass into several secondary
+  ///             command buffers on the concurrent worker task runner and
+  ///             executes them from the primary command buffer of the encoder.
+  ///
+  ///             Descriptor sets must already be allocated and all resources
+  ///             of the commands tracked by the encoder.
+  ///
+  bool EncodeCommandsInSecondaryCommandBuffers(
+      const ContextVK& context,
+      CommandEncoderVK& encoder,
+      const std::vector<DescriptorSetBindingVK>& desc_sets,
+      const vk::RenderPassBeginInfo& pass_info,
+      size_t buffer_count) const;
+
   RenderPassVK(const RenderPassVK&) = delete;
 
   RenderPassVK& operator=(const RenderPassVK&) = delete;
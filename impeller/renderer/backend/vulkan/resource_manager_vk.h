@@ -33,8 +33,10 @@ class ResourceVK {
 ///             reclaimed.
 ///
 ///             Reclaimed resources are collected in a batch on a separate
-///             thread. In the future, the resource manager may allow resource
-///             pooling/reuse, delaying reclamation past frame workloads, etc...
+///             thread, in the order they were reclaimed. This includes the
+///             resources of completed command buffers, which are handed over
+///             by the |FenceWaiterVK| so that collecting them runs in parallel
+///             with waiting on later fences.
 ///
 class ResourceManagerVK final
     : public std::enable_shared_from_this<ResourceManagerVK> {
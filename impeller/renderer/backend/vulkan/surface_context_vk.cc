@@ -58,7 +58,8 @@ void SurfaceContextVK::Shutdown() {
 }
 
 bool SurfaceContextVK::SetWindowSurface(vk::UniqueSurfaceKHR surface) {
-  auto swapchain = SwapchainVK::Create(parent_, std::move(surface));
+  auto swapchain =
+      SwapchainVK::Create(parent_, std::move(surface), swapchain_settings_);
   if (!swapchain) {
     VALIDATION_LOG << "Could not create swapchain.";
     return false;
@@ -71,9 +72,27 @@ bool SurfaceContextVK::SetWindowSurface(vk::UniqueSurfaceKHR surface) {
   return true;
 }
 
+void SurfaceContextVK::SetSwapchainSettings(
+    const SwapchainSettingsVK& settings) {
+  swapchain_settings_ = settings;
+  if (swapchain_) {
+    swapchain_->UpdateSettings(settings);
+  }
+}
+
+void SurfaceContextVK::SetAcquireSurfaceCallback(
+    AcquireSurfaceCallback callback) {
+  acquire_surface_callback_ = std::move(callback);
+}
+
 std::unique_ptr<Surface> SurfaceContextVK::AcquireNextSurface() {
   TRACE_EVENT0("impeller", __FUNCTION__);
-  auto surface = swapchain_ ? swapchain_->AcquireNextDrawable() : nullptr;
+  std::unique_ptr<Surface> surface;
+  if (acquire_surface_callback_) {
+    surface = acquire_surface_callback_();
+  } else if (swapchain_) {
+    surface = swapchain_->AcquireNextDrawable();
+  }
   if (!surface) {
     return nullptr;
   }
@@ -5,9 +5,11 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_SURFACE_CONTEXT_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_SURFACE_CONTEXT_VK_H_
 
+#include <functional>
 #include <memory>
 
 #include "impeller/base/backend_cast.h"
+#include "impeller/renderer/backend/vulkan/swapchain_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 #include "impeller/renderer/context.h"
 
@@ -15,11 +17,12 @@ namespace impeller {
 
 class ContextVK;
 class Surface;
-class SwapchainVK;
 
 class SurfaceContextVK : public Context,
                          public BackendCast<SurfaceContextVK, Context> {
  public:
+  using AcquireSurfaceCallback = std::function<std::unique_ptr<Surface>()>;
+
   explicit SurfaceContextVK(const std::shared_ptr<ContextVK>& parent);
 
   // |Context|
@@ -60,6 +63,21 @@ class SurfaceContextVK : public Context,
 
   [[nodiscard]] bool SetWindowSurface(vk::UniqueSurfaceKHR surface);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the present mode and image count of the swapchain. A
+  ///             current swapchain is recreated with them when the next
+  ///             surface is acquired.
+  ///
+  void SetSwapchainSettings(const SwapchainSettingsVK& settings);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Acquires the surfaces from `callback` instead of the swapchain
+  ///             of the window surface, for platforms that present buffers of
+  ///             their own to the system compositor. A null callback goes back
+  ///             to the swapchain.
+  ///
+  void SetAcquireSurfaceCallback(AcquireSurfaceCallback callback);
+
   std::unique_ptr<Surface> AcquireNextSurface();
 
 #ifdef FML_OS_ANDROID
@@ -69,6 +87,8 @@ class SurfaceContextVK : public Context,
  private:
   std::shared_ptr<ContextVK> parent_;
   std::shared_ptr<SwapchainVK> swapchain_;
+  SwapchainSettingsVK swapchain_settings_;
+  AcquireSurfaceCallback acquire_surface_callback_;
 };
 
 }  // namespace impeller
@@ -13,7 +13,8 @@ namespace impeller {
 std::unique_ptr<SurfaceVK> SurfaceVK::WrapSwapchainImage(
     const std::shared_ptr<Context>& context,
     std::shared_ptr<SwapchainImageVK>& swapchain_image,
-    SwapCallback swap_callback) {
+    SwapCallback swap_callback,
+    size_t buffer_age) {
   if (!context || !swapchain_image || !swap_callback) {
     return nullptr;
   }
@@ -70,17 +71,25 @@ std::unique_ptr<SurfaceVK> SurfaceVK::WrapSwapchainImage(
   render_target_desc.SetColorAttachment(color0, 0u);
 
   // The constructor is private. So make_unique may not be used.
-  return std::unique_ptr<SurfaceVK>(
-      new SurfaceVK(render_target_desc, std::move(swap_callback)));
+  return std::unique_ptr<SurfaceVK>(new SurfaceVK(
+      render_target_desc, std::move(swap_callback), buffer_age));
 }
 
-SurfaceVK::SurfaceVK(const RenderTarget& target, SwapCallback swap_callback)
-    : Surface(target), swap_callback_(std::move(swap_callback)) {}
+SurfaceVK::SurfaceVK(const RenderTarget& target,
+                     SwapCallback swap_callback,
+                     size_t buffer_age)
+    : Surface(target),
+      swap_callback_(std::move(swap_callback)),
+      buffer_age_(buffer_age) {}
 
 SurfaceVK::~SurfaceVK() = default;
 
+size_t SurfaceVK::GetBufferAge() const {
+  return buffer_age_;
+}
+
 bool SurfaceVK::Present() const {
-  return swap_callback_ ? swap_callback_() : false;
+  return swap_callback_ ? swap_callback_(GetPresentationTime()) : false;
 }
 
 }  // namespace impeller
@@ -16,20 +16,33 @@ namespace impeller {
 
 class SurfaceVK final : public Surface {
  public:
-  using SwapCallback = std::function<bool(void)>;
+  using SwapCallback =
+      std::function<bool(std::optional<fml::TimePoint> presentation_time)>;
 
   static std::unique_ptr<SurfaceVK> WrapSwapchainImage(
       const std::shared_ptr<Context>& context,
       std::shared_ptr<SwapchainImageVK>& swapchain_image,
-      SwapCallback swap_callback);
+      SwapCallback swap_callback,
+      size_t buffer_age = 0u);
 
   // |Surface|
   ~SurfaceVK() override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      How many frames ago the contents of the swapchain image were
+  ///             presented, like `EGL_BUFFER_AGE_EXT`. One means the image
+  ///             holds the previous frame. Zero means its contents are
+  ///             unknown.
+  ///
+  size_t GetBufferAge() const;
+
  private:
   SwapCallback swap_callback_;
+  size_t buffer_age_ = 0u;
 
-  SurfaceVK(const RenderTarget& target, SwapCallback swap_callback);
+  SurfaceVK(const RenderTarget& target,
+            SwapCallback swap_callback,
+            size_t buffer_age);
 
   // |Surface|
   bool Present() const override;
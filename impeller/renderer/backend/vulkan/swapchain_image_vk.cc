@@ -47,6 +47,14 @@ void SwapchainImageVK::SetMSAATexture(std::shared_ptr<Texture> msaa_tex) {
   msaa_tex_ = std::move(msaa_tex);
 }
 
+uint64_t SwapchainImageVK::GetPresentedFrame() const {
+  return presented_frame_;
+}
+
+void SwapchainImageVK::SetPresentedFrame(uint64_t frame) {
+  presented_frame_ = frame;
+}
+
 PixelFormat SwapchainImageVK::GetPixelFormat() const {
   return desc_.format;
 }
@@ -40,10 +40,19 @@ class SwapchainImageVK final : public TextureSourceVK {
 
   void SetMSAATexture(std::shared_ptr<Texture> msaa_tex);
 
+  //----------------------------------------------------------------------------
+  /// @brief      The number of the swapchain frame this image was last
+  ///             presented in, or zero if it has not been presented yet.
+  ///
+  uint64_t GetPresentedFrame() const;
+
+  void SetPresentedFrame(uint64_t frame);
+
  private:
   vk::Image image_ = VK_NULL_HANDLE;
   vk::UniqueImageView image_view_ = {};
   std::shared_ptr<Texture> msaa_tex_;
+  uint64_t presented_frame_ = 0u;
   bool is_valid_ = false;
 
   SwapchainImageVK(const SwapchainImageVK&) = delete;
@@ -6,6 +6,7 @@
 
 #include "fml/synchronization/semaphore.h"
 #include "impeller/base/validation.h"
+#include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
@@ -20,6 +21,12 @@ namespace impeller {
 
 static constexpr size_t kMaxFramesInFlight = 3u;
 
+// How much earlier than the presentation time of a frame its image may be
+// presented with VK_GOOGLE_display_timing, so that a present requested for a
+// vsync is not held until the next one by timestamp jitter.
+static constexpr fml::TimeDelta kDisplayTimingMargin =
+    fml::TimeDelta::FromMicroseconds(500);
+
 // Number of frames to poll for orientation changes. For example `1u` means
 // that the orientation will be polled every frame, while `2u` means that the
 // orientation will be polled every other frame.
@@ -126,6 +133,19 @@ static std::optional<vk::CompositeAlphaFlagBitsKHR> ChooseAlphaCompositionMode(
   return std::nullopt;
 }
 
+static vk::PresentModeKHR ChoosePresentMode(
+    const std::vector<vk::PresentModeKHR>& supported_modes,
+    const std::vector<vk::PresentModeKHR>& preferred_modes) {
+  for (const auto& mode : preferred_modes) {
+    if (std::find(supported_modes.begin(), supported_modes.end(), mode) !=
+        supported_modes.end()) {
+      return mode;
+    }
+  }
+  // All surfaces support FIFO.
+  return vk::PresentModeKHR::eFifo;
+}
+
 static std::optional<vk::Queue> ChoosePresentQueue(
     const vk::PhysicalDevice& physical_device,
     const vk::Device& device,
@@ -145,15 +165,17 @@ static std::optional<vk::Queue> ChoosePresentQueue(
 std::shared_ptr<SwapchainImplVK> SwapchainImplVK::Create(
     const std::shared_ptr<Context>& context,
     vk::UniqueSurfaceKHR surface,
+    const SwapchainSettingsVK& settings,
     vk::SwapchainKHR old_swapchain,
     vk::SurfaceTransformFlagBitsKHR last_transform) {
   return std::shared_ptr<SwapchainImplVK>(new SwapchainImplVK(
-      context, std::move(surface), old_swapchain, last_transform));
+      context, std::move(surface), settings, old_swapchain, last_transform));
 }
 
 SwapchainImplVK::SwapchainImplVK(
     const std::shared_ptr<Context>& context,
     vk::UniqueSurfaceKHR surface,
+    const SwapchainSettingsVK& settings,
     vk::SwapchainKHR old_swapchain,
     vk::SurfaceTransformFlagBitsKHR last_transform) {
   if (!context) {
@@ -194,6 +216,14 @@ SwapchainImplVK::SwapchainImplVK(
     return;
   }
 
+  auto [present_modes_result, present_modes] =
+      vk_context.GetPhysicalDevice().getSurfacePresentModesKHR(*surface);
+  if (present_modes_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not get surface present modes: "
+                   << vk::to_string(present_modes_result);
+    return;
+  }
+
   auto present_queue = ChoosePresentQueue(vk_context.GetPhysicalDevice(),  //
                                           vk_context.GetDevice(),          //
                                           *surface                         //
@@ -207,18 +237,23 @@ SwapchainImplVK::SwapchainImplVK(
   swapchain_info.surface = *surface;
   swapchain_info.imageFormat = format.value().format;
   swapchain_info.imageColorSpace = format.value().colorSpace;
-  swapchain_info.presentMode = vk::PresentModeKHR::eFifo;
+  swapchain_info.presentMode =
+      ChoosePresentMode(present_modes, settings.present_modes);
   swapchain_info.imageExtent = vk::Extent2D{
       std::clamp(caps.currentExtent.width, caps.minImageExtent.width,
                  caps.maxImageExtent.width),
       std::clamp(caps.currentExtent.height, caps.minImageExtent.height,
                  caps.maxImageExtent.height),
   };
+  const uint32_t preferred_image_count = settings.image_count == 0u
+                                             ? caps.minImageCount + 1u
+                                             : settings.image_count;
   swapchain_info.minImageCount = std::clamp(
-      caps.minImageCount + 1u,  // preferred image count
-      caps.minImageCount,       // min count cannot be zero
-      caps.maxImageCount == 0u ? caps.minImageCount + 1u
-                               : caps.maxImageCount  // max zero means no limit
+      preferred_image_count,  // preferred image count
+      caps.minImageCount,     // min count cannot be zero
+      caps.maxImageCount == 0u
+          ? std::max(preferred_image_count, caps.minImageCount)
+          : caps.maxImageCount  // max zero means no limit
   );
   swapchain_info.imageArrayLayers = 1u;
   // Swapchain images are primarily used as color attachments (via resolve) or
@@ -297,6 +332,11 @@ SwapchainImplVK::SwapchainImplVK(
   present_queue_ = present_queue.value();
   surface_format_ = swapchain_info.imageFormat;
   swapchain_ = std::move(swapchain);
+  enable_display_timing_ =
+      settings.enable_display_timing &&
+      CapabilitiesVK::Cast(*vk_context.GetCapabilities())
+          .HasOptionalDeviceExtension(
+              OptionalDeviceExtensionVK::kGOOGLEDisplayTiming);
   images_ = std::move(swapchain_images);
   synchronizers_ = std::move(synchronizers);
   current_frame_ = synchronizers_.size() - 1u;
@@ -417,21 +457,28 @@ SwapchainImplVK::AcquireResult SwapchainImplVK::AcquireNextDrawable() {
 
   auto image = images_[index % images_.size()];
   uint32_t image_index = index;
+  size_t buffer_age = image->GetPresentedFrame() == 0u
+                          ? 0u
+                          : presented_frame_count_ + 1u -
+                                image->GetPresentedFrame();
   return AcquireResult{SurfaceVK::WrapSwapchainImage(
       context_strong,  // context
       image,           // swapchain image
-      [weak_swapchain = weak_from_this(), image, image_index]() -> bool {
+      [weak_swapchain = weak_from_this(), image, image_index](
+          std::optional<fml::TimePoint> presentation_time) -> bool {
         auto swapchain = weak_swapchain.lock();
         if (!swapchain) {
           return false;
         }
-        return swapchain->Present(image, image_index);
-      }  // swap callback
+        return swapchain->Present(image, image_index, presentation_time);
+      },          // swap callback
+      buffer_age  // buffer age
       )};
 }
 
 bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
-                              uint32_t index) {
+                              uint32_t index,
+                              std::optional<fml::TimePoint> presentation_time) {
   auto context_strong = context_.lock();
   if (!context_strong) {
     return false;
@@ -455,8 +502,12 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
     BarrierVK barrier;
     barrier.new_layout = vk::ImageLayout::ePresentSrcKHR;
     barrier.cmd_buffer = vk_final_cmd_buffer;
-    barrier.src_access = vk::AccessFlagBits::eColorAttachmentWrite;
-    barrier.src_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+    // The image is either rendered to or, when only part of the frame is
+    // repainted, copied to.
+    barrier.src_access = vk::AccessFlagBits::eColorAttachmentWrite |
+                         vk::AccessFlagBits::eTransferWrite;
+    barrier.src_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput |
+                        vk::PipelineStageFlagBits::eTransfer;
     barrier.dst_access = {};
     barrier.dst_stage = vk::PipelineStageFlagBits::eBottomOfPipe;
 
@@ -491,7 +542,20 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
 
   context.GetGPUTracer()->MarkFrameEnd();
 
-  auto task = [&, index, current_frame = current_frame_] {
+  // The presentation engine holds the image until the time its frame was
+  // scheduled for, so that the frames are paced by the animator even when
+  // they are rendered early.
+  std::optional<vk::PresentTimeGOOGLE> present_time;
+  if (enable_display_timing_ && presentation_time.has_value()) {
+    present_time = vk::PresentTimeGOOGLE{
+        ++present_id_,
+        static_cast<uint64_t>(std::max<int64_t>(
+            0, (presentation_time.value() - kDisplayTimingMargin)
+                   .ToEpochDelta()
+                   .ToNanoseconds()))};
+  }
+
+  auto task = [&, index, current_frame = current_frame_, present_time] {
     auto context_strong = context_.lock();
     if (!context_strong) {
       return;
@@ -509,6 +573,12 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
     present_info.setImageIndices(indices);
     present_info.setWaitSemaphores(*sync->present_ready);
 
+    vk::PresentTimesInfoGOOGLE present_times_info;
+    if (present_time.has_value()) {
+      present_times_info.setTimes(present_time.value());
+      present_info.setPNext(&present_times_info);
+    }
+
     auto result = present_queue_.presentKHR(present_info);
     sync->present_semaphore->Signal();
 
@@ -541,6 +611,7 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
   } else {
     context.GetQueueSubmitRunner()->PostTask(task);
   }
+  image->SetPresentedFrame(++presented_frame_count_);
   return true;
 }
 
@@ -7,9 +7,12 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <variant>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
+#include "impeller/renderer/backend/vulkan/swapchain_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 #include "vulkan/vulkan_enums.hpp"
 
@@ -34,6 +37,7 @@ class SwapchainImplVK final
   static std::shared_ptr<SwapchainImplVK> Create(
       const std::shared_ptr<Context>& context,
       vk::UniqueSurfaceKHR surface,
+      const SwapchainSettingsVK& settings,
       vk::SwapchainKHR old_swapchain = VK_NULL_HANDLE,
       vk::SurfaceTransformFlagBitsKHR last_transform =
           vk::SurfaceTransformFlagBitsKHR::eIdentity);
@@ -69,6 +73,9 @@ class SwapchainImplVK final
   vk::Queue present_queue_ = {};
   vk::Format surface_format_ = vk::Format::eUndefined;
   vk::UniqueSwapchainKHR swapchain_;
+  bool enable_display_timing_ = false;
+  uint32_t present_id_ = 0u;
+  uint64_t presented_frame_count_ = 0u;
   std::vector<std::shared_ptr<SwapchainImageVK>> images_;
   std::vector<std::unique_ptr<FrameSynchronizer>> synchronizers_;
   size_t current_frame_ = 0u;
@@ -78,10 +85,13 @@ class SwapchainImplVK final
 
   SwapchainImplVK(const std::shared_ptr<Context>& context,
                   vk::UniqueSurfaceKHR surface,
+                  const SwapchainSettingsVK& settings,
                   vk::SwapchainKHR old_swapchain,
                   vk::SurfaceTransformFlagBitsKHR last_transform);
 
-  bool Present(const std::shared_ptr<SwapchainImageVK>& image, uint32_t index);
+  bool Present(const std::shared_ptr<SwapchainImageVK>& image,
+               uint32_t index,
+               std::optional<fml::TimePoint> presentation_time);
 
   void WaitIdle() const;
 
@@ -12,17 +12,20 @@ namespace impeller {
 
 std::shared_ptr<SwapchainVK> SwapchainVK::Create(
     const std::shared_ptr<Context>& context,
-    vk::UniqueSurfaceKHR surface) {
-  auto impl = SwapchainImplVK::Create(context, std::move(surface));
+    vk::UniqueSurfaceKHR surface,
+    const SwapchainSettingsVK& settings) {
+  auto impl = SwapchainImplVK::Create(context, std::move(surface), settings);
   if (!impl || !impl->IsValid()) {
     VALIDATION_LOG << "Failed to create SwapchainVK implementation.";
     return nullptr;
   }
-  return std::shared_ptr<SwapchainVK>(new SwapchainVK(std::move(impl)));
+  return std::shared_ptr<SwapchainVK>(
+      new SwapchainVK(std::move(impl), settings));
 }
 
-SwapchainVK::SwapchainVK(std::shared_ptr<SwapchainImplVK> impl)
-    : impl_(std::move(impl)) {}
+SwapchainVK::SwapchainVK(std::shared_ptr<SwapchainImplVK> impl,
+                         const SwapchainSettingsVK& settings)
+    : impl_(std::move(impl)), settings_(settings) {}
 
 SwapchainVK::~SwapchainVK() = default;
 
@@ -37,20 +40,24 @@ std::unique_ptr<Surface> SwapchainVK::AcquireNextDrawable() {
 
   TRACE_EVENT0("impeller", __FUNCTION__);
 
-  auto result = impl_->AcquireNextDrawable();
-  if (!result.out_of_date) {
-    return std::move(result.surface);
+  if (!settings_changed_) {
+    auto result = impl_->AcquireNextDrawable();
+    if (!result.out_of_date) {
+      return std::move(result.surface);
+    }
   }
+  settings_changed_ = false;
 
   TRACE_EVENT0("impeller", "RecreateSwapchain");
 
-  // This swapchain implementation indicates that it is out of date. Tear it
-  // down and make a new one.
+  // This swapchain implementation indicates that it is out of date, or its
+  // settings have changed. Tear it down and make a new one.
   auto context = impl_->GetContext();
   auto [surface, old_swapchain] = impl_->DestroySwapchain();
 
   auto new_impl = SwapchainImplVK::Create(context,                   //
                                           std::move(surface),        //
+                                          settings_,                 //
                                           *old_swapchain,            //
                                           impl_->GetLastTransform()  //
   );
@@ -73,4 +80,9 @@ vk::Format SwapchainVK::GetSurfaceFormat() const {
   return IsValid() ? impl_->GetSurfaceFormat() : vk::Format::eUndefined;
 }
 
+void SwapchainVK::UpdateSettings(const SwapchainSettingsVK& settings) {
+  settings_ = settings;
+  settings_changed_ = true;
+}
+
 }  // namespace impeller
@@ -6,6 +6,7 @@
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_SWAPCHAIN_VK_H_
 
 #include <memory>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
@@ -16,6 +17,29 @@ namespace impeller {
 
 class SwapchainImplVK;
 
+//------------------------------------------------------------------------------
+/// @brief      The configuration of the swapchain images and their
+///             presentation.
+///
+struct SwapchainSettingsVK {
+  /// The present modes to use, the most preferred first. FIFO, which all
+  /// surfaces support, is used when the surface supports none of them.
+  ///
+  /// MAILBOX replaces the queued image instead of waiting for the next vsync,
+  /// which brings the latency below one vsync at the cost of the frames
+  /// rendered but never shown. FIFO_RELAXED presents late frames immediately
+  /// instead of holding them until the next vsync.
+  std::vector<vk::PresentModeKHR> present_modes = {vk::PresentModeKHR::eFifo};
+
+  /// The number of swapchain images to request, clamped to the limits of the
+  /// surface. Zero requests one more than the minimum the surface needs.
+  uint32_t image_count = 0u;
+
+  /// Whether the images are presented no earlier than the presentation times
+  /// of their frames, on devices that support VK_GOOGLE_display_timing.
+  bool enable_display_timing = true;
+};
+
 //------------------------------------------------------------------------------
 /// @brief      A swapchain that adapts to the underlying surface going out of
 ///             date. If the caller cannot acquire the next drawable, it is due
@@ -26,7 +50,8 @@ class SwapchainVK {
  public:
   static std::shared_ptr<SwapchainVK> Create(
       const std::shared_ptr<Context>& context,
-      vk::UniqueSurfaceKHR surface);
+      vk::UniqueSurfaceKHR surface,
+      const SwapchainSettingsVK& settings = {});
 
   ~SwapchainVK();
 
@@ -36,10 +61,19 @@ class SwapchainVK {
 
   vk::Format GetSurfaceFormat() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Recreates the swapchain with the given settings when the next
+  ///             drawable is acquired.
+  ///
+  void UpdateSettings(const SwapchainSettingsVK& settings);
+
  private:
   std::shared_ptr<SwapchainImplVK> impl_;
+  SwapchainSettingsVK settings_;
+  bool settings_changed_ = false;
 
-  explicit SwapchainVK(std::shared_ptr<SwapchainImplVK> impl);
+  SwapchainVK(std::shared_ptr<SwapchainImplVK> impl,
+              const SwapchainSettingsVK& settings);
 
   SwapchainVK(const SwapchainVK&) = delete;
 
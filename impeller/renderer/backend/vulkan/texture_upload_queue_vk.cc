@@ -0,0 +1,256 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/texture_upload_queue_vk.h"
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+#include "impeller/renderer/backend/vulkan/blit_command_vk.h"
+#include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
+#include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
+#include "impeller/renderer/backend/vulkan/texture_vk.h"
+
+namespace impeller {
+
+TextureUploadQueueVK::TextureUploadQueueVK(
+    std::weak_ptr<ContextVK> context,
+    std::shared_ptr<QueueVK> transfer_queue)
+    : context_(std::move(context)),
+      transfer_queue_(std::move(transfer_queue)) {}
+
+TextureUploadQueueVK::~TextureUploadQueueVK() = default;
+
+bool TextureUploadQueueVK::Enqueue(std::shared_ptr<DeviceBuffer> source,
+                                   std::shared_ptr<Texture> texture) {
+  if (!source || !texture) {
+    return false;
+  }
+  auto context = context_.lock();
+  if (!context) {
+    return false;
+  }
+
+  // The command buffers that sample the texture are only submitted after the
+  // upload is flushed, so they may be recorded for the layout the texture has
+  // once it is uploaded.
+  TextureVK::Cast(*texture).SetLayoutWithoutEncoding(
+      vk::ImageLayout::eShaderReadOnlyOptimal);
+
+  bool schedule_flush = false;
+  bool flush_now = false;
+  {
+    Lock lock(pending_mutex_);
+    schedule_flush = pending_.empty();
+    pending_bytes_ +=
+        texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+    pending_.push_back({std::move(source), std::move(texture)});
+    flush_now = pending_.size() >= kMaxBatchedUploads ||
+                pending_bytes_ >= kMaxBatchedBytes;
+  }
+
+  if (flush_now) {
+    Flush();
+  } else if (schedule_flush) {
+    context->GetQueueSubmitRunner()->PostDelayedTask(
+        [weak_queue = weak_from_this()]() {
+          if (auto queue = weak_queue.lock()) {
+            queue->Flush();
+          }
+        },
+        kBatchingDelay);
+  }
+  return true;
+}
+
+void TextureUploadQueueVK::Flush() {
+  Lock flush_lock(flush_mutex_);
+  std::vector<PendingUpload> uploads;
+  {
+    Lock lock(pending_mutex_);
+    uploads.swap(pending_);
+    pending_bytes_ = 0u;
+  }
+  if (uploads.empty()) {
+    return;
+  }
+  auto context = context_.lock();
+  if (!context) {
+    return;
+  }
+  if (!Submit(*context, uploads)) {
+    VALIDATION_LOG << "Could not submit the texture uploads.";
+  }
+}
+
+bool TextureUploadQueueVK::Submit(
+    const ContextVK& context,
+    const std::vector<PendingUpload>& uploads) const {
+  TRACE_EVENT1("impeller", "TextureUploadQueueVK::Submit", "uploads",
+               std::to_string(uploads.size()).c_str());
+  const auto& device = context.GetDevice();
+  const uint32_t transfer_family = transfer_queue_->GetIndex().family;
+  const uint32_t graphics_family =
+      context.GetGraphicsQueue()->GetIndex().family;
+
+  // The pools of the command pool recycler belong to the graphics queue
+  // family, so each batch gets a transient pool of the transfer queue family.
+  vk::CommandPoolCreateInfo pool_info;
+  pool_info.setQueueFamilyIndex(transfer_family);
+  pool_info.setFlags(vk::CommandPoolCreateFlagBits::eTransient);
+  auto [pool_result, pool] = device.createCommandPoolUnique(pool_info);
+  if (pool_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not create transfer command pool: "
+                   << vk::to_string(pool_result);
+    return false;
+  }
+
+  vk::CommandBufferAllocateInfo allocate_info;
+  allocate_info.setCommandPool(pool.get());
+  allocate_info.setLevel(vk::CommandBufferLevel::ePrimary);
+  allocate_info.setCommandBufferCount(1u);
+  auto [buffers_result, buffers] =
+      device.allocateCommandBuffers(allocate_info);
+  if (buffers_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not allocate transfer command buffer: "
+                   << vk::to_string(buffers_result);
+    return false;
+  }
+  const vk::CommandBuffer transfer_cmd = buffers[0];
+
+  auto [semaphore_result, semaphore] = device.createSemaphoreUnique({});
+  auto [fence_result, fence] = device.createFenceUnique({});
+  if (semaphore_result != vk::Result::eSuccess ||
+      fence_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not create transfer synchronization objects.";
+    return false;
+  }
+
+  // The flush may run on threads that never dispose of their command pools.
+  auto encoder_factory = context.CreateGraphicsCommandEncoderFactory();
+  encoder_factory->SetLabel("Texture Upload Acquire");
+  auto encoder = encoder_factory->CreateDetached();
+  if (!encoder) {
+    return false;
+  }
+
+  vk::CommandBufferBeginInfo begin_info;
+  begin_info.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
+  if (transfer_cmd.begin(begin_info) != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not begin transfer command buffer.";
+    return false;
+  }
+
+  std::vector<vk::ImageMemoryBarrier> copy_barriers;
+  std::vector<vk::ImageMemoryBarrier> release_barriers;
+  std::vector<vk::ImageMemoryBarrier> acquire_barriers;
+  for (const auto& upload : uploads) {
+    const auto& texture = TextureVK::Cast(*upload.texture);
+    const bool has_mips = texture.GetTextureDescriptor().mip_count > 1u;
+
+    vk::ImageMemoryBarrier barrier;
+    barrier.image = texture.GetImage();
+    barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+    barrier.subresourceRange.baseMipLevel = 0u;
+    barrier.subresourceRange.levelCount = 1u;
+    barrier.subresourceRange.baseArrayLayer = 0u;
+    barrier.subresourceRange.layerCount = 1u;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.oldLayout = vk::ImageLayout::eUndefined;
+    barrier.newLayout = vk::ImageLayout::eTransferDstOptimal;
+    barrier.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
+    copy_barriers.push_back(barrier);
+
+    // The layout transition to the first layout used on the graphics queue is
+    // part of the ownership transfer, so the release and the acquire barriers
+    // must describe the same one.
+    barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+    barrier.newLayout = has_mips ? vk::ImageLayout::eTransferSrcOptimal
+                                 : vk::ImageLayout::eShaderReadOnlyOptimal;
+    barrier.srcQueueFamilyIndex = transfer_family;
+    barrier.dstQueueFamilyIndex = graphics_family;
+    barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+    barrier.dstAccessMask = {};
+    release_barriers.push_back(barrier);
+
+    barrier.srcAccessMask = {};
+    barrier.dstAccessMask = has_mips ? vk::AccessFlagBits::eTransferRead
+                                     : vk::AccessFlagBits::eShaderRead;
+    acquire_barriers.push_back(barrier);
+
+    if (!encoder->Track(upload.source) || !encoder->Track(upload.texture)) {
+      return false;
+    }
+  }
+
+  transfer_cmd.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe,
+                               vk::PipelineStageFlagBits::eTransfer, {},
+                               nullptr, nullptr, copy_barriers);
+  for (const auto& upload : uploads) {
+    const auto& texture = TextureVK::Cast(*upload.texture);
+    const auto size = texture.GetTextureDescriptor().size;
+    vk::BufferImageCopy image_copy;
+    image_copy.setBufferOffset(0u);
+    image_copy.setBufferRowLength(0u);
+    image_copy.setBufferImageHeight(0u);
+    image_copy.setImageSubresource(
+        vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1));
+    image_copy.setImageOffset(vk::Offset3D(0, 0, 0));
+    image_copy.setImageExtent(vk::Extent3D(size.width, size.height, 1));
+    transfer_cmd.copyBufferToImage(
+        DeviceBufferVK::Cast(*upload.source).GetBuffer(),  //
+        texture.GetImage(),                                //
+        vk::ImageLayout::eTransferDstOptimal,              //
+        image_copy                                         //
+    );
+  }
+  transfer_cmd.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                               vk::PipelineStageFlagBits::eBottomOfPipe, {},
+                               nullptr, nullptr, release_barriers);
+  if (transfer_cmd.end() != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not end transfer command buffer.";
+    return false;
+  }
+
+  const auto& graphics_cmd = encoder->GetCommandBuffer();
+  graphics_cmd.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                               vk::PipelineStageFlagBits::eTransfer |
+                                   vk::PipelineStageFlagBits::eFragmentShader,
+                               {}, nullptr, nullptr, acquire_barriers);
+  for (const auto& upload : uploads) {
+    const auto& texture = TextureVK::Cast(*upload.texture);
+    const auto& desc = texture.GetTextureDescriptor();
+    if (desc.mip_count > 1u) {
+      EncodeMipmapBlitsVK(graphics_cmd, texture.GetImage(), desc.size,
+                          desc.mip_count);
+    }
+  }
+
+  auto shared_semaphore = MakeSharedVK(std::move(semaphore));
+  vk::SubmitInfo submit_info;
+  submit_info.setCommandBuffers(transfer_cmd);
+  submit_info.setSignalSemaphores(shared_semaphore->Get());
+  auto status = transfer_queue_->Submit(submit_info, fence.get());
+  if (status != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Failed to submit transfer queue: "
+                   << vk::to_string(status);
+    return false;
+  }
+
+  // Keep the transfer command pool and the semaphore alive until the transfer
+  // completes, even if the graphics submission fails.
+  context.GetFenceWaiter()->AddFence(
+      std::move(fence),
+      [pool = MakeSharedVK(std::move(pool)), shared_semaphore, uploads]() {});
+
+  if (!encoder->AddWaitSemaphore(shared_semaphore,
+                                 vk::PipelineStageFlagBits::eTransfer)) {
+    return false;
+  }
+  return encoder->Submit();
+}
+
+}  // namespace impeller
@@ -0,0 +1,94 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_TEXTURE_UPLOAD_QUEUE_VK_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_TEXTURE_UPLOAD_QUEUE_VK_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/time/time_delta.h"
+#include "impeller/base/thread.h"
+#include "impeller/core/device_buffer.h"
+#include "impeller/core/texture.h"
+#include "impeller/renderer/backend/vulkan/queue_vk.h"
+
+namespace impeller {
+
+class ContextVK;
+
+//------------------------------------------------------------------------------
+/// @brief      Uploads textures on a dedicated transfer queue, so that heavy
+///             image uploads don't contend with rendering on the graphics
+///             queue.
+///
+///             The uploads are batched: they are recorded into a single
+///             transfer command buffer shortly after the first one of a batch
+///             is enqueued, or as soon as the batch is large enough. The
+///             transfer queue releases the ownership of the textures, and a
+///             graphics command buffer that waits on the transfer acquires
+///             them and generates their mip levels, since blits are not
+///             supported on transfer queues.
+///
+///             The pending uploads are also flushed before any other command
+///             buffer is submitted to the graphics queue, so that the textures
+///             are always uploaded before they are sampled.
+///
+///             This class is thread-safe.
+///
+class TextureUploadQueueVK
+    : public std::enable_shared_from_this<TextureUploadQueueVK> {
+ public:
+  /// The uploads are flushed at most this long after the first upload of a
+  /// batch was enqueued.
+  static constexpr fml::TimeDelta kBatchingDelay =
+      fml::TimeDelta::FromMilliseconds(1);
+
+  /// The uploads are flushed as soon as this many of them are pending.
+  static constexpr size_t kMaxBatchedUploads = 32u;
+
+  /// The uploads are flushed as soon as they copy this many bytes.
+  static constexpr size_t kMaxBatchedBytes = 16u * 1024u * 1024u;
+
+  TextureUploadQueueVK(std::weak_ptr<ContextVK> context,
+                       std::shared_ptr<QueueVK> transfer_queue);
+
+  ~TextureUploadQueueVK();
+
+  /// @brief      Enqueues the upload of `source` to the base mip level of the
+  ///             newly created `texture`, and the generation of its other mip
+  ///             levels.
+  bool Enqueue(std::shared_ptr<DeviceBuffer> source,
+               std::shared_ptr<Texture> texture);
+
+  /// @brief      Submits the pending uploads. Returns once they are submitted
+  ///             to both the transfer and the graphics queues.
+  void Flush();
+
+ private:
+  struct PendingUpload {
+    std::shared_ptr<DeviceBuffer> source;
+    std::shared_ptr<Texture> texture;
+  };
+
+  const std::weak_ptr<ContextVK> context_;
+  const std::shared_ptr<QueueVK> transfer_queue_;
+  // Held while the pending uploads are recorded and submitted, so that a flush
+  // only returns once all the uploads enqueued before it are submitted.
+  Mutex flush_mutex_;
+  Mutex pending_mutex_;
+  std::vector<PendingUpload> pending_ IPLR_GUARDED_BY(pending_mutex_);
+  size_t pending_bytes_ IPLR_GUARDED_BY(pending_mutex_) = 0u;
+
+  bool Submit(const ContextVK& context,
+              const std::vector<PendingUpload>& uploads) const;
+
+  TextureUploadQueueVK(const TextureUploadQueueVK&) = delete;
+
+  TextureUploadQueueVK& operator=(const TextureUploadQueueVK&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_TEXTURE_UPLOAD_QUEUE_VK_H_
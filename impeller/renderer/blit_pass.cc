@@ -122,26 +122,35 @@ bool BlitPass::AddCopy(std::shared_ptr<Texture> source,
 
 bool BlitPass::AddCopy(BufferView source,
                        std::shared_ptr<Texture> destination,
-                       IPoint destination_origin,
+                       std::optional<IRect> destination_region,
                        std::string label) {
   if (!destination) {
     VALIDATION_LOG << "Attempted to add a texture blit with no destination.";
     return false;
   }
 
-  auto bytes_per_pixel =
-      BytesPerPixelForPixelFormat(destination->GetTextureDescriptor().format);
-  auto bytes_per_image =
-      destination->GetTextureDescriptor().size.Area() * bytes_per_pixel;
+  auto texture_bounds =
+      IRect::MakeSize(destination->GetTextureDescriptor().size);
+  auto region = destination_region.value_or(texture_bounds);
+  if (region.IsEmpty() || !texture_bounds.Contains(region)) {
+    VALIDATION_LOG << "Attempted to add a texture blit with an invalid "
+                      "destination region.";
+    return false;
+  }
+
+  auto region_descriptor = destination->GetTextureDescriptor();
+  region_descriptor.size = region.GetSize();
+  region_descriptor.mip_count = 1u;
+  auto bytes_per_region = region_descriptor.GetByteSizeOfBaseMipLevel();
 
-  if (source.range.length != bytes_per_image) {
+  if (source.range.length != bytes_per_region) {
     VALIDATION_LOG
         << "Attempted to add a texture blit with out of bounds access.";
     return false;
   }
 
   return OnCopyBufferToTextureCommand(std::move(source), std::move(destination),
-                                      destination_origin, std::move(label));
+                                      region, std::move(label));
 }
 
 bool BlitPass::GenerateMipmap(std::shared_ptr<Texture> texture,
@@ -73,5 +73,36 @@ TEST_P(BlitPassTest, BlitPassesForMatchingFormats) {
   EXPECT_TRUE(blit_pass->AddCopy(src, dst));
 }
 
+TEST_P(BlitPassTest, BufferToTextureBlitValidatesDestinationRegion) {
+  ScopedValidationDisable scope;  // avoid noise in output.
+  auto context = GetContext();
+  if (!context->GetCapabilities()->SupportsBufferToTextureBlits()) {
+    GTEST_SKIP() << "Backend doesn't support buffer to texture blits.";
+  }
+  auto cmd_buffer = context->CreateCommandBuffer();
+  auto blit_pass = cmd_buffer->CreateBlitPass();
+
+  TextureDescriptor dst_desc;
+  dst_desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  dst_desc.size = {100, 100};
+  auto dst = context->GetResourceAllocator()->CreateTexture(dst_desc);
+
+  DeviceBufferDescriptor src_desc;
+  src_desc.storage_mode = StorageMode::kHostVisible;
+  src_desc.size = 10 * 20 * 4;
+  auto src = context->GetResourceAllocator()->CreateBuffer(src_desc);
+
+  // The buffer only covers a sub-region of the texture.
+  EXPECT_FALSE(blit_pass->AddCopy(DeviceBuffer::AsBufferView(src), dst));
+  EXPECT_TRUE(blit_pass->AddCopy(DeviceBuffer::AsBufferView(src), dst,
+                                 IRect::MakeXYWH(50, 40, 10, 20)));
+  // The region must be within the bounds of the texture.
+  EXPECT_FALSE(blit_pass->AddCopy(DeviceBuffer::AsBufferView(src), dst,
+                                  IRect::MakeXYWH(95, 40, 10, 20)));
+  // The buffer must match the size of the region exactly.
+  EXPECT_FALSE(blit_pass->AddCopy(DeviceBuffer::AsBufferView(src), dst,
+                                  IRect::MakeXYWH(0, 0, 10, 10)));
+}
+
 }  // namespace testing
 }  // namespace impeller
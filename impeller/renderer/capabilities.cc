@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/capabilities.h"
 
+#include <utility>
+
 namespace impeller {
 
 Capabilities::Capabilities() = default;
@@ -78,6 +80,11 @@ class StandardCapabilities final : public Capabilities {
     return supports_device_transient_textures_;
   }
 
+  // |Capabilities|
+  bool SupportsCompressedTextureFormat(PixelFormat format) const override {
+    return compressed_texture_formats_.count(format) > 0;
+  }
+
  private:
   StandardCapabilities(bool supports_offscreen_msaa,
                        bool supports_ssbo,
@@ -89,6 +96,7 @@ class StandardCapabilities final : public Capabilities {
                        bool supports_read_from_resolve,
                        bool supports_decal_sampler_address_mode,
                        bool supports_device_transient_textures,
+                       std::set<PixelFormat> compressed_texture_formats,
                        PixelFormat default_color_format,
                        PixelFormat default_stencil_format,
                        PixelFormat default_depth_stencil_format)
@@ -103,6 +111,7 @@ class StandardCapabilities final : public Capabilities {
         supports_decal_sampler_address_mode_(
             supports_decal_sampler_address_mode),
         supports_device_transient_textures_(supports_device_transient_textures),
+        compressed_texture_formats_(std::move(compressed_texture_formats)),
         default_color_format_(default_color_format),
         default_stencil_format_(default_stencil_format),
         default_depth_stencil_format_(default_depth_stencil_format) {}
@@ -119,6 +128,7 @@ class StandardCapabilities final : public Capabilities {
   bool supports_read_from_resolve_ = false;
   bool supports_decal_sampler_address_mode_ = false;
   bool supports_device_transient_textures_ = false;
+  std::set<PixelFormat> compressed_texture_formats_;
   PixelFormat default_color_format_ = PixelFormat::kUnknown;
   PixelFormat default_stencil_format_ = PixelFormat::kUnknown;
   PixelFormat default_depth_stencil_format_ = PixelFormat::kUnknown;
@@ -207,6 +217,17 @@ CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsDeviceTransientTextures(
   return *this;
 }
 
+CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsCompressedTextureFormat(
+    PixelFormat format,
+    bool value) {
+  if (value && IsCompressed(format)) {
+    compressed_texture_formats_.insert(format);
+  } else {
+    compressed_texture_formats_.erase(format);
+  }
+  return *this;
+}
+
 std::unique_ptr<Capabilities> CapabilitiesBuilder::Build() {
   return std::unique_ptr<StandardCapabilities>(new StandardCapabilities(  //
       supports_offscreen_msaa_,                                           //
@@ -219,6 +240,7 @@ std::unique_ptr<Capabilities> CapabilitiesBuilder::Build() {
       supports_read_from_resolve_,                                        //
       supports_decal_sampler_address_mode_,                               //
       supports_device_transient_textures_,                                //
+      compressed_texture_formats_,                                        //
       default_color_format_.value_or(PixelFormat::kUnknown),              //
       default_stencil_format_.value_or(PixelFormat::kUnknown),            //
       default_depth_stencil_format_.value_or(PixelFormat::kUnknown)       //
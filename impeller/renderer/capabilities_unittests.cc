@@ -57,5 +57,25 @@ TEST(CapabilitiesTest, DefaultDepthStencilFormat) {
             PixelFormat::kD32FloatS8UInt);
 }
 
+TEST(CapabilitiesTest, CompressedTextureFormats) {
+  auto defaults = CapabilitiesBuilder().Build();
+  ASSERT_FALSE(
+      defaults->SupportsCompressedTextureFormat(PixelFormat::kASTC4x4UNormInt));
+  auto mutated =
+      CapabilitiesBuilder()
+          .SetSupportsCompressedTextureFormat(PixelFormat::kASTC4x4UNormInt,
+                                              true)
+          .SetSupportsCompressedTextureFormat(PixelFormat::kR8G8B8A8UNormInt,
+                                              true)
+          .Build();
+  ASSERT_TRUE(
+      mutated->SupportsCompressedTextureFormat(PixelFormat::kASTC4x4UNormInt));
+  ASSERT_FALSE(
+      mutated->SupportsCompressedTextureFormat(PixelFormat::kBC7UNormInt));
+  // Uncompressed formats are never reported.
+  ASSERT_FALSE(
+      mutated->SupportsCompressedTextureFormat(PixelFormat::kR8G8B8A8UNormInt));
+}
+
 }  // namespace testing
 }  // namespace impeller
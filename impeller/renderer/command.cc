@@ -101,4 +101,42 @@ bool Command::BindResource(ShaderStage stage,
   return false;
 }
 
+void Command::Reset() {
+  Bindings vertex = std::move(vertex_bindings);
+  Bindings fragment = std::move(fragment_bindings);
+  *this = Command{};
+  for (Bindings* bindings : {&vertex, &fragment}) {
+    bindings->sampled_images.clear();
+    bindings->buffers.clear();
+  }
+  vertex_bindings = std::move(vertex);
+  fragment_bindings = std::move(fragment);
+}
+
+std::shared_ptr<RenderPassCommands> RenderPassCommands::Create() {
+  return std::make_shared<RenderPassCommands>();
+}
+
+Command RenderPassCommands::TakeSpare() {
+  if (spares.empty()) {
+    return Command{};
+  }
+  Command command = std::move(spares.back());
+  spares.pop_back();
+  return command;
+}
+
+size_t RenderPassCommands::GetSize() const {
+  return (commands.capacity() + spares.capacity()) * sizeof(Command);
+}
+
+void RenderPassCommands::Reset() {
+  spares.reserve(spares.size() + commands.size());
+  for (Command& command : commands) {
+    command.Reset();
+    spares.emplace_back(std::move(command));
+  }
+  commands.clear();
+}
+
 }  // namespace impeller
@@ -9,6 +9,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "impeller/core/buffer_view.h"
 #include "impeller/core/formats.h"
@@ -18,6 +19,7 @@
 #include "impeller/core/texture.h"
 #include "impeller/core/vertex_buffer.h"
 #include "impeller/geometry/rect.h"
+#include "impeller/renderer/draw_category.h"
 #include "impeller/renderer/pipeline.h"
 
 namespace impeller {
@@ -110,6 +112,12 @@ struct Command : public ResourceBinder {
   /// The debugging label to use for the command.
   ///
   std::string label;
+
+  //----------------------------------------------------------------------------
+  /// The kind of contents this command draws, used by GPU tracers to
+  /// attribute the GPU time of a frame.
+  ///
+  DrawCategory category = DrawCategory::kOther;
 #endif  // IMPELLER_DEBUG
 
   //----------------------------------------------------------------------------
@@ -180,6 +188,13 @@ struct Command : public ResourceBinder {
 
   bool IsValid() const { return pipeline && pipeline->IsValid(); }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Releases the pipeline and the resources referenced by this
+  ///             command and resets it to its defaults, but keeps the storage
+  ///             of its bindings so that it can be reused for another draw.
+  ///
+  void Reset();
+
  private:
   template <class T>
   bool DoBindResource(ShaderStage stage,
@@ -188,6 +203,35 @@ struct Command : public ResourceBinder {
                       BufferView view);
 };
 
+//------------------------------------------------------------------------------
+/// @brief      The storage of the commands of a render pass, which is pooled
+///             by its context so that the passes of later frames don't
+///             allocate their commands and bindings again.
+///
+struct RenderPassCommands {
+  /// The commands recorded by the render pass.
+  std::vector<Command> commands;
+  /// The reset commands that the render pass records its next draws in.
+  std::vector<Command> spares;
+
+  static std::shared_ptr<RenderPassCommands> Create();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Takes a reset command to record a draw in.
+  ///
+  Command TakeSpare();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The approximate size of the storage in bytes.
+  ///
+  size_t GetSize() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Resets the recorded commands and makes them spares.
+  ///
+  void Reset();
+};
+
 }  // namespace impeller
 
 #endif  // FLUTTER_IMPELLER_RENDERER_COMMAND_H_
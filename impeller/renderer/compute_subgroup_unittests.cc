@@ -27,6 +27,7 @@
 #include "impeller/renderer/compute_command.h"
 #include "impeller/renderer/compute_pipeline_builder.h"
 #include "impeller/renderer/compute_tessellator.h"
+#include "impeller/renderer/fill.comp.h"
 #include "impeller/renderer/path_polyline.comp.h"
 #include "impeller/renderer/pipeline_library.h"
 #include "impeller/renderer/render_pass.h"
@@ -467,5 +468,62 @@ TEST_P(ComputeSubgroupTest, QuadAndCubicInOnePath) {
   }
 }
 
+TEST_P(ComputeSubgroupTest, FillFanWindingMatchesPathArea) {
+  using FS = FillComputeShader;
+
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+  ASSERT_TRUE(context->GetCapabilities()->SupportsComputeSubgroups());
+
+  auto vertex_buffer = CreateHostVisibleDeviceBuffer<FS::VertexBuffer<2048>>(
+      context, "VertexBuffer");
+  auto vertex_buffer_count =
+      CreateHostVisibleDeviceBuffer<FS::VertexBufferCount>(context,
+                                                           "VertexBufferCount");
+
+  // Two disjoint contours, the second of which is left open.
+  auto path = PathBuilder{}
+                  .AddRect(Rect::MakeXYWH(0, 0, 100, 100))
+                  .MoveTo({200, 0})
+                  .LineTo({250, 0})
+                  .LineTo({250, 50})
+                  .LineTo({200, 50})
+                  .TakePath();
+
+  fml::AutoResetWaitableEvent latch;
+
+  auto host_buffer = HostBuffer::Create(context->GetResourceAllocator());
+  auto status =
+      ComputeTessellator{}
+          .SetStyle(ComputeTessellator::Style::kFill)
+          .Tessellate(path, *host_buffer, context,
+                      DeviceBuffer::AsBufferView(vertex_buffer),
+                      DeviceBuffer::AsBufferView(vertex_buffer_count),
+                      [&latch](CommandBuffer::Status status) {
+                        EXPECT_EQ(status, CommandBuffer::Status::kCompleted);
+                        latch.Signal();
+                      });
+
+  ASSERT_EQ(status, ComputeTessellator::Status::kOk);
+  latch.Wait();
+
+  auto vertex_count = reinterpret_cast<FS::VertexBufferCount*>(
+                          vertex_buffer_count->OnGetContents())
+                          ->count;
+  ASSERT_GT(vertex_count, 0u);
+  ASSERT_EQ(vertex_count % 3, 0u);
+
+  auto vertex_buffer_data =
+      reinterpret_cast<FS::VertexBuffer<2048>*>(vertex_buffer->OnGetContents());
+  Scalar area = 0;
+  for (size_t i = 0; i < vertex_count; i += 3) {
+    Point a = vertex_buffer_data->position[i];
+    Point b = vertex_buffer_data->position[i + 1];
+    Point c = vertex_buffer_data->position[i + 2];
+    area += (b - a).Cross(c - a) / 2;
+  }
+  EXPECT_NEAR(std::abs(area), 100 * 100 + 50 * 50, 1e-2);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -5,8 +5,10 @@
 #include "impeller/renderer/compute_tessellator.h"
 
 #include <cstdint>
+#include <optional>
 
 #include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/fill.comp.h"
 #include "impeller/renderer/path_polyline.comp.h"
 #include "impeller/renderer/pipeline_library.h"
 #include "impeller/renderer/stroke.comp.h"
@@ -67,15 +69,19 @@ ComputeTessellator::Status ComputeTessellator::Tessellate(
     BufferView vertex_buffer,
     BufferView vertex_buffer_count,
     const CommandBuffer::CompletionCallback& callback) const {
-  FML_DCHECK(style_ == Style::kStroke);
   using PS = PathPolylineComputeShader;
   using SS = StrokeComputeShader;
+  using FS = FillComputeShader;
 
   auto cubic_count = path.GetComponentCount(Path::ComponentType::kCubic);
   auto quad_count = path.GetComponentCount(Path::ComponentType::kQuadratic) +
                     (cubic_count * 6);
   auto line_count =
       path.GetComponentCount(Path::ComponentType::kLinear) + (quad_count * 6);
+  if (style_ == Style::kFill) {
+    // Each contour may get a closing line and lines to and from the fan pivot.
+    line_count += path.GetComponentCount(Path::ComponentType::kContour) * 3;
+  }
   if (cubic_count > kMaxCubicCount || quad_count > kMaxQuadCount ||
       line_count > kMaxLineCount) {
     return Status::kTooManyComponents;
@@ -87,26 +93,64 @@ ComputeTessellator::Status ComputeTessellator::Tessellate(
   PS::Config config{.cubic_accuracy = cubic_accuracy_,
                     .quad_tolerance = quad_tolerance_};
 
+  auto add_line = [&lines, &components](const LinearPathComponent& linear) {
+    ::memcpy(&lines.data[lines.count], &linear, sizeof(LinearPathComponent));
+    components.data[components.count++] = {lines.count++, 2};
+  };
+
+  // Fills are rendered as a fan around the first point of the path. The
+  // polyline is continuous, so every contour is closed and then connected to
+  // the next one through the pivot. Edges that touch the pivot produce empty
+  // fan triangles and don't contribute to the winding.
+  const bool is_fill = style_ == Style::kFill;
+  std::optional<Point> pivot;
+  std::optional<Point> contour_start;
+  Point current_point;
+  auto finish_contour = [&]() {
+    if (!is_fill || !contour_start.has_value()) {
+      return;
+    }
+    if (current_point != contour_start.value()) {
+      add_line(LinearPathComponent(current_point, contour_start.value()));
+    }
+    if (contour_start.value() != pivot.value()) {
+      add_line(LinearPathComponent(contour_start.value(), pivot.value()));
+    }
+    current_point = pivot.value();
+  };
+
   path.EnumerateComponents(
-      [&lines, &components](size_t index, const LinearPathComponent& linear) {
-        ::memcpy(&lines.data[lines.count], &linear,
-                 sizeof(LinearPathComponent));
-        components.data[components.count++] = {lines.count++, 2};
+      [&](size_t index, const LinearPathComponent& linear) {
+        add_line(linear);
+        current_point = linear.p2;
       },
-      [&quads, &components](size_t index, const QuadraticPathComponent& quad) {
+      [&](size_t index, const QuadraticPathComponent& quad) {
         ::memcpy(&quads.data[quads.count], &quad,
                  sizeof(QuadraticPathComponent));
         components.data[components.count++] = {quads.count++, 3};
+        current_point = quad.p2;
       },
-      [&cubics, &components](size_t index, const CubicPathComponent& cubic) {
+      [&](size_t index, const CubicPathComponent& cubic) {
         ::memcpy(&cubics.data[cubics.count], &cubic,
                  sizeof(CubicPathComponent));
         components.data[components.count++] = {cubics.count++, 4};
+        current_point = cubic.p2;
       },
-      [](size_t index, const ContourComponent& contour) {});
+      [&](size_t index, const ContourComponent& contour) {
+        finish_contour();
+        if (!pivot.has_value()) {
+          pivot = contour.destination;
+        } else if (is_fill && contour.destination != pivot.value()) {
+          add_line(LinearPathComponent(pivot.value(), contour.destination));
+        }
+        contour_start = contour.destination;
+        current_point = contour.destination;
+      });
+  finish_contour();
 
   auto polyline_buffer =
-      CreateDeviceBuffer<PS::Polyline<2048>>(context, "Polyline");
+      CreateDeviceBuffer<PS::Polyline<kMaxPolylinePointCount>>(context,
+                                                               "Polyline");
 
   auto cmd_buffer = context->CreateCommandBuffer();
   auto pass = cmd_buffer->CreateComputePass();
@@ -140,7 +184,30 @@ ComputeTessellator::Status ComputeTessellator::Tessellate(
     }
   }
 
-  {
+  if (is_fill) {
+    using FillPipelineBuilder = ComputePipelineBuilder<FS>;
+    auto pipeline_desc =
+        FillPipelineBuilder::MakeDefaultPipelineDescriptor(*context);
+    FML_DCHECK(pipeline_desc.has_value());
+    auto compute_pipeline =
+        context->GetPipelineLibrary()->GetPipeline(pipeline_desc).Get();
+    FML_DCHECK(compute_pipeline);
+
+    pass->SetGridSize(ISize(line_count, 1));
+    pass->SetThreadGroupSize(ISize(line_count, 1));
+
+    ComputeCommand cmd;
+    DEBUG_COMMAND_INFO(cmd, "Compute Fill");
+    cmd.pipeline = compute_pipeline;
+
+    FS::BindPolyline(cmd, DeviceBuffer::AsBufferView(polyline_buffer));
+    FS::BindVertexBufferCount(cmd, std::move(vertex_buffer_count));
+    FS::BindVertexBuffer(cmd, std::move(vertex_buffer));
+
+    if (!pass->AddCommand(std::move(cmd))) {
+      return Status::kCommandInvalid;
+    }
+  } else {
     using StrokePipelineBuilder = ComputePipelineBuilder<SS>;
     auto pipeline_desc =
         StrokePipelineBuilder::MakeDefaultPipelineDescriptor(*context);
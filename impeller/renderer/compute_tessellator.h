@@ -28,6 +28,9 @@ class ComputeTessellator {
   static constexpr size_t kMaxLineCount = 4096;
   static constexpr size_t kMaxComponentCount =
       kMaxCubicCount + kMaxQuadCount + kMaxLineCount;
+  /// The maximum number of polyline points either style can be generated
+  /// from.
+  static constexpr size_t kMaxPolylinePointCount = 2048;
 
   enum class Status {
     kCommandInvalid,
@@ -37,7 +40,12 @@ class ComputeTessellator {
 
   enum class Style {
     kStroke,
-    // TODO(dnfield): Implement kFill.
+    /// Generates a triangle fan for every edge of the path, pivoting on the
+    /// first point. Every contour is closed and connected back to the pivot,
+    /// so the signed areas of the triangles sum to the winding of the path.
+    /// The triangles overlap and must be rendered using stencil-then-cover
+    /// with the path's fill type.
+    kFill,
   };
 
   ComputeTessellator& SetStyle(Style value);
@@ -5,15 +5,59 @@
 #include "impeller/renderer/context.h"
 
 #include "impeller/core/capture.h"
+#include "impeller/renderer/command.h"
 
 namespace impeller {
 
 Context::~Context() = default;
 
-Context::Context() : capture(CaptureContext::MakeInactive()) {}
+namespace {
+
+// The most memory that the storage of the commands of the render passes of a
+// context is allowed to hold on to between frames.
+constexpr uint32_t kRenderPassCommandsPoolLimit = 4u * 1024u * 1024u;
+
+}  // namespace
+
+Context::Context()
+    : capture(CaptureContext::MakeInactive()),
+      render_pass_commands_pool_(kRenderPassCommandsPoolLimit) {}
+
+Pool<RenderPassCommands>& Context::GetRenderPassCommandsPool() const {
+  return render_pass_commands_pool_;
+}
 
 bool Context::UpdateOffscreenLayerPixelFormat(PixelFormat format) {
   return false;
 }
 
+std::shared_ptr<fml::ConcurrentTaskRunner>
+Context::GetConcurrentEncodingTaskRunner() const {
+  return nullptr;
+}
+
+std::shared_ptr<fml::ConcurrentTaskRunner>
+Context::GetConcurrentWorkerTaskRunner() const {
+  return nullptr;
+}
+
+std::optional<fml::TimeDelta> Context::GetLastGPUFrameTime() const {
+  return std::nullopt;
+}
+
+std::optional<DrawCategoryTimes> Context::GetLastGPUFrameTimeByCategory()
+    const {
+  return std::nullopt;
+}
+
+std::optional<PipelineStatistics> Context::GetLastGPUFramePipelineStatistics()
+    const {
+  return std::nullopt;
+}
+
+bool Context::EnqueueTextureUpload(std::shared_ptr<DeviceBuffer> source,
+                                   std::shared_ptr<Texture> texture) {
+  return false;
+}
+
 }  // namespace impeller
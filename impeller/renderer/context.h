@@ -6,13 +6,18 @@
 #define FLUTTER_IMPELLER_RENDERER_CONTEXT_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/time/time_delta.h"
 #include "impeller/core/allocator.h"
 #include "impeller/core/capture.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/host_buffer.h"
 #include "impeller/renderer/capabilities.h"
+#include "impeller/renderer/draw_category.h"
+#include "impeller/renderer/gpu_statistics.h"
 #include "impeller/renderer/pool.h"
 #include "impeller/renderer/sampler_library.h"
 
@@ -20,7 +25,9 @@ namespace impeller {
 
 class ShaderLibrary;
 class CommandBuffer;
+class FrameCapture;
 class PipelineLibrary;
+struct RenderPassCommands;
 
 //------------------------------------------------------------------------------
 /// @brief      To do anything rendering related with Impeller, you need a
@@ -163,6 +170,46 @@ class Context {
   ///
   virtual std::shared_ptr<CommandBuffer> CreateCommandBuffer() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      A task runner on which render passes recorded into distinct
+  ///             command buffers may be encoded concurrently.
+  ///
+  ///             Submission order is still controlled by the caller. Backends
+  ///             whose native command encoding is not safe to perform off of
+  ///             the thread that created the command buffer return `nullptr`,
+  ///             in which case callers must encode inline.
+  ///
+  /// @return     The concurrent encoding task runner or `nullptr`.
+  ///
+  virtual std::shared_ptr<fml::ConcurrentTaskRunner>
+  GetConcurrentEncodingTaskRunner() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      A task runner for CPU work that does not touch the GPU, such
+  ///             as rasterizing glyphs, that may be split across threads.
+  ///
+  /// @return     The concurrent worker task runner or `nullptr` if the
+  ///             backend doesn't own one.
+  ///
+  virtual std::shared_ptr<fml::ConcurrentTaskRunner>
+  GetConcurrentWorkerTaskRunner() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Enqueues the upload of `source` to the base mip level of a
+  ///             newly created `texture`, followed by the generation of its
+  ///             other mip levels, on a queue other than the one that renders.
+  ///
+  ///             The texture may be used by any command buffer submitted after
+  ///             this call returns. Backends may batch several uploads into a
+  ///             single submission.
+  ///
+  /// @return     Whether the upload was enqueued. Backends without a dedicated
+  ///             transfer queue return false, in which case callers must
+  ///             encode the upload in a blit pass.
+  ///
+  virtual bool EnqueueTextureUpload(std::shared_ptr<DeviceBuffer> source,
+                                    std::shared_ptr<Texture> texture);
+
   //----------------------------------------------------------------------------
   /// @brief      Force all pending asynchronous work to finish. This is
   ///             achieved by deleting all owned concurrent message loops.
@@ -180,8 +227,51 @@ class Context {
   ///             pending work.
   virtual void SetSyncPresentation(bool value) {}
 
+  //----------------------------------------------------------------------------
+  /// @brief      The GPU time of the most recent frame measured by the GPU
+  ///             tracer of this context, or nullopt if GPU tracing is disabled
+  ///             or no frame was measured yet.
+  ///
+  ///             The GPU times are measured asynchronously, so this is usually
+  ///             the time of a frame submitted shortly before the last one.
+  ///
+  virtual std::optional<fml::TimeDelta> GetLastGPUFrameTime() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The GPU time of the most recent frame measured by the GPU
+  ///             tracer of this context, split by the category of the draws,
+  ///             or nullopt if the backend doesn't attribute GPU time to
+  ///             draws.
+  ///
+  ///             The time spent outside of draws, such as clearing and
+  ///             resolving render targets, isn't attributed to any category.
+  ///
+  virtual std::optional<DrawCategoryTimes> GetLastGPUFrameTimeByCategory()
+      const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The pipeline statistics of the most recent frame measured by
+  ///             the GPU tracer of this context, or nullopt if the device
+  ///             doesn't support counting them.
+  ///
+  virtual std::optional<PipelineStatistics> GetLastGPUFramePipelineStatistics()
+      const;
+
   CaptureContext capture;
 
+  //----------------------------------------------------------------------------
+  /// @brief      When set, every render pass encoded by this context is
+  ///             recorded into this capture so that the frame can be replayed
+  ///             offline. Set and clear it in between frames.
+  ///
+  std::shared_ptr<FrameCapture> frame_capture;
+
+  //----------------------------------------------------------------------------
+  /// @brief      When set, the bandwidth estimate of every render pass encoded
+  ///             by this context is recorded into this recorder.
+  ///
+  std::shared_ptr<RenderPassBandwidthRecorder> bandwidth_recorder;
+
   /// Stores a task on the `ContextMTL` that is awaiting access for the GPU.
   ///
   /// The task will be executed in the event that the GPU access has changed to
@@ -195,12 +285,24 @@ class Context {
     FML_CHECK(false && "not supported in this context");
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      The pool of the command storage of the render passes created
+  ///             by this context. Passes take their storage from it and
+  ///             return it when they are collected, so that the passes of the
+  ///             following frames reuse it.
+  ///
+  ///             Threadsafe.
+  ///
+  Pool<RenderPassCommands>& GetRenderPassCommandsPool() const;
+
  protected:
   Context();
 
   std::vector<std::function<void()>> per_frame_task_;
 
  private:
+  mutable Pool<RenderPassCommands> render_pass_commands_pool_;
+
   Context(const Context&) = delete;
 
   Context& operator=(const Context&) = delete;
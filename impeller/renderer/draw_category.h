@@ -0,0 +1,57 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_DRAW_CATEGORY_H_
+#define FLUTTER_IMPELLER_RENDERER_DRAW_CATEGORY_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/fml/time/time_delta.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      The kind of contents a draw renders, used to attribute the GPU
+///             time of a frame to the widgets that cost it.
+///
+enum class DrawCategory : uint8_t {
+  kOther,
+  kText,
+  kBlur,
+  kGradient,
+  kRuntimeEffect,
+  kClip,
+  kLast = kClip,
+};
+
+static constexpr size_t kDrawCategoryCount =
+    static_cast<size_t>(DrawCategory::kLast) + 1;
+
+/// The GPU time of a frame spent on the draws of each category, indexed by
+/// |DrawCategory|.
+using DrawCategoryTimes = std::array<fml::TimeDelta, kDrawCategoryCount>;
+
+constexpr const char* DrawCategoryToString(DrawCategory category) {
+  switch (category) {
+    case DrawCategory::kOther:
+      return "Other";
+    case DrawCategory::kText:
+      return "Text";
+    case DrawCategory::kBlur:
+      return "Blur";
+    case DrawCategory::kGradient:
+      return "Gradient";
+    case DrawCategory::kRuntimeEffect:
+      return "RuntimeEffect";
+    case DrawCategory::kClip:
+      return "Clip";
+  }
+  return "Unknown";
+}
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_DRAW_CATEGORY_H_
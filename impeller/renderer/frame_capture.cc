@@ -0,0 +1,1031 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/frame_capture.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <unordered_set>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/time/time_point.h"
+#include "impeller/archivist/archive.h"
+#include "impeller/archivist/archive_location.h"
+#include "impeller/base/validation.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/device_buffer.h"
+#include "impeller/core/sampler.h"
+#include "impeller/core/texture.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/context.h"
+#include "impeller/renderer/pipeline.h"
+#include "impeller/renderer/pipeline_library.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/shader_function.h"
+#include "impeller/renderer/shader_library.h"
+#include "impeller/renderer/vertex_descriptor.h"
+
+namespace impeller {
+
+namespace {
+
+template <class T>
+bool WriteMember(ArchiveLocation& item, const std::string& name, const T& v) {
+  return item.Write(name, v);
+}
+
+bool WriteMember(ArchiveLocation& item,
+                 const std::string& name,
+                 const std::shared_ptr<Allocation>& allocation) {
+  if (!allocation) {
+    return item.Write(name, Allocation{});
+  }
+  return item.Write(name, *allocation);
+}
+
+template <class T>
+bool ReadMember(ArchiveLocation& item, const std::string& name, T& v) {
+  return item.Read(name, v);
+}
+
+bool ReadMember(ArchiveLocation& item,
+                const std::string& name,
+                std::shared_ptr<Allocation>& allocation) {
+  allocation = std::make_shared<Allocation>();
+  return item.Read(name, *allocation);
+}
+
+}  // namespace
+
+#define _CAPTURED_MEMBER_NAME(member) #member,
+#define _CAPTURED_MEMBER_WRITE(member) &&WriteMember(item, #member, member)
+#define _CAPTURED_MEMBER_READ(member) &&ReadMember(item, #member, member)
+
+#define _DEFINE_CAPTURED_RECORD(record, for_each_member)   \
+  const ArchiveDef record::kArchiveDefinition = {          \
+      .table_name = #record,                               \
+      .members = {for_each_member(_CAPTURED_MEMBER_NAME)}, \
+  };                                                       \
+                                                           \
+  bool record::Write(ArchiveLocation& item) const {        \
+    return true for_each_member(_CAPTURED_MEMBER_WRITE);   \
+  }                                                        \
+                                                           \
+  bool record::Read(ArchiveLocation& item) {               \
+    return true for_each_member(_CAPTURED_MEMBER_READ);    \
+  }
+
+#define _FOR_EACH_CAPTURED_BUFFER_MEMBER(V) V(id) V(contents)
+
+#define _FOR_EACH_CAPTURED_TEXTURE_MEMBER(V)                              \
+  V(id) V(storage_mode) V(type) V(format) V(width) V(height) V(mip_count) \
+  V(usage) V(sample_count) V(compression_type)
+
+#define _FOR_EACH_CAPTURED_STAGE_INPUT_MEMBER(V)                         \
+  V(name) V(location) V(set) V(binding) V(type) V(bit_width) V(vec_size) \
+  V(columns) V(offset)
+
+#define _FOR_EACH_CAPTURED_STAGE_LAYOUT_MEMBER(V) V(stride) V(binding)
+
+#define _FOR_EACH_CAPTURED_DESCRIPTOR_SET_LAYOUT_MEMBER(V) \
+  V(binding) V(descriptor_type) V(shader_stage)
+
+#define _FOR_EACH_CAPTURED_COLOR_ATTACHMENT_DESCRIPTOR_MEMBER(V)        \
+  V(index) V(format) V(blending_enabled) V(src_color_blend_factor)      \
+  V(color_blend_op) V(dst_color_blend_factor) V(src_alpha_blend_factor) \
+  V(alpha_blend_op) V(dst_alpha_blend_factor) V(write_mask)
+
+#define _FOR_EACH_CAPTURED_STENCIL_ATTACHMENT_DESCRIPTOR_MEMBER(V)    \
+  V(back_face) V(stencil_compare) V(stencil_failure) V(depth_failure) \
+  V(depth_stencil_pass) V(read_mask) V(write_mask)
+
+#define _FOR_EACH_CAPTURED_PIPELINE_MEMBER(V)                             \
+  V(id) V(label) V(vertex_function) V(fragment_function) V(sample_count)  \
+  V(cull_mode) V(winding_order) V(primitive_type) V(polygon_mode)         \
+  V(depth_pixel_format) V(stencil_pixel_format) V(has_depth_attachment)   \
+  V(depth_compare) V(depth_write_enabled) V(use_subpass_input)            \
+  V(specialization_constants) V(color_attachments) V(stencil_attachments) \
+  V(stage_inputs) V(stage_layouts) V(descriptor_set_layouts)
+
+#define _FOR_EACH_CAPTURED_SHADER_STRUCT_MEMBER_MEMBER(V)            \
+  V(type) V(name) V(offset) V(size) V(byte_length) V(array_elements)
+
+#define _FOR_EACH_CAPTURED_BINDING_MEMBER(V)                               \
+  V(stage) V(is_texture) V(slot_name) V(slot_index) V(slot_set)            \
+  V(slot_binding) V(metadata_name) V(metadata_members) V(buffer_id)        \
+  V(buffer_offset) V(buffer_length) V(texture_id) V(min_filter)            \
+  V(mag_filter) V(mip_filter) V(width_address_mode) V(height_address_mode) \
+  V(depth_address_mode)
+
+#define _FOR_EACH_CAPTURED_COMMAND_MEMBER(V)                         \
+  V(label) V(pipeline_id) V(stencil_reference) V(base_vertex)        \
+  V(instance_count) V(has_viewport) V(viewport_x) V(viewport_y)      \
+  V(viewport_width) V(viewport_height) V(viewport_z_near)            \
+  V(viewport_z_far) V(has_scissor) V(scissor_x) V(scissor_y)         \
+  V(scissor_width) V(scissor_height) V(vertex_buffer_id)             \
+  V(vertex_buffer_offset) V(vertex_buffer_length) V(index_buffer_id) \
+  V(index_buffer_offset) V(index_buffer_length) V(vertex_count)      \
+  V(index_type) V(bindings)
+
+#define _FOR_EACH_CAPTURED_ATTACHMENT_MEMBER(V)                            \
+  V(index) V(texture_id) V(resolve_texture_id) V(load_action)              \
+  V(store_action) V(clear_red) V(clear_green) V(clear_blue) V(clear_alpha) \
+  V(clear_depth) V(clear_stencil)
+
+#define _FOR_EACH_CAPTURED_RENDER_PASS_MEMBER(V)                               \
+  V(color_attachments) V(depth_attachments) V(stencil_attachments) V(commands)
+
+_DEFINE_CAPTURED_RECORD(CapturedBuffer, _FOR_EACH_CAPTURED_BUFFER_MEMBER)
+_DEFINE_CAPTURED_RECORD(CapturedTexture, _FOR_EACH_CAPTURED_TEXTURE_MEMBER)
+_DEFINE_CAPTURED_RECORD(CapturedStageInput,
+                        _FOR_EACH_CAPTURED_STAGE_INPUT_MEMBER)
+_DEFINE_CAPTURED_RECORD(CapturedStageLayout,
+                        _FOR_EACH_CAPTURED_STAGE_LAYOUT_MEMBER)
+_DEFINE_CAPTURED_RECORD(CapturedDescriptorSetLayout,
+                        _FOR_EACH_CAPTURED_DESCRIPTOR_SET_LAYOUT_MEMBER)
+_DEFINE_CAPTURED_RECORD(CapturedColorAttachmentDescriptor,
+                        _FOR_EACH_CAPTURED_COLOR_ATTACHMENT_DESCRIPTOR_MEMBER)
+_DEFINE_CAPTURED_RECORD(CapturedStencilAttachmentDescriptor,
+                        _FOR_EACH_CAPTURED_STENCIL_ATTACHMENT_DESCRIPTOR_MEMBER)
+_DEFINE_CAPTURED_RECORD(CapturedPipeline, _FOR_EACH_CAPTURED_PIPELINE_MEMBER)
+_DEFINE_CAPTURED_RECORD(CapturedShaderStructMember,
+                        _FOR_EACH_CAPTURED_SHADER_STRUCT_MEMBER_MEMBER)
+_DEFINE_CAPTURED_RECORD(CapturedBinding, _FOR_EACH_CAPTURED_BINDING_MEMBER)
+_DEFINE_CAPTURED_RECORD(CapturedCommand, _FOR_EACH_CAPTURED_COMMAND_MEMBER)
+_DEFINE_CAPTURED_RECORD(CapturedAttachment,
+                        _FOR_EACH_CAPTURED_ATTACHMENT_MEMBER)
+_DEFINE_CAPTURED_RECORD(CapturedRenderPass,
+                        _FOR_EACH_CAPTURED_RENDER_PASS_MEMBER)
+
+const ArchiveDef FrameCapture::kArchiveDefinition = {
+    .table_name = "FrameCapture",
+    .members = {"passes", "pipelines", "buffers", "textures"},
+};
+
+FrameCapture::FrameCapture() = default;
+
+FrameCapture::~FrameCapture() = default;
+
+std::unique_ptr<FrameCapture> FrameCapture::ReadFromArchive(
+    const std::string& path) {
+  Archive archive(path);
+  if (!archive.IsValid()) {
+    VALIDATION_LOG << "Could not open the frame capture archive at " << path;
+    return nullptr;
+  }
+  auto capture = std::make_unique<FrameCapture>();
+  bool did_read = false;
+  // Only the first capture written to the archive is read.
+  auto count = archive.Read<FrameCapture>([&](ArchiveLocation& item) {
+    did_read = capture->Read(item);
+    return false;
+  });
+  if (count == 0u || !did_read) {
+    VALIDATION_LOG << "Could not read a frame capture from " << path;
+    return nullptr;
+  }
+  return capture;
+}
+
+bool FrameCapture::WriteToArchive(const std::string& path) const {
+  Archive archive(path);
+  if (!archive.IsValid()) {
+    VALIDATION_LOG << "Could not open the frame capture archive at " << path;
+    return false;
+  }
+  return archive.Write(*this);
+}
+
+bool FrameCapture::Write(ArchiveLocation& item) const {
+  Lock lock(mutex_);
+  return item.Write("passes", passes_) &&        //
+         item.Write("pipelines", pipelines_) &&  //
+         item.Write("buffers", buffers_) &&      //
+         item.Write("textures", textures_);
+}
+
+bool FrameCapture::Read(ArchiveLocation& item) {
+  Lock lock(mutex_);
+  passes_.clear();
+  pipelines_.clear();
+  buffers_.clear();
+  textures_.clear();
+  return item.Read("passes", passes_) &&        //
+         item.Read("pipelines", pipelines_) &&  //
+         item.Read("buffers", buffers_) &&      //
+         item.Read("textures", textures_);
+}
+
+size_t FrameCapture::GetRenderPassCount() const {
+  Lock lock(mutex_);
+  return passes_.size();
+}
+
+size_t FrameCapture::GetCommandCount() const {
+  Lock lock(mutex_);
+  size_t count = 0u;
+  for (const auto& pass : passes_) {
+    count += pass.commands.size();
+  }
+  return count;
+}
+
+//------------------------------------------------------------------------------
+// Capture.
+//------------------------------------------------------------------------------
+
+int64_t FrameCapture::CaptureBufferRange(
+    const std::shared_ptr<const DeviceBuffer>& buffer,
+    size_t offset,
+    size_t length) {
+  if (!buffer) {
+    return -1;
+  }
+  int64_t id = 0;
+  auto found = buffer_ids_.find(buffer);
+  if (found != buffer_ids_.end()) {
+    id = found->second;
+  } else {
+    const size_t size = buffer->GetDeviceBufferDescriptor().size;
+    auto contents = std::make_shared<Allocation>();
+    if (!contents->Truncate(size, /*npot=*/false)) {
+      VALIDATION_LOG << "Could not allocate the capture of a buffer.";
+      return -1;
+    }
+    std::memset(contents->GetBuffer(), 0, size);
+    id = static_cast<int64_t>(buffers_.size());
+    CapturedBuffer captured;
+    captured.id = id;
+    captured.contents = std::move(contents);
+    buffers_.push_back(std::move(captured));
+    buffer_ids_[buffer] = id;
+  }
+
+  // Device private buffers can't be read back. Their captures stay zeroed.
+  const uint8_t* source = buffer->OnGetContents();
+  const auto& contents = buffers_[id].contents;
+  if (source && offset + length <= contents->GetLength()) {
+    std::memcpy(contents->GetBuffer() + offset, source + offset, length);
+  }
+  return id;
+}
+
+int64_t FrameCapture::CaptureTexture(
+    const std::shared_ptr<const Texture>& texture) {
+  if (!texture) {
+    return -1;
+  }
+  auto found = texture_ids_.find(texture);
+  if (found != texture_ids_.end()) {
+    return found->second;
+  }
+  const TextureDescriptor& desc = texture->GetTextureDescriptor();
+  CapturedTexture captured;
+  captured.id = static_cast<int64_t>(textures_.size());
+  captured.storage_mode = static_cast<int64_t>(desc.storage_mode);
+  captured.type = static_cast<int64_t>(desc.type);
+  captured.format = static_cast<int64_t>(desc.format);
+  captured.width = desc.size.width;
+  captured.height = desc.size.height;
+  captured.mip_count = desc.mip_count;
+  captured.usage = static_cast<int64_t>(desc.usage);
+  captured.sample_count = static_cast<int64_t>(desc.sample_count);
+  captured.compression_type = static_cast<int64_t>(desc.compression_type);
+  texture_ids_[texture] = captured.id;
+  textures_.push_back(captured);
+  return captured.id;
+}
+
+namespace {
+
+CapturedStencilAttachmentDescriptor CaptureStencilDescriptor(
+    const StencilAttachmentDescriptor& desc,
+    bool back_face) {
+  CapturedStencilAttachmentDescriptor captured;
+  captured.back_face = back_face;
+  captured.stencil_compare = static_cast<int64_t>(desc.stencil_compare);
+  captured.stencil_failure = static_cast<int64_t>(desc.stencil_failure);
+  captured.depth_failure = static_cast<int64_t>(desc.depth_failure);
+  captured.depth_stencil_pass = static_cast<int64_t>(desc.depth_stencil_pass);
+  captured.read_mask = desc.read_mask;
+  captured.write_mask = desc.write_mask;
+  return captured;
+}
+
+}  // namespace
+
+int64_t FrameCapture::CapturePipeline(
+    const std::shared_ptr<Pipeline<PipelineDescriptor>>& pipeline) {
+  if (!pipeline) {
+    return -1;
+  }
+  auto found = pipeline_ids_.find(pipeline);
+  if (found != pipeline_ids_.end()) {
+    return found->second;
+  }
+  const PipelineDescriptor& desc = pipeline->GetDescriptor();
+  CapturedPipeline captured;
+  captured.id = static_cast<int64_t>(pipelines_.size());
+  captured.label = desc.GetLabel();
+  for (const auto& [stage, function] : desc.GetStageEntrypoints()) {
+    if (!function) {
+      continue;
+    }
+    if (stage == ShaderStage::kVertex) {
+      captured.vertex_function = function->GetName();
+    } else if (stage == ShaderStage::kFragment) {
+      captured.fragment_function = function->GetName();
+    }
+  }
+  captured.sample_count = static_cast<int64_t>(desc.GetSampleCount());
+  captured.cull_mode = static_cast<int64_t>(desc.GetCullMode());
+  captured.winding_order = static_cast<int64_t>(desc.GetWindingOrder());
+  captured.primitive_type = static_cast<int64_t>(desc.GetPrimitiveType());
+  captured.polygon_mode = static_cast<int64_t>(desc.GetPolygonMode());
+  captured.depth_pixel_format =
+      static_cast<int64_t>(desc.GetDepthPixelFormat());
+  captured.stencil_pixel_format =
+      static_cast<int64_t>(desc.GetStencilPixelFormat());
+  if (auto depth = desc.GetDepthStencilAttachmentDescriptor();
+      depth.has_value()) {
+    captured.has_depth_attachment = true;
+    captured.depth_compare = static_cast<int64_t>(depth->depth_compare);
+    captured.depth_write_enabled = depth->depth_write_enabled;
+  }
+  captured.use_subpass_input = desc.UsesSubpassInput();
+
+  const auto& constants = desc.GetSpecializationConstants();
+  captured.specialization_constants = std::make_shared<Allocation>();
+  if (captured.specialization_constants->Truncate(
+          constants.size() * sizeof(Scalar), /*npot=*/false) &&
+      !constants.empty()) {
+    std::memcpy(captured.specialization_constants->GetBuffer(),
+                constants.data(), constants.size() * sizeof(Scalar));
+  }
+
+  for (const auto& [index, color] : desc.GetColorAttachmentDescriptors()) {
+    CapturedColorAttachmentDescriptor attachment;
+    attachment.index = index;
+    attachment.format = static_cast<int64_t>(color.format);
+    attachment.blending_enabled = color.blending_enabled;
+    attachment.src_color_blend_factor =
+        static_cast<int64_t>(color.src_color_blend_factor);
+    attachment.color_blend_op = static_cast<int64_t>(color.color_blend_op);
+    attachment.dst_color_blend_factor =
+        static_cast<int64_t>(color.dst_color_blend_factor);
+    attachment.src_alpha_blend_factor =
+        static_cast<int64_t>(color.src_alpha_blend_factor);
+    attachment.alpha_blend_op = static_cast<int64_t>(color.alpha_blend_op);
+    attachment.dst_alpha_blend_factor =
+        static_cast<int64_t>(color.dst_alpha_blend_factor);
+    attachment.write_mask = static_cast<int64_t>(color.write_mask);
+    captured.color_attachments.push_back(attachment);
+  }
+  if (auto front = desc.GetFrontStencilAttachmentDescriptor()) {
+    captured.stencil_attachments.push_back(
+        CaptureStencilDescriptor(*front, /*back_face=*/false));
+  }
+  if (auto back = desc.GetBackStencilAttachmentDescriptor()) {
+    captured.stencil_attachments.push_back(
+        CaptureStencilDescriptor(*back, /*back_face=*/true));
+  }
+
+  if (const auto& vertex_descriptor = desc.GetVertexDescriptor()) {
+    for (const auto& input : vertex_descriptor->GetStageInputs()) {
+      CapturedStageInput captured_input;
+      captured_input.name = input.name ? input.name : "";
+      captured_input.location = input.location;
+      captured_input.set = input.set;
+      captured_input.binding = input.binding;
+      captured_input.type = static_cast<int64_t>(input.type);
+      captured_input.bit_width = input.bit_width;
+      captured_input.vec_size = input.vec_size;
+      captured_input.columns = input.columns;
+      captured_input.offset = input.offset;
+      captured.stage_inputs.push_back(captured_input);
+    }
+    for (const auto& layout : vertex_descriptor->GetStageLayouts()) {
+      CapturedStageLayout captured_layout;
+      captured_layout.stride = layout.stride;
+      captured_layout.binding = layout.binding;
+      captured.stage_layouts.push_back(captured_layout);
+    }
+    for (const auto& layout : vertex_descriptor->GetDescriptorSetLayouts()) {
+      CapturedDescriptorSetLayout captured_layout;
+      captured_layout.binding = layout.binding;
+      captured_layout.descriptor_type =
+          static_cast<int64_t>(layout.descriptor_type);
+      captured_layout.shader_stage = static_cast<int64_t>(layout.shader_stage);
+      captured.descriptor_set_layouts.push_back(captured_layout);
+    }
+  }
+
+  pipeline_ids_[pipeline] = captured.id;
+  pipelines_.push_back(std::move(captured));
+  return pipelines_.back().id;
+}
+
+namespace {
+
+void CaptureMetadata(const ShaderMetadata* metadata,
+                     CapturedBinding& binding) {
+  if (!metadata) {
+    return;
+  }
+  binding.metadata_name = metadata->name;
+  for (const auto& member : metadata->members) {
+    CapturedShaderStructMember captured;
+    captured.type = static_cast<int64_t>(member.type);
+    captured.name = member.name;
+    captured.offset = member.offset;
+    captured.size = member.size;
+    captured.byte_length = member.byte_length;
+    captured.array_elements =
+        member.array_elements.has_value()
+            ? static_cast<int64_t>(member.array_elements.value())
+            : -1;
+    binding.metadata_members.push_back(captured);
+  }
+}
+
+CapturedAttachment CaptureAttachmentActions(const Attachment& attachment) {
+  CapturedAttachment captured;
+  captured.load_action = static_cast<int64_t>(attachment.load_action);
+  captured.store_action = static_cast<int64_t>(attachment.store_action);
+  return captured;
+}
+
+}  // namespace
+
+void FrameCapture::AddRenderPass(const RenderPass& pass) {
+  Lock lock(mutex_);
+
+  CapturedRenderPass captured;
+  const RenderTarget& target = pass.GetRenderTarget();
+  for (const auto& [index, color] : target.GetColorAttachments()) {
+    CapturedAttachment attachment = CaptureAttachmentActions(color);
+    attachment.index = index;
+    attachment.texture_id = CaptureTexture(color.texture);
+    attachment.resolve_texture_id = CaptureTexture(color.resolve_texture);
+    attachment.clear_red = color.clear_color.red;
+    attachment.clear_green = color.clear_color.green;
+    attachment.clear_blue = color.clear_color.blue;
+    attachment.clear_alpha = color.clear_color.alpha;
+    captured.color_attachments.push_back(attachment);
+  }
+  if (const auto& depth = target.GetDepthAttachment(); depth.has_value()) {
+    CapturedAttachment attachment = CaptureAttachmentActions(*depth);
+    attachment.texture_id = CaptureTexture(depth->texture);
+    attachment.resolve_texture_id = CaptureTexture(depth->resolve_texture);
+    attachment.clear_depth = depth->clear_depth;
+    captured.depth_attachments.push_back(attachment);
+  }
+  if (const auto& stencil = target.GetStencilAttachment();
+      stencil.has_value()) {
+    CapturedAttachment attachment = CaptureAttachmentActions(*stencil);
+    attachment.texture_id = CaptureTexture(stencil->texture);
+    attachment.resolve_texture_id = CaptureTexture(stencil->resolve_texture);
+    attachment.clear_stencil = stencil->clear_stencil;
+    captured.stencil_attachments.push_back(attachment);
+  }
+
+  for (const auto& command : pass.GetCommands()) {
+    CapturedCommand captured_command;
+#ifdef IMPELLER_DEBUG
+    captured_command.label = command.label;
+#endif  // IMPELLER_DEBUG
+    captured_command.pipeline_id = CapturePipeline(command.pipeline);
+    captured_command.stencil_reference = command.stencil_reference;
+    captured_command.base_vertex = command.base_vertex;
+    captured_command.instance_count = command.instance_count;
+    if (command.viewport.has_value()) {
+      const Viewport& viewport = command.viewport.value();
+      captured_command.has_viewport = true;
+      captured_command.viewport_x = viewport.rect.GetX();
+      captured_command.viewport_y = viewport.rect.GetY();
+      captured_command.viewport_width = viewport.rect.GetWidth();
+      captured_command.viewport_height = viewport.rect.GetHeight();
+      captured_command.viewport_z_near = viewport.depth_range.z_near;
+      captured_command.viewport_z_far = viewport.depth_range.z_far;
+    }
+    if (command.scissor.has_value()) {
+      const IRect& scissor = command.scissor.value();
+      captured_command.has_scissor = true;
+      captured_command.scissor_x = scissor.GetX();
+      captured_command.scissor_y = scissor.GetY();
+      captured_command.scissor_width = scissor.GetWidth();
+      captured_command.scissor_height = scissor.GetHeight();
+    }
+
+    const VertexBuffer& vertex_buffer = command.vertex_buffer;
+    const BufferView& vertices = vertex_buffer.vertex_buffer;
+    captured_command.vertex_buffer_id = CaptureBufferRange(
+        vertices.buffer, vertices.range.offset, vertices.range.length);
+    captured_command.vertex_buffer_offset = vertices.range.offset;
+    captured_command.vertex_buffer_length = vertices.range.length;
+    const BufferView& indices = vertex_buffer.index_buffer;
+    captured_command.index_buffer_id = CaptureBufferRange(
+        indices.buffer, indices.range.offset, indices.range.length);
+    captured_command.index_buffer_offset = indices.range.offset;
+    captured_command.index_buffer_length = indices.range.length;
+    captured_command.vertex_count = vertex_buffer.vertex_count;
+    captured_command.index_type =
+        static_cast<int64_t>(vertex_buffer.index_type);
+
+    for (auto stage : {ShaderStage::kVertex, ShaderStage::kFragment}) {
+      const Bindings& bindings = stage == ShaderStage::kVertex
+                                     ? command.vertex_bindings
+                                     : command.fragment_bindings;
+      for (const auto& buffer : bindings.buffers) {
+        CapturedBinding binding;
+        binding.stage = static_cast<int64_t>(stage);
+        binding.slot_name = buffer.slot.name ? buffer.slot.name : "";
+        binding.slot_index = buffer.slot.ext_res_0;
+        binding.slot_set = buffer.slot.set;
+        binding.slot_binding = buffer.slot.binding;
+        CaptureMetadata(buffer.view.GetMetadata(), binding);
+        const BufferView& view = buffer.view.resource;
+        binding.buffer_id = CaptureBufferRange(view.buffer, view.range.offset,
+                                               view.range.length);
+        binding.buffer_offset = view.range.offset;
+        binding.buffer_length = view.range.length;
+        captured_command.bindings.push_back(std::move(binding));
+      }
+      for (const auto& image : bindings.sampled_images) {
+        CapturedBinding binding;
+        binding.stage = static_cast<int64_t>(stage);
+        binding.is_texture = true;
+        binding.slot_name = image.slot.name ? image.slot.name : "";
+        binding.slot_index = image.slot.texture_index;
+        binding.slot_set = image.slot.set;
+        binding.slot_binding = image.slot.binding;
+        CaptureMetadata(image.texture.GetMetadata(), binding);
+        binding.texture_id = CaptureTexture(image.texture.resource);
+        if (image.sampler) {
+          const SamplerDescriptor& sampler = image.sampler->GetDescriptor();
+          binding.min_filter = static_cast<int64_t>(sampler.min_filter);
+          binding.mag_filter = static_cast<int64_t>(sampler.mag_filter);
+          binding.mip_filter = static_cast<int64_t>(sampler.mip_filter);
+          binding.width_address_mode =
+              static_cast<int64_t>(sampler.width_address_mode);
+          binding.height_address_mode =
+              static_cast<int64_t>(sampler.height_address_mode);
+          binding.depth_address_mode =
+              static_cast<int64_t>(sampler.depth_address_mode);
+        }
+        captured_command.bindings.push_back(std::move(binding));
+      }
+    }
+
+    captured.commands.push_back(std::move(captured_command));
+  }
+
+  passes_.push_back(std::move(captured));
+}
+
+//------------------------------------------------------------------------------
+// Replay.
+//------------------------------------------------------------------------------
+
+namespace {
+
+/// The resources of a capture recreated on the context that replays it.
+struct ReplayResources {
+  std::unordered_map<int64_t, std::shared_ptr<DeviceBuffer>> buffers;
+  std::unordered_map<int64_t, std::shared_ptr<Texture>> textures;
+  std::unordered_map<int64_t, std::shared_ptr<Pipeline<PipelineDescriptor>>>
+      pipelines;
+  std::unordered_map<const CapturedBinding*,
+                     std::shared_ptr<const ShaderMetadata>>
+      metadata;
+  std::unordered_map<const CapturedBinding*, std::shared_ptr<const Sampler>>
+      samplers;
+  // Slots refer to their names by pointer. The nodes of the set keep those
+  // pointers stable.
+  std::unordered_set<std::string> names;
+
+  const char* Intern(const std::string& name) {
+    return names.insert(name).first->c_str();
+  }
+
+  template <class T>
+  static std::shared_ptr<T> Find(
+      const std::unordered_map<int64_t, std::shared_ptr<T>>& map,
+      int64_t id) {
+    auto found = map.find(id);
+    return found == map.end() ? nullptr : found->second;
+  }
+
+  BufferView GetBufferView(int64_t id, int64_t offset, int64_t length) const {
+    auto buffer = Find(buffers, id);
+    if (!buffer) {
+      return {};
+    }
+    return BufferView{
+        .buffer = std::move(buffer),
+        .range = Range{static_cast<size_t>(offset),
+                       static_cast<size_t>(length)},
+    };
+  }
+};
+
+std::optional<PipelineDescriptor> CreateReplayPipelineDescriptor(
+    const CapturedPipeline& captured,
+    ShaderLibrary& library,
+    ReplayResources& resources) {
+  PipelineDescriptor desc;
+  desc.SetLabel(captured.label);
+  desc.SetSampleCount(static_cast<SampleCount>(captured.sample_count));
+  for (auto stage : {ShaderStage::kVertex, ShaderStage::kFragment}) {
+    const std::string& name = stage == ShaderStage::kVertex
+                                  ? captured.vertex_function
+                                  : captured.fragment_function;
+    if (name.empty()) {
+      continue;
+    }
+    auto function = library.GetFunction(name, stage);
+    if (!function) {
+      VALIDATION_LOG << "The shader function " << name << " of the pipeline "
+                     << captured.label << " is not in the shader library.";
+      return std::nullopt;
+    }
+    desc.AddStageEntrypoint(std::move(function));
+  }
+
+  std::vector<ShaderStageIOSlot> inputs;
+  for (const auto& input : captured.stage_inputs) {
+    inputs.push_back(ShaderStageIOSlot{
+        .name = resources.Intern(input.name),
+        .location = static_cast<size_t>(input.location),
+        .set = static_cast<size_t>(input.set),
+        .binding = static_cast<size_t>(input.binding),
+        .type = static_cast<ShaderType>(input.type),
+        .bit_width = static_cast<size_t>(input.bit_width),
+        .vec_size = static_cast<size_t>(input.vec_size),
+        .columns = static_cast<size_t>(input.columns),
+        .offset = static_cast<size_t>(input.offset),
+    });
+  }
+  std::vector<ShaderStageBufferLayout> layouts;
+  for (const auto& layout : captured.stage_layouts) {
+    layouts.push_back(ShaderStageBufferLayout{
+        .stride = static_cast<size_t>(layout.stride),
+        .binding = static_cast<size_t>(layout.binding),
+    });
+  }
+  std::vector<DescriptorSetLayout> set_layouts;
+  for (const auto& layout : captured.descriptor_set_layouts) {
+    set_layouts.push_back(DescriptorSetLayout{
+        .binding = static_cast<uint32_t>(layout.binding),
+        .descriptor_type =
+            static_cast<DescriptorType>(layout.descriptor_type),
+        .shader_stage = static_cast<ShaderStage>(layout.shader_stage),
+    });
+  }
+  auto vertex_descriptor = std::make_shared<VertexDescriptor>();
+  vertex_descriptor->SetStageInputs(inputs, layouts);
+  vertex_descriptor->RegisterDescriptorSetLayouts(set_layouts.data(),
+                                                  set_layouts.size());
+  desc.SetVertexDescriptor(std::move(vertex_descriptor));
+
+  for (const auto& color : captured.color_attachments) {
+    desc.SetColorAttachmentDescriptor(
+        color.index,
+        ColorAttachmentDescriptor{
+            .format = static_cast<PixelFormat>(color.format),
+            .blending_enabled = color.blending_enabled,
+            .src_color_blend_factor =
+                static_cast<BlendFactor>(color.src_color_blend_factor),
+            .color_blend_op = static_cast<BlendOperation>(color.color_blend_op),
+            .dst_color_blend_factor =
+                static_cast<BlendFactor>(color.dst_color_blend_factor),
+            .src_alpha_blend_factor =
+                static_cast<BlendFactor>(color.src_alpha_blend_factor),
+            .alpha_blend_op = static_cast<BlendOperation>(color.alpha_blend_op),
+            .dst_alpha_blend_factor =
+                static_cast<BlendFactor>(color.dst_alpha_blend_factor),
+            .write_mask = static_cast<std::underlying_type_t<ColorWriteMask>>(
+                color.write_mask),
+        });
+  }
+
+  std::optional<StencilAttachmentDescriptor> front;
+  std::optional<StencilAttachmentDescriptor> back;
+  for (const auto& stencil : captured.stencil_attachments) {
+    StencilAttachmentDescriptor stencil_desc{
+        .stencil_compare =
+            static_cast<CompareFunction>(stencil.stencil_compare),
+        .stencil_failure =
+            static_cast<StencilOperation>(stencil.stencil_failure),
+        .depth_failure = static_cast<StencilOperation>(stencil.depth_failure),
+        .depth_stencil_pass =
+            static_cast<StencilOperation>(stencil.depth_stencil_pass),
+        .read_mask = static_cast<uint32_t>(stencil.read_mask),
+        .write_mask = static_cast<uint32_t>(stencil.write_mask),
+    };
+    (stencil.back_face ? back : front) = stencil_desc;
+  }
+  if (front.has_value() || back.has_value()) {
+    desc.SetStencilAttachmentDescriptors(front, back);
+  }
+  if (captured.has_depth_attachment) {
+    desc.SetDepthStencilAttachmentDescriptor(DepthAttachmentDescriptor{
+        .depth_compare = static_cast<CompareFunction>(captured.depth_compare),
+        .depth_write_enabled = captured.depth_write_enabled,
+    });
+  }
+  desc.SetDepthPixelFormat(
+      static_cast<PixelFormat>(captured.depth_pixel_format));
+  desc.SetStencilPixelFormat(
+      static_cast<PixelFormat>(captured.stencil_pixel_format));
+  desc.SetCullMode(static_cast<CullMode>(captured.cull_mode));
+  desc.SetWindingOrder(static_cast<WindingOrder>(captured.winding_order));
+  desc.SetPrimitiveType(static_cast<PrimitiveType>(captured.primitive_type));
+  desc.SetPolygonMode(static_cast<PolygonMode>(captured.polygon_mode));
+  desc.SetUseSubpassInput(captured.use_subpass_input ? UseSubpassInput::kYes
+                                                     : UseSubpassInput::kNo);
+  if (const auto& constants = captured.specialization_constants) {
+    const auto* values =
+        reinterpret_cast<const Scalar*>(constants->GetBuffer());
+    desc.SetSpecializationConstants(std::vector<Scalar>(
+        values, values + constants->GetLength() / sizeof(Scalar)));
+  }
+  return desc;
+}
+
+std::shared_ptr<const ShaderMetadata> CreateReplayMetadata(
+    const CapturedBinding& binding) {
+  auto metadata = std::make_shared<ShaderMetadata>();
+  metadata->name = binding.metadata_name;
+  for (const auto& member : binding.metadata_members) {
+    metadata->members.push_back(ShaderStructMemberMetadata{
+        .type = static_cast<ShaderType>(member.type),
+        .name = member.name,
+        .offset = static_cast<size_t>(member.offset),
+        .size = static_cast<size_t>(member.size),
+        .byte_length = static_cast<size_t>(member.byte_length),
+        .array_elements =
+            member.array_elements < 0
+                ? std::nullopt
+                : std::optional<size_t>(member.array_elements),
+    });
+  }
+  return metadata;
+}
+
+SamplerDescriptor CreateReplaySamplerDescriptor(
+    const CapturedBinding& binding) {
+  SamplerDescriptor desc;
+  desc.label = "Replayed Sampler";
+  desc.min_filter = static_cast<MinMagFilter>(binding.min_filter);
+  desc.mag_filter = static_cast<MinMagFilter>(binding.mag_filter);
+  desc.mip_filter = static_cast<MipFilter>(binding.mip_filter);
+  desc.width_address_mode =
+      static_cast<SamplerAddressMode>(binding.width_address_mode);
+  desc.height_address_mode =
+      static_cast<SamplerAddressMode>(binding.height_address_mode);
+  desc.depth_address_mode =
+      static_cast<SamplerAddressMode>(binding.depth_address_mode);
+  return desc;
+}
+
+template <class T>
+bool SetReplayAttachment(const CapturedAttachment& captured,
+                         const ReplayResources& resources,
+                         T& attachment) {
+  attachment.texture = ReplayResources::Find(resources.textures,
+                                             captured.texture_id);
+  attachment.resolve_texture = ReplayResources::Find(
+      resources.textures, captured.resolve_texture_id);
+  attachment.load_action = static_cast<LoadAction>(captured.load_action);
+  attachment.store_action = static_cast<StoreAction>(captured.store_action);
+  return attachment.texture != nullptr;
+}
+
+bool EncodeReplayPass(const CapturedRenderPass& captured,
+                      CommandBuffer& command_buffer,
+                      ReplayResources& resources) {
+  RenderTarget target;
+  for (const auto& captured_color : captured.color_attachments) {
+    ColorAttachment color;
+    if (!SetReplayAttachment(captured_color, resources, color)) {
+      return false;
+    }
+    color.clear_color =
+        Color(captured_color.clear_red, captured_color.clear_green,
+              captured_color.clear_blue, captured_color.clear_alpha);
+    target.SetColorAttachment(color, captured_color.index);
+  }
+  for (const auto& captured_depth : captured.depth_attachments) {
+    DepthAttachment depth;
+    if (!SetReplayAttachment(captured_depth, resources, depth)) {
+      return false;
+    }
+    depth.clear_depth = captured_depth.clear_depth;
+    target.SetDepthAttachment(depth);
+  }
+  for (const auto& captured_stencil : captured.stencil_attachments) {
+    StencilAttachment stencil;
+    if (!SetReplayAttachment(captured_stencil, resources, stencil)) {
+      return false;
+    }
+    stencil.clear_stencil = captured_stencil.clear_stencil;
+    target.SetStencilAttachment(stencil);
+  }
+
+  auto pass = command_buffer.CreateRenderPass(target);
+  if (!pass) {
+    VALIDATION_LOG << "Could not create a replayed render pass.";
+    return false;
+  }
+  pass->SetLabel("Replayed RenderPass");
+  for (const auto& command : captured.commands) {
+    auto pipeline =
+        ReplayResources::Find(resources.pipelines, command.pipeline_id);
+    if (!pipeline) {
+      VALIDATION_LOG << "A replayed command has no pipeline.";
+      return false;
+    }
+    pass->SetPipeline(pipeline);
+    pass->SetCommandLabel(command.label);
+    pass->SetStencilReference(command.stencil_reference);
+    pass->SetBaseVertex(command.base_vertex);
+    if (command.has_viewport) {
+      pass->SetViewport(Viewport{
+          .rect = Rect::MakeXYWH(command.viewport_x, command.viewport_y,
+                                 command.viewport_width,
+                                 command.viewport_height),
+          .depth_range = DepthRange{.z_near = static_cast<Scalar>(
+                                        command.viewport_z_near),
+                                    .z_far = static_cast<Scalar>(
+                                        command.viewport_z_far)},
+      });
+    }
+    if (command.has_scissor) {
+      pass->SetScissor(IRect::MakeXYWH(command.scissor_x, command.scissor_y,
+                                       command.scissor_width,
+                                       command.scissor_height));
+    }
+    pass->SetInstanceCount(command.instance_count);
+    pass->SetVertexBuffer(VertexBuffer{
+        .vertex_buffer = resources.GetBufferView(command.vertex_buffer_id,
+                                                 command.vertex_buffer_offset,
+                                                 command.vertex_buffer_length),
+        .index_buffer = resources.GetBufferView(command.index_buffer_id,
+                                                command.index_buffer_offset,
+                                                command.index_buffer_length),
+        .vertex_count = static_cast<size_t>(command.vertex_count),
+        .index_type = static_cast<IndexType>(command.index_type),
+    });
+    for (const auto& binding : command.bindings) {
+      const auto stage = static_cast<ShaderStage>(binding.stage);
+      const auto& metadata = resources.metadata[&binding];
+      if (binding.is_texture) {
+        auto texture =
+            ReplayResources::Find(resources.textures, binding.texture_id);
+        SampledImageSlot slot{
+            .name = resources.Intern(binding.slot_name),
+            .texture_index = static_cast<size_t>(binding.slot_index),
+            .set = static_cast<size_t>(binding.slot_set),
+            .binding = static_cast<size_t>(binding.slot_binding),
+        };
+        pass->BindResource(stage, slot, *metadata, std::move(texture),
+                           resources.samplers[&binding]);
+      } else {
+        ShaderUniformSlot slot{
+            .name = resources.Intern(binding.slot_name),
+            .ext_res_0 = static_cast<size_t>(binding.slot_index),
+            .set = static_cast<size_t>(binding.slot_set),
+            .binding = static_cast<size_t>(binding.slot_binding),
+        };
+        pass->BindResource(
+            stage, slot, metadata,
+            resources.GetBufferView(binding.buffer_id, binding.buffer_offset,
+                                    binding.buffer_length));
+      }
+    }
+    if (!pass->Draw().ok()) {
+      VALIDATION_LOG << "Could not replay the command " << command.label;
+      return false;
+    }
+  }
+  return pass->EncodeCommands();
+}
+
+}  // namespace
+
+std::optional<FrameCapture::ReplayStatistics> FrameCapture::Replay(
+    const std::shared_ptr<Context>& context,
+    size_t iteration_count) const {
+  if (!context || !context->IsValid()) {
+    return std::nullopt;
+  }
+  Lock lock(mutex_);
+
+  ReplayResources resources;
+  auto allocator = context->GetResourceAllocator();
+  for (const auto& buffer : buffers_) {
+    auto device_buffer = allocator->CreateBufferWithCopy(
+        buffer.contents->GetBuffer(), buffer.contents->GetLength());
+    if (!device_buffer) {
+      VALIDATION_LOG << "Could not create a replayed buffer.";
+      return std::nullopt;
+    }
+    resources.buffers[buffer.id] = std::move(device_buffer);
+  }
+  for (const auto& texture : textures_) {
+    TextureDescriptor desc;
+    desc.storage_mode = static_cast<StorageMode>(texture.storage_mode);
+    desc.type = static_cast<TextureType>(texture.type);
+    desc.format = static_cast<PixelFormat>(texture.format);
+    desc.size = ISize(texture.width, texture.height);
+    desc.mip_count = texture.mip_count;
+    desc.usage = static_cast<TextureUsageMask>(texture.usage);
+    desc.sample_count = static_cast<SampleCount>(texture.sample_count);
+    desc.compression_type =
+        static_cast<CompressionType>(texture.compression_type);
+    auto device_texture = allocator->CreateTexture(desc);
+    if (!device_texture) {
+      VALIDATION_LOG << "Could not create a replayed texture.";
+      return std::nullopt;
+    }
+    resources.textures[texture.id] = std::move(device_texture);
+  }
+  auto shader_library = context->GetShaderLibrary();
+  auto pipeline_library = context->GetPipelineLibrary();
+  for (const auto& pipeline : pipelines_) {
+    auto desc =
+        CreateReplayPipelineDescriptor(pipeline, *shader_library, resources);
+    if (!desc.has_value()) {
+      return std::nullopt;
+    }
+    auto replayed = pipeline_library->GetPipeline(desc).Get();
+    if (!replayed || !replayed->IsValid()) {
+      VALIDATION_LOG << "Could not create the replayed pipeline "
+                     << pipeline.label;
+      return std::nullopt;
+    }
+    resources.pipelines[pipeline.id] = std::move(replayed);
+  }
+  auto sampler_library = context->GetSamplerLibrary();
+  for (const auto& pass : passes_) {
+    for (const auto& command : pass.commands) {
+      for (const auto& binding : command.bindings) {
+        resources.metadata[&binding] = CreateReplayMetadata(binding);
+        if (binding.is_texture) {
+          resources.samplers[&binding] = sampler_library->GetSampler(
+              CreateReplaySamplerDescriptor(binding));
+        }
+      }
+    }
+  }
+
+  ReplayStatistics statistics;
+  int64_t total_nanos = 0;
+  int64_t min_nanos = std::numeric_limits<int64_t>::max();
+  int64_t max_nanos = 0;
+  for (size_t i = 0; i < iteration_count; i++) {
+    const auto start = fml::TimePoint::Now();
+    auto command_buffer = context->CreateCommandBuffer();
+    if (!command_buffer) {
+      return std::nullopt;
+    }
+    command_buffer->SetLabel("Frame Capture Replay");
+    for (const auto& pass : passes_) {
+      if (!EncodeReplayPass(pass, *command_buffer, resources)) {
+        return std::nullopt;
+      }
+    }
+    fml::AutoResetWaitableEvent latch;
+    auto status = CommandBuffer::Status::kPending;
+    if (!command_buffer->SubmitCommands(
+            [&latch, &status](CommandBuffer::Status result) {
+              status = result;
+              latch.Signal();
+            })) {
+      VALIDATION_LOG << "Could not submit a frame capture replay.";
+      return std::nullopt;
+    }
+    latch.Wait();
+    if (status != CommandBuffer::Status::kCompleted) {
+      VALIDATION_LOG << "A frame capture replay did not complete.";
+      return std::nullopt;
+    }
+    const int64_t nanos = (fml::TimePoint::Now() - start).ToNanoseconds();
+    total_nanos += nanos;
+    min_nanos = std::min(min_nanos, nanos);
+    max_nanos = std::max(max_nanos, nanos);
+    statistics.iteration_count++;
+  }
+  if (statistics.iteration_count > 0u) {
+    statistics.min_frame_time = fml::TimeDelta::FromNanoseconds(min_nanos);
+    statistics.max_frame_time = fml::TimeDelta::FromNanoseconds(max_nanos);
+    statistics.average_frame_time = fml::TimeDelta::FromNanoseconds(
+        total_nanos / static_cast<int64_t>(statistics.iteration_count));
+  }
+  return statistics;
+}
+
+}  // namespace impeller
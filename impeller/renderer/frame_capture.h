@@ -0,0 +1,362 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_FRAME_CAPTURE_H_
+#define FLUTTER_IMPELLER_RENDERER_FRAME_CAPTURE_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/time/time_delta.h"
+#include "impeller/archivist/archivable.h"
+#include "impeller/base/allocation.h"
+#include "impeller/base/thread.h"
+
+namespace impeller {
+
+class Context;
+class DeviceBuffer;
+class PipelineDescriptor;
+class RenderPass;
+class Texture;
+template <typename PipelineDescriptor_>
+class Pipeline;
+
+// The records below make up the frame capture format. Every enum is stored as
+// its underlying value and every resource is referred to by the ID it was
+// given in the capture.
+
+#define IPLR_CAPTURED_RECORD(record)                       \
+  PrimaryKey GetPrimaryKey() const override { return {}; } \
+  bool Write(ArchiveLocation& item) const override;        \
+  bool Read(ArchiveLocation& item) override;               \
+  static const ArchiveDef kArchiveDefinition;
+
+/// The contents of a device buffer. Only the ranges referenced by the captured
+/// commands are copied, the rest of the buffer is zeroed.
+struct CapturedBuffer : public Archivable {
+  int64_t id = 0;
+  std::shared_ptr<Allocation> contents;
+
+  IPLR_CAPTURED_RECORD(CapturedBuffer)
+};
+
+/// The descriptor of a sampled texture or of a render target attachment. The
+/// contents of textures are not captured.
+struct CapturedTexture : public Archivable {
+  int64_t id = 0;
+  int64_t storage_mode = 0;
+  int64_t type = 0;
+  int64_t format = 0;
+  int64_t width = 0;
+  int64_t height = 0;
+  int64_t mip_count = 1;
+  int64_t usage = 0;
+  int64_t sample_count = 1;
+  int64_t compression_type = 0;
+
+  IPLR_CAPTURED_RECORD(CapturedTexture)
+};
+
+struct CapturedStageInput : public Archivable {
+  std::string name;
+  int64_t location = 0;
+  int64_t set = 0;
+  int64_t binding = 0;
+  int64_t type = 0;
+  int64_t bit_width = 0;
+  int64_t vec_size = 0;
+  int64_t columns = 0;
+  int64_t offset = 0;
+
+  IPLR_CAPTURED_RECORD(CapturedStageInput)
+};
+
+struct CapturedStageLayout : public Archivable {
+  int64_t stride = 0;
+  int64_t binding = 0;
+
+  IPLR_CAPTURED_RECORD(CapturedStageLayout)
+};
+
+struct CapturedDescriptorSetLayout : public Archivable {
+  int64_t binding = 0;
+  int64_t descriptor_type = 0;
+  int64_t shader_stage = 0;
+
+  IPLR_CAPTURED_RECORD(CapturedDescriptorSetLayout)
+};
+
+struct CapturedColorAttachmentDescriptor : public Archivable {
+  int64_t index = 0;
+  int64_t format = 0;
+  bool blending_enabled = false;
+  int64_t src_color_blend_factor = 0;
+  int64_t color_blend_op = 0;
+  int64_t dst_color_blend_factor = 0;
+  int64_t src_alpha_blend_factor = 0;
+  int64_t alpha_blend_op = 0;
+  int64_t dst_alpha_blend_factor = 0;
+  int64_t write_mask = 0;
+
+  IPLR_CAPTURED_RECORD(CapturedColorAttachmentDescriptor)
+};
+
+struct CapturedStencilAttachmentDescriptor : public Archivable {
+  bool back_face = false;
+  int64_t stencil_compare = 0;
+  int64_t stencil_failure = 0;
+  int64_t depth_failure = 0;
+  int64_t depth_stencil_pass = 0;
+  int64_t read_mask = 0;
+  int64_t write_mask = 0;
+
+  IPLR_CAPTURED_RECORD(CapturedStencilAttachmentDescriptor)
+};
+
+/// A pipeline descriptor. Its shader functions are looked up by name in the
+/// shader library of the context that replays the capture.
+struct CapturedPipeline : public Archivable {
+  int64_t id = 0;
+  std::string label;
+  std::string vertex_function;
+  std::string fragment_function;
+  int64_t sample_count = 1;
+  int64_t cull_mode = 0;
+  int64_t winding_order = 0;
+  int64_t primitive_type = 0;
+  int64_t polygon_mode = 0;
+  int64_t depth_pixel_format = 0;
+  int64_t stencil_pixel_format = 0;
+  bool has_depth_attachment = false;
+  int64_t depth_compare = 0;
+  bool depth_write_enabled = false;
+  bool use_subpass_input = false;
+  /// The specialization constants, as packed floats.
+  std::shared_ptr<Allocation> specialization_constants;
+  std::vector<CapturedColorAttachmentDescriptor> color_attachments;
+  std::vector<CapturedStencilAttachmentDescriptor> stencil_attachments;
+  std::vector<CapturedStageInput> stage_inputs;
+  std::vector<CapturedStageLayout> stage_layouts;
+  std::vector<CapturedDescriptorSetLayout> descriptor_set_layouts;
+
+  IPLR_CAPTURED_RECORD(CapturedPipeline)
+};
+
+struct CapturedShaderStructMember : public Archivable {
+  int64_t type = 0;
+  std::string name;
+  int64_t offset = 0;
+  int64_t size = 0;
+  int64_t byte_length = 0;
+  /// -1 if the member is not an array.
+  int64_t array_elements = -1;
+
+  IPLR_CAPTURED_RECORD(CapturedShaderStructMember)
+};
+
+/// A buffer bound to a uniform slot, or a texture and sampler bound to a
+/// sampled image slot.
+struct CapturedBinding : public Archivable {
+  int64_t stage = 0;
+  bool is_texture = false;
+  std::string slot_name;
+  /// The `ext_res_0` of a uniform slot or the `texture_index` of a sampled
+  /// image slot.
+  int64_t slot_index = 0;
+  int64_t slot_set = 0;
+  int64_t slot_binding = 0;
+  std::string metadata_name;
+  std::vector<CapturedShaderStructMember> metadata_members;
+  int64_t buffer_id = -1;
+  int64_t buffer_offset = 0;
+  int64_t buffer_length = 0;
+  int64_t texture_id = -1;
+  int64_t min_filter = 0;
+  int64_t mag_filter = 0;
+  int64_t mip_filter = 0;
+  int64_t width_address_mode = 0;
+  int64_t height_address_mode = 0;
+  int64_t depth_address_mode = 0;
+
+  IPLR_CAPTURED_RECORD(CapturedBinding)
+};
+
+struct CapturedCommand : public Archivable {
+  std::string label;
+  int64_t pipeline_id = -1;
+  int64_t stencil_reference = 0;
+  int64_t base_vertex = 0;
+  int64_t instance_count = 1;
+  bool has_viewport = false;
+  double viewport_x = 0.0;
+  double viewport_y = 0.0;
+  double viewport_width = 0.0;
+  double viewport_height = 0.0;
+  double viewport_z_near = 0.0;
+  double viewport_z_far = 1.0;
+  bool has_scissor = false;
+  int64_t scissor_x = 0;
+  int64_t scissor_y = 0;
+  int64_t scissor_width = 0;
+  int64_t scissor_height = 0;
+  int64_t vertex_buffer_id = -1;
+  int64_t vertex_buffer_offset = 0;
+  int64_t vertex_buffer_length = 0;
+  int64_t index_buffer_id = -1;
+  int64_t index_buffer_offset = 0;
+  int64_t index_buffer_length = 0;
+  int64_t vertex_count = 0;
+  int64_t index_type = 0;
+  std::vector<CapturedBinding> bindings;
+
+  IPLR_CAPTURED_RECORD(CapturedCommand)
+};
+
+struct CapturedAttachment : public Archivable {
+  /// The index of a color attachment. Unused by depth and stencil attachments.
+  int64_t index = 0;
+  int64_t texture_id = -1;
+  int64_t resolve_texture_id = -1;
+  int64_t load_action = 0;
+  int64_t store_action = 0;
+  double clear_red = 0.0;
+  double clear_green = 0.0;
+  double clear_blue = 0.0;
+  double clear_alpha = 0.0;
+  double clear_depth = 0.0;
+  int64_t clear_stencil = 0;
+
+  IPLR_CAPTURED_RECORD(CapturedAttachment)
+};
+
+struct CapturedRenderPass : public Archivable {
+  std::vector<CapturedAttachment> color_attachments;
+  /// At most one depth and one stencil attachment.
+  std::vector<CapturedAttachment> depth_attachments;
+  std::vector<CapturedAttachment> stencil_attachments;
+  std::vector<CapturedCommand> commands;
+
+  IPLR_CAPTURED_RECORD(CapturedRenderPass)
+};
+
+#undef IPLR_CAPTURED_RECORD
+
+//------------------------------------------------------------------------------
+/// @brief      The command stream of the render passes of a frame, in a form
+///             that can be archived and replayed without the application that
+///             rendered it.
+///
+///             A capture records every render pass encoded by a context while
+///             it is set as the `frame_capture` of that context, in the order
+///             the passes are encoded. Captures are meant to span a single
+///             frame: the contents of host buffers are copied when a pass is
+///             encoded and are assumed not to change until the end of the
+///             frame.
+///
+///             Replaying a capture recreates its pipelines, buffers, and
+///             textures on a context, which may use any backend, and times
+///             the encoding and execution of its passes. This reproduces the
+///             GPU cost of a frame from a device without the application.
+///
+class FrameCapture final : public Archivable {
+ public:
+  struct ReplayStatistics {
+    size_t iteration_count = 0u;
+    fml::TimeDelta min_frame_time;
+    fml::TimeDelta average_frame_time;
+    fml::TimeDelta max_frame_time;
+  };
+
+  FrameCapture();
+
+  ~FrameCapture() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reads the capture written to the archive at `path`.
+  ///
+  /// @return     The capture, or nullptr if the archive holds none.
+  ///
+  static std::unique_ptr<FrameCapture> ReadFromArchive(
+      const std::string& path);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the capture to the archive at `path`.
+  ///
+  [[nodiscard]] bool WriteToArchive(const std::string& path) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the commands of a render pass that is about to be
+  ///             encoded. Safe to call from any thread.
+  ///
+  void AddRenderPass(const RenderPass& pass);
+
+  size_t GetRenderPassCount() const;
+
+  size_t GetCommandCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Replays the captured passes on `context` `iteration_count`
+  ///             times, waiting for each replay to complete before starting
+  ///             the next one.
+  ///
+  /// @return     The time each replay took from the start of its encoding to
+  ///             its completion on the GPU, or std::nullopt if the capture
+  ///             could not be replayed on the context.
+  ///
+  std::optional<ReplayStatistics> Replay(
+      const std::shared_ptr<Context>& context,
+      size_t iteration_count) const;
+
+  // |Archivable|
+  PrimaryKey GetPrimaryKey() const override { return {}; }
+
+  // |Archivable|
+  bool Write(ArchiveLocation& item) const override;
+
+  // |Archivable|
+  bool Read(ArchiveLocation& item) override;
+
+  static const ArchiveDef kArchiveDefinition;
+
+ private:
+  mutable Mutex mutex_;
+  std::vector<CapturedRenderPass> passes_ IPLR_GUARDED_BY(mutex_);
+  std::vector<CapturedPipeline> pipelines_ IPLR_GUARDED_BY(mutex_);
+  std::vector<CapturedBuffer> buffers_ IPLR_GUARDED_BY(mutex_);
+  std::vector<CapturedTexture> textures_ IPLR_GUARDED_BY(mutex_);
+
+  // The resources seen so far, by the ID they were given. References are
+  // held so that their addresses are not reused by other resources while the
+  // capture is recording.
+  std::unordered_map<std::shared_ptr<Pipeline<PipelineDescriptor>>, int64_t>
+      pipeline_ids_ IPLR_GUARDED_BY(mutex_);
+  std::unordered_map<std::shared_ptr<const DeviceBuffer>, int64_t> buffer_ids_
+      IPLR_GUARDED_BY(mutex_);
+  std::unordered_map<std::shared_ptr<const Texture>, int64_t> texture_ids_
+      IPLR_GUARDED_BY(mutex_);
+
+  int64_t CaptureBufferRange(const std::shared_ptr<const DeviceBuffer>& buffer,
+                             size_t offset,
+                             size_t length) IPLR_REQUIRES(mutex_);
+
+  int64_t CaptureTexture(const std::shared_ptr<const Texture>& texture)
+      IPLR_REQUIRES(mutex_);
+
+  int64_t CapturePipeline(
+      const std::shared_ptr<Pipeline<PipelineDescriptor>>& pipeline)
+      IPLR_REQUIRES(mutex_);
+
+  FrameCapture(const FrameCapture&) = delete;
+
+  FrameCapture& operator=(const FrameCapture&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_FRAME_CAPTURE_H_
@@ -0,0 +1,106 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/paths.h"
+#include "flutter/testing/testing.h"
+#include "impeller/core/host_buffer.h"
+#include "impeller/fixtures/box_fade.frag.h"
+#include "impeller/fixtures/box_fade.vert.h"
+#include "impeller/playground/playground_test.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/frame_capture.h"
+#include "impeller/renderer/pipeline_builder.h"
+#include "impeller/renderer/pipeline_library.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/render_target.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
+
+// NOLINTBEGIN(bugprone-unchecked-optional-access)
+
+namespace impeller {
+namespace testing {
+
+using FrameCaptureTest = PlaygroundTest;
+INSTANTIATE_PLAYGROUND_SUITE(FrameCaptureTest);
+
+TEST_P(FrameCaptureTest, CapturedFrameRoundTripsThroughArchiveAndReplays) {
+  using VS = BoxFadeVertexShader;
+  using FS = BoxFadeFragmentShader;
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+  auto pipeline_desc =
+      PipelineBuilder<VS, FS>::MakeDefaultPipelineDescriptor(*context);
+  ASSERT_TRUE(pipeline_desc.has_value());
+  pipeline_desc->SetSampleCount(SampleCount::kCount1);
+  auto box_pipeline =
+      context->GetPipelineLibrary()->GetPipeline(pipeline_desc).Get();
+  ASSERT_TRUE(box_pipeline);
+
+  VertexBufferBuilder<VS::PerVertexData> vertex_builder;
+  vertex_builder.AddVertices({
+      {{100, 100, 0.0}, {0.0, 0.0}},  // 1
+      {{800, 100, 0.0}, {1.0, 0.0}},  // 2
+      {{800, 800, 0.0}, {1.0, 1.0}},  // 3
+      {{100, 100, 0.0}, {0.0, 0.0}},  // 1
+      {{800, 800, 0.0}, {1.0, 1.0}},  // 3
+      {{100, 800, 0.0}, {0.0, 1.0}},  // 4
+  });
+  auto vertex_buffer =
+      vertex_builder.CreateVertexBuffer(*context->GetResourceAllocator());
+  ASSERT_TRUE(vertex_buffer);
+  auto bridge = CreateTextureForFixture("bay_bridge.jpg");
+  auto boston = CreateTextureForFixture("boston.jpg");
+  ASSERT_TRUE(bridge && boston);
+  auto sampler = context->GetSamplerLibrary()->GetSampler({});
+  auto host_buffer = HostBuffer::Create(context->GetResourceAllocator());
+
+  auto capture = std::make_shared<FrameCapture>();
+  context->frame_capture = capture;
+  {
+    auto cmd_buffer = context->CreateCommandBuffer();
+    RenderTargetAllocator allocator(context->GetResourceAllocator());
+    auto render_target = RenderTarget::CreateOffscreen(
+        *context, allocator, {400, 400}, /*mip_count=*/1);
+    auto pass = cmd_buffer->CreateRenderPass(render_target);
+    ASSERT_TRUE(pass);
+
+    pass->SetCommandLabel("Box");
+    pass->SetPipeline(box_pipeline);
+    pass->SetVertexBuffer(vertex_buffer);
+    FS::FrameInfo frame_info;
+    frame_info.current_time = 1.0f;
+    FS::BindFrameInfo(*pass, host_buffer->EmplaceUniform(frame_info));
+    FS::BindContents1(*pass, boston, sampler);
+    FS::BindContents2(*pass, bridge, sampler);
+    VS::UniformBuffer uniforms;
+    uniforms.mvp = pass->GetOrthographicTransform();
+    VS::BindUniformBuffer(*pass, host_buffer->EmplaceUniform(uniforms));
+    ASSERT_TRUE(pass->Draw().ok());
+    ASSERT_TRUE(cmd_buffer->EncodeAndSubmit(pass));
+  }
+  context->frame_capture = nullptr;
+
+  EXPECT_EQ(capture->GetRenderPassCount(), 1u);
+  EXPECT_EQ(capture->GetCommandCount(), 1u);
+
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto archive_path = fml::paths::JoinPaths({temp_dir.path(), "frame.db"});
+  ASSERT_TRUE(capture->WriteToArchive(archive_path));
+
+  auto read_capture = FrameCapture::ReadFromArchive(archive_path);
+  ASSERT_TRUE(read_capture);
+  EXPECT_EQ(read_capture->GetRenderPassCount(), 1u);
+  EXPECT_EQ(read_capture->GetCommandCount(), 1u);
+
+  auto statistics = read_capture->Replay(context, /*iteration_count=*/2u);
+  ASSERT_TRUE(statistics.has_value());
+  EXPECT_EQ(statistics->iteration_count, 2u);
+  EXPECT_LE(statistics->min_frame_time, statistics->max_frame_time);
+}
+
+}  // namespace testing
+}  // namespace impeller
+
+// NOLINTEND(bugprone-unchecked-optional-access)
@@ -0,0 +1,71 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/gpu_statistics.h"
+
+#include <memory>
+#include <utility>
+
+#include "impeller/core/texture.h"
+#include "impeller/renderer/render_target.h"
+
+namespace impeller {
+
+static size_t GetAttachmentByteSize(const std::shared_ptr<Texture>& texture) {
+  if (!texture) {
+    return 0u;
+  }
+  const auto& desc = texture->GetTextureDescriptor();
+  return desc.GetByteSizeOfBaseMipLevel() *
+         static_cast<size_t>(desc.sample_count);
+}
+
+RenderPassBandwidth EstimateRenderPassBandwidth(
+    const RenderTarget& render_target) {
+  RenderPassBandwidth bandwidth;
+  bandwidth.size = render_target.GetRenderTargetSize();
+  bandwidth.sample_count = render_target.GetSampleCount();
+  render_target.IterateAllAttachments(
+      [&bandwidth](const Attachment& attachment) -> bool {
+        const auto texture_bytes = GetAttachmentByteSize(attachment.texture);
+        if (attachment.load_action == LoadAction::kLoad) {
+          bandwidth.bytes_loaded += texture_bytes;
+        }
+        switch (attachment.store_action) {
+          case StoreAction::kDontCare:
+            break;
+          case StoreAction::kStore:
+            bandwidth.bytes_stored += texture_bytes;
+            break;
+          case StoreAction::kMultisampleResolve:
+            bandwidth.bytes_resolved +=
+                GetAttachmentByteSize(attachment.resolve_texture);
+            break;
+          case StoreAction::kStoreAndMultisampleResolve:
+            bandwidth.bytes_stored += texture_bytes;
+            bandwidth.bytes_resolved +=
+                GetAttachmentByteSize(attachment.resolve_texture);
+            break;
+        }
+        return true;
+      });
+  return bandwidth;
+}
+
+RenderPassBandwidthRecorder::RenderPassBandwidthRecorder() = default;
+
+RenderPassBandwidthRecorder::~RenderPassBandwidthRecorder() = default;
+
+void RenderPassBandwidthRecorder::Record(const RenderTarget& render_target) {
+  auto bandwidth = EstimateRenderPassBandwidth(render_target);
+  Lock lock(mutex_);
+  records_.push_back(bandwidth);
+}
+
+std::vector<RenderPassBandwidth> RenderPassBandwidthRecorder::TakeRecords() {
+  Lock lock(mutex_);
+  return std::exchange(records_, {});
+}
+
+}  // namespace impeller
@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_GPU_STATISTICS_H_
+#define FLUTTER_IMPELLER_RENDERER_GPU_STATISTICS_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "impeller/base/thread.h"
+#include "impeller/base/thread_safety.h"
+#include "impeller/core/formats.h"
+#include "impeller/geometry/size.h"
+
+namespace impeller {
+
+class RenderTarget;
+
+//------------------------------------------------------------------------------
+/// @brief      The pipeline statistics counted by the GPU for the work of a
+///             frame.
+///
+struct PipelineStatistics {
+  /// The number of times a vertex shader was invoked.
+  uint64_t vertex_invocations = 0u;
+  /// The number of primitives processed by the clipping stage.
+  uint64_t clipping_invocations = 0u;
+  /// The number of primitives output by the clipping stage.
+  uint64_t clipping_primitives = 0u;
+  /// The number of times a fragment shader was invoked.
+  uint64_t fragment_invocations = 0u;
+
+  constexpr PipelineStatistics& operator+=(const PipelineStatistics& other) {
+    vertex_invocations += other.vertex_invocations;
+    clipping_invocations += other.clipping_invocations;
+    clipping_primitives += other.clipping_primitives;
+    fragment_invocations += other.fragment_invocations;
+    return *this;
+  }
+};
+
+//------------------------------------------------------------------------------
+/// @brief      An estimate of the memory traffic of the attachments of a
+///             render pass, from the descriptors of its render target alone.
+///
+///             On tiled GPUs, attachments are read from memory when they are
+///             loaded and written back when they are stored or resolved. The
+///             traffic of the draws within the pass isn't accounted for.
+///
+struct RenderPassBandwidth {
+  ISize size;
+  SampleCount sample_count = SampleCount::kCount1;
+  /// The bytes read from memory by attachments with a load action of
+  /// |LoadAction::kLoad|.
+  size_t bytes_loaded = 0u;
+  /// The bytes written to memory by attachments that are stored.
+  size_t bytes_stored = 0u;
+  /// The bytes written to memory by the multisample resolve of attachments.
+  size_t bytes_resolved = 0u;
+
+  constexpr size_t GetTotalBytes() const {
+    return bytes_loaded + bytes_stored + bytes_resolved;
+  }
+};
+
+RenderPassBandwidth EstimateRenderPassBandwidth(
+    const RenderTarget& render_target);
+
+//------------------------------------------------------------------------------
+/// @brief      Collects the bandwidth estimates of the render passes encoded
+///             by a context, for profiling tools and benchmarks.
+///
+class RenderPassBandwidthRecorder {
+ public:
+  RenderPassBandwidthRecorder();
+
+  ~RenderPassBandwidthRecorder();
+
+  void Record(const RenderTarget& render_target);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the estimates recorded since the last call, in the
+  ///             order their render passes were encoded.
+  ///
+  std::vector<RenderPassBandwidth> TakeRecords();
+
+ private:
+  Mutex mutex_;
+  std::vector<RenderPassBandwidth> records_ IPLR_GUARDED_BY(mutex_);
+
+  RenderPassBandwidthRecorder(const RenderPassBandwidthRecorder&) = delete;
+
+  RenderPassBandwidthRecorder& operator=(const RenderPassBandwidthRecorder&) =
+      delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_GPU_STATISTICS_H_
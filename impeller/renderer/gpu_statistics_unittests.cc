@@ -0,0 +1,106 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/gpu_statistics.h"
+#include "impeller/renderer/render_target.h"
+#include "impeller/renderer/testing/mocks.h"
+
+namespace impeller {
+namespace testing {
+
+static std::shared_ptr<Texture> MakeAttachmentTexture(
+    PixelFormat format,
+    SampleCount sample_count) {
+  TextureDescriptor desc;
+  desc.type = sample_count == SampleCount::kCount1
+                  ? TextureType::kTexture2D
+                  : TextureType::kTexture2DMultisample;
+  desc.format = format;
+  desc.size = {100, 50};
+  desc.sample_count = sample_count;
+  return std::make_shared<MockTexture>(desc);
+}
+
+TEST(GPUStatisticsTest, EstimatesBandwidthOfLoadedAndStoredAttachments) {
+  ColorAttachment color;
+  color.texture = MakeAttachmentTexture(PixelFormat::kR8G8B8A8UNormInt,
+                                        SampleCount::kCount1);
+  color.load_action = LoadAction::kLoad;
+  color.store_action = StoreAction::kStore;
+
+  StencilAttachment stencil;
+  stencil.texture =
+      MakeAttachmentTexture(PixelFormat::kS8UInt, SampleCount::kCount1);
+  stencil.load_action = LoadAction::kClear;
+  stencil.store_action = StoreAction::kDontCare;
+
+  RenderTarget render_target;
+  render_target.SetColorAttachment(color, 0u);
+  render_target.SetStencilAttachment(stencil);
+
+  auto bandwidth = EstimateRenderPassBandwidth(render_target);
+  EXPECT_EQ(bandwidth.size, ISize(100, 50));
+  EXPECT_EQ(bandwidth.bytes_loaded, 100u * 50u * 4u);
+  EXPECT_EQ(bandwidth.bytes_stored, 100u * 50u * 4u);
+  EXPECT_EQ(bandwidth.bytes_resolved, 0u);
+  EXPECT_EQ(bandwidth.GetTotalBytes(), 2u * 100u * 50u * 4u);
+}
+
+TEST(GPUStatisticsTest, EstimatesBandwidthOfMultisampleResolves) {
+  ColorAttachment color;
+  color.texture = MakeAttachmentTexture(PixelFormat::kR8G8B8A8UNormInt,
+                                        SampleCount::kCount4);
+  color.resolve_texture = MakeAttachmentTexture(
+      PixelFormat::kR8G8B8A8UNormInt, SampleCount::kCount1);
+  color.load_action = LoadAction::kClear;
+  color.store_action = StoreAction::kStoreAndMultisampleResolve;
+
+  RenderTarget render_target;
+  render_target.SetColorAttachment(color, 0u);
+
+  auto bandwidth = EstimateRenderPassBandwidth(render_target);
+  EXPECT_EQ(bandwidth.bytes_loaded, 0u);
+  EXPECT_EQ(bandwidth.bytes_stored, 4u * 100u * 50u * 4u);
+  EXPECT_EQ(bandwidth.bytes_resolved, 100u * 50u * 4u);
+}
+
+TEST(GPUStatisticsTest, RecorderTakesRecordsInOrder) {
+  ColorAttachment color;
+  color.texture = MakeAttachmentTexture(PixelFormat::kR8G8B8A8UNormInt,
+                                        SampleCount::kCount1);
+  color.store_action = StoreAction::kStore;
+  RenderTarget render_target;
+  render_target.SetColorAttachment(color, 0u);
+
+  RenderPassBandwidthRecorder recorder;
+  recorder.Record(render_target);
+  color.store_action = StoreAction::kDontCare;
+  render_target.SetColorAttachment(color, 0u);
+  recorder.Record(render_target);
+
+  auto records = recorder.TakeRecords();
+  ASSERT_EQ(records.size(), 2u);
+  EXPECT_EQ(records[0].bytes_stored, 100u * 50u * 4u);
+  EXPECT_EQ(records[1].bytes_stored, 0u);
+  EXPECT_TRUE(recorder.TakeRecords().empty());
+}
+
+TEST(GPUStatisticsTest, PipelineStatisticsAccumulate) {
+  PipelineStatistics total;
+  total += {.vertex_invocations = 6u,
+            .clipping_invocations = 2u,
+            .clipping_primitives = 2u,
+            .fragment_invocations = 100u};
+  total += {.vertex_invocations = 3u, .fragment_invocations = 20u};
+  EXPECT_EQ(total.vertex_invocations, 9u);
+  EXPECT_EQ(total.clipping_invocations, 2u);
+  EXPECT_EQ(total.clipping_primitives, 2u);
+  EXPECT_EQ(total.fragment_invocations, 120u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -4,6 +4,7 @@
 
 #include "gtest/gtest.h"
 
+#include "impeller/renderer/command.h"
 #include "impeller/renderer/pool.h"
 
 namespace impeller {
@@ -60,5 +61,26 @@ TEST(PoolTest, Overload) {
   EXPECT_EQ(pool.GetSize(), 1'000u);
 }
 
+TEST(PoolTest, RecycledRenderPassCommandsKeepTheirBindingStorage) {
+  Pool<RenderPassCommands> pool(1'000'000);
+  {
+    auto storage = pool.Grab();
+    Command command = storage->TakeSpare();
+    command.stencil_reference = 2u;
+    command.fragment_bindings.buffers.resize(4u);
+    storage->commands.emplace_back(std::move(command));
+    pool.Recycle(storage);
+  }
+  auto storage = pool.Grab();
+  EXPECT_TRUE(storage->commands.empty());
+  ASSERT_EQ(storage->spares.size(), 1u);
+
+  Command command = storage->TakeSpare();
+  EXPECT_TRUE(storage->spares.empty());
+  EXPECT_EQ(command.stencil_reference, 0u);
+  EXPECT_TRUE(command.fragment_bindings.buffers.empty());
+  EXPECT_GE(command.fragment_bindings.buffers.capacity(), 4u);
+}
+
 }  // namespace testing
 }  // namespace impeller
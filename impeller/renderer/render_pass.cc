@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/render_pass.h"
 #include "fml/status.h"
+#include "impeller/renderer/context.h"
+#include "impeller/renderer/frame_capture.h"
 
 namespace impeller {
 
@@ -15,9 +17,23 @@ RenderPass::RenderPass(std::weak_ptr<const Context> context,
       has_stencil_attachment_(target.GetStencilAttachment().has_value()),
       render_target_size_(target.GetRenderTargetSize()),
       render_target_(target),
-      orthographic_(Matrix::MakeOrthographic(render_target_size_)) {}
+      orthographic_(Matrix::MakeOrthographic(render_target_size_)) {
+  if (auto strong_context = context_.lock()) {
+    storage_ = strong_context->GetRenderPassCommandsPool().Grab();
+    commands_.swap(storage_->commands);
+    pending_ = storage_->TakeSpare();
+  }
+}
 
-RenderPass::~RenderPass() {}
+RenderPass::~RenderPass() {
+  auto strong_context = context_.lock();
+  if (!storage_ || !strong_context) {
+    return;
+  }
+  commands_.swap(storage_->commands);
+  storage_->commands.emplace_back(std::move(pending_));
+  strong_context->GetRenderPassCommandsPool().Recycle(std::move(storage_));
+}
 
 SampleCount RenderPass::GetSampleCount() const {
   return sample_count_;
@@ -82,6 +98,12 @@ bool RenderPass::EncodeCommands() const {
   if (!context) {
     return false;
   }
+  if (context->frame_capture) {
+    context->frame_capture->AddRenderPass(*this);
+  }
+  if (context->bandwidth_recorder) {
+    context->bandwidth_recorder->Record(render_target_);
+  }
   return OnEncodeCommands(*context);
 }
 
@@ -100,6 +122,17 @@ void RenderPass::SetCommandLabel(std::string_view label) {
 #endif  // IMPELLER_DEBUG
 }
 
+void RenderPass::SetDrawCategory(DrawCategory category) {
+  draw_category_ = category;
+#ifdef IMPELLER_DEBUG
+  pending_.category = category;
+#endif  // IMPELLER_DEBUG
+}
+
+DrawCategory RenderPass::GetDrawCategory() const {
+  return draw_category_;
+}
+
 void RenderPass::SetStencilReference(uint32_t value) {
   pending_.stencil_reference = value;
 }
@@ -116,6 +149,11 @@ void RenderPass::SetScissor(IRect scissor) {
   pending_.scissor = scissor;
 }
 
+void RenderPass::SetClipScissor(std::optional<IRect> scissor) {
+  clip_scissor_ = scissor;
+  pending_.scissor = scissor;
+}
+
 void RenderPass::SetInstanceCount(size_t count) {
   pending_.instance_count = count;
 }
@@ -126,7 +164,11 @@ bool RenderPass::SetVertexBuffer(VertexBuffer buffer) {
 
 fml::Status RenderPass::Draw() {
   auto result = AddCommand(std::move(pending_));
-  pending_ = Command{};
+  pending_ = storage_ ? storage_->TakeSpare() : Command{};
+  pending_.scissor = clip_scissor_;
+#ifdef IMPELLER_DEBUG
+  pending_.category = draw_category_;
+#endif  // IMPELLER_DEBUG
   if (result) {
     return fml::Status();
   }
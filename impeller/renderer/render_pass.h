@@ -62,6 +62,14 @@ class RenderPass : public ResourceBinder {
   /// The debugging label to use for the command.
   void SetCommandLabel(std::string_view label);
 
+  //----------------------------------------------------------------------------
+  /// The kind of contents drawn by this and every following command, used by
+  /// GPU tracers to attribute the GPU time of a frame.
+  ///
+  void SetDrawCategory(DrawCategory category);
+
+  DrawCategory GetDrawCategory() const;
+
   //----------------------------------------------------------------------------
   /// The reference value to use in stenciling operations. Stencil configuration
   /// is part of pipeline setup and can be read from the pipelines descriptor.
@@ -88,6 +96,13 @@ class RenderPass : public ResourceBinder {
   ///
   void SetScissor(IRect scissor);
 
+  //----------------------------------------------------------------------------
+  /// The scissor rect applied to this and every following command that does
+  /// not set its own scissor. Entity passes use it to apply rectangular clips
+  /// without the stencil buffer. std::nullopt removes it.
+  ///
+  void SetClipScissor(std::optional<IRect> scissor);
+
   //----------------------------------------------------------------------------
   /// The number of instances of the given set of vertices to render. Not all
   /// backends support rendering more than one instance at a time.
@@ -192,7 +207,12 @@ class RenderPass : public ResourceBinder {
 
   RenderPass& operator=(const RenderPass&) = delete;
 
+  // The pooled storage that `commands_` and the spare commands that
+  // `pending_` is taken from come from.
+  std::shared_ptr<RenderPassCommands> storage_;
   Command pending_;
+  std::optional<IRect> clip_scissor_;
+  DrawCategory draw_category_ = DrawCategory::kOther;
 };
 
 }  // namespace impeller
@@ -22,6 +22,12 @@ void RenderTargetAllocator::Start() {}
 
 void RenderTargetAllocator::End() {}
 
+void RenderTargetAllocator::Trim() {}
+
+size_t RenderTargetAllocator::GetCachedBytes() const {
+  return 0u;
+}
+
 std::shared_ptr<Texture> RenderTargetAllocator::CreateTexture(
     const TextureDescriptor& desc) {
   return allocator_->CreateTexture(desc);
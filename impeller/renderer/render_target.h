@@ -42,6 +42,14 @@ class RenderTargetAllocator {
   ///        This may be used to deallocate any unused textures.
   virtual void End();
 
+  /// @brief Deallocate the textures kept for reuse that are not in use.
+  ///
+  ///        Called when the device is low on memory.
+  virtual void Trim();
+
+  /// @brief The bytes of the textures kept for reuse, whether in use or not.
+  virtual size_t GetCachedBytes() const;
+
  private:
   std::shared_ptr<Allocator> allocator_;
 };
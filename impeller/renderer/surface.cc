@@ -38,4 +38,13 @@ bool Surface::Present() const {
   return false;
 };
 
+void Surface::SetPresentationTime(
+    std::optional<fml::TimePoint> presentation_time) {
+  presentation_time_ = presentation_time;
+}
+
+std::optional<fml::TimePoint> Surface::GetPresentationTime() const {
+  return presentation_time_;
+}
+
 }  // namespace impeller
@@ -7,8 +7,10 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/render_target.h"
@@ -31,9 +33,19 @@ class Surface {
 
   virtual bool Present() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the time at which the frame drawn to this surface is
+  ///             scheduled to be shown. Backends that support it do not present
+  ///             the surface earlier.
+  ///
+  void SetPresentationTime(std::optional<fml::TimePoint> presentation_time);
+
+  std::optional<fml::TimePoint> GetPresentationTime() const;
+
  private:
   RenderTarget desc_;
   ISize size_;
+  std::optional<fml::TimePoint> presentation_time_;
 
   bool is_valid_ = false;
 
@@ -81,7 +81,7 @@ class MockBlitPass : public BlitPass {
               OnCopyBufferToTextureCommand,
               (BufferView source,
                std::shared_ptr<Texture> destination,
-               IPoint destination_origin,
+               IRect destination_region,
                std::string label),
               (override));
   MOCK_METHOD(bool,
@@ -195,6 +195,10 @@ class MockCapabilities : public Capabilities {
   MOCK_METHOD(bool, SupportsReadFromResolve, (), (const, override));
   MOCK_METHOD(bool, SupportsDecalSamplerAddressMode, (), (const, override));
   MOCK_METHOD(bool, SupportsDeviceTransientTextures, (), (const, override));
+  MOCK_METHOD(bool,
+              SupportsCompressedTextureFormat,
+              (PixelFormat format),
+              (const, override));
   MOCK_METHOD(PixelFormat, GetDefaultColorFormat, (), (const, override));
   MOCK_METHOD(PixelFormat, GetDefaultStencilFormat, (), (const, override));
   MOCK_METHOD(PixelFormat, GetDefaultDepthStencilFormat, (), (const, override));
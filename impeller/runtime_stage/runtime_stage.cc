@@ -57,16 +57,23 @@ std::unique_ptr<RuntimeStage> RuntimeStage::RuntimeStageIfPresent(
       new RuntimeStage(runtime_stage, payload));
 }
 
-RuntimeStage::Map RuntimeStage::DecodeRuntimeStages(
+static const fb::RuntimeStages* GetRuntimeStages(
     const std::shared_ptr<fml::Mapping>& payload) {
   if (payload == nullptr || !payload->GetMapping()) {
-    return {};
+    return nullptr;
   }
   if (!fb::RuntimeStagesBufferHasIdentifier(payload->GetMapping())) {
-    return {};
+    return nullptr;
   }
+  return fb::GetRuntimeStages(payload->GetMapping());
+}
 
-  auto raw_stages = fb::GetRuntimeStages(payload->GetMapping());
+RuntimeStage::Map RuntimeStage::DecodeRuntimeStages(
+    const std::shared_ptr<fml::Mapping>& payload) {
+  auto raw_stages = GetRuntimeStages(payload);
+  if (!raw_stages) {
+    return {};
+  }
   return {
       {RuntimeStageBackend::kSkSL,
        RuntimeStageIfPresent(raw_stages->sksl(), payload)},
@@ -79,6 +86,26 @@ RuntimeStage::Map RuntimeStage::DecodeRuntimeStages(
   };
 }
 
+std::shared_ptr<RuntimeStage> RuntimeStage::DecodeRuntimeStage(
+    const std::shared_ptr<fml::Mapping>& payload,
+    RuntimeStageBackend backend) {
+  auto raw_stages = GetRuntimeStages(payload);
+  if (!raw_stages) {
+    return nullptr;
+  }
+  switch (backend) {
+    case RuntimeStageBackend::kSkSL:
+      return RuntimeStageIfPresent(raw_stages->sksl(), payload);
+    case RuntimeStageBackend::kMetal:
+      return RuntimeStageIfPresent(raw_stages->metal(), payload);
+    case RuntimeStageBackend::kOpenGLES:
+      return RuntimeStageIfPresent(raw_stages->opengles(), payload);
+    case RuntimeStageBackend::kVulkan:
+      return RuntimeStageIfPresent(raw_stages->vulkan(), payload);
+  }
+  FML_UNREACHABLE();
+}
+
 RuntimeStage::RuntimeStage(const fb::RuntimeStage* runtime_stage,
                            const std::shared_ptr<fml::Mapping>& payload)
     : payload_(payload) {
@@ -23,6 +23,15 @@ class RuntimeStage {
   using Map = std::map<RuntimeStageBackend, std::shared_ptr<RuntimeStage>>;
   static Map DecodeRuntimeStages(const std::shared_ptr<fml::Mapping>& payload);
 
+  /// @brief Decodes only the stage for the given backend, leaving the stages
+  ///        of the other backends in the payload untouched.
+  ///
+  /// @return The stage, or nullptr if the payload is invalid or doesn't
+  ///         contain a stage for the backend.
+  static std::shared_ptr<RuntimeStage> DecodeRuntimeStage(
+      const std::shared_ptr<fml::Mapping>& payload,
+      RuntimeStageBackend backend);
+
   RuntimeStage(const fb::RuntimeStage* runtime_stage,
                const std::shared_ptr<fml::Mapping>& payload);
   ~RuntimeStage();
@@ -36,6 +36,21 @@ TEST_P(RuntimeStageTest, CanReadValidBlob) {
   ASSERT_EQ(stage->GetShaderStage(), RuntimeShaderStage::kFragment);
 }
 
+TEST_P(RuntimeStageTest, CanDecodeSingleBackend) {
+  const std::shared_ptr<fml::Mapping> fixture =
+      flutter::testing::OpenFixtureAsMapping("ink_sparkle.frag.iplr");
+  ASSERT_TRUE(fixture);
+  auto backend = PlaygroundBackendToRuntimeStageBackend(GetBackend());
+  auto stage = RuntimeStage::DecodeRuntimeStage(fixture, backend);
+  ASSERT_TRUE(stage);
+  ASSERT_TRUE(stage->IsValid());
+  auto stages = RuntimeStage::DecodeRuntimeStages(fixture);
+  ASSERT_EQ(stage->GetEntrypoint(), stages[backend]->GetEntrypoint());
+  ASSERT_EQ(stage->GetUniforms().size(), stages[backend]->GetUniforms().size());
+  ASSERT_EQ(stage->GetCodeMapping()->GetSize(),
+            stages[backend]->GetCodeMapping()->GetSize());
+}
+
 TEST_P(RuntimeStageTest, CanRejectInvalidBlob) {
   ScopedValidationDisable disable_validation;
   const std::shared_ptr<fml::Mapping> fixture =
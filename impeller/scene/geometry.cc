@@ -15,6 +15,7 @@
 #include "impeller/geometry/vector.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/vertex_buffer_builder.h"
+#include "impeller/scene/importer/conversions.h"
 #include "impeller/scene/importer/scene_flatbuffers.h"
 #include "impeller/scene/shaders/skinned.vert.h"
 #include "impeller/scene/shaders/unskinned.vert.h"
@@ -34,8 +35,10 @@ std::shared_ptr<CuboidGeometry> Geometry::MakeCuboid(Vector3 size) {
   return result;
 }
 
-std::shared_ptr<Geometry> Geometry::MakeVertexBuffer(VertexBuffer vertex_buffer,
-                                                     bool is_skinned) {
+std::shared_ptr<Geometry> Geometry::MakeVertexBuffer(
+    VertexBuffer vertex_buffer,
+    bool is_skinned,
+    std::optional<GeometryBounds> bounds) {
   if (is_skinned) {
     auto result = std::make_shared<SkinnedVertexBufferGeometry>();
     result->SetVertexBuffer(std::move(vertex_buffer));
@@ -43,10 +46,27 @@ std::shared_ptr<Geometry> Geometry::MakeVertexBuffer(VertexBuffer vertex_buffer,
   } else {
     auto result = std::make_shared<UnskinnedVertexBufferGeometry>();
     result->SetVertexBuffer(std::move(vertex_buffer));
+    result->SetBounds(bounds);
     return result;
   }
 }
 
+template <typename VertexType>
+static std::optional<GeometryBounds> ComputeBounds(
+    const flatbuffers::Vector<const VertexType*>& vertices) {
+  if (vertices.size() == 0) {
+    return std::nullopt;
+  }
+  GeometryBounds bounds;
+  bounds.min = bounds.max = importer::ToVector3(vertices.Get(0)->position());
+  for (const VertexType* vertex : vertices) {
+    Vector3 position = importer::ToVector3(vertex->position());
+    bounds.min = bounds.min.Min(position);
+    bounds.max = bounds.max.Max(position);
+  }
+  return bounds;
+}
+
 std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
     const fb::MeshPrimitive& mesh,
     Allocator& allocator) {
@@ -63,6 +83,7 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
   const uint8_t* vertices_start;
   size_t vertices_bytes;
   bool is_skinned;
+  std::optional<GeometryBounds> bounds;
 
   switch (mesh.vertices_type()) {
     case fb::VertexBuffer::UnskinnedVertexBuffer: {
@@ -71,6 +92,7 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
       vertices_start = reinterpret_cast<const uint8_t*>(vertices->Get(0));
       vertices_bytes = vertices->size() * sizeof(fb::Vertex);
       is_skinned = false;
+      bounds = ComputeBounds(*vertices);
       break;
     }
     case fb::VertexBuffer::SkinnedVertexBuffer: {
@@ -115,11 +137,15 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
       .vertex_count = mesh.indices()->count(),
       .index_type = index_type,
   };
-  return MakeVertexBuffer(std::move(vertex_buffer), is_skinned);
+  return MakeVertexBuffer(std::move(vertex_buffer), is_skinned, bounds);
 }
 
 void Geometry::SetJointsTexture(const std::shared_ptr<Texture>& texture) {}
 
+std::optional<GeometryBounds> Geometry::GetBounds() const {
+  return std::nullopt;
+}
+
 //------------------------------------------------------------------------------
 /// CuboidGeometry
 ///
@@ -185,6 +211,11 @@ void UnskinnedVertexBufferGeometry::SetVertexBuffer(
   vertex_buffer_ = std::move(vertex_buffer);
 }
 
+void UnskinnedVertexBufferGeometry::SetBounds(
+    std::optional<GeometryBounds> bounds) {
+  bounds_ = bounds;
+}
+
 // |Geometry|
 GeometryType UnskinnedVertexBufferGeometry::GetGeometryType() const {
   return GeometryType::kUnskinned;
@@ -210,6 +241,12 @@ void UnskinnedVertexBufferGeometry::BindToCommand(
   UnskinnedVertexShader::BindFrameInfo(pass, buffer.EmplaceUniform(info));
 }
 
+// |Geometry|
+std::optional<GeometryBounds> UnskinnedVertexBufferGeometry::GetBounds()
+    const {
+  return bounds_;
+}
+
 //------------------------------------------------------------------------------
 /// SkinnedVertexBufferGeometry
 ///
@@ -6,6 +6,7 @@
 #define FLUTTER_IMPELLER_SCENE_GEOMETRY_H_
 
 #include <memory>
+#include <optional>
 
 #include "flutter/fml/macros.h"
 #include "impeller/core/allocator.h"
@@ -26,14 +27,25 @@ namespace scene {
 class CuboidGeometry;
 class UnskinnedVertexBufferGeometry;
 
+/// An axis-aligned box that contains the vertices of a geometry, in the model
+/// space of the geometry.
+struct GeometryBounds {
+  Vector3 min;
+  Vector3 max;
+};
+
 class Geometry {
  public:
   virtual ~Geometry();
 
   static std::shared_ptr<CuboidGeometry> MakeCuboid(Vector3 size);
 
-  static std::shared_ptr<Geometry> MakeVertexBuffer(VertexBuffer vertex_buffer,
-                                                    bool is_skinned);
+  /// The bounds are ignored for skinned geometry, whose vertices are moved
+  /// by the joints.
+  static std::shared_ptr<Geometry> MakeVertexBuffer(
+      VertexBuffer vertex_buffer,
+      bool is_skinned,
+      std::optional<GeometryBounds> bounds = std::nullopt);
 
   static std::shared_ptr<Geometry> MakeFromFlatbuffer(
       const fb::MeshPrimitive& mesh,
@@ -49,6 +61,10 @@ class Geometry {
                              RenderPass& pass) const = 0;
 
   virtual void SetJointsTexture(const std::shared_ptr<Texture>& texture);
+
+  /// Returns the bounds of the geometry, or std::nullopt if they are unknown
+  /// and the geometry must never be culled.
+  virtual std::optional<GeometryBounds> GetBounds() const;
 };
 
 class CuboidGeometry final : public Geometry {
@@ -87,6 +103,8 @@ class UnskinnedVertexBufferGeometry final : public Geometry {
 
   void SetVertexBuffer(VertexBuffer vertex_buffer);
 
+  void SetBounds(std::optional<GeometryBounds> bounds);
+
   // |Geometry|
   GeometryType GetGeometryType() const override;
 
@@ -99,8 +117,12 @@ class UnskinnedVertexBufferGeometry final : public Geometry {
                      const Matrix& transform,
                      RenderPass& pass) const override;
 
+  // |Geometry|
+  std::optional<GeometryBounds> GetBounds() const override;
+
  private:
   VertexBuffer vertex_buffer_;
+  std::optional<GeometryBounds> bounds_;
 
   UnskinnedVertexBufferGeometry(const UnskinnedVertexBufferGeometry&) = delete;
 
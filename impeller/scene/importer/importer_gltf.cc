@@ -167,6 +167,9 @@ static bool ProcessMeshPrimitive(const tinygltf::Model& gltf,
     const auto* index_buffer =
         &gltf.buffers[index_view.buffer].data[index_view.byteOffset];
     std::memcpy(indices->data.data(), index_buffer, indices->data.size());
+    if (primitive.mode == TINYGLTF_MODE_TRIANGLES) {
+      OptimizeVertexCacheOrder(*indices);
+    }
 
     mesh_primitive.indices = std::move(indices);
   }
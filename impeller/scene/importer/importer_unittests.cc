@@ -2,12 +2,18 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <vector>
+
 #include "flutter/testing/testing.h"
 #include "impeller/geometry/geometry_asserts.h"
 #include "impeller/geometry/matrix.h"
 #include "impeller/scene/importer/conversions.h"
 #include "impeller/scene/importer/importer.h"
 #include "impeller/scene/importer/scene_flatbuffers.h"
+#include "impeller/scene/importer/vertices_builder.h"
 
 namespace impeller {
 namespace scene {
@@ -31,9 +37,11 @@ TEST(ImporterTest, CanParseUnskinnedGLTF) {
   auto& mesh = *node->mesh_primitives[0];
   ASSERT_EQ(mesh.indices->count, 918u);
 
+  // The triangles are reordered for the vertex cache, starting from the
+  // triangles around the first vertex.
   uint16_t first_index =
       *reinterpret_cast<uint16_t*>(mesh.indices->data.data());
-  ASSERT_EQ(first_index, 45u);
+  ASSERT_EQ(first_index, 0u);
 
   ASSERT_EQ(mesh.vertices.type, fb::VertexBuffer::UnskinnedVertexBuffer);
   auto& vertices = mesh.vertices.AsUnskinnedVertexBuffer()->vertices;
@@ -121,6 +129,55 @@ TEST(ImporterTest, CanParseSkinnedGLTF) {
                       Vector4(0.700151, 0.0989373, -0.0989373, 0.700151));
 }
 
+// Returns the number of vertices transformed per triangle with a FIFO vertex
+// cache of `cache_size` vertices.
+static double GetAverageCacheMissRatio(const std::vector<uint32_t>& indices,
+                                       size_t cache_size) {
+  std::deque<uint32_t> cache;
+  size_t misses = 0;
+  for (uint32_t index : indices) {
+    if (std::find(cache.begin(), cache.end(), index) == cache.end()) {
+      misses++;
+      cache.push_back(index);
+      if (cache.size() > cache_size) {
+        cache.pop_front();
+      }
+    }
+  }
+  return static_cast<double>(misses) / (indices.size() / 3);
+}
+
+static std::vector<std::array<uint32_t, 3>> GetSortedTriangles(
+    const std::vector<uint32_t>& indices) {
+  std::vector<std::array<uint32_t, 3>> triangles;
+  for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+    triangles.push_back({indices[i], indices[i + 1], indices[i + 2]});
+  }
+  std::sort(triangles.begin(), triangles.end());
+  return triangles;
+}
+
+TEST(ImporterTest, OptimizeVertexCacheOrderKeepsTrianglesAndReducesMisses) {
+  // A grid of quads in rows, which revisits the vertices of a row only after
+  // the whole row.
+  constexpr uint32_t kGridSize = 32;
+  std::vector<uint32_t> indices;
+  for (uint32_t y = 0; y < kGridSize; y++) {
+    for (uint32_t x = 0; x < kGridSize; x++) {
+      uint32_t i = y * (kGridSize + 1) + x;
+      uint32_t below = i + kGridSize + 1;
+      indices.insert(indices.end(), {i, i + 1, below, i + 1, below + 1, below});
+    }
+  }
+
+  auto optimized = OptimizeVertexCacheOrder(indices);
+
+  ASSERT_EQ(optimized.size(), indices.size());
+  ASSERT_EQ(GetSortedTriangles(optimized), GetSortedTriangles(indices));
+  ASSERT_LT(GetAverageCacheMissRatio(optimized, 16),
+            GetAverageCacheMissRatio(indices, 16) * 0.75);
+}
+
 }  // namespace testing
 }  // namespace importer
 }  // namespace scene
@@ -4,11 +4,13 @@
 
 #include "impeller/scene/importer/vertices_builder.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <limits>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 #include "flutter/fml/logging.h"
 #include "impeller/scene/importer/conversions.h"
@@ -236,6 +238,148 @@ void SkinnedVerticesBuilder::SetAttributeFromBuffer(
                  attribute_count);        // attribute_count
 }
 
+//------------------------------------------------------------------------------
+/// Index ordering
+///
+
+std::vector<uint32_t> OptimizeVertexCacheOrder(
+    const std::vector<uint32_t>& indices,
+    size_t cache_size) {
+  const size_t triangle_count = indices.size() / 3;
+  if (triangle_count == 0) {
+    return indices;
+  }
+  const size_t vertex_count =
+      *std::max_element(indices.begin(), indices.begin() + triangle_count * 3) +
+      1;
+
+  // The triangles that use each vertex, as offsets into `vertex_triangles`.
+  std::vector<size_t> triangle_offsets(vertex_count + 1, 0);
+  for (size_t i = 0; i < triangle_count * 3; i++) {
+    triangle_offsets[indices[i] + 1]++;
+  }
+  for (size_t vertex = 0; vertex < vertex_count; vertex++) {
+    triangle_offsets[vertex + 1] += triangle_offsets[vertex];
+  }
+  std::vector<size_t> vertex_triangles(triangle_count * 3);
+  {
+    std::vector<size_t> next = triangle_offsets;
+    for (size_t i = 0; i < triangle_count * 3; i++) {
+      vertex_triangles[next[indices[i]]++] = i / 3;
+    }
+  }
+
+  // The number of triangles left to emit that use each vertex.
+  std::vector<size_t> live_counts(vertex_count);
+  for (size_t vertex = 0; vertex < vertex_count; vertex++) {
+    live_counts[vertex] =
+        triangle_offsets[vertex + 1] - triangle_offsets[vertex];
+  }
+  // The time at which each vertex last entered the simulated FIFO cache.
+  std::vector<size_t> cache_times(vertex_count, 0);
+  std::vector<bool> emitted(triangle_count, false);
+  // The recently used vertices, to continue from when a fan is exhausted.
+  std::vector<uint32_t> dead_ends;
+
+  std::vector<uint32_t> result;
+  result.reserve(indices.size());
+  size_t time = cache_size + 1;
+  size_t cursor = 0;
+  int64_t fanning_vertex = 0;
+  std::vector<uint32_t> candidates;
+  while (fanning_vertex >= 0) {
+    // Emit all the triangles around the fanning vertex.
+    candidates.clear();
+    for (size_t offset = triangle_offsets[fanning_vertex];
+         offset < triangle_offsets[fanning_vertex + 1]; offset++) {
+      size_t triangle = vertex_triangles[offset];
+      if (emitted[triangle]) {
+        continue;
+      }
+      emitted[triangle] = true;
+      for (size_t corner = 0; corner < 3; corner++) {
+        uint32_t vertex = indices[triangle * 3 + corner];
+        result.push_back(vertex);
+        dead_ends.push_back(vertex);
+        candidates.push_back(vertex);
+        live_counts[vertex]--;
+        if (time - cache_times[vertex] > cache_size) {
+          cache_times[vertex] = time++;
+        }
+      }
+    }
+
+    // Continue from the candidate that will still be in the cache after its
+    // triangles are emitted and has been in it the longest.
+    fanning_vertex = -1;
+    size_t best_priority = 0;
+    for (uint32_t vertex : candidates) {
+      if (live_counts[vertex] == 0) {
+        continue;
+      }
+      size_t priority = 0;
+      if (time - cache_times[vertex] + 2 * live_counts[vertex] <= cache_size) {
+        priority = time - cache_times[vertex];
+      }
+      if (fanning_vertex < 0 || priority > best_priority) {
+        fanning_vertex = vertex;
+        best_priority = priority;
+      }
+    }
+    if (fanning_vertex >= 0) {
+      continue;
+    }
+
+    // Otherwise, continue from a recently used vertex, or from the next
+    // vertex in the input order that has triangles left.
+    while (!dead_ends.empty() && fanning_vertex < 0) {
+      uint32_t vertex = dead_ends.back();
+      dead_ends.pop_back();
+      if (live_counts[vertex] > 0) {
+        fanning_vertex = vertex;
+      }
+    }
+    while (cursor < vertex_count && fanning_vertex < 0) {
+      if (live_counts[cursor] > 0) {
+        fanning_vertex = cursor;
+      }
+      cursor++;
+    }
+  }
+
+  result.insert(result.end(), indices.begin() + triangle_count * 3,
+                indices.end());
+  return result;
+}
+
+template <typename IndexType>
+static void OptimizeVertexCacheOrder(std::vector<uint8_t>& data,
+                                     size_t count) {
+  std::vector<uint32_t> indices(
+      std::min<size_t>(count, data.size() / sizeof(IndexType)));
+  for (size_t i = 0; i < indices.size(); i++) {
+    IndexType index;
+    std::memcpy(&index, data.data() + i * sizeof(IndexType), sizeof(index));
+    indices[i] = index;
+  }
+  indices = OptimizeVertexCacheOrder(indices);
+  for (size_t i = 0; i < indices.size(); i++) {
+    IndexType index = static_cast<IndexType>(indices[i]);
+    std::memcpy(data.data() + i * sizeof(IndexType), &index, sizeof(index));
+  }
+}
+
+void OptimizeVertexCacheOrder(fb::IndicesT& indices) {
+  switch (indices.type) {
+    case fb::IndexType::k16Bit:
+      OptimizeVertexCacheOrder<uint16_t>(indices.data, indices.count);
+      break;
+    case fb::IndexType::k32Bit:
+      OptimizeVertexCacheOrder<uint32_t>(indices.data, indices.count);
+      break;
+  }
+}
+
 }  // namespace importer
 }  // namespace scene
 }  // namespace impeller
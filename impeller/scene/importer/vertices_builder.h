@@ -6,7 +6,9 @@
 #define FLUTTER_IMPELLER_SCENE_IMPORTER_VERTICES_BUILDER_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/geometry/matrix.h"
@@ -167,6 +169,31 @@ class SkinnedVerticesBuilder final : public VerticesBuilder {
   SkinnedVerticesBuilder& operator=(const SkinnedVerticesBuilder&) = delete;
 };
 
+//------------------------------------------------------------------------------
+/// Index ordering
+///
+
+/// @brief  Reorders the triangles of an indexed triangle list so that
+///         consecutive triangles share more vertices, which are then still in
+///         the post-transform vertex cache of the GPU when they are reused.
+///
+///         This is the Tipsify algorithm from "Fast Triangle Reordering for
+///         Vertex Locality and Reduced Overdraw" (Sander et al. 2007). The
+///         triangles and the order of their vertices are unchanged.
+///
+/// @param  indices     The indices of the triangles. Any trailing indices
+///                     that don't form a triangle are kept at the end.
+/// @param  cache_size  The number of vertices in the cache of the target GPUs.
+///
+std::vector<uint32_t> OptimizeVertexCacheOrder(
+    const std::vector<uint32_t>& indices,
+    size_t cache_size = 16u);
+
+/// @brief  Reorders the triangles of `indices` in place with
+///         `OptimizeVertexCacheOrder`.
+///
+void OptimizeVertexCacheOrder(fb::IndicesT& indices);
+
 }  // namespace importer
 }  // namespace scene
 }  // namespace impeller
@@ -55,6 +55,8 @@ class Material {
 
   void SetTranslucent(bool is_translucent);
 
+  bool IsTranslucent() const;
+
   SceneContextOptions GetContextOptions(const RenderPass& pass) const;
 
   virtual MaterialType GetMaterialType() const = 0;
@@ -0,0 +1,141 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "impeller/geometry/constants.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/quaternion.h"
+#include "impeller/scene/animation/animation.h"
+#include "impeller/scene/animation/animation_player.h"
+#include "impeller/scene/importer/conversions.h"
+#include "impeller/scene/node.h"
+#include "impeller/scene/skin.h"
+
+namespace impeller {
+namespace scene {
+
+namespace {
+
+// The skeletons have a root joint with limbs of several joints each, like
+// the skeletons of characters.
+constexpr size_t kLimbCount = 4u;
+constexpr size_t kJointsPerLimb = 8u;
+constexpr size_t kKeyframeCount = 30u;
+
+/// The skeleton, skin and animation of a skinned model. The meshes are left
+/// out since only the evaluation of the pose on the CPU is measured.
+struct SkinnedModel {
+  std::vector<std::shared_ptr<Node>> joints;
+  std::unique_ptr<Skin> skin;
+  AnimationPlayer player;
+};
+
+std::unique_ptr<Skin> MakeSkin(
+    const std::vector<std::shared_ptr<Node>>& joints) {
+  fb::SkinT skin;
+  for (size_t joint_i = 0; joint_i < joints.size(); joint_i++) {
+    skin.joints.push_back(joint_i);
+    skin.inverse_bind_matrices.push_back(importer::ToFBMatrix(Matrix()));
+  }
+  skin.skeleton = 0;
+
+  flatbuffers::FlatBufferBuilder builder;
+  builder.Finish(fb::Skin::Pack(builder, &skin));
+  return Skin::MakeFromFlatbuffer(
+      *flatbuffers::GetRoot<fb::Skin>(builder.GetBufferPointer()), joints);
+}
+
+/// Makes an animation that swings every joint back and forth each second.
+std::shared_ptr<Animation> MakeAnimation(
+    const std::vector<std::shared_ptr<Node>>& joints) {
+  fb::AnimationT animation;
+  animation.name = "Swing";
+  for (size_t joint_i = 0; joint_i < joints.size(); joint_i++) {
+    auto channel = std::make_unique<fb::ChannelT>();
+    channel->node = joint_i;
+    fb::RotationKeyframesT keyframes;
+    for (size_t key_i = 0; key_i < kKeyframeCount; key_i++) {
+      Scalar progress = key_i / static_cast<Scalar>(kKeyframeCount - 1);
+      Quaternion rotation({0, 0, 1}, std::sin(progress * 2 * kPi) * 0.5f);
+      channel->timeline.push_back(progress);
+      keyframes.values.push_back(
+          fb::Vec4(rotation.x, rotation.y, rotation.z, rotation.w));
+    }
+    channel->keyframes.Set(std::move(keyframes));
+    animation.channels.push_back(std::move(channel));
+  }
+
+  flatbuffers::FlatBufferBuilder builder;
+  builder.Finish(fb::Animation::Pack(builder, &animation));
+  return Animation::MakeFromFlatbuffer(
+      *flatbuffers::GetRoot<fb::Animation>(builder.GetBufferPointer()),
+      joints);
+}
+
+std::unique_ptr<SkinnedModel> MakeSkinnedModel() {
+  auto model = std::make_unique<SkinnedModel>();
+  auto& joints = model->joints;
+
+  auto root = std::make_shared<Node>();
+  root->SetName("root");
+  joints.push_back(root);
+  for (size_t limb_i = 0; limb_i < kLimbCount; limb_i++) {
+    std::shared_ptr<Node> parent = root;
+    for (size_t joint_i = 0; joint_i < kJointsPerLimb; joint_i++) {
+      auto joint = std::make_shared<Node>();
+      joint->SetName("joint_" + std::to_string(joints.size()));
+      parent->AddChild(joint);
+      joints.push_back(joint);
+      parent = joint;
+    }
+  }
+
+  model->skin = MakeSkin(joints);
+  // Creating the skin moves the joints to their bind pose.
+  for (size_t joint_i = 1; joint_i < joints.size(); joint_i++) {
+    joints[joint_i]->SetLocalTransform(Matrix::MakeTranslation({0, 1, 0}));
+  }
+
+  AnimationClip* clip =
+      model->player.AddAnimation(MakeAnimation(joints), root.get());
+  clip->SetPlaying(true);
+  clip->SetLoop(true);
+  clip->SetWeight(1);
+  return model;
+}
+
+}  // namespace
+
+// The CPU cost per frame of the animated skinned models of a scene: sampling
+// their animations and computing the joint matrices of their skins. The
+// argument is the number of models.
+static void BM_AnimateSkinnedModels(benchmark::State& state) {
+  std::vector<std::unique_ptr<SkinnedModel>> models;
+  for (int64_t model_i = 0; model_i < state.range(0); model_i++) {
+    models.push_back(MakeSkinnedModel());
+  }
+
+  for (auto _ : state) {
+    for (auto& model : models) {
+      model->player.Update();
+      benchmark::DoNotOptimize(model->skin->ComputeJointMatrices().data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["joints_per_model"] = 1 + kLimbCount * kJointsPerLimb;
+}
+
+BENCHMARK(BM_AnimateSkinnedModels)
+    ->ArgName("models")
+    ->RangeMultiplier(4)
+    ->Range(1, 256);
+
+}  // namespace scene
+}  // namespace impeller
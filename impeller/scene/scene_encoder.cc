@@ -4,6 +4,12 @@
 
 #include "flutter/fml/macros.h"
 
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <optional>
+#include <utility>
+
 #include "flutter/fml/logging.h"
 #include "impeller/renderer/command.h"
 #include "impeller/renderer/render_target.h"
@@ -20,6 +26,94 @@ void SceneEncoder::Add(const SceneCommand& command) {
   commands_.push_back(command);
 }
 
+namespace {
+
+/// A command whose geometry is in the view frustum.
+struct VisibleCommand {
+  const SceneCommand* command;
+  /// The distance from the camera to the nearest point of the geometry.
+  Scalar depth;
+};
+
+}  // namespace
+
+/// Returns the distance from the camera to the nearest corner of the bounds
+/// of the geometry, or std::nullopt if the bounds are entirely outside of one
+/// of the clip planes. Geometry without bounds is never culled, and its depth
+/// is that of its origin.
+static std::optional<Scalar> GetVisibleDepth(const Matrix& transform,
+                                             const Geometry& geometry) {
+  std::optional<GeometryBounds> bounds = geometry.GetBounds();
+  if (!bounds.has_value()) {
+    return (transform * Vector4(0, 0, 0, 1)).w;
+  }
+
+  // The number of corners outside of each of the planes of the clip volume,
+  // which is -w <= x <= w, -w <= y <= w and 0 <= z <= w.
+  std::array<size_t, 6> outside_counts = {};
+  Scalar depth = std::numeric_limits<Scalar>::max();
+  for (size_t corner_i = 0; corner_i < 8; corner_i++) {
+    Vector4 corner((corner_i & 1) ? bounds->max.x : bounds->min.x,
+                   (corner_i & 2) ? bounds->max.y : bounds->min.y,
+                   (corner_i & 4) ? bounds->max.z : bounds->min.z, 1);
+    Vector4 clip = transform * corner;
+    outside_counts[0] += clip.x < -clip.w;
+    outside_counts[1] += clip.x > clip.w;
+    outside_counts[2] += clip.y < -clip.w;
+    outside_counts[3] += clip.y > clip.w;
+    outside_counts[4] += clip.z < 0;
+    outside_counts[5] += clip.z > clip.w;
+    depth = std::min(depth, clip.w);
+  }
+  for (size_t outside_count : outside_counts) {
+    if (outside_count == 8) {
+      return std::nullopt;
+    }
+  }
+  return depth;
+}
+
+/// Culls the commands whose geometry is outside of the view frustum, and
+/// orders the rest: the opaque commands first, grouped by pipeline and from
+/// front to back so that the depth test rejects the occluded fragments early,
+/// then the translucent commands from back to front so that they blend in
+/// order.
+static std::vector<VisibleCommand> GetVisibleCommands(
+    const std::vector<SceneCommand>& commands,
+    const Matrix& camera_transform) {
+  std::vector<VisibleCommand> visible_commands;
+  visible_commands.reserve(commands.size());
+  for (const auto& command : commands) {
+    std::optional<Scalar> depth = GetVisibleDepth(
+        camera_transform * command.transform, *command.geometry);
+    if (depth.has_value()) {
+      visible_commands.push_back({.command = &command, .depth = *depth});
+    }
+  }
+
+  auto is_before = [](const VisibleCommand& a, const VisibleCommand& b) {
+    bool a_translucent = a.command->material->IsTranslucent();
+    bool b_translucent = b.command->material->IsTranslucent();
+    if (a_translucent != b_translucent) {
+      return b_translucent;
+    }
+    if (a_translucent) {
+      return a.depth > b.depth;
+    }
+    auto pipeline = [](const SceneCommand& command) {
+      return std::make_pair(command.geometry->GetGeometryType(),
+                            command.material->GetMaterialType());
+    };
+    if (pipeline(*a.command) != pipeline(*b.command)) {
+      return pipeline(*a.command) < pipeline(*b.command);
+    }
+    return a.depth < b.depth;
+  };
+  std::stable_sort(visible_commands.begin(), visible_commands.end(),
+                   is_before);
+  return visible_commands;
+}
+
 static void EncodeCommand(const SceneContext& scene_context,
                           const Matrix& view_transform,
                           RenderPass& render_pass,
@@ -91,8 +185,9 @@ std::shared_ptr<CommandBuffer> SceneEncoder::BuildSceneCommandBuffer(
     return nullptr;
   }
 
-  for (auto& command : commands_) {
-    EncodeCommand(scene_context, camera_transform, *render_pass, command);
+  for (const auto& visible : GetVisibleCommands(commands_, camera_transform)) {
+    EncodeCommand(scene_context, camera_transform, *render_pass,
+                  *visible.command);
   }
 
   if (!render_pass->EncodeCommands()) {
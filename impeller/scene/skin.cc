@@ -63,29 +63,47 @@ Skin::Skin(Skin&&) = default;
 Skin& Skin::operator=(Skin&&) = default;
 
 std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
-  // Each joint has a matrix. 1 matrix = 16 floats. 1 pixel = 4 floats.
-  // Therefore, each joint needs 4 pixels.
-  auto required_pixels = joints_.size() * 4;
-  auto dimension_size = std::max(
-      2u,
-      Allocation::NextPowerOfTwoSize(std::ceil(std::sqrt(required_pixels))));
-
-  impeller::TextureDescriptor texture_descriptor;
-  texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
-  texture_descriptor.format = PixelFormat::kR32G32B32A32Float;
-  texture_descriptor.size = {dimension_size, dimension_size};
-  texture_descriptor.mip_count = 1u;
-
-  auto result = allocator.CreateTexture(texture_descriptor);
-  result->SetLabel("Joints Texture");
-  if (!result) {
-    FML_LOG(ERROR) << "Could not create joint texture.";
+  auto& joints_texture = joints_textures_[joints_texture_index_];
+  joints_texture_index_ = (joints_texture_index_ + 1) % kJointsTextureCount;
+  if (!joints_texture) {
+    // Each joint has a matrix. 1 matrix = 16 floats. 1 pixel = 4 floats.
+    // Therefore, each joint needs 4 pixels.
+    auto required_pixels = joints_.size() * 4;
+    auto dimension_size = std::max(
+        2u,
+        Allocation::NextPowerOfTwoSize(std::ceil(std::sqrt(required_pixels))));
+
+    impeller::TextureDescriptor texture_descriptor;
+    texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
+    texture_descriptor.format = PixelFormat::kR32G32B32A32Float;
+    texture_descriptor.size = {dimension_size, dimension_size};
+    texture_descriptor.mip_count = 1u;
+
+    joints_texture = allocator.CreateTexture(texture_descriptor);
+    if (!joints_texture) {
+      FML_LOG(ERROR) << "Could not create joint texture.";
+      return nullptr;
+    }
+    joints_texture->SetLabel("Joints Texture");
+    joint_matrices_.resize(joints_texture->GetSize().Area() / 4, Matrix());
+  }
+
+  const auto& joint_matrices = ComputeJointMatrices();
+  if (!joints_texture->SetContents(
+          reinterpret_cast<const uint8_t*>(joint_matrices.data()),
+          joint_matrices.size() * sizeof(Matrix))) {
+    FML_LOG(ERROR) << "Could not set contents of joint texture.";
     return nullptr;
   }
 
-  std::vector<Matrix> joints;
-  joints.resize(result->GetSize().Area() / 4, Matrix());
-  FML_DCHECK(joints.size() >= joints_.size());
+  return joints_texture;
+}
+
+const std::vector<Matrix>& Skin::ComputeJointMatrices() {
+  if (joint_matrices_.size() < joints_.size()) {
+    joint_matrices_.resize(joints_.size(), Matrix());
+  }
+  joint_model_transforms_.clear();
   for (size_t joint_i = 0; joint_i < joints_.size(); joint_i++) {
     const Node* joint = joints_[joint_i].get();
     if (!joint) {
@@ -93,13 +111,6 @@ std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
       continue;
     }
 
-    // Compute a model space matrix for the joint by walking up the bones to the
-    // skeleton root.
-    while (joint && joint->IsJoint()) {
-      joints[joint_i] = joint->GetLocalTransform() * joints[joint_i];
-      joint = joint->GetParent();
-    }
-
     // Get the joint transform relative to the default pose of the bone by
     // incorporating the joint's inverse bind matrix. The inverse bind matrix
     // transforms from model space to the default pose space of the joint. The
@@ -107,16 +118,26 @@ std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
     // the joint's default pose and the joint's current pose in the scene. This
     // is necessary because the skinned model's vertex positions (which _define_
     // the default pose) are all in model space.
-    joints[joint_i] = joints[joint_i] * inverse_bind_matrices_[joint_i];
+    joint_matrices_[joint_i] =
+        GetJointModelTransform(joint) * inverse_bind_matrices_[joint_i];
   }
+  return joint_matrices_;
+}
 
-  if (!result->SetContents(reinterpret_cast<uint8_t*>(joints.data()),
-                           joints.size() * sizeof(Matrix))) {
-    FML_LOG(ERROR) << "Could not set contents of joint texture.";
-    return nullptr;
+const Matrix& Skin::GetJointModelTransform(const Node* joint) {
+  auto found = joint_model_transforms_.find(joint);
+  if (found != joint_model_transforms_.end()) {
+    return found->second;
   }
 
-  return result;
+  // Compute a model space matrix for the joint by walking up the bones to the
+  // skeleton root.
+  const Node* parent = joint->GetParent();
+  Matrix transform = parent && parent->IsJoint()
+                         ? GetJointModelTransform(parent) *
+                               joint->GetLocalTransform()
+                         : joint->GetLocalTransform();
+  return joint_model_transforms_.emplace(joint, transform).first->second;
 }
 
 }  // namespace scene
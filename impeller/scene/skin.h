@@ -5,8 +5,11 @@
 #ifndef FLUTTER_IMPELLER_SCENE_SKIN_H_
 #define FLUTTER_IMPELLER_SCENE_SKIN_H_
 
+#include <array>
 #include <memory>
 #include <optional>
+#include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 
@@ -28,14 +31,38 @@ class Skin final {
   Skin(Skin&&);
   Skin& operator=(Skin&&);
 
+  /// @brief  Returns a texture with the joint matrices of the current pose.
+  ///
+  ///         The textures are created on the first calls and then reused
+  ///         in turn, so that a texture isn't updated while a previous
+  ///         frame that is still in flight reads it.
   std::shared_ptr<Texture> GetJointsTexture(Allocator& allocator);
 
+  /// @brief  Computes the matrix of each joint of the current pose relative
+  ///         to its bind pose, in model space.
+  const std::vector<Matrix>& ComputeJointMatrices();
+
  private:
   Skin();
 
+  /// Returns the model space transform of a joint, which is the product of
+  /// its local transform and those of its ancestors that are joints.
+  const Matrix& GetJointModelTransform(const Node* joint);
+
   std::vector<std::shared_ptr<Node>> joints_;
   std::vector<Matrix> inverse_bind_matrices_;
 
+  /// The number of joint textures used in turn, one per frame in flight.
+  static constexpr size_t kJointsTextureCount = 3u;
+
+  std::array<std::shared_ptr<Texture>, kJointsTextureCount> joints_textures_;
+  size_t joints_texture_index_ = 0u;
+  std::vector<Matrix> joint_matrices_;
+  // The model space transforms of the joints computed for the current pose,
+  // so that the transforms of the ancestors shared by several joints are
+  // computed once.
+  std::unordered_map<const Node*, Matrix> joint_model_transforms_;
+
   Skin(const Skin&) = delete;
 
   Skin& operator=(const Skin&) = delete;
@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/tessellator/tessellation_cache.h"
+
+#include <cmath>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+size_t TessellationCache::Entry::GetByteSize() const {
+  return vertices.size() * sizeof(Point) + indices.size() * sizeof(uint16_t);
+}
+
+size_t TessellationCache::KeyHash::operator()(const Key& key) const {
+  return fml::HashCombine(key.path_hash, key.scale_bucket,
+                          static_cast<int>(key.kind));
+}
+
+TessellationCache::TessellationCache(size_t byte_budget)
+    : byte_budget_(byte_budget) {}
+
+TessellationCache::~TessellationCache() = default;
+
+std::pair<int32_t, Scalar> TessellationCache::QuantizeScale(Scalar scale) {
+  if (!(scale > 0.0f) || !std::isfinite(scale)) {
+    return {0, scale};
+  }
+  auto bucket = static_cast<int32_t>(
+      std::ceil(std::log2(scale) * kScaleBucketsPerOctave - kEhCloseEnough));
+  return {bucket, std::exp2(bucket / kScaleBucketsPerOctave)};
+}
+
+bool TessellationCache::IsEnabled() const {
+  return byte_budget_ > 0;
+}
+
+void TessellationCache::SetByteBudget(size_t byte_budget) {
+  byte_budget_ = byte_budget;
+  EvictToFit(byte_budget_);
+}
+
+size_t TessellationCache::GetByteBudget() const {
+  return byte_budget_;
+}
+
+const TessellationCache::Entry* TessellationCache::Get(const Key& key) {
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    statistics_.misses++;
+    ReportStatistics();
+    return nullptr;
+  }
+  statistics_.hits++;
+  ReportStatistics();
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return &found->second->second;
+}
+
+void TessellationCache::Put(const Key& key, Entry entry) {
+  auto size = entry.GetByteSize();
+  if (size > byte_budget_) {
+    return;
+  }
+  auto found = index_.find(key);
+  if (found != index_.end()) {
+    statistics_.bytes_used -= found->second->second.GetByteSize();
+    entries_.erase(found->second);
+    index_.erase(found);
+  }
+  EvictToFit(byte_budget_ - size);
+  entries_.emplace_front(key, std::move(entry));
+  index_[key] = entries_.begin();
+  statistics_.bytes_used += size;
+  statistics_.entry_count = entries_.size();
+}
+
+void TessellationCache::Clear() {
+  EvictToFit(0u);
+}
+
+const TessellationCache::Statistics& TessellationCache::GetStatistics() const {
+  return statistics_;
+}
+
+void TessellationCache::EvictToFit(size_t byte_budget) {
+  while (!entries_.empty() && statistics_.bytes_used > byte_budget) {
+    const auto& [key, entry] = entries_.back();
+    statistics_.bytes_used -= entry.GetByteSize();
+    index_.erase(key);
+    entries_.pop_back();
+  }
+  statistics_.entry_count = entries_.size();
+}
+
+void TessellationCache::ReportStatistics() const {
+  static constexpr int64_t kImpellerTessellationCacheTraceID = 1989;
+  FML_TRACE_COUNTER("impeller",                                       //
+                    "TessellationCache",                              //
+                    kImpellerTessellationCacheTraceID,                //
+                    "TessellationCacheHits", statistics_.hits,        //
+                    "TessellationCacheMisses", statistics_.misses,    //
+                    "TessellationCacheBytes", statistics_.bytes_used  //
+  );
+}
+
+}  // namespace impeller
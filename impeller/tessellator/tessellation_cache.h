@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_TESSELLATOR_TESSELLATION_CACHE_H_
+#define FLUTTER_IMPELLER_TESSELLATOR_TESSELLATION_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "impeller/geometry/point.h"
+#include "impeller/geometry/scalar.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A least recently used cache of tessellation results, keyed by
+///             the content hash of a path and a quantized tessellation scale.
+///
+///             Entries are evicted once the total size of the cached vertices
+///             and indices exceeds the byte budget.
+///
+///             This object is not thread safe.
+///
+class TessellationCache {
+ public:
+  /// The default number of bytes of vertex and index data retained.
+  static constexpr size_t kDefaultByteBudget = 2u * 1024u * 1024u;
+
+  /// The number of scale buckets per doubling of the tessellation scale.
+  static constexpr Scalar kScaleBucketsPerOctave = 4.0f;
+
+  enum class Kind {
+    kFill,
+    kConvex,
+  };
+
+  struct Key {
+    size_t path_hash = 0;
+    int32_t scale_bucket = 0;
+    Kind kind = Kind::kFill;
+
+    constexpr bool operator==(const Key& other) const {
+      return path_hash == other.path_hash &&
+             scale_bucket == other.scale_bucket && kind == other.kind;
+    }
+  };
+
+  struct Entry {
+    std::vector<Point> vertices;
+    /// Empty if the vertices are not indexed.
+    std::vector<uint16_t> indices;
+
+    size_t GetByteSize() const;
+  };
+
+  struct Statistics {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t entry_count = 0;
+    size_t bytes_used = 0;
+  };
+
+  explicit TessellationCache(size_t byte_budget = kDefaultByteBudget);
+
+  ~TessellationCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Rounds the scale up to the nearest bucket. Results are
+  ///             tessellated at the quantized scale so that they are at least
+  ///             as fine as requested and can be shared between small changes
+  ///             in the transform.
+  ///
+  ///             Scales that are not positive and finite are returned as is
+  ///             and should not be used to key the cache.
+  ///
+  /// @return     The bucket index, and the scale it represents.
+  ///
+  static std::pair<int32_t, Scalar> QuantizeScale(Scalar scale);
+
+  /// @brief      Whether the cache retains any entries at all.
+  bool IsEnabled() const;
+
+  /// @brief      Sets the byte budget, evicting entries if necessary. A budget
+  ///             of zero disables the cache.
+  void SetByteBudget(size_t byte_budget);
+
+  size_t GetByteBudget() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Looks up an entry and marks it as most recently used.
+  ///
+  /// @return     The entry, or nullptr on a miss. The pointer is valid until
+  ///             the next call to a non-const method.
+  ///
+  const Entry* Get(const Key& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Inserts an entry, evicting the least recently used entries
+  ///             until it fits. Entries larger than the budget are dropped.
+  ///
+  void Put(const Key& key, Entry entry);
+
+  void Clear();
+
+  const Statistics& GetStatistics() const;
+
+ private:
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  using EntryList = std::list<std::pair<Key, Entry>>;
+
+  size_t byte_budget_;
+  EntryList entries_;
+  std::unordered_map<Key, EntryList::iterator, KeyHash> index_;
+  Statistics statistics_;
+
+  void EvictToFit(size_t byte_budget);
+
+  void ReportStatistics() const;
+
+  TessellationCache(const TessellationCache&) = delete;
+
+  TessellationCache& operator=(const TessellationCache&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_TESSELLATOR_TESSELLATION_CACHE_H_
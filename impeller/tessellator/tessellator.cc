@@ -4,6 +4,8 @@
 
 #include "impeller/tessellator/tessellator.h"
 
+#include <cmath>
+
 #include "third_party/libtess2/Include/tesselator.h"
 
 namespace impeller {
@@ -61,6 +63,55 @@ static int ToTessWindingRule(FillType fill_type) {
   return TESS_WINDING_ODD;
 }
 
+Path::Polyline Tessellator::CreateTempPolyline(const Path& path,
+                                               Scalar tolerance) {
+  FML_DCHECK(point_buffer_);
+  point_buffer_->clear();
+  return path.CreatePolyline(
+      tolerance, std::move(point_buffer_),
+      [this](Path::Polyline::PointBufferPtr point_buffer) {
+        point_buffer_ = std::move(point_buffer);
+      });
+}
+
+void Tessellator::SetCacheByteBudget(size_t byte_budget) {
+  cache_.SetByteBudget(byte_budget);
+}
+
+const TessellationCache::Statistics& Tessellator::GetCacheStatistics() const {
+  return cache_.GetStatistics();
+}
+
+std::optional<TessellationCache::Key> Tessellator::MakeCacheKey(
+    const Path& path,
+    TessellationCache::Kind kind,
+    Scalar& tolerance) const {
+  if (!cache_.IsEnabled() || !(tolerance > 0.0f) || !std::isfinite(tolerance)) {
+    return std::nullopt;
+  }
+  auto [bucket, quantized_tolerance] =
+      TessellationCache::QuantizeScale(tolerance);
+  tolerance = quantized_tolerance;
+  return TessellationCache::Key{
+      .path_hash = path.GetContentHash(),
+      .scale_bucket = bucket,
+      .kind = kind,
+  };
+}
+
+static TessellationCache::Entry MakeCacheEntry(const float* vertices,
+                                               size_t vertices_count,
+                                               const uint16_t* indices,
+                                               size_t indices_count) {
+  TessellationCache::Entry entry;
+  auto points = reinterpret_cast<const Point*>(vertices);
+  entry.vertices.assign(points, points + vertices_count);
+  if (indices) {
+    entry.indices.assign(indices, indices + indices_count);
+  }
+  return entry;
+}
+
 Tessellator::Result Tessellator::Tessellate(const Path& path,
                                             Scalar tolerance,
                                             const BuilderCallback& callback) {
@@ -68,6 +119,19 @@ Tessellator::Result Tessellator::Tessellate(const Path& path,
     return Result::kInputError;
   }
 
+  auto cache_key =
+      MakeCacheKey(path, TessellationCache::Kind::kFill, tolerance);
+  if (cache_key.has_value()) {
+    if (auto entry = cache_.Get(cache_key.value())) {
+      auto indices = entry->indices.empty() ? nullptr : entry->indices.data();
+      if (!callback(reinterpret_cast<const float*>(entry->vertices.data()),
+                    entry->vertices.size(), indices, entry->indices.size())) {
+        return Result::kInputError;
+      }
+      return Result::kSuccess;
+    }
+  }
+
   point_buffer_->clear();
   auto polyline =
       path.CreatePolyline(tolerance, std::move(point_buffer_),
@@ -144,6 +208,11 @@ Tessellator::Result Tessellator::Tessellate(const Path& path,
                   element_item_count)) {
       return Result::kInputError;
     }
+    if (cache_key.has_value()) {
+      cache_.Put(cache_key.value(),
+                 MakeCacheEntry(vertices, vertex_item_count, indices.data(),
+                                element_item_count));
+    }
   } else {
     std::vector<Point> points;
     std::vector<float> data;
@@ -165,6 +234,10 @@ Tessellator::Result Tessellator::Tessellate(const Path& path,
     if (!callback(data.data(), element_item_count, nullptr, 0u)) {
       return Result::kInputError;
     }
+    if (cache_key.has_value()) {
+      cache_.Put(cache_key.value(),
+                 MakeCacheEntry(data.data(), element_item_count, nullptr, 0u));
+    }
   }
 
   return Result::kSuccess;
@@ -172,6 +245,14 @@ Tessellator::Result Tessellator::Tessellate(const Path& path,
 
 std::vector<Point> Tessellator::TessellateConvex(const Path& path,
                                                  Scalar tolerance) {
+  auto cache_key =
+      MakeCacheKey(path, TessellationCache::Kind::kConvex, tolerance);
+  if (cache_key.has_value()) {
+    if (auto entry = cache_.Get(cache_key.value())) {
+      return entry->vertices;
+    }
+  }
+
   std::vector<Point> output;
 
   point_buffer_->clear();
@@ -215,6 +296,9 @@ std::vector<Point> Tessellator::TessellateConvex(const Path& path,
       output.emplace_back(polyline.GetPoint(a));
     }
   }
+  if (cache_key.has_value()) {
+    cache_.Put(cache_key.value(), TessellationCache::Entry{.vertices = output});
+  }
   return output;
 }
 
@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -14,6 +15,7 @@
 #include "impeller/geometry/path.h"
 #include "impeller/geometry/point.h"
 #include "impeller/geometry/trig.h"
+#include "impeller/tessellator/tessellation_cache.h"
 
 struct TESStesselator;
 
@@ -33,6 +35,11 @@ enum class WindingOrder {
 /// @brief      A utility that generates triangles of the specified fill type
 ///             given a polyline. This happens on the CPU.
 ///
+///             Results of |Tessellate| and |TessellateConvex| are retained in
+///             a |TessellationCache| keyed by the content of the path and the
+///             tolerance rounded up to a scale bucket, so that paths drawn
+///             unchanged across frames are not tessellated again.
+///
 ///             This object is not thread safe, and its methods must not be
 ///             called from multiple threads.
 ///
@@ -218,6 +225,35 @@ class Tessellator {
   ///
   std::vector<Point> TessellateConvex(const Path& path, Scalar tolerance);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Create a polyline for the path using this tessellator's
+  ///             retained point buffer. The polyline must be destroyed before
+  ///             the tessellator is used again.
+  ///
+  Path::Polyline CreateTempPolyline(const Path& path, Scalar tolerance);
+
+  //----------------------------------------------------------------------------
+  /// @brief      A retained buffer that stroke generation uses as an arena
+  ///             for its output vertices. Callers clear it before use; its
+  ///             capacity persists between frames.
+  ///
+  std::vector<Point>& GetStrokePointArena() { return stroke_point_arena_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      A retained scratch buffer for the arc points of round stroke
+  ///             joins and caps.
+  ///
+  std::vector<Point>& GetStrokeArcPoints() { return stroke_arc_points_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the number of bytes of tessellated vertices and indices
+  ///             that are retained between calls. A budget of zero disables
+  ///             caching and tessellates at the exact tolerance requested.
+  ///
+  void SetCacheByteBudget(size_t byte_budget);
+
+  const TessellationCache::Statistics& GetCacheStatistics() const;
+
   /// @brief   The pixel tolerance used by the algorighm to determine how
   ///          many divisions to create for a circle.
   ///
@@ -297,7 +333,10 @@ class Tessellator {
  private:
   /// Used for polyline generation.
   std::unique_ptr<std::vector<Point>> point_buffer_;
+  std::vector<Point> stroke_point_arena_;
+  std::vector<Point> stroke_arc_points_;
   CTessellator c_tessellator_;
+  TessellationCache cache_;
 
   // Data for variouos Circle/EllipseGenerator classes, cached per
   // Tessellator instance which is usually the foreground life of an app
@@ -307,6 +346,13 @@ class Tessellator {
 
   Trigs GetTrigsForDivisions(size_t divisions);
 
+  /// Returns the cache key for the path if caching is enabled, in which case
+  /// the tolerance is replaced with that of its scale bucket.
+  std::optional<TessellationCache::Key> MakeCacheKey(
+      const Path& path,
+      TessellationCache::Kind kind,
+      Scalar& tolerance) const;
+
   static void GenerateFilledCircle(const Trigs& trigs,
                                    const EllipticalVertexGenerator::Data& data,
                                    const TessellatedVertexProc& proc);
@@ -134,6 +134,24 @@ TEST(TessellatorTest, TessellateConvex) {
   }
 }
 
+TEST(TessellatorTest, CreateTempPolylineReusesPointBuffer) {
+  Tessellator t;
+  auto path = PathBuilder{}.AddRect(Rect::MakeLTRB(0, 0, 10, 10)).TakePath();
+
+  const Point* first_points = nullptr;
+  std::vector<Point> first_copy;
+  {
+    auto polyline = t.CreateTempPolyline(path, 1.0);
+    first_points = polyline.points->data();
+    first_copy = *polyline.points;
+  }
+  {
+    auto polyline = t.CreateTempPolyline(path, 1.0);
+    EXPECT_EQ(polyline.points->data(), first_points);
+    EXPECT_EQ(*polyline.points, first_copy);
+  }
+}
+
 TEST(TessellatorTest, CircleVertexCounts) {
   auto tessellator = std::make_shared<Tessellator>();
 
@@ -484,5 +502,116 @@ TEST(TessellatorTest, FilledRoundRectTessellationVertices) {
        Rect::MakeXYWH(5000, 10000, 2000, 3000), {50, 70});
 }
 
+TEST(TessellatorTest, CachesTessellationResults) {
+  Tessellator t;
+  auto make_path = [](Scalar offset) {
+    return PathBuilder{}
+        .MoveTo({0, 0})
+        .CubicCurveTo({offset, 0}, {offset, 100}, {0, 100})
+        .Close()
+        .TakePath();
+  };
+
+  std::vector<float> first_vertices;
+  std::vector<uint16_t> first_indices;
+  auto result = t.Tessellate(
+      make_path(50), 1.0f,
+      [&](const float* vertices, size_t vertices_count,
+          const uint16_t* indices, size_t indices_count) {
+        first_vertices.assign(vertices, vertices + vertices_count * 2);
+        first_indices.assign(indices, indices + indices_count);
+        return true;
+      });
+  ASSERT_EQ(result, Tessellator::Result::kSuccess);
+  EXPECT_EQ(t.GetCacheStatistics().misses, 1u);
+  EXPECT_EQ(t.GetCacheStatistics().hits, 0u);
+  EXPECT_EQ(t.GetCacheStatistics().entry_count, 1u);
+
+  // An equal path at a tolerance in the same scale bucket is a hit.
+  std::vector<float> second_vertices;
+  std::vector<uint16_t> second_indices;
+  result = t.Tessellate(
+      make_path(50), 0.95f,
+      [&](const float* vertices, size_t vertices_count,
+          const uint16_t* indices, size_t indices_count) {
+        second_vertices.assign(vertices, vertices + vertices_count * 2);
+        second_indices.assign(indices, indices + indices_count);
+        return true;
+      });
+  EXPECT_EQ(second_vertices, first_vertices);
+  EXPECT_EQ(second_indices, first_indices);
+  ASSERT_EQ(result, Tessellator::Result::kSuccess);
+  EXPECT_EQ(t.GetCacheStatistics().hits, 1u);
+
+  // Different geometry, and a much finer tolerance, both miss.
+  auto ignore = [](const float*, size_t, const uint16_t*, size_t) {
+    return true;
+  };
+  t.Tessellate(make_path(60), 1.0f, ignore);
+  t.Tessellate(make_path(50), 4.0f, ignore);
+  EXPECT_EQ(t.GetCacheStatistics().hits, 1u);
+  EXPECT_EQ(t.GetCacheStatistics().misses, 3u);
+  EXPECT_EQ(t.GetCacheStatistics().entry_count, 3u);
+
+  // Convex tessellations are cached separately from fills.
+  auto path = make_path(50);
+  auto convex = t.TessellateConvex(path, 1.0f);
+  EXPECT_EQ(t.GetCacheStatistics().misses, 4u);
+  EXPECT_EQ(t.TessellateConvex(path, 1.0f), convex);
+  EXPECT_EQ(t.GetCacheStatistics().hits, 2u);
+
+  // Shrinking the budget evicts entries, and a budget of zero disables the
+  // cache.
+  t.SetCacheByteBudget(0u);
+  EXPECT_EQ(t.GetCacheStatistics().entry_count, 0u);
+  EXPECT_EQ(t.GetCacheStatistics().bytes_used, 0u);
+  EXPECT_EQ(t.TessellateConvex(path, 1.0f), convex);
+  EXPECT_EQ(t.GetCacheStatistics().hits, 2u);
+  EXPECT_EQ(t.GetCacheStatistics().misses, 4u);
+}
+
+TEST(TessellatorTest, TessellationCacheEvictsLeastRecentlyUsed) {
+  TessellationCache cache(3 * sizeof(Point));
+  auto make_entry = [] {
+    return TessellationCache::Entry{.vertices = {Point(0, 0)}};
+  };
+  TessellationCache::Key a{.path_hash = 1};
+  TessellationCache::Key b{.path_hash = 2};
+  TessellationCache::Key c{.path_hash = 3};
+  TessellationCache::Key d{.path_hash = 4};
+
+  cache.Put(a, make_entry());
+  cache.Put(b, make_entry());
+  cache.Put(c, make_entry());
+  EXPECT_NE(cache.Get(a), nullptr);
+
+  // |b| is now the least recently used entry.
+  cache.Put(d, make_entry());
+  EXPECT_EQ(cache.Get(b), nullptr);
+  EXPECT_NE(cache.Get(a), nullptr);
+  EXPECT_NE(cache.Get(c), nullptr);
+  EXPECT_NE(cache.Get(d), nullptr);
+  EXPECT_EQ(cache.GetStatistics().bytes_used, 3 * sizeof(Point));
+
+  // Entries larger than the budget are not retained.
+  TessellationCache::Entry large;
+  large.vertices.resize(4);
+  cache.Put(b, std::move(large));
+  EXPECT_EQ(cache.Get(b), nullptr);
+  EXPECT_EQ(cache.GetStatistics().entry_count, 3u);
+}
+
+TEST(TessellatorTest, TessellationCacheQuantizesScaleUpwards) {
+  EXPECT_EQ(TessellationCache::QuantizeScale(1.0f).first, 0);
+  EXPECT_FLOAT_EQ(TessellationCache::QuantizeScale(1.0f).second, 1.0f);
+  EXPECT_FLOAT_EQ(TessellationCache::QuantizeScale(2.0f).second, 2.0f);
+  for (Scalar scale = 0.1f; scale < 100.0f; scale *= 1.1f) {
+    auto [bucket, quantized] = TessellationCache::QuantizeScale(scale);
+    EXPECT_GE(quantized, scale * (1.0f - kEhCloseEnough));
+    EXPECT_LT(quantized, scale * 1.2f);
+    EXPECT_EQ(TessellationCache::QuantizeScale(quantized).first, bucket);
+  }
+}
+
 }  // namespace testing
 }  // namespace impeller
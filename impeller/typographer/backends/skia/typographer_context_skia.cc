@@ -4,10 +4,18 @@
 
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <numeric>
 #include <utility>
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/allocation.h"
 #include "impeller/core/allocator.h"
@@ -35,13 +43,32 @@ TypographerContextSkia::TypographerContextSkia() = default;
 
 TypographerContextSkia::~TypographerContextSkia() = default;
 
+bool TypographerContextSkia::SupportsSignedDistanceFields() const {
+  return true;
+}
+
 std::shared_ptr<GlyphAtlasContext>
 TypographerContextSkia::CreateGlyphAtlasContext() const {
   return std::make_shared<GlyphAtlasContextSkia>();
 }
 
+// The size of the rectangle the glyph occupies in an atlas of the given type,
+// not including the padding between glyphs.
+static ISize GetGlyphSizeInAtlas(const FontGlyphPair& pair,
+                                 GlyphAtlas::Type type) {
+  auto glyph_size =
+      ISize::Ceil(pair.glyph.bounds.GetSize() * pair.scaled_font.scale);
+  if (type == GlyphAtlas::Type::kSignedDistanceField) {
+    // The distance field extends past the outline of the glyph.
+    glyph_size = glyph_size + ISize(GlyphAtlas::kSignedDistanceFieldSpread * 2,
+                                    GlyphAtlas::kSignedDistanceFieldSpread * 2);
+  }
+  return glyph_size;
+}
+
 static size_t PairsFitInAtlasOfSize(
     const std::vector<FontGlyphPair>& pairs,
+    GlyphAtlas::Type type,
     const ISize& atlas_size,
     std::vector<Rect>& glyph_positions,
     const std::shared_ptr<RectanglePacker>& rect_packer) {
@@ -56,8 +83,7 @@ static size_t PairsFitInAtlasOfSize(
   for (auto it = pairs.begin(); it != pairs.end(); ++i, ++it) {
     const auto& pair = *it;
 
-    const auto glyph_size =
-        ISize::Ceil(pair.glyph.bounds.GetSize() * pair.scaled_font.scale);
+    const auto glyph_size = GetGlyphSizeInAtlas(pair, type);
     IPoint16 location_in_atlas;
     if (!rect_packer->addRect(glyph_size.width + kPadding,   //
                               glyph_size.height + kPadding,  //
@@ -94,8 +120,7 @@ static bool CanAppendToExistingAtlas(
   for (size_t i = 0; i < extra_pairs.size(); i++) {
     const FontGlyphPair& pair = extra_pairs[i];
 
-    const auto glyph_size =
-        ISize::Ceil(pair.glyph.bounds.GetSize() * pair.scaled_font.scale);
+    const auto glyph_size = GetGlyphSizeInAtlas(pair, atlas->GetType());
     IPoint16 location_in_atlas;
     if (!rect_packer->addRect(glyph_size.width + kPadding,   //
                               glyph_size.height + kPadding,  //
@@ -132,8 +157,8 @@ static ISize OptimumAtlasSizeForFontGlyphPairs(
     auto rect_packer = std::shared_ptr<RectanglePacker>(
         RectanglePacker::Factory(current_size.width, current_size.height));
 
-    auto remaining_pairs = PairsFitInAtlasOfSize(pairs, current_size,
-                                                 glyph_positions, rect_packer);
+    auto remaining_pairs = PairsFitInAtlasOfSize(
+        pairs, type, current_size, glyph_positions, rect_packer);
     if (remaining_pairs == 0) {
       atlas_context->UpdateRectPacker(rect_packer);
       return current_size;
@@ -185,13 +210,177 @@ static void DrawGlyph(SkCanvas* canvas,
   );
 }
 
-static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
-                              const std::shared_ptr<SkBitmap>& bitmap,
-                              const std::vector<FontGlyphPair>& new_pairs) {
-  TRACE_EVENT0("impeller", __FUNCTION__);
-  FML_DCHECK(bitmap != nullptr);
+// A distance larger than any in a glyph, which unlike infinity can be
+// subtracted from itself.
+static constexpr float kFarDistance = 1e20f;
+
+// Computes the squared distance of each of the `count` samples of `f`, spaced
+// `stride` apart, to the nearest sample whose value is zero, as described in
+// "Distance Transforms of Sampled Functions" (Felzenszwalb & Huttenlocher).
+// `v`, `z` and `d` are scratch buffers of at least `count` + 1 elements.
+static void DistanceTransform1D(float* f,
+                                size_t count,
+                                size_t stride,
+                                std::vector<int>& v,
+                                std::vector<float>& z,
+                                std::vector<float>& d) {
+  constexpr float kInfinity = std::numeric_limits<float>::infinity();
+  // The horizontal position at which the parabolas rooted at q and r meet.
+  auto intersection = [f, stride](int q, int r) {
+    return ((f[q * stride] + q * q) - (f[r * stride] + r * r)) /
+           (2.0f * (q - r));
+  };
+  int k = 0;
+  v[0] = 0;
+  z[0] = -kInfinity;
+  z[1] = kInfinity;
+  for (int q = 1; q < static_cast<int>(count); q++) {
+    float s = intersection(q, v[k]);
+    while (s <= z[k]) {
+      k--;
+      s = intersection(q, v[k]);
+    }
+    k++;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = kInfinity;
+  }
+  k = 0;
+  for (int q = 0; q < static_cast<int>(count); q++) {
+    while (z[k + 1] < q) {
+      k++;
+    }
+    int r = v[k];
+    d[q] = (q - r) * (q - r) + f[r * stride];
+  }
+  for (size_t q = 0; q < count; q++) {
+    f[q * stride] = d[q];
+  }
+}
+
+// Replaces each value of the `width` by `height` grid with its squared
+// distance to the nearest value that is zero.
+static void DistanceTransform2D(std::vector<float>& grid,
+                                size_t width,
+                                size_t height) {
+  const size_t max_count = std::max(width, height) + 1;
+  std::vector<int> v(max_count);
+  std::vector<float> z(max_count + 1);
+  std::vector<float> d(max_count);
+  for (size_t x = 0; x < width; x++) {
+    DistanceTransform1D(grid.data() + x, height, width, v, z, d);
+  }
+  for (size_t y = 0; y < height; y++) {
+    DistanceTransform1D(grid.data() + y * width, width, 1u, v, z, d);
+  }
+}
 
-  auto surface = SkSurfaces::WrapPixels(bitmap->pixmap());
+//------------------------------------------------------------------------------
+/// Draws the signed distance field of the glyph at the location in an atlas of
+/// type `GlyphAtlas::Type::kSignedDistanceField`. The location includes the
+/// spread of the field around the glyph.
+///
+static bool DrawSignedDistanceFieldGlyph(const SkBitmap& bitmap,
+                                         const ScaledFont& scaled_font,
+                                         const Glyph& glyph,
+                                         const Rect& location) {
+  constexpr int kSpread = GlyphAtlas::kSignedDistanceFieldSpread;
+  const size_t width = location.GetWidth();
+  const size_t height = location.GetHeight();
+  if (width == 0u || height == 0u) {
+    return true;
+  }
+
+  // Rasterize the glyph with enough room around it for the field.
+  SkBitmap coverage;
+  if (!coverage.tryAllocPixels(SkImageInfo::MakeA8(width, height))) {
+    return false;
+  }
+  coverage.eraseColor(SK_ColorTRANSPARENT);
+  auto surface = SkSurfaces::WrapPixels(coverage.pixmap());
+  if (!surface) {
+    return false;
+  }
+  DrawGlyph(surface->getCanvas(), scaled_font, glyph,
+            Rect::MakeXYWH(kSpread, kSpread, 0, 0), /*has_color=*/false);
+
+  // The squared distances of the pixels outside of the glyph to the glyph,
+  // and of those inside of the glyph to its outside.
+  std::vector<float> to_inside(width * height);
+  std::vector<float> to_outside(width * height);
+  for (size_t y = 0; y < height; y++) {
+    const uint8_t* row = coverage.getAddr8(0, y);
+    for (size_t x = 0; x < width; x++) {
+      bool inside = row[x] >= 128u;
+      to_inside[y * width + x] = inside ? 0.0f : kFarDistance;
+      to_outside[y * width + x] = inside ? kFarDistance : 0.0f;
+    }
+  }
+  DistanceTransform2D(to_inside, width, height);
+  DistanceTransform2D(to_outside, width, height);
+
+  // Encode the distances so that the outline is at half the range, and the
+  // spread maps to the full range.
+  const size_t origin_x = location.GetX();
+  const size_t origin_y = location.GetY();
+  for (size_t y = 0; y < height; y++) {
+    uint8_t* row = bitmap.getAddr8(origin_x, origin_y + y);
+    for (size_t x = 0; x < width; x++) {
+      size_t i = y * width + x;
+      float distance = to_outside[i] > 0.0f
+                           ? std::sqrt(to_outside[i]) - 0.5f
+                           : 0.5f - std::sqrt(to_inside[i]);
+      float value = 0.5f + distance / (2.0f * kSpread);
+      row[x] = static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f +
+                                    0.5f);
+    }
+  }
+  // Glyphs are sampled slightly past their location, from the padding.
+  for (size_t y = 0; y < height + kPadding; y++) {
+    if (origin_y + y >= static_cast<size_t>(bitmap.height())) {
+      break;
+    }
+    size_t begin = y < height ? width : 0u;
+    size_t end = std::min(width + kPadding, bitmap.width() - origin_x);
+    if (begin < end) {
+      memset(bitmap.getAddr8(origin_x + begin, origin_y + y), 0, end - begin);
+    }
+  }
+  return true;
+}
+
+namespace {
+struct GlyphLocation {
+  const ScaledFont& scaled_font;
+  const Glyph& glyph;
+  Rect location;
+};
+}  // namespace
+
+// The minimum number of glyphs rasterized by each worker task. Smaller batches
+// are not worth the cost of dispatching them.
+static constexpr size_t kMinGlyphsPerRasterTask = 32u;
+static constexpr size_t kMaxGlyphRasterTasks = 8u;
+
+static bool DrawGlyphRange(const SkBitmap& bitmap,
+                           const std::vector<GlyphLocation>& glyphs,
+                           size_t begin,
+                           size_t end,
+                           GlyphAtlas::Type type,
+                           bool clip_to_location) {
+  if (type == GlyphAtlas::Type::kSignedDistanceField) {
+    // The fields are written to the pixels reserved for each glyph.
+    for (size_t i = begin; i < end; i++) {
+      const auto& glyph = glyphs[i];
+      if (!DrawSignedDistanceFieldGlyph(bitmap, glyph.scaled_font,
+                                        glyph.glyph, glyph.location)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  bool has_color = type == GlyphAtlas::Type::kColorBitmap;
+  auto surface = SkSurfaces::WrapPixels(bitmap.pixmap());
   if (!surface) {
     return false;
   }
@@ -199,27 +388,97 @@ static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
   if (!canvas) {
     return false;
   }
+  for (size_t i = begin; i < end; i++) {
+    const auto& glyph = glyphs[i];
+    if (clip_to_location) {
+      // Glyphs drawn concurrently must not touch pixels outside of the space
+      // reserved for them in the atlas.
+      canvas->save();
+      canvas->resetMatrix();
+      canvas->clipRect(SkRect::MakeXYWH(glyph.location.GetX(),
+                                        glyph.location.GetY(),
+                                        glyph.location.GetWidth() + kPadding,
+                                        glyph.location.GetHeight() + kPadding));
+    }
+    DrawGlyph(canvas, glyph.scaled_font, glyph.glyph, glyph.location,
+              has_color);
+    if (clip_to_location) {
+      canvas->restore();
+    }
+  }
+  return true;
+}
 
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
+//------------------------------------------------------------------------------
+/// Rasterizes the glyphs into the bitmap. Large batches of glyphs, such as
+/// the first frame of a text heavy screen, are split across the worker task
+/// runner so the raster thread only waits for the slowest batch.
+///
+static bool DrawGlyphs(
+    const SkBitmap& bitmap,
+    const std::vector<GlyphLocation>& glyphs,
+    GlyphAtlas::Type type,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  size_t task_count =
+      worker_task_runner ? std::min(glyphs.size() / kMinGlyphsPerRasterTask,
+                                    kMaxGlyphRasterTasks)
+                         : 0u;
+  if (task_count < 2u) {
+    return DrawGlyphRange(bitmap, glyphs, 0u, glyphs.size(), type,
+                          /*clip_to_location=*/false);
+  }
 
+  TRACE_EVENT0("impeller", "DrawGlyphsConcurrently");
+  std::atomic_bool success = true;
+  fml::CountDownLatch latch(task_count);
+  size_t glyphs_per_task = (glyphs.size() + task_count - 1) / task_count;
+  for (size_t i = 0; i < task_count; i++) {
+    size_t begin = i * glyphs_per_task;
+    size_t end = std::min(begin + glyphs_per_task, glyphs.size());
+    worker_task_runner->PostTask(
+        [&bitmap, &glyphs, &success, &latch, begin, end, type]() {
+          if (!DrawGlyphRange(bitmap, glyphs, begin, end, type,
+                              /*clip_to_location=*/true)) {
+            success = false;
+          }
+          latch.CountDown();
+        });
+  }
+  latch.Wait();
+  return success;
+}
+
+static bool UpdateAtlasBitmap(
+    const GlyphAtlas& atlas,
+    const std::shared_ptr<SkBitmap>& bitmap,
+    const std::vector<FontGlyphPair>& new_pairs,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  FML_DCHECK(bitmap != nullptr);
+
+  std::vector<GlyphLocation> glyphs;
+  glyphs.reserve(new_pairs.size());
   for (const FontGlyphPair& pair : new_pairs) {
     auto pos = atlas.FindFontGlyphBounds(pair);
     if (!pos.has_value()) {
       continue;
     }
-    DrawGlyph(canvas, pair.scaled_font, pair.glyph, pos.value(), has_color);
+    glyphs.push_back({pair.scaled_font, pair.glyph, pos.value()});
   }
-  return true;
+  return DrawGlyphs(*bitmap, glyphs, atlas.GetType(), worker_task_runner);
 }
 
-static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
-                                                   const ISize& atlas_size) {
+static std::shared_ptr<SkBitmap> CreateAtlasBitmap(
+    const GlyphAtlas& atlas,
+    const ISize& atlas_size,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   auto bitmap = std::make_shared<SkBitmap>();
   SkImageInfo image_info;
 
   switch (atlas.GetType()) {
     case GlyphAtlas::Type::kAlphaBitmap:
+    case GlyphAtlas::Type::kSignedDistanceField:
       image_info = SkImageInfo::MakeA8(atlas_size.width, atlas_size.height);
       break;
     case GlyphAtlas::Type::kColorBitmap:
@@ -232,24 +491,18 @@ static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
     return nullptr;
   }
 
-  auto surface = SkSurfaces::WrapPixels(bitmap->pixmap());
-  if (!surface) {
-    return nullptr;
-  }
-  auto canvas = surface->getCanvas();
-  if (!canvas) {
-    return nullptr;
-  }
-
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
-
-  atlas.IterateGlyphs([canvas, has_color](const ScaledFont& scaled_font,
-                                          const Glyph& glyph,
-                                          const Rect& location) -> bool {
-    DrawGlyph(canvas, scaled_font, glyph, location, has_color);
+  std::vector<GlyphLocation> glyphs;
+  glyphs.reserve(atlas.GetGlyphCount());
+  atlas.IterateGlyphs([&glyphs](const ScaledFont& scaled_font,
+                                const Glyph& glyph,
+                                const Rect& location) -> bool {
+    glyphs.push_back({scaled_font, glyph, location});
     return true;
   });
 
+  if (!DrawGlyphs(*bitmap, glyphs, atlas.GetType(), worker_task_runner)) {
+    return nullptr;
+  }
   return bitmap;
 }
 
@@ -376,19 +629,30 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     // Step 4a: Draw new font-glyph pairs into the existing bitmap.
     // ---------------------------------------------------------------------------
     auto bitmap = atlas_context_skia.GetBitmap();
-    if (!UpdateAtlasBitmap(*last_atlas, bitmap, new_glyphs)) {
+    if (!UpdateAtlasBitmap(*last_atlas, bitmap, new_glyphs,
+                           context.GetConcurrentWorkerTaskRunner())) {
       return nullptr;
     }
 
     // ---------------------------------------------------------------------------
-    // Step 5a: Update the existing texture with the updated bitmap.
+    // Step 5a: Update the existing texture with the updated bitmap. Prefer
+    //          uploading only the region covered by the new glyphs.
     // ---------------------------------------------------------------------------
-    if (!UpdateGlyphTextureAtlas(bitmap, last_atlas->GetTexture())) {
-      return nullptr;
+    const auto& texture = last_atlas->GetTexture();
+    auto pixels = reinterpret_cast<const uint8_t*>(bitmap->getAddr(0, 0));
+    if (!UploadGlyphAtlasRegion(context, texture, pixels, bitmap->rowBytes(),
+                                glyph_positions, kPadding)) {
+      if (!UpdateGlyphTextureAtlas(bitmap, texture)) {
+        return nullptr;
+      }
+      ReportGlyphAtlasUpdate(
+          texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel(),
+          fml::TimeDelta::Zero());
     }
     return last_atlas;
   }
   // A new glyph atlas must be created.
+  auto rebuild_start = fml::TimePoint::Now();
 
   // ---------------------------------------------------------------------------
   // Step 3b: Get the optimum size of the texture atlas.
@@ -440,7 +704,8 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   // ---------------------------------------------------------------------------
   // Step 6b: Draw font-glyph pairs in the correct spot in the atlas.
   // ---------------------------------------------------------------------------
-  auto bitmap = CreateAtlasBitmap(*glyph_atlas, atlas_size);
+  auto bitmap = CreateAtlasBitmap(*glyph_atlas, atlas_size,
+                                  context.GetConcurrentWorkerTaskRunner());
   if (!bitmap) {
     return nullptr;
   }
@@ -456,6 +721,9 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
       }
 
       glyph_atlas->SetTexture(last_texture);
+      ReportGlyphAtlasUpdate(
+          last_texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel(),
+          fml::TimePoint::Now() - rebuild_start);
       return glyph_atlas;
     }
   }
@@ -466,6 +734,7 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   PixelFormat format;
   switch (type) {
     case GlyphAtlas::Type::kAlphaBitmap:
+    case GlyphAtlas::Type::kSignedDistanceField:
       format = PixelFormat::kA8UNormInt;
       break;
     case GlyphAtlas::Type::kColorBitmap:
@@ -483,6 +752,10 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   // ---------------------------------------------------------------------------
   glyph_atlas->SetTexture(std::move(texture));
 
+  ReportGlyphAtlasUpdate(glyph_atlas->GetTexture()
+                             ->GetTextureDescriptor()
+                             .GetByteSizeOfBaseMipLevel(),
+                         fml::TimePoint::Now() - rebuild_start);
   return glyph_atlas;
 }
 
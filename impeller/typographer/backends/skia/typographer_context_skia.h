@@ -18,6 +18,9 @@ class TypographerContextSkia : public TypographerContext {
 
   ~TypographerContextSkia() override;
 
+  // |TypographerContext|
+  bool SupportsSignedDistanceFields() const override;
+
   // |TypographerContext|
   std::shared_ptr<GlyphAtlasContext> CreateGlyphAtlasContext() const override;
 
@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/allocation.h"
 #include "impeller/core/allocator.h"
@@ -378,7 +379,8 @@ std::shared_ptr<GlyphAtlas> TypographerContextSTB::CreateGlyphAtlas(
     std::shared_ptr<GlyphAtlasContext> atlas_context,
     const FontGlyphMap& font_glyph_map) const {
   TRACE_EVENT0("impeller", __FUNCTION__);
-  if (!IsValid()) {
+  // Signed distance fields are not supported by this backend.
+  if (!IsValid() || type == GlyphAtlas::Type::kSignedDistanceField) {
     return nullptr;
   }
   auto& atlas_context_stb = GlyphAtlasContextSTB::Cast(*atlas_context);
@@ -444,14 +446,24 @@ std::shared_ptr<GlyphAtlas> TypographerContextSTB::CreateGlyphAtlas(
     }
 
     // ---------------------------------------------------------------------------
-    // Step 5a: Update the existing texture with the updated bitmap.
+    // Step 5a: Update the existing texture with the updated bitmap. Prefer
+    //          uploading only the region covered by the new glyphs.
     // ---------------------------------------------------------------------------
-    if (!UpdateGlyphTextureAtlas(bitmap, last_atlas->GetTexture())) {
-      return nullptr;
+    const auto& texture = last_atlas->GetTexture();
+    auto pixels = reinterpret_cast<const uint8_t*>(bitmap->GetPixels());
+    if (!UploadGlyphAtlasRegion(context, texture, pixels, bitmap->GetRowBytes(),
+                                glyph_positions, kPadding)) {
+      if (!UpdateGlyphTextureAtlas(bitmap, texture)) {
+        return nullptr;
+      }
+      ReportGlyphAtlasUpdate(
+          texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel(),
+          fml::TimeDelta::Zero());
     }
     return last_atlas;
   }
   // A new glyph atlas must be created.
+  auto rebuild_start = fml::TimePoint::Now();
 
   // ---------------------------------------------------------------------------
   // Step 3b: Get the optimum size of the texture atlas.
@@ -522,6 +534,8 @@ std::shared_ptr<GlyphAtlas> TypographerContextSTB::CreateGlyphAtlas(
       format = DISABLE_COLOR_FONT_SUPPORT ? PixelFormat::kA8UNormInt
                                           : PixelFormat::kR8G8B8A8UNormInt;
       break;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      return nullptr;
   }
   auto texture = UploadGlyphTextureAtlas(context.GetResourceAllocator(), bitmap,
                                          atlas_size, format);
@@ -534,6 +548,10 @@ std::shared_ptr<GlyphAtlas> TypographerContextSTB::CreateGlyphAtlas(
   // ---------------------------------------------------------------------------
   glyph_atlas->SetTexture(std::move(texture));
 
+  ReportGlyphAtlasUpdate(glyph_atlas->GetTexture()
+                             ->GetTextureDescriptor()
+                             .GetByteSizeOfBaseMipLevel(),
+                         fml::TimePoint::Now() - rebuild_start);
   return glyph_atlas;
 }
 
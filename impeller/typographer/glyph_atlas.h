@@ -42,8 +42,28 @@ class GlyphAtlas {
     /// colors.
     ///
     kColorBitmap,
+
+    //--------------------------------------------------------------------------
+    /// The glyphs are represented at a fixed size, regardless of the
+    /// requested one, as the 8-bit signed distance to their outlines. The
+    /// same glyphs are drawn at every larger size.
+    ///
+    kSignedDistanceField,
   };
 
+  //----------------------------------------------------------------------------
+  /// The size in pixels of the em square of the glyphs of signed distance
+  /// field atlases.
+  ///
+  static constexpr Scalar kSignedDistanceFieldEmSize = 64.0f;
+
+  //----------------------------------------------------------------------------
+  /// The distance in pixels from the outlines of the glyphs at which the
+  /// signed distance fields of the glyphs saturate, which also pads the
+  /// glyphs in the atlas.
+  ///
+  static constexpr int kSignedDistanceFieldSpread = 8;
+
   //----------------------------------------------------------------------------
   /// @brief      Create an empty glyph atlas.
   ///
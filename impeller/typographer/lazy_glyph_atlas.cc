@@ -19,23 +19,98 @@ LazyGlyphAtlas::LazyGlyphAtlas(
                          : nullptr),
       color_context_(typographer_context_
                          ? typographer_context_->CreateGlyphAtlasContext()
-                         : nullptr) {}
+                         : nullptr),
+      sdf_context_(typographer_context_ &&
+                           typographer_context_->SupportsSignedDistanceFields()
+                       ? typographer_context_->CreateGlyphAtlasContext()
+                       : nullptr) {}
 
 LazyGlyphAtlas::~LazyGlyphAtlas() = default;
 
-void LazyGlyphAtlas::AddTextFrame(const TextFrame& frame, Scalar scale) {
+GlyphAtlas::Type LazyGlyphAtlas::AddTextFrame(const TextFrame& frame,
+                                              Scalar scale) {
   FML_DCHECK(atlas_map_.empty());
-  if (frame.GetAtlasType() == GlyphAtlas::Type::kAlphaBitmap) {
-    frame.CollectUniqueFontGlyphPairs(alpha_glyph_map_, scale);
-  } else {
-    frame.CollectUniqueFontGlyphPairs(color_glyph_map_, scale);
-  }
+  auto type = frame.GetAtlasType(scale, sdf_context_ != nullptr);
+  frame.CollectUniqueFontGlyphPairs(GetGlyphMap(type), scale, type);
+  return type;
 }
 
 void LazyGlyphAtlas::ResetTextFrames() {
+  atlas_map_.clear();
+  if (in_frame_batch_) {
+    return;
+  }
   alpha_glyph_map_.clear();
   color_glyph_map_.clear();
-  atlas_map_.clear();
+  sdf_glyph_map_.clear();
+}
+
+void LazyGlyphAtlas::BeginFrameBatch() {
+  in_frame_batch_ = true;
+}
+
+void LazyGlyphAtlas::EndFrameBatch() {
+  in_frame_batch_ = false;
+  ResetTextFrames();
+}
+
+void LazyGlyphAtlas::Trim() {
+  if (!typographer_context_) {
+    return;
+  }
+  alpha_context_ = typographer_context_->CreateGlyphAtlasContext();
+  color_context_ = typographer_context_->CreateGlyphAtlasContext();
+  if (sdf_context_) {
+    sdf_context_ = typographer_context_->CreateGlyphAtlasContext();
+  }
+}
+
+LazyGlyphAtlas::Stats LazyGlyphAtlas::GetStats() const {
+  Stats stats;
+  for (const auto& context : {alpha_context_, color_context_, sdf_context_}) {
+    if (!context) {
+      continue;
+    }
+    auto atlas = context->GetGlyphAtlas();
+    if (!atlas) {
+      continue;
+    }
+    stats.glyph_count += atlas->GetGlyphCount();
+    if (const auto& texture = atlas->GetTexture()) {
+      stats.texture_bytes +=
+          texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+    }
+  }
+  return stats;
+}
+
+const FontGlyphMap& LazyGlyphAtlas::GetGlyphMap(GlyphAtlas::Type type) const {
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      return alpha_glyph_map_;
+    case GlyphAtlas::Type::kColorBitmap:
+      return color_glyph_map_;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      return sdf_glyph_map_;
+  }
+  FML_UNREACHABLE();
+}
+
+FontGlyphMap& LazyGlyphAtlas::GetGlyphMap(GlyphAtlas::Type type) {
+  return const_cast<FontGlyphMap&>(std::as_const(*this).GetGlyphMap(type));
+}
+
+const std::shared_ptr<GlyphAtlasContext>& LazyGlyphAtlas::GetAtlasContext(
+    GlyphAtlas::Type type) const {
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      return alpha_context_;
+    case GlyphAtlas::Type::kColorBitmap:
+      return color_context_;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      return sdf_context_;
+  }
+  FML_UNREACHABLE();
 }
 
 std::shared_ptr<GlyphAtlas> LazyGlyphAtlas::CreateOrGetGlyphAtlas(
@@ -59,12 +134,14 @@ std::shared_ptr<GlyphAtlas> LazyGlyphAtlas::CreateOrGetGlyphAtlas(
     return nullptr;
   }
 
-  auto& glyph_map = type == GlyphAtlas::Type::kAlphaBitmap ? alpha_glyph_map_
-                                                           : color_glyph_map_;
-  auto atlas_context =
-      type == GlyphAtlas::Type::kAlphaBitmap ? alpha_context_ : color_context_;
-  auto atlas = typographer_context_->CreateGlyphAtlas(context, type,
-                                                      atlas_context, glyph_map);
+  const auto& atlas_context = GetAtlasContext(type);
+  if (!atlas_context) {
+    VALIDATION_LOG << "The TypographerContext does not support this atlas "
+                      "type.";
+    return nullptr;
+  }
+  auto atlas = typographer_context_->CreateGlyphAtlas(
+      context, type, atlas_context, GetGlyphMap(type));
   if (!atlas || !atlas->IsValid()) {
     VALIDATION_LOG << "Could not create valid atlas.";
     return nullptr;
@@ -17,15 +17,58 @@ namespace impeller {
 
 class LazyGlyphAtlas {
  public:
+  struct Stats {
+    /// The number of glyphs in the atlases kept for reuse.
+    size_t glyph_count = 0u;
+    /// The bytes of the textures of the atlases kept for reuse.
+    size_t texture_bytes = 0u;
+  };
+
   explicit LazyGlyphAtlas(
       std::shared_ptr<TypographerContext> typographer_context);
 
   ~LazyGlyphAtlas();
 
-  void AddTextFrame(const TextFrame& frame, Scalar scale);
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the glyphs of the frame drawn at `scale` to the atlas
+  ///             of the type returned, from which the frame is drawn.
+  ///
+  GlyphAtlas::Type AddTextFrame(const TextFrame& frame, Scalar scale);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Drops the atlases created since the text frames were last
+  ///             added, and the glyphs of the text frames unless a frame
+  ///             batch is in progress.
+  ///
   void ResetTextFrames();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Keeps the glyphs of the text frames added until
+  ///             `EndFrameBatch`, so that the atlases created for each render
+  ///             of the batch also hold the glyphs of the renders before it.
+  ///
+  ///             When several views are drawn for a frame, this stops the
+  ///             atlas from being rebuilt back and forth between the glyphs
+  ///             of each view, since the atlas built for the last view holds
+  ///             the glyphs of all of them.
+  ///
+  void BeginFrameBatch();
+
+  void EndFrameBatch();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Releases the atlases kept for reuse by the next frames, which
+  ///             then create new ones of the size they need. Called when the
+  ///             device is low on memory.
+  ///
+  void Trim();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The size of the atlases kept for reuse, summed over the atlas
+  ///             types.
+  ///
+  Stats GetStats() const;
+
   std::shared_ptr<GlyphAtlas> CreateOrGetGlyphAtlas(
       Context& context,
       GlyphAtlas::Type type) const;
@@ -35,10 +78,20 @@ class LazyGlyphAtlas {
 
   FontGlyphMap alpha_glyph_map_;
   FontGlyphMap color_glyph_map_;
+  FontGlyphMap sdf_glyph_map_;
   std::shared_ptr<GlyphAtlasContext> alpha_context_;
   std::shared_ptr<GlyphAtlasContext> color_context_;
+  std::shared_ptr<GlyphAtlasContext> sdf_context_;
   mutable std::unordered_map<GlyphAtlas::Type, std::shared_ptr<GlyphAtlas>>
       atlas_map_;
+  bool in_frame_batch_ = false;
+
+  const FontGlyphMap& GetGlyphMap(GlyphAtlas::Type type) const;
+
+  FontGlyphMap& GetGlyphMap(GlyphAtlas::Type type);
+
+  const std::shared_ptr<GlyphAtlasContext>& GetAtlasContext(
+      GlyphAtlas::Type type) const;
 
   LazyGlyphAtlas(const LazyGlyphAtlas&) = delete;
 
@@ -5,6 +5,7 @@
 #include "impeller/typographer/rectangle_packer.h"
 
 #include <algorithm>
+#include <limits>
 #include <vector>
 
 namespace impeller {
@@ -166,8 +167,177 @@ void SkylineRectanglePacker::addSkylineLevel(int skylineIndex,
   }
 }
 
-RectanglePacker* RectanglePacker::Factory(int width, int height) {
-  return new SkylineRectanglePacker(width, height);
+// Track the maximal free rectangles of the area and place each new rectangle
+// using the best short side fit heuristic.
+// Based on Jukka Jylanki's "A Thousand Ways to Pack the Bin".
+class MaxRectsRectanglePacker final : public RectanglePacker {
+ public:
+  MaxRectsRectanglePacker(int w, int h) : RectanglePacker(w, h) {
+    this->reset();
+  }
+
+  ~MaxRectsRectanglePacker() final {}
+
+  void reset() final {
+    area_so_far_ = 0;
+    free_rects_.clear();
+    free_rects_.push_back(FreeRect{0, 0, this->width(), this->height()});
+  }
+
+  bool addRect(int w, int h, IPoint16* loc) final;
+
+  float percentFull() const final {
+    return area_so_far_ / ((float)this->width() * this->height());
+  }
+
+ private:
+  struct FreeRect {
+    int x_;
+    int y_;
+    int width_;
+    int height_;
+
+    int right() const { return x_ + width_; }
+    int bottom() const { return y_ + height_; }
+
+    bool Contains(const FreeRect& other) const {
+      return other.x_ >= x_ && other.y_ >= y_ && other.right() <= right() &&
+             other.bottom() <= bottom();
+    }
+
+    bool Intersects(const FreeRect& other) const {
+      return other.x_ < right() && other.right() > x_ && other.y_ < bottom() &&
+             other.bottom() > y_;
+    }
+  };
+
+  std::vector<FreeRect> free_rects_;
+
+  int32_t area_so_far_;
+
+  // Replace every free rectangle overlapping 'used' with the (up to four)
+  // maximal rectangles of its remaining free space. The new rectangles are
+  // stored after all of the untouched ones, whose count is returned.
+  size_t splitFreeRects(const FreeRect& used);
+  // Remove free rectangles at or after 'firstNew' that are fully contained in
+  // another one.
+  void pruneFreeRects(size_t firstNew);
+};
+
+bool MaxRectsRectanglePacker::addRect(int width, int height, IPoint16* loc) {
+  if ((unsigned)width > (unsigned)this->width() ||
+      (unsigned)height > (unsigned)this->height()) {
+    return false;
+  }
+
+  // find the free rectangle leaving the shortest leftover side, breaking ties
+  // on the longest leftover side
+  int bestShortSide = std::numeric_limits<int>::max();
+  int bestLongSide = std::numeric_limits<int>::max();
+  int bestIndex = -1;
+  for (int i = 0; i < (int)free_rects_.size(); ++i) {
+    const FreeRect& free = free_rects_[i];
+    if (width > free.width_ || height > free.height_) {
+      continue;
+    }
+    int leftoverX = free.width_ - width;
+    int leftoverY = free.height_ - height;
+    int shortSide = std::min(leftoverX, leftoverY);
+    int longSide = std::max(leftoverX, leftoverY);
+    if (shortSide < bestShortSide ||
+        (shortSide == bestShortSide && longSide < bestLongSide)) {
+      bestIndex = i;
+      bestShortSide = shortSide;
+      bestLongSide = longSide;
+    }
+  }
+
+  if (-1 == bestIndex) {
+    loc->x_ = 0;
+    loc->y_ = 0;
+    return false;
+  }
+
+  FreeRect used{free_rects_[bestIndex].x_, free_rects_[bestIndex].y_, width,
+                height};
+  this->pruneFreeRects(this->splitFreeRects(used));
+
+  loc->x_ = used.x_;
+  loc->y_ = used.y_;
+
+  area_so_far_ += width * height;
+  return true;
+}
+
+size_t MaxRectsRectanglePacker::splitFreeRects(const FreeRect& used) {
+  // Only the rectangles present before the split need to be examined; the new
+  // ones appended below never overlap 'used'.
+  size_t count = free_rects_.size();
+  for (size_t i = 0; i < count;) {
+    const FreeRect free = free_rects_[i];
+    if (!free.Intersects(used)) {
+      ++i;
+      continue;
+    }
+
+    if (used.x_ > free.x_) {
+      free_rects_.push_back(
+          FreeRect{free.x_, free.y_, used.x_ - free.x_, free.height_});
+    }
+    if (used.right() < free.right()) {
+      free_rects_.push_back(FreeRect{used.right(), free.y_,
+                                     free.right() - used.right(),
+                                     free.height_});
+    }
+    if (used.y_ > free.y_) {
+      free_rects_.push_back(
+          FreeRect{free.x_, free.y_, free.width_, used.y_ - free.y_});
+    }
+    if (used.bottom() < free.bottom()) {
+      free_rects_.push_back(FreeRect{free.x_, used.bottom(), free.width_,
+                                     free.bottom() - used.bottom()});
+    }
+
+    // swap-remove the split rectangle, pulling in an unexamined one if any
+    --count;
+    free_rects_[i] = free_rects_[count];
+    free_rects_[count] = free_rects_.back();
+    free_rects_.pop_back();
+  }
+  return count;
+}
+
+void MaxRectsRectanglePacker::pruneFreeRects(size_t firstNew) {
+  // Free rectangles that predate the split were already maximal and cannot
+  // be contained in the new ones, which are all parts of a former free
+  // rectangle. Only the new rectangles need to be tested.
+  for (size_t i = firstNew; i < free_rects_.size();) {
+    bool contained = false;
+    for (size_t j = 0; j < free_rects_.size(); ++j) {
+      if (j != i && free_rects_[j].Contains(free_rects_[i])) {
+        contained = true;
+        break;
+      }
+    }
+    if (contained) {
+      free_rects_[i] = free_rects_.back();
+      free_rects_.pop_back();
+    } else {
+      ++i;
+    }
+  }
+}
+
+RectanglePacker* RectanglePacker::Factory(int width,
+                                          int height,
+                                          Algorithm algorithm) {
+  switch (algorithm) {
+    case Algorithm::kSkyline:
+      return new SkylineRectanglePacker(width, height);
+    case Algorithm::kMaxRects:
+      return new MaxRectsRectanglePacker(width, height);
+  }
+  FML_UNREACHABLE();
 }
 
 }  // namespace impeller
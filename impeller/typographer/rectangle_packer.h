@@ -24,10 +24,26 @@ struct IPoint16 {
 ///
 class RectanglePacker {
  public:
+  //----------------------------------------------------------------------------
+  /// @brief     The packing strategy used to place rectangles.
+  ///
+  enum class Algorithm {
+    /// Tracks the top silhouette of the placed rectangles and places each new
+    /// rectangle as low as possible. Fast, but leaves unused space below
+    /// overhanging rectangles when sizes are very mixed.
+    kSkyline,
+    /// Tracks every maximal free rectangle and places each new rectangle in
+    /// the one that leaves the shortest leftover side. Slower per insertion,
+    /// but packs mixed sizes (for example emoji among Latin glyphs) tighter.
+    kMaxRects,
+  };
+
   //----------------------------------------------------------------------------
   /// @brief     Return an empty packer with area specified by width and height.
   ///
-  static RectanglePacker* Factory(int width, int height);
+  static RectanglePacker* Factory(int width,
+                                  int height,
+                                  Algorithm algorithm = Algorithm::kSkyline);
 
   virtual ~RectanglePacker() {}
 
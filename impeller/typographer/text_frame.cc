@@ -30,6 +30,23 @@ GlyphAtlas::Type TextFrame::GetAtlasType() const {
                     : GlyphAtlas::Type::kAlphaBitmap;
 }
 
+GlyphAtlas::Type TextFrame::GetAtlasType(
+    Scalar scale,
+    bool allow_signed_distance_field) const {
+  if (has_color_ || !allow_signed_distance_field || runs_.empty()) {
+    return GetAtlasType();
+  }
+  for (const TextRun& run : runs_) {
+    // The signed distance fields are only magnified, since thin strokes fade
+    // when they are minified.
+    if (run.GetFont().GetMetrics().point_size * scale <
+        GlyphAtlas::kSignedDistanceFieldEmSize) {
+      return GetAtlasType();
+    }
+  }
+  return GlyphAtlas::Type::kSignedDistanceField;
+}
+
 bool TextFrame::MaybeHasOverlapping() const {
   if (runs_.size() > 1) {
     return true;
@@ -67,12 +84,28 @@ Scalar TextFrame::RoundScaledFontSize(Scalar scale, Scalar point_size) {
   return std::round(scale * 100) / 100;
 }
 
+// static
+Scalar TextFrame::GetAtlasScale(GlyphAtlas::Type type,
+                                Scalar scale,
+                                Scalar point_size) {
+  if (type == GlyphAtlas::Type::kSignedDistanceField) {
+    return GlyphAtlas::kSignedDistanceFieldEmSize / point_size;
+  }
+  return RoundScaledFontSize(scale, point_size);
+}
+
 void TextFrame::CollectUniqueFontGlyphPairs(FontGlyphMap& glyph_map,
                                             Scalar scale) const {
+  CollectUniqueFontGlyphPairs(glyph_map, scale, GetAtlasType());
+}
+
+void TextFrame::CollectUniqueFontGlyphPairs(FontGlyphMap& glyph_map,
+                                            Scalar scale,
+                                            GlyphAtlas::Type type) const {
   for (const TextRun& run : GetRuns()) {
     const Font& font = run.GetFont();
     auto rounded_scale =
-        RoundScaledFontSize(scale, font.GetMetrics().point_size);
+        GetAtlasScale(type, scale, font.GetMetrics().point_size);
     auto& set = glyph_map[{font, rounded_scale}];
     for (const TextRun::GlyphPosition& glyph_position :
          run.GetGlyphPositions()) {
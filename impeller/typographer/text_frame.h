@@ -27,8 +27,24 @@ class TextFrame {
 
   void CollectUniqueFontGlyphPairs(FontGlyphMap& glyph_map, Scalar scale) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Collects the glyphs of this frame drawn at `scale` from an
+  ///             atlas of the given type.
+  ///
+  void CollectUniqueFontGlyphPairs(FontGlyphMap& glyph_map,
+                                   Scalar scale,
+                                   GlyphAtlas::Type type) const;
+
   static Scalar RoundScaledFontSize(Scalar scale, Scalar point_size);
 
+  //----------------------------------------------------------------------------
+  /// @brief      The scale at which the glyphs of a font are stored in an atlas
+  ///             of the given type, to be drawn at `scale`.
+  ///
+  static Scalar GetAtlasScale(GlyphAtlas::Type type,
+                              Scalar scale,
+                              Scalar point_size);
+
   //----------------------------------------------------------------------------
   /// @brief      The conservative bounding box for this text frame.
   ///
@@ -65,6 +81,18 @@ class TextFrame {
   /// @brief      The type of atlas this run should be emplaced in.
   GlyphAtlas::Type GetAtlasType() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The type of atlas this run should be emplaced in to be drawn
+  ///             at `scale`.
+  ///
+  ///             Frames without color glyphs whose fonts are all drawn at least
+  ///             as large as the glyphs of signed distance field atlases use
+  ///             such an atlas if `allow_signed_distance_field` is true, so
+  ///             that the glyphs are not rasterized again at every scale.
+  ///
+  GlyphAtlas::Type GetAtlasType(Scalar scale,
+                                bool allow_signed_distance_field) const;
+
   TextFrame& operator=(TextFrame&& other) = default;
 
   TextFrame(const TextFrame& other) = default;
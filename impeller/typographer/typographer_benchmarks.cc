@@ -0,0 +1,132 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "impeller/typographer/rectangle_packer.h"
+#include "third_party/skia/include/core/SkFont.h"
+#include "third_party/skia/include/core/SkFontMgr.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+#include "txt/platform.h"
+
+namespace impeller {
+
+namespace {
+
+/// Matches the padding the glyph atlas adds around every glyph.
+constexpr int kGlyphPadding = 2;
+constexpr int kAtlasSize = 512;
+constexpr SkScalar kFontSizes[] = {12, 14, 16, 20, 28};
+
+struct GlyphSize {
+  int width;
+  int height;
+};
+
+void AppendGlyphSizes(const SkFont& font,
+                      const std::vector<SkUnichar>& characters,
+                      std::vector<GlyphSize>& sizes) {
+  std::vector<SkGlyphID> glyphs(characters.size());
+  font.unicharsToGlyphs(characters.data(), characters.size(), glyphs.data());
+  std::vector<SkRect> bounds(glyphs.size());
+  font.getBounds(glyphs.data(), glyphs.size(), bounds.data(), nullptr);
+  for (const auto& rect : bounds) {
+    if (rect.isEmpty()) {
+      continue;
+    }
+    sizes.push_back(
+        {static_cast<int>(std::ceil(rect.width())) + kGlyphPadding,
+         static_cast<int>(std::ceil(rect.height())) + kGlyphPadding});
+  }
+}
+
+/// The padded bounds of every printable ASCII glyph of the default typeface
+/// at common UI font sizes, optionally mixed with emoji from the platform's
+/// emoji font, if there is one. Shuffled since the atlas inserts glyphs in
+/// hash order.
+std::vector<GlyphSize> CreateGlyphSizes(bool with_emoji) {
+  auto font_mgr = txt::GetDefaultFontManager();
+  sk_sp<SkTypeface> typeface =
+      font_mgr->matchFamilyStyle(nullptr, SkFontStyle::Normal());
+  std::vector<SkUnichar> latin;
+  for (SkUnichar c = 0x21; c < 0x7f; c++) {
+    latin.push_back(c);
+  }
+  std::vector<SkUnichar> emoji;
+  for (SkUnichar c = 0x1F600; c < 0x1F640; c++) {
+    emoji.push_back(c);
+  }
+  sk_sp<SkTypeface> emoji_typeface;
+  if (with_emoji) {
+    emoji_typeface = font_mgr->matchFamilyStyleCharacter(
+        nullptr, SkFontStyle::Normal(), nullptr, 0, emoji.front());
+  }
+
+  std::vector<GlyphSize> sizes;
+  for (auto font_size : kFontSizes) {
+    if (typeface) {
+      AppendGlyphSizes(SkFont(typeface, font_size), latin, sizes);
+    }
+    if (emoji_typeface) {
+      AppendGlyphSizes(SkFont(emoji_typeface, font_size), emoji, sizes);
+    }
+  }
+  std::shuffle(sizes.begin(), sizes.end(), std::mt19937(0));
+  return sizes;
+}
+
+}  // namespace
+
+/// Packs glyphs into a fresh atlas until the first one that does not fit,
+/// which is when the glyph atlas would grow. Reports the fraction of the atlas
+/// covered at that point.
+static void BM_RectanglePacker(benchmark::State& state,
+                               RectanglePacker::Algorithm algorithm,
+                               bool with_emoji) {
+  auto sizes = CreateGlyphSizes(with_emoji);
+  if (sizes.empty()) {
+    state.SkipWithError("No fonts available.");
+    return;
+  }
+  auto packer = std::unique_ptr<RectanglePacker>(
+      RectanglePacker::Factory(kAtlasSize, kAtlasSize, algorithm));
+
+  size_t packed = 0u;
+  while (state.KeepRunning()) {
+    packer->reset();
+    packed = 0u;
+    IPoint16 location;
+    while (packer->addRect(sizes[packed % sizes.size()].width,
+                           sizes[packed % sizes.size()].height, &location)) {
+      packed++;
+    }
+  }
+  state.counters["PackedRects"] = packed;
+  state.counters["Occupancy"] = packer->percentFull();
+}
+
+BENCHMARK_CAPTURE(BM_RectanglePacker,
+                  skyline_latin,
+                  RectanglePacker::Algorithm::kSkyline,
+                  false);
+BENCHMARK_CAPTURE(BM_RectanglePacker,
+                  skyline_mixed_emoji,
+                  RectanglePacker::Algorithm::kSkyline,
+                  true);
+BENCHMARK_CAPTURE(BM_RectanglePacker,
+                  maxrects_latin,
+                  RectanglePacker::Algorithm::kMaxRects,
+                  false);
+BENCHMARK_CAPTURE(BM_RectanglePacker,
+                  maxrects_mixed_emoji,
+                  RectanglePacker::Algorithm::kMaxRects,
+                  true);
+
+}  // namespace impeller
@@ -4,8 +4,14 @@
 
 #include "impeller/typographer/typographer_context.h"
 
+#include <cmath>
+#include <cstring>
 #include <utility>
 
+#include "flutter/fml/trace_event.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
+
 namespace impeller {
 
 TypographerContext::TypographerContext() {
@@ -18,4 +24,100 @@ bool TypographerContext::IsValid() const {
   return is_valid_;
 }
 
+bool TypographerContext::SupportsSignedDistanceFields() const {
+  return false;
+}
+
+bool TypographerContext::UploadGlyphAtlasRegion(
+    Context& context,
+    const std::shared_ptr<Texture>& texture,
+    const uint8_t* pixels,
+    size_t row_bytes,
+    const std::vector<Rect>& glyph_positions,
+    int padding) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (!texture || !pixels ||
+      !context.GetCapabilities()->SupportsBufferToTextureBlits()) {
+    return false;
+  }
+  if (glyph_positions.empty()) {
+    return true;
+  }
+
+  // The bounds of the new glyphs, including the padding reserved for each,
+  // are the only pixels in the bitmap that changed since the last upload.
+  auto texture_bounds = IRect::MakeSize(texture->GetSize());
+  std::optional<IRect> dirty_region;
+  for (const auto& position : glyph_positions) {
+    auto glyph_region = IRect::MakeXYWH(
+        static_cast<int64_t>(position.GetX()),
+        static_cast<int64_t>(position.GetY()),
+        static_cast<int64_t>(std::ceil(position.GetWidth())) + padding,
+        static_cast<int64_t>(std::ceil(position.GetHeight())) + padding);
+    dirty_region = IRect::Union(dirty_region, glyph_region);
+  }
+  dirty_region = dirty_region->Intersection(texture_bounds);
+  if (!dirty_region.has_value() || dirty_region->IsEmpty()) {
+    return true;
+  }
+
+  auto bytes_per_pixel =
+      BytesPerPixelForPixelFormat(texture->GetTextureDescriptor().format);
+  auto region_row_bytes = dirty_region->GetWidth() * bytes_per_pixel;
+
+  DeviceBufferDescriptor buffer_desc;
+  buffer_desc.storage_mode = StorageMode::kHostVisible;
+  buffer_desc.size = region_row_bytes * dirty_region->GetHeight();
+  auto buffer = context.GetResourceAllocator()->CreateBuffer(buffer_desc);
+  if (!buffer) {
+    return false;
+  }
+  buffer->SetLabel("GlyphAtlasUpload");
+
+  // Blits expect tightly packed rows, so copy the dirty rows out of the
+  // bitmap.
+  auto contents = buffer->OnGetContents();
+  const uint8_t* source = pixels + dirty_region->GetY() * row_bytes +
+                          dirty_region->GetX() * bytes_per_pixel;
+  for (int64_t row = 0; row < dirty_region->GetHeight(); row++) {
+    ::memcpy(contents + row * region_row_bytes, source + row * row_bytes,
+             region_row_bytes);
+  }
+  buffer->Flush();
+
+  auto cmd_buffer = context.CreateCommandBuffer();
+  if (!cmd_buffer) {
+    return false;
+  }
+  cmd_buffer->SetLabel("GlyphAtlas Update Command Buffer");
+  auto blit_pass = cmd_buffer->CreateBlitPass();
+  if (!blit_pass) {
+    return false;
+  }
+  blit_pass->SetLabel("GlyphAtlas Update Blit Pass");
+  if (!blit_pass->AddCopy(DeviceBuffer::AsBufferView(std::move(buffer)),
+                          texture, dirty_region.value(), "GlyphAtlas Update")) {
+    return false;
+  }
+  if (!blit_pass->EncodeCommands(context.GetResourceAllocator()) ||
+      !cmd_buffer->SubmitCommands()) {
+    return false;
+  }
+
+  ReportGlyphAtlasUpdate(buffer_desc.size, fml::TimeDelta::Zero());
+  return true;
+}
+
+void TypographerContext::ReportGlyphAtlasUpdate(size_t bytes_uploaded,
+                                                fml::TimeDelta rebuild_time) {
+  static constexpr int64_t kImpellerGlyphAtlasTraceID = 1990;
+  FML_TRACE_COUNTER("impeller",                                         //
+                    "GlyphAtlas",                                       //
+                    kImpellerGlyphAtlasTraceID,                         //
+                    "GlyphAtlasBytesUploaded", bytes_uploaded,          //
+                    "GlyphAtlasRebuildMicros",                          //
+                    rebuild_time.ToMicroseconds()                       //
+  );
+}
+
 }  // namespace impeller
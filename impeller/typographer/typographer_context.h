@@ -6,8 +6,10 @@
 #define FLUTTER_IMPELLER_TYPOGRAPHER_TYPOGRAPHER_CONTEXT_H_
 
 #include <memory>
+#include <vector>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
 #include "impeller/renderer/context.h"
 #include "impeller/typographer/glyph_atlas.h"
 
@@ -26,6 +28,12 @@ class TypographerContext {
 
   virtual bool IsValid() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether this context can create atlases of type
+  ///             `GlyphAtlas::Type::kSignedDistanceField`.
+  ///
+  virtual bool SupportsSignedDistanceFields() const;
+
   virtual std::shared_ptr<GlyphAtlasContext> CreateGlyphAtlasContext()
       const = 0;
 
@@ -45,6 +53,36 @@ class TypographerContext {
   ///
   TypographerContext();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Uploads only the parts of an atlas bitmap covered by newly
+  ///             added glyphs to the existing atlas texture, using a blit
+  ///             pass.
+  ///
+  /// @param[in]  context          The context used to record the blit.
+  /// @param[in]  texture          The atlas texture to update.
+  /// @param[in]  pixels           The pixels of the entire atlas bitmap.
+  /// @param[in]  row_bytes        The stride of the atlas bitmap.
+  /// @param[in]  glyph_positions  The locations of the new glyphs.
+  /// @param[in]  padding          The padding reserved around each glyph.
+  ///
+  /// @return     If the upload was recorded and submitted. Callers should
+  ///             fall back to replacing the entire contents of the texture if
+  ///             the context doesn't support buffer to texture blits.
+  ///
+  static bool UploadGlyphAtlasRegion(Context& context,
+                                     const std::shared_ptr<Texture>& texture,
+                                     const uint8_t* pixels,
+                                     size_t row_bytes,
+                                     const std::vector<Rect>& glyph_positions,
+                                     int padding);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reports the number of bytes sent to an atlas texture and the
+  ///             time taken to rebuild an atlas as trace counters.
+  ///
+  static void ReportGlyphAtlasUpdate(size_t bytes_uploaded,
+                                     fml::TimeDelta rebuild_time);
+
  private:
   bool is_valid_ = false;
 
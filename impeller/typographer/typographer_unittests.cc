@@ -127,6 +127,85 @@ TEST_P(TypographerTest, LazyAtlasTracksColor) {
   ASSERT_FALSE(color_atlas == bitmap_atlas);
 }
 
+TEST_P(TypographerTest, LazyAtlasUsesSignedDistanceFieldsForMagnifiedText) {
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString("hello", sk_font);
+  ASSERT_TRUE(blob);
+  auto frame = MakeTextFrameFromTextBlobSkia(blob);
+
+  LazyGlyphAtlas lazy_atlas(TypographerContextSkia::Make());
+
+  // Small text is rasterized at its scale.
+  ASSERT_EQ(lazy_atlas.AddTextFrame(*frame, 1.0f),
+            GlyphAtlas::Type::kAlphaBitmap);
+  // Text larger than the glyphs of the distance fields reuses them.
+  ASSERT_EQ(lazy_atlas.AddTextFrame(*frame, 6.0f),
+            GlyphAtlas::Type::kSignedDistanceField);
+  ASSERT_EQ(lazy_atlas.AddTextFrame(*frame, 12.0f),
+            GlyphAtlas::Type::kSignedDistanceField);
+
+  auto sdf_atlas = lazy_atlas.CreateOrGetGlyphAtlas(
+      *GetContext(), GlyphAtlas::Type::kSignedDistanceField);
+  ASSERT_NE(sdf_atlas, nullptr);
+  ASSERT_NE(sdf_atlas->GetTexture(), nullptr);
+  ASSERT_EQ(sdf_atlas->GetType(), GlyphAtlas::Type::kSignedDistanceField);
+  // Both scales share the glyphs of a single scaled font.
+  ASSERT_EQ(sdf_atlas->GetGlyphCount(), 4llu);
+  ASSERT_NE(sdf_atlas->GetFontGlyphAtlas(
+                frame->GetRuns()[0].GetFont(),
+                TextFrame::GetAtlasScale(GlyphAtlas::Type::kSignedDistanceField,
+                                         12.0f, 12.0f)),
+            nullptr);
+}
+
+TEST_P(TypographerTest, LazyAtlasReportsTheSizeOfItsAtlases) {
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString("hello", sk_font);
+  ASSERT_TRUE(blob);
+  auto frame = MakeTextFrameFromTextBlobSkia(blob);
+
+  LazyGlyphAtlas lazy_atlas(TypographerContextSkia::Make());
+  ASSERT_EQ(lazy_atlas.GetStats().glyph_count, 0u);
+  ASSERT_EQ(lazy_atlas.GetStats().texture_bytes, 0u);
+
+  lazy_atlas.AddTextFrame(*frame, 1.0f);
+  auto atlas = lazy_atlas.CreateOrGetGlyphAtlas(*GetContext(),
+                                                GlyphAtlas::Type::kAlphaBitmap);
+  ASSERT_NE(atlas, nullptr);
+  ASSERT_NE(atlas->GetTexture(), nullptr);
+
+  auto stats = lazy_atlas.GetStats();
+  ASSERT_EQ(stats.glyph_count, atlas->GetGlyphCount());
+  ASSERT_EQ(stats.texture_bytes, atlas->GetTexture()
+                                     ->GetTextureDescriptor()
+                                     .GetByteSizeOfBaseMipLevel());
+}
+
+TEST_P(TypographerTest, LazyAtlasKeepsGlyphsOfFrameBatch) {
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto first_frame =
+      MakeTextFrameFromTextBlobSkia(SkTextBlob::MakeFromString("ab", sk_font));
+  auto second_frame =
+      MakeTextFrameFromTextBlobSkia(SkTextBlob::MakeFromString("cd", sk_font));
+
+  LazyGlyphAtlas lazy_atlas(TypographerContextSkia::Make());
+  lazy_atlas.BeginFrameBatch();
+
+  // The first view of the frame.
+  lazy_atlas.AddTextFrame(*first_frame, 1.0f);
+  auto atlas = lazy_atlas.CreateOrGetGlyphAtlas(*GetContext(),
+                                                GlyphAtlas::Type::kAlphaBitmap);
+  ASSERT_EQ(atlas->GetGlyphCount(), 2llu);
+  lazy_atlas.ResetTextFrames();
+
+  // The atlas of the second view also holds the glyphs of the first.
+  lazy_atlas.AddTextFrame(*second_frame, 1.0f);
+  atlas = lazy_atlas.CreateOrGetGlyphAtlas(*GetContext(),
+                                           GlyphAtlas::Type::kAlphaBitmap);
+  ASSERT_EQ(atlas->GetGlyphCount(), 4llu);
+  lazy_atlas.EndFrameBatch();
+}
+
 TEST_P(TypographerTest, GlyphAtlasWithOddUniqueGlyphSize) {
   auto context = TypographerContextSkia::Make();
   auto atlas_context = context->CreateGlyphAtlasContext();
@@ -338,6 +417,65 @@ TEST_P(TypographerTest, RectanglePackerAddsNonoverlapingRectangles) {
   ASSERT_EQ(packer->percentFull(), 0);
 }
 
+TEST_P(TypographerTest, MaxRectsRectanglePackerAddsNonoverlapingRectangles) {
+  auto packer = std::unique_ptr<RectanglePacker>(RectanglePacker::Factory(
+      200, 100, RectanglePacker::Algorithm::kMaxRects));
+  ASSERT_NE(packer, nullptr);
+  ASSERT_EQ(packer->percentFull(), 0);
+
+  const SkIRect packer_area = SkIRect::MakeXYWH(0, 0, 200, 100);
+
+  IPoint16 first_output = {-1, -1};
+  ASSERT_TRUE(packer->addRect(20, 20, &first_output));
+  const SkIRect first_rect =
+      SkIRect::MakeXYWH(first_output.x(), first_output.y(), 20, 20);
+  ASSERT_TRUE(packer_area.contains(first_rect));
+  ASSERT_TRUE(flutter::testing::NumberNear(packer->percentFull(), 0.02));
+
+  IPoint16 second_output = {-1, -1};
+  ASSERT_TRUE(packer->addRect(140, 90, &second_output));
+  const SkIRect second_rect =
+      SkIRect::MakeXYWH(second_output.x(), second_output.y(), 140, 90);
+  ASSERT_TRUE(packer_area.contains(second_rect));
+  ASSERT_FALSE(SkIRect::Intersects(first_rect, second_rect));
+  ASSERT_TRUE(flutter::testing::NumberNear(packer->percentFull(), 0.65));
+
+  IPoint16 output;
+  ASSERT_FALSE(packer->addRect(50, 50, &output));
+  ASSERT_TRUE(flutter::testing::NumberNear(packer->percentFull(), 0.65));
+
+  packer->reset();
+  ASSERT_EQ(packer->percentFull(), 0);
+  ASSERT_TRUE(packer->addRect(200, 100, &output));
+  ASSERT_TRUE(flutter::testing::NumberNear(packer->percentFull(), 1.0));
+}
+
+TEST_P(TypographerTest, RectanglePackersPackMixedSizesWithoutOverlap) {
+  for (auto algorithm : {RectanglePacker::Algorithm::kSkyline,
+                         RectanglePacker::Algorithm::kMaxRects}) {
+    auto packer = std::unique_ptr<RectanglePacker>(
+        RectanglePacker::Factory(256, 256, algorithm));
+    std::vector<SkIRect> placed;
+    for (int i = 0;; i++) {
+      // Every seventh rectangle is a large square among small narrow ones,
+      // similar to emoji mixed into Latin text.
+      int width = i % 7 == 0 ? 40 : 6 + (i * 5) % 9;
+      int height = i % 7 == 0 ? 40 : 12 + (i * 3) % 7;
+      IPoint16 loc;
+      if (!packer->addRect(width, height, &loc)) {
+        break;
+      }
+      auto rect = SkIRect::MakeXYWH(loc.x(), loc.y(), width, height);
+      ASSERT_TRUE(SkIRect::MakeWH(256, 256).contains(rect));
+      for (const auto& other : placed) {
+        ASSERT_FALSE(SkIRect::Intersects(rect, other));
+      }
+      placed.push_back(rect);
+    }
+    ASSERT_GT(packer->percentFull(), 0.75);
+  }
+}
+
 TEST_P(TypographerTest, GlyphAtlasTextureIsRecycledWhenContentsAreRecreated) {
   auto context = TypographerContextSkia::Make();
   auto atlas_context = context->CreateGlyphAtlasContext();
@@ -7,6 +7,7 @@
 #include "dart_api.h"
 #include "fml/make_copyable.h"
 #include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/compute_pass.h"
 #include "impeller/renderer/render_pass.h"
 #include "lib/ui/ui_dart_state.h"
 #include "tonic/converter/dart_converter.h"
@@ -17,8 +18,10 @@ namespace gpu {
 IMPLEMENT_WRAPPERTYPEINFO(flutter_gpu, CommandBuffer);
 
 CommandBuffer::CommandBuffer(
+    std::shared_ptr<impeller::Context> context,
     std::shared_ptr<impeller::CommandBuffer> command_buffer)
-    : command_buffer_(std::move(command_buffer)) {}
+    : context_(std::move(context)),
+      command_buffer_(std::move(command_buffer)) {}
 
 CommandBuffer::~CommandBuffer() = default;
 
@@ -26,23 +29,34 @@ std::shared_ptr<impeller::CommandBuffer> CommandBuffer::GetCommandBuffer() {
   return command_buffer_;
 }
 
+const std::shared_ptr<impeller::Context>& CommandBuffer::GetContext() const {
+  return context_;
+}
+
 void CommandBuffer::AddRenderPass(
     std::shared_ptr<impeller::RenderPass> render_pass) {
   encodables_.push_back(std::move(render_pass));
 }
 
-bool CommandBuffer::Submit() {
+void CommandBuffer::AddComputePass(
+    std::shared_ptr<impeller::ComputePass> compute_pass) {
+  encodables_.push_back(std::move(compute_pass));
+}
+
+void CommandBuffer::EncodeCommands() {
   for (auto& encodable : encodables_) {
-    encodable->EncodeCommands();
+    std::visit([](auto& pass) { pass->EncodeCommands(); }, encodable);
   }
+}
+
+bool CommandBuffer::Submit() {
+  EncodeCommands();
   return command_buffer_->SubmitCommands();
 }
 
 bool CommandBuffer::Submit(
     const impeller::CommandBuffer::CompletionCallback& completion_callback) {
-  for (auto& encodable : encodables_) {
-    encodable->EncodeCommands();
-  }
+  EncodeCommands();
   return command_buffer_->SubmitCommands(completion_callback);
 }
 
@@ -57,6 +71,7 @@ bool InternalFlutterGpu_CommandBuffer_Initialize(
     Dart_Handle wrapper,
     flutter::gpu::Context* contextWrapper) {
   auto res = fml::MakeRefCounted<flutter::gpu::CommandBuffer>(
+      contextWrapper->GetContext(),
       contextWrapper->GetContext()->CreateCommandBuffer());
   res->AssociateWithDartWrapper(wrapper);
 
@@ -5,10 +5,15 @@
 #ifndef FLUTTER_LIB_GPU_COMMAND_BUFFER_H_
 #define FLUTTER_LIB_GPU_COMMAND_BUFFER_H_
 
+#include <memory>
+#include <variant>
+#include <vector>
+
 #include "flutter/lib/gpu/context.h"
 #include "flutter/lib/gpu/export.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/compute_pass.h"
 
 namespace flutter {
 namespace gpu {
@@ -18,13 +23,17 @@ class CommandBuffer : public RefCountedDartWrappable<CommandBuffer> {
   FML_FRIEND_MAKE_REF_COUNTED(CommandBuffer);
 
  public:
-  explicit CommandBuffer(
-      std::shared_ptr<impeller::CommandBuffer> command_buffer);
+  CommandBuffer(std::shared_ptr<impeller::Context> context,
+                std::shared_ptr<impeller::CommandBuffer> command_buffer);
 
   std::shared_ptr<impeller::CommandBuffer> GetCommandBuffer();
 
+  const std::shared_ptr<impeller::Context>& GetContext() const;
+
   void AddRenderPass(std::shared_ptr<impeller::RenderPass> render_pass);
 
+  void AddComputePass(std::shared_ptr<impeller::ComputePass> compute_pass);
+
   bool Submit();
   bool Submit(
       const impeller::CommandBuffer::CompletionCallback& completion_callback);
@@ -32,8 +41,16 @@ class CommandBuffer : public RefCountedDartWrappable<CommandBuffer> {
   ~CommandBuffer() override;
 
  private:
+  using Encodable = std::variant<std::shared_ptr<impeller::RenderPass>,
+                                 std::shared_ptr<impeller::ComputePass>>;
+
+  void EncodeCommands();
+
+  std::shared_ptr<impeller::Context> context_;
   std::shared_ptr<impeller::CommandBuffer> command_buffer_;
-  std::vector<std::shared_ptr<impeller::RenderPass>> encodables_;
+  // The passes in the order they were begun, which is the order in which
+  // they are encoded.
+  std::vector<Encodable> encodables_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(CommandBuffer);
 };
@@ -0,0 +1,175 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/gpu/compute_pass.h"
+
+#include "flutter/lib/gpu/compute_pipeline.h"
+#include "flutter/lib/gpu/shader.h"
+#include "fml/memory/ref_ptr.h"
+#include "impeller/core/buffer_view.h"
+#include "impeller/core/shader_types.h"
+#include "impeller/renderer/pipeline_library.h"
+#include "tonic/converter/dart_converter.h"
+
+namespace flutter {
+namespace gpu {
+
+IMPLEMENT_WRAPPERTYPEINFO(flutter_gpu, ComputePass);
+
+ComputePass::ComputePass() = default;
+
+ComputePass::~ComputePass() = default;
+
+impeller::ComputeCommand& ComputePass::GetCommand() {
+  return command_;
+}
+
+const fml::RefPtr<ComputePipeline>& ComputePass::GetPipeline() const {
+  return compute_pipeline_;
+}
+
+bool ComputePass::Begin(flutter::gpu::CommandBuffer& command_buffer) {
+  context_ = command_buffer.GetContext();
+  if (!context_ || !context_->GetCapabilities()->SupportsCompute()) {
+    return false;
+  }
+  compute_pass_ = command_buffer.GetCommandBuffer()->CreateComputePass();
+  if (!compute_pass_) {
+    return false;
+  }
+  command_buffer.AddComputePass(compute_pass_);
+  return true;
+}
+
+void ComputePass::SetPipeline(fml::RefPtr<ComputePipeline> pipeline) {
+  compute_pipeline_ = std::move(pipeline);
+}
+
+void ComputePass::SetGridSize(const impeller::ISize& size) {
+  compute_pass_->SetGridSize(size);
+}
+
+void ComputePass::SetThreadGroupSize(const impeller::ISize& size) {
+  compute_pass_->SetThreadGroupSize(size);
+}
+
+std::shared_ptr<impeller::Pipeline<impeller::ComputePipelineDescriptor>>
+ComputePass::GetOrCreatePipeline() {
+  impeller::ComputePipelineDescriptor pipeline_desc;
+  compute_pipeline_->BindToPipelineDescriptor(*context_->GetShaderLibrary(),
+                                              pipeline_desc);
+
+  auto pipeline =
+      context_->GetPipelineLibrary()->GetPipeline(pipeline_desc).Get();
+  FML_DCHECK(pipeline) << "Couldn't resolve compute pipeline";
+  return pipeline;
+}
+
+bool ComputePass::Dispatch() {
+  if (!compute_pipeline_) {
+    return false;
+  }
+  impeller::ComputeCommand result = command_;
+  result.pipeline = GetOrCreatePipeline();
+  return compute_pass_->AddCommand(std::move(result));
+}
+
+}  // namespace gpu
+}  // namespace flutter
+
+//----------------------------------------------------------------------------
+/// Exports
+///
+
+void InternalFlutterGpu_ComputePass_Initialize(Dart_Handle wrapper) {
+  auto res = fml::MakeRefCounted<flutter::gpu::ComputePass>();
+  res->AssociateWithDartWrapper(wrapper);
+}
+
+Dart_Handle InternalFlutterGpu_ComputePass_Begin(
+    flutter::gpu::ComputePass* wrapper,
+    flutter::gpu::CommandBuffer* command_buffer) {
+  if (!wrapper->Begin(*command_buffer)) {
+    return tonic::ToDart("Failed to begin ComputePass");
+  }
+  return Dart_Null();
+}
+
+void InternalFlutterGpu_ComputePass_BindPipeline(
+    flutter::gpu::ComputePass* wrapper,
+    flutter::gpu::ComputePipeline* pipeline) {
+  auto ref = fml::RefPtr<flutter::gpu::ComputePipeline>(pipeline);
+  wrapper->SetPipeline(std::move(ref));
+}
+
+template <typename TBuffer>
+static bool BindBuffer(flutter::gpu::ComputePass* wrapper,
+                       flutter::gpu::Shader* shader,
+                       Dart_Handle name_handle,
+                       TBuffer buffer,
+                       int offset_in_bytes,
+                       int length_in_bytes) {
+  auto name = tonic::StdStringFromDart(name_handle);
+  // Uniform and storage buffers are both bound by the name of their block.
+  const flutter::gpu::Shader::UniformBinding* binding =
+      shader->GetUniformStruct(name);
+  if (!binding) {
+    return false;
+  }
+
+  return wrapper->GetCommand().BindResource(
+      impeller::ShaderStage::kCompute, binding->slot, binding->metadata,
+      impeller::BufferView{
+          .buffer = buffer,
+          .range = impeller::Range(offset_in_bytes, length_in_bytes),
+      });
+}
+
+bool InternalFlutterGpu_ComputePass_BindBufferDevice(
+    flutter::gpu::ComputePass* wrapper,
+    flutter::gpu::Shader* shader,
+    Dart_Handle name_handle,
+    flutter::gpu::DeviceBuffer* device_buffer,
+    int offset_in_bytes,
+    int length_in_bytes) {
+  return BindBuffer(wrapper, shader, name_handle, device_buffer->GetBuffer(),
+                    offset_in_bytes, length_in_bytes);
+}
+
+bool InternalFlutterGpu_ComputePass_BindBufferHost(
+    flutter::gpu::ComputePass* wrapper,
+    flutter::gpu::Shader* shader,
+    Dart_Handle name_handle,
+    flutter::gpu::HostBuffer* host_buffer,
+    int offset_in_bytes,
+    int length_in_bytes) {
+  auto view =
+      host_buffer->GetBufferViewForOffset(offset_in_bytes, length_in_bytes);
+  if (!view.has_value()) {
+    FML_LOG(ERROR) << "Failed to bind buffer due to invalid HostBuffer offset: "
+                   << offset_in_bytes;
+    return false;
+  }
+  return BindBuffer(wrapper, shader, name_handle, view->buffer,
+                    view->range.offset, view->range.length);
+}
+
+void InternalFlutterGpu_ComputePass_SetGridSize(
+    flutter::gpu::ComputePass* wrapper,
+    int width,
+    int height) {
+  wrapper->SetGridSize(impeller::ISize(width, height));
+}
+
+void InternalFlutterGpu_ComputePass_SetThreadGroupSize(
+    flutter::gpu::ComputePass* wrapper,
+    int width,
+    int height) {
+  wrapper->SetThreadGroupSize(impeller::ISize(width, height));
+}
+
+bool InternalFlutterGpu_ComputePass_Dispatch(
+    flutter::gpu::ComputePass* wrapper) {
+  return wrapper->Dispatch();
+}
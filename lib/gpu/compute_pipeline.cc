@@ -0,0 +1,60 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/gpu/compute_pipeline.h"
+
+#include "flutter/lib/gpu/shader.h"
+#include "impeller/renderer/compute_pipeline_descriptor.h"
+#include "tonic/converter/dart_converter.h"
+
+namespace flutter {
+namespace gpu {
+
+IMPLEMENT_WRAPPERTYPEINFO(flutter_gpu, ComputePipeline);
+
+ComputePipeline::ComputePipeline(
+    fml::RefPtr<flutter::gpu::Shader> compute_shader)
+    : compute_shader_(std::move(compute_shader)) {}
+
+void ComputePipeline::BindToPipelineDescriptor(
+    impeller::ShaderLibrary& library,
+    impeller::ComputePipelineDescriptor& desc) {
+  desc.SetStageEntrypoint(compute_shader_->GetFunctionFromLibrary(library));
+}
+
+const fml::RefPtr<flutter::gpu::Shader>& ComputePipeline::GetComputeShader()
+    const {
+  return compute_shader_;
+}
+
+ComputePipeline::~ComputePipeline() = default;
+
+}  // namespace gpu
+}  // namespace flutter
+
+//----------------------------------------------------------------------------
+/// Exports
+///
+
+Dart_Handle InternalFlutterGpu_ComputePipeline_Initialize(
+    Dart_Handle wrapper,
+    flutter::gpu::Context* gpu_context,
+    flutter::gpu::Shader* compute_shader) {
+  if (compute_shader->GetShaderStage() != impeller::ShaderStage::kCompute) {
+    return tonic::ToDart("ComputePipelines require a compute shader");
+  }
+  if (!gpu_context->GetContext()->GetCapabilities()->SupportsCompute()) {
+    return tonic::ToDart(
+        "The rendering backend doesn't support compute pipelines");
+  }
+
+  // Lazily register the shader synchronously if it hasn't been already.
+  compute_shader->RegisterSync(*gpu_context);
+
+  auto res = fml::MakeRefCounted<flutter::gpu::ComputePipeline>(
+      fml::RefPtr<flutter::gpu::Shader>(compute_shader));
+  res->AssociateWithDartWrapper(wrapper);
+
+  return Dart_Null();
+}
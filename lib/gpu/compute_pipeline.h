@@ -0,0 +1,54 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_GPU_COMPUTE_PIPELINE_H_
+#define FLUTTER_LIB_GPU_COMPUTE_PIPELINE_H_
+
+#include "flutter/lib/gpu/context.h"
+#include "flutter/lib/gpu/export.h"
+#include "flutter/lib/gpu/shader.h"
+#include "flutter/lib/ui/dart_wrapper.h"
+#include "impeller/renderer/compute_pipeline_descriptor.h"
+
+namespace flutter {
+namespace gpu {
+
+class ComputePipeline : public RefCountedDartWrappable<ComputePipeline> {
+  DEFINE_WRAPPERTYPEINFO();
+  FML_FRIEND_MAKE_REF_COUNTED(ComputePipeline);
+
+ public:
+  explicit ComputePipeline(fml::RefPtr<flutter::gpu::Shader> compute_shader);
+
+  ~ComputePipeline() override;
+
+  void BindToPipelineDescriptor(impeller::ShaderLibrary& library,
+                                impeller::ComputePipelineDescriptor& desc);
+
+  const fml::RefPtr<flutter::gpu::Shader>& GetComputeShader() const;
+
+ private:
+  fml::RefPtr<flutter::gpu::Shader> compute_shader_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ComputePipeline);
+};
+
+}  // namespace gpu
+}  // namespace flutter
+
+//----------------------------------------------------------------------------
+/// Exports
+///
+
+extern "C" {
+
+FLUTTER_GPU_EXPORT
+extern Dart_Handle InternalFlutterGpu_ComputePipeline_Initialize(
+    Dart_Handle wrapper,
+    flutter::gpu::Context* gpu_context,
+    flutter::gpu::Shader* compute_shader);
+
+}  // extern "C"
+
+#endif  // FLUTTER_LIB_GPU_COMPUTE_PIPELINE_H_
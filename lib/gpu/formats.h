@@ -125,6 +125,10 @@ constexpr FlutterGPUPixelFormat FromImpellerPixelFormat(
       return FlutterGPUPixelFormat::kB10G10R10XRSRGB;
     case impeller::PixelFormat::kB10G10R10A10XR:
       return FlutterGPUPixelFormat::kB10G10R10A10XR;
+    case impeller::PixelFormat::kETC2R8G8B8A8UNormInt:
+    case impeller::PixelFormat::kASTC4x4UNormInt:
+    case impeller::PixelFormat::kBC7UNormInt:
+      return FlutterGPUPixelFormat::kUnknown;
     case impeller::PixelFormat::kS8UInt:
       return FlutterGPUPixelFormat::kS8UInt;
     case impeller::PixelFormat::kD24UnormS8Uint:
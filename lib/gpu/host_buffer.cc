@@ -4,6 +4,7 @@
 
 #include "flutter/lib/gpu/host_buffer.h"
 
+#include <memory>
 #include <optional>
 
 #include "dart_api.h"
@@ -30,15 +31,79 @@ size_t HostBuffer::EmplaceBytes(const tonic::DartByteData& byte_data) {
   auto view =
       host_buffer_->Emplace(byte_data.data(), byte_data.length_in_bytes(),
                             impeller::DefaultUniformAlignment());
-  emplacements_[current_offset_] = view;
+  emplacements_[current_offset_] = {.view = view};
   size_t previous_offset = current_offset_;
   current_offset_ += view.range.length;
   return previous_offset;
 }
 
+size_t HostBuffer::ReserveBytes(size_t length) {
+  // The contents are written by Dart after this returns, and flushed when a
+  // view of them is bound.
+  auto view = host_buffer_->Emplace(length, impeller::DefaultUniformAlignment(),
+                                    [](uint8_t* contents) {});
+  emplacements_[current_offset_] = {.view = view, .is_reserved = true};
+  size_t previous_offset = current_offset_;
+  current_offset_ += view.range.length;
+  return previous_offset;
+}
+
+static void ReleaseMappedBuffer(void* isolate_callback_data, void* peer) {
+  delete static_cast<std::shared_ptr<const impeller::DeviceBuffer>*>(peer);
+}
+
+Dart_Handle HostBuffer::GetMappedBytes(size_t offset) {
+  auto found = emplacements_.find(offset);
+  if (found == emplacements_.end() || !found->second.is_reserved ||
+      !found->second.view) {
+    return Dart_Null();
+  }
+  const impeller::BufferView& view = found->second.view;
+  uint8_t* contents = view.buffer->OnGetContents();
+  if (!contents) {
+    return Dart_Null();
+  }
+
+  // The ByteData keeps the device buffer alive, so that a ByteData that
+  // outlives the frame doesn't map freed memory.
+  auto peer = new std::shared_ptr<const impeller::DeviceBuffer>(view.buffer);
+  Dart_Handle bytes = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kByteData, contents + view.range.offset,
+      view.range.length, peer, view.range.length, ReleaseMappedBuffer);
+  if (Dart_IsError(bytes)) {
+    delete peer;
+  }
+  return bytes;
+}
+
+void HostBuffer::Reset() {
+  host_buffer_->Reset();
+  emplacements_.clear();
+  current_offset_ = 0;
+}
+
 std::optional<impeller::BufferView> HostBuffer::GetBufferViewForOffset(
-    size_t offset) {
-  return emplacements_[offset];
+    size_t offset,
+    size_t length) {
+  auto found = emplacements_.upper_bound(offset);
+  if (found == emplacements_.begin()) {
+    return std::nullopt;
+  }
+  found--;
+  const auto& [emplacement_offset, emplacement] = *found;
+  const size_t offset_in_view = offset - emplacement_offset;
+  if (!emplacement.view || length > emplacement.view.range.length ||
+      offset_in_view > emplacement.view.range.length - length) {
+    return std::nullopt;
+  }
+
+  impeller::Range range(emplacement.view.range.offset + offset_in_view,
+                        length);
+  if (emplacement.is_reserved) {
+    emplacement.view.buffer->Flush(range);
+  }
+  return impeller::BufferView{.buffer = emplacement.view.buffer,
+                              .range = range};
 }
 
 }  // namespace gpu
@@ -59,3 +124,19 @@ size_t InternalFlutterGpu_HostBuffer_EmplaceBytes(
     Dart_Handle byte_data) {
   return wrapper->EmplaceBytes(tonic::DartByteData(byte_data));
 }
+
+size_t InternalFlutterGpu_HostBuffer_ReserveBytes(
+    flutter::gpu::HostBuffer* wrapper,
+    size_t length) {
+  return wrapper->ReserveBytes(length);
+}
+
+Dart_Handle InternalFlutterGpu_HostBuffer_GetMappedBytes(
+    flutter::gpu::HostBuffer* wrapper,
+    size_t offset) {
+  return wrapper->GetMappedBytes(offset);
+}
+
+void InternalFlutterGpu_HostBuffer_Reset(flutter::gpu::HostBuffer* wrapper) {
+  wrapper->Reset();
+}
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_LIB_GPU_HOST_BUFFER_H_
 #define FLUTTER_LIB_GPU_HOST_BUFFER_H_
 
+#include <map>
+
 #include "flutter/lib/gpu/export.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "impeller/core/buffer_view.h"
@@ -28,12 +30,38 @@ class HostBuffer : public RefCountedDartWrappable<HostBuffer> {
 
   size_t EmplaceBytes(const tonic::DartByteData& byte_data);
 
-  std::optional<impeller::BufferView> GetBufferViewForOffset(size_t offset);
+  /// Reserves `length` bytes that Dart writes in place through the ByteData
+  /// returned by `GetMappedBytes`, rather than copying them in with
+  /// `EmplaceBytes`. Returns the offset of the reserved bytes.
+  size_t ReserveBytes(size_t length);
+
+  /// Returns an external ByteData that maps the bytes reserved at `offset`
+  /// into host-visible device memory, or null if no bytes were reserved
+  /// there.
+  Dart_Handle GetMappedBytes(size_t offset);
+
+  /// Moves on to the next frame of the ring of device buffers, so that the
+  /// offsets start over. Views from the previous frames that are still in
+  /// flight remain valid.
+  void Reset();
+
+  /// Returns the view of `length` bytes at `offset`, which may be in the
+  /// middle of emplaced or reserved bytes. Reserved bytes are flushed to the
+  /// device when a view of them is returned.
+  std::optional<impeller::BufferView> GetBufferViewForOffset(size_t offset,
+                                                             size_t length);
 
  private:
+  struct Emplacement {
+    impeller::BufferView view;
+    bool is_reserved = false;
+  };
+
   size_t current_offset_ = 0;
   std::shared_ptr<impeller::HostBuffer> host_buffer_;
-  std::unordered_map<size_t, impeller::BufferView> emplacements_;
+  // Ordered by offset, so that the emplacement containing an offset can be
+  // found.
+  std::map<size_t, Emplacement> emplacements_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(HostBuffer);
 };
@@ -57,6 +85,20 @@ extern size_t InternalFlutterGpu_HostBuffer_EmplaceBytes(
     flutter::gpu::HostBuffer* wrapper,
     Dart_Handle byte_data);
 
+FLUTTER_GPU_EXPORT
+extern size_t InternalFlutterGpu_HostBuffer_ReserveBytes(
+    flutter::gpu::HostBuffer* wrapper,
+    size_t length);
+
+FLUTTER_GPU_EXPORT
+extern Dart_Handle InternalFlutterGpu_HostBuffer_GetMappedBytes(
+    flutter::gpu::HostBuffer* wrapper,
+    size_t offset);
+
+FLUTTER_GPU_EXPORT
+extern void InternalFlutterGpu_HostBuffer_Reset(
+    flutter::gpu::HostBuffer* wrapper);
+
 }  // extern "C"
 
 #endif  // FLUTTER_LIB_GPU_HOST_BUFFER_H_
@@ -21,6 +21,8 @@ export 'src/smoketest.dart';
 
 part 'src/buffer.dart';
 part 'src/command_buffer.dart';
+part 'src/compute_pass.dart';
+part 'src/compute_pipeline.dart';
 part 'src/context.dart';
 part 'src/formats.dart';
 part 'src/texture.dart';
@@ -33,6 +33,9 @@ mixin Buffer {
 
   bool _bindAsUniform(RenderPass renderPass, UniformSlot slot,
       int offsetInBytes, int lengthInBytes);
+
+  bool _bindToComputePass(ComputePass computePass, UniformSlot slot,
+      int offsetInBytes, int lengthInBytes);
 }
 
 /// [DeviceBuffer] is a region of memory allocated on the device heap
@@ -82,6 +85,13 @@ base class DeviceBuffer extends NativeFieldWrapperClass1 with Buffer {
         slot.shader, slot.uniformName, this, offsetInBytes, lengthInBytes);
   }
 
+  @override
+  bool _bindToComputePass(ComputePass computePass, UniformSlot slot,
+      int offsetInBytes, int lengthInBytes) {
+    return computePass._bindBufferDevice(
+        slot.shader, slot.uniformName, this, offsetInBytes, lengthInBytes);
+  }
+
   /// Wrap with native counterpart.
   @Native<Bool Function(Handle, Pointer<Void>, Int, Int)>(
       symbol: 'InternalFlutterGpu_DeviceBuffer_Initialize')
@@ -160,6 +170,13 @@ base class HostBuffer extends NativeFieldWrapperClass1 with Buffer {
         slot.shader, slot.uniformName, this, offsetInBytes, lengthInBytes);
   }
 
+  @override
+  bool _bindToComputePass(ComputePass computePass, UniformSlot slot,
+      int offsetInBytes, int lengthInBytes) {
+    return computePass._bindBufferHost(
+        slot.shader, slot.uniformName, this, offsetInBytes, lengthInBytes);
+  }
+
   /// Wrap with native counterpart.
   @Native<Void Function(Handle, Pointer<Void>)>(
       symbol: 'InternalFlutterGpu_HostBuffer_Initialize')
@@ -183,4 +200,68 @@ base class HostBuffer extends NativeFieldWrapperClass1 with Buffer {
   @Native<Uint64 Function(Pointer<Void>, Handle)>(
       symbol: 'InternalFlutterGpu_HostBuffer_EmplaceBytes')
   external int _emplaceBytes(ByteData bytes);
+
+  /// Reserve [lengthInBytes] bytes at the end of the [HostBuffer] and produce
+  /// a [HostBufferRegion] whose bytes are written in place.
+  ///
+  /// Unlike [emplace], which copies its [ByteData] into the buffer, the
+  /// [HostBufferRegion.bytes] map the GPU-visible memory of the buffer
+  /// directly. Reserving one region per frame and writing the vertices and
+  /// uniforms of every draw into it avoids a copy across the native boundary
+  /// per draw. Views of any part of the region can be made with [BufferView],
+  /// at offsets relative to [HostBufferRegion.view].
+  ///
+  /// The bytes must be written before a rendering command uses a view of
+  /// them, and must not be written after [reset] has reused the region.
+  HostBufferRegion reserve(int lengthInBytes) {
+    if (lengthInBytes < 0) {
+      throw Exception('lengthInBytes must be positive');
+    }
+    int resultOffset = _reserveBytes(lengthInBytes);
+    ByteData? bytes = _getMappedBytes(resultOffset);
+    if (bytes == null) {
+      throw Exception('Failed to map the reserved HostBuffer bytes');
+    }
+    return HostBufferRegion._(
+        BufferView(this,
+            offsetInBytes: resultOffset, lengthInBytes: lengthInBytes),
+        bytes);
+  }
+
+  @Native<Uint64 Function(Pointer<Void>, Uint64)>(
+      symbol: 'InternalFlutterGpu_HostBuffer_ReserveBytes')
+  external int _reserveBytes(int lengthInBytes);
+
+  @Native<Handle Function(Pointer<Void>, Uint64)>(
+      symbol: 'InternalFlutterGpu_HostBuffer_GetMappedBytes')
+  external ByteData? _getMappedBytes(int offsetInBytes);
+
+  /// Start a new frame of the [HostBuffer], so that the offsets of the
+  /// [BufferView]s it produces start over.
+  ///
+  /// The buffer cycles through the memory of a few frames, so the views
+  /// produced before a reset stay valid while the GPU still uses them, and
+  /// their memory is reused by a later frame instead of being reallocated.
+  /// Views produced before a reset must not be bound after it.
+  void reset() {
+    _reset();
+  }
+
+  @Native<Void Function(Pointer<Void>)>(
+      symbol: 'InternalFlutterGpu_HostBuffer_Reset')
+  external void _reset();
+}
+
+/// A region of a [HostBuffer] whose [bytes] are written in place.
+///
+/// Produced by [HostBuffer.reserve].
+class HostBufferRegion {
+  /// A view of the whole region.
+  final BufferView view;
+
+  /// The bytes of the region, which map the GPU-visible memory of the
+  /// [HostBuffer].
+  final ByteData bytes;
+
+  const HostBufferRegion._(this.view, this.bytes);
 }
@@ -18,6 +18,10 @@ base class CommandBuffer extends NativeFieldWrapperClass1 {
     return RenderPass._(this, renderTarget);
   }
 
+  ComputePass createComputePass() {
+    return ComputePass._(this);
+  }
+
   void submit({CompletionCallback? completionCallback}) {
     String? error = _submit(completionCallback);
     if (error != null) {
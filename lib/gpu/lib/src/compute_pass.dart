@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// ignore_for_file: public_member_api_docs
+
+part of flutter_gpu;
+
+/// Records dispatches of compute pipelines, which are encoded in the order
+/// the passes of a [CommandBuffer] are created, so that a compute pass can
+/// produce the data a later [RenderPass] draws.
+///
+/// The grid and thread group sizes apply to every dispatch of the pass.
+base class ComputePass extends NativeFieldWrapperClass1 {
+  /// Creates a new ComputePass.
+  ComputePass._(CommandBuffer commandBuffer) {
+    _initialize();
+    String? error = _begin(commandBuffer);
+    if (error != null) {
+      throw Exception(error);
+    }
+  }
+
+  void bindPipeline(ComputePipeline pipeline) {
+    _bindPipeline(pipeline);
+  }
+
+  /// Binds a uniform or storage buffer of the compute shader by name.
+  void bindBuffer(UniformSlot slot, BufferView bufferView) {
+    bool success = bufferView.buffer._bindToComputePass(
+        this, slot, bufferView.offsetInBytes, bufferView.lengthInBytes);
+    if (!success) {
+      throw Exception("Failed to bind buffer");
+    }
+  }
+
+  void setGridSize(int width, int height) {
+    _setGridSize(width, height);
+  }
+
+  void setThreadGroupSize(int width, int height) {
+    _setThreadGroupSize(width, height);
+  }
+
+  void dispatch() {
+    bool success = _dispatch();
+    if (!success) {
+      throw Exception("Failed to append dispatch");
+    }
+  }
+
+  /// Wrap with native counterpart.
+  @Native<Void Function(Handle)>(
+      symbol: 'InternalFlutterGpu_ComputePass_Initialize')
+  external void _initialize();
+
+  @Native<Handle Function(Pointer<Void>, Pointer<Void>)>(
+      symbol: 'InternalFlutterGpu_ComputePass_Begin')
+  external String? _begin(CommandBuffer commandBuffer);
+
+  @Native<Void Function(Pointer<Void>, Pointer<Void>)>(
+      symbol: 'InternalFlutterGpu_ComputePass_BindPipeline')
+  external void _bindPipeline(ComputePipeline pipeline);
+
+  @Native<
+      Bool Function(Pointer<Void>, Pointer<Void>, Handle, Pointer<Void>, Int,
+          Int)>(symbol: 'InternalFlutterGpu_ComputePass_BindBufferDevice')
+  external bool _bindBufferDevice(Shader shader, String name,
+      DeviceBuffer buffer, int offsetInBytes, int lengthInBytes);
+
+  @Native<
+      Bool Function(Pointer<Void>, Pointer<Void>, Handle, Pointer<Void>, Int,
+          Int)>(symbol: 'InternalFlutterGpu_ComputePass_BindBufferHost')
+  external bool _bindBufferHost(Shader shader, String name, HostBuffer buffer,
+      int offsetInBytes, int lengthInBytes);
+
+  @Native<Void Function(Pointer<Void>, Int, Int)>(
+      symbol: 'InternalFlutterGpu_ComputePass_SetGridSize')
+  external void _setGridSize(int width, int height);
+
+  @Native<Void Function(Pointer<Void>, Int, Int)>(
+      symbol: 'InternalFlutterGpu_ComputePass_SetThreadGroupSize')
+  external void _setThreadGroupSize(int width, int height);
+
+  @Native<Bool Function(Pointer<Void>)>(
+      symbol: 'InternalFlutterGpu_ComputePass_Dispatch')
+  external bool _dispatch();
+}
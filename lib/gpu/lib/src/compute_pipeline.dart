@@ -0,0 +1,25 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// ignore_for_file: public_member_api_docs
+
+part of flutter_gpu;
+
+base class ComputePipeline extends NativeFieldWrapperClass1 {
+  /// Creates a new ComputePipeline.
+  ComputePipeline._(GpuContext gpuContext, Shader computeShader)
+      : computeShader = computeShader {
+    String? error = _initialize(gpuContext, computeShader);
+    if (error != null) {
+      throw Exception(error);
+    }
+  }
+
+  final Shader computeShader;
+
+  /// Wrap with native counterpart.
+  @Native<Handle Function(Handle, Pointer<Void>, Pointer<Void>)>(
+      symbol: 'InternalFlutterGpu_ComputePipeline_Initialize')
+  external String? _initialize(GpuContext gpuContext, Shader computeShader);
+}
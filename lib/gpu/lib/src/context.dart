@@ -108,6 +108,10 @@ base class GpuContext extends NativeFieldWrapperClass1 {
     return RenderPipeline._(this, vertexShader, fragmentShader);
   }
 
+  ComputePipeline createComputePipeline(Shader computeShader) {
+    return ComputePipeline._(this, computeShader);
+  }
+
   /// Associates the default Impeller context with this Context.
   @Native<Handle Function(Handle)>(
       symbol: 'InternalFlutterGpu_Context_InitializeDefault')
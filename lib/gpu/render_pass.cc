@@ -302,7 +302,7 @@ void InternalFlutterGpu_RenderPass_BindVertexBufferHost(
     int length_in_bytes,
     int vertex_count) {
   std::optional<impeller::BufferView> view =
-      host_buffer->GetBufferViewForOffset(offset_in_bytes);
+      host_buffer->GetBufferViewForOffset(offset_in_bytes, length_in_bytes);
   if (!view.has_value()) {
     FML_LOG(ERROR)
         << "Failed to bind vertex buffer due to invalid HostBuffer offset: "
@@ -347,7 +347,8 @@ void InternalFlutterGpu_RenderPass_BindIndexBufferHost(
     int length_in_bytes,
     int index_type,
     int index_count) {
-  auto view = host_buffer->GetBufferViewForOffset(offset_in_bytes);
+  auto view = host_buffer->GetBufferViewForOffset(offset_in_bytes,
+                                                  length_in_bytes);
   if (!view.has_value()) {
     FML_LOG(ERROR)
         << "Failed to bind index buffer due to invalid HostBuffer offset: "
@@ -403,7 +404,8 @@ bool InternalFlutterGpu_RenderPass_BindUniformHost(
     flutter::gpu::HostBuffer* host_buffer,
     int offset_in_bytes,
     int length_in_bytes) {
-  auto view = host_buffer->GetBufferViewForOffset(offset_in_bytes);
+  auto view = host_buffer->GetBufferViewForOffset(offset_in_bytes,
+                                                  length_in_bytes);
   if (!view.has_value()) {
     FML_LOG(ERROR)
         << "Failed to bind index buffer due to invalid HostBuffer offset: "
@@ -96,6 +96,7 @@ typedef CanvasPath Path;
   V(IsolateNameServerNatives::RemovePortNameMapping, 1)               \
   V(NativeStringAttribute::initLocaleStringAttribute, 4)              \
   V(NativeStringAttribute::initSpellOutStringAttribute, 3)            \
+  V(Paragraph::layoutAll, 2)                                          \
   V(PlatformConfigurationNativeApi::DefaultRouteName, 0)              \
   V(PlatformConfigurationNativeApi::ScheduleFrame, 0)                 \
   V(PlatformConfigurationNativeApi::Render, 1)                        \
@@ -136,10 +137,12 @@ typedef CanvasPath Path;
 //   If there is a mismatch between names or parameter count an @Native is
 //   trying to resolve, an exception will be thrown.
 #define FFI_METHOD_LIST(V)                             \
+  V(Canvas, batch, 1)                                  \
   V(Canvas, clipPath, 3)                               \
   V(Canvas, clipRect, 7)                               \
   V(Canvas, clipRRect, 3)                              \
   V(Canvas, drawArc, 10)                               \
+  V(Canvas, drawArcLeaf, 8)                            \
   V(Canvas, drawAtlas, 10)                             \
   V(Canvas, drawCircle, 6)                             \
   V(Canvas, drawColor, 3)                              \
@@ -150,17 +153,21 @@ typedef CanvasPath Path;
   V(Canvas, drawLine, 7)                               \
   V(Canvas, drawOval, 7)                               \
   V(Canvas, drawPaint, 3)                              \
+  V(Canvas, drawPaintLeaf, 1)                          \
   V(Canvas, drawPath, 4)                               \
+  V(Canvas, drawPathLeaf, 2)                           \
   V(Canvas, drawPicture, 2)                            \
   V(Canvas, drawPoints, 5)                             \
   V(Canvas, drawRRect, 4)                              \
   V(Canvas, drawRect, 7)                               \
   V(Canvas, drawShadow, 5)                             \
   V(Canvas, drawVertices, 5)                           \
+  V(Canvas, flushBatch, 1)                             \
   V(Canvas, getDestinationClipBounds, 2)               \
   V(Canvas, getLocalClipBounds, 2)                     \
   V(Canvas, getSaveCount, 1)                           \
   V(Canvas, getTransform, 2)                           \
+  V(Canvas, leafPaintData, 1)                          \
   V(Canvas, restore, 1)                                \
   V(Canvas, restoreToCount, 2)                         \
   V(Canvas, rotate, 2)                                 \
@@ -48,6 +48,18 @@ void setLatencyPerformanceMode() {
   _finish();
 }
 
+@pragma('vm:entry-point')
+void receiveLargePlatformMessage() {
+  channelBuffers.setListener('test', (ByteData? data, PlatformMessageResponseCallback callback) {
+    // The buffer should be writable.
+    data!.setUint8(0, 1);
+    _validatePlatformMessage(data);
+  });
+}
+
+@pragma('vm:external-name', 'ValidatePlatformMessage')
+external void _validatePlatformMessage(ByteData data);
+
 @pragma('vm:entry-point')
 void validateSceneBuilderAndScene() {
   final SceneBuilder builder = SceneBuilder();
@@ -304,6 +316,24 @@ external void _finishCallResponse(bool didPass);
 @pragma('vm:entry-point')
 void messageCallback(dynamic data) {}
 
+@pragma('vm:entry-point')
+void recordCanvasDraws() {
+  final PictureRecorder recorder = PictureRecorder();
+  final Canvas canvas = Canvas(recorder);
+  final Paint fill = Paint()..color = const Color(0xFF2196F3);
+  final Paint stroke = Paint()
+    ..color = const Color(0xFFF44336)
+    ..style = PaintingStyle.stroke
+    ..strokeWidth = 2;
+  for (int i = 0; i < 1000; i++) {
+    final double x = (i % 100).toDouble();
+    canvas.drawRect(Rect.fromLTWH(x, x, 10, 10), fill);
+    canvas.drawLine(Offset(x, 0), Offset(x, 100), stroke);
+    canvas.drawCircle(Offset(x, x), 5, fill);
+  }
+  recorder.endRecording().dispose();
+}
+
 @pragma('vm:entry-point')
 @pragma('vm:external-name', 'ValidateConfiguration')
 external void validateConfiguration();
@@ -10,4 +10,8 @@ std::shared_ptr<impeller::Context> IOManager::GetImpellerContext() const {
   return nullptr;
 }
 
+bool IOManager::PostConcurrentUploadTask(UploadTask task) {
+  return false;
+}
+
 }  // namespace flutter
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_LIB_UI_IO_MANAGER_H_
 #define FLUTTER_LIB_UI_IO_MANAGER_H_
 
+#include <functional>
+
 #include "flutter/flow/skia_gpu_object.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/sync_switch.h"
@@ -20,6 +22,10 @@ namespace flutter {
 // GrDirectContext, i.e. the shell's IOManager.
 class IOManager {
  public:
+  using UploadTask =
+      std::function<void(GrDirectContext* context,
+                         const fml::RefPtr<flutter::SkiaUnrefQueue>& queue)>;
+
   virtual ~IOManager() = default;
 
   virtual fml::WeakPtr<IOManager> GetWeakIOManager() const = 0;
@@ -32,6 +38,14 @@ class IOManager {
   GetIsGpuDisabledSyncSwitch() = 0;
 
   virtual std::shared_ptr<impeller::Context> GetImpellerContext() const;
+
+  // Posts a task that uploads resources with a resource context other than
+  // the one returned by |GetResourceContext|, on a thread other than the IO
+  // thread. The context is in the same share group, and the objects created
+  // with it must be released through the queue given to the task. Returns
+  // false without posting the task if there is no such context, in which case
+  // the upload should happen on the IO thread instead.
+  virtual bool PostConcurrentUploadTask(UploadTask task);
 };
 
 }  // namespace flutter
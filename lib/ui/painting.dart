@@ -5770,6 +5770,97 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   // garbage collected until PictureRecorder.endRecording is called.
   _NativePictureRecorder? _recorder;
 
+  // A view of native memory owned by the canvas. The data of the paints
+  // without objects is copied there so that the draws using them can be leaf
+  // calls, which don't convert the paint through handles.
+  Uint32List? _leafPaintData;
+
+  @Native<Handle Function(Pointer<Void>)>(symbol: 'Canvas::leafPaintData')
+  external Uint32List _getLeafPaintData();
+
+  // Whether `paint` can be drawn by a leaf call, in which case its data has
+  // been copied to `_leafPaintData`.
+  bool _prepareLeafPaint(Paint paint) {
+    if (paint._objects != null) {
+      return false;
+    }
+    final Uint32List leafPaintData = _leafPaintData ??= _getLeafPaintData();
+    final ByteData data = paint._data;
+    for (int i = 0; i < leafPaintData.length; i++) {
+      leafPaintData[i] = data.getUint32(i * 4, _kFakeHostEndian);
+    }
+    return true;
+  }
+
+  // Native memory owned by the canvas, into which the draws of rects, rounded
+  // rects, ovals, circles and lines whose paints have no objects are encoded
+  // instead of being submitted one by one. The native canvas decodes them
+  // when the batch is full, and before anything else is recorded.
+  //
+  // The layout must be kept in sync with Canvas::BatchOp in canvas.h.
+  Float64List? _batch;
+  Uint32List? _batchWords;
+  // The paint data of the last kBatchSetPaint op, which starts as the data of
+  // the default paint, all zeros, on both sides.
+  Uint32List? _batchPaintData;
+
+  static const int _kBatchSetPaint = 0;
+  static const int _kBatchDrawRect = 1;
+  static const int _kBatchDrawRRect = 2;
+  static const int _kBatchDrawOval = 3;
+  static const int _kBatchDrawCircle = 4;
+  static const int _kBatchDrawLine = 5;
+  static const int _kBatchPaintSlotCount = (Paint._kDataByteCount + 7) ~/ 8;
+
+  @Native<Handle Function(Pointer<Void>)>(symbol: 'Canvas::batch')
+  external Float64List _getBatch();
+
+  @Native<Void Function(Pointer<Void>)>(symbol: 'Canvas::flushBatch', isLeaf: true)
+  external void _flushBatch();
+
+  // Appends an `op` with `argCount` arguments drawn with `paint` to the batch,
+  // and returns the slot of its first argument, or -1 if `paint` has objects
+  // and must be drawn through handles.
+  int _reserveBatchOp(Paint paint, int op, int argCount) {
+    if (paint._objects != null) {
+      return -1;
+    }
+    final Float64List batch = _batch ??= _getBatch();
+    final Uint32List words = _batchWords ??= batch.buffer.asUint32List(batch.offsetInBytes, batch.length * 2);
+    final Uint32List lastPaintData = _batchPaintData ??= Uint32List(Paint._kDataByteCount ~/ 4);
+    final ByteData data = paint._data;
+    bool paintChanged = false;
+    for (int i = 0; !paintChanged && i < lastPaintData.length; i++) {
+      paintChanged = data.getUint32(i * 4, _kFakeHostEndian) != lastPaintData[i];
+    }
+    final int needed = 1 + argCount + (paintChanged ? 1 + _kBatchPaintSlotCount : 0);
+    int slot = words[0];
+    if (slot + needed > batch.length) {
+      _flushBatch();
+      slot = words[0];
+    }
+    if (paintChanged) {
+      words[slot * 2] = _kBatchSetPaint;
+      for (int i = 0; i < lastPaintData.length; i++) {
+        final int word = data.getUint32(i * 4, _kFakeHostEndian);
+        words[(slot + 1) * 2 + i] = word;
+        lastPaintData[i] = word;
+      }
+      slot += 1 + _kBatchPaintSlotCount;
+    }
+    words[slot * 2] = op;
+    words[0] = slot + 1 + argCount;
+    return slot + 1;
+  }
+
+  void _encodeBatchRect(int slot, Rect rect) {
+    final Float64List batch = _batch!;
+    batch[slot] = rect.left;
+    batch[slot + 1] = rect.top;
+    batch[slot + 2] = rect.right;
+    batch[slot + 3] = rect.bottom;
+  }
+
   @override
   @Native<Void Function(Pointer<Void>)>(symbol: 'Canvas::save', isLeaf: true)
   external void save();
@@ -5915,7 +6006,16 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   void drawLine(Offset p1, Offset p2, Paint paint) {
     assert(_offsetIsValid(p1));
     assert(_offsetIsValid(p2));
-    _drawLine(p1.dx, p1.dy, p2.dx, p2.dy, paint._objects, paint._data);
+    final int slot = _reserveBatchOp(paint, _kBatchDrawLine, 4);
+    if (slot >= 0) {
+      final Float64List batch = _batch!;
+      batch[slot] = p1.dx;
+      batch[slot + 1] = p1.dy;
+      batch[slot + 2] = p2.dx;
+      batch[slot + 3] = p2.dy;
+    } else {
+      _drawLine(p1.dx, p1.dy, p2.dx, p2.dy, paint._objects, paint._data);
+    }
   }
 
   @Native<Void Function(Pointer<Void>, Double, Double, Double, Double, Handle, Handle)>(symbol: 'Canvas::drawLine')
@@ -5923,18 +6023,30 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
 
   @override
   void drawPaint(Paint paint) {
-    _drawPaint(paint._objects, paint._data);
+    if (_prepareLeafPaint(paint)) {
+      _drawPaintLeaf();
+    } else {
+      _drawPaint(paint._objects, paint._data);
+    }
   }
 
   @Native<Void Function(Pointer<Void>, Handle, Handle)>(symbol: 'Canvas::drawPaint')
   external void _drawPaint(List<Object?>? paintObjects, ByteData paintData);
 
+  @Native<Void Function(Pointer<Void>)>(symbol: 'Canvas::drawPaintLeaf', isLeaf: true)
+  external void _drawPaintLeaf();
+
   @override
   void drawRect(Rect rect, Paint paint) {
     assert(_rectIsValid(rect));
     rect = _sorted(rect);
     if (paint.style != PaintingStyle.fill || !rect.isEmpty) {
-      _drawRect(rect.left, rect.top, rect.right, rect.bottom, paint._objects, paint._data);
+      final int slot = _reserveBatchOp(paint, _kBatchDrawRect, 4);
+      if (slot >= 0) {
+        _encodeBatchRect(slot, rect);
+      } else {
+        _drawRect(rect.left, rect.top, rect.right, rect.bottom, paint._objects, paint._data);
+      }
     }
   }
 
@@ -5944,7 +6056,24 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   @override
   void drawRRect(RRect rrect, Paint paint) {
     assert(_rrectIsValid(rrect));
-    _drawRRect(rrect._getValue32(), paint._objects, paint._data);
+    final int slot = _reserveBatchOp(paint, _kBatchDrawRRect, 12);
+    if (slot >= 0) {
+      final Float64List batch = _batch!;
+      batch[slot] = rrect.left;
+      batch[slot + 1] = rrect.top;
+      batch[slot + 2] = rrect.right;
+      batch[slot + 3] = rrect.bottom;
+      batch[slot + 4] = rrect.tlRadiusX;
+      batch[slot + 5] = rrect.tlRadiusY;
+      batch[slot + 6] = rrect.trRadiusX;
+      batch[slot + 7] = rrect.trRadiusY;
+      batch[slot + 8] = rrect.brRadiusX;
+      batch[slot + 9] = rrect.brRadiusY;
+      batch[slot + 10] = rrect.blRadiusX;
+      batch[slot + 11] = rrect.blRadiusY;
+    } else {
+      _drawRRect(rrect._getValue32(), paint._objects, paint._data);
+    }
   }
 
   @Native<Void Function(Pointer<Void>, Handle, Handle, Handle)>(symbol: 'Canvas::drawRRect')
@@ -5965,7 +6094,12 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
     assert(_rectIsValid(rect));
     rect = _sorted(rect);
     if (paint.style != PaintingStyle.fill || !rect.isEmpty) {
-      _drawOval(rect.left, rect.top, rect.right, rect.bottom, paint._objects, paint._data);
+      final int slot = _reserveBatchOp(paint, _kBatchDrawOval, 4);
+      if (slot >= 0) {
+        _encodeBatchRect(slot, rect);
+      } else {
+        _drawOval(rect.left, rect.top, rect.right, rect.bottom, paint._objects, paint._data);
+      }
     }
   }
 
@@ -5975,7 +6109,15 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   @override
   void drawCircle(Offset c, double radius, Paint paint) {
     assert(_offsetIsValid(c));
-    _drawCircle(c.dx, c.dy, radius, paint._objects, paint._data);
+    final int slot = _reserveBatchOp(paint, _kBatchDrawCircle, 3);
+    if (slot >= 0) {
+      final Float64List batch = _batch!;
+      batch[slot] = c.dx;
+      batch[slot + 1] = c.dy;
+      batch[slot + 2] = radius;
+    } else {
+      _drawCircle(c.dx, c.dy, radius, paint._objects, paint._data);
+    }
   }
 
   @Native<Void Function(Pointer<Void>, Double, Double, Double, Handle, Handle)>(symbol: 'Canvas::drawCircle')
@@ -5984,7 +6126,11 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   @override
   void drawArc(Rect rect, double startAngle, double sweepAngle, bool useCenter, Paint paint) {
     assert(_rectIsValid(rect));
-    _drawArc(rect.left, rect.top, rect.right, rect.bottom, startAngle, sweepAngle, useCenter, paint._objects, paint._data);
+    if (_prepareLeafPaint(paint)) {
+      _drawArcLeaf(rect.left, rect.top, rect.right, rect.bottom, startAngle, sweepAngle, useCenter);
+    } else {
+      _drawArc(rect.left, rect.top, rect.right, rect.bottom, startAngle, sweepAngle, useCenter, paint._objects, paint._data);
+    }
   }
 
   @Native<Void Function(Pointer<Void>, Double, Double, Double, Double, Double, Double, Bool, Handle, Handle)>(symbol: 'Canvas::drawArc')
@@ -5999,14 +6145,24 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
       List<Object?>? paintObjects,
       ByteData paintData);
 
+  @Native<Void Function(Pointer<Void>, Double, Double, Double, Double, Double, Double, Bool)>(symbol: 'Canvas::drawArcLeaf', isLeaf: true)
+  external void _drawArcLeaf(double left, double top, double right, double bottom, double startAngle, double sweepAngle, bool useCenter);
+
   @override
   void drawPath(Path path, Paint paint) {
-    _drawPath(path as _NativePath, paint._objects, paint._data);
+    if (_prepareLeafPaint(paint)) {
+      _drawPathLeaf(path as _NativePath);
+    } else {
+      _drawPath(path as _NativePath, paint._objects, paint._data);
+    }
   }
 
   @Native<Void Function(Pointer<Void>, Pointer<Void>, Handle, Handle)>(symbol: 'Canvas::drawPath')
   external void _drawPath(_NativePath path, List<Object?>? paintObjects, ByteData paintData);
 
+  @Native<Void Function(Pointer<Void>, Pointer<Void>)>(symbol: 'Canvas::drawPathLeaf', isLeaf: true)
+  external void _drawPathLeaf(_NativePath path);
+
   @override
   void drawImage(Image image, Offset offset, Paint paint) {
     assert(!image.debugDisposed);
@@ -6431,6 +6587,11 @@ base class _NativePictureRecorder extends NativeFieldWrapperClass1 implements Pi
     final _NativePicture picture = _NativePicture._();
     _endRecording(picture);
     _canvas!._recorder = null;
+    // The native canvas, which owns the memory of this view, may be destroyed
+    // once the recording ends.
+    _canvas!._leafPaintData = null;
+    _canvas!._batch = null;
+    _canvas!._batchWords = null;
     _canvas = null;
     // We invoke the handler here, not in the Picture constructor, because we want
     // [picture.approximateBytesUsed] to be available for the handler.
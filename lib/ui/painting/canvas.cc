@@ -4,7 +4,10 @@
 
 #include "flutter/lib/ui/painting/canvas.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <iterator>
 
 #include "flutter/display_list/dl_builder.h"
 #include "flutter/lib/ui/floating_point.h"
@@ -59,8 +62,8 @@ void Canvas::saveLayerWithoutBounds(Dart_Handle paint_objects,
 
   FML_DCHECK(paint.isNotNull());
   if (display_list_builder_) {
-    DlPaint dl_paint;
-    const DlPaint* save_paint = paint.paint(dl_paint, kSaveLayerWithPaintFlags);
+    const DlPaint* save_paint =
+        paint_cache_.paint(paint, kSaveLayerWithPaintFlags);
     FML_DCHECK(save_paint);
     TRACE_EVENT0("flutter", "ui.Canvas::saveLayer (Recorded)");
     builder()->SaveLayer(nullptr, save_paint);
@@ -79,8 +82,8 @@ void Canvas::saveLayer(double left,
   SkRect bounds = SkRect::MakeLTRB(SafeNarrow(left), SafeNarrow(top),
                                    SafeNarrow(right), SafeNarrow(bottom));
   if (display_list_builder_) {
-    DlPaint dl_paint;
-    const DlPaint* save_paint = paint.paint(dl_paint, kSaveLayerWithPaintFlags);
+    const DlPaint* save_paint =
+        paint_cache_.paint(paint, kSaveLayerWithPaintFlags);
     FML_DCHECK(save_paint);
     TRACE_EVENT0("flutter", "ui.Canvas::saveLayer (Recorded)");
     builder()->SaveLayer(&bounds, save_paint);
@@ -228,8 +231,7 @@ void Canvas::drawLine(double x1,
 
   FML_DCHECK(paint.isNotNull());
   if (display_list_builder_) {
-    DlPaint dl_paint;
-    paint.paint(dl_paint, kDrawLineFlags);
+    const DlPaint& dl_paint = cachedPaint(paint, kDrawLineFlags);
     builder()->DrawLine(SkPoint::Make(SafeNarrow(x1), SafeNarrow(y1)),
                         SkPoint::Make(SafeNarrow(x2), SafeNarrow(y2)),
                         dl_paint);
@@ -241,8 +243,7 @@ void Canvas::drawPaint(Dart_Handle paint_objects, Dart_Handle paint_data) {
 
   FML_DCHECK(paint.isNotNull());
   if (display_list_builder_) {
-    DlPaint dl_paint;
-    paint.paint(dl_paint, kDrawPaintFlags);
+    const DlPaint& dl_paint = cachedPaint(paint, kDrawPaintFlags);
     std::shared_ptr<const DlImageFilter> filter = dl_paint.getImageFilter();
     if (filter && !filter->asColorFilter()) {
       // drawPaint does an implicit saveLayer if an SkImageFilter is
@@ -263,8 +264,7 @@ void Canvas::drawRect(double left,
 
   FML_DCHECK(paint.isNotNull());
   if (display_list_builder_) {
-    DlPaint dl_paint;
-    paint.paint(dl_paint, kDrawRectFlags);
+    const DlPaint& dl_paint = cachedPaint(paint, kDrawRectFlags);
     builder()->DrawRect(SkRect::MakeLTRB(SafeNarrow(left), SafeNarrow(top),
                                          SafeNarrow(right), SafeNarrow(bottom)),
                         dl_paint);
@@ -278,8 +278,7 @@ void Canvas::drawRRect(const RRect& rrect,
 
   FML_DCHECK(paint.isNotNull());
   if (display_list_builder_) {
-    DlPaint dl_paint;
-    paint.paint(dl_paint, kDrawRRectFlags);
+    const DlPaint& dl_paint = cachedPaint(paint, kDrawRRectFlags);
     builder()->DrawRRect(rrect.sk_rrect, dl_paint);
   }
 }
@@ -292,8 +291,7 @@ void Canvas::drawDRRect(const RRect& outer,
 
   FML_DCHECK(paint.isNotNull());
   if (display_list_builder_) {
-    DlPaint dl_paint;
-    paint.paint(dl_paint, kDrawDRRectFlags);
+    const DlPaint& dl_paint = cachedPaint(paint, kDrawDRRectFlags);
     builder()->DrawDRRect(outer.sk_rrect, inner.sk_rrect, dl_paint);
   }
 }
@@ -308,8 +306,7 @@ void Canvas::drawOval(double left,
 
   FML_DCHECK(paint.isNotNull());
   if (display_list_builder_) {
-    DlPaint dl_paint;
-    paint.paint(dl_paint, kDrawOvalFlags);
+    const DlPaint& dl_paint = cachedPaint(paint, kDrawOvalFlags);
     builder()->DrawOval(SkRect::MakeLTRB(SafeNarrow(left), SafeNarrow(top),
                                          SafeNarrow(right), SafeNarrow(bottom)),
                         dl_paint);
@@ -325,8 +322,7 @@ void Canvas::drawCircle(double x,
 
   FML_DCHECK(paint.isNotNull());
   if (display_list_builder_) {
-    DlPaint dl_paint;
-    paint.paint(dl_paint, kDrawCircleFlags);
+    const DlPaint& dl_paint = cachedPaint(paint, kDrawCircleFlags);
     builder()->DrawCircle(SkPoint::Make(SafeNarrow(x), SafeNarrow(y)),
                           SafeNarrow(radius), dl_paint);
   }
@@ -345,10 +341,10 @@ void Canvas::drawArc(double left,
 
   FML_DCHECK(paint.isNotNull());
   if (display_list_builder_) {
-    DlPaint dl_paint;
-    paint.paint(dl_paint, useCenter  //
-                              ? kDrawArcWithCenterFlags
-                              : kDrawArcNoCenterFlags);
+    const DlPaint& dl_paint =
+        cachedPaint(paint, useCenter  //
+                               ? kDrawArcWithCenterFlags
+                               : kDrawArcNoCenterFlags);
     builder()->DrawArc(
         SkRect::MakeLTRB(SafeNarrow(left), SafeNarrow(top), SafeNarrow(right),
                          SafeNarrow(bottom)),
@@ -370,8 +366,7 @@ void Canvas::drawPath(const CanvasPath* path,
     return;
   }
   if (display_list_builder_) {
-    DlPaint dl_paint;
-    paint.paint(dl_paint, kDrawPathFlags);
+    const DlPaint& dl_paint = cachedPaint(paint, kDrawPathFlags);
     builder()->DrawPath(path->path(), dl_paint);
   }
 }
@@ -400,8 +395,8 @@ Dart_Handle Canvas::drawImage(const CanvasImage* image,
 
   auto sampling = ImageFilter::SamplingFromIndex(filterQualityIndex);
   if (display_list_builder_) {
-    DlPaint dl_paint;
-    const DlPaint* opt_paint = paint.paint(dl_paint, kDrawImageWithPaintFlags);
+    const DlPaint* opt_paint =
+        paint_cache_.paint(paint, kDrawImageWithPaintFlags);
     builder()->DrawImage(dl_image, SkPoint::Make(SafeNarrow(x), SafeNarrow(y)),
                          sampling, opt_paint);
   }
@@ -442,9 +437,8 @@ Dart_Handle Canvas::drawImageRect(const CanvasImage* image,
                                 SafeNarrow(dst_right), SafeNarrow(dst_bottom));
   auto sampling = ImageFilter::SamplingFromIndex(filterQualityIndex);
   if (display_list_builder_) {
-    DlPaint dl_paint;
     const DlPaint* opt_paint =
-        paint.paint(dl_paint, kDrawImageRectWithPaintFlags);
+        paint_cache_.paint(paint, kDrawImageRectWithPaintFlags);
     builder()->DrawImageRect(dl_image, src, dst, sampling, opt_paint,
                              DlCanvas::SrcRectConstraint::kFast);
   }
@@ -487,9 +481,8 @@ Dart_Handle Canvas::drawImageNine(const CanvasImage* image,
                                 SafeNarrow(dst_right), SafeNarrow(dst_bottom));
   auto filter = ImageFilter::FilterModeFromIndex(bitmapSamplingIndex);
   if (display_list_builder_) {
-    DlPaint dl_paint;
     const DlPaint* opt_paint =
-        paint.paint(dl_paint, kDrawImageNineWithPaintFlags);
+        paint_cache_.paint(paint, kDrawImageNineWithPaintFlags);
     builder()->DrawImageNine(dl_image, icenter, dst, filter, opt_paint);
   }
   return Dart_Null();
@@ -521,22 +514,22 @@ void Canvas::drawPoints(Dart_Handle paint_objects,
 
   FML_DCHECK(paint.isNotNull());
   if (display_list_builder_) {
-    DlPaint dl_paint;
+    const DlPaint* dl_paint = nullptr;
     switch (point_mode) {
       case DlCanvas::PointMode::kPoints:
-        paint.paint(dl_paint, kDrawPointsAsPointsFlags);
+        dl_paint = &cachedPaint(paint, kDrawPointsAsPointsFlags);
         break;
       case DlCanvas::PointMode::kLines:
-        paint.paint(dl_paint, kDrawPointsAsLinesFlags);
+        dl_paint = &cachedPaint(paint, kDrawPointsAsLinesFlags);
         break;
       case DlCanvas::PointMode::kPolygon:
-        paint.paint(dl_paint, kDrawPointsAsPolygonFlags);
+        dl_paint = &cachedPaint(paint, kDrawPointsAsPolygonFlags);
         break;
     }
     builder()->DrawPoints(point_mode,
                           points.num_elements() / 2,  // SkPoints have 2 floats
                           reinterpret_cast<const SkPoint*>(points.data()),
-                          dl_paint);
+                          *dl_paint);
   }
 }
 
@@ -553,8 +546,7 @@ void Canvas::drawVertices(const Vertices* vertices,
   }
   FML_DCHECK(paint.isNotNull());
   if (display_list_builder_) {
-    DlPaint dl_paint;
-    paint.paint(dl_paint, kDrawVerticesFlags);
+    const DlPaint& dl_paint = cachedPaint(paint, kDrawVerticesFlags);
     builder()->DrawVertices(vertices->vertices(), blend_mode, dl_paint);
   }
 }
@@ -596,8 +588,8 @@ Dart_Handle Canvas::drawAtlas(Dart_Handle paint_objects,
     tonic::Int32List colors(colors_handle);
     tonic::Float32List cull_rect(cull_rect_handle);
 
-    DlPaint dl_paint;
-    const DlPaint* opt_paint = paint.paint(dl_paint, kDrawAtlasWithPaintFlags);
+    const DlPaint* opt_paint =
+        paint_cache_.paint(paint, kDrawAtlasWithPaintFlags);
     builder()->DrawAtlas(
         dl_image, reinterpret_cast<const SkRSXform*>(transforms.data()),
         reinterpret_cast<const SkRect*>(rects.data()),
@@ -643,8 +635,181 @@ void Canvas::drawShadow(const CanvasPath* path,
   }
 }
 
+Dart_Handle Canvas::leafPaintData() {
+  return Dart_NewExternalTypedData(Dart_TypedData_kUint32, leaf_paint_data_,
+                                   std::size(leaf_paint_data_));
+}
+
+void Canvas::drawPaintLeaf() {
+  if (display_list_builder_) {
+    const DlPaint& dl_paint =
+        *paint_cache_.paintWithoutObjects(kDrawPaintFlags, leaf_paint_data_);
+    builder()->DrawPaint(dl_paint);
+  }
+}
+
+void Canvas::drawArcLeaf(double left,
+                         double top,
+                         double right,
+                         double bottom,
+                         double startAngle,
+                         double sweepAngle,
+                         bool useCenter) {
+  if (display_list_builder_) {
+    const DlPaint& dl_paint = *paint_cache_.paintWithoutObjects(
+        useCenter ? kDrawArcWithCenterFlags : kDrawArcNoCenterFlags,
+        leaf_paint_data_);
+    builder()->DrawArc(
+        SkRect::MakeLTRB(SafeNarrow(left), SafeNarrow(top), SafeNarrow(right),
+                         SafeNarrow(bottom)),
+        SafeNarrow(startAngle) * 180.0f / static_cast<float>(M_PI),
+        SafeNarrow(sweepAngle) * 180.0f / static_cast<float>(M_PI), useCenter,
+        dl_paint);
+  }
+}
+
+void Canvas::drawPathLeaf(const CanvasPath* path) {
+  // The path is a _NativePath on the Dart side, whose native peer is checked
+  // by the FFI before the call.
+  FML_DCHECK(path);
+  if (display_list_builder_) {
+    const DlPaint& dl_paint =
+        *paint_cache_.paintWithoutObjects(kDrawPathFlags, leaf_paint_data_);
+    builder()->DrawPath(path->path(), dl_paint);
+  }
+}
+
+Dart_Handle Canvas::batch() {
+  if (!batch_) {
+    batch_ = std::make_unique<double[]>(kBatchSlotCount);
+    reinterpret_cast<uint32_t*>(batch_.get())[0] = 1u;
+  }
+  return Dart_NewExternalTypedData(Dart_TypedData_kFloat64, batch_.get(),
+                                   kBatchSlotCount);
+}
+
+void Canvas::flushBatch() {
+  if (!batch_) {
+    return;
+  }
+  uint32_t* words = reinterpret_cast<uint32_t*>(batch_.get());
+  const size_t slot_count = std::min<size_t>(words[0], kBatchSlotCount);
+  if (slot_count <= 1u) {
+    return;
+  }
+  words[0] = 1u;
+  if (!display_list_builder_) {
+    return;
+  }
+  DisplayListBuilder* builder = display_list_builder_.get();
+  const double* slots = batch_.get();
+
+  // Returns the arguments of the op at |slot| if they are in the batch.
+  auto args = [slots, slot_count](size_t slot,
+                                  size_t arg_count) -> const double* {
+    return slot + 1 + arg_count <= slot_count ? slots + slot + 1 : nullptr;
+  };
+  auto rect = [](const double* a) {
+    return SkRect::MakeLTRB(SafeNarrow(a[0]), SafeNarrow(a[1]),
+                            SafeNarrow(a[2]), SafeNarrow(a[3]));
+  };
+  auto paint = [this](const DisplayListAttributeFlags& flags)
+      -> const DlPaint& {
+    return *batch_paint_cache_.paintWithoutObjects(flags, batch_paint_data_);
+  };
+
+  size_t slot = 1u;
+  while (slot < slot_count) {
+    switch (words[slot * 2]) {
+      case kBatchSetPaint: {
+        constexpr size_t kPaintSlotCount =
+            (sizeof(batch_paint_data_) + sizeof(double) - 1) / sizeof(double);
+        const double* paint_data = args(slot, kPaintSlotCount);
+        if (!paint_data) {
+          return;
+        }
+        memcpy(batch_paint_data_, paint_data, sizeof(batch_paint_data_));
+        slot += 1 + kPaintSlotCount;
+        break;
+      }
+      case kBatchDrawRect: {
+        const double* a = args(slot, 4);
+        if (!a) {
+          return;
+        }
+        builder->DrawRect(rect(a), paint(kDrawRectFlags));
+        slot += 1 + 4;
+        break;
+      }
+      case kBatchDrawRRect: {
+        const double* a = args(slot, 12);
+        if (!a) {
+          return;
+        }
+        // Narrowed like the Float32List of RRect._getValue32.
+        SkVector radii[4];
+        for (int i = 0; i < 4; i++) {
+          radii[i].set(static_cast<float>(a[4 + i * 2]),
+                       static_cast<float>(a[5 + i * 2]));
+        }
+        SkRect bounds = SkRect::MakeLTRB(
+            static_cast<float>(a[0]), static_cast<float>(a[1]),
+            static_cast<float>(a[2]), static_cast<float>(a[3]));
+        SkRRect rrect;
+        rrect.setRectRadii(bounds, radii);
+        builder->DrawRRect(rrect, paint(kDrawRRectFlags));
+        slot += 1 + 12;
+        break;
+      }
+      case kBatchDrawOval: {
+        const double* a = args(slot, 4);
+        if (!a) {
+          return;
+        }
+        builder->DrawOval(rect(a), paint(kDrawOvalFlags));
+        slot += 1 + 4;
+        break;
+      }
+      case kBatchDrawCircle: {
+        const double* a = args(slot, 3);
+        if (!a) {
+          return;
+        }
+        builder->DrawCircle(SkPoint::Make(SafeNarrow(a[0]), SafeNarrow(a[1])),
+                            SafeNarrow(a[2]),
+                            paint(kDrawCircleFlags));
+        slot += 1 + 3;
+        break;
+      }
+      case kBatchDrawLine: {
+        const double* a = args(slot, 4);
+        if (!a) {
+          return;
+        }
+        builder->DrawLine(SkPoint::Make(SafeNarrow(a[0]), SafeNarrow(a[1])),
+                          SkPoint::Make(SafeNarrow(a[2]), SafeNarrow(a[3])),
+                          paint(kDrawLineFlags));
+        slot += 1 + 4;
+        break;
+      }
+      default:
+        FML_DLOG(ERROR) << "Unknown canvas batch op " << words[slot * 2];
+        return;
+    }
+  }
+}
+
+const DlPaint& Canvas::cachedPaint(const Paint& paint,
+                                   const DisplayListAttributeFlags& flags) {
+  static const DlPaint kDefaultPaint;
+  const DlPaint* dl_paint = paint_cache_.paint(paint, flags);
+  return dl_paint ? *dl_paint : kDefaultPaint;
+}
+
 void Canvas::Invalidate() {
   display_list_builder_ = nullptr;
+  paint_cache_.clear();
+  batch_paint_cache_.clear();
   if (dart_wrapper()) {
     ClearDartWrapper();
   }
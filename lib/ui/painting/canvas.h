@@ -5,9 +5,12 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_CANVAS_H_
 #define FLUTTER_LIB_UI_PAINTING_CANVAS_H_
 
+#include <memory>
+
 #include "flutter/display_list/dl_blend_mode.h"
 #include "flutter/display_list/dl_op_flags.h"
 #include "flutter/lib/ui/dart_wrapper.h"
+#include "flutter/lib/ui/painting/paint.h"
 #include "flutter/lib/ui/painting/path.h"
 #include "flutter/lib/ui/painting/picture.h"
 #include "flutter/lib/ui/painting/picture_recorder.h"
@@ -184,14 +187,76 @@ class Canvas : public RefCountedDartWrappable<Canvas>, DisplayListOpFlags {
                   double elevation,
                   bool transparentOccluder);
 
+  // The following functions are leaf calls, which can't take handles. They
+  // draw with a paint whose shader, color filter and image filter are all
+  // null, and whose data Dart copies beforehand to the memory returned by
+  // leafPaintData.
+
+  Dart_Handle leafPaintData();
+
+  void drawPaintLeaf();
+
+  void drawArcLeaf(double left,
+                   double top,
+                   double right,
+                   double bottom,
+                   double startAngle,
+                   double sweepAngle,
+                   bool useCenter);
+
+  void drawPathLeaf(const CanvasPath* path);
+
+  // Dart encodes the draws of rects, rounded rects, ovals, circles and lines
+  // with paints without objects into the memory returned by batch, as a
+  // sequence of ops of 64-bit slots. The ops are decoded by flushBatch when
+  // the batch is full, and before anything else is recorded, so that they
+  // stay in order with the other calls.
+  //
+  // The first 32 bits of the first slot hold the number of slots used. The
+  // first 32 bits of the first slot of an op hold its BatchOp, and its
+  // arguments are in the following slots: the 13 words of the paint data for
+  // kBatchSetPaint, and doubles for the draws.
+  //
+  // Must be kept in sync with the batch constants in painting.dart.
+  enum BatchOp : uint32_t {
+    kBatchSetPaint,
+    kBatchDrawRect,
+    kBatchDrawRRect,
+    kBatchDrawOval,
+    kBatchDrawCircle,
+    kBatchDrawLine,
+  };
+  static constexpr size_t kBatchSlotCount = 1024;
+
+  Dart_Handle batch();
+
+  void flushBatch();
+
   void Invalidate();
 
-  DisplayListBuilder* builder() { return display_list_builder_.get(); }
+  DisplayListBuilder* builder() {
+    if (batch_) {
+      flushBatch();
+    }
+    return display_list_builder_.get();
+  }
 
  private:
   explicit Canvas(sk_sp<DisplayListBuilder> builder);
 
+  // Decodes |paint| through |paint_cache_|, or returns a default paint if it
+  // cannot be decoded.
+  const DlPaint& cachedPaint(const Paint& paint,
+                             const DisplayListAttributeFlags& flags);
+
   sk_sp<DisplayListBuilder> display_list_builder_;
+  PaintCache paint_cache_;
+  uint32_t leaf_paint_data_[Paint::kDataByteCount / sizeof(uint32_t)] = {};
+  std::unique_ptr<double[]> batch_;
+  uint32_t batch_paint_data_[Paint::kDataByteCount / sizeof(uint32_t)] = {};
+  // Separate from |paint_cache_| because |builder| flushes the batch after
+  // the paint of a draw call may have been decoded.
+  PaintCache batch_paint_cache_;
 };
 
 }  // namespace flutter
@@ -83,7 +83,7 @@ size_t DlDeferredImageGPUImpeller::GetApproximateByteSize() const {
     if (wrapper_->texture()) {
       size += wrapper_->texture()
                   ->GetTextureDescriptor()
-                  .GetByteSizeOfBaseMipLevel();
+                  .GetByteSizeOfAllLevels();
     } else {
       size += wrapper_->size().width() * wrapper_->size().height() * 4;
     }
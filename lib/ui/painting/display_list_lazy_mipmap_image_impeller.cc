@@ -0,0 +1,132 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/display_list_lazy_mipmap_image_impeller.h"
+
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/strings.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
+
+namespace flutter {
+
+sk_sp<DlLazyMipmapImageImpeller> DlLazyMipmapImageImpeller::Make(
+    std::shared_ptr<impeller::Texture> texture,
+    const std::shared_ptr<impeller::Context>& context) {
+  if (!texture || !context ||
+      !context->GetCapabilities()->SupportsTextureToTextureBlits()) {
+    return nullptr;
+  }
+  FML_DCHECK(texture->GetTextureDescriptor().mip_count == 1u);
+  return sk_sp<DlLazyMipmapImageImpeller>(
+      new DlLazyMipmapImageImpeller(std::move(texture), context));
+}
+
+DlLazyMipmapImageImpeller::DlLazyMipmapImageImpeller(
+    std::shared_ptr<impeller::Texture> texture,
+    std::weak_ptr<impeller::Context> context)
+    : context_(std::move(context)), texture_(std::move(texture)) {
+  // Images too small to be minified have no other mip levels.
+  mipmaps_resolved_ = texture_->GetTextureDescriptor().size.MipCount() <= 1u;
+}
+
+// |DlImage|
+DlLazyMipmapImageImpeller::~DlLazyMipmapImageImpeller() = default;
+
+// |DlImage|
+sk_sp<SkImage> DlLazyMipmapImageImpeller::skia_image() const {
+  return nullptr;
+}
+
+// |DlImage|
+std::shared_ptr<impeller::Texture> DlLazyMipmapImageImpeller::impeller_texture()
+    const {
+  std::scoped_lock lock(mutex_);
+  return texture_;
+}
+
+// |DlImage|
+std::shared_ptr<impeller::Texture>
+DlLazyMipmapImageImpeller::impeller_mipmapped_texture() const {
+  std::scoped_lock lock(mutex_);
+  if (mipmaps_resolved_) {
+    return texture_;
+  }
+  mipmaps_resolved_ = true;
+  auto context = context_.lock();
+  if (!context) {
+    return texture_;
+  }
+  if (auto texture = GenerateMipmaps(*context)) {
+    // Frames in flight keep their own reference to the base texture.
+    texture_ = std::move(texture);
+  } else {
+    FML_LOG(ERROR) << "Could not generate the mip levels of an image.";
+  }
+  return texture_;
+}
+
+std::shared_ptr<impeller::Texture> DlLazyMipmapImageImpeller::GenerateMipmaps(
+    impeller::Context& context) const {
+  TRACE_EVENT0("flutter", "DlLazyMipmapImageImpeller::GenerateMipmaps");
+  auto descriptor = texture_->GetTextureDescriptor();
+  descriptor.storage_mode = impeller::StorageMode::kDevicePrivate;
+  descriptor.mip_count = descriptor.size.MipCount();
+  auto texture = context.GetResourceAllocator()->CreateTexture(descriptor);
+  if (!texture) {
+    return nullptr;
+  }
+  texture->SetLabel(impeller::SPrintF("ui.Image(%p)", texture.get()).c_str());
+
+  auto command_buffer = context.CreateCommandBuffer();
+  if (!command_buffer) {
+    return nullptr;
+  }
+  command_buffer->SetLabel("Mipmap Command Buffer");
+  auto blit_pass = command_buffer->CreateBlitPass();
+  if (!blit_pass) {
+    return nullptr;
+  }
+  blit_pass->SetLabel("Mipmap Blit Pass");
+  if (!blit_pass->AddCopy(texture_, texture) ||
+      !blit_pass->GenerateMipmap(texture) ||
+      !blit_pass->EncodeCommands(context.GetResourceAllocator()) ||
+      !command_buffer->SubmitCommands()) {
+    return nullptr;
+  }
+  return texture;
+}
+
+// |DlImage|
+bool DlLazyMipmapImageImpeller::isOpaque() const {
+  // Impeller doesn't currently implement opaque alpha types.
+  return false;
+}
+
+// |DlImage|
+bool DlLazyMipmapImageImpeller::isTextureBacked() const {
+  return true;
+}
+
+// |DlImage|
+bool DlLazyMipmapImageImpeller::isUIThreadSafe() const {
+  return true;
+}
+
+// |DlImage|
+SkISize DlLazyMipmapImageImpeller::dimensions() const {
+  const auto size = impeller_texture()->GetSize();
+  return SkISize::Make(size.width, size.height);
+}
+
+// |DlImage|
+size_t DlLazyMipmapImageImpeller::GetApproximateByteSize() const {
+  return sizeof(*this) +
+         impeller_texture()->GetTextureDescriptor().GetByteSizeOfAllLevels();
+}
+
+}  // namespace flutter
@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_DISPLAY_LIST_LAZY_MIPMAP_IMAGE_IMPELLER_H_
+#define FLUTTER_LIB_UI_PAINTING_DISPLAY_LIST_LAZY_MIPMAP_IMAGE_IMPELLER_H_
+
+#include <memory>
+#include <mutex>
+
+#include "flutter/display_list/image/dl_image.h"
+#include "flutter/fml/macros.h"
+#include "impeller/core/texture.h"
+#include "impeller/renderer/context.h"
+
+namespace flutter {
+
+/// @brief  An image uploaded with only its base mip level, whose other mip
+///         levels are generated the first time it is drawn at a minifying
+///         scale with a mipmap filter.
+///
+///         Most images are never minified, so this skips the mipmap
+///         generation of most uploads and the memory of their mip levels.
+///         The mip levels are generated into a copy of the texture, which
+///         replaces the base texture from then on.
+class DlLazyMipmapImageImpeller final : public DlImage {
+ public:
+  /// @brief  Makes an image of `texture`, which must have a single mip level,
+  ///         whose mip levels are generated on `context` when needed. Returns
+  ///         null if the context cannot copy between textures.
+  static sk_sp<DlLazyMipmapImageImpeller> Make(
+      std::shared_ptr<impeller::Texture> texture,
+      const std::shared_ptr<impeller::Context>& context);
+
+  // |DlImage|
+  ~DlLazyMipmapImageImpeller() override;
+
+  // |DlImage|
+  sk_sp<SkImage> skia_image() const override;
+
+  // |DlImage|
+  std::shared_ptr<impeller::Texture> impeller_texture() const override;
+
+  // |DlImage|
+  std::shared_ptr<impeller::Texture> impeller_mipmapped_texture()
+      const override;
+
+  // |DlImage|
+  bool isOpaque() const override;
+
+  // |DlImage|
+  bool isTextureBacked() const override;
+
+  // |DlImage|
+  bool isUIThreadSafe() const override;
+
+  // |DlImage|
+  SkISize dimensions() const override;
+
+  // |DlImage|
+  size_t GetApproximateByteSize() const override;
+
+ private:
+  const std::weak_ptr<impeller::Context> context_;
+  mutable std::mutex mutex_;
+  // Replaced by the texture with all its mip levels once they are generated.
+  mutable std::shared_ptr<impeller::Texture> texture_;
+  // Whether the mip levels were generated, or could not be, in which case the
+  // base texture is sampled at every scale.
+  mutable bool mipmaps_resolved_ = false;
+
+  DlLazyMipmapImageImpeller(std::shared_ptr<impeller::Texture> texture,
+                            std::weak_ptr<impeller::Context> context);
+
+  // Generates the mip levels into a copy of the texture, or returns null.
+  std::shared_ptr<impeller::Texture> GenerateMipmaps(
+      impeller::Context& context) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlLazyMipmapImageImpeller);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_DISPLAY_LIST_LAZY_MIPMAP_IMAGE_IMPELLER_H_
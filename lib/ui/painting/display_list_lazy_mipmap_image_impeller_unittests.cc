@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#if IMPELLER_SUPPORTS_RENDERING
+
+#include "flutter/lib/ui/painting/display_list_lazy_mipmap_image_impeller.h"
+
+#include "flutter/testing/testing.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "impeller/renderer/testing/mocks.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+using ::impeller::testing::MockAllocator;
+using ::impeller::testing::MockBlitPass;
+using ::impeller::testing::MockCapabilities;
+using ::impeller::testing::MockCommandBuffer;
+using ::impeller::testing::MockImpellerContext;
+using ::impeller::testing::MockTexture;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::ReturnRef;
+
+std::shared_ptr<MockTexture> MakeTexture(
+    const impeller::TextureDescriptor& desc) {
+  auto texture = std::make_shared<MockTexture>(desc);
+  ON_CALL(*texture, GetSize()).WillByDefault(Return(desc.size));
+  return texture;
+}
+
+impeller::TextureDescriptor MakeBaseLevelDescriptor() {
+  impeller::TextureDescriptor desc;
+  desc.size = {64, 32};
+  desc.format = impeller::PixelFormat::kR8G8B8A8UNormInt;
+  desc.mip_count = 1u;
+  return desc;
+}
+
+class DlLazyMipmapImageImpellerTest : public ::testing::Test {
+ public:
+  DlLazyMipmapImageImpellerTest()
+      : context_(std::make_shared<MockImpellerContext>()),
+        allocator_(std::make_shared<MockAllocator>()) {
+    auto capabilities = std::make_shared<MockCapabilities>();
+    ON_CALL(*capabilities, SupportsTextureToTextureBlits())
+        .WillByDefault(Return(true));
+    capabilities_ = capabilities;
+    ON_CALL(*context_, GetCapabilities())
+        .WillByDefault(ReturnRef(capabilities_));
+    ON_CALL(*context_, GetResourceAllocator())
+        .WillByDefault(Return(allocator_));
+    ON_CALL(*allocator_, GetMaxTextureSizeSupported())
+        .WillByDefault(Return(impeller::ISize(1024, 1024)));
+  }
+
+ protected:
+  std::shared_ptr<MockImpellerContext> context_;
+  std::shared_ptr<MockAllocator> allocator_;
+  std::shared_ptr<const impeller::Capabilities> capabilities_;
+};
+
+}  // namespace
+
+TEST_F(DlLazyMipmapImageImpellerTest, GeneratesMipmapsOnFirstMinifiedDraw) {
+  auto base_texture = MakeTexture(MakeBaseLevelDescriptor());
+  auto image = DlLazyMipmapImageImpeller::Make(base_texture, context_);
+  ASSERT_TRUE(image);
+  EXPECT_EQ(image->impeller_texture(), base_texture);
+  EXPECT_EQ(image->dimensions(), SkISize::Make(64, 32));
+
+  std::shared_ptr<MockTexture> mipmapped_texture;
+  EXPECT_CALL(*allocator_, OnCreateTexture(_))
+      .WillOnce(Invoke([&](const impeller::TextureDescriptor& desc) {
+        mipmapped_texture = MakeTexture(desc);
+        return mipmapped_texture;
+      }));
+  auto command_buffer = std::make_shared<MockCommandBuffer>(context_);
+  auto blit_pass = std::make_shared<MockBlitPass>();
+  EXPECT_CALL(*context_, CreateCommandBuffer())
+      .WillOnce(Return(command_buffer));
+  EXPECT_CALL(*command_buffer, IsValid()).WillRepeatedly(Return(true));
+  EXPECT_CALL(*command_buffer, OnCreateBlitPass()).WillOnce(Return(blit_pass));
+  EXPECT_CALL(*command_buffer, OnSubmitCommands(_)).WillOnce(Return(true));
+  EXPECT_CALL(*blit_pass, IsValid()).WillRepeatedly(Return(true));
+  EXPECT_CALL(*blit_pass, OnCopyTextureToTextureCommand(_, _, _, _, _))
+      .WillOnce(Return(true));
+  EXPECT_CALL(*blit_pass, OnGenerateMipmapCommand(_, _))
+      .WillOnce(Return(true));
+  EXPECT_CALL(*blit_pass, EncodeCommands(_)).WillOnce(Return(true));
+
+  auto texture = image->impeller_mipmapped_texture();
+  ASSERT_TRUE(mipmapped_texture);
+  EXPECT_EQ(texture, mipmapped_texture);
+  EXPECT_EQ(texture->GetTextureDescriptor().mip_count, 6u);
+
+  // The mipmapped texture replaces the base texture, and is only generated
+  // once.
+  EXPECT_EQ(image->impeller_texture(), mipmapped_texture);
+  EXPECT_EQ(image->impeller_mipmapped_texture(), mipmapped_texture);
+}
+
+TEST_F(DlLazyMipmapImageImpellerTest, KeepsBaseTextureWhenGenerationFails) {
+  auto base_texture = MakeTexture(MakeBaseLevelDescriptor());
+  auto image = DlLazyMipmapImageImpeller::Make(base_texture, context_);
+  ASSERT_TRUE(image);
+
+  EXPECT_CALL(*allocator_, OnCreateTexture(_)).WillOnce(Return(nullptr));
+  EXPECT_EQ(image->impeller_mipmapped_texture(), base_texture);
+  // The generation is not attempted again.
+  EXPECT_EQ(image->impeller_mipmapped_texture(), base_texture);
+}
+
+TEST_F(DlLazyMipmapImageImpellerTest, RequiresTextureToTextureBlits) {
+  auto capabilities = std::make_shared<MockCapabilities>();
+  EXPECT_CALL(*capabilities, SupportsTextureToTextureBlits())
+      .WillRepeatedly(Return(false));
+  capabilities_ = capabilities;
+  EXPECT_FALSE(DlLazyMipmapImageImpeller::Make(
+      MakeTexture(MakeBaseLevelDescriptor()), context_));
+}
+
+}  // namespace testing
+}  // namespace flutter
+
+#endif  // IMPELLER_SUPPORTS_RENDERING
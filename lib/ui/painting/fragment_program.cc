@@ -53,17 +53,18 @@ std::string FragmentProgram::initFromAsset(const std::string& asset_name) {
     return std::string("Asset '") + asset_name + std::string("' not found");
   }
 
-  auto runtime_stages =
-      impeller::RuntimeStage::DecodeRuntimeStages(std::move(data));
-
-  if (runtime_stages.empty()) {
-    return std::string("Asset '") + asset_name +
-           std::string("' does not contain any shader data.");
-  }
-
+  // Only the stage of the current backend is decoded. The shader code is
+  // not copied out of the asset mapping.
+  std::shared_ptr<fml::Mapping> payload = std::move(data);
   auto backend = UIDartState::Current()->GetRuntimeStageBackend();
-  auto runtime_stage = runtime_stages[backend];
+  auto runtime_stage =
+      impeller::RuntimeStage::DecodeRuntimeStage(payload, backend);
   if (!runtime_stage) {
+    auto runtime_stages = impeller::RuntimeStage::DecodeRuntimeStages(payload);
+    if (runtime_stages.empty()) {
+      return std::string("Asset '") + asset_name +
+             std::string("' does not contain any shader data.");
+    }
     std::ostringstream stream;
     stream << "Asset '" << asset_name
            << "' does not contain appropriate runtime stage data for current "
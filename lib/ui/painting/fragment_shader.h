@@ -43,6 +43,9 @@ class ReusableFragmentShader : public Shader {
   // |Shader|
   std::shared_ptr<DlColorSource> shader(DlImageSampling) override;
 
+  // |Shader|
+  bool is_immutable() const override { return false; }
+
  private:
   ReusableFragmentShader(fml::RefPtr<FragmentProgram> program,
                          uint64_t float_count,
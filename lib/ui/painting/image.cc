@@ -39,6 +39,14 @@ Dart_Handle CanvasImage::toByteData(int format, Dart_Handle callback) {
   return EncodeImage(this, format, callback);
 }
 
+size_t CanvasImage::GetAllocationSize() const {
+  auto size = sizeof(CanvasImage);
+  if (image_) {
+    size += image_->GetApproximateByteSize();
+  }
+  return size;
+}
+
 void CanvasImage::dispose() {
   image_.reset();
   ClearDartWrapper();
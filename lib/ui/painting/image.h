@@ -44,8 +44,12 @@ class CanvasImage final : public RefCountedDartWrappable<CanvasImage> {
   void set_image(const sk_sp<DlImage>& image) {
     FML_DCHECK(image->isUIThreadSafe());
     image_ = image;
+    UpdateAllocationSize();
   }
 
+  // |DartWrappable|
+  size_t GetAllocationSize() const override;
+
   int colorSpace();
 
  private:
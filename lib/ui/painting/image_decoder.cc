@@ -18,21 +18,36 @@ std::unique_ptr<ImageDecoder> ImageDecoder::Make(
     std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
     fml::WeakPtr<IOManager> io_manager,
     const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch) {
+  std::unique_ptr<ImageDecoder> decoder;
 #if IMPELLER_SUPPORTS_RENDERING
   if (settings.enable_impeller) {
-    return std::make_unique<ImageDecoderImpeller>(
+    std::shared_ptr<ImageTextureCacheImpeller> texture_cache;
+    if (settings.enable_image_texture_purging) {
+      texture_cache = std::make_shared<ImageTextureCacheImpeller>(
+          settings.image_texture_cache_max_bytes);
+    }
+    decoder = std::make_unique<ImageDecoderImpeller>(
         runners,                            //
         std::move(concurrent_task_runner),  //
         std::move(io_manager),              //
         settings.enable_wide_gamut,         //
-        gpu_disabled_switch);
+        gpu_disabled_switch,                //
+        std::move(texture_cache),           //
+        settings.enable_lazy_image_mipmaps);
   }
 #endif  // IMPELLER_SUPPORTS_RENDERING
-  return std::make_unique<ImageDecoderSkia>(
-      runners,                            //
-      std::move(concurrent_task_runner),  //
-      std::move(io_manager)               //
-  );
+  if (!decoder) {
+    decoder = std::make_unique<ImageDecoderSkia>(
+        runners,                            //
+        std::move(concurrent_task_runner),  //
+        std::move(io_manager)               //
+    );
+  }
+  decoder->animated_image_frame_lookahead_ =
+      settings.animated_image_frame_lookahead;
+  decoder->animated_image_lookahead_max_bytes_ =
+      settings.animated_image_lookahead_max_bytes;
+  return decoder;
 }
 
 ImageDecoder::ImageDecoder(
@@ -54,4 +69,12 @@ fml::WeakPtr<ImageDecoder> ImageDecoder::GetWeakPtr() const {
   return weak_factory_.GetWeakPtr();
 }
 
+size_t ImageDecoder::GetAnimatedImageFrameLookahead() const {
+  return animated_image_frame_lookahead_;
+}
+
+size_t ImageDecoder::GetAnimatedImageLookaheadMaxBytes() const {
+  return animated_image_lookahead_max_bytes_;
+}
+
 }  // namespace flutter
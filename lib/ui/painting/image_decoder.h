@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_H_
 
+#include <functional>
 #include <memory>
 
 #include "flutter/common/settings.h"
@@ -44,8 +45,28 @@ class ImageDecoder {
                       uint32_t target_height,
                       const ImageResult& result) = 0;
 
+  // Releases the memory held by the decoded images that can be recreated,
+  // such as the textures of images that are not drawn. Called on the UI thread
+  // when the system is low on memory.
+  virtual void NotifyLowMemoryWarning() {}
+
+  // Returns a function reporting the bytes of the textures of decoded images
+  // that can be purged, or null if they aren't tracked. The function may be
+  // called on any thread, and after this decoder is destroyed.
+  virtual std::function<size_t()> GetPurgeableTextureBytesCallback() const {
+    return nullptr;
+  }
+
   fml::WeakPtr<ImageDecoder> GetWeakPtr() const;
 
+  // The number of frames the codecs of animated images decode ahead, see
+  // |Settings::animated_image_frame_lookahead|.
+  size_t GetAnimatedImageFrameLookahead() const;
+
+  // The memory budget of the frames each codec of an animated image decodes
+  // ahead, see |Settings::animated_image_lookahead_max_bytes|.
+  size_t GetAnimatedImageLookaheadMaxBytes() const;
+
  protected:
   TaskRunners runners_;
   std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
@@ -57,6 +78,8 @@ class ImageDecoder {
       fml::WeakPtr<IOManager> io_manager);
 
  private:
+  size_t animated_image_frame_lookahead_ = 0;
+  size_t animated_image_lookahead_max_bytes_ = 0;
   fml::WeakPtrFactory<ImageDecoder> weak_factory_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ImageDecoder);
@@ -8,12 +8,14 @@
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/memory/allocation_tag.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/impeller/core/allocator.h"
 #include "flutter/impeller/core/texture.h"
 #include "flutter/impeller/display_list/dl_image_impeller.h"
 #include "flutter/impeller/renderer/command_buffer.h"
 #include "flutter/impeller/renderer/context.h"
+#include "flutter/lib/ui/painting/display_list_lazy_mipmap_image_impeller.h"
 #include "flutter/lib/ui/painting/image_decoder_skia.h"
 #include "impeller/base/strings.h"
 #include "impeller/display_list/skia_conversions.h"
@@ -117,10 +119,14 @@ ImageDecoderImpeller::ImageDecoderImpeller(
     std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
     const fml::WeakPtr<IOManager>& io_manager,
     bool supports_wide_gamut,
-    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch)
+    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch,
+    std::shared_ptr<ImageTextureCacheImpeller> texture_cache,
+    bool lazy_mipmaps)
     : ImageDecoder(runners, std::move(concurrent_task_runner), io_manager),
       supports_wide_gamut_(supports_wide_gamut),
-      gpu_disabled_switch_(gpu_disabled_switch) {
+      gpu_disabled_switch_(gpu_disabled_switch),
+      texture_cache_(std::move(texture_cache)),
+      lazy_mipmaps_(lazy_mipmaps) {
   std::promise<std::shared_ptr<impeller::Context>> context_promise;
   context_ = context_promise.get_future();
   runners_.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
@@ -288,7 +294,8 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
 static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadTextureToPrivate(
     const std::shared_ptr<impeller::Context>& context,
     const std::shared_ptr<impeller::DeviceBuffer>& buffer,
-    const SkImageInfo& image_info) {
+    const SkImageInfo& image_info,
+    bool create_mips) {
   const auto pixel_format =
       impeller::skia_conversions::ToPixelFormat(image_info.colorType());
   if (!pixel_format) {
@@ -302,7 +309,8 @@ static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadTextureToPrivate(
   texture_descriptor.storage_mode = impeller::StorageMode::kDevicePrivate;
   texture_descriptor.format = pixel_format.value();
   texture_descriptor.size = {image_info.width(), image_info.height()};
-  texture_descriptor.mip_count = texture_descriptor.size.MipCount();
+  texture_descriptor.mip_count =
+      create_mips ? texture_descriptor.size.MipCount() : 1;
   texture_descriptor.compression_type = impeller::CompressionType::kLossy;
 
   auto dest_texture =
@@ -316,6 +324,14 @@ static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadTextureToPrivate(
   dest_texture->SetLabel(
       impeller::SPrintF("ui.Image(%p)", dest_texture.get()).c_str());
 
+  // Backends with a dedicated transfer queue upload the texture there, so
+  // that uploads don't contend with rendering.
+  if (context->EnqueueTextureUpload(buffer, dest_texture)) {
+    return std::make_pair(
+        impeller::DlImageImpeller::Make(std::move(dest_texture)),
+        std::string());
+  }
+
   auto command_buffer = context->CreateCommandBuffer();
   if (!command_buffer) {
     std::string decode_error(
@@ -335,7 +351,7 @@ static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadTextureToPrivate(
   blit_pass->SetLabel("Mipmap Blit Pass");
   blit_pass->AddCopy(impeller::DeviceBuffer::AsBufferView(buffer),
                      dest_texture);
-  if (texture_descriptor.size.MipCount() > 1) {
+  if (texture_descriptor.mip_count > 1) {
     blit_pass->GenerateMipmap(dest_texture);
   }
 
@@ -356,7 +372,8 @@ ImageDecoderImpeller::UploadTextureToPrivate(
     const std::shared_ptr<impeller::DeviceBuffer>& buffer,
     const SkImageInfo& image_info,
     const std::shared_ptr<SkBitmap>& bitmap,
-    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch) {
+    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch,
+    bool create_mips) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   if (!context) {
     return std::make_pair(nullptr, "No Impeller context is available");
@@ -368,8 +385,9 @@ ImageDecoderImpeller::UploadTextureToPrivate(
   std::pair<sk_sp<DlImage>, std::string> result;
   gpu_disabled_switch->Execute(
       fml::SyncSwitch::Handlers()
-          .SetIfFalse([&result, context, buffer, image_info] {
-            result = UnsafeUploadTextureToPrivate(context, buffer, image_info);
+          .SetIfFalse([&result, context, buffer, image_info, create_mips] {
+            result = UnsafeUploadTextureToPrivate(context, buffer, image_info,
+                                                  create_mips);
           })
           .SetIfTrue([&result, context, bitmap, gpu_disabled_switch] {
             // create_mips is false because we already know the GPU is disabled.
@@ -475,6 +493,101 @@ ImageDecoderImpeller::UploadTextureToStorage(
                         std::string());
 }
 
+// Decodes the image straight into a texture if its generator is backed by a
+// hardware decoder, skipping both the CPU bitmap and the upload.
+static std::shared_ptr<impeller::Texture> DecodeToTexture(
+    ImageDescriptor* descriptor,
+    SkISize target_size,
+    impeller::ISize max_texture_size,
+    bool supports_wide_gamut,
+    const std::shared_ptr<impeller::Context>& context,
+    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch) {
+  // Wide gamut images are left to the CPU path, which picks the extended pixel
+  // formats.
+  if (!descriptor->is_compressed() ||
+      (supports_wide_gamut &&
+       IsWideGamut(descriptor->image_info().colorSpace()))) {
+    return nullptr;
+  }
+  const SkISize texture_size = SkISize::Make(
+      std::min(static_cast<int32_t>(max_texture_size.width),
+               target_size.width()),
+      std::min(static_cast<int32_t>(max_texture_size.height),
+               target_size.height()));
+  std::shared_ptr<impeller::Texture> texture;
+  gpu_disabled_switch->Execute(fml::SyncSwitch::Handlers().SetIfFalse(
+      [&texture, descriptor, context, texture_size] {
+        texture = descriptor->decode_to_texture(context, texture_size);
+      }));
+  return texture;
+}
+
+static std::pair<sk_sp<DlImage>, std::string> UploadTexture(
+    const std::shared_ptr<impeller::Context>& context,
+    const DecompressResult& bitmap_result,
+    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch,
+    bool lazy_mipmaps = false) {
+  const bool create_mips =
+      !lazy_mipmaps ||
+      !context->GetCapabilities()->SupportsTextureToTextureBlits();
+  std::pair<sk_sp<DlImage>, std::string> result;
+  if (!kShouldUseMallocDeviceBuffer &&
+      context->GetCapabilities()->SupportsBufferToTextureBlits()) {
+    result = ImageDecoderImpeller::UploadTextureToPrivate(
+        context, bitmap_result.device_buffer, bitmap_result.image_info,
+        bitmap_result.sk_bitmap, gpu_disabled_switch, create_mips);
+  } else {
+    result = ImageDecoderImpeller::UploadTextureToStorage(
+        context, bitmap_result.sk_bitmap, gpu_disabled_switch,
+        impeller::StorageMode::kDevicePrivate, create_mips);
+  }
+  // The other mip levels are generated the first time the image is minified.
+  if (!create_mips && result.first) {
+    auto texture = result.first->impeller_texture();
+    if (texture && texture->GetTextureDescriptor().mip_count == 1u) {
+      result.first =
+          DlLazyMipmapImageImpeller::Make(std::move(texture), context);
+    }
+  }
+  return result;
+}
+
+// Makes a loader that decodes the texture of an image again after it was
+// purged from the texture cache. The loader runs synchronously on the thread
+// that draws the image.
+static ImageTextureCacheImpeller::TextureLoader MakeTextureLoader(
+    fml::RefPtr<ImageDescriptor> descriptor,
+    SkISize target_size,
+    const std::shared_ptr<impeller::Context>& context,
+    bool supports_wide_gamut,
+    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch) {
+  return [descriptor = std::move(descriptor), target_size,
+          weak_context = std::weak_ptr<impeller::Context>(context),
+          supports_wide_gamut,
+          gpu_disabled_switch]() -> std::shared_ptr<impeller::Texture> {
+    auto context = weak_context.lock();
+    if (!context) {
+      return nullptr;
+    }
+    auto max_size_supported =
+        context->GetResourceAllocator()->GetMaxTextureSizeSupported();
+    if (auto texture = DecodeToTexture(descriptor.get(), target_size,
+                                       max_size_supported, supports_wide_gamut,
+                                       context, gpu_disabled_switch)) {
+      return texture;
+    }
+    auto bitmap_result = ImageDecoderImpeller::DecompressTexture(
+        descriptor.get(), target_size, max_size_supported, supports_wide_gamut,
+        context->GetResourceAllocator());
+    if (!bitmap_result.device_buffer) {
+      return nullptr;
+    }
+    auto image =
+        UploadTexture(context, bitmap_result, gpu_disabled_switch).first;
+    return image ? image->impeller_texture() : nullptr;
+  };
+}
+
 // |ImageDecoder|
 void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
                                   uint32_t target_width,
@@ -483,6 +596,8 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
   FML_DCHECK(descriptor);
   FML_DCHECK(p_result);
 
+  const auto target_size = SkISize::Make(target_width, target_height);
+
   // Wrap the result callback so that it can be invoked from any thread.
   auto raw_descriptor = descriptor.get();
   raw_descriptor->AddRef();
@@ -496,14 +611,36 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
     });
   };
 
+  // The textures of the images in the cache may be purged, and are then
+  // decoded again from a copy of the descriptor, since the descriptor itself
+  // may be disposed from Dart by then.
+  if (texture_cache_ && context_.get() && raw_descriptor->data()) {
+    result = [result, texture_cache = texture_cache_,
+              loader = MakeTextureLoader(
+                  raw_descriptor->Clone(), target_size, context_.get(),
+                  supports_wide_gamut_, gpu_disabled_switch_)](
+                 sk_sp<DlImage> image, std::string decode_error) {
+      if (image && image->impeller_texture()) {
+        image = texture_cache->MakeImage(image->impeller_texture(), loader);
+      }
+      result(std::move(image), std::move(decode_error));
+    };
+  }
+
+  // Images whose textures may be purged are reloaded with all their mip
+  // levels, so they generate them eagerly.
+  const bool lazy_mipmaps = lazy_mipmaps_ && !texture_cache_;
+
   concurrent_task_runner_->PostTask(
-      [raw_descriptor,                                            //
-       context = context_.get(),                                  //
-       target_size = SkISize::Make(target_width, target_height),  //
-       io_runner = runners_.GetIOTaskRunner(),                    //
+      [raw_descriptor,                          //
+       context = context_.get(),                //
+       target_size,                             //
+       io_runner = runners_.GetIOTaskRunner(),  //
        result,
        supports_wide_gamut = supports_wide_gamut_,  //
-       gpu_disabled_switch = gpu_disabled_switch_]() {
+       gpu_disabled_switch = gpu_disabled_switch_,  //
+       lazy_mipmaps]() {
+        FML_ALLOCATION_TAG(kCodecs);
         if (!context) {
           result(nullptr, "No Impeller context is available");
           return;
@@ -511,7 +648,15 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
         auto max_size_supported =
             context->GetResourceAllocator()->GetMaxTextureSizeSupported();
 
-        // Always decompress on the concurrent runner.
+        if (auto texture = DecodeToTexture(
+                raw_descriptor, target_size, max_size_supported,
+                supports_wide_gamut, context, gpu_disabled_switch)) {
+          result(impeller::DlImageImpeller::Make(std::move(texture)),
+                 std::string());
+          return;
+        }
+
+        // Otherwise, decompress on the concurrent runner.
         auto bitmap_result = DecompressTexture(
             raw_descriptor, target_size, max_size_supported,
             supports_wide_gamut, context->GetResourceAllocator());
@@ -520,32 +665,38 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
           return;
         }
         auto upload_texture_and_invoke_result = [result, context, bitmap_result,
-                                                 gpu_disabled_switch]() {
-          sk_sp<DlImage> image;
-          std::string decode_error;
-          if (!kShouldUseMallocDeviceBuffer &&
-              context->GetCapabilities()->SupportsBufferToTextureBlits()) {
-            std::tie(image, decode_error) = UploadTextureToPrivate(
-                context, bitmap_result.device_buffer, bitmap_result.image_info,
-                bitmap_result.sk_bitmap, gpu_disabled_switch);
-            result(image, decode_error);
-          } else {
-            std::tie(image, decode_error) = UploadTextureToStorage(
-                context, bitmap_result.sk_bitmap, gpu_disabled_switch,
-                impeller::StorageMode::kDevicePrivate,
-                /*create_mips=*/true);
-            result(image, decode_error);
-          }
+                                                 gpu_disabled_switch,
+                                                 lazy_mipmaps]() {
+          auto [image, decode_error] = UploadTexture(
+              context, bitmap_result, gpu_disabled_switch, lazy_mipmaps);
+          result(image, decode_error);
         };
         // TODO(jonahwilliams):
         // https://github.com/flutter/flutter/issues/123058 Technically we
         // don't need to post tasks to the io runner, but without this
         // forced serialization we can end up overloading the GPU and/or
         // competing with raster workloads.
-        io_runner->PostTask(upload_texture_and_invoke_result);
+        io_runner->PostTaskWithGrade(upload_texture_and_invoke_result,
+                                     fml::TaskSourceGrade::kUserInteraction);
       });
 }
 
+void ImageDecoderImpeller::NotifyLowMemoryWarning() {
+  if (texture_cache_) {
+    texture_cache_->PurgeUnusedTextures();
+  }
+}
+
+std::function<size_t()> ImageDecoderImpeller::GetPurgeableTextureBytesCallback()
+    const {
+  if (!texture_cache_) {
+    return nullptr;
+  }
+  return [texture_cache = texture_cache_]() {
+    return texture_cache->GetResidentBytes();
+  };
+}
+
 ImpellerAllocator::ImpellerAllocator(
     std::shared_ptr<impeller::Allocator> allocator)
     : allocator_(std::move(allocator)) {}
@@ -9,6 +9,7 @@
 
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/painting/image_decoder.h"
+#include "flutter/lib/ui/painting/image_texture_cache_impeller.h"
 #include "impeller/core/formats.h"
 #include "impeller/geometry/size.h"
 #include "third_party/skia/include/core/SkBitmap.h"
@@ -51,7 +52,9 @@ class ImageDecoderImpeller final : public ImageDecoder {
       std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
       const fml::WeakPtr<IOManager>& io_manager,
       bool supports_wide_gamut,
-      const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch);
+      const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch,
+      std::shared_ptr<ImageTextureCacheImpeller> texture_cache = nullptr,
+      bool lazy_mipmaps = false);
 
   ~ImageDecoderImpeller() override;
 
@@ -61,6 +64,12 @@ class ImageDecoderImpeller final : public ImageDecoder {
               uint32_t target_height,
               const ImageResult& result) override;
 
+  // |ImageDecoder|
+  void NotifyLowMemoryWarning() override;
+
+  // |ImageDecoder|
+  std::function<size_t()> GetPurgeableTextureBytesCallback() const override;
+
   static DecompressResult DecompressTexture(
       ImageDescriptor* descriptor,
       SkISize target_size,
@@ -75,13 +84,16 @@ class ImageDecoderImpeller final : public ImageDecoder {
   /// @param image_info Format information about the particular image.
   /// @param bitmap      A bitmap containg the image to be uploaded.
   /// @param gpu_disabled_switch Whether the GPU is available command encoding.
+  /// @param create_mips Whether mipmaps should be generated for the given
+  /// image.
   /// @return           A DlImage.
   static std::pair<sk_sp<DlImage>, std::string> UploadTextureToPrivate(
       const std::shared_ptr<impeller::Context>& context,
       const std::shared_ptr<impeller::DeviceBuffer>& buffer,
       const SkImageInfo& image_info,
       const std::shared_ptr<SkBitmap>& bitmap,
-      const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch);
+      const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch,
+      bool create_mips = true);
 
   /// @brief Create a host visible texture from the provided bitmap.
   /// @param context     The Impeller graphics context.
@@ -103,6 +115,11 @@ class ImageDecoderImpeller final : public ImageDecoder {
   FutureContext context_;
   const bool supports_wide_gamut_;
   std::shared_ptr<fml::SyncSwitch> gpu_disabled_switch_;
+  // Null unless the textures of the decoded images may be purged.
+  const std::shared_ptr<ImageTextureCacheImpeller> texture_cache_;
+  // Whether the mip levels of the decoded images are only generated the first
+  // time they are drawn at a minifying scale.
+  const bool lazy_mipmaps_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ImageDecoderImpeller);
 };
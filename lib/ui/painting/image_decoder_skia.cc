@@ -8,6 +8,7 @@
 
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/memory/allocation_tag.h"
 #include "flutter/lib/ui/painting/display_list_image_gpu.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImage.h"
@@ -161,7 +162,9 @@ sk_sp<SkImage> ImageDecoderSkia::ImageFromCompressedData(
 
 static SkiaGPUObject<SkImage> UploadRasterImage(
     sk_sp<SkImage> image,
-    const fml::WeakPtr<IOManager>& io_manager,
+    GrDirectContext* context,
+    const fml::RefPtr<SkiaUnrefQueue>& queue,
+    const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch,
     const fml::tracing::TraceFlow& flow) {
   TRACE_EVENT0("flutter", __FUNCTION__);
   flow.Step(__FUNCTION__);
@@ -170,7 +173,7 @@ static SkiaGPUObject<SkImage> UploadRasterImage(
   // the this method.
   FML_DCHECK(!image->isTextureBacked());
 
-  if (!io_manager->GetResourceContext() || !io_manager->GetSkiaUnrefQueue()) {
+  if (!context || !queue) {
     FML_LOG(ERROR)
         << "Could not acquire context of release queue for texture upload.";
     return {};
@@ -183,7 +186,7 @@ static SkiaGPUObject<SkImage> UploadRasterImage(
   }
 
   SkiaGPUObject<SkImage> result;
-  io_manager->GetIsGpuDisabledSyncSwitch()->Execute(
+  is_gpu_disabled_sync_switch->Execute(
       fml::SyncSwitch::Handlers()
           .SetIfTrue([&result, &pixmap, &image] {
             SkSafeRef(image.get());
@@ -195,15 +198,16 @@ static SkiaGPUObject<SkImage> UploadRasterImage(
                 image.get());
             result = {std::move(texture_image), nullptr};
           })
-          .SetIfFalse([&result, context = io_manager->GetResourceContext(),
-                       &pixmap, queue = io_manager->GetSkiaUnrefQueue()] {
+          .SetIfFalse([&result, context, &pixmap, &queue] {
             TRACE_EVENT0("flutter", "MakeCrossContextImageFromPixmap");
+            // The image carries a fence that the raster context waits on, so
+            // it may be uploaded with any context in the share group.
             sk_sp<SkImage> texture_image =
                 SkImages::CrossContextTextureFromPixmap(
-                    context.get(),  // context
-                    pixmap,         // pixmap
-                    true,           // buildMips,
-                    true            // limitToMaxTextureSize
+                    context,  // context
+                    pixmap,   // pixmap
+                    true,     // buildMips,
+                    true      // limitToMaxTextureSize
                 );
             if (!texture_image) {
               FML_LOG(ERROR) << "Could not make x-context image.";
@@ -273,6 +277,7 @@ void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
                          target_height = target_height,           //
                          flow = std::move(flow)                   //
   ]() mutable {
+        FML_ALLOCATION_TAG(kCodecs);
         // Step 1: Decompress the image.
         // On Worker.
 
@@ -295,36 +300,53 @@ void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
         // Step 2: Update the image to the GPU.
         // On IO Thread.
 
-        io_runner->PostTask(fml::MakeCopyable([io_manager, decompressed, result,
-                                               flow =
-                                                   std::move(flow)]() mutable {
-          if (!io_manager) {
-            FML_DLOG(ERROR) << "Could not acquire IO manager.";
-            result({}, std::move(flow));
-            return;
-          }
-
-          // If the IO manager does not have a resource context, the caller
-          // might not have set one or a software backend could be in use.
-          // Either way, just return the image as-is.
-          if (!io_manager->GetResourceContext()) {
-            result({std::move(decompressed), io_manager->GetSkiaUnrefQueue()},
-                   std::move(flow));
-            return;
-          }
-
-          auto uploaded =
-              UploadRasterImage(std::move(decompressed), io_manager, flow);
-
-          if (!uploaded.skia_object()) {
-            FML_DLOG(ERROR) << "Could not upload image to the GPU.";
-            result({}, std::move(flow));
-            return;
-          }
-
-          // Finally, all done.
-          result(std::move(uploaded), std::move(flow));
-        }));
+        io_runner->PostTaskWithGrade(
+            fml::MakeCopyable([io_manager, decompressed, result,
+                               flow = std::move(flow)]() mutable {
+              if (!io_manager) {
+                FML_DLOG(ERROR) << "Could not acquire IO manager.";
+                result({}, std::move(flow));
+                return;
+              }
+
+              // If the IO manager does not have a resource context, the caller
+              // might not have set one or a software backend could be in use.
+              // Either way, just return the image as-is.
+              if (!io_manager->GetResourceContext()) {
+                result({std::move(decompressed),
+                        io_manager->GetSkiaUnrefQueue()},
+                       std::move(flow));
+                return;
+              }
+
+              auto upload = fml::MakeCopyable(
+                  [decompressed, result, flow = std::move(flow),
+                   sync_switch = io_manager->GetIsGpuDisabledSyncSwitch()](
+                      GrDirectContext* context,
+                      const fml::RefPtr<SkiaUnrefQueue>& queue) mutable {
+                    auto uploaded =
+                        UploadRasterImage(std::move(decompressed), context,
+                                          queue, sync_switch, flow);
+
+                    if (!uploaded.skia_object()) {
+                      FML_DLOG(ERROR) << "Could not upload image to the GPU.";
+                      result({}, std::move(flow));
+                      return;
+                    }
+
+                    // Finally, all done.
+                    result(std::move(uploaded), std::move(flow));
+                  });
+
+              // Prefer the upload threads, if any, so that the images of a
+              // frame aren't uploaded one after the other.
+              if (io_manager->PostConcurrentUploadTask(upload)) {
+                return;
+              }
+              upload(io_manager->GetResourceContext().get(),
+                     io_manager->GetSkiaUnrefQueue());
+            }),
+            fml::TaskSourceGrade::kUserInteraction);
       }));
 }
 
@@ -2,6 +2,10 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <limits>
+#include <mutex>
+#include <optional>
+
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -166,7 +170,22 @@ class TestIOManager final : public IOManager {
   FML_DISALLOW_COPY_AND_ASSIGN(TestIOManager);
 };
 
-class ImageDecoderFixtureTest : public FixtureTest {};
+class ImageDecoderFixtureTest : public FixtureTest {
+ protected:
+  static size_t GetFrameLookahead(const MultiFrameCodec& codec) {
+    return codec.state_->frameLookahead_;
+  }
+
+  static size_t DecodeFramesAhead(const MultiFrameCodec& codec) {
+    codec.state_->DecodeAhead();
+    std::scoped_lock lock(codec.state_->mutex_);
+    return codec.state_->decodedFrames_.size();
+  }
+
+  static std::optional<SkBitmap> TakeNextFrame(const MultiFrameCodec& codec) {
+    return codec.state_->TakeNextFrame().bitmap;
+  }
+};
 
 TEST_F(ImageDecoderFixtureTest, CanCreateImageDecoder) {
   auto loop = fml::ConcurrentMessageLoop::Create();
@@ -752,6 +771,34 @@ TEST(ImageDecoderTest, ImagesWithTransparencyArePremulAlpha) {
   ASSERT_EQ(compressed_image->alphaType(), kPremul_SkAlphaType);
 }
 
+TEST(ImageDecoderTest, StillImagesAreSubsampledWhileDecoding) {
+  auto data = flutter::testing::OpenFixtureAsSkData("heart_end.png");
+  ASSERT_TRUE(data);
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+  ASSERT_EQ(generator->GetInfo().dimensions(), SkISize::Make(500, 500));
+
+  // PNG codecs cannot scale natively, so this size comes from subsampling.
+  const SkISize scaled_size = generator->GetScaledDimensions(0.5);
+  ASSERT_EQ(scaled_size, SkISize::Make(250, 250));
+  EXPECT_EQ(generator->GetScaledDimensions(1.0), SkISize::Make(500, 500));
+
+  SkBitmap bitmap;
+  ASSERT_TRUE(bitmap.tryAllocPixels(
+      generator->GetInfo().makeDimensions(scaled_size)));
+  EXPECT_TRUE(generator->GetPixels(bitmap.info(), bitmap.getPixels(),
+                                   bitmap.rowBytes()));
+
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(std::move(data),
+                                                         std::move(generator));
+  auto image = ImageDecoderSkia::ImageFromCompressedData(
+      descriptor.get(), 200, 200, fml::tracing::TraceFlow(""));
+  ASSERT_TRUE(image);
+  EXPECT_EQ(image->dimensions(), SkISize::Make(200, 200));
+}
+
 TEST(ImageDecoderTest, VerifySubpixelDecodingPreservesExifOrientation) {
   auto data = flutter::testing::OpenFixtureAsSkData("Horizontal.jpg");
 
@@ -1044,6 +1091,91 @@ TEST_F(ImageDecoderFixtureTest,
   PostTaskSync(runners.GetIOTaskRunner(), [&]() { io_manager.reset(); });
 }
 
+TEST_F(ImageDecoderFixtureTest, MultiFrameCodecDecodesSameFramesAhead) {
+  auto settings = CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+
+  auto apng_mapping = flutter::testing::OpenFixtureAsSkData(
+      "2_dispose_op_restore_previous.apng");
+  ASSERT_TRUE(apng_mapping);
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(apng_mapping);
+  std::shared_ptr<ImageGenerator> lookahead_generator =
+      registry.CreateCompatibleGenerator(apng_mapping);
+  ASSERT_TRUE(generator);
+  ASSERT_TRUE(lookahead_generator);
+  const int frame_count = generator->GetFrameCount();
+  ASSERT_GT(frame_count, 2);
+
+  auto runner = CreateNewThread();
+  TaskRunners runners(GetCurrentTestName(), runner, runner, runner, runner);
+  auto isolate = RunDartCodeInIsolate(vm_ref, settings, runners, "main", {},
+                                      GetDefaultKernelFilePath());
+  ASSERT_TRUE(isolate && isolate->IsValid());
+
+  PostTaskSync(runner, [&]() {
+    EXPECT_TRUE(isolate->RunInIsolateScope([&]() -> bool {
+      auto codec = fml::MakeRefCounted<MultiFrameCodec>(std::move(generator));
+      auto lookahead_codec = fml::MakeRefCounted<MultiFrameCodec>(
+          std::move(lookahead_generator), /*frame_lookahead=*/2,
+          /*lookahead_max_bytes=*/std::numeric_limits<size_t>::max());
+      EXPECT_EQ(GetFrameLookahead(*lookahead_codec), 2u);
+
+      // Frames depending on the previous ones must be composited the same way
+      // when decoded ahead, including across the end of the loop.
+      for (int i = 0; i < frame_count * 2; i++) {
+        EXPECT_EQ(DecodeFramesAhead(*lookahead_codec), 2u);
+        std::optional<SkBitmap> expected = TakeNextFrame(*codec);
+        std::optional<SkBitmap> actual = TakeNextFrame(*lookahead_codec);
+        if (!expected.has_value() || !actual.has_value()) {
+          return false;
+        }
+        EXPECT_EQ(expected->computeByteSize(), actual->computeByteSize());
+        EXPECT_EQ(memcmp(expected->getPixels(), actual->getPixels(),
+                         expected->computeByteSize()),
+                  0)
+            << "Frame " << i % frame_count << " differs.";
+      }
+      return true;
+    }));
+  });
+}
+
+TEST_F(ImageDecoderFixtureTest, MultiFrameCodecLookaheadRespectsMemoryBudget) {
+  auto settings = CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+
+  auto gif_mapping = flutter::testing::OpenFixtureAsSkData("hello_loop_2.gif");
+  ASSERT_TRUE(gif_mapping);
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> gif_generator =
+      registry.CreateCompatibleGenerator(gif_mapping);
+  ASSERT_TRUE(gif_generator);
+  const size_t frame_bytes = gif_generator->GetInfo()
+                                 .makeColorType(kN32_SkColorType)
+                                 .computeMinByteSize();
+
+  auto runner = CreateNewThread();
+  TaskRunners runners(GetCurrentTestName(), runner, runner, runner, runner);
+  auto isolate = RunDartCodeInIsolate(vm_ref, settings, runners, "main", {},
+                                      GetDefaultKernelFilePath());
+  ASSERT_TRUE(isolate && isolate->IsValid());
+
+  PostTaskSync(runner, [&]() {
+    EXPECT_TRUE(isolate->RunInIsolateScope([&]() -> bool {
+      auto codec = fml::MakeRefCounted<MultiFrameCodec>(
+          gif_generator, /*frame_lookahead=*/4,
+          /*lookahead_max_bytes=*/frame_bytes - 1);
+      EXPECT_EQ(GetFrameLookahead(*codec), 0u);
+      EXPECT_EQ(DecodeFramesAhead(*codec), 0u);
+      return true;
+    }));
+  });
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -7,6 +7,7 @@
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/painting/image_decoder.h"
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
 #include "flutter/lib/ui/painting/single_frame_codec.h"
 #include "flutter/lib/ui/ui_dart_state.h"
@@ -116,11 +117,26 @@ void ImageDescriptor::instantiateCodec(Dart_Handle codec_handle,
         static_cast<fml::RefPtr<ImageDescriptor>>(this), target_width,
         target_height);
   } else {
-    ui_codec = fml::MakeRefCounted<MultiFrameCodec>(generator_);
+    size_t frame_lookahead = 0;
+    size_t lookahead_max_bytes = 0;
+    if (auto image_decoder = UIDartState::Current()->GetImageDecoder()) {
+      frame_lookahead = image_decoder->GetAnimatedImageFrameLookahead();
+      lookahead_max_bytes = image_decoder->GetAnimatedImageLookaheadMaxBytes();
+    }
+    ui_codec = fml::MakeRefCounted<MultiFrameCodec>(
+        generator_, frame_lookahead, lookahead_max_bytes);
   }
   ui_codec->AssociateWithDartWrapper(codec_handle);
 }
 
+fml::RefPtr<ImageDescriptor> ImageDescriptor::Clone() const {
+  if (generator_) {
+    return fml::MakeRefCounted<ImageDescriptor>(buffer_, generator_);
+  }
+  return fml::MakeRefCounted<ImageDescriptor>(buffer_, image_info_,
+                                              row_bytes_);
+}
+
 sk_sp<SkImage> ImageDescriptor::image() const {
   return generator_->GetImage();
 }
@@ -110,6 +110,23 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   ///         orientation tag, if applicable.
   bool get_pixels(const SkPixmap& pixmap) const;
 
+  /// @brief  Decodes this image directly into a texture of the given size, if
+  ///         backed by an `ImageGenerator` that supports it.
+  /// @see    `ImageGenerator::DecodeToTexture`
+  std::shared_ptr<impeller::Texture> decode_to_texture(
+      const std::shared_ptr<impeller::Context>& context,
+      const SkISize& target_size) const {
+    if (generator_) {
+      return generator_->DecodeToTexture(context, target_size);
+    }
+    return nullptr;
+  }
+
+  /// @brief  Creates a descriptor of the same image data and generator, which
+  ///         is not associated with a Dart object, so that the data can be
+  ///         retained after this descriptor is disposed.
+  fml::RefPtr<ImageDescriptor> Clone() const;
+
   void dispose() {
     buffer_.reset();
     generator_.reset();
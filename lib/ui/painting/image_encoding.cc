@@ -10,7 +10,9 @@
 
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/build_config.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/pixel_conversion.h"
 #include "flutter/fml/status_or.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/image.h"
@@ -81,6 +83,24 @@ sk_sp<SkData> CopyImageByteData(const sk_sp<SkImage>& raster_image,
     return SkData::MakeWithCopy(pixmap.addr(), pixmap.computeByteSize());
   }
 
+  // Swapping the red and blue channels is all it takes to convert between
+  // the BGRA of Impeller's textures and the requested RGBA, and is much
+  // cheaper than drawing the pixels to a surface.
+  bool swaps_red_and_blue =
+      (pixmap.colorType() == kBGRA_8888_SkColorType &&
+       color_type == kRGBA_8888_SkColorType) ||
+      (pixmap.colorType() == kRGBA_8888_SkColorType &&
+       color_type == kBGRA_8888_SkColorType);
+  if (swaps_red_and_blue && pixmap.alphaType() == alpha_type) {
+    const size_t row_bytes = pixmap.width() * 4u;
+    sk_sp<SkData> data = SkData::MakeUninitialized(row_bytes * pixmap.height());
+    fml::SwizzleRedAndBlue(static_cast<const uint8_t*>(pixmap.addr()),
+                           pixmap.rowBytes(),
+                           static_cast<uint8_t*>(data->writable_data()),
+                           row_bytes, pixmap.width(), pixmap.height());
+    return data;
+  }
+
   // Perform swizzle if the type doesnt match the specification.
   auto surface = SkSurfaces::Raster(
       SkImageInfo::Make(raster_image->width(), raster_image->height(),
@@ -108,6 +128,7 @@ void EncodeImageAndInvokeDataCallback(
     const fml::RefPtr<fml::TaskRunner>& ui_task_runner,
     const fml::RefPtr<fml::TaskRunner>& raster_task_runner,
     const fml::RefPtr<fml::TaskRunner>& io_task_runner,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner,
     const fml::WeakPtr<GrDirectContext>& resource_context,
     const fml::TaskRunnerAffineWeakPtr<SnapshotDelegate>& snapshot_delegate,
     const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch,
@@ -121,22 +142,33 @@ void EncodeImageAndInvokeDataCallback(
   // The static leak checker gets confused by the use of fml::MakeCopyable in
   // EncodeImage.
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
-  auto encode_task =
-      [callback_task = std::move(callback_task), format,
-       ui_task_runner](const fml::StatusOr<sk_sp<SkImage>>& raster_image) {
-        if (raster_image.ok()) {
-          sk_sp<SkData> encoded = EncodeImage(raster_image.value(), format);
-          ui_task_runner->PostTask([callback_task = callback_task,
-                                    encoded = std::move(encoded)]() mutable {
-            callback_task(std::move(encoded));
-          });
-        } else {
-          ui_task_runner->PostTask([callback_task = callback_task,
-                                    raster_image = raster_image]() mutable {
-            callback_task(raster_image.status());
-          });
-        }
+  auto encode_task = [callback_task = std::move(callback_task), format,
+                      ui_task_runner, concurrent_task_runner](
+                         const fml::StatusOr<sk_sp<SkImage>>& raster_image) {
+    if (raster_image.ok()) {
+      // Encoding a large image to PNG takes long enough to hold up the image
+      // decodes and uploads that share the IO thread, so it is done on the
+      // concurrent loop when there is one.
+      auto encode = [callback_task, format, ui_task_runner,
+                     raster_image = raster_image.value()]() {
+        sk_sp<SkData> encoded = EncodeImage(raster_image, format);
+        ui_task_runner->PostTask([callback_task = callback_task,
+                                  encoded = std::move(encoded)]() mutable {
+          callback_task(std::move(encoded));
+        });
       };
+      if (concurrent_task_runner) {
+        concurrent_task_runner->PostTask(encode);
+      } else {
+        encode();
+      }
+    } else {
+      ui_task_runner->PostTask([callback_task = callback_task,
+                                raster_image = raster_image]() mutable {
+        callback_task(raster_image.status());
+      });
+    }
+  };
 
   FML_DCHECK(image);
 #if IMPELLER_SUPPORTS_RENDERING
@@ -179,13 +211,15 @@ Dart_Handle EncodeImage(CanvasImage* canvas_image,
        image_format, ui_task_runner = task_runners.GetUITaskRunner(),
        raster_task_runner = task_runners.GetRasterTaskRunner(),
        io_task_runner = task_runners.GetIOTaskRunner(),
+       concurrent_task_runner =
+           UIDartState::Current()->GetConcurrentTaskRunner(),
        io_manager = UIDartState::Current()->GetIOManager(),
        snapshot_delegate = UIDartState::Current()->GetSnapshotDelegate(),
        is_impeller_enabled =
            UIDartState::Current()->IsImpellerEnabled()]() mutable {
         EncodeImageAndInvokeDataCallback(
             image, std::move(callback), image_format, ui_task_runner,
-            raster_task_runner, io_task_runner,
+            raster_task_runner, io_task_runner, concurrent_task_runner,
             io_manager->GetResourceContext(), snapshot_delegate,
             io_manager->GetIsGpuDisabledSyncSwitch(),
             io_manager->GetImpellerContext(), is_impeller_enabled);
@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/painting/image_generator.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "flutter/fml/logging.h"
@@ -35,6 +36,12 @@ sk_sp<SkImage> ImageGenerator::GetImage() {
   return SkImages::RasterFromBitmap(bitmap);
 }
 
+std::shared_ptr<impeller::Texture> ImageGenerator::DecodeToTexture(
+    const std::shared_ptr<impeller::Context>& context,
+    const SkISize& target_size) {
+  return nullptr;
+}
+
 BuiltinSkiaImageGenerator::~BuiltinSkiaImageGenerator() = default;
 
 BuiltinSkiaImageGenerator::BuiltinSkiaImageGenerator(
@@ -97,14 +104,14 @@ static SkImageInfo getInfoIncludingExif(SkCodec* codec) {
 
 BuiltinSkiaCodecImageGenerator::BuiltinSkiaCodecImageGenerator(
     std::unique_ptr<SkCodec> codec)
-    : codec_(std::move(codec)) {
-  image_info_ = getInfoIncludingExif(codec_.get());
+    : android_codec_(SkAndroidCodec::MakeFromCodec(std::move(codec))),
+      codec_(android_codec_->codec()) {
+  image_info_ = getInfoIncludingExif(codec_);
 }
 
 BuiltinSkiaCodecImageGenerator::BuiltinSkiaCodecImageGenerator(
     sk_sp<SkData> buffer)
-    : codec_(SkCodec::MakeFromData(std::move(buffer)).release()) {
-  image_info_ = getInfoIncludingExif(codec_.get());
+    : BuiltinSkiaCodecImageGenerator(SkCodec::MakeFromData(std::move(buffer))) {
 }
 
 const SkImageInfo& BuiltinSkiaCodecImageGenerator::GetInfo() {
@@ -135,6 +142,16 @@ const ImageGenerator::FrameInfo BuiltinSkiaCodecImageGenerator::GetFrameInfo(
 SkISize BuiltinSkiaCodecImageGenerator::GetScaledDimensions(
     float desired_scale) {
   SkISize size = codec_->getScaledDimensions(desired_scale);
+  if (desired_scale < 1.0f && codec_->getFrameCount() == 1) {
+    // Still images can also be subsampled by any integer factor while they
+    // are decoded. Use the largest one that stays above the desired scale.
+    const int sample_size = std::max(1, static_cast<int>(1.0f / desired_scale));
+    const SkISize sampled_size =
+        android_codec_->getSampledDimensions(sample_size);
+    if (sampled_size.area() < size.area()) {
+      size = sampled_size;
+    }
+  }
   if (SkEncodedOriginSwapsWidthHeight(codec_->getOrigin())) {
     std::swap(size.fWidth, size.fHeight);
   }
@@ -176,7 +193,21 @@ bool BuiltinSkiaCodecImageGenerator::GetPixels(
     temp_pixmap = temp_bitmap.pixmap();
   }
 
-  SkCodec::Result result = codec_->getPixels(temp_pixmap, &options);
+  SkCodec::Result result;
+  SkISize sampled_size = temp_pixmap.dimensions();
+  const int sample_size = android_codec_->computeSampleSize(&sampled_size);
+  if (frame_index == 0 && sample_size > 1 &&
+      sampled_size == temp_pixmap.dimensions() &&
+      !codec_->dimensionsSupported(sampled_size)) {
+    // The size was picked by `GetScaledDimensions` for a subsampled decode.
+    SkAndroidCodec::AndroidOptions android_options;
+    android_options.fSampleSize = sample_size;
+    result = android_codec_->getAndroidPixels(
+        temp_pixmap.info(), temp_pixmap.writable_addr(), temp_pixmap.rowBytes(),
+        &android_options);
+  } else {
+    result = codec_->getPixels(temp_pixmap, &options);
+  }
   if (result != SkCodec::kSuccess) {
     FML_DLOG(WARNING) << "codec could not get pixels. "
                       << SkCodec::ResultToString(result);
@@ -5,8 +5,11 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_H_
 
+#include <memory>
 #include <optional>
+
 #include "flutter/fml/macros.h"
+#include "third_party/skia/include/codec/SkAndroidCodec.h"
 #include "third_party/skia/include/codec/SkCodec.h"
 #include "third_party/skia/include/codec/SkCodecAnimation.h"
 #include "third_party/skia/include/core/SkData.h"
@@ -15,6 +18,11 @@
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkSize.h"
 
+namespace impeller {
+class Context;
+class Texture;
+}  // namespace impeller
+
 namespace flutter {
 
 /// @brief  The minimal interface necessary for defining a decoder that can be
@@ -139,6 +147,21 @@ class ImageGenerator {
   ///          `ImageGenerator`.
   /// @return  A new `SkImage` containing the decoded image data.
   sk_sp<SkImage> GetImage();
+
+  /// @brief      Decode the first frame of the image directly into a texture
+  ///             owned by the given Impeller context, without going through a
+  ///             CPU bitmap. Generators backed by platform hardware decoders
+  ///             override this; the default implementation does nothing.
+  /// @param[in]  context      The Impeller context the texture is created in.
+  /// @param[in]  target_size  The size of the texture to decode into.
+  /// @return     The decoded texture, or nullptr if the image could not be
+  ///             decoded this way. Callers must then fall back to `GetPixels`.
+  /// @note       Like `GetPixels`, this method performs potentially long
+  ///             synchronous work and should never be executed on the UI
+  ///             thread.
+  virtual std::shared_ptr<impeller::Texture> DecodeToTexture(
+      const std::shared_ptr<impeller::Context>& context,
+      const SkISize& target_size);
 };
 
 class BuiltinSkiaImageGenerator : public ImageGenerator {
@@ -216,7 +239,10 @@ class BuiltinSkiaCodecImageGenerator : public ImageGenerator {
 
  private:
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(BuiltinSkiaCodecImageGenerator);
-  std::unique_ptr<SkCodec> codec_;
+  // Owns the codec, and subsamples still images while decoding them in the
+  // formats that the codec cannot scale natively.
+  std::unique_ptr<SkAndroidCodec> android_codec_;
+  SkCodec* codec_;
   SkImageInfo image_info_;
 };
 
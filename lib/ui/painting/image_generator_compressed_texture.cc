@@ -0,0 +1,338 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_generator_compressed_texture.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+
+#if IMPELLER_SUPPORTS_RENDERING
+#include "flutter/impeller/base/strings.h"
+#include "flutter/impeller/core/allocator.h"
+#include "flutter/impeller/core/device_buffer.h"
+#include "flutter/impeller/core/formats.h"
+#include "flutter/impeller/core/texture.h"
+#include "flutter/impeller/core/texture_descriptor.h"
+#include "flutter/impeller/renderer/command_buffer.h"
+#include "flutter/impeller/renderer/context.h"
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+namespace flutter {
+
+namespace {
+
+using Format = CompressedTextureImageGenerator::Format;
+using Level = CompressedTextureImageGenerator::Level;
+
+// https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html
+constexpr uint8_t kKTX2Identifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32,
+                                         0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+constexpr size_t kKTX2HeaderSize = 80;
+constexpr size_t kKTX2LevelIndexEntrySize = 24;
+// `VkFormat` values. The sRGB variants are sampled without conversion, like
+// every other image.
+constexpr uint32_t kVkFormatBC7UNorm = 145;
+constexpr uint32_t kVkFormatBC7SRGB = 146;
+constexpr uint32_t kVkFormatETC2R8G8B8A8UNorm = 151;
+constexpr uint32_t kVkFormatETC2R8G8B8A8SRGB = 152;
+constexpr uint32_t kVkFormatASTC4x4UNorm = 157;
+constexpr uint32_t kVkFormatASTC4x4SRGB = 158;
+
+// https://github.com/ARM-software/astc-encoder/blob/main/Docs/FileFormat.md
+constexpr uint32_t kASTCMagic = 0x5CA1AB13;
+constexpr size_t kASTCHeaderSize = 16;
+
+constexpr size_t kBlockDimension = 4;
+constexpr size_t kBlockSize = 16;
+
+uint32_t ReadUint32(const uint8_t* bytes) {
+  return bytes[0] | bytes[1] << 8 | bytes[2] << 16 |
+         static_cast<uint32_t>(bytes[3]) << 24;
+}
+
+uint64_t ReadUint64(const uint8_t* bytes) {
+  return ReadUint32(bytes) | static_cast<uint64_t>(ReadUint32(bytes + 4)) << 32;
+}
+
+uint32_t ReadUint24(const uint8_t* bytes) {
+  return bytes[0] | bytes[1] << 8 | bytes[2] << 16;
+}
+
+size_t GetLevelLength(const SkISize& size) {
+  return ((size.width() + kBlockDimension - 1) / kBlockDimension) *
+         ((size.height() + kBlockDimension - 1) / kBlockDimension) * kBlockSize;
+}
+
+bool ParseKTX2(const SkData& data, Format* format, std::vector<Level>* levels) {
+  const uint8_t* bytes = data.bytes();
+  if (data.size() < kKTX2HeaderSize ||
+      memcmp(bytes, kKTX2Identifier, sizeof(kKTX2Identifier)) != 0) {
+    return false;
+  }
+  switch (ReadUint32(bytes + 12)) {
+    case kVkFormatETC2R8G8B8A8UNorm:
+    case kVkFormatETC2R8G8B8A8SRGB:
+      *format = Format::kETC2RGBA8;
+      break;
+    case kVkFormatASTC4x4UNorm:
+    case kVkFormatASTC4x4SRGB:
+      *format = Format::kASTC4x4;
+      break;
+    case kVkFormatBC7UNorm:
+    case kVkFormatBC7SRGB:
+      *format = Format::kBC7;
+      break;
+    default:
+      return false;
+  }
+  const uint32_t width = ReadUint32(bytes + 20);
+  const uint32_t height = ReadUint32(bytes + 24);
+  const uint32_t depth = ReadUint32(bytes + 28);
+  const uint32_t layer_count = ReadUint32(bytes + 32);
+  const uint32_t face_count = ReadUint32(bytes + 36);
+  const uint32_t level_count = std::max(ReadUint32(bytes + 40), 1u);
+  const uint32_t supercompression_scheme = ReadUint32(bytes + 44);
+  // Only plain 2D textures, whose levels can be uploaded as they are.
+  if (width == 0 || height == 0 || width > INT32_MAX || height > INT32_MAX ||
+      depth != 0 || layer_count != 0 || face_count != 1 ||
+      supercompression_scheme != 0 || level_count > 32) {
+    return false;
+  }
+  if (data.size() <
+      kKTX2HeaderSize + level_count * kKTX2LevelIndexEntrySize) {
+    return false;
+  }
+  for (uint32_t i = 0; i < level_count; i++) {
+    const uint8_t* entry =
+        bytes + kKTX2HeaderSize + i * kKTX2LevelIndexEntrySize;
+    const uint64_t offset = ReadUint64(entry);
+    const uint64_t length = ReadUint64(entry + 8);
+    const SkISize size = SkISize::Make(std::max(width >> i, 1u),
+                                       std::max(height >> i, 1u));
+    if (length != GetLevelLength(size) || offset > data.size() ||
+        length > data.size() - offset) {
+      return false;
+    }
+    levels->push_back({.offset = static_cast<size_t>(offset),
+                       .length = static_cast<size_t>(length),
+                       .size = size});
+  }
+  return true;
+}
+
+bool ParseASTC(const SkData& data, Format* format, std::vector<Level>* levels) {
+  const uint8_t* bytes = data.bytes();
+  if (data.size() < kASTCHeaderSize || ReadUint32(bytes) != kASTCMagic) {
+    return false;
+  }
+  // Only the 4x4 block footprint is supported.
+  if (bytes[4] != kBlockDimension || bytes[5] != kBlockDimension ||
+      bytes[6] != 1) {
+    return false;
+  }
+  const SkISize size =
+      SkISize::Make(ReadUint24(bytes + 7), ReadUint24(bytes + 10));
+  if (size.isEmpty() || ReadUint24(bytes + 13) != 1) {
+    return false;
+  }
+  const size_t length = GetLevelLength(size);
+  if (data.size() - kASTCHeaderSize < length) {
+    return false;
+  }
+  *format = Format::kASTC4x4;
+  levels->push_back(
+      {.offset = kASTCHeaderSize, .length = length, .size = size});
+  return true;
+}
+
+#if IMPELLER_SUPPORTS_RENDERING
+impeller::PixelFormat ToPixelFormat(Format format) {
+  switch (format) {
+    case Format::kETC2RGBA8:
+      return impeller::PixelFormat::kETC2R8G8B8A8UNormInt;
+    case Format::kASTC4x4:
+      return impeller::PixelFormat::kASTC4x4UNormInt;
+    case Format::kBC7:
+      return impeller::PixelFormat::kBC7UNormInt;
+  }
+  FML_UNREACHABLE();
+}
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+}  // namespace
+
+CompressedTextureImageGenerator::CompressedTextureImageGenerator(
+    sk_sp<SkData> data,
+    Format format,
+    std::vector<Level> levels)
+    : data_(std::move(data)),
+      format_(format),
+      levels_(std::move(levels)),
+      image_info_(SkImageInfo::Make(levels_.front().size,
+                                    kRGBA_8888_SkColorType,
+                                    kPremul_SkAlphaType,
+                                    SkColorSpace::MakeSRGB())) {}
+
+CompressedTextureImageGenerator::~CompressedTextureImageGenerator() = default;
+
+const SkImageInfo& CompressedTextureImageGenerator::GetInfo() {
+  return image_info_;
+}
+
+unsigned int CompressedTextureImageGenerator::GetFrameCount() const {
+  return 1;
+}
+
+unsigned int CompressedTextureImageGenerator::GetPlayCount() const {
+  return 1;
+}
+
+const ImageGenerator::FrameInfo CompressedTextureImageGenerator::GetFrameInfo(
+    unsigned int frame_index) {
+  return {.required_frame = std::nullopt,
+          .duration = 0,
+          .disposal_method = SkCodecAnimation::DisposalMethod::kKeep};
+}
+
+SkISize CompressedTextureImageGenerator::GetScaledDimensions(
+    float desired_scale) {
+  // Compressed data can't be resized, so the smallest level that is still at
+  // least as large as the desired size is used instead.
+  const SkISize base_size = levels_.front().size;
+  SkISize size = base_size;
+  for (const auto& level : levels_) {
+    if (level.size.width() < base_size.width() * desired_scale ||
+        level.size.height() < base_size.height() * desired_scale) {
+      break;
+    }
+    size = level.size;
+  }
+  return size;
+}
+
+bool CompressedTextureImageGenerator::GetPixels(
+    const SkImageInfo& info,
+    void* pixels,
+    size_t row_bytes,
+    unsigned int frame_index,
+    std::optional<unsigned int> prior_frame) {
+  // There is no CPU decoder for block compressed formats.
+  FML_DLOG(ERROR) << "Compressed textures can only be decoded on the GPU.";
+  return false;
+}
+
+std::shared_ptr<impeller::Texture>
+CompressedTextureImageGenerator::DecodeToTexture(
+    const std::shared_ptr<impeller::Context>& context,
+    const SkISize& target_size) {
+#if IMPELLER_SUPPORTS_RENDERING
+  if (!context) {
+    return nullptr;
+  }
+  const auto pixel_format = ToPixelFormat(format_);
+  if (!context->GetCapabilities()->SupportsCompressedTextureFormat(
+          pixel_format)) {
+    FML_LOG(ERROR) << "The GPU does not support compressed textures in the "
+                   << impeller::PixelFormatToString(pixel_format)
+                   << " format.";
+    return nullptr;
+  }
+  TRACE_EVENT0("flutter", __FUNCTION__);
+
+  // The smallest level that covers the target size, among those that fit in
+  // a texture.
+  const auto& allocator = context->GetResourceAllocator();
+  const auto max_size = allocator->GetMaxTextureSizeSupported();
+  const Level* level = nullptr;
+  for (const auto& candidate : levels_) {
+    if (candidate.size.width() > max_size.width ||
+        candidate.size.height() > max_size.height) {
+      continue;
+    }
+    if (level && (candidate.size.width() < target_size.width() ||
+                  candidate.size.height() < target_size.height())) {
+      break;
+    }
+    level = &candidate;
+  }
+  if (!level) {
+    FML_LOG(ERROR) << "The compressed texture is too large for the GPU.";
+    return nullptr;
+  }
+
+  impeller::TextureDescriptor texture_descriptor;
+  texture_descriptor.format = pixel_format;
+  texture_descriptor.size = {level->size.width(), level->size.height()};
+  texture_descriptor.mip_count = 1u;
+
+  const uint8_t* level_data = data_->bytes() + level->offset;
+  if (!context->GetCapabilities()->SupportsBufferToTextureBlits()) {
+    texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
+    auto texture = allocator->CreateTexture(texture_descriptor);
+    if (!texture ||
+        !texture->SetContents(std::make_shared<fml::NonOwnedMapping>(
+            level_data, level->length, [data = data_](auto, auto) {}))) {
+      FML_DLOG(ERROR) << "Could not upload the compressed texture.";
+      return nullptr;
+    }
+    return texture;
+  }
+
+  texture_descriptor.storage_mode = impeller::StorageMode::kDevicePrivate;
+  auto texture = allocator->CreateTexture(texture_descriptor);
+  auto buffer = allocator->CreateBufferWithCopy(level_data, level->length);
+  if (!texture || !buffer) {
+    FML_DLOG(ERROR) << "Could not allocate the compressed texture.";
+    return nullptr;
+  }
+  texture->SetLabel(impeller::SPrintF("ui.Image(%p)", texture.get()).c_str());
+
+  auto command_buffer = context->CreateCommandBuffer();
+  if (!command_buffer) {
+    return nullptr;
+  }
+  command_buffer->SetLabel("Compressed Texture Command Buffer");
+  auto blit_pass = command_buffer->CreateBlitPass();
+  if (!blit_pass) {
+    return nullptr;
+  }
+  blit_pass->SetLabel("Compressed Texture Blit Pass");
+  if (!blit_pass->AddCopy(impeller::DeviceBuffer::AsBufferView(buffer),
+                          texture) ||
+      !blit_pass->EncodeCommands(allocator) ||
+      !command_buffer->SubmitCommands()) {
+    FML_DLOG(ERROR) << "Could not upload the compressed texture.";
+    return nullptr;
+  }
+  return texture;
+#else
+  return nullptr;
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+std::unique_ptr<ImageGenerator> CompressedTextureImageGenerator::MakeFromData(
+    sk_sp<SkData> data) {
+  if (!data) {
+    return nullptr;
+  }
+  Format format;
+  std::vector<Level> levels;
+  if (!ParseKTX2(*data, &format, &levels)) {
+    levels.clear();
+    if (!ParseASTC(*data, &format, &levels)) {
+      return nullptr;
+    }
+  }
+  return std::unique_ptr<CompressedTextureImageGenerator>(
+      new CompressedTextureImageGenerator(std::move(data), format,
+                                          std::move(levels)));
+}
+
+}  // namespace flutter
@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_COMPRESSED_TEXTURE_H_
+#define FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_COMPRESSED_TEXTURE_H_
+
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/painting/image_generator.h"
+
+namespace flutter {
+
+/// @brief  An image generator for textures that are already compressed in a
+///         GPU block format, stored in a KTX2 or `.astc` container.
+///
+///         The blocks are uploaded to a texture as they are, so these images
+///         take a quarter (or less) of the memory of a decoded image and skip
+///         the CPU decode entirely. There is no CPU fallback: images in a
+///         format the GPU cannot sample from fail to decode, and applications
+///         are expected to ship a variant of each asset per platform.
+class CompressedTextureImageGenerator : public ImageGenerator {
+ public:
+  /// The supported block formats. All of them store blocks of 4x4 pixels in
+  /// 16 bytes.
+  enum class Format {
+    kETC2RGBA8,
+    kASTC4x4,
+    kBC7,
+  };
+
+  /// A mip level of the texture, in the encoded data.
+  struct Level {
+    size_t offset;
+    size_t length;
+    SkISize size;
+  };
+
+  ~CompressedTextureImageGenerator();
+
+  // |ImageGenerator|
+  const SkImageInfo& GetInfo() override;
+
+  // |ImageGenerator|
+  unsigned int GetFrameCount() const override;
+
+  // |ImageGenerator|
+  unsigned int GetPlayCount() const override;
+
+  // |ImageGenerator|
+  const ImageGenerator::FrameInfo GetFrameInfo(
+      unsigned int frame_index) override;
+
+  // |ImageGenerator|
+  SkISize GetScaledDimensions(float desired_scale) override;
+
+  // |ImageGenerator|
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) override;
+
+  // |ImageGenerator|
+  std::shared_ptr<impeller::Texture> DecodeToTexture(
+      const std::shared_ptr<impeller::Context>& context,
+      const SkISize& target_size) override;
+
+  Format GetFormat() const { return format_; }
+
+  const std::vector<Level>& GetLevels() const { return levels_; }
+
+  static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
+
+ private:
+  const sk_sp<SkData> data_;
+  const Format format_;
+  // From the largest to the smallest.
+  const std::vector<Level> levels_;
+  const SkImageInfo image_info_;
+
+  CompressedTextureImageGenerator(sk_sp<SkData> data,
+                                  Format format,
+                                  std::vector<Level> levels);
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(CompressedTextureImageGenerator);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_COMPRESSED_TEXTURE_H_
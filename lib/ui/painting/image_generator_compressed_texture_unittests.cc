@@ -0,0 +1,114 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_generator_compressed_texture.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "flutter/lib/ui/painting/image_generator_registry.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+void WriteUint32(std::vector<uint8_t>& bytes, size_t offset, uint32_t value) {
+  for (size_t i = 0; i < 4; i++) {
+    bytes[offset + i] = (value >> (8 * i)) & 0xFF;
+  }
+}
+
+void WriteUint64(std::vector<uint8_t>& bytes, size_t offset, uint64_t value) {
+  WriteUint32(bytes, offset, value & 0xFFFFFFFF);
+  WriteUint32(bytes, offset + 4, value >> 32);
+}
+
+// A KTX2 file of an ETC2 RGBA8 texture of 8x6 pixels with all its levels.
+std::vector<uint8_t> MakeKTX2() {
+  const size_t level_lengths[] = {2 * 2 * 16, 1 * 1 * 16, 1 * 1 * 16,
+                                  1 * 1 * 16};
+  std::vector<uint8_t> bytes(80 + 4 * 24);
+  const uint8_t identifier[] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32,
+                                0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+  std::copy(std::begin(identifier), std::end(identifier), bytes.begin());
+  WriteUint32(bytes, 12, 151);  // VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+  WriteUint32(bytes, 16, 1);
+  WriteUint32(bytes, 20, 8);
+  WriteUint32(bytes, 24, 6);
+  WriteUint32(bytes, 36, 1);
+  WriteUint32(bytes, 40, 4);
+  for (size_t i = 0; i < 4; i++) {
+    WriteUint64(bytes, 80 + i * 24, bytes.size());
+    WriteUint64(bytes, 80 + i * 24 + 8, level_lengths[i]);
+    WriteUint64(bytes, 80 + i * 24 + 16, level_lengths[i]);
+    bytes.resize(bytes.size() + level_lengths[i], i);
+  }
+  return bytes;
+}
+
+}  // namespace
+
+TEST(CompressedTextureImageGeneratorTest, ParsesKTX2Levels) {
+  auto ktx2 = MakeKTX2();
+  auto generator = CompressedTextureImageGenerator::MakeFromData(
+      SkData::MakeWithCopy(ktx2.data(), ktx2.size()));
+  ASSERT_TRUE(generator);
+  EXPECT_EQ(generator->GetInfo().dimensions(), SkISize::Make(8, 6));
+  EXPECT_EQ(generator->GetFrameCount(), 1u);
+
+  auto* compressed =
+      static_cast<CompressedTextureImageGenerator*>(generator.get());
+  EXPECT_EQ(compressed->GetFormat(),
+            CompressedTextureImageGenerator::Format::kETC2RGBA8);
+  const auto& levels = compressed->GetLevels();
+  ASSERT_EQ(levels.size(), 4u);
+  EXPECT_EQ(levels[0].offset, 80u + 4 * 24);
+  EXPECT_EQ(levels[0].length, 64u);
+  EXPECT_EQ(levels[1].size, SkISize::Make(4, 3));
+  EXPECT_EQ(levels[3].size, SkISize::Make(1, 1));
+  EXPECT_EQ(ktx2[levels[2].offset], 2);
+
+  // Compressed data is never resized, so the closest level is picked.
+  EXPECT_EQ(generator->GetScaledDimensions(0.5), SkISize::Make(4, 3));
+  EXPECT_EQ(generator->GetScaledDimensions(0.4), SkISize::Make(4, 3));
+  EXPECT_EQ(generator->GetScaledDimensions(1.0), SkISize::Make(8, 6));
+
+  // There is no CPU decoder.
+  std::vector<uint8_t> pixels(8 * 6 * 4);
+  EXPECT_FALSE(generator->GetPixels(generator->GetInfo(), pixels.data(),
+                                    8 * 4, 0, std::nullopt));
+}
+
+TEST(CompressedTextureImageGeneratorTest, RejectsTruncatedKTX2) {
+  auto ktx2 = MakeKTX2();
+  ktx2.pop_back();
+  EXPECT_FALSE(CompressedTextureImageGenerator::MakeFromData(
+      SkData::MakeWithCopy(ktx2.data(), ktx2.size())));
+}
+
+TEST(CompressedTextureImageGeneratorTest, ParsesASTC) {
+  // An ASTC file of 5x5 pixels, which take 2x2 blocks of 4x4 pixels.
+  std::vector<uint8_t> astc = {0x13, 0xAB, 0xA1, 0x5C, 4, 4, 1, 5,
+                               0,    0,    5,    0,    0, 1, 0, 0};
+  astc.resize(astc.size() + 4 * 16);
+
+  ImageGeneratorRegistry registry;
+  auto generator = registry.CreateCompatibleGenerator(
+      SkData::MakeWithCopy(astc.data(), astc.size()));
+  ASSERT_TRUE(generator);
+  EXPECT_EQ(generator->GetInfo().dimensions(), SkISize::Make(5, 5));
+  EXPECT_EQ(static_cast<CompressedTextureImageGenerator*>(generator.get())
+                ->GetFormat(),
+            CompressedTextureImageGenerator::Format::kASTC4x4);
+
+  // Other block footprints are not supported.
+  astc[4] = 6;
+  EXPECT_FALSE(CompressedTextureImageGenerator::MakeFromData(
+      SkData::MakeWithCopy(astc.data(), astc.size())));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -15,6 +15,7 @@
 #endif
 
 #include "image_generator_apng.h"
+#include "image_generator_compressed_texture.h"
 
 namespace flutter {
 
@@ -25,6 +26,12 @@ ImageGeneratorRegistry::ImageGeneratorRegistry() : weak_factory_(this) {
       },
       0);
 
+  AddFactory(
+      [](sk_sp<SkData> buffer) {
+        return CompressedTextureImageGenerator::MakeFromData(std::move(buffer));
+      },
+      0);
+
   AddFactory(
       [](sk_sp<SkData> buffer) {
         return BuiltinSkiaCodecImageGenerator::MakeFromData(std::move(buffer));
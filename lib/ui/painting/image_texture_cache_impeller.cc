@@ -0,0 +1,206 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_texture_cache_impeller.h"
+
+#include <list>
+#include <mutex>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/impeller/core/texture.h"
+
+namespace flutter {
+
+// The cache state shared with the images, which may outlive the cache.
+class ImageTextureCacheImpeller::State {
+ public:
+  explicit State(size_t max_bytes) : max_bytes_(max_bytes) {}
+
+  // Guards the resident textures of all the images, and the LRU list.
+  std::mutex mutex;
+
+  // Adds a resident texture to the cache, evicting the textures of images
+  // that are not on screen if this exceeds the budget.
+  void AddResidentLocked(CachedImage* image);
+
+  void RemoveResidentLocked(CachedImage* image);
+
+  void MarkUsedLocked(CachedImage* image);
+
+  void PurgeLocked(bool over_budget_only);
+
+  size_t resident_bytes() const { return resident_bytes_; }
+
+ private:
+  const size_t max_bytes_;
+  size_t resident_bytes_ = 0;
+  // The images with a resident texture, the least recently used first.
+  std::list<CachedImage*> lru_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(State);
+};
+
+class ImageTextureCacheImpeller::CachedImage final : public DlImage {
+ public:
+  CachedImage(std::shared_ptr<State> state,
+              std::shared_ptr<impeller::Texture> texture,
+              TextureLoader loader)
+      : state_(std::move(state)),
+        loader_(std::move(loader)),
+        texture_(std::move(texture)),
+        size_(texture_->GetSize()),
+        bytes_(texture_->GetTextureDescriptor().GetByteSizeOfAllLevels()),
+        last_used_(fml::TimePoint::Now()) {
+    std::scoped_lock lock(state_->mutex);
+    state_->AddResidentLocked(this);
+  }
+
+  // |DlImage|
+  ~CachedImage() override {
+    std::scoped_lock lock(state_->mutex);
+    if (texture_) {
+      state_->RemoveResidentLocked(this);
+    }
+  }
+
+  // |DlImage|
+  sk_sp<SkImage> skia_image() const override { return nullptr; }
+
+  // |DlImage|
+  std::shared_ptr<impeller::Texture> impeller_texture() const override {
+    {
+      std::scoped_lock lock(state_->mutex);
+      if (texture_) {
+        state_->MarkUsedLocked(const_cast<CachedImage*>(this));
+        return texture_;
+      }
+    }
+    // The lock is not held while loading, so that the other images can be
+    // drawn and purged meanwhile.
+    std::shared_ptr<impeller::Texture> texture;
+    {
+      TRACE_EVENT0("flutter", "ImageTextureCacheImpeller::LoadTexture");
+      texture = loader_();
+    }
+    if (!texture) {
+      FML_LOG(ERROR) << "Could not load the purged texture of an image.";
+      return nullptr;
+    }
+    std::scoped_lock lock(state_->mutex);
+    // Another thread may have loaded the texture meanwhile.
+    if (!texture_) {
+      texture_ = std::move(texture);
+      state_->AddResidentLocked(const_cast<CachedImage*>(this));
+    }
+    return texture_;
+  }
+
+  // |DlImage|
+  bool isOpaque() const override {
+    // Impeller doesn't currently implement opaque alpha types.
+    return false;
+  }
+
+  // |DlImage|
+  bool isTextureBacked() const override { return true; }
+
+  // |DlImage|
+  bool isUIThreadSafe() const override { return true; }
+
+  // |DlImage|
+  SkISize dimensions() const override {
+    return SkISize::Make(size_.width, size_.height);
+  }
+
+  // |DlImage|
+  size_t GetApproximateByteSize() const override {
+    return sizeof(*this) + bytes_;
+  }
+
+ private:
+  friend class ImageTextureCacheImpeller::State;
+
+  const std::shared_ptr<State> state_;
+  const TextureLoader loader_;
+  // Guarded by the mutex of the state.
+  mutable std::shared_ptr<impeller::Texture> texture_;
+  const impeller::ISize size_;
+  const size_t bytes_;
+  // Guarded by the mutex of the state.
+  mutable fml::TimePoint last_used_;
+  // The position of this image in the LRU list while its texture is resident.
+  mutable std::list<CachedImage*>::iterator lru_position_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(CachedImage);
+};
+
+void ImageTextureCacheImpeller::State::AddResidentLocked(CachedImage* image) {
+  image->last_used_ = fml::TimePoint::Now();
+  image->lru_position_ = lru_.insert(lru_.end(), image);
+  resident_bytes_ += image->bytes_;
+  PurgeLocked(/*over_budget_only=*/true);
+}
+
+void ImageTextureCacheImpeller::State::RemoveResidentLocked(
+    CachedImage* image) {
+  lru_.erase(image->lru_position_);
+  resident_bytes_ -= image->bytes_;
+}
+
+void ImageTextureCacheImpeller::State::MarkUsedLocked(CachedImage* image) {
+  image->last_used_ = fml::TimePoint::Now();
+  lru_.splice(lru_.end(), lru_, image->lru_position_);
+}
+
+void ImageTextureCacheImpeller::State::PurgeLocked(bool over_budget_only) {
+  if (over_budget_only && (max_bytes_ == 0 || resident_bytes_ <= max_bytes_)) {
+    return;
+  }
+  const auto recent_use = fml::TimePoint::Now() - kRecentUseInterval;
+  auto it = lru_.begin();
+  while (it != lru_.end()) {
+    if (over_budget_only && resident_bytes_ <= max_bytes_) {
+      return;
+    }
+    CachedImage* image = *it;
+    // The list is sorted by last use, so the remaining images are on screen.
+    if (image->last_used_ > recent_use) {
+      return;
+    }
+    // Frames in flight keep their own reference to the texture.
+    image->texture_.reset();
+    resident_bytes_ -= image->bytes_;
+    it = lru_.erase(it);
+  }
+}
+
+ImageTextureCacheImpeller::ImageTextureCacheImpeller(size_t max_bytes)
+    : state_(std::make_shared<State>(max_bytes)) {}
+
+ImageTextureCacheImpeller::~ImageTextureCacheImpeller() = default;
+
+sk_sp<DlImage> ImageTextureCacheImpeller::MakeImage(
+    std::shared_ptr<impeller::Texture> texture,
+    TextureLoader loader) {
+  if (!texture || !loader) {
+    return nullptr;
+  }
+  return sk_make_sp<CachedImage>(state_, std::move(texture),
+                                 std::move(loader));
+}
+
+void ImageTextureCacheImpeller::PurgeUnusedTextures() {
+  TRACE_EVENT0("flutter", "ImageTextureCacheImpeller::PurgeUnusedTextures");
+  std::scoped_lock lock(state_->mutex);
+  state_->PurgeLocked(/*over_budget_only=*/false);
+}
+
+size_t ImageTextureCacheImpeller::GetResidentBytes() const {
+  std::scoped_lock lock(state_->mutex);
+  return state_->resident_bytes();
+}
+
+}  // namespace flutter
@@ -0,0 +1,74 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_TEXTURE_CACHE_IMPELLER_H_
+#define FLUTTER_LIB_UI_PAINTING_IMAGE_TEXTURE_CACHE_IMPELLER_H_
+
+#include <functional>
+#include <memory>
+
+#include "flutter/display_list/image/dl_image.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace impeller {
+class Texture;
+}  // namespace impeller
+
+namespace flutter {
+
+/// @brief  Keeps track of the textures of decoded images, so that the ones
+///         that are not drawn can be released when they exceed a byte budget
+///         or when the system is low on memory.
+///
+///         The images made by this cache keep a way to load their texture
+///         again, typically by decoding the encoded bytes they retain, and do
+///         so the next time they are drawn after their texture was purged.
+///         Images drawn in the last `kRecentUseInterval` are never purged, so
+///         the budget may be exceeded by the images on screen.
+///
+///         All the methods of this class and of the images it makes are safe
+///         to call from any thread.
+class ImageTextureCacheImpeller {
+ public:
+  /// Loads the texture of a purged image again. Called synchronously on the
+  /// thread that needs the texture, typically the raster thread.
+  using TextureLoader = std::function<std::shared_ptr<impeller::Texture>()>;
+
+  /// Images drawn within this interval are considered on screen.
+  static constexpr fml::TimeDelta kRecentUseInterval =
+      fml::TimeDelta::FromSeconds(1);
+
+  /// @param[in]  max_bytes  The budget of the resident textures, or 0 to
+  ///                        only purge them on `PurgeUnusedTextures`.
+  explicit ImageTextureCacheImpeller(size_t max_bytes);
+
+  ~ImageTextureCacheImpeller();
+
+  /// @brief  Makes an image of `texture` whose texture can be purged, and
+  ///         then loaded again with `loader`.
+  sk_sp<DlImage> MakeImage(std::shared_ptr<impeller::Texture> texture,
+                           TextureLoader loader);
+
+  /// @brief  Releases the textures of all the images that were not drawn
+  ///         recently, such as on a low memory warning.
+  void PurgeUnusedTextures();
+
+  /// @brief  The size of the textures of the images of this cache that are
+  ///         currently resident.
+  size_t GetResidentBytes() const;
+
+ private:
+  class CachedImage;
+  class State;
+
+  const std::shared_ptr<State> state_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ImageTextureCacheImpeller);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_TEXTURE_CACHE_IMPELLER_H_
@@ -0,0 +1,122 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#if IMPELLER_SUPPORTS_RENDERING
+
+#include "flutter/lib/ui/painting/image_texture_cache_impeller.h"
+
+#include "flutter/testing/testing.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "impeller/renderer/testing/mocks.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+using ::impeller::testing::MockTexture;
+using ::testing::Return;
+
+fml::TimePoint now;
+
+fml::TimePoint FakeNow() {
+  return now;
+}
+
+class ImageTextureCacheImpellerTest : public ::testing::Test {
+ public:
+  ImageTextureCacheImpellerTest() {
+    now = fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromSeconds(100));
+    fml::TimePoint::SetClockSource(FakeNow);
+  }
+
+  ~ImageTextureCacheImpellerTest() override {
+    fml::TimePoint::SetClockSource(nullptr);
+  }
+
+  void AdvanceTime(fml::TimeDelta delta) { now = now + delta; }
+
+  // A texture of 10x10 RGBA pixels, which takes 400 bytes.
+  static std::shared_ptr<impeller::Texture> MakeTexture() {
+    impeller::TextureDescriptor desc;
+    desc.size = {10, 10};
+    desc.format = impeller::PixelFormat::kR8G8B8A8UNormInt;
+    auto texture = std::make_shared<MockTexture>(desc);
+    ON_CALL(*texture, GetSize()).WillByDefault(Return(desc.size));
+    return texture;
+  }
+};
+
+}  // namespace
+
+TEST_F(ImageTextureCacheImpellerTest, PurgesUnusedTexturesOnRequest) {
+  ImageTextureCacheImpeller cache(/*max_bytes=*/0);
+  int loads = 0;
+  auto image = cache.MakeImage(MakeTexture(), [&loads] {
+    loads++;
+    return MakeTexture();
+  });
+  ASSERT_TRUE(image);
+  EXPECT_EQ(image->dimensions(), SkISize::Make(10, 10));
+  EXPECT_EQ(cache.GetResidentBytes(), 400u);
+
+  // Images drawn recently are kept.
+  cache.PurgeUnusedTextures();
+  EXPECT_EQ(cache.GetResidentBytes(), 400u);
+
+  AdvanceTime(ImageTextureCacheImpeller::kRecentUseInterval * 2);
+  cache.PurgeUnusedTextures();
+  EXPECT_EQ(cache.GetResidentBytes(), 0u);
+  EXPECT_EQ(image->dimensions(), SkISize::Make(10, 10));
+
+  // The texture is loaded again when the image is drawn.
+  EXPECT_TRUE(image->impeller_texture());
+  EXPECT_EQ(loads, 1);
+  EXPECT_EQ(cache.GetResidentBytes(), 400u);
+  EXPECT_TRUE(image->impeller_texture());
+  EXPECT_EQ(loads, 1);
+
+  image.reset();
+  EXPECT_EQ(cache.GetResidentBytes(), 0u);
+}
+
+TEST_F(ImageTextureCacheImpellerTest, EvictsLeastRecentlyUsedOverBudget) {
+  ImageTextureCacheImpeller cache(/*max_bytes=*/800);
+  auto loader = [] { return MakeTexture(); };
+  auto first = cache.MakeImage(MakeTexture(), loader);
+  AdvanceTime(ImageTextureCacheImpeller::kRecentUseInterval * 2);
+  auto second = cache.MakeImage(MakeTexture(), loader);
+  AdvanceTime(ImageTextureCacheImpeller::kRecentUseInterval * 2);
+  // Drawing the first image makes the second one the least recently used.
+  first->impeller_texture();
+  AdvanceTime(ImageTextureCacheImpeller::kRecentUseInterval * 2);
+  EXPECT_EQ(cache.GetResidentBytes(), 800u);
+
+  auto third = cache.MakeImage(MakeTexture(), loader);
+  EXPECT_EQ(cache.GetResidentBytes(), 800u);
+
+  // Drawing the second image again evicts the first one, which is no longer
+  // on screen.
+  EXPECT_TRUE(second->impeller_texture());
+  EXPECT_EQ(cache.GetResidentBytes(), 800u);
+
+  // The budget is exceeded when all the images are on screen.
+  EXPECT_TRUE(first->impeller_texture());
+  EXPECT_EQ(cache.GetResidentBytes(), 1200u);
+}
+
+TEST_F(ImageTextureCacheImpellerTest, ReturnsNullWhenReloadFails) {
+  ImageTextureCacheImpeller cache(/*max_bytes=*/0);
+  auto image = cache.MakeImage(MakeTexture(), [] { return nullptr; });
+  AdvanceTime(ImageTextureCacheImpeller::kRecentUseInterval * 2);
+  cache.PurgeUnusedTextures();
+  EXPECT_FALSE(image->impeller_texture());
+  EXPECT_EQ(cache.GetResidentBytes(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
+
+#endif  // IMPELLER_SUPPORTS_RENDERING
@@ -8,6 +8,7 @@
 #include <cstdint>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/tonic/dart_library_natives.h"
@@ -20,7 +21,8 @@ namespace flutter {
 /// A simple opaque handle to an immutable byte buffer suitable for use
 /// internally by the engine.
 ///
-/// This data is not known by the Dart VM.
+/// This data is not known by the Dart VM, other than as the external size of
+/// the wrapper of the buffer.
 ///
 /// It is expected that C++ users of this object will not modify the data
 /// argument. No Dart side calls are provided to do so.
@@ -76,6 +78,11 @@ class ImmutableBuffer : public RefCountedDartWrappable<ImmutableBuffer> {
     return data_->size();
   }
 
+  // |DartWrappable|
+  size_t GetAllocationSize() const override {
+    return sizeof(ImmutableBuffer) + (data_ ? data_->size() : 0u);
+  }
+
   /// Callers should not modify the returned data. This is not exposed to Dart.
   sk_sp<SkData> data() const { return data_; }
 
@@ -96,6 +103,12 @@ class ImmutableBuffer : public RefCountedDartWrappable<ImmutableBuffer> {
 
   static sk_sp<SkData> MakeSkDataWithCopy(const void* data, size_t length);
 
+  // Wraps a file-backed |mapping| without copying it, keeping the mapping
+  // alive until the SkData is released. Other mappings are copied with
+  // |MakeSkDataWithCopy|.
+  static sk_sp<SkData> MakeSkDataFromMapping(
+      std::unique_ptr<fml::Mapping> mapping);
+
   DEFINE_WRAPPERTYPEINFO();
   FML_FRIEND_MAKE_REF_COUNTED(ImmutableBuffer);
   FML_DISALLOW_COPY_AND_ASSIGN(ImmutableBuffer);
@@ -4,9 +4,12 @@
 
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/memory/allocation_tag.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/display_list_image_gpu.h"
 #include "flutter/lib/ui/painting/image.h"
 #if IMPELLER_SUPPORTS_RENDERING
@@ -21,19 +24,51 @@
 
 namespace flutter {
 
-MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator)
-    : state_(new State(std::move(generator))) {}
+MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator,
+                                 size_t frame_lookahead,
+                                 size_t lookahead_max_bytes)
+    : state_(new State(std::move(generator),
+                       frame_lookahead,
+                       lookahead_max_bytes)) {}
 
 MultiFrameCodec::~MultiFrameCodec() = default;
 
-MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator)
+static SkImageInfo GetFrameImageInfo(const ImageGenerator& generator) {
+  SkImageInfo info = generator.GetInfo().makeColorType(kN32_SkColorType);
+  if (info.alphaType() == kUnpremul_SkAlphaType) {
+    info = info.makeAlphaType(kPremul_SkAlphaType);
+  }
+  return info;
+}
+
+// The number of frames decoded ahead is bounded by the memory budget, and
+// there is no point in decoding the frame being returned again.
+static size_t GetFrameLookahead(const ImageGenerator& generator,
+                                int frame_count,
+                                size_t frame_lookahead,
+                                size_t lookahead_max_bytes) {
+  const size_t frame_bytes = GetFrameImageInfo(generator).computeMinByteSize();
+  if (frame_count < 2 || frame_bytes == 0) {
+    return 0;
+  }
+  return std::min({frame_lookahead, lookahead_max_bytes / frame_bytes,
+                   static_cast<size_t>(frame_count - 1)});
+}
+
+MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator,
+                              size_t frame_lookahead,
+                              size_t lookahead_max_bytes)
     : generator_(std::move(generator)),
       frameCount_(generator_->GetFrameCount()),
       repetitionCount_(generator_->GetPlayCount() ==
                                ImageGenerator::kInfinitePlayCount
                            ? -1
                            : generator_->GetPlayCount() - 1),
-      is_impeller_enabled_(UIDartState::Current()->IsImpellerEnabled()) {}
+      is_impeller_enabled_(UIDartState::Current()->IsImpellerEnabled()),
+      frameLookahead_(GetFrameLookahead(*generator_,
+                                        frameCount_,
+                                        frame_lookahead,
+                                        lookahead_max_bytes)) {}
 
 static void InvokeNextFrameCallback(
     const fml::RefPtr<CanvasImage>& image,
@@ -53,29 +88,24 @@ static void InvokeNextFrameCallback(
                      tonic::ToDart(decode_error)});
 }
 
-std::pair<sk_sp<DlImage>, std::string>
-MultiFrameCodec::State::GetNextFrameImage(
-    fml::WeakPtr<GrDirectContext> resourceContext,
-    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
-    const std::shared_ptr<impeller::Context>& impeller_context,
-    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
+MultiFrameCodec::State::DecodedFrame
+MultiFrameCodec::State::DecodeNextFrameLocked() {
+  DecodedFrame decoded_frame;
+  const int frameIndex = nextFrameIndex_;
+  nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
+
   SkBitmap bitmap = SkBitmap();
-  SkImageInfo info = generator_->GetInfo().makeColorType(kN32_SkColorType);
-  if (info.alphaType() == kUnpremul_SkAlphaType) {
-    SkImageInfo updated = info.makeAlphaType(kPremul_SkAlphaType);
-    info = updated;
-  }
+  SkImageInfo info = GetFrameImageInfo(*generator_);
   if (!bitmap.tryAllocPixels(info)) {
     std::ostringstream ostr;
     ostr << "Failed to allocate memory for bitmap of size "
          << info.computeMinByteSize() << "B";
-    std::string decode_error = ostr.str();
-    FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
+    decoded_frame.decode_error = ostr.str();
+    FML_LOG(ERROR) << decoded_frame.decode_error;
+    return decoded_frame;
   }
 
-  ImageGenerator::FrameInfo frameInfo =
-      generator_->GetFrameInfo(nextFrameIndex_);
+  ImageGenerator::FrameInfo frameInfo = generator_->GetFrameInfo(frameIndex);
 
   const int requiredFrameIndex =
       frameInfo.required_frame.value_or(SkCodec::kNoFrame);
@@ -86,7 +116,7 @@ MultiFrameCodec::State::GetNextFrameImage(
     // |requiredFrameIndex| is set to ex-frame or ex-ex-frame.
     if (!lastRequiredFrame_.has_value()) {
       FML_DLOG(INFO)
-          << "Frame " << nextFrameIndex_ << " depends on frame "
+          << "Frame " << frameIndex << " depends on frame "
           << requiredFrameIndex
           << " and no required frames are cached. Using blank slate instead.";
     } else {
@@ -102,12 +132,12 @@ MultiFrameCodec::State::GetNextFrameImage(
   // Write the new frame to the output buffer. The bitmap pixels as supplied
   // are already set in accordance with the previous frame's disposal policy.
   if (!generator_->GetPixels(info, bitmap.getPixels(), bitmap.rowBytes(),
-                             nextFrameIndex_, requiredFrameIndex)) {
+                             frameIndex, requiredFrameIndex)) {
     std::ostringstream ostr;
-    ostr << "Could not getPixels for frame " << nextFrameIndex_;
-    std::string decode_error = ostr.str();
-    FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
+    ostr << "Could not getPixels for frame " << frameIndex;
+    decoded_frame.decode_error = ostr.str();
+    FML_LOG(ERROR) << decoded_frame.decode_error;
+    return decoded_frame;
   }
 
   const bool keep_current_frame =
@@ -132,7 +162,7 @@ MultiFrameCodec::State::GetNextFrameImage(
     // Replace the stored frame. The `lastRequiredFrame_` will get used as the
     // starting backdrop for the next frame.
     lastRequiredFrame_ = bitmap;
-    lastRequiredFrameIndex_ = nextFrameIndex_;
+    lastRequiredFrameIndex_ = frameIndex;
   }
 
   if (frameInfo.disposal_method ==
@@ -142,6 +172,64 @@ MultiFrameCodec::State::GetNextFrameImage(
     restoreBGColorRect_.reset();
   }
 
+  decoded_frame.bitmap = std::move(bitmap);
+  decoded_frame.duration = frameInfo.duration;
+  return decoded_frame;
+}
+
+MultiFrameCodec::State::DecodedFrame MultiFrameCodec::State::TakeNextFrame() {
+  std::scoped_lock lock(mutex_);
+  if (decodedFrames_.empty()) {
+    return DecodeNextFrameLocked();
+  }
+  DecodedFrame decoded_frame = std::move(decodedFrames_.front());
+  decodedFrames_.pop_front();
+  return decoded_frame;
+}
+
+void MultiFrameCodec::State::DecodeAhead() {
+  TRACE_EVENT0("flutter", "MultiFrameCodec::DecodeAhead");
+  FML_ALLOCATION_TAG(kCodecs);
+  while (true) {
+    // The lock is released between frames so that a frame requested in the
+    // meantime does not wait for the whole look-ahead.
+    std::scoped_lock lock(mutex_);
+    if (decodedFrames_.size() >= frameLookahead_) {
+      lookaheadPending_ = false;
+      return;
+    }
+    decodedFrames_.push_back(DecodeNextFrameLocked());
+  }
+}
+
+void MultiFrameCodec::State::ScheduleDecodeAhead(
+    const std::shared_ptr<State>& state,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& task_runner) {
+  if (state->frameLookahead_ == 0 || !task_runner) {
+    return;
+  }
+  {
+    std::scoped_lock lock(state->mutex_);
+    if (state->lookaheadPending_ ||
+        state->decodedFrames_.size() >= state->frameLookahead_) {
+      return;
+    }
+    state->lookaheadPending_ = true;
+  }
+  // The frames decoded ahead are dropped with the codec.
+  task_runner->PostTask([weak_state = std::weak_ptr<State>(state)]() {
+    if (auto state = weak_state.lock()) {
+      state->DecodeAhead();
+    }
+  });
+}
+
+std::pair<sk_sp<DlImage>, std::string> MultiFrameCodec::State::UploadFrame(
+    const SkBitmap& bitmap,
+    fml::WeakPtr<GrDirectContext> resourceContext,
+    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
+    const std::shared_ptr<impeller::Context>& impeller_context,
+    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
 #if IMPELLER_SUPPORTS_RENDERING
   if (is_impeller_enabled_) {
     // This is safe regardless of whether the GPU is available or not because
@@ -182,28 +270,32 @@ MultiFrameCodec::State::GetNextFrameImage(
 }
 
 void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
+    const std::shared_ptr<State>& state,
     std::unique_ptr<tonic::DartPersistentValue> callback,
     const fml::RefPtr<fml::TaskRunner>& ui_task_runner,
     fml::WeakPtr<GrDirectContext> resourceContext,
     fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue,
     const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
     size_t trace_id,
-    const std::shared_ptr<impeller::Context>& impeller_context) {
+    const std::shared_ptr<impeller::Context>& impeller_context,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner) {
   fml::RefPtr<CanvasImage> image = nullptr;
   int duration = 0;
+  DecodedFrame decoded_frame = state->TakeNextFrame();
+  // Refill the look-ahead while this frame is uploaded.
+  ScheduleDecodeAhead(state, concurrent_task_runner);
   sk_sp<DlImage> dlImage;
-  std::string decode_error;
-  std::tie(dlImage, decode_error) =
-      GetNextFrameImage(std::move(resourceContext), gpu_disable_sync_switch,
-                        impeller_context, std::move(unref_queue));
+  std::string decode_error = std::move(decoded_frame.decode_error);
+  if (decoded_frame.bitmap.has_value()) {
+    std::tie(dlImage, decode_error) = state->UploadFrame(
+        decoded_frame.bitmap.value(), std::move(resourceContext),
+        gpu_disable_sync_switch, impeller_context, std::move(unref_queue));
+  }
   if (dlImage) {
     image = CanvasImage::Create();
     image->set_image(dlImage);
-    ImageGenerator::FrameInfo frameInfo =
-        generator_->GetFrameInfo(nextFrameIndex_);
-    duration = frameInfo.duration;
+    duration = decoded_frame.duration;
   }
-  nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
 
   // The static leak checker gets confused by the use of fml::MakeCopyable.
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
@@ -245,18 +337,20 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
            tonic::DartState::Current(), callback_handle),
        weak_state = std::weak_ptr<MultiFrameCodec::State>(state_), trace_id,
        ui_task_runner = task_runners.GetUITaskRunner(),
-       io_manager = dart_state->GetIOManager()]() mutable {
+       io_manager = dart_state->GetIOManager(),
+       concurrent_task_runner =
+           dart_state->GetConcurrentTaskRunner()]() mutable {
         auto state = weak_state.lock();
         if (!state) {
           ui_task_runner->PostTask(fml::MakeCopyable(
               [callback = std::move(callback)]() { callback->Clear(); }));
           return;
         }
-        state->GetNextFrameAndInvokeCallback(
-            std::move(callback), ui_task_runner,
+        State::GetNextFrameAndInvokeCallback(
+            state, std::move(callback), ui_task_runner,
             io_manager->GetResourceContext(), io_manager->GetSkiaUnrefQueue(),
             io_manager->GetIsGpuDisabledSyncSwitch(), trace_id,
-            io_manager->GetImpellerContext());
+            io_manager->GetImpellerContext(), concurrent_task_runner);
       }));
 
   return Dart_Null();
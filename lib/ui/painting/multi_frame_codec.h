@@ -5,17 +5,29 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_MULTI_FRAME_CODEC_H_
 #define FLUTTER_LIB_UI_PAINTING_MULTI_FRAME_CODEC_H_
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/painting/codec.h"
 #include "flutter/lib/ui/painting/image_generator.h"
 
+#include <deque>
+#include <mutex>
 #include <utility>
 
 namespace flutter {
 
+namespace testing {
+class ImageDecoderFixtureTest;
+}  // namespace testing
+
 class MultiFrameCodec : public Codec {
  public:
-  explicit MultiFrameCodec(std::shared_ptr<ImageGenerator> generator);
+  // Up to |frame_lookahead| frames are decoded on the concurrent task runner
+  // ahead of the requests of the framework, as long as their pixels fit in
+  // |lookahead_max_bytes|.
+  explicit MultiFrameCodec(std::shared_ptr<ImageGenerator> generator,
+                           size_t frame_lookahead = 0,
+                           size_t lookahead_max_bytes = 0);
 
   ~MultiFrameCodec() override;
 
@@ -38,17 +50,34 @@ class MultiFrameCodec : public Codec {
   // Instead, the MultiFrameCodec creates this object when it is constructed,
   // shares it with the IO task runner's decoding work, and sets the live_
   // member to false when it is destructed.
+  //
+  // Frames are decoded in order, either on the IO task runner when they are
+  // requested, or ahead of the requests on the concurrent task runner. Each
+  // frame may be composited over the previous ones depending on their disposal
+  // methods, so the decoding state is guarded by a single mutex.
   struct State {
-    explicit State(std::shared_ptr<ImageGenerator> generator);
+    State(std::shared_ptr<ImageGenerator> generator,
+          size_t frame_lookahead,
+          size_t lookahead_max_bytes);
+
+    // The pixels of a decoded frame, not yet uploaded.
+    struct DecodedFrame {
+      std::optional<SkBitmap> bitmap;
+      int duration = 0;
+      std::string decode_error;
+    };
 
     const std::shared_ptr<ImageGenerator> generator_;
     const int frameCount_;
     const int repetitionCount_;
     bool is_impeller_enabled_ = false;
+    // The number of frames that may be decoded ahead, within the memory
+    // budget.
+    const size_t frameLookahead_;
 
-    // The non-const members and functions below here are only read or written
-    // to on the IO thread. They are not safe to access or write on the UI
-    // thread.
+    // The members below here are guarded by |mutex_|.
+    std::mutex mutex_;
+    // The index of the next frame to decode.
     int nextFrameIndex_ = 0;
     // The last decoded frame that's required to decode any subsequent frames.
     std::optional<SkBitmap> lastRequiredFrame_;
@@ -58,21 +87,46 @@ class MultiFrameCodec : public Codec {
     // The rectangle that should be cleared if the previous frame's disposal
     // method was kRestoreBGColor.
     std::optional<SkIRect> restoreBGColorRect_;
-
-    std::pair<sk_sp<DlImage>, std::string> GetNextFrameImage(
+    // The frames decoded ahead, in order, starting with the next frame to
+    // return to the framework.
+    std::deque<DecodedFrame> decodedFrames_;
+    // Whether a task decoding frames ahead is posted.
+    bool lookaheadPending_ = false;
+
+    // Decodes the frame at |nextFrameIndex_|. |mutex_| must be held.
+    DecodedFrame DecodeNextFrameLocked();
+
+    // Returns the next frame to give to the framework, decoding it if it was
+    // not decoded ahead.
+    DecodedFrame TakeNextFrame();
+
+    // Decodes frames until the look-ahead is full. Runs on the concurrent task
+    // runner.
+    void DecodeAhead();
+
+    // Posts a task decoding frames ahead if the look-ahead is not full.
+    static void ScheduleDecodeAhead(
+        const std::shared_ptr<State>& state,
+        const std::shared_ptr<fml::ConcurrentTaskRunner>& task_runner);
+
+    std::pair<sk_sp<DlImage>, std::string> UploadFrame(
+        const SkBitmap& bitmap,
         fml::WeakPtr<GrDirectContext> resourceContext,
         const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
         const std::shared_ptr<impeller::Context>& impeller_context,
         fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue);
 
-    void GetNextFrameAndInvokeCallback(
+    static void GetNextFrameAndInvokeCallback(
+        const std::shared_ptr<State>& state,
         std::unique_ptr<tonic::DartPersistentValue> callback,
         const fml::RefPtr<fml::TaskRunner>& ui_task_runner,
         fml::WeakPtr<GrDirectContext> resourceContext,
         fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue,
         const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
         size_t trace_id,
-        const std::shared_ptr<impeller::Context>& impeller_context);
+        const std::shared_ptr<impeller::Context>& impeller_context,
+        const std::shared_ptr<fml::ConcurrentTaskRunner>&
+            concurrent_task_runner);
   };
 
   // Shared across the UI and IO task runners.
@@ -80,6 +134,7 @@ class MultiFrameCodec : public Codec {
 
   FML_FRIEND_MAKE_REF_COUNTED(MultiFrameCodec);
   FML_FRIEND_REF_COUNTED_THREAD_SAFE(MultiFrameCodec);
+  friend class testing::ImageDecoderFixtureTest;
 };
 
 }  // namespace flutter
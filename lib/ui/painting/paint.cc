@@ -34,8 +34,8 @@ constexpr int kMaskFilterIndex = 9;
 constexpr int kMaskFilterBlurStyleIndex = 10;
 constexpr int kMaskFilterSigmaIndex = 11;
 constexpr int kInvertColorIndex = 12;
-constexpr size_t kDataByteCount = 52;  // 4 * (last index + 1)
-static_assert(kDataByteCount == sizeof(uint32_t) * (kInvertColorIndex + 1),
+static_assert(Paint::kDataByteCount ==
+                  sizeof(uint32_t) * (kInvertColorIndex + 1),
               "kDataByteCount must match the size of the data array.");
 
 // Indices for objects.
@@ -58,79 +58,12 @@ constexpr float kStrokeMiterLimitDefault = 4.0f;
 // Must be kept in sync with the MaskFilter private constants in painting.dart.
 enum MaskFilterType { kNull, kBlur };
 
-Paint::Paint(Dart_Handle paint_objects, Dart_Handle paint_data)
-    : paint_objects_(paint_objects), paint_data_(paint_data) {}
-
-const DlPaint* Paint::paint(DlPaint& paint,
-                            const DisplayListAttributeFlags& flags) const {
-  if (isNull()) {
-    return nullptr;
-  }
-  tonic::DartByteData byte_data(paint_data_);
-  FML_CHECK(byte_data.length_in_bytes() == kDataByteCount);
-
-  const uint32_t* uint_data = static_cast<const uint32_t*>(byte_data.data());
-  const float* float_data = static_cast<const float*>(byte_data.data());
+namespace {
 
-  Dart_Handle values[kObjectCount];
-  if (Dart_IsNull(paint_objects_)) {
-    if (flags.applies_shader()) {
-      paint.setColorSource(nullptr);
-    }
-    if (flags.applies_color_filter()) {
-      paint.setColorFilter(nullptr);
-    }
-    if (flags.applies_image_filter()) {
-      paint.setImageFilter(nullptr);
-    }
-  } else {
-    FML_DCHECK(Dart_IsList(paint_objects_));
-    intptr_t length = 0;
-    Dart_ListLength(paint_objects_, &length);
-
-    FML_CHECK(length == kObjectCount);
-    if (Dart_IsError(
-            Dart_ListGetRange(paint_objects_, 0, kObjectCount, values))) {
-      return nullptr;
-    }
-
-    if (flags.applies_shader()) {
-      Dart_Handle shader = values[kShaderIndex];
-      if (Dart_IsNull(shader)) {
-        paint.setColorSource(nullptr);
-      } else {
-        if (Shader* decoded = tonic::DartConverter<Shader*>::FromDart(shader)) {
-          auto sampling =
-              ImageFilter::SamplingFromIndex(uint_data[kFilterQualityIndex]);
-          paint.setColorSource(decoded->shader(sampling));
-        } else {
-          paint.setColorSource(nullptr);
-        }
-      }
-    }
-
-    if (flags.applies_color_filter()) {
-      Dart_Handle color_filter = values[kColorFilterIndex];
-      if (Dart_IsNull(color_filter)) {
-        paint.setColorFilter(nullptr);
-      } else {
-        ColorFilter* decoded =
-            tonic::DartConverter<ColorFilter*>::FromDart(color_filter);
-        paint.setColorFilter(decoded->filter());
-      }
-    }
-
-    if (flags.applies_image_filter()) {
-      Dart_Handle image_filter = values[kImageFilterIndex];
-      if (Dart_IsNull(image_filter)) {
-        paint.setImageFilter(nullptr);
-      } else {
-        ImageFilter* decoded =
-            tonic::DartConverter<ImageFilter*>::FromDart(image_filter);
-        paint.setImageFilter(decoded->filter());
-      }
-    }
-  }
+void DecodeData(DlPaint& paint,
+                const DisplayListAttributeFlags& flags,
+                const uint32_t* uint_data) {
+  const float* float_data = reinterpret_cast<const float*>(uint_data);
 
   if (flags.applies_anti_alias()) {
     paint.setAntiAlias(uint_data[kIsAntiAliasIndex] == 0);
@@ -190,10 +123,162 @@ const DlPaint* Paint::paint(DlPaint& paint,
         break;
     }
   }
+}
+
+}  // namespace
+
+Paint::Paint(Dart_Handle paint_objects, Dart_Handle paint_data)
+    : paint_objects_(paint_objects), paint_data_(paint_data) {}
 
+bool Paint::Key::operator==(const Key& other) const {
+  return memcmp(data, other.data, sizeof(data)) == 0 &&
+         shader == other.shader && color_filter == other.color_filter &&
+         image_filter == other.image_filter;
+}
+
+const DlPaint* Paint::paint(DlPaint& paint,
+                            const DisplayListAttributeFlags& flags) const {
+  Key key;
+  if (!getKey(key)) {
+    return nullptr;
+  }
+  return paintFromKey(paint, flags, key);
+}
+
+bool Paint::getKey(Key& key) const {
+  if (isNull()) {
+    return false;
+  }
+  {
+    tonic::DartByteData byte_data(paint_data_);
+    FML_CHECK(byte_data.length_in_bytes() == kDataByteCount);
+    memcpy(key.data, byte_data.data(), kDataByteCount);
+  }
+
+  key.shader = nullptr;
+  key.color_filter = nullptr;
+  key.image_filter = nullptr;
+  if (Dart_IsNull(paint_objects_)) {
+    return true;
+  }
+
+  Dart_Handle values[kObjectCount];
+  FML_DCHECK(Dart_IsList(paint_objects_));
+  intptr_t length = 0;
+  Dart_ListLength(paint_objects_, &length);
+
+  FML_CHECK(length == kObjectCount);
+  if (Dart_IsError(
+          Dart_ListGetRange(paint_objects_, 0, kObjectCount, values))) {
+    return false;
+  }
+
+  Dart_Handle shader = values[kShaderIndex];
+  if (!Dart_IsNull(shader)) {
+    key.shader = fml::Ref(tonic::DartConverter<Shader*>::FromDart(shader));
+  }
+  Dart_Handle color_filter = values[kColorFilterIndex];
+  if (!Dart_IsNull(color_filter)) {
+    key.color_filter =
+        fml::Ref(tonic::DartConverter<ColorFilter*>::FromDart(color_filter));
+  }
+  Dart_Handle image_filter = values[kImageFilterIndex];
+  if (!Dart_IsNull(image_filter)) {
+    key.image_filter =
+        fml::Ref(tonic::DartConverter<ImageFilter*>::FromDart(image_filter));
+  }
+  return true;
+}
+
+const DlPaint* Paint::paintFromKey(DlPaint& paint,
+                                   const DisplayListAttributeFlags& flags,
+                                   const Key& key) {
+  if (flags.applies_shader()) {
+    if (key.shader) {
+      auto sampling =
+          ImageFilter::SamplingFromIndex(key.data[kFilterQualityIndex]);
+      paint.setColorSource(key.shader->shader(sampling));
+    } else {
+      paint.setColorSource(nullptr);
+    }
+  }
+
+  if (flags.applies_color_filter()) {
+    paint.setColorFilter(key.color_filter ? key.color_filter->filter()
+                                          : nullptr);
+  }
+
+  if (flags.applies_image_filter()) {
+    paint.setImageFilter(key.image_filter ? key.image_filter->filter()
+                                          : nullptr);
+  }
+
+  DecodeData(paint, flags, key.data);
+  return &paint;
+}
+
+const DlPaint* Paint::paintWithoutObjects(
+    DlPaint& paint,
+    const DisplayListAttributeFlags& flags,
+    const uint32_t* data) {
+  if (flags.applies_shader()) {
+    paint.setColorSource(nullptr);
+  }
+  if (flags.applies_color_filter()) {
+    paint.setColorFilter(nullptr);
+  }
+  if (flags.applies_image_filter()) {
+    paint.setImageFilter(nullptr);
+  }
+  DecodeData(paint, flags, data);
   return &paint;
 }
 
+PaintCache::Entry& PaintCache::entryFor(
+    const DisplayListAttributeFlags& flags) {
+  for (Entry& entry : entries_) {
+    if (entry.flags == flags) {
+      return entry;
+    }
+  }
+  entries_.push_back(Entry{flags});
+  return entries_.back();
+}
+
+const DlPaint* PaintCache::paint(const Paint& paint,
+                                 const DisplayListAttributeFlags& flags) {
+  if (!paint.getKey(scratch_key_)) {
+    return nullptr;
+  }
+  Entry& entry = entryFor(flags);
+  if (entry.has_key && entry.key == scratch_key_) {
+    return &entry.paint;
+  }
+  entry.paint = DlPaint();
+  Paint::paintFromKey(entry.paint, flags, scratch_key_);
+  // A mutable shader can produce a different color source for the same key.
+  entry.has_key = !scratch_key_.shader || scratch_key_.shader->is_immutable();
+  std::swap(entry.key, scratch_key_);
+  return &entry.paint;
+}
+
+const DlPaint* PaintCache::paintWithoutObjects(
+    const DisplayListAttributeFlags& flags,
+    const uint32_t* data) {
+  Entry& entry = entryFor(flags);
+  if (entry.has_key && !entry.key.shader && !entry.key.color_filter &&
+      !entry.key.image_filter &&
+      memcmp(entry.key.data, data, Paint::kDataByteCount) == 0) {
+    return &entry.paint;
+  }
+  entry.paint = DlPaint();
+  Paint::paintWithoutObjects(entry.paint, flags, data);
+  entry.key = Paint::Key();
+  memcpy(entry.key.data, data, Paint::kDataByteCount);
+  entry.has_key = true;
+  return &entry.paint;
+}
+
 void Paint::toDlPaint(DlPaint& paint) const {
   if (isNull()) {
     return;
@@ -5,8 +5,12 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_PAINT_H_
 #define FLUTTER_LIB_UI_PAINTING_PAINT_H_
 
+#include <vector>
+
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_op_flags.h"
+#include "flutter/lib/ui/painting/image_filter.h"
+#include "flutter/lib/ui/painting/shader.h"
 #include "third_party/skia/include/core/SkPaint.h"
 #include "third_party/tonic/converter/dart_converter.h"
 
@@ -14,6 +18,22 @@ namespace flutter {
 
 class Paint {
  public:
+  // The size of the data encoded by the Paint class of painting.dart.
+  static constexpr size_t kDataByteCount = 52;
+
+  // Everything a Paint decodes to a DlPaint from: its data and the native
+  // peers of its objects. Holding the peers keeps their addresses from being
+  // reused by other objects while the key is alive.
+  struct Key {
+    uint32_t data[kDataByteCount / sizeof(uint32_t)] = {};
+    fml::RefPtr<Shader> shader;
+    fml::RefPtr<ColorFilter> color_filter;
+    fml::RefPtr<ImageFilter> image_filter;
+
+    bool operator==(const Key& other) const;
+    bool operator!=(const Key& other) const { return !(*this == other); }
+  };
+
   Paint() = default;
   Paint(Dart_Handle paint_objects, Dart_Handle paint_data);
 
@@ -22,6 +42,22 @@ class Paint {
 
   void toDlPaint(DlPaint& paint) const;
 
+  // Reads the data and objects of a non-null paint into |key|. Returns false
+  // if the paint is null or its objects could not be read.
+  bool getKey(Key& key) const;
+
+  // Decodes a |key| obtained from |getKey| into |paint|.
+  static const DlPaint* paintFromKey(DlPaint& paint,
+                                     const DisplayListAttributeFlags& flags,
+                                     const Key& key);
+
+  // Decodes the |data| of a paint whose shader, color filter and image filter
+  // are all null, without any call to the Dart API.
+  static const DlPaint* paintWithoutObjects(
+      DlPaint& paint,
+      const DisplayListAttributeFlags& flags,
+      const uint32_t* data);
+
   bool isNull() const { return Dart_IsNull(paint_data_); }
   bool isNotNull() const { return !Dart_IsNull(paint_data_); }
 
@@ -32,6 +68,42 @@ class Paint {
   Dart_Handle paint_data_;
 };
 
+// Remembers the DlPaint that a Canvas last decoded for each set of attribute
+// flags, so that drawing repeatedly with an unchanged Paint reuses the decoded
+// paint (and the color source, filters and mask filter it holds) instead of
+// decoding it again.
+class PaintCache {
+ public:
+  PaintCache() = default;
+
+  // Like |Paint::paint|, but the returned DlPaint is owned by the cache and
+  // is only valid until the next call.
+  const DlPaint* paint(const Paint& paint,
+                       const DisplayListAttributeFlags& flags);
+
+  // Like |Paint::paintWithoutObjects|, with the same lifetime as |paint|.
+  const DlPaint* paintWithoutObjects(const DisplayListAttributeFlags& flags,
+                                     const uint32_t* data);
+
+  // Releases the decoded paints and the objects they hold.
+  void clear() { entries_.clear(); }
+
+ private:
+  struct Entry {
+    DisplayListAttributeFlags flags;
+    Paint::Key key;
+    bool has_key = false;
+    DlPaint paint;
+  };
+
+  std::vector<Entry> entries_;
+  Paint::Key scratch_key_;
+
+  Entry& entryFor(const DisplayListAttributeFlags& flags);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PaintCache);
+};
+
 // The PaintData argument is a placeholder to receive encoded data for Paint
 // objects. The data is actually processed by DartConverter<Paint>, which reads
 // both at the given index and at the next index (which it assumes is a byte
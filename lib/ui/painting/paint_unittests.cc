@@ -58,5 +58,30 @@ TEST_F(ShellTest, ConvertPaintToDlPaint) {
   ASSERT_EQ(dl_paint.getDrawStyle(), DlDrawStyle::kStroke);
 }
 
+TEST(PaintCacheTest, ReusesPaintsWithUnchangedData) {
+  PaintCache cache;
+  uint32_t data[Paint::kDataByteCount / sizeof(uint32_t)] = {};
+
+  const DlPaint* first =
+      cache.paintWithoutObjects(DisplayListOpFlags::kDrawRectFlags, data);
+  ASSERT_EQ(*first, DlPaint());
+  const DlPaint* second =
+      cache.paintWithoutObjects(DisplayListOpFlags::kDrawRectFlags, data);
+  ASSERT_EQ(first, second);
+
+  // The color is encoded XORed with opaque black.
+  data[1] = 0xFF000000 ^ 0xFF112233;
+  const DlPaint* changed =
+      cache.paintWithoutObjects(DisplayListOpFlags::kDrawRectFlags, data);
+  ASSERT_EQ(changed->getColor(), DlColor(0xFF112233));
+
+  const DlPaint* other_flags =
+      cache.paintWithoutObjects(DisplayListOpFlags::kDrawOvalFlags, data);
+  ASSERT_EQ(other_flags->getColor(), DlColor(0xFF112233));
+  ASSERT_EQ(cache.paintWithoutObjects(DisplayListOpFlags::kDrawRectFlags, data)
+                ->getColor(),
+            DlColor(0xFF112233));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -36,7 +36,8 @@ void PictureRecorder::endRecording(Dart_Handle dart_picture) {
     return;
   }
 
-  auto display_list = display_list_builder_->Build();
+  canvas_->flushBatch();
+  auto display_list = display_list_builder_->Build(/*compact=*/true);
   display_list_builder_ = nullptr;
 
   FML_DCHECK(display_list->has_rtree());
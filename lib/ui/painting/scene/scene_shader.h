@@ -33,6 +33,9 @@ class SceneShader : public Shader {
   // |Shader|
   std::shared_ptr<DlColorSource> shader(DlImageSampling) override;
 
+  // |Shader|
+  bool is_immutable() const override { return false; }
+
  private:
   explicit SceneShader(fml::RefPtr<SceneNode> scene_node);
 
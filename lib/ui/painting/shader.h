@@ -19,6 +19,11 @@ class Shader : public RefCountedDartWrappable<Shader> {
 
   virtual std::shared_ptr<DlColorSource> shader(DlImageSampling) = 0;
 
+  // Whether |shader| keeps returning equivalent color sources, which allows a
+  // paint decoded with this shader to be reused. Shaders whose inputs can be
+  // changed after creation must return false.
+  virtual bool is_immutable() const { return true; }
+
  protected:
   Shader() {}
 };
@@ -1621,6 +1621,15 @@ enum _FrameTimingInfo {
   /// The number of bytes used to cache pictures during the frame.
   pictureCacheBytes,
 
+  /// The number of engine layers rasterized during the frame.
+  layerCount,
+
+  /// The number of display list operations rasterized during the frame.
+  displayListOpCount,
+
+  /// The number of offscreen passes rendered during the frame.
+  offscreenPassCount,
+
   /// The frame number of the frame.
   frameNumber,
 }
@@ -1656,6 +1665,9 @@ class FrameTiming {
     int layerCacheBytes = 0,
     int pictureCacheCount = 0,
     int pictureCacheBytes = 0,
+    int layerCount = 0,
+    int displayListOpCount = 0,
+    int offscreenPassCount = 0,
     int frameNumber = -1,
   }) {
     return FrameTiming._(<int>[
@@ -1669,6 +1681,9 @@ class FrameTiming {
       layerCacheBytes,
       pictureCacheCount,
       pictureCacheBytes,
+      layerCount,
+      displayListOpCount,
+      offscreenPassCount,
       frameNumber,
     ]);
   }
@@ -1759,6 +1774,28 @@ class FrameTiming {
   /// See also [layerCacheCount], [layerCacheBytes], [pictureCacheCount] and [pictureCacheBytes].
   double get pictureCacheMegabytes => pictureCacheBytes / 1024.0 / 1024.0;
 
+  /// The number of engine layers in the layer trees rasterized for the frame.
+  ///
+  /// Together with [displayListOpCount] and [offscreenPassCount], this
+  /// describes how complex the frame was to rasterize, which helps to explain
+  /// its [rasterDuration].
+  int get layerCount => _rawInfo(_FrameTimingInfo.layerCount);
+
+  /// The number of drawing operations in the pictures of the layers
+  /// rasterized for the frame, including those of nested pictures.
+  ///
+  /// See also [layerCount] and [offscreenPassCount].
+  int get displayListOpCount => _rawInfo(_FrameTimingInfo.displayListOpCount);
+
+  /// The number of times the frame was rendered to an offscreen texture and
+  /// composited back, for example for a [Canvas.saveLayer] that could not be
+  /// applied directly.
+  ///
+  /// This is only counted by the Impeller renderer and is zero otherwise.
+  ///
+  /// See also [layerCount] and [displayListOpCount].
+  int get offscreenPassCount => _rawInfo(_FrameTimingInfo.offscreenPassCount);
+
   /// The frame key associated with this frame measurement.
   int get frameNumber => _data.last;
 
@@ -1776,6 +1813,9 @@ class FrameTiming {
         'layerCacheBytes: $layerCacheBytes, '
         'pictureCacheCount: $pictureCacheCount, '
         'pictureCacheBytes: $pictureCacheBytes, '
+        'layerCount: $layerCount, '
+        'displayListOpCount: $displayListOpCount, '
+        'offscreenPassCount: $offscreenPassCount, '
         'frameNumber: ${_data.last})';
   }
 }
@@ -5,6 +5,7 @@
 #include "flutter/lib/ui/semantics/semantics_update_builder.h"
 
 #include <utility>
+#include "flutter/fml/memory/allocation_tag.h"
 
 #include "flutter/lib/ui/floating_point.h"
 #include "flutter/lib/ui/ui_dart_state.h"
@@ -67,6 +68,7 @@ void SemanticsUpdateBuilder::updateNode(
     const tonic::Int32List& childrenInTraversalOrder,
     const tonic::Int32List& childrenInHitTestOrder,
     const tonic::Int32List& localContextActions) {
+  FML_ALLOCATION_TAG(kSemantics);
   FML_CHECK(scrollChildren == 0 ||
             (scrollChildren > 0 && childrenInHitTestOrder.data()))
       << "Semantics update contained scrollChildren but did not have "
@@ -117,7 +119,7 @@ void SemanticsUpdateBuilder::updateNode(
   node.customAccessibilityActions = std::vector<int32_t>(
       localContextActions.data(),
       localContextActions.data() + localContextActions.num_elements());
-  nodes_[id] = node;
+  nodes_[id] = std::move(node);
 }
 
 void SemanticsUpdateBuilder::updateCustomAction(int id,
@@ -129,7 +131,7 @@ void SemanticsUpdateBuilder::updateCustomAction(int id,
   action.overrideId = overrideId;
   action.label = std::move(label);
   action.hint = std::move(hint);
-  actions_[id] = action;
+  actions_[id] = std::move(action);
 }
 
 void SemanticsUpdateBuilder::build(Dart_Handle semantics_update_handle) {
@@ -2995,6 +2995,33 @@ abstract class Paragraph {
   /// The [ParagraphConstraints] control how wide the text is allowed to be.
   void layout(ParagraphConstraints constraints);
 
+  /// Lays out each of the [paragraphs] with the constraints at the same index
+  /// of [constraints], as if [layout] was called on each of them.
+  ///
+  /// The text of the paragraphs is shaped on multiple threads at once, which
+  /// is faster than laying them out one at a time when many new paragraphs
+  /// are laid out in the same frame. This returns once all the paragraphs
+  /// are laid out.
+  static void layoutAll(List<Paragraph> paragraphs, List<ParagraphConstraints> constraints) {
+    assert(paragraphs.length == constraints.length);
+    if (paragraphs.any((Paragraph paragraph) => paragraph is! _NativeParagraph)) {
+      for (int i = 0; i < paragraphs.length; i++) {
+        paragraphs[i].layout(constraints[i]);
+      }
+      return;
+    }
+    _NativeParagraph._layoutAll(
+      paragraphs,
+      <double>[for (final ParagraphConstraints constraint in constraints) constraint.width],
+    );
+    assert(() {
+      for (final Paragraph paragraph in paragraphs) {
+        (paragraph as _NativeParagraph)._needsLayout = false;
+      }
+      return true;
+    }());
+  }
+
   /// Returns a list of text boxes that enclose the given text range.
   ///
   /// The [boxHeightStyle] and [boxWidthStyle] parameters allow customization
@@ -3167,6 +3194,9 @@ base class _NativeParagraph extends NativeFieldWrapperClass1 implements Paragrap
   @Native<Void Function(Pointer<Void>, Double)>(symbol: 'Paragraph::layout', isLeaf: true)
   external void _layout(double width);
 
+  @Native<Void Function(Handle, Handle)>(symbol: 'Paragraph::layoutAll')
+  external static void _layoutAll(List<Paragraph> paragraphs, List<double> widths);
+
   List<TextBox> _decodeTextBoxes(Float32List encoded) {
     final int count = encoded.length ~/ 5;
     final List<TextBox> boxes = <TextBox>[];
@@ -76,21 +76,33 @@ AssetManagerFontStyleSet::AssetManagerFontStyleSet(
 AssetManagerFontStyleSet::~AssetManagerFontStyleSet() = default;
 
 void AssetManagerFontStyleSet::registerAsset(const std::string& asset) {
+  std::scoped_lock lock(mutex_);
   assets_.emplace_back(asset);
 }
 
 int AssetManagerFontStyleSet::count() {
+  std::scoped_lock lock(mutex_);
   return assets_.size();
 }
 
 void AssetManagerFontStyleSet::getStyle(int index,
                                         SkFontStyle* style,
                                         SkString* name) {
+  std::scoped_lock lock(mutex_);
   FML_DCHECK(index < static_cast<int>(assets_.size()));
   if (style) {
-    sk_sp<SkTypeface> typeface(createTypeface(index));
-    if (typeface) {
-      *style = typeface->fontStyle();
+    TypefaceAsset& asset = assets_[index];
+    if (!asset.style) {
+      // Matching a style reads the styles of all the typefaces of the family,
+      // of which only the matched one is kept.
+      sk_sp<SkTypeface> typeface =
+          asset.typeface ? asset.typeface : LoadTypeface(asset);
+      if (typeface) {
+        asset.style = typeface->fontStyle();
+      }
+    }
+    if (asset.style) {
+      *style = asset.style.value();
     }
   }
   if (name) {
@@ -99,6 +111,7 @@ void AssetManagerFontStyleSet::getStyle(int index,
 }
 
 auto AssetManagerFontStyleSet::createTypeface(int i) -> CreateTypefaceRet {
+  std::scoped_lock lock(mutex_);
   size_t index = i;
   if (index >= assets_.size()) {
     return nullptr;
@@ -106,31 +119,42 @@ auto AssetManagerFontStyleSet::createTypeface(int i) -> CreateTypefaceRet {
 
   TypefaceAsset& asset = assets_[index];
   if (!asset.typeface) {
-    std::unique_ptr<fml::Mapping> asset_mapping =
-        asset_manager_->GetAsMapping(asset.asset);
-    if (asset_mapping == nullptr) {
-      return nullptr;
-    }
-
-    fml::Mapping* asset_mapping_ptr = asset_mapping.release();
-    sk_sp<SkData> asset_data = SkData::MakeWithProc(
-        asset_mapping_ptr->GetMapping(), asset_mapping_ptr->GetSize(),
-        MappingReleaseProc, asset_mapping_ptr);
-    std::unique_ptr<SkMemoryStream> stream = SkMemoryStream::Make(asset_data);
-
-    sk_sp<SkFontMgr> font_mgr = txt::GetDefaultFontManager();
-    // Ownership of the stream is transferred.
-    asset.typeface = font_mgr->makeFromStream(std::move(stream));
+    asset.typeface = LoadTypeface(asset);
     if (!asset.typeface) {
-      FML_DLOG(ERROR) << "Unable to load font asset for family: "
-                      << family_name_;
       return nullptr;
     }
+    asset.style = asset.typeface->fontStyle();
   }
 
   return CreateTypefaceRet(SkRef(asset.typeface.get()));
 }
 
+sk_sp<SkTypeface> AssetManagerFontStyleSet::LoadTypeface(
+    const TypefaceAsset& asset) const {
+  // The asset resolvers map the files of the assets, of which the typefaces
+  // only read the pages of the tables they use.
+  std::unique_ptr<fml::Mapping> asset_mapping =
+      asset_manager_->GetAsMapping(asset.asset);
+  if (asset_mapping == nullptr) {
+    return nullptr;
+  }
+
+  fml::Mapping* asset_mapping_ptr = asset_mapping.release();
+  sk_sp<SkData> asset_data = SkData::MakeWithProc(
+      asset_mapping_ptr->GetMapping(), asset_mapping_ptr->GetSize(),
+      MappingReleaseProc, asset_mapping_ptr);
+  std::unique_ptr<SkMemoryStream> stream = SkMemoryStream::Make(asset_data);
+
+  sk_sp<SkFontMgr> font_mgr = txt::GetDefaultFontManager();
+  // Ownership of the stream is transferred.
+  sk_sp<SkTypeface> typeface = font_mgr->makeFromStream(std::move(stream));
+  if (!typeface) {
+    FML_DLOG(ERROR) << "Unable to load font asset for family: "
+                    << family_name_;
+  }
+  return typeface;
+}
+
 auto AssetManagerFontStyleSet::matchStyle(const SkFontStyle& pattern)
     -> MatchStyleRet {
   return matchStyleCSS3(pattern);
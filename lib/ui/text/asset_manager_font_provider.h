@@ -6,6 +6,8 @@
 #define FLUTTER_LIB_UI_TEXT_ASSET_MANAGER_FONT_PROVIDER_H_
 
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -55,10 +57,19 @@ class AssetManagerFontStyleSet : public SkFontStyleSet {
     ~TypefaceAsset();
 
     std::string asset;
+    // Only kept once the typeface is used, rather than when its style is
+    // matched against those of the other typefaces of the family.
     sk_sp<SkTypeface> typeface;
+    std::optional<SkFontStyle> style;
   };
+  // Guards the typefaces and styles, which are loaded by the threads that
+  // lay out paragraphs.
+  std::mutex mutex_;
   std::vector<TypefaceAsset> assets_;
 
+  // Makes a typeface of the mapping of the asset, or returns null.
+  sk_sp<SkTypeface> LoadTypeface(const TypefaceAsset& asset) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManagerFontStyleSet);
 };
 
@@ -6,6 +6,7 @@
 
 #include <mutex>
 
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/text/asset_manager_font_provider.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_configuration.h"
@@ -47,9 +48,30 @@ std::shared_ptr<txt::FontCollection> FontCollection::GetFontCollection() const {
 
 void FontCollection::SetupDefaultFontManager(
     uint32_t font_initialization_data) {
+  // A pending prefetch would overwrite the font manager created here.
+  prefetched_default_font_manager_ = {};
   collection_->SetupDefaultFontManager(font_initialization_data);
 }
 
+void FontCollection::PrefetchDefaultFontManager(
+    uint32_t font_initialization_data,
+    const std::shared_ptr<fml::BasicTaskRunner>& task_runner) {
+  auto promise = std::make_shared<std::promise<sk_sp<SkFontMgr>>>();
+  prefetched_default_font_manager_ = promise->get_future();
+  task_runner->PostTask([promise, font_initialization_data]() {
+    TRACE_EVENT0("flutter", "FontCollection::PrefetchDefaultFontManager");
+    promise->set_value(txt::GetDefaultFontManager(font_initialization_data));
+  });
+}
+
+void FontCollection::WaitForDefaultFontManager() {
+  if (!prefetched_default_font_manager_.valid()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "FontCollection::WaitForDefaultFontManager");
+  collection_->SetDefaultFontManager(prefetched_default_font_manager_.get());
+}
+
 // Font manifest yaml format:
 //
 // flutter:
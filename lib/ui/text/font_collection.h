@@ -5,11 +5,13 @@
 #ifndef FLUTTER_LIB_UI_TEXT_FONT_COLLECTION_H_
 #define FLUTTER_LIB_UI_TEXT_FONT_COLLECTION_H_
 
+#include <future>
 #include <memory>
 #include <vector>
 
 #include "flutter/assets/asset_manager.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "third_party/tonic/typed_data/typed_list.h"
 #include "txt/font_collection.h"
@@ -26,6 +28,17 @@ class FontCollection {
 
   void SetupDefaultFontManager(uint32_t font_initialization_data);
 
+  // Starts creating the default font manager on |task_runner|. The font
+  // manager is set once |WaitForDefaultFontManager| is called.
+  void PrefetchDefaultFontManager(
+      uint32_t font_initialization_data,
+      const std::shared_ptr<fml::BasicTaskRunner>& task_runner);
+
+  // Waits for the font manager started by |PrefetchDefaultFontManager| and
+  // sets it as the default font manager. Does nothing if no prefetch is
+  // pending.
+  void WaitForDefaultFontManager();
+
   void RegisterFonts(const std::shared_ptr<AssetManager>& asset_manager);
 
   void RegisterTestFonts();
@@ -37,6 +50,7 @@ class FontCollection {
  private:
   std::shared_ptr<txt::FontCollection> collection_;
   sk_sp<txt::DynamicFontManager> dynamic_font_manager_;
+  std::future<sk_sp<SkFontMgr>> prefetched_default_font_manager_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(FontCollection);
 };
@@ -4,10 +4,18 @@
 
 #include "flutter/lib/ui/text/paragraph.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/dart/runtime/include/dart_api.h"
 #include "third_party/skia/modules/skparagraph/include/DartTypes.h"
 #include "third_party/skia/modules/skparagraph/include/Paragraph.h"
@@ -62,6 +70,81 @@ void Paragraph::layout(double width) {
   m_paragraph_->Layout(width);
 }
 
+namespace {
+
+// The layout tasks of a batch of paragraphs, which are pulled in order by the
+// calling thread and the workers helping it.
+struct ConcurrentLayouts {
+  explicit ConcurrentLayouts(std::vector<std::function<void()>> p_tasks)
+      : tasks(std::move(p_tasks)), latch(tasks.size()) {}
+
+  // Runs the remaining tasks, and returns once none is left to start.
+  void Run() {
+    for (size_t index = next.fetch_add(1); index < tasks.size();
+         index = next.fetch_add(1)) {
+      tasks[index]();
+      latch.CountDown();
+    }
+  }
+
+  std::vector<std::function<void()>> tasks;
+  std::atomic_size_t next = 0;
+  fml::CountDownLatch latch;
+};
+
+}  // namespace
+
+void Paragraph::layoutAll(Dart_Handle paragraphs_handle,
+                          Dart_Handle widths_handle) {
+  TRACE_EVENT0("flutter", "Paragraph::layoutAll");
+  const auto widths =
+      tonic::DartConverter<std::vector<double>>::FromDart(widths_handle);
+  intptr_t count = 0;
+  if (Dart_IsError(Dart_ListLength(paragraphs_handle, &count)) ||
+      static_cast<size_t>(count) != widths.size()) {
+    FML_LOG(ERROR) << "Each paragraph to lay out must have a width.";
+    return;
+  }
+
+  // The paragraphs that cannot be laid out on another thread are laid out
+  // first, on this thread.
+  std::vector<std::function<void()>> tasks;
+  for (intptr_t i = 0; i < count; i++) {
+    auto* paragraph = tonic::DartConverter<Paragraph*>::FromDart(
+        Dart_ListGetAt(paragraphs_handle, i));
+    if (!paragraph || !paragraph->m_paragraph_) {
+      continue;
+    }
+    if (auto task =
+            paragraph->m_paragraph_->PrepareConcurrentLayout(widths[i])) {
+      tasks.push_back(std::move(task));
+    } else {
+      paragraph->layout(widths[i]);
+    }
+  }
+
+  auto runner = UIDartState::Current()->GetConcurrentTaskRunner();
+  if (tasks.size() < 2 || !runner) {
+    for (const auto& task : tasks) {
+      task();
+    }
+    return;
+  }
+
+  auto layouts = std::make_shared<ConcurrentLayouts>(std::move(tasks));
+  const size_t worker_count = std::min<size_t>(
+      layouts->tasks.size() - 1,
+      std::max(std::thread::hardware_concurrency(), 1u));
+  for (size_t i = 0; i < worker_count; i++) {
+    // Workers that only start once this thread ran out of tasks find none
+    // left, and only keep the shared state alive.
+    runner->PostTask([layouts]() { layouts->Run(); },
+                     fml::ConcurrentTaskPriority::kHigh);
+  }
+  layouts->Run();
+  layouts->latch.Wait();
+}
+
 void Paragraph::paint(Canvas* canvas, double x, double y) {
   if (!m_paragraph_ || !canvas) {
     // disposed.
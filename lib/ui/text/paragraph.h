@@ -26,6 +26,14 @@ class Paragraph : public RefCountedDartWrappable<Paragraph> {
 
   ~Paragraph() override;
 
+  /// @brief  Lays out each of the `paragraphs_handle` list of paragraphs with
+  ///         the width at the same index of the `widths_handle` list. The
+  ///         paragraphs are shaped on the concurrent task runner and the
+  ///         calling thread in parallel, and are all laid out when this
+  ///         returns.
+  static void layoutAll(Dart_Handle paragraphs_handle,
+                        Dart_Handle widths_handle);
+
   double width();
   double height();
   double longestLine();
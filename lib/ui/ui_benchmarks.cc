@@ -112,9 +112,39 @@ static void BM_PathVolatilityTracker(benchmark::State& state) {
   }
 }
 
+static void BM_CanvasDrawCalls(benchmark::State& state) {
+  ThreadHost thread_host(ThreadHost::ThreadHostConfig(
+      "test", ThreadHost::Type::kPlatform | ThreadHost::Type::kRaster |
+                  ThreadHost::Type::kIo | ThreadHost::Type::kUi));
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  Fixture fixture;
+  auto settings = fixture.CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  auto isolate =
+      testing::RunDartCodeInIsolate(vm_ref, settings, task_runners, "main", {},
+                                    testing::GetDefaultKernelFilePath(), {});
+
+  while (state.KeepRunning()) {
+    // Records 3000 draws whose paints have no objects, which are encoded into
+    // the batch of the canvas.
+    bool successful = isolate->RunInIsolateScope([]() -> bool {
+      Dart_Handle result = Dart_Invoke(
+          Dart_RootLibrary(), Dart_NewStringFromCString("recordCanvasDraws"),
+          0, nullptr);
+      return !Dart_IsError(result);
+    });
+    FML_CHECK(successful);
+  }
+}
+
 BENCHMARK(BM_PlatformMessageResponseDartComplete)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK(BM_CanvasDrawCalls)->Unit(benchmark::kMicrosecond);
+
 BENCHMARK(BM_PathVolatilityTracker)->Unit(benchmark::kMillisecond);
 
 }  // namespace flutter
@@ -7,6 +7,7 @@
 #include "flutter/lib/ui/window/platform_configuration.h"
 
 #include <memory>
+#include <vector>
 
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -332,5 +333,58 @@ TEST_F(PlatformConfigurationTest, SetDartPerformanceMode) {
   DestroyShell(std::move(shell), task_runners);
 }
 
+TEST_F(PlatformConfigurationTest, LargePlatformMessageIsNotCopied) {
+  auto message_latch = std::make_shared<fml::AutoResetWaitableEvent>();
+  const uint8_t* message_data = nullptr;
+  const size_t message_size = 1 << 20;
+
+  auto validate = [&](Dart_NativeArguments args) {
+    Dart_Handle handle = Dart_GetNativeArgument(args, 0);
+    EXPECT_EQ(Dart_GetTypeOfExternalTypedData(handle),
+              Dart_TypedData_kByteData);
+
+    Dart_TypedData_Type type;
+    void* data = nullptr;
+    intptr_t length = 0;
+    ASSERT_FALSE(
+        Dart_IsError(Dart_TypedDataAcquireData(handle, &type, &data, &length)));
+    EXPECT_EQ(data, message_data);
+    EXPECT_EQ(static_cast<size_t>(length), message_size);
+    EXPECT_EQ(static_cast<const uint8_t*>(data)[0], 1);
+    Dart_TypedDataReleaseData(handle);
+    message_latch->Signal();
+  };
+  AddNativeCallback("ValidatePlatformMessage", CREATE_NATIVE_ENTRY(validate));
+
+  Settings settings = CreateSettingsForFixture();
+
+  TaskRunners task_runners("test",                  // label
+                           GetCurrentTaskRunner(),  // platform
+                           CreateNewThread(),       // raster
+                           CreateNewThread(),       // ui
+                           CreateNewThread()        // io
+  );
+
+  std::unique_ptr<Shell> shell = CreateShell(settings, task_runners);
+
+  ASSERT_TRUE(shell->IsSetup());
+  auto run_configuration = RunConfiguration::InferFromSettings(settings);
+  run_configuration.SetEntrypoint("receiveLargePlatformMessage");
+
+  shell->RunEngine(std::move(run_configuration), [&](auto result) {
+    ASSERT_EQ(result, Engine::RunStatus::Success);
+  });
+
+  std::vector<uint8_t> bytes(message_size, 0);
+  fml::MallocMapping mapping =
+      fml::MallocMapping::Copy(bytes.data(), bytes.size());
+  message_data = mapping.GetMapping();
+  SendPlatformMessage(shell.get(), std::make_unique<PlatformMessage>(
+                                       "test", std::move(mapping), nullptr));
+
+  message_latch->Wait();
+  DestroyShell(std::move(shell), task_runners);
+}
+
 }  // namespace testing
 }  // namespace flutter
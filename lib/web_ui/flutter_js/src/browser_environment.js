@@ -35,6 +35,15 @@ const supportsWasmGC = () => {
   return WebAssembly.validate(new Uint8Array(bytes));
 }
 
+const supportsWasmSIMD = () => {
+  // This validates a wasm module that returns a SIMD128 value, which only
+  // validates if the browser implements the fixed-width SIMD proposal.
+  //
+  // Copied from https://github.com/GoogleChromeLabs/wasm-feature-detect/blob/main/src/detectors/simd/index.js
+  const bytes = [0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0, 10, 10, 1, 8, 0, 65, 0, 253, 15, 253, 98, 11];
+  return WebAssembly.validate(new Uint8Array(bytes));
+}
+
 /**
  * @returns {import("./types").BrowserEnvironment}
  */
@@ -42,5 +51,6 @@ export const browserEnvironment = {
   hasImageCodecs: hasImageCodecs(),
   hasChromiumBreakIterators: hasChromiumBreakIterators(),
   supportsWasmGC: supportsWasmGC(),
+  supportsWasmSIMD: supportsWasmSIMD(),
   crossOriginIsolated: window.crossOriginIsolated,
 };
@@ -81,7 +81,8 @@ export class FlutterLoader {
           return browserEnvironment.crossOriginIsolated
             && browserEnvironment.hasChromiumBreakIterators
             && browserEnvironment.hasImageCodecs
-            && browserEnvironment.supportsWasmGC;
+            && browserEnvironment.supportsWasmGC
+            && browserEnvironment.supportsWasmSIMD;
         default:
           return true;
       }
@@ -39,6 +39,7 @@ export interface BrowserEnvironment {
   hasImageCodecs: boolean;
   hasChromiumBreakIterators: boolean;
   supportsWasmGC: boolean;
+  supportsWasmSIMD: boolean;
   crossOriginIsolated: boolean;
 }
 
@@ -164,6 +164,9 @@ enum _FrameTimingInfo {
   layerCacheBytes,
   pictureCacheCount,
   pictureCacheBytes,
+  layerCount,
+  displayListOpCount,
+  offscreenPassCount,
   frameNumber,
 }
 
@@ -179,6 +182,9 @@ class FrameTiming {
     int layerCacheBytes = 0,
     int pictureCacheCount = 0,
     int pictureCacheBytes = 0,
+    int layerCount = 0,
+    int displayListOpCount = 0,
+    int offscreenPassCount = 0,
     int frameNumber = 1,
   }) {
     return FrameTiming._(<int>[
@@ -192,6 +198,9 @@ class FrameTiming {
       layerCacheBytes,
       pictureCacheCount,
       pictureCacheBytes,
+      layerCount,
+      displayListOpCount,
+      offscreenPassCount,
       frameNumber,
     ]);
   }
@@ -230,6 +239,12 @@ class FrameTiming {
 
   double get pictureCacheMegabytes => pictureCacheBytes / 1024.0 / 1024.0;
 
+  int get layerCount => _rawInfo(_FrameTimingInfo.layerCount);
+
+  int get displayListOpCount => _rawInfo(_FrameTimingInfo.displayListOpCount);
+
+  int get offscreenPassCount => _rawInfo(_FrameTimingInfo.offscreenPassCount);
+
   int get frameNumber => _data.last;
 
   final List<int> _data;  // some elements in microseconds, some in bytes, some are counts
@@ -246,6 +261,9 @@ class FrameTiming {
         'layerCacheBytes: $layerCacheBytes, '
         'pictureCacheCount: $pictureCacheCount, '
         'pictureCacheBytes: $pictureCacheBytes, '
+        'layerCount: $layerCount, '
+        'displayListOpCount: $displayListOpCount, '
+        'offscreenPassCount: $offscreenPassCount, '
         'frameNumber: ${_data.last})';
   }
 }
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 import 'dart:async';
+import 'dart:js_interop';
 import 'dart:math' as math;
 import 'dart:typed_data';
 
@@ -258,6 +259,34 @@ class CanvasKitRenderer implements Renderer {
     return CkImage(skImage);
   }
 
+  @override
+  FutureOr<ui.Image> createImageFromTextureSource(
+    JSAny object, {
+    required int width,
+    required int height,
+    required bool transferOwnership,
+  }) async {
+    // CanvasKit uploads the texture source each time it needs the texture, so
+    // it has to hold on to a copy if it doesn't own the source.
+    if (!transferOwnership) {
+      object = await createImageBitmap(object);
+    }
+    final SkImage? skImage = canvasKit.MakeLazyImageFromTextureSourceWithInfo(
+      object,
+      SkPartialImageInfo(
+        alphaType: canvasKit.AlphaType.Premul,
+        colorType: canvasKit.ColorType.RGBA_8888,
+        colorSpace: SkColorSpaceSRGB,
+        width: width.toDouble(),
+        height: height.toDouble(),
+      ),
+    );
+    if (skImage == null) {
+      throw Exception('Failed to convert texture source to an SkImage.');
+    }
+    return CkImage(skImage);
+  }
+
   @override
   void decodeImageFromPixels(
     Uint8List pixels,
@@ -387,4 +387,17 @@ class HtmlRenderer implements Renderer {
     imageElement.src = await canvas.toDataUrl();
     return completer.future;
   }
+
+  @override
+  Future<ui.Image> createImageFromTextureSource(
+    JSAny object, {
+    required int width,
+    required int height,
+    required bool transferOwnership,
+  }) async {
+    // The HTML renderer draws images as elements, so the texture source is
+    // converted to an image element through an ImageBitmap.
+    final DomImageBitmap bitmap = await createImageBitmap(object);
+    return createImageFromImageBitmap(bitmap);
+  }
 }
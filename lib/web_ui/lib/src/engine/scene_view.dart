@@ -9,11 +9,13 @@ import 'package:ui/ui.dart' as ui;
 
 const String kCanvasContainerTag = 'flt-canvas-container';
 
-// This is an interface that renders a `ScenePicture` as a `DomImageBitmap`.
+// This is an interface that renders `ScenePicture`s as `DomImageBitmap`s.
 // It is optionally asynchronous. It is required for the `EngineSceneView` to
-// composite pictures into the canvases in the DOM tree it builds.
+// composite pictures into the canvases in the DOM tree it builds. All the
+// pictures of a scene are rendered together, so that a renderer on another
+// thread can render them with a single round trip.
 abstract class PictureRenderer {
-  FutureOr<DomImageBitmap> renderPicture(ScenePicture picture);
+  FutureOr<List<DomImageBitmap>> renderPictures(List<ScenePicture> pictures);
 }
 
 class _SceneRender {
@@ -77,13 +79,13 @@ class EngineSceneView {
 
   Future<void> _renderScene(EngineScene scene) async {
     final List<LayerSlice> slices = scene.rootLayer.slices;
-    final Iterable<Future<DomImageBitmap?>> renderFutures = slices.map(
-      (LayerSlice slice) async => switch (slice) {
-          PlatformViewSlice() => null,
-          PictureSlice() => pictureRenderer.renderPicture(slice.picture),
-        }
-    );
-    final List<DomImageBitmap?> renderedBitmaps = await Future.wait(renderFutures);
+    final List<ScenePicture> picturesToRender = <ScenePicture>[
+      for (final LayerSlice slice in slices)
+        if (slice is PictureSlice) slice.picture,
+    ];
+    final List<DomImageBitmap> renderedBitmaps =
+      await pictureRenderer.renderPictures(picturesToRender);
+    int renderedBitmapIndex = 0;
     final List<SliceContainer?> reusableContainers = List<SliceContainer?>.from(containers);
     final List<SliceContainer> newContainers = <SliceContainer>[];
     for (int i = 0; i < slices.length; i++) {
@@ -106,7 +108,7 @@ class EngineSceneView {
             container = PictureSliceContainer(slice.picture.cullRect);
           }
           container.updateContents();
-          container.renderBitmap(renderedBitmaps[i]!);
+          container.renderBitmap(renderedBitmaps[renderedBitmapIndex++]);
           newContainers.add(container);
 
         case PlatformViewSlice():
@@ -463,6 +463,27 @@ class SkwasmRenderer implements Renderer {
       surface.handle,
     ));
   }
+
+  @override
+  FutureOr<ui.Image> createImageFromTextureSource(
+    JSAny object, {
+    required int width,
+    required int height,
+    required bool transferOwnership,
+  }) async {
+    // The texture source is transferred to the raster worker, which uploads it
+    // into a WebGL texture, so its pixels never go through the wasm heap. A
+    // source that the caller keeps is copied into an ImageBitmap first.
+    if (!transferOwnership) {
+      object = await createImageBitmap(object);
+    }
+    return SkwasmImage(imageCreateFromTextureSource(
+      object as JSObject,
+      width,
+      height,
+      surface.handle,
+    ));
+  }
 }
 
 class SkwasmPictureRenderer implements PictureRenderer {
@@ -471,6 +492,6 @@ class SkwasmPictureRenderer implements PictureRenderer {
   SkwasmSurface surface;
 
   @override
-  FutureOr<DomImageBitmap> renderPicture(ScenePicture picture) =>
-    surface.renderPicture(picture as SkwasmPicture);
+  FutureOr<List<DomImageBitmap>> renderPictures(List<ScenePicture> pictures) =>
+    surface.renderPictures(pictures.cast<SkwasmPicture>());
 }
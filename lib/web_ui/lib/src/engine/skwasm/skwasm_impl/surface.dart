@@ -78,12 +78,25 @@ class SkwasmSurface {
     surfaceSetCallbackHandler(handle, SkwasmCallbackHandler.instance.callbackPointer);
   }
 
-  Future<DomImageBitmap> renderPicture(SkwasmPicture picture) async {
-    final int callbackId = surfaceRenderPicture(handle, picture.handle);
-    final DomImageBitmap bitmap = (await SkwasmCallbackHandler.instance.registerCallback(callbackId)) as DomImageBitmap;
-    return bitmap;
+  // Renders all the pictures with a single message to the raster worker, which
+  // is how the pictures of a frame are rendered.
+  Future<List<DomImageBitmap>> renderPictures(List<SkwasmPicture> pictures) async {
+    final int callbackId = withStackScope((StackScope scope) {
+      final Pointer<PictureHandle> pictureHandles =
+        scope.allocPointerArray(pictures.length).cast<PictureHandle>();
+      for (int i = 0; i < pictures.length; i++) {
+        pictureHandles[i] = pictures[i].handle;
+      }
+      return surfaceRenderPictures(handle, pictureHandles, pictures.length);
+    });
+    final JSArray<JSAny> bitmaps =
+      (await SkwasmCallbackHandler.instance.registerCallback(callbackId)) as JSArray<JSAny>;
+    return bitmaps.toDart.cast<DomImageBitmap>();
   }
 
+  Future<DomImageBitmap> renderPicture(SkwasmPicture picture) async =>
+    (await renderPictures(<SkwasmPicture>[picture])).single;
+
   Future<ByteData> rasterizeImage(SkwasmImage image, ui.ImageByteFormat format) async {
     final int callbackId = surfaceRasterizeImage(
       handle,
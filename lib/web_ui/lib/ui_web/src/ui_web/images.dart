@@ -44,3 +44,31 @@ FutureOr<ui.Image> createImageFromImageBitmap(JSAny imageSource) {
     imageSource as DomImageBitmap,
   );
 }
+
+/// Creates a [ui.Image] from a valid texture source (for example
+/// HTMLImageElement | HTMLVideoElement | HTMLCanvasElement | ImageBitmap |
+/// OffscreenCanvas | VideoFrame).
+///
+/// The contents of the texture source must have a premultiplied alpha. The
+/// renderers that draw with WebGL upload it as a texture, without copying its
+/// pixels into the memory of the engine.
+///
+/// By default, the caller keeps the ownership of [object], and the engine
+/// makes a copy of its contents. If [transferOwnership] is true, the engine
+/// takes ownership of [object] and may consume it, as
+/// [createImageFromImageBitmap] does.
+///
+/// See https://developer.mozilla.org/en-US/docs/Web/API/WebGLRenderingContext/texImage2D#source
+FutureOr<ui.Image> createImageFromTextureSource(
+  JSAny object, {
+  required int width,
+  required int height,
+  bool transferOwnership = false,
+}) {
+  return renderer.createImageFromTextureSource(
+    object,
+    width: width,
+    height: height,
+    transferOwnership: transferOwnership,
+  );
+}
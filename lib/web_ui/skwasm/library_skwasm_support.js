@@ -27,11 +27,11 @@ mergeInto(LibraryManager.library, {
           return;
         }
         switch (skwasmMessage) {
-          case 'renderPicture':
-            _surface_renderPictureOnWorker(data.surface, data.picture, data.callbackId);
+          case 'renderPictures':
+            _surface_renderPicturesOnWorker(data.surface, data.pictures, data.pictureCount, data.callbackId);
             return;
           case 'onRenderComplete':
-            _surface_onRenderComplete(data.surface, data.callbackId, data.imageBitmap);
+            _surface_onRenderComplete(data.surface, data.callbackId, data.imageBitmaps);
             return;
           case 'setAssociatedObject':
             associatedObjectsMap.set(data.pointer, data.object);
@@ -54,11 +54,12 @@ mergeInto(LibraryManager.library, {
         PThread.pthreads[threadId].addEventListener("message", eventListener);
       }
     };
-    _skwasm_dispatchRenderPicture = function(threadId, surfaceHandle, pictureHandle, callbackId) {
+    _skwasm_dispatchRenderPictures = function(threadId, surfaceHandle, pictures, pictureCount, callbackId) {
       PThread.pthreads[threadId].postMessage({
-        skwasmMessage: 'renderPicture',
+        skwasmMessage: 'renderPictures',
         surface: surfaceHandle,
-        picture: pictureHandle,
+        pictures,
+        pictureCount,
         callbackId,
       });
     };
@@ -85,15 +86,22 @@ mergeInto(LibraryManager.library, {
       canvas.width = width;
       canvas.height = height;
     };
-    _skwasm_captureImageBitmap = async function(surfaceHandle, contextHandle, callbackId, width, height) {
+    _skwasm_captureImageBitmap = function(contextHandle, width, height, imagePromises) {
+      if (!imagePromises) imagePromises = Array();
       const canvas = handleToCanvasMap.get(contextHandle);
-      const imageBitmap = await createImageBitmap(canvas, 0, 0, width, height);
+      // The contents of the canvas are copied when `createImageBitmap` is
+      // called, so the next picture can be drawn while the bitmap is created.
+      imagePromises.push(createImageBitmap(canvas, 0, 0, width, height));
+      return imagePromises;
+    };
+    _skwasm_resolveAndPostImages = async function(surfaceHandle, imagePromises, callbackId) {
+      const imageBitmaps = imagePromises ? await Promise.all(imagePromises) : [];
       postMessage({
         skwasmMessage: 'onRenderComplete',
         surface: surfaceHandle,
         callbackId,
-        imageBitmap,
-      }, [imageBitmap]);
+        imageBitmaps,
+      }, [...imageBitmaps]);
     };
     _skwasm_createGlTextureFromTextureSource = function(textureSource, width, height) {
       const glCtx = GL.currentContext.GLctx;
@@ -125,14 +133,16 @@ mergeInto(LibraryManager.library, {
   skwasm_disposeAssociatedObjectOnThread__deps: ['$skwasm_support_setup'],
   skwasm_registerMessageListener: function() {},
   skwasm_registerMessageListener__deps: ['$skwasm_support_setup'],
-  skwasm_dispatchRenderPicture: function() {},
-  skwasm_dispatchRenderPicture__deps: ['$skwasm_support_setup'],
+  skwasm_dispatchRenderPictures: function() {},
+  skwasm_dispatchRenderPictures__deps: ['$skwasm_support_setup'],
   skwasm_createOffscreenCanvas: function () {},
   skwasm_createOffscreenCanvas__deps: ['$skwasm_support_setup'],
   skwasm_resizeCanvas: function () {},
   skwasm_resizeCanvas__deps: ['$skwasm_support_setup'],
   skwasm_captureImageBitmap: function () {},
   skwasm_captureImageBitmap__deps: ['$skwasm_support_setup'],
+  skwasm_resolveAndPostImages: function () {},
+  skwasm_resolveAndPostImages__deps: ['$skwasm_support_setup'],
   skwasm_createGlTextureFromTextureSource: function () {},
   skwasm_createGlTextureFromTextureSource__deps: ['$skwasm_support_setup'],
 });
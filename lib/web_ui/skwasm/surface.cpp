@@ -4,6 +4,7 @@
 
 #include "surface.h"
 #include <algorithm>
+#include <memory>
 
 #include "third_party/skia/include/gpu/GrBackendSurface.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
@@ -39,11 +40,20 @@ void Surface::dispose() {
 }
 
 // Main thread only
-uint32_t Surface::renderPicture(SkPicture* picture) {
+uint32_t Surface::renderPictures(SkPicture** pictures, int count) {
   assert(emscripten_is_main_browser_thread());
   uint32_t callbackId = ++_currentCallbackId;
-  picture->ref();
-  skwasm_dispatchRenderPicture(_thread, this, picture, callbackId);
+  std::unique_ptr<sk_sp<SkPicture>[]> picturePointers =
+      std::make_unique<sk_sp<SkPicture>[]>(count);
+  for (int i = 0; i < count; i++) {
+    picturePointers[i] = sk_ref_sp(pictures[i]);
+  }
+
+  // All the pictures of a frame are rendered by a single message to the
+  // worker. The pictures themselves aren't copied, as they live in the
+  // shared memory of the module.
+  skwasm_dispatchRenderPictures(_thread, this, picturePointers.release(),
+                                count, callbackId);
   return callbackId;
 }
 
@@ -136,20 +146,40 @@ void Surface::_recreateSurface() {
 }
 
 // Worker thread only
-void Surface::renderPictureOnWorker(SkPicture* picture, uint32_t callbackId) {
-  SkRect pictureRect = picture->cullRect();
-  SkIRect roundedOutRect;
-  pictureRect.roundOut(&roundedOutRect);
-  _resizeCanvasToFit(roundedOutRect.width(), roundedOutRect.height());
-  SkMatrix matrix =
-      SkMatrix::Translate(-roundedOutRect.fLeft, -roundedOutRect.fTop);
+void Surface::renderPicturesOnWorker(sk_sp<SkPicture>* pictures,
+                                     int pictureCount,
+                                     uint32_t callbackId) {
+  // Size the canvas for the largest picture up front, so that it isn't
+  // reallocated between the pictures of a frame.
+  int width = 0;
+  int height = 0;
+  for (int i = 0; i < pictureCount; i++) {
+    SkIRect roundedOutRect;
+    pictures[i]->cullRect().roundOut(&roundedOutRect);
+    width = std::max(width, roundedOutRect.width());
+    height = std::max(height, roundedOutRect.height());
+  }
+  _resizeCanvasToFit(width, height);
   makeCurrent(_glContext);
-  auto canvas = _surface->getCanvas();
-  canvas->drawColor(SK_ColorTRANSPARENT, SkBlendMode::kSrc);
-  canvas->drawPicture(sk_ref_sp<SkPicture>(picture), &matrix, nullptr);
-  _grContext->flush(_surface.get());
-  skwasm_captureImageBitmap(this, _glContext, callbackId,
-                            roundedOutRect.width(), roundedOutRect.height());
+
+  // The image bitmaps are captured as soon as each picture is drawn, and
+  // posted back to the main thread together once they are all ready.
+  SkwasmObject imagePromises = __builtin_wasm_ref_null_extern();
+  for (int i = 0; i < pictureCount; i++) {
+    sk_sp<SkPicture> picture = pictures[i];
+    SkIRect roundedOutRect;
+    picture->cullRect().roundOut(&roundedOutRect);
+    SkMatrix matrix =
+        SkMatrix::Translate(-roundedOutRect.fLeft, -roundedOutRect.fTop);
+    auto canvas = _surface->getCanvas();
+    canvas->drawColor(SK_ColorTRANSPARENT, SkBlendMode::kSrc);
+    canvas->drawPicture(picture, &matrix, nullptr);
+    _grContext->flush(_surface.get());
+    imagePromises = skwasm_captureImageBitmap(
+        _glContext, roundedOutRect.width(), roundedOutRect.height(),
+        imagePromises);
+  }
+  skwasm_resolveAndPostImages(this, imagePromises, callbackId);
 }
 
 void Surface::_rasterizeImage(SkImage* image,
@@ -184,9 +214,10 @@ void Surface::_onRasterizeComplete(SkData* data, uint32_t callbackId) {
 }
 
 // Main thread only
-void Surface::onRenderComplete(uint32_t callbackId, SkwasmObject imageBitmap) {
+void Surface::onRenderComplete(uint32_t callbackId,
+                               SkwasmObject imageBitmaps) {
   assert(emscripten_is_main_browser_thread());
-  _callbackHandler(callbackId, nullptr, imageBitmap);
+  _callbackHandler(callbackId, nullptr, imageBitmaps);
 }
 
 void Surface::fDispose(Surface* surface) {
@@ -225,16 +256,20 @@ SKWASM_EXPORT void surface_destroy(Surface* surface) {
   surface->dispose();
 }
 
-SKWASM_EXPORT uint32_t surface_renderPicture(Surface* surface,
-                                             SkPicture* picture) {
-  return surface->renderPicture(picture);
+SKWASM_EXPORT uint32_t surface_renderPictures(Surface* surface,
+                                              SkPicture** pictures,
+                                              int count) {
+  return surface->renderPictures(pictures, count);
 }
 
-SKWASM_EXPORT void surface_renderPictureOnWorker(Surface* surface,
-                                                 SkPicture* picture,
-                                                 uint32_t callbackId) {
-  surface->renderPictureOnWorker(picture, callbackId);
-  picture->unref();
+SKWASM_EXPORT void surface_renderPicturesOnWorker(Surface* surface,
+                                                  sk_sp<SkPicture>* pictures,
+                                                  int pictureCount,
+                                                  uint32_t callbackId) {
+  // This will release the pictures when they leave scope.
+  std::unique_ptr<sk_sp<SkPicture>[]> picturesPointer =
+      std::unique_ptr<sk_sp<SkPicture>[]>(pictures);
+  surface->renderPicturesOnWorker(pictures, pictureCount, callbackId);
 }
 
 SKWASM_EXPORT uint32_t surface_rasterizeImage(Surface* surface,
@@ -244,9 +279,9 @@ SKWASM_EXPORT uint32_t surface_rasterizeImage(Surface* surface,
 }
 
 // This is used by the skwasm JS support code to call back into C++ when the
-// we finish creating the image bitmap, which is an asynchronous operation.
+// we finish creating the image bitmaps, which is an asynchronous operation.
 SKWASM_EXPORT void surface_onRenderComplete(Surface* surface,
                                             uint32_t callbackId,
-                                            SkwasmObject imageBitmap) {
-  return surface->onRenderComplete(callbackId, imageBitmap);
+                                            SkwasmObject imageBitmaps) {
+  return surface->onRenderComplete(callbackId, imageBitmaps);
 }
@@ -62,17 +62,19 @@ class Surface {
 
   // Main thread only
   void dispose();
-  uint32_t renderPicture(SkPicture* picture);
+  uint32_t renderPictures(SkPicture** picture, int count);
   uint32_t rasterizeImage(SkImage* image, ImageByteFormat format);
   void setCallbackHandler(CallbackHandler* callbackHandler);
-  void onRenderComplete(uint32_t callbackId, SkwasmObject imageBitmap);
+  void onRenderComplete(uint32_t callbackId, SkwasmObject imageBitmaps);
 
   // Any thread
   std::unique_ptr<TextureSourceWrapper> createTextureSourceWrapper(
       SkwasmObject textureSource);
 
   // Worker thread
-  void renderPictureOnWorker(SkPicture* picture, uint32_t callbackId);
+  void renderPicturesOnWorker(sk_sp<SkPicture>* picture,
+                              int pictureCount,
+                              uint32_t callbackId);
 
  private:
   void _runWorker();
@@ -104,7 +106,7 @@ class Surface {
   static void fDispose(Surface* surface);
   static void fOnRenderComplete(Surface* surface,
                                 uint32_t callbackId,
-                                SkwasmObject imageBitmap);
+                                SkwasmObject imageBitmaps);
   static void fRasterizeImage(Surface* surface,
                               SkImage* image,
                               ImageByteFormat format,
@@ -46,5 +46,8 @@ Future<void> runFrameTimingsTest() async {
     expect(timing.layerCacheBytes, equals(0));
     expect(timing.pictureCacheCount, equals(0));
     expect(timing.pictureCacheBytes, equals(0));
+    expect(timing.layerCount, equals(0));
+    expect(timing.displayListOpCount, equals(0));
+    expect(timing.offscreenPassCount, equals(0));
   }
 }
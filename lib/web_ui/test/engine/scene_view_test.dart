@@ -23,6 +23,11 @@ class StubPictureRenderer implements PictureRenderer {
       createDomCanvasElement(width: 500, height: 500);
 
   @override
+  Future<List<DomImageBitmap>> renderPictures(List<ScenePicture> pictures) async {
+    renderPictureBatchCount++;
+    return Future.wait(pictures.map(renderPicture));
+  }
+
   Future<DomImageBitmap> renderPicture(ScenePicture picture) async {
     renderedPictures.add(picture);
     final ui.Rect cullRect = picture.cullRect;
@@ -37,6 +42,7 @@ class StubPictureRenderer implements PictureRenderer {
   }
 
   List<ScenePicture> renderedPictures = <ScenePicture>[];
+  int renderPictureBatchCount = 0;
 }
 
 void testMain() {
@@ -142,4 +148,22 @@ void testMain() {
     expect(stubPictureRenderer.renderedPictures.first, pictures.first);
     expect(stubPictureRenderer.renderedPictures.last, pictures.last);
   });
+
+  test('SceneView renders all the pictures of a scene in one batch', () async {
+    final EngineRootLayer rootLayer = EngineRootLayer();
+    final List<StubPicture> pictures = <StubPicture>[
+      StubPicture(const ui.Rect.fromLTWH(0, 0, 100, 120)),
+      StubPicture(const ui.Rect.fromLTWH(50, 80, 100, 120)),
+    ];
+    rootLayer.slices.add(PictureSlice(pictures.first));
+    rootLayer.slices.add(PlatformViewSlice(<PlatformView>[], null));
+    rootLayer.slices.add(PictureSlice(pictures.last));
+    final EngineScene scene = EngineScene(rootLayer);
+    await sceneView.renderScene(scene);
+
+    expect(stubPictureRenderer.renderPictureBatchCount, 1);
+    expect(stubPictureRenderer.renderedPictures, pictures);
+    final List<DomElement> children = sceneView.sceneElement.children.toList();
+    expect(children.length, 2);
+  });
 }
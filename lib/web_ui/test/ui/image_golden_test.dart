@@ -13,6 +13,7 @@ import 'package:test/test.dart';
 import 'package:ui/src/engine.dart';
 
 import 'package:ui/ui.dart' as ui;
+import 'package:ui/ui_web/src/ui_web.dart' as ui_web;
 import 'package:web_engine_tester/golden_tester.dart';
 
 import '../common/fake_asset_manager.dart';
@@ -333,6 +334,26 @@ Future<void> testMain() async {
     });
   }
 
+  emitImageTests('texture_source_image', () async {
+    final DomCanvasElement canvas = createDomCanvasElement(width: 150, height: 150);
+    final DomCanvasRenderingContext2D context = canvas.context2D;
+    context.fillStyle = '#ff0000';
+    context.fillRect(0, 0, 100, 100);
+    context.fillStyle = '#0000ff';
+    context.fillRect(50, 50, 100, 100);
+
+    final ui.Image uiImage = await ui_web.createImageFromTextureSource(
+      canvas as JSObject,
+      width: 150,
+      height: 150,
+    );
+
+    // The canvas belongs to the caller, so the engine must not consume it.
+    expect(canvas.width, 150);
+    expect(canvas.height, 150);
+    return uiImage;
+  });
+
   emitImageTests('codec_list_resized', () async {
     final ByteBuffer data = await httpFetchByteBuffer('/test_images/mandrill_128.png');
     final ui.Codec codec = await renderer.instantiateImageCodec(
@@ -21,6 +21,7 @@
 #include "flutter/runtime/dart_isolate.h"
 #include "flutter/runtime/dart_vm_initializer.h"
 #include "flutter/runtime/ptrace_check.h"
+#include "flutter/runtime/snapshot_page_profile.h"
 #include "third_party/dart/runtime/include/bin/dart_io_api.h"
 #include "third_party/skia/include/core/SkExecutor.h"
 #include "third_party/tonic/converter/dart_converter.h"
@@ -306,6 +307,17 @@ DartVM::DartVM(const std::shared_ptr<const DartVMData>& vm_data,
   FML_DCHECK(isolate_name_server_);
   FML_DCHECK(service_protocol_);
 
+  // Read in the snapshot pages needed by the last startup while the VM and
+  // the root isolate are being set up.
+  if (!settings_.snapshot_page_profile_path.empty() &&
+      IsRunningPrecompiledCode()) {
+    concurrent_message_loop_->GetTaskRunner()->PostTask(
+        [vm_data = vm_data_, path = settings_.snapshot_page_profile_path]() {
+          PrefetchSnapshotPageProfile(vm_data->GetVMSnapshot(),
+                                      *vm_data->GetIsolateSnapshot(), path);
+        });
+  }
+
   {
     TRACE_EVENT0("flutter", "dart::bin::BootstrapDartIo");
     dart::bin::BootstrapDartIo();
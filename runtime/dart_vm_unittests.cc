@@ -4,7 +4,11 @@
 
 #include "flutter/runtime/dart_vm.h"
 
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/paths.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
+#include "flutter/runtime/snapshot_page_profile.h"
 #include "flutter/testing/fixture_test.h"
 #include "gtest/gtest.h"
 
@@ -60,5 +64,26 @@ TEST_F(DartVMTest, TraceGetTimelineMicrosDoesNotGetClockWhenSystraceIsEnabled) {
   ASSERT_EQ(-1, fml::tracing::TraceGetTimelineMicros());
 }
 
+#if FML_OS_LINUX || FML_OS_ANDROID
+TEST_F(DartVMTest, RecordsSnapshotPageProfileThatCanBePrefetched) {
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+  auto vm = DartVMRef::Create(CreateSettingsForFixture());
+  ASSERT_TRUE(vm);
+  auto vm_data = vm.GetVMData();
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto path = fml::paths::JoinPaths({temp_dir.path(), "page_profile"});
+  ASSERT_FALSE(PrefetchSnapshotPageProfile(
+      vm_data->GetVMSnapshot(), *vm_data->GetIsolateSnapshot(), path));
+  ASSERT_TRUE(RecordSnapshotPageProfile(
+      vm_data->GetVMSnapshot(), *vm_data->GetIsolateSnapshot(), path));
+  ASSERT_TRUE(fml::IsFile(path));
+  ASSERT_TRUE(PrefetchSnapshotPageProfile(
+      vm_data->GetVMSnapshot(), *vm_data->GetIsolateSnapshot(), path));
+  // Profiles are only recorded once per process.
+  ASSERT_FALSE(RecordSnapshotPageProfile(
+      vm_data->GetVMSnapshot(), *vm_data->GetIsolateSnapshot(), path));
+}
+#endif  // FML_OS_LINUX || FML_OS_ANDROID
+
 }  // namespace testing
 }  // namespace flutter
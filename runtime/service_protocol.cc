@@ -34,6 +34,16 @@ const std::string_view ServiceProtocol::kGetDisplayRefreshRateExtensionName =
     "_flutter.getDisplayRefreshRate";
 const std::string_view ServiceProtocol::kGetSkSLsExtensionName =
     "_flutter.getSkSLs";
+const std::string_view
+    ServiceProtocol::kGetImpellerPipelineVariantsExtensionName =
+        "_flutter.getImpellerPipelineVariants";
+const std::string_view
+    ServiceProtocol::kGetImpellerGPUTimeByCategoryExtensionName =
+        "_flutter.getImpellerGPUTimeByCategory";
+const std::string_view ServiceProtocol::kGetTraceRingBufferExtensionName =
+    "_flutter.getTraceRingBuffer";
+const std::string_view ServiceProtocol::kGetEngineMemoryUsageExtensionName =
+    "_flutter.getEngineMemoryUsage";
 const std::string_view
     ServiceProtocol::kEstimateRasterCacheMemoryExtensionName =
         "_flutter.estimateRasterCacheMemory";
@@ -60,6 +70,10 @@ ServiceProtocol::ServiceProtocol()
           kSetAssetBundlePathExtensionName,
           kGetDisplayRefreshRateExtensionName,
           kGetSkSLsExtensionName,
+          kGetImpellerPipelineVariantsExtensionName,
+          kGetImpellerGPUTimeByCategoryExtensionName,
+          kGetTraceRingBufferExtensionName,
+          kGetEngineMemoryUsageExtensionName,
           kEstimateRasterCacheMemoryExtensionName,
           kRenderFrameWithRasterStatsExtensionName,
           kReloadAssetFonts,
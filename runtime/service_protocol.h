@@ -28,6 +28,10 @@ class ServiceProtocol {
   static const std::string_view kSetAssetBundlePathExtensionName;
   static const std::string_view kGetDisplayRefreshRateExtensionName;
   static const std::string_view kGetSkSLsExtensionName;
+  static const std::string_view kGetImpellerPipelineVariantsExtensionName;
+  static const std::string_view kGetImpellerGPUTimeByCategoryExtensionName;
+  static const std::string_view kGetTraceRingBufferExtensionName;
+  static const std::string_view kGetEngineMemoryUsageExtensionName;
   static const std::string_view kEstimateRasterCacheMemoryExtensionName;
   static const std::string_view kRenderFrameWithRasterStatsExtensionName;
   static const std::string_view kReloadAssetFonts;
@@ -0,0 +1,188 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/snapshot_page_profile.h"
+
+#include "flutter/fml/build_config.h"
+
+#if FML_OS_LINUX || FML_OS_ANDROID
+#include <link.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <array>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#endif  // FML_OS_LINUX || FML_OS_ANDROID
+
+namespace flutter {
+
+#if FML_OS_LINUX || FML_OS_ANDROID
+
+namespace {
+
+// The pages from the start of a snapshot section to the end of the loaded
+// segment that contains it. The size of a section isn't known when it is
+// resolved as a symbol.
+struct PageRange {
+  uint8_t* start = nullptr;
+  size_t page_count = 0;
+};
+
+constexpr size_t kSectionCount = 4;
+
+struct SegmentSearch {
+  uintptr_t address;
+  uintptr_t end;
+};
+
+int FindSegmentEnd(struct dl_phdr_info* info, size_t size, void* data) {
+  auto* search = static_cast<SegmentSearch*>(data);
+  for (size_t i = 0; i < info->dlpi_phnum; i++) {
+    const auto& header = info->dlpi_phdr[i];
+    if (header.p_type != PT_LOAD) {
+      continue;
+    }
+    uintptr_t start = info->dlpi_addr + header.p_vaddr;
+    uintptr_t end = start + header.p_memsz;
+    if (search->address >= start && search->address < end) {
+      search->end = end;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+PageRange GetPageRange(const uint8_t* section, size_t page_size) {
+  if (section == nullptr) {
+    return {};
+  }
+  SegmentSearch search = {reinterpret_cast<uintptr_t>(section), 0};
+  if (dl_iterate_phdr(FindSegmentEnd, &search) == 0) {
+    // The section isn't part of a loaded library.
+    return {};
+  }
+  uintptr_t start = search.address & ~(page_size - 1);
+  return {
+      .start = reinterpret_cast<uint8_t*>(start),
+      .page_count = (search.end - start + page_size - 1) / page_size,
+  };
+}
+
+std::array<PageRange, kSectionCount> GetPageRanges(
+    const DartSnapshot& vm_snapshot,
+    const DartSnapshot& isolate_snapshot,
+    size_t page_size) {
+  return {
+      GetPageRange(vm_snapshot.GetDataMapping(), page_size),
+      GetPageRange(vm_snapshot.GetInstructionsMapping(), page_size),
+      GetPageRange(isolate_snapshot.GetDataMapping(), page_size),
+      GetPageRange(isolate_snapshot.GetInstructionsMapping(), page_size),
+  };
+}
+
+}  // namespace
+
+bool RecordSnapshotPageProfile(const DartSnapshot& vm_snapshot,
+                               const DartSnapshot& isolate_snapshot,
+                               const std::string& path) {
+  static std::once_flag once_flag;
+  bool recorded = false;
+  std::call_once(once_flag, [&]() {
+    if (fml::IsFile(path)) {
+      return;
+    }
+    TRACE_EVENT0("flutter", "RecordSnapshotPageProfile");
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    auto ranges = GetPageRanges(vm_snapshot, isolate_snapshot, page_size);
+
+    // Each line lists a run of resident pages of a section as its section
+    // index, its first page and its page count.
+    std::stringstream profile;
+    std::vector<unsigned char> residency;
+    for (size_t section = 0; section < kSectionCount; section++) {
+      const PageRange& range = ranges[section];
+      if (range.page_count == 0) {
+        continue;
+      }
+      residency.resize(range.page_count);
+      if (mincore(range.start, range.page_count * page_size,
+                  residency.data()) != 0) {
+        continue;
+      }
+      size_t run_start = 0;
+      for (size_t page = 0; page <= range.page_count; page++) {
+        bool resident = page < range.page_count && (residency[page] & 1);
+        if (resident) {
+          continue;
+        }
+        if (page > run_start) {
+          profile << section << " " << run_start << " " << page - run_start
+                  << "\n";
+        }
+        run_start = page + 1;
+      }
+    }
+
+    std::ofstream file(path, std::ios::trunc);
+    file << profile.str();
+    recorded = file.good();
+    if (!recorded) {
+      FML_LOG(ERROR) << "Could not write the snapshot page profile to "
+                     << path;
+    }
+  });
+  return recorded;
+}
+
+bool PrefetchSnapshotPageProfile(const DartSnapshot& vm_snapshot,
+                                 const DartSnapshot& isolate_snapshot,
+                                 const std::string& path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    return false;
+  }
+  TRACE_EVENT0("flutter", "PrefetchSnapshotPageProfile");
+  const size_t page_size = sysconf(_SC_PAGESIZE);
+  auto ranges = GetPageRanges(vm_snapshot, isolate_snapshot, page_size);
+
+  size_t section, first_page, page_count;
+  while (file >> section >> first_page >> page_count) {
+    if (section >= kSectionCount) {
+      continue;
+    }
+    const PageRange& range = ranges[section];
+    if (first_page >= range.page_count ||
+        page_count > range.page_count - first_page) {
+      continue;
+    }
+    madvise(range.start + first_page * page_size, page_count * page_size,
+            MADV_WILLNEED);
+  }
+  return true;
+}
+
+#else  // FML_OS_LINUX || FML_OS_ANDROID
+
+bool RecordSnapshotPageProfile(const DartSnapshot& vm_snapshot,
+                               const DartSnapshot& isolate_snapshot,
+                               const std::string& path) {
+  return false;
+}
+
+bool PrefetchSnapshotPageProfile(const DartSnapshot& vm_snapshot,
+                                 const DartSnapshot& isolate_snapshot,
+                                 const std::string& path) {
+  return false;
+}
+
+#endif  // FML_OS_LINUX || FML_OS_ANDROID
+
+}  // namespace flutter
@@ -0,0 +1,46 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_RUNTIME_SNAPSHOT_PAGE_PROFILE_H_
+#define FLUTTER_RUNTIME_SNAPSHOT_PAGE_PROFILE_H_
+
+#include <string>
+
+#include "flutter/runtime/dart_snapshot.h"
+
+namespace flutter {
+
+// A snapshot page profile lists the pages of the AOT snapshots that were
+// resident in memory once the first frame of a startup was rendered. Later
+// startups prefetch those pages on a background thread, instead of faulting
+// them in one by one as the VM and the root isolate touch them.
+//
+// Profiles are supported for snapshots loaded from an ELF library on Linux
+// and Android. Elsewhere, recording and prefetching do nothing.
+
+//------------------------------------------------------------------------------
+/// @brief      Writes the resident pages of the snapshots to a profile at
+///             |path|, unless a profile already exists there. Only the first
+///             call in the process writes a profile.
+///
+/// @return     Whether a profile was written.
+///
+bool RecordSnapshotPageProfile(const DartSnapshot& vm_snapshot,
+                               const DartSnapshot& isolate_snapshot,
+                               const std::string& path);
+
+//------------------------------------------------------------------------------
+/// @brief      Hints the kernel to read in the pages of the snapshots listed
+///             in the profile at |path|. Pages outside of the snapshots, for
+///             example in a profile recorded for another build, are ignored.
+///
+/// @return     Whether a profile was read.
+///
+bool PrefetchSnapshotPageProfile(const DartSnapshot& vm_snapshot,
+                                 const DartSnapshot& isolate_snapshot,
+                                 const std::string& path);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_RUNTIME_SNAPSHOT_PAGE_PROFILE_H_
@@ -0,0 +1,56 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/adaptive_quality_controller.h"
+
+#include <algorithm>
+
+namespace flutter {
+
+AdaptiveQualityController::AdaptiveQualityController() = default;
+
+AdaptiveQualityController::~AdaptiveQualityController() = default;
+
+bool AdaptiveQualityController::RecordFrameRasterized(
+    fml::TimeDelta raster_time,
+    fml::TimeDelta frame_budget) {
+  if (raster_time > frame_budget) {
+    overrun_count_ = std::min(overrun_count_ + 1, kOverrunFrameCount);
+    recovery_count_ = 0u;
+  } else {
+    overrun_count_ = overrun_count_ > 0u ? overrun_count_ - 1 : 0u;
+    if (raster_time * 4 < frame_budget * 3) {
+      recovery_count_++;
+    } else {
+      recovery_count_ = 0u;
+    }
+  }
+
+  if (overrun_count_ >= kOverrunFrameCount && level_ < kMaxLevel) {
+    level_++;
+  } else if (recovery_count_ >= kRecoveryFrameCount && level_ > 0u) {
+    level_--;
+  } else {
+    return false;
+  }
+  overrun_count_ = 0u;
+  recovery_count_ = 0u;
+  return true;
+}
+
+AdaptiveQualityController::Quality
+AdaptiveQualityController::GetQualityForLevel(size_t level) {
+  switch (std::min(level, kMaxLevel)) {
+    case 0u:
+      return {};
+    case 1u:
+      return {.blur_downsample_scale = 0.75,
+              .raster_cache_access_threshold_reduction = 1u};
+    default:
+      return {.blur_downsample_scale = 0.5,
+              .raster_cache_access_threshold_reduction = 2u};
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,76 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_ADAPTIVE_QUALITY_CONTROLLER_H_
+#define FLUTTER_SHELL_COMMON_ADAPTIVE_QUALITY_CONTROLLER_H_
+
+#include <cstddef>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+/// Lowers the quality of the frames while their rasterization keeps missing
+/// the frame budget, and restores it once the frames have been rasterized
+/// well within the budget for a while.
+///
+/// Overruns are counted with a leaky bucket, so that the quality is only
+/// lowered when most of the recent frames overran, and one level at a time.
+/// The quality is restored one level at a time after a longer run of fast
+/// frames, so that it doesn't oscillate around the budget.
+///
+/// Used by the |Rasterizer| on the raster thread only.
+class AdaptiveQualityController {
+ public:
+  /// The degradations applied at a quality level.
+  struct Quality {
+    /// The factor by which the downsample factor of Gaussian blurs is
+    /// multiplied.
+    double blur_downsample_scale = 1.0;
+    /// The number of frames by which the access threshold of the raster
+    /// cache is reduced, so that pictures are cached sooner.
+    size_t raster_cache_access_threshold_reduction = 0u;
+  };
+
+  // The lowest quality level. Level 0 is the full quality.
+  static constexpr size_t kMaxLevel = 2u;
+
+  // The number of overruns, net of the frames within budget, after which the
+  // quality is lowered.
+  static constexpr size_t kOverrunFrameCount = 10u;
+
+  // The number of consecutive frames rasterized in less than 3/4 of the
+  // budget after which the quality is raised.
+  static constexpr size_t kRecoveryFrameCount = 120u;
+
+  AdaptiveQualityController();
+
+  ~AdaptiveQualityController();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the rasterization time of a frame.
+  ///
+  /// @return     Whether the quality level changed.
+  ///
+  bool RecordFrameRasterized(fml::TimeDelta raster_time,
+                             fml::TimeDelta frame_budget);
+
+  size_t GetLevel() const { return level_; }
+
+  Quality GetQuality() const { return GetQualityForLevel(level_); }
+
+  static Quality GetQualityForLevel(size_t level);
+
+ private:
+  size_t level_ = 0u;
+  size_t overrun_count_ = 0u;
+  size_t recovery_count_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AdaptiveQualityController);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_ADAPTIVE_QUALITY_CONTROLLER_H_
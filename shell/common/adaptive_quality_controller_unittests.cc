@@ -0,0 +1,80 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/adaptive_quality_controller.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr fml::TimeDelta kFrameBudget = fml::TimeDelta::FromMilliseconds(16);
+constexpr fml::TimeDelta kSlowFrame = fml::TimeDelta::FromMilliseconds(20);
+constexpr fml::TimeDelta kFastFrame = fml::TimeDelta::FromMilliseconds(8);
+
+// Records |count| frames, and returns whether the level changed on the last.
+bool RecordFrames(AdaptiveQualityController& controller,
+                  fml::TimeDelta raster_time,
+                  size_t count) {
+  bool changed = false;
+  for (size_t i = 0; i < count; i++) {
+    changed = controller.RecordFrameRasterized(raster_time, kFrameBudget);
+  }
+  return changed;
+}
+
+}  // namespace
+
+TEST(AdaptiveQualityControllerTest, LowersQualityUnderSustainedOverruns) {
+  AdaptiveQualityController controller;
+  EXPECT_FALSE(RecordFrames(controller, kSlowFrame,
+                            AdaptiveQualityController::kOverrunFrameCount - 1));
+  EXPECT_EQ(controller.GetLevel(), 0u);
+  EXPECT_TRUE(RecordFrames(controller, kSlowFrame, 1));
+  EXPECT_EQ(controller.GetLevel(), 1u);
+  EXPECT_LT(controller.GetQuality().blur_downsample_scale, 1.0);
+  EXPECT_GT(controller.GetQuality().raster_cache_access_threshold_reduction,
+            0u);
+}
+
+TEST(AdaptiveQualityControllerTest, IgnoresOccasionalOverruns) {
+  AdaptiveQualityController controller;
+  for (size_t i = 0; i < 100; i++) {
+    EXPECT_FALSE(controller.RecordFrameRasterized(kSlowFrame, kFrameBudget));
+    EXPECT_FALSE(controller.RecordFrameRasterized(kFastFrame, kFrameBudget));
+  }
+  EXPECT_EQ(controller.GetLevel(), 0u);
+}
+
+TEST(AdaptiveQualityControllerTest, DoesNotGoBelowTheLowestLevel) {
+  AdaptiveQualityController controller;
+  RecordFrames(controller, kSlowFrame,
+               AdaptiveQualityController::kOverrunFrameCount *
+                   (AdaptiveQualityController::kMaxLevel + 2));
+  EXPECT_EQ(controller.GetLevel(), AdaptiveQualityController::kMaxLevel);
+}
+
+TEST(AdaptiveQualityControllerTest, RestoresQualityWithHysteresis) {
+  AdaptiveQualityController controller;
+  RecordFrames(controller, kSlowFrame,
+               AdaptiveQualityController::kOverrunFrameCount);
+  ASSERT_EQ(controller.GetLevel(), 1u);
+
+  // Frames just within the budget don't restore the quality.
+  EXPECT_FALSE(RecordFrames(controller, kFrameBudget,
+                            AdaptiveQualityController::kRecoveryFrameCount));
+  EXPECT_EQ(controller.GetLevel(), 1u);
+
+  EXPECT_FALSE(RecordFrames(
+      controller, kFastFrame,
+      AdaptiveQualityController::kRecoveryFrameCount - 1));
+  EXPECT_TRUE(RecordFrames(controller, kFastFrame, 1));
+  EXPECT_EQ(controller.GetLevel(), 0u);
+  EXPECT_EQ(controller.GetQuality().blur_downsample_scale, 1.0);
+}
+
+}  // namespace testing
+}  // namespace flutter
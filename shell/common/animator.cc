@@ -66,6 +66,16 @@ void Animator::BeginFrame(
 
   frame_timings_recorder_ = std::move(frame_timings_recorder);
   frame_timings_recorder_->RecordBuildStart(fml::TimePoint::Now());
+  const fml::TimeDelta vsync_interval =
+      frame_timings_recorder_->GetVsyncTargetTime() -
+      frame_timings_recorder_->GetVsyncStartTime();
+  if (frame_scheduler_) {
+    frame_scheduler_->RecordVsyncInterval(vsync_interval);
+  }
+  if (thread_affinity_policy_) {
+    thread_affinity_policy_->OnFrameBegin(
+        frame_timings_recorder_->GetBuildStartTime(), vsync_interval);
+  }
 
   size_t flow_id_count = trace_flow_ids_.size();
   std::unique_ptr<uint64_t[]> flow_ids =
@@ -99,11 +109,17 @@ void Animator::BeginFrame(
       // full because the consumer is being too slow. Try again at the next
       // frame interval.
       TRACE_EVENT0("flutter", "PipelineFull");
-      RequestFrame();
+      if (!ScheduleEarlyBuild()) {
+        RequestFrame();
+      }
       return;
     }
   }
 
+  BeginFrameWithContinuation();
+}
+
+void Animator::BeginFrameWithContinuation() {
   // We have acquired a valid continuation from the pipeline and are ready
   // to service potential frame.
   FML_DCHECK(producer_continuation_);
@@ -139,6 +155,53 @@ void Animator::BeginFrame(
         },
         kNotifyIdleTaskWaitTime);
   }
+
+  if (!frame_scheduled_ && thread_affinity_policy_) {
+    task_runners_.GetUITaskRunner()->PostDelayedTask(
+        [self = weak_factory_.GetWeakPtr()]() {
+          if (self && !self->frame_scheduled_) {
+            self->thread_affinity_policy_->OnIdle(fml::TimePoint::Now());
+          }
+        },
+        ThreadAffinityPolicy::kIdleTimeToDemote);
+  }
+}
+
+bool Animator::ScheduleEarlyBuild() {
+  if (!frame_scheduler_ ||
+      !frame_scheduler_->ShouldStartBuildEarly(
+          fml::TimePoint::Now(),
+          frame_timings_recorder_->GetVsyncTargetTime())) {
+    return false;
+  }
+  task_runners_.GetUITaskRunner()->PostDelayedTask(
+      [self = weak_factory_.GetWeakPtr(),
+       frame_number = frame_timings_recorder_->GetFrameNumber()]() {
+        if (!self) {
+          return;
+        }
+        self->RetryBeginFrame(frame_number);
+      },
+      kEarlyBuildRetryInterval);
+  return true;
+}
+
+void Animator::RetryBeginFrame(uint64_t frame_number) {
+  // Bail if another vsync began a newer frame in the meantime.
+  if (!frame_timings_recorder_ ||
+      frame_timings_recorder_->GetFrameNumber() != frame_number ||
+      producer_continuation_) {
+    return;
+  }
+  producer_continuation_ = layer_tree_pipeline_->Produce();
+  if (!producer_continuation_) {
+    if (!ScheduleEarlyBuild()) {
+      RequestFrame();
+    }
+    return;
+  }
+  TRACE_EVENT0("flutter", "Animator::RetryBeginFrame");
+  BeginFrameWithContinuation();
 }
 
 void Animator::Render(std::unique_ptr<flutter::LayerTree> layer_tree,
@@ -264,6 +327,48 @@ void Animator::AwaitVSync() {
   }
 }
 
+void Animator::EnableDeadlineAwareScheduling() {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  FML_DCHECK(!producer_continuation_);
+#if SHELL_ENABLE_METAL
+  const size_t max_pipeline_depth = FrameScheduler::kMaxPipelineDepth;
+#else   // SHELL_ENABLE_METAL
+  // See the constructor for why frames aren't pipelined if the platform and
+  // raster threads are the same.
+  const size_t max_pipeline_depth =
+      task_runners_.GetPlatformTaskRunner() ==
+              task_runners_.GetRasterTaskRunner()
+          ? 1u
+          : FrameScheduler::kMaxPipelineDepth;
+#endif  // SHELL_ENABLE_METAL
+  layer_tree_pipeline_ = std::make_shared<FramePipeline>(max_pipeline_depth);
+  frame_scheduler_ = std::make_unique<FrameScheduler>(max_pipeline_depth);
+  layer_tree_pipeline_->SetDepthLimit(frame_scheduler_->GetPipelineDepth());
+}
+
+void Animator::EnableWorkloadThreadAffinity() {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  thread_affinity_policy_ = ThreadAffinityPolicy::Create(task_runners_);
+}
+
+void Animator::OnFrameRasterized(const FrameTiming& timing) {
+  if (thread_affinity_policy_) {
+    thread_affinity_policy_->OnFrameRasterized(timing);
+  }
+  if (!frame_scheduler_) {
+    return;
+  }
+  frame_scheduler_->RecordFrameRasterized(timing);
+  const size_t pipeline_depth = frame_scheduler_->GetPipelineDepth();
+  layer_tree_pipeline_->SetDepthLimit(pipeline_depth);
+  FML_TRACE_COUNTER(
+      "flutter", "FrameScheduler", reinterpret_cast<int64_t>(this),
+      "PipelineDepth", pipeline_depth, "PredictedBuildMicros",
+      frame_scheduler_->GetPredictedBuildDuration().ToMicroseconds(),
+      "PredictedRasterMicros",
+      frame_scheduler_->GetPredictedRasterDuration().ToMicroseconds());
+}
+
 void Animator::ScheduleSecondaryVsyncCallback(uintptr_t id,
                                               const fml::closure& callback) {
   waiter_->ScheduleSecondaryCallback(id, callback);
@@ -13,8 +13,10 @@
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/frame_scheduler.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/rasterizer.h"
+#include "flutter/shell/common/thread_host.h"
 #include "flutter/shell/common/vsync_waiter.h"
 
 namespace flutter {
@@ -88,9 +90,52 @@ class Animator final {
   // rendering.
   void EnqueueTraceFlowId(uint64_t trace_flow_id);
 
+  //--------------------------------------------------------------------------
+  /// @brief    Schedules frames using the timings of the rasterized frames,
+  ///           which must be reported with |OnFrameRasterized|.
+  ///
+  ///           The depth of the frame pipeline is adapted between 1 and 3
+  ///           frames to how often frames miss their vsync, and a frame that
+  ///           finds the pipeline full starts building as soon as there is
+  ///           room instead of at the next vsync if it's predicted to be
+  ///           built before its target time.
+  ///
+  ///           Must be called before the first frame is requested.
+  ///
+  void EnableDeadlineAwareScheduling();
+
+  //--------------------------------------------------------------------------
+  /// @brief    Moves the UI and raster threads to the performance cores
+  ///           while frames are being produced, and back to the efficiency
+  ///           cores once no frame has been produced for a while. Expensive
+  ///           frames, which must be reported with |OnFrameRasterized|, also
+  ///           move the threads to the performance cores.
+  ///
+  void EnableWorkloadThreadAffinity();
+
+  //--------------------------------------------------------------------------
+  /// @brief    Reports the timings of a rasterized frame to the frame
+  ///           scheduler and the thread affinity policy, if they are
+  ///           enabled.
+  ///
+  void OnFrameRasterized(const FrameTiming& timing);
+
  private:
+  // How often a frame that found the pipeline full checks whether the
+  // pipeline has room, when it's started early.
+  static constexpr fml::TimeDelta kEarlyBuildRetryInterval =
+      fml::TimeDelta::FromMilliseconds(1);
+
   void BeginFrame(std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
 
+  // The part of |BeginFrame| once a producer continuation was acquired.
+  void BeginFrameWithContinuation();
+
+  // Returns false if the frame can't start building before the next vsync.
+  bool ScheduleEarlyBuild();
+
+  void RetryBeginFrame(uint64_t frame_number);
+
   bool CanReuseLastLayerTrees();
 
   void DrawLastLayerTrees(
@@ -109,6 +154,8 @@ class Animator final {
   uint64_t frame_request_number_ = 1;
   fml::TimeDelta dart_frame_deadline_;
   std::shared_ptr<FramePipeline> layer_tree_pipeline_;
+  std::unique_ptr<FrameScheduler> frame_scheduler_;
+  std::unique_ptr<ThreadAffinityPolicy> thread_affinity_policy_;
   fml::Semaphore pending_frame_semaphore_;
   FramePipeline::ProducerContinuation producer_continuation_;
   bool regenerate_layer_trees_ = false;
@@ -60,7 +60,14 @@ Engine::Engine(
                                         gpu_disabled_switch)),
       task_runners_(task_runners),
       weak_factory_(this) {
-  pointer_data_dispatcher_ = dispatcher_maker(*this);
+  if (settings_.enable_pointer_event_coalescing ||
+      settings_.enable_pointer_event_resampling) {
+    pointer_data_dispatcher_ =
+        std::make_unique<CoalescingPointerDataDispatcher>(
+            *this, settings_.enable_pointer_event_resampling);
+  } else {
+    pointer_data_dispatcher_ = dispatcher_maker(*this);
+  }
 }
 
 Engine::Engine(Delegate& delegate,
@@ -146,6 +153,8 @@ std::unique_ptr<Engine> Engine::Spawn(
       /*image_generator_registry=*/result->GetImageGeneratorRegistry(),
       /*snapshot_delegate=*/std::move(snapshot_delegate));
   result->initial_route_ = initial_route;
+  result->skip_next_default_font_manager_setup_ = true;
+  result->skip_next_font_registration_ = true;
   return result;
 }
 
@@ -157,9 +166,23 @@ fml::WeakPtr<Engine> Engine::GetWeakPtr() const {
 
 void Engine::SetupDefaultFontManager() {
   TRACE_EVENT0("flutter", "Engine::SetupDefaultFontManager");
+  if (skip_next_default_font_manager_setup_) {
+    skip_next_default_font_manager_setup_ = false;
+    return;
+  }
   font_collection_->SetupDefaultFontManager(settings_.font_initialization_data);
 }
 
+void Engine::PrefetchDefaultFontManager() {
+  if (skip_next_default_font_manager_setup_) {
+    skip_next_default_font_manager_setup_ = false;
+    return;
+  }
+  font_collection_->PrefetchDefaultFontManager(
+      settings_.font_initialization_data,
+      runtime_controller_->GetDartVM()->GetConcurrentWorkerTaskRunner());
+}
+
 std::shared_ptr<AssetManager> Engine::GetAssetManager() {
   return asset_manager_;
 }
@@ -168,6 +191,10 @@ fml::WeakPtr<ImageDecoder> Engine::GetImageDecoderWeakPtr() {
   return image_decoder_->GetWeakPtr();
 }
 
+std::function<size_t()> Engine::GetPurgeableImageTextureBytesCallback() const {
+  return image_decoder_->GetPurgeableTextureBytesCallback();
+}
+
 fml::WeakPtr<ImageGeneratorRegistry> Engine::GetImageGeneratorRegistry() {
   return image_generator_registry_.GetWeakPtr();
 }
@@ -184,6 +211,11 @@ bool Engine::UpdateAssetManager(
     return false;
   }
 
+  if (skip_next_font_registration_) {
+    skip_next_font_registration_ = false;
+    return true;
+  }
+
   // Using libTXT as the text engine.
   if (settings_.use_asset_fonts) {
     font_collection_->RegisterFonts(asset_manager_);
@@ -221,6 +253,7 @@ Engine::RunStatus Engine::Run(RunConfiguration configuration) {
   last_entry_point_args_ = configuration.GetEntrypointArgs();
 #endif
 
+  font_collection_->WaitForDefaultFontManager();
   UpdateAssetManager(configuration.GetAssetManager());
 
   if (runtime_controller_->IsRootIsolateRunning()) {
@@ -259,6 +292,7 @@ Engine::RunStatus Engine::Run(RunConfiguration configuration) {
 }
 
 void Engine::BeginFrame(fml::TimePoint frame_time, uint64_t frame_number) {
+  pointer_data_dispatcher_->OnBeginFrame(frame_time);
   runtime_controller_->BeginFrame(frame_time, frame_number);
 }
 
@@ -266,6 +300,10 @@ void Engine::ReportTimings(std::vector<int64_t> timings) {
   runtime_controller_->ReportTimings(std::move(timings));
 }
 
+void Engine::OnFrameRasterized(const FrameTiming& timing) {
+  animator_->OnFrameRasterized(timing);
+}
+
 void Engine::NotifyIdle(fml::TimeDelta deadline) {
   runtime_controller_->NotifyIdle(deadline);
 }
@@ -275,6 +313,10 @@ void Engine::NotifyDestroyed() {
   runtime_controller_->NotifyDestroyed();
 }
 
+void Engine::NotifyLowMemoryWarning() {
+  image_decoder_->NotifyLowMemoryWarning();
+}
+
 std::optional<uint32_t> Engine::GetUIIsolateReturnCode() {
   return runtime_controller_->GetRootIsolateReturnCode();
 }
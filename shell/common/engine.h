@@ -480,9 +480,20 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
 
   //----------------------------------------------------------------------------
   /// @brief      Setup default font manager according to specific platform.
+  ///             The initial setup of a spawned engine is skipped, as it
+  ///             shares the font collection of its spawner.
   ///
   void SetupDefaultFontManager();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Starts creating the default font manager on a concurrent
+  ///             worker. The font manager is set when the engine is run, right
+  ///             before the asset fonts are registered. Like
+  ///             |SetupDefaultFontManager|, this is skipped for the initial
+  ///             setup of a spawned engine.
+  ///
+  void PrefetchDefaultFontManager();
+
   //----------------------------------------------------------------------------
   /// @brief      Updates the asset manager referenced by the root isolate of a
   ///             Flutter application. This happens implicitly in the call to
@@ -599,6 +610,12 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///             some cleanp activities.
   void NotifyDestroyed();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the engine that the system is low on memory. The
+  ///             image decoder releases the memory of the decoded images that
+  ///             it can recreate.
+  void NotifyLowMemoryWarning();
+
   //----------------------------------------------------------------------------
   /// @brief      Dart code cannot fully measure the time it takes for a
   ///             specific frame to be rendered. This is because Dart code only
@@ -632,6 +649,16 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   void ReportTimings(std::vector<int64_t> timings);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Reports the timings of a frame as soon as it has been
+  ///             rasterized so that the animator can schedule the next frames
+  ///             from them. Only called if
+  ///             `Settings::enable_deadline_aware_frame_scheduling` is set.
+  ///
+  /// @param[in]  timing  The timings of the rasterized frame.
+  ///
+  void OnFrameRasterized(const FrameTiming& timing);
+
   //----------------------------------------------------------------------------
   /// @brief      Gets the main port of the root isolate. Since the isolate is
   ///             created immediately in the constructor of the engine, it is
@@ -846,6 +873,13 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   // Return the weak_ptr of ImageDecoder.
   fml::WeakPtr<ImageDecoder> GetImageDecoderWeakPtr();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a function reporting the bytes of the textures of
+  ///             decoded images that can be purged, which may be called on
+  ///             any thread, or null if they aren't tracked.
+  ///
+  std::function<size_t()> GetPurgeableImageTextureBytesCallback() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Get the `ImageGeneratorRegistry` associated with the current
   ///             engine.
@@ -1031,6 +1065,12 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   std::string initial_route_;
   std::shared_ptr<AssetManager> asset_manager_;
   std::shared_ptr<FontCollection> font_collection_;
+  // A spawned engine shares |font_collection_| with its spawner, which has
+  // already set up the default font manager and registered the fonts of the
+  // bundle. These skip the initial setup and registration of the spawned
+  // engine, later reloads are still applied.
+  bool skip_next_default_font_manager_setup_ = false;
+  bool skip_next_font_registration_ = false;
   const std::unique_ptr<ImageDecoder> image_decoder_;
   ImageGeneratorRegistry image_generator_registry_;
   TaskRunners task_runners_;
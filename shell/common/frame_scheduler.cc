@@ -0,0 +1,114 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_scheduler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+FrameScheduler::FrameScheduler(size_t max_pipeline_depth)
+    : max_pipeline_depth_(std::clamp(max_pipeline_depth, kMinPipelineDepth,
+                                     kMaxPipelineDepth)),
+      // Two frames in flight is what the animator used before frames were
+      // scheduled.
+      pipeline_depth_(std::min<size_t>(2u, max_pipeline_depth_)) {}
+
+FrameScheduler::~FrameScheduler() = default;
+
+void FrameScheduler::RecordVsyncInterval(fml::TimeDelta interval) {
+  vsync_interval_ = interval;
+}
+
+void FrameScheduler::RecordFrameRasterized(const FrameTiming& timing) {
+  FrameDurations durations;
+  durations.build = timing.Get(FrameTiming::kBuildFinish) -
+                    timing.Get(FrameTiming::kBuildStart);
+  durations.raster = timing.Get(FrameTiming::kRasterFinish) -
+                     timing.Get(FrameTiming::kRasterStart);
+  durations.janky = vsync_interval_ > fml::TimeDelta::Zero() &&
+                    (durations.build > vsync_interval_ ||
+                     durations.raster > vsync_interval_);
+  history_.push_back(durations);
+  if (history_.size() > kHistorySize) {
+    history_.pop_front();
+  }
+
+  frames_since_depth_change_++;
+  if (durations.janky) {
+    janky_frames_since_depth_change_++;
+  }
+
+  if (janky_frames_since_depth_change_ >= kJankyFramesToDeepen) {
+    SetPipelineDepth(std::min(pipeline_depth_ + 1u, max_pipeline_depth_));
+    return;
+  }
+  if (frames_since_depth_change_ < kHistorySize) {
+    return;
+  }
+  // The UI thread can only start building a frame once the frame that
+  // occupies its spot in the pipeline has been rasterized, so one frame less
+  // in flight fits if building and rasterizing a frame takes no more than that
+  // many vsync intervals.
+  const auto duration =
+      GetPredictedBuildDuration() + GetPredictedRasterDuration();
+  if (janky_frames_since_depth_change_ == 0u && pipeline_depth_ > 1u &&
+      duration <= vsync_interval_ * static_cast<int64_t>(pipeline_depth_ - 1)) {
+    SetPipelineDepth(pipeline_depth_ - 1u);
+    return;
+  }
+  SetPipelineDepth(pipeline_depth_);
+}
+
+fml::TimeDelta FrameScheduler::GetPredictedBuildDuration() const {
+  return GetPredictedDuration(&FrameDurations::build);
+}
+
+fml::TimeDelta FrameScheduler::GetPredictedRasterDuration() const {
+  return GetPredictedDuration(&FrameDurations::raster);
+}
+
+size_t FrameScheduler::GetPipelineDepth() const {
+  return pipeline_depth_;
+}
+
+bool FrameScheduler::ShouldStartBuildEarly(fml::TimePoint now,
+                                           fml::TimePoint target_time) const {
+  if (history_.size() < kMinHistorySize ||
+      vsync_interval_ <= fml::TimeDelta::Zero()) {
+    return false;
+  }
+  return GetPredictedRasterDuration() <= vsync_interval_ / 2 &&
+         now + GetPredictedBuildDuration() <= target_time;
+}
+
+fml::TimeDelta FrameScheduler::GetPredictedDuration(
+    fml::TimeDelta FrameDurations::*duration) const {
+  if (history_.size() < kMinHistorySize) {
+    return fml::TimeDelta::Zero();
+  }
+  // The 90th percentile, so that a single slow frame doesn't throw off the
+  // prediction but a few of them do.
+  std::vector<fml::TimeDelta> durations;
+  durations.reserve(history_.size());
+  for (const auto& frame : history_) {
+    durations.push_back(frame.*duration);
+  }
+  auto percentile = durations.begin() + (durations.size() * 9u) / 10u;
+  std::nth_element(durations.begin(), percentile, durations.end());
+  return *percentile;
+}
+
+void FrameScheduler::SetPipelineDepth(size_t pipeline_depth) {
+  FML_DCHECK(pipeline_depth >= kMinPipelineDepth &&
+             pipeline_depth <= max_pipeline_depth_);
+  pipeline_depth_ = pipeline_depth;
+  frames_since_depth_change_ = 0u;
+  janky_frames_since_depth_change_ = 0u;
+}
+
+}  // namespace flutter
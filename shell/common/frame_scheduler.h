@@ -0,0 +1,120 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_SCHEDULER_H_
+#define FLUTTER_SHELL_COMMON_FRAME_SCHEDULER_H_
+
+#include <deque>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+/// Predicts how long the next frames will take to build and rasterize from
+/// the timings of the last rasterized frames, and picks the depth of the frame
+/// pipeline accordingly.
+///
+/// A deeper pipeline lets the UI thread build a frame while the raster thread
+/// is still busy with the previous ones, which absorbs the occasional slow
+/// frame, at the cost of one frame interval of latency per frame in flight.
+/// The scheduler deepens the pipeline when frames are missing their vsync and
+/// makes it shallower again once frames comfortably fit in the interval.
+///
+/// Used by the |Animator| on the UI thread only.
+class FrameScheduler {
+ public:
+  static constexpr size_t kMinPipelineDepth = 1u;
+  static constexpr size_t kMaxPipelineDepth = 3u;
+
+  // The number of rasterized frames the predictions are made from.
+  static constexpr size_t kHistorySize = 32u;
+
+  // The number of frames that must have been rasterized before predictions
+  // are made.
+  static constexpr size_t kMinHistorySize = 8u;
+
+  // The number of janky frames in the history that deepen the pipeline.
+  static constexpr size_t kJankyFramesToDeepen = 2u;
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  max_pipeline_depth  The depth of the frame pipeline, which
+  ///                                 the pipeline depth never exceeds.
+  ///
+  explicit FrameScheduler(size_t max_pipeline_depth);
+
+  ~FrameScheduler();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the vsync interval of the frame being built.
+  ///
+  void RecordVsyncInterval(fml::TimeDelta interval);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the timings of a rasterized frame and updates the
+  ///             pipeline depth.
+  ///
+  void RecordFrameRasterized(const FrameTiming& timing);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The duration within which most of the recent frames were
+  ///             built, or zero if too few frames have been rasterized.
+  ///
+  fml::TimeDelta GetPredictedBuildDuration() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The duration within which most of the recent frames were
+  ///             rasterized, or zero if too few frames have been rasterized.
+  ///
+  fml::TimeDelta GetPredictedRasterDuration() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of frames that may be in flight in the pipeline.
+  ///
+  size_t GetPipelineDepth() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether a frame that found the pipeline full should be built
+  ///             as soon as the frame being rasterized is done instead of at
+  ///             the next vsync.
+  ///
+  ///             This is only the case if rasterizing is predicted to take a
+  ///             fraction of the vsync interval and the frame is predicted to
+  ///             be built before its target time.
+  ///
+  /// @param[in]  now          The current time.
+  /// @param[in]  target_time  The vsync target time of the frame.
+  ///
+  bool ShouldStartBuildEarly(fml::TimePoint now,
+                             fml::TimePoint target_time) const;
+
+ private:
+  struct FrameDurations {
+    fml::TimeDelta build;
+    fml::TimeDelta raster;
+    bool janky = false;
+  };
+
+  const size_t max_pipeline_depth_;
+  size_t pipeline_depth_;
+  fml::TimeDelta vsync_interval_;
+  std::deque<FrameDurations> history_;
+  // The frames rasterized since the pipeline depth last changed. Only these
+  // are considered to change it again.
+  size_t frames_since_depth_change_ = 0u;
+  size_t janky_frames_since_depth_change_ = 0u;
+
+  fml::TimeDelta GetPredictedDuration(
+      fml::TimeDelta FrameDurations::*duration) const;
+
+  void SetPipelineDepth(size_t pipeline_depth);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameScheduler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_SCHEDULER_H_
@@ -0,0 +1,127 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_scheduler.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr fml::TimeDelta kVsyncInterval =
+    fml::TimeDelta::FromMicroseconds(8333);
+
+FrameTiming MakeFrameTiming(fml::TimeDelta build, fml::TimeDelta raster) {
+  const auto vsync_start = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(1000));
+  FrameTiming timing;
+  timing.Set(FrameTiming::kVsyncStart, vsync_start);
+  timing.Set(FrameTiming::kBuildStart, vsync_start);
+  timing.Set(FrameTiming::kBuildFinish, vsync_start + build);
+  timing.Set(FrameTiming::kRasterStart, vsync_start + build);
+  timing.Set(FrameTiming::kRasterFinish, vsync_start + build + raster);
+  return timing;
+}
+
+void RecordFrames(FrameScheduler& scheduler,
+                  size_t count,
+                  fml::TimeDelta build,
+                  fml::TimeDelta raster) {
+  for (size_t i = 0; i < count; i++) {
+    scheduler.RecordVsyncInterval(kVsyncInterval);
+    scheduler.RecordFrameRasterized(MakeFrameTiming(build, raster));
+  }
+}
+
+}  // namespace
+
+TEST(FrameSchedulerTest, PredictsDurationsFromRecentFrames) {
+  FrameScheduler scheduler(FrameScheduler::kMaxPipelineDepth);
+  EXPECT_EQ(scheduler.GetPredictedBuildDuration(), fml::TimeDelta::Zero());
+
+  RecordFrames(scheduler, FrameScheduler::kHistorySize,
+               fml::TimeDelta::FromMilliseconds(2),
+               fml::TimeDelta::FromMilliseconds(3));
+  EXPECT_EQ(scheduler.GetPredictedBuildDuration(),
+            fml::TimeDelta::FromMilliseconds(2));
+  EXPECT_EQ(scheduler.GetPredictedRasterDuration(),
+            fml::TimeDelta::FromMilliseconds(3));
+
+  // A single slow frame doesn't change the prediction.
+  RecordFrames(scheduler, 1, fml::TimeDelta::FromMilliseconds(20),
+               fml::TimeDelta::FromMilliseconds(3));
+  EXPECT_EQ(scheduler.GetPredictedBuildDuration(),
+            fml::TimeDelta::FromMilliseconds(2));
+}
+
+TEST(FrameSchedulerTest, DeepensPipelineOnJank) {
+  FrameScheduler scheduler(FrameScheduler::kMaxPipelineDepth);
+  EXPECT_EQ(scheduler.GetPipelineDepth(), 2u);
+
+  RecordFrames(scheduler, FrameScheduler::kJankyFramesToDeepen,
+               fml::TimeDelta::FromMilliseconds(2),
+               fml::TimeDelta::FromMilliseconds(12));
+  EXPECT_EQ(scheduler.GetPipelineDepth(), 3u);
+
+  RecordFrames(scheduler, FrameScheduler::kJankyFramesToDeepen,
+               fml::TimeDelta::FromMilliseconds(2),
+               fml::TimeDelta::FromMilliseconds(12));
+  EXPECT_EQ(scheduler.GetPipelineDepth(), FrameScheduler::kMaxPipelineDepth);
+}
+
+TEST(FrameSchedulerTest, ShrinksPipelineWhenFramesFitInVsyncInterval) {
+  FrameScheduler scheduler(FrameScheduler::kMaxPipelineDepth);
+
+  RecordFrames(scheduler, FrameScheduler::kHistorySize - 1,
+               fml::TimeDelta::FromMilliseconds(2),
+               fml::TimeDelta::FromMilliseconds(3));
+  EXPECT_EQ(scheduler.GetPipelineDepth(), 2u);
+  RecordFrames(scheduler, 1, fml::TimeDelta::FromMilliseconds(2),
+               fml::TimeDelta::FromMilliseconds(3));
+  EXPECT_EQ(scheduler.GetPipelineDepth(), 1u);
+
+  // Frames that don't fit in one interval keep two frames in flight.
+  FrameScheduler slow_scheduler(FrameScheduler::kMaxPipelineDepth);
+  RecordFrames(slow_scheduler, FrameScheduler::kHistorySize,
+               fml::TimeDelta::FromMilliseconds(5),
+               fml::TimeDelta::FromMilliseconds(6));
+  EXPECT_EQ(slow_scheduler.GetPipelineDepth(), 2u);
+}
+
+TEST(FrameSchedulerTest, PipelineDepthIsClampedToMaxDepth) {
+  FrameScheduler scheduler(1u);
+  EXPECT_EQ(scheduler.GetPipelineDepth(), 1u);
+
+  RecordFrames(scheduler, FrameScheduler::kJankyFramesToDeepen,
+               fml::TimeDelta::FromMilliseconds(2),
+               fml::TimeDelta::FromMilliseconds(12));
+  EXPECT_EQ(scheduler.GetPipelineDepth(), 1u);
+}
+
+TEST(FrameSchedulerTest, StartsBuildEarlyOnlyIfItCanMakeTheDeadline) {
+  FrameScheduler scheduler(FrameScheduler::kMaxPipelineDepth);
+  const auto now = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(1000));
+  const auto target_time = now + fml::TimeDelta::FromMilliseconds(4);
+  EXPECT_FALSE(scheduler.ShouldStartBuildEarly(now, target_time));
+
+  RecordFrames(scheduler, FrameScheduler::kMinHistorySize,
+               fml::TimeDelta::FromMilliseconds(2),
+               fml::TimeDelta::FromMilliseconds(3));
+  EXPECT_TRUE(scheduler.ShouldStartBuildEarly(now, target_time));
+  EXPECT_FALSE(scheduler.ShouldStartBuildEarly(
+      now + fml::TimeDelta::FromMilliseconds(3), target_time));
+
+  // Rasterizing takes too long for the pipeline to have room soon.
+  FrameScheduler slow_scheduler(FrameScheduler::kMaxPipelineDepth);
+  RecordFrames(slow_scheduler, FrameScheduler::kMinHistorySize,
+               fml::TimeDelta::FromMilliseconds(2),
+               fml::TimeDelta::FromMilliseconds(6));
+  EXPECT_FALSE(slow_scheduler.ShouldStartBuildEarly(now, target_time));
+}
+
+}  // namespace testing
+}  // namespace flutter
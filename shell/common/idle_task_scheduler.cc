@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_task_scheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+IdleTaskScheduler::IdleTaskScheduler() = default;
+
+IdleTaskScheduler::~IdleTaskScheduler() = default;
+
+IdleTaskScheduler::TaskId IdleTaskScheduler::AddTask(Task task) {
+  const auto id = next_id_++;
+  tasks_.push_back({.id = id, .task = std::move(task)});
+  return id;
+}
+
+void IdleTaskScheduler::RemoveTask(TaskId id) {
+  auto found =
+      std::find_if(tasks_.begin(), tasks_.end(),
+                   [id](const Entry& entry) { return entry.id == id; });
+  if (found == tasks_.end()) {
+    return;
+  }
+  const auto index = static_cast<size_t>(found - tasks_.begin());
+  tasks_.erase(found);
+  if (next_task_index_ > index) {
+    next_task_index_--;
+  }
+}
+
+size_t IdleTaskScheduler::RunTasks(fml::TimePoint deadline) {
+  if (tasks_.empty()) {
+    return 0u;
+  }
+  const auto idle_time = deadline - fml::TimePoint::Now();
+  size_t run_count = 0u;
+  const size_t task_count = tasks_.size();
+  const size_t first_index = next_task_index_ % task_count;
+  for (size_t i = 0u; i < task_count; i++) {
+    const size_t index = (first_index + i) % task_count;
+    auto& task = tasks_[index].task;
+    const auto start = fml::TimePoint::Now();
+    if (idle_time < task.min_idle_time ||
+        start + task.estimated_duration > deadline) {
+      continue;
+    }
+    {
+      TRACE_EVENT1("flutter", "IdleTask", "name", task.name.c_str());
+      task.callback(deadline);
+    }
+    run_count++;
+    next_task_index_ = index + 1u;
+    // Move the estimate a quarter of the way to the measured duration.
+    const auto duration = fml::TimePoint::Now() - start;
+    task.estimated_duration = fml::TimeDelta::FromMicroseconds(
+        (task.estimated_duration.ToMicroseconds() * 3 +
+         duration.ToMicroseconds()) /
+        4);
+  }
+  return run_count;
+}
+
+}  // namespace flutter
@@ -0,0 +1,80 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_IDLE_TASK_SCHEDULER_H_
+#define FLUTTER_SHELL_COMMON_IDLE_TASK_SCHEDULER_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+/// Runs the maintenance work registered by subsystems in the idle periods
+/// between frames, instead of during frames or never.
+///
+/// Each idle period, the tasks are visited round robin, starting after the
+/// last task that ran, and run if the time left before the deadline covers
+/// their estimated duration. The estimates are refined with the measured
+/// durations of the tasks.
+///
+/// Not thread safe. Tasks run on the thread that calls |RunTasks|, and must
+/// not add or remove tasks.
+class IdleTaskScheduler {
+ public:
+  using TaskId = size_t;
+
+  struct Task {
+    /// The name of the trace event of the task.
+    std::string name;
+    /// The task only runs when at least this much of the idle period is
+    /// left, so that work undone by the next frame waits until no frame is
+    /// scheduled.
+    fml::TimeDelta min_idle_time;
+    /// The first estimate of the duration of the task.
+    fml::TimeDelta estimated_duration;
+    /// Does the work. Long running work should be split so that it returns
+    /// by the deadline.
+    std::function<void(fml::TimePoint deadline)> callback;
+  };
+
+  IdleTaskScheduler();
+
+  ~IdleTaskScheduler();
+
+  TaskId AddTask(Task task);
+
+  void RemoveTask(TaskId id);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Runs the tasks that fit before the deadline.
+  ///
+  /// @param[in]  deadline  The end of the idle period.
+  ///
+  /// @return     The number of tasks that ran.
+  ///
+  size_t RunTasks(fml::TimePoint deadline);
+
+  size_t GetTaskCount() const { return tasks_.size(); }
+
+ private:
+  struct Entry {
+    TaskId id;
+    Task task;
+  };
+
+  std::vector<Entry> tasks_;
+  TaskId next_id_ = 0u;
+  size_t next_task_index_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(IdleTaskScheduler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_IDLE_TASK_SCHEDULER_H_
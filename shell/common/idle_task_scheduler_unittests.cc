@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_task_scheduler.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static IdleTaskScheduler::Task MakeTask(std::vector<int>& runs, int value) {
+  return {.name = "Task", .callback = [&runs, value](fml::TimePoint) {
+            runs.push_back(value);
+          }};
+}
+
+TEST(IdleTaskSchedulerTest, RunsTasksThatFitBeforeTheDeadline) {
+  IdleTaskScheduler scheduler;
+  std::vector<int> runs;
+  scheduler.AddTask(MakeTask(runs, 1));
+  auto slow_task = MakeTask(runs, 2);
+  slow_task.estimated_duration = fml::TimeDelta::FromSeconds(60);
+  scheduler.AddTask(std::move(slow_task));
+
+  auto deadline = fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(10);
+  EXPECT_EQ(scheduler.RunTasks(deadline), 1u);
+  EXPECT_EQ(runs, std::vector<int>({1}));
+
+  // Nothing runs past the deadline.
+  EXPECT_EQ(scheduler.RunTasks(fml::TimePoint::Now()), 0u);
+}
+
+TEST(IdleTaskSchedulerTest, SkipsTasksNeedingLongerIdlePeriods) {
+  IdleTaskScheduler scheduler;
+  std::vector<int> runs;
+  auto long_idle_task = MakeTask(runs, 1);
+  long_idle_task.min_idle_time = fml::TimeDelta::FromSeconds(60);
+  scheduler.AddTask(std::move(long_idle_task));
+  scheduler.AddTask(MakeTask(runs, 2));
+
+  auto now = fml::TimePoint::Now();
+  scheduler.RunTasks(now + fml::TimeDelta::FromSeconds(10));
+  EXPECT_EQ(runs, std::vector<int>({2}));
+  scheduler.RunTasks(now + fml::TimeDelta::FromSeconds(120));
+  EXPECT_EQ(runs, std::vector<int>({2, 1, 2}));
+}
+
+TEST(IdleTaskSchedulerTest, StartsAfterTheLastTaskThatRan) {
+  IdleTaskScheduler scheduler;
+  std::vector<int> runs;
+  scheduler.AddTask(MakeTask(runs, 1));
+  scheduler.AddTask(MakeTask(runs, 2));
+  auto id = scheduler.AddTask(MakeTask(runs, 3));
+
+  auto deadline = fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(10);
+  scheduler.RunTasks(deadline);
+  scheduler.RemoveTask(id);
+  EXPECT_EQ(scheduler.GetTaskCount(), 2u);
+  scheduler.RunTasks(deadline);
+  EXPECT_EQ(runs, std::vector<int>({1, 2, 3, 1, 2}));
+}
+
+}  // namespace testing
+}  // namespace flutter
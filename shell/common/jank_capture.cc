@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/jank_capture.h"
+
+#include "flutter/fml/trace_ring_buffer.h"
+
+namespace flutter {
+
+namespace {
+
+using fml::tracing::TraceRingBuffer;
+using EventType = TraceRingBuffer::EventType;
+
+constexpr double kDefaultThresholdFrameBudgets = 2.0;
+
+int64_t ToNanos(fml::TimePoint time) {
+  return time.ToEpochDelta().ToNanoseconds();
+}
+
+void AddSlice(std::vector<TraceRingBuffer::Event>& events,
+              const char* name,
+              fml::TimePoint begin,
+              fml::TimePoint end) {
+  events.push_back({.type = EventType::kSliceBegin,
+                    .timestamp_nanos = ToNanos(begin),
+                    .name = name});
+  events.push_back({.type = EventType::kSliceEnd,
+                    .timestamp_nanos = ToNanos(end),
+                    .name = name});
+}
+
+void AddCounter(std::vector<TraceRingBuffer::Event>& events,
+                const char* name,
+                const char* arg_name,
+                fml::TimePoint time,
+                double value) {
+  events.push_back({.type = EventType::kCounter,
+                    .timestamp_nanos = ToNanos(time),
+                    .name = name,
+                    .arg_name = arg_name,
+                    .value = value});
+}
+
+}  // namespace
+
+JankCapture::JankCapture(fml::TimeDelta threshold) : threshold_(threshold) {}
+
+JankCapture::~JankCapture() = default;
+
+bool JankCapture::RecordFrameRasterized(const FrameTiming& timing,
+                                        fml::TimeDelta frame_budget) {
+  frames_.push_back(timing);
+  if (frames_.size() > kFrameCount) {
+    frames_.pop_front();
+  }
+  last_frame_budget_ = frame_budget;
+
+  const auto threshold = threshold_ > fml::TimeDelta::Zero()
+                             ? threshold_
+                             : fml::TimeDelta::FromMillisecondsF(
+                                   frame_budget.ToMillisecondsF() *
+                                   kDefaultThresholdFrameBudgets);
+  const auto frame_time = timing.Get(FrameTiming::kRasterFinish) -
+                          timing.Get(FrameTiming::kBuildStart);
+  if (frame_time <= threshold || capture_count_ >= kMaxCaptureCount) {
+    return false;
+  }
+  const auto now = timing.Get(FrameTiming::kRasterFinish);
+  if (capture_count_ > 0u && now - last_capture_time_ < kMinCaptureInterval) {
+    return false;
+  }
+  capture_count_++;
+  last_capture_time_ = now;
+  return true;
+}
+
+std::vector<uint8_t> JankCapture::Capture(const RasterizerStats& stats) const {
+  auto threads = TraceRingBuffer::GetEvents();
+  if (frames_.empty()) {
+    return TraceRingBuffer::SerializeAsPerfettoTrace(threads);
+  }
+
+  // The builds and rasterizations of consecutive frames overlap when the
+  // pipeline is deeper than one frame, so they go on separate tracks.
+  TraceRingBuffer::ThreadEvents build{.thread_name = "Frame builds"};
+  TraceRingBuffer::ThreadEvents raster{.thread_name = "Frame rasterizations"};
+  for (const auto& frame : frames_) {
+    AddSlice(build.events, "Build", frame.Get(FrameTiming::kBuildStart),
+             frame.Get(FrameTiming::kBuildFinish));
+    const auto raster_finish = frame.Get(FrameTiming::kRasterFinish);
+    AddSlice(raster.events, "Raster", frame.Get(FrameTiming::kRasterStart),
+             raster_finish);
+    AddCounter(raster.events, "Frame", "GPUTimeMS", raster_finish,
+               frame.GetGPUTime().ToMillisecondsF());
+    AddCounter(raster.events, "Frame", "PipelineDepth", raster_finish,
+               frame.GetPipelineDepth());
+    AddCounter(raster.events, "RasterCache", "LayerCount", raster_finish,
+               frame.GetLayerCacheCount());
+    AddCounter(raster.events, "RasterCache", "LayerBytes", raster_finish,
+               frame.GetLayerCacheBytes());
+    AddCounter(raster.events, "RasterCache", "PictureCount", raster_finish,
+               frame.GetPictureCacheCount());
+    AddCounter(raster.events, "RasterCache", "PictureBytes", raster_finish,
+               frame.GetPictureCacheBytes());
+  }
+
+  const auto& janky_frame = frames_.back();
+  const auto capture_time = janky_frame.Get(FrameTiming::kRasterFinish);
+  raster.events.push_back({.type = EventType::kInstant,
+                           .timestamp_nanos = ToNanos(capture_time),
+                           .name = "Jank"});
+  AddCounter(raster.events, "JankCapture", "FrameTimeMS", capture_time,
+             (capture_time - janky_frame.Get(FrameTiming::kBuildStart))
+                 .ToMillisecondsF());
+  AddCounter(raster.events, "JankCapture", "FrameBudgetMS", capture_time,
+             last_frame_budget_.ToMillisecondsF());
+  AddCounter(raster.events, "LayerTree", "LayerCount", capture_time,
+             stats.layer_count);
+  AddCounter(raster.events, "LayerTree", "DisplayListOpCount", capture_time,
+             stats.display_list_op_count);
+  AddCounter(raster.events, "GlyphAtlas", "GlyphCount", capture_time,
+             stats.glyph_atlas_glyph_count);
+  AddCounter(raster.events, "GlyphAtlas", "Bytes", capture_time,
+             stats.glyph_atlas_bytes);
+
+  threads.push_back(std::move(build));
+  threads.push_back(std::move(raster));
+  return TraceRingBuffer::SerializeAsPerfettoTrace(threads);
+}
+
+}  // namespace flutter
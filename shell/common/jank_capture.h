@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_JANK_CAPTURE_H_
+#define FLUTTER_SHELL_COMMON_JANK_CAPTURE_H_
+
+#include <deque>
+#include <vector>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+/// Keeps the timings of the recent frames, and decides which slow frames are
+/// captured so that jank seen in the field can be investigated offline.
+///
+/// A capture is a Perfetto trace of the trace ring buffer, to which the
+/// timings of the recent frames are added as slices and the stats of the
+/// rasterizer at the time of the capture as counters.
+///
+/// Used by the |Shell| on the raster thread only.
+class JankCapture {
+ public:
+  /// The stats of the rasterizer at the time of a capture, in addition to
+  /// the cache stats of the frame timings.
+  struct RasterizerStats {
+    /// The number of layers of the last layer trees drawn.
+    size_t layer_count = 0u;
+    /// The number of ops of the display lists of those layers.
+    size_t display_list_op_count = 0u;
+    /// The number of glyphs and the texture bytes of Impeller's glyph atlases.
+    size_t glyph_atlas_glyph_count = 0u;
+    size_t glyph_atlas_bytes = 0u;
+  };
+
+  // The number of recent frames whose timings are captured.
+  static constexpr size_t kFrameCount = 120u;
+
+  // The number of captures made at most, and the minimum time between them,
+  // so that the disk isn't flooded when every frame janks.
+  static constexpr size_t kMaxCaptureCount = 20u;
+  static constexpr fml::TimeDelta kMinCaptureInterval =
+      fml::TimeDelta::FromSeconds(10);
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  threshold  The time from the start of the build to the end
+  ///                        of the rasterization of a frame past which it is
+  ///                        captured, or zero for twice the frame budget.
+  ///
+  explicit JankCapture(fml::TimeDelta threshold);
+
+  ~JankCapture();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the timings of a rasterized frame.
+  ///
+  /// @return     Whether the frame should be captured.
+  ///
+  bool RecordFrameRasterized(const FrameTiming& timing,
+                             fml::TimeDelta frame_budget);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Encode the capture of the last recorded frame.
+  ///
+  std::vector<uint8_t> Capture(const RasterizerStats& stats) const;
+
+ private:
+  const fml::TimeDelta threshold_;
+  std::deque<FrameTiming> frames_;
+  fml::TimeDelta last_frame_budget_;
+  size_t capture_count_ = 0u;
+  fml::TimePoint last_capture_time_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(JankCapture);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_JANK_CAPTURE_H_
@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/jank_capture.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr fml::TimeDelta kFrameBudget = fml::TimeDelta::FromMilliseconds(16);
+
+FrameTiming MakeFrameTiming(fml::TimePoint build_start,
+                            fml::TimeDelta frame_time) {
+  FrameTiming timing;
+  timing.Set(FrameTiming::kVsyncStart, build_start);
+  timing.Set(FrameTiming::kBuildStart, build_start);
+  timing.Set(FrameTiming::kBuildFinish, build_start + frame_time / 2);
+  timing.Set(FrameTiming::kRasterStart, build_start + frame_time / 2);
+  timing.Set(FrameTiming::kRasterFinish, build_start + frame_time);
+  return timing;
+}
+
+fml::TimePoint SecondsAfterStart(int64_t seconds) {
+  return fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromSeconds(seconds));
+}
+
+}  // namespace
+
+TEST(JankCaptureTest, CapturesFramesSlowerThanTwiceTheBudgetByDefault) {
+  JankCapture capture(fml::TimeDelta::Zero());
+  EXPECT_FALSE(capture.RecordFrameRasterized(
+      MakeFrameTiming(SecondsAfterStart(1), kFrameBudget * 2), kFrameBudget));
+  EXPECT_TRUE(capture.RecordFrameRasterized(
+      MakeFrameTiming(SecondsAfterStart(2), kFrameBudget * 3), kFrameBudget));
+}
+
+TEST(JankCaptureTest, CapturesFramesSlowerThanTheThreshold) {
+  JankCapture capture(fml::TimeDelta::FromMilliseconds(100));
+  EXPECT_FALSE(capture.RecordFrameRasterized(
+      MakeFrameTiming(SecondsAfterStart(1), kFrameBudget * 3), kFrameBudget));
+  EXPECT_TRUE(capture.RecordFrameRasterized(
+      MakeFrameTiming(SecondsAfterStart(2),
+                      fml::TimeDelta::FromMilliseconds(101)),
+      kFrameBudget));
+}
+
+TEST(JankCaptureTest, LimitsTheRateOfCaptures) {
+  JankCapture capture(fml::TimeDelta::Zero());
+  const auto jank = kFrameBudget * 4;
+  EXPECT_TRUE(capture.RecordFrameRasterized(
+      MakeFrameTiming(SecondsAfterStart(1), jank), kFrameBudget));
+  EXPECT_FALSE(capture.RecordFrameRasterized(
+      MakeFrameTiming(SecondsAfterStart(2), jank), kFrameBudget));
+
+  int64_t seconds = 1;
+  for (size_t i = 1; i < JankCapture::kMaxCaptureCount; i++) {
+    seconds += JankCapture::kMinCaptureInterval.ToSeconds();
+    EXPECT_TRUE(capture.RecordFrameRasterized(
+        MakeFrameTiming(SecondsAfterStart(seconds), jank), kFrameBudget));
+  }
+  seconds += JankCapture::kMinCaptureInterval.ToSeconds();
+  EXPECT_FALSE(capture.RecordFrameRasterized(
+      MakeFrameTiming(SecondsAfterStart(seconds), jank), kFrameBudget));
+}
+
+TEST(JankCaptureTest, CaptureContainsTheRecentFramesAndStats) {
+  JankCapture capture(fml::TimeDelta::Zero());
+  for (int64_t i = 1; i <= 3; i++) {
+    capture.RecordFrameRasterized(
+        MakeFrameTiming(SecondsAfterStart(i), kFrameBudget * i), kFrameBudget);
+  }
+  auto data = capture.Capture({.layer_count = 3u});
+  std::string trace(data.begin(), data.end());
+  EXPECT_NE(trace.find("Frame rasterizations"), std::string::npos);
+  EXPECT_NE(trace.find("Raster"), std::string::npos);
+  EXPECT_NE(trace.find("Jank"), std::string::npos);
+  EXPECT_NE(trace.find("LayerTree.LayerCount"), std::string::npos);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,60 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_MEMORY_USAGE_H_
+#define FLUTTER_SHELL_COMMON_MEMORY_USAGE_H_
+
+#include <cstddef>
+#include <functional>
+
+namespace flutter {
+
+/// The memory held by the subsystems of the engine, so that regressions can
+/// be attributed to one of them rather than seen as a change of the RSS.
+///
+/// Fields that don't apply to the current backend are zero.
+struct MemoryUsage {
+  /// The bytes of the layers and pictures in the raster cache.
+  size_t raster_cache_layer_bytes = 0u;
+  size_t raster_cache_picture_bytes = 0u;
+  /// The bytes of the display lists of the last layer trees drawn.
+  size_t display_list_bytes = 0u;
+  /// The texture bytes of Impeller's glyph atlases.
+  size_t glyph_atlas_bytes = 0u;
+  /// The bytes of the textures of decoded images that can be purged.
+  size_t image_texture_bytes = 0u;
+  /// The bytes of the render targets kept by Impeller for reuse.
+  size_t render_target_cache_bytes = 0u;
+  /// The bytes of all the resources created by Impeller's allocator, by
+  /// category. These include the render target cache, the glyph atlases and
+  /// the image textures above.
+  size_t impeller_render_target_bytes = 0u;
+  size_t impeller_texture_bytes = 0u;
+  size_t impeller_host_buffer_bytes = 0u;
+  size_t impeller_device_buffer_bytes = 0u;
+  /// The number of pipeline variants created by Impeller.
+  size_t impeller_pipeline_count = 0u;
+
+  /// Invokes |callback| with the name and the value of each field. The
+  /// values of names ending with "_count" are counts rather than bytes.
+  void ForEach(
+      const std::function<void(const char* name, size_t value)>& callback)
+      const {
+    callback("raster_cache_layer_bytes", raster_cache_layer_bytes);
+    callback("raster_cache_picture_bytes", raster_cache_picture_bytes);
+    callback("display_list_bytes", display_list_bytes);
+    callback("glyph_atlas_bytes", glyph_atlas_bytes);
+    callback("image_texture_bytes", image_texture_bytes);
+    callback("render_target_cache_bytes", render_target_cache_bytes);
+    callback("impeller_render_target_bytes", impeller_render_target_bytes);
+    callback("impeller_texture_bytes", impeller_texture_bytes);
+    callback("impeller_host_buffer_bytes", impeller_host_buffer_bytes);
+    callback("impeller_device_buffer_bytes", impeller_device_buffer_bytes);
+    callback("impeller_pipeline_count", impeller_pipeline_count);
+  }
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_MEMORY_USAGE_H_
@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/common/graphics/persistent_cache_pack.h"
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/fml/command_line.h"
@@ -199,5 +200,71 @@ TEST_F(PersistentCacheTest, PurgeAllowsFutureSkSLCache) {
   DestroyShell(std::move(shell));
 }
 
+TEST(PersistentCachePackTest, AppendsBatchesAndReadsThemBack) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = std::make_shared<fml::UniqueFD>(
+      fml::OpenDirectory(dir.path().c_str(), false,
+                         fml::FilePermission::kReadWrite));
+  auto a = SkData::MakeWithCopy("a", 1);
+  auto b = SkData::MakeWithCopy("b", 1);
+  auto x = SkData::MakeWithCopy("x", 1);
+  auto y = SkData::MakeWithCopy("y", 1);
+  {
+    PersistentCachePack pack(directory);
+    EXPECT_TRUE(pack.Add(*a, *x));
+    EXPECT_FALSE(pack.Add(*b, *y));
+    // Queued entries are found before they are written.
+    CheckTextSkData(pack.Find(*a), "x");
+    EXPECT_EQ(pack.GetPendingCount(), 2u);
+    ASSERT_TRUE(pack.Flush());
+    EXPECT_EQ(pack.GetPendingCount(), 0u);
+    CheckTextSkData(pack.Find(*b), "y");
+
+    // The next batch is appended.
+    EXPECT_TRUE(pack.Add(*a, *y));
+    ASSERT_TRUE(pack.Flush());
+  }
+
+  PersistentCachePack pack(directory);
+  CheckTextSkData(pack.Find(*a), "y");
+  CheckTextSkData(pack.Find(*b), "y");
+  EXPECT_EQ(pack.GetEntries().size(), 2u);
+  EXPECT_EQ(pack.Find(*x), nullptr);
+}
+
+TEST(PersistentCachePackTest, IgnoresIncompleteRecords) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = std::make_shared<fml::UniqueFD>(
+      fml::OpenDirectory(dir.path().c_str(), false,
+                         fml::FilePermission::kReadWrite));
+  auto a = SkData::MakeWithCopy("a", 1);
+  auto b = SkData::MakeWithCopy("b", 1);
+  auto x = SkData::MakeWithCopy("x", 1);
+  {
+    PersistentCachePack pack(directory);
+    pack.Add(*a, *x);
+    ASSERT_TRUE(pack.Flush());
+  }
+  // Corrupt the value of the record, as if the process died while writing
+  // it.
+  {
+    auto file = fml::OpenFile(*directory, PersistentCachePack::kFileName,
+                              false, fml::FilePermission::kReadWrite);
+    fml::FileMapping mapping(file, {fml::FileMapping::Protection::kRead,
+                                    fml::FileMapping::Protection::kWrite});
+    ASSERT_NE(mapping.GetMutableMapping(), nullptr);
+    mapping.GetMutableMapping()[mapping.GetSize() - 1] = 0;
+  }
+
+  PersistentCachePack pack(directory);
+  EXPECT_EQ(pack.Find(*a), nullptr);
+  // The incomplete record is overwritten by the next batch.
+  pack.Add(*b, *x);
+  ASSERT_TRUE(pack.Flush());
+  PersistentCachePack reloaded(directory);
+  EXPECT_EQ(reloaded.Find(*a), nullptr);
+  CheckTextSkData(reloaded.Find(*b), "x");
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_SHELL_COMMON_PIPELINE_H_
 #define FLUTTER_SHELL_COMMON_PIPELINE_H_
 
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -129,19 +130,32 @@ class Pipeline {
   };
 
   explicit Pipeline(uint32_t depth)
-      : empty_(depth), available_(0), inflight_(0) {}
+      : empty_(depth), available_(0), inflight_(0), depth_limit_(depth) {}
 
   ~Pipeline() = default;
 
   bool IsValid() const { return empty_.IsValid() && available_.IsValid(); }
 
+  /// Limits the number of resources in flight to fewer than the depth the
+  /// pipeline was created with. Lowering the limit below the number of
+  /// resources already in flight makes |Produce| fail until enough of them
+  /// have been consumed.
+  void SetDepthLimit(uint32_t depth_limit) { depth_limit_ = depth_limit; }
+
+  /// The number of resources being produced or waiting to be consumed, which
+  /// includes a resource being consumed until its consumer returns.
+  uint32_t GetInflightCount() const {
+    return static_cast<uint32_t>(inflight_.load());
+  }
+
   /// Creates a `ProducerContinuation` that a producer can use to add a
   /// resource to the queue.
   ///
-  /// If the queue is already at its maximum depth, the `ProducerContinuation`
-  /// is returned with success = false.
+  /// If the queue is already at its maximum depth or depth limit, the
+  /// `ProducerContinuation` is returned with success = false.
   ProducerContinuation Produce() {
-    if (!empty_.TryWait()) {
+    if (inflight_.load() >= static_cast<int>(depth_limit_.load()) ||
+        !empty_.TryWait()) {
       return {};
     }
     ++inflight_;
@@ -216,6 +230,7 @@ class Pipeline {
   fml::Semaphore empty_;
   fml::Semaphore available_;
   std::atomic<int> inflight_;
+  std::atomic<uint32_t> depth_limit_;
   std::mutex queue_mutex_;
   std::deque<std::pair<ResourcePtr, size_t>> queue_;
 
@@ -144,5 +144,30 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, ProduceFailsAtDepthLimit) {
+  const int depth = 3;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+  pipeline->SetDepthLimit(1);
+
+  Continuation continuation_1 = pipeline->Produce();
+  ASSERT_TRUE(continuation_1);
+  ASSERT_FALSE(pipeline->Produce());
+
+  PipelineProduceResult result =
+      continuation_1.Complete(std::make_unique<int>(1));
+  ASSERT_EQ(result.success, true);
+  ASSERT_FALSE(pipeline->Produce());
+
+  pipeline->SetDepthLimit(2);
+  Continuation continuation_2 = pipeline->Produce();
+  ASSERT_TRUE(continuation_2);
+  ASSERT_FALSE(pipeline->Produce());
+
+  PipelineConsumeResult consume_result =
+      pipeline->Consume([](std::unique_ptr<int> v) { ASSERT_EQ(*v, 1); });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::Done);
+  ASSERT_TRUE(pipeline->Produce());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -99,6 +99,12 @@ std::shared_ptr<impeller::Context> PlatformView::GetImpellerContext() const {
 
 void PlatformView::ReleaseResourceContext() const {}
 
+sk_sp<GrDirectContext> PlatformView::CreateResourceUploadContext() const {
+  return nullptr;
+}
+
+void PlatformView::ReleaseResourceUploadContext() const {}
+
 PointerDataDispatcherMaker PlatformView::GetDispatcherMaker() {
   return [](DefaultPointerDataDispatcher::Delegate& delegate) {
     return std::make_unique<DefaultPointerDataDispatcher>(delegate);
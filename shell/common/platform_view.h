@@ -557,6 +557,33 @@ class PlatformView {
   ///
   virtual void ReleaseResourceContext() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Used by the shell to obtain additional resource contexts, in
+  ///             the same share-group as the one returned by
+  ///             `CreateResourceContext()`, so that textures can be uploaded
+  ///             on more than one thread. Only called when the settings ask
+  ///             for resource upload threads. The default implementation
+  ///             returns `nullptr`.
+  ///
+  /// @attention  Unlike all other methods on the platform view, this will be
+  ///             called on a resource upload thread, once per thread. The
+  ///             context must be current on that thread when returned.
+  ///
+  /// @return     The Skia GPU context for the calling thread. May be
+  ///             `nullptr` if no more contexts can be created.
+  ///
+  virtual sk_sp<GrDirectContext> CreateResourceUploadContext() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Used by the shell to notify the embedder that the context
+  ///             previously obtained on this thread via a call to
+  ///             `CreateResourceUploadContext()` has been collected.
+  ///
+  /// @attention  Unlike all other methods on the platform view, this will be
+  ///             called on the resource upload thread of the context.
+  ///
+  virtual void ReleaseResourceUploadContext() const;
+
   //--------------------------------------------------------------------------
   /// @brief      Returns a platform-specific PointerDataDispatcherMaker so the
   ///             `Engine` can construct the PointerDataPacketDispatcher based
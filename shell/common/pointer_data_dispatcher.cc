@@ -4,6 +4,8 @@
 
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 
+#include <algorithm>
+
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -15,6 +17,16 @@ SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate)
     : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
 SmoothPointerDataDispatcher::~SmoothPointerDataDispatcher() = default;
 
+CoalescingPointerDataDispatcher::CoalescingPointerDataDispatcher(
+    Delegate& delegate,
+    bool resample)
+    : DefaultPointerDataDispatcher(delegate),
+      resample_(resample),
+      weak_factory_(this) {}
+CoalescingPointerDataDispatcher::~CoalescingPointerDataDispatcher() = default;
+
+void PointerDataDispatcher::OnBeginFrame(fml::TimePoint frame_target_time) {}
+
 void DefaultPointerDataDispatcher::DispatchPacket(
     std::unique_ptr<PointerDataPacket> packet,
     uint64_t trace_flow_id) {
@@ -72,4 +84,152 @@ void SmoothPointerDataDispatcher::DispatchPendingPacket() {
   ScheduleSecondaryVsyncCallback();
 }
 
+void CoalescingPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  TRACE_EVENT0_WITH_FLOW_IDS("flutter",
+                             "CoalescingPointerDataDispatcher::DispatchPacket",
+                             /*flow_id_count=*/1, &trace_flow_id);
+  TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
+
+  for (size_t i = 0; i < packet->GetLength(); i++) {
+    pending_events_.push_back(packet->GetPointerData(i));
+  }
+  pending_trace_flow_ids_.push_back(trace_flow_id);
+
+  // The events are dispatched before the next frame is built, if any. The
+  // secondary vsync callback dispatches them when no frame is requested.
+  if (!is_vsync_callback_scheduled_) {
+    is_vsync_callback_scheduled_ = true;
+    delegate_.ScheduleSecondaryVsyncCallback(
+        reinterpret_cast<uintptr_t>(this),
+        [dispatcher = weak_factory_.GetWeakPtr()]() {
+          if (dispatcher) {
+            dispatcher->is_vsync_callback_scheduled_ = false;
+            dispatcher->DispatchPendingEvents(std::nullopt);
+          }
+        });
+  }
+}
+
+void CoalescingPointerDataDispatcher::OnBeginFrame(
+    fml::TimePoint frame_target_time) {
+  DispatchPendingEvents(frame_target_time);
+}
+
+void CoalescingPointerDataDispatcher::DispatchPendingEvents(
+    std::optional<fml::TimePoint> frame_target_time) {
+  if (pending_trace_flow_ids_.empty()) {
+    return;
+  }
+  TRACE_EVENT0_WITH_FLOW_IDS(
+      "flutter", "CoalescingPointerDataDispatcher::DispatchPendingEvents",
+      pending_trace_flow_ids_.size(), pending_trace_flow_ids_.data());
+
+  std::vector<PointerData> events =
+      resample_ ? Resample(pending_events_, frame_target_time)
+                : std::move(pending_events_);
+  auto packet = std::make_unique<PointerDataPacket>(events.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    packet->SetPointerData(i, events[i]);
+  }
+
+  // The packet carries the flow of the last packet it batches, the flows of
+  // the others end here.
+  uint64_t trace_flow_id = pending_trace_flow_ids_.back();
+  for (size_t i = 0; i + 1 < pending_trace_flow_ids_.size(); i++) {
+    TRACE_FLOW_END("flutter", "PointerEvent", pending_trace_flow_ids_[i]);
+  }
+  pending_events_.clear();
+  pending_trace_flow_ids_.clear();
+
+  DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                               trace_flow_id);
+}
+
+std::vector<PointerData> CoalescingPointerDataDispatcher::Resample(
+    const std::vector<PointerData>& events,
+    std::optional<fml::TimePoint> sample_time) {
+  std::vector<PointerData> resampled;
+  resampled.reserve(events.size());
+  // Whether the resampled event at the same index is superseded by a later
+  // move of its pointer.
+  std::vector<bool> superseded;
+  superseded.reserve(events.size());
+  // The index of the last resampled move of the pointers whose runs of moves
+  // are not over yet.
+  std::unordered_map<int64_t, size_t> run_ends;
+
+  for (const PointerData& event : events) {
+    bool is_move = (event.change == PointerData::Change::kMove ||
+                    event.change == PointerData::Change::kHover) &&
+                   event.signal_kind == PointerData::SignalKind::kNone;
+    auto run_end = run_ends.find(event.device);
+    if (is_move) {
+      PointerSample sample = {event.time_stamp, event.physical_x,
+                              event.physical_y};
+      auto state = pointer_states_.find(event.device);
+      if (state == pointer_states_.end()) {
+        pointer_states_[event.device] = {
+            std::nullopt, sample, event.physical_x - event.physical_delta_x,
+            event.physical_y - event.physical_delta_y};
+      } else {
+        state->second.previous = state->second.last;
+        state->second.last = sample;
+      }
+      if (run_end != run_ends.end()) {
+        superseded[run_end->second] = true;
+      }
+      run_ends[event.device] = resampled.size();
+    } else if (run_end != run_ends.end()) {
+      // The run ended within the batch, so its last move is kept as is.
+      PointerData& last_move = resampled[run_end->second];
+      const PointerState& state = pointer_states_[event.device];
+      last_move.physical_delta_x = last_move.physical_x - state.dispatched_x;
+      last_move.physical_delta_y = last_move.physical_y - state.dispatched_y;
+      run_ends.erase(run_end);
+    }
+    if (!is_move) {
+      pointer_states_.erase(event.device);
+    }
+    resampled.push_back(event);
+    superseded.push_back(false);
+  }
+
+  // The runs still in progress are moved to the sample time.
+  for (const auto& [device, index] : run_ends) {
+    PointerData& last_move = resampled[index];
+    PointerState& state = pointer_states_[device];
+    if (sample_time.has_value() && state.previous.has_value()) {
+      int64_t sample = sample_time->ToEpochDelta().ToMicroseconds();
+      int64_t interval = state.last.time_stamp - state.previous->time_stamp;
+      int64_t distance = sample - state.last.time_stamp;
+      if (interval > 0 && distance > 0 &&
+          distance <= kMaxResampleDistance.ToMicroseconds()) {
+        int64_t extrapolation = std::min(
+            {distance, kMaxExtrapolation.ToMicroseconds(), interval / 2});
+        double alpha = static_cast<double>(extrapolation) / interval;
+        last_move.time_stamp = state.last.time_stamp + extrapolation;
+        last_move.physical_x =
+            state.last.x + (state.last.x - state.previous->x) * alpha;
+        last_move.physical_y =
+            state.last.y + (state.last.y - state.previous->y) * alpha;
+      }
+    }
+    last_move.physical_delta_x = last_move.physical_x - state.dispatched_x;
+    last_move.physical_delta_y = last_move.physical_y - state.dispatched_y;
+    state.dispatched_x = last_move.physical_x;
+    state.dispatched_y = last_move.physical_y;
+  }
+
+  size_t count = 0;
+  for (size_t i = 0; i < resampled.size(); i++) {
+    if (!superseded[i]) {
+      resampled[count++] = resampled[i];
+    }
+  }
+  resampled.resize(count);
+  return resampled;
+}
+
 }  // namespace flutter
@@ -5,6 +5,10 @@
 #ifndef FLUTTER_SHELL_COMMON_POINTER_DATA_DISPATCHER_H_
 #define FLUTTER_SHELL_COMMON_POINTER_DATA_DISPATCHER_H_
 
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/shell/common/animator.h"
 
@@ -74,6 +78,13 @@ class PointerDataDispatcher {
   virtual void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
                               uint64_t trace_flow_id) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Signal that the engine is about to begin a frame, before the
+  ///             framework is asked to build it.
+  ///
+  /// @param[in]  frame_target_time  The target time of the frame.
+  virtual void OnBeginFrame(fml::TimePoint frame_target_time);
+
   //----------------------------------------------------------------------------
   /// @brief      Default destructor.
   virtual ~PointerDataDispatcher();
@@ -163,6 +174,88 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// A dispatcher that holds the packets received between two frames and
+/// dispatches their events in a single packet right before the next frame is
+/// built. If no frame is requested, the events are dispatched at the next
+/// vsync instead.
+///
+/// Touch panels sampling at 120Hz or 240Hz deliver several packets per frame.
+/// Dispatching each of them costs a call into the framework, which decodes the
+/// packet and allocates its events, while only the state at the time of the
+/// frame is drawn. Batching them keeps every event, so the framework still
+/// sees the full history of the pointers, with a single dispatch per frame.
+///
+/// If resampling is enabled, the consecutive move and hover events of each
+/// pointer within the batch are further replaced with a single event. When the
+/// events are dispatched for a frame, that event is at the position the
+/// pointer is predicted to have at the target time of the frame.
+/// The prediction extrapolates the last two samples of the pointer by at most
+/// `kMaxExtrapolation` and half the time between these samples, like the input
+/// resampling of Android. Events with timestamps more than
+/// `kMaxResampleDistance` away from the frame target time are assumed to come
+/// from a different clock and are not resampled.
+class CoalescingPointerDataDispatcher : public DefaultPointerDataDispatcher {
+ public:
+  static constexpr fml::TimeDelta kMaxExtrapolation =
+      fml::TimeDelta::FromMilliseconds(8);
+  static constexpr fml::TimeDelta kMaxResampleDistance =
+      fml::TimeDelta::FromMilliseconds(100);
+
+  CoalescingPointerDataDispatcher(Delegate& delegate, bool resample);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  // |PointerDataDispatcer|
+  void OnBeginFrame(fml::TimePoint frame_target_time) override;
+
+  virtual ~CoalescingPointerDataDispatcher();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Replaces the consecutive move and hover events of each
+  ///             pointer with their last event. If `sample_time` is set, the
+  ///             last event of the pointers that are still moving is moved to
+  ///             where they are predicted to be at `sample_time`.
+  ///
+  /// @note       Visible for testing.
+  std::vector<PointerData> Resample(const std::vector<PointerData>& events,
+                                    std::optional<fml::TimePoint> sample_time);
+
+ private:
+  struct PointerSample {
+    int64_t time_stamp;
+    double x;
+    double y;
+  };
+
+  // The state of a pointer across the runs of its moves.
+  struct PointerState {
+    // The last two samples of the pointer.
+    std::optional<PointerSample> previous;
+    PointerSample last;
+    // The position of the last resampled event dispatched for the pointer,
+    // which the delta of the next one is relative to.
+    double dispatched_x;
+    double dispatched_y;
+  };
+
+  void DispatchPendingEvents(std::optional<fml::TimePoint> frame_target_time);
+
+  const bool resample_;
+  std::vector<PointerData> pending_events_;
+  std::vector<uint64_t> pending_trace_flow_ids_;
+  bool is_vsync_callback_scheduled_ = false;
+  // The pointers whose last events were moves, by device.
+  std::unordered_map<int64_t, PointerState> pointer_states_;
+
+  // WeakPtrFactory must be the last member.
+  fml::WeakPtrFactory<CoalescingPointerDataDispatcher> weak_factory_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(CoalescingPointerDataDispatcher);
+};
+
 //--------------------------------------------------------------------------
 /// @brief      Signature for constructing PointerDataDispatcher.
 ///
@@ -0,0 +1,195 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_data_dispatcher.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class FakePointerDataDispatcherDelegate
+    : public PointerDataDispatcher::Delegate {
+ public:
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    packets.push_back(std::move(packet));
+  }
+
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    vsync_callback = callback;
+  }
+
+  void FireVsyncCallback() {
+    fml::closure callback = std::move(vsync_callback);
+    vsync_callback = nullptr;
+    callback();
+  }
+
+  std::vector<std::unique_ptr<PointerDataPacket>> packets;
+  fml::closure vsync_callback;
+};
+
+PointerData MakePointerData(PointerData::Change change,
+                            int64_t device,
+                            int64_t time_stamp_ms,
+                            double x,
+                            double y,
+                            double delta_x = 0,
+                            double delta_y = 0) {
+  PointerData data;
+  data.Clear();
+  data.change = change;
+  data.kind = PointerData::DeviceKind::kTouch;
+  data.signal_kind = PointerData::SignalKind::kNone;
+  data.device = device;
+  data.time_stamp = time_stamp_ms * 1000;
+  data.physical_x = x;
+  data.physical_y = y;
+  data.physical_delta_x = delta_x;
+  data.physical_delta_y = delta_y;
+  return data;
+}
+
+std::unique_ptr<PointerDataPacket> MakePacket(
+    const std::vector<PointerData>& events) {
+  auto packet = std::make_unique<PointerDataPacket>(events.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    packet->SetPointerData(i, events[i]);
+  }
+  return packet;
+}
+
+fml::TimePoint FromMilliseconds(int64_t ms) {
+  return fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromMilliseconds(ms));
+}
+
+}  // namespace
+
+TEST(CoalescingPointerDataDispatcherTest, DispatchesOncePerFrame) {
+  FakePointerDataDispatcherDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(delegate, /*resample=*/false);
+
+  dispatcher.DispatchPacket(
+      MakePacket({MakePointerData(PointerData::Change::kDown, 0, 0, 0, 0)}),
+      1);
+  dispatcher.DispatchPacket(
+      MakePacket({MakePointerData(PointerData::Change::kMove, 0, 4, 10, 0),
+                  MakePointerData(PointerData::Change::kMove, 0, 8, 20, 0)}),
+      2);
+  EXPECT_TRUE(delegate.packets.empty());
+
+  dispatcher.OnBeginFrame(FromMilliseconds(16));
+  ASSERT_EQ(delegate.packets.size(), 1u);
+  ASSERT_EQ(delegate.packets[0]->GetLength(), 3u);
+  EXPECT_EQ(delegate.packets[0]->GetPointerData(0).change,
+            PointerData::Change::kDown);
+  EXPECT_EQ(delegate.packets[0]->GetPointerData(2).physical_x, 20);
+
+  // Nothing is left for the vsync callback.
+  delegate.FireVsyncCallback();
+  EXPECT_EQ(delegate.packets.size(), 1u);
+}
+
+TEST(CoalescingPointerDataDispatcherTest, DispatchesAtVsyncWithoutFrame) {
+  FakePointerDataDispatcherDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(delegate, /*resample=*/true);
+
+  dispatcher.DispatchPacket(
+      MakePacket({MakePointerData(PointerData::Change::kHover, 0, 0, 0, 0)}),
+      1);
+  dispatcher.DispatchPacket(
+      MakePacket({MakePointerData(PointerData::Change::kHover, 0, 4, 10, 0)}),
+      2);
+  ASSERT_TRUE(delegate.vsync_callback);
+
+  delegate.FireVsyncCallback();
+  ASSERT_EQ(delegate.packets.size(), 1u);
+  ASSERT_EQ(delegate.packets[0]->GetLength(), 1u);
+  // Without a frame target time, the last move is not extrapolated.
+  PointerData hover = delegate.packets[0]->GetPointerData(0);
+  EXPECT_EQ(hover.time_stamp, 4000);
+  EXPECT_EQ(hover.physical_x, 10);
+  EXPECT_EQ(hover.physical_delta_x, 10);
+}
+
+TEST(CoalescingPointerDataDispatcherTest, ResamplesMovesAtSampleTime) {
+  FakePointerDataDispatcherDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(delegate, /*resample=*/true);
+
+  std::vector<PointerData> events = dispatcher.Resample(
+      {MakePointerData(PointerData::Change::kDown, 0, 0, 0, 0),
+       MakePointerData(PointerData::Change::kMove, 0, 4, 8, 4, 8, 4),
+       MakePointerData(PointerData::Change::kMove, 1, 4, 100, 100),
+       MakePointerData(PointerData::Change::kMove, 0, 8, 16, 8, 8, 4)},
+      FromMilliseconds(16));
+
+  ASSERT_EQ(events.size(), 3u);
+  EXPECT_EQ(events[0].change, PointerData::Change::kDown);
+  // The pointer without a previous sample is not extrapolated.
+  EXPECT_EQ(events[1].device, 1);
+  EXPECT_EQ(events[1].physical_x, 100);
+  // The extrapolation is limited to half the interval between the samples.
+  EXPECT_EQ(events[2].device, 0);
+  EXPECT_EQ(events[2].time_stamp, 10000);
+  EXPECT_EQ(events[2].physical_x, 20);
+  EXPECT_EQ(events[2].physical_y, 10);
+  EXPECT_EQ(events[2].physical_delta_x, 20);
+  EXPECT_EQ(events[2].physical_delta_y, 10);
+
+  // The next delta is relative to the extrapolated position.
+  events = dispatcher.Resample(
+      {MakePointerData(PointerData::Change::kMove, 0, 12, 18, 9)},
+      FromMilliseconds(12));
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_EQ(events[0].physical_x, 18);
+  EXPECT_EQ(events[0].physical_delta_x, -2);
+  EXPECT_EQ(events[0].physical_delta_y, -1);
+}
+
+TEST(CoalescingPointerDataDispatcherTest, KeepsMovesEndedWithinBatch) {
+  FakePointerDataDispatcherDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(delegate, /*resample=*/true);
+
+  std::vector<PointerData> events = dispatcher.Resample(
+      {MakePointerData(PointerData::Change::kMove, 0, 0, 0, 0),
+       MakePointerData(PointerData::Change::kMove, 0, 4, 8, 0),
+       MakePointerData(PointerData::Change::kUp, 0, 4, 8, 0),
+       MakePointerData(PointerData::Change::kDown, 0, 8, 50, 0),
+       MakePointerData(PointerData::Change::kMove, 0, 12, 60, 0)},
+      FromMilliseconds(16));
+
+  ASSERT_EQ(events.size(), 4u);
+  EXPECT_EQ(events[0].change, PointerData::Change::kMove);
+  EXPECT_EQ(events[0].time_stamp, 4000);
+  EXPECT_EQ(events[0].physical_x, 8);
+  EXPECT_EQ(events[0].physical_delta_x, 8);
+  EXPECT_EQ(events[1].change, PointerData::Change::kUp);
+  EXPECT_EQ(events[2].change, PointerData::Change::kDown);
+  // The move after the down has no previous sample to extrapolate from.
+  EXPECT_EQ(events[3].change, PointerData::Change::kMove);
+  EXPECT_EQ(events[3].physical_x, 60);
+}
+
+TEST(CoalescingPointerDataDispatcherTest, IgnoresDistantSampleTime) {
+  FakePointerDataDispatcherDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(delegate, /*resample=*/true);
+
+  std::vector<PointerData> events = dispatcher.Resample(
+      {MakePointerData(PointerData::Change::kMove, 0, 0, 0, 0),
+       MakePointerData(PointerData::Change::kMove, 0, 4, 8, 0)},
+      FromMilliseconds(1000));
+
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_EQ(events[0].time_stamp, 4000);
+  EXPECT_EQ(events[0].physical_x, 8);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -5,13 +5,19 @@
 #include "flutter/shell/common/rasterizer.h"
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <utility>
 
 #include "flow/frame_timings.h"
 #include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/display_list/dl_serialization.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
 #include "flutter/flow/layers/offscreen_surface.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/memory/allocation_tag.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/base64.h"
@@ -40,6 +46,10 @@ namespace flutter {
 // used within this interval.
 static constexpr std::chrono::milliseconds kSkiaCleanupExpiration(15000);
 
+// The number of frames written when capturing display lists, which is enough
+// for the replay benchmarks to cover a few seconds of animation.
+static constexpr size_t kMaxCapturedDisplayLists = 300u;
+
 Rasterizer::Rasterizer(Delegate& delegate,
                        MakeGpuImageBehavior gpu_image_behavior)
     : delegate_(delegate),
@@ -49,6 +59,13 @@ Rasterizer::Rasterizer(Delegate& delegate,
           SnapshotController::Make(*this, delegate.GetSettings())),
       weak_factory_(this) {
   FML_DCHECK(compositor_context_);
+  if (delegate.GetSettings().enable_adaptive_quality) {
+    adaptive_quality_controller_ =
+        std::make_unique<AdaptiveQualityController>();
+    default_raster_cache_access_threshold_ =
+        compositor_context_->raster_cache().access_threshold();
+  }
+  AddIdleTasks();
 }
 
 Rasterizer::~Rasterizer() = default;
@@ -80,6 +97,20 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
     compositor_context_->OnGrContextCreated();
   }
 
+#if IMPELLER_SUPPORTS_RENDERING
+  if (auto aiks_context = surface_->GetAiksContext()) {
+    aiks_context->GetContentContext().SetAsyncRuntimeEffectPipelines(
+        delegate_.GetSettings().enable_async_runtime_effect_pipelines);
+    aiks_context->GetContentContext().SetAnalyticAntialiasing(
+        delegate_.GetSettings().enable_impeller_analytic_antialiasing);
+    aiks_context->GetContentContext().SetStencilThenCoverFills(
+        delegate_.GetSettings().enable_impeller_stencil_then_cover);
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  if (adaptive_quality_controller_) {
+    ApplyAdaptiveQuality();
+  }
+
   if (external_view_embedder_ &&
       external_view_embedder_->SupportsDynamicThreadMerging() &&
       !raster_thread_merger_) {
@@ -143,6 +174,171 @@ std::optional<DrawSurfaceStatus> Rasterizer::GetLastDrawStatus(
   }
 }
 
+std::string Rasterizer::GetImpellerPipelineVariants() const {
+#if IMPELLER_SUPPORTS_RENDERING
+  if (surface_) {
+    if (auto aiks_context = surface_->GetAiksContext()) {
+      return aiks_context->GetContentContext().GetPipelineVariants();
+    }
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  return "";
+}
+
+std::map<std::string, fml::TimeDelta>
+Rasterizer::GetImpellerGPUTimeByCategory() const {
+  std::map<std::string, fml::TimeDelta> times;
+#if IMPELLER_SUPPORTS_RENDERING
+  auto context = impeller_context_.lock();
+  auto category_times =
+      context ? context->GetLastGPUFrameTimeByCategory() : std::nullopt;
+  if (category_times.has_value()) {
+    for (size_t i = 0; i < impeller::kDrawCategoryCount; i++) {
+      times[impeller::DrawCategoryToString(
+          static_cast<impeller::DrawCategory>(i))] = category_times->at(i);
+    }
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  return times;
+}
+
+namespace {
+
+void VisitLayers(const Layer* layer,
+                 const std::function<void(const Layer*)>& visitor) {
+  if (!layer) {
+    return;
+  }
+  visitor(layer);
+  if (auto container = layer->as_container_layer()) {
+    for (const auto& child : container->layers()) {
+      VisitLayers(child.get(), visitor);
+    }
+  }
+}
+
+const DisplayList* GetDisplayList(const Layer* layer) {
+  auto display_list_layer = layer->as_display_list_layer();
+  return display_list_layer ? display_list_layer->display_list() : nullptr;
+}
+
+}  // namespace
+
+void Rasterizer::AccumulateFrameComplexity(const LayerTree& layer_tree) {
+  VisitLayers(layer_tree.root_layer(), [this](const Layer* layer) {
+    frame_complexity_.layer_count++;
+    if (const DisplayList* display_list = GetDisplayList(layer)) {
+      frame_complexity_.display_list_op_count +=
+          display_list->op_count(/*nested=*/true);
+    }
+  });
+#if IMPELLER_SUPPORTS_RENDERING
+  // The statistics are those of the last root pass rendered, which is the
+  // one of this layer tree.
+  if (surface_ && surface_->GetAiksContext()) {
+    frame_complexity_.offscreen_pass_count +=
+        surface_->GetAiksContext()
+            ->GetContentContext()
+            .GetSubpassStatistics()
+            .offscreen_subpass_count;
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+void Rasterizer::VisitLastLayers(
+    const std::function<void(const Layer*)>& visitor) const {
+  for (const auto& [view_id, record] : view_records_) {
+    const auto& task = record.last_successful_task;
+    if (task && task->layer_tree) {
+      VisitLayers(task->layer_tree->root_layer(), visitor);
+    }
+  }
+}
+
+void Rasterizer::ApplyAdaptiveQuality() {
+  const AdaptiveQualityController::Quality quality =
+      adaptive_quality_controller_->GetQuality();
+  // An access threshold of zero disables the raster cache, and the cache
+  // stays disabled at every level.
+  if (default_raster_cache_access_threshold_ > 0u) {
+    const size_t reduction = std::min(
+        quality.raster_cache_access_threshold_reduction,
+        default_raster_cache_access_threshold_ - 1);
+    compositor_context_->raster_cache().set_access_threshold(
+        default_raster_cache_access_threshold_ - reduction);
+  }
+#if IMPELLER_SUPPORTS_RENDERING
+  if (surface_) {
+    if (auto aiks_context = surface_->GetAiksContext()) {
+      aiks_context->GetContentContext().SetGaussianBlurDownsampleScale(
+          quality.blur_downsample_scale);
+    }
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  FML_TRACE_COUNTER("flutter", "AdaptiveQuality",
+                    reinterpret_cast<int64_t>(this), "Level",
+                    adaptive_quality_controller_->GetLevel());
+}
+
+JankCapture::RasterizerStats Rasterizer::GetJankCaptureStats() const {
+  JankCapture::RasterizerStats stats;
+  VisitLastLayers([&stats](const Layer* layer) {
+    stats.layer_count++;
+    if (auto display_list = GetDisplayList(layer)) {
+      stats.display_list_op_count += display_list->op_count(true);
+    }
+  });
+#if IMPELLER_SUPPORTS_RENDERING
+  if (surface_) {
+    if (auto aiks_context = surface_->GetAiksContext()) {
+      auto atlas_stats =
+          aiks_context->GetContentContext().GetLazyGlyphAtlas()->GetStats();
+      stats.glyph_atlas_glyph_count = atlas_stats.glyph_count;
+      stats.glyph_atlas_bytes = atlas_stats.texture_bytes;
+    }
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  return stats;
+}
+
+MemoryUsage Rasterizer::GetMemoryUsage() const {
+  MemoryUsage usage;
+  const auto& raster_cache = compositor_context_->raster_cache();
+  usage.raster_cache_layer_bytes = raster_cache.EstimateLayerCacheByteSize();
+  usage.raster_cache_picture_bytes =
+      raster_cache.EstimatePictureCacheByteSize();
+  VisitLastLayers([&usage](const Layer* layer) {
+    if (auto display_list = GetDisplayList(layer)) {
+      usage.display_list_bytes += display_list->bytes(true);
+    }
+  });
+#if IMPELLER_SUPPORTS_RENDERING
+  if (surface_) {
+    if (auto aiks_context = surface_->GetAiksContext()) {
+      const auto& content_context = aiks_context->GetContentContext();
+      usage.glyph_atlas_bytes =
+          content_context.GetLazyGlyphAtlas()->GetStats().texture_bytes;
+      usage.render_target_cache_bytes =
+          content_context.GetRenderTargetCache()->GetCachedBytes();
+      usage.impeller_pipeline_count =
+          content_context.GetPipelineVariantCount();
+    }
+  }
+  if (auto context = impeller_context_.lock()) {
+    const auto& accountant = context->GetResourceAllocator()->GetAccountant();
+    usage.impeller_render_target_bytes =
+        accountant.GetBytes(impeller::AllocationCategory::kRenderTarget);
+    usage.impeller_texture_bytes =
+        accountant.GetBytes(impeller::AllocationCategory::kTexture);
+    usage.impeller_host_buffer_bytes =
+        accountant.GetBytes(impeller::AllocationCategory::kHostBuffer);
+    usage.impeller_device_buffer_bytes =
+        accountant.GetBytes(impeller::AllocationCategory::kDeviceBuffer);
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  return usage;
+}
+
 void Rasterizer::EnableThreadMergerIfNeeded() {
   if (raster_thread_merger_) {
     raster_thread_merger_->Enable();
@@ -174,6 +370,67 @@ void Rasterizer::NotifyLowMemoryWarning() const {
   context->performDeferredCleanup(std::chrono::milliseconds(0));
 }
 
+void Rasterizer::NotifyIdle(fml::TimePoint deadline) {
+  idle_task_scheduler_.RunTasks(deadline);
+}
+
+void Rasterizer::AddIdleTasks() {
+  // The animator reports idle periods of this length once no frame has been
+  // scheduled for a few vsyncs. Work that the next frame would undo waits
+  // for them rather than running between frames.
+  static constexpr fml::TimeDelta kLongIdleTime =
+      fml::TimeDelta::FromMilliseconds(50);
+
+  // The shaders compiled by the last frames are written in one batch, on a
+  // worker, once the animation that needed them is over.
+  idle_task_scheduler_.AddTask({
+      .name = "PersistentCacheFlush",
+      .min_idle_time = kLongIdleTime,
+      .estimated_duration = fml::TimeDelta::FromMicroseconds(100),
+      .callback =
+          [](fml::TimePoint deadline) {
+            PersistentCache::GetCacheForProcess()->FlushPendingEntries();
+          },
+  });
+
+#if IMPELLER_SUPPORTS_RENDERING
+  // Render targets are the allocations recreated most often. Glyph atlases
+  // are kept as rebuilding them would delay the next frame.
+  idle_task_scheduler_.AddTask({
+      .name = "RenderTargetCacheTrim",
+      .min_idle_time = kLongIdleTime,
+      .estimated_duration = fml::TimeDelta::FromMicroseconds(100),
+      .callback =
+          [this](fml::TimePoint deadline) {
+            if (auto aiks_context =
+                    surface_ ? surface_->GetAiksContext() : nullptr) {
+              aiks_context->GetContentContext().GetRenderTargetCache()->Trim();
+            }
+          },
+  });
+
+  // A frame may be scheduled at any point, so compaction only gets a short
+  // slice of the idle period.
+  static constexpr fml::TimeDelta kMaxCompactionTime =
+      fml::TimeDelta::FromMilliseconds(4);
+  idle_task_scheduler_.AddTask({
+      .name = "CompactMemory",
+      .min_idle_time = kLongIdleTime,
+      .estimated_duration = kMaxCompactionTime,
+      .callback =
+          [this](fml::TimePoint deadline) {
+            if (auto aiks_context =
+                    surface_ ? surface_->GetAiksContext() : nullptr) {
+              auto compaction_deadline = std::min(
+                  deadline, fml::TimePoint::Now() + kMaxCompactionTime);
+              aiks_context->GetContext()->GetResourceAllocator()->CompactMemory(
+                  compaction_deadline);
+            }
+          },
+  });
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
 void Rasterizer::CollectView(int64_t view_id) {
   view_records_.erase(view_id);
 }
@@ -237,8 +494,10 @@ DrawStatus Rasterizer::Draw(const std::shared_ptr<FramePipeline>& pipeline) {
                  ->RunsTasksOnCurrentThread());
 
   DoDrawResult draw_result;
-  FramePipeline::Consumer consumer = [&draw_result,
+  FramePipeline::Consumer consumer = [&draw_result, &pipeline,
                                       this](std::unique_ptr<FrameItem> item) {
+    item->frame_timings_recorder->RecordPipelineDepth(
+        pipeline->GetInflightCount());
     draw_result = DoDraw(std::move(item->frame_timings_recorder),
                          std::move(item->layer_tree_tasks));
   };
@@ -273,12 +532,13 @@ DrawStatus Rasterizer::Draw(const std::shared_ptr<FramePipeline>& pipeline) {
   // between successive tries.
   switch (consume_result) {
     case PipelineConsumeResult::MoreAvailable: {
-      delegate_.GetTaskRunners().GetRasterTaskRunner()->PostTask(
+      delegate_.GetTaskRunners().GetRasterTaskRunner()->PostTaskWithGrade(
           [weak_this = weak_factory_.GetWeakPtr(), pipeline]() {
             if (weak_this) {
               weak_this->Draw(pipeline);
             }
-          });
+          },
+          fml::TaskSourceGrade::kUserInteraction);
       break;
     }
     default:
@@ -462,7 +722,28 @@ Rasterizer::DoDrawResult Rasterizer::DoDraw(
   // TODO(liyuqian): in Fuchsia, the rasterization doesn't finish when
   // Rasterizer::DoDraw finishes. Future work is needed to adapt the timestamp
   // for Fuchsia to capture SceneUpdateContext::ExecutePaintTasks.
-  delegate_.OnFrameRasterized(frame_timings_recorder->GetRecordedTime());
+  FrameTiming timing = frame_timings_recorder->GetRecordedTime();
+  timing.SetComplexity(frame_complexity_);
+#if IMPELLER_SUPPORTS_RENDERING
+  if (auto context = impeller_context_.lock()) {
+    timing.SetGPUTime(
+        context->GetLastGPUFrameTime().value_or(fml::TimeDelta::Zero()));
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  delegate_.OnFrameRasterized(timing);
+  fml::ReportAllocationTagStats();
+
+  if (adaptive_quality_controller_ &&
+      adaptive_quality_controller_->RecordFrameRasterized(
+          timing.Get(FrameTiming::kRasterFinish) -
+              timing.Get(FrameTiming::kRasterStart),
+          fml::TimeDelta::FromMillisecondsF(
+              delegate_.GetFrameBudget().count()))) {
+    TRACE_EVENT_INSTANT1(
+        "flutter", "AdaptiveQualityChanged", "level",
+        std::to_string(adaptive_quality_controller_->GetLevel()).c_str());
+    ApplyAdaptiveQuality();
+  }
 
 // SceneDisplayLag events are disabled on Fuchsia.
 // see: https://github.com/flutter/flutter/issues/56598
@@ -603,7 +884,18 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
 
   frame_timings_recorder.RecordRasterStart(fml::TimePoint::Now());
 
+#if IMPELLER_SUPPORTS_RENDERING
+  // The views drawn for this frame share the transient allocations and the
+  // glyph atlases of a single frame.
+  std::shared_ptr<impeller::AiksContext> aiks_context =
+      tasks.size() > 1u ? surface_->GetAiksContext() : nullptr;
+  if (aiks_context) {
+    aiks_context->BeginFrameBatch();
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
   // Second traverse: draw all layer trees.
+  frame_complexity_ = {};
   std::vector<std::unique_ptr<LayerTreeTask>> resubmitted_tasks;
   for (std::unique_ptr<LayerTreeTask>& task : tasks) {
     int64_t view_id = task->view_id;
@@ -617,6 +909,8 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
     auto& view_record = EnsureViewRecord(task->view_id);
     view_record.last_draw_status = status;
     if (status == DrawSurfaceStatus::kSuccess) {
+      AccumulateFrameComplexity(*layer_tree);
+      CaptureDisplayList(*layer_tree);
       view_record.last_successful_task = std::make_unique<LayerTreeTask>(
           view_id, std::move(layer_tree), device_pixel_ratio);
     } else if (status == DrawSurfaceStatus::kRetry) {
@@ -624,14 +918,27 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
           view_id, std::move(layer_tree), device_pixel_ratio));
     }
   }
+#if IMPELLER_SUPPORTS_RENDERING
+  if (aiks_context) {
+    aiks_context->EndFrameBatch();
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
   // TODO(dkwingsmt): Pass in raster cache(s) for all views.
   // See https://github.com/flutter/flutter/issues/135530, item 4.
   frame_timings_recorder.RecordRasterEnd(&compositor_context_->raster_cache());
   FireNextFrameCallbackIfPresent();
 
-  if (surface_->GetContext()) {
-    surface_->GetContext()->performDeferredCleanup(kSkiaCleanupExpiration);
-  }
+  // Purging the resources Skia no longer uses can wait until the raster thread
+  // has no frame to draw.
+  delegate_.GetTaskRunners().GetRasterTaskRunner()->PostTaskWithGrade(
+      [weak_this = weak_factory_.GetWeakPtr()]() {
+        if (weak_this && weak_this->surface_ &&
+            weak_this->surface_->GetContext()) {
+          weak_this->surface_->GetContext()->performDeferredCleanup(
+              kSkiaCleanupExpiration);
+        }
+      },
+      fml::TaskSourceGrade::kBackground);
 
   if (resubmitted_tasks.empty()) {
     return nullptr;
@@ -691,21 +998,29 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
     compositor_context_->raster_cache().BeginFrame();
 
     std::unique_ptr<FrameDamage> damage;
+    // Disable partial repaint if external_view_embedder_ SubmitFlutterView is
+    // involved - ExternalViewEmbedder unconditionally clears the entire
+    // surface and also partial repaint with platform view present is
+    // something that still need to be figured out.
+    bool force_full_repaint =
+        external_view_embedder_ &&
+        (!raster_thread_merger_ || raster_thread_merger_->IsMerged());
+    // The embedder may still present which parts of the frames changed.
+    bool report_frame_damage =
+        force_full_repaint && external_view_embedder_->SupportsFrameDamage();
     // when leaf layer tracing is enabled we wish to repaint the whole frame
     // for accurate performance metrics.
-    if (frame->framebuffer_info().supports_partial_repaint &&
+    if ((frame->framebuffer_info().supports_partial_repaint ||
+         report_frame_damage) &&
         !layer_tree.is_leaf_layer_tracing_enabled()) {
-      // Disable partial repaint if external_view_embedder_ SubmitFlutterView is
-      // involved - ExternalViewEmbedder unconditionally clears the entire
-      // surface and also partial repaint with platform view present is
-      // something that still need to be figured out.
-      bool force_full_repaint =
-          external_view_embedder_ &&
-          (!raster_thread_merger_ || raster_thread_merger_->IsMerged());
-
       damage = std::make_unique<FrameDamage>();
       auto existing_damage = frame->framebuffer_info().existing_damage;
-      if (existing_damage.has_value() && !force_full_repaint) {
+      if (report_frame_damage) {
+        damage->SetPreviousLayerTree(GetLastLayerTree(view_id));
+        damage->SetClipToDamage(false);
+        // The frames are still repainted and presented entirely.
+        damage->Reset();
+      } else if (existing_damage.has_value() && !force_full_repaint) {
         damage->SetPreviousLayerTree(GetLastLayerTree(view_id));
         damage->AddAdditionalDamage(existing_damage.value());
         damage->SetClipAlignment(
@@ -768,6 +1083,46 @@ Rasterizer::ViewRecord& Rasterizer::EnsureViewRecord(int64_t view_id) {
   return view_records_[view_id];
 }
 
+void Rasterizer::CaptureDisplayList(flutter::LayerTree& layer_tree) {
+  const std::string& path = delegate_.GetSettings().capture_display_lists_path;
+  if (path.empty() ||
+      captured_display_list_count_ >= kMaxCapturedDisplayLists) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "Rasterizer::CaptureDisplayList");
+  if (!capture_display_lists_directory_.is_valid()) {
+    capture_display_lists_directory_ = fml::OpenDirectory(
+        path.c_str(), true, fml::FilePermission::kReadWrite);
+    if (!capture_display_lists_directory_.is_valid()) {
+      FML_LOG(ERROR) << "Could not open " << path
+                     << " to capture display lists.";
+      captured_display_list_count_ = kMaxCapturedDisplayLists;
+      return;
+    }
+  }
+  auto display_list = layer_tree.Flatten(
+      SkRect::Make(layer_tree.frame_size()), GetTextureRegistry(),
+      GetGrContext());
+  auto serialized = display_list
+                        ? DlSerializedDisplayList::Serialize(*display_list)
+                        : nullptr;
+  if (!serialized) {
+    if (!logged_display_list_capture_failure_) {
+      FML_LOG(WARNING) << "Skipping frames that can't be serialized while "
+                          "capturing display lists.";
+      logged_display_list_capture_failure_ = true;
+    }
+    return;
+  }
+  auto name = "frame_" + std::to_string(captured_display_list_count_);
+  if (!serialized->WriteToDirectory(capture_display_lists_directory_, name)) {
+    FML_LOG(ERROR) << "Could not write " << name << " to " << path << ".";
+    captured_display_list_count_ = kMaxCapturedDisplayLists;
+    return;
+  }
+  captured_display_list_count_++;
+}
+
 static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
     flutter::LayerTree* tree,
     flutter::CompositorContext& compositor_context) {
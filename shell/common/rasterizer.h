@@ -5,8 +5,11 @@
 #ifndef FLUTTER_SHELL_COMMON_RASTERIZER_H_
 #define FLUTTER_SHELL_COMMON_RASTERIZER_H_
 
+#include <functional>
+#include <map>
 #include <memory>
 #include <optional>
+#include <string>
 #include <unordered_map>
 
 #include "flutter/common/settings.h"
@@ -24,6 +27,7 @@
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/fml/unique_fd.h"
 #if IMPELLER_SUPPORTS_RENDERING
 // GN is having trouble understanding how this works in the Fuchsia builds.
 #include "impeller/aiks/aiks_context.h"  // nogncheck
@@ -31,6 +35,10 @@
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"  // nogncheck
 #endif  // IMPELLER_SUPPORTS_RENDERING
 #include "flutter/lib/ui/snapshot_delegate.h"
+#include "flutter/shell/common/adaptive_quality_controller.h"
+#include "flutter/shell/common/idle_task_scheduler.h"
+#include "flutter/shell/common/jank_capture.h"
+#include "flutter/shell/common/memory_usage.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/snapshot_controller.h"
 #include "flutter/shell/common/snapshot_surface_producer.h"
@@ -248,6 +256,27 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   void NotifyLowMemoryWarning() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the rasterizer that the UI thread is idle until the
+  ///             deadline, and runs the idle tasks that fit before it.
+  ///
+  ///             With Impeller, once no frame has been drawn for a while,
+  ///             the render targets cached for the next frames are released
+  ///             so that the memory they leave behind can be reused or
+  ///             returned to the system, and long lived textures are moved
+  ///             out of sparsely used blocks of device memory.
+  ///
+  /// @param[in]  deadline  The time by which the rasterizer must be done.
+  ///
+  void NotifyIdle(fml::TimePoint deadline);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The scheduler of the maintenance work that runs on the
+  ///             raster thread when it would otherwise be idle. Subsystems
+  ///             owned by the rasterizer may add their tasks to it.
+  ///
+  IdleTaskScheduler& GetIdleTaskScheduler() { return idle_task_scheduler_; }
+
   //----------------------------------------------------------------------------
   /// @brief      Gets a weak pointer to the rasterizer. The rasterizer may only
   ///             be accessed on the raster task runner.
@@ -578,6 +607,39 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   std::optional<DrawSurfaceStatus> GetLastDrawStatus(int64_t view_id);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the Impeller pipeline variants created so far by the
+  ///             on-screen surface, in the format read by
+  ///             |PersistentCache::LoadImpellerPipelineVariants|.
+  ///
+  /// @return     The pipeline variants, or an empty string if the surface
+  ///             doesn't render with Impeller.
+  ///
+  std::string GetImpellerPipelineVariants() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the GPU time of a recent frame spent on each category
+  ///             of draws, keyed by the name of the category.
+  ///
+  /// @return     The GPU times, or an empty map if the Impeller context
+  ///             doesn't attribute GPU time to draws, which is the case for
+  ///             the Skia backend and release builds.
+  ///
+  std::map<std::string, fml::TimeDelta> GetImpellerGPUTimeByCategory() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the sizes of the last layer trees drawn and of the
+  ///             glyph atlases, which are recorded by jank captures.
+  ///
+  JankCapture::RasterizerStats GetJankCaptureStats() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the memory held by the raster cache, the last layer
+  ///             trees drawn and Impeller. The bytes of the image textures
+  ///             are left for the caller to fill in.
+  ///
+  MemoryUsage GetMemoryUsage() const;
+
  private:
   // The result status of DoDraw, DrawToSurfaces, and DrawToSurfacesUnsafe.
   enum class DoDrawStatus {
@@ -708,8 +770,25 @@ class Rasterizer final : public SnapshotDelegate,
 
   ViewRecord& EnsureViewRecord(int64_t view_id);
 
+  // Writes the layer tree as a serialized display list to the directory set
+  // by |Settings::capture_display_lists_path|, if any.
+  void CaptureDisplayList(flutter::LayerTree& layer_tree);
+
+  // Invokes |visitor| with every layer of the last layer trees drawn.
+  void VisitLastLayers(const std::function<void(const Layer*)>& visitor) const;
+
   void FireNextFrameCallbackIfPresent();
 
+  // Adds what was rasterized for |layer_tree| to |frame_complexity_|.
+  void AccumulateFrameComplexity(const LayerTree& layer_tree);
+
+  // Applies the quality level of |adaptive_quality_controller_| to the raster
+  // cache and to the content context of Impeller.
+  void ApplyAdaptiveQuality();
+
+  // Adds the maintenance work of the rasterizer to |idle_task_scheduler_|.
+  void AddIdleTasks();
+
   static bool ShouldResubmitFrame(const DoDrawResult& result);
   static DrawStatus ToDrawStatus(DoDrawStatus status);
 
@@ -727,6 +806,15 @@ class Rasterizer final : public SnapshotDelegate,
   fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
   std::shared_ptr<ExternalViewEmbedder> external_view_embedder_;
   std::unique_ptr<SnapshotController> snapshot_controller_;
+  fml::UniqueFD capture_display_lists_directory_;
+  size_t captured_display_list_count_ = 0u;
+  bool logged_display_list_capture_failure_ = false;
+  // The complexity of the layer trees drawn for the current frame.
+  FrameTiming::Complexity frame_complexity_;
+  // Only set when |Settings::enable_adaptive_quality| is set.
+  std::unique_ptr<AdaptiveQualityController> adaptive_quality_controller_;
+  size_t default_raster_cache_access_threshold_ = 0u;
+  IdleTaskScheduler idle_task_scheduler_;
 
   // WeakPtrFactory must be the last member.
   fml::TaskRunnerAffineWeakPtrFactory<Rasterizer> weak_factory_;
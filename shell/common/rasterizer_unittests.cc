@@ -10,6 +10,7 @@
 #include <optional>
 
 #include "flutter/flow/frame_timings.h"
+#include "flutter/flow/layers/container_layer.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/thread_host.h"
@@ -124,6 +125,7 @@ class MockExternalViewEmbedder : public ExternalViewEmbedder {
        const fml::RefPtr<fml::RasterThreadMerger>& raster_thread_merger),
       (override));
   MOCK_METHOD(bool, SupportsDynamicThreadMerging, (), (override));
+  MOCK_METHOD(bool, SupportsFrameDamage, (), (override));
 };
 }  // namespace
 
@@ -493,6 +495,90 @@ TEST(RasterizerTest,
   rasterizer->DrawLastLayerTrees(CreateFinishedBuildRecorder());
 }
 
+TEST(RasterizerTest, externalViewEmbedderReceivesFrameDamageWhenSupported) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::kPlatform |
+                             ThreadHost::Type::kRaster | ThreadHost::Type::kIo |
+                             ThreadHost::Type::kUi);
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  TaskRunners task_runners("test",
+                           fml::MessageLoop::GetCurrent().GetTaskRunner(),
+                           fml::MessageLoop::GetCurrent().GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto surface = std::make_unique<NiceMock<MockSurface>>();
+
+  std::shared_ptr<NiceMock<MockExternalViewEmbedder>> external_view_embedder =
+      std::make_shared<NiceMock<MockExternalViewEmbedder>>();
+  rasterizer->SetExternalViewEmbedder(external_view_embedder);
+  ON_CALL(*external_view_embedder, SupportsFrameDamage)
+      .WillByDefault(Return(true));
+
+  const SkISize frame_size = SkISize::Make(800, 600);
+  ON_CALL(*surface, AllowsDrawingWhenGpuDisabled()).WillByDefault(Return(true));
+  ON_CALL(*surface, AcquireFrame(_))
+      .WillByDefault(::testing::Invoke([frame_size](SkISize) {
+        SurfaceFrame::FramebufferInfo framebuffer_info;
+        framebuffer_info.supports_readback = true;
+        return std::make_unique<SurfaceFrame>(
+            /*surface=*/nullptr, framebuffer_info,
+            /*submit_callback=*/
+            [](const SurfaceFrame&, DlCanvas*) { return true; }, frame_size,
+            /*context_result=*/nullptr, /*display_list_fallback=*/true);
+      }));
+  ON_CALL(*surface, MakeRenderContextCurrent())
+      .WillByDefault(::testing::Invoke(
+          [] { return std::make_unique<GLContextDefaultResult>(true); }));
+
+  std::vector<std::optional<SkIRect>> frame_damages;
+  EXPECT_CALL(*external_view_embedder, SubmitFlutterView)
+      .Times(2)
+      .WillRepeatedly(::testing::Invoke(
+          [&frame_damages](
+              GrDirectContext*, const std::shared_ptr<impeller::AiksContext>&,
+              std::unique_ptr<SurfaceFrame> frame) {
+            frame_damages.push_back(frame->submit_info().frame_damage);
+            // The frame is still repainted entirely.
+            EXPECT_FALSE(frame->submit_info().buffer_damage.has_value());
+          }));
+
+  rasterizer->Setup(std::move(surface));
+
+  auto pipeline = std::make_shared<FramePipeline>(/*depth=*/10);
+  LayerTree::Config config;
+  config.root_layer = std::make_shared<ContainerLayer>();
+  auto layer_tree = std::make_unique<LayerTree>(config, frame_size);
+  auto layer_tree_item = std::make_unique<FrameItem>(
+      SingleLayerTreeList(kImplicitViewId, std::move(layer_tree),
+                          kDevicePixelRatio),
+      CreateFinishedBuildRecorder());
+  PipelineProduceResult result =
+      pipeline->Produce().Complete(std::move(layer_tree_item));
+  EXPECT_TRUE(result.success);
+
+  ON_CALL(delegate, ShouldDiscardLayerTree).WillByDefault(Return(false));
+  rasterizer->Draw(pipeline);
+  rasterizer->DrawLastLayerTrees(CreateFinishedBuildRecorder());
+
+  // The first frame is damaged entirely, and the same layer tree drawn again
+  // damages nothing.
+  ASSERT_EQ(frame_damages.size(), 2u);
+  ASSERT_TRUE(frame_damages[0].has_value());
+  EXPECT_EQ(frame_damages[0].value(), SkIRect::MakeSize(frame_size));
+  ASSERT_TRUE(frame_damages[1].has_value());
+  EXPECT_TRUE(frame_damages[1]->isEmpty());
+}
+
 TEST(RasterizerTest, externalViewEmbedderDoesntEndFrameWhenNoSurfaceIsSet) {
   std::string test_name =
       ::testing::UnitTest::GetInstance()->current_test_info()->name();
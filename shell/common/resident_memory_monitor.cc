@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/resident_memory_monitor.h"
+
+#include <utility>
+
+#include "flutter/fml/build_config.h"
+
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+#include <unistd.h>
+
+#include <fstream>
+#elif defined(FML_OS_MACOSX)
+#include <mach/mach.h>
+#endif
+
+namespace flutter {
+
+std::optional<size_t> ResidentMemoryMonitor::GetResidentMemoryBytes() {
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+  // The second field is the number of resident pages.
+  std::ifstream statm("/proc/self/statm");
+  size_t total_pages = 0u;
+  size_t resident_pages = 0u;
+  if (!(statm >> total_pages >> resident_pages)) {
+    return std::nullopt;
+  }
+  const long page_size = sysconf(_SC_PAGESIZE);
+  if (page_size <= 0) {
+    return std::nullopt;
+  }
+  return resident_pages * static_cast<size_t>(page_size);
+#elif defined(FML_OS_MACOSX)
+  mach_task_basic_info_data_t info = {};
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                reinterpret_cast<task_info_t>(&info),
+                &count) != KERN_SUCCESS) {
+    return std::nullopt;
+  }
+  return static_cast<size_t>(info.resident_size);
+#else
+  return std::nullopt;
+#endif
+}
+
+ResidentMemoryMonitor::ResidentMemoryMonitor(size_t threshold_bytes,
+                                             Sampler sampler)
+    : threshold_bytes_(threshold_bytes),
+      sampler_(std::move(sampler)),
+      next_warning_bytes_(threshold_bytes) {}
+
+ResidentMemoryMonitor::~ResidentMemoryMonitor() = default;
+
+bool ResidentMemoryMonitor::Sample(fml::TimePoint now) {
+  if (threshold_bytes_ == 0u) {
+    return false;
+  }
+  if (last_sample_time_.has_value() &&
+      now - last_sample_time_.value() < kMinSampleInterval) {
+    return false;
+  }
+  last_sample_time_ = now;
+  auto resident_bytes = sampler_();
+  if (!resident_bytes.has_value()) {
+    return false;
+  }
+  if (resident_bytes.value() < threshold_bytes_) {
+    next_warning_bytes_ = threshold_bytes_;
+    return false;
+  }
+  if (resident_bytes.value() < next_warning_bytes_) {
+    return false;
+  }
+  next_warning_bytes_ = resident_bytes.value() + threshold_bytes_ / 4u;
+  return true;
+}
+
+}  // namespace flutter
@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_RESIDENT_MEMORY_MONITOR_H_
+#define FLUTTER_SHELL_COMMON_RESIDENT_MEMORY_MONITOR_H_
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+/// Samples the resident memory of the process, and decides when the |Shell|
+/// should act as if the system sent a low memory warning, so that the Dart GC
+/// runs and the caches are trimmed before the system kills the process.
+///
+/// A warning is raised when the resident memory crosses the threshold, and
+/// again each time it grows by another quarter of the threshold, until it
+/// drops below the threshold.
+///
+/// Used by the |Shell| on the UI thread only.
+class ResidentMemoryMonitor {
+ public:
+  /// Returns the resident memory of the process in bytes, or nullopt if it
+  /// can't be read on this platform.
+  using Sampler = std::function<std::optional<size_t>()>;
+
+  // The minimum time between samples, as reading the resident memory can
+  // take a system call and the file system.
+  static constexpr fml::TimeDelta kMinSampleInterval =
+      fml::TimeDelta::FromSeconds(1);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The resident memory of the process in bytes, or nullopt on
+  ///             platforms where it isn't supported.
+  ///
+  static std::optional<size_t> GetResidentMemoryBytes();
+
+  ResidentMemoryMonitor(size_t threshold_bytes,
+                        Sampler sampler = &GetResidentMemoryBytes);
+
+  ~ResidentMemoryMonitor();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Samples the resident memory unless it was sampled less than
+  ///             |kMinSampleInterval| ago.
+  ///
+  /// @return     Whether a low memory warning should be raised.
+  ///
+  bool Sample(fml::TimePoint now);
+
+ private:
+  const size_t threshold_bytes_;
+  const Sampler sampler_;
+  size_t next_warning_bytes_;
+  std::optional<fml::TimePoint> last_sample_time_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ResidentMemoryMonitor);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_RESIDENT_MEMORY_MONITOR_H_
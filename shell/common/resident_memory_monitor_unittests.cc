@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/resident_memory_monitor.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(ResidentMemoryMonitorTest, WarnsWhenCrossingAndGrowingPastThreshold) {
+  size_t resident_bytes = 0u;
+  ResidentMemoryMonitor monitor(
+      1000u, [&]() -> std::optional<size_t> { return resident_bytes; });
+  auto now = fml::TimePoint::Now();
+  auto next_sample = [&]() {
+    now = now + ResidentMemoryMonitor::kMinSampleInterval;
+    return monitor.Sample(now);
+  };
+
+  resident_bytes = 900u;
+  EXPECT_FALSE(next_sample());
+  resident_bytes = 1000u;
+  EXPECT_TRUE(next_sample());
+  // Not again until the memory grows by another quarter of the threshold.
+  resident_bytes = 1200u;
+  EXPECT_FALSE(next_sample());
+  resident_bytes = 1250u;
+  EXPECT_TRUE(next_sample());
+  // Rearmed once the memory drops below the threshold.
+  resident_bytes = 500u;
+  EXPECT_FALSE(next_sample());
+  resident_bytes = 1000u;
+  EXPECT_TRUE(next_sample());
+}
+
+TEST(ResidentMemoryMonitorTest, ThrottlesSamples) {
+  size_t sample_count = 0u;
+  ResidentMemoryMonitor monitor(1000u, [&]() -> std::optional<size_t> {
+    sample_count++;
+    return 2000u;
+  });
+  auto now = fml::TimePoint::Now();
+  EXPECT_TRUE(monitor.Sample(now));
+  EXPECT_FALSE(monitor.Sample(now + fml::TimeDelta::FromMilliseconds(10)));
+  EXPECT_EQ(sample_count, 1u);
+}
+
+TEST(ResidentMemoryMonitorTest, DisabledWithoutThreshold) {
+  ResidentMemoryMonitor monitor(
+      0u, []() -> std::optional<size_t> { return 2000u; });
+  EXPECT_FALSE(monitor.Sample(fml::TimePoint::Now()));
+}
+
+TEST(ResidentMemoryMonitorTest, IgnoresUnsupportedPlatforms) {
+  ResidentMemoryMonitor monitor(
+      1000u, []() -> std::optional<size_t> { return std::nullopt; });
+  EXPECT_FALSE(monitor.Sample(fml::TimePoint::Now()));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/resource_upload_context_pool.h"
+
+#include <limits>
+#include <string>
+#include <utility>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+ResourceUploadContextPool::ResourceUploadContextPool(
+    size_t thread_count,
+    const ContextFactory& context_factory,
+    ContextReleaser context_releaser,
+    fml::TimeDelta unref_queue_drain_delay)
+    : context_releaser_(std::move(context_releaser)) {
+  for (size_t i = 0; i < thread_count; i++) {
+    auto slot = std::make_unique<Slot>();
+    slot->thread = std::make_unique<fml::Thread>("io.flutter.upload." +
+                                                 std::to_string(i + 1));
+    auto task_runner = slot->thread->GetTaskRunner();
+    fml::AutoResetWaitableEvent latch;
+    task_runner->PostTask([&slot = *slot, &context_factory, &latch]() {
+      TRACE_EVENT0("flutter", "CreateResourceUploadContext");
+      slot.context = context_factory();
+      latch.Signal();
+    });
+    latch.Wait();
+    if (!slot->context) {
+      // Contexts beyond what the platform supports aren't an error, there
+      // just aren't as many threads.
+      slot->thread->Join();
+      break;
+    }
+    slot->unref_queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+        task_runner, unref_queue_drain_delay, slot->context);
+    slots_.emplace_back(std::move(slot));
+  }
+}
+
+ResourceUploadContextPool::~ResourceUploadContextPool() {
+  for (auto& slot : slots_) {
+    slot->thread->GetTaskRunner()->PostTask([&slot = *slot, this]() {
+      slot.unref_queue->Drain();
+      slot.unref_queue->UpdateResourceContext(nullptr);
+      slot.context.reset();
+      if (context_releaser_) {
+        context_releaser_();
+      }
+    });
+    slot->thread->Join();
+  }
+}
+
+size_t ResourceUploadContextPool::GetContextCount() const {
+  return slots_.size();
+}
+
+bool ResourceUploadContextPool::PostTask(IOManager::UploadTask task) {
+  Slot* least_busy = nullptr;
+  size_t least_pending = std::numeric_limits<size_t>::max();
+  for (const auto& slot : slots_) {
+    const size_t pending = slot->pending_tasks.load();
+    if (pending < least_pending) {
+      least_busy = slot.get();
+      least_pending = pending;
+    }
+  }
+  if (!least_busy) {
+    return false;
+  }
+  least_busy->pending_tasks++;
+  least_busy->thread->GetTaskRunner()->PostTask(
+      [&slot = *least_busy, task = std::move(task)]() {
+        TRACE_EVENT0("flutter", "ResourceUploadTask");
+        task(slot.context.get(), slot.unref_queue);
+        slot.pending_tasks--;
+      });
+  return true;
+}
+
+}  // namespace flutter
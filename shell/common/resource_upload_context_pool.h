@@ -0,0 +1,90 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_RESOURCE_UPLOAD_CONTEXT_POOL_H_
+#define FLUTTER_SHELL_COMMON_RESOURCE_UPLOAD_CONTEXT_POOL_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/thread.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/lib/ui/io_manager.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Threads that each own a resource context in the share group of
+///             the one of the IO manager, so that the decoded images of
+///             image-heavy frames can be uploaded in parallel instead of one
+///             after the other on the IO thread.
+///
+///             The contexts are created and collected on their own threads by
+///             the platform. Images uploaded with
+///             `SkImages::CrossContextTextureFromPixmap` carry the fence that
+///             the raster context waits on before sampling them, so no other
+///             synchronization is needed for the handoff.
+///
+class ResourceUploadContextPool {
+ public:
+  /// Called on an upload thread to create a context current on it. May
+  /// return `nullptr` if the platform cannot create more contexts.
+  using ContextFactory = std::function<sk_sp<GrDirectContext>()>;
+
+  /// Called on an upload thread once its context has been collected.
+  using ContextReleaser = std::function<void()>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts the threads and creates their contexts, waiting for
+  ///             them to be created. Threads whose context could not be
+  ///             created are stopped right away.
+  ///
+  ResourceUploadContextPool(size_t thread_count,
+                            const ContextFactory& context_factory,
+                            ContextReleaser context_releaser,
+                            fml::TimeDelta unref_queue_drain_delay =
+                                fml::TimeDelta::FromMilliseconds(8));
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drains the unref queues and collects the contexts on their
+  ///             threads, then stops the threads. Tasks that are already
+  ///             posted run first.
+  ///
+  ~ResourceUploadContextPool();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of threads with a context.
+  ///
+  size_t GetContextCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Posts the task to the thread with the fewest pending tasks.
+  ///
+  /// @return     Whether the task was posted, which it isn't if there are no
+  ///             contexts.
+  ///
+  bool PostTask(IOManager::UploadTask task);
+
+ private:
+  struct Slot {
+    std::unique_ptr<fml::Thread> thread;
+    sk_sp<GrDirectContext> context;
+    fml::RefPtr<SkiaUnrefQueue> unref_queue;
+    std::atomic<size_t> pending_tasks = 0u;
+  };
+
+  const ContextReleaser context_releaser_;
+  std::vector<std::unique_ptr<Slot>> slots_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ResourceUploadContextPool);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_RESOURCE_UPLOAD_CONTEXT_POOL_H_
@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/resource_upload_context_pool.h"
+
+#include <atomic>
+#include <mutex>
+#include <set>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(ResourceUploadContextPoolTest, PostsTasksWithTheContextOfTheirThread) {
+  std::atomic<size_t> released = 0u;
+  {
+    ResourceUploadContextPool pool(
+        2u, []() { return GrDirectContext::MakeMock(nullptr); },
+        [&released]() { released++; });
+    ASSERT_EQ(pool.GetContextCount(), 2u);
+
+    fml::CountDownLatch latch(4u);
+    std::mutex mutex;
+    std::set<GrDirectContext*> contexts;
+    for (size_t i = 0; i < 4u; i++) {
+      ASSERT_TRUE(pool.PostTask(
+          [&](GrDirectContext* context,
+              const fml::RefPtr<SkiaUnrefQueue>& queue) {
+            EXPECT_TRUE(context);
+            EXPECT_TRUE(queue);
+            {
+              std::scoped_lock lock(mutex);
+              contexts.insert(context);
+            }
+            latch.CountDown();
+          }));
+    }
+    latch.Wait();
+    EXPECT_GE(contexts.size(), 1u);
+    EXPECT_LE(contexts.size(), 2u);
+  }
+  EXPECT_EQ(released, 2u);
+}
+
+TEST(ResourceUploadContextPoolTest, StopsAtTheFirstContextThatCannotBeMade) {
+  std::atomic<size_t> made = 0u;
+  ResourceUploadContextPool pool(
+      3u,
+      [&made]() -> sk_sp<GrDirectContext> {
+        if (made++ > 0u) {
+          return nullptr;
+        }
+        return GrDirectContext::MakeMock(nullptr);
+      },
+      nullptr);
+  EXPECT_EQ(pool.GetContextCount(), 1u);
+  EXPECT_EQ(made, 2u);
+}
+
+TEST(ResourceUploadContextPoolTest, DoesNotPostTasksWithoutContexts) {
+  ResourceUploadContextPool pool(
+      2u, []() -> sk_sp<GrDirectContext> { return nullptr; }, nullptr);
+  EXPECT_EQ(pool.GetContextCount(), 0u);
+  EXPECT_FALSE(pool.PostTask(
+      [](GrDirectContext*, const fml::RefPtr<SkiaUnrefQueue>&) {}));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -13,16 +13,20 @@
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/display_list/skia/dl_sk_dispatcher.h"
 #include "flutter/fml/base32.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/icu_util.h"
 #include "flutter/fml/log_settings.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/memory/allocation_tag.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_ring_buffer.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/runtime/snapshot_page_profile.h"
 #include "flutter/shell/common/base64.h"
 #include "flutter/shell/common/engine.h"
 #include "flutter/shell/common/skia_event_tracer_impl.h"
@@ -83,6 +87,27 @@ std::unique_ptr<Engine> CreateEngine(
                                   runtime_stage_backend);
 }
 
+// Starts the threads that upload images in parallel to the IO thread, if the
+// settings ask for them and the IO manager uploads with a Skia resource
+// context. Must be called on the IO thread.
+void SetUpResourceUploadThreads(ShellIOManager& io_manager,
+                                const PlatformView& platform_view,
+                                size_t thread_count) {
+  if (thread_count == 0 || io_manager.HasUploadContextPool() ||
+      io_manager.GetImpellerContext() || !io_manager.GetResourceContext()) {
+    return;
+  }
+  auto pool = std::make_unique<ResourceUploadContextPool>(
+      thread_count,
+      [&platform_view]() {
+        return platform_view.CreateResourceUploadContext();
+      },
+      [&platform_view]() { platform_view.ReleaseResourceUploadContext(); });
+  if (pool->GetContextCount() > 0) {
+    io_manager.SetUploadContextPool(std::move(pool), &platform_view);
+  }
+}
+
 void RegisterCodecsWithSkia() {
   // These are in the order they will be attempted to be decoded from.
   // If we have data to back it up, we can order these by "frequency used in
@@ -143,6 +168,7 @@ void PerformInitializationTasks(Settings& settings) {
   });
 
   PersistentCache::SetCacheSkSL(settings.cache_sksl);
+  DlSkCanvasDispatcher::SetBatchImageDraws(settings.skia_batch_image_draws);
 }
 
 }  // namespace
@@ -171,27 +197,38 @@ std::unique_ptr<Shell> Shell::Create(
     const Shell::CreateCallback<PlatformView>& on_create_platform_view,
     const Shell::CreateCallback<Rasterizer>& on_create_rasterizer,
     bool is_gpu_disabled) {
+  // The phases that precede the creation of the shell are merged into its
+  // timeline once it exists.
+  StartupTimeline startup_timeline;
+  startup_timeline.RecordPhase(StartupTimeline::Phase::kShellCreate);
+
   // This must come first as it initializes tracing.
   PerformInitializationTasks(settings);
+  startup_timeline.RecordPhase(StartupTimeline::Phase::kInitializationTasks);
 
   TRACE_EVENT0("flutter", "Shell::Create");
 
   auto [vm, isolate_snapshot] = InferVmInitDataFromSettings(settings);
+  startup_timeline.RecordPhase(StartupTimeline::Phase::kDartVM);
   auto resource_cache_limit_calculator =
       std::make_shared<ResourceCacheLimitCalculator>(
           settings.resource_cache_max_bytes_threshold);
 
-  return CreateWithSnapshot(platform_data,                     //
-                            task_runners,                      //
-                            /*parent_thread_merger=*/nullptr,  //
-                            /*parent_io_manager=*/nullptr,     //
-                            resource_cache_limit_calculator,   //
-                            settings,                          //
-                            std::move(vm),                     //
-                            std::move(isolate_snapshot),       //
-                            on_create_platform_view,           //
-                            on_create_rasterizer,              //
-                            CreateEngine, is_gpu_disabled);
+  auto shell = CreateWithSnapshot(platform_data,                     //
+                                  task_runners,                      //
+                                  /*parent_thread_merger=*/nullptr,  //
+                                  /*parent_io_manager=*/nullptr,     //
+                                  resource_cache_limit_calculator,   //
+                                  settings,                          //
+                                  std::move(vm),                     //
+                                  std::move(isolate_snapshot),       //
+                                  on_create_platform_view,           //
+                                  on_create_rasterizer,              //
+                                  CreateEngine, is_gpu_disabled);
+  if (shell) {
+    shell->startup_timeline_.Merge(startup_timeline);
+  }
+  return shell;
 }
 
 static impeller::RuntimeStageBackend DetermineRuntimeStageBackend(
@@ -241,6 +278,7 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   if (!platform_view || !platform_view->GetWeakPtr()) {
     return nullptr;
   }
+  shell->startup_timeline_.RecordPhase(StartupTimeline::Phase::kPlatformView);
 
   // Create the rasterizer on the raster thread.
   std::promise<std::unique_ptr<Rasterizer>> rasterizer_promise;
@@ -259,6 +297,8 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
         TRACE_EVENT0("flutter", "ShellSetupGPUSubsystem");
         std::unique_ptr<Rasterizer> rasterizer(on_create_rasterizer(*shell));
         rasterizer->SetImpellerContext(impeller_context);
+        shell->startup_timeline_.RecordPhase(
+            StartupTimeline::Phase::kRasterizer);
         snapshot_delegate_promise.set_value(rasterizer->GetSnapshotDelegate());
         rasterizer_promise.set_value(std::move(rasterizer));
       });
@@ -291,9 +331,11 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
        &weak_io_manager_promise,                                          //
        &parent_io_manager,                                                //
        &unref_queue_promise,                                              //
+       &startup_timeline = shell->startup_timeline_,                      //
        platform_view_ptr,                                                 //
        io_task_runner,                                                    //
-       is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch()  //
+       is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch(),
+       upload_thread_count = settings.resource_upload_thread_count  //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupIOSubsystem");
         std::shared_ptr<ShellIOManager> io_manager;
@@ -306,7 +348,10 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
               io_task_runner,  // unref queue task runner
               platform_view_ptr->GetImpellerContext()  // impeller context
           );
+          SetUpResourceUploadThreads(*io_manager, *platform_view_ptr,
+                                     upload_thread_count);
         }
+        startup_timeline.RecordPhase(StartupTimeline::Phase::kIOManager);
         weak_io_manager_promise.set_value(io_manager->GetWeakPtr());
         unref_queue_promise.set_value(io_manager->GetSkiaUnrefQueue());
         io_manager_promise.set_value(io_manager);
@@ -340,6 +385,12 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
         // from the platform.
         auto animator = std::make_unique<Animator>(*shell, task_runners,
                                                    std::move(vsync_waiter));
+        if (shell->GetSettings().enable_deadline_aware_frame_scheduling) {
+          animator->EnableDeadlineAwareScheduling();
+        }
+        if (shell->GetSettings().enable_workload_thread_affinity) {
+          animator->EnableWorkloadThreadAffinity();
+        }
 
         engine_promise.set_value(on_create_engine(
             *shell,                               //
@@ -357,6 +408,7 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
             shell->is_gpu_disabled_sync_switch_,  //
             runtime_stage_backend                 //
             ));
+        shell->startup_timeline_.RecordPhase(StartupTimeline::Phase::kEngine);
       }));
 
   if (!shell->Setup(std::move(platform_view),  //
@@ -366,6 +418,7 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   ) {
     return nullptr;
   }
+  shell->startup_timeline_.RecordPhase(StartupTimeline::Phase::kShellSetup);
 
   return shell;
 }
@@ -454,6 +507,17 @@ Shell::Shell(DartVMRef vm,
   FML_DCHECK(task_runners_.IsValid());
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  if (!settings_.jank_capture_path.empty()) {
+    fml::tracing::TraceRingBuffer::SetEnabled(true);
+    jank_capture_ = std::make_unique<JankCapture>(
+        fml::TimeDelta::FromMillisecondsF(settings_.jank_capture_threshold_ms));
+  }
+
+  if (settings_.resident_memory_warning_bytes > 0u) {
+    resident_memory_monitor_ = std::make_unique<ResidentMemoryMonitor>(
+        settings_.resident_memory_warning_bytes);
+  }
+
   display_manager_ = std::make_unique<DisplayManager>();
   resource_cache_limit_calculator->AddResourceCacheLimitItem(
       weak_factory_.GetWeakPtr());
@@ -500,6 +564,26 @@ Shell::Shell(DartVMRef vm,
       task_runners_.GetIOTaskRunner(),
       std::bind(&Shell::OnServiceProtocolGetSkSLs, this, std::placeholders::_1,
                 std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetImpellerPipelineVariantsExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetImpellerPipelineVariants, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetImpellerGPUTimeByCategoryExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetImpellerGPUTimeByCategory,
+                    this, std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetTraceRingBufferExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetTraceRingBuffer, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetEngineMemoryUsageExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetEngineMemoryUsage, this,
+                    std::placeholders::_1, std::placeholders::_2)};
   service_protocol_handlers_
       [ServiceProtocol::kEstimateRasterCacheMemoryExtensionName] = {
           task_runners_.GetRasterTaskRunner(),
@@ -547,6 +631,9 @@ Shell::~Shell() {
       fml::MakeCopyable([io_manager = std::move(io_manager_),
                          platform_view = platform_view_.get(),
                          &io_latch]() mutable {
+        if (io_manager) {
+          io_manager->ResetUploadContextPool(platform_view);
+        }
         io_manager.reset();
         if (platform_view) {
           platform_view->ReleaseResourceContext();
@@ -623,6 +710,12 @@ void Shell::NotifyLowMemoryWarning() const {
   // running.
   ::Dart_NotifyLowMemory();
 
+  task_runners_.GetUITaskRunner()->PostTask([engine = weak_engine_]() {
+    if (engine) {
+      engine->NotifyLowMemoryWarning();
+    }
+  });
+
   task_runners_.GetRasterTaskRunner()->PostTask(
       [rasterizer = rasterizer_->GetWeakPtr(), trace_id = trace_id]() {
         if (rasterizer) {
@@ -731,6 +824,8 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
       });
   engine_ = std::move(engine);
   rasterizer_ = std::move(rasterizer);
+  image_texture_bytes_callback_ =
+      engine_->GetPurgeableImageTextureBytesCallback();
   io_manager_ = io_manager;
 
   // Set the external view embedder for the rasterizer.
@@ -738,6 +833,10 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   rasterizer_->SetExternalViewEmbedder(view_embedder);
   rasterizer_->SetSnapshotSurfaceProducer(
       platform_view_->CreateSnapshotSurfaceProducer());
+  if (settings_.enable_parallel_layer_tree_traversal) {
+    rasterizer_->compositor_context()->set_worker_task_runner(
+        vm_->GetConcurrentWorkerTaskRunner());
+  }
 
   // The weak ptr must be generated in the platform thread which owns the unique
   // ptr.
@@ -747,13 +846,26 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
 
   engine_->AddView(kFlutterImplicitViewId, ViewportMetrics{});
   // Setup the time-consuming default font manager right after engine created.
-  if (!settings_.prefetched_default_font_manager) {
+  // With concurrent startup, it is created on a worker while the UI thread
+  // launches the root isolate, and set once the engine runs.
+  if (settings_.enable_concurrent_startup &&
+      !settings_.prefetched_default_font_manager) {
     fml::TaskRunner::RunNowOrPostTask(task_runners_.GetUITaskRunner(),
                                       [engine = weak_engine_] {
                                         if (engine) {
-                                          engine->SetupDefaultFontManager();
+                                          engine->PrefetchDefaultFontManager();
                                         }
                                       });
+  } else if (!settings_.prefetched_default_font_manager) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetUITaskRunner(),
+        [engine = weak_engine_, &startup_timeline = startup_timeline_] {
+          if (engine) {
+            engine->SetupDefaultFontManager();
+            startup_timeline.RecordPhase(
+                StartupTimeline::Phase::kDefaultFontManager);
+          }
+        });
   }
 
   is_set_up_ = true;
@@ -870,12 +982,18 @@ void Shell::OnPlatformViewCreated(std::unique_ptr<Surface> surface) {
   auto io_task = [io_manager = io_manager_->GetWeakPtr(), platform_view,
                   ui_task_runner = task_runners_.GetUITaskRunner(), ui_task,
                   raster_task_runner = task_runners_.GetRasterTaskRunner(),
-                  raster_task, should_post_raster_task, &latch] {
+                  raster_task, should_post_raster_task,
+                  upload_thread_count = settings_.resource_upload_thread_count,
+                  &latch] {
     if (io_manager && !io_manager->GetResourceContext()) {
       sk_sp<GrDirectContext> resource_context =
           platform_view->CreateResourceContext();
       io_manager->NotifyResourceContextAvailable(resource_context);
     }
+    if (io_manager) {
+      SetUpResourceUploadThreads(*io_manager, *platform_view,
+                                 upload_thread_count);
+    }
     // Step 1: Post a task on the UI thread to tell the engine that it has
     // an output surface.
     fml::TaskRunner::RunNowOrPostTask(ui_task_runner, ui_task);
@@ -1030,6 +1148,7 @@ void Shell::OnPlatformViewSetViewportMetrics(int64_t view_id,
 void Shell::OnPlatformViewDispatchPlatformMessage(
     std::unique_ptr<PlatformMessage> message) {
   FML_DCHECK(is_set_up_);
+  FML_ALLOCATION_TAG(kPlatformMessages);
 #if FLUTTER_RUNTIME_MODE == FLUTTER_RUNTIME_MODE_DEBUG
   if (!task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread()) {
     std::scoped_lock lock(misbehaving_message_channels_mutex_);
@@ -1068,13 +1187,14 @@ void Shell::OnPlatformViewDispatchPointerDataPacket(
   TRACE_FLOW_BEGIN("flutter", "PointerEvent", next_pointer_flow_id_);
   FML_DCHECK(is_set_up_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
-  task_runners_.GetUITaskRunner()->PostTask(
+  task_runners_.GetUITaskRunner()->PostTaskWithGrade(
       fml::MakeCopyable([engine = weak_engine_, packet = std::move(packet),
                          flow_id = next_pointer_flow_id_]() mutable {
         if (engine) {
           engine->DispatchPointerDataPacket(std::move(packet), flow_id);
         }
-      }));
+      }),
+      fml::TaskSourceGrade::kUserInteraction);
   next_pointer_flow_id_++;
 }
 
@@ -1225,6 +1345,28 @@ void Shell::OnAnimatorNotifyIdle(fml::TimeDelta deadline) {
     engine_->NotifyIdle(deadline);
     volatile_path_tracker_->OnFrame();
   }
+
+  if (resident_memory_monitor_ &&
+      resident_memory_monitor_->Sample(fml::TimePoint::Now())) {
+    NotifyLowMemoryWarning();
+  }
+
+  // The idle tasks of the rasterizer decide which of them fit in the time
+  // left, which is only a few milliseconds after a frame and longer once no
+  // frame has been scheduled for a few vsyncs.
+  static constexpr fml::TimeDelta kMinRasterizerIdleTime =
+      fml::TimeDelta::FromMilliseconds(1);
+  auto now = fml::TimeDelta::FromMicroseconds(Dart_TimelineGetMicros());
+  if (deadline - now >= kMinRasterizerIdleTime) {
+    // The deadline is on the clock of the Dart timeline.
+    auto rasterizer_deadline = fml::TimePoint::Now() + (deadline - now);
+    task_runners_.GetRasterTaskRunner()->PostTask(
+        [rasterizer = rasterizer_->GetWeakPtr(), rasterizer_deadline]() {
+          if (rasterizer) {
+            rasterizer->NotifyIdle(rasterizer_deadline);
+          }
+        });
+  }
 }
 
 void Shell::OnAnimatorUpdateLatestFrameTargetTime(
@@ -1246,23 +1388,42 @@ void Shell::OnAnimatorUpdateLatestFrameTargetTime(
 void Shell::OnAnimatorDraw(std::shared_ptr<FramePipeline> pipeline) {
   FML_DCHECK(is_set_up_);
 
-  task_runners_.GetRasterTaskRunner()->PostTask(fml::MakeCopyable(
-      [&waiting_for_first_frame = waiting_for_first_frame_,
-       &waiting_for_first_frame_condition = waiting_for_first_frame_condition_,
-       rasterizer = rasterizer_->GetWeakPtr(),
-       weak_pipeline = std::weak_ptr<FramePipeline>(pipeline)]() mutable {
-        if (rasterizer) {
-          std::shared_ptr<FramePipeline> pipeline = weak_pipeline.lock();
-          if (pipeline) {
-            rasterizer->Draw(pipeline);
-          }
-
-          if (waiting_for_first_frame.load()) {
-            waiting_for_first_frame.store(false);
-            waiting_for_first_frame_condition.notify_all();
-          }
-        }
-      }));
+  task_runners_.GetRasterTaskRunner()->PostTaskWithGrade(
+      fml::MakeCopyable(
+          [&waiting_for_first_frame = waiting_for_first_frame_,
+           &waiting_for_first_frame_condition =
+               waiting_for_first_frame_condition_,
+           &startup_timeline = startup_timeline_,
+           rasterizer = rasterizer_->GetWeakPtr(),
+           weak_pipeline = std::weak_ptr<FramePipeline>(pipeline),
+           io_task_runner = task_runners_.GetIOTaskRunner(),
+           vm_data = vm_->GetVMData(),
+           page_profile_path = settings_.snapshot_page_profile_path]() mutable {
+            if (rasterizer) {
+              std::shared_ptr<FramePipeline> pipeline = weak_pipeline.lock();
+              if (pipeline) {
+                rasterizer->Draw(pipeline);
+              }
+
+              if (startup_timeline.RecordPhase(
+                      StartupTimeline::Phase::kFirstFrame) &&
+                  !page_profile_path.empty() &&
+                  DartVM::IsRunningPrecompiledCode()) {
+                // Record the snapshot pages the startup needed, so that the
+                // next startup can prefetch them.
+                io_task_runner->PostTask([vm_data, page_profile_path]() {
+                  RecordSnapshotPageProfile(vm_data->GetVMSnapshot(),
+                                            *vm_data->GetIsolateSnapshot(),
+                                            page_profile_path);
+                });
+              }
+              if (waiting_for_first_frame.load()) {
+                waiting_for_first_frame.store(false);
+                waiting_for_first_frame_condition.notify_all();
+              }
+            }
+          }),
+      fml::TaskSourceGrade::kUserInteraction);
 }
 
 // |Animator::Delegate|
@@ -1290,6 +1451,7 @@ void Shell::OnEngineUpdateSemantics(SemanticsNodeUpdates update,
   task_runners_.GetPlatformTaskRunner()->PostTask(
       [view = platform_view_->GetWeakPtr(), update = std::move(update),
        actions = std::move(actions)] {
+        FML_ALLOCATION_TAG(kSemantics);
         if (view) {
           view->UpdateSemantics(update, actions);
         }
@@ -1300,6 +1462,7 @@ void Shell::OnEngineUpdateSemantics(SemanticsNodeUpdates update,
 void Shell::OnEngineHandlePlatformMessage(
     std::unique_ptr<PlatformMessage> message) {
   FML_DCHECK(is_set_up_);
+  FML_ALLOCATION_TAG(kPlatformMessages);
   FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
 
   if (message->channel() == kSkiaChannel) {
@@ -1546,6 +1709,22 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  if (jank_capture_) {
+    CaptureJank(timing);
+  }
+
+  UpdateMemoryUsage(timing);
+
+  if (settings_.enable_deadline_aware_frame_scheduling ||
+      settings_.enable_workload_thread_affinity) {
+    task_runners_.GetUITaskRunner()->PostTask(
+        [timing, engine = weak_engine_] {
+          if (engine) {
+            engine->OnFrameRasterized(timing);
+          }
+        });
+  }
+
   if (!needs_report_timings_) {
     return;
   }
@@ -1560,6 +1739,9 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
   unreported_timings_.push_back(timing.GetLayerCacheBytes());
   unreported_timings_.push_back(timing.GetPictureCacheCount());
   unreported_timings_.push_back(timing.GetPictureCacheBytes());
+  unreported_timings_.push_back(timing.GetComplexity().layer_count);
+  unreported_timings_.push_back(timing.GetComplexity().display_list_op_count);
+  unreported_timings_.push_back(timing.GetComplexity().offscreen_pass_count);
   unreported_timings_.push_back(timing.GetFrameNumber());
   FML_DCHECK(unreported_timings_.size() ==
              old_count + FrameTiming::kStatisticsCount);
@@ -1604,6 +1786,73 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
   }
 }
 
+void Shell::CaptureJank(const FrameTiming& timing) {
+  const auto frame_budget =
+      fml::TimeDelta::FromMillisecondsF(GetFrameBudget().count());
+  if (!jank_capture_->RecordFrameRasterized(timing, frame_budget) ||
+      !rasterizer_) {
+    return;
+  }
+
+  TRACE_EVENT0("flutter", "Shell::CaptureJank");
+  auto capture = std::make_shared<fml::DataMapping>(
+      jank_capture_->Capture(rasterizer_->GetJankCaptureStats()));
+  auto file_name = "jank_frame_" + std::to_string(timing.GetFrameNumber()) +
+                   ".perfetto-trace";
+  task_runners_.GetIOTaskRunner()->PostTask(
+      [path = settings_.jank_capture_path, file_name, capture,
+       callback = settings_.jank_capture_callback]() {
+        auto directory = fml::OpenDirectory(path.c_str(), true,
+                                            fml::FilePermission::kReadWrite);
+        if (!directory.is_valid() ||
+            !fml::WriteAtomically(directory, file_name.c_str(), *capture)) {
+          FML_LOG(ERROR) << "Could not write the jank capture to " << path
+                         << ".";
+          return;
+        }
+        if (callback) {
+          callback(fml::paths::JoinPaths({path, file_name}));
+        }
+      });
+}
+
+MemoryUsage Shell::ComputeMemoryUsage() const {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  MemoryUsage usage;
+  if (rasterizer_) {
+    usage = rasterizer_->GetMemoryUsage();
+  }
+  if (image_texture_bytes_callback_) {
+    usage.image_texture_bytes = image_texture_bytes_callback_();
+  }
+  return usage;
+}
+
+void Shell::UpdateMemoryUsage(const FrameTiming& timing) {
+  constexpr fml::TimeDelta kUpdateInterval = fml::TimeDelta::FromSeconds(1);
+  const auto now = timing.Get(FrameTiming::kRasterFinish);
+  if (last_memory_usage_time_ != fml::TimePoint() &&
+      now - last_memory_usage_time_ < kUpdateInterval) {
+    return;
+  }
+  last_memory_usage_time_ = now;
+
+  auto usage = ComputeMemoryUsage();
+  {
+    std::scoped_lock lock(memory_usage_mutex_);
+    last_memory_usage_ = usage;
+  }
+  usage.ForEach([id = reinterpret_cast<int64_t>(this)](const char* name,
+                                                       size_t value) {
+    FML_TRACE_COUNTER("flutter", "EngineMemoryUsage", id, name, value);
+  });
+}
+
+MemoryUsage Shell::GetLastMemoryUsage() const {
+  std::scoped_lock lock(memory_usage_mutex_);
+  return last_memory_usage_;
+}
+
 fml::Milliseconds Shell::GetFrameBudget() {
   double display_refresh_rate = display_manager_->GetMainDisplayRefreshRate();
   if (display_refresh_rate > 0) {
@@ -1887,6 +2136,74 @@ bool Shell::OnServiceProtocolGetSkSLs(
   return true;
 }
 
+bool Shell::OnServiceProtocolGetImpellerPipelineVariants(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  response->SetObject();
+  response->AddMember("type", "GetImpellerPipelineVariants",
+                      response->GetAllocator());
+  std::string variants =
+      rasterizer_ ? rasterizer_->GetImpellerPipelineVariants() : "";
+  rapidjson::Value variants_value(variants.c_str(), response->GetAllocator());
+  response->AddMember("variants", variants_value, response->GetAllocator());
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetImpellerGPUTimeByCategory(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  response->SetObject();
+  response->AddMember("type", "ImpellerGPUTimeByCategory",
+                      response->GetAllocator());
+  rapidjson::Value categories(rapidjson::kObjectType);
+  if (rasterizer_) {
+    for (const auto& [name, time] :
+         rasterizer_->GetImpellerGPUTimeByCategory()) {
+      rapidjson::Value name_value(name.c_str(), response->GetAllocator());
+      categories.AddMember(name_value, time.ToMillisecondsF(),
+                           response->GetAllocator());
+    }
+  }
+  response->AddMember("categoriesMS", categories, response->GetAllocator());
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetTraceRingBuffer(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  auto trace = fml::tracing::TraceRingBuffer::SerializeAsPerfettoTrace(
+      fml::tracing::TraceRingBuffer::GetEvents());
+  size_t b64_size = Base64::EncodedSize(trace.size());
+  std::string b64_trace(b64_size, '\0');
+  Base64::Encode(trace.data(), trace.size(), b64_trace.data());
+  response->SetObject();
+  response->AddMember("type", "TraceRingBuffer", response->GetAllocator());
+  response->AddMember("enabled", fml::tracing::TraceRingBuffer::IsEnabled(),
+                      response->GetAllocator());
+  response->AddMember("trace",
+                      rapidjson::Value(b64_trace.c_str(), b64_trace.size(),
+                                       response->GetAllocator()),
+                      response->GetAllocator());
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetEngineMemoryUsage(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  response->SetObject();
+  response->AddMember("type", "EngineMemoryUsage", response->GetAllocator());
+  ComputeMemoryUsage().ForEach([response](const char* name, size_t value) {
+    response->AddMember(rapidjson::StringRef(name),
+                        static_cast<uint64_t>(value),
+                        response->GetAllocator());
+  });
+  return true;
+}
+
 bool Shell::OnServiceProtocolEstimateRasterCacheMemory(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
     rapidjson::Document* response) {
@@ -2192,6 +2509,10 @@ fml::Status Shell::WaitForFirstFrame(fml::TimeDelta timeout) {
   }
 }
 
+const StartupTimeline& Shell::GetStartupTimeline() const {
+  return startup_timeline_;
+}
+
 bool Shell::ReloadSystemFonts() {
   FML_DCHECK(is_set_up_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
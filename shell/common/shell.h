@@ -36,10 +36,14 @@
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/display_manager.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/jank_capture.h"
+#include "flutter/shell/common/memory_usage.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
+#include "flutter/shell/common/resident_memory_monitor.h"
 #include "flutter/shell/common/resource_cache_limit_calculator.h"
 #include "flutter/shell/common/shell_io_manager.h"
+#include "flutter/shell/common/startup_timeline.h"
 #include "impeller/runtime_stage/runtime_stage.h"
 
 namespace flutter {
@@ -286,8 +290,9 @@ class Shell final : public PlatformView::Delegate,
 
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to notify that there is a low memory
-  ///             warning. The shell will attempt to purge caches. Current, only
-  ///             the rasterizer cache is purged.
+  ///             warning. The shell will attempt to purge caches. Currently,
+  ///             the rasterizer cache and the textures of the decoded images
+  ///             that can be decoded again are purged.
   void NotifyLowMemoryWarning() const;
 
   //----------------------------------------------------------------------------
@@ -361,6 +366,27 @@ class Shell final : public PlatformView::Delegate,
   ///
   fml::Status WaitForFirstFrame(fml::TimeDelta timeout);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Used by embedders and benchmarks to get the time at which each
+  ///             phase of the startup of this shell completed. Shells created
+  ///             with |Spawn| don't record the phases that precede the
+  ///             creation of their platform view.
+  ///
+  /// @return     The startup timeline of this shell.
+  ///
+  const StartupTimeline& GetStartupTimeline() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Used by embedders to get the memory held by the subsystems
+  ///             of the engine. This is a snapshot updated at most once per
+  ///             second as frames are rasterized, so it may be called from
+  ///             any thread without waiting on the raster thread.
+  ///
+  /// @return     The memory usage as of the last snapshot, which is empty
+  ///             until the first frame is rasterized.
+  ///
+  MemoryUsage GetLastMemoryUsage() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to reload the system fonts in
   ///             FontCollection.
@@ -503,6 +529,7 @@ class Shell final : public PlatformView::Delegate,
 
   bool first_frame_rasterized_ = false;
   std::atomic<bool> waiting_for_first_frame_ = true;
+  StartupTimeline startup_timeline_;
   std::mutex waiting_for_first_frame_mutex_;
   std::condition_variable waiting_for_first_frame_condition_;
 
@@ -519,6 +546,25 @@ class Shell final : public PlatformView::Delegate,
   // stored here for easier conversions to Dart objects.
   std::vector<int64_t> unreported_timings_;
 
+  // Decides which frames are written to |Settings::jank_capture_path|. Only
+  // accessed on the raster thread. Null if jank capture is disabled.
+  std::unique_ptr<JankCapture> jank_capture_;
+
+  // Raises low memory warnings when the resident memory crosses
+  // |Settings::resident_memory_warning_bytes|. Only accessed on the UI
+  // thread. Null if disabled.
+  std::unique_ptr<ResidentMemoryMonitor> resident_memory_monitor_;
+
+  // Reports the bytes of the purgeable image textures. Set up with the
+  // engine, and called on the raster thread.
+  std::function<size_t()> image_texture_bytes_callback_;
+
+  // Written on the raster thread, and read by |GetLastMemoryUsage| from any
+  // thread.
+  mutable std::mutex memory_usage_mutex_;
+  MemoryUsage last_memory_usage_;
+  fml::TimePoint last_memory_usage_time_;
+
   /// Manages the displays. This class is thread safe, can be accessed from
   /// any of the threads.
   std::unique_ptr<DisplayManager> display_manager_;
@@ -583,6 +629,18 @@ class Shell final : public PlatformView::Delegate,
 
   void ReportTimings();
 
+  // Writes a jank capture to |Settings::jank_capture_path| if the frame took
+  // longer than the jank capture threshold.
+  void CaptureJank(const FrameTiming& timing);
+
+  // Returns the memory usage of the rasterizer and of the image decoder.
+  // Must be called on the raster thread.
+  MemoryUsage ComputeMemoryUsage() const;
+
+  // Updates the snapshot returned by |GetLastMemoryUsage| and emits it as
+  // trace counters, at most once per second.
+  void UpdateMemoryUsage(const FrameTiming& timing);
+
   // |PlatformView::Delegate|
   void OnPlatformViewCreated(std::unique_ptr<Surface> surface) override;
 
@@ -771,6 +829,36 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // The returned pipeline variants can be bundled with the application as the
+  // |PersistentCache::kImpellerPipelineVariantsAssetFileName| asset.
+  bool OnServiceProtocolGetImpellerPipelineVariants(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Reports the GPU time of a recent frame spent on each category of draws,
+  // such as text or blurs, in milliseconds.
+  bool OnServiceProtocolGetImpellerGPUTimeByCategory(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the trace ring buffer as a base64 encoded Perfetto trace.
+  bool OnServiceProtocolGetTraceRingBuffer(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Reports the memory held by the subsystems of the engine, in bytes.
+  bool OnServiceProtocolGetEngineMemoryUsage(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Service protocol handler
   bool OnServiceProtocolEstimateRasterCacheMemory(
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
@@ -4,7 +4,10 @@
 
 #include "flutter/shell/common/shell.h"
 
+#include <array>
+
 #include "flutter/benchmarking/benchmarking.h"
+#include "flutter/common/constants.h"
 #include "flutter/fml/logging.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/thread_host.h"
@@ -13,6 +16,28 @@
 
 namespace flutter {
 
+static Settings CreateSettings(const fml::UniqueFD& assets_dir,
+                               testing::ELFAOTSymbols& aot_symbols) {
+  Settings settings = {};
+  settings.task_observer_add = [](intptr_t, const fml::closure&) {};
+  settings.task_observer_remove = [](intptr_t) {};
+
+  if (DartVM::IsRunningPrecompiledCode()) {
+    aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary(
+        testing::kDefaultAOTAppELFFileName);
+    FML_CHECK(testing::PrepareSettingsForAOTWithSymbols(settings, aot_symbols))
+        << "Could not set up settings with AOT symbols.";
+  } else {
+    settings.application_kernels = [&assets_dir]() {
+      std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
+      kernel_mappings.emplace_back(
+          fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
+      return kernel_mappings;
+    };
+  }
+  return settings;
+}
+
 static void StartupAndShutdownShell(benchmark::State& state,
                                     bool measure_startup,
                                     bool measure_shutdown) {
@@ -24,24 +49,7 @@ static void StartupAndShutdownShell(benchmark::State& state,
 
   {
     benchmarking::ScopedPauseTiming pause(state, !measure_startup);
-    Settings settings = {};
-    settings.task_observer_add = [](intptr_t, const fml::closure&) {};
-    settings.task_observer_remove = [](intptr_t) {};
-
-    if (DartVM::IsRunningPrecompiledCode()) {
-      aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary(
-          testing::kDefaultAOTAppELFFileName);
-      FML_CHECK(
-          testing::PrepareSettingsForAOTWithSymbols(settings, aot_symbols))
-          << "Could not set up settings with AOT symbols.";
-    } else {
-      settings.application_kernels = [&]() {
-        std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
-        kernel_mappings.emplace_back(
-            fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
-        return kernel_mappings;
-      };
-    }
+    Settings settings = CreateSettings(assets_dir, aot_symbols);
 
     thread_host = std::make_unique<ThreadHost>(ThreadHost::ThreadHostConfig(
         "io.flutter.bench.",
@@ -120,4 +128,158 @@ static void BM_ShellInitializationAndShutdown(benchmark::State& state) {
 
 BENCHMARK(BM_ShellInitializationAndShutdown);
 
+// Measures the time from |Shell::Create| to the first rasterized frame. The
+// time of each startup phase since the call to |Shell::Create| is reported as
+// a counter, in microseconds.
+static void BM_ShellStartupToFirstFrame(benchmark::State& state) {
+  auto assets_dir = fml::OpenDirectory(testing::GetFixturesPath(), false,
+                                       fml::FilePermission::kRead);
+  testing::ELFAOTSymbols aot_symbols;
+  Settings settings = CreateSettings(assets_dir, aot_symbols);
+
+  std::array<double, StartupTimeline::kPhaseCount> phase_micros = {};
+  while (state.KeepRunning()) {
+    std::unique_ptr<ThreadHost> thread_host;
+    {
+      benchmarking::ScopedPauseTiming pause(state);
+      thread_host = std::make_unique<ThreadHost>(ThreadHost::ThreadHostConfig(
+          "io.flutter.bench.",
+          ThreadHost::Type::kPlatform | ThreadHost::Type::kRaster |
+              ThreadHost::Type::kIo | ThreadHost::Type::kUi));
+    }
+    TaskRunners task_runners("test",
+                             thread_host->platform_thread->GetTaskRunner(),
+                             thread_host->raster_thread->GetTaskRunner(),
+                             thread_host->ui_thread->GetTaskRunner(),
+                             thread_host->io_thread->GetTaskRunner());
+    auto platform_task_runner = task_runners.GetPlatformTaskRunner();
+
+    std::unique_ptr<Shell> shell = Shell::Create(
+        flutter::PlatformData(), task_runners, settings,
+        [](Shell& shell) {
+          return std::make_unique<PlatformView>(shell, shell.GetTaskRunners());
+        },
+        [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+    FML_CHECK(shell);
+
+    fml::AutoResetWaitableEvent run_latch;
+    fml::TaskRunner::RunNowOrPostTask(platform_task_runner, [&]() {
+      shell->GetPlatformView()->SetViewportMetrics(
+          kFlutterImplicitViewId, ViewportMetrics{1, 100, 100, 0, 0});
+      auto configuration = RunConfiguration::InferFromSettings(settings);
+      configuration.SetEntrypoint("drawFirstFrame");
+      shell->RunEngine(std::move(configuration));
+      run_latch.Signal();
+    });
+    run_latch.Wait();
+    FML_CHECK(shell->WaitForFirstFrame(fml::TimeDelta::FromSeconds(10)).ok())
+        << "The first frame was not rasterized.";
+
+    benchmarking::ScopedPauseTiming pause(state);
+    const StartupTimeline& timeline = shell->GetStartupTimeline();
+    auto start = timeline.GetPhaseTime(StartupTimeline::Phase::kShellCreate);
+    for (size_t i = 0; i < StartupTimeline::kPhaseCount; i++) {
+      auto time = timeline.GetPhaseTime(static_cast<StartupTimeline::Phase>(i));
+      if (time.has_value()) {
+        phase_micros[i] += (time.value() - start.value()).ToMicrosecondsF();
+      }
+    }
+
+    fml::AutoResetWaitableEvent shutdown_latch;
+    fml::TaskRunner::RunNowOrPostTask(platform_task_runner, [&]() {
+      shell.reset();
+      shutdown_latch.Signal();
+    });
+    shutdown_latch.Wait();
+    thread_host.reset();
+  }
+
+  for (size_t i = 0; i < StartupTimeline::kPhaseCount; i++) {
+    state.counters[StartupTimeline::GetPhaseName(
+        static_cast<StartupTimeline::Phase>(i))] =
+        benchmark::Counter(phase_micros[i], benchmark::Counter::kAvgIterations);
+  }
+}
+
+BENCHMARK(BM_ShellStartupToFirstFrame)->Unit(benchmark::kMillisecond);
+
+// Measures the time to spawn a shell from a running shell, up to the launch of
+// the spawned root isolate. The shutdown of the spawned shell is not measured.
+static void BM_ShellSpawn(benchmark::State& state) {
+  auto assets_dir = fml::OpenDirectory(testing::GetFixturesPath(), false,
+                                       fml::FilePermission::kRead);
+  testing::ELFAOTSymbols aot_symbols;
+  Settings settings = CreateSettings(assets_dir, aot_symbols);
+
+  auto thread_host = std::make_unique<ThreadHost>(ThreadHost::ThreadHostConfig(
+      "io.flutter.bench.", ThreadHost::Type::kPlatform |
+                               ThreadHost::Type::kRaster |
+                               ThreadHost::Type::kIo | ThreadHost::Type::kUi));
+  TaskRunners task_runners("test",
+                           thread_host->platform_thread->GetTaskRunner(),
+                           thread_host->raster_thread->GetTaskRunner(),
+                           thread_host->ui_thread->GetTaskRunner(),
+                           thread_host->io_thread->GetTaskRunner());
+  auto platform_task_runner = task_runners.GetPlatformTaskRunner();
+  auto ui_task_runner = task_runners.GetUITaskRunner();
+
+  auto on_create_platform_view = [](Shell& shell) {
+    return std::make_unique<PlatformView>(shell, shell.GetTaskRunners());
+  };
+  auto on_create_rasterizer = [](Shell& shell) {
+    return std::make_unique<Rasterizer>(shell);
+  };
+
+  // Spawning requires a running root isolate in the spawner.
+  std::unique_ptr<Shell> shell;
+  fml::AutoResetWaitableEvent run_latch;
+  fml::TaskRunner::RunNowOrPostTask(platform_task_runner, [&]() {
+    shell = Shell::Create(flutter::PlatformData(), task_runners, settings,
+                          on_create_platform_view, on_create_rasterizer);
+    FML_CHECK(shell);
+    shell->RunEngine(RunConfiguration::InferFromSettings(settings),
+                     [&run_latch](Engine::RunStatus status) {
+                       FML_CHECK(status == Engine::RunStatus::Success);
+                       run_latch.Signal();
+                     });
+  });
+  run_latch.Wait();
+
+  while (state.KeepRunning()) {
+    std::unique_ptr<Shell> spawn;
+    fml::AutoResetWaitableEvent spawn_latch;
+    fml::TaskRunner::RunNowOrPostTask(platform_task_runner, [&]() {
+      spawn = shell->Spawn(RunConfiguration::InferFromSettings(settings),
+                           /*initial_route=*/"", on_create_platform_view,
+                           on_create_rasterizer);
+      spawn_latch.Signal();
+    });
+    spawn_latch.Wait();
+    FML_CHECK(spawn);
+
+    // Wait for the spawned root isolate to be launched on the ui thread.
+    fml::AutoResetWaitableEvent ui_latch;
+    ui_task_runner->PostTask([&ui_latch]() { ui_latch.Signal(); });
+    ui_latch.Wait();
+
+    benchmarking::ScopedPauseTiming pause(state, true);
+    fml::AutoResetWaitableEvent shutdown_latch;
+    fml::TaskRunner::RunNowOrPostTask(platform_task_runner, [&]() {
+      spawn.reset();
+      shutdown_latch.Signal();
+    });
+    shutdown_latch.Wait();
+  }
+
+  fml::AutoResetWaitableEvent shutdown_latch;
+  fml::TaskRunner::RunNowOrPostTask(platform_task_runner, [&]() {
+    shell.reset();
+    shutdown_latch.Signal();
+  });
+  shutdown_latch.Wait();
+  thread_host.reset();
+}
+
+BENCHMARK(BM_ShellSpawn);
+
 }  // namespace flutter
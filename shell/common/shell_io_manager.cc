@@ -92,6 +92,23 @@ void ShellIOManager::UpdateResourceContext(
   unref_queue_->UpdateResourceContext(resource_context_);
 }
 
+void ShellIOManager::SetUploadContextPool(
+    std::unique_ptr<ResourceUploadContextPool> upload_context_pool,
+    const PlatformView* owner) {
+  upload_context_pool_ = std::move(upload_context_pool);
+  upload_context_pool_owner_ = upload_context_pool_ ? owner : nullptr;
+}
+
+void ShellIOManager::ResetUploadContextPool(const PlatformView* owner) {
+  if (upload_context_pool_ && upload_context_pool_owner_ == owner) {
+    SetUploadContextPool(nullptr, nullptr);
+  }
+}
+
+bool ShellIOManager::HasUploadContextPool() const {
+  return !!upload_context_pool_;
+}
+
 fml::WeakPtr<ShellIOManager> ShellIOManager::GetWeakPtr() {
   return weak_factory_.GetWeakPtr();
 }
@@ -124,4 +141,12 @@ std::shared_ptr<impeller::Context> ShellIOManager::GetImpellerContext() const {
   return impeller_context_;
 }
 
+// |IOManager|
+bool ShellIOManager::PostConcurrentUploadTask(UploadTask task) {
+  if (!upload_context_pool_) {
+    return false;
+  }
+  return upload_context_pool_->PostTask(std::move(task));
+}
+
 }  // namespace flutter
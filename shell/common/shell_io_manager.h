@@ -11,6 +11,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/lib/ui/io_manager.h"
+#include "flutter/shell/common/resource_upload_context_pool.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/skia/include/gpu/GrTypes.h"
 
@@ -18,6 +19,8 @@ struct GrGLInterface;
 
 namespace flutter {
 
+class PlatformView;
+
 class ShellIOManager final : public IOManager {
  public:
   // Convenience methods for platforms to create a GrDirectContext used to
@@ -48,6 +51,20 @@ class ShellIOManager final : public IOManager {
   // resource context, but may be called if the Dart VM is restarted.
   void UpdateResourceContext(sk_sp<GrDirectContext> resource_context);
 
+  // Sets the threads that upload resources in parallel to the IO thread, with
+  // resource contexts of their own created by |owner|. Must be called on the
+  // IO thread.
+  void SetUploadContextPool(
+      std::unique_ptr<ResourceUploadContextPool> upload_context_pool,
+      const PlatformView* owner);
+
+  // Collects the upload threads if their contexts were created by |owner|.
+  // This must be called before the owner is collected, as the IO manager may
+  // be shared with the shells spawned from its shell.
+  void ResetUploadContextPool(const PlatformView* owner);
+
+  bool HasUploadContextPool() const;
+
   fml::WeakPtr<ShellIOManager> GetWeakPtr();
 
   // |IOManager|
@@ -65,6 +82,9 @@ class ShellIOManager final : public IOManager {
   // |IOManager|
   std::shared_ptr<impeller::Context> GetImpellerContext() const override;
 
+  // |IOManager|
+  bool PostConcurrentUploadTask(UploadTask task) override;
+
  private:
   // Resource context management.
   sk_sp<GrDirectContext> resource_context_;
@@ -74,6 +94,8 @@ class ShellIOManager final : public IOManager {
   fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue_;
   std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch_;
   std::shared_ptr<impeller::Context> impeller_context_;
+  std::unique_ptr<ResourceUploadContextPool> upload_context_pool_;
+  const PlatformView* upload_context_pool_owner_ = nullptr;
   fml::WeakPtrFactory<ShellIOManager> weak_factory_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ShellIOManager);
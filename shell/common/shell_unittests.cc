@@ -3678,6 +3678,65 @@ TEST_F(ShellTest, UpdateAssetResolverByTypeDoesNotReplaceMismatchType) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+namespace {
+class CountingAssetResolver : public AssetResolver {
+ public:
+  explicit CountingAssetResolver(std::string asset_name)
+      : asset_name_(std::move(asset_name)) {}
+
+  bool IsValid() const override { return true; }
+
+  bool IsValidAfterAssetManagerChange() const override { return true; }
+
+  AssetResolver::AssetResolverType GetType() const override {
+    return AssetResolverType::kApkAssetProvider;
+  }
+
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override {
+    lookup_count++;
+    if (asset_name != asset_name_) {
+      return nullptr;
+    }
+    return std::make_unique<fml::DataMapping>(asset_name_);
+  }
+
+  mutable size_t lookup_count = 0;
+
+ private:
+  std::string asset_name_;
+};
+}  // namespace
+
+TEST_F(ShellTest, AssetManagerIndexesLookups) {
+  AssetManager asset_manager;
+  auto first = std::make_unique<CountingAssetResolver>("first");
+  auto second = std::make_unique<CountingAssetResolver>("second");
+  auto* first_ptr = first.get();
+  auto* second_ptr = second.get();
+  asset_manager.PushBack(std::move(first));
+  asset_manager.PushBack(std::move(second));
+
+  ASSERT_NE(asset_manager.GetAsMapping("second"), nullptr);
+  ASSERT_EQ(first_ptr->lookup_count, 1u);
+  ASSERT_EQ(second_ptr->lookup_count, 1u);
+
+  // Indexed assets only probe the resolver that provided them.
+  ASSERT_NE(asset_manager.GetAsMapping("second"), nullptr);
+  ASSERT_EQ(first_ptr->lookup_count, 1u);
+  ASSERT_EQ(second_ptr->lookup_count, 2u);
+
+  // Missing assets don't probe any resolver once indexed.
+  ASSERT_EQ(asset_manager.GetAsMapping("missing"), nullptr);
+  ASSERT_EQ(asset_manager.GetAsMapping("missing"), nullptr);
+  ASSERT_EQ(first_ptr->lookup_count, 2u);
+  ASSERT_EQ(second_ptr->lookup_count, 3u);
+
+  // Adding a resolver clears the index.
+  asset_manager.PushFront(std::make_unique<CountingAssetResolver>("missing"));
+  ASSERT_NE(asset_manager.GetAsMapping("missing"), nullptr);
+}
+
 TEST_F(ShellTest, CanCreateShellsWithGLBackend) {
 #if !SHELL_ENABLE_GL
   // GL emulation does not exist on Fuchsia.
@@ -3783,6 +3842,35 @@ TEST_F(ShellTest, UserTagSetOnStartup) {
   isolate_create_latch.Wait();
 }
 
+TEST_F(ShellTest, StartupTimelineRecordsPhases) {
+  auto settings = CreateSettingsForFixture();
+  auto shell = CreateShell(settings);
+  ASSERT_TRUE(shell);
+
+  // Wait for the default font manager to be set up on the UI thread.
+  PostSync(shell->GetTaskRunners().GetUITaskRunner(), [] {});
+
+  using Phase = StartupTimeline::Phase;
+  const StartupTimeline& timeline = shell->GetStartupTimeline();
+  auto time = [&timeline](Phase phase) {
+    auto result = timeline.GetPhaseTime(phase);
+    EXPECT_TRUE(result.has_value()) << StartupTimeline::GetPhaseName(phase);
+    return result.value_or(fml::TimePoint());
+  };
+  EXPECT_LE(time(Phase::kShellCreate), time(Phase::kInitializationTasks));
+  EXPECT_LE(time(Phase::kInitializationTasks), time(Phase::kDartVM));
+  EXPECT_LE(time(Phase::kDartVM), time(Phase::kPlatformView));
+  EXPECT_LE(time(Phase::kPlatformView), time(Phase::kRasterizer));
+  EXPECT_LE(time(Phase::kPlatformView), time(Phase::kIOManager));
+  EXPECT_LE(time(Phase::kRasterizer), time(Phase::kEngine));
+  EXPECT_LE(time(Phase::kIOManager), time(Phase::kEngine));
+  EXPECT_LE(time(Phase::kEngine), time(Phase::kShellSetup));
+  EXPECT_LE(time(Phase::kShellSetup), time(Phase::kDefaultFontManager));
+  EXPECT_FALSE(timeline.GetPhaseTime(Phase::kFirstFrame).has_value());
+
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, PrefetchDefaultFontManager) {
   auto settings = CreateSettingsForFixture();
   settings.prefetched_default_font_manager = true;
@@ -3824,6 +3912,38 @@ TEST_F(ShellTest, PrefetchDefaultFontManager) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, ConcurrentStartupSetsDefaultFontManagerWhenRun) {
+  auto settings = CreateSettingsForFixture();
+  settings.enable_concurrent_startup = true;
+  std::unique_ptr<Shell> shell;
+
+  auto get_font_manager_count = [&] {
+    fml::AutoResetWaitableEvent latch;
+    size_t font_manager_count;
+    fml::TaskRunner::RunNowOrPostTask(
+        shell->GetTaskRunners().GetUITaskRunner(),
+        [this, &shell, &latch, &font_manager_count]() {
+          font_manager_count =
+              GetFontCollection(shell.get())->GetFontManagersCount();
+          latch.Signal();
+        });
+    latch.Wait();
+    return font_manager_count;
+  };
+
+  shell = CreateShell(settings);
+  size_t initial_font_manager_count = get_font_manager_count();
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+
+  // The default font manager created on a worker is set when the engine runs.
+  ASSERT_EQ(get_font_manager_count(), initial_font_manager_count + 1);
+
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, OnPlatformViewCreatedWhenUIThreadIsBusy) {
   // This test will deadlock if the threading logic in
   // Shell::OnCreatePlatformView is wrong.
@@ -34,9 +34,6 @@ sk_sp<DlImage> SnapshotControllerImpeller::DoMakeRasterSnapshot(
     const sk_sp<DisplayList>& display_list,
     SkISize size) {
   TRACE_EVENT0("flutter", __FUNCTION__);
-  impeller::DlDispatcher dispatcher;
-  display_list->Dispatch(dispatcher);
-  impeller::Picture picture = dispatcher.EndRecordingAsPicture();
   auto context = GetDelegate().GetAiksContext();
   if (context) {
     auto max_size = context->GetContext()
@@ -59,6 +56,18 @@ sk_sp<DlImage> SnapshotControllerImpeller::DoMakeRasterSnapshot(
       render_target_size.height *= scale_factor;
     }
 
+    impeller::DlDispatcher dispatcher;
+    // Scale the picture along with the render target so that all of it is
+    // in the snapshot rather than just the part that fits in the target.
+    if (scale_factor < 1.0) {
+      dispatcher.scale(scale_factor, scale_factor);
+    }
+    // Only the ops that intersect the snapshot are recorded, which keeps the
+    // snapshots of small parts of large pictures cheap.
+    display_list->Dispatch(dispatcher,
+                           SkRect::MakeWH(size.width(), size.height()));
+    impeller::Picture picture = dispatcher.EndRecordingAsPicture();
+
     std::shared_ptr<impeller::Image> image =
         picture.ToImage(*context, render_target_size);
     if (image) {
@@ -0,0 +1,76 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/startup_timeline.h"
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+StartupTimeline::StartupTimeline() = default;
+
+StartupTimeline::~StartupTimeline() = default;
+
+bool StartupTimeline::RecordPhase(Phase phase) {
+  {
+    std::scoped_lock lock(mutex_);
+    auto& phase_time = phase_times_[static_cast<size_t>(phase)];
+    if (phase_time.has_value()) {
+      return false;
+    }
+    phase_time = fml::TimePoint::Now();
+  }
+  TRACE_EVENT_INSTANT1("flutter", "StartupTimeline", "phase",
+                       GetPhaseName(phase));
+  return true;
+}
+
+void StartupTimeline::Merge(const StartupTimeline& other) {
+  std::array<std::optional<fml::TimePoint>, kPhaseCount> other_phase_times;
+  {
+    std::scoped_lock lock(other.mutex_);
+    other_phase_times = other.phase_times_;
+  }
+  std::scoped_lock lock(mutex_);
+  for (size_t i = 0; i < kPhaseCount; i++) {
+    if (!phase_times_[i].has_value()) {
+      phase_times_[i] = other_phase_times[i];
+    }
+  }
+}
+
+std::optional<fml::TimePoint> StartupTimeline::GetPhaseTime(
+    Phase phase) const {
+  std::scoped_lock lock(mutex_);
+  return phase_times_[static_cast<size_t>(phase)];
+}
+
+const char* StartupTimeline::GetPhaseName(Phase phase) {
+  switch (phase) {
+    case Phase::kShellCreate:
+      return "ShellCreate";
+    case Phase::kInitializationTasks:
+      return "InitializationTasks";
+    case Phase::kDartVM:
+      return "DartVM";
+    case Phase::kPlatformView:
+      return "PlatformView";
+    case Phase::kRasterizer:
+      return "Rasterizer";
+    case Phase::kIOManager:
+      return "IOManager";
+    case Phase::kEngine:
+      return "Engine";
+    case Phase::kShellSetup:
+      return "ShellSetup";
+    case Phase::kDefaultFontManager:
+      return "DefaultFontManager";
+    case Phase::kFirstFrame:
+      return "FirstFrame";
+  }
+  FML_UNREACHABLE();
+}
+
+}  // namespace flutter
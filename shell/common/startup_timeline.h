@@ -0,0 +1,95 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_STARTUP_TIMELINE_H_
+#define FLUTTER_SHELL_COMMON_STARTUP_TIMELINE_H_
+
+#include <array>
+#include <mutex>
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      The monotonic timestamps at which the phases of the startup of a
+///             shell completed, from the call to |Shell::Create| to its first
+///             rasterized frame.
+///
+///             Each phase is recorded once and is also emitted as an instant
+///             trace event. Events recorded before the Dart VM is created only
+///             appear in this timeline, since the VM provides the trace
+///             buffer. All methods are thread-safe.
+///
+class StartupTimeline {
+ public:
+  enum class Phase {
+    // |Shell::Create| was called.
+    kShellCreate,
+    // The process-wide initialization of logging, Skia and ICU completed.
+    kInitializationTasks,
+    // The Dart VM was created and the snapshots were mapped.
+    kDartVM,
+    // The platform view was created on the platform thread.
+    kPlatformView,
+    // The rasterizer was created on the raster thread.
+    kRasterizer,
+    // The IO manager and its resource context were created on the IO thread.
+    kIOManager,
+    // The engine was created on the UI thread.
+    kEngine,
+    // The shell finished its setup and was returned to the embedder.
+    kShellSetup,
+    // The default font manager was set up on the UI thread. This isn't
+    // recorded when the font manager is prefetched by the embedder or by a
+    // concurrent startup.
+    kDefaultFontManager,
+    // The first frame was rasterized.
+    kFirstFrame,
+  };
+
+  static constexpr size_t kPhaseCount =
+      static_cast<size_t>(Phase::kFirstFrame) + 1;
+
+  StartupTimeline();
+
+  ~StartupTimeline();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the current time as the completion of |phase| unless
+  ///             it was already recorded, and emits a trace event.
+  ///
+  /// @return     Whether this call recorded |phase|.
+  ///
+  bool RecordPhase(Phase phase);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Copies the phases recorded in |other| that aren't recorded in
+  ///             this timeline.
+  ///
+  void Merge(const StartupTimeline& other);
+
+  //----------------------------------------------------------------------------
+  /// @return     The time at which |phase| completed, or std::nullopt if it
+  ///             hasn't completed yet.
+  ///
+  std::optional<fml::TimePoint> GetPhaseTime(Phase phase) const;
+
+  //----------------------------------------------------------------------------
+  /// @return     The name of |phase| used in trace events.
+  ///
+  static const char* GetPhaseName(Phase phase);
+
+ private:
+  mutable std::mutex mutex_;
+  std::array<std::optional<fml::TimePoint>, kPhaseCount> phase_times_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(StartupTimeline);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_STARTUP_TIMELINE_H_
@@ -356,9 +356,25 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   command_line.GetOptionValue(FlagForSwitch(Switch::TraceToFile),
                               &settings.trace_to_file);
 
+  command_line.GetOptionValue(FlagForSwitch(Switch::CaptureDisplayListsPath),
+                              &settings.capture_display_lists_path);
+
+  command_line.GetOptionValue(FlagForSwitch(Switch::JankCapturePath),
+                              &settings.jank_capture_path);
+
+  if (command_line.HasOption(FlagForSwitch(Switch::JankCaptureThresholdMs))) {
+    std::string jank_capture_threshold_ms;
+    command_line.GetOptionValue(FlagForSwitch(Switch::JankCaptureThresholdMs),
+                                &jank_capture_threshold_ms);
+    settings.jank_capture_threshold_ms = std::stod(jank_capture_threshold_ms);
+  }
+
   settings.skia_deterministic_rendering_on_cpu =
       command_line.HasOption(FlagForSwitch(Switch::SkiaDeterministicRendering));
 
+  settings.skia_batch_image_draws =
+      command_line.HasOption(FlagForSwitch(Switch::SkiaBatchImageDraws));
+
   settings.verbose_logging =
       command_line.HasOption(FlagForSwitch(Switch::VerboseLogging));
 
@@ -466,14 +482,50 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
 
   settings.enable_vulkan_validation =
       command_line.HasOption(FlagForSwitch(Switch::EnableVulkanValidation));
+  settings.enable_surface_control =
+      command_line.HasOption(FlagForSwitch(Switch::EnableSurfaceControl));
   settings.enable_opengl_gpu_tracing =
       command_line.HasOption(FlagForSwitch(Switch::EnableOpenGLGPUTracing));
 
+  settings.enable_async_runtime_effect_pipelines = command_line.HasOption(
+      FlagForSwitch(Switch::EnableAsyncRuntimeEffectPipelines));
+
+  settings.enable_impeller_analytic_antialiasing = command_line.HasOption(
+      FlagForSwitch(Switch::EnableImpellerAnalyticAntialiasing));
+
+  settings.enable_impeller_stencil_then_cover = command_line.HasOption(
+      FlagForSwitch(Switch::EnableImpellerStencilThenCover));
+
+  settings.enable_parallel_layer_tree_traversal = command_line.HasOption(
+      FlagForSwitch(Switch::EnableParallelLayerTreeTraversal));
+
+  settings.enable_deadline_aware_frame_scheduling = command_line.HasOption(
+      FlagForSwitch(Switch::EnableDeadlineAwareFrameScheduling));
+
+  settings.enable_workload_thread_affinity = command_line.HasOption(
+      FlagForSwitch(Switch::EnableWorkloadThreadAffinity));
+
+  settings.enable_realtime_raster_thread = command_line.HasOption(
+      FlagForSwitch(Switch::EnableRealtimeRasterThread));
+
+  settings.enable_pointer_event_coalescing = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePointerEventCoalescing));
+
+  settings.enable_pointer_event_resampling = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePointerEventResampling));
+
+  settings.enable_adaptive_quality =
+      command_line.HasOption(FlagForSwitch(Switch::EnableAdaptiveQuality));
+
   settings.enable_embedder_api =
       command_line.HasOption(FlagForSwitch(Switch::EnableEmbedderAPI));
 
   settings.prefetched_default_font_manager = command_line.HasOption(
       FlagForSwitch(Switch::PrefetchedDefaultFontManager));
+  settings.enable_concurrent_startup =
+      command_line.HasOption(FlagForSwitch(Switch::EnableConcurrentStartup));
+  command_line.GetOptionValue(FlagForSwitch(Switch::SnapshotPageProfilePath),
+                              &settings.snapshot_page_profile_path);
 
   std::string all_dart_flags;
   if (command_line.GetOptionValue(FlagForSwitch(Switch::DartFlags),
@@ -518,6 +570,62 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
         std::stoi(resource_cache_max_bytes_threshold);
   }
 
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::AnimatedImageFrameLookahead))) {
+    std::string animated_image_frame_lookahead;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::AnimatedImageFrameLookahead),
+        &animated_image_frame_lookahead);
+    settings.animated_image_frame_lookahead =
+        std::stoul(animated_image_frame_lookahead);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::AnimatedImageLookaheadMaxBytes))) {
+    std::string animated_image_lookahead_max_bytes;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::AnimatedImageLookaheadMaxBytes),
+        &animated_image_lookahead_max_bytes);
+    settings.animated_image_lookahead_max_bytes =
+        std::stoul(animated_image_lookahead_max_bytes);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::ResidentMemoryWarningBytes))) {
+    std::string resident_memory_warning_bytes;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::ResidentMemoryWarningBytes),
+        &resident_memory_warning_bytes);
+    settings.resident_memory_warning_bytes =
+        std::stoul(resident_memory_warning_bytes);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::ResourceUploadThreadCount))) {
+    std::string resource_upload_thread_count;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::ResourceUploadThreadCount),
+        &resource_upload_thread_count);
+    settings.resource_upload_thread_count =
+        std::stoul(resource_upload_thread_count);
+  }
+
+  settings.enable_image_texture_purging =
+      command_line.HasOption(FlagForSwitch(Switch::EnableImageTexturePurging));
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::ImageTextureCacheMaxBytes))) {
+    std::string image_texture_cache_max_bytes;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::ImageTextureCacheMaxBytes),
+        &image_texture_cache_max_bytes);
+    settings.image_texture_cache_max_bytes =
+        std::stoul(image_texture_cache_max_bytes);
+  }
+
+  settings.enable_lazy_image_mipmaps =
+      command_line.HasOption(FlagForSwitch(Switch::EnableLazyImageMipmaps));
+
   if (command_line.HasOption(FlagForSwitch(Switch::MsaaSamples))) {
     std::string msaa_samples;
     command_line.GetOptionValue(FlagForSwitch(Switch::MsaaSamples),
@@ -141,6 +141,11 @@ DEF_SWITCH(SkiaDeterministicRendering,
            "Skips the call to SkGraphics::Init(), thus avoiding swapping out "
            "some Skia function pointers based on available CPU features. This "
            "is used to obtain 100% deterministic behavior in Skia rendering.")
+DEF_SWITCH(SkiaBatchImageDraws,
+           "skia-batch-image-draws",
+           "Draw consecutive images that share their sampling and paint with "
+           "a single Skia image set, which Ganesh can draw with one op. Only "
+           "affects the Skia backend.")
 DEF_SWITCH(FlutterAssetsDir,
            "flutter-assets-dir",
            "Path to the Flutter assets directory.")
@@ -202,6 +207,26 @@ DEF_SWITCH(TraceToFile,
            "Write the timeline trace to a file at the specified path. The file "
            "will be in Perfetto's proto format; it will be possible to load "
            "the file into Perfetto's trace viewer.")
+DEF_SWITCH(CaptureDisplayListsPath,
+           "capture-display-lists-path",
+           "Write the first frames drawn by the rasterizer to the directory at "
+           "the specified path as serialized display lists. Frames containing "
+           "ops that can't be serialized, such as text, are skipped. The "
+           "captured frames can be replayed by the display list replay "
+           "benchmarks.")
+DEF_SWITCH(JankCapturePath,
+           "jank-capture-path",
+           "Record trace events into a fixed size in-memory ring buffer per "
+           "thread, and write the most recent events along with the timings "
+           "of the recent frames and the stats of the rasterizer's caches to "
+           "the directory at the specified path as a Perfetto trace when a "
+           "frame takes longer than the jank capture threshold. This is cheap "
+           "enough to leave enabled in the field.")
+DEF_SWITCH(JankCaptureThresholdMs,
+           "jank-capture-threshold-ms",
+           "The time in milliseconds from the start of the build to the end of "
+           "the rasterization of a frame past which the frame is captured by "
+           "--jank-capture-path. Defaults to twice the frame budget.")
 DEF_SWITCH(UseTestFonts,
            "use-test-fonts",
            "Running tests that layout and measure text will not yield "
@@ -218,6 +243,15 @@ DEF_SWITCH(PrefetchedDefaultFontManager,
            "prefetched-default-font-manager",
            "Indicates whether the embedding started a prefetch of the "
            "default font manager before creating the engine.")
+DEF_SWITCH(EnableConcurrentStartup,
+           "enable-concurrent-startup",
+           "Creates the default font manager on a concurrent worker while the "
+           "shell and the root isolate start up.")
+DEF_SWITCH(SnapshotPageProfilePath,
+           "snapshot-page-profile-path",
+           "Path to a profile of the AOT snapshot pages needed by the first "
+           "frame. The pages are prefetched when the VM starts, and the "
+           "profile is recorded after the first frame if it doesn't exist.")
 DEF_SWITCH(VerboseLogging,
            "verbose-logging",
            "By default, only errors are logged. This flag enabled logging at "
@@ -262,6 +296,40 @@ DEF_SWITCH(OldGenHeapSize,
 DEF_SWITCH(ResourceCacheMaxBytesThreshold,
            "resource-cache-max-bytes-threshold",
            "The max bytes threshold of resource cache, or 0 for unlimited.")
+DEF_SWITCH(AnimatedImageFrameLookahead,
+           "animated-image-frame-lookahead",
+           "The number of frames of animated images to decode ahead of the "
+           "requests of the framework on the concurrent worker threads, or 0 "
+           "to decode each frame when it is requested.")
+DEF_SWITCH(AnimatedImageLookaheadMaxBytes,
+           "animated-image-lookahead-max-bytes",
+           "The max bytes of the frames decoded ahead for each animated image.")
+DEF_SWITCH(ResidentMemoryWarningBytes,
+           "resident-memory-warning-bytes",
+           "The resident memory of the process past which the engine runs "
+           "the Dart GC and trims its caches as if the system sent a low "
+           "memory warning, or 0 to only do so on the warnings of the "
+           "system.")
+DEF_SWITCH(ResourceUploadThreadCount,
+           "resource-upload-thread-count",
+           "The number of threads, in addition to the IO thread, that upload "
+           "decoded images to the GPU with resource contexts of their own. "
+           "Only used with Skia on platforms that support it.")
+DEF_SWITCH(EnableImageTexturePurging,
+           "enable-image-texture-purging",
+           "Release the textures of decoded images that are not drawn when "
+           "the system is low on memory or they exceed "
+           "--image-texture-cache-max-bytes, and decode them again when they "
+           "are drawn. Only supported with Impeller.")
+DEF_SWITCH(ImageTextureCacheMaxBytes,
+           "image-texture-cache-max-bytes",
+           "The max bytes of the textures of decoded images that are not "
+           "drawn, or 0 to only release them on low memory warnings.")
+DEF_SWITCH(EnableLazyImageMipmaps,
+           "enable-lazy-image-mipmaps",
+           "Only generate the mip levels of decoded images the first time "
+           "they are drawn at a minifying scale with a mipmap filter. Only "
+           "supported with Impeller.")
 DEF_SWITCH(EnableImpeller,
            "enable-impeller",
            "Enable the Impeller renderer on supported platforms. Ignored if "
@@ -275,10 +343,66 @@ DEF_SWITCH(EnableVulkanValidation,
            "Enable loading Vulkan validation layers. The layers must be "
            "available to the application and loadable. On non-Vulkan backends, "
            "this flag does nothing.")
+DEF_SWITCH(EnableSurfaceControl,
+           "enable-surface-control",
+           "Present the frames of the Impeller Vulkan backend on Android 10 "
+           "and above through surface control transactions of hardware "
+           "buffers instead of a swapchain on the window.")
 DEF_SWITCH(EnableOpenGLGPUTracing,
            "enable-opengl-gpu-tracing",
            "Enable tracing of GPU execution time when using the Impeller "
            "OpenGLES backend.")
+DEF_SWITCH(EnableAsyncRuntimeEffectPipelines,
+           "enable-async-runtime-effect-pipelines",
+           "Compile the shaders and pipelines of fragment programs without "
+           "blocking the raster thread, and skip drawing them until they are "
+           "ready. Only supported with Impeller.")
+DEF_SWITCH(EnableImpellerAnalyticAntialiasing,
+           "enable-impeller-analytic-antialiasing",
+           "Anti-alias solid filled rectangles, rounded rectangles, ovals, "
+           "circles and lines in the fragment shader, and render save layers "
+           "that only contain such draws without MSAA. Only supported with "
+           "Impeller.")
+DEF_SWITCH(EnableImpellerStencilThenCover,
+           "enable-impeller-stencil-then-cover",
+           "Fill complex solid paths by drawing triangle fans into the stencil "
+           "buffer and covering their bounds instead of triangulating them. "
+           "Only supported with Impeller.")
+DEF_SWITCH(EnableParallelLayerTreeTraversal,
+           "enable-parallel-layer-tree-traversal",
+           "Preroll and paint the children of layers with many children on the "
+           "concurrent worker threads of the VM.")
+DEF_SWITCH(EnableDeadlineAwareFrameScheduling,
+           "enable-deadline-aware-frame-scheduling",
+           "Adapt the number of frames in flight between 1 and 3 to the "
+           "recent build and raster times, and build frames that find the "
+           "pipeline full as soon as it has room if they can still make their "
+           "vsync.")
+DEF_SWITCH(EnableWorkloadThreadAffinity,
+           "enable-workload-thread-affinity",
+           "Move the UI and raster threads to the performance cores during "
+           "animations and expensive frames, and to the efficiency cores once "
+           "no frame has been produced for a while.")
+DEF_SWITCH(EnableRealtimeRasterThread,
+           "enable-realtime-raster-thread",
+           "Run the raster thread with the SCHED_FIFO scheduling policy on "
+           "Linux, so that other threads can't delay it once it is runnable. "
+           "Requires CAP_SYS_NICE or a large enough RLIMIT_RTPRIO.")
+DEF_SWITCH(EnablePointerEventCoalescing,
+           "enable-pointer-event-coalescing",
+           "Dispatch the pointer events received between two frames to the "
+           "framework in a single packet before the next frame is built.")
+DEF_SWITCH(EnablePointerEventResampling,
+           "enable-pointer-event-resampling",
+           "Coalesce the pointer events, and replace the moves of each pointer "
+           "within a frame with a single move at the position predicted for "
+           "the target time of the frame. Implies "
+           "--enable-pointer-event-coalescing.")
+DEF_SWITCH(EnableAdaptiveQuality,
+           "enable-adaptive-quality",
+           "Lower the quality of blurs and cache pictures sooner while the "
+           "rasterization of frames keeps missing the frame budget, and "
+           "restore them once frames have been fast for a while.")
 DEF_SWITCH(LeakVM,
            "leak-vm",
            "When the last shell shuts down, the shared VM is leaked by default "
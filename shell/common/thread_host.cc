@@ -10,8 +10,25 @@
 #include <string>
 #include <utility>
 
+#include "flutter/fml/trace_event.h"
+
 namespace flutter {
 
+namespace {
+
+const char* AffinityName(fml::CpuAffinity affinity) {
+  switch (affinity) {
+    case fml::CpuAffinity::kPerformance:
+      return "Performance";
+    case fml::CpuAffinity::kEfficiency:
+      return "Efficiency";
+    case fml::CpuAffinity::kNotPerformance:
+      return "NotPerformance";
+  }
+}
+
+}  // namespace
+
 std::string ThreadHost::ThreadHostConfig::MakeThreadName(
     Type type,
     const std::string& prefix) {
@@ -104,4 +121,98 @@ ThreadHost::ThreadHost(const ThreadHostConfig& host_config)
 
 ThreadHost::~ThreadHost() = default;
 
+ThreadAffinityPolicy::ThreadAffinityPolicy(MigrateCallback migrate,
+                                           fml::CpuAffinity initial_affinity)
+    : migrate_(std::move(migrate)), affinity_(initial_affinity) {}
+
+ThreadAffinityPolicy::~ThreadAffinityPolicy() = default;
+
+std::unique_ptr<ThreadAffinityPolicy> ThreadAffinityPolicy::Create(
+    const TaskRunners& task_runners) {
+  const auto platform_queue_id =
+      task_runners.GetPlatformTaskRunner()->GetTaskQueueId();
+  // Moving a thread the UI or raster task runner shares with the platform
+  // task runner would move the platform thread as well, which the embedder
+  // owns.
+  auto ui_task_runner =
+      task_runners.GetUITaskRunner()->GetTaskQueueId() == platform_queue_id
+          ? nullptr
+          : task_runners.GetUITaskRunner();
+  auto raster_task_runner =
+      task_runners.GetRasterTaskRunner()->GetTaskQueueId() ==
+                  platform_queue_id ||
+              task_runners.GetRasterTaskRunner() == ui_task_runner
+          ? nullptr
+          : task_runners.GetRasterTaskRunner();
+  // The embedders that support affinities create the UI and raster threads
+  // with an affinity for the performance cores.
+  return std::make_unique<ThreadAffinityPolicy>(
+      [ui_task_runner, raster_task_runner](fml::CpuAffinity affinity) {
+        if (ui_task_runner) {
+          fml::TaskRunner::RunNowOrPostTask(
+              ui_task_runner, [affinity] { fml::RequestAffinity(affinity); });
+        }
+        if (raster_task_runner) {
+          raster_task_runner->PostTask(
+              [affinity] { fml::RequestAffinity(affinity); });
+        }
+      },
+      fml::CpuAffinity::kPerformance);
+}
+
+void ThreadAffinityPolicy::OnFrameBegin(fml::TimePoint now,
+                                        fml::TimeDelta vsync_interval) {
+  if (last_frame_begin_.has_value() &&
+      now - last_frame_begin_.value() <= kMaxFrameGap) {
+    consecutive_frames_++;
+  } else {
+    consecutive_frames_ = 1u;
+  }
+  last_frame_begin_ = now;
+  vsync_interval_ = vsync_interval;
+  if (consecutive_frames_ >= kFramesToPromote) {
+    Migrate(fml::CpuAffinity::kPerformance, "Animating");
+  }
+}
+
+void ThreadAffinityPolicy::OnFrameRasterized(const FrameTiming& timing) {
+  if (vsync_interval_ <= fml::TimeDelta::Zero()) {
+    return;
+  }
+  const fml::TimeDelta build_duration =
+      timing.Get(FrameTiming::kBuildFinish) -
+      timing.Get(FrameTiming::kBuildStart);
+  const fml::TimeDelta raster_duration =
+      timing.Get(FrameTiming::kRasterFinish) -
+      timing.Get(FrameTiming::kRasterStart);
+  const fml::TimeDelta budget = vsync_interval_ / 2;
+  if (build_duration > budget || raster_duration > budget) {
+    Migrate(fml::CpuAffinity::kPerformance, "ExpensiveFrame");
+  }
+}
+
+void ThreadAffinityPolicy::OnIdle(fml::TimePoint now) {
+  if (last_frame_begin_.has_value() &&
+      now - last_frame_begin_.value() < kIdleTimeToDemote) {
+    return;
+  }
+  consecutive_frames_ = 0u;
+  Migrate(fml::CpuAffinity::kEfficiency, "Idle");
+}
+
+fml::CpuAffinity ThreadAffinityPolicy::GetAffinity() const {
+  return affinity_;
+}
+
+void ThreadAffinityPolicy::Migrate(fml::CpuAffinity affinity,
+                                   const char* reason) {
+  if (affinity == affinity_) {
+    return;
+  }
+  TRACE_EVENT_INSTANT2("flutter", "ThreadAffinityPolicy::Migrate", "affinity",
+                       AffinityName(affinity), "reason", reason);
+  affinity_ = affinity;
+  migrate_(affinity);
+}
+
 }  // namespace flutter
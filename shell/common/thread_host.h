@@ -5,12 +5,18 @@
 #ifndef FLUTTER_SHELL_COMMON_THREAD_HOST_H_
 #define FLUTTER_SHELL_COMMON_THREAD_HOST_H_
 
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
 
+#include "flutter/common/settings.h"
+#include "flutter/common/task_runners.h"
+#include "flutter/fml/cpu_affinity.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/thread.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
 
 namespace flutter {
 
@@ -105,6 +111,91 @@ struct ThreadHost {
       const ThreadHostConfig& host_config) const;
 };
 
+/// Moves the UI and raster threads to the performance cores while frames are
+/// being produced, and back to the efficiency cores once the engine is idle.
+///
+/// The affinity requested when the threads are created holds for their whole
+/// lifetime, so the UI and raster threads stay on the performance cores even
+/// when nothing is animating. This policy trades that battery for latency
+/// only while it matters: during animations and scrolling, or when a single
+/// frame is expensive enough to miss its vsync on a slower core.
+///
+/// Used by the |Animator| on the UI thread only.
+class ThreadAffinityPolicy {
+ public:
+  /// Moves the UI and raster threads to the cores of the given affinity.
+  using MigrateCallback = std::function<void(fml::CpuAffinity)>;
+
+  // The number of consecutive frames, each started within |kMaxFrameGap| of
+  // the previous one, that move the threads to the performance cores.
+  static constexpr size_t kFramesToPromote = 3u;
+
+  // The longest time between the start of two frames of the same animation.
+  static constexpr fml::TimeDelta kMaxFrameGap =
+      fml::TimeDelta::FromMilliseconds(50);
+
+  // How long no frame must have started before the threads move back to the
+  // efficiency cores. This is long enough not to move threads back and forth
+  // between the flings of a scroll.
+  static constexpr fml::TimeDelta kIdleTimeToDemote =
+      fml::TimeDelta::FromMilliseconds(500);
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  migrate           Called on the UI thread whenever the
+  ///                               threads should move.
+  /// @param[in]  initial_affinity  The affinity the threads currently have.
+  ///
+  ThreadAffinityPolicy(MigrateCallback migrate,
+                       fml::CpuAffinity initial_affinity);
+
+  ~ThreadAffinityPolicy();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a policy that requests the affinity of the UI and
+  ///             raster threads of the given task runners. Threads shared
+  ///             with the platform task runner are left alone.
+  ///
+  static std::unique_ptr<ThreadAffinityPolicy> Create(
+      const TaskRunners& task_runners);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the start of a frame.
+  ///
+  /// @param[in]  now             The time the frame started building.
+  /// @param[in]  vsync_interval  The vsync interval of the frame.
+  ///
+  void OnFrameBegin(fml::TimePoint now, fml::TimeDelta vsync_interval);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the timings of a rasterized frame. A frame that took
+  ///             more than half its vsync interval to build or rasterize
+  ///             moves the threads to the performance cores.
+  ///
+  void OnFrameRasterized(const FrameTiming& timing);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Moves the threads to the efficiency cores if no frame has
+  ///             started for |kIdleTimeToDemote|.
+  ///
+  void OnIdle(fml::TimePoint now);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The affinity last requested for the threads.
+  ///
+  fml::CpuAffinity GetAffinity() const;
+
+ private:
+  const MigrateCallback migrate_;
+  fml::CpuAffinity affinity_;
+  std::optional<fml::TimePoint> last_frame_begin_;
+  fml::TimeDelta vsync_interval_;
+  size_t consecutive_frames_ = 0u;
+
+  void Migrate(fml::CpuAffinity affinity, const char* reason);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadAffinityPolicy);
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_SHELL_COMMON_THREAD_HOST_H_
@@ -0,0 +1,112 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/thread_host.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr fml::TimeDelta kVsyncInterval =
+    fml::TimeDelta::FromMicroseconds(16667);
+
+const fml::TimePoint kStart =
+    fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromMilliseconds(1000));
+
+FrameTiming MakeFrameTiming(fml::TimeDelta build, fml::TimeDelta raster) {
+  FrameTiming timing;
+  timing.Set(FrameTiming::kVsyncStart, kStart);
+  timing.Set(FrameTiming::kBuildStart, kStart);
+  timing.Set(FrameTiming::kBuildFinish, kStart + build);
+  timing.Set(FrameTiming::kRasterStart, kStart + build);
+  timing.Set(FrameTiming::kRasterFinish, kStart + build + raster);
+  return timing;
+}
+
+}  // namespace
+
+TEST(ThreadAffinityPolicyTest, ContinuousFramesMoveToPerformanceCores) {
+  std::vector<fml::CpuAffinity> migrations;
+  ThreadAffinityPolicy policy(
+      [&migrations](fml::CpuAffinity affinity) {
+        migrations.push_back(affinity);
+      },
+      fml::CpuAffinity::kEfficiency);
+
+  fml::TimePoint frame_begin = kStart;
+  for (size_t i = 0; i < ThreadAffinityPolicy::kFramesToPromote - 1; i++) {
+    policy.OnFrameBegin(frame_begin, kVsyncInterval);
+    frame_begin = frame_begin + kVsyncInterval;
+  }
+  EXPECT_TRUE(migrations.empty());
+
+  policy.OnFrameBegin(frame_begin, kVsyncInterval);
+  ASSERT_EQ(migrations.size(), 1u);
+  EXPECT_EQ(migrations[0], fml::CpuAffinity::kPerformance);
+  EXPECT_EQ(policy.GetAffinity(), fml::CpuAffinity::kPerformance);
+}
+
+TEST(ThreadAffinityPolicyTest, SparseFramesStayOnEfficiencyCores) {
+  std::vector<fml::CpuAffinity> migrations;
+  ThreadAffinityPolicy policy(
+      [&migrations](fml::CpuAffinity affinity) {
+        migrations.push_back(affinity);
+      },
+      fml::CpuAffinity::kEfficiency);
+
+  for (int64_t i = 0; i < 10; i++) {
+    policy.OnFrameBegin(kStart + ThreadAffinityPolicy::kMaxFrameGap * (2 * i),
+                        kVsyncInterval);
+  }
+  EXPECT_TRUE(migrations.empty());
+  EXPECT_EQ(policy.GetAffinity(), fml::CpuAffinity::kEfficiency);
+}
+
+TEST(ThreadAffinityPolicyTest, ExpensiveFrameMovesToPerformanceCores) {
+  std::vector<fml::CpuAffinity> migrations;
+  ThreadAffinityPolicy policy(
+      [&migrations](fml::CpuAffinity affinity) {
+        migrations.push_back(affinity);
+      },
+      fml::CpuAffinity::kEfficiency);
+
+  policy.OnFrameBegin(kStart, kVsyncInterval);
+  policy.OnFrameRasterized(MakeFrameTiming(kVsyncInterval / 4,  //
+                                           kVsyncInterval / 4));
+  EXPECT_TRUE(migrations.empty());
+
+  policy.OnFrameRasterized(MakeFrameTiming(kVsyncInterval / 4,  //
+                                           kVsyncInterval));
+  ASSERT_EQ(migrations.size(), 1u);
+  EXPECT_EQ(migrations[0], fml::CpuAffinity::kPerformance);
+}
+
+TEST(ThreadAffinityPolicyTest, IdleMovesToEfficiencyCoresAfterDelay) {
+  std::vector<fml::CpuAffinity> migrations;
+  ThreadAffinityPolicy policy(
+      [&migrations](fml::CpuAffinity affinity) {
+        migrations.push_back(affinity);
+      },
+      fml::CpuAffinity::kPerformance);
+
+  policy.OnFrameBegin(kStart, kVsyncInterval);
+  policy.OnIdle(kStart + ThreadAffinityPolicy::kIdleTimeToDemote / 2);
+  EXPECT_TRUE(migrations.empty());
+
+  policy.OnIdle(kStart + ThreadAffinityPolicy::kIdleTimeToDemote);
+  ASSERT_EQ(migrations.size(), 1u);
+  EXPECT_EQ(migrations[0], fml::CpuAffinity::kEfficiency);
+
+  // Already on the efficiency cores.
+  policy.OnIdle(kStart + ThreadAffinityPolicy::kIdleTimeToDemote * 2);
+  EXPECT_EQ(migrations.size(), 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
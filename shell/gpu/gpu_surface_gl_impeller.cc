@@ -4,6 +4,7 @@
 
 #include "flutter/shell/gpu/gpu_surface_gl_impeller.h"
 
+#include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/make_copyable.h"
 #include "impeller/display_list/dl_dispatcher.h"
 #include "impeller/renderer/backend/gles/surface_gles.h"
@@ -36,6 +37,11 @@ GPUSurfaceGLImpeller::GPUSurfaceGLImpeller(
     return;
   }
 
+  // Start creating the pipeline variants bundled with the application so that
+  // they aren't created on first use in the middle of a frame.
+  aiks_context->GetContentContext().PrewarmPipelineVariants(
+      PersistentCache::GetCacheForProcess()->LoadImpellerPipelineVariants());
+
   delegate_ = delegate;
   impeller_context_ = std::move(context);
   impeller_renderer_ = std::move(renderer);
@@ -110,12 +116,9 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
 
         auto cull_rect =
             surface->GetTargetRenderPassDescriptor().GetRenderTargetSize();
-        impeller::Rect dl_cull_rect = impeller::Rect::MakeSize(cull_rect);
-        impeller::DlDispatcher impeller_dispatcher(dl_cull_rect);
-        display_list->Dispatch(
-            impeller_dispatcher,
-            SkIRect::MakeWH(cull_rect.width, cull_rect.height));
-        auto picture = impeller_dispatcher.EndRecordingAsPicture();
+        auto picture = impeller::DlDispatcher::DispatchPartitioned(
+            *display_list, impeller::IRect::MakeSize(cull_rect),
+            aiks_context->GetContext()->GetConcurrentWorkerTaskRunner());
 
         return renderer->Render(
             std::move(surface),
@@ -167,7 +170,7 @@ bool GPUSurfaceGLImpeller::AllowsDrawingWhenGpuDisabled() const {
 
 // |Surface|
 bool GPUSurfaceGLImpeller::EnableRasterCache() const {
-  return false;
+  return true;
 }
 
 // |Surface|
@@ -21,9 +21,15 @@ namespace flutter {
 class IMPELLER_CA_METAL_LAYER_AVAILABLE GPUSurfaceMetalImpeller
     : public Surface {
  public:
-  GPUSurfaceMetalImpeller(GPUSurfaceMetalDelegate* delegate,
-                          const std::shared_ptr<impeller::Context>& context,
-                          bool render_to_surface = true);
+  /// If |aiks_context| is provided, the surface renders with it instead of
+  /// creating its own, so that surfaces on the same |context| can share its
+  /// pipelines, glyph atlas and render target cache. It must have been
+  /// created for |context|.
+  GPUSurfaceMetalImpeller(
+      GPUSurfaceMetalDelegate* delegate,
+      const std::shared_ptr<impeller::Context>& context,
+      bool render_to_surface = true,
+      const std::shared_ptr<impeller::AiksContext>& aiks_context = nullptr);
 
   // |Surface|
   ~GPUSurfaceMetalImpeller();
@@ -29,16 +29,20 @@ static std::shared_ptr<impeller::Renderer> CreateImpellerRenderer(
   return renderer;
 }
 
-GPUSurfaceMetalImpeller::GPUSurfaceMetalImpeller(GPUSurfaceMetalDelegate* delegate,
-                                                 const std::shared_ptr<impeller::Context>& context,
-                                                 bool render_to_surface)
+GPUSurfaceMetalImpeller::GPUSurfaceMetalImpeller(
+    GPUSurfaceMetalDelegate* delegate,
+    const std::shared_ptr<impeller::Context>& context,
+    bool render_to_surface,
+    const std::shared_ptr<impeller::AiksContext>& aiks_context)
     : delegate_(delegate),
       render_target_type_(delegate->GetRenderTargetType()),
       impeller_renderer_(CreateImpellerRenderer(context)),
-      aiks_context_(
-          std::make_shared<impeller::AiksContext>(impeller_renderer_ ? context : nullptr,
-                                                  impeller::TypographerContextSkia::Make())),
+      aiks_context_(aiks_context ? aiks_context
+                                 : std::make_shared<impeller::AiksContext>(
+                                       impeller_renderer_ ? context : nullptr,
+                                       impeller::TypographerContextSkia::Make())),
       render_to_surface_(render_to_surface) {
+  FML_DCHECK(!aiks_context || aiks_context->GetContext() == context);
   // If this preference is explicitly set, we allow for disabling partial repaint.
   NSNumber* disablePartialRepaint =
       [[NSBundle mainBundle] objectForInfoDictionaryKey:@"FLTDisablePartialRepaint"];
@@ -154,10 +158,8 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrameFromCAMetalLa
         }
 
         impeller::IRect cull_rect = surface->coverage();
-        SkIRect sk_cull_rect = SkIRect::MakeWH(cull_rect.GetWidth(), cull_rect.GetHeight());
-        impeller::DlDispatcher impeller_dispatcher(cull_rect);
-        display_list->Dispatch(impeller_dispatcher, sk_cull_rect);
-        auto picture = impeller_dispatcher.EndRecordingAsPicture();
+        auto picture = impeller::DlDispatcher::DispatchPartitioned(
+            *display_list, cull_rect, aiks_context->GetContext()->GetConcurrentWorkerTaskRunner());
 
         return renderer->Render(
             std::move(surface),
@@ -252,10 +254,8 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrameFromMTLTextur
         }
 
         impeller::IRect cull_rect = surface->coverage();
-        SkIRect sk_cull_rect = SkIRect::MakeWH(cull_rect.GetWidth(), cull_rect.GetHeight());
-        impeller::DlDispatcher impeller_dispatcher(cull_rect);
-        display_list->Dispatch(impeller_dispatcher, sk_cull_rect);
-        auto picture = impeller_dispatcher.EndRecordingAsPicture();
+        auto picture = impeller::DlDispatcher::DispatchPartitioned(
+            *display_list, cull_rect, aiks_context->GetContext()->GetConcurrentWorkerTaskRunner());
 
         bool render_result = renderer->Render(
             std::move(surface),
@@ -318,7 +318,7 @@ bool GPUSurfaceMetalImpeller::AllowsDrawingWhenGpuDisabled() const {
 
 // |Surface|
 bool GPUSurfaceMetalImpeller::EnableRasterCache() const {
-  return false;
+  return true;
 }
 
 // |Surface|
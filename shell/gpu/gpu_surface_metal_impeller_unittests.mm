@@ -11,6 +11,7 @@
 #include "impeller/entity/mtl/framebuffer_blend_shaders.h"
 #include "impeller/entity/mtl/modern_shaders.h"
 #include "impeller/renderer/backend/metal/context_mtl.h"
+#include "impeller/typographer/backends/skia/typographer_context_skia.h"
 
 namespace flutter {
 namespace testing {
@@ -77,5 +78,22 @@ TEST(GPUSurfaceMetalImpeller, AcquireFrameFromCAMetalLayerNullChecksDrawable) {
   ASSERT_EQ(frame, nullptr);
 }
 
+TEST(GPUSurfaceMetalImpeller, UsesProvidedAiksContext) {
+  auto delegate = std::make_shared<TestGPUSurfaceMetalDelegate>();
+  auto context = CreateImpellerContext();
+  auto aiks_context = std::make_shared<impeller::AiksContext>(
+      context, impeller::TypographerContextSkia::Make());
+
+  auto first = std::make_shared<GPUSurfaceMetalImpeller>(delegate.get(), context,
+                                                         /*render_to_surface=*/true, aiks_context);
+  auto second = std::make_shared<GPUSurfaceMetalImpeller>(delegate.get(), context,
+                                                          /*render_to_surface=*/true, aiks_context);
+
+  ASSERT_TRUE(first->IsValid());
+  ASSERT_TRUE(second->IsValid());
+  EXPECT_EQ(first->GetAiksContext(), aiks_context);
+  EXPECT_EQ(second->GetAiksContext(), aiks_context);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -64,6 +64,17 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
   SkCanvas* canvas = backing_store->getCanvas();
   canvas->resetMatrix();
 
+  // The platforms hand out the same backing store for as long as the size
+  // stays the same, and it still holds the last frame presented from it. Only
+  // the parts of that frame that changed need to be rasterized again. Any other
+  // backing store, including one that a failed frame may have partially drawn
+  // to, is repainted entirely.
+  framebuffer_info.supports_partial_repaint = true;
+  if (backing_store == last_presented_backing_store_) {
+    framebuffer_info.existing_damage = SkIRect::MakeEmpty();
+  }
+  last_presented_backing_store_ = nullptr;
+
   SurfaceFrame::SubmitCallback on_submit =
       [self = weak_factory_.GetWeakPtr()](const SurfaceFrame& surface_frame,
                                           DlCanvas* canvas) -> bool {
@@ -74,7 +85,11 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
 
     canvas->Flush();
 
-    return self->delegate_->PresentBackingStore(surface_frame.SkiaSurface());
+    if (!self->delegate_->PresentBackingStore(surface_frame.SkiaSurface())) {
+      return false;
+    }
+    self->last_presented_backing_store_ = surface_frame.SkiaSurface();
+    return true;
   };
 
   return std::make_unique<SurfaceFrame>(backing_store, framebuffer_info,
@@ -4,15 +4,65 @@
 
 #include "flutter/shell/gpu/gpu_surface_vulkan_impeller.h"
 
+#include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/make_copyable.h"
 #include "impeller/display_list/dl_dispatcher.h"
 #include "impeller/renderer/backend/vulkan/surface_context_vk.h"
+#include "impeller/renderer/backend/vulkan/surface_vk.h"
+#include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/renderer.h"
 #include "impeller/renderer/surface.h"
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 
 namespace flutter {
 
+namespace {
+
+// The render target that the damaged part of a frame is rendered to when the
+// swapchain image already holds the rest of it. It has the format of the
+// swapchain image so that it can be copied into it.
+std::optional<impeller::RenderTarget> MakeDamageRenderTarget(
+    const impeller::Context& context,
+    impeller::PixelFormat format,
+    impeller::ISize size) {
+  impeller::TextureDescriptor msaa_tex_desc;
+  msaa_tex_desc.storage_mode = impeller::StorageMode::kDeviceTransient;
+  msaa_tex_desc.type = impeller::TextureType::kTexture2DMultisample;
+  msaa_tex_desc.sample_count = impeller::SampleCount::kCount4;
+  msaa_tex_desc.format = format;
+  msaa_tex_desc.size = size;
+  msaa_tex_desc.usage =
+      static_cast<impeller::TextureUsageMask>(
+          impeller::TextureUsage::kRenderTarget);
+
+  impeller::TextureDescriptor resolve_tex_desc = msaa_tex_desc;
+  resolve_tex_desc.storage_mode = impeller::StorageMode::kDevicePrivate;
+  resolve_tex_desc.type = impeller::TextureType::kTexture2D;
+  resolve_tex_desc.sample_count = impeller::SampleCount::kCount1;
+
+  auto allocator = context.GetResourceAllocator();
+  auto msaa_tex = allocator->CreateTexture(msaa_tex_desc);
+  auto resolve_tex = allocator->CreateTexture(resolve_tex_desc);
+  if (!msaa_tex || !resolve_tex) {
+    return std::nullopt;
+  }
+  msaa_tex->SetLabel("ImpellerOnscreenDamageMSAA");
+  resolve_tex->SetLabel("ImpellerOnscreenDamageResolve");
+
+  impeller::ColorAttachment color0;
+  color0.texture = std::move(msaa_tex);
+  color0.clear_color = impeller::Color::DarkSlateGray();
+  color0.load_action = impeller::LoadAction::kClear;
+  color0.store_action = impeller::StoreAction::kMultisampleResolve;
+  color0.resolve_texture = std::move(resolve_tex);
+
+  impeller::RenderTarget render_target;
+  render_target.SetColorAttachment(color0, 0u);
+  return render_target;
+}
+
+}  // namespace
+
 GPUSurfaceVulkanImpeller::GPUSurfaceVulkanImpeller(
     std::shared_ptr<impeller::Context> context) {
   if (!context || !context->IsValid()) {
@@ -30,6 +80,11 @@ GPUSurfaceVulkanImpeller::GPUSurfaceVulkanImpeller(
     return;
   }
 
+  // Start creating the pipeline variants bundled with the application so that
+  // they aren't created on first use in the middle of a frame.
+  aiks_context->GetContentContext().PrewarmPipelineVariants(
+      PersistentCache::GetCacheForProcess()->LoadImpellerPipelineVariants());
+
   impeller_context_ = std::move(context);
   impeller_renderer_ = std::move(renderer);
   aiks_context_ = std::move(aiks_context);
@@ -65,10 +120,27 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
     return nullptr;
   }
 
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.supports_partial_repaint = true;
+  // The swapchain image lags behind the front buffer by the damage of the
+  // frames presented since it was. Images that are older than the damage that
+  // is kept, or whose contents are unknown, are repainted entirely.
+  size_t buffer_age =
+      static_cast<impeller::SurfaceVK&>(*surface).GetBufferAge();
+  if (buffer_age > 0u && buffer_age <= frame_damage_.size() + 1u) {
+    SkIRect existing_damage = SkIRect::MakeEmpty();
+    for (size_t i = 0u; i + 1u < buffer_age; i++) {
+      existing_damage.join(frame_damage_[i]);
+    }
+    framebuffer_info.existing_damage = existing_damage;
+  }
+
   SurfaceFrame::SubmitCallback submit_callback =
-      fml::MakeCopyable([renderer = impeller_renderer_,  //
+      fml::MakeCopyable([this,                           //
+                         renderer = impeller_renderer_,  //
                          aiks_context = aiks_context_,   //
-                         surface = std::move(surface)    //
+                         surface = std::move(surface),   //
+                         size                            //
   ](SurfaceFrame& surface_frame, DlCanvas* canvas) mutable -> bool {
         if (!aiks_context) {
           return false;
@@ -80,32 +152,94 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
           return false;
         }
 
-        auto cull_rect =
-            surface->GetTargetRenderPassDescriptor().GetRenderTargetSize();
-        impeller::Rect dl_cull_rect = impeller::Rect::MakeSize(cull_rect);
-        impeller::DlDispatcher impeller_dispatcher(dl_cull_rect);
-        display_list->Dispatch(
-            impeller_dispatcher,
-            SkIRect::MakeWH(cull_rect.width, cull_rect.height));
-        auto picture = impeller_dispatcher.EndRecordingAsPicture();
-
-        return renderer->Render(
-            std::move(surface),
-            fml::MakeCopyable(
-                [aiks_context, picture = std::move(picture)](
-                    impeller::RenderTarget& render_target) -> bool {
-                  return aiks_context->Render(picture, render_target,
-                                              /*reset_host_buffer=*/true);
-                }));
+        surface->SetPresentationTime(
+            surface_frame.submit_info().presentation_time);
+
+        // The display list of a partially repainted frame is already
+        // translated to the origin of its damage by the compositor.
+        std::optional<impeller::IRect> clip_rect;
+        const auto& buffer_damage = surface_frame.submit_info().buffer_damage;
+        if (buffer_damage.has_value() &&
+            *buffer_damage != SkIRect::MakeSize(size)) {
+          clip_rect = impeller::IRect::MakeLTRB(
+              buffer_damage->left(), buffer_damage->top(),
+              buffer_damage->right(), buffer_damage->bottom());
+        }
+
+        bool result;
+        if (clip_rect.has_value() && clip_rect->IsEmpty()) {
+          // Nothing changed since the frame in the swapchain image.
+          result = surface->Present();
+        } else {
+          auto cull_rect =
+              clip_rect.has_value()
+                  ? impeller::IRect::MakeSize(clip_rect->GetSize())
+                  : impeller::IRect::MakeSize(
+                        surface->GetTargetRenderPassDescriptor()
+                            .GetRenderTargetSize());
+          auto picture = impeller::DlDispatcher::DispatchPartitioned(
+              *display_list, cull_rect,
+              aiks_context->GetContext()->GetConcurrentWorkerTaskRunner());
+
+          result = renderer->Render(
+              std::move(surface),
+              fml::MakeCopyable(
+                  [aiks_context, clip_rect, picture = std::move(picture)](
+                      impeller::RenderTarget& render_target) -> bool {
+                    if (!clip_rect.has_value()) {
+                      return aiks_context->Render(picture, render_target,
+                                                  /*reset_host_buffer=*/true);
+                    }
+                    // Render the damage on its own and copy it over the
+                    // part of the previous frame that it replaces.
+                    const auto& context = aiks_context->GetContext();
+                    auto swapchain_texture =
+                        render_target.GetRenderTargetTexture();
+                    auto damage_target = MakeDamageRenderTarget(
+                        *context,
+                        swapchain_texture->GetTextureDescriptor().format,
+                        clip_rect->GetSize());
+                    if (!damage_target.has_value() ||
+                        !aiks_context->Render(picture, *damage_target,
+                                              /*reset_host_buffer=*/true)) {
+                      return false;
+                    }
+                    auto command_buffer = context->CreateCommandBuffer();
+                    if (!command_buffer) {
+                      return false;
+                    }
+                    command_buffer->SetLabel("Partial Repaint Command Buffer");
+                    auto blit_pass = command_buffer->CreateBlitPass();
+                    blit_pass->AddCopy(damage_target->GetRenderTargetTexture(),
+                                       swapchain_texture, std::nullopt,
+                                       clip_rect->GetOrigin());
+                    return blit_pass->EncodeCommands(
+                               context->GetResourceAllocator()) &&
+                           command_buffer->SubmitCommands();
+                  }));
+        }
+        if (!result) {
+          // The damage since the images were presented is no longer known.
+          frame_damage_.clear();
+          return false;
+        }
+
+        frame_damage_.push_front(
+            surface_frame.submit_info().frame_damage.value_or(
+                SkIRect::MakeSize(size)));
+        if (frame_damage_.size() > kMaxFrameDamageCount) {
+          frame_damage_.pop_back();
+        }
+        return true;
       });
 
   return std::make_unique<SurfaceFrame>(
-      nullptr,                          // surface
-      SurfaceFrame::FramebufferInfo{},  // framebuffer info
-      submit_callback,                  // submit callback
-      size,                             // frame size
-      nullptr,                          // context result
-      true                              // display list fallback
+      nullptr,           // surface
+      framebuffer_info,  // framebuffer info
+      submit_callback,   // submit callback
+      size,              // frame size
+      nullptr,           // context result
+      true               // display list fallback
   );
 }
 
@@ -131,7 +265,7 @@ GPUSurfaceVulkanImpeller::MakeRenderContextCurrent() {
 
 // |Surface|
 bool GPUSurfaceVulkanImpeller::EnableRasterCache() const {
-  return false;
+  return true;
 }
 
 // |Surface|
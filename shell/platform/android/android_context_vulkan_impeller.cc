@@ -56,9 +56,11 @@ static std::shared_ptr<impeller::Context> CreateImpellerContext(
 }
 
 AndroidContextVulkanImpeller::AndroidContextVulkanImpeller(
-    bool enable_validation)
+    bool enable_validation,
+    bool enable_surface_control)
     : AndroidContext(AndroidRenderingAPI::kVulkan),
-      proc_table_(fml::MakeRefCounted<vulkan::VulkanProcTable>()) {
+      proc_table_(fml::MakeRefCounted<vulkan::VulkanProcTable>()),
+      enable_surface_control_(enable_surface_control) {
   auto impeller_context = CreateImpellerContext(proc_table_, enable_validation);
   SetImpellerContext(impeller_context);
   is_valid_ =
@@ -14,16 +14,23 @@ namespace flutter {
 
 class AndroidContextVulkanImpeller : public AndroidContext {
  public:
-  explicit AndroidContextVulkanImpeller(bool enable_validation);
+  explicit AndroidContextVulkanImpeller(bool enable_validation,
+                                        bool enable_surface_control = false);
 
   ~AndroidContextVulkanImpeller();
 
   // |AndroidContext|
   bool IsValid() const override;
 
+  /// @brief      Whether the surfaces present through surface control
+  ///             transactions where the device supports them. See
+  ///             |AndroidSurfaceControlSwapchainVK|.
+  bool IsSurfaceControlEnabled() const { return enable_surface_control_; }
+
  private:
   fml::RefPtr<vulkan::VulkanProcTable> proc_table_;
   bool is_valid_ = false;
+  const bool enable_surface_control_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(AndroidContextVulkanImpeller);
 };
@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_hardware_image_generator.h"
+
+#include <android/bitmap.h>
+#include <android/data_space.h>
+#include <android/hardware_buffer.h>
+#include <android/imagedecoder.h>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/impeller/core/formats.h"
+#include "flutter/impeller/core/texture_descriptor.h"
+#include "flutter/impeller/renderer/backend/vulkan/android_hardware_buffer_texture_source_vk.h"
+#include "flutter/impeller/renderer/backend/vulkan/context_vk.h"
+#include "flutter/impeller/renderer/backend/vulkan/texture_vk.h"
+#include "flutter/shell/platform/android/ndk_helpers.h"
+#include "third_party/skia/include/codec/SkEncodedOrigin.h"
+
+namespace flutter {
+
+AndroidHardwareImageGenerator::AndroidHardwareImageGenerator(
+    std::unique_ptr<SkCodec> codec,
+    sk_sp<SkData> data)
+    : BuiltinSkiaCodecImageGenerator(std::move(codec)),
+      data_(std::move(data)) {}
+
+AndroidHardwareImageGenerator::~AndroidHardwareImageGenerator() = default;
+
+std::shared_ptr<impeller::Texture>
+AndroidHardwareImageGenerator::DecodeToTexture(
+    const std::shared_ptr<impeller::Context>& context,
+    const SkISize& target_size) {
+  if (!context ||
+      context->GetBackendType() != impeller::Context::BackendType::kVulkan ||
+      GetFrameCount() != 1 || target_size.isEmpty()) {
+    return nullptr;
+  }
+  TRACE_EVENT0("flutter", __FUNCTION__);
+
+  AImageDecoder* decoder = nullptr;
+  if (NDKHelpers::AImageDecoder_createFromBuffer(
+          data_->data(), data_->size(), &decoder) !=
+      ANDROID_IMAGE_DECODER_SUCCESS) {
+    return nullptr;
+  }
+  fml::ScopedCleanupClosure delete_decoder(
+      [decoder]() { NDKHelpers::AImageDecoder_delete(decoder); });
+  if (NDKHelpers::AImageDecoder_setAndroidBitmapFormat(
+          decoder, ANDROID_BITMAP_FORMAT_RGBA_8888) !=
+          ANDROID_IMAGE_DECODER_SUCCESS ||
+      NDKHelpers::AImageDecoder_setTargetSize(decoder, target_size.width(),
+                                              target_size.height()) !=
+          ANDROID_IMAGE_DECODER_SUCCESS ||
+      NDKHelpers::AImageDecoder_setDataSpace(decoder, ADATASPACE_SRGB) !=
+          ANDROID_IMAGE_DECODER_SUCCESS) {
+    return nullptr;
+  }
+
+  AHardwareBuffer_Desc hb_desc = {};
+  hb_desc.width = target_size.width();
+  hb_desc.height = target_size.height();
+  hb_desc.layers = 1;
+  hb_desc.format = AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM;
+  hb_desc.usage = AHARDWAREBUFFER_USAGE_CPU_WRITE_OFTEN |
+                  AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE;
+  AHardwareBuffer* hardware_buffer = nullptr;
+  if (NDKHelpers::AHardwareBuffer_allocate(&hb_desc, &hardware_buffer) != 0) {
+    FML_DLOG(ERROR) << "Failed to allocate a hardware buffer of size "
+                    << target_size.width() << "x" << target_size.height();
+    return nullptr;
+  }
+  // The texture imported below holds its own reference to the buffer.
+  fml::ScopedCleanupClosure release_buffer([hardware_buffer]() {
+    NDKHelpers::AHardwareBuffer_release(hardware_buffer);
+  });
+  NDKHelpers::AHardwareBuffer_describe(hardware_buffer, &hb_desc);
+
+  void* pixels = nullptr;
+  if (NDKHelpers::AHardwareBuffer_lock(hardware_buffer,
+                                       AHARDWAREBUFFER_USAGE_CPU_WRITE_OFTEN,
+                                       /*fence=*/-1, /*rect=*/nullptr,
+                                       &pixels) != 0) {
+    return nullptr;
+  }
+  const size_t row_bytes = hb_desc.stride * 4;
+  const int decode_result = NDKHelpers::AImageDecoder_decodeImage(
+      decoder, pixels, row_bytes, row_bytes * hb_desc.height);
+  NDKHelpers::AHardwareBuffer_unlock(hardware_buffer, /*fence=*/nullptr);
+  if (decode_result != ANDROID_IMAGE_DECODER_SUCCESS) {
+    FML_DLOG(ERROR) << "AImageDecoder failed to decode image: "
+                    << decode_result;
+    return nullptr;
+  }
+
+  impeller::TextureDescriptor desc;
+  desc.storage_mode = impeller::StorageMode::kDevicePrivate;
+  desc.size = {target_size.width(), target_size.height()};
+  desc.format = impeller::PixelFormat::kR8G8B8A8UNormInt;
+  desc.mip_count = 1;
+
+  auto texture_source =
+      std::make_shared<impeller::AndroidHardwareBufferTextureSourceVK>(
+          desc, impeller::ContextVK::Cast(*context).GetDevice(),
+          hardware_buffer, hb_desc);
+  if (!texture_source->IsValid()) {
+    return nullptr;
+  }
+  return std::make_shared<impeller::TextureVK>(context, texture_source);
+}
+
+bool AndroidHardwareImageGenerator::IsSupported() {
+  return NDKHelpers::ImageDecoderSupported();
+}
+
+std::unique_ptr<ImageGenerator> AndroidHardwareImageGenerator::MakeFromData(
+    sk_sp<SkData> data) {
+  auto codec = SkCodec::MakeFromData(data);
+  if (!codec) {
+    return nullptr;
+  }
+  // The texture is sampled as decoded, so images with an EXIF orientation are
+  // left to the builtin generator, which applies it on the CPU.
+  if (codec->getOrigin() != kTopLeft_SkEncodedOrigin) {
+    return std::make_unique<BuiltinSkiaCodecImageGenerator>(std::move(codec));
+  }
+  return std::make_unique<AndroidHardwareImageGenerator>(std::move(codec),
+                                                         std::move(data));
+}
+
+}  // namespace flutter
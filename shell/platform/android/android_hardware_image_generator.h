@@ -0,0 +1,47 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_HARDWARE_IMAGE_GENERATOR_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_HARDWARE_IMAGE_GENERATOR_H_
+
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/painting/image_generator.h"
+
+namespace flutter {
+
+/// @brief  An image generator that decodes still images with the platform
+///         `AImageDecoder` straight into an `AHardwareBuffer`, which is then
+///         imported as an Impeller Vulkan texture without any copy.
+///
+///         Everything else, including the fallback when the image cannot be
+///         decoded this way, is handled by the builtin Skia codec.
+class AndroidHardwareImageGenerator : public BuiltinSkiaCodecImageGenerator {
+ public:
+  AndroidHardwareImageGenerator(std::unique_ptr<SkCodec> codec,
+                                sk_sp<SkData> data);
+
+  ~AndroidHardwareImageGenerator();
+
+  // |ImageGenerator|
+  std::shared_ptr<impeller::Texture> DecodeToTexture(
+      const std::shared_ptr<impeller::Context>& context,
+      const SkISize& target_size) override;
+
+  /// @brief  Whether the platform has the APIs needed by this generator
+  ///         (API level 30+).
+  static bool IsSupported();
+
+  static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
+
+ private:
+  const sk_sp<SkData> data_;
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(AndroidHardwareImageGenerator);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_HARDWARE_IMAGE_GENERATOR_H_
@@ -4,6 +4,9 @@
 
 #include "flutter/shell/platform/android/android_image_generator.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <memory>
 #include <utility>
 
@@ -17,6 +20,7 @@
 namespace flutter {
 
 static fml::jni::ScopedJavaGlobalRef<jclass>* g_flutter_jni_class = nullptr;
+static jmethodID g_decode_image_header_method = nullptr;
 static jmethodID g_decode_image_method = nullptr;
 
 AndroidImageGenerator::~AndroidImageGenerator() = default;
@@ -45,7 +49,16 @@ const ImageGenerator::FrameInfo AndroidImageGenerator::GetFrameInfo(
 }
 
 SkISize AndroidImageGenerator::GetScaledDimensions(float desired_scale) {
-  return GetInfo().dimensions();
+  const SkISize size = GetInfo().dimensions();
+  if (desired_scale >= 1.0f) {
+    return size;
+  }
+  // The platform decoder can scale to any size while decoding.
+  return SkISize::Make(
+      std::clamp(static_cast<int>(std::ceil(size.width() * desired_scale)), 1,
+                 size.width()),
+      std::clamp(static_cast<int>(std::ceil(size.height() * desired_scale)), 1,
+                 size.height()));
 }
 
 bool AndroidImageGenerator::GetPixels(const SkImageInfo& info,
@@ -53,12 +66,6 @@ bool AndroidImageGenerator::GetPixels(const SkImageInfo& info,
                                       size_t row_bytes,
                                       unsigned int frame_index,
                                       std::optional<unsigned int> prior_frame) {
-  fully_decoded_latch_.Wait();
-
-  if (!software_decoded_data_) {
-    return false;
-  }
-
   if (kRGBA_8888_SkColorType != info.colorType()) {
     return false;
   }
@@ -79,19 +86,36 @@ bool AndroidImageGenerator::GetPixels(const SkImageInfo& info,
   // API level 30+ once it's updated to do symbol lookups and not get
   // preprocessed out in Skia. This will allow for avoiding this copy in
   // cases where the result image doesn't need to be resized.
-  memcpy(pixels, software_decoded_data_->data(),
-         software_decoded_data_->size());
-  return true;
+  return DecodePixels(info, pixels, row_bytes);
 }
 
-void AndroidImageGenerator::DecodeImage() {
-  DoDecodeImage();
+void AndroidImageGenerator::DecodeHeader() {
+  FML_DCHECK(g_flutter_jni_class);
+  FML_DCHECK(g_decode_image_header_method);
+
+  // Call FlutterJNI.decodeImageHeader
+
+  JNIEnv* env = fml::jni::AttachCurrentThread();
+
+  // This task is run on the IO thread.  Create a frame to ensure that all
+  // local JNI references used here are freed.
+  fml::jni::ScopedJavaLocalFrame scoped_local_reference_frame(env);
+
+  jobject direct_buffer =
+      env->NewDirectByteBuffer(const_cast<void*>(data_->data()), data_->size());
 
+  env->CallStaticVoidMethod(g_flutter_jni_class->obj(),
+                            g_decode_image_header_method, direct_buffer,
+                            reinterpret_cast<jlong>(this));
+  FML_CHECK(fml::jni::CheckException(env));
+
+  // Unblock callers if the header could not be decoded.
   header_decoded_latch_.Signal();
-  fully_decoded_latch_.Signal();
 }
 
-void AndroidImageGenerator::DoDecodeImage() {
+bool AndroidImageGenerator::DecodePixels(const SkImageInfo& info,
+                                         void* pixels,
+                                         size_t row_bytes) {
   FML_DCHECK(g_flutter_jni_class);
   FML_DCHECK(g_decode_image_method);
 
@@ -99,51 +123,48 @@ void AndroidImageGenerator::DoDecodeImage() {
 
   JNIEnv* env = fml::jni::AttachCurrentThread();
 
-  // This task is run on the IO thread.  Create a frame to ensure that all
-  // local JNI references used here are freed.
+  // This may run on any thread that decodes images. Create a frame to ensure
+  // that all local JNI references used here are freed.
   fml::jni::ScopedJavaLocalFrame scoped_local_reference_frame(env);
 
   jobject direct_buffer =
       env->NewDirectByteBuffer(const_cast<void*>(data_->data()), data_->size());
 
-  auto bitmap = std::make_unique<fml::jni::ScopedJavaGlobalRef<jobject>>(
-      env, env->CallStaticObjectMethod(g_flutter_jni_class->obj(),
-                                       g_decode_image_method, direct_buffer,
-                                       reinterpret_cast<jlong>(this)));
+  jobject bitmap = env->CallStaticObjectMethod(
+      g_flutter_jni_class->obj(), g_decode_image_method, direct_buffer,
+      info.width(), info.height());
   FML_CHECK(fml::jni::CheckException(env));
 
-  if (bitmap->is_null()) {
-    return;
+  if (bitmap == nullptr) {
+    return false;
   }
 
-  AndroidBitmapInfo info;
-  [[maybe_unused]] int status;
-  if ((status = AndroidBitmap_getInfo(env, bitmap->obj(), &info)) < 0) {
+  AndroidBitmapInfo bitmap_info;
+  int status;
+  if ((status = AndroidBitmap_getInfo(env, bitmap, &bitmap_info)) < 0) {
     FML_DLOG(ERROR) << "Failed to get bitmap info, status=" << status;
-    return;
+    return false;
+  }
+  FML_DCHECK(bitmap_info.format == ANDROID_BITMAP_FORMAT_RGBA_8888);
+  if (static_cast<int>(bitmap_info.width) != info.width() ||
+      static_cast<int>(bitmap_info.height) != info.height()) {
+    FML_DLOG(ERROR) << "Decoded bitmap has an unexpected size";
+    return false;
   }
-  FML_DCHECK(info.format == ANDROID_BITMAP_FORMAT_RGBA_8888);
-
-  // Lock the android buffer in a shared pointer
 
   void* pixel_lock;
-  if ((status = AndroidBitmap_lockPixels(env, bitmap->obj(), &pixel_lock)) <
-      0) {
+  if ((status = AndroidBitmap_lockPixels(env, bitmap, &pixel_lock)) < 0) {
     FML_DLOG(ERROR) << "Failed to lock pixels, error=" << status;
-    return;
+    return false;
   }
-
-  SkData::ReleaseProc on_release = [](const void* ptr, void* context) -> void {
-    fml::jni::ScopedJavaGlobalRef<jobject>* bitmap =
-        reinterpret_cast<fml::jni::ScopedJavaGlobalRef<jobject>*>(context);
-    auto env = fml::jni::AttachCurrentThread();
-    AndroidBitmap_unlockPixels(env, bitmap->obj());
-    delete bitmap;
-  };
-
-  software_decoded_data_ = SkData::MakeWithProc(
-      pixel_lock, info.width * info.height * sizeof(uint32_t), on_release,
-      bitmap.release());
+  const size_t min_row_bytes = info.minRowBytes();
+  for (uint32_t row = 0; row < bitmap_info.height; row++) {
+    memcpy(static_cast<uint8_t*>(pixels) + row * row_bytes,
+           static_cast<const uint8_t*>(pixel_lock) + row * bitmap_info.stride,
+           min_row_bytes);
+  }
+  AndroidBitmap_unlockPixels(env, bitmap);
+  return true;
 }
 
 bool AndroidImageGenerator::Register(JNIEnv* env) {
@@ -151,9 +172,14 @@ bool AndroidImageGenerator::Register(JNIEnv* env) {
       env, env->FindClass("io/flutter/embedding/engine/FlutterJNI"));
   FML_DCHECK(!g_flutter_jni_class->is_null());
 
+  g_decode_image_header_method =
+      env->GetStaticMethodID(g_flutter_jni_class->obj(), "decodeImageHeader",
+                             "(Ljava/nio/ByteBuffer;J)V");
+  FML_DCHECK(g_decode_image_header_method);
+
   g_decode_image_method = env->GetStaticMethodID(
       g_flutter_jni_class->obj(), "decodeImage",
-      "(Ljava/nio/ByteBuffer;J)Landroid/graphics/Bitmap;");
+      "(Ljava/nio/ByteBuffer;II)Landroid/graphics/Bitmap;");
   FML_DCHECK(g_decode_image_method);
 
   static const JNINativeMethod header_decoded_method = {
@@ -179,7 +205,7 @@ std::shared_ptr<ImageGenerator> AndroidImageGenerator::MakeFromData(
       new AndroidImageGenerator(std::move(data)));
 
   fml::TaskRunner::RunNowOrPostTask(
-      task_runner, [generator]() { generator->DecodeImage(); });
+      task_runner, [generator]() { generator->DecodeHeader(); });
 
   if (generator->IsValidImageData()) {
     return generator;
@@ -202,7 +228,7 @@ void AndroidImageGenerator::NativeImageHeaderCallback(JNIEnv* env,
 }
 
 bool AndroidImageGenerator::IsValidImageData() {
-  // The generator kicks off an IO task to decode everything, and calls to
+  // The generator kicks off an IO task to decode the header, and calls to
   // "GetInfo()" block until either the header has been decoded or decoding has
   // failed, whichever is sooner. The decoder is initialized with a width and
   // height of -1 and will update the dimensions if the image is able to be
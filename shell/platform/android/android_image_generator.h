@@ -44,7 +44,7 @@ class AndroidImageGenerator : public ImageGenerator {
                  unsigned int frame_index,
                  std::optional<unsigned int> prior_frame) override;
 
-  void DecodeImage();
+  void DecodeHeader();
 
   static bool Register(JNIEnv* env);
 
@@ -60,7 +60,6 @@ class AndroidImageGenerator : public ImageGenerator {
 
  private:
   sk_sp<SkData> data_;
-  sk_sp<SkData> software_decoded_data_;
 
   SkImageInfo image_info_;
 
@@ -68,10 +67,9 @@ class AndroidImageGenerator : public ImageGenerator {
   /// dimensions have been determined.
   fml::ManualResetWaitableEvent header_decoded_latch_;
 
-  /// Blocks until the image has been fully decoded.
-  fml::ManualResetWaitableEvent fully_decoded_latch_;
-
-  void DoDecodeImage();
+  /// Decodes the image at the size of `info` into `pixels`. The platform
+  /// decoder scales while decoding, so smaller sizes use less memory.
+  bool DecodePixels(const SkImageInfo& info, void* pixels, size_t row_bytes);
 
   bool IsValidImageData();
 
@@ -27,6 +27,7 @@
 #include "flutter/shell/common/run_configuration.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/shell/platform/android/android_display.h"
+#include "flutter/shell/platform/android/android_hardware_image_generator.h"
 #include "flutter/shell/platform/android/android_image_generator.h"
 #include "flutter/shell/platform/android/context/android_context.h"
 #include "flutter/shell/platform/android/platform_view_android.h"
@@ -169,6 +170,17 @@ AndroidShellHolder::AndroidShellHolder(
         },
         -1);
     FML_DLOG(INFO) << "Registered Android SDK image decoder (API level 28+)";
+
+    if (settings_.enable_impeller &&
+        AndroidHardwareImageGenerator::IsSupported()) {
+      shell_->RegisterImageDecoder(
+          [](sk_sp<SkData> buffer) {
+            return AndroidHardwareImageGenerator::MakeFromData(
+                std::move(buffer));
+          },
+          1);
+      FML_DLOG(INFO) << "Registered Android hardware image decoder";
+    }
   }
 
   platform_view_ = weak_platform_view;
@@ -0,0 +1,389 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_surface_control_swapchain_vk.h"
+
+#include <poll.h>
+
+#include <algorithm>
+#include <cerrno>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/impeller/renderer/backend/vulkan/android_hardware_buffer_texture_source_vk.h"
+#include "flutter/impeller/renderer/backend/vulkan/barrier_vk.h"
+#include "flutter/impeller/renderer/backend/vulkan/capabilities_vk.h"
+#include "flutter/impeller/renderer/backend/vulkan/command_buffer_vk.h"
+#include "flutter/impeller/renderer/backend/vulkan/command_encoder_vk.h"
+#include "flutter/impeller/renderer/backend/vulkan/gpu_tracer_vk.h"
+#include "flutter/impeller/renderer/backend/vulkan/surface_vk.h"
+#include "flutter/impeller/renderer/backend/vulkan/swapchain_image_vk.h"
+#include "flutter/shell/platform/android/ndk_helpers.h"
+
+namespace flutter {
+
+// How long to wait for the compositor to release a buffer before giving up
+// on the frame.
+static constexpr fml::TimeDelta kBufferReleaseTimeout =
+    fml::TimeDelta::FromSeconds(1);
+
+struct AndroidSurfaceControlSwapchainVK::Buffer {
+  // Keeps the device alive until the compositor has released the buffer.
+  std::shared_ptr<impeller::ContextVK> context;
+  AHardwareBuffer* hardware_buffer = nullptr;
+  impeller::ISize size;
+  // Owns the image and the memory imported from the hardware buffer.
+  std::shared_ptr<impeller::AndroidHardwareBufferTextureSourceVK>
+      texture_source;
+  // Renders into the image of `texture_source`, and keeps the multisampled
+  // texture resolved into it across frames.
+  std::shared_ptr<impeller::SwapchainImageVK> image;
+  // Whether neither the raster thread nor the compositor uses the buffer.
+  bool is_available = true;
+  fml::UniqueFD release_fence;
+  // The submission that hands the image to the compositor, kept until the
+  // buffer is rendered into again.
+  std::shared_ptr<impeller::CommandBuffer> final_cmd_buffer;
+  vk::UniqueSemaphore render_done;
+
+  ~Buffer() {
+    image.reset();
+    texture_source.reset();
+    if (hardware_buffer) {
+      NDKHelpers::AHardwareBuffer_release(hardware_buffer);
+    }
+  }
+};
+
+struct AndroidSurfaceControlSwapchainVK::TransactionContext {
+  std::weak_ptr<AndroidSurfaceControlSwapchainVK> swapchain;
+  // The buffer replaced by the transaction.
+  std::shared_ptr<Buffer> previous_buffer;
+};
+
+static bool WaitForFence(const fml::UniqueFD& fence) {
+  pollfd poll_fd = {};
+  poll_fd.fd = fence.get();
+  poll_fd.events = POLLIN;
+  int result;
+  do {
+    result = ::poll(&poll_fd, 1, kBufferReleaseTimeout.ToMilliseconds());
+  } while (result == -1 && (errno == EINTR || errno == EAGAIN));
+  return result > 0;
+}
+
+bool AndroidSurfaceControlSwapchainVK::IsSupported(
+    const impeller::ContextVK& context) {
+  return NDKHelpers::SurfaceControlSupported() &&
+         impeller::CapabilitiesVK::Cast(*context.GetCapabilities())
+             .HasOptionalDeviceExtension(
+                 impeller::OptionalDeviceExtensionVK::kKHRExternalSemaphoreFd);
+}
+
+std::shared_ptr<AndroidSurfaceControlSwapchainVK>
+AndroidSurfaceControlSwapchainVK::Create(
+    const std::shared_ptr<impeller::ContextVK>& context,
+    fml::RefPtr<AndroidNativeWindow> window) {
+  if (!context || !window || !window->IsValid() || !IsSupported(*context)) {
+    return nullptr;
+  }
+  ASurfaceControl* surface_control =
+      NDKHelpers::ASurfaceControl_createFromWindow(window->handle(),
+                                                   "FlutterSurfaceControl");
+  if (!surface_control) {
+    FML_LOG(ERROR) << "Could not create a surface control for the window.";
+    return nullptr;
+  }
+  context->SetOffscreenFormat(impeller::PixelFormat::kR8G8B8A8UNormInt);
+  return std::shared_ptr<AndroidSurfaceControlSwapchainVK>(
+      new AndroidSurfaceControlSwapchainVK(context, std::move(window),
+                                           surface_control));
+}
+
+AndroidSurfaceControlSwapchainVK::AndroidSurfaceControlSwapchainVK(
+    const std::shared_ptr<impeller::ContextVK>& context,
+    fml::RefPtr<AndroidNativeWindow> window,
+    ASurfaceControl* surface_control)
+    : context_(context),
+      window_(std::move(window)),
+      surface_control_(surface_control) {}
+
+AndroidSurfaceControlSwapchainVK::~AndroidSurfaceControlSwapchainVK() {
+  if (auto context = context_.lock()) {
+    [[maybe_unused]] auto result = context->GetDevice().waitIdle();
+  }
+  // Remove the surface control from the window. The buffers still used by the
+  // compositor are destroyed once it releases them.
+  ASurfaceTransaction* transaction = NDKHelpers::ASurfaceTransaction_create();
+  NDKHelpers::ASurfaceTransaction_reparent(transaction, surface_control_,
+                                           nullptr);
+  NDKHelpers::ASurfaceTransaction_apply(transaction);
+  NDKHelpers::ASurfaceTransaction_delete(transaction);
+  NDKHelpers::ASurfaceControl_release(surface_control_);
+}
+
+std::unique_ptr<impeller::Surface>
+AndroidSurfaceControlSwapchainVK::AcquireNextDrawable() {
+  TRACE_EVENT0("flutter", "AndroidSurfaceControlSwapchainVK::Acquire");
+  auto context = context_.lock();
+  if (!context) {
+    return nullptr;
+  }
+  const SkISize window_size = window_->GetSize();
+  const impeller::ISize size(window_size.width(), window_size.height());
+  if (size.IsEmpty()) {
+    return nullptr;
+  }
+
+  std::shared_ptr<Buffer> buffer;
+  {
+    std::unique_lock lock(buffers_mutex_);
+    // The buffers of a previous size of the window are destroyed once they
+    // are released.
+    buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+                                  [&size](const auto& buffer) {
+                                    return buffer->size != size;
+                                  }),
+                   buffers_.end());
+    while (buffers_.size() < kBufferCount) {
+      auto new_buffer = CreateBuffer(context, size);
+      if (!new_buffer) {
+        return nullptr;
+      }
+      buffers_.push_back(std::move(new_buffer));
+    }
+    const auto is_available = [](const auto& buffer) {
+      return buffer->is_available;
+    };
+    if (!buffer_released_.wait_for(
+            lock,
+            std::chrono::milliseconds(kBufferReleaseTimeout.ToMilliseconds()),
+            [&]() {
+              return std::any_of(buffers_.begin(), buffers_.end(),
+                                 is_available);
+            })) {
+      FML_LOG(ERROR) << "The compositor did not release a buffer in time.";
+      return nullptr;
+    }
+    buffer = *std::find_if(buffers_.begin(), buffers_.end(), is_available);
+    buffer->is_available = false;
+  }
+
+  // The compositor may still read the buffer until its release fence
+  // signals.
+  if (buffer->release_fence.is_valid()) {
+    if (!WaitForFence(buffer->release_fence)) {
+      FML_LOG(ERROR) << "Could not wait for the release of a buffer.";
+      ReleaseBuffer(buffer, std::move(buffer->release_fence));
+      return nullptr;
+    }
+    buffer->release_fence.reset();
+  }
+  buffer->final_cmd_buffer.reset();
+  buffer->render_done.reset();
+
+  context->GetGPUTracer()->MarkFrameStart();
+
+  // Buffers whose surface is discarded without being presented go back to
+  // the pool.
+  auto weak_swapchain = weak_from_this();
+  auto release_if_not_presented = std::make_shared<fml::ScopedCleanupClosure>(
+      [weak_swapchain, buffer]() {
+        if (auto swapchain = weak_swapchain.lock()) {
+          swapchain->ReleaseBuffer(buffer, {});
+        }
+      });
+  return impeller::SurfaceVK::WrapSwapchainImage(
+      context,        // context
+      buffer->image,  // swapchain image
+      [weak_swapchain, buffer, release_if_not_presented](
+          std::optional<fml::TimePoint> presentation_time) -> bool {
+        auto swapchain = weak_swapchain.lock();
+        if (!swapchain) {
+          return false;
+        }
+        if (!swapchain->Present(buffer, presentation_time)) {
+          return false;
+        }
+        release_if_not_presented->Release();
+        return true;
+      }  // swap callback
+  );
+}
+
+bool AndroidSurfaceControlSwapchainVK::Present(
+    const std::shared_ptr<Buffer>& buffer,
+    std::optional<fml::TimePoint> presentation_time) {
+  TRACE_EVENT0("flutter", "AndroidSurfaceControlSwapchainVK::Present");
+  auto context_strong = context_.lock();
+  if (!context_strong) {
+    return false;
+  }
+  const auto& context = *context_strong;
+
+  //----------------------------------------------------------------------------
+  /// Transition the image to a layout the compositor can read.
+  ///
+  auto cmd_buffer = context.CreateCommandBuffer();
+  if (!cmd_buffer) {
+    return false;
+  }
+  auto vk_cmd_buffer = impeller::CommandBufferVK::Cast(*cmd_buffer)
+                           .GetEncoder()
+                           ->GetCommandBuffer();
+  {
+    impeller::BarrierVK barrier;
+    barrier.new_layout = vk::ImageLayout::eGeneral;
+    barrier.cmd_buffer = vk_cmd_buffer;
+    barrier.src_access = vk::AccessFlagBits::eColorAttachmentWrite;
+    barrier.src_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+    barrier.dst_access = {};
+    barrier.dst_stage = vk::PipelineStageFlagBits::eBottomOfPipe;
+    if (!buffer->image->SetLayout(barrier).ok()) {
+      return false;
+    }
+    if (vk_cmd_buffer.end() != vk::Result::eSuccess) {
+      return false;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// Signal a semaphore once the image is rendered, and export it as the
+  /// acquire fence of the buffer.
+  ///
+  vk::ExportSemaphoreCreateInfo export_info;
+  export_info.handleTypes = vk::ExternalSemaphoreHandleTypeFlagBits::eSyncFd;
+  vk::SemaphoreCreateInfo semaphore_info;
+  semaphore_info.pNext = &export_info;
+  auto [semaphore_result, semaphore] =
+      context.GetDevice().createSemaphoreUnique(semaphore_info);
+  if (semaphore_result != vk::Result::eSuccess) {
+    FML_LOG(ERROR) << "Could not create the render semaphore: "
+                   << vk::to_string(semaphore_result);
+    return false;
+  }
+  vk::SubmitInfo submit_info;
+  submit_info.setCommandBuffers(vk_cmd_buffer);
+  submit_info.setSignalSemaphores(*semaphore);
+  if (auto result = context.GetGraphicsQueue()->Submit(submit_info, {});
+      result != vk::Result::eSuccess) {
+    FML_LOG(ERROR) << "Could not submit the present barrier: "
+                   << vk::to_string(result);
+    return false;
+  }
+  buffer->final_cmd_buffer = cmd_buffer;
+  buffer->render_done = std::move(semaphore);
+
+  vk::SemaphoreGetFdInfoKHR fd_info;
+  fd_info.semaphore = *buffer->render_done;
+  fd_info.handleType = vk::ExternalSemaphoreHandleTypeFlagBits::eSyncFd;
+  auto [fd_result, acquire_fence] =
+      context.GetDevice().getSemaphoreFdKHR(fd_info);
+  if (fd_result != vk::Result::eSuccess) {
+    // Without a fence, the compositor must not see the buffer before it is
+    // rendered.
+    FML_LOG(ERROR) << "Could not export the render semaphore: "
+                   << vk::to_string(fd_result);
+    [[maybe_unused]] auto result = context.GetDevice().waitIdle();
+    acquire_fence = -1;
+  }
+
+  context.GetGPUTracer()->MarkFrameEnd();
+
+  //----------------------------------------------------------------------------
+  /// Hand the buffer to the compositor.
+  ///
+  ASurfaceTransaction* transaction = NDKHelpers::ASurfaceTransaction_create();
+  // The transaction takes ownership of the fence.
+  NDKHelpers::ASurfaceTransaction_setBuffer(
+      transaction, surface_control_, buffer->hardware_buffer, acquire_fence);
+  if (presentation_time.has_value()) {
+    NDKHelpers::ASurfaceTransaction_setDesiredPresentTime(
+        transaction,
+        presentation_time.value().ToEpochDelta().ToNanoseconds());
+  }
+  NDKHelpers::ASurfaceTransaction_setOnComplete(
+      transaction,
+      new TransactionContext{weak_from_this(), std::move(presented_buffer_)},
+      &OnTransactionComplete);
+  presented_buffer_ = buffer;
+  NDKHelpers::ASurfaceTransaction_apply(transaction);
+  NDKHelpers::ASurfaceTransaction_delete(transaction);
+  return true;
+}
+
+void AndroidSurfaceControlSwapchainVK::ReleaseBuffer(
+    const std::shared_ptr<Buffer>& buffer,
+    fml::UniqueFD release_fence) {
+  {
+    std::scoped_lock lock(buffers_mutex_);
+    buffer->release_fence = std::move(release_fence);
+    buffer->is_available = true;
+  }
+  buffer_released_.notify_one();
+}
+
+void AndroidSurfaceControlSwapchainVK::OnTransactionComplete(
+    void* context,
+    ASurfaceTransactionStats* stats) {
+  std::unique_ptr<TransactionContext> transaction_context(
+      reinterpret_cast<TransactionContext*>(context));
+  auto swapchain = transaction_context->swapchain.lock();
+  if (!swapchain || !transaction_context->previous_buffer) {
+    return;
+  }
+  fml::UniqueFD release_fence(
+      NDKHelpers::ASurfaceTransactionStats_getPreviousReleaseFenceFd(
+          stats, swapchain->surface_control_));
+  swapchain->ReleaseBuffer(transaction_context->previous_buffer,
+                           std::move(release_fence));
+}
+
+std::shared_ptr<AndroidSurfaceControlSwapchainVK::Buffer>
+AndroidSurfaceControlSwapchainVK::CreateBuffer(
+    const std::shared_ptr<impeller::ContextVK>& context,
+    const impeller::ISize& size) {
+  AHardwareBuffer_Desc hardware_buffer_desc = {};
+  hardware_buffer_desc.width = size.width;
+  hardware_buffer_desc.height = size.height;
+  hardware_buffer_desc.layers = 1;
+  hardware_buffer_desc.format = AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM;
+  hardware_buffer_desc.usage = AHARDWAREBUFFER_USAGE_GPU_COLOR_OUTPUT |
+                               AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE |
+                               AHARDWAREBUFFER_USAGE_COMPOSER_OVERLAY;
+  auto buffer = std::make_shared<Buffer>();
+  buffer->context = context;
+  buffer->size = size;
+  if (NDKHelpers::AHardwareBuffer_allocate(&hardware_buffer_desc,
+                                           &buffer->hardware_buffer) != 0) {
+    FML_LOG(ERROR) << "Could not allocate a hardware buffer.";
+    return nullptr;
+  }
+
+  impeller::TextureDescriptor texture_desc;
+  texture_desc.type = impeller::TextureType::kTexture2D;
+  texture_desc.storage_mode = impeller::StorageMode::kDevicePrivate;
+  texture_desc.format = impeller::PixelFormat::kR8G8B8A8UNormInt;
+  texture_desc.size = size;
+  texture_desc.usage = static_cast<impeller::TextureUsageMask>(
+      impeller::TextureUsage::kRenderTarget);
+  buffer->texture_source =
+      std::make_shared<impeller::AndroidHardwareBufferTextureSourceVK>(
+          texture_desc, context->GetDevice(), buffer->hardware_buffer,
+          hardware_buffer_desc);
+  if (!buffer->texture_source->IsValid()) {
+    FML_LOG(ERROR) << "Could not import a hardware buffer.";
+    return nullptr;
+  }
+  buffer->image = std::make_shared<impeller::SwapchainImageVK>(
+      texture_desc, context->GetDevice(), buffer->texture_source->GetImage());
+  if (!buffer->image->IsValid()) {
+    FML_LOG(ERROR) << "Could not wrap the image of a hardware buffer.";
+    return nullptr;
+  }
+  return buffer;
+}
+
+}  // namespace flutter
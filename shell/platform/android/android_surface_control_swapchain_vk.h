@@ -0,0 +1,98 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_SURFACE_CONTROL_SWAPCHAIN_VK_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_SURFACE_CONTROL_SWAPCHAIN_VK_H_
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/fml/unique_fd.h"
+#include "flutter/impeller/renderer/backend/vulkan/context_vk.h"
+#include "flutter/impeller/renderer/surface.h"
+#include "flutter/shell/platform/android/surface/android_native_window.h"
+
+#include <android/surface_control.h>
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A swapchain that renders into a pool of hardware buffers and
+///             presents them on a child surface control of the window with
+///             surface transactions, instead of through the buffer queue of
+///             the window.
+///
+///             Each buffer is handed to the system compositor with a fence
+///             that signals once the GPU has rendered it, and with the time at
+///             which its frame is scheduled to be shown. A buffer is rendered
+///             into again once the compositor has released it, so the only
+///             buffering is that of the pool.
+///
+///             Requires Android 10 (API 29) and VK_KHR_external_semaphore_fd.
+///
+class AndroidSurfaceControlSwapchainVK final
+    : public std::enable_shared_from_this<AndroidSurfaceControlSwapchainVK> {
+ public:
+  /// The number of buffers of the pool.
+  static constexpr size_t kBufferCount = 3u;
+
+  static bool IsSupported(const impeller::ContextVK& context);
+
+  static std::shared_ptr<AndroidSurfaceControlSwapchainVK> Create(
+      const std::shared_ptr<impeller::ContextVK>& context,
+      fml::RefPtr<AndroidNativeWindow> window);
+
+  ~AndroidSurfaceControlSwapchainVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a surface that renders into a buffer released by the
+  ///             compositor, and presents the buffer when it is presented.
+  ///             Buffers of the current size of the window are allocated as
+  ///             needed.
+  ///
+  std::unique_ptr<impeller::Surface> AcquireNextDrawable();
+
+ private:
+  struct Buffer;
+  struct TransactionContext;
+
+  std::weak_ptr<impeller::ContextVK> context_;
+  fml::RefPtr<AndroidNativeWindow> window_;
+  ASurfaceControl* surface_control_ = nullptr;
+  std::mutex buffers_mutex_;
+  std::condition_variable buffer_released_;
+  std::vector<std::shared_ptr<Buffer>> buffers_;
+  // The buffer of the last transaction, which the compositor releases once
+  // the next transaction is applied.
+  std::shared_ptr<Buffer> presented_buffer_;
+
+  AndroidSurfaceControlSwapchainVK(
+      const std::shared_ptr<impeller::ContextVK>& context,
+      fml::RefPtr<AndroidNativeWindow> window,
+      ASurfaceControl* surface_control);
+
+  static std::shared_ptr<Buffer> CreateBuffer(
+      const std::shared_ptr<impeller::ContextVK>& context,
+      const impeller::ISize& size);
+
+  bool Present(const std::shared_ptr<Buffer>& buffer,
+               std::optional<fml::TimePoint> presentation_time);
+
+  void ReleaseBuffer(const std::shared_ptr<Buffer>& buffer,
+                     fml::UniqueFD release_fence);
+
+  static void OnTransactionComplete(void* context,
+                                    ASurfaceTransactionStats* stats);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AndroidSurfaceControlSwapchainVK);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_SURFACE_CONTROL_SWAPCHAIN_VK_H_
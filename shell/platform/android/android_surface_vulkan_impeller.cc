@@ -17,12 +17,13 @@
 namespace flutter {
 
 AndroidSurfaceVulkanImpeller::AndroidSurfaceVulkanImpeller(
-    const std::shared_ptr<AndroidContextVulkanImpeller>& android_context) {
+    const std::shared_ptr<AndroidContextVulkanImpeller>& android_context)
+    : enable_surface_control_(android_context->IsSurfaceControlEnabled()) {
   is_valid_ = android_context->IsValid();
 
-  auto& context_vk =
-      impeller::ContextVK::Cast(*android_context->GetImpellerContext());
-  surface_context_vk_ = context_vk.CreateSurfaceContext();
+  context_vk_ = std::static_pointer_cast<impeller::ContextVK>(
+      android_context->GetImpellerContext());
+  surface_context_vk_ = context_vk_->CreateSurfaceContext();
 }
 
 AndroidSurfaceVulkanImpeller::~AndroidSurfaceVulkanImpeller() = default;
@@ -70,8 +71,14 @@ bool AndroidSurfaceVulkanImpeller::ResourceContextClearCurrent() {
 bool AndroidSurfaceVulkanImpeller::SetNativeWindow(
     fml::RefPtr<AndroidNativeWindow> window) {
   native_window_ = std::move(window);
+  surface_control_swapchain_.reset();
+  surface_context_vk_->SetAcquireSurfaceCallback(nullptr);
   bool success = native_window_ && native_window_->IsValid();
   if (success) {
+    if (enable_surface_control_ && SetSurfaceControlSwapchain()) {
+      return true;
+    }
+
     auto surface =
         surface_context_vk_->CreateAndroidSurface(native_window_->handle());
 
@@ -87,6 +94,27 @@ bool AndroidSurfaceVulkanImpeller::SetNativeWindow(
   return false;
 }
 
+bool AndroidSurfaceVulkanImpeller::SetSurfaceControlSwapchain() {
+  if (!AndroidSurfaceControlSwapchainVK::IsSupported(*context_vk_)) {
+    return false;
+  }
+  auto swapchain =
+      AndroidSurfaceControlSwapchainVK::Create(context_vk_, native_window_);
+  if (!swapchain) {
+    FML_LOG(ERROR) << "Could not create a surface control swapchain. Falling "
+                      "back to a Vulkan swapchain.";
+    return false;
+  }
+  surface_context_vk_->SetAcquireSurfaceCallback(
+      [weak_swapchain = std::weak_ptr(swapchain)]()
+          -> std::unique_ptr<impeller::Surface> {
+        auto swapchain = weak_swapchain.lock();
+        return swapchain ? swapchain->AcquireNextDrawable() : nullptr;
+      });
+  surface_control_swapchain_ = std::move(swapchain);
+  return true;
+}
+
 std::shared_ptr<impeller::Context>
 AndroidSurfaceVulkanImpeller::GetImpellerContext() {
   return surface_context_vk_;
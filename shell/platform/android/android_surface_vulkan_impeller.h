@@ -7,8 +7,10 @@
 
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
+#include "flutter/impeller/renderer/backend/vulkan/context_vk.h"
 #include "flutter/impeller/renderer/backend/vulkan/surface_context_vk.h"
 #include "flutter/shell/platform/android/android_context_vulkan_impeller.h"
+#include "flutter/shell/platform/android/android_surface_control_swapchain_vk.h"
 #include "flutter/shell/platform/android/surface/android_native_window.h"
 #include "flutter/shell/platform/android/surface/android_surface.h"
 
@@ -47,10 +49,15 @@ class AndroidSurfaceVulkanImpeller : public AndroidSurface {
   bool SetNativeWindow(fml::RefPtr<AndroidNativeWindow> window) override;
 
  private:
+  std::shared_ptr<impeller::ContextVK> context_vk_;
   std::shared_ptr<impeller::SurfaceContextVK> surface_context_vk_;
   fml::RefPtr<AndroidNativeWindow> native_window_;
+  const bool enable_surface_control_;
+  std::shared_ptr<AndroidSurfaceControlSwapchainVK> surface_control_swapchain_;
   bool is_valid_ = false;
 
+  bool SetSurfaceControlSwapchain();
+
   FML_DISALLOW_COPY_AND_ASSIGN(AndroidSurfaceVulkanImpeller);
 };
 
@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/android/apk_asset_provider.h"
 
+#include <sys/mman.h>
 #include <unistd.h>
 
 #include <algorithm>
@@ -34,6 +35,63 @@ class APKAssetMapping : public fml::Mapping {
   FML_DISALLOW_COPY_AND_ASSIGN(APKAssetMapping);
 };
 
+// Maps an asset that is stored uncompressed in the APK directly from the APK
+// file, instead of through an AAsset buffer.
+class APKFileAssetMapping : public fml::Mapping {
+ public:
+  static std::unique_ptr<APKFileAssetMapping> Create(AAsset* asset) {
+    off64_t start = 0;
+    off64_t length = 0;
+    // Fails for compressed assets.
+    int fd = AAsset_openFileDescriptor64(asset, &start, &length);
+    if (fd < 0) {
+      return nullptr;
+    }
+    if (length <= 0) {
+      close(fd);
+      return nullptr;
+    }
+    // The offset of a mapping must be page aligned.
+    off64_t page_size = sysconf(_SC_PAGESIZE);
+    off64_t aligned_start = start - (start % page_size);
+    size_t mapping_size = length + (start - aligned_start);
+    void* mapping = mmap64(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, fd,
+                           aligned_start);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+      return nullptr;
+    }
+    return std::unique_ptr<APKFileAssetMapping>(new APKFileAssetMapping(
+        static_cast<uint8_t*>(mapping), mapping_size, start - aligned_start,
+        length));
+  }
+
+  ~APKFileAssetMapping() override { munmap(mapping_, mapping_size_); }
+
+  size_t GetSize() const override { return size_; }
+
+  const uint8_t* GetMapping() const override { return mapping_ + offset_; }
+
+  bool IsDontNeedSafe() const override { return true; }
+
+ private:
+  APKFileAssetMapping(uint8_t* mapping,
+                      size_t mapping_size,
+                      size_t offset,
+                      size_t size)
+      : mapping_(mapping),
+        mapping_size_(mapping_size),
+        offset_(offset),
+        size_(size) {}
+
+  uint8_t* const mapping_;
+  const size_t mapping_size_;
+  const size_t offset_;
+  const size_t size_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(APKFileAssetMapping);
+};
+
 class APKAssetProviderImpl : public APKAssetProviderInternal {
  public:
   explicit APKAssetProviderImpl(JNIEnv* env,
@@ -50,8 +108,25 @@ class APKAssetProviderImpl : public APKAssetProviderInternal {
       const std::string& asset_name) const override {
     std::stringstream ss;
     ss << directory_.c_str() << "/" << asset_name;
-    AAsset* asset = AAssetManager_open(asset_manager_, ss.str().c_str(),
-                                       AASSET_MODE_BUFFER);
+    std::string path = ss.str();
+
+    // Uncompressed assets are mapped from the APK, so that their pages are
+    // only read in when they are accessed and can be dropped under memory
+    // pressure.
+    AAsset* asset = AAssetManager_open(asset_manager_, path.c_str(),
+                                       AASSET_MODE_STREAMING);
+    if (!asset) {
+      return nullptr;
+    }
+    std::unique_ptr<fml::Mapping> file_mapping =
+        APKFileAssetMapping::Create(asset);
+    AAsset_close(asset);
+    if (file_mapping) {
+      return file_mapping;
+    }
+
+    asset = AAssetManager_open(asset_manager_, path.c_str(),
+                               AASSET_MODE_BUFFER);
     if (!asset) {
       return nullptr;
     }
@@ -13,13 +13,15 @@ AndroidExternalViewEmbedder::AndroidExternalViewEmbedder(
     const AndroidContext& android_context,
     std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
     std::shared_ptr<AndroidSurfaceFactory> surface_factory,
-    const TaskRunners& task_runners)
+    const TaskRunners& task_runners,
+    bool merge_threads)
     : ExternalViewEmbedder(),
       android_context_(android_context),
       jni_facade_(std::move(jni_facade)),
       surface_factory_(std::move(surface_factory)),
       surface_pool_(std::make_unique<SurfacePool>()),
-      task_runners_(task_runners) {}
+      task_runners_(task_runners),
+      merge_threads_(merge_threads) {}
 
 // |ExternalViewEmbedder|
 void AndroidExternalViewEmbedder::PrerollCompositeEmbeddedView(
@@ -154,18 +156,23 @@ void AndroidExternalViewEmbedder::SubmitFlutterView(
   for (int64_t view_id : composition_order_) {
     SkRect view_rect = GetViewRect(view_id);
     const EmbeddedViewParams& params = view_params_.at(view_id);
+    SkSize view_size = SkSize::Make(
+        params.sizePoints().width() * device_pixel_ratio_,
+        params.sizePoints().height() * device_pixel_ratio_);
     // Display the platform view. If it's already displayed, then it's
     // just positioned and sized.
-    jni_facade_->FlutterViewOnDisplayPlatformView(
-        view_id,             //
-        view_rect.x(),       //
-        view_rect.y(),       //
-        view_rect.width(),   //
-        view_rect.height(),  //
-        params.sizePoints().width() * device_pixel_ratio_,
-        params.sizePoints().height() * device_pixel_ratio_,
-        params.mutatorsStack()  //
-    );
+    RunOnPlatformThread([jni_facade = jni_facade_, view_id, view_rect,
+                         view_size, mutators = params.mutatorsStack()]() {
+      jni_facade->FlutterViewOnDisplayPlatformView(view_id,              //
+                                                   view_rect.x(),        //
+                                                   view_rect.y(),        //
+                                                   view_rect.width(),    //
+                                                   view_rect.height(),   //
+                                                   view_size.width(),    //
+                                                   view_size.height(),   //
+                                                   mutators              //
+      );
+    });
     std::unordered_map<int64_t, SkRect>::const_iterator overlay =
         overlay_layers.find(view_id);
     if (overlay == overlay_layers.end()) {
@@ -189,19 +196,37 @@ AndroidExternalViewEmbedder::CreateSurfaceIfNeeded(GrDirectContext* context,
                                                    int64_t view_id,
                                                    EmbedderViewSlice* slice,
                                                    const SkRect& rect) {
-  std::shared_ptr<OverlayLayer> layer = surface_pool_->GetLayer(
-      context, android_context_, jni_facade_, surface_factory_);
+  std::shared_ptr<OverlayLayer> layer;
+  if (merge_threads_) {
+    layer = surface_pool_->GetLayer(context, android_context_, jni_facade_,
+                                    surface_factory_);
+  } else {
+    // Overlay surfaces are created by a Java method, so a new layer is
+    // allocated on the platform thread. Layers are recycled across frames,
+    // so this rarely blocks the raster thread.
+    fml::AutoResetWaitableEvent latch;
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetPlatformTaskRunner(), [&]() {
+          layer = surface_pool_->GetLayer(context, android_context_,
+                                          jni_facade_, surface_factory_);
+          latch.Signal();
+        });
+    latch.Wait();
+  }
 
   std::unique_ptr<SurfaceFrame> frame =
       layer->surface->AcquireFrame(frame_size_);
   // Display the overlay surface. If it's already displayed, then it's
   // just positioned and sized.
-  jni_facade_->FlutterViewDisplayOverlaySurface(layer->id,     //
-                                                rect.x(),      //
-                                                rect.y(),      //
-                                                rect.width(),  //
-                                                rect.height()  //
-  );
+  RunOnPlatformThread(
+      [jni_facade = jni_facade_, layer_id = layer->id, rect]() {
+        jni_facade->FlutterViewDisplayOverlaySurface(layer_id,      //
+                                                     rect.x(),      //
+                                                     rect.y(),      //
+                                                     rect.width(),  //
+                                                     rect.height()  //
+        );
+      });
   DlCanvas* overlay_canvas = frame->Canvas();
   overlay_canvas->Clear(DlColor::kTransparent());
   // Offset the picture since its absolute position on the scene is determined
@@ -217,6 +242,14 @@ PostPrerollResult AndroidExternalViewEmbedder::PostPrerollAction(
   if (!FrameHasPlatformLayers()) {
     return PostPrerollResult::kSuccess;
   }
+  if (!merge_threads_) {
+    // Surface switch requires to resubmit the frame. The switch is done by
+    // the Java methods of this frame, which `EndFrame` waits for.
+    if (previous_frame_view_count_ == 0) {
+      return PostPrerollResult::kResubmitFrame;
+    }
+    return PostPrerollResult::kSuccess;
+  }
   if (!raster_thread_merger->IsMerged()) {
     // The raster thread merger may be disabled if the rasterizer is being
     // created or teared down.
@@ -249,6 +282,34 @@ DlCanvas* AndroidExternalViewEmbedder::GetRootCanvas() {
   return nullptr;
 }
 
+void AndroidExternalViewEmbedder::RunOnPlatformThread(fml::closure task) {
+  if (merge_threads_) {
+    // The threads are merged while the frame has platform views.
+    task();
+    return;
+  }
+  platform_tasks_.push_back(std::move(task));
+}
+
+void AndroidExternalViewEmbedder::FlushPlatformTasks(bool wait) {
+  TRACE_EVENT0("flutter", "AndroidExternalViewEmbedder::FlushPlatformTasks");
+  auto latch = std::make_shared<fml::AutoResetWaitableEvent>();
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetPlatformTaskRunner(),
+      [jni_facade = jni_facade_, tasks = std::move(platform_tasks_), latch]() {
+        jni_facade->FlutterViewBeginFrame();
+        for (const fml::closure& task : tasks) {
+          task();
+        }
+        jni_facade->FlutterViewEndFrame();
+        latch->Signal();
+      });
+  platform_tasks_.clear();
+  if (wait) {
+    latch->Wait();
+  }
+}
+
 void AndroidExternalViewEmbedder::Reset() {
   previous_frame_view_count_ = composition_order_.size();
 
@@ -260,6 +321,11 @@ void AndroidExternalViewEmbedder::Reset() {
 void AndroidExternalViewEmbedder::BeginFrame(
     GrDirectContext* context,
     const fml::RefPtr<fml::RasterThreadMerger>& raster_thread_merger) {
+  // When the threads aren't merged, the Java method is called by the task
+  // posted at the end of the frame.
+  if (!merge_threads_) {
+    return;
+  }
   // JNI method must be called on the platform thread.
   if (raster_thread_merger->IsOnPlatformThread()) {
     jni_facade_->FlutterViewBeginFrame();
@@ -297,6 +363,17 @@ void AndroidExternalViewEmbedder::EndFrame(
     bool should_resubmit_frame,
     const fml::RefPtr<fml::RasterThreadMerger>& raster_thread_merger) {
   surface_pool_->RecycleLayers();
+  if (!merge_threads_) {
+    // The Java methods also remove the platform views that are no longer
+    // displayed, so they run for the first frame without platform views.
+    // When the frame must be resubmitted, the surfaces are switched by these
+    // methods before the frame is drawn again.
+    if (FrameHasPlatformLayers() || previous_frame_view_count_ > 0) {
+      FlushPlatformTasks(/*wait=*/should_resubmit_frame);
+    }
+    platform_tasks_.clear();
+    return;
+  }
   // JNI method must be called on the platform thread.
   if (raster_thread_merger->IsOnPlatformThread()) {
     jni_facade_->FlutterViewEndFrame();
@@ -305,7 +382,7 @@ void AndroidExternalViewEmbedder::EndFrame(
 
 // |ExternalViewEmbedder|
 bool AndroidExternalViewEmbedder::SupportsDynamicThreadMerging() {
-  return true;
+  return merge_threads_;
 }
 
 // |ExternalViewEmbedder|
@@ -6,9 +6,11 @@
 #define FLUTTER_SHELL_PLATFORM_ANDROID_EXTERNAL_VIEW_EMBEDDER_EXTERNAL_VIEW_EMBEDDER_H_
 
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/common/task_runners.h"
 #include "flutter/flow/embedded_views.h"
+#include "flutter/fml/closure.h"
 #include "flutter/shell/platform/android/context/android_context.h"
 #include "flutter/shell/platform/android/external_view_embedder/surface_pool.h"
 #include "flutter/shell/platform/android/jni/platform_view_android_jni.h"
@@ -26,13 +28,23 @@ namespace flutter {
 /// that render above (by Z order) the Android view corresponding to
 /// |flutter::PlatformViewLayer|.
 ///
+/// By default, the raster thread is merged with the platform thread while
+/// platform views are on screen, since the Java methods must be called on the
+/// platform thread. When the embedder is created with
+/// `merge_threads = false`, the platform views are instead positioned by a
+/// single task posted to the platform thread at the end of each frame, and
+/// the overlay surfaces are rendered on the raster thread. This is used when
+/// the surfaces present through surface control transactions, so that frames
+/// with platform views aren't serialized with the platform thread.
+///
 class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
  public:
   AndroidExternalViewEmbedder(
       const AndroidContext& android_context,
       std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
       std::shared_ptr<AndroidSurfaceFactory> surface_factory,
-      const TaskRunners& task_runners);
+      const TaskRunners& task_runners,
+      bool merge_threads = true);
 
   // |ExternalViewEmbedder|
   void PrerollCompositeEmbeddedView(
@@ -105,6 +117,14 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
   // The task runners.
   const TaskRunners task_runners_;
 
+  // Whether the raster thread is merged with the platform thread while
+  // platform views are on screen.
+  const bool merge_threads_;
+
+  // When the threads aren't merged, the Java method calls of the current
+  // frame, which are run in order by a task on the platform thread.
+  std::vector<fml::closure> platform_tasks_;
+
   // The size of the root canvas.
   SkISize frame_size_;
 
@@ -126,13 +146,21 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
   std::unordered_map<int64_t, EmbeddedViewParams> view_params_;
 
   // The number of platform views in the previous frame.
-  int64_t previous_frame_view_count_;
+  int64_t previous_frame_view_count_ = 0;
 
   // Destroys the surfaces created from the surface factory.
   // This method schedules a task on the platform thread, and waits for
   // the task until it completes.
   void DestroySurfaces();
 
+  // Runs `task` on the platform thread. If the threads aren't merged, the
+  // task is queued until the end of the frame.
+  void RunOnPlatformThread(fml::closure task);
+
+  // Posts the queued Java method calls of the frame to the platform thread.
+  // If `wait` is true, this method blocks until they have run.
+  void FlushPlatformTasks(bool wait);
+
   // Resets the state.
   void Reset();
 
@@ -953,6 +953,53 @@ TEST(AndroidExternalViewEmbedder, SupportsDynamicThreadMerging) {
   ASSERT_TRUE(embedder->SupportsDynamicThreadMerging());
 }
 
+TEST(AndroidExternalViewEmbedder, PositionsPlatformViewsWithoutThreadMerging) {
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto android_context = AndroidContext(AndroidRenderingAPI::kSoftware);
+  auto embedder = std::make_unique<AndroidExternalViewEmbedder>(
+      android_context, jni_mock, nullptr, GetTaskRunnersForFixture(),
+      /*merge_threads=*/false);
+  ASSERT_FALSE(embedder->SupportsDynamicThreadMerging());
+
+  // The rasterizer doesn't create a thread merger for this embedder, and the
+  // Java methods of the frame are called by a task run on the platform thread
+  // at the end of the frame.
+  EXPECT_CALL(*jni_mock, FlutterViewBeginFrame()).Times(0);
+  embedder->BeginFrame(nullptr, nullptr);
+  embedder->PrepareFlutterView(kImplicitViewId, SkISize::Make(100, 100), 1.0);
+
+  SkMatrix matrix;
+  MutatorsStack stack;
+  stack.PushTransform(SkMatrix::Translate(0, 0));
+  embedder->PrerollCompositeEmbeddedView(
+      0, std::make_unique<EmbeddedViewParams>(matrix, SkSize::Make(10, 10),
+                                              stack));
+
+  // Surface switch requires to resubmit the frame.
+  ASSERT_EQ(PostPrerollResult::kResubmitFrame,
+            embedder->PostPrerollAction(nullptr));
+
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      SkSurfaces::Null(100, 100), framebuffer_info,
+      [](const SurfaceFrame& surface_frame, DlCanvas* canvas) {
+        return true;
+      },
+      /*frame_size=*/SkISize::Make(100, 100));
+  EXPECT_CALL(*jni_mock, FlutterViewOnDisplayPlatformView).Times(0);
+  embedder->SubmitFlutterView(nullptr, nullptr, std::move(surface_frame));
+  ::testing::Mock::VerifyAndClearExpectations(jni_mock.get());
+
+  {
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*jni_mock, FlutterViewBeginFrame());
+    EXPECT_CALL(*jni_mock, FlutterViewOnDisplayPlatformView(0, 0, 0, 10, 10,
+                                                            10, 10, stack));
+    EXPECT_CALL(*jni_mock, FlutterViewEndFrame());
+  }
+  embedder->EndFrame(/*should_resubmit_frame=*/true, nullptr);
+}
+
 TEST(AndroidExternalViewEmbedder, DisableThreadMerger) {
   auto jni_mock = std::make_shared<JNIMock>();
   auto android_context = AndroidContext(AndroidRenderingAPI::kSoftware);
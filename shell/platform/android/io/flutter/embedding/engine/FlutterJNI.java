@@ -542,17 +542,52 @@ public class FlutterJNI {
   public static native void nativeImageHeaderCallback(
       long imageGeneratorPointer, int width, int height);
 
+  /** Thrown to stop an {@link ImageDecoder} once the header of the image is decoded. */
+  private static final class ImageHeaderDecodedException extends RuntimeException {}
+
+  /**
+   * Called by native to read the size of an image before decoding it with {@link #decodeImage}.
+   * The size is reported through {@link #nativeImageHeaderCallback}, and is not reported if the
+   * image cannot be decoded. Like {@link #decodeImage}, this method is expected to be called on a
+   * worker thread.
+   */
+  @SuppressWarnings("unused")
+  @VisibleForTesting
+  public static void decodeImageHeader(@NonNull ByteBuffer buffer, long imageGeneratorAddress) {
+    if (Build.VERSION.SDK_INT >= 28) {
+      ImageDecoder.Source source = ImageDecoder.createSource(buffer);
+      try {
+        ImageDecoder.decodeBitmap(
+            source,
+            (decoder, info, src) -> {
+              Size size = info.getSize();
+              nativeImageHeaderCallback(imageGeneratorAddress, size.getWidth(), size.getHeight());
+              // ImageDecoder cannot only decode the header, so stop it before it allocates and
+              // decodes the pixels.
+              throw new ImageHeaderDecodedException();
+            });
+      } catch (ImageHeaderDecodedException e) {
+        // The header was decoded.
+      } catch (IOException e) {
+        Log.e(TAG, "Failed to decode image header", e);
+      }
+    }
+  }
+
   /**
    * Called by native as a fallback method of image decoding. There are other ways to decode images
    * on lower API levels, they involve copying the native data _and_ do not support any additional
    * formats, whereas ImageDecoder supports HEIF images. Unlike most other methods called from
    * native, this method is expected to be called on a worker thread, since it only uses thread safe
    * methods and may take multiple frames to complete.
+   *
+   * <p>The image is scaled to {@code targetWidth} by {@code targetHeight} while it is decoded, so
+   * that decoding a large image for a small target does not allocate the full size bitmap.
    */
   @SuppressWarnings("unused")
   @VisibleForTesting
   @Nullable
-  public static Bitmap decodeImage(@NonNull ByteBuffer buffer, long imageGeneratorAddress) {
+  public static Bitmap decodeImage(@NonNull ByteBuffer buffer, int targetWidth, int targetHeight) {
     if (Build.VERSION.SDK_INT >= 28) {
       ImageDecoder.Source source = ImageDecoder.createSource(buffer);
       try {
@@ -566,9 +601,7 @@ public class FlutterJNI {
               // `SkImage::MakeFromAHardwareBuffer` via dynamic lookups:
               // https://skia-review.googlesource.com/c/skia/+/428960
               decoder.setAllocator(ImageDecoder.ALLOCATOR_SOFTWARE);
-
-              Size size = info.getSize();
-              nativeImageHeaderCallback(imageGeneratorAddress, size.getWidth(), size.getHeight());
+              decoder.setTargetSize(targetWidth, targetHeight);
             });
       } catch (IOException e) {
         Log.e(TAG, "Failed to decode image", e);
@@ -1393,6 +1426,28 @@ public class FlutterJNI {
   private native void nativeLoadDartDeferredLibrary(
       long nativeShellHolderId, int loadingUnitId, @NonNull String[] searchPaths);
 
+  /**
+   * Opens the shared library of a Dart deferred library on a background thread, ahead of its load.
+   *
+   * <p>A later call to {@link #loadDartDeferredLibrary(int, String[])} with the same loading unit
+   * reuses the opened library instead of waiting for it to be read and linked. Call this when the
+   * application is likely to load the loading unit soon, for example once its deferred component
+   * has been installed.
+   *
+   * @param loadingUnitId The loading unit to prefetch.
+   * @param searchPaths An array of paths in which to look for valid dart shared libraries, in the
+   *     same format as for {@link #loadDartDeferredLibrary(int, String[])}.
+   */
+  @UiThread
+  public void prefetchDartDeferredLibrary(int loadingUnitId, @NonNull String[] searchPaths) {
+    ensureRunningOnMainThread();
+    ensureAttachedToNative();
+    nativePrefetchDartDeferredLibrary(nativeShellHolderId, loadingUnitId, searchPaths);
+  }
+
+  private native void nativePrefetchDartDeferredLibrary(
+      long nativeShellHolderId, int loadingUnitId, @NonNull String[] searchPaths);
+
   /**
    * Adds the specified AssetManager as an APKAssetResolver in the Flutter Engine's AssetManager.
    *
@@ -106,6 +106,10 @@ public class PlayStoreDeferredComponentManager implements DeferredComponentManag
               if (sessionIdToLoadingUnitId.get(sessionId) > 0) {
                 loadDartLibrary(
                     sessionIdToLoadingUnitId.get(sessionId), sessionIdToName.get(sessionId));
+              } else {
+                // Installing a component by name hints that its Dart libraries will be loaded
+                // soon, so open them ahead of their load.
+                prefetchDartLibraries(sessionIdToName.get(sessionId));
               }
               if (channel != null) {
                 channel.completeInstallSuccess(sessionIdToName.get(sessionId));
@@ -404,6 +408,37 @@ public class PlayStoreDeferredComponentManager implements DeferredComponentManag
       return;
     }
 
+    flutterJNI.loadDartDeferredLibrary(
+        loadingUnitId, getSearchPaths(loadingUnitId, componentName));
+  }
+
+  /**
+   * Opens the shared library of a loading unit in the background, so that a later call to {@link
+   * #loadDartLibrary(int, String)} for the same loading unit doesn't wait for it to be read and
+   * linked. The deferred component containing the loading unit must already be installed.
+   */
+  public void prefetchDartLibrary(int loadingUnitId, @NonNull String componentName) {
+    if (!verifyJNI()) {
+      return;
+    }
+    if (loadingUnitId < 0) {
+      return;
+    }
+
+    flutterJNI.prefetchDartDeferredLibrary(
+        loadingUnitId, getSearchPaths(loadingUnitId, componentName));
+  }
+
+  private void prefetchDartLibraries(@NonNull String componentName) {
+    for (int i = 0; i < loadingUnitIdToComponentNames.size(); i++) {
+      if (componentName.equals(loadingUnitIdToComponentNames.valueAt(i))) {
+        prefetchDartLibrary(loadingUnitIdToComponentNames.keyAt(i), componentName);
+      }
+    }
+  }
+
+  @NonNull
+  private String[] getSearchPaths(int loadingUnitId, @NonNull String componentName) {
     String aotSharedLibraryName = loadingUnitIdToSharedLibraryNames.get(loadingUnitId);
     if (aotSharedLibraryName == null) {
       // If the filename is not specified, we use dart's loading unit naming convention.
@@ -476,8 +511,7 @@ public class PlayStoreDeferredComponentManager implements DeferredComponentManag
       searchPaths.add(path);
     }
 
-    flutterJNI.loadDartDeferredLibrary(
-        loadingUnitId, searchPaths.toArray(new String[searchPaths.size()]));
+    return searchPaths.toArray(new String[searchPaths.size()]);
   }
 
   public boolean uninstallDeferredComponent(int loadingUnitId, @Nullable String componentName) {
@@ -9,6 +9,8 @@
 #include "flutter/fml/logging.h"
 
 #include <android/hardware_buffer.h>
+#include <android/imagedecoder.h>
+#include <android/surface_control.h>
 #include <dlfcn.h>
 
 namespace flutter {
@@ -24,6 +26,56 @@ typedef void (*fp_AHardwareBuffer_describe)(AHardwareBuffer* buffer,
                                             AHardwareBuffer_Desc* desc);
 typedef EGLClientBuffer (*fp_eglGetNativeClientBufferANDROID)(
     AHardwareBuffer* buffer);
+typedef int (*fp_AHardwareBuffer_allocate)(const AHardwareBuffer_Desc* desc,
+                                           AHardwareBuffer** out_buffer);
+typedef int (*fp_AHardwareBuffer_lock)(AHardwareBuffer* buffer,
+                                       uint64_t usage,
+                                       int32_t fence,
+                                       const ARect* rect,
+                                       void** out_virtual_address);
+typedef int (*fp_AHardwareBuffer_unlock)(AHardwareBuffer* buffer,
+                                         int32_t* fence);
+typedef ASurfaceControl* (*fp_ASurfaceControl_createFromWindow)(
+    ANativeWindow* parent,
+    const char* debug_name);
+typedef void (*fp_ASurfaceControl_release)(ASurfaceControl* surface_control);
+typedef ASurfaceTransaction* (*fp_ASurfaceTransaction_create)();
+typedef void (*fp_ASurfaceTransaction_delete)(ASurfaceTransaction* transaction);
+typedef void (*fp_ASurfaceTransaction_apply)(ASurfaceTransaction* transaction);
+typedef void (*fp_ASurfaceTransaction_setBuffer)(
+    ASurfaceTransaction* transaction,
+    ASurfaceControl* surface_control,
+    AHardwareBuffer* buffer,
+    int acquire_fence_fd);
+typedef void (*fp_ASurfaceTransaction_setDesiredPresentTime)(
+    ASurfaceTransaction* transaction,
+    int64_t desired_present_time);
+typedef void (*fp_ASurfaceTransaction_setOnComplete)(
+    ASurfaceTransaction* transaction,
+    void* context,
+    ASurfaceTransaction_OnComplete func);
+typedef void (*fp_ASurfaceTransaction_reparent)(
+    ASurfaceTransaction* transaction,
+    ASurfaceControl* surface_control,
+    ASurfaceControl* new_parent);
+typedef int (*fp_ASurfaceTransactionStats_getPreviousReleaseFenceFd)(
+    ASurfaceTransactionStats* stats,
+    ASurfaceControl* surface_control);
+typedef int (*fp_AImageDecoder_createFromBuffer)(const void* buffer,
+                                                 size_t length,
+                                                 AImageDecoder** out_decoder);
+typedef int (*fp_AImageDecoder_setAndroidBitmapFormat)(AImageDecoder* decoder,
+                                                       int32_t format);
+typedef int (*fp_AImageDecoder_setTargetSize)(AImageDecoder* decoder,
+                                              int32_t width,
+                                              int32_t height);
+typedef int (*fp_AImageDecoder_setDataSpace)(AImageDecoder* decoder,
+                                             int32_t data_space);
+typedef int (*fp_AImageDecoder_decodeImage)(AImageDecoder* decoder,
+                                            void* pixels,
+                                            size_t stride,
+                                            size_t size);
+typedef void (*fp_AImageDecoder_delete)(AImageDecoder* decoder);
 
 AHardwareBuffer* (*_AHardwareBuffer_fromHardwareBuffer)(
     JNIEnv* env,
@@ -34,6 +86,30 @@ void (*_AHardwareBuffer_describe)(AHardwareBuffer* buffer,
                                   AHardwareBuffer_Desc* desc) = nullptr;
 EGLClientBuffer (*_eglGetNativeClientBufferANDROID)(AHardwareBuffer* buffer) =
     nullptr;
+fp_AHardwareBuffer_allocate _AHardwareBuffer_allocate = nullptr;
+fp_AHardwareBuffer_lock _AHardwareBuffer_lock = nullptr;
+fp_AHardwareBuffer_unlock _AHardwareBuffer_unlock = nullptr;
+fp_ASurfaceControl_createFromWindow _ASurfaceControl_createFromWindow =
+    nullptr;
+fp_ASurfaceControl_release _ASurfaceControl_release = nullptr;
+fp_ASurfaceTransaction_create _ASurfaceTransaction_create = nullptr;
+fp_ASurfaceTransaction_delete _ASurfaceTransaction_delete = nullptr;
+fp_ASurfaceTransaction_apply _ASurfaceTransaction_apply = nullptr;
+fp_ASurfaceTransaction_setBuffer _ASurfaceTransaction_setBuffer = nullptr;
+fp_ASurfaceTransaction_setDesiredPresentTime
+    _ASurfaceTransaction_setDesiredPresentTime = nullptr;
+fp_ASurfaceTransaction_setOnComplete _ASurfaceTransaction_setOnComplete =
+    nullptr;
+fp_ASurfaceTransaction_reparent _ASurfaceTransaction_reparent = nullptr;
+fp_ASurfaceTransactionStats_getPreviousReleaseFenceFd
+    _ASurfaceTransactionStats_getPreviousReleaseFenceFd = nullptr;
+fp_AImageDecoder_createFromBuffer _AImageDecoder_createFromBuffer = nullptr;
+fp_AImageDecoder_setAndroidBitmapFormat
+    _AImageDecoder_setAndroidBitmapFormat = nullptr;
+fp_AImageDecoder_setTargetSize _AImageDecoder_setTargetSize = nullptr;
+fp_AImageDecoder_setDataSpace _AImageDecoder_setDataSpace = nullptr;
+fp_AImageDecoder_decodeImage _AImageDecoder_decodeImage = nullptr;
+fp_AImageDecoder_delete _AImageDecoder_delete = nullptr;
 
 std::once_flag init_once;
 
@@ -66,6 +142,106 @@ void InitOnceCallback() {
           ->ResolveFunction<fp_AHardwareBuffer_describe>(
               "AHardwareBuffer_describe")
           .value_or(nullptr);
+  _AHardwareBuffer_allocate =
+      android
+          ->ResolveFunction<fp_AHardwareBuffer_allocate>(
+              "AHardwareBuffer_allocate")
+          .value_or(nullptr);
+  _AHardwareBuffer_lock =
+      android->ResolveFunction<fp_AHardwareBuffer_lock>("AHardwareBuffer_lock")
+          .value_or(nullptr);
+  _AHardwareBuffer_unlock = android
+                                ->ResolveFunction<fp_AHardwareBuffer_unlock>(
+                                    "AHardwareBuffer_unlock")
+                                .value_or(nullptr);
+  _ASurfaceControl_createFromWindow =
+      android
+          ->ResolveFunction<fp_ASurfaceControl_createFromWindow>(
+              "ASurfaceControl_createFromWindow")
+          .value_or(nullptr);
+  _ASurfaceControl_release =
+      android
+          ->ResolveFunction<fp_ASurfaceControl_release>(
+              "ASurfaceControl_release")
+          .value_or(nullptr);
+  _ASurfaceTransaction_create =
+      android
+          ->ResolveFunction<fp_ASurfaceTransaction_create>(
+              "ASurfaceTransaction_create")
+          .value_or(nullptr);
+  _ASurfaceTransaction_delete =
+      android
+          ->ResolveFunction<fp_ASurfaceTransaction_delete>(
+              "ASurfaceTransaction_delete")
+          .value_or(nullptr);
+  _ASurfaceTransaction_apply =
+      android
+          ->ResolveFunction<fp_ASurfaceTransaction_apply>(
+              "ASurfaceTransaction_apply")
+          .value_or(nullptr);
+  _ASurfaceTransaction_setBuffer =
+      android
+          ->ResolveFunction<fp_ASurfaceTransaction_setBuffer>(
+              "ASurfaceTransaction_setBuffer")
+          .value_or(nullptr);
+  _ASurfaceTransaction_setDesiredPresentTime =
+      android
+          ->ResolveFunction<fp_ASurfaceTransaction_setDesiredPresentTime>(
+              "ASurfaceTransaction_setDesiredPresentTime")
+          .value_or(nullptr);
+  _ASurfaceTransaction_setOnComplete =
+      android
+          ->ResolveFunction<fp_ASurfaceTransaction_setOnComplete>(
+              "ASurfaceTransaction_setOnComplete")
+          .value_or(nullptr);
+  _ASurfaceTransaction_reparent =
+      android
+          ->ResolveFunction<fp_ASurfaceTransaction_reparent>(
+              "ASurfaceTransaction_reparent")
+          .value_or(nullptr);
+  _ASurfaceTransactionStats_getPreviousReleaseFenceFd =
+      android
+          ->ResolveFunction<
+              fp_ASurfaceTransactionStats_getPreviousReleaseFenceFd>(
+              "ASurfaceTransactionStats_getPreviousReleaseFenceFd")
+          .value_or(nullptr);
+
+  // AImageDecoder lives in libjnigraphics, which may not be loadable on older
+  // devices.
+  static fml::RefPtr<fml::NativeLibrary> jnigraphics =
+      fml::NativeLibrary::Create("libjnigraphics.so");
+  if (jnigraphics.get() == nullptr) {
+    return;
+  }
+  _AImageDecoder_createFromBuffer =
+      jnigraphics
+          ->ResolveFunction<fp_AImageDecoder_createFromBuffer>(
+              "AImageDecoder_createFromBuffer")
+          .value_or(nullptr);
+  _AImageDecoder_setAndroidBitmapFormat =
+      jnigraphics
+          ->ResolveFunction<fp_AImageDecoder_setAndroidBitmapFormat>(
+              "AImageDecoder_setAndroidBitmapFormat")
+          .value_or(nullptr);
+  _AImageDecoder_setTargetSize =
+      jnigraphics
+          ->ResolveFunction<fp_AImageDecoder_setTargetSize>(
+              "AImageDecoder_setTargetSize")
+          .value_or(nullptr);
+  _AImageDecoder_setDataSpace =
+      jnigraphics
+          ->ResolveFunction<fp_AImageDecoder_setDataSpace>(
+              "AImageDecoder_setDataSpace")
+          .value_or(nullptr);
+  _AImageDecoder_decodeImage =
+      jnigraphics
+          ->ResolveFunction<fp_AImageDecoder_decodeImage>(
+              "AImageDecoder_decodeImage")
+          .value_or(nullptr);
+  _AImageDecoder_delete =
+      jnigraphics
+          ->ResolveFunction<fp_AImageDecoder_delete>("AImageDecoder_delete")
+          .value_or(nullptr);
 }
 
 }  // namespace
@@ -114,4 +290,183 @@ EGLClientBuffer NDKHelpers::eglGetNativeClientBufferANDROID(
   return _eglGetNativeClientBufferANDROID(buffer);
 }
 
+int NDKHelpers::AHardwareBuffer_allocate(const AHardwareBuffer_Desc* desc,
+                                         AHardwareBuffer** out_buffer) {
+  NDKHelpers::Init();
+  FML_CHECK(_AHardwareBuffer_allocate != nullptr);
+  return _AHardwareBuffer_allocate(desc, out_buffer);
+}
+
+int NDKHelpers::AHardwareBuffer_lock(AHardwareBuffer* buffer,
+                                     uint64_t usage,
+                                     int32_t fence,
+                                     const ARect* rect,
+                                     void** out_virtual_address) {
+  NDKHelpers::Init();
+  FML_CHECK(_AHardwareBuffer_lock != nullptr);
+  return _AHardwareBuffer_lock(buffer, usage, fence, rect, out_virtual_address);
+}
+
+int NDKHelpers::AHardwareBuffer_unlock(AHardwareBuffer* buffer,
+                                       int32_t* fence) {
+  NDKHelpers::Init();
+  FML_CHECK(_AHardwareBuffer_unlock != nullptr);
+  return _AHardwareBuffer_unlock(buffer, fence);
+}
+
+bool NDKHelpers::SurfaceControlSupported() {
+  NDKHelpers::Init();
+  return _ASurfaceControl_createFromWindow != nullptr &&
+         _ASurfaceControl_release != nullptr &&
+         _ASurfaceTransaction_create != nullptr &&
+         _ASurfaceTransaction_delete != nullptr &&
+         _ASurfaceTransaction_apply != nullptr &&
+         _ASurfaceTransaction_setBuffer != nullptr &&
+         _ASurfaceTransaction_setDesiredPresentTime != nullptr &&
+         _ASurfaceTransaction_setOnComplete != nullptr &&
+         _ASurfaceTransaction_reparent != nullptr &&
+         _ASurfaceTransactionStats_getPreviousReleaseFenceFd != nullptr &&
+         _AHardwareBuffer_allocate != nullptr &&
+         _AHardwareBuffer_describe != nullptr &&
+         _AHardwareBuffer_release != nullptr;
+}
+
+ASurfaceControl* NDKHelpers::ASurfaceControl_createFromWindow(
+    ANativeWindow* parent,
+    const char* debug_name) {
+  NDKHelpers::Init();
+  FML_CHECK(_ASurfaceControl_createFromWindow != nullptr);
+  return _ASurfaceControl_createFromWindow(parent, debug_name);
+}
+
+void NDKHelpers::ASurfaceControl_release(ASurfaceControl* surface_control) {
+  NDKHelpers::Init();
+  FML_CHECK(_ASurfaceControl_release != nullptr);
+  _ASurfaceControl_release(surface_control);
+}
+
+ASurfaceTransaction* NDKHelpers::ASurfaceTransaction_create() {
+  NDKHelpers::Init();
+  FML_CHECK(_ASurfaceTransaction_create != nullptr);
+  return _ASurfaceTransaction_create();
+}
+
+void NDKHelpers::ASurfaceTransaction_delete(ASurfaceTransaction* transaction) {
+  NDKHelpers::Init();
+  FML_CHECK(_ASurfaceTransaction_delete != nullptr);
+  _ASurfaceTransaction_delete(transaction);
+}
+
+void NDKHelpers::ASurfaceTransaction_apply(ASurfaceTransaction* transaction) {
+  NDKHelpers::Init();
+  FML_CHECK(_ASurfaceTransaction_apply != nullptr);
+  _ASurfaceTransaction_apply(transaction);
+}
+
+void NDKHelpers::ASurfaceTransaction_setBuffer(
+    ASurfaceTransaction* transaction,
+    ASurfaceControl* surface_control,
+    AHardwareBuffer* buffer,
+    int acquire_fence_fd) {
+  NDKHelpers::Init();
+  FML_CHECK(_ASurfaceTransaction_setBuffer != nullptr);
+  _ASurfaceTransaction_setBuffer(transaction, surface_control, buffer,
+                                 acquire_fence_fd);
+}
+
+void NDKHelpers::ASurfaceTransaction_setDesiredPresentTime(
+    ASurfaceTransaction* transaction,
+    int64_t desired_present_time) {
+  NDKHelpers::Init();
+  FML_CHECK(_ASurfaceTransaction_setDesiredPresentTime != nullptr);
+  _ASurfaceTransaction_setDesiredPresentTime(transaction, desired_present_time);
+}
+
+void NDKHelpers::ASurfaceTransaction_setOnComplete(
+    ASurfaceTransaction* transaction,
+    void* context,
+    ASurfaceTransaction_OnComplete func) {
+  NDKHelpers::Init();
+  FML_CHECK(_ASurfaceTransaction_setOnComplete != nullptr);
+  _ASurfaceTransaction_setOnComplete(transaction, context, func);
+}
+
+void NDKHelpers::ASurfaceTransaction_reparent(
+    ASurfaceTransaction* transaction,
+    ASurfaceControl* surface_control,
+    ASurfaceControl* new_parent) {
+  NDKHelpers::Init();
+  FML_CHECK(_ASurfaceTransaction_reparent != nullptr);
+  _ASurfaceTransaction_reparent(transaction, surface_control, new_parent);
+}
+
+int NDKHelpers::ASurfaceTransactionStats_getPreviousReleaseFenceFd(
+    ASurfaceTransactionStats* stats,
+    ASurfaceControl* surface_control) {
+  NDKHelpers::Init();
+  FML_CHECK(_ASurfaceTransactionStats_getPreviousReleaseFenceFd != nullptr);
+  return _ASurfaceTransactionStats_getPreviousReleaseFenceFd(stats,
+                                                             surface_control);
+}
+
+bool NDKHelpers::ImageDecoderSupported() {
+  NDKHelpers::Init();
+  return _AImageDecoder_createFromBuffer != nullptr &&
+         _AImageDecoder_setAndroidBitmapFormat != nullptr &&
+         _AImageDecoder_setTargetSize != nullptr &&
+         _AImageDecoder_setDataSpace != nullptr &&
+         _AImageDecoder_decodeImage != nullptr &&
+         _AImageDecoder_delete != nullptr &&
+         _AHardwareBuffer_allocate != nullptr &&
+         _AHardwareBuffer_lock != nullptr &&
+         _AHardwareBuffer_unlock != nullptr &&
+         _AHardwareBuffer_describe != nullptr &&
+         _AHardwareBuffer_release != nullptr;
+}
+
+int NDKHelpers::AImageDecoder_createFromBuffer(const void* buffer,
+                                               size_t length,
+                                               AImageDecoder** out_decoder) {
+  NDKHelpers::Init();
+  FML_CHECK(_AImageDecoder_createFromBuffer != nullptr);
+  return _AImageDecoder_createFromBuffer(buffer, length, out_decoder);
+}
+
+int NDKHelpers::AImageDecoder_setAndroidBitmapFormat(AImageDecoder* decoder,
+                                                     int32_t format) {
+  NDKHelpers::Init();
+  FML_CHECK(_AImageDecoder_setAndroidBitmapFormat != nullptr);
+  return _AImageDecoder_setAndroidBitmapFormat(decoder, format);
+}
+
+int NDKHelpers::AImageDecoder_setTargetSize(AImageDecoder* decoder,
+                                            int32_t width,
+                                            int32_t height) {
+  NDKHelpers::Init();
+  FML_CHECK(_AImageDecoder_setTargetSize != nullptr);
+  return _AImageDecoder_setTargetSize(decoder, width, height);
+}
+
+int NDKHelpers::AImageDecoder_setDataSpace(AImageDecoder* decoder,
+                                           int32_t data_space) {
+  NDKHelpers::Init();
+  FML_CHECK(_AImageDecoder_setDataSpace != nullptr);
+  return _AImageDecoder_setDataSpace(decoder, data_space);
+}
+
+int NDKHelpers::AImageDecoder_decodeImage(AImageDecoder* decoder,
+                                          void* pixels,
+                                          size_t stride,
+                                          size_t size) {
+  NDKHelpers::Init();
+  FML_CHECK(_AImageDecoder_decodeImage != nullptr);
+  return _AImageDecoder_decodeImage(decoder, pixels, stride, size);
+}
+
+void NDKHelpers::AImageDecoder_delete(AImageDecoder* decoder) {
+  NDKHelpers::Init();
+  FML_CHECK(_AImageDecoder_delete != nullptr);
+  _AImageDecoder_delete(decoder);
+}
+
 }  // namespace flutter
@@ -11,6 +11,9 @@
 #include "flutter/impeller/toolkit/egl/egl.h"
 
 #include <android/hardware_buffer.h>
+#include <android/imagedecoder.h>
+#include <android/native_window.h>
+#include <android/surface_control.h>
 
 namespace flutter {
 
@@ -29,6 +32,59 @@ class NDKHelpers {
                                        AHardwareBuffer_Desc* desc);
   static EGLClientBuffer eglGetNativeClientBufferANDROID(
       AHardwareBuffer* buffer);
+  static int AHardwareBuffer_allocate(const AHardwareBuffer_Desc* desc,
+                                      AHardwareBuffer** out_buffer);
+  static int AHardwareBuffer_lock(AHardwareBuffer* buffer,
+                                  uint64_t usage,
+                                  int32_t fence,
+                                  const ARect* rect,
+                                  void** out_virtual_address);
+  static int AHardwareBuffer_unlock(AHardwareBuffer* buffer, int32_t* fence);
+
+  // API Version 29
+  static bool SurfaceControlSupported();
+  static ASurfaceControl* ASurfaceControl_createFromWindow(
+      ANativeWindow* parent,
+      const char* debug_name);
+  static void ASurfaceControl_release(ASurfaceControl* surface_control);
+  static ASurfaceTransaction* ASurfaceTransaction_create();
+  static void ASurfaceTransaction_delete(ASurfaceTransaction* transaction);
+  static void ASurfaceTransaction_apply(ASurfaceTransaction* transaction);
+  static void ASurfaceTransaction_setBuffer(ASurfaceTransaction* transaction,
+                                            ASurfaceControl* surface_control,
+                                            AHardwareBuffer* buffer,
+                                            int acquire_fence_fd);
+  static void ASurfaceTransaction_setDesiredPresentTime(
+      ASurfaceTransaction* transaction,
+      int64_t desired_present_time);
+  static void ASurfaceTransaction_setOnComplete(
+      ASurfaceTransaction* transaction,
+      void* context,
+      ASurfaceTransaction_OnComplete func);
+  static void ASurfaceTransaction_reparent(ASurfaceTransaction* transaction,
+                                           ASurfaceControl* surface_control,
+                                           ASurfaceControl* new_parent);
+  static int ASurfaceTransactionStats_getPreviousReleaseFenceFd(
+      ASurfaceTransactionStats* stats,
+      ASurfaceControl* surface_control);
+
+  // API Version 30
+  static bool ImageDecoderSupported();
+  static int AImageDecoder_createFromBuffer(const void* buffer,
+                                            size_t length,
+                                            AImageDecoder** out_decoder);
+  static int AImageDecoder_setAndroidBitmapFormat(AImageDecoder* decoder,
+                                                  int32_t format);
+  static int AImageDecoder_setTargetSize(AImageDecoder* decoder,
+                                         int32_t width,
+                                         int32_t height);
+  static int AImageDecoder_setDataSpace(AImageDecoder* decoder,
+                                        int32_t data_space);
+  static int AImageDecoder_decodeImage(AImageDecoder* decoder,
+                                       void* pixels,
+                                       size_t stride,
+                                       size_t size);
+  static void AImageDecoder_delete(AImageDecoder* decoder);
 
  private:
   static void Init();
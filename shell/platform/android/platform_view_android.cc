@@ -5,11 +5,13 @@
 #include "flutter/shell/platform/android/platform_view_android.h"
 
 #include <android/api-level.h>
+#include <dlfcn.h>
 #include <memory>
 #include <utility>
 
 #include "flutter/common/graphics/texture.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/shell/common/shell_io_manager.h"
 #include "flutter/shell/gpu/gpu_surface_gl_delegate.h"
 #include "flutter/shell/platform/android/android_context_gl_impeller.h"
@@ -74,6 +76,7 @@ static std::shared_ptr<flutter::AndroidContext> CreateAndroidContext(
     bool enable_impeller,
     const std::optional<std::string>& impeller_backend,
     bool enable_vulkan_validation,
+    bool enable_surface_control,
     bool enable_opengl_gpu_tracing) {
   if (use_software_rendering) {
     FML_DCHECK(!enable_impeller);
@@ -119,10 +122,10 @@ static std::shared_ptr<flutter::AndroidContext> CreateAndroidContext(
             enable_opengl_gpu_tracing);
       case AndroidRenderingAPI::kVulkan:
         return std::make_unique<AndroidContextVulkanImpeller>(
-            enable_vulkan_validation);
+            enable_vulkan_validation, enable_surface_control);
       case AndroidRenderingAPI::kAutoselect: {
         auto vulkan_backend = std::make_unique<AndroidContextVulkanImpeller>(
-            enable_vulkan_validation);
+            enable_vulkan_validation, enable_surface_control);
         if (!vulkan_backend->IsValid()) {
           return std::make_unique<AndroidContextGLImpeller>(
               std::make_unique<impeller::egl::Display>(),
@@ -159,6 +162,7 @@ PlatformViewAndroid::PlatformViewAndroid(
               delegate.OnPlatformViewGetSettings().enable_impeller,
               delegate.OnPlatformViewGetSettings().impeller_backend,
               delegate.OnPlatformViewGetSettings().enable_vulkan_validation,
+              delegate.OnPlatformViewGetSettings().enable_surface_control,
               delegate.OnPlatformViewGetSettings().enable_opengl_gpu_tracing)) {
 }
 
@@ -393,8 +397,18 @@ std::unique_ptr<Surface> PlatformViewAndroid::CreateRenderingSurface() {
 // |PlatformView|
 std::shared_ptr<ExternalViewEmbedder>
 PlatformViewAndroid::CreateExternalViewEmbedder() {
+  // Surfaces presented through surface control don't require the raster
+  // thread to be merged with the platform thread to be composited with
+  // platform views.
+  bool merge_threads = true;
+  if (android_context_->RenderingApi() == AndroidRenderingAPI::kVulkan) {
+    merge_threads = !std::static_pointer_cast<AndroidContextVulkanImpeller>(
+                         android_context_)
+                         ->IsSurfaceControlEnabled();
+  }
   return std::make_shared<AndroidExternalViewEmbedder>(
-      *android_context_, jni_facade_, surface_factory_, task_runners_);
+      *android_context_, jni_facade_, surface_factory_, task_runners_,
+      merge_threads);
 }
 
 // |PlatformView|
@@ -476,6 +490,53 @@ void PlatformViewAndroid::LoadDartDeferredLibraryError(
                                          transient);
 }
 
+void PlatformViewAndroid::PrefetchDartDeferredLibrary(
+    intptr_t loading_unit_id,
+    std::vector<std::string> search_paths) {
+  task_runners_.GetIOTaskRunner()->PostTask(
+      [prefetched = prefetched_deferred_libraries_, loading_unit_id,
+       search_paths = std::move(search_paths)]() mutable {
+        TRACE_EVENT0("flutter", "PrefetchDartDeferredLibrary");
+        auto library = OpenDartDeferredLibrary(std::move(search_paths));
+        if (!library) {
+          // The load reports the failure when the unit is requested.
+          return;
+        }
+        std::scoped_lock lock(prefetched->mutex);
+        prefetched->libraries[loading_unit_id] = std::move(library);
+      });
+}
+
+fml::RefPtr<fml::NativeLibrary>
+PlatformViewAndroid::TakePrefetchedDartDeferredLibrary(
+    intptr_t loading_unit_id) {
+  std::scoped_lock lock(prefetched_deferred_libraries_->mutex);
+  auto& libraries = prefetched_deferred_libraries_->libraries;
+  auto found = libraries.find(loading_unit_id);
+  if (found == libraries.end()) {
+    return nullptr;
+  }
+  auto library = std::move(found->second);
+  libraries.erase(found);
+  return library;
+}
+
+fml::RefPtr<fml::NativeLibrary> PlatformViewAndroid::OpenDartDeferredLibrary(
+    std::vector<std::string> search_paths) {
+  // Use dlopen here to directly check if handle is nullptr before creating a
+  // NativeLibrary.
+  void* handle = nullptr;
+  while (handle == nullptr && !search_paths.empty()) {
+    std::string path = search_paths.back();
+    handle = ::dlopen(path.c_str(), RTLD_NOW);
+    search_paths.pop_back();
+  }
+  if (handle == nullptr) {
+    return nullptr;
+  }
+  return fml::NativeLibrary::CreateWithHandle(handle, false);
+}
+
 // |PlatformView|
 void PlatformViewAndroid::UpdateAssetResolverByType(
     std::unique_ptr<AssetResolver> updated_asset_resolver,
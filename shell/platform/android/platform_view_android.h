@@ -6,12 +6,14 @@
 #define FLUTTER_SHELL_PLATFORM_ANDROID_PLATFORM_VIEW_ANDROID_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include <android/hardware_buffer_jni.h>
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/native_library.h"
 #include "flutter/fml/platform/android/scoped_java_ref.h"
 #include "flutter/lib/ui/window/platform_message.h"
 #include "flutter/shell/common/platform_view.h"
@@ -106,6 +108,36 @@ class PlatformViewAndroid final : public PlatformView {
                                     const std::string error_message,
                                     bool transient) override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Opens the shared library of a loading unit on the IO thread,
+  ///             so that loading the unit later doesn't block on dlopen.
+  ///
+  /// @param[in]  loading_unit_id  The loading unit to prefetch.
+  /// @param[in]  search_paths     The paths to look for the library in, from
+  ///                              last to first.
+  ///
+  void PrefetchDartDeferredLibrary(intptr_t loading_unit_id,
+                                   std::vector<std::string> search_paths);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes the library of a loading unit prefetched by
+  ///             |PrefetchDartDeferredLibrary|.
+  ///
+  /// @return     The library, or nullptr if the loading unit wasn't
+  ///             prefetched or its prefetch hasn't completed.
+  ///
+  fml::RefPtr<fml::NativeLibrary> TakePrefetchedDartDeferredLibrary(
+      intptr_t loading_unit_id);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Opens the first library found in |search_paths|, trying them
+  ///             from last to first.
+  ///
+  /// @return     The library, or nullptr if none could be opened.
+  ///
+  static fml::RefPtr<fml::NativeLibrary> OpenDartDeferredLibrary(
+      std::vector<std::string> search_paths);
+
   // |PlatformView|
   void UpdateAssetResolverByType(
       std::unique_ptr<AssetResolver> updated_asset_resolver,
@@ -136,6 +168,15 @@ class PlatformViewAndroid final : public PlatformView {
   std::unique_ptr<AndroidSurface> android_surface_;
   std::shared_ptr<PlatformMessageHandlerAndroid> platform_message_handler_;
 
+  // Deferred libraries opened ahead of their load. Shared with the prefetch
+  // tasks, which may outlive the platform view.
+  struct PrefetchedDeferredLibraries {
+    std::mutex mutex;
+    std::unordered_map<intptr_t, fml::RefPtr<fml::NativeLibrary>> libraries;
+  };
+  std::shared_ptr<PrefetchedDeferredLibraries> prefetched_deferred_libraries_ =
+      std::make_shared<PrefetchedDeferredLibraries>();
+
   // |PlatformView|
   void UpdateSemantics(
       flutter::SemanticsNodeUpdates update,
@@ -6,7 +6,6 @@
 
 #include <android/hardware_buffer_jni.h>
 #include <android/native_window_jni.h>
-#include <dlfcn.h>
 #include <jni.h>
 #include <memory>
 #include <sstream>
@@ -613,21 +612,19 @@ static void LoadDartDeferredLibrary(JNIEnv* env,
   std::vector<std::string> search_paths =
       fml::jni::StringArrayToVector(env, jSearchPaths);
 
-  // Use dlopen here to directly check if handle is nullptr before creating a
-  // NativeLibrary.
-  void* handle = nullptr;
-  while (handle == nullptr && !search_paths.empty()) {
-    std::string path = search_paths.back();
-    handle = ::dlopen(path.c_str(), RTLD_NOW);
-    search_paths.pop_back();
+  // Reuse the library if it was prefetched.
+  fml::RefPtr<fml::NativeLibrary> native_lib =
+      ANDROID_SHELL_HOLDER->GetPlatformView()
+          ->TakePrefetchedDartDeferredLibrary(loading_unit_id);
+  if (!native_lib) {
+    native_lib =
+        PlatformViewAndroid::OpenDartDeferredLibrary(std::move(search_paths));
   }
-  if (handle == nullptr) {
+  if (!native_lib) {
     LoadLoadingUnitFailure(loading_unit_id,
                            "No lib .so found for provided search paths.", true);
     return;
   }
-  fml::RefPtr<fml::NativeLibrary> native_lib =
-      fml::NativeLibrary::CreateWithHandle(handle, false);
 
   // Resolve symbols.
   std::unique_ptr<const fml::SymbolMapping> data_mapping =
@@ -642,6 +639,16 @@ static void LoadDartDeferredLibrary(JNIEnv* env,
       std::move(instructions_mapping));
 }
 
+static void PrefetchDartDeferredLibrary(JNIEnv* env,
+                                        jobject obj,
+                                        jlong shell_holder,
+                                        jint jLoadingUnitId,
+                                        jobjectArray jSearchPaths) {
+  ANDROID_SHELL_HOLDER->GetPlatformView()->PrefetchDartDeferredLibrary(
+      static_cast<intptr_t>(jLoadingUnitId),
+      fml::jni::StringArrayToVector(env, jSearchPaths));
+}
+
 static void UpdateJavaAssetManager(JNIEnv* env,
                                    jobject obj,
                                    jlong shell_holder,
@@ -842,6 +849,11 @@ bool RegisterApi(JNIEnv* env) {
           .signature = "(JI[Ljava/lang/String;)V",
           .fnPtr = reinterpret_cast<void*>(&LoadDartDeferredLibrary),
       },
+      {
+          .name = "nativePrefetchDartDeferredLibrary",
+          .signature = "(JI[Ljava/lang/String;)V",
+          .fnPtr = reinterpret_cast<void*>(&PrefetchDartDeferredLibrary),
+      },
       {
           .name = "nativeUpdateJavaAssetManager",
           .signature =
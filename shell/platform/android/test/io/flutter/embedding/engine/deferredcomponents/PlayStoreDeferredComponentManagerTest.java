@@ -37,6 +37,7 @@ import org.robolectric.annotation.Config;
 public class PlayStoreDeferredComponentManagerTest {
   private class TestFlutterJNI extends FlutterJNI {
     public int loadDartDeferredLibraryCalled = 0;
+    public int prefetchDartDeferredLibraryCalled = 0;
     public int updateAssetManagerCalled = 0;
     public int deferredComponentInstallFailureCalled = 0;
     public String[] searchPaths;
@@ -53,6 +54,13 @@ public class PlayStoreDeferredComponentManagerTest {
       this.loadingUnitId = loadingUnitId;
     }
 
+    @Override
+    public void prefetchDartDeferredLibrary(int loadingUnitId, @NonNull String[] searchPaths) {
+      prefetchDartDeferredLibraryCalled++;
+      this.searchPaths = searchPaths;
+      this.loadingUnitId = loadingUnitId;
+    }
+
     @Override
     public void updateJavaAssetManager(
         @NonNull AssetManager assetManager, @NonNull String assetBundlePath) {
@@ -128,6 +136,27 @@ public class PlayStoreDeferredComponentManagerTest {
     assertEquals(jni.assetBundlePath, "flutter_assets");
   }
 
+  @Test
+  public void prefetchCallsJNIFunctions() throws NameNotFoundException {
+    TestFlutterJNI jni = new TestFlutterJNI();
+    Context spyContext = createSpyContext(null);
+    String soTestFilename = "libapp.so-123.part.so";
+    String soTestPath = "test/path/" + soTestFilename;
+    doReturn(new File(soTestPath)).when(spyContext).getFilesDir();
+    TestPlayStoreDeferredComponentManager playStoreManager =
+        new TestPlayStoreDeferredComponentManager(spyContext, jni);
+    jni.setDeferredComponentManager(playStoreManager);
+
+    playStoreManager.prefetchDartLibrary(123, "TestModuleName");
+    assertEquals(jni.prefetchDartDeferredLibraryCalled, 1);
+    assertEquals(jni.loadDartDeferredLibraryCalled, 0);
+
+    assertEquals(jni.searchPaths[0], soTestFilename);
+    assertTrue(jni.searchPaths[1].endsWith(soTestPath));
+    assertEquals(jni.searchPaths.length, 2);
+    assertEquals(jni.loadingUnitId, 123);
+  }
+
   @Test
   public void downloadCallsJNIFunctionsWithFilenameFromManifest() throws NameNotFoundException {
     TestFlutterJNI jni = new TestFlutterJNI();
@@ -19,6 +19,18 @@ constexpr int kHasScrollingAction =
     FlutterSemanticsAction::kFlutterSemanticsActionScrollUp |
     FlutterSemanticsAction::kFlutterSemanticsActionScrollDown;
 
+static bool RectEquals(const FlutterRect& a, const FlutterRect& b) {
+  return a.left == b.left && a.top == b.top && a.right == b.right &&
+         a.bottom == b.bottom;
+}
+
+static bool TransformationEquals(const FlutterTransformation& a,
+                                 const FlutterTransformation& b) {
+  return a.scaleX == b.scaleX && a.skewX == b.skewX && a.transX == b.transX &&
+         a.skewY == b.skewY && a.scaleY == b.scaleY && a.transY == b.transY &&
+         a.pers0 == b.pers0 && a.pers1 == b.pers1 && a.pers2 == b.pers2;
+}
+
 // AccessibilityBridge
 AccessibilityBridge::AccessibilityBridge()
     : tree_(std::make_unique<ui::AXTree>()) {
@@ -83,15 +95,26 @@ void AccessibilityBridge::CommitUpdates() {
   std::vector<std::vector<SemanticsNode>> results;
   while (!pending_semantics_node_updates_.empty()) {
     auto begin = pending_semantics_node_updates_.begin();
-    SemanticsNode target = begin->second;
-    std::vector<SemanticsNode> sub_tree_list;
-    GetSubTreeList(target, sub_tree_list);
-    results.push_back(sub_tree_list);
+    SemanticsNode target = std::move(begin->second);
     pending_semantics_node_updates_.erase(begin);
+    std::vector<SemanticsNode> sub_tree_list;
+    GetSubTreeList(std::move(target), sub_tree_list);
+    results.push_back(std::move(sub_tree_list));
   }
 
+  // The framework resends nodes whose semantics did not change, for example
+  // the ancestors of a changed node. Those are skipped so that only the nodes
+  // that differ from the committed tree are converted and unserialized.
+  size_t node_count = 0;
+  for (const auto& sub_tree_list : results) {
+    node_count += sub_tree_list.size();
+  }
+  update.nodes.reserve(node_count);
   for (size_t i = results.size(); i > 0; i--) {
     for (const SemanticsNode& node : results[i - 1]) {
+      if (IsCommittedSemanticsNode(node)) {
+        continue;
+      }
       ConvertFlutterUpdate(node, update);
     }
   }
@@ -114,6 +137,12 @@ void AccessibilityBridge::CommitUpdates() {
     FML_LOG(ERROR) << "Failed to update ui::AXTree, error: " << error;
     return;
   }
+  for (auto& sub_tree_list : results) {
+    for (SemanticsNode& node : sub_tree_list) {
+      int32_t id = node.id;
+      committed_semantics_nodes_[id] = std::move(node);
+    }
+  }
   // Handles accessibility events as the result of the semantics update.
   for (const auto& targeted_event : event_generator_) {
     auto event_target =
@@ -178,6 +207,7 @@ void AccessibilityBridge::OnNodeDeleted(ui::AXTree* tree,
   if (id_wrapper_map_.find(node_id) != id_wrapper_map_.end()) {
     id_wrapper_map_.erase(node_id);
   }
+  committed_semantics_nodes_.erase(node_id);
 }
 
 void AccessibilityBridge::OnAtomicUpdateFinished(
@@ -228,6 +258,8 @@ AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
       int32_t parent_id = child->parent()->id();
       if (updates.find(parent_id) == updates.end()) {
         updates[parent_id] = tree_->GetFromId(parent_id)->data();
+        // The previous parent no longer matches its committed semantics node.
+        committed_semantics_nodes_.erase(parent_id);
       }
 
       ui::AXNodeData* parent = &updates[parent_id];
@@ -256,19 +288,57 @@ AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
 }
 
 // Private method.
-void AccessibilityBridge::GetSubTreeList(const SemanticsNode& target,
+void AccessibilityBridge::GetSubTreeList(SemanticsNode target,
                                          std::vector<SemanticsNode>& result) {
-  result.push_back(target);
-  for (int32_t child : target.children_in_traversal_order) {
+  result.push_back(std::move(target));
+  // The recursion may reallocate |result|, so the children are read by index.
+  size_t index = result.size() - 1;
+  for (size_t i = 0; i < result[index].children_in_traversal_order.size();
+       i++) {
+    int32_t child = result[index].children_in_traversal_order[i];
     auto iter = pending_semantics_node_updates_.find(child);
     if (iter != pending_semantics_node_updates_.end()) {
-      SemanticsNode node = iter->second;
-      GetSubTreeList(node, result);
+      SemanticsNode node = std::move(iter->second);
       pending_semantics_node_updates_.erase(iter);
+      GetSubTreeList(std::move(node), result);
     }
   }
 }
 
+bool AccessibilityBridge::IsCommittedSemanticsNode(
+    const SemanticsNode& node) const {
+  // The descriptions of the custom actions are read from the pending custom
+  // action updates, which may have changed.
+  if (!node.custom_accessibility_actions.empty()) {
+    return false;
+  }
+  auto iter = committed_semantics_nodes_.find(node.id);
+  if (iter == committed_semantics_nodes_.end()) {
+    return false;
+  }
+  const SemanticsNode& committed = iter->second;
+  return node.flags == committed.flags && node.actions == committed.actions &&
+         node.text_selection_base == committed.text_selection_base &&
+         node.text_selection_extent == committed.text_selection_extent &&
+         node.scroll_child_count == committed.scroll_child_count &&
+         node.scroll_index == committed.scroll_index &&
+         node.scroll_position == committed.scroll_position &&
+         node.scroll_extent_max == committed.scroll_extent_max &&
+         node.scroll_extent_min == committed.scroll_extent_min &&
+         node.elevation == committed.elevation &&
+         node.thickness == committed.thickness &&
+         node.label == committed.label && node.hint == committed.hint &&
+         node.value == committed.value &&
+         node.increased_value == committed.increased_value &&
+         node.decreased_value == committed.decreased_value &&
+         node.tooltip == committed.tooltip &&
+         node.text_direction == committed.text_direction &&
+         RectEquals(node.rect, committed.rect) &&
+         TransformationEquals(node.transform, committed.transform) &&
+         node.children_in_traversal_order ==
+             committed.children_in_traversal_order;
+}
+
 void AccessibilityBridge::ConvertFlutterUpdate(const SemanticsNode& node,
                                                ui::AXTreeUpdate& tree_update) {
   ui::AXNodeData node_data;
@@ -295,7 +365,7 @@ void AccessibilityBridge::ConvertFlutterUpdate(const SemanticsNode& node,
     node_data.child_ids.push_back(child);
   }
   SetTreeData(node, tree_update);
-  tree_update.nodes.push_back(node_data);
+  tree_update.nodes.push_back(std::move(node_data));
 }
 
 void AccessibilityBridge::SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
@@ -201,6 +201,9 @@ class AccessibilityBridge
   std::unordered_map<int32_t, SemanticsNode> pending_semantics_node_updates_;
   std::unordered_map<int32_t, SemanticsCustomAction>
       pending_semantics_custom_action_updates_;
+  // The semantics nodes of the last successful update, used to skip the nodes
+  // that are sent again without changes.
+  std::unordered_map<int32_t, SemanticsNode> committed_semantics_nodes_;
   AccessibilityNodeId last_focused_id_ = ui::AXNode::kInvalidAXID;
 
   void InitAXTree(const ui::AXTreeUpdate& initial_state);
@@ -209,8 +212,10 @@ class AccessibilityBridge
   // pending_semantics_updates_. Returns std::nullopt if none are reparented.
   std::optional<ui::AXTreeUpdate> CreateRemoveReparentedNodesUpdate();
 
-  void GetSubTreeList(const SemanticsNode& target,
+  void GetSubTreeList(SemanticsNode target,
                       std::vector<SemanticsNode>& result);
+  // Whether |node| is identical to the node with the same ID in the tree.
+  bool IsCommittedSemanticsNode(const SemanticsNode& node) const;
   void ConvertFlutterUpdate(const SemanticsNode& node,
                             ui::AXTreeUpdate& tree_update);
   void SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
@@ -13,14 +13,18 @@
 // removed in favor of the normal structure since templates will no longer
 // manually include files.
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <memory>
 #include <variant>
+#include <vector>
 
 #include "binary_messenger_impl.h"
 #include "include/flutter/engine_method_result.h"
 #include "include/flutter/method_channel.h"
 #include "include/flutter/standard_method_codec.h"
+#include "include/flutter/streaming_channel.h"
 #include "texture_registrar_impl.h"
 
 namespace flutter {
@@ -206,6 +210,121 @@ void SetChannelWarnsOnOverflow(BinaryMessenger* messenger,
 
 }  // namespace internal
 
+// ========== streaming_channel.h ==========
+
+namespace {
+
+// The state of a stream being sent, shared by the replies to its frames.
+struct OutgoingStream {
+  BinaryMessenger* messenger;
+  std::string channel;
+  size_t chunk_size;
+  size_t max_chunks_in_flight;
+  uint32_t id;
+  StreamReader reader;
+  StreamCompletionHandler on_complete;
+  uint32_t next_sequence = 0;
+  size_t chunks_in_flight = 0;
+  bool end_sent = false;
+  bool finished = false;
+  // Whether PumpStream is running, to avoid reentering it when the messenger
+  // replies synchronously.
+  bool pumping = false;
+};
+
+void WriteUint32LittleEndian(uint8_t* bytes, uint32_t value) {
+  for (int i = 0; i < 4; ++i) {
+    bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+void FinishStream(const std::shared_ptr<OutgoingStream>& stream,
+                  bool completed) {
+  stream->finished = true;
+  stream->reader = nullptr;
+  StreamCompletionHandler on_complete = std::move(stream->on_complete);
+  stream->on_complete = nullptr;
+  if (on_complete) {
+    on_complete(completed);
+  }
+}
+
+// Sends the next frames of |stream| until |max_chunks_in_flight| of them are
+// waiting for an acknowledgement, and finishes the stream once its end is
+// acknowledged.
+void PumpStream(const std::shared_ptr<OutgoingStream>& stream) {
+  if (stream->pumping) {
+    return;
+  }
+  stream->pumping = true;
+  while (!stream->finished && !stream->end_sent &&
+         stream->chunks_in_flight < stream->max_chunks_in_flight) {
+    std::vector<uint8_t> frame(StreamingChannel::kFrameHeaderSize +
+                               stream->chunk_size);
+    size_t size =
+        stream->reader(frame.data() + StreamingChannel::kFrameHeaderSize,
+                       stream->chunk_size);
+    assert(size <= stream->chunk_size);
+    size = std::min(size, stream->chunk_size);
+    frame.resize(StreamingChannel::kFrameHeaderSize + size);
+    stream->end_sent = size == 0;
+    frame[0] =
+        stream->end_sent ? StreamingChannel::kEnd : StreamingChannel::kData;
+    WriteUint32LittleEndian(&frame[1], stream->id);
+    WriteUint32LittleEndian(&frame[5], stream->next_sequence++);
+
+    stream->chunks_in_flight++;
+    stream->messenger->Send(
+        stream->channel, frame.data(), frame.size(),
+        [stream](const uint8_t* reply, size_t reply_size) {
+          stream->chunks_in_flight--;
+          if (stream->finished) {
+            return;
+          }
+          if (reply_size != 1 || reply[0] != StreamingChannel::kAcknowledge) {
+            FinishStream(stream, false);
+            return;
+          }
+          PumpStream(stream);
+        });
+  }
+  stream->pumping = false;
+  if (!stream->finished && stream->end_sent && stream->chunks_in_flight == 0) {
+    FinishStream(stream, true);
+  }
+}
+
+}  // namespace
+
+StreamingChannel::StreamingChannel(BinaryMessenger* messenger,
+                                   const std::string& name,
+                                   size_t chunk_size,
+                                   size_t max_chunks_in_flight)
+    : messenger_(messenger),
+      name_(name),
+      chunk_size_(chunk_size),
+      max_chunks_in_flight_(std::max<size_t>(max_chunks_in_flight, 1)) {
+  assert(chunk_size_ > 0);
+  internal::ResizeChannel(messenger_, name_,
+                          static_cast<int>(max_chunks_in_flight_));
+}
+
+StreamingChannel::~StreamingChannel() = default;
+
+uint32_t StreamingChannel::Send(StreamReader reader,
+                                StreamCompletionHandler on_complete) {
+  auto stream = std::make_shared<OutgoingStream>();
+  stream->messenger = messenger_;
+  stream->channel = name_;
+  stream->chunk_size = chunk_size_;
+  stream->max_chunks_in_flight = max_chunks_in_flight_;
+  stream->id = next_stream_id_++;
+  stream->reader = std::move(reader);
+  stream->on_complete = std::move(on_complete);
+  PumpStream(stream);
+  return stream->id;
+}
+
 // ========== texture_registrar_impl.h ==========
 
 TextureRegistrarImpl::TextureRegistrarImpl(
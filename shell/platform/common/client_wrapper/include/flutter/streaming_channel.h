@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STREAMING_CHANNEL_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STREAMING_CHANNEL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "binary_messenger.h"
+
+namespace flutter {
+
+// Reads up to |size| bytes of a stream into |buffer|, and returns the number
+// of bytes read. Returning 0 ends the stream.
+typedef std::function<size_t(uint8_t* buffer, size_t size)> StreamReader;
+
+// Called once a stream is over, with true if the receiver acknowledged all of
+// it, or false if the receiver cancelled it or could not be reached.
+typedef std::function<void(bool completed)> StreamCompletionHandler;
+
+// A channel for sending payloads too large to be materialized in a single
+// message to Flutter, as a stream of framed chunks.
+//
+// The payload is read lazily from a StreamReader, one chunk at a time, and
+// at most |max_chunks_in_flight| chunks are sent before the receiver
+// acknowledges them. Memory use is therefore bounded on both sides of the
+// channel regardless of the size of the payload, and the UI thread handles
+// one small message at a time.
+//
+// Each chunk is sent as a platform message on the channel, made of a header
+// followed by the payload of the chunk:
+// - byte 0: the frame type, kData or kEnd.
+// - bytes 1-4: the id of the stream, as a little-endian uint32.
+// - bytes 5-8: the sequence number of the frame in its stream, as a
+//   little-endian uint32.
+// A stream is zero or more kData frames followed by an empty kEnd frame. Frames
+// of different streams may be interleaved. The receiver must reply to each
+// frame with the single byte kAcknowledge once it is done with it, and any
+// other reply cancels the stream.
+class StreamingChannel {
+ public:
+  enum FrameType : uint8_t {
+    kData = 0,
+    kEnd = 1,
+  };
+
+  static constexpr size_t kFrameHeaderSize = 9;
+  static constexpr uint8_t kAcknowledge = 0;
+
+  static constexpr size_t kDefaultChunkSize = 64 * 1024;
+  static constexpr size_t kDefaultMaxChunksInFlight = 4;
+
+  // Creates an instance that sends streams on the channel named |name| with
+  // |messenger|, which must outlive the streams.
+  //
+  // The buffer of the channel on the Flutter side is resized to
+  // |max_chunks_in_flight|, so that the frames sent before the receiver is set
+  // up are not dropped.
+  StreamingChannel(BinaryMessenger* messenger,
+                   const std::string& name,
+                   size_t chunk_size = kDefaultChunkSize,
+                   size_t max_chunks_in_flight = kDefaultMaxChunksInFlight);
+
+  ~StreamingChannel();
+
+  // Prevent copying.
+  StreamingChannel(StreamingChannel const&) = delete;
+  StreamingChannel& operator=(StreamingChannel const&) = delete;
+
+  // Streams the content of |reader| to Flutter, and returns the id of the
+  // stream. |reader| and |on_complete| are called on the platform thread, and
+  // are released once the stream is over.
+  //
+  // The stream keeps going if this channel is destroyed.
+  uint32_t Send(StreamReader reader,
+                StreamCompletionHandler on_complete = nullptr);
+
+ private:
+  BinaryMessenger* messenger_;
+  std::string name_;
+  size_t chunk_size_;
+  size_t max_chunks_in_flight_;
+  uint32_t next_stream_id_ = 0;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STREAMING_CHANNEL_H_
@@ -0,0 +1,77 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
+
+namespace flutter {
+
+namespace {
+
+// A map of |count| entries from string keys to small maps, like the ones
+// plugins commonly send.
+EncodableValue MakeMapOfMaps(int64_t count) {
+  EncodableMap map;
+  for (int64_t i = 0; i < count; ++i) {
+    map.emplace(EncodableValue("key" + std::to_string(i)),
+                EncodableValue(EncodableMap{
+                    {EncodableValue("id"), EncodableValue(i)},
+                    {EncodableValue("value"), EncodableValue(i * 0.5)},
+                    {EncodableValue("tags"),
+                     EncodableValue(EncodableList{EncodableValue("a"),
+                                                  EncodableValue("b")})},
+                }));
+  }
+  return EncodableValue(std::move(map));
+}
+
+EncodableValue MakeFloat64List(int64_t count) {
+  return EncodableValue(std::vector<double>(count, 0.5));
+}
+
+void EncodeValue(benchmark::State& state, const EncodableValue& value) {
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance();
+  for (auto _ : state) {
+    auto encoded = codec.EncodeMessage(value);
+    benchmark::DoNotOptimize(encoded);
+  }
+}
+
+void DecodeValue(benchmark::State& state, const EncodableValue& value) {
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance();
+  auto encoded = codec.EncodeMessage(value);
+  for (auto _ : state) {
+    auto decoded = codec.DecodeMessage(*encoded);
+    benchmark::DoNotOptimize(decoded);
+  }
+  state.SetBytesProcessed(state.iterations() * encoded->size());
+}
+
+}  // namespace
+
+static void BM_StandardMessageCodecEncodeMap(benchmark::State& state) {
+  EncodeValue(state, MakeMapOfMaps(state.range(0)));
+}
+
+static void BM_StandardMessageCodecDecodeMap(benchmark::State& state) {
+  DecodeValue(state, MakeMapOfMaps(state.range(0)));
+}
+
+static void BM_StandardMessageCodecEncodeFloat64List(benchmark::State& state) {
+  EncodeValue(state, MakeFloat64List(state.range(0)));
+}
+
+static void BM_StandardMessageCodecDecodeFloat64List(benchmark::State& state) {
+  DecodeValue(state, MakeFloat64List(state.range(0)));
+}
+
+BENCHMARK(BM_StandardMessageCodecEncodeMap)->Range(1 << 4, 1 << 17);
+BENCHMARK(BM_StandardMessageCodecDecodeMap)->Range(1 << 4, 1 << 17);
+BENCHMARK(BM_StandardMessageCodecEncodeFloat64List)->Range(1 << 4, 1 << 20);
+BENCHMARK(BM_StandardMessageCodecDecodeFloat64List)->Range(1 << 4, 1 << 20);
+
+}  // namespace flutter
@@ -0,0 +1,163 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/streaming_channel.h"
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/binary_messenger.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+namespace {
+
+class TestBinaryMessenger : public BinaryMessenger {
+ public:
+  struct Frame {
+    std::vector<uint8_t> bytes;
+    BinaryReply reply;
+  };
+
+  void Send(const std::string& channel,
+            const uint8_t* message,
+            const size_t message_size,
+            BinaryReply reply) const override {
+    if (channel == "test") {
+      frames_.push_back(
+          {std::vector<uint8_t>(message, message + message_size), reply});
+    }
+  }
+
+  void SetMessageHandler(const std::string& channel,
+                         BinaryMessageHandler handler) override {}
+
+  std::vector<Frame>& frames() { return frames_; }
+
+ private:
+  mutable std::vector<Frame> frames_;
+};
+
+uint32_t ReadUint32(const std::vector<uint8_t>& bytes, size_t offset) {
+  return bytes[offset] | bytes[offset + 1] << 8 | bytes[offset + 2] << 16 |
+         bytes[offset + 3] << 24;
+}
+
+// Returns a reader for the bytes of |data|.
+StreamReader MakeReader(std::shared_ptr<std::vector<uint8_t>> data) {
+  auto offset = std::make_shared<size_t>(0);
+  return [data, offset](uint8_t* buffer, size_t size) {
+    size_t read = std::min(size, data->size() - *offset);
+    std::copy_n(data->begin() + *offset, read, buffer);
+    *offset += read;
+    return read;
+  };
+}
+
+void Acknowledge(const TestBinaryMessenger::Frame& frame) {
+  // The reply may send more frames, which would invalidate |frame|.
+  BinaryReply reply = frame.reply;
+  uint8_t acknowledge = StreamingChannel::kAcknowledge;
+  reply(&acknowledge, 1);
+}
+
+}  // namespace
+
+// Tests that a stream is sent in framed chunks, with at most the maximum number
+// of chunks waiting for an acknowledgement.
+TEST(StreamingChannelTest, SendsFramedChunksWithBackpressure) {
+  TestBinaryMessenger messenger;
+  StreamingChannel channel(&messenger, "test", /*chunk_size=*/4,
+                           /*max_chunks_in_flight=*/2);
+  auto data = std::make_shared<std::vector<uint8_t>>(
+      std::vector<uint8_t>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+  std::optional<bool> completed;
+
+  uint32_t id = channel.Send(MakeReader(data),
+                             [&completed](bool result) { completed = result; });
+
+  auto& frames = messenger.frames();
+  ASSERT_EQ(frames.size(), 2u);
+  EXPECT_EQ(frames[0].bytes[0], StreamingChannel::kData);
+  EXPECT_EQ(ReadUint32(frames[0].bytes, 1), id);
+  EXPECT_EQ(ReadUint32(frames[0].bytes, 5), 0u);
+  EXPECT_EQ(std::vector<uint8_t>(frames[0].bytes.begin() +
+                                     StreamingChannel::kFrameHeaderSize,
+                                 frames[0].bytes.end()),
+            std::vector<uint8_t>({1, 2, 3, 4}));
+  EXPECT_EQ(ReadUint32(frames[1].bytes, 5), 1u);
+
+  Acknowledge(frames[0]);
+  ASSERT_EQ(frames.size(), 3u);
+  EXPECT_EQ(frames[2].bytes.size(), StreamingChannel::kFrameHeaderSize + 2);
+
+  Acknowledge(frames[1]);
+  ASSERT_EQ(frames.size(), 4u);
+  EXPECT_EQ(frames[3].bytes[0], StreamingChannel::kEnd);
+  EXPECT_EQ(frames[3].bytes.size(), StreamingChannel::kFrameHeaderSize);
+  EXPECT_EQ(ReadUint32(frames[3].bytes, 5), 3u);
+
+  Acknowledge(frames[2]);
+  EXPECT_FALSE(completed.has_value());
+  Acknowledge(frames[3]);
+  ASSERT_TRUE(completed.has_value());
+  EXPECT_TRUE(*completed);
+}
+
+// Tests that any reply other than an acknowledgement cancels the stream.
+TEST(StreamingChannelTest, CancelsOnMissingAcknowledgement) {
+  TestBinaryMessenger messenger;
+  StreamingChannel channel(&messenger, "test", /*chunk_size=*/4,
+                           /*max_chunks_in_flight=*/1);
+  auto data = std::make_shared<std::vector<uint8_t>>(100, 0);
+  std::optional<bool> completed;
+
+  channel.Send(MakeReader(data),
+               [&completed](bool result) { completed = result; });
+
+  auto& frames = messenger.frames();
+  ASSERT_EQ(frames.size(), 1u);
+  // No handler on the Flutter side.
+  frames[0].reply(nullptr, 0);
+  EXPECT_EQ(frames.size(), 1u);
+  ASSERT_TRUE(completed.has_value());
+  EXPECT_FALSE(*completed);
+}
+
+// Tests that synchronous replies do not reenter the sending loop.
+TEST(StreamingChannelTest, HandlesSynchronousReplies) {
+  class AcknowledgingBinaryMessenger : public TestBinaryMessenger {
+   public:
+    void Send(const std::string& channel,
+              const uint8_t* message,
+              const size_t message_size,
+              BinaryReply reply) const override {
+      sent_++;
+      if (reply) {
+        uint8_t acknowledge = StreamingChannel::kAcknowledge;
+        reply(&acknowledge, 1);
+      }
+    }
+
+    mutable int sent_ = 0;
+  };
+  AcknowledgingBinaryMessenger messenger;
+  StreamingChannel channel(&messenger, "test", /*chunk_size=*/1,
+                           /*max_chunks_in_flight=*/1);
+  auto data = std::make_shared<std::vector<uint8_t>>(1000, 0);
+  bool completed = false;
+
+  channel.Send(MakeReader(data),
+               [&completed](bool result) { completed = result; });
+
+  // The data frames, the end frame, and the resize of the channel.
+  EXPECT_EQ(messenger.sent_, 1002);
+  EXPECT_TRUE(completed);
+}
+
+}  // namespace flutter
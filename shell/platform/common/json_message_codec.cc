@@ -8,11 +8,36 @@
 #include <string>
 
 #include "rapidjson/error/en.h"
-#include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 
 namespace flutter {
 
+namespace {
+
+// A rapidjson output stream that writes straight into the encoded message, so
+// that it doesn't have to be copied out of an intermediate buffer.
+class MessageOutputStream {
+ public:
+  typedef char Ch;
+
+  explicit MessageOutputStream(std::vector<uint8_t>* message)
+      : message_(message) {}
+
+  void Put(Ch c) { message_->push_back(static_cast<uint8_t>(c)); }
+
+  void Flush() {}
+
+ private:
+  std::vector<uint8_t>* message_;
+};
+
+}  // namespace
+
+ReusableJsonDocument::ReusableJsonDocument(size_t arena_size)
+    : arena_(std::make_unique<char[]>(arena_size)),
+      allocator_(arena_.get(), arena_size),
+      document_(&allocator_) {}
+
 // static
 const JsonMessageCodec& JsonMessageCodec::GetInstance() {
   static JsonMessageCodec sInstance;
@@ -21,15 +46,15 @@ const JsonMessageCodec& JsonMessageCodec::GetInstance() {
 
 std::unique_ptr<std::vector<uint8_t>> JsonMessageCodec::EncodeMessageInternal(
     const rapidjson::Document& message) const {
-  rapidjson::StringBuffer buffer;
-  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  auto encoded = std::make_unique<std::vector<uint8_t>>();
+  encoded->reserve(256);
+  MessageOutputStream stream(encoded.get());
+  rapidjson::Writer<MessageOutputStream> writer(stream);
   // clang-tidy has trouble reasoning about some of the complicated array and
   // pointer-arithmetic code in rapidjson.
   // NOLINTNEXTLINE(clang-analyzer-core.*)
   message.Accept(writer);
-  const char* buffer_start = buffer.GetString();
-  return std::make_unique<std::vector<uint8_t>>(
-      buffer_start, buffer_start + buffer.GetSize());
+  return encoded;
 }
 
 std::unique_ptr<rapidjson::Document> JsonMessageCodec::DecodeMessageInternal(
@@ -47,4 +72,26 @@ std::unique_ptr<rapidjson::Document> JsonMessageCodec::DecodeMessageInternal(
   return json_message;
 }
 
+bool JsonMessageCodec::DecodeMessageInto(const uint8_t* binary_message,
+                                         const size_t message_size,
+                                         ReusableJsonDocument* document) const {
+  auto raw_message = reinterpret_cast<const char*>(binary_message);
+  // The values of the previous message live in the arena, so they have to be
+  // dropped before it is cleared.
+  document->document_.SetNull();
+  document->allocator_.Clear();
+  // Parsing in place needs a mutable, null-terminated copy of the message.
+  document->message_.assign(raw_message, raw_message + message_size);
+  document->message_.push_back('\0');
+  rapidjson::ParseResult result =
+      document->document_.ParseInsitu(document->message_.data());
+  if (result.IsError()) {
+    std::cerr << "Unable to parse JSON message:" << std::endl
+              << rapidjson::GetParseError_En(result.Code()) << std::endl;
+    document->document_.SetNull();
+    return false;
+  }
+  return true;
+}
+
 }  // namespace flutter
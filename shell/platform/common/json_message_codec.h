@@ -7,10 +7,46 @@
 
 #include <rapidjson/document.h>
 
+#include <memory>
+#include <vector>
+
 #include "flutter/shell/platform/common/client_wrapper/include/flutter/message_codec.h"
 
 namespace flutter {
 
+// A document that JSON messages are decoded into one after the other, for
+// channels that handle a stream of messages and are done with each before the
+// next arrives.
+//
+// Each message is copied into a buffer that is kept from one message to the
+// next and parsed in place, so strings point into that buffer rather than
+// being copied. Other values are allocated out of an arena of |arena_size|
+// bytes that is also kept, so decoding a message that fits in it doesn't
+// allocate at all. Decoding the next message invalidates the values of the
+// previous one.
+class ReusableJsonDocument {
+ public:
+  explicit ReusableJsonDocument(size_t arena_size = 4096);
+
+  ~ReusableJsonDocument() = default;
+
+  // Prevent copying.
+  ReusableJsonDocument(ReusableJsonDocument const&) = delete;
+  ReusableJsonDocument& operator=(ReusableJsonDocument const&) = delete;
+
+  // The last message decoded into this document.
+  rapidjson::Document& document() { return document_; }
+  const rapidjson::Document& document() const { return document_; }
+
+ private:
+  friend class JsonMessageCodec;
+
+  std::unique_ptr<char[]> arena_;
+  rapidjson::MemoryPoolAllocator<> allocator_;
+  rapidjson::Document document_;
+  std::vector<char> message_;
+};
+
 // A message encoding/decoding mechanism for communications to/from the
 // Flutter engine via JSON channels.
 class JsonMessageCodec : public MessageCodec<rapidjson::Document> {
@@ -24,6 +60,14 @@ class JsonMessageCodec : public MessageCodec<rapidjson::Document> {
   JsonMessageCodec(JsonMessageCodec const&) = delete;
   JsonMessageCodec& operator=(JsonMessageCodec const&) = delete;
 
+  // Decodes |binary_message| into |document|, replacing the message decoded
+  // into it before.
+  //
+  // Returns false, leaving |document| null, if the message isn't valid JSON.
+  bool DecodeMessageInto(const uint8_t* binary_message,
+                         const size_t message_size,
+                         ReusableJsonDocument* document) const;
+
  protected:
   // Instances should be obtained via GetInstance.
   JsonMessageCodec() = default;
@@ -0,0 +1,78 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/common/json_message_codec.h"
+
+namespace flutter {
+
+namespace {
+
+// A TextInputClient.updateEditingState method call for a field with |length|
+// characters of text, like the ones the text input plugins send on every
+// keystroke.
+rapidjson::Document MakeEditingStateUpdate(int64_t length) {
+  rapidjson::Document message(rapidjson::kObjectType);
+  auto& allocator = message.GetAllocator();
+  rapidjson::Value state(rapidjson::kObjectType);
+  state.AddMember("text",
+                  rapidjson::Value(std::string(length, 'a'), allocator),
+                  allocator);
+  state.AddMember("selectionBase", length, allocator);
+  state.AddMember("selectionExtent", length, allocator);
+  state.AddMember("selectionAffinity", "TextAffinity.downstream", allocator);
+  state.AddMember("selectionIsDirectional", false, allocator);
+  state.AddMember("composingBase", -1, allocator);
+  state.AddMember("composingExtent", -1, allocator);
+  rapidjson::Value args(rapidjson::kArrayType);
+  args.PushBack(1, allocator);
+  args.PushBack(state, allocator);
+  message.AddMember("method", "TextInputClient.updateEditingState", allocator);
+  message.AddMember("args", args, allocator);
+  return message;
+}
+
+}  // namespace
+
+static void BM_JsonMessageCodecEncodeEditingState(benchmark::State& state) {
+  const JsonMessageCodec& codec = JsonMessageCodec::GetInstance();
+  rapidjson::Document message = MakeEditingStateUpdate(state.range(0));
+  for (auto _ : state) {
+    auto encoded = codec.EncodeMessage(message);
+    benchmark::DoNotOptimize(encoded);
+  }
+}
+
+static void BM_JsonMessageCodecDecodeEditingState(benchmark::State& state) {
+  const JsonMessageCodec& codec = JsonMessageCodec::GetInstance();
+  auto encoded = codec.EncodeMessage(MakeEditingStateUpdate(state.range(0)));
+  for (auto _ : state) {
+    auto decoded = codec.DecodeMessage(*encoded);
+    benchmark::DoNotOptimize(decoded);
+  }
+  state.SetBytesProcessed(state.iterations() * encoded->size());
+}
+
+static void BM_JsonMessageCodecDecodeEditingStateIntoReusableDocument(
+    benchmark::State& state) {
+  const JsonMessageCodec& codec = JsonMessageCodec::GetInstance();
+  auto encoded = codec.EncodeMessage(MakeEditingStateUpdate(state.range(0)));
+  ReusableJsonDocument document;
+  for (auto _ : state) {
+    bool decoded =
+        codec.DecodeMessageInto(encoded->data(), encoded->size(), &document);
+    benchmark::DoNotOptimize(decoded);
+  }
+  state.SetBytesProcessed(state.iterations() * encoded->size());
+}
+
+BENCHMARK(BM_JsonMessageCodecEncodeEditingState)->Range(1 << 4, 1 << 16);
+BENCHMARK(BM_JsonMessageCodecDecodeEditingState)->Range(1 << 4, 1 << 16);
+BENCHMARK(BM_JsonMessageCodecDecodeEditingStateIntoReusableDocument)
+    ->Range(1 << 4, 1 << 16);
+
+}  // namespace flutter
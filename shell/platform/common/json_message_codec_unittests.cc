@@ -6,6 +6,7 @@
 
 #include <limits>
 #include <map>
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -44,4 +45,39 @@ TEST(JsonMessageCodec, EncodeDecode) {
   CheckEncodeDecode(array);
 }
 
+// Tests that messages decoded one after the other into the same document each
+// replace the one before, including ones that don't fit in its arena.
+TEST(JsonMessageCodec, DecodeMessagesIntoReusableDocument) {
+  const JsonMessageCodec& codec = JsonMessageCodec::GetInstance();
+  ReusableJsonDocument document(256);
+
+  const std::string first = R"([1,{"text":"hello","selectionBase":5}])";
+  ASSERT_TRUE(codec.DecodeMessageInto(
+      reinterpret_cast<const uint8_t*>(first.data()), first.size(),
+      &document));
+  const rapidjson::Document& decoded = document.document();
+  ASSERT_TRUE(decoded.IsArray());
+  EXPECT_EQ(decoded[0].GetInt(), 1);
+  EXPECT_STREQ(decoded[1]["text"].GetString(), "hello");
+
+  std::string second = R"({"text":")" + std::string(4096, 'a') + R"("})";
+  ASSERT_TRUE(codec.DecodeMessageInto(
+      reinterpret_cast<const uint8_t*>(second.data()), second.size(),
+      &document));
+  ASSERT_TRUE(decoded.IsObject());
+  EXPECT_EQ(decoded["text"].GetStringLength(), 4096u);
+
+  const std::string invalid = "{\"text\":";
+  EXPECT_FALSE(codec.DecodeMessageInto(
+      reinterpret_cast<const uint8_t*>(invalid.data()), invalid.size(),
+      &document));
+  EXPECT_TRUE(decoded.IsNull());
+
+  // Only |message_size| bytes of the message are decoded.
+  const std::string number = "42";
+  ASSERT_TRUE(codec.DecodeMessageInto(
+      reinterpret_cast<const uint8_t*>(number.data()), 1u, &document));
+  EXPECT_EQ(decoded.GetInt(), 4);
+}
+
 }  // namespace flutter
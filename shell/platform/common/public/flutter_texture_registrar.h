@@ -5,6 +5,7 @@
 #ifndef FLUTTER_SHELL_PLATFORM_COMMON_PUBLIC_FLUTTER_TEXTURE_REGISTRAR_H_
 #define FLUTTER_SHELL_PLATFORM_COMMON_PUBLIC_FLUTTER_TEXTURE_REGISTRAR_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -100,6 +101,20 @@ typedef struct {
   void (*release_callback)(void* release_context);
   // Opaque data passed to |release_callback|.
   void* release_context;
+  // Whether Flutter synchronizes its access to the texture with the
+  // |IDXGIKeyedMutex| of the texture (Windows only). The texture must have
+  // been created with |D3D11_RESOURCE_MISC_SHARED_KEYEDMUTEX|.
+  //
+  // Flutter shows the texture once it can acquire the mutex with
+  // |keyed_mutex_acquire_key| without waiting, and keeps showing the previous
+  // texture until then. The mutex is held until Flutter shows another
+  // texture, and then released with |keyed_mutex_release_key|, so the
+  // producer must rotate through at least two textures.
+  bool use_keyed_mutex;
+  // The key the keyed mutex is acquired with by Flutter.
+  uint64_t keyed_mutex_acquire_key;
+  // The key the keyed mutex is released with by Flutter.
+  uint64_t keyed_mutex_release_key;
 } FlutterDesktopGpuSurfaceDescriptor;
 
 // The pixel buffer copy callback definition provided to
@@ -190,6 +190,12 @@ class TextInputModel {
   // Gets the current text as UTF-8.
   std::string GetText() const;
 
+  // The current text as UTF-16, as it is stored.
+  //
+  // Unlike GetText(), this neither converts nor copies the text, so prefer it
+  // on paths that run for every edit.
+  const std::u16string& text_utf16() const { return text_; }
+
   // Gets the cursor position as a byte offset in UTF-8 string returned from
   // GetText().
   int GetCursorOffset() const;
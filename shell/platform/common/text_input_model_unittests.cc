@@ -24,6 +24,16 @@ TEST(TextInputModel, SetTextWideCharacters) {
   EXPECT_STREQ(model->GetText().c_str(), "😄🙃🤪🧐");
 }
 
+TEST(TextInputModel, TextUtf16MatchesText) {
+  auto model = std::make_unique<TextInputModel>();
+  model->SetText("A😄B");
+  EXPECT_EQ(model->text_utf16(), u"A😄B");
+  model->SetSelection(TextRange(1));
+  model->AddText(u"C");
+  EXPECT_EQ(model->text_utf16(), u"AC😄B");
+  EXPECT_STREQ(model->GetText().c_str(), "AC😄B");
+}
+
 TEST(TextInputModel, SetTextEmpty) {
   auto model = std::make_unique<TextInputModel>();
   model->SetText("");
@@ -44,9 +44,20 @@ extern CFTimeInterval display_link_target;
 
   // Whether layer displayLink is forced to max rate.
   BOOL _displayLinkForcedMaxRate;
+
+  // When the last texture made it to the screen, used to schedule
+  // presentAfterMinimumDuration: relative to it.
+  CFTimeInterval _lastPresentedTime;
 }
 
-- (void)presentTexture:(FlutterTexture*)texture;
+// Called with the time at which the texture was set as layer contents, or 0
+// if it was replaced by a newer texture before that happened.
+typedef void (^FlutterTexturePresentedHandler)(CFTimeInterval presentedTime);
+
+- (void)presentTexture:(FlutterTexture*)texture
+                atTime:(CFTimeInterval)presentationTime
+      presentedHandler:(FlutterTexturePresentedHandler)presentedHandler;
+- (CFTimeInterval)lastPresentedTime;
 - (void)returnTexture:(FlutterTexture*)texture;
 
 @end
@@ -84,6 +95,8 @@ extern CFTimeInterval display_link_target;
   __weak FlutterMetalLayer* _layer;
   NSUInteger _drawableId;
   BOOL _presented;
+  CFTimeInterval _presentedTime;
+  NSMutableArray<MTLDrawablePresentedHandler>* _presentedHandlers;
 }
 
 - (instancetype)initWithTexture:(FlutterTexture*)texture
@@ -121,12 +134,11 @@ extern CFTimeInterval display_link_target;
 }
 
 - (CFTimeInterval)presentedTime {
-  return 0;
+  return self->_presentedTime;
 }
 
 - (void)present {
-  [_layer presentTexture:self->_texture];
-  self->_presented = YES;
+  [self presentAtTime:0];
 }
 
 - (void)dealloc {
@@ -136,15 +148,28 @@ extern CFTimeInterval display_link_target;
 }
 
 - (void)addPresentedHandler:(nonnull MTLDrawablePresentedHandler)block {
-  FML_LOG(WARNING) << "FlutterMetalLayer drawable does not implement addPresentedHandler:";
+  if (self->_presentedHandlers == nil) {
+    self->_presentedHandlers = [[NSMutableArray alloc] init];
+  }
+  [self->_presentedHandlers addObject:[block copy]];
 }
 
 - (void)presentAtTime:(CFTimeInterval)presentationTime {
-  FML_LOG(WARNING) << "FlutterMetalLayer drawable does not implement presentAtTime:";
+  self->_presented = YES;
+  // The handler keeps the drawable alive until its texture is on screen (or
+  // dropped), so that the presented handlers can be given the drawable.
+  [_layer presentTexture:self->_texture
+                  atTime:presentationTime
+        presentedHandler:^(CFTimeInterval presentedTime) {
+          self->_presentedTime = presentedTime;
+          for (MTLDrawablePresentedHandler handler in self->_presentedHandlers) {
+            handler(self);
+          }
+        }];
 }
 
 - (void)presentAfterMinimumDuration:(CFTimeInterval)duration {
-  FML_LOG(WARNING) << "FlutterMetalLayer drawable does not implement presentAfterMinimumDuration:";
+  [self presentAtTime:[_layer lastPresentedTime] + duration];
 }
 
 @end
@@ -282,72 +307,68 @@ extern CFTimeInterval display_link_target;
   return (__bridge_transfer IOSurface*)res;
 }
 
+- (FlutterTexture*)createTexture {
+  IOSurface* surface = [self createIOSurface];
+  if (surface == nil) {
+    return nil;
+  }
+  MTLTextureDescriptor* textureDescriptor =
+      [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:_pixelFormat
+                                                         width:_drawableSize.width
+                                                        height:_drawableSize.height
+                                                     mipmapped:NO];
+
+  if (_framebufferOnly) {
+    textureDescriptor.usage = MTLTextureUsageRenderTarget;
+  } else {
+    textureDescriptor.usage =
+        MTLTextureUsageRenderTarget | MTLTextureUsageShaderRead | MTLTextureUsageShaderWrite;
+  }
+  id<MTLTexture> texture = [self.device newTextureWithDescriptor:textureDescriptor
+                                                       iosurface:(__bridge IOSurfaceRef)surface
+                                                           plane:0];
+  return [[FlutterTexture alloc] initWithTexture:texture surface:surface];
+}
+
 - (FlutterTexture*)nextTexture {
   @synchronized(self) {
     if (_totalTextures < 3) {
       ++_totalTextures;
-      IOSurface* surface = [self createIOSurface];
-      if (surface == nil) {
-        return nil;
-      }
-      MTLTextureDescriptor* textureDescriptor =
-          [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:_pixelFormat
-                                                             width:_drawableSize.width
-                                                            height:_drawableSize.height
-                                                         mipmapped:NO];
-
-      if (_framebufferOnly) {
-        textureDescriptor.usage = MTLTextureUsageRenderTarget;
-      } else {
-        textureDescriptor.usage =
-            MTLTextureUsageRenderTarget | MTLTextureUsageShaderRead | MTLTextureUsageShaderWrite;
-      }
-      id<MTLTexture> texture = [self.device newTextureWithDescriptor:textureDescriptor
-                                                           iosurface:(__bridge IOSurfaceRef)surface
-                                                               plane:0];
-      FlutterTexture* flutterTexture = [[FlutterTexture alloc] initWithTexture:texture
-                                                                       surface:surface];
-      return flutterTexture;
-    } else {
-      // Make sure raster thread doesn't have too many drawables in flight.
-      if (_availableTextures.count == 0) {
-        CFTimeInterval start = CACurrentMediaTime();
-        while (_availableTextures.count == 0 && CACurrentMediaTime() - start < 1.0) {
-          usleep(100);
-        }
-        CFTimeInterval elapsed = CACurrentMediaTime() - start;
-        if (_availableTextures.count == 0) {
-          NSLog(@"Waited %f seconds for a drawable, giving up.", elapsed);
-          return nil;
-        } else {
-          NSLog(@"Had to wait %f seconds for a drawable", elapsed);
-        }
-      }
+      return [self createTexture];
+    }
+
+    // Make sure raster thread doesn't have too many drawables in flight.
+    // Textures only come back when a drawable is presented or dropped, which
+    // can't happen while the raster thread is waiting here, so rather than
+    // stalling the frame, give up on it right away.
+    if (_availableTextures.count == 0) {
+      FML_DLOG(WARNING) << "No drawable available, dropping frame.";
+      return nil;
+    }
 
-      // Prefer surface that is not in use and has been presented the longest
-      // time ago.
-      // When isInUse is false, the surface is definitely not used by the compositor.
-      // When isInUse is true, the surface may be used by the compositor.
-      // When both surfaces are in use, the one presented earlier will be returned.
-      // The assumption here is that the compositor is already aware of the
-      // newer texture and is unlikely to read from the older one, even though it
-      // has not decreased the use count yet (there seems to be certain latency).
-      FlutterTexture* res = nil;
-      for (FlutterTexture* texture in _availableTextures) {
-        if (res == nil) {
-          res = texture;
-        } else if (res.surface.isInUse && !texture.surface.isInUse) {
-          // prefer texture that is not in use.
-          res = texture;
-        } else if (res.surface.isInUse == texture.surface.isInUse &&
-                   texture.presentedTime < res.presentedTime) {
-          // prefer texture with older presented time.
-          res = texture;
-        }
+    // Prefer surface that is not in use and has been presented the longest
+    // time ago.
+    // When isInUse is false, the surface is definitely not used by the compositor.
+    // When isInUse is true, the surface may be used by the compositor.
+    // When both surfaces are in use, the one presented earlier will be returned.
+    // The assumption here is that the compositor is already aware of the
+    // newer texture and is unlikely to read from the older one, even though it
+    // has not decreased the use count yet (there seems to be certain latency).
+    FlutterTexture* res = nil;
+    for (FlutterTexture* texture in _availableTextures) {
+      if (res == nil) {
+        res = texture;
+      } else if (res.surface.isInUse && !texture.surface.isInUse) {
+        // prefer texture that is not in use.
+        res = texture;
+      } else if (res.surface.isInUse == texture.surface.isInUse &&
+                 texture.presentedTime < res.presentedTime) {
+        // prefer texture with older presented time.
+        res = texture;
       }
-      [_availableTextures removeObject:res];
-      return res;
     }
+    [_availableTextures removeObject:res];
+    return res;
   }
 }
 
@@ -362,7 +383,18 @@ extern CFTimeInterval display_link_target;
   return drawable;
 }
 
-- (void)presentOnMainThread:(FlutterTexture*)texture {
+- (void)presentOnMainThread:(FlutterTexture*)texture
+            presentedHandler:(FlutterTexturePresentedHandler)presentedHandler {
+  @synchronized(self) {
+    // A newer texture was presented before this one made it to the screen.
+    // The raster thread may already be drawing into this one again, so it
+    // must not be shown.
+    if (texture != _front) {
+      presentedHandler(0);
+      return;
+    }
+  }
+
   // This is needed otherwise frame gets skipped on touch begin / end. Go figure.
   // Might also be placebo
   [self setNeedsDisplay];
@@ -372,6 +404,9 @@ extern CFTimeInterval display_link_target;
   self.contents = texture.surface;
   texture.presentedTime = CACurrentMediaTime();
   [CATransaction commit];
+  @synchronized(self) {
+    _lastPresentedTime = texture.presentedTime;
+  }
   _displayLink.paused = NO;
   _displayLinkPauseCountdown = 0;
   if (!_didSetContentsDuringThisDisplayLinkPeriod) {
@@ -380,25 +415,43 @@ extern CFTimeInterval display_link_target;
     _displayLinkForcedMaxRate = YES;
     [self setMaxRefreshRate:[DisplayLinkManager displayRefreshRate] forceMax:YES];
   }
+  presentedHandler(texture.presentedTime);
 }
 
-- (void)presentTexture:(FlutterTexture*)texture {
+- (void)presentTexture:(FlutterTexture*)texture
+                atTime:(CFTimeInterval)presentationTime
+      presentedHandler:(FlutterTexturePresentedHandler)presentedHandler {
   @synchronized(self) {
     if (_front != nil) {
       [_availableTextures addObject:_front];
     }
     _front = texture;
-    if ([NSThread isMainThread]) {
-      [self presentOnMainThread:texture];
+    CFTimeInterval delay = presentationTime - CACurrentMediaTime();
+    if (delay > 0) {
+      // Hold the texture back until the requested time rather than showing it
+      // on the next vsync. Should a newer texture be presented in the meantime,
+      // this one is dropped.
+      dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)),
+                     dispatch_get_main_queue(), ^{
+                       [self presentOnMainThread:texture presentedHandler:presentedHandler];
+                     });
+    } else if ([NSThread isMainThread]) {
+      [self presentOnMainThread:texture presentedHandler:presentedHandler];
     } else {
       // Core animation layers can only be updated on main thread.
       dispatch_async(dispatch_get_main_queue(), ^{
-        [self presentOnMainThread:texture];
+        [self presentOnMainThread:texture presentedHandler:presentedHandler];
       });
     }
   }
 }
 
+- (CFTimeInterval)lastPresentedTime {
+  @synchronized(self) {
+    return _lastPresentedTime;
+  }
+}
+
 - (void)returnTexture:(FlutterTexture*)texture {
   @synchronized(self) {
     [_availableTextures addObject:texture];
@@ -236,4 +236,45 @@
   [self removeMetalLayer:layer];
 }
 
+- (void)testPresentedHandlerReceivesPresentedTime {
+  FlutterMetalLayer* layer = [self addMetalLayer];
+
+  id<CAMetalDrawable> drawable = [layer nextDrawable];
+  BAIL_IF_NO_DRAWABLE(drawable);
+  __block CFTimeInterval presentedTime = 0;
+  [drawable addPresentedHandler:^(id<MTLDrawable> presented) {
+    presentedTime = presented.presentedTime;
+  }];
+  XCTAssertEqual(drawable.presentedTime, 0);
+
+  [drawable present];
+  XCTAssertGreaterThan(presentedTime, 0);
+  XCTAssertEqual(drawable.presentedTime, presentedTime);
+
+  [self removeMetalLayer:layer];
+}
+
+- (void)testScheduledPresentIsDroppedWhenReplaced {
+  FlutterMetalLayer* layer = [self addMetalLayer];
+
+  id<CAMetalDrawable> d1 = [layer nextDrawable];
+  BAIL_IF_NO_DRAWABLE(d1);
+  id<CAMetalDrawable> d2 = [layer nextDrawable];
+  BAIL_IF_NO_DRAWABLE(d2);
+
+  XCTestExpectation* dropped = [self expectationWithDescription:@"d1 dropped"];
+  [d1 addPresentedHandler:^(id<MTLDrawable> presented) {
+    XCTAssertEqual(presented.presentedTime, 0);
+    [dropped fulfill];
+  }];
+  [d1 presentAtTime:CACurrentMediaTime() + 0.05];
+  [d2 present];
+  XCTAssertGreaterThan(d2.presentedTime, 0);
+
+  [self waitForExpectationsWithTimeout:1.0 handler:nil];
+  XCTAssertEqual((__bridge IOSurfaceRef)layer.contents, d2.texture.iosurface);
+
+  [self removeMetalLayer:layer];
+}
+
 @end
@@ -19,6 +19,7 @@
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
 namespace impeller {
+class AiksContext;
 class Context;
 }  // namespace impeller
 
@@ -145,6 +146,15 @@ class IOSContext {
 
   virtual std::shared_ptr<impeller::Context> GetImpellerContext() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The Aiks context that surfaces drawing with the Impeller
+  ///             context render with. Engines spawned from one another share
+  ///             this context, and with it its pipelines, glyph atlas and
+  ///             render target cache, as they share the raster thread.
+  /// @returns    `nullptr` if the backend isn't Impeller.
+  ///
+  virtual std::shared_ptr<impeller::AiksContext> GetAiksContext();
+
   MsaaSampleCount GetMsaaSampleCount() const { return msaa_samples_; }
 
  protected:
@@ -56,4 +56,8 @@ std::shared_ptr<impeller::Context> IOSContext::GetImpellerContext() const {
   return nullptr;
 }
 
+std::shared_ptr<impeller::AiksContext> IOSContext::GetAiksContext() {
+  return nullptr;
+}
+
 }  // namespace flutter
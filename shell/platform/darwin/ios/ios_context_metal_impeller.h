@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_PLATFORM_DARWIN_IOS_IOS_CONTEXT_METAL_IMPELLER_H_
 #define FLUTTER_SHELL_PLATFORM_DARWIN_IOS_IOS_CONTEXT_METAL_IMPELLER_H_
 
+#include <mutex>
+
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/darwin/graphics/FlutterDarwinContextMetalImpeller.h"
 #include "flutter/shell/platform/darwin/graphics/FlutterDarwinContextMetalSkia.h"
@@ -12,6 +14,7 @@
 
 namespace impeller {
 
+class AiksContext;
 class Context;
 
 }  // namespace impeller
@@ -36,6 +39,10 @@ class IOSContextMetalImpeller final : public IOSContext {
 
  private:
   fml::scoped_nsobject<FlutterDarwinContextMetalImpeller> darwin_context_metal_impeller_;
+  std::mutex aiks_context_mutex_;
+  // Created with the first surface, rather than with the context, as building
+  // the pipelines is expensive.
+  std::shared_ptr<impeller::AiksContext> aiks_context_;
 
   // |IOSContext|
   sk_sp<GrDirectContext> CreateResourceContext() override;
@@ -51,6 +58,9 @@ class IOSContextMetalImpeller final : public IOSContext {
   // |IOSContext|
   std::shared_ptr<impeller::Context> GetImpellerContext() const override;
 
+  // |IOSContext|
+  std::shared_ptr<impeller::AiksContext> GetAiksContext() override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(IOSContextMetalImpeller);
 };
 
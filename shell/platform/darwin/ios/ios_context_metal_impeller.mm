@@ -3,7 +3,9 @@
 // found in the LICENSE file.
 
 #import "flutter/shell/platform/darwin/ios/ios_context_metal_impeller.h"
+#include "flutter/impeller/aiks/aiks_context.h"
 #include "flutter/impeller/entity/mtl/entity_shaders.h"
+#include "flutter/impeller/typographer/backends/skia/typographer_context_skia.h"
 #import "flutter/shell/platform/darwin/ios/ios_external_texture_metal.h"
 
 namespace flutter {
@@ -43,6 +45,20 @@ std::shared_ptr<impeller::Context> IOSContextMetalImpeller::GetImpellerContext()
   return darwin_context_metal_impeller_.get().context;
 }
 
+// |IOSContext|
+std::shared_ptr<impeller::AiksContext> IOSContextMetalImpeller::GetAiksContext() {
+  std::scoped_lock lock(aiks_context_mutex_);
+  if (!aiks_context_) {
+    std::shared_ptr<impeller::Context> context = GetImpellerContext();
+    if (!context) {
+      return nullptr;
+    }
+    aiks_context_ = std::make_shared<impeller::AiksContext>(
+        context, impeller::TypographerContextSkia::Make());
+  }
+  return aiks_context_;
+}
+
 // |IOSContext|
 std::unique_ptr<GLContextResult> IOSContextMetalImpeller::MakeCurrent() {
   // This only makes sense for contexts that need to be bound to a specific thread.
@@ -39,8 +39,10 @@ void IOSSurfaceMetalImpeller::UpdateStorageSizeIfNecessary() {
 std::unique_ptr<Surface> IOSSurfaceMetalImpeller::CreateGPUSurface(GrDirectContext*) {
   impeller_context_->UpdateOffscreenLayerPixelFormat(
       impeller::FromMTLPixelFormat(layer_.get().pixelFormat));
-  return std::make_unique<GPUSurfaceMetalImpeller>(this,              //
-                                                   impeller_context_  //
+  return std::make_unique<GPUSurfaceMetalImpeller>(this,                           //
+                                                   impeller_context_,              //
+                                                   /*render_to_surface=*/true,     //
+                                                   GetContext()->GetAiksContext()  //
   );
 }
 
@@ -99,6 +99,10 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "third_party/skia/include/gpu/ganesh/vk/GrVkBackendSurface.h"
 #endif  // SHELL_ENABLE_VULKAN
 
+#if FML_OS_LINUX
+#include "flutter/fml/platform/linux/thread_scheduling.h"
+#endif  // FML_OS_LINUX
+
 const int32_t kFlutterSemanticsNodeIdBatchEnd = -1;
 const int32_t kFlutterSemanticsCustomActionIdBatchEnd = -1;
 
@@ -126,6 +130,37 @@ static constexpr FlutterViewId kFlutterImplicitViewId = 0;
 // 1 for handled, and 0 for not. Malformed value is considered false.
 const char* kFlutterKeyDataChannel = "flutter/keydata";
 
+#if FML_OS_LINUX
+// The timer slack of the UI and raster threads, which bounds how late the
+// kernel may wake them up for delayed tasks such as the fallback vsync.
+static constexpr fml::TimeDelta kFrameThreadTimerSlack =
+    fml::TimeDelta::FromMicroseconds(10);
+
+// The realtime priority of the raster thread when it is enabled. It is the
+// lowest one so that the realtime threads of the system, such as those of the
+// audio server, still preempt it.
+static constexpr int kRasterThreadRealtimePriority = 1;
+
+static void ConfigureLinuxThreadScheduling(
+    const fml::Thread::ThreadConfig& config,
+    bool realtime_raster_thread) {
+  if (config.priority != fml::Thread::ThreadPriority::kDisplay &&
+      config.priority != fml::Thread::ThreadPriority::kRaster) {
+    return;
+  }
+  fml::SetCurrentThreadTimerSlack(kFrameThreadTimerSlack);
+  if (realtime_raster_thread &&
+      config.priority == fml::Thread::ThreadPriority::kRaster &&
+      !fml::RequestCurrentThreadRealtimePriority(
+          kRasterThreadRealtimePriority)) {
+    FML_LOG(WARNING) << "Could not run the raster thread with a realtime "
+                        "priority. It needs CAP_SYS_NICE or an RLIMIT_RTPRIO "
+                        "of at least "
+                     << kRasterThreadRealtimePriority << ".";
+  }
+}
+#endif  // FML_OS_LINUX
+
 static FlutterEngineResult LogEmbedderError(FlutterEngineResult code,
                                             const char* reason,
                                             const char* code_name,
@@ -1274,6 +1309,13 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor,
       SAFE_ACCESS(compositor, present_layers_callback, nullptr);
   bool avoid_backing_store_cache =
       SAFE_ACCESS(compositor, avoid_backing_store_cache, false);
+  flutter::EmbedderRenderTargetCache::Config render_target_cache_config = {
+      .max_unused_frames =
+          SAFE_ACCESS(compositor, backing_store_cache_frame_count, 0u),
+      .max_bytes = SAFE_ACCESS(compositor, backing_store_cache_max_bytes, 0u),
+      .size_alignment = static_cast<int32_t>(
+          SAFE_ACCESS(compositor, backing_store_size_alignment, 0u)),
+  };
 
   // Make sure the required callbacks are present
   if (!c_create_callback || !c_collect_callback || !c_present_callback) {
@@ -1305,7 +1347,7 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor,
 
   return {std::make_unique<flutter::EmbedderExternalViewEmbedder>(
               avoid_backing_store_cache, create_render_target_callback,
-              present_callback),
+              present_callback, render_target_cache_config),
           false};
 }
 
@@ -1313,6 +1355,24 @@ struct _FlutterPlatformMessageResponseHandle {
   std::unique_ptr<flutter::PlatformMessage> message;
 };
 
+// Hands the message to the embedder, which owns the response handle until it
+// responds with `FlutterEngineSendPlatformMessageResponse`.
+static void DispatchPlatformMessageToEmbedder(
+    FlutterPlatformMessageCallback callback,
+    void* user_data,
+    std::unique_ptr<flutter::PlatformMessage> message) {
+  auto handle = new FlutterPlatformMessageResponseHandle();
+  const FlutterPlatformMessage incoming_message = {
+      sizeof(FlutterPlatformMessage),  // struct_size
+      message->channel().c_str(),      // channel
+      message->data().GetMapping(),    // message
+      message->data().GetSize(),       // message_size
+      handle,                          // response_handle
+  };
+  handle->message = std::move(message);
+  callback(&incoming_message, user_data);
+}
+
 struct LoadedElfDeleter {
   void operator()(Dart_LoadedElf* elf) {
     if (elf) {
@@ -1766,6 +1826,38 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
   if (SAFE_ACCESS(args, log_tag, nullptr) != nullptr) {
     settings.log_tag = SAFE_ACCESS(args, log_tag, nullptr);
   }
+  if (SAFE_ACCESS(args, frame_statistics_callback, nullptr) != nullptr) {
+    FlutterFrameStatisticsCallback callback =
+        SAFE_ACCESS(args, frame_statistics_callback, nullptr);
+    settings.frame_rasterized_callback =
+        [callback, user_data](const flutter::FrameTiming& timing) {
+          auto to_nanoseconds = [&timing](flutter::FrameTiming::Phase phase) {
+            return static_cast<uint64_t>(
+                timing.Get(phase).ToEpochDelta().ToNanoseconds());
+          };
+          FlutterFrameStatistics statistics = {};
+          statistics.struct_size = sizeof(FlutterFrameStatistics);
+          statistics.frame_number = timing.GetFrameNumber();
+          statistics.vsync_start_time =
+              to_nanoseconds(flutter::FrameTiming::kVsyncStart);
+          statistics.build_start_time =
+              to_nanoseconds(flutter::FrameTiming::kBuildStart);
+          statistics.build_end_time =
+              to_nanoseconds(flutter::FrameTiming::kBuildFinish);
+          statistics.raster_start_time =
+              to_nanoseconds(flutter::FrameTiming::kRasterStart);
+          statistics.raster_end_time =
+              to_nanoseconds(flutter::FrameTiming::kRasterFinish);
+          statistics.gpu_duration =
+              static_cast<uint64_t>(timing.GetGPUTime().ToNanoseconds());
+          statistics.pipeline_depth = timing.GetPipelineDepth();
+          const auto& complexity = timing.GetComplexity();
+          statistics.layer_count = complexity.layer_count;
+          statistics.display_list_op_count = complexity.display_list_op_count;
+          statistics.offscreen_pass_count = complexity.offscreen_pass_count;
+          callback(&statistics, user_data);
+        };
+  }
 
   bool has_update_semantics_2_callback =
       SAFE_ACCESS(args, update_semantics_callback2, nullptr) != nullptr;
@@ -1800,19 +1892,22 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
     platform_message_response_callback =
         [ptr = args->platform_message_callback,
          user_data](std::unique_ptr<flutter::PlatformMessage> message) {
-          auto handle = new FlutterPlatformMessageResponseHandle();
-          const FlutterPlatformMessage incoming_message = {
-              sizeof(FlutterPlatformMessage),  // struct_size
-              message->channel().c_str(),      // channel
-              message->data().GetMapping(),    // message
-              message->data().GetSize(),       // message_size
-              handle,                          // response_handle
-          };
-          handle->message = std::move(message);
-          return ptr(&incoming_message, user_data);
+          DispatchPlatformMessageToEmbedder(ptr, user_data, std::move(message));
         };
   }
 
+  // Messages are only routed off the platform thread if the embedder has
+  // specified a task runner for them.
+  std::shared_ptr<flutter::EmbedderBackgroundPlatformMessageRouter>
+      background_platform_message_router;
+  if (SAFE_ACCESS(args, custom_task_runners, nullptr) != nullptr &&
+      SAFE_ACCESS(args->custom_task_runners,
+                  background_platform_message_task_runner,
+                  nullptr) != nullptr) {
+    background_platform_message_router =
+        std::make_shared<flutter::EmbedderBackgroundPlatformMessageRouter>();
+  }
+
   flutter::VsyncWaiterEmbedder::VsyncCallback vsync_callback = nullptr;
   if (SAFE_ACCESS(args, vsync_callback, nullptr) != nullptr) {
     vsync_callback = [ptr = args->vsync_callback, user_data](intptr_t baton) {
@@ -1896,12 +1991,14 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
 
   flutter::PlatformViewEmbedder::PlatformDispatchTable platform_dispatch_table =
       {
-          update_semantics_callback,                  //
-          platform_message_response_callback,         //
-          vsync_callback,                             //
-          compute_platform_resolved_locale_callback,  //
-          on_pre_engine_restart_callback,             //
-          channel_update_callback,                    //
+          update_semantics_callback,                       //
+          platform_message_response_callback,              //
+          vsync_callback,                                  //
+          compute_platform_resolved_locale_callback,       //
+          on_pre_engine_restart_callback,                  //
+          channel_update_callback,                         //
+          background_platform_message_router,              //
+          SAFE_ACCESS(args, render_without_vsync, false),  //
       };
 
   auto on_create_platform_view = InferPlatformViewCreationCallback(
@@ -1970,9 +2067,13 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
   }
 #endif
   auto custom_task_runners = SAFE_ACCESS(args, custom_task_runners, nullptr);
-  auto thread_config_callback = [&custom_task_runners](
+  auto thread_config_callback = [&custom_task_runners, &settings](
                                     const fml::Thread::ThreadConfig& config) {
     fml::Thread::SetCurrentThreadName(config);
+#if FML_OS_LINUX
+    ConfigureLinuxThreadScheduling(config,
+                                   settings.enable_realtime_raster_thread);
+#endif  // FML_OS_LINUX
     if (!custom_task_runners || !custom_task_runners->thread_priority_setter) {
       return;
     }
@@ -2042,13 +2143,14 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
 
   // Create the engine but don't launch the shell or run the root isolate.
   auto embedder_engine = std::make_unique<flutter::EmbedderEngine>(
-      std::move(thread_host),               //
-      std::move(task_runners),              //
-      std::move(settings),                  //
-      std::move(run_configuration),         //
-      on_create_platform_view,              //
-      on_create_rasterizer,                 //
-      std::move(external_texture_resolver)  //
+      std::move(thread_host),                       //
+      std::move(task_runners),                      //
+      std::move(settings),                          //
+      std::move(run_configuration),                 //
+      on_create_platform_view,                      //
+      on_create_rasterizer,                         //
+      std::move(external_texture_resolver),         //
+      std::move(background_platform_message_router)  //
   );
 
   // Release the ownership of the embedder engine to the caller.
@@ -2259,18 +2361,9 @@ inline int64_t PointerDataButtonsForLegacyEvent(
   return 0;
 }
 
-FlutterEngineResult FlutterEngineSendPointerEvent(
-    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+static std::unique_ptr<flutter::PointerDataPacket> MakePointerDataPacket(
     const FlutterPointerEvent* pointers,
     size_t events_count) {
-  if (engine == nullptr) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
-  }
-
-  if (pointers == nullptr || events_count == 0) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid pointer events.");
-  }
-
   auto packet = std::make_unique<flutter::PointerDataPacket>(events_count);
 
   const FlutterPointerEvent* current = pointers;
@@ -2332,15 +2425,51 @@ FlutterEngineResult FlutterEngineSendPointerEvent(
     current = reinterpret_cast<const FlutterPointerEvent*>(
         reinterpret_cast<const uint8_t*>(current) + current->struct_size);
   }
+  return packet;
+}
+
+FlutterEngineResult FlutterEngineSendPointerEvent(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPointerEvent* pointers,
+    size_t events_count) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  if (pointers == nullptr || events_count == 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid pointer events.");
+  }
 
   return reinterpret_cast<flutter::EmbedderEngine*>(engine)
-                 ->DispatchPointerDataPacket(std::move(packet))
+                 ->DispatchPointerDataPacket(
+                     MakePointerDataPacket(pointers, events_count))
              ? kSuccess
              : LOG_EMBEDDER_ERROR(kInternalInconsistency,
                                   "Could not dispatch pointer events to the "
                                   "running Flutter application.");
 }
 
+FlutterEngineResult FlutterEngineEnqueuePointerEvents(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPointerEvent* pointers,
+    size_t events_count) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  if (pointers == nullptr || events_count == 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid pointer events.");
+  }
+
+  return reinterpret_cast<flutter::EmbedderEngine*>(engine)
+                 ->EnqueuePointerDataPacket(
+                     *MakePointerDataPacket(pointers, events_count))
+             ? kSuccess
+             : LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                                  "Could not queue pointer events, the input "
+                                  "queue is full.");
+}
+
 static inline flutter::KeyEventType MapKeyEventType(
     FlutterKeyEventType event_kind) {
   switch (event_kind) {
@@ -2371,6 +2500,25 @@ static inline flutter::KeyEventDeviceType MapKeyEventDeviceType(
   return flutter::KeyEventDeviceType::kKeyboard;
 }
 
+static std::unique_ptr<flutter::KeyDataPacket> MakeKeyDataPacket(
+    const FlutterKeyEvent* event) {
+  const char* character = SAFE_ACCESS(event, character, nullptr);
+
+  flutter::KeyData key_data;
+  key_data.Clear();
+  key_data.timestamp = static_cast<uint64_t>(SAFE_ACCESS(event, timestamp, 0));
+  key_data.type = MapKeyEventType(
+      SAFE_ACCESS(event, type, FlutterKeyEventType::kFlutterKeyEventTypeUp));
+  key_data.physical = SAFE_ACCESS(event, physical, 0);
+  key_data.logical = SAFE_ACCESS(event, logical, 0);
+  key_data.synthesized = SAFE_ACCESS(event, synthesized, false);
+  key_data.device_type = MapKeyEventDeviceType(SAFE_ACCESS(
+      event, device_type,
+      FlutterKeyEventDeviceType::kFlutterKeyEventDeviceTypeKeyboard));
+
+  return std::make_unique<flutter::KeyDataPacket>(key_data, character);
+}
+
 // Send a platform message to the framework.
 //
 // The `data_callback` will be invoked with `user_data`, and must not be empty.
@@ -2423,21 +2571,7 @@ FlutterEngineResult FlutterEngineSendKeyEvent(FLUTTER_API_SYMBOL(FlutterEngine)
     return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid key event.");
   }
 
-  const char* character = SAFE_ACCESS(event, character, nullptr);
-
-  flutter::KeyData key_data;
-  key_data.Clear();
-  key_data.timestamp = static_cast<uint64_t>(SAFE_ACCESS(event, timestamp, 0));
-  key_data.type = MapKeyEventType(
-      SAFE_ACCESS(event, type, FlutterKeyEventType::kFlutterKeyEventTypeUp));
-  key_data.physical = SAFE_ACCESS(event, physical, 0);
-  key_data.logical = SAFE_ACCESS(event, logical, 0);
-  key_data.synthesized = SAFE_ACCESS(event, synthesized, false);
-  key_data.device_type = MapKeyEventDeviceType(SAFE_ACCESS(
-      event, device_type,
-      FlutterKeyEventDeviceType::kFlutterKeyEventDeviceTypeKeyboard));
-
-  auto packet = std::make_unique<flutter::KeyDataPacket>(key_data, character);
+  auto packet = MakeKeyDataPacket(event);
 
   struct MessageData {
     FlutterKeyEventCallback callback;
@@ -2465,6 +2599,78 @@ FlutterEngineResult FlutterEngineSendKeyEvent(FLUTTER_API_SYMBOL(FlutterEngine)
       message_data);
 }
 
+FlutterEngineResult FlutterEngineEnqueueKeyEvent(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterKeyEvent* event,
+    FlutterKeyEventCallback callback,
+    void* user_data) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  if (event == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid key event.");
+  }
+
+  auto embedder_engine = reinterpret_cast<flutter::EmbedderEngine*>(engine);
+  auto packet = MakeKeyDataPacket(event);
+  auto response = fml::MakeRefCounted<flutter::EmbedderPlatformMessageResponse>(
+      embedder_engine->GetTaskRunners().GetPlatformTaskRunner(),
+      [callback, user_data](const uint8_t* data, size_t size) {
+        if (callback == nullptr) {
+          return;
+        }
+        callback(size == 1 && *data != 0, user_data);
+      });
+  auto message = std::make_unique<flutter::PlatformMessage>(
+      kFlutterKeyDataChannel,
+      fml::MallocMapping::Copy(packet->data().data(), packet->data().size()),
+      std::move(response));
+
+  return embedder_engine->EnqueueKeyMessage(std::move(message))
+             ? kSuccess
+             : LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                                  "Could not queue the key event, the input "
+                                  "queue is full.");
+}
+
+FlutterEngineResult FlutterEngineGetInputQueueDepth(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    size_t* depth_out) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  if (depth_out == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Depth out pointer was null.");
+  }
+
+  *depth_out =
+      reinterpret_cast<flutter::EmbedderEngine*>(engine)->GetInputQueueDepth();
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineGetMemoryUsage(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    FlutterEngineMemoryUsageCallback callback,
+    void* user_data) {
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (engine == nullptr || !engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (callback == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Memory usage callback was null.");
+  }
+
+  engine->GetShell().GetLastMemoryUsage().ForEach(
+      [callback, user_data](const char* name, size_t value) {
+        callback(name, value, user_data);
+      });
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineSendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPlatformMessage* flutter_message) {
@@ -3164,6 +3370,40 @@ FlutterEngineResult FlutterEngineSetNextFrameCallback(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEngineSetBackgroundPlatformMessageCallback(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* channel,
+    FlutterPlatformMessageCallback callback,
+    void* user_data) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (channel == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Channel was null.");
+  }
+
+  flutter::EmbedderBackgroundPlatformMessageRouter::Callback message_callback;
+  if (callback != nullptr) {
+    message_callback = [callback, user_data](
+                           std::unique_ptr<flutter::PlatformMessage> message) {
+      DispatchPlatformMessageToEmbedder(callback, user_data,
+                                        std::move(message));
+    };
+  }
+
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)
+           ->SetBackgroundPlatformMessageCallback(
+               channel, std::move(message_callback))) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "The engine was not configured with a task runner for background "
+        "platform messages.");
+  }
+
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineGetProcAddresses(
     FlutterEngineProcTable* table) {
   if (!table) {
@@ -3216,6 +3456,12 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(NotifyDisplayUpdate, FlutterEngineNotifyDisplayUpdate);
   SET_PROC(ScheduleFrame, FlutterEngineScheduleFrame);
   SET_PROC(SetNextFrameCallback, FlutterEngineSetNextFrameCallback);
+  SET_PROC(SetBackgroundPlatformMessageCallback,
+           FlutterEngineSetBackgroundPlatformMessageCallback);
+  SET_PROC(EnqueuePointerEvents, FlutterEngineEnqueuePointerEvents);
+  SET_PROC(EnqueueKeyEvent, FlutterEngineEnqueueKeyEvent);
+  SET_PROC(GetInputQueueDepth, FlutterEngineGetInputQueueDepth);
+  SET_PROC(GetMemoryUsage, FlutterEngineGetMemoryUsage);
 #undef SET_PROC
 
   return kSuccess;
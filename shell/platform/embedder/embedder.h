@@ -1055,6 +1055,14 @@ typedef struct {
 typedef void (*FlutterKeyEventCallback)(bool /* handled */,
                                         void* /* user_data */);
 
+/// Called with the name of a subsystem of the engine, such as
+/// "raster_cache_layer_bytes", and the memory it holds. The values of names
+/// ending with "_count" are counts rather than bytes. The name is only valid
+/// for the duration of the call.
+typedef void (*FlutterEngineMemoryUsageCallback)(const char* /* name */,
+                                                 uint64_t /* value */,
+                                                 void* /* user_data */);
+
 struct _FlutterPlatformMessageResponseHandle;
 typedef struct _FlutterPlatformMessageResponseHandle
     FlutterPlatformMessageResponseHandle;
@@ -1445,6 +1453,46 @@ typedef void (*FlutterChannelUpdateCallback)(
     const FlutterChannelUpdate* /* channel update */,
     void* /* user data */);
 
+/// The timings and statistics of a frame rasterized by the engine. The
+/// timestamps are in nanoseconds of the clock of
+/// `FlutterEngineGetCurrentTime`.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameStatistics).
+  size_t struct_size;
+  /// The number of the frame, which increases with each frame built.
+  uint64_t frame_number;
+  /// When the vsync signal the frame was built for was received.
+  uint64_t vsync_start_time;
+  /// When the framework started and finished building the frame on the UI
+  /// thread.
+  uint64_t build_start_time;
+  uint64_t build_end_time;
+  /// When the engine started and finished rasterizing the frame on the raster
+  /// thread.
+  uint64_t raster_start_time;
+  uint64_t raster_end_time;
+  /// The GPU time in nanoseconds of the most recent frame whose GPU work
+  /// completed when this frame was rasterized, which is usually a frame or
+  /// two before this one. Zero if the renderer does not measure GPU times,
+  /// which only the Impeller renderers with GPU tracing enabled do.
+  uint64_t gpu_duration;
+  /// The number of frames in flight between the UI and raster threads,
+  /// including this one, when this frame was rasterized.
+  size_t pipeline_depth;
+  /// The number of layers in the layer trees of the frame.
+  size_t layer_count;
+  /// The number of ops in the display lists of those layers, including the
+  /// ops of nested display lists.
+  size_t display_list_op_count;
+  /// The number of subpasses that Impeller rendered to offscreen textures.
+  /// Zero for the Skia renderers.
+  size_t offscreen_pass_count;
+} FlutterFrameStatistics;
+
+typedef void (*FlutterFrameStatisticsCallback)(
+    const FlutterFrameStatistics* /* frame statistics */,
+    void* /* user data */);
+
 typedef struct _FlutterTaskRunner* FlutterTaskRunner;
 
 typedef struct {
@@ -1502,6 +1550,11 @@ typedef struct {
   /// Specify a callback that is used to set the thread priority for embedder
   /// task runners.
   void (*thread_priority_setter)(FlutterThreadPriority);
+  /// Specify the task runner for the thread on which the callbacks set with
+  /// `FlutterEngineSetBackgroundPlatformMessageCallback` are run. It should
+  /// not service tasks on the platform thread. If not specified, all platform
+  /// messages are handled on the platform thread.
+  const FlutterTaskRunnerDescription* background_platform_message_task_runner;
 } FlutterCustomTaskRunners;
 
 typedef struct {
@@ -1711,6 +1764,23 @@ typedef struct {
   /// outside of this area are transparent and the embedder may choose not
   /// to render them. Coordinates are in physical pixels.
   FlutterRegion* paint_region;
+
+  /// The area of the backing store whose contents changed since the previous
+  /// call to the `present_layers_callback`, compared to the layer at the same
+  /// position in the layers presented then. Pixels outside of this area are
+  /// the same as in that layer, so an embedder that kept its contents may only
+  /// update this area, for example with partial plane updates. The backing
+  /// store itself is rendered entirely and may not be the same as the one
+  /// presented then. Coordinates are in physical pixels.
+  ///
+  /// This is null if the damage is unknown, in which case the entire backing
+  /// store must be considered changed. This happens for the first frame, when
+  /// platform views move between layers, or when the root surface
+  /// transformation changes.
+  ///
+  /// This member was added after `paint_region`. Embedders must check that
+  /// `struct_size` includes it before reading it.
+  FlutterRegion* damage_region;
 } FlutterBackingStorePresentInfo;
 
 typedef struct {
@@ -1775,6 +1845,24 @@ typedef struct {
   FlutterLayersPresentCallback present_layers_callback;
   /// Avoid caching backing stores provided by this compositor.
   bool avoid_backing_store_cache;
+  /// The number of consecutive frames a cached backing store may go unused
+  /// before it is collected, so that backing stores are reused when the
+  /// layers change. Zero or one collects the backing stores that were not
+  /// used during a frame. Ignored if `avoid_backing_store_cache` is set.
+  size_t backing_store_cache_frame_count;
+  /// The maximum number of bytes of the unused backing stores kept in the
+  /// cache, estimated at four bytes per pixel. The least recently used backing
+  /// stores beyond this budget are collected. Zero for no limit. Ignored if
+  /// `avoid_backing_store_cache` is set.
+  size_t backing_store_cache_max_bytes;
+  /// If greater than one, the width and height of the backing stores requested
+  /// in `FlutterBackingStoreConfig.size` are rounded up to a multiple of this
+  /// number of pixels, so that layers whose size changes from frame to frame,
+  /// for example while a window is resized, reuse the same backing stores.
+  /// The layers then only cover the top left `FlutterLayer.size` of their
+  /// backing stores, and the embedder must only present that part. Ignored if
+  /// `avoid_backing_store_cache` is set.
+  size_t backing_store_size_alignment;
 } FlutterCompositor;
 
 typedef struct {
@@ -2267,6 +2355,22 @@ typedef struct {
   /// being registered on the framework side. The callback is invoked from
   /// a task posted to the platform thread.
   FlutterChannelUpdateCallback channel_update_callback;
+
+  /// The callback invoked with the statistics of each frame after it was
+  /// rasterized, for embedders to monitor the performance of the application
+  /// without a listener in Dart. The callback is invoked on the raster thread
+  /// and must not block. The statistics are only valid during the call.
+  FlutterFrameStatisticsCallback frame_statistics_callback;
+
+  /// Whether frames are begun as soon as the framework requests them, rather
+  /// than at the next tick of the 60 fps timer the engine falls back to when
+  /// no `vsync_callback` is provided. Meant for embedders that render without
+  /// a display, for example to generate images on a server, where frames
+  /// should only be limited by how fast they can be built and rasterized.
+  /// Animations still advance by 1/60th of a second per frame.
+  ///
+  /// Ignored if a `vsync_callback` is provided.
+  bool render_without_vsync;
 } FlutterProjectArgs;
 
 #ifndef FLUTTER_ENGINE_NO_PROTOTYPES
@@ -2451,6 +2555,98 @@ FlutterEngineResult FlutterEngineSendKeyEvent(FLUTTER_API_SYMBOL(FlutterEngine)
                                               FlutterKeyEventCallback callback,
                                               void* user_data);
 
+//------------------------------------------------------------------------------
+/// @brief      Queues pointer events to be dispatched to the framework along
+///             with the other events queued with this call and
+///             `FlutterEngineEnqueueKeyEvent`. All the queued events are
+///             dispatched in order by a single task on the UI thread, and the
+///             events queued while that task is pending join it, so that high
+///             frequency input sources do not post a task for each of their
+///             events like `FlutterEngineSendPointerEvent` does.
+///
+///             Unlike `FlutterEngineSendPointerEvent`, this may be called on
+///             any thread.
+///
+/// @param[in]  engine        A running engine instance.
+/// @param[in]  events        The events to queue. This function will no longer
+///                           access `events` after returning.
+/// @param[in]  events_count  The number of events in `events`.
+///
+/// @return     The result of the call. `kInternalInconsistency` if the input
+///             queue did not have room for the events, none of which were
+///             queued.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineEnqueuePointerEvents(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPointerEvent* events,
+    size_t events_count);
+
+//------------------------------------------------------------------------------
+/// @brief      Queues a key event to be dispatched to the framework along with
+///             the other queued input events. See
+///             `FlutterEngineEnqueuePointerEvents`. The `callback` is invoked
+///             on the platform thread, like the one of
+///             `FlutterEngineSendKeyEvent`, unless the event could not be
+///             queued.
+///
+/// @param[in]  engine         A running engine instance.
+/// @param[in]  event          The event data to be queued. This function will
+///                            no longer access `event` after returning.
+/// @param[in]  callback       The callback invoked by the engine when the
+///                            Flutter application has decided whether it
+///                            handles this event. Accepts nullptr.
+/// @param[in]  user_data      The context associated with the callback.
+///                            Accepts nullptr.
+///
+/// @return     The result of the call. `kInternalInconsistency` if the input
+///             queue was full.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineEnqueueKeyEvent(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterKeyEvent* event,
+    FlutterKeyEventCallback callback,
+    void* user_data);
+
+//------------------------------------------------------------------------------
+/// @brief      Gets the number of input events queued with
+///             `FlutterEngineEnqueuePointerEvents` and
+///             `FlutterEngineEnqueueKeyEvent` that have not been dispatched to
+///             the framework yet. A depth that keeps growing means the UI
+///             thread does not keep up with the input source, which should
+///             coalesce its events before queuing them.
+///
+/// @param[in]  engine     A running engine instance.
+/// @param[out] depth_out  The number of queued events.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetInputQueueDepth(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    size_t* depth_out);
+
+//------------------------------------------------------------------------------
+/// @brief      Reports the memory held by the subsystems of the engine, such
+///             as the raster cache, the glyph atlases and the textures of
+///             decoded images, so that a growth of the memory of the process
+///             can be attributed to one of them. The values are a snapshot
+///             updated at most once per second as frames are rasterized, and
+///             are zero until the first frame is.
+///
+/// @param[in]  engine     A running engine instance.
+/// @param[in]  callback   Called synchronously for each subsystem.
+/// @param[in]  user_data  The user data passed to the callback.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetMemoryUsage(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineMemoryUsageCallback callback,
+    void* user_data);
+
 FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineSendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
@@ -2962,6 +3158,34 @@ FlutterEngineResult FlutterEngineSetNextFrameCallback(
     VoidCallback callback,
     void* user_data);
 
+//------------------------------------------------------------------------------
+/// @brief      Set the callback that handles the platform messages sent on a
+///             channel, on the `background_platform_message_task_runner` of
+///             the custom task runners instead of the platform thread. This is
+///             meant for the channels used by background isolates, whose
+///             traffic then never waits on the work of the platform thread.
+///             Responses to these messages may be sent with
+///             `FlutterEngineSendPlatformMessageResponse` from any thread. The
+///             messages on the other channels are still handled by the
+///             `platform_message_callback` on the platform thread.
+///
+/// @param[in]  engine     A running engine instance.
+/// @param[in]  channel    The channel of the messages to handle.
+/// @param[in]  callback   The callback to handle the messages with, or NULL to
+///                        handle them on the platform thread again.
+/// @param[in]  user_data  A baton passed by the engine to the callback. This
+///                        baton is not interpreted by the engine in any way.
+///
+/// @return     The result of the call. `kInvalidArguments` if the engine was
+///             not configured with a `background_platform_message_task_runner`.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSetBackgroundPlatformMessageCallback(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* channel,
+    FlutterPlatformMessageCallback callback,
+    void* user_data);
+
 #endif  // !FLUTTER_ENGINE_NO_PROTOTYPES
 
 // Typedefs for the function pointers in FlutterEngineProcTable.
@@ -3084,6 +3308,28 @@ typedef FlutterEngineResult (*FlutterEngineSetNextFrameCallbackFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     VoidCallback callback,
     void* user_data);
+typedef FlutterEngineResult (
+    *FlutterEngineSetBackgroundPlatformMessageCallbackFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* channel,
+    FlutterPlatformMessageCallback callback,
+    void* user_data);
+typedef FlutterEngineResult (*FlutterEngineEnqueuePointerEventsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPointerEvent* events,
+    size_t events_count);
+typedef FlutterEngineResult (*FlutterEngineEnqueueKeyEventFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterKeyEvent* event,
+    FlutterKeyEventCallback callback,
+    void* user_data);
+typedef FlutterEngineResult (*FlutterEngineGetInputQueueDepthFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    size_t* depth_out);
+typedef FlutterEngineResult (*FlutterEngineGetMemoryUsageFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineMemoryUsageCallback callback,
+    void* user_data);
 
 /// Function-pointer-based versions of the APIs above.
 typedef struct {
@@ -3130,6 +3376,12 @@ typedef struct {
   FlutterEngineNotifyDisplayUpdateFnPtr NotifyDisplayUpdate;
   FlutterEngineScheduleFrameFnPtr ScheduleFrame;
   FlutterEngineSetNextFrameCallbackFnPtr SetNextFrameCallback;
+  FlutterEngineSetBackgroundPlatformMessageCallbackFnPtr
+      SetBackgroundPlatformMessageCallback;
+  FlutterEngineEnqueuePointerEventsFnPtr EnqueuePointerEvents;
+  FlutterEngineEnqueueKeyEventFnPtr EnqueueKeyEvent;
+  FlutterEngineGetInputQueueDepthFnPtr GetInputQueueDepth;
+  FlutterEngineGetMemoryUsageFnPtr GetMemoryUsage;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
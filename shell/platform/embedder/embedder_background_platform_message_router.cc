@@ -0,0 +1,52 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_background_platform_message_router.h"
+
+#include <utility>
+
+#include "flutter/fml/make_copyable.h"
+
+namespace flutter {
+
+EmbedderBackgroundPlatformMessageRouter::
+    EmbedderBackgroundPlatformMessageRouter() = default;
+
+EmbedderBackgroundPlatformMessageRouter::
+    ~EmbedderBackgroundPlatformMessageRouter() = default;
+
+void EmbedderBackgroundPlatformMessageRouter::SetCallback(
+    const std::string& channel,
+    fml::RefPtr<fml::TaskRunner> task_runner,
+    Callback callback) {
+  std::scoped_lock lock(handlers_mutex_);
+  if (callback) {
+    FML_DCHECK(task_runner);
+    handlers_[channel] = {std::move(task_runner),
+                          std::make_shared<Callback>(std::move(callback))};
+  } else {
+    handlers_.erase(channel);
+  }
+}
+
+bool EmbedderBackgroundPlatformMessageRouter::Route(
+    std::unique_ptr<PlatformMessage>& message) {
+  Handler handler;
+  {
+    std::scoped_lock lock(handlers_mutex_);
+    auto found = handlers_.find(message->channel());
+    if (found == handlers_.end()) {
+      return false;
+    }
+    handler = found->second;
+  }
+  handler.task_runner->PostTask(fml::MakeCopyable(
+      [callback = std::move(handler.callback),
+       message = std::move(message)]() mutable {
+        (*callback)(std::move(message));
+      }));
+  return true;
+}
+
+}  // namespace flutter
@@ -0,0 +1,69 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_BACKGROUND_PLATFORM_MESSAGE_ROUTER_H_
+#define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_BACKGROUND_PLATFORM_MESSAGE_ROUTER_H_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/lib/ui/window/platform_message.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Routes the platform messages of the channels the embedder handles off the
+/// platform thread to the task runners specified for them, so that they are
+/// not delayed by the work of the platform thread.
+///
+/// The messages are routed from the thread of the isolate that sent them, and
+/// callbacks may be set and cleared concurrently from any thread.
+///
+class EmbedderBackgroundPlatformMessageRouter {
+ public:
+  using Callback = std::function<void(std::unique_ptr<PlatformMessage>)>;
+
+  EmbedderBackgroundPlatformMessageRouter();
+
+  ~EmbedderBackgroundPlatformMessageRouter();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the callback run on a task runner for the messages on a
+  ///             channel. A null callback lets the messages on the channel go
+  ///             to the platform thread again.
+  ///
+  void SetCallback(const std::string& channel,
+                   fml::RefPtr<fml::TaskRunner> task_runner,
+                   Callback callback);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Posts the message to the callback of its channel, if any.
+  ///
+  /// @return     Whether the message was routed. If not, the message is left
+  ///             untouched for the caller to handle.
+  ///
+  bool Route(std::unique_ptr<PlatformMessage>& message);
+
+ private:
+  struct Handler {
+    fml::RefPtr<fml::TaskRunner> task_runner;
+    // Shared so that a callback cleared while a message is pending is still
+    // alive to handle it.
+    std::shared_ptr<Callback> callback;
+  };
+
+  std::mutex handlers_mutex_;
+  std::map<std::string, Handler> handlers_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbedderBackgroundPlatformMessageRouter);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_BACKGROUND_PLATFORM_MESSAGE_ROUTER_H_
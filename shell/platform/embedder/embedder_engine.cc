@@ -5,6 +5,7 @@
 #include "flutter/shell/platform/embedder/embedder_engine.h"
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/shell/platform/embedder/vsync_waiter_embedder.h"
 
 namespace flutter {
@@ -28,14 +29,19 @@ EmbedderEngine::EmbedderEngine(
     RunConfiguration run_configuration,
     const Shell::CreateCallback<PlatformView>& on_create_platform_view,
     const Shell::CreateCallback<Rasterizer>& on_create_rasterizer,
-    std::unique_ptr<EmbedderExternalTextureResolver> external_texture_resolver)
+    std::unique_ptr<EmbedderExternalTextureResolver> external_texture_resolver,
+    std::shared_ptr<EmbedderBackgroundPlatformMessageRouter>
+        background_platform_message_router)
     : thread_host_(std::move(thread_host)),
       task_runners_(task_runners),
       run_configuration_(std::move(run_configuration)),
       shell_args_(std::make_unique<ShellArgs>(settings,
                                               on_create_platform_view,
                                               on_create_rasterizer)),
-      external_texture_resolver_(std::move(external_texture_resolver)) {}
+      external_texture_resolver_(std::move(external_texture_resolver)),
+      background_platform_message_router_(
+          std::move(background_platform_message_router)),
+      input_queue_(std::make_shared<EmbedderInputQueue>()) {}
 
 EmbedderEngine::~EmbedderEngine() = default;
 
@@ -144,6 +150,64 @@ bool EmbedderEngine::SendPlatformMessage(
   return true;
 }
 
+bool EmbedderEngine::EnqueuePointerDataPacket(
+    const flutter::PointerDataPacket& packet) {
+  if (!IsValid()) {
+    return false;
+  }
+  switch (input_queue_->PushPointerData(packet)) {
+    case EmbedderInputQueue::PushResult::kQueueFull:
+      return false;
+    case EmbedderInputQueue::PushResult::kQueued:
+      return true;
+    case EmbedderInputQueue::PushResult::kNeedsDrain:
+      ScheduleInputQueueDrain();
+      return true;
+  }
+  return false;
+}
+
+bool EmbedderEngine::EnqueueKeyMessage(
+    std::unique_ptr<PlatformMessage> message) {
+  if (!IsValid() || !message) {
+    return false;
+  }
+  switch (input_queue_->PushKeyMessage(std::move(message))) {
+    case EmbedderInputQueue::PushResult::kQueueFull:
+      return false;
+    case EmbedderInputQueue::PushResult::kQueued:
+      return true;
+    case EmbedderInputQueue::PushResult::kNeedsDrain:
+      ScheduleInputQueueDrain();
+      return true;
+  }
+  return false;
+}
+
+size_t EmbedderEngine::GetInputQueueDepth() const {
+  return input_queue_->GetDepth();
+}
+
+void EmbedderEngine::ScheduleInputQueueDrain() {
+  task_runners_.GetUITaskRunner()->PostTaskWithGrade(
+      [queue = input_queue_, engine = shell_->GetEngine()]() {
+        queue->Drain(
+            [&engine](std::unique_ptr<PointerDataPacket> packet) {
+              if (engine) {
+                const uint64_t flow_id = fml::tracing::TraceNonce();
+                TRACE_FLOW_BEGIN("flutter", "PointerEvent", flow_id);
+                engine->DispatchPointerDataPacket(std::move(packet), flow_id);
+              }
+            },
+            [&engine](std::unique_ptr<PlatformMessage> message) {
+              if (engine) {
+                engine->DispatchPlatformMessage(std::move(message));
+              }
+            });
+      },
+      fml::TaskSourceGrade::kUserInteraction);
+}
+
 bool EmbedderEngine::RegisterTexture(int64_t texture) {
   if (!IsValid()) {
     return false;
@@ -289,6 +353,18 @@ bool EmbedderEngine::ScheduleFrame() {
   return true;
 }
 
+bool EmbedderEngine::SetBackgroundPlatformMessageCallback(
+    const std::string& channel,
+    EmbedderBackgroundPlatformMessageRouter::Callback callback) {
+  if (!background_platform_message_router_) {
+    return false;
+  }
+  background_platform_message_router_->SetCallback(
+      channel, thread_host_->GetBackgroundPlatformMessageTaskRunner(),
+      std::move(callback));
+  return true;
+}
+
 Shell& EmbedderEngine::GetShell() {
   FML_DCHECK(shell_);
   return *shell_.get();
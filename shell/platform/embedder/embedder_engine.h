@@ -12,7 +12,9 @@
 #include "flutter/shell/common/shell.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/shell/platform/embedder/embedder.h"
+#include "flutter/shell/platform/embedder/embedder_background_platform_message_router.h"
 #include "flutter/shell/platform/embedder/embedder_external_texture_resolver.h"
+#include "flutter/shell/platform/embedder/embedder_input_queue.h"
 #include "flutter/shell/platform/embedder/embedder_thread_host.h"
 namespace flutter {
 
@@ -30,7 +32,9 @@ class EmbedderEngine {
       const Shell::CreateCallback<PlatformView>& on_create_platform_view,
       const Shell::CreateCallback<Rasterizer>& on_create_rasterizer,
       std::unique_ptr<EmbedderExternalTextureResolver>
-          external_texture_resolver);
+          external_texture_resolver,
+      std::shared_ptr<EmbedderBackgroundPlatformMessageRouter>
+          background_platform_message_router = nullptr);
 
   ~EmbedderEngine();
 
@@ -56,6 +60,17 @@ class EmbedderEngine {
 
   bool SendPlatformMessage(std::unique_ptr<PlatformMessage> message);
 
+  // Queues pointer events to be dispatched along with the other queued input
+  // events by a single task on the UI thread. Returns false if the input
+  // queue is full.
+  bool EnqueuePointerDataPacket(const flutter::PointerDataPacket& packet);
+
+  // Queues the platform message of a key event. See
+  // |EnqueuePointerDataPacket|.
+  bool EnqueueKeyMessage(std::unique_ptr<PlatformMessage> message);
+
+  size_t GetInputQueueDepth() const;
+
   bool RegisterTexture(int64_t texture);
 
   bool UnregisterTexture(int64_t texture);
@@ -85,6 +100,10 @@ class EmbedderEngine {
 
   bool ScheduleFrame();
 
+  bool SetBackgroundPlatformMessageCallback(
+      const std::string& channel,
+      EmbedderBackgroundPlatformMessageRouter::Callback callback);
+
   Shell& GetShell();
 
  private:
@@ -94,6 +113,12 @@ class EmbedderEngine {
   std::unique_ptr<ShellArgs> shell_args_;
   std::unique_ptr<Shell> shell_;
   std::unique_ptr<EmbedderExternalTextureResolver> external_texture_resolver_;
+  std::shared_ptr<EmbedderBackgroundPlatformMessageRouter>
+      background_platform_message_router_;
+  // Shared with the pending drain task, which may outlive the engine.
+  const std::shared_ptr<EmbedderInputQueue> input_queue_;
+
+  void ScheduleInputQueueDrain();
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderEngine);
 };
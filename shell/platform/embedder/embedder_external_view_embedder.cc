@@ -5,6 +5,7 @@
 #include "flutter/shell/platform/embedder/embedder_external_view_embedder.h"
 
 #include <cassert>
+#include <optional>
 #include <utility>
 
 #include "flutter/common/constants.h"
@@ -19,10 +20,12 @@ static const auto kRootViewIdentifier = EmbedderExternalView::ViewIdentifier{};
 EmbedderExternalViewEmbedder::EmbedderExternalViewEmbedder(
     bool avoid_backing_store_cache,
     const CreateRenderTargetCallback& create_render_target_callback,
-    const PresentCallback& present_callback)
+    const PresentCallback& present_callback,
+    const EmbedderRenderTargetCache::Config& render_target_cache_config)
     : avoid_backing_store_cache_(avoid_backing_store_cache),
       create_render_target_callback_(create_render_target_callback),
-      present_callback_(present_callback) {
+      present_callback_(present_callback),
+      render_target_cache_(render_target_cache_config) {
   FML_DCHECK(create_render_target_callback_);
   FML_DCHECK(present_callback_);
 }
@@ -130,8 +133,15 @@ static FlutterBackingStoreConfig MakeBackingStoreConfig(
   return config;
 }
 
+// |ExternalViewEmbedder|
+bool EmbedderExternalViewEmbedder::SupportsFrameDamage() {
+  return true;
+}
+
 namespace {
 
+using PresentedLayer = EmbedderExternalViewEmbedder::PresentedLayer;
+
 struct PlatformView {
   EmbedderExternalView::ViewIdentifier view_identifier;
   const EmbeddedViewParams* params;
@@ -271,10 +281,31 @@ class Layer {
     return flutter_contents_region_.getRects();
   }
 
+  /// Returns the part of this layer whose Flutter contents changed since the
+  /// previous frame, or nullopt if unknown.
+  const std::optional<std::vector<SkIRect>>& damage() const { return damage_; }
+
+  void SetDamage(std::vector<SkIRect> damage) { damage_ = std::move(damage); }
+
+  /// Returns the contents of this layer, against which the damage of the next
+  /// frame is computed.
+  PresentedLayer GetPresentedLayer() const {
+    PresentedLayer presented_layer;
+    for (const auto& platform_view : platform_views_) {
+      if (platform_view.view_identifier.platform_view_id.has_value()) {
+        presented_layer.platform_view_ids.push_back(
+            platform_view.view_identifier.platform_view_id.value());
+      }
+    }
+    presented_layer.flutter_contents_region = flutter_contents_region_;
+    return presented_layer;
+  }
+
  private:
   std::vector<PlatformView> platform_views_;
   std::vector<EmbedderExternalView*> flutter_contents_;
   DlRegion flutter_contents_region_;
+  std::optional<std::vector<SkIRect>> damage_;
   std::unique_ptr<EmbedderRenderTarget> render_target_;
   friend class LayerBuilder;
 };
@@ -330,6 +361,48 @@ class LayerBuilder {
     }
   }
 
+  /// Computes the damage of each layer, which is the part of the frame damage
+  /// covered by its Flutter contents in this frame or in the layer at the same
+  /// position in the previous frame.
+  ///
+  /// The damage of the layers is unknown if the frame damage is unknown, or if
+  /// the platform views are not arranged in the same layers as in the previous
+  /// frame.
+  void ComputeDamage(const std::optional<SkIRect>& frame_damage,
+                     const std::vector<PresentedLayer>& presented_layers) {
+    if (!frame_damage.has_value() ||
+        presented_layers.size() != layers_.size()) {
+      return;
+    }
+    std::vector<PresentedLayer> current_layers = GetPresentedLayers();
+    for (size_t i = 0; i < layers_.size(); i++) {
+      if (current_layers[i].platform_view_ids !=
+          presented_layers[i].platform_view_ids) {
+        return;
+      }
+    }
+    DlRegion frame_damage_region(frame_damage.value());
+    for (size_t i = 0; i < layers_.size(); i++) {
+      DlRegion contents_region =
+          DlRegion::MakeUnion(current_layers[i].flutter_contents_region,
+                              presented_layers[i].flutter_contents_region);
+      layers_[i].SetDamage(
+          DlRegion::MakeIntersection(frame_damage_region, contents_region)
+              .getRects());
+    }
+  }
+
+  /// Returns the contents of the layers, against which the damage of the next
+  /// frame is computed.
+  std::vector<PresentedLayer> GetPresentedLayers() const {
+    std::vector<PresentedLayer> presented_layers;
+    presented_layers.reserve(layers_.size());
+    for (const auto& layer : layers_) {
+      presented_layers.push_back(layer.GetPresentedLayer());
+    }
+    return presented_layers;
+  }
+
   /// Populates EmbedderLayers from layer builder's layers.
   void PushLayers(EmbedderLayers& layers) {
     for (auto& layer : layers_) {
@@ -341,7 +414,7 @@ class LayerBuilder {
       }
       if (layer.render_target() != nullptr) {
         layers.PushBackingStoreLayer(layer.render_target()->GetBackingStore(),
-                                     layer.coverage());
+                                     layer.coverage(), layer.damage());
       }
     }
   }
@@ -434,10 +507,14 @@ void EmbedderExternalViewEmbedder::SubmitFlutterView(
   builder.PrepareBackingStore([&](FlutterBackingStoreConfig config) {
     std::unique_ptr<EmbedderRenderTarget> target;
     if (!avoid_backing_store_cache_) {
+      // Layers of similar sizes share the render targets of the aligned size.
+      auto size = render_target_cache_.GetRenderTargetSize(
+          SkISize{static_cast<int32_t>(config.size.width),
+                  static_cast<int32_t>(config.size.height)});
+      config.size.width = size.width();
+      config.size.height = size.height();
       target = render_target_cache_.GetRenderTarget(
-          EmbedderExternalView::RenderTargetDescriptor(
-              SkISize{static_cast<int32_t>(config.size.width),
-                      static_cast<int32_t>(config.size.height)}));
+          EmbedderExternalView::RenderTargetDescriptor(size));
     }
     if (target != nullptr) {
       return target;
@@ -458,7 +535,7 @@ void EmbedderExternalViewEmbedder::SubmitFlutterView(
   //
   // @warning: Embedder may trample on our OpenGL context here.
   auto deferred_cleanup_render_targets =
-      render_target_cache_.ClearAllRenderTargetsInCache();
+      render_target_cache_.CollectUnusedRenderTargets();
 
   // The OpenGL context could have been trampled by the embedder at this point
   // as it attempted to collect old render targets and create new ones. Tell
@@ -469,6 +546,15 @@ void EmbedderExternalViewEmbedder::SubmitFlutterView(
 
   builder.Render();
 
+  // The damage is only comparable to the previous frame if the layers are
+  // transformed the same way.
+  if (pending_surface_transformation_ == presented_surface_transformation_) {
+    builder.ComputeDamage(frame->submit_info().frame_damage,
+                          presented_layers_);
+  }
+  presented_layers_ = builder.GetPresentedLayers();
+  presented_surface_transformation_ = pending_surface_transformation_;
+
   // We are going to be transferring control back over to the embedder there
   // the context may be trampled upon again. Flush all operations to the
   // underlying rendering API.
@@ -8,7 +8,9 @@
 #include <map>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
+#include "flutter/display_list/geometry/dl_region.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/hash_combine.h"
 #include "flutter/fml/macros.h"
@@ -38,6 +40,13 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
       std::function<bool(const std::vector<const FlutterLayer*>& layers)>;
   using SurfaceTransformationCallback = std::function<SkMatrix(void)>;
 
+  /// The contents of a layer presented to the embedder, against which the
+  /// damage of the layer at the same position in the next frame is computed.
+  struct PresentedLayer {
+    std::vector<EmbedderExternalView::PlatformViewID> platform_view_ids;
+    DlRegion flutter_contents_region;
+  };
+
   //----------------------------------------------------------------------------
   /// @brief      Creates an external view embedder used by the generic embedder
   ///             API.
@@ -54,11 +63,16 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   ///                                     collection of layers (backed by
   ///                                     fulfilled render targets) to the
   ///                                     embedder for presentation.
+  /// @param[in]  render_target_cache_config
+  ///                                     How long and in which sizes the
+  ///                                     render targets are cached, unless
+  ///                                     avoid_backing_store_cache is set.
   ///
   EmbedderExternalViewEmbedder(
       bool avoid_backing_store_cache,
       const CreateRenderTargetCallback& create_render_target_callback,
-      const PresentCallback& present_callback);
+      const PresentCallback& present_callback,
+      const EmbedderRenderTargetCache::Config& render_target_cache_config);
 
   //----------------------------------------------------------------------------
   /// @brief      Collects the external view embedder.
@@ -107,6 +121,9 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   // |ExternalViewEmbedder|
   DlCanvas* GetRootCanvas() override;
 
+  // |ExternalViewEmbedder|
+  bool SupportsFrameDamage() override;
+
  private:
   const bool avoid_backing_store_cache_;
   const CreateRenderTargetCallback create_render_target_callback_;
@@ -118,6 +135,9 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   EmbedderExternalView::PendingViews pending_views_;
   std::vector<EmbedderExternalView::ViewIdentifier> composition_order_;
   EmbedderRenderTargetCache render_target_cache_;
+  // The layers of the last frame presented to the embedder.
+  std::vector<PresentedLayer> presented_layers_;
+  SkMatrix presented_surface_transformation_;
 
   void Reset();
 
@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_input_queue.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+EmbedderInputQueue::EmbedderInputQueue(size_t capacity)
+    : entries_(std::max<size_t>(capacity, 1u)) {}
+
+EmbedderInputQueue::~EmbedderInputQueue() = default;
+
+EmbedderInputQueue::Entry& EmbedderInputQueue::EntryAt(size_t index) {
+  return entries_[(head_ + index) % entries_.size()];
+}
+
+EmbedderInputQueue::PushResult EmbedderInputQueue::PushPointerData(
+    const PointerDataPacket& packet) {
+  std::scoped_lock lock(mutex_);
+  const size_t count = packet.GetLength();
+  if (entries_.size() - depth_ < count) {
+    return PushResult::kQueueFull;
+  }
+  const bool was_empty = depth_ == 0;
+  for (size_t i = 0; i < count; i++) {
+    EntryAt(depth_++).pointer_data = packet.GetPointerData(i);
+  }
+  FML_TRACE_COUNTER("flutter", "EmbedderInputQueue",
+                    reinterpret_cast<int64_t>(this), "Depth", depth_);
+  return was_empty ? PushResult::kNeedsDrain : PushResult::kQueued;
+}
+
+EmbedderInputQueue::PushResult EmbedderInputQueue::PushKeyMessage(
+    std::unique_ptr<PlatformMessage> message) {
+  std::scoped_lock lock(mutex_);
+  if (depth_ == entries_.size()) {
+    return PushResult::kQueueFull;
+  }
+  const bool was_empty = depth_ == 0;
+  EntryAt(depth_++).key_message = std::move(message);
+  FML_TRACE_COUNTER("flutter", "EmbedderInputQueue",
+                    reinterpret_cast<int64_t>(this), "Depth", depth_);
+  return was_empty ? PushResult::kNeedsDrain : PushResult::kQueued;
+}
+
+void EmbedderInputQueue::Drain(
+    const PointerDataPacketCallback& dispatch_pointer_data_packet,
+    const PlatformMessageCallback& dispatch_key_message) {
+  TRACE_EVENT0("flutter", "EmbedderInputQueue::Drain");
+  // The events are moved out of the ring so that the callbacks run without
+  // the lock, and events queued meanwhile schedule another drain.
+  std::vector<Entry> entries;
+  {
+    std::scoped_lock lock(mutex_);
+    entries.reserve(depth_);
+    for (size_t i = 0; i < depth_; i++) {
+      entries.push_back(std::move(EntryAt(i)));
+    }
+    head_ = (head_ + depth_) % entries_.size();
+    depth_ = 0;
+    FML_TRACE_COUNTER("flutter", "EmbedderInputQueue",
+                      reinterpret_cast<int64_t>(this), "Depth", 0);
+  }
+
+  size_t index = 0;
+  while (index < entries.size()) {
+    if (entries[index].key_message) {
+      dispatch_key_message(std::move(entries[index].key_message));
+      index++;
+      continue;
+    }
+    size_t end = index;
+    while (end < entries.size() && !entries[end].key_message) {
+      end++;
+    }
+    auto packet = std::make_unique<PointerDataPacket>(end - index);
+    for (size_t i = index; i < end; i++) {
+      packet->SetPointerData(i - index, entries[i].pointer_data);
+    }
+    dispatch_pointer_data_packet(std::move(packet));
+    index = end;
+  }
+}
+
+size_t EmbedderInputQueue::GetDepth() const {
+  std::scoped_lock lock(mutex_);
+  return depth_;
+}
+
+size_t EmbedderInputQueue::GetCapacity() const {
+  return entries_.size();
+}
+
+}  // namespace flutter
@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_INPUT_QUEUE_H_
+#define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_INPUT_QUEUE_H_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/window/platform_message.h"
+#include "flutter/lib/ui/window/pointer_data_packet.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A bounded ring buffer of the pointer and key events queued by
+///             the embedder, which are all dispatched to the framework by a
+///             single task on the UI thread.
+///
+///             Events queued while a drain is pending join that drain, so that
+///             high frequency input sources cost one UI thread task per drain
+///             instead of one per event. Consecutive pointer events are
+///             dispatched in a single packet, and the order of the pointer
+///             and key events is kept.
+///
+///             This class is thread-safe.
+///
+class EmbedderInputQueue {
+ public:
+  /// The default number of events the queue holds.
+  static constexpr size_t kDefaultCapacity = 1024u;
+
+  enum class PushResult {
+    /// The queue did not have room for all the events, none of which were
+    /// queued.
+    kQueueFull,
+    /// The events were queued behind others, whose drain is pending.
+    kQueued,
+    /// The events were queued into an empty queue, and the caller must
+    /// schedule a drain.
+    kNeedsDrain,
+  };
+
+  using PointerDataPacketCallback =
+      std::function<void(std::unique_ptr<PointerDataPacket>)>;
+  using PlatformMessageCallback =
+      std::function<void(std::unique_ptr<PlatformMessage>)>;
+
+  explicit EmbedderInputQueue(size_t capacity = kDefaultCapacity);
+
+  ~EmbedderInputQueue();
+
+  /// @brief      Queues all the pointer data of `packet`, or none of it.
+  PushResult PushPointerData(const PointerDataPacket& packet);
+
+  /// @brief      Queues the platform message of a key event.
+  PushResult PushKeyMessage(std::unique_ptr<PlatformMessage> message);
+
+  /// @brief      Removes all the queued events and dispatches them in order,
+  ///             with the consecutive pointer events in a single packet.
+  void Drain(const PointerDataPacketCallback& dispatch_pointer_data_packet,
+             const PlatformMessageCallback& dispatch_key_message);
+
+  /// @brief      The number of events in the queue.
+  size_t GetDepth() const;
+
+  size_t GetCapacity() const;
+
+ private:
+  struct Entry {
+    PointerData pointer_data;
+    // The key event, or null for a pointer event.
+    std::unique_ptr<PlatformMessage> key_message;
+  };
+
+  mutable std::mutex mutex_;
+  std::vector<Entry> entries_;
+  // The index of the oldest entry.
+  size_t head_ = 0;
+  size_t depth_ = 0;
+
+  Entry& EntryAt(size_t index);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbedderInputQueue);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_INPUT_QUEUE_H_
@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_input_queue.h"
+
+#include <string>
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+namespace {
+
+std::unique_ptr<PointerDataPacket> MakePacket(size_t count, int64_t device) {
+  auto packet = std::make_unique<PointerDataPacket>(count);
+  for (size_t i = 0; i < count; i++) {
+    PointerData data;
+    data.Clear();
+    data.device = device;
+    data.physical_x = static_cast<double>(i);
+    packet->SetPointerData(i, data);
+  }
+  return packet;
+}
+
+std::unique_ptr<PlatformMessage> MakeKeyMessage() {
+  return std::make_unique<PlatformMessage>("flutter/keydata", nullptr);
+}
+
+}  // namespace
+
+TEST(EmbedderInputQueueTest, OnlyTheFirstEventsNeedADrain) {
+  EmbedderInputQueue queue(8u);
+  EXPECT_EQ(queue.PushPointerData(*MakePacket(2u, 1)),
+            EmbedderInputQueue::PushResult::kNeedsDrain);
+  EXPECT_EQ(queue.PushKeyMessage(MakeKeyMessage()),
+            EmbedderInputQueue::PushResult::kQueued);
+  EXPECT_EQ(queue.GetDepth(), 3u);
+
+  queue.Drain([](std::unique_ptr<PointerDataPacket>) {},
+              [](std::unique_ptr<PlatformMessage>) {});
+  EXPECT_EQ(queue.GetDepth(), 0u);
+  EXPECT_EQ(queue.PushPointerData(*MakePacket(1u, 1)),
+            EmbedderInputQueue::PushResult::kNeedsDrain);
+}
+
+TEST(EmbedderInputQueueTest, RejectsEventsBeyondCapacity) {
+  EmbedderInputQueue queue(4u);
+  EXPECT_EQ(queue.PushPointerData(*MakePacket(3u, 1)),
+            EmbedderInputQueue::PushResult::kNeedsDrain);
+  // None of the events of a packet are queued if they do not all fit.
+  EXPECT_EQ(queue.PushPointerData(*MakePacket(2u, 1)),
+            EmbedderInputQueue::PushResult::kQueueFull);
+  EXPECT_EQ(queue.GetDepth(), 3u);
+  EXPECT_EQ(queue.PushKeyMessage(MakeKeyMessage()),
+            EmbedderInputQueue::PushResult::kQueued);
+  EXPECT_EQ(queue.PushKeyMessage(MakeKeyMessage()),
+            EmbedderInputQueue::PushResult::kQueueFull);
+  EXPECT_EQ(queue.GetDepth(), 4u);
+}
+
+TEST(EmbedderInputQueueTest, DrainsConsecutivePointerEventsInOnePacket) {
+  EmbedderInputQueue queue(8u);
+  queue.PushPointerData(*MakePacket(2u, 1));
+  queue.PushPointerData(*MakePacket(1u, 2));
+  queue.PushKeyMessage(MakeKeyMessage());
+  queue.PushPointerData(*MakePacket(3u, 3));
+
+  std::string order;
+  std::vector<size_t> packet_lengths;
+  queue.Drain(
+      [&](std::unique_ptr<PointerDataPacket> packet) {
+        order += "p";
+        packet_lengths.push_back(packet->GetLength());
+        if (packet_lengths.size() == 1u) {
+          EXPECT_EQ(packet->GetPointerData(0).device, 1);
+          EXPECT_EQ(packet->GetPointerData(1).device, 1);
+          EXPECT_EQ(packet->GetPointerData(1).physical_x, 1.0);
+          EXPECT_EQ(packet->GetPointerData(2).device, 2);
+        }
+      },
+      [&](std::unique_ptr<PlatformMessage> message) {
+        order += "k";
+        EXPECT_EQ(message->channel(), "flutter/keydata");
+      });
+  EXPECT_EQ(order, "pkp");
+  EXPECT_EQ(packet_lengths, (std::vector<size_t>{3u, 3u}));
+}
+
+TEST(EmbedderInputQueueTest, WrapsAroundTheRing) {
+  EmbedderInputQueue queue(4u);
+  for (int64_t round = 0; round < 3; round++) {
+    EXPECT_EQ(queue.PushPointerData(*MakePacket(3u, round)),
+              EmbedderInputQueue::PushResult::kNeedsDrain);
+    size_t drained = 0;
+    queue.Drain(
+        [&](std::unique_ptr<PointerDataPacket> packet) {
+          for (size_t i = 0; i < packet->GetLength(); i++) {
+            EXPECT_EQ(packet->GetPointerData(i).device, round);
+          }
+          drained += packet->GetLength();
+        },
+        [](std::unique_ptr<PlatformMessage>) {});
+    EXPECT_EQ(drained, 3u);
+  }
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_LAYERS_H_
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "flutter/flow/embedded_views.h"
@@ -24,8 +25,10 @@ class EmbedderLayers {
 
   ~EmbedderLayers();
 
-  void PushBackingStoreLayer(const FlutterBackingStore* store,
-                             const std::vector<SkIRect>& drawn_region);
+  void PushBackingStoreLayer(
+      const FlutterBackingStore* store,
+      const std::vector<SkIRect>& drawn_region,
+      const std::optional<std::vector<SkIRect>>& damage_region);
 
   void PushPlatformViewLayer(FlutterPlatformViewIdentifier identifier,
                              const EmbeddedViewParams& params);
@@ -49,6 +52,10 @@ class EmbedderLayers {
   std::vector<std::unique_ptr<std::vector<FlutterRect>>> rects_referenced_;
   std::vector<FlutterLayer> presented_layers_;
 
+  // Returns a region of the rectangles transformed to the root surface, which
+  // lives as long as the layers.
+  FlutterRegion* MakeRegion(const std::vector<SkIRect>& rects);
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderLayers);
 };
 
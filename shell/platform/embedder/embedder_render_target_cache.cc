@@ -4,12 +4,39 @@
 
 #include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace flutter {
 
-EmbedderRenderTargetCache::EmbedderRenderTargetCache() = default;
+EmbedderRenderTargetCache::EmbedderRenderTargetCache()
+    : EmbedderRenderTargetCache(Config{
+          .max_unused_frames = 1u,
+          .max_bytes = 0u,
+          .size_alignment = 1,
+      }) {}
+
+EmbedderRenderTargetCache::EmbedderRenderTargetCache(const Config& config)
+    : config_(Config{
+          .max_unused_frames = std::max<size_t>(config.max_unused_frames, 1u),
+          .max_bytes = config.max_bytes,
+          .size_alignment = std::max(config.size_alignment, 1),
+      }) {}
 
 EmbedderRenderTargetCache::~EmbedderRenderTargetCache() = default;
 
+SkISize EmbedderRenderTargetCache::GetRenderTargetSize(
+    const SkISize& layer_size) const {
+  auto align = [alignment = config_.size_alignment](int32_t value) {
+    return (value + alignment - 1) / alignment * alignment;
+  };
+  return SkISize::Make(align(layer_size.width()), align(layer_size.height()));
+}
+
+size_t EmbedderRenderTargetCache::GetByteSize(const SkISize& size) {
+  return static_cast<size_t>(size.width()) * size.height() * 4u;
+}
+
 std::unique_ptr<EmbedderRenderTarget>
 EmbedderRenderTargetCache::GetRenderTarget(
     const EmbedderExternalView::RenderTargetDescriptor& descriptor) {
@@ -17,8 +44,9 @@ EmbedderRenderTargetCache::GetRenderTarget(
   if (compatible_target == cached_render_targets_.end()) {
     return nullptr;
   }
-  auto target = std::move(compatible_target->second);
+  auto target = std::move(compatible_target->second.target);
   cached_render_targets_.erase(compatible_target);
+  cached_bytes_ -= GetByteSize(target->GetRenderTargetSize());
   return target;
 }
 
@@ -26,12 +54,53 @@ std::set<std::unique_ptr<EmbedderRenderTarget>>
 EmbedderRenderTargetCache::ClearAllRenderTargetsInCache() {
   std::set<std::unique_ptr<EmbedderRenderTarget>> cleared_targets;
   for (auto& targets : cached_render_targets_) {
-    cleared_targets.insert(std::move(targets.second));
+    cleared_targets.insert(std::move(targets.second.target));
   }
   cached_render_targets_.clear();
+  cached_bytes_ = 0;
   return cleared_targets;
 }
 
+std::set<std::unique_ptr<EmbedderRenderTarget>>
+EmbedderRenderTargetCache::CollectUnusedRenderTargets() {
+  frame_++;
+  std::set<std::unique_ptr<EmbedderRenderTarget>> collected_targets;
+  auto collect = [&](CachedRenderTargets::iterator target) {
+    cached_bytes_ -= GetByteSize(target->second.target->GetRenderTargetSize());
+    collected_targets.insert(std::move(target->second.target));
+    return cached_render_targets_.erase(target);
+  };
+
+  for (auto i = cached_render_targets_.begin();
+       i != cached_render_targets_.end();) {
+    if (frame_ - i->second.last_used_frame >= config_.max_unused_frames) {
+      i = collect(i);
+    } else {
+      ++i;
+    }
+  }
+
+  if (config_.max_bytes > 0u && cached_bytes_ > config_.max_bytes) {
+    // Collect the least recently used render targets first.
+    std::vector<CachedRenderTargets::iterator> targets;
+    targets.reserve(cached_render_targets_.size());
+    for (auto i = cached_render_targets_.begin();
+         i != cached_render_targets_.end(); ++i) {
+      targets.push_back(i);
+    }
+    std::sort(targets.begin(), targets.end(), [](auto a, auto b) {
+      return a->second.last_used_frame < b->second.last_used_frame;
+    });
+    for (auto target : targets) {
+      if (cached_bytes_ <= config_.max_bytes) {
+        break;
+      }
+      collect(target);
+    }
+  }
+  return collected_targets;
+}
+
 void EmbedderRenderTargetCache::CacheRenderTarget(
     std::unique_ptr<EmbedderRenderTarget> target) {
   if (target == nullptr) {
@@ -39,11 +108,18 @@ void EmbedderRenderTargetCache::CacheRenderTarget(
   }
   auto desc = EmbedderExternalView::RenderTargetDescriptor{
       target->GetRenderTargetSize()};
-  cached_render_targets_.insert(std::make_pair(desc, std::move(target)));
+  cached_bytes_ += GetByteSize(desc.surface_size);
+  cached_render_targets_.insert(std::make_pair(
+      desc, CachedRenderTarget{.target = std::move(target),
+                               .last_used_frame = frame_}));
 }
 
 size_t EmbedderRenderTargetCache::GetCachedTargetsCount() const {
   return cached_render_targets_.size();
 }
 
+size_t EmbedderRenderTargetCache::GetCachedBytes() const {
+  return cached_bytes_;
+}
+
 }  // namespace flutter
@@ -19,30 +19,85 @@ namespace flutter {
 /// @brief      A cache used to reference render targets that are owned by the
 ///             embedder but needed by th engine to render a frame.
 ///
+///             Render targets that go unused are kept for a number of frames
+///             and within a byte budget, and render targets may be requested
+///             in sizes rounded up to an alignment, so that layers whose
+///             sizes change from frame to frame, for example while a window
+///             is resized, reuse the same render targets.
+///
 class EmbedderRenderTargetCache {
  public:
+  struct Config {
+    /// The number of consecutive frames a cached render target may go unused
+    /// before it is collected. Values below one are treated as one, which
+    /// collects the render targets unused during a frame.
+    size_t max_unused_frames;
+    /// The maximum number of bytes of the unused render targets, estimated at
+    /// four bytes per pixel, beyond which the least recently used ones are
+    /// collected. Zero for no limit.
+    size_t max_bytes;
+    /// The alignment in pixels the width and height of render targets are
+    /// rounded up to. Values below one are treated as one.
+    int32_t size_alignment;
+  };
+
   EmbedderRenderTargetCache();
 
+  explicit EmbedderRenderTargetCache(const Config& config);
+
   ~EmbedderRenderTargetCache();
 
+  //----------------------------------------------------------------------------
+  /// @brief      The size of the render targets used for layers of the given
+  ///             size, which is rounded up to the size alignment.
+  ///
+  SkISize GetRenderTargetSize(const SkISize& layer_size) const;
+
   std::unique_ptr<EmbedderRenderTarget> GetRenderTarget(
       const EmbedderExternalView::RenderTargetDescriptor& descriptor);
 
   std::set<std::unique_ptr<EmbedderRenderTarget>>
   ClearAllRenderTargetsInCache();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Ends the use of the cached render targets by a frame, and
+  ///             removes the render targets that are no longer kept for later
+  ///             frames, which are returned for collection.
+  ///
+  ///             This must be called once per frame, after the render targets
+  ///             of the frame were taken from the cache and before they are
+  ///             cached again.
+  ///
+  std::set<std::unique_ptr<EmbedderRenderTarget>> CollectUnusedRenderTargets();
+
   void CacheRenderTarget(std::unique_ptr<EmbedderRenderTarget> target);
 
   size_t GetCachedTargetsCount() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The estimated number of bytes of the cached render targets.
+  ///
+  size_t GetCachedBytes() const;
+
  private:
+  struct CachedRenderTarget {
+    std::unique_ptr<EmbedderRenderTarget> target;
+    // The frame during which the render target was last used.
+    size_t last_used_frame;
+  };
+
   using CachedRenderTargets = std::unordered_multimap<
       EmbedderExternalView::RenderTargetDescriptor,
-      std::unique_ptr<EmbedderRenderTarget>,
+      CachedRenderTarget,
       EmbedderExternalView::RenderTargetDescriptor::Hash,
       EmbedderExternalView::RenderTargetDescriptor::Equal>;
 
+  const Config config_;
   CachedRenderTargets cached_render_targets_;
+  size_t cached_bytes_ = 0;
+  size_t frame_ = 0;
+
+  static size_t GetByteSize(const SkISize& size);
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRenderTargetCache);
 };
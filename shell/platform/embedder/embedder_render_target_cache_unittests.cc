@@ -0,0 +1,119 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+namespace {
+
+class TestRenderTarget : public EmbedderRenderTarget {
+ public:
+  explicit TestRenderTarget(SkISize size)
+      : EmbedderRenderTarget(FlutterBackingStore{}, nullptr), size_(size) {}
+
+  // |EmbedderRenderTarget|
+  sk_sp<SkSurface> GetSkiaSurface() const override { return nullptr; }
+
+  // |EmbedderRenderTarget|
+  impeller::RenderTarget* GetImpellerRenderTarget() const override {
+    return nullptr;
+  }
+
+  // |EmbedderRenderTarget|
+  std::shared_ptr<impeller::AiksContext> GetAiksContext() const override {
+    return nullptr;
+  }
+
+  // |EmbedderRenderTarget|
+  SkISize GetRenderTargetSize() const override { return size_; }
+
+ private:
+  const SkISize size_;
+};
+
+EmbedderExternalView::RenderTargetDescriptor Descriptor(int32_t width,
+                                                        int32_t height) {
+  return EmbedderExternalView::RenderTargetDescriptor(
+      SkISize::Make(width, height));
+}
+
+}  // namespace
+
+TEST(EmbedderRenderTargetCacheTest, CollectsTargetsUnusedDuringAFrame) {
+  EmbedderRenderTargetCache cache;
+  cache.CollectUnusedRenderTargets();
+  cache.CacheRenderTarget(
+      std::make_unique<TestRenderTarget>(SkISize::Make(100, 100)));
+  cache.CacheRenderTarget(
+      std::make_unique<TestRenderTarget>(SkISize::Make(200, 100)));
+  EXPECT_EQ(cache.GetCachedTargetsCount(), 2u);
+  EXPECT_EQ(cache.GetCachedBytes(), 120000u);
+
+  // The next frame only uses one of the targets.
+  auto target = cache.GetRenderTarget(Descriptor(100, 100));
+  ASSERT_NE(target, nullptr);
+  EXPECT_EQ(cache.CollectUnusedRenderTargets().size(), 1u);
+  EXPECT_EQ(cache.GetCachedTargetsCount(), 0u);
+  EXPECT_EQ(cache.GetCachedBytes(), 0u);
+  cache.CacheRenderTarget(std::move(target));
+  EXPECT_EQ(cache.GetCachedTargetsCount(), 1u);
+}
+
+TEST(EmbedderRenderTargetCacheTest, KeepsUnusedTargetsForConfiguredFrames) {
+  EmbedderRenderTargetCache cache({
+      .max_unused_frames = 3u,
+      .max_bytes = 0u,
+      .size_alignment = 1,
+  });
+  cache.CollectUnusedRenderTargets();
+  cache.CacheRenderTarget(
+      std::make_unique<TestRenderTarget>(SkISize::Make(100, 100)));
+
+  EXPECT_TRUE(cache.CollectUnusedRenderTargets().empty());
+  EXPECT_TRUE(cache.CollectUnusedRenderTargets().empty());
+  EXPECT_EQ(cache.GetCachedTargetsCount(), 1u);
+  EXPECT_EQ(cache.CollectUnusedRenderTargets().size(), 1u);
+  EXPECT_EQ(cache.GetCachedTargetsCount(), 0u);
+}
+
+TEST(EmbedderRenderTargetCacheTest, CollectsOldestTargetsOverBudget) {
+  EmbedderRenderTargetCache cache({
+      .max_unused_frames = 10u,
+      .max_bytes = 100000u,
+      .size_alignment = 1,
+  });
+  cache.CollectUnusedRenderTargets();
+  cache.CacheRenderTarget(
+      std::make_unique<TestRenderTarget>(SkISize::Make(100, 100)));
+  cache.CollectUnusedRenderTargets();
+  cache.CacheRenderTarget(
+      std::make_unique<TestRenderTarget>(SkISize::Make(130, 130)));
+
+  // Both targets are within the budget, but not together.
+  EXPECT_EQ(cache.CollectUnusedRenderTargets().size(), 1u);
+  EXPECT_EQ(cache.GetCachedTargetsCount(), 1u);
+  EXPECT_EQ(cache.GetRenderTarget(Descriptor(100, 100)), nullptr);
+  EXPECT_NE(cache.GetRenderTarget(Descriptor(130, 130)), nullptr);
+}
+
+TEST(EmbedderRenderTargetCacheTest, AlignsRenderTargetSizes) {
+  EmbedderRenderTargetCache cache({
+      .max_unused_frames = 1u,
+      .max_bytes = 0u,
+      .size_alignment = 64,
+  });
+  EXPECT_EQ(cache.GetRenderTargetSize(SkISize::Make(100, 64)),
+            SkISize::Make(128, 64));
+  EXPECT_EQ(cache.GetRenderTargetSize(SkISize::Make(101, 65)),
+            SkISize::Make(128, 128));
+  EXPECT_EQ(EmbedderRenderTargetCache().GetRenderTargetSize(
+                SkISize::Make(101, 65)),
+            SkISize::Make(101, 65));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -221,20 +221,25 @@ EmbedderSemanticsUpdate2::CreateStringAttributes(
         std::shared_ptr<flutter::LocaleStringAttribute> locale_attribute =
             std::static_pointer_cast<flutter::LocaleStringAttribute>(attribute);
 
-        auto embedder_locale = std::make_unique<FlutterLocaleStringAttribute>();
-        embedder_locale->struct_size = sizeof(FlutterLocaleStringAttribute);
-        embedder_locale->locale = locale_attribute->locale.c_str();
-        locale_attributes_.push_back(std::move(embedder_locale));
+        // Attributes with the same locale share an embedder locale, which
+        // points to the interned locale string.
+        auto [iter, inserted] =
+            locale_attributes_.try_emplace(locale_attribute->locale);
+        if (inserted) {
+          iter->second = std::make_unique<FlutterLocaleStringAttribute>();
+          iter->second->struct_size = sizeof(FlutterLocaleStringAttribute);
+          iter->second->locale = iter->first.c_str();
+        }
 
         embedder_attribute->type = FlutterStringAttributeType::kLocale;
-        embedder_attribute->locale = locale_attributes_.back().get();
+        embedder_attribute->locale = iter->second.get();
         break;
       }
       case flutter::StringAttributeType::kSpellOut: {
         // All spell out attributes are identical and share a lazily created
         // instance.
         if (!spell_out_attribute_) {
-          auto spell_out_attribute_ =
+          spell_out_attribute_ =
               std::make_unique<FlutterSpellOutStringAttribute>();
           spell_out_attribute_->struct_size =
               sizeof(FlutterSpellOutStringAttribute);
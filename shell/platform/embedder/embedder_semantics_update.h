@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SEMANTICS_UPDATE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SEMANTICS_UPDATE_H_
 
+#include <unordered_map>
+
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
 #include "flutter/lib/ui/semantics/semantics_node.h"
 #include "flutter/shell/platform/embedder/embedder.h"
@@ -70,7 +72,10 @@ class EmbedderSemanticsUpdate2 {
   std::vector<std::unique_ptr<std::vector<const FlutterStringAttribute*>>>
       node_string_attributes_;
   std::vector<std::unique_ptr<FlutterStringAttribute>> string_attributes_;
-  std::vector<std::unique_ptr<FlutterLocaleStringAttribute>> locale_attributes_;
+  // Locale attributes are interned by locale, most attributes of an update
+  // share a handful of locales.
+  std::unordered_map<std::string, std::unique_ptr<FlutterLocaleStringAttribute>>
+      locale_attributes_;
   std::unique_ptr<FlutterSpellOutStringAttribute> spell_out_attribute_;
 
   // Translates engine semantic nodes to embedder semantic nodes.
@@ -145,8 +145,13 @@ EmbedderThreadHost::CreateEmbedderManagedThreadHost(
       SAFE_ACCESS(custom_task_runners, platform_task_runner, nullptr));
   auto render_task_runner_pair = CreateEmbedderTaskRunner(
       SAFE_ACCESS(custom_task_runners, render_task_runner, nullptr));
+  auto background_platform_message_task_runner_pair =
+      CreateEmbedderTaskRunner(SAFE_ACCESS(
+          custom_task_runners, background_platform_message_task_runner,
+          nullptr));
 
-  if (!platform_task_runner_pair.first || !render_task_runner_pair.first) {
+  if (!platform_task_runner_pair.first || !render_task_runner_pair.first ||
+      !background_platform_message_task_runner_pair.first) {
     // User error while supplying a custom task runner. Return an invalid thread
     // host. This will abort engine initialization. Don't fallback to defaults
     // if the user wanted to specify a task runner but just messed up instead.
@@ -209,9 +214,15 @@ EmbedderThreadHost::CreateEmbedderManagedThreadHost(
     embedder_task_runners.insert(render_task_runner_pair.second);
   }
 
+  if (background_platform_message_task_runner_pair.second) {
+    embedder_task_runners.insert(
+        background_platform_message_task_runner_pair.second);
+  }
+
   auto embedder_host = std::make_unique<EmbedderThreadHost>(
       std::move(thread_host), std::move(task_runners),
-      std::move(embedder_task_runners));
+      std::move(embedder_task_runners),
+      background_platform_message_task_runner_pair.second);
 
   if (embedder_host->IsValid()) {
     return embedder_host;
@@ -270,8 +281,12 @@ EmbedderThreadHost::CreateEngineManagedThreadHost(
 EmbedderThreadHost::EmbedderThreadHost(
     ThreadHost host,
     const flutter::TaskRunners& runners,
-    const std::set<fml::RefPtr<EmbedderTaskRunner>>& embedder_task_runners)
-    : host_(std::move(host)), runners_(runners) {
+    const std::set<fml::RefPtr<EmbedderTaskRunner>>& embedder_task_runners,
+    fml::RefPtr<fml::TaskRunner> background_platform_message_task_runner)
+    : host_(std::move(host)),
+      runners_(runners),
+      background_platform_message_task_runner_(
+          std::move(background_platform_message_task_runner)) {
   for (const auto& runner : embedder_task_runners) {
     runners_map_[reinterpret_cast<int64_t>(runner.get())] = runner;
   }
@@ -295,4 +310,9 @@ bool EmbedderThreadHost::PostTask(int64_t runner, uint64_t task) const {
   return found->second->PostTask(task);
 }
 
+fml::RefPtr<fml::TaskRunner>
+EmbedderThreadHost::GetBackgroundPlatformMessageTaskRunner() const {
+  return background_platform_message_task_runner_;
+}
+
 }  // namespace flutter
@@ -28,7 +28,9 @@ class EmbedderThreadHost {
   EmbedderThreadHost(
       ThreadHost host,
       const flutter::TaskRunners& runners,
-      const std::set<fml::RefPtr<EmbedderTaskRunner>>& embedder_task_runners);
+      const std::set<fml::RefPtr<EmbedderTaskRunner>>& embedder_task_runners,
+      fml::RefPtr<fml::TaskRunner> background_platform_message_task_runner =
+          nullptr);
 
   ~EmbedderThreadHost();
 
@@ -38,9 +40,14 @@ class EmbedderThreadHost {
 
   bool PostTask(int64_t runner, uint64_t task) const;
 
+  // The task runner specified by the embedder for the platform messages of
+  // background isolates, or null if none was.
+  fml::RefPtr<fml::TaskRunner> GetBackgroundPlatformMessageTaskRunner() const;
+
  private:
   ThreadHost host_;
   flutter::TaskRunners runners_;
+  fml::RefPtr<fml::TaskRunner> background_platform_message_task_runner_;
   std::map<int64_t, fml::RefPtr<EmbedderTaskRunner>> runners_map_;
 
   static std::unique_ptr<EmbedderThreadHost> CreateEmbedderManagedThreadHost(
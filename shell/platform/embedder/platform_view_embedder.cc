@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/shell/platform/embedder/vsync_waiter_headless.h"
 
 namespace flutter {
 
@@ -15,11 +16,19 @@ class PlatformViewEmbedder::EmbedderPlatformMessageHandler
  public:
   EmbedderPlatformMessageHandler(
       fml::WeakPtr<PlatformView> parent,
-      fml::RefPtr<fml::TaskRunner> platform_task_runner)
+      fml::RefPtr<fml::TaskRunner> platform_task_runner,
+      std::shared_ptr<EmbedderBackgroundPlatformMessageRouter>
+          background_platform_message_router)
       : parent_(std::move(parent)),
-        platform_task_runner_(std::move(platform_task_runner)) {}
+        platform_task_runner_(std::move(platform_task_runner)),
+        background_platform_message_router_(
+            std::move(background_platform_message_router)) {}
 
   virtual void HandlePlatformMessage(std::unique_ptr<PlatformMessage> message) {
+    if (background_platform_message_router_ &&
+        background_platform_message_router_->Route(message)) {
+      return;
+    }
     platform_task_runner_->PostTask(fml::MakeCopyable(
         [parent = parent_, message = std::move(message)]() mutable {
           if (parent) {
@@ -43,6 +52,8 @@ class PlatformViewEmbedder::EmbedderPlatformMessageHandler
  private:
   fml::WeakPtr<PlatformView> parent_;
   fml::RefPtr<fml::TaskRunner> platform_task_runner_;
+  std::shared_ptr<EmbedderBackgroundPlatformMessageRouter>
+      background_platform_message_router_;
 };
 
 PlatformViewEmbedder::PlatformViewEmbedder(
@@ -59,7 +70,8 @@ PlatformViewEmbedder::PlatformViewEmbedder(
                                                     external_view_embedder_)),
       platform_message_handler_(new EmbedderPlatformMessageHandler(
           GetWeakPtr(),
-          task_runners.GetPlatformTaskRunner())),
+          task_runners.GetPlatformTaskRunner(),
+          platform_dispatch_table.background_platform_message_router)),
       platform_dispatch_table_(std::move(platform_dispatch_table)) {}
 
 #ifdef SHELL_ENABLE_GL
@@ -74,7 +86,8 @@ PlatformViewEmbedder::PlatformViewEmbedder(
       embedder_surface_(std::move(embedder_surface)),
       platform_message_handler_(new EmbedderPlatformMessageHandler(
           GetWeakPtr(),
-          task_runners.GetPlatformTaskRunner())),
+          task_runners.GetPlatformTaskRunner(),
+          platform_dispatch_table.background_platform_message_router)),
       platform_dispatch_table_(std::move(platform_dispatch_table)) {}
 #endif
 
@@ -90,7 +103,8 @@ PlatformViewEmbedder::PlatformViewEmbedder(
       embedder_surface_(std::move(embedder_surface)),
       platform_message_handler_(new EmbedderPlatformMessageHandler(
           GetWeakPtr(),
-          task_runners.GetPlatformTaskRunner())),
+          task_runners.GetPlatformTaskRunner(),
+          platform_dispatch_table.background_platform_message_router)),
       platform_dispatch_table_(std::move(platform_dispatch_table)) {}
 #endif
 
@@ -106,7 +120,8 @@ PlatformViewEmbedder::PlatformViewEmbedder(
       embedder_surface_(std::move(embedder_surface)),
       platform_message_handler_(new EmbedderPlatformMessageHandler(
           GetWeakPtr(),
-          task_runners.GetPlatformTaskRunner())),
+          task_runners.GetPlatformTaskRunner(),
+          platform_dispatch_table.background_platform_message_router)),
       platform_dispatch_table_(std::move(platform_dispatch_table)) {}
 #endif
 
@@ -170,6 +185,9 @@ sk_sp<GrDirectContext> PlatformViewEmbedder::CreateResourceContext() const {
 // |PlatformView|
 std::unique_ptr<VsyncWaiter> PlatformViewEmbedder::CreateVSyncWaiter() {
   if (!platform_dispatch_table_.vsync_callback) {
+    if (platform_dispatch_table_.render_without_vsync) {
+      return std::make_unique<VsyncWaiterHeadless>(task_runners_);
+    }
     // Superclass implementation creates a timer based fallback.
     return PlatformView::CreateVSyncWaiter();
   }
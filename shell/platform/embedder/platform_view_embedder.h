@@ -11,6 +11,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/platform/embedder/embedder.h"
+#include "flutter/shell/platform/embedder/embedder_background_platform_message_router.h"
 #include "flutter/shell/platform/embedder/embedder_surface.h"
 #include "flutter/shell/platform/embedder/embedder_surface_software.h"
 #include "flutter/shell/platform/embedder/vsync_waiter_embedder.h"
@@ -52,6 +53,11 @@ class PlatformViewEmbedder final : public PlatformView {
         compute_platform_resolved_locale_callback;
     OnPreEngineRestartCallback on_pre_engine_restart_callback;  // optional
     ChanneUpdateCallback on_channel_update;                     // optional
+    std::shared_ptr<EmbedderBackgroundPlatformMessageRouter>
+        background_platform_message_router;  // optional
+    // Begin frames as soon as they are requested when there is no
+    // |vsync_callback|.
+    bool render_without_vsync = false;  // optional
   };
 
   // Create a platform view that sets up a software rasterizer.
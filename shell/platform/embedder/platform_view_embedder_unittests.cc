@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/embedder/platform_view_embedder.h"
 
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/testing.h"
 
@@ -202,5 +203,69 @@ TEST(PlatformViewEmbedderTest, DeletionDisabledDispatch) {
   EXPECT_FALSE(did_call);
 }
 
+TEST(PlatformViewEmbedderTest, RoutesBackgroundPlatformMessages) {
+  ThreadHost thread_host("io.flutter.test." + GetCurrentTestName() + ".",
+                         ThreadHost::Type::kPlatform | ThreadHost::Type::kUi);
+  flutter::TaskRunners task_runners = flutter::TaskRunners(
+      "RoutesBackgroundPlatformMessages",
+      thread_host.platform_thread->GetTaskRunner(), nullptr, nullptr, nullptr);
+  fml::RefPtr<fml::TaskRunner> background_task_runner =
+      thread_host.ui_thread->GetTaskRunner();
+  auto router = std::make_shared<EmbedderBackgroundPlatformMessageRouter>();
+  fml::CountDownLatch handled(2);
+  std::string background_channel;
+  std::string platform_channel;
+  router->SetCallback(
+      "foo", background_task_runner,
+      [&](std::unique_ptr<PlatformMessage> message) {
+        EXPECT_TRUE(background_task_runner->RunsTasksOnCurrentThread());
+        background_channel = message->channel();
+        handled.CountDown();
+      });
+  std::unique_ptr<PlatformViewEmbedder> embedder;
+  {
+    fml::AutoResetWaitableEvent latch;
+    task_runners.GetPlatformTaskRunner()->PostTask([&] {
+      MockDelegate delegate;
+      EmbedderSurfaceSoftware::SoftwareDispatchTable software_dispatch_table;
+      PlatformViewEmbedder::PlatformDispatchTable platform_dispatch_table;
+      platform_dispatch_table.platform_message_response_callback =
+          [&](std::unique_ptr<PlatformMessage> message) {
+            EXPECT_TRUE(task_runners.GetPlatformTaskRunner()
+                            ->RunsTasksOnCurrentThread());
+            platform_channel = message->channel();
+            handled.CountDown();
+          };
+      platform_dispatch_table.background_platform_message_router = router;
+      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder;
+      embedder = std::make_unique<PlatformViewEmbedder>(
+          delegate, task_runners, software_dispatch_table,
+          platform_dispatch_table, external_view_embedder);
+      latch.Signal();
+    });
+    latch.Wait();
+  }
+
+  // Messages are handed to the handler from the thread of their isolate.
+  auto platform_message_handler = embedder->GetPlatformMessageHandler();
+  platform_message_handler->HandlePlatformMessage(
+      std::make_unique<PlatformMessage>("foo", nullptr));
+  platform_message_handler->HandlePlatformMessage(
+      std::make_unique<PlatformMessage>("bar", nullptr));
+  handled.Wait();
+
+  EXPECT_EQ(background_channel, "foo");
+  EXPECT_EQ(platform_channel, "bar");
+
+  {
+    fml::AutoResetWaitableEvent latch;
+    thread_host.platform_thread->GetTaskRunner()->PostTask([&latch, &embedder] {
+      embedder.reset();
+      latch.Signal();
+    });
+    latch.Wait();
+  }
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -313,6 +313,7 @@ TEST_F(EmbedderA11yTest, A11yStringAttributes) {
           ASSERT_EQ(node->label_attributes[1]->end, size_t(1));
           ASSERT_EQ(node->label_attributes[1]->type,
                     FlutterStringAttributeType::kSpellOut);
+          ASSERT_NE(node->label_attributes[1]->spell_out, nullptr);
         }
 
         // Verify hint
@@ -326,6 +327,9 @@ TEST_F(EmbedderA11yTest, A11yStringAttributes) {
                     FlutterStringAttributeType::kLocale);
           ASSERT_EQ(std::string(node->hint_attributes[0]->locale->locale),
                     "en");
+          // Attributes with the same locale share their embedder locale.
+          ASSERT_EQ(node->hint_attributes[0]->locale,
+                    node->label_attributes[0]->locale);
 
           ASSERT_EQ(node->hint_attributes[1]->start, size_t(2));
           ASSERT_EQ(node->hint_attributes[1]->end, size_t(3));
@@ -0,0 +1,37 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/vsync_waiter_headless.h"
+
+namespace flutter {
+
+namespace {
+
+// Animations still advance as if frames were shown at 60 fps.
+constexpr fml::TimeDelta kFrameInterval =
+    fml::TimeDelta::FromSecondsF(1.0 / 60.0);
+
+}  // namespace
+
+VsyncWaiterHeadless::VsyncWaiterHeadless(
+    const flutter::TaskRunners& task_runners)
+    : VsyncWaiter(task_runners) {}
+
+VsyncWaiterHeadless::~VsyncWaiterHeadless() = default;
+
+void VsyncWaiterHeadless::AwaitVSync() {
+  std::weak_ptr<VsyncWaiterHeadless> weak_this =
+      std::static_pointer_cast<VsyncWaiterHeadless>(shared_from_this());
+  // Posted rather than fired right away, as the caller doesn't expect the
+  // callback to run before it returns.
+  task_runners_.GetUITaskRunner()->PostTask([weak_this]() {
+    if (auto vsync_waiter = weak_this.lock()) {
+      const fml::TimePoint now = fml::TimePoint::Now();
+      vsync_waiter->FireCallback(now, now + kFrameInterval,
+                                 /*pause_secondary_tasks=*/false);
+    }
+  });
+}
+
+}  // namespace flutter
@@ -0,0 +1,32 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_VSYNC_WAITER_HEADLESS_H_
+#define FLUTTER_SHELL_PLATFORM_EMBEDDER_VSYNC_WAITER_HEADLESS_H_
+
+#include "flutter/fml/macros.h"
+#include "flutter/shell/common/vsync_waiter.h"
+
+namespace flutter {
+
+/// A |VsyncWaiter| for engines that render without a display, which begins
+/// each frame as soon as it is requested instead of at the next 60 fps tick
+/// like the fallback waiter does. Frames are then only limited by how fast
+/// they can be built and rasterized.
+class VsyncWaiterHeadless final : public VsyncWaiter {
+ public:
+  explicit VsyncWaiterHeadless(const flutter::TaskRunners& task_runners);
+
+  ~VsyncWaiterHeadless() override;
+
+ private:
+  // |VsyncWaiter|
+  void AwaitVSync() override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(VsyncWaiterHeadless);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_VSYNC_WAITER_HEADLESS_H_
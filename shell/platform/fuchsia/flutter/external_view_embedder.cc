@@ -3,6 +3,8 @@
 // found in the LICENSE file.
 
 #include "external_view_embedder.h"
+#include <lib/fidl/cpp/comparison.h>
+
 #include <algorithm>
 #include <cstdint>
 
@@ -212,6 +214,10 @@ void ExternalViewEmbedder::SubmitFlutterView(
     const float inv_dpr = 1.0f / frame_dpr_;
     flatland_->flatland()->SetScale(root_transform_id_, {inv_dpr, inv_dpr});
 
+    // Children of the root transform for this frame, in composition order.
+    // They are only sent to Flatland if they differ from the last frame.
+    std::vector<fuchsia::ui::composition::TransformId> child_transforms;
+
     size_t layer_index = 0;
     for (const auto& layer_id : frame_composition_order_) {
       const auto& layer = frame_layers_.find(layer_id);
@@ -361,9 +367,7 @@ void ExternalViewEmbedder::SubmitFlutterView(
             viewport.mutators.clips.empty()
                 ? viewport.transform_id
                 : viewport.clip_transforms[0].transform_id;
-        flatland_->flatland()->AddChild(root_transform_id_,
-                                        main_child_transform);
-        child_transforms_.emplace_back(main_child_transform);
+        child_transforms.emplace_back(main_child_transform);
       }
 
       // Acquire the surface associated with the layer.
@@ -395,8 +399,12 @@ void ExternalViewEmbedder::SubmitFlutterView(
         }
 
         // Update the image content and set size.
-        flatland_->flatland()->SetContent(layers_[layer_index].transform_id,
-                                          {surface_for_layer->GetImageId()});
+        Layer& flatland_layer = layers_[layer_index];
+        if (flatland_layer.image_id != surface_for_layer->GetImageId()) {
+          flatland_layer.image_id = surface_for_layer->GetImageId();
+          flatland_->flatland()->SetContent(flatland_layer.transform_id,
+                                            {flatland_layer.image_id});
+        }
         flatland_->flatland()->SetImageDestinationSize(
             {surface_for_layer->GetImageId()},
             {static_cast<uint32_t>(surface_for_layer->GetSize().width()),
@@ -429,14 +437,18 @@ void ExternalViewEmbedder::SubmitFlutterView(
                 fuchsia::ui::composition::HitTestInteraction::DEFAULT;
           }
 
-          flatland_->flatland()->SetHitRegions(
-              layers_[layer_index].transform_id, std::move(hit_regions));
+          if (!flatland_layer.hit_regions.has_value() ||
+              !fidl::Equals(hit_regions, *flatland_layer.hit_regions)) {
+            flatland_layer.hit_regions = hit_regions;
+            flatland_->flatland()->SetHitRegions(flatland_layer.transform_id,
+                                                 std::move(hit_regions));
+          }
         }
 
         // Attach the Layer to the main scene graph.
-        flatland_->flatland()->AddChild(root_transform_id_,
-                                        layers_[layer_index].transform_id);
-        child_transforms_.emplace_back(layers_[layer_index].transform_id);
+        child_transforms.emplace_back(flatland_layer.transform_id);
+      } else if (layer_index < layers_.size()) {
+        ClearLayerContent(&layers_[layer_index]);
       }
 
       // Reset for the next pass:
@@ -447,10 +459,15 @@ void ExternalViewEmbedder::SubmitFlutterView(
     // will capture all input, and any unwanted input will be reinjected into
     // embedded views.
     if (input_interceptor_transform_.has_value()) {
-      flatland_->flatland()->AddChild(root_transform_id_,
-                                      *input_interceptor_transform_);
-      child_transforms_.emplace_back(*input_interceptor_transform_);
+      child_transforms.emplace_back(*input_interceptor_transform_);
     }
+
+    // Clear images on unused layers so they aren't cached unnecessarily.
+    for (size_t i = layer_index; i < layers_.size(); i++) {
+      ClearLayerContent(&layers_[i]);
+    }
+
+    SetRootChildren(std::move(child_transforms));
   }
 
   // Present the session to Scenic, along with surface acquire/release fences.
@@ -588,17 +605,34 @@ void ExternalViewEmbedder::Reset() {
   frame_composition_order_.clear();
   frame_size_ = SkISize::Make(0, 0);
   frame_dpr_ = 1.f;
+}
+
+void ExternalViewEmbedder::ClearLayerContent(Layer* layer) {
+  if (layer->image_id != 0) {
+    layer->image_id = 0;
+    flatland_->flatland()->SetContent(layer->transform_id, {0});
+  }
+}
+
+void ExternalViewEmbedder::SetRootChildren(
+    std::vector<fuchsia::ui::composition::TransformId> child_transforms) {
+  // Most frames composite the same layers and views as the previous one, in
+  // which case the scene graph is left as it is.
+  if (std::equal(child_transforms.begin(), child_transforms.end(),
+                 child_transforms_.begin(), child_transforms_.end(),
+                 [](const auto& a, const auto& b) {
+                   return a.value == b.value;
+                 })) {
+    return;
+  }
 
-  // Clear all children from root.
   for (const auto& transform : child_transforms_) {
     flatland_->flatland()->RemoveChild(root_transform_id_, transform);
   }
-  child_transforms_.clear();
-
-  // Clear images on all layers so they aren't cached unnecessarily.
-  for (const auto& layer : layers_) {
-    flatland_->flatland()->SetContent(layer.transform_id, {0});
+  for (const auto& transform : child_transforms) {
+    flatland_->flatland()->AddChild(root_transform_id_, transform);
   }
+  child_transforms_ = std::move(child_transforms);
 }
 
 ExternalViewEmbedder::ViewMutators ExternalViewEmbedder::ParseMutatorStack(
@@ -191,8 +191,21 @@ class ExternalViewEmbedder final : public flutter::ExternalViewEmbedder {
   struct Layer {
     // Transform on which Images are set.
     fuchsia::ui::composition::TransformId transform_id;
+
+    // The content and hit regions last set on |transform_id|, so that
+    // unchanged ones aren't sent to Flatland again on every frame.
+    uint32_t image_id = 0;
+    std::optional<std::vector<fuchsia::ui::composition::HitRegion>>
+        hit_regions;
   };
 
+  // Removes the image from the layer, if it has one.
+  void ClearLayerContent(Layer* layer);
+
+  // Replaces the children of the root transform, unless they are unchanged.
+  void SetRootChildren(
+      std::vector<fuchsia::ui::composition::TransformId> child_transforms);
+
   std::shared_ptr<FlatlandConnection> flatland_;
   std::shared_ptr<SurfaceProducer> surface_producer_;
 
@@ -205,6 +218,7 @@ class ExternalViewEmbedder final : public flutter::ExternalViewEmbedder {
 
   std::unordered_map<EmbedderLayerId, EmbedderLayer> frame_layers_;
   std::vector<EmbedderLayerId> frame_composition_order_;
+  // The children currently attached to |root_transform_id_|, in order.
   std::vector<fuchsia::ui::composition::TransformId> child_transforms_;
   SkISize frame_size_ = SkISize::Make(0, 0);
   float frame_dpr_ = 1.f;
@@ -0,0 +1,271 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_dmabuf_texture.h"
+
+#include <epoxy/egl.h>
+#include <epoxy/gl.h>
+#include <errno.h>
+#include <gio/gio.h>
+#include <gmodule.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include "flutter/shell/platform/linux/fl_dmabuf_texture_private.h"
+
+// DRM_FORMAT_MOD_INVALID from drm_fourcc.h.
+static constexpr uint64_t kDrmFormatModInvalid = 0x00ffffffffffffffull;
+
+typedef struct {
+  int64_t id;
+} FlDmabufTexturePrivate;
+
+// A frame that Flutter is showing, released when the engine destroys the
+// OpenGL texture bound to it.
+typedef struct {
+  FlDmabufTexture* texture;
+  FlDmabufTextureFrame frame;
+  EGLDisplay display;
+  EGLImageKHR image;
+  GLuint texture_id;
+} FlDmabufTextureImport;
+
+static void fl_dmabuf_texture_iface_init(FlTextureInterface* iface);
+
+G_DEFINE_TYPE_WITH_CODE(FlDmabufTexture,
+                        fl_dmabuf_texture,
+                        G_TYPE_OBJECT,
+                        G_IMPLEMENT_INTERFACE(fl_texture_get_type(),
+                                              fl_dmabuf_texture_iface_init);
+                        G_ADD_PRIVATE(FlDmabufTexture))
+
+// Implements FlTexture::set_id
+static void fl_dmabuf_texture_set_id(FlTexture* texture, int64_t id) {
+  FlDmabufTexture* self = FL_DMABUF_TEXTURE(texture);
+  FlDmabufTexturePrivate* priv = reinterpret_cast<FlDmabufTexturePrivate*>(
+      fl_dmabuf_texture_get_instance_private(self));
+  priv->id = id;
+}
+
+// Implements FlTexture::get_id
+static int64_t fl_dmabuf_texture_get_id(FlTexture* texture) {
+  FlDmabufTexture* self = FL_DMABUF_TEXTURE(texture);
+  FlDmabufTexturePrivate* priv = reinterpret_cast<FlDmabufTexturePrivate*>(
+      fl_dmabuf_texture_get_instance_private(self));
+  return priv->id;
+}
+
+static void fl_dmabuf_texture_iface_init(FlTextureInterface* iface) {
+  iface->set_id = fl_dmabuf_texture_set_id;
+  iface->get_id = fl_dmabuf_texture_get_id;
+}
+
+static void fl_dmabuf_texture_class_init(FlDmabufTextureClass* klass) {}
+
+static void fl_dmabuf_texture_init(FlDmabufTexture* self) {}
+
+// Returns the frame to the texture, which takes the ownership of
+// `release_fence_fd`.
+static void release_frame(FlDmabufTexture* self,
+                          const FlDmabufTextureFrame* frame,
+                          int release_fence_fd) {
+  if (FL_DMABUF_TEXTURE_GET_CLASS(self)->release_frame != nullptr) {
+    FL_DMABUF_TEXTURE_GET_CLASS(self)->release_frame(self, frame,
+                                                     release_fence_fd);
+  } else if (release_fence_fd >= 0) {
+    close(release_fence_fd);
+  }
+}
+
+// Makes the GPU wait for the fence before it samples the buffer. Takes the
+// ownership of `fence_fd`.
+static void wait_for_fence(EGLDisplay display, int fence_fd) {
+  if (epoxy_has_egl_extension(display, "EGL_ANDROID_native_fence_sync")) {
+    const EGLint attributes[] = {EGL_SYNC_NATIVE_FENCE_FD_ANDROID, fence_fd,
+                                 EGL_NONE};
+    EGLSyncKHR sync =
+        eglCreateSyncKHR(display, EGL_SYNC_NATIVE_FENCE_ANDROID, attributes);
+    if (sync != EGL_NO_SYNC_KHR) {
+      // The sync owns the fence from now on.
+      eglWaitSyncKHR(display, sync, 0);
+      eglDestroySyncKHR(display, sync);
+      return;
+    }
+  }
+
+  // Without native fence support, wait on the CPU.
+  struct pollfd poll_fd = {fence_fd, POLLIN, 0};
+  while (poll(&poll_fd, 1, -1) < 0 && (errno == EINTR || errno == EAGAIN)) {
+  }
+  close(fence_fd);
+}
+
+// Returns a fence that signals once the GPU has executed the commands that
+// sample the buffer, or -1 once they have been executed.
+static int create_release_fence(EGLDisplay display) {
+  if (epoxy_has_egl_extension(display, "EGL_ANDROID_native_fence_sync")) {
+    EGLSyncKHR sync =
+        eglCreateSyncKHR(display, EGL_SYNC_NATIVE_FENCE_ANDROID, nullptr);
+    if (sync != EGL_NO_SYNC_KHR) {
+      // The fence is only created once the sync is flushed.
+      glFlush();
+      int fence_fd = eglDupNativeFenceFDANDROID(display, sync);
+      eglDestroySyncKHR(display, sync);
+      if (fence_fd != EGL_NO_NATIVE_FENCE_FD_ANDROID) {
+        return fence_fd;
+      }
+    }
+  }
+
+  glFinish();
+  return -1;
+}
+
+// Called by the engine once it no longer uses the OpenGL texture of a frame.
+static void destroy_import(void* user_data) {
+  FlDmabufTextureImport* import =
+      static_cast<FlDmabufTextureImport*>(user_data);
+
+  int release_fence_fd = create_release_fence(import->display);
+  glDeleteTextures(1, &import->texture_id);
+  eglDestroyImageKHR(import->display, import->image);
+  release_frame(import->texture, &import->frame, release_fence_fd);
+
+  g_object_unref(import->texture);
+  g_free(import);
+}
+
+// Imports the buffer of `frame` as an EGL image.
+static EGLImageKHR create_image(EGLDisplay display,
+                                const FlDmabufTextureFrame* frame,
+                                GError** error) {
+  if (!epoxy_has_egl_extension(display, "EGL_EXT_image_dma_buf_import")) {
+    g_set_error_literal(error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                        "EGL_EXT_image_dma_buf_import is not supported");
+    return EGL_NO_IMAGE_KHR;
+  }
+  const bool has_modifier = frame->modifier != kDrmFormatModInvalid;
+  if (has_modifier &&
+      !epoxy_has_egl_extension(display,
+                               "EGL_EXT_image_dma_buf_import_modifiers")) {
+    g_set_error_literal(
+        error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+        "EGL_EXT_image_dma_buf_import_modifiers is not supported");
+    return EGL_NO_IMAGE_KHR;
+  }
+  if (frame->n_planes == 0 || frame->n_planes > FL_DMABUF_TEXTURE_MAX_PLANES) {
+    g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+                "Invalid number of dmabuf planes %u", frame->n_planes);
+    return EGL_NO_IMAGE_KHR;
+  }
+
+  static const EGLint kPlaneAttributes[FL_DMABUF_TEXTURE_MAX_PLANES][5] = {
+      {EGL_DMA_BUF_PLANE0_FD_EXT, EGL_DMA_BUF_PLANE0_OFFSET_EXT,
+       EGL_DMA_BUF_PLANE0_PITCH_EXT, EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT,
+       EGL_DMA_BUF_PLANE0_MODIFIER_HI_EXT},
+      {EGL_DMA_BUF_PLANE1_FD_EXT, EGL_DMA_BUF_PLANE1_OFFSET_EXT,
+       EGL_DMA_BUF_PLANE1_PITCH_EXT, EGL_DMA_BUF_PLANE1_MODIFIER_LO_EXT,
+       EGL_DMA_BUF_PLANE1_MODIFIER_HI_EXT},
+      {EGL_DMA_BUF_PLANE2_FD_EXT, EGL_DMA_BUF_PLANE2_OFFSET_EXT,
+       EGL_DMA_BUF_PLANE2_PITCH_EXT, EGL_DMA_BUF_PLANE2_MODIFIER_LO_EXT,
+       EGL_DMA_BUF_PLANE2_MODIFIER_HI_EXT},
+      {EGL_DMA_BUF_PLANE3_FD_EXT, EGL_DMA_BUF_PLANE3_OFFSET_EXT,
+       EGL_DMA_BUF_PLANE3_PITCH_EXT, EGL_DMA_BUF_PLANE3_MODIFIER_LO_EXT,
+       EGL_DMA_BUF_PLANE3_MODIFIER_HI_EXT},
+  };
+
+  // 6 attributes for the format and size, 10 per plane, and EGL_NONE.
+  EGLint attributes[6 + 10 * FL_DMABUF_TEXTURE_MAX_PLANES + 1];
+  size_t n = 0;
+  attributes[n++] = EGL_WIDTH;
+  attributes[n++] = static_cast<EGLint>(frame->width);
+  attributes[n++] = EGL_HEIGHT;
+  attributes[n++] = static_cast<EGLint>(frame->height);
+  attributes[n++] = EGL_LINUX_DRM_FOURCC_EXT;
+  attributes[n++] = static_cast<EGLint>(frame->fourcc);
+  for (uint32_t i = 0; i < frame->n_planes; i++) {
+    attributes[n++] = kPlaneAttributes[i][0];
+    attributes[n++] = frame->fds[i];
+    attributes[n++] = kPlaneAttributes[i][1];
+    attributes[n++] = static_cast<EGLint>(frame->offsets[i]);
+    attributes[n++] = kPlaneAttributes[i][2];
+    attributes[n++] = static_cast<EGLint>(frame->strides[i]);
+    if (has_modifier) {
+      attributes[n++] = kPlaneAttributes[i][3];
+      attributes[n++] = static_cast<EGLint>(frame->modifier & 0xffffffff);
+      attributes[n++] = kPlaneAttributes[i][4];
+      attributes[n++] = static_cast<EGLint>(frame->modifier >> 32);
+    }
+  }
+  attributes[n++] = EGL_NONE;
+
+  EGLImageKHR image = eglCreateImageKHR(display, EGL_NO_CONTEXT,
+                                        EGL_LINUX_DMA_BUF_EXT, nullptr,
+                                        attributes);
+  if (image == EGL_NO_IMAGE_KHR) {
+    g_set_error(error, G_IO_ERROR, G_IO_ERROR_FAILED,
+                "Failed to import dmabuf: EGL error 0x%x", eglGetError());
+  }
+  return image;
+}
+
+gboolean fl_dmabuf_texture_populate(FlDmabufTexture* self,
+                                    uint32_t width,
+                                    uint32_t height,
+                                    FlutterOpenGLTexture* opengl_texture,
+                                    GError** error) {
+  FlDmabufTextureFrame frame = {};
+  frame.width = width;
+  frame.height = height;
+  frame.modifier = kDrmFormatModInvalid;
+  frame.acquire_fence_fd = -1;
+  if (!FL_DMABUF_TEXTURE_GET_CLASS(self)->acquire_frame(self, &frame, error)) {
+    return FALSE;
+  }
+
+  // dmabufs can only be imported with EGL.
+  EGLDisplay display = eglGetCurrentDisplay();
+  EGLImageKHR image = EGL_NO_IMAGE_KHR;
+  if (display == EGL_NO_DISPLAY) {
+    g_set_error_literal(error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                        "dmabuf textures require an EGL context");
+  } else {
+    image = create_image(display, &frame, error);
+  }
+  if (image == EGL_NO_IMAGE_KHR) {
+    if (frame.acquire_fence_fd >= 0) {
+      close(frame.acquire_fence_fd);
+    }
+    release_frame(self, &frame, -1);
+    return FALSE;
+  }
+
+  if (frame.acquire_fence_fd >= 0) {
+    wait_for_fence(display, frame.acquire_fence_fd);
+    frame.acquire_fence_fd = -1;
+  }
+
+  FlDmabufTextureImport* import = g_new0(FlDmabufTextureImport, 1);
+  import->texture = FL_DMABUF_TEXTURE(g_object_ref(self));
+  import->frame = frame;
+  import->display = display;
+  import->image = image;
+  glGenTextures(1, &import->texture_id);
+  glBindTexture(GL_TEXTURE_2D, import->texture_id);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glEGLImageTargetTexture2DOES(GL_TEXTURE_2D, image);
+
+  opengl_texture->target = GL_TEXTURE_2D;
+  opengl_texture->name = import->texture_id;
+  opengl_texture->format = GL_RGBA8;
+  opengl_texture->destruction_callback = destroy_import;
+  opengl_texture->user_data = import;
+  opengl_texture->width = frame.width;
+  opengl_texture->height = frame.height;
+
+  return TRUE;
+}
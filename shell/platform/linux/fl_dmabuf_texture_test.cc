@@ -0,0 +1,132 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_dmabuf_texture.h"
+#include "flutter/shell/platform/linux/fl_dmabuf_texture_private.h"
+#include "flutter/shell/platform/linux/fl_texture_private.h"
+#include "flutter/shell/platform/linux/testing/fl_test.h"
+#include "gtest/gtest.h"
+
+#include <epoxy/egl.h>
+#include <epoxy/gl.h>
+
+static constexpr uint32_t kTextureWidth = 4u;
+static constexpr uint32_t kTextureHeight = 4u;
+static constexpr uint32_t kBufferWidth = 2u;
+static constexpr uint32_t kBufferHeight = 2u;
+
+G_DECLARE_FINAL_TYPE(FlTestDmabufTexture,
+                     fl_test_dmabuf_texture,
+                     FL,
+                     TEST_DMABUF_TEXTURE,
+                     FlDmabufTexture)
+
+/// A texture with a single fixed buffer.
+struct _FlTestDmabufTexture {
+  FlDmabufTexture parent_instance;
+
+  // The number of planes of the buffer.
+  uint32_t n_planes;
+
+  int acquired_count;
+  int released_count;
+};
+
+G_DEFINE_TYPE(FlTestDmabufTexture,
+              fl_test_dmabuf_texture,
+              fl_dmabuf_texture_get_type())
+
+static gboolean fl_test_dmabuf_texture_acquire_frame(
+    FlDmabufTexture* texture,
+    FlDmabufTextureFrame* frame,
+    GError** error) {
+  FlTestDmabufTexture* self = FL_TEST_DMABUF_TEXTURE(texture);
+  EXPECT_EQ(frame->width, kTextureWidth);
+  EXPECT_EQ(frame->height, kTextureHeight);
+  EXPECT_EQ(frame->acquire_fence_fd, -1);
+
+  frame->width = kBufferWidth;
+  frame->height = kBufferHeight;
+  frame->fourcc = 0x34324241;  // DRM_FORMAT_ABGR8888
+  frame->n_planes = self->n_planes;
+  frame->fds[0] = 42;
+  frame->offsets[0] = 0;
+  frame->strides[0] = kBufferWidth * 4;
+  self->acquired_count++;
+
+  return TRUE;
+}
+
+static void fl_test_dmabuf_texture_release_frame(
+    FlDmabufTexture* texture,
+    const FlDmabufTextureFrame* frame,
+    int release_fence_fd) {
+  FlTestDmabufTexture* self = FL_TEST_DMABUF_TEXTURE(texture);
+  EXPECT_EQ(frame->fds[0], 42);
+  self->released_count++;
+}
+
+static void fl_test_dmabuf_texture_class_init(
+    FlTestDmabufTextureClass* klass) {
+  FL_DMABUF_TEXTURE_CLASS(klass)->acquire_frame =
+      fl_test_dmabuf_texture_acquire_frame;
+  FL_DMABUF_TEXTURE_CLASS(klass)->release_frame =
+      fl_test_dmabuf_texture_release_frame;
+}
+
+static void fl_test_dmabuf_texture_init(FlTestDmabufTexture* self) {
+  self->n_planes = 1;
+}
+
+static FlTestDmabufTexture* fl_test_dmabuf_texture_new() {
+  return FL_TEST_DMABUF_TEXTURE(
+      g_object_new(fl_test_dmabuf_texture_get_type(), nullptr));
+}
+
+// Test that getting the texture ID works.
+TEST(FlDmabufTextureTest, TextureID) {
+  g_autoptr(FlTexture) texture = FL_TEXTURE(fl_test_dmabuf_texture_new());
+  fl_texture_set_id(texture, 42);
+  EXPECT_EQ(fl_texture_get_id(texture), static_cast<int64_t>(42));
+}
+
+// Test that populating an OpenGL texture imports the buffer, and releases it
+// once the OpenGL texture is destroyed.
+TEST(FlDmabufTextureTest, PopulateTexture) {
+  EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+  ASSERT_TRUE(eglInitialize(display, nullptr, nullptr));
+
+  g_autoptr(FlTestDmabufTexture) texture = fl_test_dmabuf_texture_new();
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_dmabuf_texture_populate(FL_DMABUF_TEXTURE(texture),
+                                         kTextureWidth, kTextureHeight,
+                                         &opengl_texture, &error));
+  EXPECT_EQ(error, nullptr);
+  EXPECT_EQ(opengl_texture.target, static_cast<uint32_t>(GL_TEXTURE_2D));
+  EXPECT_EQ(opengl_texture.width, kBufferWidth);
+  EXPECT_EQ(opengl_texture.height, kBufferHeight);
+  EXPECT_EQ(texture->acquired_count, 1);
+  EXPECT_EQ(texture->released_count, 0);
+
+  ASSERT_NE(opengl_texture.destruction_callback, nullptr);
+  opengl_texture.destruction_callback(opengl_texture.user_data);
+  EXPECT_EQ(texture->released_count, 1);
+}
+
+// Test that a frame that can't be imported is released immediately.
+TEST(FlDmabufTextureTest, ReleasesInvalidFrame) {
+  EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+  ASSERT_TRUE(eglInitialize(display, nullptr, nullptr));
+
+  g_autoptr(FlTestDmabufTexture) texture = fl_test_dmabuf_texture_new();
+  texture->n_planes = FL_DMABUF_TEXTURE_MAX_PLANES + 1;
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_FALSE(fl_dmabuf_texture_populate(FL_DMABUF_TEXTURE(texture),
+                                          kTextureWidth, kTextureHeight,
+                                          &opengl_texture, &error));
+  EXPECT_NE(error, nullptr);
+  EXPECT_EQ(texture->released_count, 1);
+}
@@ -17,6 +17,7 @@
 #include "flutter/shell/platform/linux/fl_binary_messenger_private.h"
 #include "flutter/shell/platform/linux/fl_dart_project_private.h"
 #include "flutter/shell/platform/linux/fl_engine_private.h"
+#include "flutter/shell/platform/linux/fl_dmabuf_texture_private.h"
 #include "flutter/shell/platform/linux/fl_pixel_buffer_texture_private.h"
 #include "flutter/shell/platform/linux/fl_plugin_registrar_private.h"
 #include "flutter/shell/platform/linux/fl_renderer.h"
@@ -37,6 +38,11 @@ static constexpr int32_t kPointerPanZoomDeviceId = 1;
 
 static constexpr const char* kFlutterLifecycleChannel = "flutter/lifecycle";
 
+// The refresh interval assumed until the frame clock reports one.
+static constexpr gint64 kDefaultRefreshIntervalMicroseconds = 16667;
+
+static constexpr gint64 kNanosecondsPerMicrosecond = 1000;
+
 struct _FlEngine {
   GObject parent_instance;
 
@@ -53,6 +59,16 @@ struct _FlEngine {
   FLUTTER_API_SYMBOL(FlutterEngine) engine;
   FlutterEngineProcTable embedder_api;
 
+  // Timing of the frames presented by the view, in monotonic microseconds,
+  // which the engine's vsync requests are aligned to. These are written on
+  // the GTK thread and read on the UI thread.
+  GMutex vsync_mutex;
+  gint64 vsync_phase;
+  gint64 refresh_interval;
+
+  // Refresh interval last reported to the engine.
+  gint64 reported_refresh_interval;
+
   // Function to call when a platform message is received.
   FlEnginePlatformMessageHandler platform_message_handler;
   gpointer platform_message_handler_data;
@@ -284,6 +300,9 @@ static bool fl_engine_gl_external_texture_frame_callback(
     result =
         fl_pixel_buffer_texture_populate(FL_PIXEL_BUFFER_TEXTURE(texture),
                                          width, height, opengl_texture, &error);
+  } else if (FL_IS_DMABUF_TEXTURE(texture)) {
+    result = fl_dmabuf_texture_populate(FL_DMABUF_TEXTURE(texture), width,
+                                        height, opengl_texture, &error);
   } else {
     g_warning("Unsupported texture type %" G_GINT64_FORMAT, texture_id);
     return false;
@@ -312,6 +331,32 @@ static void fl_engine_post_task(FlutterTask task,
   fl_task_runner_post_task(self->task_runner, task, target_time_nanos);
 }
 
+// Called by the engine on the UI thread when it needs a frame. Reports the
+// next time the view is predicted to be presented, according to the timing
+// of the frames it last presented.
+static void fl_engine_vsync_cb(void* user_data, intptr_t baton) {
+  FlEngine* self = static_cast<FlEngine*>(user_data);
+
+  gint64 phase, interval;
+  {
+    g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->vsync_mutex);
+    phase = self->vsync_phase * kNanosecondsPerMicrosecond;
+    interval = self->refresh_interval * kNanosecondsPerMicrosecond;
+  }
+  if (interval <= 0) {
+    interval = kDefaultRefreshIntervalMicroseconds * kNanosecondsPerMicrosecond;
+  }
+
+  gint64 now = self->embedder_api.GetCurrentTime();
+  gint64 offset = (now - phase) % interval;
+  if (offset < 0) {
+    offset += interval;
+  }
+  gint64 frame_start = offset == 0 ? now : now - offset + interval;
+  self->embedder_api.OnVsync(self->engine, baton, frame_start,
+                             frame_start + interval);
+}
+
 // Called when a platform message is received from the engine.
 static void fl_engine_platform_message_cb(const FlutterPlatformMessage* message,
                                           void* user_data) {
@@ -418,6 +463,8 @@ static void fl_engine_dispose(GObject* object) {
   g_clear_object(&self->settings_plugin);
   g_clear_object(&self->task_runner);
 
+  g_mutex_clear(&self->vsync_mutex);
+
   if (self->platform_message_handler_destroy_notify) {
     self->platform_message_handler_destroy_notify(
         self->platform_message_handler_data);
@@ -462,6 +509,8 @@ static void fl_engine_init(FlEngine* self) {
   FlutterEngineGetProcAddresses(&self->embedder_api);
 
   self->texture_registrar = fl_texture_registrar_new(self);
+
+  g_mutex_init(&self->vsync_mutex);
 }
 
 FlEngine* fl_engine_new(FlDartProject* project, FlRenderer* renderer) {
@@ -531,6 +580,7 @@ gboolean fl_engine_start(FlEngine* self, GError** error) {
   args.custom_task_runners = &custom_task_runners;
   args.shutdown_dart_vm_when_done = true;
   args.on_pre_engine_restart_callback = fl_engine_on_pre_engine_restart_cb;
+  args.vsync_callback = fl_engine_vsync_cb;
   args.dart_entrypoint_argc =
       dart_entrypoint_args != nullptr ? g_strv_length(dart_entrypoint_args) : 0;
   args.dart_entrypoint_argv =
@@ -932,6 +982,39 @@ void fl_engine_update_accessibility_features(FlEngine* self, int32_t flags) {
       self->engine, static_cast<FlutterAccessibilityFeature>(flags));
 }
 
+void fl_engine_update_frame_timing(FlEngine* self,
+                                   gint64 presentation_time,
+                                   gint64 refresh_interval) {
+  g_return_if_fail(FL_IS_ENGINE(self));
+
+  if (presentation_time <= 0 || refresh_interval <= 0) {
+    return;
+  }
+
+  {
+    g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->vsync_mutex);
+    self->vsync_phase = presentation_time;
+    self->refresh_interval = refresh_interval;
+  }
+
+  // Report changes of more than 1% of the refresh rate, such as when the view
+  // moves to another monitor or the compositor switches to variable refresh.
+  if (self->engine == nullptr ||
+      ABS(refresh_interval - self->reported_refresh_interval) * 100 <
+          refresh_interval) {
+    return;
+  }
+  self->reported_refresh_interval = refresh_interval;
+
+  FlutterEngineDisplay display = {};
+  display.struct_size = sizeof(FlutterEngineDisplay);
+  display.display_id = 0;
+  display.single_display = true;
+  display.refresh_rate = G_USEC_PER_SEC / static_cast<double>(refresh_interval);
+  self->embedder_api.NotifyDisplayUpdate(
+      self->engine, kFlutterEngineDisplaysUpdateTypeStartup, &display, 1);
+}
+
 GPtrArray* fl_engine_get_switches(FlEngine* self) {
   GPtrArray* switches = g_ptr_array_new_with_free_func(g_free);
   for (const auto& env_switch : flutter::GetSwitchesFromEnvironment()) {
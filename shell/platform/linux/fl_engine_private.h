@@ -350,6 +350,20 @@ gboolean fl_engine_unregister_external_texture(FlEngine* engine,
  */
 void fl_engine_update_accessibility_features(FlEngine* engine, int32_t flags);
 
+/**
+ * fl_engine_update_frame_timing:
+ * @engine: an #FlEngine.
+ * @presentation_time: the monotonic time in microseconds a frame was, or is
+ * predicted to be, presented at.
+ * @refresh_interval: the refresh interval of the monitor in microseconds.
+ *
+ * Aligns the frames the engine produces to the frames presented by the view,
+ * and reports changes of the refresh rate to the engine.
+ */
+void fl_engine_update_frame_timing(FlEngine* engine,
+                                   gint64 presentation_time,
+                                   gint64 refresh_interval);
+
 /**
  * fl_engine_get_switches:
  * @project: an #FlEngine.
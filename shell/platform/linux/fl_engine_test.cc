@@ -461,6 +461,48 @@ TEST(FlEngineTest, SendWindowStateEvent) {
   EXPECT_TRUE(called);
 }
 
+// Checks the frames requested by the engine are aligned to the frames
+// presented by the view.
+TEST(FlEngineTest, VsyncAlignsToFrameTiming) {
+  g_autoptr(FlEngine) engine = make_mock_engine();
+  FlutterEngineProcTable* embedder_api = fl_engine_get_embedder_api(engine);
+
+  VsyncCallback vsync_callback = nullptr;
+  embedder_api->Initialize = MOCK_ENGINE_PROC(
+      Initialize, ([&vsync_callback](
+                       size_t version, const FlutterRendererConfig* config,
+                       const FlutterProjectArgs* args, void* user_data,
+                       FLUTTER_API_SYMBOL(FlutterEngine) * engine_out) {
+        vsync_callback = args->vsync_callback;
+        return kSuccess;
+      }));
+  embedder_api->GetCurrentTime =
+      MOCK_ENGINE_PROC(GetCurrentTime, ([]() -> uint64_t { return 1010000; }));
+  uint64_t frame_start_time = 0;
+  uint64_t frame_target_time = 0;
+  embedder_api->OnVsync = MOCK_ENGINE_PROC(
+      OnVsync, ([&frame_start_time, &frame_target_time](
+                    auto engine, intptr_t baton, uint64_t start_time_nanos,
+                    uint64_t target_time_nanos) {
+        EXPECT_EQ(baton, 42);
+        frame_start_time = start_time_nanos;
+        frame_target_time = target_time_nanos;
+        return kSuccess;
+      }));
+
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_engine_start(engine, &error));
+  EXPECT_EQ(error, nullptr);
+  ASSERT_NE(vsync_callback, nullptr);
+
+  // A frame was presented at 1ms, on a monitor refreshing every 8ms.
+  fl_engine_update_frame_timing(engine, 1000, 8000);
+  vsync_callback(engine, 42);
+
+  EXPECT_EQ(frame_start_time, 9000000u);
+  EXPECT_EQ(frame_target_time, 17000000u);
+}
+
 #ifndef FLUTTER_RELEASE
 TEST(FlEngineTest, Switches) {
   g_autoptr(FlEngine) engine = make_mock_engine();
@@ -126,11 +126,39 @@ GtkWidget* fl_gl_area_new(GdkGLContext* context) {
   return GTK_WIDGET(area);
 }
 
-void fl_gl_area_queue_render(FlGLArea* self, GPtrArray* textures) {
+void fl_gl_area_queue_render(FlGLArea* self,
+                             GPtrArray* textures,
+                             const cairo_region_t* damage) {
   g_return_if_fail(FL_IS_GL_AREA(self));
 
+  // The damage is relative to the textures drawn before, so without them
+  // everything has to be drawn.
+  gboolean redraw_all = damage == nullptr || self->textures == nullptr;
+
   g_clear_pointer(&self->textures, g_ptr_array_unref);
   self->textures = g_ptr_array_ref(textures);
 
-  gtk_widget_queue_draw(GTK_WIDGET(self));
+  if (redraw_all) {
+    gtk_widget_queue_draw(GTK_WIDGET(self));
+    return;
+  }
+
+  // Convert the damage to logical pixels, rounding outwards.
+  gint scale = gtk_widget_get_scale_factor(GTK_WIDGET(self));
+  cairo_region_t* region = cairo_region_create();
+  for (int i = 0; i < cairo_region_num_rectangles(damage); i++) {
+    cairo_rectangle_int_t rect;
+    cairo_region_get_rectangle(damage, i, &rect);
+    gint left = rect.x / scale;
+    gint top = rect.y / scale;
+    gint right = (rect.x + rect.width + scale - 1) / scale;
+    gint bottom = (rect.y + rect.height + scale - 1) / scale;
+    cairo_rectangle_int_t logical_rect = {left, top, right - left,
+                                          bottom - top};
+    cairo_region_union_rectangle(region, &logical_rect);
+  }
+  if (!cairo_region_is_empty(region)) {
+    gtk_widget_queue_draw_region(GTK_WIDGET(self), region);
+  }
+  cairo_region_destroy(region);
 }
@@ -34,10 +34,16 @@ GtkWidget* fl_gl_area_new(GdkGLContext* context);
  * @area: an #FlGLArea.
  * @textures: (transfer none) (element-type FlBackingStoreProvider): a list of
  * #FlBackingStoreProvider.
+ * @damage: (allow-none): the area, in physical pixels, that changed since the
+ * textures queued before, or %NULL to redraw everything.
  *
- * Queues textures to be drawn later.
+ * Queues textures to be drawn later. Only the damaged area is invalidated, so
+ * GDK only redraws that area and reports it as the damage of the window
+ * surface to the compositor.
  */
-void fl_gl_area_queue_render(FlGLArea* area, GPtrArray* textures);
+void fl_gl_area_queue_render(FlGLArea* area,
+                             GPtrArray* textures,
+                             const cairo_region_t* damage);
 
 G_END_DECLS
 
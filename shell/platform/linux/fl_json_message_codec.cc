@@ -250,8 +250,7 @@ static GBytes* fl_json_message_codec_encode_message(FlMessageCodec* codec,
     return nullptr;
   }
 
-  const gchar* text = buffer.GetString();
-  return g_bytes_new(text, strlen(text));
+  return g_bytes_new(buffer.GetString(), buffer.GetSize());
 }
 
 // Implements FlMessageCodec:decode_message.
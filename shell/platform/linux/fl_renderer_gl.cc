@@ -4,6 +4,9 @@
 
 #include "flutter/shell/platform/linux/fl_renderer_gl.h"
 
+#include <cmath>
+#include <cstddef>
+
 #include "flutter/shell/platform/linux/fl_backing_store_provider.h"
 #include "flutter/shell/platform/linux/fl_view_private.h"
 
@@ -89,6 +92,33 @@ static gboolean fl_renderer_gl_collect_backing_store(
   return TRUE;
 }
 
+// Adds the damage of a backing store layer, offset to its position in the
+// view, to @damage. Returns %FALSE if the damage of the layer is unknown.
+static gboolean add_layer_damage(const FlutterLayer* layer,
+                                 cairo_region_t* damage) {
+  const FlutterBackingStorePresentInfo* info =
+      layer->backing_store_present_info;
+  if (info == nullptr ||
+      info->struct_size <
+          offsetof(FlutterBackingStorePresentInfo, damage_region) +
+              sizeof(info->damage_region) ||
+      info->damage_region == nullptr) {
+    return FALSE;
+  }
+
+  for (size_t i = 0; i < info->damage_region->rects_count; i++) {
+    const FlutterRect& rect = info->damage_region->rects[i];
+    int left = static_cast<int>(std::floor(layer->offset.x + rect.left));
+    int top = static_cast<int>(std::floor(layer->offset.y + rect.top));
+    int right = static_cast<int>(std::ceil(layer->offset.x + rect.right));
+    int bottom = static_cast<int>(std::ceil(layer->offset.y + rect.bottom));
+    cairo_rectangle_int_t damage_rect = {left, top, right - left,
+                                         bottom - top};
+    cairo_region_union_rectangle(damage, &damage_rect);
+  }
+  return TRUE;
+}
+
 // Implements FlRenderer::present_layers.
 static gboolean fl_renderer_gl_present_layers(FlRenderer* renderer,
                                               const FlutterLayer** layers,
@@ -100,6 +130,8 @@ static gboolean fl_renderer_gl_present_layers(FlRenderer* renderer,
   }
 
   g_autoptr(GPtrArray) textures = g_ptr_array_new();
+  cairo_region_t* damage = cairo_region_create();
+  gboolean damage_known = TRUE;
   for (size_t i = 0; i < layers_count; ++i) {
     const FlutterLayer* layer = layers[i];
     switch (layer->type) {
@@ -108,6 +140,9 @@ static gboolean fl_renderer_gl_present_layers(FlRenderer* renderer,
         auto framebuffer = &backing_store->open_gl.framebuffer;
         g_ptr_array_add(textures, reinterpret_cast<FlBackingStoreProvider*>(
                                       framebuffer->user_data));
+        if (!add_layer_damage(layer, damage)) {
+          damage_known = FALSE;
+        }
       } break;
       case kFlutterLayerContentTypePlatformView: {
         // Currently unsupported.
@@ -115,7 +150,9 @@ static gboolean fl_renderer_gl_present_layers(FlRenderer* renderer,
     }
   }
 
-  fl_view_set_textures(view, context, textures);
+  fl_view_set_textures(view, context, textures,
+                       damage_known ? damage : nullptr);
+  cairo_region_destroy(damage);
 
   return TRUE;
 }
@@ -6,7 +6,6 @@
 #include "flutter/shell/platform/linux/fl_engine_private.h"
 
 static constexpr int kMicrosecondsPerNanosecond = 1000;
-static constexpr int kMillisecondsPerMicrosecond = 1000;
 
 struct _FlTaskRunner {
   GObject parent_instance;
@@ -16,7 +15,13 @@ struct _FlTaskRunner {
   GMutex mutex;
   GCond cond;
 
-  guint timeout_source_id;
+  // Source on the main context that is dispatched when the next task expires.
+  // It is created once and rescheduled by setting its ready time, which wakes
+  // the main context from any thread, instead of adding a timeout source for
+  // every change of the next expiration time.
+  GSource* source;
+  // Sorted by expiration time, tasks expiring at the same time in the order
+  // they were posted.
   GList /*<FlTaskRunnerTask>*/* pending_tasks;
   gboolean blocking_main_thread;
 };
@@ -29,25 +34,40 @@ typedef struct _FlTaskRunnerTask {
 
 G_DEFINE_TYPE(FlTaskRunner, fl_task_runner, G_TYPE_OBJECT)
 
+// Orders tasks by expiration time. Tasks never compare equal so that
+// g_list_insert_sorted places a task after those expiring at the same time.
+static gint fl_task_runner_compare_tasks(gconstpointer a, gconstpointer b) {
+  const FlTaskRunnerTask* task_a = static_cast<const FlTaskRunnerTask*>(a);
+  const FlTaskRunnerTask* task_b = static_cast<const FlTaskRunnerTask*>(b);
+  return task_a->task_time_micros < task_b->task_time_micros ? -1 : 1;
+}
+
 // Removes expired tasks from the task queue and executes them.
 // The execution is performed with mutex unlocked.
 static void fl_task_runner_process_expired_tasks_locked(FlTaskRunner* self) {
-  GList* expired_tasks = nullptr;
-
   gint64 current_time = g_get_monotonic_time();
 
+  // The expired tasks are at the start of the queue, so they are drained in
+  // one batch.
+  GList* expired_tasks = self->pending_tasks;
   GList* l = self->pending_tasks;
+  GList* last_expired = nullptr;
   while (l != nullptr) {
     FlTaskRunnerTask* task = static_cast<FlTaskRunnerTask*>(l->data);
-    if (task->task_time_micros <= current_time) {
-      GList* link = l;
-      l = l->next;
-      self->pending_tasks = g_list_remove_link(self->pending_tasks, link);
-      expired_tasks = g_list_concat(expired_tasks, link);
-    } else {
-      l = l->next;
+    if (task->task_time_micros > current_time) {
+      break;
     }
+    last_expired = l;
+    l = l->next;
+  }
+  if (last_expired == nullptr) {
+    return;
   }
+  self->pending_tasks = l;
+  if (l != nullptr) {
+    l->prev = nullptr;
+  }
+  last_expired->next = nullptr;
 
   g_mutex_unlock(&self->mutex);
 
@@ -65,9 +85,9 @@ static void fl_task_runner_process_expired_tasks_locked(FlTaskRunner* self) {
 
 static void fl_task_runner_tasks_did_change_locked(FlTaskRunner* self);
 
-// Invoked from a timeout source. Removes and executes expired tasks
-// and reschedules timeout if needed.
-static gboolean fl_task_runner_on_expired_timeout(gpointer data) {
+// Invoked from the task runner source when the next task expires. Removes and
+// executes expired tasks and reschedules the source if needed.
+static gboolean fl_task_runner_on_source_ready(gpointer data) {
   FlTaskRunner* self = FL_TASK_RUNNER(data);
 
   g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->mutex);
@@ -75,48 +95,53 @@ static gboolean fl_task_runner_on_expired_timeout(gpointer data) {
 
   g_object_ref(self);
 
-  self->timeout_source_id = 0;
   fl_task_runner_process_expired_tasks_locked(self);
 
-  // reschedule timeout
+  // reschedule source
   fl_task_runner_tasks_did_change_locked(self);
 
   g_object_unref(self);
 
-  return FALSE;
+  return G_SOURCE_CONTINUE;
+}
+
+static gboolean fl_task_runner_source_dispatch(GSource* source,
+                                               GSourceFunc callback,
+                                               gpointer user_data) {
+  g_source_set_ready_time(source, -1);
+  return callback(user_data);
 }
 
+static GSourceFuncs fl_task_runner_source_funcs = {
+    nullptr,  // prepare
+    nullptr,  // check
+    fl_task_runner_source_dispatch,
+    nullptr,  // finalize
+    nullptr,
+    nullptr,
+};
+
 // Returns the absolute time of next expired task (in microseconds, based on
 // g_get_monotonic_time). If no task is scheduled returns G_MAXINT64.
 static gint64 fl_task_runner_next_task_expiration_time_locked(
     FlTaskRunner* self) {
-  gint64 min_time = G_MAXINT64;
-  GList* l = self->pending_tasks;
-  while (l != nullptr) {
-    FlTaskRunnerTask* task = static_cast<FlTaskRunnerTask*>(l->data);
-    min_time = MIN(min_time, task->task_time_micros);
-    l = l->next;
+  if (self->pending_tasks == nullptr) {
+    return G_MAXINT64;
   }
-  return min_time;
+  return static_cast<FlTaskRunnerTask*>(self->pending_tasks->data)
+      ->task_time_micros;
 }
 
 static void fl_task_runner_tasks_did_change_locked(FlTaskRunner* self) {
   if (self->blocking_main_thread) {
     // Wake up blocked thread
     g_cond_signal(&self->cond);
-  } else {
-    // Reschedule timeout
-    if (self->timeout_source_id != 0) {
-      g_source_remove(self->timeout_source_id);
-      self->timeout_source_id = 0;
-    }
+  } else if (self->source != nullptr) {
+    // Reschedule source. The main context uses the same clock as
+    // g_get_monotonic_time.
     gint64 min_time = fl_task_runner_next_task_expiration_time_locked(self);
-    if (min_time != G_MAXINT64) {
-      gint64 remaining = MAX(min_time - g_get_monotonic_time(), 0);
-      self->timeout_source_id =
-          g_timeout_add(remaining / kMillisecondsPerMicrosecond + 1,
-                        fl_task_runner_on_expired_timeout, self);
-    }
+    g_source_set_ready_time(self->source,
+                            min_time != G_MAXINT64 ? min_time : -1);
   }
 }
 
@@ -142,8 +167,11 @@ void fl_task_runner_dispose(GObject* object) {
   g_cond_clear(&self->cond);
 
   g_list_free_full(self->pending_tasks, g_free);
-  if (self->timeout_source_id != 0) {
-    g_source_remove(self->timeout_source_id);
+  self->pending_tasks = nullptr;
+  if (self->source != nullptr) {
+    g_source_destroy(self->source);
+    g_source_unref(self->source);
+    self->source = nullptr;
   }
 
   G_OBJECT_CLASS(fl_task_runner_parent_class)->dispose(object);
@@ -156,6 +184,12 @@ static void fl_task_runner_class_init(FlTaskRunnerClass* klass) {
 static void fl_task_runner_init(FlTaskRunner* self) {
   g_mutex_init(&self->mutex);
   g_cond_init(&self->cond);
+
+  self->source = g_source_new(&fl_task_runner_source_funcs, sizeof(GSource));
+  g_source_set_name(self->source, "FlTaskRunner");
+  g_source_set_callback(self->source, fl_task_runner_on_source_ready, self,
+                        nullptr);
+  g_source_attach(self->source, nullptr);
 }
 
 FlTaskRunner* fl_task_runner_new(FlEngine* engine) {
@@ -177,7 +211,8 @@ void fl_task_runner_post_task(FlTaskRunner* self,
   runner_task->task_time_micros =
       target_time_nanos / kMicrosecondsPerNanosecond;
 
-  self->pending_tasks = g_list_append(self->pending_tasks, runner_task);
+  self->pending_tasks = g_list_insert_sorted(
+      self->pending_tasks, runner_task, fl_task_runner_compare_tasks);
   fl_task_runner_tasks_did_change_locked(self);
 }
 
@@ -6,6 +6,7 @@
 
 #include <gtk/gtk.h>
 
+#include "flutter/fml/string_conversion.h"
 #include "flutter/shell/platform/common/text_editing_delta.h"
 #include "flutter/shell/platform/common/text_input_model.h"
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_json_method_codec.h"
@@ -262,13 +263,20 @@ static void im_preedit_start_cb(FlTextInputPlugin* self) {
 static void im_preedit_changed_cb(FlTextInputPlugin* self) {
   FlTextInputPluginPrivate* priv = static_cast<FlTextInputPluginPrivate*>(
       fl_text_input_plugin_get_instance_private(self));
-  std::string text_before_change = priv->text_model->GetText();
-  flutter::TextRange composing_before_change =
-      priv->text_model->composing_range();
   g_autofree gchar* buf = nullptr;
   gint cursor_offset = 0;
   gtk_im_context_get_preedit_string(priv->im_context, &buf, nullptr,
                                     &cursor_offset);
+
+  // The delta is described before the edit is made so that the text from
+  // before the change doesn't have to be copied.
+  std::unique_ptr<flutter::TextEditingDelta> delta;
+  if (priv->enable_delta_model) {
+    delta = std::make_unique<flutter::TextEditingDelta>(
+        priv->text_model->text_utf16(), priv->text_model->composing_range(),
+        fml::Utf8ToUtf16(buf));
+  }
+
   if (priv->text_model->composing()) {
     cursor_offset += priv->text_model->composing_range().start();
   } else {
@@ -277,11 +285,8 @@ static void im_preedit_changed_cb(FlTextInputPlugin* self) {
   priv->text_model->UpdateComposingText(buf);
   priv->text_model->SetSelection(flutter::TextRange(cursor_offset));
 
-  if (priv->enable_delta_model) {
-    std::string text(buf);
-    flutter::TextEditingDelta delta = flutter::TextEditingDelta(
-        text_before_change, composing_before_change, text);
-    update_editing_state_with_delta(self, &delta);
+  if (delta) {
+    update_editing_state_with_delta(self, delta.get());
   } else {
     update_editing_state(self);
   }
@@ -291,23 +296,21 @@ static void im_preedit_changed_cb(FlTextInputPlugin* self) {
 static void im_commit_cb(FlTextInputPlugin* self, const gchar* text) {
   FlTextInputPluginPrivate* priv = static_cast<FlTextInputPluginPrivate*>(
       fl_text_input_plugin_get_instance_private(self));
-  std::string text_before_change = priv->text_model->GetText();
-  flutter::TextRange composing_before_change =
-      priv->text_model->composing_range();
-  flutter::TextRange selection_before_change = priv->text_model->selection();
-  gboolean was_composing = priv->text_model->composing();
+  std::unique_ptr<flutter::TextEditingDelta> delta;
+  if (priv->enable_delta_model) {
+    flutter::TextRange replace_range = priv->text_model->composing()
+                                           ? priv->text_model->composing_range()
+                                           : priv->text_model->selection();
+    delta = std::make_unique<flutter::TextEditingDelta>(
+        priv->text_model->text_utf16(), replace_range, fml::Utf8ToUtf16(text));
+  }
 
   priv->text_model->AddText(text);
   if (priv->text_model->composing()) {
     priv->text_model->CommitComposing();
   }
 
-  if (priv->enable_delta_model) {
-    flutter::TextRange replace_range =
-        was_composing ? composing_before_change : selection_before_change;
-    std::unique_ptr<flutter::TextEditingDelta> delta =
-        std::make_unique<flutter::TextEditingDelta>(text_before_change,
-                                                    replace_range, text);
+  if (delta) {
     update_editing_state_with_delta(self, delta.get());
   } else {
     update_editing_state(self);
@@ -346,12 +349,15 @@ static gboolean im_delete_surrounding_cb(FlTextInputPlugin* self,
   FlTextInputPluginPrivate* priv = static_cast<FlTextInputPluginPrivate*>(
       fl_text_input_plugin_get_instance_private(self));
 
-  std::string text_before_change = priv->text_model->GetText();
+  std::u16string text_before_change;
+  if (priv->enable_delta_model) {
+    text_before_change = priv->text_model->text_utf16();
+  }
   if (priv->text_model->DeleteSurrounding(offset, n_chars)) {
     if (priv->enable_delta_model) {
       flutter::TextEditingDelta delta = flutter::TextEditingDelta(
           text_before_change, priv->text_model->composing_range(),
-          priv->text_model->GetText());
+          priv->text_model->text_utf16());
       update_editing_state_with_delta(self, &delta);
     } else {
       update_editing_state(self);
@@ -6,8 +6,12 @@
 
 #include <gmodule.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
 
+#include "flutter/shell/platform/linux/fl_value_private.h"
+
 struct _FlValue {
   FlValueType type;
   int ref_count;
@@ -37,30 +41,40 @@ typedef struct {
   FlValue parent;
   uint8_t* values;
   size_t values_length;
+  // The message the values are in, if they weren't copied out of it.
+  GBytes* bytes;
 } FlValueUint8List;
 
 typedef struct {
   FlValue parent;
   int32_t* values;
   size_t values_length;
+  // The message the values are in, if they weren't copied out of it.
+  GBytes* bytes;
 } FlValueInt32List;
 
 typedef struct {
   FlValue parent;
   int64_t* values;
   size_t values_length;
+  // The message the values are in, if they weren't copied out of it.
+  GBytes* bytes;
 } FlValueInt64List;
 
 typedef struct {
   FlValue parent;
   float* values;
   size_t values_length;
+  // The message the values are in, if they weren't copied out of it.
+  GBytes* bytes;
 } FlValueFloat32List;
 
 typedef struct {
   FlValue parent;
   double* values;
   size_t values_length;
+  // The message the values are in, if they weren't copied out of it.
+  GBytes* bytes;
 } FlValueFloatList;
 
 typedef struct {
@@ -74,13 +88,111 @@ typedef struct {
   GPtrArray* values;
 } FlValueMap;
 
+// Values of every type are allocated in blocks of the same size, so that the
+// blocks of freed values can be reused for new values of any type. Values are
+// commonly decoded and dropped in bursts, such as for sensor streams, so each
+// thread keeps a bounded cache of free blocks rather than returning them to
+// the allocator.
+static constexpr size_t kValueBlockSize = std::max({
+    sizeof(FlValueBool),
+    sizeof(FlValueInt),
+    sizeof(FlValueDouble),
+    sizeof(FlValueString),
+    sizeof(FlValueUint8List),
+    sizeof(FlValueInt32List),
+    sizeof(FlValueInt64List),
+    sizeof(FlValueFloat32List),
+    sizeof(FlValueFloatList),
+    sizeof(FlValueList),
+    sizeof(FlValueMap),
+});
+static constexpr size_t kMaxCachedValueBlocks = 256;
+
+// Free blocks, linked through their first pointer.
+typedef struct {
+  gpointer head;
+  size_t length;
+} FlValueBlockCache;
+
+static void fl_value_block_cache_free(gpointer data) {
+  FlValueBlockCache* cache = static_cast<FlValueBlockCache*>(data);
+  while (cache->head != nullptr) {
+    gpointer next = *static_cast<gpointer*>(cache->head);
+    g_free(cache->head);
+    cache->head = next;
+  }
+  g_free(cache);
+}
+
+static GPrivate fl_value_block_cache =
+    G_PRIVATE_INIT(fl_value_block_cache_free);
+
+static FlValueBlockCache* fl_value_get_block_cache() {
+  FlValueBlockCache* cache =
+      static_cast<FlValueBlockCache*>(g_private_get(&fl_value_block_cache));
+  if (cache == nullptr) {
+    cache = g_new0(FlValueBlockCache, 1);
+    g_private_set(&fl_value_block_cache, cache);
+  }
+  return cache;
+}
+
 static FlValue* fl_value_new(FlValueType type, size_t size) {
-  FlValue* self = static_cast<FlValue*>(g_malloc0(size));
+  g_assert(size <= kValueBlockSize);
+  FlValueBlockCache* cache = fl_value_get_block_cache();
+  FlValue* self;
+  if (cache->head != nullptr) {
+    self = static_cast<FlValue*>(cache->head);
+    cache->head = *static_cast<gpointer*>(cache->head);
+    cache->length--;
+    memset(self, 0, kValueBlockSize);
+  } else {
+    self = static_cast<FlValue*>(g_malloc0(kValueBlockSize));
+  }
   self->type = type;
   self->ref_count = 1;
   return self;
 }
 
+// Returns the block of a value to the cache of the calling thread, which need
+// not be the one that allocated it since all blocks are alike.
+static void fl_value_free(FlValue* self) {
+  FlValueBlockCache* cache = fl_value_get_block_cache();
+  if (cache->length >= kMaxCachedValueBlocks) {
+    g_free(self);
+    return;
+  }
+  *reinterpret_cast<gpointer*>(self) = cache->head;
+  cache->head = self;
+  cache->length++;
+}
+
+// Creates a typed list of @length values that are at @offset in @bytes. The
+// list keeps a reference to @bytes rather than copying the values out of it,
+// unless they aren't aligned for their type.
+template <typename ListType, typename T>
+static FlValue* fl_value_new_typed_list_from_bytes(FlValueType type,
+                                                   GBytes* bytes,
+                                                   size_t offset,
+                                                   size_t length) {
+  ListType* self =
+      reinterpret_cast<ListType*>(fl_value_new(type, sizeof(ListType)));
+  self->values_length = length;
+  if (length == 0) {
+    return reinterpret_cast<FlValue*>(self);
+  }
+  const uint8_t* data =
+      static_cast<const uint8_t*>(g_bytes_get_data(bytes, nullptr)) + offset;
+  if (reinterpret_cast<uintptr_t>(data) % alignof(T) == 0) {
+    self->bytes = g_bytes_ref(bytes);
+    self->values = reinterpret_cast<T*>(const_cast<uint8_t*>(data));
+  } else {
+    self->values = static_cast<T*>(g_malloc(sizeof(T) * length));
+    memcpy(self->values, data, sizeof(T) * length);
+  }
+  return reinterpret_cast<FlValue*>(self);
+}
+
 // Helper function to match GDestroyNotify type.
 static void fl_value_destroy(gpointer value) {
   fl_value_unref(static_cast<FlValue*>(value));
@@ -289,10 +401,8 @@ G_MODULE_EXPORT FlValue* fl_value_new_uint8_list(const uint8_t* data,
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_uint8_list_from_bytes(GBytes* data) {
-  gsize length;
-  const uint8_t* d =
-      static_cast<const uint8_t*>(g_bytes_get_data(data, &length));
-  return fl_value_new_uint8_list(d, length);
+  return fl_value_new_list_from_bytes(FL_VALUE_TYPE_UINT8_LIST, data, 0,
+                                      g_bytes_get_size(data));
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_int32_list(const int32_t* data,
@@ -360,6 +470,32 @@ G_MODULE_EXPORT FlValue* fl_value_new_map() {
   return reinterpret_cast<FlValue*>(self);
 }
 
+FlValue* fl_value_new_list_from_bytes(FlValueType type,
+                                      GBytes* bytes,
+                                      size_t offset,
+                                      size_t length) {
+  g_return_val_if_fail(bytes != nullptr, nullptr);
+  switch (type) {
+    case FL_VALUE_TYPE_UINT8_LIST:
+      return fl_value_new_typed_list_from_bytes<FlValueUint8List, uint8_t>(
+          type, bytes, offset, length);
+    case FL_VALUE_TYPE_INT32_LIST:
+      return fl_value_new_typed_list_from_bytes<FlValueInt32List, int32_t>(
+          type, bytes, offset, length);
+    case FL_VALUE_TYPE_INT64_LIST:
+      return fl_value_new_typed_list_from_bytes<FlValueInt64List, int64_t>(
+          type, bytes, offset, length);
+    case FL_VALUE_TYPE_FLOAT32_LIST:
+      return fl_value_new_typed_list_from_bytes<FlValueFloat32List, float>(
+          type, bytes, offset, length);
+    case FL_VALUE_TYPE_FLOAT_LIST:
+      return fl_value_new_typed_list_from_bytes<FlValueFloatList, double>(
+          type, bytes, offset, length);
+    default:
+      g_return_val_if_reached(nullptr);
+  }
+}
+
 G_MODULE_EXPORT FlValue* fl_value_ref(FlValue* self) {
   g_return_val_if_fail(self != nullptr, nullptr);
   self->ref_count++;
@@ -382,27 +518,47 @@ G_MODULE_EXPORT void fl_value_unref(FlValue* self) {
     }
     case FL_VALUE_TYPE_UINT8_LIST: {
       FlValueUint8List* v = reinterpret_cast<FlValueUint8List*>(self);
-      g_free(v->values);
+      if (v->bytes != nullptr) {
+        g_bytes_unref(v->bytes);
+      } else {
+        g_free(v->values);
+      }
       break;
     }
     case FL_VALUE_TYPE_INT32_LIST: {
       FlValueInt32List* v = reinterpret_cast<FlValueInt32List*>(self);
-      g_free(v->values);
+      if (v->bytes != nullptr) {
+        g_bytes_unref(v->bytes);
+      } else {
+        g_free(v->values);
+      }
       break;
     }
     case FL_VALUE_TYPE_INT64_LIST: {
       FlValueInt64List* v = reinterpret_cast<FlValueInt64List*>(self);
-      g_free(v->values);
+      if (v->bytes != nullptr) {
+        g_bytes_unref(v->bytes);
+      } else {
+        g_free(v->values);
+      }
       break;
     }
     case FL_VALUE_TYPE_FLOAT32_LIST: {
       FlValueFloat32List* v = reinterpret_cast<FlValueFloat32List*>(self);
-      g_free(v->values);
+      if (v->bytes != nullptr) {
+        g_bytes_unref(v->bytes);
+      } else {
+        g_free(v->values);
+      }
       break;
     }
     case FL_VALUE_TYPE_FLOAT_LIST: {
       FlValueFloatList* v = reinterpret_cast<FlValueFloatList*>(self);
-      g_free(v->values);
+      if (v->bytes != nullptr) {
+        g_bytes_unref(v->bytes);
+      } else {
+        g_free(v->values);
+      }
       break;
     }
     case FL_VALUE_TYPE_LIST: {
@@ -422,7 +578,7 @@ G_MODULE_EXPORT void fl_value_unref(FlValue* self) {
     case FL_VALUE_TYPE_FLOAT:
       break;
   }
-  g_free(self);
+  fl_value_free(self);
 }
 
 G_MODULE_EXPORT FlValueType fl_value_get_type(FlValue* self) {
@@ -0,0 +1,35 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_value.h"
+
+G_BEGIN_DECLS
+
+/**
+ * fl_value_new_list_from_bytes:
+ * @type: the type of list, one of the typed list types such as
+ * #FL_VALUE_TYPE_INT32_LIST.
+ * @bytes: bytes containing the values.
+ * @offset: offset of the first value in @bytes.
+ * @length: number of values.
+ *
+ * Creates a typed list of the values at @offset in @bytes. The list holds a
+ * reference to @bytes instead of copying the values out of it, unless they
+ * aren't aligned for their type, so it keeps all of @bytes alive.
+ *
+ * The caller must ensure @bytes holds @length values at @offset.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_list_from_bytes(FlValueType type,
+                                      GBytes* bytes,
+                                      size_t offset,
+                                      size_t length);
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
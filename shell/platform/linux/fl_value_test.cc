@@ -3,9 +3,12 @@
 // found in the LICENSE file.
 
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_value.h"
+#include "flutter/shell/platform/linux/fl_value_private.h"
 
 #include <gmodule.h>
 
+#include <cstring>
+
 #include "gtest/gtest.h"
 
 TEST(FlDartProjectTest, Null) {
@@ -210,6 +213,43 @@ TEST(FlValueTest, Uint8List) {
   EXPECT_EQ(fl_value_get_uint8_list(value)[3], 0xFF);
 }
 
+TEST(FlValueTest, Uint8ListFromBytesSharesData) {
+  uint8_t data[] = {0x00, 0x01, 0xFE, 0xFF};
+  g_autoptr(GBytes) bytes = g_bytes_new(data, 4);
+  g_autoptr(FlValue) value = fl_value_new_uint8_list_from_bytes(bytes);
+  ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_UINT8_LIST);
+  ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(4));
+  EXPECT_EQ(fl_value_get_uint8_list(value), g_bytes_get_data(bytes, nullptr));
+  EXPECT_EQ(fl_value_get_uint8_list(value)[3], 0xFF);
+}
+
+TEST(FlValueTest, FloatListFromBytes) {
+  double data[] = {0.0, 1.0, 2.0, 3.0};
+  g_autoptr(GBytes) bytes = g_bytes_new(data, sizeof(data));
+  g_autoptr(FlValue) value = fl_value_new_list_from_bytes(
+      FL_VALUE_TYPE_FLOAT_LIST, bytes, sizeof(double), 2);
+  ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_FLOAT_LIST);
+  ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(2));
+  const double* values = fl_value_get_float_list(value);
+  EXPECT_EQ(reinterpret_cast<const uint8_t*>(values),
+            static_cast<const uint8_t*>(g_bytes_get_data(bytes, nullptr)) +
+                sizeof(double));
+  EXPECT_EQ(values[0], 1.0);
+  EXPECT_EQ(values[1], 2.0);
+}
+
+TEST(FlValueTest, FloatListFromUnalignedBytes) {
+  uint8_t data[1 + 2 * sizeof(double)] = {};
+  double values[] = {1.0, 2.0};
+  memcpy(data + 1, values, sizeof(values));
+  g_autoptr(GBytes) bytes = g_bytes_new(data, sizeof(data));
+  g_autoptr(FlValue) value =
+      fl_value_new_list_from_bytes(FL_VALUE_TYPE_FLOAT_LIST, bytes, 1, 2);
+  ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(2));
+  EXPECT_EQ(fl_value_get_float_list(value)[0], 1.0);
+  EXPECT_EQ(fl_value_get_float_list(value)[1], 2.0);
+}
+
 TEST(FlValueTest, Uint8ListNullptr) {
   g_autoptr(FlValue) value = fl_value_new_uint8_list(nullptr, 0);
   ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_UINT8_LIST);
@@ -543,6 +543,25 @@ static gboolean window_state_event_cb(GtkWidget* widget,
   return FALSE;
 }
 
+// Aligns the frames produced by the engine to the frames presented by the
+// view. The frame clock has the timing of the compositor, such as the
+// presentation-time feedback of Wayland compositors.
+static void frame_clock_after_paint_cb(GdkFrameClock* frame_clock,
+                                       FlView* self) {
+  gint64 frame_time = gdk_frame_clock_get_frame_time(frame_clock);
+  gint64 refresh_interval = 0;
+  gint64 presentation_time = 0;
+  gdk_frame_clock_get_refresh_info(frame_clock, frame_time, &refresh_interval,
+                                   &presentation_time);
+  // The presentation time is unknown when the compositor doesn't report it,
+  // in which case frames are assumed to start at the frame time.
+  if (presentation_time == 0) {
+    presentation_time = frame_time;
+  }
+  fl_engine_update_frame_timing(self->engine, presentation_time,
+                                refresh_interval);
+}
+
 static void realize_cb(GtkWidget* widget) {
   FlView* self = FL_VIEW(widget);
   g_autoptr(GError) error = nullptr;
@@ -562,6 +581,10 @@ static void realize_cb(GtkWidget* widget) {
 
   init_keyboard(self);
 
+  g_signal_connect_object(gtk_widget_get_frame_clock(GTK_WIDGET(self)),
+                          "after-paint", G_CALLBACK(frame_clock_after_paint_cb),
+                          self, static_cast<GConnectFlags>(0));
+
   if (!fl_renderer_start(self->renderer, self, &error)) {
     g_warning("Failed to start Flutter renderer: %s", error->message);
     return;
@@ -774,7 +797,8 @@ G_MODULE_EXPORT FlEngine* fl_view_get_engine(FlView* self) {
 
 void fl_view_set_textures(FlView* self,
                           GdkGLContext* context,
-                          GPtrArray* textures) {
+                          GPtrArray* textures,
+                          const cairo_region_t* damage) {
   g_return_if_fail(FL_IS_VIEW(self));
 
   if (self->gl_area == nullptr) {
@@ -784,7 +808,7 @@ void fl_view_set_textures(FlView* self,
                       GTK_WIDGET(self->gl_area));
   }
 
-  fl_gl_area_queue_render(self->gl_area, textures);
+  fl_gl_area_queue_render(self->gl_area, textures, damage);
 }
 
 GHashTable* fl_view_get_keyboard_state(FlView* self) {
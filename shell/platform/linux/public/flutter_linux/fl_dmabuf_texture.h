@@ -0,0 +1,167 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_PUBLIC_FLUTTER_LINUX_FL_DMABUF_TEXTURE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_PUBLIC_FLUTTER_LINUX_FL_DMABUF_TEXTURE_H_
+
+#if !defined(__FLUTTER_LINUX_INSIDE__) && !defined(FLUTTER_LINUX_COMPILATION)
+#error "Only <flutter_linux/flutter_linux.h> can be included directly."
+#endif
+
+#include <glib-object.h>
+#include <gmodule.h>
+#include <stdint.h>
+
+#include "fl_texture.h"
+
+G_BEGIN_DECLS
+
+G_MODULE_EXPORT
+G_DECLARE_DERIVABLE_TYPE(FlDmabufTexture,
+                         fl_dmabuf_texture,
+                         FL,
+                         DMABUF_TEXTURE,
+                         GObject)
+
+/**
+ * FL_DMABUF_TEXTURE_MAX_PLANES:
+ *
+ * The maximum number of planes of a #FlDmabufTextureFrame.
+ */
+#define FL_DMABUF_TEXTURE_MAX_PLANES 4
+
+/**
+ * FlDmabufTextureFrame:
+ * @width: width of the buffer in pixels.
+ * @height: height of the buffer in pixels.
+ * @fourcc: DRM fourcc format of the buffer, for example DRM_FORMAT_ABGR8888.
+ * @modifier: DRM format modifier of the buffer, or DRM_FORMAT_MOD_INVALID if
+ * the buffer uses an implicit modifier.
+ * @n_planes: number of planes of the buffer.
+ * @fds: dmabuf file descriptor of each plane.
+ * @offsets: offset in bytes of each plane in its dmabuf.
+ * @strides: stride in bytes of each plane.
+ * @acquire_fence_fd: sync file descriptor that signals once the buffer has
+ * been written, or -1 if it can be read immediately.
+ *
+ * A frame of a #FlDmabufTexture.
+ */
+typedef struct {
+  uint32_t width;
+  uint32_t height;
+  uint32_t fourcc;
+  uint64_t modifier;
+  uint32_t n_planes;
+  int fds[FL_DMABUF_TEXTURE_MAX_PLANES];
+  uint32_t offsets[FL_DMABUF_TEXTURE_MAX_PLANES];
+  uint32_t strides[FL_DMABUF_TEXTURE_MAX_PLANES];
+  int acquire_fence_fd;
+} FlDmabufTextureFrame;
+
+/**
+ * FlDmabufTexture:
+ *
+ * #FlDmabufTexture is an abstract class that represents a texture whose frames
+ * are Linux dmabufs, such as the buffers decoded by a video pipeline. The
+ * buffers are imported as EGL images and sampled by Flutter without being
+ * copied, which requires Flutter to render with EGL and the
+ * EGL_EXT_image_dma_buf_import extension.
+ *
+ * The buffers must have a format that OpenGL can sample as a GL_TEXTURE_2D,
+ * such as DRM_FORMAT_ABGR8888. Once a new frame is ready, call
+ * fl_texture_registrar_mark_texture_frame_available().
+ *
+ * The following example shows how to implement an #FlDmabufTexture.
+ * ![<!-- language="C" -->
+ *   struct _MyTexture {
+ *     FlDmabufTexture parent_instance;
+ *
+ *     MyBuffer *buffer;  // the last buffer of your pipeline.
+ *   }
+ *
+ *   G_DEFINE_TYPE(MyTexture,
+ *                 my_texture,
+ *                 fl_dmabuf_texture_get_type ())
+ *
+ *   static gboolean
+ *   my_texture_acquire_frame (FlDmabufTexture* texture,
+ *                             FlDmabufTextureFrame* frame,
+ *                             GError** error) {
+ *     // This method is called on the render thread.
+ *     MyBuffer *buffer = take_last_buffer (MY_TEXTURE (texture));
+ *     frame->width = buffer->width;
+ *     frame->height = buffer->height;
+ *     frame->fourcc = DRM_FORMAT_ABGR8888;
+ *     frame->n_planes = 1;
+ *     frame->fds[0] = buffer->fd;
+ *     frame->offsets[0] = 0;
+ *     frame->strides[0] = buffer->stride;
+ *     // Flutter takes the ownership of the fence.
+ *     frame->acquire_fence_fd = dup (buffer->render_done_fd);
+ *     return TRUE;
+ *   }
+ *
+ *   static void
+ *   my_texture_release_frame (FlDmabufTexture* texture,
+ *                             const FlDmabufTextureFrame* frame,
+ *                             int release_fence_fd) {
+ *     // The buffer can be written again once the fence signals.
+ *     return_buffer (MY_TEXTURE (texture), frame->fds[0], release_fence_fd);
+ *   }
+ *
+ *   static void my_texture_class_init(MyTextureClass* klass) {
+ *     FL_DMABUF_TEXTURE_CLASS(klass)->acquire_frame =
+ *         my_texture_acquire_frame;
+ *     FL_DMABUF_TEXTURE_CLASS(klass)->release_frame =
+ *         my_texture_release_frame;
+ *   }
+ *
+ *   static void my_texture_init(MyTexture* self) {}
+ * ]|
+ */
+
+struct _FlDmabufTextureClass {
+  GObjectClass parent_class;
+
+  /**
+   * FlDmabufTexture::acquire_frame:
+   * @texture: an #FlDmabufTexture.
+   * @frame: (out): the frame to show. @width and @height initially contain
+   * the size of the texture in Flutter, @modifier is DRM_FORMAT_MOD_INVALID
+   * and @acquire_fence_fd is -1.
+   * @error: (allow-none): #GError location to store the error occurring, or
+   * %NULL to ignore.
+   *
+   * Virtual method called on the render thread when Flutter draws a new frame
+   * of this texture.
+   *
+   * The dmabuf file descriptors remain owned by @texture, and must stay valid
+   * until the frame is released. The ownership of @acquire_fence_fd is
+   * transferred to Flutter.
+   *
+   * Returns: %TRUE on success.
+   */
+  gboolean (*acquire_frame)(FlDmabufTexture* texture,
+                            FlDmabufTextureFrame* frame,
+                            GError** error);
+
+  /**
+   * FlDmabufTexture::release_frame:
+   * @texture: an #FlDmabufTexture.
+   * @frame: a frame returned by acquire_frame.
+   * @release_fence_fd: sync file descriptor that signals once Flutter has
+   * finished reading the buffer, or -1 if it has already finished.
+   *
+   * Virtual method called on the render thread when Flutter no longer shows
+   * @frame, usually after the next frame has been acquired. The ownership of
+   * @release_fence_fd is transferred to @texture.
+   */
+  void (*release_frame)(FlDmabufTexture* texture,
+                        const FlDmabufTextureFrame* frame,
+                        int release_fence_fd);
+};
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_PUBLIC_FLUTTER_LINUX_FL_DMABUF_TEXTURE_H_
@@ -450,6 +450,26 @@ FlutterEngineResult FlutterEngineRunTask(FLUTTER_API_SYMBOL(FlutterEngine)
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEngineOnVsync(FLUTTER_API_SYMBOL(FlutterEngine)
+                                             engine,
+                                         intptr_t baton,
+                                         uint64_t frame_start_time_nanos,
+                                         uint64_t frame_target_time_nanos) {
+  return kSuccess;
+}
+
+uint64_t FlutterEngineGetCurrentTime() {
+  return g_get_monotonic_time() * 1000;
+}
+
+FlutterEngineResult FlutterEngineNotifyDisplayUpdate(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineDisplaysUpdateType update_type,
+    const FlutterEngineDisplay* displays,
+    size_t display_count) {
+  return kSuccess;
+}
+
 bool FlutterEngineRunsAOTCompiledDartCode() {
   return false;
 }
@@ -552,5 +572,8 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   table->UnregisterExternalTexture = &FlutterEngineUnregisterExternalTexture;
   table->UpdateAccessibilityFeatures =
       &FlutterEngineUpdateAccessibilityFeatures;
+  table->OnVsync = &FlutterEngineOnVsync;
+  table->GetCurrentTime = &FlutterEngineGetCurrentTime;
+  table->NotifyDisplayUpdate = &FlutterEngineNotifyDisplayUpdate;
   return kSuccess;
 }
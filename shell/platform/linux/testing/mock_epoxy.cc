@@ -6,6 +6,8 @@
 #include <epoxy/egl.h>
 #include <epoxy/gl.h>
 
+#include <cstring>
+
 typedef struct {
   EGLint config_id;
   EGLint buffer_size;
@@ -45,11 +47,19 @@ typedef struct {
 typedef struct {
 } MockSurface;
 
+typedef struct {
+} MockImage;
+
+typedef struct {
+} MockSync;
+
 static bool display_initialized = false;
 static MockDisplay mock_display;
 static MockConfig mock_config;
 static MockContext mock_context;
 static MockSurface mock_surface;
+static MockImage mock_image;
+static MockSync mock_sync;
 
 static EGLint mock_error = EGL_SUCCESS;
 
@@ -135,6 +145,19 @@ EGLContext _eglCreateContext(EGLDisplay dpy,
   return &mock_context;
 }
 
+EGLImageKHR _eglCreateImageKHR(EGLDisplay dpy,
+                               EGLContext ctx,
+                               EGLenum target,
+                               EGLClientBuffer buffer,
+                               const EGLint* attrib_list) {
+  if (!check_display(dpy) || !check_initialized(dpy)) {
+    return EGL_NO_IMAGE_KHR;
+  }
+
+  mock_error = EGL_SUCCESS;
+  return &mock_image;
+}
+
 EGLSurface _eglCreatePbufferSurface(EGLDisplay dpy,
                                     EGLConfig config,
                                     const EGLint* attrib_list) {
@@ -146,6 +169,17 @@ EGLSurface _eglCreatePbufferSurface(EGLDisplay dpy,
   return &mock_surface;
 }
 
+EGLSyncKHR _eglCreateSyncKHR(EGLDisplay dpy,
+                             EGLenum type,
+                             const EGLint* attrib_list) {
+  if (!check_display(dpy) || !check_initialized(dpy)) {
+    return EGL_NO_SYNC_KHR;
+  }
+
+  mock_error = EGL_SUCCESS;
+  return &mock_sync;
+}
+
 EGLSurface _eglCreateWindowSurface(EGLDisplay dpy,
                                    EGLConfig config,
                                    EGLNativeWindowType win,
@@ -158,6 +192,27 @@ EGLSurface _eglCreateWindowSurface(EGLDisplay dpy,
   return &mock_surface;
 }
 
+EGLBoolean _eglDestroyImageKHR(EGLDisplay dpy, EGLImageKHR image) {
+  if (!check_display(dpy) || !check_initialized(dpy)) {
+    return EGL_FALSE;
+  }
+
+  return bool_success();
+}
+
+EGLBoolean _eglDestroySyncKHR(EGLDisplay dpy, EGLSyncKHR sync) {
+  if (!check_display(dpy) || !check_initialized(dpy)) {
+    return EGL_FALSE;
+  }
+
+  return bool_success();
+}
+
+EGLint _eglDupNativeFenceFDANDROID(EGLDisplay dpy, EGLSyncKHR sync) {
+  mock_error = EGL_SUCCESS;
+  return EGL_NO_NATIVE_FENCE_FD_ANDROID;
+}
+
 EGLBoolean _eglGetConfigAttrib(EGLDisplay dpy,
                                EGLConfig config,
                                EGLint attribute,
@@ -254,6 +309,10 @@ EGLBoolean _eglGetConfigAttrib(EGLDisplay dpy,
   }
 }
 
+EGLDisplay _eglGetCurrentDisplay() {
+  return &mock_display;
+}
+
 EGLDisplay _eglGetDisplay(EGLNativeDisplayType display_id) {
   return &mock_display;
 }
@@ -334,6 +393,14 @@ EGLBoolean _eglSwapBuffers(EGLDisplay dpy, EGLSurface surface) {
   return bool_success();
 }
 
+EGLint _eglWaitSyncKHR(EGLDisplay dpy, EGLSyncKHR sync, EGLint flags) {
+  if (!check_display(dpy) || !check_initialized(dpy)) {
+    return EGL_FALSE;
+  }
+
+  return bool_success();
+}
+
 static void _glBindFramebuffer(GLenum target, GLuint framebuffer) {}
 
 static void _glBindTexture(GLenum target, GLuint texture) {}
@@ -342,6 +409,12 @@ void _glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {}
 
 void _glDeleteTextures(GLsizei n, const GLuint* textures) {}
 
+static void _glEGLImageTargetTexture2DOES(GLenum target, GLeglImageOES image) {}
+
+static void _glFinish() {}
+
+static void _glFlush() {}
+
 static void _glFramebufferTexture2D(GLenum target,
                                     GLenum attachment,
                                     GLenum textarget,
@@ -378,6 +451,11 @@ static GLenum _glGetError() {
   return GL_NO_ERROR;
 }
 
+bool epoxy_has_egl_extension(EGLDisplay dpy, const char* extension) {
+  return strcmp(extension, "EGL_EXT_image_dma_buf_import") == 0 ||
+         strcmp(extension, "EGL_ANDROID_native_fence_sync") == 0;
+}
+
 bool epoxy_has_gl_extension(const char* extension) {
   return false;
 }
@@ -419,17 +497,29 @@ EGLContext (*epoxy_eglCreateContext)(EGLDisplay dpy,
                                      EGLConfig config,
                                      EGLContext share_context,
                                      const EGLint* attrib_list);
+EGLImageKHR (*epoxy_eglCreateImageKHR)(EGLDisplay dpy,
+                                       EGLContext ctx,
+                                       EGLenum target,
+                                       EGLClientBuffer buffer,
+                                       const EGLint* attrib_list);
 EGLSurface (*epoxy_eglCreatePbufferSurface)(EGLDisplay dpy,
                                             EGLConfig config,
                                             const EGLint* attrib_list);
+EGLSyncKHR (*epoxy_eglCreateSyncKHR)(EGLDisplay dpy,
+                                     EGLenum type,
+                                     const EGLint* attrib_list);
 EGLSurface (*epoxy_eglCreateWindowSurface)(EGLDisplay dpy,
                                            EGLConfig config,
                                            EGLNativeWindowType win,
                                            const EGLint* attrib_list);
+EGLBoolean (*epoxy_eglDestroyImageKHR)(EGLDisplay dpy, EGLImageKHR image);
+EGLBoolean (*epoxy_eglDestroySyncKHR)(EGLDisplay dpy, EGLSyncKHR sync);
+EGLint (*epoxy_eglDupNativeFenceFDANDROID)(EGLDisplay dpy, EGLSyncKHR sync);
 EGLBoolean (*epoxy_eglGetConfigAttrib)(EGLDisplay dpy,
                                        EGLConfig config,
                                        EGLint attribute,
                                        EGLint* value);
+EGLDisplay (*epoxy_eglGetCurrentDisplay)();
 EGLDisplay (*epoxy_eglGetDisplay)(EGLNativeDisplayType display_id);
 EGLint (*epoxy_eglGetError)();
 void (*(*epoxy_eglGetProcAddress)(const char* procname))(void);
@@ -439,11 +529,15 @@ EGLBoolean (*epoxy_eglMakeCurrent)(EGLDisplay dpy,
                                    EGLSurface read,
                                    EGLContext ctx);
 EGLBoolean (*epoxy_eglSwapBuffers)(EGLDisplay dpy, EGLSurface surface);
+EGLint (*epoxy_eglWaitSyncKHR)(EGLDisplay dpy, EGLSyncKHR sync, EGLint flags);
 
 void (*epoxy_glBindFramebuffer)(GLenum target, GLuint framebuffer);
 void (*epoxy_glBindTexture)(GLenum target, GLuint texture);
 void (*epoxy_glDeleteFramebuffers)(GLsizei n, const GLuint* framebuffers);
 void (*epoxy_glDeleteTextures)(GLsizei n, const GLuint* textures);
+void (*epoxy_glEGLImageTargetTexture2DOES)(GLenum target, GLeglImageOES image);
+void (*epoxy_glFinish)();
+void (*epoxy_glFlush)();
 void (*epoxy_glFramebufferTexture2D)(GLenum target,
                                      GLenum attachment,
                                      GLenum textarget,
@@ -468,20 +562,30 @@ static void library_init() {
   epoxy_eglBindAPI = _eglBindAPI;
   epoxy_eglChooseConfig = _eglChooseConfig;
   epoxy_eglCreateContext = _eglCreateContext;
+  epoxy_eglCreateImageKHR = _eglCreateImageKHR;
   epoxy_eglCreatePbufferSurface = _eglCreatePbufferSurface;
+  epoxy_eglCreateSyncKHR = _eglCreateSyncKHR;
   epoxy_eglCreateWindowSurface = _eglCreateWindowSurface;
+  epoxy_eglDestroyImageKHR = _eglDestroyImageKHR;
+  epoxy_eglDestroySyncKHR = _eglDestroySyncKHR;
+  epoxy_eglDupNativeFenceFDANDROID = _eglDupNativeFenceFDANDROID;
   epoxy_eglGetConfigAttrib = _eglGetConfigAttrib;
+  epoxy_eglGetCurrentDisplay = _eglGetCurrentDisplay;
   epoxy_eglGetDisplay = _eglGetDisplay;
   epoxy_eglGetError = _eglGetError;
   epoxy_eglGetProcAddress = _eglGetProcAddress;
   epoxy_eglInitialize = _eglInitialize;
   epoxy_eglMakeCurrent = _eglMakeCurrent;
   epoxy_eglSwapBuffers = _eglSwapBuffers;
+  epoxy_eglWaitSyncKHR = _eglWaitSyncKHR;
 
   epoxy_glBindFramebuffer = _glBindFramebuffer;
   epoxy_glBindTexture = _glBindTexture;
   epoxy_glDeleteFramebuffers = _glDeleteFramebuffers;
   epoxy_glDeleteTextures = _glDeleteTextures;
+  epoxy_glEGLImageTargetTexture2DOES = _glEGLImageTargetTexture2DOES;
+  epoxy_glFinish = _glFinish;
+  epoxy_glFlush = _glFlush;
   epoxy_glFramebufferTexture2D = _glFramebufferTexture2D;
   epoxy_glGenFramebuffers = _glGenFramebuffers;
   epoxy_glGenTextures = _glGenTextures;
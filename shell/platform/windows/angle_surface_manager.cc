@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/windows/angle_surface_manager.h"
 
+#include <cstring>
 #include <vector>
 
 #include "flutter/fml/logging.h"
@@ -21,20 +22,33 @@ namespace flutter {
 int AngleSurfaceManager::instance_count_ = 0;
 
 std::unique_ptr<AngleSurfaceManager> AngleSurfaceManager::Create(
-    bool enable_impeller) {
+    bool enable_impeller,
+    bool enable_direct_composition) {
   std::unique_ptr<AngleSurfaceManager> manager;
-  manager.reset(new AngleSurfaceManager(enable_impeller));
+  manager.reset(
+      new AngleSurfaceManager(enable_impeller, enable_direct_composition));
   if (!manager->initialize_succeeded_) {
     return nullptr;
   }
   return std::move(manager);
 }
 
-AngleSurfaceManager::AngleSurfaceManager(bool enable_impeller)
+AngleSurfaceManager::AngleSurfaceManager(bool enable_impeller,
+                                         bool enable_direct_composition)
     : egl_config_(nullptr),
       egl_display_(EGL_NO_DISPLAY),
       egl_context_(EGL_NO_CONTEXT) {
   initialize_succeeded_ = Initialize(enable_impeller);
+  if (initialize_succeeded_ && enable_direct_composition) {
+    const char* extensions = eglQueryString(egl_display_, EGL_EXTENSIONS);
+    use_direct_composition_ =
+        extensions != nullptr &&
+        strstr(extensions, "EGL_ANGLE_direct_composition") != nullptr;
+    if (!use_direct_composition_) {
+      FML_LOG(WARNING) << "DirectComposition is not supported by ANGLE, "
+                          "falling back to window surfaces.";
+    }
+  }
   ++instance_count_;
 }
 
@@ -245,9 +259,34 @@ bool AngleSurfaceManager::CreateSurface(HWND hwnd,
       EGL_FIXED_SIZE_ANGLE, EGL_TRUE, EGL_WIDTH, width,
       EGL_HEIGHT,           height,   EGL_NONE};
 
-  surface = eglCreateWindowSurface(egl_display_, egl_config_,
-                                   static_cast<EGLNativeWindowType>(hwnd),
-                                   surfaceAttributes);
+  if (use_direct_composition_) {
+    // ANGLE puts the swapchain of the surface in a DirectComposition visual
+    // targeting the window and creates it with the flip model.
+    const EGLint direct_composition_surface_attributes[] = {
+        EGL_FIXED_SIZE_ANGLE,
+        EGL_TRUE,
+        EGL_WIDTH,
+        width,
+        EGL_HEIGHT,
+        height,
+        EGL_DIRECT_COMPOSITION_ANGLE,
+        EGL_TRUE,
+        EGL_NONE};
+    surface = eglCreateWindowSurface(egl_display_, egl_config_,
+                                     static_cast<EGLNativeWindowType>(hwnd),
+                                     direct_composition_surface_attributes);
+    if (surface == EGL_NO_SURFACE) {
+      LogEglError(
+          "DirectComposition surface creation failed, falling back to a "
+          "window surface.");
+    }
+  }
+
+  if (surface == EGL_NO_SURFACE) {
+    surface = eglCreateWindowSurface(egl_display_, egl_config_,
+                                     static_cast<EGLNativeWindowType>(hwnd),
+                                     surfaceAttributes);
+  }
   if (surface == EGL_NO_SURFACE) {
     LogEglError("Surface creation failed.");
     return false;
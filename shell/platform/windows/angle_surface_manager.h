@@ -27,7 +27,14 @@ namespace flutter {
 // destroy surfaces
 class AngleSurfaceManager {
  public:
-  static std::unique_ptr<AngleSurfaceManager> Create(bool enable_impeller);
+  // Creates a surface manager. If |enable_direct_composition| is true and
+  // ANGLE supports it, window surfaces are presented through a
+  // DirectComposition visual with a flip-model swapchain rather than through
+  // the window's redirection surface. This saves DWM a copy per frame and lets
+  // the swapchain be promoted to a hardware overlay.
+  static std::unique_ptr<AngleSurfaceManager> Create(
+      bool enable_impeller,
+      bool enable_direct_composition = false);
 
   virtual ~AngleSurfaceManager();
 
@@ -103,7 +110,8 @@ class AngleSurfaceManager {
  protected:
   // Creates a new surface manager retaining reference to the passed-in target
   // for the lifetime of the manager.
-  explicit AngleSurfaceManager(bool enable_impeller);
+  explicit AngleSurfaceManager(bool enable_impeller,
+                               bool enable_direct_composition = false);
 
  private:
   bool Initialize(bool enable_impeller);
@@ -135,6 +143,10 @@ class AngleSurfaceManager {
   // Current render_surface that engine will draw into.
   EGLSurface render_surface_ = EGL_NO_SURFACE;
 
+  // Whether window surfaces are created with DirectComposition, which is
+  // only requested if ANGLE supports it.
+  bool use_direct_composition_ = false;
+
   // Requested dimensions for current surface
   EGLint surface_width_ = 0;
   EGLint surface_height_ = 0;
@@ -13,7 +13,7 @@ ExternalTextureD3d::ExternalTextureD3d(
     FlutterDesktopGpuSurfaceType type,
     const FlutterDesktopGpuSurfaceTextureCallback texture_callback,
     void* user_data,
-    const AngleSurfaceManager* surface_manager,
+    AngleSurfaceManager* surface_manager,
     std::shared_ptr<GlProcTable> gl)
     : type_(type),
       texture_callback_(texture_callback),
@@ -22,10 +22,8 @@ ExternalTextureD3d::ExternalTextureD3d(
       gl_(std::move(gl)) {}
 
 ExternalTextureD3d::~ExternalTextureD3d() {
-  ReleaseImage();
-
-  if (gl_texture_ != 0) {
-    gl_->DeleteTextures(1, &gl_texture_);
+  for (auto& [handle, surface] : surfaces_) {
+    DestroySurface(surface);
   }
 }
 
@@ -35,85 +33,187 @@ bool ExternalTextureD3d::PopulateTexture(size_t width,
   const FlutterDesktopGpuSurfaceDescriptor* descriptor =
       texture_callback_(width, height, user_data_);
 
-  if (!CreateOrUpdateTexture(descriptor)) {
+  void* handle = SAFE_ACCESS(descriptor, handle, nullptr);
+  ImportedSurface* surface = GetOrImportSurface(descriptor);
+
+  auto release_callback = SAFE_ACCESS(descriptor, release_callback, nullptr);
+  if (handle != nullptr && release_callback) {
+    release_callback(SAFE_ACCESS(descriptor, release_context, nullptr));
+  }
+
+  if (surface == nullptr) {
     return false;
   }
 
+  if (handle != current_handle_) {
+    auto current = surfaces_.find(current_handle_);
+    if (AcquireSurface(*surface, descriptor)) {
+      if (current != surfaces_.end()) {
+        ReleaseSurface(current->second);
+      }
+      current_handle_ = handle;
+    } else if (current != surfaces_.end()) {
+      // The producer hasn't finished the new texture yet. Show the previous
+      // one instead of waiting for it.
+      surface = &current->second;
+    } else {
+      return false;
+    }
+  }
+  surface->last_used = ++use_count_;
+
   // Populate the texture object used by the engine.
   opengl_texture->target = GL_TEXTURE_2D;
-  opengl_texture->name = gl_texture_;
+  opengl_texture->name = surface->gl_texture;
   opengl_texture->format = GL_RGBA8_OES;
   opengl_texture->destruction_callback = nullptr;
   opengl_texture->user_data = nullptr;
-  opengl_texture->width = SAFE_ACCESS(descriptor, visible_width, 0);
-  opengl_texture->height = SAFE_ACCESS(descriptor, visible_height, 0);
+  opengl_texture->width = surface->visible_width;
+  opengl_texture->height = surface->visible_height;
 
   return true;
 }
 
-void ExternalTextureD3d::ReleaseImage() {
-  if (egl_surface_ != EGL_NO_SURFACE) {
-    eglReleaseTexImage(surface_manager_->egl_display(), egl_surface_,
-                       EGL_BACK_BUFFER);
-    eglDestroySurface(surface_manager_->egl_display(), egl_surface_);
-    egl_surface_ = EGL_NO_SURFACE;
+ExternalTextureD3d::ImportedSurface* ExternalTextureD3d::GetOrImportSurface(
+    const FlutterDesktopGpuSurfaceDescriptor* descriptor) {
+  void* handle = SAFE_ACCESS(descriptor, handle, nullptr);
+  if (handle == nullptr) {
+    return nullptr;
+  }
+  size_t width = SAFE_ACCESS(descriptor, width, 0);
+  size_t height = SAFE_ACCESS(descriptor, height, 0);
+
+  auto it = surfaces_.find(handle);
+  if (it != surfaces_.end()) {
+    ImportedSurface& surface = it->second;
+    surface.visible_width = SAFE_ACCESS(descriptor, visible_width, 0);
+    surface.visible_height = SAFE_ACCESS(descriptor, visible_height, 0);
+    if (surface.width == width && surface.height == height) {
+      return &surface;
+    }
+    // The handle was reused for another texture.
+    DestroySurface(surface);
+    surfaces_.erase(it);
+    if (handle == current_handle_) {
+      current_handle_ = nullptr;
+    }
+  }
+
+  EvictSurfaces();
+
+  ImportedSurface surface;
+  surface.width = width;
+  surface.height = height;
+  surface.visible_width = SAFE_ACCESS(descriptor, visible_width, 0);
+  surface.visible_height = SAFE_ACCESS(descriptor, visible_height, 0);
+
+  gl_->GenTextures(1, &surface.gl_texture);
+  gl_->BindTexture(GL_TEXTURE_2D, surface.gl_texture);
+  gl_->TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  gl_->TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  gl_->TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  gl_->TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+  EGLint attributes[] = {EGL_WIDTH,
+                         static_cast<EGLint>(width),
+                         EGL_HEIGHT,
+                         static_cast<EGLint>(height),
+                         EGL_TEXTURE_TARGET,
+                         EGL_TEXTURE_2D,
+                         EGL_TEXTURE_FORMAT,
+                         EGL_TEXTURE_RGBA,  // always EGL_TEXTURE_RGBA
+                         EGL_NONE};
+
+  surface.egl_surface = surface_manager_->CreateSurfaceFromHandle(
+      (type_ == kFlutterDesktopGpuSurfaceTypeD3d11Texture2D)
+          ? EGL_D3D_TEXTURE_ANGLE
+          : EGL_D3D_TEXTURE_2D_SHARE_HANDLE_ANGLE,
+      handle, attributes);
+
+  if (surface.egl_surface == EGL_NO_SURFACE ||
+      eglBindTexImage(surface_manager_->egl_display(), surface.egl_surface,
+                      EGL_BACK_BUFFER) == EGL_FALSE) {
+    FML_LOG(ERROR) << "Binding D3D surface failed.";
+    DestroySurface(surface);
+    return nullptr;
+  }
+
+  if (SAFE_ACCESS(descriptor, use_keyed_mutex, false)) {
+    // The keyed mutex must be acquired on ANGLE's device.
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
+    if (type_ == kFlutterDesktopGpuSurfaceTypeD3d11Texture2D) {
+      texture = static_cast<ID3D11Texture2D*>(handle);
+    } else {
+      ID3D11Device* device = nullptr;
+      if (surface_manager_->GetDevice(&device)) {
+        device->OpenSharedResource(handle, IID_PPV_ARGS(&texture));
+      }
+    }
+    if (!texture || FAILED(texture.As(&surface.keyed_mutex))) {
+      FML_LOG(ERROR) << "The D3D texture doesn't have a keyed mutex.";
+    }
   }
+
+  return &surfaces_.emplace(handle, std::move(surface)).first->second;
 }
 
-bool ExternalTextureD3d::CreateOrUpdateTexture(
+bool ExternalTextureD3d::AcquireSurface(
+    ImportedSurface& surface,
     const FlutterDesktopGpuSurfaceDescriptor* descriptor) {
-  if (descriptor == nullptr ||
-      SAFE_ACCESS(descriptor, handle, nullptr) == nullptr) {
-    ReleaseImage();
+  if (!surface.keyed_mutex || surface.keyed_mutex_acquired) {
+    return true;
+  }
+  HRESULT result = surface.keyed_mutex->AcquireSync(
+      SAFE_ACCESS(descriptor, keyed_mutex_acquire_key, 0),
+      /*dwMilliseconds=*/0);
+  if (result != S_OK) {
     return false;
   }
+  surface.keyed_mutex_acquired = true;
+  surface.keyed_mutex_release_key =
+      SAFE_ACCESS(descriptor, keyed_mutex_release_key, 0);
+  return true;
+}
 
-  if (gl_texture_ == 0) {
-    gl_->GenTextures(1, &gl_texture_);
-
-    gl_->BindTexture(GL_TEXTURE_2D, gl_texture_);
-    gl_->TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    gl_->TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    gl_->TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    gl_->TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  } else {
-    gl_->BindTexture(GL_TEXTURE_2D, gl_texture_);
+void ExternalTextureD3d::ReleaseSurface(ImportedSurface& surface) {
+  if (surface.keyed_mutex_acquired) {
+    // The release is ordered after the draws that sampled the texture, which
+    // have been issued to ANGLE's device by now.
+    surface.keyed_mutex->ReleaseSync(surface.keyed_mutex_release_key);
+    surface.keyed_mutex_acquired = false;
   }
+}
 
-  auto handle = SAFE_ACCESS(descriptor, handle, nullptr);
-  if (handle != last_surface_handle_) {
-    ReleaseImage();
-
-    EGLint attributes[] = {
-        EGL_WIDTH,
-        static_cast<EGLint>(SAFE_ACCESS(descriptor, width, 0)),
-        EGL_HEIGHT,
-        static_cast<EGLint>(SAFE_ACCESS(descriptor, height, 0)),
-        EGL_TEXTURE_TARGET,
-        EGL_TEXTURE_2D,
-        EGL_TEXTURE_FORMAT,
-        EGL_TEXTURE_RGBA,  // always EGL_TEXTURE_RGBA
-        EGL_NONE};
-
-    egl_surface_ = surface_manager_->CreateSurfaceFromHandle(
-        (type_ == kFlutterDesktopGpuSurfaceTypeD3d11Texture2D)
-            ? EGL_D3D_TEXTURE_ANGLE
-            : EGL_D3D_TEXTURE_2D_SHARE_HANDLE_ANGLE,
-        handle, attributes);
-
-    if (egl_surface_ == EGL_NO_SURFACE ||
-        eglBindTexImage(surface_manager_->egl_display(), egl_surface_,
-                        EGL_BACK_BUFFER) == EGL_FALSE) {
-      FML_LOG(ERROR) << "Binding D3D surface failed.";
-    }
-    last_surface_handle_ = handle;
+void ExternalTextureD3d::DestroySurface(ImportedSurface& surface) {
+  ReleaseSurface(surface);
+  if (surface.egl_surface != EGL_NO_SURFACE) {
+    eglReleaseTexImage(surface_manager_->egl_display(), surface.egl_surface,
+                       EGL_BACK_BUFFER);
+    eglDestroySurface(surface_manager_->egl_display(), surface.egl_surface);
+    surface.egl_surface = EGL_NO_SURFACE;
   }
+  if (surface.gl_texture != 0) {
+    gl_->DeleteTextures(1, &surface.gl_texture);
+    surface.gl_texture = 0;
+  }
+}
 
-  auto release_callback = SAFE_ACCESS(descriptor, release_callback, nullptr);
-  if (release_callback) {
-    release_callback(SAFE_ACCESS(descriptor, release_context, nullptr));
+void ExternalTextureD3d::EvictSurfaces() {
+  while (surfaces_.size() >= kMaxImportedSurfaces) {
+    auto oldest = surfaces_.end();
+    for (auto it = surfaces_.begin(); it != surfaces_.end(); ++it) {
+      if (it->first != current_handle_ &&
+          (oldest == surfaces_.end() ||
+           it->second.last_used < oldest->second.last_used)) {
+        oldest = it;
+      }
+    }
+    if (oldest == surfaces_.end()) {
+      return;
+    }
+    DestroySurface(oldest->second);
+    surfaces_.erase(oldest);
   }
-  return egl_surface_ != EGL_NO_SURFACE;
 }
 
 }  // namespace flutter
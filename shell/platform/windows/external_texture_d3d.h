@@ -5,7 +5,10 @@
 #ifndef FLUTTER_SHELL_PLATFORM_WINDOWS_EXTERNAL_TEXTURE_D3D_H_
 #define FLUTTER_SHELL_PLATFORM_WINDOWS_EXTERNAL_TEXTURE_D3D_H_
 
+#include <dxgi.h>
+#include <wrl/client.h>
 #include <memory>
+#include <unordered_map>
 
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/windows/angle_surface_manager.h"
@@ -15,13 +18,22 @@
 namespace flutter {
 
 // An external texture that is backed by a DXGI surface.
+//
+// The surfaces of the textures provided by the producer are imported once and
+// cached by handle, so that a producer that rotates through a pool of
+// textures doesn't cause surfaces to be recreated on every frame.
+//
+// If the producer requests it, access to the textures is synchronized with
+// their |IDXGIKeyedMutex| without blocking the raster thread: a texture is
+// only shown once its mutex can be acquired immediately, and the previous
+// texture is shown until then.
 class ExternalTextureD3d : public ExternalTexture {
  public:
   ExternalTextureD3d(
       FlutterDesktopGpuSurfaceType type,
       const FlutterDesktopGpuSurfaceTextureCallback texture_callback,
       void* user_data,
-      const AngleSurfaceManager* surface_manager,
+      AngleSurfaceManager* surface_manager,
       std::shared_ptr<GlProcTable> gl);
   virtual ~ExternalTextureD3d();
 
@@ -31,21 +43,56 @@ class ExternalTextureD3d : public ExternalTexture {
                        FlutterOpenGLTexture* opengl_texture) override;
 
  private:
-  // Creates or updates the backing texture and associates it with the provided
-  // surface.
-  bool CreateOrUpdateTexture(
+  // The maximum number of imported surfaces that are cached.
+  static constexpr size_t kMaxImportedSurfaces = 8;
+
+  // A surface imported from a texture of the producer, bound to its own GL
+  // texture.
+  struct ImportedSurface {
+    EGLSurface egl_surface = EGL_NO_SURFACE;
+    GLuint gl_texture = 0;
+    size_t width = 0;
+    size_t height = 0;
+    size_t visible_width = 0;
+    size_t visible_height = 0;
+    // The keyed mutex of the texture, if access to it is synchronized.
+    Microsoft::WRL::ComPtr<IDXGIKeyedMutex> keyed_mutex;
+    // Whether the keyed mutex is held, and the key it is released with.
+    bool keyed_mutex_acquired = false;
+    uint64_t keyed_mutex_release_key = 0;
+    // The last time the surface was shown, to evict the least recently used
+    // surface.
+    uint64_t last_used = 0;
+  };
+
+  // Returns the imported surface of the texture of |descriptor|, importing it
+  // if needed. Returns null if the texture can't be imported.
+  ImportedSurface* GetOrImportSurface(
       const FlutterDesktopGpuSurfaceDescriptor* descriptor);
-  // Detaches the previously attached surface, if any.
-  void ReleaseImage();
+
+  // Acquires the keyed mutex of |surface|, if any, without waiting.
+  bool AcquireSurface(ImportedSurface& surface,
+                      const FlutterDesktopGpuSurfaceDescriptor* descriptor);
+
+  // Releases the keyed mutex of |surface|, if it is held.
+  void ReleaseSurface(ImportedSurface& surface);
+
+  // Releases and destroys |surface|.
+  void DestroySurface(ImportedSurface& surface);
+
+  // Destroys the least recently used surfaces until another one can be
+  // imported.
+  void EvictSurfaces();
 
   FlutterDesktopGpuSurfaceType type_;
   const FlutterDesktopGpuSurfaceTextureCallback texture_callback_;
   void* const user_data_;
-  const AngleSurfaceManager* surface_manager_;
+  AngleSurfaceManager* surface_manager_;
   std::shared_ptr<GlProcTable> gl_;
-  GLuint gl_texture_ = 0;
-  EGLSurface egl_surface_ = EGL_NO_SURFACE;
-  void* last_surface_handle_ = nullptr;
+  std::unordered_map<void*, ImportedSurface> surfaces_;
+  // The handle of the surface that is shown.
+  void* current_handle_ = nullptr;
+  uint64_t use_count_ = 0;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ExternalTextureD3d);
 };
@@ -120,7 +120,8 @@ FlutterWindow::FlutterWindow(
     int width,
     int height,
     std::shared_ptr<WindowsProcTable> windows_proc_table,
-    std::unique_ptr<TextInputManager> text_input_manager)
+    std::unique_ptr<TextInputManager> text_input_manager,
+    bool pipeline_key_events)
     : binding_handler_delegate_(nullptr),
       touch_id_generator_(kMinTouchDeviceId, kMaxTouchDeviceId),
       windows_proc_table_(std::move(windows_proc_table)),
@@ -142,7 +143,8 @@ FlutterWindow::FlutterWindow(
   if (text_input_manager_ == nullptr) {
     text_input_manager_ = std::make_unique<TextInputManager>();
   }
-  keyboard_manager_ = std::make_unique<KeyboardManager>(this);
+  keyboard_manager_ =
+      std::make_unique<KeyboardManager>(this, pipeline_key_events);
 
   InitializeChild("FLUTTERVIEW", width, height);
   current_cursor_ = ::LoadCursor(nullptr, IDC_ARROW);
@@ -36,10 +36,13 @@ class FlutterWindow : public KeyboardManager::WindowDelegate,
                       public WindowBindingHandler {
  public:
   // Create flutter Window for use as child window
+  //
+  // See |KeyboardManager| for |pipeline_key_events|.
   FlutterWindow(int width,
                 int height,
                 std::shared_ptr<WindowsProcTable> windows_proc_table = nullptr,
-                std::unique_ptr<TextInputManager> text_input_manager = nullptr);
+                std::unique_ptr<TextInputManager> text_input_manager = nullptr,
+                bool pipeline_key_events = false);
 
   virtual ~FlutterWindow();
 
@@ -79,7 +79,8 @@ FlutterDesktopViewControllerRef FlutterDesktopViewControllerCreate(
   flutter::FlutterWindowsEngine* engine_ptr = EngineFromHandle(engine_ref);
   std::unique_ptr<flutter::WindowBindingHandler> window_wrapper =
       std::make_unique<flutter::FlutterWindow>(
-          width, height, engine_ptr->windows_proc_table());
+          width, height, engine_ptr->windows_proc_table(),
+          /*text_input_manager=*/nullptr, engine_ptr->pipeline_key_events());
 
   auto engine = std::unique_ptr<flutter::FlutterWindowsEngine>(engine_ptr);
   auto view = std::make_unique<flutter::FlutterWindowsView>(
@@ -199,8 +199,14 @@ FlutterWindowsEngine::FlutterWindowsEngine(
   auto& switches = project_->GetSwitches();
   enable_impeller_ = std::find(switches.begin(), switches.end(),
                                "--enable-impeller=true") != switches.end();
-
-  surface_manager_ = AngleSurfaceManager::Create(enable_impeller_);
+  pipeline_key_events_ = std::find(switches.begin(), switches.end(),
+                                   "--pipeline-key-events") != switches.end();
+  bool enable_direct_composition =
+      std::find(switches.begin(), switches.end(),
+                "--enable-direct-composition") != switches.end();
+
+  surface_manager_ = AngleSurfaceManager::Create(enable_impeller_,
+                                                 enable_direct_composition);
   window_proc_delegate_manager_ = std::make_unique<WindowProcDelegateManager>();
   window_proc_delegate_manager_->RegisterTopLevelWindowProcDelegate(
       [](HWND hwnd, UINT msg, WPARAM wpar, LPARAM lpar, void* user_data,
@@ -448,18 +454,7 @@ bool FlutterWindowsEngine::Run(std::string_view entrypoint) {
     return false;
   }
 
-  // Configure device frame rate displayed via devtools.
-  FlutterEngineDisplay display = {};
-  display.struct_size = sizeof(FlutterEngineDisplay);
-  display.display_id = 0;
-  display.single_display = true;
-  display.refresh_rate =
-      1.0 / (static_cast<double>(FrameInterval().count()) / 1000000000.0);
-
-  std::vector<FlutterEngineDisplay> displays = {display};
-  embedder_api_.NotifyDisplayUpdate(engine_,
-                                    kFlutterEngineDisplaysUpdateTypeStartup,
-                                    displays.data(), displays.size());
+  UpdateDisplayRefreshRate();
 
   SendSystemLocales();
   SetLifecycleState(flutter::AppLifecycleState::kResumed);
@@ -492,7 +487,7 @@ void FlutterWindowsEngine::OnVsync(intptr_t baton) {
   std::chrono::nanoseconds current_time =
       std::chrono::nanoseconds(embedder_api_.GetCurrentTime());
   std::chrono::nanoseconds frame_interval = FrameInterval();
-  auto next = SnapToNextTick(current_time, start_time_, frame_interval);
+  auto next = SnapToNextTick(current_time, VsyncPhase(), frame_interval);
   embedder_api_.OnVsync(engine_, baton, next.count(),
                         (next + frame_interval).count());
 }
@@ -516,6 +511,46 @@ std::chrono::nanoseconds FlutterWindowsEngine::FrameInterval() {
   return std::chrono::nanoseconds(interval);
 }
 
+std::chrono::nanoseconds FlutterWindowsEngine::VsyncPhase() {
+  // Keep the frames aligned to the start time when the frame interval is
+  // overridden so that they are predictable.
+  if (frame_interval_override_.has_value()) {
+    return start_time_;
+  }
+
+  DWM_TIMING_INFO timing_info = {};
+  timing_info.cbSize = sizeof(timing_info);
+  LARGE_INTEGER frequency = {};
+  if (DwmGetCompositionTimingInfo(NULL, &timing_info) != S_OK ||
+      timing_info.qpcVBlank == 0 || !QueryPerformanceFrequency(&frequency) ||
+      frequency.QuadPart <= 0) {
+    return start_time_;
+  }
+
+  // The engine's clock counts the performance counter's ticks too.
+  const uint64_t ticks = timing_info.qpcVBlank;
+  const uint64_t ticks_per_second = frequency.QuadPart;
+  constexpr uint64_t kNanosecondsPerSecond = 1000000000;
+  return std::chrono::nanoseconds(
+      ticks / ticks_per_second * kNanosecondsPerSecond +
+      ticks % ticks_per_second * kNanosecondsPerSecond / ticks_per_second);
+}
+
+void FlutterWindowsEngine::UpdateDisplayRefreshRate() {
+  // Configure device frame rate displayed via devtools.
+  FlutterEngineDisplay display = {};
+  display.struct_size = sizeof(FlutterEngineDisplay);
+  display.display_id = 0;
+  display.single_display = true;
+  display.refresh_rate =
+      1.0 / (static_cast<double>(FrameInterval().count()) / 1000000000.0);
+
+  std::vector<FlutterEngineDisplay> displays = {display};
+  embedder_api_.NotifyDisplayUpdate(engine_,
+                                    kFlutterEngineDisplaysUpdateTypeStartup,
+                                    displays.data(), displays.size());
+}
+
 // Returns the currently configured Plugin Registrar.
 FlutterDesktopPluginRegistrarRef FlutterWindowsEngine::GetRegistrar() {
   return plugin_registrar_.get();
@@ -827,6 +862,8 @@ void FlutterWindowsEngine::OnQuit(std::optional<HWND> hwnd,
 
 void FlutterWindowsEngine::OnDwmCompositionChanged() {
   view_->OnDwmCompositionChanged();
+  // The refresh rate may have changed with the composition.
+  UpdateDisplayRefreshRate();
 }
 
 void FlutterWindowsEngine::OnWindowStateEvent(HWND hwnd,
@@ -229,6 +229,10 @@ class FlutterWindowsEngine {
   // Returns true if the high contrast feature is enabled.
   bool high_contrast_enabled() const { return high_contrast_enabled_; }
 
+  // Returns true if the views of this engine should send key events to the
+  // framework without waiting for the responses to the previous ones.
+  bool pipeline_key_events() const { return pipeline_key_events_; }
+
   // Register a root isolate create callback.
   //
   // The root isolate create callback is invoked at creation of the root Dart
@@ -399,6 +403,12 @@ class FlutterWindowsEngine {
   // The approximate time between vblank events.
   std::chrono::nanoseconds FrameInterval();
 
+  // The time of a recent vblank event, which the frames are aligned to.
+  std::chrono::nanoseconds VsyncPhase();
+
+  // Reports the refresh rate of the display to the engine.
+  void UpdateDisplayRefreshRate();
+
   // The start time used to align frames.
   std::chrono::nanoseconds start_time_ = std::chrono::nanoseconds::zero();
 
@@ -412,6 +422,8 @@ class FlutterWindowsEngine {
 
   bool enable_impeller_ = false;
 
+  bool pipeline_key_events_ = false;
+
   // The manager for WindowProc delegate registration and callbacks.
   std::unique_ptr<WindowProcDelegateManager> window_proc_delegate_manager_;
 
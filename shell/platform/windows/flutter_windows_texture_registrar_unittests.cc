@@ -319,6 +319,63 @@ TEST(FlutterWindowsTextureRegistrarTest, PopulateD3dTexture) {
   EXPECT_TRUE(release_callback_called);
 }
 
+TEST(FlutterWindowsTextureRegistrarTest, PopulateD3dTextureReusesSurfaces) {
+  std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
+  std::shared_ptr<MockGlProcTable> gl = std::make_shared<MockGlProcTable>();
+  FlutterWindowsTextureRegistrar registrar(engine.get(), gl);
+
+  UINT width = 100;
+  UINT height = 100;
+  ComPtr<ID3D11Texture2D> d3d_textures[] = {
+      CreateD3dTexture(engine.get(), width, height),
+      CreateD3dTexture(engine.get(), width, height)};
+  EXPECT_TRUE(d3d_textures[0]);
+  EXPECT_TRUE(d3d_textures[1]);
+
+  FlutterDesktopGpuSurfaceDescriptor surface_descriptor = {};
+  surface_descriptor.struct_size = sizeof(FlutterDesktopGpuSurfaceDescriptor);
+  surface_descriptor.width = surface_descriptor.visible_width = width;
+  surface_descriptor.height = surface_descriptor.visible_height = height;
+
+  FlutterDesktopTextureInfo texture_info = {};
+  texture_info.type = kFlutterDesktopGpuSurfaceTexture;
+  texture_info.gpu_surface_config.struct_size =
+      sizeof(FlutterDesktopGpuSurfaceTextureConfig);
+  texture_info.gpu_surface_config.type =
+      kFlutterDesktopGpuSurfaceTypeD3d11Texture2D;
+  texture_info.gpu_surface_config.user_data = &surface_descriptor;
+  texture_info.gpu_surface_config.callback =
+      [](size_t width, size_t height,
+         void* user_data) -> const FlutterDesktopGpuSurfaceDescriptor* {
+    return reinterpret_cast<const FlutterDesktopGpuSurfaceDescriptor*>(
+        user_data);
+  };
+
+  auto texture_id = registrar.RegisterTexture(&texture_info);
+  EXPECT_NE(texture_id, -1);
+
+  // Each texture of the producer is imported once, and its surface is reused
+  // when the producer flips back to it.
+  GLuint next_name = 1;
+  EXPECT_CALL(*gl.get(), GenTextures(1, _))
+      .Times(2)
+      .WillRepeatedly(
+          [&next_name](GLsizei n, GLuint* textures) {
+            textures[0] = next_name++;
+          });
+  EXPECT_CALL(*gl.get(), BindTexture).Times(2);
+  EXPECT_CALL(*gl.get(), TexParameteri).Times(AtLeast(1));
+  EXPECT_CALL(*gl.get(), DeleteTextures(1, _)).Times(2);
+
+  for (int frame = 0; frame < 4; frame++) {
+    surface_descriptor.handle = d3d_textures[frame % 2].Get();
+    FlutterOpenGLTexture flutter_texture = {};
+    EXPECT_TRUE(
+        registrar.PopulateTexture(texture_id, 640, 480, &flutter_texture));
+    EXPECT_EQ(flutter_texture.name, static_cast<GLuint>(frame % 2 + 1));
+  }
+}
+
 TEST(FlutterWindowsTextureRegistrarTest, PopulateInvalidTexture) {
   std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
   std::shared_ptr<MockGlProcTable> gl = std::make_shared<MockGlProcTable>();
@@ -6,6 +6,7 @@
 #include <string>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/shell/platform/windows/keyboard_manager.h"
 #include "flutter/shell/platform/windows/keyboard_utils.h"
 
@@ -100,11 +101,13 @@ bool IsSysAction(UINT action) {
 
 }  // namespace
 
-KeyboardManager::KeyboardManager(WindowDelegate* delegate)
+KeyboardManager::KeyboardManager(WindowDelegate* delegate,
+                                 bool pipeline_events)
     : window_delegate_(delegate),
       last_key_is_ctrl_left_down(false),
       should_synthesize_ctrl_left_up(false),
-      processing_event_(false) {}
+      processing_event_(false),
+      pipeline_events_(pipeline_events) {}
 
 void KeyboardManager::RedispatchEvent(std::unique_ptr<PendingEvent> event) {
   for (const Win32Message& message : event->session) {
@@ -212,8 +215,7 @@ bool KeyboardManager::HandleMessage(UINT const action,
             .session = std::move(current_session_),
         });
 
-        pending_events_.push_back(std::move(event));
-        ProcessNextEvent();
+        EnqueueEvent(std::move(event));
 
         // SYS messages must not be consumed by `HandleMessage` so that they are
         // forwarded to the system.
@@ -233,8 +235,7 @@ bool KeyboardManager::HandleMessage(UINT const action,
             .character = code_point,
             .session = std::move(current_session_),
         });
-        pending_events_.push_back(std::move(event));
-        ProcessNextEvent();
+        EnqueueEvent(std::move(event));
       }
       return true;
     }
@@ -313,8 +314,7 @@ bool KeyboardManager::HandleMessage(UINT const action,
           .was_down = was_down,
           .session = std::move(current_session_),
       });
-      pending_events_.push_back(std::move(event));
-      ProcessNextEvent();
+      EnqueueEvent(std::move(event));
       // SYS messages must not be consumed by `HandleMessage` so that they are
       // forwarded to the system.
       return !IsSysAction(action);
@@ -326,6 +326,18 @@ bool KeyboardManager::HandleMessage(UINT const action,
   return false;
 }
 
+void KeyboardManager::EnqueueEvent(std::unique_ptr<PendingEvent> event) {
+  event->trace_id = fml::tracing::TraceNonce();
+  TRACE_EVENT_ASYNC_BEGIN0("flutter", "KeyboardManager::Event",
+                           event->trace_id);
+  pending_events_.push_back(std::move(event));
+  if (pipeline_events_) {
+    ProcessPendingEventsPipelined();
+  } else {
+    ProcessNextEvent();
+  }
+}
+
 void KeyboardManager::ProcessNextEvent() {
   if (processing_event_ || pending_events_.empty()) {
     return;
@@ -340,12 +352,64 @@ void KeyboardManager::ProcessNextEvent() {
   });
 }
 
+void KeyboardManager::ProcessPendingEventsPipelined() {
+  while (!pending_events_.empty()) {
+    auto in_flight = std::make_unique<InFlightEvent>();
+    in_flight->event = std::move(pending_events_.front());
+    pending_events_.pop_front();
+    InFlightEvent* in_flight_p = in_flight.get();
+    in_flight_events_.push_back(std::move(in_flight));
+
+    // PendingEvent::action being WM_CHAR means this is a char message without
+    // a preceding key message, which only waits for the events before it.
+    if (in_flight_p->event->action == WM_CHAR) {
+      in_flight_p->responded = true;
+      CompleteInFlightEvents();
+      continue;
+    }
+
+    // The in-flight event outlives the callback, as it is only removed from
+    // |in_flight_events_| once it has been responded to.
+    const PendingEvent& event = *in_flight_p->event;
+    window_delegate_->OnKey(event.key, event.scancode, event.action,
+                            event.character, event.extended, event.was_down,
+                            [this, in_flight_p](bool handled) {
+                              in_flight_p->responded = true;
+                              in_flight_p->framework_handled = handled;
+                              CompleteInFlightEvents();
+                            });
+  }
+}
+
+void KeyboardManager::CompleteInFlightEvents() {
+  if (completing_in_flight_events_) {
+    return;
+  }
+  completing_in_flight_events_ = true;
+  while (!in_flight_events_.empty() && in_flight_events_.front()->responded) {
+    std::unique_ptr<InFlightEvent> in_flight =
+        std::move(in_flight_events_.front());
+    in_flight_events_.pop_front();
+    if (in_flight->event->action == WM_CHAR) {
+      DispatchText(*in_flight->event);
+      TRACE_EVENT_ASYNC_END0("flutter", "KeyboardManager::Event",
+                             in_flight->event->trace_id);
+    } else {
+      HandleOnKeyResult(std::move(in_flight->event),
+                        in_flight->framework_handled);
+    }
+  }
+  completing_in_flight_events_ = false;
+}
+
 void KeyboardManager::PerformProcessEvent(std::unique_ptr<PendingEvent> event,
                                           std::function<void()> callback) {
   // PendingEvent::action being WM_CHAR means this is a char message without
   // a preceding key message, and should be dispatched immediately.
   if (event->action == WM_CHAR) {
     DispatchText(*event);
+    TRACE_EVENT_ASYNC_END0("flutter", "KeyboardManager::Event",
+                           event->trace_id);
     callback();
     return;
   }
@@ -365,6 +429,7 @@ void KeyboardManager::PerformProcessEvent(std::unique_ptr<PendingEvent> event,
 
 void KeyboardManager::HandleOnKeyResult(std::unique_ptr<PendingEvent> event,
                                         bool framework_handled) {
+  TRACE_EVENT_ASYNC_END0("flutter", "KeyboardManager::Event", event->trace_id);
   const UINT last_action = event->session.back().action;
   // SYS messages must not be redispached, and their text content is not
   // dispatched either.
@@ -92,7 +92,13 @@ class KeyboardManager {
 
   using KeyEventCallback = WindowDelegate::KeyEventCallback;
 
-  explicit KeyboardManager(WindowDelegate* delegate);
+  // If |pipeline_events| is true, events are sent to the framework without
+  // waiting for the responses to the events before them. The responses are
+  // still handled in the order of the events, so texts are dispatched and
+  // messages are redispatched in order, but unhandled messages may be
+  // redispatched after the framework has received later events.
+  explicit KeyboardManager(WindowDelegate* delegate,
+                           bool pipeline_events = false);
 
   // Processes Win32 messages related to keyboard and text.
   //
@@ -134,6 +140,10 @@ class KeyboardManager {
     bool was_down;
 
     std::vector<Win32Message> session;
+
+    // Identifies the trace event that spans from the receipt of the event to
+    // the handling of the framework's response.
+    size_t trace_id = 0;
   };
 
   virtual void RedispatchEvent(std::unique_ptr<PendingEvent> event);
@@ -148,6 +158,19 @@ class KeyboardManager {
     bool placeholder = false;
   };
 
+  // An event sent to the framework in the pipelined mode.
+  struct InFlightEvent {
+    std::unique_ptr<PendingEvent> event;
+    // Whether the framework has responded to the event. Events that aren't
+    // sent to the framework, such as text only ones, have no response to wait
+    // for.
+    bool responded = false;
+    bool framework_handled = false;
+  };
+
+  // Adds an event to |pending_events_| and processes it as soon as possible.
+  void EnqueueEvent(std::unique_ptr<PendingEvent> event);
+
   // Resume processing the pending events.
   //
   // If there is at least one pending event and no event is being processed,
@@ -158,6 +181,16 @@ class KeyboardManager {
   // Otherwise, this call is a no-op.
   void ProcessNextEvent();
 
+  // Send all the pending events to the framework, without waiting for the
+  // responses to the previous ones.
+  //
+  // Used instead of |ProcessNextEvent| in the pipelined mode.
+  void ProcessPendingEventsPipelined();
+
+  // Handle the responses of the events at the front of |in_flight_events_|
+  // that have been responded to, stopping at the first one that hasn't.
+  void CompleteInFlightEvents();
+
   // Process an event and call `callback` when it's completed.
   //
   // The `callback` is constructed by |ProcessNextEvent| to start the next
@@ -225,6 +258,18 @@ class KeyboardManager {
   // Whether a message is being processed.
   std::atomic<bool> processing_event_;
 
+  // Whether events are sent to the framework without waiting for the
+  // responses to the previous events.
+  const bool pipeline_events_;
+
+  // The events sent to the framework in the pipelined mode, in the order they
+  // were sent, until their responses are handled.
+  std::deque<std::unique_ptr<InFlightEvent>> in_flight_events_;
+
+  // Whether |CompleteInFlightEvents| is running, as handling a response may
+  // redispatch messages that reenter the keyboard manager.
+  bool completing_in_flight_events_ = false;
+
   // The queue of messages that have been redispatched to the system but have
   // not yet been received for a second time.
   std::deque<Win32Message> pending_redispatches_;
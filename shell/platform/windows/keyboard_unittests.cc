@@ -99,8 +99,9 @@ UINT LayoutFrench(UINT uCode, UINT uMapType) {
 
 class TestKeyboardManager : public KeyboardManager {
  public:
-  explicit TestKeyboardManager(WindowDelegate* delegate)
-      : KeyboardManager(delegate) {}
+  explicit TestKeyboardManager(WindowDelegate* delegate,
+                               bool pipeline_events = false)
+      : KeyboardManager(delegate, pipeline_events) {}
 
   bool DuringRedispatch() { return during_redispatch_; }
 
@@ -185,9 +186,11 @@ class MockKeyboardManagerDelegate : public KeyboardManager::WindowDelegate,
                                     protected MockMessageQueue {
  public:
   MockKeyboardManagerDelegate(WindowBindingHandlerDelegate* view,
-                              MapVirtualKeyToChar map_vk_to_char)
+                              MapVirtualKeyToChar map_vk_to_char,
+                              bool pipeline_events = false)
       : view_(view), map_vk_to_char_(std::move(map_vk_to_char)) {
-    keyboard_manager_ = std::make_unique<TestKeyboardManager>(this);
+    keyboard_manager_ =
+        std::make_unique<TestKeyboardManager>(this, pipeline_events);
   }
   virtual ~MockKeyboardManagerDelegate() {}
 
@@ -358,7 +361,8 @@ class KeyboardTester {
   using ResponseHandler =
       std::function<void(MockKeyResponseController::ResponseCallback)>;
 
-  explicit KeyboardTester(WindowsTestContext& context)
+  explicit KeyboardTester(WindowsTestContext& context,
+                          bool pipeline_events = false)
       : callback_handler_(RespondValue(false)),
         map_virtual_key_layout_(LayoutDefault) {
     engine_ = GetTestEngine(context);
@@ -369,9 +373,11 @@ class KeyboardTester {
         std::make_unique<::testing::NiceMock<MockWindowBindingHandler>>());
     view_->SetEngine(engine_.get());
     window_ = std::make_unique<MockKeyboardManagerDelegate>(
-        view_.get(), [this](UINT virtual_key) -> SHORT {
+        view_.get(),
+        [this](UINT virtual_key) -> SHORT {
           return map_virtual_key_layout_(virtual_key, MAPVK_VK_TO_CHAR);
-        });
+        },
+        pipeline_events);
   }
 
   TestFlutterWindowsView& GetView() { return *view_; }
@@ -2101,6 +2107,60 @@ TEST_F(KeyboardTest, SlowFrameworkResponse) {
   EXPECT_EQ(tester.RedispatchedMessageCountAndClear(), 2);
 }
 
+// In the pipelined mode, events are sent to the framework before the previous
+// ones are responded to, but their responses are still handled in order.
+TEST_F(KeyboardTest, SlowFrameworkResponseWhenPipelined) {
+  KeyboardTester tester{GetContext(), /*pipeline_events=*/true};
+
+  std::vector<MockKeyResponseController::ResponseCallback> recorded_callbacks;
+
+  // Store callbacks to manually call them.
+  tester.LateResponding(
+      [&recorded_callbacks](
+          const FlutterKeyEvent* event,
+          MockKeyResponseController::ResponseCallback callback) {
+        recorded_callbacks.push_back(callback);
+      });
+
+  // Press A
+  tester.InjectKeyboardChanges(std::vector<KeyboardChange>{
+      WmKeyDownInfo{kVirtualKeyA, kScanCodeKeyA, kNotExtended, kWasUp}.Build(
+          kWmResultZero),
+      WmCharInfo{'a', kScanCodeKeyA, kNotExtended, kWasUp}.Build(
+          kWmResultZero)});
+
+  // Hold A
+  tester.InjectKeyboardChanges(std::vector<KeyboardChange>{
+      WmKeyDownInfo{kVirtualKeyA, kScanCodeKeyA, kNotExtended, kWasDown}.Build(
+          kWmResultZero),
+      WmCharInfo{'a', kScanCodeKeyA, kNotExtended, kWasDown}.Build(
+          kWmResultZero)});
+
+  // Both events were sent without waiting for a response.
+  EXPECT_EQ(tester.key_calls.size(), 2);
+  EXPECT_CALL_IS_EVENT(tester.key_calls[0], kFlutterKeyEventTypeDown,
+                       kPhysicalKeyA, kLogicalKeyA, "a", kNotSynthesized);
+  EXPECT_CALL_IS_EVENT(tester.key_calls[1], kFlutterKeyEventTypeRepeat,
+                       kPhysicalKeyA, kLogicalKeyA, "a", kNotSynthesized);
+  EXPECT_EQ(recorded_callbacks.size(), 2);
+  EXPECT_EQ(tester.RedispatchedMessageCountAndClear(), 0);
+
+  // The second response waits for the first one.
+  recorded_callbacks.back()(false);
+
+  EXPECT_EQ(tester.key_calls.size(), 2);
+  EXPECT_EQ(tester.RedispatchedMessageCountAndClear(), 0);
+
+  // The first response completes both events in order.
+  recorded_callbacks.front()(false);
+
+  EXPECT_EQ(tester.key_calls.size(), 4);
+  EXPECT_CALL_IS_TEXT(tester.key_calls[2], u"a");
+  EXPECT_CALL_IS_TEXT(tester.key_calls[3], u"a");
+  tester.clear_key_calls();
+  EXPECT_EQ(tester.RedispatchedMessageCountAndClear(), 4);
+}
+
 // Regression test for https://github.com/flutter/flutter/issues/84210.
 //
 // When the framework response is slow during a sequence of identical messages,
@@ -68,16 +68,15 @@ void TextInputPlugin::TextHook(const std::u16string& text) {
   if (active_model_ == nullptr) {
     return;
   }
-  std::u16string text_before_change =
-      fml::Utf8ToUtf16(active_model_->GetText());
-  TextRange selection_before_change = active_model_->selection();
-  active_model_->AddText(text);
-
   if (enable_delta_model) {
-    TextEditingDelta delta =
-        TextEditingDelta(text_before_change, selection_before_change, text);
+    // Describe the edit before making it rather than keeping a copy of the
+    // text from before the change around.
+    TextEditingDelta delta = TextEditingDelta(
+        active_model_->text_utf16(), active_model_->selection(), text);
+    active_model_->AddText(text);
     SendStateUpdateWithDelta(*active_model_, &delta);
   } else {
+    active_model_->AddText(text);
     SendStateUpdate(*active_model_);
   }
 }
@@ -128,9 +127,7 @@ void TextInputPlugin::ComposeBeginHook() {
   }
   active_model_->BeginComposing();
   if (enable_delta_model) {
-    std::string text = active_model_->GetText();
-    TextRange selection = active_model_->selection();
-    TextEditingDelta delta = TextEditingDelta(text);
+    TextEditingDelta delta = TextEditingDelta(active_model_->text_utf16());
     SendStateUpdateWithDelta(*active_model_, &delta);
   } else {
     SendStateUpdate(*active_model_);
@@ -141,11 +138,6 @@ void TextInputPlugin::ComposeCommitHook() {
   if (active_model_ == nullptr) {
     return;
   }
-  std::string text_before_change = active_model_->GetText();
-  TextRange selection_before_change = active_model_->selection();
-  TextRange composing_before_change = active_model_->composing_range();
-  std::string composing_text_before_change = text_before_change.substr(
-      composing_before_change.start(), composing_before_change.length());
   active_model_->CommitComposing();
 
   // We do not trigger SendStateUpdate here.
@@ -176,13 +168,10 @@ void TextInputPlugin::ComposeEndHook() {
   if (active_model_ == nullptr) {
     return;
   }
-  std::string text_before_change = active_model_->GetText();
-  TextRange selection_before_change = active_model_->selection();
   active_model_->CommitComposing();
   active_model_->EndComposing();
   if (enable_delta_model) {
-    std::string text = active_model_->GetText();
-    TextEditingDelta delta = TextEditingDelta(text);
+    TextEditingDelta delta = TextEditingDelta(active_model_->text_utf16());
     SendStateUpdateWithDelta(*active_model_, &delta);
   } else {
     SendStateUpdate(*active_model_);
@@ -194,15 +183,15 @@ void TextInputPlugin::ComposeChangeHook(const std::u16string& text,
   if (active_model_ == nullptr) {
     return;
   }
-  std::string text_before_change = active_model_->GetText();
-  TextRange composing_before_change = active_model_->composing_range();
+  std::unique_ptr<TextEditingDelta> delta;
+  if (enable_delta_model) {
+    delta = std::make_unique<TextEditingDelta>(
+        active_model_->text_utf16(), active_model_->composing_range(), text);
+  }
   active_model_->AddText(text);
   active_model_->UpdateComposingText(text, TextRange(cursor_pos, cursor_pos));
-  std::string text_after_change = active_model_->GetText();
-  if (enable_delta_model) {
-    TextEditingDelta delta = TextEditingDelta(
-        fml::Utf8ToUtf16(text_before_change), composing_before_change, text);
-    SendStateUpdateWithDelta(*active_model_, &delta);
+  if (delta) {
+    SendStateUpdateWithDelta(*active_model_, delta.get());
   } else {
     SendStateUpdate(*active_model_);
   }
@@ -467,14 +456,12 @@ void TextInputPlugin::SendStateUpdateWithDelta(const TextInputModel& model,
 void TextInputPlugin::EnterPressed(TextInputModel* model) {
   if (input_type_ == kMultilineInputType &&
       input_action_ == kInputActionNewline) {
-    std::u16string text_before_change = fml::Utf8ToUtf16(model->GetText());
-    TextRange selection_before_change = model->selection();
-    model->AddText(u"\n");
     if (enable_delta_model) {
-      TextEditingDelta delta(text_before_change, selection_before_change,
-                             u"\n");
+      TextEditingDelta delta(model->text_utf16(), model->selection(), u"\n");
+      model->AddText(u"\n");
       SendStateUpdateWithDelta(*model, &delta);
     } else {
+      model->AddText(u"\n");
       SendStateUpdate(*model);
     }
   }
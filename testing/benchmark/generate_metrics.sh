@@ -16,3 +16,10 @@ $ENGINE_PATH/src/out/host_release/ui_benchmarks --benchmark_format=json > $ENGIN
 $ENGINE_PATH/src/out/host_release/display_list_builder_benchmarks --benchmark_format=json > $ENGINE_PATH/src/out/host_release/display_list_builder_benchmarks.json
 $ENGINE_PATH/src/out/host_release/geometry_benchmarks --benchmark_format=json > $ENGINE_PATH/src/out/host_release/geometry_benchmarks.json
 $ENGINE_PATH/src/out/host_release/canvas_benchmarks --benchmark_format=json > $ENGINE_PATH/src/out/host_release/canvas_benchmarks.json
+$ENGINE_PATH/src/out/host_release/typographer_benchmarks --benchmark_format=json > $ENGINE_PATH/src/out/host_release/typographer_benchmarks.json
+
+# The replay benchmarks replay the frames captured with the
+# --capture-display-lists-path flag into FLUTTER_DL_REPLAY_DIR.
+if [ -n "$FLUTTER_DL_REPLAY_DIR" ]; then
+  $ENGINE_PATH/src/out/host_release/display_list_replay_benchmarks --benchmark_format=json > $ENGINE_PATH/src/out/host_release/display_list_replay_benchmarks.json
+fi
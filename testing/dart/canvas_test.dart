@@ -492,6 +492,52 @@ void main() async {
     expect(data, listEquals(dataSync));
   });
 
+  test('Paints without objects draw like paints whose objects were cleared', () async {
+    Future<ByteData> draw(Paint fill, Paint stroke) async {
+      final PictureRecorder recorder = PictureRecorder();
+      final Canvas canvas = Canvas(recorder);
+      canvas.drawPaint(Paint()..color = const Color(0xFFFFFFFF));
+      // Enough draws with alternating paints to fill the batch of the canvas
+      // several times.
+      for (int i = 0; i < 300; i++) {
+        canvas.drawRect(Rect.fromLTWH((i % 50) * 2, (i ~/ 50) * 2, 2, 2), i.isEven ? fill : stroke);
+      }
+      canvas.save();
+      canvas.clipRect(const Rect.fromLTWH(0, 0, 80, 80));
+      canvas.drawRRect(RRect.fromLTRBR(5, 20, 45, 45, const Radius.circular(6)), stroke);
+      canvas.restore();
+      canvas.drawRect(const Rect.fromLTWH(10, 10, 40, 30), fill);
+      canvas.drawOval(const Rect.fromLTWH(60, 10, 30, 40), stroke);
+      canvas.drawCircle(const Offset(30, 70), 15, fill);
+      canvas.drawArc(const Rect.fromLTWH(60, 60, 30, 30), 0, 2, true, stroke);
+      canvas.drawLine(const Offset(0, 99), const Offset(99, 0), stroke);
+      canvas.drawPath(Path()..addRect(const Rect.fromLTWH(40, 40, 20, 20)), fill);
+      final Image image = await recorder.endRecording().toImage(100, 100);
+      return (await image.toByteData())!;
+    }
+
+    // Setting then clearing a shader leaves the paint with a list of null
+    // objects, which is drawn through handles instead of the batch or leaf
+    // calls of the canvas.
+    Paint withClearedObjects(Paint paint) => paint
+      ..shader = Gradient.linear(Offset.zero, const Offset(1, 1), <Color>[const Color(0xFF000000), const Color(0xFFFFFFFF)])
+      ..shader = null;
+
+    Paint makeFill() => Paint()..color = const Color(0xFF2196F3);
+    Paint makeStroke() => Paint()
+      ..color = const Color(0xA0F44336)
+      ..style = PaintingStyle.stroke
+      ..strokeWidth = 3
+      ..strokeCap = StrokeCap.round;
+
+    final ByteData leafData = await draw(makeFill(), makeStroke());
+    final ByteData handleData = await draw(
+      withClearedObjects(makeFill()),
+      withClearedObjects(makeStroke()),
+    );
+    expect(leafData.buffer.asUint8List(), listEquals(handleData.buffer.asUint8List()));
+  });
+
   test('Canvas.drawParagraph throws when Paragraph.layout was not called', () async {
     // Regression test for https://github.com/flutter/flutter/issues/97172
     bool assertsEnabled = false;
@@ -318,6 +318,39 @@ void main() {
     expect(bottomRight?.writingDirection, TextDirection.ltr);
   });
 
+  test('layoutAll lays out each paragraph with its constraints', () {
+    const double fontSize = 10.0;
+    final List<Paragraph> paragraphs = <Paragraph>[];
+    final List<ParagraphConstraints> constraints = <ParagraphConstraints>[];
+    for (int i = 1; i <= 8; i++) {
+      final ParagraphBuilder builder = ParagraphBuilder(ParagraphStyle(
+        fontFamily: 'FlutterTest',
+        fontSize: fontSize,
+      ));
+      builder.addText('Test ' * i);
+      paragraphs.add(builder.build());
+      constraints.add(ParagraphConstraints(width: fontSize * 5 * i));
+    }
+
+    Paragraph.layoutAll(paragraphs, constraints);
+
+    for (int i = 0; i < paragraphs.length; i++) {
+      final ParagraphBuilder builder = ParagraphBuilder(ParagraphStyle(
+        fontFamily: 'FlutterTest',
+        fontSize: fontSize,
+      ));
+      builder.addText('Test ' * (i + 1));
+      final Paragraph expected = builder.build();
+      expected.layout(constraints[i]);
+
+      expect(paragraphs[i].width, expected.width);
+      expect(paragraphs[i].height, expected.height);
+      expect(paragraphs[i].longestLine, expected.longestLine);
+      expect(paragraphs[i].computeLineMetrics().length,
+          expected.computeLineMetrics().length);
+    }
+  });
+
   test('painting a disposed paragraph does not crash', () {
     final Paragraph paragraph = ParagraphBuilder(ParagraphStyle()).build();
     paragraph.dispose();
@@ -39,6 +39,9 @@ void main() {
             'layerCacheBytes: 0, '
             'pictureCacheCount: 0, '
             'pictureCacheBytes: 0, '
+            'layerCount: 0, '
+            'displayListOpCount: 0, '
+            'offscreenPassCount: 0, '
             'frameNumber: 23)');
   });
 
@@ -54,6 +57,9 @@ void main() {
       layerCacheBytes: 200000,
       pictureCacheCount: 3,
       pictureCacheBytes: 300000,
+      layerCount: 7,
+      displayListOpCount: 120,
+      offscreenPassCount: 2,
       frameNumber: 29,
     );
     expect(timing.toString(),
@@ -65,6 +71,9 @@ void main() {
             'layerCacheBytes: 200000, '
             'pictureCacheCount: 3, '
             'pictureCacheBytes: 300000, '
+            'layerCount: 7, '
+            'displayListOpCount: 120, '
+            'offscreenPassCount: 2, '
             'frameNumber: 29)');
   });
 
@@ -38,7 +38,7 @@ Dart_Handle DartWrappable::CreateDartWrapper(DartState* dart_state) {
   TONIC_DCHECK(!CheckAndHandleError(res));
 
   this->RetainDartWrappableReference();  // Balanced in FinalizeDartWrapper.
-  dart_wrapper_.Set(dart_state, wrapper, this, sizeof(*this),
+  dart_wrapper_.Set(dart_state, wrapper, this, GetAllocationSize(),
                     &FinalizeDartWrapper);
 
   return wrapper;
@@ -59,10 +59,21 @@ void DartWrappable::AssociateWithDartWrapper(Dart_Handle wrapper) {
   this->RetainDartWrappableReference();  // Balanced in FinalizeDartWrapper.
 
   DartState* dart_state = DartState::Current();
-  dart_wrapper_.Set(dart_state, wrapper, this, sizeof(*this),
+  dart_wrapper_.Set(dart_state, wrapper, this, GetAllocationSize(),
                     &FinalizeDartWrapper);
 }
 
+size_t DartWrappable::GetAllocationSize() const {
+  return sizeof(*this);
+}
+
+void DartWrappable::UpdateAllocationSize() {
+  if (dart_wrapper_.is_empty()) {
+    return;
+  }
+  Dart_UpdateExternalSize(dart_wrapper_.value(), GetAllocationSize());
+}
+
 void DartWrappable::ClearDartWrapper() {
   TONIC_DCHECK(!dart_wrapper_.is_empty());
   Dart_Handle wrapper = dart_wrapper_.Get();
@@ -48,6 +48,16 @@ class DartWrappable {
     return dart_wrapper_.value();
   }
 
+  // The bytes retained by this object, including the native resources it
+  // holds on to, that are reported to the Dart GC as the external size of
+  // its wrapper. Subclasses holding large resources should override this and
+  // call UpdateAllocationSize when the resources change while wrapped.
+  virtual size_t GetAllocationSize() const;
+
+  // Reports the current GetAllocationSize to the Dart GC if this object is
+  // wrapped.
+  void UpdateAllocationSize();
+
  protected:
   virtual ~DartWrappable();
 
@@ -17,6 +17,7 @@
 #include "paragraph_builder_skia.h"
 #include "paragraph_skia.h"
 
+#include "flutter/fml/memory/allocation_tag.h"
 #include "third_party/skia/modules/skparagraph/include/ParagraphStyle.h"
 #include "third_party/skia/modules/skparagraph/include/TextStyle.h"
 #include "txt/paragraph_style.h"
@@ -48,20 +49,29 @@ ParagraphBuilderSkia::ParagraphBuilderSkia(
     const ParagraphStyle& style,
     std::shared_ptr<FontCollection> font_collection,
     const bool impeller_enabled)
-    : base_style_(style.GetTextStyle()), impeller_enabled_(impeller_enabled) {
-  builder_ = skt::ParagraphBuilder::make(
-      TxtToSkia(style), font_collection->CreateSktFontCollection());
+    : font_collection_(font_collection),
+      base_style_(style.GetTextStyle()),
+      impeller_enabled_(impeller_enabled) {
+  auto skia_style = TxtToSkia(style);
+  auto skt_collection = font_collection->CreateSktFontCollection();
+  contents_ = std::make_shared<ParagraphContentsSkia>(
+      skia_style, skt_collection,
+      font_collection_->GetParagraphCache()->GetFontGeneration());
+  builder_ = skt::ParagraphBuilder::make(skia_style, skt_collection);
 }
 
 ParagraphBuilderSkia::~ParagraphBuilderSkia() = default;
 
 void ParagraphBuilderSkia::PushStyle(const TextStyle& style) {
-  builder_->pushStyle(TxtToSkia(style));
+  auto skia_style = TxtToSkia(style);
+  builder_->pushStyle(skia_style);
+  contents_->PushStyle(skia_style);
   txt_style_stack_.push(style);
 }
 
 void ParagraphBuilderSkia::Pop() {
   builder_->pop();
+  contents_->Pop();
   txt_style_stack_.pop();
 }
 
@@ -71,6 +81,7 @@ const TextStyle& ParagraphBuilderSkia::PeekStyle() {
 
 void ParagraphBuilderSkia::AddText(const std::u16string& text) {
   builder_->addText(text);
+  contents_->AddText(text);
 }
 
 void ParagraphBuilderSkia::AddPlaceholder(PlaceholderRun& span) {
@@ -83,11 +94,14 @@ void ParagraphBuilderSkia::AddPlaceholder(PlaceholderRun& span) {
       static_cast<skt::PlaceholderAlignment>(span.alignment);
 
   builder_->addPlaceholder(placeholder_style);
+  contents_->AddPlaceholder(placeholder_style);
 }
 
 std::unique_ptr<Paragraph> ParagraphBuilderSkia::Build() {
+  FML_ALLOCATION_TAG(kTxt);
   return std::make_unique<ParagraphSkia>(
-      builder_->Build(), std::move(dl_paints_), impeller_enabled_);
+      builder_->Build(), std::move(dl_paints_), impeller_enabled_,
+      std::move(contents_), font_collection_);
 }
 
 skt::ParagraphPainter::PaintID ParagraphBuilderSkia::CreatePaintID(
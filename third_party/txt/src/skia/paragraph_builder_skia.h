@@ -20,6 +20,7 @@
 #include "txt/paragraph_builder.h"
 
 #include "flutter/display_list/dl_paint.h"
+#include "flutter/third_party/txt/src/skia/paragraph_cache_skia.h"
 #include "third_party/skia/modules/skparagraph/include/ParagraphBuilder.h"
 
 namespace txt {
@@ -51,6 +52,10 @@ class ParagraphBuilderSkia : public ParagraphBuilder {
   skia::textlayout::TextStyle TxtToSkia(const TextStyle& txt);
 
   std::shared_ptr<skia::textlayout::ParagraphBuilder> builder_;
+  // The contents added to the builder, which key the paragraph in the cache of
+  // the font collection.
+  std::shared_ptr<ParagraphContentsSkia> contents_;
+  const std::shared_ptr<FontCollection> font_collection_;
   TextStyle base_style_;
 
   /// @brief      Whether Impeller is enabled in the runtime.
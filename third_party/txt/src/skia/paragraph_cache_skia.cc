@@ -0,0 +1,186 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "paragraph_cache_skia.h"
+
+#include <utility>
+
+#include "flutter/fml/hash_combine.h"
+#include "third_party/skia/modules/skparagraph/include/ParagraphBuilder.h"
+
+namespace skt = skia::textlayout;
+
+namespace txt {
+
+ParagraphContentsSkia::ParagraphContentsSkia(
+    skt::ParagraphStyle style,
+    sk_sp<skt::FontCollection> font_collection,
+    uint64_t font_generation)
+    : style_(std::move(style)),
+      font_collection_(std::move(font_collection)),
+      font_generation_(font_generation) {}
+
+ParagraphContentsSkia::~ParagraphContentsSkia() = default;
+
+void ParagraphContentsSkia::PushStyle(const skt::TextStyle& style) {
+  fml::HashCombineSeed(hash_, static_cast<int>(Op::Type::kPushStyle),
+                       style.getFontSize());
+  ops_.push_back({.type = Op::Type::kPushStyle, .style = style});
+}
+
+void ParagraphContentsSkia::Pop() {
+  fml::HashCombineSeed(hash_, static_cast<int>(Op::Type::kPop));
+  ops_.push_back({.type = Op::Type::kPop});
+}
+
+void ParagraphContentsSkia::AddText(const std::u16string& text) {
+  fml::HashCombineSeed(hash_, static_cast<int>(Op::Type::kAddText), text);
+  text_length_ += text.length();
+  ops_.push_back({.type = Op::Type::kAddText, .text = text});
+}
+
+void ParagraphContentsSkia::AddPlaceholder(
+    const skt::PlaceholderStyle& style) {
+  fml::HashCombineSeed(hash_, static_cast<int>(Op::Type::kAddPlaceholder),
+                       style.fWidth, style.fHeight);
+  // The builder adds an object replacement character for the placeholder.
+  text_length_ += 1;
+  ops_.push_back({.type = Op::Type::kAddPlaceholder, .placeholder = style});
+}
+
+std::unique_ptr<skt::Paragraph> ParagraphContentsSkia::Build() const {
+  return Build(font_collection_);
+}
+
+std::unique_ptr<skt::Paragraph> ParagraphContentsSkia::Build(
+    sk_sp<skt::FontCollection> font_collection) const {
+  auto builder =
+      skt::ParagraphBuilder::make(style_, std::move(font_collection));
+  for (const auto& op : ops_) {
+    switch (op.type) {
+      case Op::Type::kPushStyle:
+        builder->pushStyle(op.style);
+        break;
+      case Op::Type::kPop:
+        builder->pop();
+        break;
+      case Op::Type::kAddText:
+        builder->addText(op.text);
+        break;
+      case Op::Type::kAddPlaceholder:
+        builder->addPlaceholder(op.placeholder);
+        break;
+    }
+  }
+  return builder->Build();
+}
+
+bool ParagraphContentsSkia::Op::operator==(const Op& other) const {
+  if (type != other.type) {
+    return false;
+  }
+  switch (type) {
+    case Type::kPushStyle:
+      return style.equals(other.style);
+    case Type::kPop:
+      return true;
+    case Type::kAddText:
+      return text == other.text;
+    case Type::kAddPlaceholder:
+      return placeholder.equals(other.placeholder);
+  }
+  return false;
+}
+
+bool ParagraphContentsSkia::operator==(
+    const ParagraphContentsSkia& other) const {
+  // The paragraph style is compared field by field, since not all of the
+  // fields set by |ParagraphBuilderSkia| take part in its equality.
+  return hash_ == other.hash_ && font_generation_ == other.font_generation_ &&
+         font_collection_ == other.font_collection_ &&
+         style_.getTextStyle().equals(other.style_.getTextStyle()) &&
+         style_.getStrutStyle() == other.style_.getStrutStyle() &&
+         style_.getTextAlign() == other.style_.getTextAlign() &&
+         style_.getTextDirection() == other.style_.getTextDirection() &&
+         style_.getMaxLines() == other.style_.getMaxLines() &&
+         style_.getEllipsisUtf16() == other.style_.getEllipsisUtf16() &&
+         style_.getTextHeightBehavior() ==
+             other.style_.getTextHeightBehavior() &&
+         style_.getApplyRoundingHack() == other.style_.getApplyRoundingHack() &&
+         ops_ == other.ops_;
+}
+
+size_t ParagraphCacheSkia::KeyHash::operator()(const Key& key) const {
+  return fml::HashCombine(key.contents->GetHash(), key.width);
+}
+
+ParagraphCacheSkia::ParagraphCacheSkia(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+ParagraphCacheSkia::~ParagraphCacheSkia() = default;
+
+std::shared_ptr<skt::Paragraph> ParagraphCacheSkia::Get(
+    const ParagraphContentsSkia& contents,
+    double width) {
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(Key{&contents, width});
+  if (found == index_.end()) {
+    return nullptr;
+  }
+  entries_.splice(entries_.end(), entries_, found->second);
+  return found->second->paragraph;
+}
+
+bool ParagraphCacheSkia::Put(
+    std::shared_ptr<const ParagraphContentsSkia> contents,
+    double width,
+    std::shared_ptr<skt::Paragraph> paragraph) {
+  const size_t bytes =
+      sizeof(Entry) + contents->GetTextLength() * kEstimatedBytesPerCodeUnit;
+  std::scoped_lock lock(mutex_);
+  if (contents->GetFontGeneration() != font_generation_ ||
+      bytes > max_bytes_ || index_.count(Key{contents.get(), width}) > 0) {
+    return false;
+  }
+  const ParagraphContentsSkia* key_contents = contents.get();
+  auto entry = entries_.insert(
+      entries_.end(),
+      {std::move(contents), width, std::move(paragraph), bytes});
+  index_[Key{key_contents, width}] = entry;
+  bytes_ += bytes;
+
+  while (bytes_ > max_bytes_) {
+    const auto& oldest = entries_.front();
+    index_.erase(Key{oldest.contents.get(), oldest.width});
+    bytes_ -= oldest.bytes;
+    // The paragraphs that use the evicted paragraph keep it alive.
+    entries_.pop_front();
+  }
+  return true;
+}
+
+void ParagraphCacheSkia::Clear() {
+  std::scoped_lock lock(mutex_);
+  index_.clear();
+  entries_.clear();
+  bytes_ = 0;
+  font_generation_++;
+}
+
+uint64_t ParagraphCacheSkia::GetFontGeneration() const {
+  std::scoped_lock lock(mutex_);
+  return font_generation_;
+}
+
+size_t ParagraphCacheSkia::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+size_t ParagraphCacheSkia::GetByteSize() const {
+  std::scoped_lock lock(mutex_);
+  return bytes_;
+}
+
+}  // namespace txt
@@ -0,0 +1,168 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LIB_TXT_SRC_PARAGRAPH_CACHE_SKIA_H_
+#define LIB_TXT_SRC_PARAGRAPH_CACHE_SKIA_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/modules/skparagraph/include/FontCollection.h"
+#include "third_party/skia/modules/skparagraph/include/Paragraph.h"
+#include "third_party/skia/modules/skparagraph/include/ParagraphStyle.h"
+#include "third_party/skia/modules/skparagraph/include/TextStyle.h"
+
+namespace txt {
+
+//------------------------------------------------------------------------------
+/// @brief      The text, styles and placeholders of a paragraph built by
+///             |ParagraphBuilderSkia|, in the order they were added, from which
+///             the paragraph can be built again.
+///
+class ParagraphContentsSkia {
+ public:
+  ParagraphContentsSkia(skia::textlayout::ParagraphStyle style,
+                        sk_sp<skia::textlayout::FontCollection> font_collection,
+                        uint64_t font_generation);
+
+  ~ParagraphContentsSkia();
+
+  void PushStyle(const skia::textlayout::TextStyle& style);
+  void Pop();
+  void AddText(const std::u16string& text);
+  void AddPlaceholder(const skia::textlayout::PlaceholderStyle& style);
+
+  /// @brief      Builds a new paragraph of these contents, to be laid out.
+  std::unique_ptr<skia::textlayout::Paragraph> Build() const;
+
+  /// @brief      Builds a new paragraph of these contents with another font
+  ///             collection equivalent to the one they were added with.
+  std::unique_ptr<skia::textlayout::Paragraph> Build(
+      sk_sp<skia::textlayout::FontCollection> font_collection) const;
+
+  /// @brief      The generation of the font collection the paragraph was
+  ///             built with. See |ParagraphCacheSkia::GetFontGeneration|.
+  uint64_t GetFontGeneration() const { return font_generation_; }
+
+  /// @brief      The number of UTF-16 code units of the text.
+  size_t GetTextLength() const { return text_length_; }
+
+  size_t GetHash() const { return hash_; }
+
+  bool operator==(const ParagraphContentsSkia& other) const;
+
+ private:
+  struct Op {
+    enum class Type { kPushStyle, kPop, kAddText, kAddPlaceholder };
+    Type type;
+    skia::textlayout::TextStyle style;
+    std::u16string text;
+    skia::textlayout::PlaceholderStyle placeholder;
+
+    bool operator==(const Op& other) const;
+  };
+
+  const skia::textlayout::ParagraphStyle style_;
+  const sk_sp<skia::textlayout::FontCollection> font_collection_;
+  const uint64_t font_generation_;
+  std::vector<Op> ops_;
+  size_t text_length_ = 0;
+  size_t hash_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ParagraphContentsSkia);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      A cache of laid out paragraphs, keyed by their contents and
+///             the width they were laid out with, so that a paragraph with the
+///             same contents as a recent one reuses its lines without shaping
+///             and breaking the text again.
+///
+///             The cached paragraphs are shared by the |ParagraphSkia| that
+///             use them, and must not be laid out again. The least recently
+///             used paragraphs are evicted once the cache exceeds its byte
+///             budget.
+///
+///             This class is thread-safe.
+///
+class ParagraphCacheSkia {
+ public:
+  /// The default budget of the cached paragraphs.
+  static constexpr size_t kDefaultMaxBytes = 4u * 1024u * 1024u;
+
+  /// A rough estimate of the memory a laid out paragraph keeps for each UTF-16
+  /// code unit of its text, including the shaped runs, the glyph positions
+  /// and the clusters.
+  static constexpr size_t kEstimatedBytesPerCodeUnit = 96u;
+
+  explicit ParagraphCacheSkia(size_t max_bytes = kDefaultMaxBytes);
+
+  ~ParagraphCacheSkia();
+
+  /// @brief      Returns the cached paragraph of `contents` laid out with
+  ///             `width`, or null.
+  std::shared_ptr<skia::textlayout::Paragraph> Get(
+      const ParagraphContentsSkia& contents,
+      double width);
+
+  /// @brief      Caches `paragraph`, which was built from `contents` and laid
+  ///             out with `width`, and returns whether it was cached.
+  ///             Paragraphs built with fonts of a previous generation are not
+  ///             cached.
+  bool Put(std::shared_ptr<const ParagraphContentsSkia> contents,
+           double width,
+           std::shared_ptr<skia::textlayout::Paragraph> paragraph);
+
+  /// @brief      Removes all the paragraphs and starts a new font generation,
+  ///             since the layout of the cached paragraphs may change when the
+  ///             fonts change.
+  void Clear();
+
+  /// @brief      Incremented each time the cache is cleared.
+  uint64_t GetFontGeneration() const;
+
+  size_t GetEntryCount() const;
+
+  size_t GetByteSize() const;
+
+ private:
+  struct Entry {
+    std::shared_ptr<const ParagraphContentsSkia> contents;
+    double width;
+    std::shared_ptr<skia::textlayout::Paragraph> paragraph;
+    size_t bytes;
+  };
+
+  struct Key {
+    const ParagraphContentsSkia* contents;
+    double width;
+
+    bool operator==(const Key& other) const {
+      return width == other.width && *contents == *other.contents;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  const size_t max_bytes_;
+  mutable std::mutex mutex_;
+  uint64_t font_generation_ = 0;
+  size_t bytes_ = 0;
+  // The cached paragraphs, the least recently used first.
+  std::list<Entry> entries_;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ParagraphCacheSkia);
+};
+
+}  // namespace txt
+
+#endif  // LIB_TXT_SRC_PARAGRAPH_CACHE_SKIA_H_
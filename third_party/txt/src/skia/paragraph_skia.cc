@@ -20,6 +20,7 @@
 #include <numeric>
 #include "display_list/dl_paint.h"
 #include "fml/logging.h"
+#include "fml/memory/allocation_tag.h"
 #include "impeller/typographer/backends/skia/text_frame_skia.h"
 #include "include/core/SkMatrix.h"
 
@@ -243,10 +244,17 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
 
 }  // anonymous namespace
 
-ParagraphSkia::ParagraphSkia(std::unique_ptr<skt::Paragraph> paragraph,
-                             std::vector<flutter::DlPaint>&& dl_paints,
-                             bool impeller_enabled)
+ParagraphSkia::ParagraphSkia(
+    std::unique_ptr<skt::Paragraph> paragraph,
+    std::vector<flutter::DlPaint>&& dl_paints,
+    bool impeller_enabled,
+    std::shared_ptr<const ParagraphContentsSkia> contents,
+    std::shared_ptr<FontCollection> font_collection)
     : paragraph_(std::move(paragraph)),
+      contents_(std::move(contents)),
+      font_collection_(contents_ ? std::move(font_collection) : nullptr),
+      cache_(font_collection_ ? font_collection_->GetParagraphCache()
+                              : nullptr),
       dl_paints_(dl_paints),
       impeller_enabled_(impeller_enabled) {}
 
@@ -327,9 +335,49 @@ bool ParagraphSkia::DidExceedMaxLines() {
 }
 
 void ParagraphSkia::Layout(double width) {
+  FML_ALLOCATION_TAG(kTxt);
   line_metrics_.reset();
   line_metrics_styles_.clear();
+  if (!cache_) {
+    paragraph_->layout(width);
+    return;
+  }
+
+  // The cached paragraphs were laid out by other paragraphs with the same
+  // contents, and paint with the paints of this one.
+  if (auto cached = cache_->Get(*contents_, width)) {
+    paragraph_ = std::move(cached);
+    paragraph_is_cached_ = true;
+    return;
+  }
+  if (paragraph_is_cached_) {
+    // The shaping of the runs is still cached by the Skia font collection.
+    paragraph_ = contents_->Build();
+  }
   paragraph_->layout(width);
+  paragraph_is_cached_ = cache_->Put(contents_, width, paragraph_);
+}
+
+std::function<void()> ParagraphSkia::PrepareConcurrentLayout(double width) {
+  if (!cache_) {
+    return nullptr;
+  }
+  line_metrics_.reset();
+  line_metrics_styles_.clear();
+  // The paragraph is built again with a font collection of its own, since the
+  // collection shared by the paragraphs built on the UI thread caches the
+  // fonts and shaped runs it finds without synchronization.
+  return [this, width,
+          collection = font_collection_->MakeSktFontCollection()]() {
+    if (auto cached = cache_->Get(*contents_, width)) {
+      paragraph_ = std::move(cached);
+      paragraph_is_cached_ = true;
+      return;
+    }
+    paragraph_ = contents_->Build(collection);
+    paragraph_->layout(width);
+    paragraph_is_cached_ = cache_->Put(contents_, width, paragraph_);
+  };
 }
 
 bool ParagraphSkia::Paint(DisplayListBuilder* builder, double x, double y) {
@@ -19,8 +19,11 @@
 
 #include <optional>
 
+#include "txt/font_collection.h"
 #include "txt/paragraph.h"
 
+#include "flutter/third_party/txt/src/skia/paragraph_cache_skia.h"
+
 #include "third_party/skia/modules/skparagraph/include/Paragraph.h"
 
 namespace txt {
@@ -28,9 +31,15 @@ namespace txt {
 // Implementation of Paragraph based on Skia's text layout module.
 class ParagraphSkia : public Paragraph {
  public:
-  ParagraphSkia(std::unique_ptr<skia::textlayout::Paragraph> paragraph,
-                std::vector<flutter::DlPaint>&& dl_paints,
-                bool impeller_enabled);
+  // If the |contents| and a font collection are provided, laying out the
+  // paragraph reuses a cached paragraph with the same contents and width, if
+  // any, and the paragraph can be laid out on another thread.
+  ParagraphSkia(
+      std::unique_ptr<skia::textlayout::Paragraph> paragraph,
+      std::vector<flutter::DlPaint>&& dl_paints,
+      bool impeller_enabled,
+      std::shared_ptr<const ParagraphContentsSkia> contents = nullptr,
+      std::shared_ptr<FontCollection> font_collection = nullptr);
 
   virtual ~ParagraphSkia() = default;
 
@@ -62,6 +71,8 @@ class ParagraphSkia : public Paragraph {
 
   void Layout(double width) override;
 
+  std::function<void()> PrepareConcurrentLayout(double width) override;
+
   bool Paint(flutter::DisplayListBuilder* builder, double x, double y) override;
 
   std::vector<TextBox> GetRectsForRange(
@@ -89,7 +100,13 @@ class ParagraphSkia : public Paragraph {
  private:
   TextStyle SkiaToTxt(const skia::textlayout::TextStyle& skia);
 
-  std::unique_ptr<skia::textlayout::Paragraph> paragraph_;
+  std::shared_ptr<skia::textlayout::Paragraph> paragraph_;
+  // Whether |paragraph_| is shared with the cache, in which case it must be
+  // built again before being laid out with another width.
+  bool paragraph_is_cached_ = false;
+  const std::shared_ptr<const ParagraphContentsSkia> contents_;
+  const std::shared_ptr<FontCollection> font_collection_;
+  const std::shared_ptr<ParagraphCacheSkia> cache_;
   std::vector<flutter::DlPaint> dl_paints_;
   std::optional<std::vector<LineMetrics>> line_metrics_;
   std::vector<TextStyle> line_metrics_styles_;
@@ -0,0 +1,148 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "txt/fallback_caching_font_manager.h"
+
+#include <utility>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/core/SkString.h"
+
+namespace txt {
+
+bool FallbackCachingFontManager::Key::operator==(const Key& other) const {
+  return index == other.index && style == other.style &&
+         family == other.family && locales == other.locales;
+}
+
+size_t FallbackCachingFontManager::KeyHash::operator()(const Key& key) const {
+  return fml::HashCombine(key.family, key.style.weight(), key.style.width(),
+                          static_cast<int>(key.style.slant()), key.locales,
+                          key.index);
+}
+
+FallbackCachingFontManager::FallbackCachingFontManager(
+    sk_sp<SkFontMgr> font_manager)
+    : font_manager_(std::move(font_manager)) {
+  FML_DCHECK(font_manager_ != nullptr);
+}
+
+FallbackCachingFontManager::~FallbackCachingFontManager() = default;
+
+size_t FallbackCachingFontManager::GetCachedRangeCount() const {
+  std::scoped_lock lock(mutex_);
+  return typefaces_.size();
+}
+
+void FallbackCachingFontManager::ClearCache() {
+  std::scoped_lock lock(mutex_);
+  typefaces_.clear();
+  misses_.clear();
+}
+
+int FallbackCachingFontManager::onCountFamilies() const {
+  return font_manager_->countFamilies();
+}
+
+void FallbackCachingFontManager::onGetFamilyName(int index,
+                                                 SkString* familyName) const {
+  font_manager_->getFamilyName(index, familyName);
+}
+
+sk_sp<SkFontStyleSet> FallbackCachingFontManager::onCreateStyleSet(
+    int index) const {
+  return font_manager_->createStyleSet(index);
+}
+
+sk_sp<SkFontStyleSet> FallbackCachingFontManager::onMatchFamily(
+    const char familyName[]) const {
+  return font_manager_->matchFamily(familyName);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMatchFamilyStyle(
+    const char familyName[],
+    const SkFontStyle& style) const {
+  return font_manager_->matchFamilyStyle(familyName, style);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMatchFamilyStyleCharacter(
+    const char familyName[],
+    const SkFontStyle& style,
+    const char* bcp47[],
+    int bcp47Count,
+    SkUnichar character) const {
+  Key key{
+      .family = familyName ? familyName : "",
+      .style = style,
+      .index = character / kRangeSize,
+  };
+  for (int i = 0; i < bcp47Count; i++) {
+    key.locales.append(bcp47[i]).push_back(',');
+  }
+  Key miss_key = key;
+  miss_key.index = character;
+
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = typefaces_.find(key);
+    // The typeface found for another character of the range may not have a
+    // glyph for this one.
+    if (found != typefaces_.end() &&
+        found->second->unicharToGlyph(character) != 0) {
+      return found->second;
+    }
+    if (misses_.count(miss_key) > 0) {
+      return nullptr;
+    }
+  }
+
+  auto typeface = font_manager_->matchFamilyStyleCharacter(
+      familyName, style, bcp47, bcp47Count, character);
+
+  std::scoped_lock lock(mutex_);
+  if (typeface) {
+    typefaces_[std::move(key)] = typeface;
+  } else {
+    if (misses_.size() >= kMaxMissCount) {
+      misses_.clear();
+    }
+    misses_.insert(std::move(miss_key));
+  }
+  return typeface;
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMakeFromData(
+    sk_sp<SkData> data,
+    int ttcIndex) const {
+  return font_manager_->makeFromData(std::move(data), ttcIndex);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMakeFromStreamIndex(
+    std::unique_ptr<SkStreamAsset> stream,
+    int ttcIndex) const {
+  return font_manager_->makeFromStream(std::move(stream), ttcIndex);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMakeFromStreamArgs(
+    std::unique_ptr<SkStreamAsset> stream,
+    const SkFontArguments& args) const {
+  return font_manager_->makeFromStream(std::move(stream), args);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMakeFromFile(
+    const char path[],
+    int ttcIndex) const {
+  return font_manager_->makeFromFile(path, ttcIndex);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onLegacyMakeTypeface(
+    const char familyName[],
+    SkFontStyle style) const {
+  return font_manager_->legacyMakeTypeface(familyName, style);
+}
+
+}  // namespace txt
@@ -0,0 +1,128 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LIB_TXT_SRC_FALLBACK_CACHING_FONT_MANAGER_H_
+#define LIB_TXT_SRC_FALLBACK_CACHING_FONT_MANAGER_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkFontMgr.h"
+#include "third_party/skia/include/core/SkFontStyle.h"
+#include "third_party/skia/include/core/SkRefCnt.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace txt {
+
+//------------------------------------------------------------------------------
+/// @brief      A font manager that forwards to another one, and caches the
+///             typefaces it falls back to for the characters missing from the
+///             requested fonts.
+///
+///             Platform font managers scan the families of the system fonts
+///             on each fallback lookup, which is slow on systems with many
+///             fonts. The typeface found for a character is reused for the
+///             other characters of its range of |kRangeSize| code points that
+///             it has glyphs for, such as the rest of a CJK or emoji block.
+///
+///             The cache lives as long as the manager, which the
+///             |FontCollection| replaces whenever its fonts change.
+///
+///             This class is thread-safe.
+///
+class FallbackCachingFontManager : public SkFontMgr {
+ public:
+  /// The number of consecutive code points that share a cached typeface.
+  static constexpr SkUnichar kRangeSize = 128;
+
+  /// The maximum number of characters remembered to have no fallback
+  /// typeface, after which they are forgotten.
+  static constexpr size_t kMaxMissCount = 4096;
+
+  explicit FallbackCachingFontManager(sk_sp<SkFontMgr> font_manager);
+
+  ~FallbackCachingFontManager() override;
+
+  const sk_sp<SkFontMgr>& GetFontManager() const { return font_manager_; }
+
+  /// @brief      The number of ranges of code points with a cached typeface.
+  size_t GetCachedRangeCount() const;
+
+  /// @brief      Forgets the typefaces and misses found so far.
+  void ClearCache();
+
+ private:
+  struct Key {
+    std::string family;
+    SkFontStyle style;
+    std::string locales;
+    // The range of code points for typefaces, or the code point for misses.
+    SkUnichar index;
+
+    bool operator==(const Key& other) const;
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  const sk_sp<SkFontMgr> font_manager_;
+  mutable std::mutex mutex_;
+  mutable std::unordered_map<Key, sk_sp<SkTypeface>, KeyHash> typefaces_;
+  mutable std::unordered_set<Key, KeyHash> misses_;
+
+  // |SkFontMgr|
+  int onCountFamilies() const override;
+
+  // |SkFontMgr|
+  void onGetFamilyName(int index, SkString* familyName) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkFontStyleSet> onCreateStyleSet(int index) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkFontStyleSet> onMatchFamily(const char familyName[]) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMatchFamilyStyle(const char familyName[],
+                                       const SkFontStyle&) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMatchFamilyStyleCharacter(
+      const char familyName[],
+      const SkFontStyle&,
+      const char* bcp47[],
+      int bcp47Count,
+      SkUnichar character) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromData(sk_sp<SkData>, int ttcIndex) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromStreamIndex(std::unique_ptr<SkStreamAsset>,
+                                          int ttcIndex) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromStreamArgs(std::unique_ptr<SkStreamAsset>,
+                                         const SkFontArguments&) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromFile(const char path[],
+                                   int ttcIndex) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onLegacyMakeTypeface(const char familyName[],
+                                         SkFontStyle) const override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FallbackCachingFontManager);
+};
+
+}  // namespace txt
+
+#endif  // LIB_TXT_SRC_FALLBACK_CACHING_FONT_MANAGER_H_
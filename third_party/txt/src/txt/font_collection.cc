@@ -26,12 +26,15 @@
 #include <vector>
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/third_party/txt/src/skia/paragraph_cache_skia.h"
 #include "txt/platform.h"
 #include "txt/text_style.h"
 
 namespace txt {
 
-FontCollection::FontCollection() : enable_font_fallback_(true) {}
+FontCollection::FontCollection()
+    : enable_font_fallback_(true),
+      paragraph_cache_(std::make_shared<ParagraphCacheSkia>()) {}
 
 FontCollection::~FontCollection() {
   if (skt_collection_) {
@@ -45,28 +48,34 @@ size_t FontCollection::GetFontManagersCount() const {
 
 void FontCollection::SetupDefaultFontManager(
     uint32_t font_initialization_data) {
-  default_font_manager_ = GetDefaultFontManager(font_initialization_data);
-  skt_collection_.reset();
+  SetDefaultFontManager(GetDefaultFontManager(font_initialization_data));
 }
 
 void FontCollection::SetDefaultFontManager(sk_sp<SkFontMgr> font_manager) {
   default_font_manager_ = font_manager;
+  fallback_font_manager_ =
+      font_manager ? sk_make_sp<FallbackCachingFontManager>(font_manager)
+                   : nullptr;
   skt_collection_.reset();
+  paragraph_cache_->Clear();
 }
 
 void FontCollection::SetAssetFontManager(sk_sp<SkFontMgr> font_manager) {
   asset_font_manager_ = font_manager;
   skt_collection_.reset();
+  paragraph_cache_->Clear();
 }
 
 void FontCollection::SetDynamicFontManager(sk_sp<SkFontMgr> font_manager) {
   dynamic_font_manager_ = font_manager;
   skt_collection_.reset();
+  paragraph_cache_->Clear();
 }
 
 void FontCollection::SetTestFontManager(sk_sp<SkFontMgr> font_manager) {
   test_font_manager_ = font_manager;
   skt_collection_.reset();
+  paragraph_cache_->Clear();
 }
 
 // Return the available font managers in the order they should be queried.
@@ -88,34 +97,47 @@ void FontCollection::DisableFontFallback() {
   if (skt_collection_) {
     skt_collection_->disableFontFallback();
   }
+  paragraph_cache_->Clear();
 }
 
 void FontCollection::ClearFontFamilyCache() {
   if (skt_collection_) {
     skt_collection_->clearCaches();
   }
+  if (fallback_font_manager_) {
+    fallback_font_manager_->ClearCache();
+  }
+  paragraph_cache_->Clear();
 }
 
 sk_sp<skia::textlayout::FontCollection>
 FontCollection::CreateSktFontCollection() {
   if (!skt_collection_) {
-    skt_collection_ = sk_make_sp<skia::textlayout::FontCollection>();
-
-    std::vector<SkString> default_font_families;
-    for (const std::string& family : GetDefaultFontFamilies()) {
-      default_font_families.emplace_back(family);
-    }
-    skt_collection_->setDefaultFontManager(default_font_manager_,
-                                           default_font_families);
-    skt_collection_->setAssetFontManager(asset_font_manager_);
-    skt_collection_->setDynamicFontManager(dynamic_font_manager_);
-    skt_collection_->setTestFontManager(test_font_manager_);
-    if (!enable_font_fallback_) {
-      skt_collection_->disableFontFallback();
-    }
+    skt_collection_ = MakeSktFontCollection();
   }
 
   return skt_collection_;
 }
 
+sk_sp<skia::textlayout::FontCollection> FontCollection::MakeSktFontCollection()
+    const {
+  auto collection = sk_make_sp<skia::textlayout::FontCollection>();
+
+  std::vector<SkString> default_font_families;
+  for (const std::string& family : GetDefaultFontFamilies()) {
+    default_font_families.emplace_back(family);
+  }
+  // The fallback typefaces are looked up in the default font manager, through
+  // the cache shared by all the Skia collections of this collection.
+  collection->setDefaultFontManager(fallback_font_manager_,
+                                    default_font_families);
+  collection->setAssetFontManager(asset_font_manager_);
+  collection->setDynamicFontManager(dynamic_font_manager_);
+  collection->setTestFontManager(test_font_manager_);
+  if (!enable_font_fallback_) {
+    collection->disableFontFallback();
+  }
+  return collection;
+}
+
 }  // namespace txt
@@ -28,10 +28,13 @@
 #include "third_party/skia/include/core/SkRefCnt.h"
 #include "third_party/skia/modules/skparagraph/include/FontCollection.h"  // nogncheck
 #include "txt/asset_font_manager.h"
+#include "txt/fallback_caching_font_manager.h"
 #include "txt/text_style.h"
 
 namespace txt {
 
+class ParagraphCacheSkia;
+
 class FontCollection : public std::enable_shared_from_this<FontCollection> {
  public:
   FontCollection();
@@ -56,8 +59,21 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // Construct a Skia text layout FontCollection based on this collection.
   sk_sp<skia::textlayout::FontCollection> CreateSktFontCollection();
 
+  // Construct a new Skia text layout FontCollection based on this collection,
+  // which is not shared with the paragraphs built on the UI thread and can be
+  // used by another thread.
+  sk_sp<skia::textlayout::FontCollection> MakeSktFontCollection() const;
+
+  // The cache of the paragraphs laid out with this collection, which is
+  // cleared whenever the fonts change.
+  const std::shared_ptr<ParagraphCacheSkia>& GetParagraphCache() const {
+    return paragraph_cache_;
+  }
+
  private:
   sk_sp<SkFontMgr> default_font_manager_;
+  // Forwards to the default font manager, and caches its fallback typefaces.
+  sk_sp<FallbackCachingFontManager> fallback_font_manager_;
   sk_sp<SkFontMgr> asset_font_manager_;
   sk_sp<SkFontMgr> dynamic_font_manager_;
   sk_sp<SkFontMgr> test_font_manager_;
@@ -66,6 +82,8 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // An equivalent font collection usable by the Skia text shaper library.
   sk_sp<skia::textlayout::FontCollection> skt_collection_;
 
+  const std::shared_ptr<ParagraphCacheSkia> paragraph_cache_;
+
   std::vector<sk_sp<SkFontMgr>> GetFontManagerOrder() const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(FontCollection);
@@ -18,6 +18,8 @@
 #ifndef LIB_TXT_SRC_PARAGRAPH_H_
 #define LIB_TXT_SRC_PARAGRAPH_H_
 
+#include <functional>
+
 #include "flutter/display_list/dl_builder.h"
 #include "line_metrics.h"
 #include "paragraph_style.h"
@@ -146,6 +148,13 @@ class Paragraph {
   // before Painting and getting any statistics from this class.
   virtual void Layout(double width) = 0;
 
+  // Returns a task that lays out the paragraph like Layout(width), and that
+  // may run on another thread while this paragraph is not otherwise used, or
+  // null if the paragraph can only be laid out on the calling thread.
+  virtual std::function<void()> PrepareConcurrentLayout(double width) {
+    return nullptr;
+  }
+
   // Paints the laid out text onto the supplied DisplayListBuilder at
   // (x, y) offset from the origin. Only valid after Layout() is called.
   virtual bool Paint(flutter::DisplayListBuilder* builder,
@@ -18,7 +18,10 @@
 
 #include <sstream>
 
+#include "runtime/test_font_data.h"
+#include "txt/fallback_caching_font_manager.h"
 #include "txt/font_collection.h"
+#include "txt/typeface_font_asset_provider.h"
 
 namespace txt {
 namespace testing {
@@ -39,5 +42,70 @@ TEST_F(FontCollectionTests, SettingUpDefaultFontManagerClearsCache) {
   sk_font_collection = font_collection.CreateSktFontCollection();
   ASSERT_NE(sk_font_collection->getFallbackManager().get(), nullptr);
 }
+
+namespace {
+
+// Falls back to the first test font with a glyph for the character, and
+// counts the lookups.
+class CountingFallbackFontManager : public AssetFontManager {
+ public:
+  CountingFallbackFontManager()
+      : AssetFontManager(std::make_unique<TypefaceFontAssetProvider>()),
+        typefaces_(flutter::GetTestFontData()) {}
+
+  int lookup_count() const { return lookup_count_; }
+
+ private:
+  sk_sp<SkTypeface> onMatchFamilyStyleCharacter(
+      const char familyName[],
+      const SkFontStyle&,
+      const char* bcp47[],
+      int bcp47Count,
+      SkUnichar character) const override {
+    lookup_count_++;
+    for (const auto& typeface : typefaces_) {
+      if (typeface->unicharToGlyph(character) != 0) {
+        return typeface;
+      }
+    }
+    return nullptr;
+  }
+
+  const std::vector<sk_sp<SkTypeface>> typefaces_;
+  mutable int lookup_count_ = 0;
+};
+
+}  // namespace
+
+TEST_F(FontCollectionTests, CachesFallbackTypefacesByCodePointRange) {
+  auto counting_manager = sk_make_sp<CountingFallbackFontManager>();
+  auto manager = sk_make_sp<FallbackCachingFontManager>(counting_manager);
+
+  auto typeface = manager->matchFamilyStyleCharacter(nullptr, SkFontStyle(),
+                                                     nullptr, 0, 'A');
+  ASSERT_NE(typeface, nullptr);
+  EXPECT_EQ(counting_manager->lookup_count(), 1);
+  // Another character of the same range with a glyph in the typeface.
+  EXPECT_EQ(manager->matchFamilyStyleCharacter(nullptr, SkFontStyle(),
+                                               nullptr, 0, 'B'),
+            typeface);
+  EXPECT_EQ(counting_manager->lookup_count(), 1);
+  EXPECT_EQ(manager->GetCachedRangeCount(), 1u);
+
+  // Characters without a fallback are only looked up once.
+  const SkUnichar missing = 0x10FFFD;
+  EXPECT_EQ(manager->matchFamilyStyleCharacter(nullptr, SkFontStyle(),
+                                               nullptr, 0, missing),
+            nullptr);
+  EXPECT_EQ(manager->matchFamilyStyleCharacter(nullptr, SkFontStyle(),
+                                               nullptr, 0, missing),
+            nullptr);
+  EXPECT_EQ(counting_manager->lookup_count(), 2);
+
+  manager->ClearCache();
+  EXPECT_EQ(manager->GetCachedRangeCount(), 0u);
+  manager->matchFamilyStyleCharacter(nullptr, SkFontStyle(), nullptr, 0, 'A');
+  EXPECT_EQ(counting_manager->lookup_count(), 3);
+}
 }  // namespace testing
 }  // namespace txt
@@ -65,6 +65,17 @@ class DlOpRecorder final : public virtual DlOpReceiver,
   const DlPathEffect* path_effect_;
 };
 
+std::shared_ptr<txt::FontCollection> MakeTestFontCollection() {
+  auto f_collection = std::make_shared<txt::FontCollection>();
+  auto font_provider = std::make_unique<txt::TypefaceFontAssetProvider>();
+  for (auto& font : GetTestFontData()) {
+    font_provider->RegisterTypeface(font);
+  }
+  auto manager = sk_make_sp<txt::AssetFontManager>(std::move(font_provider));
+  f_collection->SetAssetFontManager(manager);
+  return f_collection;
+}
+
 template <typename T>
 class PainterTestBase : public CanvasTestBase<T> {
  public:
@@ -109,20 +120,9 @@ class PainterTestBase : public CanvasTestBase<T> {
   }
 
  private:
-  std::shared_ptr<txt::FontCollection> makeFontCollection() const {
-    auto f_collection = std::make_shared<txt::FontCollection>();
-    auto font_provider = std::make_unique<txt::TypefaceFontAssetProvider>();
-    for (auto& font : GetTestFontData()) {
-      font_provider->RegisterTypeface(font);
-    }
-    auto manager = sk_make_sp<txt::AssetFontManager>(std::move(font_provider));
-    f_collection->SetAssetFontManager(manager);
-    return f_collection;
-  }
-
   txt::ParagraphBuilderSkia makeParagraphBuilder() const {
     auto p_style = txt::ParagraphStyle();
-    auto f_collection = makeFontCollection();
+    auto f_collection = MakeTestFontCollection();
     return txt::ParagraphBuilderSkia(p_style, f_collection, impeller_);
   }
 
@@ -241,5 +241,61 @@ TEST_F(PainterTest, DrawTextBlobNoImpeller) {
 }
 #endif  // IMPELLER_SUPPORTS_RENDERING
 
+std::unique_ptr<txt::Paragraph> BuildParagraph(
+    const std::shared_ptr<txt::FontCollection>& f_collection,
+    const std::u16string& text) {
+  auto t_style = txt::TextStyle();
+  t_style.font_size = 14;
+  t_style.font_families.push_back("ahem");
+  auto pb_skia =
+      txt::ParagraphBuilderSkia(txt::ParagraphStyle(), f_collection, false);
+  pb_skia.PushStyle(t_style);
+  pb_skia.AddText(text);
+  pb_skia.Pop();
+  return pb_skia.Build();
+}
+
+TEST(ParagraphCacheTest, ReusesLayoutOfIdenticalParagraphs) {
+  auto f_collection = MakeTestFontCollection();
+  const auto& cache = f_collection->GetParagraphCache();
+
+  auto first = BuildParagraph(f_collection, u"Hello World!");
+  first->Layout(100);
+  EXPECT_EQ(cache->GetEntryCount(), 1u);
+
+  auto second = BuildParagraph(f_collection, u"Hello World!");
+  second->Layout(100);
+  EXPECT_EQ(cache->GetEntryCount(), 1u);
+  EXPECT_EQ(second->GetHeight(), first->GetHeight());
+  EXPECT_EQ(second->GetNumberOfLines(), first->GetNumberOfLines());
+
+  // Laying out the shared paragraph with another width doesn't affect the
+  // other paragraphs that use it.
+  second->Layout(50);
+  EXPECT_EQ(cache->GetEntryCount(), 2u);
+  EXPECT_EQ(first->GetMaxWidth(), 100);
+  EXPECT_EQ(second->GetMaxWidth(), 50);
+
+  auto other = BuildParagraph(f_collection, u"Hello Flutter!");
+  other->Layout(100);
+  EXPECT_EQ(cache->GetEntryCount(), 3u);
+}
+
+TEST(ParagraphCacheTest, ClearsWhenFontsChange) {
+  auto f_collection = MakeTestFontCollection();
+  const auto& cache = f_collection->GetParagraphCache();
+
+  BuildParagraph(f_collection, u"Hello World!")->Layout(100);
+  EXPECT_EQ(cache->GetEntryCount(), 1u);
+
+  auto paragraph = BuildParagraph(f_collection, u"Hello World!");
+  f_collection->ClearFontFamilyCache();
+  EXPECT_EQ(cache->GetEntryCount(), 0u);
+
+  // Paragraphs built with the previous fonts are not cached.
+  paragraph->Layout(100);
+  EXPECT_EQ(cache->GetEntryCount(), 0u);
+}
+
 }  // namespace testing
 }  // namespace flutter